@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""
+Compare two JSON outputs of the mlpack_bench target and flag regressions.
+
+Typical per-PR usage:
+
+  git checkout master && cmake --build build --target mlpack_bench
+  ./build/bin/mlpack_bench --json > baseline.json
+  git checkout my-branch && cmake --build build --target mlpack_bench
+  ./build/bin/mlpack_bench --json > contender.json
+  scripts/compare-benchmarks.py baseline.json contender.json
+
+The exit status is nonzero if any benchmark slowed down by more than the
+threshold (default 10%), so this can gate CI.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        results = json.load(f)
+    return {b['name']: b['ns_per_iteration'] for b in results['benchmarks']}
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compare two mlpack_bench --json outputs.')
+    parser.add_argument('baseline', help='JSON output of the baseline run')
+    parser.add_argument('contender', help='JSON output of the contender run')
+    parser.add_argument('--threshold', type=float, default=10.0,
+        help='maximum allowed slowdown, in percent (default: 10)')
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    contender = load(args.contender)
+
+    width = max(len(name) for name in baseline) if baseline else 0
+    print('%-*s %14s %14s %9s' %
+        (width, 'benchmark', 'baseline', 'contender', 'change'))
+    print('-' * (width + 40))
+
+    regressions = []
+    for name in sorted(baseline):
+        if name not in contender:
+            print('%-*s %14.1f %14s %9s' %
+                (width, name, baseline[name], 'MISSING', ''))
+            continue
+        change = 100.0 * (contender[name] - baseline[name]) / baseline[name]
+        print('%-*s %14.1f %14.1f %+8.1f%%' %
+            (width, name, baseline[name], contender[name], change))
+        if change > args.threshold:
+            regressions.append((name, change))
+
+    for name in sorted(contender):
+        if name not in baseline:
+            print('%-*s %14s %14.1f %9s' %
+                (width, name, 'NEW', contender[name], ''))
+
+    if regressions:
+        print()
+        for (name, change) in regressions:
+            print('REGRESSION: %s slowed down by %.1f%% (threshold: %.1f%%)' %
+                (name, change, args.threshold))
+        return 1
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -92,6 +92,9 @@ void IO_SetParamVecInt(const std::string& paramName,
 void IO_SetParamMat(const std::string& paramName,
                     const arma::mat& paramValue)
 {
+  // The points-as-rows convention of the R interface requires a transpose,
+  // which inherently copies; matrices therefore cannot be borrowed the way
+  // vector parameters are (see IO_SetParamRow()).
   IO::GetParam<arma::mat>(paramName) = paramValue.t();
   IO::SetPassed(paramName);
 }
@@ -110,7 +113,12 @@ void IO_SetParamUMat(const std::string& paramName,
 void IO_SetParamRow(const std::string& paramName,
                     const arma::rowvec& paramValue)
 {
-  IO::GetParam<arma::rowvec>(paramName) = std::move(paramValue);
+  // Borrow the R memory with a non-strict alias instead of copying it.  The
+  // generated R code keeps the underlying vector alive in its frame until the
+  // binding has run, so the alias cannot dangle.
+  IO::GetParam<arma::rowvec>(paramName) = arma::rowvec(
+      const_cast<double*>(paramValue.memptr()), paramValue.n_elem, false,
+      false);
   IO::SetPassed(paramName);
 }
 
@@ -128,7 +136,10 @@ void IO_SetParamURow(const std::string& paramName,
 void IO_SetParamCol(const std::string& paramName,
                     const arma::vec& paramValue)
 {
-  IO::GetParam<arma::vec>(paramName) = std::move(paramValue);
+  // Borrow the R memory (see IO_SetParamRow()).
+  IO::GetParam<arma::vec>(paramName) = arma::vec(
+      const_cast<double*>(paramValue.memptr()), paramValue.n_elem, false,
+      false);
   IO::SetPassed(paramName);
 }
 
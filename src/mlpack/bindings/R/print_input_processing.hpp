@@ -74,19 +74,25 @@ void PrintInputProcessing(
     util::ParamData& d,
     const typename boost::enable_if<arma::is_arma_type<T>>::type* = 0)
 {
+  // The converted value is rebound to the parameter name, so that it stays
+  // alive in the function frame: the C++ side borrows the underlying memory
+  // instead of copying it.
   if (!d.required)
   {
     /**
      * This gives us code like:
      *
      *     if (!identical(<param_name>, NA)) {
-     *        IO_SetParam<type>("<param_name>", to_matrix(<param_name>))
+     *        <param_name> <- to_matrix(<param_name>)
+     *        IO_SetParam<type>("<param_name>", <param_name>)
      *     }
      */
     MLPACK_COUT_STREAM << "  if (!identical(" << d.name << ", NA)) {"
         << std::endl;
+    MLPACK_COUT_STREAM << "    " << d.name << " <- to_matrix(" << d.name
+        << ")" << std::endl;
     MLPACK_COUT_STREAM << "    IO_SetParam" << GetType<T>(d) << "(\""
-        << d.name << "\", to_matrix(" << d.name << "))" << std::endl;
+        << d.name << "\", " << d.name << ")" << std::endl;
     MLPACK_COUT_STREAM << "  }" << std::endl; // Closing brace.
   }
   else
@@ -94,10 +100,13 @@ void PrintInputProcessing(
     /**
      * This gives us code like:
      *
-     *     IO_SetParam<type>("<param_name>", to_matrix(<param_name>))
+     *     <param_name> <- to_matrix(<param_name>)
+     *     IO_SetParam<type>("<param_name>", <param_name>)
      */
+    MLPACK_COUT_STREAM << "  " << d.name << " <- to_matrix(" << d.name
+        << ")" << std::endl;
     MLPACK_COUT_STREAM << "  IO_SetParam" << GetType<T>(d) << "(\""
-        << d.name << "\", to_matrix(" << d.name << "))" << std::endl;
+        << d.name << "\", " << d.name << ")" << std::endl;
   }
   MLPACK_COUT_STREAM << std::endl; // Extra line is to clear up the code a bit.
 }
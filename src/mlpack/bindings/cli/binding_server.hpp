@@ -0,0 +1,345 @@
+/**
+ * @file bindings/cli/binding_server.hpp
+ *
+ * Persistent server mode for command-line bindings.  When a binding is run
+ * with '--server <path>', instead of running once and exiting, it listens on a
+ * Unix domain socket at the given path and runs one binding invocation per
+ * framed request.  This amortizes process startup, parameter registration, and
+ * input model deserialization across many invocations, which matters when a
+ * pipeline shells out to the same binding thousands of times.
+ *
+ * The wire format is documented in server_protocol.hpp, which holds the
+ * framing helpers.  The arguments given on the command line at startup (minus
+ * '--server' and its value) are prepended to every request, so a model file
+ * or other common options can be given just once.
+ *
+ * Requests are served one at a time: the IO parameter singleton is global
+ * state, so there is no safe way to run two invocations concurrently in one
+ * process.  A connection may carry any number of requests.  The default
+ * options --help, --info, and --version must not be sent over the socket, as
+ * they terminate the process.
+ *
+ * Input models are cached between requests, keyed by parameter name and
+ * filename: if a request passes the same model file as an earlier one, the
+ * already-deserialized model is reused instead of being loaded again.  The
+ * file's modification time is recorded when the model is cached, and a cached
+ * model is only reused while the file on disk still has that modification
+ * time; overwriting a model file (e.g. by retraining) makes the next request
+ * load the new file.  Caching assumes that bindings do not modify their input
+ * models in memory, which holds for the shipped bindings; if a binding does
+ * modify its input model, pass a different filename (or restart the server)
+ * to avoid reusing the modified object.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_BINDING_SERVER_HPP
+#define MLPACK_BINDINGS_CLI_BINDING_SERVER_HPP
+
+#include <mlpack/core/util/io.hpp>
+#include "parse_command_line.hpp"
+#include "server_protocol.hpp"
+
+#include <cstring>
+#include <set>
+#include <unordered_map>
+
+#ifndef _WIN32
+  #include <sys/socket.h>
+  #include <sys/un.h>
+  #include <unistd.h>
+  #include <cerrno>
+#endif
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+#ifndef _WIN32
+
+//! A deserialized input model kept alive between requests.
+struct CachedModel
+{
+  //! A copy of the parameter holding the loaded model pointer.
+  util::ParamData param;
+  //! The filename the model was loaded from.
+  std::string filename;
+  //! The modification time of the file when the model was loaded; if the file
+  //! changes on disk, the cached model is stale and must not be reused.
+  time_t mtime;
+};
+
+/**
+ * Free the memory allocated during a request, moving any loaded input models
+ * into the cache instead of freeing them so that later requests passing the
+ * same filename can reuse them.  This takes the place of the cleanup at the
+ * end of EndProgram().
+ */
+inline void CollectRequestMemory(std::map<std::string, CachedModel>& modelCache)
+{
+  std::map<std::string, util::ParamData>& parameters = IO::Parameters();
+
+  // Collect every unique allocated pointer; we may hold the same pointer
+  // twice (e.g. as both an input and an output model), so we have to be
+  // careful to not delete it multiple times.
+  std::unordered_map<void*, util::ParamData*> memoryAddresses;
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+
+    void* result;
+    IO::GetSingleton().functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+        (void*) &result);
+    if (result != NULL && memoryAddresses.count(result) == 0)
+      memoryAddresses[result] = &d;
+  }
+
+  // Move loaded input models into the cache.
+  std::set<void*> kept;
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+    if (!d.input || !d.loaded)
+      continue;
+
+    void* result;
+    IO::GetSingleton().functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+        (void*) &result);
+    if (result == NULL)
+      continue;
+
+    // Drop any previously cached model for this parameter, unless it is the
+    // very object we are about to cache again (i.e. it was reused).
+    std::map<std::string, CachedModel>::iterator old = modelCache.find(d.name);
+    if (old != modelCache.end())
+    {
+      void* oldResult;
+      IO::GetSingleton().functionMap[old->second.param.tname]
+          ["GetAllocatedMemory"](old->second.param, NULL, (void*) &oldResult);
+      if (oldResult != NULL && oldResult != result)
+      {
+        IO::GetSingleton().functionMap[old->second.param.tname]
+            ["DeleteAllocatedMemory"](old->second.param, NULL, NULL);
+      }
+      modelCache.erase(old);
+    }
+
+    CachedModel cached;
+    cached.param = d;
+    IO::GetSingleton().functionMap[d.tname]["GetPrintableParam"](d, NULL,
+        (void*) &cached.filename);
+    cached.mtime = FileModificationTime(cached.filename);
+    modelCache[d.name] = std::move(cached);
+    kept.insert(result);
+  }
+
+  // Now free everything that was not kept.
+  for (auto& it : memoryAddresses)
+  {
+    if (kept.count(it.first) == 0)
+    {
+      IO::GetSingleton().functionMap[it.second->tname]
+          ["DeleteAllocatedMemory"](*it.second, NULL, NULL);
+    }
+  }
+}
+
+/**
+ * Run one request: reset the parameter state, parse the combined arguments,
+ * reuse any cached models, run the binding, and write the response.
+ */
+inline void RunRequest(const std::vector<std::string>& baseArgs,
+                       const std::vector<std::string>& requestArgs,
+                       const std::map<std::string, util::ParamData>& defaults,
+                       std::map<std::string, CachedModel>& modelCache,
+                       void (*mainFunction)(),
+                       const int fd)
+{
+  // Reset the parameter state so that this request starts from the defaults
+  // instead of inheriting values from the previous request.
+  IO::Parameters() = defaults;
+
+  std::vector<std::string> args(baseArgs);
+  args.insert(args.end(), requestArgs.begin(), requestArgs.end());
+  std::vector<char*> argv;
+  for (const std::string& s : args)
+    argv.push_back(const_cast<char*>(s.c_str()));
+
+  try
+  {
+    ParseCommandLine((int) argv.size(), argv.data());
+
+    // Reuse any cached model whose filename matches what was passed for this
+    // request; this is what amortizes deserialization across requests.
+    std::map<std::string, util::ParamData>& parameters = IO::Parameters();
+    for (auto& it : modelCache)
+    {
+      if (parameters.count(it.first) == 0)
+        continue;
+
+      util::ParamData& d = parameters.at(it.first);
+      std::string filename;
+      IO::GetSingleton().functionMap[d.tname]["GetPrintableParam"](d, NULL,
+          (void*) &filename);
+      // The modification time check makes sure the file has not been
+      // overwritten (e.g. by retraining) since the model was cached; a stale
+      // cache entry is skipped here and replaced after the request, when
+      // CollectRequestMemory() caches the freshly loaded model.
+      if (d.wasPassed && filename == it.second.filename &&
+          FileModificationTime(filename) == it.second.mtime)
+      {
+        d.value = it.second.param.value;
+        d.loaded = true;
+      }
+    }
+
+    // A "total_time" timer is run for each request, as for a standalone run.
+    Timer::Start("total_time");
+
+    mainFunction();
+
+    // Stop timers and print (save) any output parameters, as EndProgram()
+    // would, but harvest loaded input models into the cache instead of
+    // freeing them.
+    IO::GetSingleton().timer.StopAllTimers();
+    for (auto& it : parameters)
+    {
+      util::ParamData& d = it.second;
+      if (!d.input)
+        IO::GetSingleton().functionMap[d.tname]["OutputParam"](d, NULL, NULL);
+    }
+    CollectRequestMemory(modelCache);
+
+    WriteResponse(fd, 0, "");
+  }
+  catch (std::exception& e)
+  {
+    // A failed request should not take down the server; clean up anything
+    // that was allocated before the failure and report the error.
+    IO::GetSingleton().timer.StopAllTimers();
+    CollectRequestMemory(modelCache);
+    WriteResponse(fd, 1, e.what());
+  }
+}
+
+#endif // _WIN32
+
+/**
+ * Run the binding as a persistent server.  argv[serverIndex] is "--server"
+ * and argv[serverIndex + 1] is the socket path; all other arguments are
+ * prepended to every request.  Returns the process exit code.
+ */
+inline int RunServer(const int argc,
+                     char** argv,
+                     const int serverIndex,
+                     void (*mainFunction)())
+{
+#ifdef _WIN32
+  (void) argc;
+  (void) argv;
+  (void) serverIndex;
+  (void) mainFunction;
+  Log::Fatal << "Server mode (--server) is not available on Windows."
+      << std::endl;
+  return 1;
+#else
+  const std::string socketPath = argv[serverIndex + 1];
+
+  // Collect the startup arguments, minus '--server' and its value.
+  std::vector<std::string> baseArgs;
+  for (int i = 0; i < argc; ++i)
+  {
+    if (i == serverIndex || i == serverIndex + 1)
+      continue;
+    baseArgs.push_back(argv[i]);
+  }
+
+  // Snapshot the pristine parameter state; every request starts from this.
+  const std::map<std::string, util::ParamData> defaults = IO::Parameters();
+
+  // Deserialized input models kept alive between requests, keyed by parameter
+  // name.
+  std::map<std::string, CachedModel> modelCache;
+
+  // Set up the listening socket.
+  sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (socketPath.length() >= sizeof(addr.sun_path))
+    Log::Fatal << "Socket path '" << socketPath << "' is too long!"
+        << std::endl;
+  strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+  const int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listenFd < 0)
+    Log::Fatal << "Cannot create socket: " << strerror(errno) << std::endl;
+
+  // Remove any stale socket left behind by an earlier server.
+  unlink(socketPath.c_str());
+  if (bind(listenFd, (sockaddr*) &addr, sizeof(addr)) < 0)
+    Log::Fatal << "Cannot bind to socket path '" << socketPath << "': "
+        << strerror(errno) << std::endl;
+  if (listen(listenFd, 8) < 0)
+    Log::Fatal << "Cannot listen on socket path '" << socketPath << "': "
+        << strerror(errno) << std::endl;
+
+  Timer::EnableTiming();
+
+  Log::Info << "Serving requests on '" << socketPath << "'." << std::endl;
+
+  bool shutdown = false;
+  while (!shutdown)
+  {
+    const int clientFd = accept(listenFd, NULL, NULL);
+    if (clientFd < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      Log::Warn << "accept() failed: " << strerror(errno) << "; shutting down."
+          << std::endl;
+      break;
+    }
+
+    // A connection may carry any number of requests; serve until EOF.
+    std::vector<std::string> requestArgs;
+    while (true)
+    {
+      bool shutdownRequest = false;
+      if (!ReadRequest(clientFd, requestArgs, shutdownRequest))
+        break;
+
+      if (shutdownRequest)
+      {
+        WriteResponse(clientFd, 0, "");
+        shutdown = true;
+        break;
+      }
+
+      RunRequest(baseArgs, requestArgs, defaults, modelCache, mainFunction,
+          clientFd);
+    }
+
+    close(clientFd);
+  }
+
+  close(listenFd);
+  unlink(socketPath.c_str());
+
+  // Free any cached models before exiting.
+  for (auto& it : modelCache)
+  {
+    IO::GetSingleton().functionMap[it.second.param.tname]
+        ["DeleteAllocatedMemory"](it.second.param, NULL, NULL);
+  }
+
+  return 0;
+#endif
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
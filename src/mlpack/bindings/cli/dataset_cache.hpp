@@ -0,0 +1,326 @@
+/**
+ * @file bindings/cli/dataset_cache.hpp
+ *
+ * An optional shared-memory cache for input datasets of command-line
+ * bindings.  Consecutive CLI invocations on the same data file otherwise
+ * parse it from disk every time; with the cache enabled, the first process
+ * that loads a dataset publishes the parsed matrix into a POSIX shared
+ * memory segment, and later processes attach to that segment instead of
+ * re-reading the file.  For shell pipelines that call several bindings (or
+ * the same binding repeatedly) on one dataset, this gives in-memory load
+ * speeds without any change to the pipeline itself.
+ *
+ * The cache is disabled by default; it is enabled by setting the environment
+ * variable MLPACK_DATASET_CACHE to any non-empty value.  Segments are keyed
+ * by the resolved path, modification time, and size of the data file plus the
+ * requested orientation, so editing or replacing a file never yields stale
+ * data---it simply produces a new segment.  Superseded segments are not
+ * removed automatically (there is no portable way to know when the last user
+ * is done with them); they live in /dev/shm until the host reboots or they
+ * are removed with 'rm /dev/shm/mlpack-ds-*'.
+ *
+ * Attached segments are mapped copy-on-write, so a binding that modifies its
+ * input matrix in place (as the tree-building methods do) only dirties
+ * private pages and never corrupts the published copy.  Publishing uses
+ * O_EXCL creation and a ready flag that is set only after the data is fully
+ * copied in, so concurrent processes racing on a cold cache either publish,
+ * attach to a complete segment, or harmlessly fall back to loading from
+ * disk.
+ *
+ * Only dense numeric matrix parameters are cached; matrices carrying
+ * data::DatasetInfo and serialized models are always loaded from disk.  On
+ * Windows the cache compiles to a no-op.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_DATASET_CACHE_HPP
+#define MLPACK_BINDINGS_CLI_DATASET_CACHE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <limits.h>
+  #include <stdlib.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+//! Return true if the shared-memory dataset cache has been enabled via the
+//! MLPACK_DATASET_CACHE environment variable.
+inline bool DatasetCacheEnabled()
+{
+  const char* value = getenv("MLPACK_DATASET_CACHE");
+  return (value != NULL && *value != '\0');
+}
+
+#ifndef _WIN32
+
+//! The header stored at the start of every cache segment.
+struct DatasetCacheHeader
+{
+  //! Identifies the segment layout; bump when the layout changes.
+  uint64_t magic;
+  //! Nonzero once the matrix data has been fully copied into the segment.
+  uint64_t ready;
+  //! The size of one matrix element, for sanity checking.
+  uint64_t elemSize;
+  //! The number of rows of the cached matrix.
+  uint64_t nRows;
+  //! The number of columns of the cached matrix.
+  uint64_t nCols;
+};
+
+//! The magic number marking the current segment layout.
+const uint64_t datasetCacheMagic = 0x6d6c70636b647301ULL;
+
+//! Mix the given bytes into an FNV-1a hash.
+inline uint64_t DatasetCacheHash(uint64_t hash,
+                                 const void* bytes,
+                                 const size_t length)
+{
+  const unsigned char* data = (const unsigned char*) bytes;
+  for (size_t i = 0; i < length; ++i)
+  {
+    hash ^= (uint64_t) data[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/**
+ * Compute the name of the cache segment for the given data file.  The name
+ * covers the resolved path, modification time, and size of the file, the
+ * requested orientation, and the element size, so any change to the file or
+ * to how it is loaded selects a different segment.  Returns false if the file
+ * cannot be inspected.
+ */
+inline bool DatasetCacheName(const std::string& filename,
+                             const bool transpose,
+                             const size_t elemSize,
+                             std::string& name)
+{
+  struct stat info;
+  if (stat(filename.c_str(), &info) != 0)
+    return false;
+
+  char resolved[PATH_MAX];
+  if (realpath(filename.c_str(), resolved) == NULL)
+    return false;
+
+  uint64_t hash = 14695981039346656037ULL;
+  hash = DatasetCacheHash(hash, resolved, strlen(resolved));
+  hash = DatasetCacheHash(hash, &info.st_mtime, sizeof(info.st_mtime));
+  hash = DatasetCacheHash(hash, &info.st_size, sizeof(info.st_size));
+  const unsigned char flags =
+      (unsigned char) ((transpose ? 1 : 0) | (elemSize << 1));
+  hash = DatasetCacheHash(hash, &flags, sizeof(flags));
+
+  std::ostringstream oss;
+  oss << "/mlpack-ds-" << std::hex << std::setw(16) << std::setfill('0')
+      << hash;
+  name = oss.str();
+  return true;
+}
+
+//! Wrap the given cache memory in a matrix object without copying.  The
+//! non-strict alias is moved into the output object, so it remains a view
+//! into the mapping.
+template<typename ElemType>
+inline void MakeCacheAlias(arma::Mat<ElemType>& matrix,
+                           ElemType* data,
+                           const size_t rows,
+                           const size_t cols)
+{
+  matrix = arma::Mat<ElemType>(data, rows, cols, false, false);
+}
+
+//! Wrap the given cache memory in a row vector object without copying.
+template<typename ElemType>
+inline void MakeCacheAlias(arma::Row<ElemType>& matrix,
+                           ElemType* data,
+                           const size_t rows,
+                           const size_t cols)
+{
+  matrix = arma::Row<ElemType>(data, rows * cols, false, false);
+}
+
+//! Wrap the given cache memory in a column vector object without copying.
+template<typename ElemType>
+inline void MakeCacheAlias(arma::Col<ElemType>& matrix,
+                           ElemType* data,
+                           const size_t rows,
+                           const size_t cols)
+{
+  matrix = arma::Col<ElemType>(data, rows * cols, false, false);
+}
+
+/**
+ * Try to attach to a published in-memory copy of the given data file.  On
+ * success the matrix is set to a view into the (copy-on-write) mapping and
+ * true is returned; on any failure---cache disabled, no segment published
+ * yet, or a segment that does not match the file---false is returned and the
+ * caller should load the file from disk.
+ *
+ * The mapping is intentionally kept for the lifetime of the process, since
+ * the matrix aliases it directly.
+ */
+template<typename T>
+bool TryAttachCachedDataset(const std::string& filename,
+                            const bool transpose,
+                            T& matrix)
+{
+  typedef typename T::elem_type ElemType;
+
+  if (!DatasetCacheEnabled())
+    return false;
+
+  std::string name;
+  if (!DatasetCacheName(filename, transpose, sizeof(ElemType), name))
+    return false;
+
+  const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+    return false;
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      (size_t) info.st_size < sizeof(DatasetCacheHeader))
+  {
+    close(fd);
+    return false;
+  }
+
+  // The private mapping is copy-on-write: modifications made by the binding
+  // dirty private pages and never reach the published segment.
+  void* map = mmap(NULL, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+      fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    return false;
+
+  const DatasetCacheHeader* header = (const DatasetCacheHeader*) map;
+  const size_t expectedSize = sizeof(DatasetCacheHeader) +
+      (size_t) header->nRows * (size_t) header->nCols * sizeof(ElemType);
+  if (header->magic != datasetCacheMagic ||
+      header->elemSize != sizeof(ElemType) ||
+      (size_t) info.st_size < expectedSize ||
+      header->ready == 0)
+  {
+    // The segment is from another layout, another element type, or a
+    // publisher that has not finished copying yet; load from disk instead.
+    munmap(map, info.st_size);
+    return false;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  ElemType* data = (ElemType*) ((char*) map + sizeof(DatasetCacheHeader));
+  MakeCacheAlias(matrix, data, (size_t) header->nRows,
+      (size_t) header->nCols);
+
+  Log::Info << "Attached to cached copy of '" << filename << "' ("
+      << matrix.n_rows << " x " << matrix.n_cols << ")." << std::endl;
+  return true;
+}
+
+/**
+ * Publish a freshly loaded dataset into the shared-memory cache, so that
+ * later processes can attach to it.  Publishing is best-effort: if another
+ * process has already created the segment (or is creating it), or shared
+ * memory is unavailable, this quietly does nothing.
+ */
+template<typename T>
+void PublishCachedDataset(const std::string& filename,
+                          const bool transpose,
+                          const T& matrix)
+{
+  typedef typename T::elem_type ElemType;
+
+  if (!DatasetCacheEnabled())
+    return;
+
+  std::string name;
+  if (!DatasetCacheName(filename, transpose, sizeof(ElemType), name))
+    return;
+
+  const size_t dataSize = (size_t) matrix.n_elem * sizeof(ElemType);
+  const size_t totalSize = sizeof(DatasetCacheHeader) + dataSize;
+
+  // O_EXCL makes creation the arbiter between racing publishers: exactly one
+  // process fills the segment, and the rest keep their loaded copies.
+  const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0)
+    return;
+
+  if (ftruncate(fd, totalSize) != 0)
+  {
+    close(fd);
+    shm_unlink(name.c_str());
+    return;
+  }
+
+  void* map = mmap(NULL, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+      0);
+  close(fd);
+  if (map == MAP_FAILED)
+  {
+    shm_unlink(name.c_str());
+    return;
+  }
+
+  DatasetCacheHeader* header = (DatasetCacheHeader*) map;
+  header->magic = datasetCacheMagic;
+  header->elemSize = sizeof(ElemType);
+  header->nRows = matrix.n_rows;
+  header->nCols = matrix.n_cols;
+  memcpy((char*) map + sizeof(DatasetCacheHeader), matrix.memptr(), dataSize);
+
+  // Set the ready flag only after the data is fully in place, so that a
+  // concurrent reader never attaches to a half-written segment.
+  std::atomic_thread_fence(std::memory_order_release);
+  header->ready = 1;
+
+  munmap(map, totalSize);
+  Log::Info << "Published cached copy of '" << filename << "'." << std::endl;
+}
+
+#else // _WIN32
+
+//! Shared-memory caching is not available on Windows; always load from disk.
+template<typename T>
+bool TryAttachCachedDataset(const std::string& /* filename */,
+                            const bool /* transpose */,
+                            T& /* matrix */)
+{
+  return false;
+}
+
+//! Shared-memory caching is not available on Windows; do nothing.
+template<typename T>
+void PublishCachedDataset(const std::string& /* filename */,
+                          const bool /* transpose */,
+                          const T& /* matrix */)
+{
+  // Nothing to do.
+}
+
+#endif
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -13,6 +13,7 @@
 #define MLPACK_BINDINGS_CLI_GET_PARAM_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "dataset_cache.hpp"
 #include "parameter_type.hpp"
 
 namespace mlpack {
@@ -57,11 +58,26 @@ T& GetParam(
   T& matrix = std::get<0>(tuple);
   if (d.input && !d.loaded)
   {
-    // Call correct data::Load() function.
+    // Attach to a published in-memory copy of the dataset if the
+    // shared-memory cache is enabled (see dataset_cache.hpp); otherwise call
+    // the correct data::Load() function and publish the result for later
+    // processes.
     if (arma::is_Row<T>::value || arma::is_Col<T>::value)
-      data::Load(value, matrix, true);
+    {
+      if (!TryAttachCachedDataset(value, true, matrix))
+      {
+        data::Load(value, matrix, true);
+        PublishCachedDataset(value, true, matrix);
+      }
+    }
     else
-      data::Load(value, matrix, true, !d.noTranspose);
+    {
+      if (!TryAttachCachedDataset(value, !d.noTranspose, matrix))
+      {
+        data::Load(value, matrix, true, !d.noTranspose);
+        PublishCachedDataset(value, !d.noTranspose, matrix);
+      }
+    }
     d.loaded = true;
   }
 
@@ -25,6 +25,10 @@ namespace cli {
 // Add default parameters that are included in every program.
 PARAM_FLAG("help", "Default help info.", "h");
 PARAM_STRING_IN("info", "Print help on a specific option.", "", "");
+PARAM_STRING_IN("server", "If specified, run as a persistent server instead "
+    "of running once: listen on a Unix domain socket at the given path and "
+    "run one framed request per invocation, reusing loaded models across "
+    "requests (see binding_server.hpp for the wire format).", "", "");
 PARAM_FLAG("verbose", "Display informational messages and the full list of "
     "parameters and timers at the end of execution.", "v");
 PARAM_FLAG("version", "Display the version of mlpack.", "V");
@@ -0,0 +1,159 @@
+/**
+ * @file bindings/cli/server_protocol.hpp
+ *
+ * The wire protocol of the persistent binding server (see
+ * binding_server.hpp).  These helpers are kept separate from the server loop
+ * so that they can be compiled (and tested) without the binding environment
+ * that parse_command_line.hpp requires.
+ *
+ * The format is deliberately simple; all integers are 32-bit unsigned in
+ * native byte order (clients are on the same host by construction):
+ *
+ *  - request:  argc, then argc repetitions of { length, bytes } -- one
+ *    command-line argument per repetition, without the program name.
+ *  - response: status (0 for success, nonzero for failure), then
+ *    { length, bytes } holding an error message (empty on success).
+ *  - a request with argc equal to 0 asks the server to shut down cleanly.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_SERVER_PROTOCOL_HPP
+#define MLPACK_BINDINGS_CLI_SERVER_PROTOCOL_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+  #include <sys/socket.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #include <cerrno>
+#endif
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+#ifndef _WIN32
+
+/**
+ * Read exactly len bytes from the given socket.  Returns false on EOF or
+ * error.
+ */
+inline bool ReadExact(const int fd, void* buffer, size_t len)
+{
+  char* ptr = (char*) buffer;
+  while (len > 0)
+  {
+    const ssize_t bytes = recv(fd, ptr, len, 0);
+    if (bytes == 0 || (bytes < 0 && errno != EINTR))
+      return false;
+    if (bytes > 0)
+    {
+      ptr += bytes;
+      len -= bytes;
+    }
+  }
+  return true;
+}
+
+/**
+ * Write exactly len bytes to the given socket.  Returns false on error.
+ */
+inline bool WriteExact(const int fd, const void* buffer, size_t len)
+{
+  const char* ptr = (const char*) buffer;
+  while (len > 0)
+  {
+    // MSG_NOSIGNAL: a client that hangs up early should not kill the server
+    // with SIGPIPE.
+    const ssize_t bytes = send(fd, ptr, len, MSG_NOSIGNAL);
+    if (bytes < 0 && errno != EINTR)
+      return false;
+    if (bytes > 0)
+    {
+      ptr += bytes;
+      len -= bytes;
+    }
+  }
+  return true;
+}
+
+/**
+ * Read one framed request from the socket.  Returns false on EOF or a framing
+ * error; sets shutdown to true if the client sent a shutdown request.
+ */
+inline bool ReadRequest(const int fd,
+                        std::vector<std::string>& args,
+                        bool& shutdown)
+{
+  uint32_t count;
+  if (!ReadExact(fd, &count, sizeof(count)))
+    return false;
+
+  if (count == 0)
+  {
+    shutdown = true;
+    return true;
+  }
+
+  args.clear();
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    uint32_t len;
+    if (!ReadExact(fd, &len, sizeof(len)))
+      return false;
+    // Refuse absurd argument lengths so garbage on the socket cannot cause a
+    // huge allocation.
+    if (len > (1 << 20))
+      return false;
+
+    std::string arg(len, '\0');
+    if (len > 0 && !ReadExact(fd, &arg[0], len))
+      return false;
+    args.push_back(std::move(arg));
+  }
+
+  return true;
+}
+
+/**
+ * Write a framed response to the socket.
+ */
+inline void WriteResponse(const int fd,
+                          const uint32_t status,
+                          const std::string& message)
+{
+  const uint32_t len = (uint32_t) message.size();
+  if (!WriteExact(fd, &status, sizeof(status)))
+    return;
+  if (!WriteExact(fd, &len, sizeof(len)))
+    return;
+  if (len > 0)
+    WriteExact(fd, message.data(), len);
+}
+
+/**
+ * Return the modification time of the given file, or 0 if it cannot be
+ * determined.  The server uses this to detect cached models whose file has
+ * been overwritten on disk.
+ */
+inline time_t FileModificationTime(const std::string& filename)
+{
+  struct stat st;
+  if (stat(filename.c_str(), &st) != 0)
+    return 0;
+  return st.st_mtime;
+}
+
+#endif // _WIN32
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -41,6 +41,24 @@ func DataAndInfo() *matrixWithInfo {
   }
 }
 
+// The C++ side borrows the underlying Go arrays of input parameters instead
+// of copying them, so those arrays must stay reachable from Go for as long as
+// the parameters are in use; otherwise the garbage collector may free them
+// under the running binding.  Every borrowed array is recorded here and the
+// record is cleared when the next binding invocation begins (see
+// restoreSettings() in io_util.go).
+var borrowedArrays [][]float64
+
+// Keeps the given array alive until the next binding invocation.
+func retainArray(data []float64) {
+  borrowedArrays = append(borrowedArrays, data)
+}
+
+// Releases the arrays borrowed by the previous binding invocation.
+func clearBorrowedArrays() {
+  borrowedArrays = nil
+}
+
 // Allocates a C memory Pointer via cgo and registers the finalizer
 // in order to free the C memory once the input has been registered in Go.
 func (m *mlpackArma) allocArmaPtrMat(identifier string) {
@@ -96,6 +114,7 @@ func gonumToArmaMat(identifier string, m *mat.Dense) {
   r, c := m.Dims()
   blas64General := m.RawMatrix()
   data := blas64General.Data
+  retainArray(data)
 
   // Pass pointer of the underlying matrix to mlpack.
   ptr := unsafe.Pointer(&data[0])
@@ -130,6 +149,7 @@ func gonumToArmaRow(identifier string, m *mat.Dense) {
 
   blas64General := m.RawMatrix()
   data := blas64General.Data
+  retainArray(data)
 
   // Pass pointer of the underlying matrix to mlpack.
   ptr := unsafe.Pointer(&data[0])
@@ -174,6 +194,7 @@ func gonumToArmaCol(identifier string, m *mat.Dense) {
 
   blas64General := m.RawMatrix()
   data := blas64General.Data
+  retainArray(data)
 
   // Pass pointer of the underlying matrix to mlpack.
   ptr := unsafe.Pointer(&data[0])
@@ -209,6 +230,7 @@ func gonumToArmaMatWithInfo(identifier string, m *matrixWithInfo) {
   r, c := m.Data.Dims()
   blas64General := m.Data.RawMatrix()
   dataAndInfo := blas64General.Data
+  retainArray(dataAndInfo)
   boolarray := m.Categoricals
   // Pass pointer of the underlying matrix to mlpack.
   boolptr := unsafe.Pointer(&boolarray[0])
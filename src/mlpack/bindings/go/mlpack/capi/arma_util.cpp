@@ -27,8 +27,10 @@ extern "C" {
 void mlpackToArmaMat(const char* identifier, double* mat,
                      const size_t row, const size_t col)
 {
-  // Advanced constructor.
-  arma::mat m(mat, row, col, false, true);
+  // Borrow the Go memory with a non-strict alias: moving the alias into the
+  // parameter map transfers the pointer instead of copying the data, so the
+  // binding works directly on the caller's matrix.
+  arma::mat m(mat, row, col, false, false);
 
   // Set input parameter with corresponding matrix in IO.
   SetParam(identifier, m);
@@ -54,8 +56,8 @@ void mlpackToArmaUmat(const char* identifier, double* mat,
  */
 void mlpackToArmaRow(const char* identifier, double* rowvec, const size_t elem)
 {
-  // Advanced constructor.
-  arma::rowvec m(rowvec, elem, false, true);
+  // Borrow the Go memory (see mlpackToArmaMat()).
+  arma::rowvec m(rowvec, elem, false, false);
 
   // Set input parameter with corresponding row in IO.
   SetParam(identifier, m);
@@ -80,8 +82,8 @@ void mlpackToArmaUrow(const char* identifier, double* rowvec, const size_t elem)
  */
 void mlpackToArmaCol(const char* identifier, double* colvec, const size_t elem)
 {
-  // Advanced constructor.
-  arma::colvec m(colvec, elem, false, true);
+  // Borrow the Go memory (see mlpackToArmaMat()).
+  arma::colvec m(colvec, elem, false, false);
 
   // Set input parameter with corresponding column in IO.
   SetParam(identifier, m);
@@ -286,7 +288,8 @@ void mlpackToArmaMatWithInfo(const char* identifier,
         data::Datatype::numeric;
   }
 
-  arma::mat m(memptr, rows, cols, false, true);
+  // Borrow the Go memory (see mlpackToArmaMat()).
+  arma::mat m(memptr, rows, cols, false, false);
   std::get<0>(IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>(
       identifier)) = std::move(d);
   std::get<1>(IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>(
@@ -20,13 +20,16 @@ namespace mlpack {
 
 /**
  * Return the matrix's allocated memory pointer, unless the matrix is using its
- * internal preallocated memory, in which case we copy that and return a
- * pointer to the memory we just made.
+ * internal preallocated memory or is a borrowed alias of the caller's input
+ * memory (mem_state == 1), in which case we copy that and return a pointer to
+ * the memory we just made.  A borrowed alias cannot be handed back as owned
+ * memory: Go would hold a pointer into an input array it may free first.
  */
 template<typename T>
 inline typename T::elem_type* GetMemory(T& m)
 {
-  if (m.mem && m.n_elem <= arma::arma_config::mat_prealloc)
+  if (m.mem && (m.n_elem <= arma::arma_config::mat_prealloc ||
+      m.mem_state == 1))
   {
     // We need to allocate new memory.
     typename T::elem_type* mem =
@@ -63,6 +63,9 @@ func enableVerbose() {
 }
 
 func restoreSettings(method string) {
+  // Arrays borrowed by the previous invocation are no longer referenced by
+  // the C++ side once its parameters have been reset.
+  clearBorrowedArrays()
   C.mlpackRestoreSettings(C.CString(method))
 }
 
@@ -313,6 +313,9 @@ func TestGonumRow(t *testing.T) {
   x := mat.NewDense(9, 1,  []float64{
     1, 2, 3, 4, 5, 6, 7, 8, 9,
   })
+  // The binding borrows x and modifies it in place, so compare against an
+  // up-front copy.
+  xCopy := mat.DenseCopyOf(x)
 
   param := mlpack.TestGoBindingOptions()
   param.RowIn = x
@@ -327,12 +330,17 @@ func TestGonumRow(t *testing.T) {
     t.Errorf("Error. Wrong shape.")
   }
   for i := 0; i < rows; i++ {
-    if RowOut.At(i, 0) != x.At(i, 0)*2 {
+    if RowOut.At(i, 0) != xCopy.At(i, 0)*2 {
       val := RowOut.At(i, 0)
-      expected := x.At(i, 0) * 2
+      expected := xCopy.At(i, 0) * 2
       t.Errorf("Error. Value at [i] : %v. Expected value : %v",
                val, expected)
     }
+    // The in-place modification of x is the zero-copy contract: the binding
+    // operated directly on the caller's memory.
+    if x.At(i, 0) != xCopy.At(i, 0)*2 {
+      t.Errorf("Error. Input not modified in place; it was copied.")
+    }
   }
 }
 
@@ -369,6 +377,9 @@ func TestGonumCol(t *testing.T) {
   x := mat.NewDense(1, 9, []float64{
     1, 2, 3, 4, 5, 6, 7, 8, 9,
   })
+  // The binding borrows x and modifies it in place, so compare against an
+  // up-front copy.
+  xCopy := mat.DenseCopyOf(x)
 
   param := mlpack.TestGoBindingOptions()
   param.ColIn = x
@@ -383,12 +394,17 @@ func TestGonumCol(t *testing.T) {
     t.Errorf("Error. Wrong shape.")
   }
   for i := 0; i < cols; i++ {
-    if ColOut.At(0, i) != x.At(0, i)*2 {
+    if ColOut.At(0, i) != xCopy.At(0, i)*2 {
       val := ColOut.At(0, i)
-      expected := x.At(0, i) * 2
+      expected := xCopy.At(0, i) * 2
       t.Errorf("Error. Value at [i] : %v. Expected value : %v",
                val, expected)
     }
+    // The in-place modification of x is the zero-copy contract: the binding
+    // operated directly on the caller's memory.
+    if x.At(0, i) != xCopy.At(0, i)*2 {
+      t.Errorf("Error. Input not modified in place; it was copied.")
+    }
   }
 }
 
@@ -549,6 +565,10 @@ func TestGonumMatrixWithInfo(t *testing.T) {
            11, 12, 13, 14, 15,
   })
 
+  // The binding borrows x.Data and modifies it in place, so compare against
+  // an up-front copy.
+  xCopy := mat.DenseCopyOf(x.Data)
+
   param := mlpack.TestGoBindingOptions()
   param.MatrixAndInfoIn = x
   d := 4.0
@@ -564,9 +584,9 @@ func TestGonumMatrixWithInfo(t *testing.T) {
   }
   for i := 0; i < rows; i++ {
     for j := 0; j < cols; j++ {
-      if x.Data.At(i, j)*2 != MatrixAndInfoOut.At(i, j) {
+      if xCopy.At(i, j)*2 != MatrixAndInfoOut.At(i, j) {
         val := MatrixAndInfoOut.At(i, j)
-        expected := x.Data.At(i, j)*2
+        expected := xCopy.At(i, j)*2
         t.Errorf("Error. Value at [%v,%v] : %v. Expected value : %v",
                  i, j, val, expected)
       }
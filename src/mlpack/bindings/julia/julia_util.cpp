@@ -111,8 +111,11 @@ void IO_SetParamMat(const char* paramName,
                     const size_t cols,
                     const bool pointsAsRows)
 {
-  // Create the matrix as an alias.
-  arma::mat m(memptr, arma::uword(rows), arma::uword(cols), false, true);
+  // Create the matrix as a non-strict alias of the Julia memory; moving it
+  // into the parameter map transfers the alias instead of copying the data.
+  // Transposing still copies, since the points-as-rows convention changes the
+  // element order.
+  arma::mat m(memptr, arma::uword(rows), arma::uword(cols), false, false);
   IO::GetParam<arma::mat>(paramName) = pointsAsRows ? m.t() : std::move(m);
   IO::SetPassed(paramName);
 }
@@ -126,9 +129,9 @@ void IO_SetParamUMat(const char* paramName,
                      const size_t cols,
                      const bool pointsAsRows)
 {
-  // Create the matrix as an alias.
+  // Create the matrix as a non-strict alias (see IO_SetParamMat()).
   arma::Mat<size_t> m(memptr, arma::uword(rows), arma::uword(cols), false,
-      true);
+      false);
   IO::GetParam<arma::Mat<size_t>>(paramName) = pointsAsRows ? m.t() :
       std::move(m);
   IO::SetPassed(paramName);
@@ -141,7 +144,8 @@ void IO_SetParamRow(const char* paramName,
                     double* memptr,
                     const size_t cols)
 {
-  arma::rowvec m(memptr, arma::uword(cols), false, true);
+  // Create the vector as a non-strict alias (see IO_SetParamMat()).
+  arma::rowvec m(memptr, arma::uword(cols), false, false);
   IO::GetParam<arma::rowvec>(paramName) = std::move(m);
   IO::SetPassed(paramName);
 }
@@ -153,7 +157,8 @@ void IO_SetParamURow(const char* paramName,
                      size_t* memptr,
                      const size_t cols)
 {
-  arma::Row<size_t> m(memptr, arma::uword(cols), false, true);
+  // Create the vector as a non-strict alias (see IO_SetParamMat()).
+  arma::Row<size_t> m(memptr, arma::uword(cols), false, false);
   IO::GetParam<arma::Row<size_t>>(paramName) = std::move(m);
   IO::SetPassed(paramName);
 }
@@ -165,7 +170,8 @@ void IO_SetParamCol(const char* paramName,
                     double* memptr,
                     const size_t rows)
 {
-  arma::vec m(memptr, arma::uword(rows), false, true);
+  // Create the vector as a non-strict alias (see IO_SetParamMat()).
+  arma::vec m(memptr, arma::uword(rows), false, false);
   IO::GetParam<arma::vec>(paramName) = std::move(m);
   IO::SetPassed(paramName);
 }
@@ -177,7 +183,8 @@ void IO_SetParamUCol(const char* paramName,
                      size_t* memptr,
                      const size_t rows)
 {
-  arma::Col<size_t> m(memptr, arma::uword(rows), false, true);
+  // Create the vector as a non-strict alias (see IO_SetParamMat()).
+  arma::Col<size_t> m(memptr, arma::uword(rows), false, false);
   IO::GetParam<arma::Col<size_t>>(paramName) = std::move(m);
   IO::SetPassed(paramName);
 }
@@ -199,7 +206,8 @@ void IO_SetParamMatWithInfo(const char* paramName,
         data::Datatype::numeric;
   }
 
-  arma::mat m(memptr, arma::uword(rows), arma::uword(cols), false, true);
+  // Create the matrix as a non-strict alias (see IO_SetParamMat()).
+  arma::mat m(memptr, arma::uword(rows), arma::uword(cols), false, false);
   std::get<0>(IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>(
       paramName)) = std::move(d);
   std::get<1>(IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>(
@@ -303,10 +311,12 @@ size_t IO_GetParamMatCols(const char* paramName)
  */
 double* IO_GetParamMat(const char* paramName)
 {
-  // Are we using preallocated memory?  If so we have to handle this more
-  // carefully.
+  // Are we using preallocated memory, or memory borrowed from the Julia
+  // caller (mem_state == 1)?  If so we have to handle this more carefully:
+  // ownership of borrowed memory cannot be given away, since Julia will free
+  // the returned pointer.
   arma::mat& mat = IO::GetParam<arma::mat>(paramName);
-  if (mat.n_elem <= arma::arma_config::mat_prealloc)
+  if (mat.n_elem <= arma::arma_config::mat_prealloc || mat.mem_state == 1)
   {
     // Copy the memory to something that we can give back to Julia.
     double* newMem = new double[mat.n_elem];
@@ -348,9 +358,9 @@ size_t* IO_GetParamUMat(const char* paramName)
 {
   arma::Mat<size_t>& mat = IO::GetParam<arma::Mat<size_t>>(paramName);
 
-  // Are we using preallocated memory?  If so we have to handle this more
-  // carefully.
-  if (mat.n_elem <= arma::arma_config::mat_prealloc)
+  // Are we using preallocated or borrowed memory?  If so we have to handle
+  // this more carefully (see IO_GetParamMat()).
+  if (mat.n_elem <= arma::arma_config::mat_prealloc || mat.mem_state == 1)
   {
     // Copy the memory to something that we can give back to Julia.
     size_t* newMem = new size_t[mat.n_elem];
@@ -382,10 +392,10 @@ size_t IO_GetParamColRows(const char* paramName)
  */
 double* IO_GetParamCol(const char* paramName)
 {
-  // Are we using preallocated memory?  If so we have to handle this more
-  // carefully.
+  // Are we using preallocated or borrowed memory?  If so we have to handle
+  // this more carefully (see IO_GetParamMat()).
   arma::vec& vec = IO::GetParam<arma::vec>(paramName);
-  if (vec.n_elem <= arma::arma_config::mat_prealloc)
+  if (vec.n_elem <= arma::arma_config::mat_prealloc || vec.mem_state == 1)
   {
     // Copy the memory to something we can give back to Julia.
     double* newMem = new double[vec.n_elem];
@@ -419,9 +429,9 @@ size_t* IO_GetParamUCol(const char* paramName)
 {
   arma::Col<size_t>& vec = IO::GetParam<arma::Col<size_t>>(paramName);
 
-  // Are we using preallocated memory?  If so we have to handle this more
-  // carefully.
-  if (vec.n_elem <= arma::arma_config::mat_prealloc)
+  // Are we using preallocated or borrowed memory?  If so we have to handle
+  // this more carefully (see IO_GetParamMat()).
+  if (vec.n_elem <= arma::arma_config::mat_prealloc || vec.mem_state == 1)
   {
     // Copy the memory to something we can give back to Julia.
     size_t* newMem = new size_t[vec.n_elem];
@@ -453,10 +463,10 @@ size_t IO_GetParamRowCols(const char* paramName)
  */
 double* IO_GetParamRow(const char* paramName)
 {
-  // Are we using preallocated memory?  If so we have to handle this more
-  // carefully.
+  // Are we using preallocated or borrowed memory?  If so we have to handle
+  // this more carefully (see IO_GetParamMat()).
   arma::rowvec& vec = IO::GetParam<arma::rowvec>(paramName);
-  if (vec.n_elem <= arma::arma_config::mat_prealloc)
+  if (vec.n_elem <= arma::arma_config::mat_prealloc || vec.mem_state == 1)
   {
     // Copy the memory to something we can give back to Julia.
     double* newMem = new double[vec.n_elem];
@@ -490,9 +500,9 @@ size_t* IO_GetParamURow(const char* paramName)
 {
   arma::Row<size_t>& vec = IO::GetParam<arma::Row<size_t>>(paramName);
 
-  // Are we using preallocated memory?  If so we have to handle this more
-  // carefully.
-  if (vec.n_elem <= arma::arma_config::mat_prealloc)
+  // Are we using preallocated or borrowed memory?  If so we have to handle
+  // this more carefully (see IO_GetParamMat()).
+  if (vec.n_elem <= arma::arma_config::mat_prealloc || vec.mem_state == 1)
   {
     // Copy the memory to something we can give back to Julia.
     size_t* newMem = new size_t[vec.n_elem];
@@ -550,11 +560,11 @@ bool* IO_GetParamMatWithInfoBoolPtr(const char* paramName)
  */
 double* IO_GetParamMatWithInfoPtr(const char* paramName)
 {
-  // Are we using preallocated memory?  If so we have to handle this more
-  // carefully.
+  // Are we using preallocated or borrowed memory?  If so we have to handle
+  // this more carefully (see IO_GetParamMat()).
   arma::mat& m = std::get<1>(
       IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>(paramName));
-  if (m.n_elem <= arma::arma_config::mat_prealloc)
+  if (m.n_elem <= arma::arma_config::mat_prealloc || m.mem_state == 1)
   {
     double* newMem = new double[m.n_elem];
     arma::arrayops::copy(newMem, m.mem, m.n_elem);
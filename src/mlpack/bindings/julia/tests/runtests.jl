@@ -181,6 +181,9 @@ end
 # Test a column vector input parameter.
 @testset "TestCol" begin
   x = rand(100)
+  # The binding borrows x and modifies it in place, so compare against an
+  # up-front copy.
+  xCopy = copy(x)
 
   colOut, _, _, _, _, _, _, _, _, _, _, _, _, _ =
       test_julia_binding(4.0, 12, "hello",
@@ -190,7 +193,10 @@ end
   @test typeof(colOut) == Array{Float64, 1}
 
   for i in 1:100
-    @test colOut[i] == 2 * x[i]
+    @test colOut[i] == 2 * xCopy[i]
+    # The in-place modification of x is the zero-copy contract: the binding
+    # operated directly on the caller's memory.
+    @test x[i] == 2 * xCopy[i]
   end
 end
 
@@ -214,6 +220,9 @@ end
 # Test a row vector input parameter.
 @testset "TestRow" begin
   x = rand(100)
+  # The binding borrows x and modifies it in place, so compare against an
+  # up-front copy.
+  xCopy = copy(x)
 
   _, _, _, _, _, _, _, rowOut, _, _, _, _, _, _ =
       test_julia_binding(4.0, 12, "hello",
@@ -222,7 +231,10 @@ end
   @test size(rowOut, 1) == 100
   @test typeof(rowOut) == Array{Float64, 1}
   for i in 1:100
-    @test rowOut[i] == 2 * x[i]
+    @test rowOut[i] == 2 * xCopy[i]
+    # The in-place modification of x is the zero-copy contract: the binding
+    # operated directly on the caller's memory.
+    @test x[i] == 2 * xCopy[i]
   end
 end
 
@@ -249,6 +261,9 @@ end
   # Dimension information.
   dims = [false, false, false, false, false, false, false, false, false, false]
   z = x
+  # The binding borrows z and modifies it in place, so compare against an
+  # up-front copy.
+  zCopy = copy(z)
 
   _, _, _, matrix_and_info_out, _, _, _,  _, _, _, _, _, _, _ =
       test_julia_binding(4.0, 12, "hello",
@@ -260,7 +275,7 @@ end
 
   for i in 1:100
     for j in 1:10
-      @test matrix_and_info_out[j, i] == 2.0 * z[j, i]
+      @test matrix_and_info_out[j, i] == 2.0 * zCopy[j, i]
     end
   end
 end
@@ -12,6 +12,11 @@ object, then the numpy object will "own" the matrix.
 Thus, know that if you convert a matrix type, remember that the resulting type
 is what "owns" the allocated memory.
 
+If a numpy object is C-contiguous but does not own its memory (e.g. it is a
+view of some other array), the Armadillo object will simply alias the borrowed
+memory; a copy is only made when the layout genuinely mismatches or when
+ownership must be transferred and numpy itself does not own the memory.
+
 mlpack is free software; you may redistribute it and/or modify it under the
 terms of the 3-clause BSD license.  You should have received a copy of the
 3-clause BSD license along with mlpack.  If not, see
@@ -46,12 +51,17 @@ cdef extern from "<mlpack/bindings/python/mlpack/arma_util.hpp>":
 cdef arma.Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X, \
                                       bool takeOwnership) except +:
   """
-  Convert a numpy ndarray to a matrix.  The memory will still be owned by numpy.
+  Convert a numpy ndarray to a matrix.  The memory will still be owned by
+  numpy, and no copy is made unless the array is not C-contiguous.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory.
+  if not X.flags.c_contiguous:
+    # The layout genuinely mismatches, so we must copy into C order.
     X = X.copy(order="C")
     takeOwnership = True
+  elif takeOwnership and not X.flags.owndata and not isWin:
+    # We cannot take ownership of memory that numpy itself does not own (e.g.
+    # a view); make a copy that we can hand off to Armadillo.
+    X = X.copy(order="C")
 
   cdef arma.Mat[double]* m = new arma.Mat[double](<double*> X.data, X.shape[1],\
       X.shape[0], isWin, False)
@@ -66,13 +76,18 @@ cdef arma.Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X, \
 cdef arma.Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X, \
                                       bool takeOwnership) except +:
   """
-  Convert a numpy ndarray to a matrix.  The memory will still be owned by numpy.
+  Convert a numpy ndarray to a matrix.  The memory will still be owned by
+  numpy, and no copy is made unless the array is not C-contiguous.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not X.flags.c_contiguous:
+    # The layout genuinely mismatches, so we must copy into C order.  On
+    # Windows the advanced constructor below copies anyway.
     X = X.copy(order="C")
     takeOwnership = True
+  elif takeOwnership and not X.flags.owndata and not isWin:
+    # We cannot take ownership of memory that numpy itself does not own (e.g.
+    # a view); make a copy that we can hand off to Armadillo.
+    X = X.copy(order="C")
 
   cdef arma.Mat[size_t]* m = new arma.Mat[size_t](<size_t*> X.data, X.shape[1],
       X.shape[0], isWin, False)
@@ -130,13 +145,17 @@ cdef arma.Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
                                       bool takeOwnership) except +:
   """
   Convert a numpy one-dimensional ndarray to a row.  The memory will still be
-  owned by numpy.
+  owned by numpy, and no copy is made unless the array is not contiguous.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not X.flags.c_contiguous:
+    # The layout genuinely mismatches, so we must copy into C order.  On
+    # Windows the advanced constructor below copies anyway.
     X = X.copy(order="C")
     takeOwnership = True
+  elif takeOwnership and not X.flags.owndata and not isWin:
+    # We cannot take ownership of memory that numpy itself does not own (e.g.
+    # a view); make a copy that we can hand off to Armadillo.
+    X = X.copy(order="C")
 
   cdef arma.Row[double]* m = new arma.Row[double](<double*> X.data, X.shape[0],
       isWin, False)
@@ -152,13 +171,17 @@ cdef arma.Row[size_t]* numpy_to_row_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
                                       bool takeOwnership) except +:
   """
   Convert a numpy one-dimensional ndarray to a row.  The memory will still be
-  owned by numpy.
+  owned by numpy, and no copy is made unless the array is not contiguous.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not X.flags.c_contiguous:
+    # The layout genuinely mismatches, so we must copy into C order.  On
+    # Windows the advanced constructor below copies anyway.
     X = X.copy(order="C")
     takeOwnership = True
+  elif takeOwnership and not X.flags.owndata and not isWin:
+    # We cannot take ownership of memory that numpy itself does not own (e.g.
+    # a view); make a copy that we can hand off to Armadillo.
+    X = X.copy(order="C")
 
   cdef arma.Row[size_t]* m = new arma.Row[size_t](<size_t*> X.data, X.shape[0],
       isWin, False)
@@ -213,13 +236,18 @@ cdef arma.Col[double]* numpy_to_col_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
                                       bool takeOwnership) except +:
   """
   Convert a numpy one-dimensional ndarray to a column vector.  The memory will
-  still be owned by numpy.
+  still be owned by numpy, and no copy is made unless the array is not
+  contiguous.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not X.flags.c_contiguous:
+    # The layout genuinely mismatches, so we must copy into C order.  On
+    # Windows the advanced constructor below copies anyway.
     X = X.copy(order="C")
     takeOwnership = True
+  elif takeOwnership and not X.flags.owndata and not isWin:
+    # We cannot take ownership of memory that numpy itself does not own (e.g.
+    # a view); make a copy that we can hand off to Armadillo.
+    X = X.copy(order="C")
 
   cdef arma.Col[double]* m = new arma.Col[double](<double*> X.data, X.shape[0],
       isWin, False)
@@ -235,13 +263,18 @@ cdef arma.Col[size_t]* numpy_to_col_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
                                       bool takeOwnership) except +:
   """
   Convert a numpy one-dimensional ndarray to a column vector.  The memory will
-  still be owned by numpy.
+  still be owned by numpy, and no copy is made unless the array is not
+  contiguous.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not X.flags.c_contiguous:
+    # The layout genuinely mismatches, so we must copy into C order.  On
+    # Windows the advanced constructor below copies anyway.
     X = X.copy(order="C")
     takeOwnership = True
+  elif takeOwnership and not X.flags.owndata and not isWin:
+    # We cannot take ownership of memory that numpy itself does not own (e.g.
+    # a view); make a copy that we can hand off to Armadillo.
+    X = X.copy(order="C")
 
   cdef arma.Col[size_t]* m = new arma.Col[size_t](<size_t*> X.data, X.shape[0],
       isWin, False)
@@ -46,6 +46,7 @@ cdef extern from "<mlpack/bindings/python/mlpack/io_util.hpp>" \
   void SetParam[T](string, T&) nogil except +
   void SetParamPtr[T](string, T*, bool) nogil except +
   void SetParamWithInfo[T](string, T&, const bool*) nogil except +
+  void CopyParamToBuffer[T](string, T&) nogil except +
   (T*) GetParamPtr[T](string) nogil except +
   (T&) GetParamWithInfo[T](string) nogil except +
   void EnableVerbose() nogil except +
@@ -101,6 +101,33 @@ inline void SetParamWithInfo(const std::string& identifier,
   }
 }
 
+/**
+ * Copy the value of an output matrix parameter into a preallocated buffer,
+ * instead of transferring ownership of the parameter's memory.  The buffer
+ * will generally be an alias of memory owned by the caller (e.g. a numpy
+ * array), so it must already have the right shape: a reallocation would
+ * silently detach from the caller's memory, so we throw instead.
+ *
+ * @param identifier Name of (output) parameter.
+ * @param buffer Preallocated buffer to copy the parameter's value into.
+ */
+template<typename T>
+inline void CopyParamToBuffer(const std::string& identifier, T& buffer)
+{
+  const T& value = IO::GetParam<T>(identifier);
+  if (buffer.n_rows != value.n_rows || buffer.n_cols != value.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "Output buffer for parameter '" << identifier << "' has shape "
+        << buffer.n_rows << "x" << buffer.n_cols << ", but the output has "
+        << "shape " << value.n_rows << "x" << value.n_cols << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // A same-size assignment fills the aliased memory in place.
+  buffer = value;
+}
+
 /**
  * Return a pointer.  This function exists to work around Cython's seeming lack
  * of support for template pointer types.
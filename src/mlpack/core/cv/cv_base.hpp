@@ -98,6 +98,36 @@ class CVBase
                     const WeightsType& weights,
                     const MLAlgorithmArgs&... args);
 
+  /**
+   * Retrain an already constructed MLAlgorithm model in place with the given
+   * data points and predictions.  Return true if MLAlgorithm provides a
+   * Train() member function that accepts the stored basic parameters (like
+   * datasetInfo and numClasses), and false if the model has to be
+   * reconstructed instead.  Hyperparameters are passed to the constructor of
+   * MLAlgorithm and may not map onto the parameters of Train(), so in-place
+   * retraining is attempted only when no hyperparameters are given.  Models
+   * whose Train() continues from the current parameters are warm-started by
+   * the previous solution.
+   */
+  template<typename... MLAlgorithmArgs>
+  bool TrainInPlace(MLAlgorithm& model,
+                    const MatType& xs,
+                    const PredictionsType& ys,
+                    const MLAlgorithmArgs&... args);
+
+  /**
+   * Retrain an already constructed MLAlgorithm model in place with the given
+   * data points, predictions, and weights.  Return true if MLAlgorithm
+   * provides a suitable Train() member function, and false if the model has
+   * to be reconstructed instead.
+   */
+  template<typename... MLAlgorithmArgs>
+  bool TrainInPlace(MLAlgorithm& model,
+                    const MatType& xs,
+                    const PredictionsType& ys,
+                    const WeightsType& weights,
+                    const MLAlgorithmArgs&... args);
+
  private:
   static_assert(MIE::IsSupported,
       "The given MLAlgorithm is not supported by MetaInfoExtractor");
@@ -121,6 +151,25 @@ class CVBase
   static void AssertWeightsSize(const MatType& xs,
                                 const WeightsType& weights);
 
+  /**
+   * Call Train() on the given model if the expression is valid for
+   * MLAlgorithm.
+   */
+  template<typename... TrainArgs>
+  auto TryTrainInPlace(const int /* dispatchToMemberTrain */,
+                       MLAlgorithm& model,
+                       const TrainArgs&... args)
+      -> decltype(void(model.Train(args...)), bool());
+
+  /**
+   * Report that MLAlgorithm does not provide a suitable Train() member
+   * function.
+   */
+  template<typename... TrainArgs>
+  bool TryTrainInPlace(const long /* dispatchToMemberTrain */,
+                       MLAlgorithm& model,
+                       const TrainArgs&... args);
+
   /**
    * Construct a trained MLAlgorithm model if MLAlgorithm doesn't take the
    * numClasses parameter.
@@ -98,6 +98,93 @@ MLAlgorithm CVBase<MLAlgorithm,
   return TrainModel(xs, ys, weights, args...);
 }
 
+template<typename MLAlgorithm,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+bool CVBase<MLAlgorithm,
+            MatType,
+            PredictionsType,
+            WeightsType>::TrainInPlace(MLAlgorithm& model,
+                                       const MatType& xs,
+                                       const PredictionsType& ys,
+                                       const MLAlgorithmArgs&... /* args */)
+{
+  // Hyperparameters are applied through the constructor of MLAlgorithm, and
+  // there is no guarantee they map onto the parameters of its Train() member
+  // function, so in-place retraining is attempted only when the configuration
+  // is fully described by the stored datasetInfo and numClasses parameters.
+  if (sizeof...(MLAlgorithmArgs) > 0)
+    return false;
+
+  if (isDatasetInfoPassed)
+    return TryTrainInPlace(0, model, xs, datasetInfo, ys, numClasses);
+  else if (MIE::TakesNumClasses)
+    return TryTrainInPlace(0, model, xs, ys, numClasses);
+  else
+    return TryTrainInPlace(0, model, xs, ys);
+}
+
+template<typename MLAlgorithm,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+bool CVBase<MLAlgorithm,
+            MatType,
+            PredictionsType,
+            WeightsType>::TrainInPlace(MLAlgorithm& model,
+                                       const MatType& xs,
+                                       const PredictionsType& ys,
+                                       const WeightsType& weights,
+                                       const MLAlgorithmArgs&... /* args */)
+{
+  if (sizeof...(MLAlgorithmArgs) > 0)
+    return false;
+
+  if (isDatasetInfoPassed)
+    return TryTrainInPlace(0, model, xs, datasetInfo, ys, numClasses, weights);
+  else if (MIE::TakesNumClasses)
+    return TryTrainInPlace(0, model, xs, ys, numClasses, weights);
+  else
+    return TryTrainInPlace(0, model, xs, ys, weights);
+}
+
+template<typename MLAlgorithm,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... TrainArgs>
+auto CVBase<MLAlgorithm,
+            MatType,
+            PredictionsType,
+            WeightsType>::TryTrainInPlace(
+    const int /* dispatchToMemberTrain */,
+    MLAlgorithm& model,
+    const TrainArgs&... args)
+    -> decltype(void(model.Train(args...)), bool())
+{
+  model.Train(args...);
+  return true;
+}
+
+template<typename MLAlgorithm,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... TrainArgs>
+bool CVBase<MLAlgorithm,
+            MatType,
+            PredictionsType,
+            WeightsType>::TryTrainInPlace(
+    const long /* dispatchToMemberTrain */,
+    MLAlgorithm& /* model */,
+    const TrainArgs&... /* args */)
+{
+  return false;
+}
+
 template<typename MLAlgorithm,
          typename MatType,
          typename PredictionsType,
@@ -177,9 +177,34 @@ class KFoldCV
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs& ...args);
 
+  /**
+   * Copy another KFoldCV object.  The model from the last run (if any) is
+   * deep-copied, so the copy can be evaluated independently of (and
+   * concurrently with) the original.
+   */
+  KFoldCV(const KFoldCV& other);
+
   //! Access and modify a model from the last run of k-fold cross-validation.
   MLAlgorithm& Model();
 
+  //! Get whether the folds will be trained and evaluated in parallel.
+  bool Parallel() const { return parallel; }
+  //! Modify whether the folds will be trained and evaluated in parallel
+  //! (default false).  The folds are independent, so each can be handled by
+  //! its own thread; the per-fold scores are still aggregated in fold order,
+  //! so the result does not depend on thread scheduling.
+  bool& Parallel() { return parallel; }
+
+  //! Get the number of threads used for fold-level parallelism.
+  size_t NumThreads() const { return numThreads; }
+  //! Modify the number of threads used for fold-level parallelism (0, the
+  //! default, means all available threads).  When training algorithms that
+  //! are themselves parallel, set this to fewer threads to leave cores for
+  //! model-level parallelism; nested OpenMP parallelism is disabled by
+  //! default, so fold-level threads and model-level threads will not
+  //! oversubscribe the machine unless it has been explicitly enabled.
+  size_t& NumThreads() { return numThreads; }
+
  private:
   //! A short alias for CVBase.
   using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
@@ -225,6 +250,12 @@ class KFoldCV
   //! A pointer to a model from the last run of k-fold cross-validation.
   std::unique_ptr<MLAlgorithm> modelPtr;
 
+  //! Whether to train and evaluate the folds in parallel.
+  bool parallel = false;
+
+  //! The number of threads to use for fold-level parallelism (0 = all).
+  size_t numThreads = 0;
+
   /**
    * Assert the k parameter and data consistency and initialize fields required
    * for running k-fold cross-validation.
@@ -179,6 +179,29 @@ KFoldCV<MLAlgorithm,
     Shuffle();
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+KFoldCV<MLAlgorithm,
+        Metric,
+        MatType,
+        PredictionsType,
+        WeightsType>::KFoldCV(const KFoldCV& other) :
+    base(other.base),
+    k(other.k),
+    xs(other.xs),
+    ys(other.ys),
+    weights(other.weights),
+    lastBinSize(other.lastBinSize),
+    binSize(other.binSize),
+    modelPtr(other.modelPtr == nullptr ?
+        nullptr : new MLAlgorithm(*other.modelPtr)),
+    parallel(other.parallel),
+    numThreads(other.numThreads)
+{ /* Nothing left to do. */ }
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -246,13 +269,36 @@ double KFoldCV<MLAlgorithm,
 {
   arma::vec evaluations(k);
 
-  size_t numInvalidScores = 0;
-  for (size_t i = 0; i < k; ++i)
+  // The folds are independent, so they can be trained and evaluated
+  // concurrently.  Each iteration only writes its own entry of 'evaluations'
+  // (and the last fold's model), and the scores are aggregated in fold order
+  // below, so the result does not depend on scheduling.
+  #ifdef HAS_OPENMP
+    const size_t foldThreads = (numThreads == 0) ?
+        (size_t) omp_get_max_threads() : numThreads;
+  #else
+    const size_t foldThreads = 1;
+  #endif
+
+  if (parallel)
+    Log::Info << "KFoldCV::TrainAndEvaluate(): running " << k << " folds on "
+        << foldThreads << " threads." << std::endl;
+
+  #pragma omp parallel for schedule(dynamic) num_threads(foldThreads) \
+      if (parallel)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
     MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
         GetTrainingSubset(ys, i), args...);
     evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
         GetValidationSubset(ys, i));
+    if (i == (omp_size_t) k - 1)
+      modelPtr.reset(new MLAlgorithm(std::move(model)));
+  }
+
+  size_t numInvalidScores = 0;
+  for (size_t i = 0; i < k; ++i)
+  {
     if (std::isnan(evaluations(i)) || std::isinf(evaluations(i)))
     {
       ++numInvalidScores;
@@ -260,8 +306,6 @@ double KFoldCV<MLAlgorithm,
           << "a score of " << evaluations(i) << "; ignoring when computing "
           << "the average score." << std::endl;
     }
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
   if (numInvalidScores == k)
@@ -288,7 +332,22 @@ double KFoldCV<MLAlgorithm,
 {
   arma::vec evaluations(k);
 
-  for (size_t i = 0; i < k; ++i)
+  // As in the unweighted case, the folds are independent and can run
+  // concurrently; each iteration writes only its own score.
+  #ifdef HAS_OPENMP
+    const size_t foldThreads = (numThreads == 0) ?
+        (size_t) omp_get_max_threads() : numThreads;
+  #else
+    const size_t foldThreads = 1;
+  #endif
+
+  if (parallel)
+    Log::Info << "KFoldCV::TrainAndEvaluate(): running " << k << " folds on "
+        << foldThreads << " threads." << std::endl;
+
+  #pragma omp parallel for schedule(dynamic) num_threads(foldThreads) \
+      if (parallel)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
     MLAlgorithm&& model = (weights.n_elem > 0) ?
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
@@ -297,7 +356,7 @@ double KFoldCV<MLAlgorithm,
             args...);
     evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
         GetValidationSubset(ys, i));
-    if (i == k - 1)
+    if (i == (omp_size_t) k - 1)
       modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
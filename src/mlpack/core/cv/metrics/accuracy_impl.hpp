@@ -12,6 +12,8 @@
 #ifndef MLPACK_CORE_CV_METRICS_ACCURACY_IMPL_HPP
 #define MLPACK_CORE_CV_METRICS_ACCURACY_IMPL_HPP
 
+#include <mlpack/core/data/incremental_confusion_matrix.hpp>
+
 namespace mlpack {
 namespace cv {
 
@@ -24,9 +26,13 @@ double Accuracy::Evaluate(MLAlgorithm& model,
 
   arma::Row<size_t> predictedLabels;
   model.Classify(data, predictedLabels);
-  size_t amountOfCorrectPredictions = arma::sum(predictedLabels == labels);
 
-  return (double) amountOfCorrectPredictions / labels.n_elem;
+  const size_t numClasses =
+      std::max(arma::max(labels), arma::max(predictedLabels)) + 1;
+  data::IncrementalConfusionMatrix cm(numClasses);
+  cm.Update(predictedLabels, labels);
+
+  return cm.Accuracy();
 }
 
 } // namespace cv
@@ -0,0 +1,66 @@
+/**
+ * @file davies_bouldin_index.hpp
+ * @author Ryan Curtin
+ *
+ * The Davies-Bouldin index.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_DAVIES_BOULDIN_INDEX_HPP
+#define MLPACK_CORE_CV_METRICS_DAVIES_BOULDIN_INDEX_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace cv {
+
+/**
+ * The Davies-Bouldin index is a metric of performance for clustering that
+ * measures the average similarity between each cluster and the cluster most
+ * similar to it, where similarity trades off within-cluster scatter against
+ * between-centroid separation.  For cluster @f$ i @f$ with centroid
+ * @f$ c_i @f$, let @f$ S_i @f$ be the average distance of the cluster's
+ * points to @f$ c_i @f$, and let @f$ M_{ij} @f$ be the distance between
+ * centroids @f$ c_i @f$ and @f$ c_j @f$.  Then
+ * @f{eqnarray*}{
+ * DB &=& \frac{1}{k} \sum_{i=1}^{k} \max_{j \neq i}
+ *     \frac{S_i + S_j}{M_{ij}}
+ * @f}
+ * Lower values indicate better clustering; the minimum possible value is
+ * zero.  Unlike the silhouette score, the index depends only on distances to
+ * the @f$ k @f$ cluster centroids, so it costs @f$ O(nk) @f$ distance
+ * evaluations instead of @f$ O(n^2) @f$.
+ */
+class DaviesBouldinIndex
+{
+ public:
+  /**
+   * Find the Davies-Bouldin index of the clustering.
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @return (double) Davies-Bouldin index.
+   */
+  template<typename DataType, typename Metric>
+  static double Overall(const DataType& X,
+                        const arma::Row<size_t>& labels,
+                        const Metric& metric);
+
+  /**
+   * Information for hyper-parameter tuning code. It indicates that we want
+   * to minimize the metric.
+   */
+  static const bool NeedsMinimization = true;
+};
+
+} // namespace cv
+} // namespace mlpack
+
+// Include implementation.
+#include "davies_bouldin_index_impl.hpp"
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file davies_bouldin_index_impl.hpp
+ * @author Ryan Curtin
+ *
+ * The implementation of the class DaviesBouldinIndex.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_DAVIES_BOULDIN_INDEX_IMPL_HPP
+#define MLPACK_CORE_CV_METRICS_DAVIES_BOULDIN_INDEX_IMPL_HPP
+
+#include <mlpack/core/cv/metrics/facilities.hpp>
+
+namespace mlpack {
+namespace cv {
+
+template<typename DataType, typename Metric>
+double DaviesBouldinIndex::Overall(const DataType& X,
+                                   const arma::Row<size_t>& labels,
+                                   const Metric& metric)
+{
+  util::CheckSameSizes(X, labels, "DaviesBouldinIndex::Overall()");
+
+  // Map the (arbitrary) label values to consecutive cluster indices.
+  const arma::ucolvec clusterLabels = arma::find_unique(labels, false);
+  const size_t numClusters = clusterLabels.n_elem;
+  if (numClusters < 2)
+  {
+    throw std::invalid_argument("DaviesBouldinIndex::Overall(): at least two "
+        "clusters are required!");
+  }
+
+  std::unordered_map<size_t, size_t> clusterOf;
+  for (size_t j = 0; j < numClusters; ++j)
+    clusterOf[labels(clusterLabels(j))] = j;
+
+  // Compute the cluster centroids.
+  arma::mat centroids(X.n_rows, numClusters, arma::fill::zeros);
+  arma::Col<size_t> counts(numClusters, arma::fill::zeros);
+  for (size_t i = 0; i < X.n_cols; ++i)
+  {
+    const size_t cluster = clusterOf[labels(i)];
+    centroids.col(cluster) += X.col(i);
+    ++counts[cluster];
+  }
+  for (size_t j = 0; j < numClusters; ++j)
+    centroids.col(j) /= counts[j];
+
+  // Compute the within-cluster scatter: the average distance of each
+  // cluster's points to its centroid.
+  arma::vec scatter(numClusters, arma::fill::zeros);
+  for (size_t i = 0; i < X.n_cols; ++i)
+  {
+    const size_t cluster = clusterOf[labels(i)];
+    scatter[cluster] += metric.Evaluate(X.col(i), centroids.col(cluster));
+  }
+  for (size_t j = 0; j < numClusters; ++j)
+    scatter[j] /= counts[j];
+
+  // For each cluster, find the worst (largest) similarity ratio with any
+  // other cluster.  The number of clusters is small, so the O(k^2) loop over
+  // centroid pairs is cheap.
+  double index = 0.0;
+  for (size_t i = 0; i < numClusters; ++i)
+  {
+    double maxSimilarity = 0.0;
+    for (size_t j = 0; j < numClusters; ++j)
+    {
+      if (j == i)
+        continue;
+
+      const double separation = metric.Evaluate(centroids.col(i),
+          centroids.col(j));
+      const double similarity = (scatter[i] + scatter[j]) / separation;
+      if (similarity > maxSimilarity)
+        maxSimilarity = similarity;
+    }
+
+    index += maxSimilarity;
+  }
+
+  return index / numClusters;
+}
+
+} // namespace cv
+} // namespace mlpack
+
+#endif
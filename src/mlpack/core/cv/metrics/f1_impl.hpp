@@ -13,6 +13,7 @@
 #define MLPACK_CORE_CV_METRICS_F1_IMPL_HPP
 
 #include <mlpack/core/cv/metrics/accuracy.hpp>
+#include <mlpack/core/data/incremental_confusion_matrix.hpp>
 
 namespace mlpack {
 namespace cv {
@@ -37,15 +38,12 @@ double F1<AS, PC>::Evaluate(MLAlgorithm& model,
   arma::Row<size_t> predictedLabels;
   model.Classify(data, predictedLabels);
 
-  size_t tp = arma::sum((labels == PC) % (predictedLabels == PC));
-  size_t numberOfPositivePredictions = arma::sum(predictedLabels == PC);
-  size_t numberOfPositiveClassInstances = arma::sum(labels == PC);
+  const size_t numClasses = std::max(
+      std::max(arma::max(labels), arma::max(predictedLabels)), PC) + 1;
+  data::IncrementalConfusionMatrix cm(numClasses);
+  cm.Update(predictedLabels, labels);
 
-  double precision = double(tp) / numberOfPositivePredictions;
-  double recall = double(tp) / numberOfPositiveClassInstances;
-
-  return (precision + recall == 0.0) ? 0.0 :
-      2.0 * precision * recall / (precision + recall);
+  return cm.F1(PC);
 }
 
 template<AverageStrategy AS, size_t PC /* PositiveClass */>
@@ -74,20 +72,17 @@ double F1<AS, PC>::Evaluate(MLAlgorithm& model,
   arma::Row<size_t> predictedLabels;
   model.Classify(data, predictedLabels);
 
+  // The average is taken over the classes present in the ground truth, even
+  // if some predicted labels lie outside of them.
   size_t numClasses = arma::max(labels) + 1;
 
+  data::IncrementalConfusionMatrix cm(
+      std::max(numClasses, size_t(arma::max(predictedLabels) + 1)));
+  cm.Update(predictedLabels, labels);
+
   arma::vec f1s = arma::vec(numClasses);
   for (size_t c = 0; c < numClasses; ++c)
-  {
-    size_t tp = arma::sum((labels == c) % (predictedLabels == c));
-    size_t positivePredictions = arma::sum(predictedLabels == c);
-    size_t positiveLabels = arma::sum(labels == c);
-
-    double precision = double(tp) / positivePredictions;
-    double recall = double(tp) / positiveLabels;
-    f1s(c) = (precision + recall == 0.0) ? 0.0 :
-        2.0 * precision * recall / (precision + recall);
-  }
+    f1s(c) = cm.F1(c);
 
   return arma::mean(f1s);
 }
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_CV_METRICS_PRECISION_IMPL_HPP
 
 #include <mlpack/core/cv/metrics/accuracy.hpp>
+#include <mlpack/core/data/incremental_confusion_matrix.hpp>
 
 namespace mlpack {
 namespace cv {
@@ -37,10 +38,12 @@ double Precision<AS, PC>::Evaluate(MLAlgorithm& model,
   arma::Row<size_t> predictedLabels;
   model.Classify(data, predictedLabels);
 
-  size_t tp = arma::sum((labels == PC) % (predictedLabels == PC));
-  size_t numberOfPositivePredictions = arma::sum(predictedLabels == PC);
+  const size_t numClasses = std::max(
+      std::max(arma::max(labels), arma::max(predictedLabels)), PC) + 1;
+  data::IncrementalConfusionMatrix cm(numClasses);
+  cm.Update(predictedLabels, labels);
 
-  return double(tp) / numberOfPositivePredictions;
+  return cm.Precision(PC);
 }
 
 template<AverageStrategy AS, size_t PC /* PositiveClass */>
@@ -68,15 +71,17 @@ double Precision<AS, PC>::Evaluate(MLAlgorithm& model,
   arma::Row<size_t> predictedLabels;
   model.Classify(data, predictedLabels);
 
+  // The average is taken over the classes present in the ground truth, even
+  // if some predicted labels lie outside of them.
   size_t numClasses = arma::max(labels) + 1;
 
+  data::IncrementalConfusionMatrix cm(
+      std::max(numClasses, size_t(arma::max(predictedLabels) + 1)));
+  cm.Update(predictedLabels, labels);
+
   arma::vec precisions = arma::vec(numClasses);
   for (size_t c = 0; c < numClasses; ++c)
-  {
-    size_t tp = arma::sum((labels == c) % (predictedLabels == c));
-    size_t numberOfPositivePredictions = arma::sum(predictedLabels == c);
-    precisions(c) = double(tp) / numberOfPositivePredictions;
-  }
+    precisions(c) = cm.Precision(c);
 
   return arma::mean(precisions);
 }
@@ -53,6 +53,55 @@ class SilhouetteScore
                         const arma::Row<size_t>& labels,
                         const Metric& metric);
 
+  /**
+   * Estimate the overall silhouette score from a uniform random sample of
+   * points, without forming the full pairwise distance matrix.  For each
+   * sampled point the exact silhouette value is computed against the whole
+   * dataset, so the cost is O(sampleSize * n) distance evaluations instead of
+   * O(n^2).  A normal-approximation 95% confidence half-width for the
+   * estimate is returned through confidenceWidth (including a finite
+   * population correction, since sampling is done without replacement); the
+   * true overall score lies in [estimate - width, estimate + width] with
+   * approximately 95% probability.
+   *
+   * If sampleSize is at least the number of points, the exact overall score
+   * is computed and the confidence width is zero.
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @param sampleSize Number of points to sample.
+   * @param confidenceWidth Output: 95% confidence half-width of the estimate.
+   * @return (double) estimated silhouette score.
+   */
+  template<typename DataType, typename Metric>
+  static double EstimateOverall(const DataType& X,
+                                const arma::Row<size_t>& labels,
+                                const Metric& metric,
+                                const size_t sampleSize,
+                                double& confidenceWidth);
+
+  /**
+   * Find the overall simplified silhouette score, in which the average
+   * dissimilarity to a cluster is replaced by the distance to the cluster
+   * centroid.  The nearest other-cluster centroid for every point is found
+   * with a tree-based NeighborSearch over the centroids, so the cost is
+   * O(n log k + n d) rather than O(n^2); for well-separated clusters the
+   * simplified score closely tracks the exact one.
+   *
+   * Note that the Metric type must be default-constructible, as it is also
+   * used to instantiate the internal neighbor search.
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @return (double) simplified silhouette score.
+   */
+  template<typename DataType, typename Metric>
+  static double SimplifiedOverall(const DataType& X,
+                                  const arma::Row<size_t>& labels,
+                                  const Metric& metric);
+
   /**
    * Find the individual silhouette scores for precomputted dissimilarites.
    *
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_CV_METRICS_SILHOUETTE_SCORE_IMPL_HPP
 
 #include <mlpack/core/cv/metrics/facilities.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
 namespace mlpack {
 namespace cv {
@@ -26,6 +27,156 @@ double SilhouetteScore::Overall(const DataType& X,
   return arma::mean(SamplesScore(X, labels, metric));
 }
 
+template<typename DataType, typename Metric>
+double SilhouetteScore::EstimateOverall(const DataType& X,
+                                        const arma::Row<size_t>& labels,
+                                        const Metric& metric,
+                                        const size_t sampleSize,
+                                        double& confidenceWidth)
+{
+  util::CheckSameSizes(X, labels, "SilhouetteScore::EstimateOverall()");
+
+  if (sampleSize == 0)
+  {
+    throw std::invalid_argument("SilhouetteScore::EstimateOverall(): sample "
+        "size must be positive!");
+  }
+
+  const size_t n = X.n_cols;
+  if (sampleSize >= n)
+  {
+    // Sampling everything is just the exact computation.
+    confidenceWidth = 0.0;
+    return Overall(X, labels, metric);
+  }
+
+  // Sample points uniformly without replacement.
+  const arma::uvec ordering = arma::shuffle(
+      arma::regspace<arma::uvec>(0, n - 1));
+  const arma::uvec samples = ordering.head(sampleSize);
+
+  // Finds one index per cluster.
+  const arma::ucolvec clusterLabels = arma::find_unique(labels, false);
+
+  arma::rowvec sampleScores(sampleSize);
+
+  // Each sampled point only needs its own column of the distance matrix, so
+  // the full matrix is never formed; the columns are independent and can be
+  // computed in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t s = 0; s < (omp_size_t) sampleSize; ++s)
+  {
+    const size_t i = samples[s];
+    arma::colvec distances(n);
+    for (size_t j = 0; j < n; ++j)
+      distances(j) = metric.Evaluate(X.col(i), X.col(j));
+
+    double intraClusterDistance = 0;
+    double minInterClusterDistance = DBL_MAX;
+    for (size_t j = 0; j < clusterLabels.n_elem; j++)
+    {
+      const size_t clusterLabel = labels(clusterLabels(j));
+      if (labels(i) != clusterLabel)
+      {
+        const double interClusterDistance = MeanDistanceFromCluster(
+            distances, labels, clusterLabel, false);
+        if (interClusterDistance < minInterClusterDistance)
+          minInterClusterDistance = interClusterDistance;
+      }
+      else
+      {
+        intraClusterDistance = MeanDistanceFromCluster(
+            distances, labels, clusterLabel, true);
+        if (intraClusterDistance == 0)
+        {
+          // s(i) = 0, no more calculation needed.
+          break;
+        }
+      }
+    }
+
+    if (intraClusterDistance == 0)
+    {
+      // i is the only element in the cluster.
+      sampleScores(s) = 0.0;
+    }
+    else
+    {
+      sampleScores(s) = minInterClusterDistance - intraClusterDistance;
+      sampleScores(s) /= std::max(
+          intraClusterDistance, minInterClusterDistance);
+    }
+  }
+
+  // 95% normal-approximation confidence half-width for the mean, with a
+  // finite population correction since we sampled without replacement.
+  const double fpc = std::sqrt((double) (n - sampleSize) / (double) (n - 1));
+  confidenceWidth = 1.959964 * fpc * arma::stddev(sampleScores) /
+      std::sqrt((double) sampleSize);
+
+  return arma::mean(sampleScores);
+}
+
+template<typename DataType, typename Metric>
+double SilhouetteScore::SimplifiedOverall(const DataType& X,
+                                          const arma::Row<size_t>& labels,
+                                          const Metric& metric)
+{
+  util::CheckSameSizes(X, labels, "SilhouetteScore::SimplifiedOverall()");
+
+  // Map the (arbitrary) label values to consecutive cluster indices.
+  const arma::ucolvec clusterLabels = arma::find_unique(labels, false);
+  const size_t numClusters = clusterLabels.n_elem;
+  if (numClusters < 2)
+  {
+    throw std::invalid_argument("SilhouetteScore::SimplifiedOverall(): at "
+        "least two clusters are required!");
+  }
+
+  std::unordered_map<size_t, size_t> clusterOf;
+  for (size_t j = 0; j < numClusters; ++j)
+    clusterOf[labels(clusterLabels(j))] = j;
+
+  // Compute the cluster centroids.
+  arma::mat centroids(X.n_rows, numClusters, arma::fill::zeros);
+  arma::Col<size_t> counts(numClusters, arma::fill::zeros);
+  for (size_t i = 0; i < X.n_cols; ++i)
+  {
+    const size_t cluster = clusterOf[labels(i)];
+    centroids.col(cluster) += X.col(i);
+    ++counts[cluster];
+  }
+  for (size_t j = 0; j < numClusters; ++j)
+    centroids.col(j) /= counts[j];
+
+  // For each point, find the two nearest centroids with a dual-tree search.
+  // The nearer of the two may be the point's own centroid; in that case the
+  // second neighbor is the nearest other cluster.
+  neighbor::NeighborSearch<neighbor::NearestNeighborSort, Metric> searcher(
+      centroids, neighbor::DUAL_TREE_MODE, 0.0, metric);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  searcher.Search(X, 2, neighbors, distances);
+
+  double totalScore = 0.0;
+  #pragma omp parallel for reduction(+:totalScore)
+  for (omp_size_t i = 0; i < (omp_size_t) X.n_cols; ++i)
+  {
+    const size_t ownCluster = clusterOf.at(labels(i));
+
+    // a(i) is the distance to the point's own centroid, even if some other
+    // centroid happens to be nearer.
+    const double a = metric.Evaluate(X.col(i), centroids.col(ownCluster));
+    const double b = (neighbors(0, i) == ownCluster) ? distances(1, i) :
+        distances(0, i);
+
+    if (std::max(a, b) > 0)
+      totalScore += (b - a) / std::max(a, b);
+  }
+
+  return totalScore / X.n_cols;
+}
+
 template<typename DataType>
 arma::rowvec SilhouetteScore::SamplesScore(const DataType& distances,
                                            const arma::Row<size_t>& labels)
@@ -208,6 +208,13 @@ class SimpleCV
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs&... args);
 
+  /**
+   * Copy another SimpleCV object.  The last trained model (if any) is deep-
+   * copied, so the copy can be evaluated independently of (and concurrently
+   * with) the original.
+   */
+  SimpleCV(const SimpleCV& other);
+
   //! Access and modify the last trained model.
   MLAlgorithm& Model();
 
@@ -240,6 +247,10 @@ class SimpleCV
   //! The pointer to the last trained model.
   std::unique_ptr<MLAlgorithm> modelPtr;
 
+  //! Whether the last model was trained without hyperparameters, so that an
+  //! identical evaluation can retrain it in place.
+  bool modelRetrainable;
+
   /**
    * Assert data consistency and initialize fields required for running
    * cross-validation.
@@ -286,7 +297,9 @@ class SimpleCV
                                    const size_t lastCol);
 
   /**
-   * Train and run evaluation in the case of non-weighted learning.
+   * Train and run evaluation in the case of non-weighted learning.  The model
+   * from the previous evaluation is retrained in place when
+   * CVBase::TrainInPlace() supports that for the given arguments.
    */
   template<typename... MLAlgorithmArgs,
            bool Enabled = !Base::MIE::SupportsWeights,
@@ -127,6 +127,38 @@ SimpleCV<MLAlgorithm,
         std::forward<WIT>(weights))
 { /* Nothing left to do. */ }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+SimpleCV<MLAlgorithm,
+         Metric,
+         MatType,
+         PredictionsType,
+         WeightsType>::SimpleCV(const SimpleCV& other) :
+    base(other.base),
+    xs(other.xs),
+    ys(other.ys),
+    weights(other.weights),
+    modelPtr(other.modelPtr == nullptr ?
+        nullptr : new MLAlgorithm(*other.modelPtr)),
+    modelRetrainable(other.modelRetrainable)
+{
+  // Rebuild the training and validation views against the copied dataset, so
+  // that the copy does not reference the data of the original object.
+  const size_t numberOfTrainingPoints = other.trainingXs.n_cols;
+
+  trainingXs = GetSubset(xs, 0, numberOfTrainingPoints - 1);
+  trainingYs = GetSubset(ys, 0, numberOfTrainingPoints - 1);
+
+  validationXs = GetSubset(xs, numberOfTrainingPoints, xs.n_cols - 1);
+  validationYs = GetSubset(ys, numberOfTrainingPoints, ys.n_cols - 1);
+
+  if (other.trainingWeights.n_elem > 0)
+    trainingWeights = GetSubset(weights, 0, numberOfTrainingPoints - 1);
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -143,7 +175,8 @@ SimpleCV<MLAlgorithm,
                                 PIT&& ys) :
     base(std::move(base)),
     xs(std::forward<MIT>(xs)),
-    ys(std::forward<PIT>(ys))
+    ys(std::forward<PIT>(ys)),
+    modelRetrainable(false)
 {
   Base::AssertDataConsistency(this->xs, this->ys);
 
@@ -153,8 +186,10 @@ SimpleCV<MLAlgorithm,
   trainingXs = GetSubset(this->xs, 0, numberOfTrainingPoints - 1);
   trainingYs = GetSubset(this->ys, 0, numberOfTrainingPoints - 1);
 
-  validationXs = GetSubset(this->xs, numberOfTrainingPoints, xs.n_cols - 1);
-  validationYs = GetSubset(this->ys, numberOfTrainingPoints, xs.n_cols - 1);
+  validationXs = GetSubset(this->xs, numberOfTrainingPoints,
+      this->xs.n_cols - 1);
+  validationYs = GetSubset(this->ys, numberOfTrainingPoints,
+      this->ys.n_cols - 1);
 }
 
 template<typename MLAlgorithm,
@@ -258,8 +293,11 @@ arma::Mat<ElementType> SimpleCV<MLAlgorithm,
     const size_t firstCol,
     const size_t lastCol)
 {
+  // The alias is non-strict, so that Armadillo's move assignment transfers it
+  // into the class members and they remain views into the stored dataset
+  // rather than copies of it.
   return arma::Mat<ElementType>(m.colptr(firstCol), m.n_rows,
-      lastCol - firstCol + 1, false, true);
+      lastCol - firstCol + 1, false, false);
 }
 
 template<typename MLAlgorithm,
@@ -278,7 +316,7 @@ arma::Row<ElementType> SimpleCV<MLAlgorithm,
     const size_t lastCol)
 {
   return arma::Row<ElementType>(r.colptr(firstCol), lastCol - firstCol + 1,
-      false, true);
+      false, false);
 }
 
 template<typename MLAlgorithm,
@@ -293,7 +331,19 @@ double SimpleCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
-  modelPtr.reset(new MLAlgorithm(base.Train(trainingXs, trainingYs, args...)));
+  // Retrain the model from the previous evaluation in place when possible:
+  // this keeps its allocation alive across evaluations, and models whose
+  // Train() continues from the current parameters are warm-started by the
+  // previous solution.
+  const bool retrained = modelRetrainable && modelPtr != nullptr &&
+      base.TrainInPlace(*modelPtr, trainingXs, trainingYs, args...);
+
+  if (!retrained)
+  {
+    modelPtr.reset(
+        new MLAlgorithm(base.Train(trainingXs, trainingYs, args...)));
+    modelRetrainable = (sizeof...(MLAlgorithmArgs) == 0);
+  }
 
   return Metric::Evaluate(*modelPtr, validationXs, validationYs);
 }
@@ -310,12 +360,28 @@ double SimpleCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
-  if (trainingWeights.n_elem > 0)
-    modelPtr.reset(new MLAlgorithm(
-        base.Train(trainingXs, trainingYs, trainingWeights, args...)));
-  else
-    modelPtr.reset(new MLAlgorithm(
-        base.Train(trainingXs, trainingYs, args...)));
+  bool retrained = false;
+  if (modelRetrainable && modelPtr != nullptr)
+  {
+    if (trainingWeights.n_elem > 0)
+      retrained = base.TrainInPlace(*modelPtr, trainingXs, trainingYs,
+          trainingWeights, args...);
+    else
+      retrained = base.TrainInPlace(*modelPtr, trainingXs, trainingYs,
+          args...);
+  }
+
+  if (!retrained)
+  {
+    if (trainingWeights.n_elem > 0)
+      modelPtr.reset(new MLAlgorithm(
+          base.Train(trainingXs, trainingYs, trainingWeights, args...)));
+    else
+      modelPtr.reset(new MLAlgorithm(
+          base.Train(trainingXs, trainingYs, args...)));
+
+    modelRetrainable = (sizeof...(MLAlgorithmArgs) == 0);
+  }
 
   return Metric::Evaluate(*modelPtr, validationXs, validationYs);
 }
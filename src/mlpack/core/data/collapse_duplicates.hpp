@@ -0,0 +1,81 @@
+/**
+ * @file core/data/collapse_duplicates.hpp
+ *
+ * Collapse exact duplicate points of a dataset into unique points with
+ * multiplicity counts.  Duplicate-heavy datasets are pathological for
+ * space-partitioning trees (duplicates produce zero-volume bounds and
+ * maximally deep splits), so collapsing them before building a tree can
+ * reduce both build and search costs substantially.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COLLAPSE_DUPLICATES_HPP
+#define MLPACK_CORE_DATA_COLLAPSE_DUPLICATES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Collapse exact duplicate columns (points) of the input matrix.  Each unique
+ * point appears exactly once in the output, in order of first occurrence;
+ * counts[j] holds the number of copies of output point j in the input, and
+ * mappings[i] holds the output column that input column i was collapsed to.
+ * Duplicates are found with a single hashing pass over the columns, with hash
+ * collisions resolved by exact element-wise comparison, so the cost is linear
+ * in the size of the input.
+ *
+ * The counts can be used as instance weights afterwards (see the weighted
+ * KMeans::Cluster() overload), and neighbor search results computed on the
+ * collapsed set can be expanded back to the original points with
+ * ExpandNeighbors().
+ *
+ * @param input Input dataset, possibly holding duplicate points.
+ * @param output Matrix to store the unique points in.
+ * @param counts Vector to store the multiplicity of each unique point in.
+ * @param mappings Vector to store the output column of each input column in.
+ * @return The number of unique points.
+ */
+template<typename MatType>
+size_t CollapseDuplicates(const MatType& input,
+                          MatType& output,
+                          arma::Col<size_t>& counts,
+                          arma::Col<size_t>& mappings);
+
+/**
+ * Expand k-nearest-neighbor results computed on a collapsed dataset back to
+ * the original points.  The collapsed results must come from a monochromatic
+ * search on the output of CollapseDuplicates() (so that a point is not its own
+ * neighbor), with at least k neighbors per collapsed point.  For each original
+ * point, its other copies are neighbors at distance zero, and each collapsed
+ * neighbor stands for all of its copies at the same distance; since every
+ * collapsed neighbor represents at least one original point, k collapsed
+ * neighbors always suffice to fill k expanded neighbors.
+ *
+ * @param collapsedNeighbors Neighbor lists computed on the collapsed set.
+ * @param collapsedDistances Distances computed on the collapsed set.
+ * @param counts Multiplicities returned by CollapseDuplicates().
+ * @param mappings Column mappings returned by CollapseDuplicates().
+ * @param k Number of neighbors to return for each original point.
+ * @param neighbors Matrix to store the expanded neighbor lists in.
+ * @param distances Matrix to store the expanded distances in.
+ */
+inline void ExpandNeighbors(const arma::Mat<size_t>& collapsedNeighbors,
+                            const arma::mat& collapsedDistances,
+                            const arma::Col<size_t>& counts,
+                            const arma::Col<size_t>& mappings,
+                            const size_t k,
+                            arma::Mat<size_t>& neighbors,
+                            arma::mat& distances);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "collapse_duplicates_impl.hpp"
+
+#endif
@@ -0,0 +1,163 @@
+/**
+ * @file core/data/collapse_duplicates_impl.hpp
+ *
+ * Implementation of the CollapseDuplicates() and ExpandNeighbors() functions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COLLAPSE_DUPLICATES_IMPL_HPP
+#define MLPACK_CORE_DATA_COLLAPSE_DUPLICATES_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "collapse_duplicates.hpp"
+
+#include <unordered_map>
+
+namespace mlpack {
+namespace data {
+
+template<typename MatType>
+size_t CollapseDuplicates(const MatType& input,
+                          MatType& output,
+                          arma::Col<size_t>& counts,
+                          arma::Col<size_t>& mappings)
+{
+  mappings.set_size(input.n_cols);
+
+  // Each bucket holds the output columns of the unique points that share a
+  // hash value; collisions are resolved by exact comparison below.
+  std::unordered_map<size_t, std::vector<size_t>> buckets;
+  std::vector<size_t> uniqueIndices;
+  std::vector<size_t> uniqueCounts;
+
+  std::hash<typename MatType::elem_type> hasher;
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    // Combine the hashes of the elements of the column.
+    size_t hash = 0;
+    for (size_t d = 0; d < input.n_rows; ++d)
+      hash ^= hasher(input(d, i)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+    std::vector<size_t>& bucket = buckets[hash];
+    size_t uniqueIndex = uniqueIndices.size();
+    for (const size_t j : bucket)
+    {
+      bool equal = true;
+      for (size_t d = 0; d < input.n_rows; ++d)
+      {
+        if (input(d, i) != input(d, uniqueIndices[j]))
+        {
+          equal = false;
+          break;
+        }
+      }
+
+      if (equal)
+      {
+        uniqueIndex = j;
+        break;
+      }
+    }
+
+    if (uniqueIndex == uniqueIndices.size())
+    {
+      // This is a point we have not seen before.
+      bucket.push_back(uniqueIndex);
+      uniqueIndices.push_back(i);
+      uniqueCounts.push_back(1);
+    }
+    else
+    {
+      ++uniqueCounts[uniqueIndex];
+    }
+
+    mappings[i] = uniqueIndex;
+  }
+
+  // Assemble the collapsed dataset.
+  output.set_size(input.n_rows, uniqueIndices.size());
+  for (size_t j = 0; j < uniqueIndices.size(); ++j)
+    output.col(j) = input.col(uniqueIndices[j]);
+
+  counts = arma::Col<size_t>(uniqueCounts);
+
+  return uniqueIndices.size();
+}
+
+inline void ExpandNeighbors(const arma::Mat<size_t>& collapsedNeighbors,
+                            const arma::mat& collapsedDistances,
+                            const arma::Col<size_t>& counts,
+                            const arma::Col<size_t>& mappings,
+                            const size_t k,
+                            arma::Mat<size_t>& neighbors,
+                            arma::mat& distances)
+{
+  if (collapsedNeighbors.n_rows < k)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "neighbors computed on the collapsed set ("
+        << collapsedNeighbors.n_rows << ")";
+    throw std::invalid_argument(ss.str());
+  }
+  if (collapsedNeighbors.n_cols != counts.n_elem)
+  {
+    std::stringstream ss;
+    ss << "Number of collapsed neighbor lists (" << collapsedNeighbors.n_cols
+        << ") does not match the number of collapsed points ("
+        << counts.n_elem << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // Gather the original points represented by each collapsed point, in order.
+  std::vector<std::vector<size_t>> members(counts.n_elem);
+  for (size_t i = 0; i < mappings.n_elem; ++i)
+    members[mappings[i]].push_back(i);
+
+  neighbors.set_size(k, mappings.n_elem);
+  distances.set_size(k, mappings.n_elem);
+
+  for (size_t i = 0; i < mappings.n_elem; ++i)
+  {
+    const size_t u = mappings[i];
+    size_t pos = 0;
+
+    // The other copies of this point are its nearest neighbors, at distance
+    // zero.
+    for (const size_t m : members[u])
+    {
+      if (pos == k)
+        break;
+      if (m == i)
+        continue;
+
+      neighbors(pos, i) = m;
+      distances(pos, i) = 0.0;
+      ++pos;
+    }
+
+    // Then expand the collapsed neighbor list in order; each collapsed
+    // neighbor stands for all of its copies, at the same distance.
+    for (size_t j = 0; j < collapsedNeighbors.n_rows && pos < k; ++j)
+    {
+      const size_t neighborIndex = collapsedNeighbors(j, u);
+      for (const size_t m : members[neighborIndex])
+      {
+        if (pos == k)
+          break;
+
+        neighbors(pos, i) = m;
+        distances(pos, i) = collapsedDistances(j, u);
+        ++pos;
+      }
+    }
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
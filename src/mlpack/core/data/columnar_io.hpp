@@ -0,0 +1,227 @@
+/**
+ * @file core/data/columnar_io.hpp
+ * @author Ryan Curtin
+ *
+ * Support for mlpack's native binary columnar dataset format (extension
+ * '.mcol').  The format is a small fixed-size header followed by the raw
+ * column-major payload, stored exactly as the matrix is laid out in memory.
+ * This makes loading nearly free: the file is mapped into memory and the
+ * matrix is constructed as an alias of the mapping, so no parsing and no copy
+ * are performed.
+ *
+ * Layout (all integers little-endian 64-bit):
+ *
+ *   bytes  0-7   magic ("mlpkcolm")
+ *   bytes  8-15  format version (currently 1)
+ *   bytes 16-23  element size, in bytes
+ *   bytes 24-31  element type code (0 = floating point, 1 = signed integer,
+ *                2 = unsigned integer)
+ *   bytes 32-39  number of rows
+ *   bytes 40-47  number of columns
+ *   bytes 48-    payload, column-major
+ *
+ * Unlike the text loaders, this format does not participate in the
+ * transposition that data::Load() and data::Save() normally perform: the
+ * payload is always the matrix in mlpack's internal orientation (one column
+ * per observation), so a save followed by a load always reproduces the matrix
+ * exactly.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COLUMNAR_IO_HPP
+#define MLPACK_CORE_DATA_COLUMNAR_IO_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+//! Magic bytes identifying a columnar dataset file.
+static const char columnarMagic[8] = { 'm', 'l', 'p', 'k', 'c', 'o', 'l',
+    'm' };
+
+//! Size of the columnar file header, in bytes.
+static const size_t columnarHeaderSize = 48;
+
+//! Get the element type code for the given element type.
+template<typename eT>
+inline uint64_t ColumnarTypeCode()
+{
+  if (std::is_floating_point<eT>::value)
+    return 0;
+  else if (std::is_signed<eT>::value)
+    return 1;
+  else
+    return 2;
+}
+
+} // namespace details
+
+/**
+ * Save the given matrix to the given file in mlpack's binary columnar format.
+ * The matrix is written in its in-memory (column-major) orientation.  Throws
+ * std::runtime_error if the file cannot be written.
+ *
+ * @param filename Name of the file to write.
+ * @param matrix Matrix to save.
+ */
+template<typename eT>
+void SaveColumnar(const std::string& filename, const arma::Mat<eT>& matrix)
+{
+  std::ofstream stream(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!stream.is_open())
+    throw std::runtime_error("SaveColumnar(): cannot open file '" + filename +
+        "' for writing!");
+
+  const uint64_t version = 1;
+  const uint64_t elemSize = (uint64_t) sizeof(eT);
+  const uint64_t typeCode = details::ColumnarTypeCode<eT>();
+  const uint64_t rows = (uint64_t) matrix.n_rows;
+  const uint64_t cols = (uint64_t) matrix.n_cols;
+
+  stream.write(details::columnarMagic, sizeof(details::columnarMagic));
+  stream.write((const char*) &version, sizeof(uint64_t));
+  stream.write((const char*) &elemSize, sizeof(uint64_t));
+  stream.write((const char*) &typeCode, sizeof(uint64_t));
+  stream.write((const char*) &rows, sizeof(uint64_t));
+  stream.write((const char*) &cols, sizeof(uint64_t));
+
+  stream.write((const char*) matrix.memptr(),
+      (std::streamsize) (matrix.n_elem * sizeof(eT)));
+
+  if (!stream.good())
+    throw std::runtime_error("SaveColumnar(): error writing to file '" +
+        filename + "'!");
+}
+
+/**
+ * Load a matrix from the given file in mlpack's binary columnar format.
+ *
+ * On POSIX systems the payload is not copied: the file is mapped into memory
+ * copy-on-write and the matrix is constructed as an alias of the mapping, so
+ * the cost of loading is independent of the dataset size and pages are only
+ * read from disk as they are touched.  Writes to the matrix modify private
+ * copies of the affected pages and never the file.  The mapping is retained
+ * for the lifetime of the process, since matrices aliasing it may be copied
+ * or moved arbitrarily.  On other platforms (or if mapping fails), the
+ * payload is read into the matrix normally.
+ *
+ * Throws std::runtime_error if the file is missing, malformed, or holds a
+ * different element type than eT.
+ *
+ * @param filename Name of the file to load.
+ * @param matrix Matrix to load into.
+ */
+template<typename eT>
+void LoadColumnar(const std::string& filename, arma::Mat<eT>& matrix)
+{
+  // Read and validate the header.
+  char header[details::columnarHeaderSize];
+  {
+    std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!stream.is_open())
+      throw std::runtime_error("LoadColumnar(): cannot open file '" +
+          filename + "'!");
+
+    stream.read(header, (std::streamsize) details::columnarHeaderSize);
+    if (stream.gcount() != (std::streamsize) details::columnarHeaderSize)
+      throw std::runtime_error("LoadColumnar(): file '" + filename + "' is "
+          "too short to be a columnar dataset file!");
+  }
+
+  if (std::memcmp(header, details::columnarMagic,
+      sizeof(details::columnarMagic)) != 0)
+    throw std::runtime_error("LoadColumnar(): file '" + filename + "' is not "
+        "a columnar dataset file!");
+
+  uint64_t version, elemSize, typeCode, rows, cols;
+  std::memcpy(&version, header + 8, sizeof(uint64_t));
+  std::memcpy(&elemSize, header + 16, sizeof(uint64_t));
+  std::memcpy(&typeCode, header + 24, sizeof(uint64_t));
+  std::memcpy(&rows, header + 32, sizeof(uint64_t));
+  std::memcpy(&cols, header + 40, sizeof(uint64_t));
+
+  if (version != 1)
+    throw std::runtime_error("LoadColumnar(): file '" + filename + "' has "
+        "unknown format version " + std::to_string(version) + "!");
+
+  if (elemSize != sizeof(eT) || typeCode != details::ColumnarTypeCode<eT>())
+    throw std::runtime_error("LoadColumnar(): element type of file '" +
+        filename + "' does not match the requested matrix type!");
+
+  const size_t payloadBytes = (size_t) (rows * cols * elemSize);
+
+#if !defined(_WIN32)
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd >= 0)
+  {
+    struct stat st;
+    const bool sizeOk = (fstat(fd, &st) == 0) && ((size_t) st.st_size >=
+        details::columnarHeaderSize + payloadBytes);
+
+    if (sizeOk)
+    {
+      // Map copy-on-write, so that algorithms that modify the matrix in place
+      // work without modifying the file.
+      void* address = mmap(NULL, details::columnarHeaderSize + payloadBytes,
+          PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      close(fd);
+
+      if (address != MAP_FAILED)
+      {
+        // Rebuild the matrix in place as an alias of the mapping.  Assignment
+        // would not work here: assigning from an auxiliary-memory matrix makes
+        // Armadillo copy the memory, which is exactly what we are avoiding.
+        eT* payload = (eT*) ((char*) address + details::columnarHeaderSize);
+        matrix.~Mat();
+        new (&matrix) arma::Mat<eT>(payload, (arma::uword) rows,
+            (arma::uword) cols, false, false);
+        return;
+      }
+    }
+    else
+    {
+      close(fd);
+      throw std::runtime_error("LoadColumnar(): file '" + filename + "' is "
+          "shorter than its header claims!");
+    }
+  }
+#endif
+
+  // Mapping is unavailable; read the payload the ordinary way.
+  std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!stream.is_open())
+    throw std::runtime_error("LoadColumnar(): cannot open file '" + filename +
+        "'!");
+
+  stream.seekg((std::streamoff) details::columnarHeaderSize, std::ios::beg);
+  matrix.set_size((arma::uword) rows, (arma::uword) cols);
+  stream.read((char*) matrix.memptr(), (std::streamsize) payloadBytes);
+  if (stream.gcount() != (std::streamsize) payloadBytes)
+    throw std::runtime_error("LoadColumnar(): file '" + filename + "' is "
+        "shorter than its header claims!");
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
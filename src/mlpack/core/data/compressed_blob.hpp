@@ -0,0 +1,123 @@
+/**
+ * @file core/data/compressed_blob.hpp
+ *
+ * A cereal-serializable holder for a compressed, independently-deserializable
+ * model component.  Large models (e.g. the trees of a RandomForest) can store
+ * each component as its own CompressedBlob: the archive then holds compressed
+ * bytes instead of the expanded object, components can be packed and unpacked
+ * in parallel, and a loaded blob can be carried around cheaply and unpacked
+ * only when (and if) the component is actually needed.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COMPRESSED_BLOB_HPP
+#define MLPACK_CORE_DATA_COMPRESSED_BLOB_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <sstream>
+
+#include <cereal/archives/binary.hpp>
+
+#include "lz_codec.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A compressed, serialized copy of an object of type T.  Pack() serializes
+ * the object to cereal binary and compresses the bytes; Unpack() reverses the
+ * process.  The blob itself serializes into any cereal archive (the
+ * compressed bytes are base64-encoded in text archives), so it can be stored
+ * wherever the expanded object could be.
+ *
+ * @tparam T Type of the held object; must be cereal-serializable.
+ */
+template<typename T>
+class CompressedBlob
+{
+ public:
+  //! Create an empty blob.
+  CompressedBlob() : originalSize(0) { }
+
+  //! Create a blob holding a compressed copy of the given object.
+  explicit CompressedBlob(const T& object) { Pack(object); }
+
+  /**
+   * Serialize and compress the given object into this blob, replacing
+   * anything the blob previously held.
+   *
+   * @param object Object to pack.
+   */
+  void Pack(const T& object)
+  {
+    std::ostringstream oss(std::ios::out | std::ios::binary);
+    {
+      cereal::BinaryOutputArchive ar(oss);
+      ar(cereal::make_nvp("object", const_cast<T&>(object)));
+    }
+    const std::string bytes = oss.str();
+    originalSize = bytes.size();
+    compressed = LZCompress((const unsigned char*) bytes.data(), bytes.size());
+  }
+
+  /**
+   * Decompress and deserialize the held object.  Throws a cereal::Exception
+   * if the blob is empty or its contents are corrupt.
+   *
+   * @param object Object to unpack into.
+   */
+  void Unpack(T& object) const
+  {
+    std::string bytes(originalSize, '\0');
+    if (originalSize > 0 &&
+        !LZDecompress(compressed.data(), compressed.size(),
+            (unsigned char*) &bytes[0], originalSize))
+    {
+      throw cereal::Exception("CompressedBlob::Unpack(): corrupt compressed "
+          "data!");
+    }
+
+    std::istringstream iss(bytes, std::ios::in | std::ios::binary);
+    cereal::BinaryInputArchive ar(iss);
+    ar(cereal::make_nvp("object", object));
+  }
+
+  //! Get the size of the compressed representation, in bytes.
+  size_t CompressedSize() const { return compressed.size(); }
+  //! Get the size of the uncompressed serialized object, in bytes.
+  size_t OriginalSize() const { return originalSize; }
+
+  //! Serialize the blob (not the expanded object!).
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(originalSize));
+
+    size_t compressedSize = compressed.size();
+    ar(CEREAL_NVP(compressedSize));
+    if (cereal::is_loading<Archive>())
+      compressed.resize(compressedSize);
+    if (compressedSize > 0)
+    {
+      // binary_data() stores the bytes raw in binary archives and
+      // base64-encoded in text archives.
+      ar(cereal::make_nvp("compressed",
+          cereal::binary_data(compressed.data(), compressedSize)));
+    }
+  }
+
+ private:
+  //! The size of the uncompressed serialized object, in bytes.
+  size_t originalSize;
+  //! The compressed serialized object.
+  std::vector<unsigned char> compressed;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -19,10 +19,59 @@
 #include <unordered_map>
 
 #include "map_policies/increment_policy.hpp"
+#include "map_policies/interned_increment_policy.hpp"
 
 namespace mlpack {
 namespace data {
 
+/**
+ * Utility struct to detect whether the given policy provides its own map
+ * storage type for DatasetMapper (see, e.g., InternedIncrementPolicy).
+ */
+template<typename PolicyType, typename InputType>
+struct PolicyHasMapStorage
+{
+  template<typename U>
+  static std::true_type Check(typename U::template MapStorageType<InputType>*);
+  template<typename U>
+  static std::false_type Check(...);
+
+  static const bool value = decltype(Check<PolicyType>(0))::value;
+};
+
+/**
+ * The map storage used by DatasetMapper: by default, a pair of unordered maps
+ * per dimension (input to value and value back to inputs).  A policy may
+ * override this by providing a MapStorageType member template (see
+ * InternedIncrementPolicy for an example that interns each category once).
+ */
+template<typename PolicyType,
+         typename InputType,
+         bool = PolicyHasMapStorage<PolicyType, InputType>::value>
+struct DatasetMapperStorage
+{
+  // Forward mapping type.
+  using ForwardMapType = typename std::unordered_map<InputType, typename
+      PolicyType::MappedType>;
+
+  // Reverse mapping type.  Multiple inputs may map to a single output, hence
+  // the need for std::vector.
+  using ReverseMapType = std::unordered_map<typename PolicyType::MappedType,
+      std::vector<InputType>>;
+
+  // Mappings from strings to integers.
+  // Map entries will only exist for dimensions that are categorical.
+  // MapType = map<dimension, pair<bimap<string, MappedType>, numMappings>>
+  using MapType = std::unordered_map<size_t, std::pair<ForwardMapType,
+      ReverseMapType>>;
+};
+
+template<typename PolicyType, typename InputType>
+struct DatasetMapperStorage<PolicyType, InputType, true>
+{
+  using MapType = typename PolicyType::template MapStorageType<InputType>;
+};
+
 /**
  * Auxiliary information for a dataset, including mappings to/from strings (or
  * other types) and the datatype of each dimension.  DatasetMapper objects are
@@ -169,20 +218,11 @@ class DatasetMapper
   //! Types of each dimension.
   std::vector<Datatype> types;
 
-  // Forward mapping type.
-  using ForwardMapType = typename std::unordered_map<InputType, typename
-      PolicyType::MappedType>;
-
-  // Reverse mapping type.  Multiple inputs may map to a single output, hence
-  // the need for std::vector.
-  using ReverseMapType = std::unordered_map<typename PolicyType::MappedType,
-      std::vector<InputType>>;
-
-  // Mappings from strings to integers.
-  // Map entries will only exist for dimensions that are categorical.
-  // MapType = map<dimension, pair<bimap<string, MappedType>, numMappings>>
-  using MapType = std::unordered_map<size_t, std::pair<ForwardMapType,
-      ReverseMapType>>;
+  // Mappings from strings to integers (and back).  The storage is chosen by
+  // the policy; see DatasetMapperStorage above.  Map entries will only exist
+  // for dimensions that are categorical.
+  using MapType =
+      typename DatasetMapperStorage<PolicyType, InputType>::MapType;
 
   //! maps object stores string and numerical pairs.
   MapType maps;
@@ -195,6 +235,10 @@ class DatasetMapper
 // Use typedef to provide backward compatibility
 using DatasetInfo = DatasetMapper<data::IncrementPolicy>;
 
+// A DatasetInfo variant that interns each category once; use this for
+// datasets with very high-cardinality categorical dimensions.
+using InternedDatasetInfo = DatasetMapper<data::InternedIncrementPolicy>;
+
 } // namespace data
 } // namespace mlpack
 
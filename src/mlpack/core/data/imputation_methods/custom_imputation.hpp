@@ -71,6 +71,38 @@ class CustomImputation
     }
   }
 
+  /**
+   * Impute several dimensions at once with the custom value, using a single
+   * sweep over the observations that is threaded; every entry is replaced
+   * independently, so no merging is needed.
+   *
+   * @param input Matrix that contains the values to be replaced.
+   * @param mappedValues The value to replace, per dimension (must have the
+   *     same length as dimensions).
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    const size_t numObs = columnMajor ? input.n_cols : input.n_rows;
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) numObs; ++i)
+    {
+      for (size_t d = 0; d < dimensions.size(); ++d)
+      {
+        T& value = columnMajor ? input(dimensions[d], i) :
+            input(i, dimensions[d]);
+        if (value == mappedValues[d] || std::isnan(value))
+          value = customValue;
+      }
+    }
+  }
+
  private:
   //! A user-defined value that the user wants to replace missing values with.
   T customValue;
@@ -96,6 +96,83 @@ class MeanImputation
       input(target.first, target.second) = mean;
     }
   }
+
+  /**
+   * Impute several dimensions at once.  One fused sweep over the observations
+   * accumulates every dimension's sum and element count simultaneously, which
+   * touches each cache line of the matrix once instead of once per dimension;
+   * a second sweep writes the means in place.  Neither sweep materializes a
+   * list of missing positions, so the memory footprint is independent of the
+   * number of missing values.  Both sweeps are threaded over observations.
+   *
+   * @param input Matrix that contains the values to be replaced.
+   * @param mappedValues The value to replace, per dimension (must have the
+   *     same length as dimensions).
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    const size_t numDims = dimensions.size();
+    const size_t numObs = columnMajor ? input.n_cols : input.n_rows;
+
+    arma::vec sums(numDims, arma::fill::zeros);
+    arma::vec counts(numDims, arma::fill::zeros);
+
+    #pragma omp parallel
+    {
+      arma::vec localSums(numDims, arma::fill::zeros);
+      arma::vec localCounts(numDims, arma::fill::zeros);
+
+      #pragma omp for schedule(static)
+      for (omp_size_t i = 0; i < (omp_size_t) numObs; ++i)
+      {
+        for (size_t d = 0; d < numDims; ++d)
+        {
+          const T value = columnMajor ? input(dimensions[d], i) :
+              input(i, dimensions[d]);
+          if (value == mappedValues[d] || std::isnan(value))
+            continue;
+
+          localSums[d] += value;
+          localCounts[d] += 1.0;
+        }
+      }
+
+      #pragma omp critical (meanImputationMerge)
+      {
+        sums += localSums;
+        counts += localCounts;
+      }
+    }
+
+    for (size_t d = 0; d < numDims; ++d)
+    {
+      if (counts[d] == 0.0)
+        Log::Fatal << "it is impossible to calculate mean; no valid elements "
+            << "in dimension " << dimensions[d] << std::endl;
+    }
+
+    const arma::vec means = sums / counts;
+
+    // Each observation's entries are written independently, so the
+    // replacement sweep is threaded the same way as the accumulation sweep.
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) numObs; ++i)
+    {
+      for (size_t d = 0; d < numDims; ++d)
+      {
+        T& value = columnMajor ? input(dimensions[d], i) :
+            input(i, dimensions[d]);
+        if (value == mappedValues[d] || std::isnan(value))
+          value = means[d];
+      }
+    }
+  }
 }; // class MeanImputation
 
 } // namespace data
@@ -85,6 +85,32 @@ class MedianImputation
        input(target.first, target.second) = median;
     }
   }
+
+  /**
+   * Impute several dimensions at once.  A median needs the full sample of a
+   * dimension's valid values, so the dimensions cannot share one fused
+   * statistics pass the way means can; instead the dimensions are processed
+   * across threads, and each one only reads and writes its own row (or
+   * column) of the matrix.
+   *
+   * @param input Matrix that contains the values to be replaced.
+   * @param mappedValues The value to replace, per dimension (must have the
+   *     same length as dimensions).
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t d = 0; d < (omp_size_t) dimensions.size(); ++d)
+    {
+      Impute(input, mappedValues[d], dimensions[d], columnMajor);
+    }
+  }
 }; // class MedianImputation
 
 } // namespace data
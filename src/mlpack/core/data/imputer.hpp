@@ -65,6 +65,33 @@ class Imputer
     strategy.Impute(input, mappedValue, dimension, columnMajor);
   }
 
+  /**
+  * Impute missing values in several dimensions with one call.  The work is
+  * handed to the strategy's multi-dimension overload, which computes all
+  * per-dimension statistics in a single pass over the data where the
+  * strategy allows it (see, e.g., MeanImputation) and imputes in place; the
+  * input matrix is never copied.  Only strategies that replace values
+  * without changing the shape of the matrix support this overload; listwise
+  * deletion must be applied one dimension at a time.
+  *
+  * @param input Input dataset to apply imputation.
+  * @param missingValue User defined missing value; it can be anything.
+  * @param dimensions Dimensions to apply the imputation.
+  */
+  void Impute(arma::Mat<T>& input,
+              const std::string& missingValue,
+              const std::vector<size_t>& dimensions)
+  {
+    std::vector<T> mappedValues(dimensions.size());
+    for (size_t i = 0; i < dimensions.size(); ++i)
+    {
+      mappedValues[i] = static_cast<T>(
+          mapper.UnmapValue(missingValue, dimensions[i]));
+    }
+
+    strategy.Impute(input, mappedValues, dimensions, columnMajor);
+  }
+
   //! Get the strategy.
   const StrategyType& Strategy() const { return strategy; }
 
@@ -0,0 +1,138 @@
+/**
+ * @file core/data/incremental_confusion_matrix.hpp
+ *
+ * An incrementally updatable confusion matrix for streaming evaluation of
+ * classification results, with constant memory in the number of predictions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_INCREMENTAL_CONFUSION_MATRIX_HPP
+#define MLPACK_CORE_DATA_INCREMENTAL_CONFUSION_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * An IncrementalConfusionMatrix accumulates classification results one
+ * prediction or one batch at a time, so that accuracy, precision, recall and
+ * F1 can be computed over prediction streams that do not fit in memory.  Its
+ * memory use is constant in the number of predictions (numClasses x
+ * numClasses counts).  Accumulators filled independently---on different
+ * threads or different chunks of a stream---can be combined with Merge().
+ *
+ * The layout of the counts matches ConfusionMatrix(): the row index is the
+ * predicted class and the column index is the actual class.
+ *
+ * The derived metrics follow the conventions of the cross-validation metric
+ * classes (Accuracy, Precision, Recall, F1), which compute their values from
+ * this class; microaveraged precision, recall and F1 are all equal to
+ * Accuracy().
+ */
+class IncrementalConfusionMatrix
+{
+ public:
+  /**
+   * Create the accumulator with all counts zero.
+   *
+   * @param numClasses Number of classes; must be at least 1.
+   */
+  IncrementalConfusionMatrix(const size_t numClasses);
+
+  /**
+   * Accumulate a single prediction.
+   *
+   * @param prediction Predicted class label.
+   * @param response Actual (ground truth) class label.
+   */
+  void Update(const size_t prediction, const size_t response);
+
+  /**
+   * Accumulate a batch of predictions.
+   *
+   * @param predictions Predicted class labels.
+   * @param responses Actual (ground truth) class labels.
+   */
+  void Update(const arma::Row<size_t>& predictions,
+              const arma::Row<size_t>& responses);
+
+  /**
+   * Add the counts of another accumulator to this one.  The other accumulator
+   * must have been created with the same number of classes.
+   *
+   * @param other Accumulator to merge into this one.
+   */
+  void Merge(const IncrementalConfusionMatrix& other);
+
+  //! Return the fraction of correctly classified predictions.
+  double Accuracy() const;
+
+  /**
+   * Return the precision of the given class: the number of true positives
+   * divided by the number of positive predictions.
+   *
+   * @param positiveClass Class to treat as the positive class.
+   */
+  double Precision(const size_t positiveClass) const;
+
+  /**
+   * Return the recall of the given class: the number of true positives
+   * divided by the number of actually positive instances.
+   *
+   * @param positiveClass Class to treat as the positive class.
+   */
+  double Recall(const size_t positiveClass) const;
+
+  /**
+   * Return the F1 score of the given class: the harmonic mean of its
+   * precision and recall (or 0 when both are zero).
+   *
+   * @param positiveClass Class to treat as the positive class.
+   */
+  double F1(const size_t positiveClass) const;
+
+  //! Return the mean of the per-class precisions.
+  double MacroPrecision() const;
+
+  //! Return the mean of the per-class recalls.
+  double MacroRecall() const;
+
+  //! Return the mean of the per-class F1 scores.
+  double MacroF1() const;
+
+  //! Return the matrix of counts (rows: predicted class; columns: actual
+  //! class).
+  const arma::Mat<size_t>& Matrix() const { return counts; }
+
+  //! Return the number of classes.
+  size_t NumClasses() const { return counts.n_rows; }
+
+  //! Return the total number of accumulated predictions.
+  size_t Count() const { return count; }
+
+  //! Serialize the accumulator.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(counts));
+    ar(CEREAL_NVP(count));
+  }
+
+ private:
+  //! The accumulated counts.
+  arma::Mat<size_t> counts;
+  //! The total number of accumulated predictions.
+  size_t count;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "incremental_confusion_matrix_impl.hpp"
+
+#endif
@@ -0,0 +1,126 @@
+/**
+ * @file core/data/incremental_confusion_matrix_impl.hpp
+ *
+ * Implementation of the IncrementalConfusionMatrix class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_INCREMENTAL_CONFUSION_MATRIX_IMPL_HPP
+#define MLPACK_CORE_DATA_INCREMENTAL_CONFUSION_MATRIX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "incremental_confusion_matrix.hpp"
+
+namespace mlpack {
+namespace data {
+
+inline IncrementalConfusionMatrix::IncrementalConfusionMatrix(
+    const size_t numClasses) :
+    counts(arma::zeros<arma::Mat<size_t>>(numClasses, numClasses)),
+    count(0)
+{
+  if (numClasses == 0)
+    throw std::invalid_argument("at least one class is required");
+}
+
+inline void IncrementalConfusionMatrix::Update(const size_t prediction,
+                                               const size_t response)
+{
+  counts(prediction, response)++;
+  count++;
+}
+
+inline void IncrementalConfusionMatrix::Update(
+    const arma::Row<size_t>& predictions,
+    const arma::Row<size_t>& responses)
+{
+  if (predictions.n_elem != responses.n_elem)
+  {
+    std::stringstream ss;
+    ss << "Number of predictions (" << predictions.n_elem << ") does not "
+        << "match number of responses (" << responses.n_elem << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    counts(predictions[i], responses[i])++;
+  count += predictions.n_elem;
+}
+
+inline void IncrementalConfusionMatrix::Merge(
+    const IncrementalConfusionMatrix& other)
+{
+  if (other.NumClasses() != NumClasses())
+  {
+    std::stringstream ss;
+    ss << "Number of classes of the other accumulator ("
+        << other.NumClasses() << ") does not match (" << NumClasses() << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  counts += other.counts;
+  count += other.count;
+}
+
+inline double IncrementalConfusionMatrix::Accuracy() const
+{
+  return double(arma::trace(counts)) / count;
+}
+
+inline double IncrementalConfusionMatrix::Precision(
+    const size_t positiveClass) const
+{
+  // The number of positive predictions is the sum of the predicted row.
+  return double(counts(positiveClass, positiveClass)) /
+      arma::accu(counts.row(positiveClass));
+}
+
+inline double IncrementalConfusionMatrix::Recall(
+    const size_t positiveClass) const
+{
+  // The number of actually positive instances is the sum of the actual
+  // column.
+  return double(counts(positiveClass, positiveClass)) /
+      arma::accu(counts.col(positiveClass));
+}
+
+inline double IncrementalConfusionMatrix::F1(const size_t positiveClass) const
+{
+  const double precision = Precision(positiveClass);
+  const double recall = Recall(positiveClass);
+
+  return (precision + recall == 0.0) ? 0.0 :
+      2.0 * precision * recall / (precision + recall);
+}
+
+inline double IncrementalConfusionMatrix::MacroPrecision() const
+{
+  double sum = 0.0;
+  for (size_t c = 0; c < NumClasses(); ++c)
+    sum += Precision(c);
+  return sum / NumClasses();
+}
+
+inline double IncrementalConfusionMatrix::MacroRecall() const
+{
+  double sum = 0.0;
+  for (size_t c = 0; c < NumClasses(); ++c)
+    sum += Recall(c);
+  return sum / NumClasses();
+}
+
+inline double IncrementalConfusionMatrix::MacroF1() const
+{
+  double sum = 0.0;
+  for (size_t c = 0; c < NumClasses(); ++c)
+    sum += F1(c);
+  return sum / NumClasses();
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -371,6 +371,9 @@ bool Load(const std::string& filename,
 /**
  * Load the image file into the given matrix.
  *
+ * If a resolution is preset in `info` (nonzero width and height), an image of
+ * a different size is resampled to that resolution during loading.
+ *
  * @param filename Name of the image file.
  * @param matrix Matrix to load the image into.
  * @param info An object of ImageInfo class.
@@ -384,7 +387,10 @@ bool Load(const std::string& filename,
           const bool fatal = false);
 
 /**
- * Load the image file into the given matrix.
+ * Load the image files into the given matrix, one image per column.  The
+ * files are decoded in parallel, directly into the preallocated columns.
+ * The first file (or a resolution preset in `info`) decides the batch
+ * resolution; images of any other size are resampled to it.
  *
  * @param files A vector consisting of filenames.
  * @param matrix Matrix to save the image from.
@@ -17,10 +17,256 @@
 
 #include <boost/algorithm/string/trim.hpp>
 #include "is_naninf.hpp"
+#include "load_numeric_csv.hpp"
 
 namespace mlpack {
 namespace data {
 
+namespace details {
+
+/**
+ * Attempt to load the @data section of an ARFF file with the chunked parallel
+ * parser (the same strategy as LoadNumericCSV(): map the file, split it at
+ * row boundaries into one chunk per thread, and parse the chunks directly
+ * into the pre-sized matrix).  Numeric tokens are parsed in place with
+ * ParseNumericToken(), and categorical tokens are resolved through read-only
+ * lookup tables interned from the header's category declarations, so no
+ * synchronization is needed.
+ *
+ * The fast path only applies when parsing can be strictly read-only and
+ * line-local: every categorical dimension must have pre-declared categories
+ * (no dynamically-mapped `string` attributes), and the data section must not
+ * use quoting, escaping, or sparse rows.  Returns false if the fast path does
+ * not apply or if any token fails to parse; the caller then falls back to the
+ * stream-based parser, which also produces the detailed error messages.
+ *
+ * @param filename Name of the ARFF file.
+ * @param dataOffset Byte offset of the first line after @data.
+ * @param matrix Matrix to load the data into.
+ * @param info DatasetMapper object with the header's mappings already made.
+ * @param categoryStrings Pre-declared categories of each dimension.
+ */
+template<typename eT, typename PolicyType>
+bool LoadARFFDataFast(
+    const std::string& filename,
+    const size_t dataOffset,
+    arma::Mat<eT>& matrix,
+    DatasetMapper<PolicyType>& info,
+    const std::map<size_t, std::vector<std::string>>& categoryStrings)
+{
+  const size_t dimensionality = info.Dimensionality();
+
+  for (size_t d = 0; d < dimensionality; ++d)
+  {
+    if (info.Type(d) == Datatype::categorical && categoryStrings.count(d) == 0)
+      return false;
+  }
+
+  MappedFile file(filename);
+  if (file.Data() == NULL || dataOffset >= file.Length())
+    return false;
+
+  const char* const data = file.Data() + dataOffset;
+  const size_t length = file.Length() - dataOffset;
+
+  // Intern the pre-declared categories into per-dimension lookup tables.  The
+  // mappings were already created from the header, so MapString() only
+  // returns the existing values here; during parsing the tables are strictly
+  // read-only and can be shared by all threads.
+  std::vector<std::unordered_map<std::string, eT>> categoryLookups(
+      dimensionality);
+  for (const auto& dimCategories : categoryStrings)
+  {
+    for (const std::string& category : dimCategories.second)
+    {
+      categoryLookups[dimCategories.first][category] =
+          info.template MapString<eT>(category, dimCategories.first);
+    }
+  }
+
+  // Split the data section into chunks, aligning each boundary to the
+  // character after a newline so that no row straddles two chunks.
+  size_t threads = 1;
+  #ifdef HAS_OPENMP
+    threads = (size_t) omp_get_max_threads();
+  #endif
+
+  std::vector<size_t> chunkStarts;
+  chunkStarts.push_back(0);
+  const size_t targetChunkSize = std::max(length / threads, (size_t) 1);
+  for (size_t i = 1; i < threads; ++i)
+  {
+    size_t pos = std::min(i * targetChunkSize, length);
+    while (pos < length && data[pos - 1] != '\n')
+      ++pos;
+    if (pos > chunkStarts.back() && pos < length)
+      chunkStarts.push_back(pos);
+  }
+  const size_t numChunks = chunkStarts.size();
+  chunkStarts.push_back(length);
+
+  // Pass one: count the data lines in each chunk, and check that the fast
+  // path applies (no quoting, no escaping, no sparse rows).
+  std::vector<size_t> chunkLines(numChunks, 0);
+  bool fastPathOk = true;
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    size_t lines = 0;
+    bool ok = true;
+    const char* pos = data + chunkStarts[c];
+    const char* const chunkEnd = data + chunkStarts[c + 1];
+    while (pos < chunkEnd && ok)
+    {
+      const char* lineEnd = (const char*) std::memchr(pos, '\n',
+          (size_t) (chunkEnd - pos));
+      if (lineEnd == NULL)
+        lineEnd = chunkEnd;
+
+      // Find the first non-whitespace character of the line.
+      const char* scan = pos;
+      while (scan != lineEnd &&
+          (*scan == ' ' || *scan == '\t' || *scan == '\r'))
+        ++scan;
+
+      // Skip empty lines and comments; count everything else as a data line.
+      if (scan != lineEnd && *scan != '%')
+      {
+        if (*scan == '{')
+          ok = false; // Sparse data; the stream parser reports this.
+
+        for (; scan != lineEnd; ++scan)
+        {
+          if (*scan == '"' || *scan == '\'' || *scan == '\\')
+            ok = false; // Quoting or escaping; use the stream parser.
+        }
+
+        ++lines;
+      }
+
+      pos = lineEnd + 1;
+    }
+    chunkLines[c] = lines;
+
+    if (!ok)
+    {
+      #pragma omp critical (LoadARFFFastFailure)
+      fastPathOk = false;
+    }
+  }
+
+  if (!fastPathOk)
+    return false;
+
+  // Prefix-sum the line counts to get each chunk's starting row.
+  std::vector<size_t> chunkRowOffsets(numChunks + 1, 0);
+  for (size_t c = 0; c < numChunks; ++c)
+    chunkRowOffsets[c + 1] = chunkRowOffsets[c] + chunkLines[c];
+  const size_t rows = chunkRowOffsets[numChunks];
+
+  if (rows == 0)
+    return false;
+
+  // We load transposed.
+  matrix.set_size(dimensionality, rows);
+
+  // Pass two: parse each chunk into its (disjoint) range of matrix columns.
+  bool parseFailed = false;
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    size_t row = chunkRowOffsets[c];
+    const char* pos = data + chunkStarts[c];
+    const char* const chunkEnd = data + chunkStarts[c + 1];
+    bool failed = false;
+
+    while (pos < chunkEnd && !failed)
+    {
+      const char* lineEnd = (const char*) std::memchr(pos, '\n',
+          (size_t) (chunkEnd - pos));
+      if (lineEnd == NULL)
+        lineEnd = chunkEnd;
+
+      const char* scan = pos;
+      while (scan != lineEnd &&
+          (*scan == ' ' || *scan == '\t' || *scan == '\r'))
+        ++scan;
+
+      if (scan != lineEnd && *scan != '%')
+      {
+        size_t col = 0;
+        const char* tokenStart = pos;
+        scan = pos;
+        while (scan <= lineEnd && !failed)
+        {
+          if (scan == lineEnd || *scan == ',')
+          {
+            if (col >= dimensionality)
+            {
+              failed = true;
+              break;
+            }
+
+            // Strip surrounding spaces from the token.
+            const char* tokenEnd = scan;
+            while (tokenStart != tokenEnd && (*tokenStart == ' ' ||
+                *tokenStart == '\t' || *tokenStart == '\r'))
+              ++tokenStart;
+            while (tokenEnd != tokenStart && (*(tokenEnd - 1) == ' ' ||
+                *(tokenEnd - 1) == '\t' || *(tokenEnd - 1) == '\r'))
+              --tokenEnd;
+
+            if (tokenStart == tokenEnd)
+            {
+              failed = true; // Empty token; the stream parser reports.
+            }
+            else if (info.Type(col) == Datatype::categorical)
+            {
+              const std::unordered_map<std::string, eT>& lookup =
+                  categoryLookups[col];
+              typename std::unordered_map<std::string, eT>::const_iterator
+                  category = lookup.find(std::string(tokenStart, tokenEnd));
+              if (category == lookup.end())
+                failed = true; // Unknown category; the stream parser reports.
+              else
+                matrix(col, row) = category->second;
+            }
+            else
+            {
+              eT value;
+              if (!ParseNumericToken(tokenStart, tokenEnd, value))
+                failed = true; // Includes '?'; the stream parser reports.
+              else
+                matrix(col, row) = value;
+            }
+
+            ++col;
+            tokenStart = scan + 1;
+          }
+          ++scan;
+        }
+
+        ++row;
+      }
+
+      pos = lineEnd + 1;
+    }
+
+    if (failed)
+    {
+      // Parsing is all-or-nothing; any failure aborts the fast path.
+      #pragma omp critical (LoadARFFFastFailure)
+      parseFailed = true;
+    }
+  }
+
+  return !parseFailed;
+}
+
+} // namespace details
+
 template<typename eT, typename PolicyType>
 void LoadARFF(const std::string& filename,
               arma::Mat<eT>& matrix,
@@ -176,6 +422,14 @@ void LoadARFF(const std::string& filename,
     }
   }
 
+  // Try the chunked parallel parser first; it applies whenever parsing can be
+  // strictly line-local (all categories pre-declared, no quoting or sparse
+  // rows).  If it declines or hits anything unparseable, fall through to the
+  // stream-based parser below, which also produces the error messages.
+  if (details::LoadARFFDataFast(filename, (size_t) ifs.tellg(), matrix, info,
+      categoryStrings))
+    return;
+
   // We need to find out how many lines of data are in the file.
   std::streampos pos = ifs.tellg();
   size_t row = 0;
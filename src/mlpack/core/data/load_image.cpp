@@ -52,6 +52,11 @@ bool LoadImage(const std::string& filename,
     return false;
   }
 
+  // If the caller preset a resolution, the decoded image is resampled to it
+  // below.
+  const size_t targetWidth = info.Width();
+  const size_t targetHeight = info.Height();
+
   // Temporary variables needed as stb_image.h supports int parameters.
   int tempWidth, tempHeight, tempChannels;
 
@@ -83,13 +88,51 @@ bool LoadImage(const std::string& filename,
     return false;
   }
 
+  // If the caller asked for a specific resolution and the image does not
+  // match it, resample (nearest neighbor) right after decoding; this is
+  // primarily meant for downscaling batches of images to a common training
+  // resolution without ever materializing them at full size.
+  if (targetWidth > 0 && targetHeight > 0 &&
+      (targetWidth != (size_t) tempWidth ||
+       targetHeight != (size_t) tempHeight))
+  {
+    // The number of channels the decoded buffer actually has (the decode
+    // above forces grayscale or RGB).
+    const size_t channels = (info.Channels() == 1) ? 1 : 3;
+
+    matrix.set_size(targetWidth * targetHeight * channels, 1);
+    unsigned char* dest = matrix.memptr();
+
+    for (size_t y = 0; y < targetHeight; ++y)
+    {
+      const size_t srcY = (y * tempHeight) / targetHeight;
+      for (size_t x = 0; x < targetWidth; ++x)
+      {
+        const size_t srcX = (x * tempWidth) / targetWidth;
+        const unsigned char* srcPixel = image +
+            (srcY * tempWidth + srcX) * channels;
+        unsigned char* destPixel = dest + (y * targetWidth + x) * channels;
+        for (size_t c = 0; c < channels; ++c)
+          destPixel[c] = srcPixel[c];
+      }
+    }
+
+    info.Width() = targetWidth;
+    info.Height() = targetHeight;
+    info.Channels() = channels;
+
+    free(image);
+    return true;
+  }
+
   info.Width() = tempWidth;
   info.Height() = tempHeight;
   info.Channels() = tempChannels;
 
-  // Copy image into armadillo Mat.
+  // Copy the decoded buffer into the matrix (or into the preallocated memory
+  // the matrix aliases) directly, without an intermediate copy.
   matrix = arma::Mat<unsigned char>(image, info.Width() * info.Height() *
-      info.Channels(), 1, true, true);
+      info.Channels(), 1, false, true);
 
   // Free the image pointer.
   free(image);
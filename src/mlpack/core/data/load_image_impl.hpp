@@ -65,25 +65,51 @@ bool Load(const std::vector<std::string>& files,
     return false;
   }
 
+  // The first image decides the matrix dimensions (unless the caller preset
+  // a resolution in `info`, in which case it is downscaled to it like all
+  // the others).
   arma::Mat<unsigned char> img;
   bool status = LoadImage(files[0], img, info, fatal);
 
   if (!status)
     return false;
 
-  // Decide matrix dimension using the image height and width.
   arma::Mat<unsigned char> tmpMatrix(
       info.Width() * info.Height() * info.Channels(), files.size());
   tmpMatrix.col(0) = img;
 
-  for (size_t i = 1; i < files.size() ; ++i)
+  // The remaining files are decoded across threads, each one writing
+  // directly into its own preallocated column.  Since the batch resolution
+  // is now fixed in `info`, any image of a different size is resampled to it
+  // instead of failing.  Exceptions cannot leave a parallel region, so
+  // failures are only recorded here and reported below.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 1; i < (omp_size_t) files.size(); ++i)
   {
+    if (!status)
+      continue;
+
+    ImageInfo localInfo = info;
     arma::Mat<unsigned char> colImg(tmpMatrix.colptr(i), tmpMatrix.n_rows, 1,
         false, true);
-    status = LoadImage(files[i], colImg, info, fatal);
 
-    if (!status)
-      return false;
+    if (!LoadImage(files[i], colImg, localInfo, false))
+    {
+      #pragma omp atomic write
+      status = false;
+    }
+  }
+
+  if (!status)
+  {
+    // The per-file warnings have already been printed by LoadImage().
+    if (fatal)
+    {
+      Log::Fatal << "Load(): failed to load one or more images from the "
+          << "given list." << std::endl;
+    }
+
+    return false;
   }
 
   matrix = arma::conv_to<arma::Mat<eT>>::from(tmpMatrix);
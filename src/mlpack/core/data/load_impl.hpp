@@ -19,6 +19,8 @@
 #include <mlpack/core/util/timers.hpp>
 
 #include "load_csv.hpp"
+#include "load_numeric_csv.hpp"
+#include "columnar_io.hpp"
 #include "load.hpp"
 #include "extension.hpp"
 #include "detect_file_type.hpp"
@@ -94,6 +96,35 @@ bool Load(const std::string& filename,
 {
   Timer::Start("loading_data");
 
+  // mlpack's native columnar format bypasses the Armadillo loaders entirely:
+  // the file is mapped and the matrix aliases the mapping.  The format always
+  // stores the matrix in its in-memory orientation, so no transposition is
+  // needed (or performed).
+  if (Extension(filename) == "mcol")
+  {
+    Log::Info << "Loading '" << filename << "' as mlpack columnar binary "
+        << "data.  " << std::flush;
+    try
+    {
+      LoadColumnar(filename, matrix);
+    }
+    catch (std::exception& e)
+    {
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+
+    Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+        << ".\n";
+    Timer::Stop("loading_data");
+    return true;
+  }
+
   // Catch nonexistent files by opening the stream ourselves.
   std::fstream stream;
 #ifdef  _WIN32 // Always open in binary mode on Windows.
@@ -164,7 +195,16 @@ bool Load(const std::string& filename,
 
   // We can't use the stream if the type is HDF5.
   bool success;
-  if (loadType != arma::hdf5_binary)
+  if (loadType == arma::csv_ascii)
+  {
+    // Use the chunked parallel loader; it maps the file and parses row chunks
+    // on all cores.  It only understands purely numeric data, so if it fails,
+    // fall back to Armadillo's general CSV loader.
+    success = LoadNumericCSV(filename, matrix);
+    if (!success)
+      success = matrix.load(stream, loadType);
+  }
+  else if (loadType != arma::hdf5_binary)
     success = matrix.load(stream, loadType);
   else
     success = matrix.load(filename, loadType);
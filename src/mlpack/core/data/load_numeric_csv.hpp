@@ -0,0 +1,318 @@
+/**
+ * @file core/data/load_numeric_csv.hpp
+ * @author Ryan Curtin
+ *
+ * A fast, chunked loader for purely numeric CSV files.  The file is mapped
+ * into memory (when the platform supports it), split at row boundaries into
+ * one chunk per thread, and the chunks are parsed in parallel directly into a
+ * pre-sized matrix.  Unlike the generic stream-based loaders, the file
+ * contents are only traversed once for dimension discovery and once for
+ * parsing, both of which run over the in-memory mapping on all cores.
+ *
+ * This loader handles only numeric data; if anything unparseable is
+ * encountered, it returns false and the caller is expected to fall back to a
+ * more general (and slower) loader.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_NUMERIC_CSV_HPP
+#define MLPACK_CORE_DATA_LOAD_NUMERIC_CSV_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+/**
+ * A read-only view of an entire file.  On POSIX systems the file is mapped
+ * with mmap(), so no copy is made; elsewhere the contents are read into an
+ * internal buffer.
+ */
+class MappedFile
+{
+ public:
+  //! Map (or read) the given file.  On failure, Data() will return NULL.
+  MappedFile(const std::string& filename) : data(NULL), length(0), mapped(false)
+  {
+#if !defined(_WIN32)
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+      struct stat st;
+      if (fstat(fd, &st) == 0 && st.st_size > 0)
+      {
+        void* address = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE,
+            fd, 0);
+        if (address != MAP_FAILED)
+        {
+          data = (const char*) address;
+          length = (size_t) st.st_size;
+          mapped = true;
+        }
+      }
+      close(fd);
+      if (mapped)
+        return;
+    }
+#endif
+    // Fall back to reading the whole file into memory.
+    std::ifstream stream(filename.c_str(),
+        std::ios::in | std::ios::binary | std::ios::ate);
+    if (!stream.is_open())
+      return;
+
+    const std::streamoff size = stream.tellg();
+    if (size <= 0)
+      return;
+
+    buffer.resize((size_t) size);
+    stream.seekg(0, std::ios::beg);
+    stream.read(&buffer[0], size);
+    if (stream.gcount() == (std::streamsize) size)
+    {
+      data = &buffer[0];
+      length = buffer.size();
+    }
+  }
+
+  ~MappedFile()
+  {
+#if !defined(_WIN32)
+    if (mapped)
+      munmap((void*) data, length);
+#endif
+  }
+
+  //! Get a pointer to the file contents, or NULL if mapping failed.
+  const char* Data() const { return data; }
+  //! Get the length of the file, in bytes.
+  size_t Length() const { return length; }
+
+ private:
+  //! Pointer to the file contents.
+  const char* data;
+  //! Length of the file, in bytes.
+  size_t length;
+  //! Whether the contents came from mmap() (and must be unmapped).
+  bool mapped;
+  //! Storage for the non-mmap fallback.
+  std::vector<char> buffer;
+};
+
+/**
+ * Parse a single numeric token in [begin, end).  Empty tokens parse as zero,
+ * matching Armadillo's CSV semantics.  Returns false if the token is not
+ * entirely numeric.
+ */
+template<typename eT>
+inline bool ParseNumericToken(const char* begin, const char* end, eT& value)
+{
+  // Trim surrounding whitespace.
+  while (begin != end && (*begin == ' ' || *begin == '\t' || *begin == '\r'))
+    ++begin;
+  while (end != begin && (*(end - 1) == ' ' || *(end - 1) == '\t' ||
+                          *(end - 1) == '\r'))
+    --end;
+
+  if (begin == end)
+  {
+    value = eT(0);
+    return true;
+  }
+
+  // strtod() requires a terminated string, and the mapped file is not
+  // terminated, so copy the token out.  Numeric tokens are short, so a stack
+  // buffer suffices.
+  char buf[64];
+  const size_t tokenLength = (size_t) (end - begin);
+  if (tokenLength >= sizeof(buf))
+    return false;
+  std::memcpy(buf, begin, tokenLength);
+  buf[tokenLength] = '\0';
+
+  char* parseEnd = NULL;
+  const double parsed = std::strtod(buf, &parseEnd);
+  if (parseEnd != buf + tokenLength)
+    return false;
+
+  value = (eT) parsed;
+  return true;
+}
+
+} // namespace details
+
+/**
+ * Load a purely numeric CSV file into the given matrix, laid out as it appears
+ * in the file (one file row per matrix row); the caller is responsible for any
+ * transposition.  The file is split at row boundaries into one chunk per
+ * thread, and chunks are counted and parsed in parallel.
+ *
+ * @param filename Name of the file to load.
+ * @param matrix Matrix to load into.
+ * @return true on success; false if the file could not be mapped, rows have
+ *     inconsistent field counts, or any field is non-numeric.
+ */
+template<typename eT>
+bool LoadNumericCSV(const std::string& filename, arma::Mat<eT>& matrix)
+{
+  details::MappedFile file(filename);
+  if (file.Data() == NULL)
+    return false;
+
+  const char* const data = file.Data();
+  const size_t length = file.Length();
+
+  // Split the file into chunks, aligning each boundary to the character after
+  // a newline so that no row straddles two chunks.
+  size_t threads = 1;
+  #ifdef HAS_OPENMP
+    threads = (size_t) omp_get_max_threads();
+  #endif
+
+  std::vector<size_t> chunkStarts;
+  chunkStarts.push_back(0);
+  const size_t targetChunkSize = std::max(length / threads, (size_t) 1);
+  for (size_t i = 1; i < threads; ++i)
+  {
+    size_t pos = std::min(i * targetChunkSize, length);
+    while (pos < length && data[pos - 1] != '\n')
+      ++pos;
+    if (pos > chunkStarts.back() && pos < length)
+      chunkStarts.push_back(pos);
+  }
+  const size_t numChunks = chunkStarts.size();
+  chunkStarts.push_back(length);
+
+  // Pass one: count the non-empty lines in each chunk, and the number of
+  // fields in the first line of the file.
+  std::vector<size_t> chunkLines(numChunks, 0);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    size_t lines = 0;
+    const char* pos = data + chunkStarts[c];
+    const char* const chunkEnd = data + chunkStarts[c + 1];
+    while (pos < chunkEnd)
+    {
+      const char* lineEnd = (const char*) std::memchr(pos, '\n',
+          (size_t) (chunkEnd - pos));
+      if (lineEnd == NULL)
+        lineEnd = chunkEnd;
+
+      // Skip empty lines (e.g. a trailing newline at the end of the file).
+      if (lineEnd != pos && !(lineEnd == pos + 1 && *pos == '\r'))
+        ++lines;
+
+      pos = lineEnd + 1;
+    }
+    chunkLines[c] = lines;
+  }
+
+  // Count the fields in the first line.
+  size_t cols = 0;
+  {
+    const char* lineEnd = (const char*) std::memchr(data, '\n', length);
+    if (lineEnd == NULL)
+      lineEnd = data + length;
+    cols = 1;
+    for (const char* pos = data; pos != lineEnd; ++pos)
+      if (*pos == ',')
+        ++cols;
+  }
+
+  // Prefix-sum the line counts to get each chunk's starting row.
+  std::vector<size_t> chunkRowOffsets(numChunks + 1, 0);
+  for (size_t c = 0; c < numChunks; ++c)
+    chunkRowOffsets[c + 1] = chunkRowOffsets[c] + chunkLines[c];
+  const size_t rows = chunkRowOffsets[numChunks];
+
+  if (rows == 0 || cols == 0)
+    return false;
+
+  matrix.set_size(rows, cols);
+
+  // Pass two: parse each chunk into its (disjoint) range of matrix rows.
+  bool parseFailed = false;
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    size_t row = chunkRowOffsets[c];
+    const char* pos = data + chunkStarts[c];
+    const char* const chunkEnd = data + chunkStarts[c + 1];
+    bool failed = false;
+
+    while (pos < chunkEnd && !failed)
+    {
+      const char* lineEnd = (const char*) std::memchr(pos, '\n',
+          (size_t) (chunkEnd - pos));
+      if (lineEnd == NULL)
+        lineEnd = chunkEnd;
+
+      if (lineEnd != pos && !(lineEnd == pos + 1 && *pos == '\r'))
+      {
+        size_t col = 0;
+        const char* tokenStart = pos;
+        const char* scan = pos;
+        while (scan <= lineEnd && !failed)
+        {
+          if (scan == lineEnd || *scan == ',')
+          {
+            eT value;
+            if (col >= cols ||
+                !details::ParseNumericToken(tokenStart, scan, value))
+            {
+              failed = true;
+            }
+            else
+            {
+              matrix(row, col) = value;
+              ++col;
+              tokenStart = scan + 1;
+            }
+          }
+          ++scan;
+        }
+
+        if (col != cols)
+          failed = true;
+        ++row;
+      }
+
+      pos = lineEnd + 1;
+    }
+
+    if (failed)
+    {
+      // Parsing is all-or-nothing; any failure aborts the fast path.
+      #pragma omp critical (LoadNumericCSVFailure)
+      parseFailed = true;
+    }
+  }
+
+  return !parseFailed;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
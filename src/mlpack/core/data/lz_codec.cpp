@@ -0,0 +1,193 @@
+/**
+ * @file core/data/lz_codec.cpp
+ *
+ * Implementation of the LZ77 codec used for compressed model components.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "lz_codec.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+namespace mlpack {
+namespace data {
+
+namespace {
+
+//! The shortest match worth encoding: a match costs three bytes (token share
+//! plus offset), so anything shorter than four bytes is stored as literals.
+const size_t minMatch = 4;
+//! The largest offset that fits in the two-byte offset field.
+const size_t maxOffset = 65535;
+
+//! Hash the four bytes at input + pos into a 16-bit table index.
+inline uint16_t Hash4(const unsigned char* input, const size_t pos)
+{
+  uint32_t v;
+  memcpy(&v, input + pos, sizeof(uint32_t));
+  return (uint16_t) ((v * 2654435761u) >> 16);
+}
+
+//! Append a length that did not fit in a token nibble: a run of 255s followed
+//! by the remainder.
+inline void PutExtraLength(std::vector<unsigned char>& out, size_t rest)
+{
+  while (rest >= 255)
+  {
+    out.push_back(255);
+    rest -= 255;
+  }
+  out.push_back((unsigned char) rest);
+}
+
+//! Read a length extension; returns false if the input ends prematurely.
+inline bool GetExtraLength(const unsigned char* input,
+                           const size_t inputSize,
+                           size_t& pos,
+                           size_t& length)
+{
+  unsigned char byte;
+  do
+  {
+    if (pos >= inputSize)
+      return false;
+    byte = input[pos++];
+    length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+//! Emit one sequence: a token, the pending literals, and (if matchLen is
+//! nonzero) the match offset.  The last sequence of a stream has no match.
+inline void EmitSequence(std::vector<unsigned char>& out,
+                         const unsigned char* literals,
+                         const size_t litLen,
+                         const size_t matchLen,
+                         const size_t offset)
+{
+  const size_t litCode = std::min(litLen, (size_t) 15);
+  const size_t matchCode = (matchLen > 0) ?
+      std::min(matchLen - minMatch, (size_t) 15) : 0;
+  out.push_back((unsigned char) ((litCode << 4) | matchCode));
+
+  if (litCode == 15)
+    PutExtraLength(out, litLen - 15);
+  out.insert(out.end(), literals, literals + litLen);
+
+  if (matchLen > 0)
+  {
+    out.push_back((unsigned char) (offset & 0xFF));
+    out.push_back((unsigned char) ((offset >> 8) & 0xFF));
+    if (matchCode == 15)
+      PutExtraLength(out, matchLen - minMatch - 15);
+  }
+}
+
+} // namespace
+
+std::vector<unsigned char> LZCompress(const unsigned char* input,
+                                      const size_t inputSize)
+{
+  std::vector<unsigned char> out;
+  if (inputSize == 0)
+    return out;
+  out.reserve(inputSize / 2 + 16);
+
+  // Heads of hash chains: the most recent position of each four-byte prefix.
+  std::vector<uint32_t> head((size_t) 1 << 16, 0xFFFFFFFFu);
+
+  size_t pos = 0;    // Position currently being considered for a match.
+  size_t anchor = 0; // Start of the literals not yet emitted.
+
+  while (pos + minMatch <= inputSize)
+  {
+    const uint16_t h = Hash4(input, pos);
+    const uint32_t candidate = head[h];
+    head[h] = (uint32_t) pos;
+
+    // The hash may collide, so verify the match bytes directly.
+    if ((candidate != 0xFFFFFFFFu) &&
+        (pos - candidate <= maxOffset) &&
+        (memcmp(input + candidate, input + pos, minMatch) == 0))
+    {
+      // Extend the match as far as possible.
+      size_t matchLen = minMatch;
+      while ((pos + matchLen < inputSize) &&
+             (input[candidate + matchLen] == input[pos + matchLen]))
+        ++matchLen;
+
+      EmitSequence(out, input + anchor, pos - anchor, matchLen,
+          pos - candidate);
+
+      pos += matchLen;
+      anchor = pos;
+    }
+    else
+    {
+      ++pos;
+    }
+  }
+
+  // Emit any trailing literals as a final, matchless sequence.
+  if (anchor < inputSize)
+    EmitSequence(out, input + anchor, inputSize - anchor, 0, 0);
+
+  return out;
+}
+
+bool LZDecompress(const unsigned char* input,
+                  const size_t inputSize,
+                  unsigned char* output,
+                  const size_t outputSize)
+{
+  size_t ip = 0; // Input position.
+  size_t op = 0; // Output position.
+
+  while (ip < inputSize)
+  {
+    const unsigned char token = input[ip++];
+
+    // Copy the literals.
+    size_t litLen = token >> 4;
+    if (litLen == 15 && !GetExtraLength(input, inputSize, ip, litLen))
+      return false;
+    if ((ip + litLen > inputSize) || (op + litLen > outputSize))
+      return false;
+    memcpy(output + op, input + ip, litLen);
+    ip += litLen;
+    op += litLen;
+
+    // The last sequence of a stream carries no match.
+    if (ip >= inputSize)
+      break;
+
+    // Read the match offset and length.
+    if (ip + 2 > inputSize)
+      return false;
+    const size_t offset = (size_t) input[ip] | ((size_t) input[ip + 1] << 8);
+    ip += 2;
+    if ((offset == 0) || (offset > op))
+      return false;
+
+    size_t matchLen = token & 0x0F;
+    if (matchLen == 15 && !GetExtraLength(input, inputSize, ip, matchLen))
+      return false;
+    matchLen += minMatch;
+    if (op + matchLen > outputSize)
+      return false;
+
+    // Copy byte by byte: the match may overlap its own output.
+    for (size_t i = 0; i < matchLen; ++i, ++op)
+      output[op] = output[op - offset];
+  }
+
+  return (op == outputSize);
+}
+
+} // namespace data
+} // namespace mlpack
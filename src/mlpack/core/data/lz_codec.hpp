@@ -0,0 +1,56 @@
+/**
+ * @file core/data/lz_codec.hpp
+ *
+ * A small, dependency-free LZ77 codec used to compress serialized model
+ * components (see CompressedBlob).  The format is byte-oriented in the style
+ * of LZ4: each sequence is a token holding a literal count and a match
+ * length, followed by the literal bytes and a two-byte match offset.  The
+ * codec favors speed and simplicity over ratio; it is not compatible with any
+ * external format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LZ_CODEC_HPP
+#define MLPACK_CORE_DATA_LZ_CODEC_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Compress the given byte buffer.  The compressed representation does not
+ * record the original size, so the caller must store it to be able to call
+ * LZDecompress() later.
+ *
+ * @param input Buffer to compress.
+ * @param inputSize Number of bytes in the buffer.
+ * @return The compressed bytes.
+ */
+std::vector<unsigned char> LZCompress(const unsigned char* input,
+                                      const size_t inputSize);
+
+/**
+ * Decompress a buffer produced by LZCompress() into output, which must have
+ * room for exactly outputSize bytes (the original size of the data).
+ *
+ * @param input Compressed buffer.
+ * @param inputSize Number of compressed bytes.
+ * @param output Buffer to decompress into.
+ * @param outputSize Original (uncompressed) size of the data.
+ * @return True on success; false if the input is malformed or does not
+ *     decompress to exactly outputSize bytes.
+ */
+bool LZDecompress(const unsigned char* input,
+                  const size_t inputSize,
+                  unsigned char* output,
+                  const size_t outputSize);
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,155 @@
+/**
+ * @file core/data/map_policies/interned_increment_policy.hpp
+ * @author Ryan Curtin
+ *
+ * Increment mapping policy with interned category storage.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAP_POLICIES_INTERNED_INCREMENT_POLICY_HPP
+#define MLPACK_CORE_DATA_MAP_POLICIES_INTERNED_INCREMENT_POLICY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <unordered_map>
+#include <mlpack/core/data/map_policies/datatype.hpp>
+#include <mlpack/core/data/map_policies/interned_string_map.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * InternedIncrementPolicy maps inputs exactly like IncrementPolicy---each
+ * previously unseen input in a categorical dimension receives the next
+ * unsigned integer, starting from 0---but stores the mappings in
+ * InternedStringMap instead of the default pair of unordered maps.  Each
+ * category is therefore held once instead of twice, with a flat
+ * open-addressing index instead of two per-entry hash map nodes, and the
+ * serialized form contains only the categories themselves.  Use this policy
+ * (e.g. via the InternedDatasetInfo typedef) for datasets whose categorical
+ * dimensions have very many distinct values, such as ID columns.
+ *
+ * If the 'forceAllMappings' parameter is set to true, this will always map.
+ * Otherwise, inputs will only be mapped if they cannot be cast to the output
+ * type via a stringstream extraction.
+ */
+class InternedIncrementPolicy
+{
+ public:
+  InternedIncrementPolicy(const bool forceAllMappings = false) :
+      forceAllMappings(forceAllMappings) { }
+
+  // typedef of MappedType
+  using MappedType = size_t;
+
+  //! The map storage DatasetMapper should use with this policy.
+  template<typename InputType>
+  using MapStorageType = std::unordered_map<size_t,
+      InternedStringMap<InputType, MappedType>>;
+
+  //! We do need a first pass over the data to set the dimension types right.
+  static const bool NeedsFirstPass = true;
+
+  /**
+   * Determine if the dimension is numeric or categorical.
+   */
+  template<typename T, typename InputType>
+  void MapFirstPass(const InputType& input,
+                    const size_t dim,
+                    std::vector<Datatype>& types)
+  {
+    if (types[dim] == Datatype::categorical)
+    {
+      // No need to check; it's already categorical.
+      return;
+    }
+
+    if (forceAllMappings)
+    {
+      types[dim] = Datatype::categorical;
+    }
+    else
+    {
+      // Attempt to convert the input to an output type via a stringstream.
+      std::stringstream token;
+      token << input;
+      T val;
+      token >> val;
+
+      if (token.fail() || !token.eof())
+        types[dim] = Datatype::categorical;
+    }
+  }
+
+  /**
+   * Given the input and the dimension to which it belongs, and the maps and
+   * types given by the DatasetMapper class, returns its numeric mapping.  If
+   * no mapping yet exists, the input is interned and receives the next
+   * unsigned integer as its mapping.  This function is used as a helper
+   * function for the DatasetMapper class.
+   *
+   * @tparam MapType Type of the storage that contains the mappings.
+   * @param input Input to find/create mapping for.
+   * @param dimension Index of the dimension of the input.
+   * @param maps Map storage given by the DatasetMapper.
+   * @param types Vector containing the type information about each dimension.
+   */
+  template<typename MapType, typename T, typename InputType>
+  T MapString(const InputType& input,
+              const size_t dimension,
+              MapType& maps,
+              std::vector<Datatype>& types)
+  {
+    // If we are in a categorical dimension we already know we need to map.
+    if (types[dimension] == Datatype::numeric && !forceAllMappings)
+    {
+      // Check if this input needs to be mapped or if it can be read
+      // directly as a number.  This will be true if nothing else in this
+      // dimension has yet been mapped, but this can't be read as a number.
+      std::stringstream token;
+      token << input;
+      T val;
+      token >> val;
+
+      if (!token.fail() && token.eof())
+        return val;
+
+      // Otherwise, we must map.
+    }
+
+    // If this condition is true, either we have no mapping for the given input
+    // or we have no mappings for the given dimension at all.  In either case,
+    // we create a mapping.
+    if (maps.count(dimension) == 0 ||
+        maps[dimension].first.count(input) == 0)
+    {
+      // This input does not exist yet; intern it.  The reverse mapping needs
+      // no bookkeeping, since the interning order is the mapping.
+      size_t numMappings = maps[dimension].first.size();
+
+      // Change type of the feature to categorical.
+      if (numMappings == 0)
+        types[dimension] = Datatype::categorical;
+
+      maps[dimension].first.insert(std::make_pair(input, numMappings));
+
+      return T(numMappings);
+    }
+    else
+    {
+      // This input already exists in the mapping.
+      return maps[dimension].first.at(input);
+    }
+  }
+
+ private:
+  // Whether or not we should map all tokens.
+  bool forceAllMappings;
+}; // class InternedIncrementPolicy
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,325 @@
+/**
+ * @file core/data/map_policies/interned_string_map.hpp
+ * @author Ryan Curtin
+ *
+ * Interned per-dimension map storage for DatasetMapper.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAP_POLICIES_INTERNED_STRING_MAP_HPP
+#define MLPACK_CORE_DATA_MAP_POLICIES_INTERNED_STRING_MAP_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <deque>
+#include <vector>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Per-dimension map storage for DatasetMapper that interns every category
+ * exactly once.
+ *
+ * The default storage keeps two unordered maps per dimension---one from input
+ * to mapped value and one from mapped value back to input---so every category
+ * is stored twice and every entry pays the allocation and pointer overhead of
+ * two hash map nodes.  For ID-like dimensions with millions of categories,
+ * that overhead dwarfs the categories themselves.
+ *
+ * This class stores each distinct input once, in a node-stable pool, and
+ * resolves forward lookups through a flat open-addressing hash table
+ * (power-of-two size, linear probing) that holds only indices into the pool.
+ * Mapped values are required to be assigned in interning order (0, 1, 2,
+ * ...), which is exactly what InternedIncrementPolicy produces; the reverse
+ * direction therefore needs no second table at all, since value v unmaps to
+ * the v-th interned input.  The serialized form is equally compact: only the
+ * pool is written, in interning order, and the hash table is rebuilt on load.
+ *
+ * The `first` (forward) and `second` (reverse) members mirror the part of the
+ * std::pair<ForwardMapType, ReverseMapType> interface that DatasetMapper
+ * uses, so this class can be dropped in as the per-dimension storage via a
+ * policy's MapStorageType (see InternedIncrementPolicy).
+ *
+ * @tparam InputType Type of input to be mapped (e.g. std::string).
+ * @tparam MappedType Numeric type the inputs are mapped to.
+ */
+template<typename InputType, typename MappedType>
+class InternedStringMap
+{
+ public:
+  /**
+   * The forward side of the map: it owns the interned pool and the
+   * open-addressing table, and maps inputs to their interning order.
+   */
+  class ForwardMap
+  {
+   public:
+    //! Return 1 if the map contains the given input, 0 otherwise.
+    size_t count(const InputType& input) const
+    {
+      return (Find(input) != notFound) ? 1 : 0;
+    }
+
+    /**
+     * Return the value of the given input.  Throws std::out_of_range if the
+     * input has not been mapped.
+     *
+     * @param input Input to look up.
+     */
+    MappedType at(const InputType& input) const
+    {
+      const size_t index = Find(input);
+      if (index == notFound)
+      {
+        throw std::out_of_range("InternedStringMap::at(): the given input "
+            "has not been mapped!");
+      }
+
+      return MappedType(index);
+    }
+
+    //! Get the number of interned inputs.
+    size_t size() const { return inputs.size(); }
+
+    /**
+     * Insert the given (input, value) pair.  The value must be the current
+     * size of the map: the storage relies on values being assigned in
+     * interning order, and throws std::invalid_argument otherwise.
+     *
+     * @param pair Pair of input and its mapped value.
+     */
+    void insert(const std::pair<InputType, MappedType>& pair)
+    {
+      if ((size_t) pair.second != inputs.size())
+      {
+        throw std::invalid_argument("InternedStringMap::insert(): mapped "
+            "values must be assigned in interning order!");
+      }
+
+      // Keep the load factor at 0.5 or below.
+      if (2 * (inputs.size() + 1) > table.size())
+        Grow();
+
+      inputs.push_back(pair.first);
+
+      size_t slot = std::hash<InputType>()(inputs.back()) &
+          (table.size() - 1);
+      while (table[slot] != 0)
+        slot = (slot + 1) & (table.size() - 1);
+
+      // Slots hold the pool index plus one, so that 0 can mean 'empty'.
+      table[slot] = inputs.size();
+    }
+
+    //! Get the interned input with the given pool index.
+    const InputType& operator[](const size_t index) const
+    {
+      return inputs[index];
+    }
+
+    /**
+     * Serialize the map in its compact form: only the interned pool is
+     * written, in interning order; the hash table is rebuilt when loading.
+     */
+    template<typename Archive>
+    void serialize(Archive& ar, const uint32_t /* version */)
+    {
+      size_t numInputs = inputs.size();
+
+      ar(CEREAL_NVP(numInputs));
+
+      if (cereal::is_loading<Archive>())
+      {
+        inputs.clear();
+        table.clear();
+
+        for (size_t i = 0; i < numInputs; ++i)
+        {
+          InputType input;
+          ar(CEREAL_NVP(input));
+          insert(std::make_pair(std::move(input), MappedType(i)));
+        }
+      }
+      if (cereal::is_saving<Archive>())
+      {
+        for (InputType& input : inputs)
+          ar(CEREAL_NVP(input));
+      }
+    }
+
+   private:
+    //! Returned by Find() if the input is not in the map.
+    static const size_t notFound = size_t(-1);
+
+    /**
+     * Look the input up in the table.  Returns its pool index, or notFound if
+     * the input has not been mapped.
+     */
+    size_t Find(const InputType& input) const
+    {
+      if (table.empty())
+        return notFound;
+
+      size_t slot = std::hash<InputType>()(input) & (table.size() - 1);
+      while (table[slot] != 0)
+      {
+        if (inputs[table[slot] - 1] == input)
+          return table[slot] - 1;
+
+        slot = (slot + 1) & (table.size() - 1);
+      }
+
+      return notFound;
+    }
+
+    //! Double the table size (at least 16 slots) and rehash all entries.
+    void Grow()
+    {
+      size_t newSize = std::max<size_t>(2 * table.size(), 16);
+      while (newSize < 2 * (inputs.size() + 1))
+        newSize <<= 1;
+
+      table.assign(newSize, 0);
+
+      for (size_t i = 0; i < inputs.size(); ++i)
+      {
+        size_t slot = std::hash<InputType>()(inputs[i]) & (newSize - 1);
+        while (table[slot] != 0)
+          slot = (slot + 1) & (newSize - 1);
+
+        table[slot] = i + 1;
+      }
+    }
+
+    //! The interned pool, in interning order.  A deque keeps the stored
+    //! inputs node-stable, so references returned to callers survive growth.
+    std::deque<InputType> inputs;
+
+    //! The open-addressing table; slots hold pool indices plus one (0 means
+    //! the slot is empty).  The size is always a power of two.
+    std::vector<size_t> table;
+  };
+
+  /**
+   * The result of a reverse lookup.  Interned mappings are unique, so this
+   * always represents exactly one input; the vector-like interface matches
+   * what DatasetMapper expects from the default reverse map.
+   */
+  class Unmappings
+  {
+   public:
+    //! Construct the result for the given pool entry.
+    Unmappings(const ForwardMap& forward, const size_t index) :
+        forward(forward), index(index) { }
+
+    //! Interned mappings are unique.
+    size_t size() const { return 1; }
+
+    //! Get the input; the only valid index is 0.
+    const InputType& operator[](const size_t /* unmappingIndex */) const
+    {
+      return forward[index];
+    }
+
+   private:
+    //! The forward map holding the pool.
+    const ForwardMap& forward;
+    //! The pool index of the input.
+    size_t index;
+  };
+
+  /**
+   * The reverse side of the map.  It holds no data of its own: since values
+   * are assigned in interning order, value v unmaps to the v-th interned
+   * input of the forward side.
+   */
+  class ReverseMap
+  {
+   public:
+    //! Construct the reverse side over the given forward map.
+    explicit ReverseMap(const ForwardMap& forward) : forward(&forward) { }
+
+    //! Return 1 if the given value has an unmapping, 0 otherwise.
+    template<typename T>
+    size_t count(const T value) const
+    {
+      return ((size_t) value < forward->size()) ? 1 : 0;
+    }
+
+    /**
+     * Return the unmappings of the given value.  Throws std::out_of_range if
+     * the value is not a valid mapping.
+     *
+     * @param value Mapped value to look up.
+     */
+    template<typename T>
+    Unmappings at(const T value) const
+    {
+      if ((size_t) value >= forward->size())
+      {
+        throw std::out_of_range("InternedStringMap::at(): the given value "
+            "is not a valid mapping!");
+      }
+
+      return Unmappings(*forward, (size_t) value);
+    }
+
+   private:
+    //! The forward map holding the pool.
+    const ForwardMap* forward;
+  };
+
+  //! Construct an empty map.
+  InternedStringMap() : second(first) { }
+
+  //! Copy the map; the reverse side is rebound to this object's forward side.
+  InternedStringMap(const InternedStringMap& other) :
+      first(other.first), second(first) { }
+
+  //! Move the map; the reverse side is rebound to this object's forward side.
+  InternedStringMap(InternedStringMap&& other) :
+      first(std::move(other.first)), second(first) { }
+
+  //! Copy the map.
+  InternedStringMap& operator=(const InternedStringMap& other)
+  {
+    if (this != &other)
+      first = other.first;
+
+    return *this;
+  }
+
+  //! Move the map.
+  InternedStringMap& operator=(InternedStringMap&& other)
+  {
+    if (this != &other)
+      first = std::move(other.first);
+
+    return *this;
+  }
+
+  /**
+   * Serialize the map; only the forward side holds data.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(cereal::make_nvp("forward", first));
+  }
+
+  //! The forward map (input to value); named to mirror the default
+  //! std::pair-based storage.
+  ForwardMap first;
+
+  //! The reverse map (value to input); named to mirror the default
+  //! std::pair-based storage.
+  ReverseMap second;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -16,6 +16,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "load.hpp"
+
 namespace mlpack {
 namespace data {
 
@@ -34,6 +36,24 @@ void NormalizeLabels(const RowType& labelsIn,
                      arma::Row<size_t>& labels,
                      arma::Col<eT>& mapping);
 
+/**
+ * Load labels from the given file and normalize them to the range [0, n) in
+ * one step.  The raw labels exist only in a temporary row vector inside this
+ * call, so the full-size unnormalized label row is released as soon as
+ * normalization finishes instead of lingering next to the normalized copy.
+ *
+ * @param filename Name of the file to load labels from.
+ * @param labels Vector that unsigned labels will be stored in.
+ * @param mapping Reverse mapping to convert new labels back to old labels.
+ * @param fatal If an error should stop the program.
+ * @return Boolean value indicating success or failure of the load.
+ */
+template<typename eT>
+bool NormalizeLabels(const std::string& filename,
+                     arma::Row<size_t>& labels,
+                     arma::Col<eT>& mapping,
+                     const bool fatal = false);
+
 /**
  * Given a set of labels that have been mapped to the range [0, n), map them
  * back to the original labels given by the 'mapping' vector.
@@ -66,6 +66,32 @@ void NormalizeLabels(const RowType& labelsIn,
   }
 }
 
+/**
+ * Load labels from the given file and normalize them to the range [0, n) in
+ * one step.
+ *
+ * @param filename Name of the file to load labels from.
+ * @param labels Vector that unsigned labels will be stored in.
+ * @param mapping Reverse mapping to convert new labels back to old labels.
+ * @param fatal If an error should stop the program.
+ * @return Boolean value indicating success or failure of the load.
+ */
+template<typename eT>
+bool NormalizeLabels(const std::string& filename,
+                     arma::Row<size_t>& labels,
+                     arma::Col<eT>& mapping,
+                     const bool fatal)
+{
+  // The raw labels live only for the duration of this scope; once they have
+  // been normalized, the temporary is freed and only the mapped copy remains.
+  arma::Row<eT> labelsIn;
+  if (!Load(filename, labelsIn, fatal))
+    return false;
+
+  NormalizeLabels(labelsIn, labels, mapping);
+  return true;
+}
+
 /**
  * Given a set of labels that have been mapped to the range [0, n), map them
  * back to the original labels given by the 'mapping' vector.
@@ -47,6 +47,23 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     const arma::Col<size_t>& indices,
                     arma::Mat<eT>& output);
 
+/**
+ * Overloaded function for the above function, which outputs a sparse matrix.
+ * One-hot encoded dimensions hold exactly one nonzero element per point, so
+ * for high-cardinality categorical dimensions the sparse output is smaller
+ * than the dense output by a factor of roughly the number of categories.
+ * The matrix is assembled with batch insertion, so the cost is proportional
+ * to the number of nonzero elements, not to the encoded size.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded sparse matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output);
+
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a DatasetInfo object and outputs a matrix.
@@ -62,6 +79,27 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     arma::Mat<eT>& output,
                     const data::DatasetInfo& datasetInfo);
 
+/**
+ * Overloaded function for the above function, which outputs a sparse matrix.
+ * The categorical dimensions of `input` are expected to hold values already
+ * mapped by the given DatasetMapper (as produced by data::Load()), so the
+ * encoding takes no extra pass over the data: each mapped dimension is
+ * expanded to `datasetInfo.NumMappings()` rows and the mapped value selects
+ * the nonzero row directly.  Because the expansion is derived from the
+ * mapper rather than from the values present in `input`, encoding several
+ * chunks of a dataset with the same mapper yields chunks with consistent
+ * dimensions.
+ *
+ * @param input Input dataset to be encoded; categorical dimensions must hold
+ *      mapped values.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetMapper object that has information about data.
+ */
+template<typename eT, typename PolicyType, typename InputType>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const DatasetMapper<PolicyType, InputType>& datasetInfo);
+
 } // namespace data
 } // namespace mlpack
 
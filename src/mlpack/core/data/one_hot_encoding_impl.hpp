@@ -143,6 +143,90 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   }
 }
 
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a vector of indices to encode and outputs a sparse matrix.
+ * Indices represent the IDs of the dimensions to be one-hot encoded.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded sparse matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output)
+{
+  // Handle the edge case where there is nothing to encode.
+  if (indices.n_elem == 0)
+  {
+    output = arma::SpMat<eT>(input);
+    return;
+  }
+
+  // First, develop the mappings and the size of the output matrix, exactly as
+  // in the dense overload.
+  arma::Col<size_t> dimensionOffsets(input.n_rows, arma::fill::ones);
+  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    dimensionOffsets[indices[i]] = 0;
+    mappings.insert(
+        std::make_pair(indices[i], std::unordered_map<eT, size_t>()));
+  }
+
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      if (mappings.count(row) != 0)
+      {
+        // We have to one-hot encode this point.
+        if (mappings[row].count(input(row, col)) == 0)
+          mappings[row][input(row, col)] = dimensionOffsets[row]++;
+      }
+    }
+  }
+
+  // Turn the dimension counts into offsets.
+  for (size_t i = 1; i < dimensionOffsets.n_elem; ++i)
+    dimensionOffsets[i] += dimensionOffsets[i - 1];
+
+  // Each input element produces at most one nonzero element in the output:
+  // a 1 for encoded dimensions, the value itself (if nonzero) for the others.
+  // Gather the nonzero elements and assemble the matrix with batch insertion,
+  // so we never touch the (possibly enormous) zero part of the encoding.
+  arma::umat locations(2, input.n_elem);
+  arma::Col<eT> values(input.n_elem);
+  size_t count = 0;
+
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      const size_t dimOffset = (row == 0) ? 0 : dimensionOffsets[row - 1];
+      if (mappings.count(row) != 0)
+      {
+        locations(0, count) = dimOffset + mappings[row][input(row, col)];
+        locations(1, count) = col;
+        values[count++] = eT(1);
+      }
+      else if (input(row, col) != eT(0))
+      {
+        // No need for one-hot encoding.
+        locations(0, count) = dimOffset;
+        locations(1, count) = col;
+        values[count++] = input(row, col);
+      }
+    }
+  }
+
+  // The locations are already sorted (column-major traversal), so the batch
+  // constructor does not need to re-sort them.
+  output = arma::SpMat<eT>(locations.head_cols(count), values.head(count),
+      dimensionOffsets[dimensionOffsets.n_elem - 1], input.n_cols, false);
+}
+
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a DatasetInfo object and outputs a matrix.
@@ -169,6 +253,66 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   OneHotEncoding(input, arma::Col<size_t>(indices), output);
 }
 
+/**
+ * Overloaded function for the above function, which takes a matrix whose
+ * categorical dimensions hold values already mapped by the given
+ * DatasetMapper, and outputs a sparse matrix.
+ *
+ * @param input Input dataset to be encoded; categorical dimensions must hold
+ *      mapped values.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetMapper object that has information about data.
+ */
+template<typename eT, typename PolicyType, typename InputType>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const DatasetMapper<PolicyType, InputType>& datasetInfo)
+{
+  // The mapper already knows the category count of every categorical
+  // dimension, so the output size can be computed without a pass over the
+  // data, and mapped values select their one-hot rows directly.
+  arma::Col<size_t> dimensionOffsets(input.n_rows);
+  for (size_t i = 0; i < input.n_rows; ++i)
+  {
+    dimensionOffsets[i] =
+        (datasetInfo.Type(i) == data::Datatype::categorical) ?
+        datasetInfo.NumMappings(i) : 1;
+  }
+
+  // Turn the dimension counts into offsets.
+  for (size_t i = 1; i < dimensionOffsets.n_elem; ++i)
+    dimensionOffsets[i] += dimensionOffsets[i - 1];
+
+  // Gather the nonzero elements and assemble the matrix with batch insertion,
+  // as in the index-based sparse overload.
+  arma::umat locations(2, input.n_elem);
+  arma::Col<eT> values(input.n_elem);
+  size_t count = 0;
+
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      const size_t dimOffset = (row == 0) ? 0 : dimensionOffsets[row - 1];
+      if (datasetInfo.Type(row) == data::Datatype::categorical)
+      {
+        locations(0, count) = dimOffset + (size_t) input(row, col);
+        locations(1, count) = col;
+        values[count++] = eT(1);
+      }
+      else if (input(row, col) != eT(0))
+      {
+        locations(0, count) = dimOffset;
+        locations(1, count) = col;
+        values[count++] = input(row, col);
+      }
+    }
+  }
+
+  output = arma::SpMat<eT>(locations.head_cols(count), values.head(count),
+      dimensionOffsets[dimensionOffsets.n_elem - 1], input.n_cols, false);
+}
+
 } // namespace data
 } // namespace mlpack
 
@@ -0,0 +1,243 @@
+/**
+ * @file core/data/out_of_core_matrix.hpp
+ * @author Ryan Curtin
+ *
+ * An out-of-core matrix for datasets larger than RAM.  The matrix is backed
+ * by a binary columnar dataset file (see columnar_io.hpp) mapped read-only
+ * into the process's address space; the operating system pages columns in as
+ * they are touched and evicts them under memory pressure, so only a working
+ * window of the dataset is ever resident.
+ *
+ * The data is exposed as a const arma::mat that aliases the mapping, which
+ * means any algorithm taking a const matrix reference — LinearRegression,
+ * LogisticRegression, KMeans, and so on — can train on it directly, streaming
+ * columns from disk instead of requiring the dataset in memory.  For batch
+ * algorithms with a predictable access pattern, Prefetch() and Release() give
+ * explicit control over the resident column window.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_OUT_OF_CORE_MATRIX_HPP
+#define MLPACK_CORE_DATA_OUT_OF_CORE_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "columnar_io.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A read-only matrix backed by a memory-mapped columnar dataset file.
+ *
+ * Example usage:
+ *
+ * @code
+ * // Convert the dataset once (e.g. in a preprocessing step).
+ * data::Save("dataset.mcol", dataset);
+ *
+ * // Train without materializing the dataset in RAM.
+ * data::OutOfCoreMatrix<> dataset("dataset.mcol");
+ * regression::LinearRegression lr;
+ * lr.Train(dataset.Matrix(), responses);
+ * @endcode
+ *
+ * On platforms without mmap() support the file is simply loaded into memory,
+ * so the class degrades to an ordinary matrix load.
+ *
+ * @tparam eT Element type of the matrix.
+ */
+template<typename eT = double>
+class OutOfCoreMatrix
+{
+ public:
+  /**
+   * Map the given columnar dataset file.  Throws std::runtime_error if the
+   * file is missing, malformed, or holds a different element type than eT.
+   *
+   * @param filename Name of the columnar dataset file (.mcol) to map.
+   */
+  OutOfCoreMatrix(const std::string& filename) :
+      mapping(NULL),
+      mappingLength(0)
+  {
+    // Read and validate the header.
+    char header[details::columnarHeaderSize];
+    {
+      std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+      if (!stream.is_open())
+        throw std::runtime_error("OutOfCoreMatrix: cannot open file '" +
+            filename + "'!");
+
+      stream.read(header, (std::streamsize) details::columnarHeaderSize);
+      if (stream.gcount() != (std::streamsize) details::columnarHeaderSize)
+        throw std::runtime_error("OutOfCoreMatrix: file '" + filename + "' is "
+            "too short to be a columnar dataset file!");
+    }
+
+    if (std::memcmp(header, details::columnarMagic,
+        sizeof(details::columnarMagic)) != 0)
+      throw std::runtime_error("OutOfCoreMatrix: file '" + filename + "' is "
+          "not a columnar dataset file!");
+
+    uint64_t version, elemSize, typeCode, rows, cols;
+    std::memcpy(&version, header + 8, sizeof(uint64_t));
+    std::memcpy(&elemSize, header + 16, sizeof(uint64_t));
+    std::memcpy(&typeCode, header + 24, sizeof(uint64_t));
+    std::memcpy(&rows, header + 32, sizeof(uint64_t));
+    std::memcpy(&cols, header + 40, sizeof(uint64_t));
+
+    if (version != 1)
+      throw std::runtime_error("OutOfCoreMatrix: file '" + filename + "' has "
+          "unknown format version " + std::to_string(version) + "!");
+
+    if (elemSize != sizeof(eT) || typeCode != details::ColumnarTypeCode<eT>())
+      throw std::runtime_error("OutOfCoreMatrix: element type of file '" +
+          filename + "' does not match the requested matrix type!");
+
+    const size_t payloadBytes = (size_t) (rows * cols * elemSize);
+
+#if !defined(_WIN32)
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+      struct stat st;
+      if (fstat(fd, &st) != 0 || (size_t) st.st_size <
+          details::columnarHeaderSize + payloadBytes)
+      {
+        close(fd);
+        throw std::runtime_error("OutOfCoreMatrix: file '" + filename + "' is "
+            "shorter than its header claims!");
+      }
+
+      mappingLength = details::columnarHeaderSize + payloadBytes;
+      void* address = mmap(NULL, mappingLength, PROT_READ, MAP_PRIVATE, fd,
+          0);
+      close(fd);
+
+      if (address != MAP_FAILED)
+      {
+        mapping = address;
+
+        // Rebuild the matrix member in place as an alias of the mapping;
+        // assigning an auxiliary-memory matrix would copy the payload.
+        eT* payload = (eT*) ((char*) mapping +
+            details::columnarHeaderSize);
+        matrix.~Mat();
+        new (&matrix) arma::Mat<eT>(payload, (arma::uword) rows,
+            (arma::uword) cols, false, false);
+        return;
+      }
+
+      mappingLength = 0;
+    }
+#endif
+
+    // Mapping is unavailable; load the whole file instead.
+    LoadColumnar(filename, matrix);
+  }
+
+  //! Unmap the file.
+  ~OutOfCoreMatrix()
+  {
+#if !defined(_WIN32)
+    if (mapping != NULL)
+    {
+      // Detach the alias before the mapping disappears.
+      matrix.~Mat();
+      new (&matrix) arma::Mat<eT>();
+      munmap(mapping, mappingLength);
+    }
+#endif
+  }
+
+  //! Get the matrix view of the mapped dataset.  The reference stays valid
+  //! for the lifetime of this object.
+  const arma::Mat<eT>& Matrix() const { return matrix; }
+
+  //! Get the dimensionality of the dataset.
+  size_t Rows() const { return (size_t) matrix.n_rows; }
+  //! Get the number of points in the dataset.
+  size_t Cols() const { return (size_t) matrix.n_cols; }
+
+  /**
+   * Ask the operating system to read the given range of columns ahead of
+   * time.  A no-op if the dataset is not memory-mapped.
+   *
+   * @param firstCol First column of the window.
+   * @param numCols Number of columns in the window.
+   */
+  void Prefetch(const size_t firstCol, const size_t numCols) const
+  {
+#if !defined(_WIN32)
+    AdviseRange(firstCol, numCols, MADV_WILLNEED);
+#else
+    (void) firstCol;
+    (void) numCols;
+#endif
+  }
+
+  /**
+   * Tell the operating system that the given range of columns will not be
+   * needed soon, so its pages can be dropped immediately.  Together with
+   * Prefetch(), this lets a batch algorithm slide a bounded column window
+   * across a dataset much larger than RAM.  A no-op if the dataset is not
+   * memory-mapped.
+   *
+   * @param firstCol First column of the window.
+   * @param numCols Number of columns in the window.
+   */
+  void Release(const size_t firstCol, const size_t numCols) const
+  {
+#if !defined(_WIN32)
+    AdviseRange(firstCol, numCols, MADV_DONTNEED);
+#else
+    (void) firstCol;
+    (void) numCols;
+#endif
+  }
+
+ private:
+#if !defined(_WIN32)
+  /**
+   * Apply the given madvise() advice to the pages holding the given column
+   * range.
+   */
+  void AdviseRange(const size_t firstCol,
+                   const size_t numCols,
+                   const int advice) const
+  {
+    if (mapping == NULL || numCols == 0 || firstCol >= Cols())
+      return;
+
+    const size_t lastCol = std::min(firstCol + numCols, Cols());
+    const size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+
+    size_t begin = details::columnarHeaderSize +
+        firstCol * Rows() * sizeof(eT);
+    size_t end = details::columnarHeaderSize + lastCol * Rows() * sizeof(eT);
+
+    // Align the range outward to page boundaries.
+    begin = (begin / pageSize) * pageSize;
+    end = std::min(((end + pageSize - 1) / pageSize) * pageSize,
+        mappingLength);
+
+    madvise((char*) mapping + begin, end - begin, advice);
+  }
+#endif
+
+  //! The mapped region (NULL if the fallback load was used).
+  void* mapping;
+  //! Length of the mapped region, in bytes.
+  size_t mappingLength;
+  //! Alias of the mapped payload (or the loaded data, in the fallback case).
+  arma::Mat<eT> matrix;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
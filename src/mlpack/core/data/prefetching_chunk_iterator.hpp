@@ -0,0 +1,269 @@
+/**
+ * @file core/data/prefetching_chunk_iterator.hpp
+ * @author Ryan Curtin
+ *
+ * An iterator that yields a dataset in column chunks, reading each chunk on a
+ * background thread while the caller works on the previous one.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_PREFETCHING_CHUNK_ITERATOR_HPP
+#define MLPACK_CORE_DATA_PREFETCHING_CHUNK_ITERATOR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * PrefetchingChunkIterator yields a dataset (and, optionally, its aligned
+ * responses) in chunks of columns.  A background thread copies the next
+ * chunks out of the source matrix into a bounded queue while the caller is
+ * still working on the current one, so that the time spent materializing a
+ * chunk---in particular the disk reads when the source is the mapped view of
+ * an OutOfCoreMatrix, where touching a column pages it in---overlaps with
+ * compute instead of preceding it.
+ *
+ * Example usage, streaming a dataset larger than RAM through a training loop:
+ *
+ * @code
+ * data::OutOfCoreMatrix<> dataset("dataset.mcol");
+ * data::PrefetchingChunkIterator<> it(dataset.Matrix(), responses);
+ *
+ * arma::mat chunk, chunkResponses;
+ * while (it.Next(chunk, chunkResponses))
+ *   model.Train(std::move(chunk), std::move(chunkResponses), optimizer);
+ * @endcode
+ *
+ * The source matrices are held by reference and must outlive the iterator.
+ * The iterator itself is not thread-safe: only one consumer thread may call
+ * Next() and Reset().
+ *
+ * @tparam eT Element type of the dataset.
+ */
+template<typename eT = double>
+class PrefetchingChunkIterator
+{
+ public:
+  /**
+   * Create an iterator over the columns of the given dataset.
+   *
+   * @param predictors Dataset to iterate over, in column-major chunks.
+   * @param chunkSize Number of columns per chunk (the last chunk may be
+   *     smaller).
+   * @param maxQueuedChunks Bound on the number of chunks the background
+   *     thread may hold ready; this bounds the extra memory to
+   *     (maxQueuedChunks + 1) chunks.
+   */
+  PrefetchingChunkIterator(const arma::Mat<eT>& predictors,
+                           const size_t chunkSize = 4096,
+                           const size_t maxQueuedChunks = 2) :
+      predictors(predictors),
+      responses(NULL),
+      chunkSize(std::max(chunkSize, (size_t) 1)),
+      maxQueuedChunks(std::max(maxQueuedChunks, (size_t) 1)),
+      stop(false),
+      exhausted(false)
+  {
+    StartWorker();
+  }
+
+  /**
+   * Create an iterator over the columns of the given dataset and its aligned
+   * responses; each yielded chunk holds the same columns of both.
+   *
+   * @param predictors Dataset to iterate over, in column-major chunks.
+   * @param responses Responses aligned with the columns of `predictors`.
+   * @param chunkSize Number of columns per chunk (the last chunk may be
+   *     smaller).
+   * @param maxQueuedChunks Bound on the number of chunks the background
+   *     thread may hold ready; this bounds the extra memory to
+   *     (maxQueuedChunks + 1) chunks.
+   */
+  PrefetchingChunkIterator(const arma::Mat<eT>& predictors,
+                           const arma::Mat<eT>& responses,
+                           const size_t chunkSize = 4096,
+                           const size_t maxQueuedChunks = 2) :
+      predictors(predictors),
+      responses(&responses),
+      chunkSize(std::max(chunkSize, (size_t) 1)),
+      maxQueuedChunks(std::max(maxQueuedChunks, (size_t) 1)),
+      stop(false),
+      exhausted(false)
+  {
+    if (responses.n_cols != predictors.n_cols)
+    {
+      throw std::invalid_argument("PrefetchingChunkIterator: predictors and "
+          "responses must have the same number of columns!");
+    }
+
+    StartWorker();
+  }
+
+  //! Stop the background thread.
+  ~PrefetchingChunkIterator()
+  {
+    StopWorker();
+  }
+
+  //! No copies: the iterator owns a running thread.
+  PrefetchingChunkIterator(const PrefetchingChunkIterator&) = delete;
+  PrefetchingChunkIterator& operator=(const PrefetchingChunkIterator&) =
+      delete;
+
+  /**
+   * Get the next chunk of predictors (and responses, if the iterator was
+   * created with them).  Blocks until a chunk is ready.  Returns false when
+   * the dataset is exhausted; call Reset() to start a new pass.
+   *
+   * @param predictorChunk Matrix to place the chunk of predictors into.
+   */
+  bool Next(arma::Mat<eT>& predictorChunk)
+  {
+    arma::Mat<eT> unusedResponses;
+    return Next(predictorChunk, unusedResponses);
+  }
+
+  /**
+   * Get the next chunk of predictors and responses.  Blocks until a chunk is
+   * ready.  Returns false when the dataset is exhausted; call Reset() to
+   * start a new pass.
+   *
+   * @param predictorChunk Matrix to place the chunk of predictors into.
+   * @param responseChunk Matrix to place the chunk of responses into; left
+   *     empty if the iterator was created without responses.
+   */
+  bool Next(arma::Mat<eT>& predictorChunk, arma::Mat<eT>& responseChunk)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    notEmpty.wait(lock, [this]() { return !chunks.empty() || exhausted; });
+
+    if (chunks.empty())
+      return false; // The pass is over.
+
+    predictorChunk = std::move(chunks.front().predictors);
+    responseChunk = std::move(chunks.front().responses);
+    chunks.pop();
+
+    notFull.notify_one();
+    return true;
+  }
+
+  /**
+   * Restart the iterator at the first chunk, e.g. for the next epoch of a
+   * training loop.  Any chunks of the previous pass that were not consumed
+   * are discarded.
+   */
+  void Reset()
+  {
+    StopWorker();
+    std::queue<Chunk>().swap(chunks);
+    stop = false;
+    exhausted = false;
+    StartWorker();
+  }
+
+  //! Get the number of chunks in one pass over the dataset.
+  size_t NumChunks() const
+  {
+    return (predictors.n_cols + chunkSize - 1) / chunkSize;
+  }
+
+  //! Get the number of columns per chunk.
+  size_t ChunkSize() const { return chunkSize; }
+
+ private:
+  //! A materialized chunk: aligned columns of predictors and responses.
+  struct Chunk
+  {
+    arma::Mat<eT> predictors;
+    arma::Mat<eT> responses;
+  };
+
+  //! Launch the background thread at the first chunk.
+  void StartWorker()
+  {
+    worker = std::thread([this]() { WorkerLoop(); });
+  }
+
+  //! Ask the background thread to finish and join it.
+  void StopWorker()
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      stop = true;
+      notFull.notify_all();
+    }
+    if (worker.joinable())
+      worker.join();
+  }
+
+  //! The background thread: materialize chunks in order, keeping at most
+  //! maxQueuedChunks of them queued.
+  void WorkerLoop()
+  {
+    const size_t numChunks = NumChunks();
+    for (size_t i = 0; i < numChunks; ++i)
+    {
+      // Copy the columns outside of the lock; for memory-mapped sources this
+      // is where the pages are read from disk.
+      const size_t begin = i * chunkSize;
+      const size_t end = std::min(begin + chunkSize,
+          (size_t) predictors.n_cols);
+
+      Chunk chunk;
+      chunk.predictors = predictors.cols(begin, end - 1);
+      if (responses != NULL)
+        chunk.responses = responses->cols(begin, end - 1);
+
+      std::unique_lock<std::mutex> lock(mutex);
+      notFull.wait(lock,
+          [this]() { return chunks.size() < maxQueuedChunks || stop; });
+      if (stop)
+        return;
+
+      chunks.push(std::move(chunk));
+      notEmpty.notify_one();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    exhausted = true;
+    notEmpty.notify_all();
+  }
+
+  //! The dataset the chunks are copied from.
+  const arma::Mat<eT>& predictors;
+  //! The aligned responses, or NULL if none were given.
+  const arma::Mat<eT>* responses;
+  //! Number of columns per chunk.
+  size_t chunkSize;
+  //! Bound on the number of queued chunks.
+  size_t maxQueuedChunks;
+
+  //! The bounded queue of ready chunks and its synchronization.
+  std::queue<Chunk> chunks;
+  std::mutex mutex;
+  std::condition_variable notEmpty;
+  std::condition_variable notFull;
+
+  //! Set to ask the background thread to finish early.
+  bool stop;
+  //! Set by the background thread once the last chunk has been queued.
+  bool exhausted;
+
+  //! The background thread.
+  std::thread worker;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
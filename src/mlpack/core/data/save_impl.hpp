@@ -16,6 +16,7 @@
 #include "save.hpp"
 #include "extension.hpp"
 #include "detect_file_type.hpp"
+#include "columnar_io.hpp"
 
 #include <cereal/archives/xml.hpp>
 #include <cereal/archives/json.hpp>
@@ -52,6 +53,32 @@ bool Save(const std::string& filename,
 {
   Timer::Start("saving_data");
 
+  // mlpack's native columnar format is written directly; the matrix is stored
+  // in its in-memory orientation regardless of the transpose flag, so that
+  // loading it back can alias the file without any rearrangement.
+  if (Extension(filename) == "mcol")
+  {
+    Log::Info << "Saving mlpack columnar binary data to '" << filename << "'."
+        << std::endl;
+    try
+    {
+      SaveColumnar(filename, matrix);
+    }
+    catch (std::exception& e)
+    {
+      Timer::Stop("saving_data");
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+
+    Timer::Stop("saving_data");
+    return true;
+  }
+
   arma::file_type saveType = inputSaveType;
   std::string stringType = "";
 
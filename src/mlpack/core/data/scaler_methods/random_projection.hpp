@@ -0,0 +1,131 @@
+/**
+ * @file core/data/scaler_methods/random_projection.hpp
+ * @author Ryan Curtin
+ *
+ * Random projection preprocessing, using the subsampled randomized Hadamard
+ * transform.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_RANDOM_PROJECTION_SCALE_HPP
+#define MLPACK_CORE_DATA_RANDOM_PROJECTION_SCALE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/fast_projection.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A simple RandomProjection class.
+ *
+ * Reduces the dimensionality of a dataset with a fast Johnson-Lindenstrauss
+ * random projection (the subsampled randomized Hadamard transform).  Pairwise
+ * distances are approximately preserved, so the projected data can be fed to
+ * distance-based methods at a fraction of the cost of the original
+ * dimensionality.  Note that, unlike the other scalers, the transform changes
+ * the number of dimensions, and InverseTransform() can only return the
+ * least-squares reconstruction of the original points.
+ *
+ * @code
+ * arma::mat input;
+ * Load("train.csv", input);
+ * arma::mat output;
+ *
+ * // Fit the features.
+ * RandomProjection scale(20);
+ * scale.Fit(input)
+ *
+ * // Scale the features.
+ * scale.Transform(input, output);
+ *
+ * // Retransform the input (approximately).
+ * scale.InverseTransform(output, input);
+ * @endcode
+ */
+class RandomProjection
+{
+ public:
+  /**
+   * A constructor to set the dimensionality to project to.
+   *
+   * @param newDimension Dimensionality of the projected dataset.
+   */
+  RandomProjection(const size_t newDimension = 0) : newDimension(newDimension)
+  { }
+
+  /**
+   * Function to fit features, to draw the random projection.
+   *
+   * @param input Dataset to fit.
+   */
+  template<typename MatType>
+  void Fit(const MatType& input)
+  {
+    if (newDimension == 0)
+    {
+      throw std::runtime_error("New dimensionality is not correct");
+    }
+
+    projection = math::SubsampledHadamardProjection(input.n_rows,
+        newDimension);
+  }
+
+  /**
+   * Function to project the features.
+   *
+   * @param input Dataset to scale features.
+   * @param output Output matrix with projected features.
+   */
+  template<typename MatType>
+  void Transform(const MatType& input, MatType& output)
+  {
+    if (projection.OutputDim() == 0)
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+          " refer to the documentation.");
+    }
+    projection.Project(input, output);
+  }
+
+  /**
+   * Function to retrieve an approximation of the original dataset.  The
+   * projection is not invertible, so this applies its pseudoinverse and
+   * returns the least-squares reconstruction.
+   *
+   * @param input Scaled dataset.
+   * @param output Output matrix with approximately reconstructed dataset.
+   */
+  template<typename MatType>
+  void InverseTransform(const MatType& input, MatType& output)
+  {
+    projection.ProjectBack(input, output);
+  }
+
+  //! Get the new dimensionality.
+  const size_t& NewDimension() const { return newDimension; }
+  //! Get the fitted projection.
+  const math::SubsampledHadamardProjection& Projection() const
+  { return projection; }
+
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(newDimension));
+    ar(CEREAL_NVP(projection));
+  }
+
+ private:
+  // Dimensionality to project to.
+  size_t newDimension;
+  // The fitted random projection.
+  math::SubsampledHadamardProjection projection;
+}; // class RandomProjection
+
+} // namespace data
+} // namespace mlpack
+
+#endif
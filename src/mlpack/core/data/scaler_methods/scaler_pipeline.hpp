@@ -0,0 +1,249 @@
+/**
+ * @file core/data/scaler_methods/scaler_pipeline.hpp
+ * @author Jeffin Sam
+ *
+ * ScalerPipeline class to chain several scalers into one transformation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SCALER_PIPELINE_HPP
+#define MLPACK_CORE_DATA_SCALER_PIPELINE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A composable pipeline of scalers.
+ *
+ * The pipeline owns one instance of every scaler type and applies them in
+ * order.  Fit() fits the first scaler on the data, the second scaler on the
+ * data as transformed by the first, and so on, using a single shared working
+ * copy instead of one intermediate matrix per stage.  Transform() and
+ * InverseTransform() walk the data in column blocks and push each block
+ * through the whole chain before touching the next one, so the data is swept
+ * once in total rather than once per stage and the only temporary is one
+ * block per thread; the in-place overloads never allocate a full-size matrix
+ * at all.
+ *
+ * Every scaler that transforms its columns independently can be chained; this
+ * covers all of the scalers in this directory.  The fitted pipeline
+ * serializes as a unit.
+ *
+ * @code
+ * arma::mat input;
+ * Load("train.csv", input);
+ *
+ * // Standardize, then whiten.
+ * ScalerPipeline<StandardScaler, PCAWhitening> pipeline;
+ * pipeline.Fit(input);
+ *
+ * // Scale the features in place.
+ * pipeline.Transform(input);
+ *
+ * // Retransform the input.
+ * pipeline.InverseTransform(input);
+ * @endcode
+ *
+ * @tparam ScalerTypes The scaler types to apply, in order.
+ */
+template<typename... ScalerTypes>
+class ScalerPipeline
+{
+  static_assert(sizeof...(ScalerTypes) > 0,
+      "ScalerPipeline requires at least one scaler type!");
+
+ public:
+  /**
+   * Construct the pipeline with default-constructed scalers.
+   *
+   * @param blockSize Number of columns pushed through the chain at a time by
+   *     the blockwise transforms.
+   */
+  ScalerPipeline(const size_t blockSize = 1024) : blockSize(blockSize) { }
+
+  /**
+   * Construct the pipeline from already-constructed scalers (useful for
+   * scalers with constructor parameters, like MinMaxScaler's range).
+   *
+   * @param scalers The scalers to apply, in order.
+   */
+  ScalerPipeline(ScalerTypes... scalers) :
+      scalers(std::move(scalers)...),
+      blockSize(1024)
+  { }
+
+  /**
+   * Fit every scaler in the chain.  Each scaler is fit on the data as
+   * transformed by its predecessors; one working copy of the data is shared
+   * by all stages.
+   *
+   * @param input Dataset to fit.
+   */
+  template<typename MatType>
+  void Fit(const MatType& input)
+  {
+    MatType working(input);
+    FitStage<0>(working);
+  }
+
+  /**
+   * Apply the whole chain to the data in place, one column block at a time.
+   *
+   * @param data Dataset to scale; overwritten with the scaled features.
+   */
+  template<typename MatType>
+  void Transform(MatType& data)
+  {
+    const size_t cols = std::max<size_t>(blockSize, 1);
+    const size_t numBlocks = (data.n_cols + cols - 1) / cols;
+
+    // The blocks are disjoint, so they are pushed through the chain across
+    // threads.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+    {
+      const size_t begin = b * cols;
+      const size_t end = std::min(begin + cols, (size_t) data.n_cols) - 1;
+
+      arma::Mat<typename MatType::elem_type> block(data.cols(begin, end));
+      TransformStage<0>(block);
+      data.cols(begin, end) = block;
+    }
+  }
+
+  /**
+   * Apply the whole chain to the input, writing the scaled features to the
+   * output matrix.
+   *
+   * @param input Dataset to scale.
+   * @param output Output matrix with scaled features.
+   */
+  template<typename MatType>
+  void Transform(const MatType& input, MatType& output)
+  {
+    output = input;
+    Transform(output);
+  }
+
+  /**
+   * Undo the whole chain in place, applying the scalers' inverses in reverse
+   * order, one column block at a time.
+   *
+   * @param data Scaled dataset; overwritten with the original features.
+   */
+  template<typename MatType>
+  void InverseTransform(MatType& data)
+  {
+    const size_t cols = std::max<size_t>(blockSize, 1);
+    const size_t numBlocks = (data.n_cols + cols - 1) / cols;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+    {
+      const size_t begin = b * cols;
+      const size_t end = std::min(begin + cols, (size_t) data.n_cols) - 1;
+
+      arma::Mat<typename MatType::elem_type> block(data.cols(begin, end));
+      InverseTransformStage<0>(block);
+      data.cols(begin, end) = block;
+    }
+  }
+
+  /**
+   * Undo the whole chain, writing the original features to the output matrix.
+   *
+   * @param input Scaled dataset.
+   * @param output Output matrix with the original features.
+   */
+  template<typename MatType>
+  void InverseTransform(const MatType& input, MatType& output)
+  {
+    output = input;
+    InverseTransform(output);
+  }
+
+  //! Get the scaler at the given position in the chain.
+  template<size_t I>
+  const typename std::tuple_element<I, std::tuple<ScalerTypes...>>::type&
+  Scaler() const { return std::get<I>(scalers); }
+  //! Modify the scaler at the given position in the chain.
+  template<size_t I>
+  typename std::tuple_element<I, std::tuple<ScalerTypes...>>::type&
+  Scaler() { return std::get<I>(scalers); }
+
+  //! Get the number of columns per transform block.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of columns per transform block.
+  size_t& BlockSize() { return blockSize; }
+
+  //! Serialize the fitted pipeline as a unit.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(scalers));
+    ar(CEREAL_NVP(blockSize));
+  }
+
+ private:
+  //! Fit the last stage; the working copy does not need to be transformed
+  //! any further.
+  template<size_t I, typename MatType>
+  typename std::enable_if<I == sizeof...(ScalerTypes) - 1, void>::type
+  FitStage(MatType& working)
+  {
+    std::get<I>(scalers).Fit(working);
+  }
+
+  //! Fit a stage, transform the working copy in place, and move on.
+  template<size_t I, typename MatType>
+  typename std::enable_if<I < sizeof...(ScalerTypes) - 1, void>::type
+  FitStage(MatType& working)
+  {
+    std::get<I>(scalers).Fit(working);
+    std::get<I>(scalers).Transform(working, working);
+    FitStage<I + 1>(working);
+  }
+
+  //! Push a block through the stages, front to back.
+  template<size_t I, typename MatType>
+  typename std::enable_if<I < sizeof...(ScalerTypes), void>::type
+  TransformStage(MatType& block)
+  {
+    std::get<I>(scalers).Transform(block, block);
+    TransformStage<I + 1>(block);
+  }
+
+  template<size_t I, typename MatType>
+  typename std::enable_if<I == sizeof...(ScalerTypes), void>::type
+  TransformStage(MatType& /* block */) { }
+
+  //! Push a block through the stages' inverses, back to front.
+  template<size_t I, typename MatType>
+  typename std::enable_if<I < sizeof...(ScalerTypes), void>::type
+  InverseTransformStage(MatType& block)
+  {
+    std::get<sizeof...(ScalerTypes) - 1 - I>(scalers).InverseTransform(block,
+        block);
+    InverseTransformStage<I + 1>(block);
+  }
+
+  template<size_t I, typename MatType>
+  typename std::enable_if<I == sizeof...(ScalerTypes), void>::type
+  InverseTransformStage(MatType& /* block */) { }
+
+  //! The scalers, in application order.
+  std::tuple<ScalerTypes...> scalers;
+
+  //! Number of columns per transform block.
+  size_t blockSize;
+}; // class ScalerPipeline
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -62,6 +62,46 @@ void SplitHelper(const InputType& input,
   }
 }
 
+/**
+ * Compute the indices of a training set and a test set, without touching the
+ * data itself.  This is useful when copying the dataset is too expensive;
+ * the returned index vectors can be used to form zero-copy views of the
+ * original matrix (e.g. `input.cols(trainIdx)`), which most methods accept
+ * in place of a materialized matrix.
+ *
+ * @code
+ * arma::mat input = loadData();
+ * arma::uvec trainIdx, testIdx;
+ *
+ * // Compute a 70/30 split of the columns of `input`; no data is copied.
+ * SplitIndices(input.n_cols, trainIdx, testIdx, 0.3);
+ * model.Train(input.cols(trainIdx));
+ * @endcode
+ *
+ * @param count Number of samples (columns) in the dataset to split.
+ * @param trainIdx Vector to store the indices of the training samples into.
+ * @param testIdx Vector to store the indices of the test samples into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ */
+inline void SplitIndices(const size_t count,
+                         arma::uvec& trainIdx,
+                         arma::uvec& testIdx,
+                         const double testRatio,
+                         const bool shuffleData = true)
+{
+  const size_t testSize = static_cast<size_t>(count * testRatio);
+  const size_t trainSize = count - testSize;
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, count - 1, count);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  trainIdx = order.head(trainSize);
+  testIdx = order.tail(testSize);
+}
+
 /**
  * Given an input dataset and labels, stratify into a training set and test set.
  * It is recommended to have the input labels between the range [0, n) where n
@@ -217,6 +257,178 @@ void StratifiedSplit(const arma::Mat<T>& input,
   }
 }
 
+/**
+ * Compute the indices of a stratified training set and test set, without
+ * touching the data itself.  The split preserves the ratio of each label in
+ * the training and test sets, using the same strategy as StratifiedSplit();
+ * see the documentation of that function for details.  The returned index
+ * vectors can be used to form zero-copy views of the original matrix (e.g.
+ * `input.cols(trainIdx)`).
+ *
+ * @code
+ * arma::mat input = loadData();
+ * arma::Row<size_t> label = loadLabel();
+ * arma::uvec trainIdx, testIdx;
+ *
+ * // Compute a stratified 70/30 split of the columns of `input`; no data is
+ * // copied.
+ * StratifiedSplitIndices(label, trainIdx, testIdx, 0.3);
+ * model.Train(input.cols(trainIdx), label.cols(trainIdx));
+ * @endcode
+ *
+ * @param inputLabel Input labels to stratify on.
+ * @param trainIdx Vector to store the indices of the training samples into.
+ * @param testIdx Vector to store the indices of the test samples into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ */
+template<typename LabelsType,
+         typename = std::enable_if_t<arma::is_arma_type<LabelsType>::value> >
+void StratifiedSplitIndices(const LabelsType& inputLabel,
+                            arma::uvec& trainIdx,
+                            arma::uvec& testIdx,
+                            const double testRatio,
+                            const bool shuffleData = true)
+{
+  const bool typeCheck = (arma::is_Row<LabelsType>::value)
+      || (arma::is_Col<LabelsType>::value);
+  if (!typeCheck)
+    throw std::runtime_error("data::Split(): when stratified sampling is done, "
+        "labels must have type `arma::Row<>`!");
+
+  size_t trainCount = 0;
+  size_t testCount = 0;
+  size_t trainSize = 0;
+  size_t testSize = 0;
+  arma::uvec labelCounts;
+  arma::uvec testLabelCounts;
+  typename LabelsType::elem_type maxLabel = inputLabel.max();
+
+  labelCounts.zeros(maxLabel + 1);
+  testLabelCounts.zeros(maxLabel + 1);
+
+  for (typename LabelsType::elem_type label : inputLabel)
+    ++labelCounts[label];
+
+  for (arma::uword labelCount : labelCounts)
+  {
+    testSize += floor(labelCount * testRatio);
+    trainSize += labelCount - floor(labelCount * testRatio);
+  }
+
+  trainIdx.set_size(trainSize);
+  testIdx.set_size(testSize);
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, inputLabel.n_elem - 1,
+      inputLabel.n_elem);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  for (arma::uword i : order)
+  {
+    typename LabelsType::elem_type label = inputLabel[i];
+    if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
+    {
+      testLabelCounts[label] += 1;
+      testIdx[testCount++] = i;
+    }
+    else
+    {
+      trainIdx[trainCount++] = i;
+    }
+  }
+}
+
+/**
+ * Deterministically decide whether the sample with the given index belongs to
+ * the test set.  The decision depends only on the sample index, the test
+ * ratio and the seed---not on the dataset size, the number of samples seen so
+ * far, or the global random number generator---so it yields a consistent
+ * split when a dataset is processed out of core, in chunks, or in several
+ * passes.  The assignment is made by hashing the index with the seed and
+ * comparing the hash, mapped to [0, 1), against the test ratio; the test set
+ * therefore holds a testRatio fraction of the samples in expectation rather
+ * than exactly.
+ *
+ * @param index Global index of the sample.
+ * @param testRatio Expected fraction of samples in the test set (between 0
+ *     and 1).
+ * @param seed Seed that selects the split; the same seed always produces the
+ *     same split. (Default 0.)
+ */
+inline bool SplitIsTest(const size_t index,
+                        const double testRatio,
+                        const size_t seed = 0)
+{
+  // Finalizer of the SplitMix64 generator; a cheap bijective hash with good
+  // avalanche behavior, so consecutive indices land on independent sides of
+  // the threshold.
+  uint64_t h = (uint64_t) index + 0x9E3779B97F4A7C15 * (uint64_t) (seed + 1);
+  h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9;
+  h = (h ^ (h >> 27)) * 0x94D049BB133111EB;
+  h = h ^ (h >> 31);
+
+  // Map the top 53 bits to [0, 1).
+  return (double) (h >> 11) / 9007199254740992.0 < testRatio;
+}
+
+/**
+ * Split a chunk of a larger dataset into a training part and a test part,
+ * deterministically.  Each sample is assigned with SplitIsTest() based on its
+ * global index (its column index within the chunk plus `offset`), so
+ * streaming a dataset through this function chunk by chunk produces the same
+ * split regardless of the chunk boundaries, and the split can be reproduced
+ * later by replaying the stream with the same seed.
+ *
+ * @code
+ * arma::mat chunk;
+ * size_t offset = 0;
+ * while (stream.ReadChunk(chunk))
+ * {
+ *   arma::mat trainChunk, testChunk;
+ *   StreamingSplit(chunk, trainChunk, testChunk, 0.3, offset);
+ *   // ... accumulate or train on trainChunk / testChunk ...
+ *   offset += chunk.n_cols;
+ * }
+ * @endcode
+ *
+ * @param input Chunk of the dataset to split.
+ * @param trainData Matrix to store training data into.
+ * @param testData Matrix to store test data into.
+ * @param testRatio Expected fraction of samples in the test set (between 0
+ *     and 1).
+ * @param offset Global index of the first column of the chunk. (Default 0.)
+ * @param seed Seed that selects the split; the same seed always produces the
+ *     same split. (Default 0.)
+ */
+template<typename T>
+void StreamingSplit(const arma::Mat<T>& input,
+                    arma::Mat<T>& trainData,
+                    arma::Mat<T>& testData,
+                    const double testRatio,
+                    const size_t offset = 0,
+                    const size_t seed = 0)
+{
+  size_t testSize = 0;
+  for (size_t i = 0; i < input.n_cols; ++i)
+    if (SplitIsTest(offset + i, testRatio, seed))
+      ++testSize;
+
+  trainData.set_size(input.n_rows, input.n_cols - testSize);
+  testData.set_size(input.n_rows, testSize);
+
+  size_t trainIdx = 0;
+  size_t testIdx = 0;
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    if (SplitIsTest(offset + i, testRatio, seed))
+      testData.col(testIdx++) = input.col(i);
+    else
+      trainData.col(trainIdx++) = input.col(i);
+  }
+}
+
 /**
  * Given an input dataset and labels, split into a training set and test set.
  * Example usage below.  This overload places the split dataset into the four
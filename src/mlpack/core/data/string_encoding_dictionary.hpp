@@ -18,6 +18,7 @@
 #include <unordered_map>
 #include <deque>
 #include <array>
+#include <vector>
 
 namespace mlpack {
 namespace data {
@@ -139,6 +140,7 @@ class StringEncodingDictionary<boost::string_view>
   {
     tokens = other.tokens;
     mapping.clear();
+    frozenTable.clear();
 
     for (const std::string& token : tokens)
       mapping[token] = other.mapping.at(token);
@@ -157,18 +159,24 @@ class StringEncodingDictionary<boost::string_view>
    */
   bool HasToken(const boost::string_view token) const
   {
+    if (!frozenTable.empty())
+      return FrozenFind(token) != nullptr;
+
     return mapping.find(token) != mapping.end();
   }
 
   /**
    * The function adds the given token to the dictionary and assigns a label
    * to the token. The label is equal to the resulting size of the dictionary.
-   * The function returns the assigned label.
+   * The function returns the assigned label.  Adding a token discards the
+   * frozen lookup table, if any.
    *
    * @param token The given token.
    */
   size_t AddToken(const boost::string_view token)
   {
+    frozenTable.clear();
+
     tokens.emplace_back(token);
 
     size_t size = mapping.size();
@@ -186,9 +194,53 @@ class StringEncodingDictionary<boost::string_view>
    */
   size_t Value(const boost::string_view token) const
   {
+    if (!frozenTable.empty())
+    {
+      const FrozenEntry* entry = FrozenFind(token);
+      if (entry == nullptr)
+      {
+        throw std::out_of_range("StringEncodingDictionary::Value(): "
+            "the dictionary doesn't contain the given token!");
+      }
+
+      return entry->second;
+    }
+
     return mapping.at(token);
   }
 
+  /**
+   * Freeze the dictionary for encode-only workloads.  The mapping is packed
+   * into a flat open-addressing hash table (power-of-two size, linear
+   * probing), so lookups probe contiguous memory instead of chasing the
+   * nodes of the unordered map, and the table can be shared across threads
+   * since it is immutable.  AddToken() and Clear() discard the table; the
+   * frozen state is not serialized, so a loaded dictionary must be frozen
+   * again.
+   */
+  void Freeze()
+  {
+    size_t tableSize = 1;
+    while (tableSize < 2 * mapping.size())
+      tableSize <<= 1;
+
+    frozenTable.assign(tableSize,
+        FrozenEntry(boost::string_view(), size_t(0)));
+
+    for (const auto& keyValue : mapping)
+    {
+      size_t slot = boost::hash<boost::string_view>()(keyValue.first) &
+          (tableSize - 1);
+      while (frozenTable[slot].first.data() != nullptr)
+        slot = (slot + 1) & (tableSize - 1);
+
+      frozenTable[slot] = keyValue;
+    }
+  }
+
+  //! Return true if the dictionary is frozen.
+  bool Frozen() const { return !frozenTable.empty(); }
+
   //! Get the size of the dictionary.
   size_t Size() const { return mapping.size(); }
 
@@ -197,6 +249,7 @@ class StringEncodingDictionary<boost::string_view>
   {
     mapping.clear();
     tokens.clear();
+    frozenTable.clear();
   }
 
   //! Get the tokens.
@@ -245,11 +298,38 @@ class StringEncodingDictionary<boost::string_view>
   }
 
  private:
+  //! An entry of the frozen lookup table: a token view and its label.
+  using FrozenEntry = std::pair<boost::string_view, size_t>;
+
+  /**
+   * Look the token up in the frozen table.  Returns a pointer to the entry,
+   * or NULL if the token is not in the dictionary.
+   */
+  const FrozenEntry* FrozenFind(const boost::string_view token) const
+  {
+    size_t slot = boost::hash<boost::string_view>()(token) &
+        (frozenTable.size() - 1);
+    while (frozenTable[slot].first.data() != nullptr)
+    {
+      if (frozenTable[slot].first == token)
+        return &frozenTable[slot];
+
+      slot = (slot + 1) & (frozenTable.size() - 1);
+    }
+
+    return nullptr;
+  }
+
   //! The tokens that the dictionary stores.
   std::deque<std::string> tokens;
 
   //! The mapping itself.
   MapType mapping;
+
+  //! The frozen lookup table; empty unless Freeze() has been called.  The
+  //! views point into `tokens`, so the table is intentionally not copied
+  //! with the dictionary and not serialized.
+  std::vector<FrozenEntry> frozenTable;
 };
 
 template<>
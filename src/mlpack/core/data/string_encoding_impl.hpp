@@ -105,54 +105,114 @@ EncodeHelper(const std::vector<std::string>& input,
              const TokenizerType& tokenizer,
              PolicyType& policy)
 {
-  size_t numColumns = 0;
+  using Token = typename std::remove_reference<
+      typename DictionaryType::TokenType>::type;
 
   policy.Reset();
 
-  // The first pass adds the extracted tokens to the dictionary.
-  for (size_t i = 0; i < input.size(); ++i)
+  // Shard the corpus into contiguous blocks of documents.  Each shard is
+  // tokenized by one thread, which keeps the extracted tokens of its
+  // documents and a local dictionary of the tokens it saw first.  Tokenizing
+  // is the expensive part of encoding, and this way it happens exactly once
+  // and in parallel.
+  #ifdef HAS_OPENMP
+  const size_t numShards = (size_t) omp_get_max_threads();
+  #else
+  const size_t numShards = 1;
+  #endif
+  const size_t shardSize = (input.size() + numShards - 1) / numShards;
+
+  std::vector<std::vector<Token>> lineTokens(input.size());
+  std::vector<std::vector<Token>> shardNewTokens(numShards);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t s = 0; s < (omp_size_t) numShards; ++s)
   {
-    boost::string_view strView(input[i]);
-    auto token = tokenizer(strView);
+    const size_t begin = s * shardSize;
+    if (begin >= input.size())
+      continue;
+    const size_t end = std::min(begin + shardSize, input.size());
 
-    static_assert(
-        std::is_same<typename std::remove_reference<decltype(token)>::type,
-                     typename std::remove_reference<typename DictionaryType::
-                        TokenType>::type>::value,
-        "The dictionary token type doesn't match the return value type "
-        "of the tokenizer.");
+    // Tracks which tokens this shard has already recorded, so that
+    // shardNewTokens keeps every candidate exactly once, in first-occurrence
+    // order.
+    DictionaryType localDictionary;
 
-    size_t numTokens = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+      boost::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      static_assert(
+          std::is_same<typename std::remove_reference<decltype(token)>::type,
+                       Token>::value,
+          "The dictionary token type doesn't match the return value type "
+          "of the tokenizer.");
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        // The shared dictionary is strictly read-only here.
+        if (!dictionary.HasToken(token) && !localDictionary.HasToken(token))
+        {
+          localDictionary.AddToken(token);
+          shardNewTokens[s].push_back(token);
+        }
+
+        lineTokens[i].push_back(token);
+        token = tokenizer(strView);
+      }
+    }
+  }
 
-    while (!tokenizer.IsTokenEmpty(token))
+  // Merge the shards' new tokens into the shared dictionary, in shard (and
+  // therefore document) order.  Since the shards are contiguous document
+  // blocks, the tokens end up with exactly the labels a serial pass over the
+  // corpus would have assigned.
+  for (size_t s = 0; s < numShards; ++s)
+  {
+    for (Token& token : shardNewTokens[s])
     {
       if (!dictionary.HasToken(token))
         dictionary.AddToken(std::move(token));
+    }
+  }
 
-      policy.PreprocessToken(i, numTokens, dictionary.Value(token));
+  // With the dictionary complete, resolve the stored tokens to their labels
+  // across threads; all dictionary accesses are read-only lookups now.
+  std::vector<std::vector<size_t>> lineLabels(input.size());
 
-      token = tokenizer(strView);
-      numTokens++;
-    }
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) input.size(); ++i)
+  {
+    lineLabels[i].reserve(lineTokens[i].size());
+    for (const Token& token : lineTokens[i])
+      lineLabels[i].push_back(dictionary.Value(token));
+
+    // The tokens of this document are no longer needed.
+    std::vector<Token>().swap(lineTokens[i]);
+  }
+
+  // Policy statistics (e.g. the tf-idf counts) must be accumulated in
+  // document order, but at this point that is a cheap loop over integer
+  // labels.
+  size_t numColumns = 0;
+  for (size_t i = 0; i < lineLabels.size(); ++i)
+  {
+    for (size_t j = 0; j < lineLabels[i].size(); ++j)
+      policy.PreprocessToken(i, j, lineLabels[i][j]);
 
-    numColumns = std::max(numColumns, numTokens);
+    numColumns = std::max(numColumns, lineLabels[i].size());
   }
 
   policy.InitMatrix(output, input.size(), numColumns, dictionary.Size());
 
-  // The second pass writes the encoded values to the output.
-  for (size_t i = 0; i < input.size(); ++i)
+  // Every document writes only its own slice of the output, so the encoding
+  // pass is threaded as well.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) input.size(); ++i)
   {
-    boost::string_view strView(input[i]);
-    auto token = tokenizer(strView);
-    size_t numTokens = 0;
-
-    while (!tokenizer.IsTokenEmpty(token))
-    {
-      policy.Encode(output, dictionary.Value(token), i, numTokens);
-      token = tokenizer(strView);
-      numTokens++;
-    }
+    for (size_t j = 0; j < lineLabels[i].size(); ++j)
+      policy.Encode(output, lineLabels[i][j], i, j);
   }
 }
 
@@ -15,35 +15,132 @@
 using namespace mlpack;
 using namespace mlpack::distribution;
 
+/**
+ * Build the alias tables used by Random(), one per dimension, with Vose's
+ * O(n) construction.  Each table slot holds 1/n of the probability mass,
+ * shared between the slot's own observation (below the cutoff) and one other
+ * observation, the alias (above it); observations with less than average
+ * probability donate their leftover slot space to those with more.
+ */
+void DiscreteDistribution::BuildAliasTables() const
+{
+  aliasCutoff.resize(probabilities.size());
+  aliasIndex.resize(probabilities.size());
+
+  for (size_t d = 0; d < probabilities.size(); d++)
+  {
+    const size_t n = probabilities[d].n_elem;
+    aliasCutoff[d].set_size(n);
+    aliasIndex[d].set_size(n);
+
+    // Scale the probabilities so that an average observation has weight 1.
+    arma::vec scaled = probabilities[d] * n;
+
+    // Partition the observations into those that underfill their slot and
+    // those with mass to spare.
+    std::vector<size_t> small, large;
+    small.reserve(n);
+    large.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (scaled[i] < 1.0)
+        small.push_back(i);
+      else
+        large.push_back(i);
+    }
+
+    // Fill each underfull slot from an overfull observation, which becomes
+    // the slot's alias.
+    while (!small.empty() && !large.empty())
+    {
+      const size_t s = small.back();
+      const size_t l = large.back();
+      small.pop_back();
+
+      aliasCutoff[d][s] = scaled[s];
+      aliasIndex[d][s] = l;
+
+      // The alias donated (1 - scaled[s]) of its mass to this slot.
+      scaled[l] -= (1.0 - scaled[s]);
+      if (scaled[l] < 1.0)
+      {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+
+    // Anything left over (either list may be nonempty due to floating-point
+    // roundoff) fills its own slot entirely.
+    while (!large.empty())
+    {
+      aliasCutoff[d][large.back()] = 1.0;
+      aliasIndex[d][large.back()] = large.back();
+      large.pop_back();
+    }
+    while (!small.empty())
+    {
+      aliasCutoff[d][small.back()] = 1.0;
+      aliasIndex[d][small.back()] = small.back();
+      small.pop_back();
+    }
+  }
+
+  recalculateAlias = false;
+}
+
 /**
  * Return a randomly generated observation according to the probability
  * distribution defined by this object.
  */
 arma::vec DiscreteDistribution::Random() const
 {
+  if (recalculateAlias)
+    BuildAliasTables();
+
   size_t dimension = probabilities.size();
   arma::vec result(dimension);
 
   for (size_t d = 0; d < dimension; d++)
   {
-    // Generate a random number.
-    double randObs = math::Random();
+    // Pick a table slot uniformly, then use the fractional part of the same
+    // draw to decide between the slot's own observation and its alias.
+    const double randObs = math::Random() * probabilities[d].n_elem;
+    const size_t slot = std::min((size_t) randObs,
+        (size_t) (probabilities[d].n_elem - 1));
 
-    double sumProb = 0;
+    if (randObs - slot < aliasCutoff[d][slot])
+      result[d] = slot;
+    else
+      result[d] = aliasIndex[d][slot];
+  }
 
-    for (size_t obs = 0; obs < probabilities[d].n_elem; obs++)
-    {
-      if ((sumProb += probabilities[d][obs]) >= randObs)
-      {
-        result[d] = obs;
-        break;
-      }
-    }
+  return result;
+}
+
+/**
+ * Return a matrix of randomly generated observations, one per column,
+ * according to the probability distribution defined by this object.
+ */
+arma::mat DiscreteDistribution::Random(const size_t n) const
+{
+  if (recalculateAlias)
+    BuildAliasTables();
 
-    if (sumProb > 1.0)
+  const size_t dimension = probabilities.size();
+  arma::mat result(dimension, n);
+
+  for (size_t c = 0; c < n; c++)
+  {
+    for (size_t d = 0; d < dimension; d++)
     {
-      // This shouldn't happen.
-      result[d] = probabilities[d].n_elem - 1;
+      const double randObs = math::Random() * probabilities[d].n_elem;
+      const size_t slot = std::min((size_t) randObs,
+          (size_t) (probabilities[d].n_elem - 1));
+
+      if (randObs - slot < aliasCutoff[d][slot])
+        result(d, c) = slot;
+      else
+        result(d, c) = aliasIndex[d][slot];
     }
   }
 
@@ -101,6 +198,9 @@ void DiscreteDistribution::Train(const arma::mat& observations)
     else // Force normalization.
       probabilities[i].fill(1.0 / probabilities[i].n_elem);
   }
+
+  // The sampling tables no longer match the probabilities.
+  recalculateAlias = true;
 }
 
 /**
@@ -157,4 +257,7 @@ void DiscreteDistribution::Train(const arma::mat& observations,
     else // Force normalization.
       probabilities[i].fill(1.0 / probabilities[i].n_elem);
   }
+
+  // The sampling tables no longer match the probabilities.
+  recalculateAlias = true;
 }
@@ -50,7 +50,9 @@ class DiscreteDistribution
    * observations.
    */
   DiscreteDistribution() :
-      probabilities(std::vector<arma::vec>(1)){ /* Nothing to do. */ }
+      probabilities(std::vector<arma::vec>(1)),
+      recalculateAlias(true)
+  { /* Nothing to do. */ }
 
   /**
    * Define the discrete distribution as having numObservations possible
@@ -62,7 +64,8 @@ class DiscreteDistribution
    */
   DiscreteDistribution(const size_t numObservations) :
       probabilities(std::vector<arma::vec>(1,
-          arma::ones<arma::vec>(numObservations) / numObservations))
+          arma::ones<arma::vec>(numObservations) / numObservations)),
+      recalculateAlias(true)
   { /* Nothing to do. */ }
 
   /**
@@ -73,7 +76,8 @@ class DiscreteDistribution
    * @param numObservations Number of possible observations this distribution
    *    can have.
    */
-  DiscreteDistribution(const arma::Col<size_t>& numObservations)
+  DiscreteDistribution(const arma::Col<size_t>& numObservations) :
+      recalculateAlias(true)
   {
     for (size_t i = 0; i < numObservations.n_elem; ++i)
     {
@@ -95,7 +99,8 @@ class DiscreteDistribution
    *
    * @param probabilities Probabilities of each possible observation.
    */
-  DiscreteDistribution(const std::vector<arma::vec>& probabilities)
+  DiscreteDistribution(const std::vector<arma::vec>& probabilities) :
+      recalculateAlias(true)
   {
     for (size_t i = 0; i < probabilities.size(); ++i)
     {
@@ -203,10 +208,25 @@ class DiscreteDistribution
    * observation) according to the probability distribution defined by this
    * object.
    *
+   * Sampling uses the alias method: a pair of tables is built (lazily, in
+   * O(n) time) the first time Random() is called after the probabilities
+   * change, after which each draw costs O(1) instead of a linear scan.
+   *
    * @return Random observation.
    */
   arma::vec Random() const;
 
+  /**
+   * Return a matrix of randomly generated observations, one observation per
+   * column, according to the probability distribution defined by this object.
+   * This batched overload shares one alias table build across all draws, so
+   * it should be preferred when many samples are needed.
+   *
+   * @param n Number of observations to generate.
+   * @return Matrix of random observations (one observation per column).
+   */
+  arma::mat Random(const size_t n) const;
+
   /**
    * Estimate the probability distribution directly from the given
    * observations. If any of the observations is greater than numObservations,
@@ -228,9 +248,15 @@ class DiscreteDistribution
   void Train(const arma::mat& observations,
              const arma::vec& probabilities);
 
-  //! Return the vector of probabilities for the given dimension.
-  arma::vec& Probabilities(const size_t dim = 0) { return probabilities[dim]; }
   //! Modify the vector of probabilities for the given dimension.
+  arma::vec& Probabilities(const size_t dim = 0)
+  {
+    // The caller may change the probabilities, so the sampling tables must be
+    // rebuilt before the next draw.
+    recalculateAlias = true;
+    return probabilities[dim];
+  }
+  //! Return the vector of probabilities for the given dimension.
   const arma::vec& Probabilities(const size_t dim = 0) const
   { return probabilities[dim]; }
 
@@ -241,12 +267,32 @@ class DiscreteDistribution
   void serialize(Archive& ar, const uint32_t /* version */)
   {
     ar(CEREAL_NVP(probabilities));
+
+    // The alias tables are not serialized; rebuild them before sampling.
+    if (cereal::is_loading<Archive>())
+      recalculateAlias = true;
   }
 
  private:
+  /**
+   * Build the alias tables used by Random().  After Vose's construction, a
+   * sample for dimension d is drawn by picking a uniform table slot i and a
+   * uniform value in [0, 1): the sample is i when the value falls below the
+   * slot's cutoff aliasCutoff[d][i], and the slot's alias aliasIndex[d][i]
+   * otherwise.
+   */
+  void BuildAliasTables() const;
+
   //! The probabilities for each dimension; each arma::vec represents the
   //! probabilities for the observations in each dimension.
   std::vector<arma::vec> probabilities;
+
+  //! Cutoff values of the alias tables; built lazily by BuildAliasTables().
+  mutable std::vector<arma::vec> aliasCutoff;
+  //! Alias indices of the alias tables; built lazily by BuildAliasTables().
+  mutable std::vector<arma::Col<size_t>> aliasIndex;
+  //! Whether the alias tables must be rebuilt before the next draw.
+  mutable bool recalculateAlias;
 };
 
 } // namespace distribution
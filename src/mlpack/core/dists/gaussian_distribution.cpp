@@ -11,6 +11,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include "gaussian_distribution.hpp"
+#include <mlpack/core/math/ccov.hpp>
 #include <mlpack/methods/gmm/positive_definite_constraint.hpp>
 
 using namespace mlpack;
@@ -60,7 +61,7 @@ void GaussianDistribution::FactorCovariance()
   // 0 after the method. That last part is unnecessary, but baked into
   // Armadillo, so there's not really much that can be done about that without
   // discussion with the Armadillo maintainer.
-  const arma::mat invCovLower = arma::inv(arma::trimatl(covLower));
+  invCovLower = arma::inv(arma::trimatl(covLower));
 
   invCov = invCovLower.t() * invCovLower;
   double sign = 0.;
@@ -70,10 +71,21 @@ void GaussianDistribution::FactorCovariance()
 
 double GaussianDistribution::LogProbability(const arma::vec& observation) const
 {
+  // With z = invCovLower * (observation - mean), the Mahalanobis term is
+  // dot(z, z).  Computing z row by row from the cached triangular factor
+  // avoids allocating any temporaries, which matters for the single-point
+  // calls the HMM and GMM code makes in tight loops.
   const size_t k = observation.n_elem;
-  const arma::vec diff = mean - observation;
-  const arma::vec v = (diff.t() * invCov * diff);
-  return -0.5 * k * log2pi - 0.5 * logDetCov - 0.5 * v(0);
+  double mahalanobis = 0.0;
+  for (size_t r = 0; r < k; ++r)
+  {
+    double z = 0.0;
+    for (size_t c = 0; c <= r; ++c)
+      z += invCovLower(r, c) * (observation[c] - mean[c]);
+    mahalanobis += z * z;
+  }
+
+  return -0.5 * k * log2pi - 0.5 * logDetCov - 0.5 * mahalanobis;
 }
 
 arma::vec GaussianDistribution::Random() const
@@ -108,16 +120,11 @@ void GaussianDistribution::Train(const arma::mat& observations)
   // Normalize the mean.
   mean /= observations.n_cols;
 
-  // Now calculate the covariance.
-  for (size_t i = 0; i < observations.n_cols; ++i)
-  {
-    arma::vec obsNoMean = observations.col(i) - mean;
-    covariance += obsNoMean * trans(obsNoMean);
-  }
-
-  // Finish estimating the covariance by normalizing, with the (1 / (n - 1)) so
-  // that it is the unbiased estimator.
-  covariance /= (observations.n_cols - 1);
+  // Now calculate the unbiased covariance estimate.  ColumnCovariance()
+  // streams over the observations in blocks, so no centered copy of the data
+  // is made.
+  if (observations.n_cols > 1)
+    covariance = math::ColumnCovariance(observations);
 
   // Ensure that the covariance is positive definite.
   gmm::PositiveDefiniteConstraint::ApplyConstraint(covariance);
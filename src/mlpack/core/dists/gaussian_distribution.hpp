@@ -32,6 +32,10 @@ class GaussianDistribution
   arma::mat covLower;
   //! Cached inverse of covariance.
   arma::mat invCov;
+  //! Cached inverse of the lower triangular factor (invCovLower =
+  //! covLower^-1); used by the probability computations, since with z =
+  //! invCovLower * (x - mean) the Mahalanobis term is just dot(z, z).
+  arma::mat invCovLower;
   //! Cached logdet(cov).
   double logDetCov;
 
@@ -53,6 +57,7 @@ class GaussianDistribution
       covariance(arma::eye<arma::mat>(dimension, dimension)),
       covLower(arma::eye<arma::mat>(dimension, dimension)),
       invCov(arma::eye<arma::mat>(dimension, dimension)),
+      invCovLower(arma::eye<arma::mat>(dimension, dimension)),
       logDetCov(0)
   { /* Nothing to do. */ }
 
@@ -107,14 +112,27 @@ class GaussianDistribution
    */
   void LogProbability(const arma::mat& x, arma::vec& logProbabilities) const
   {
-    // Column i of 'diffs' is the difference between x.col(i) and the mean.
-    arma::mat diffs = x;
-    diffs.each_col() -= mean;
-
-    // Now, we only want to calculate the diagonal elements of (diffs' * cov^-1
-    // * diffs).  We just don't need any of the other elements.
-    logProbabilities = -0.5 * x.n_rows * log2pi - 0.5 * logDetCov +
-        sum(diffs % (-0.5 * invCov * diffs), 0).t();
+    const double baseTerm = -0.5 * x.n_rows * log2pi - 0.5 * logDetCov;
+    logProbabilities.set_size(x.n_cols);
+
+    // With z = invCovLower * (x - mean), the Mahalanobis term of each point is
+    // just the squared norm of its column of z, so each block costs one
+    // triangular matrix product.  Process the points in blocks so the
+    // temporaries stay cache-resident no matter how many points are given.
+    const size_t blockSize = 512;
+    arma::mat diffs, z;
+    for (size_t begin = 0; begin < x.n_cols; begin += blockSize)
+    {
+      const size_t end = std::min(begin + blockSize, (size_t) x.n_cols) - 1;
+
+      // Column i of 'diffs' is the difference between x.col(i) and the mean.
+      diffs = x.cols(begin, end);
+      diffs.each_col() -= mean;
+
+      z = arma::trimatl(invCovLower) * diffs;
+      logProbabilities.subvec(begin, end) = baseTerm -
+          0.5 * arma::sum(z % z, 0).t();
+    }
   }
 
   /**
@@ -165,6 +183,9 @@ class GaussianDistribution
   //! Return the invCov.
   const arma::mat& InvCov() const { return invCov; }
 
+  //! Return the inverse of the lower triangular factor of the covariance.
+  const arma::mat& InvCovLower() const { return invCovLower; }
+
   //! Return the logDetCov.
   double LogDetCov() const { return logDetCov; }
 
@@ -180,6 +201,11 @@ class GaussianDistribution
     ar(CEREAL_NVP(covLower));
     ar(CEREAL_NVP(invCov));
     ar(CEREAL_NVP(logDetCov));
+
+    // The inverse factor is not serialized, to keep the archive format
+    // unchanged; rebuild it from the loaded factor instead.
+    if (cereal::is_loading<Archive>())
+      invCovLower = arma::inv(arma::trimatl(covLower));
   }
 
  private:
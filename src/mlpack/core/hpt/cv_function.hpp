@@ -65,6 +65,14 @@ class CVFunction
              const double minDelta,
              const BoundArgs&... args);
 
+  /**
+   * Copy another CVFunction object.  The copy gets its own deep copy of the
+   * underlying cross-validation object, so it can be evaluated independently
+   * of (and concurrently with) the original; this is what makes parallel
+   * hyper-parameter search possible.
+   */
+  CVFunction(const CVFunction& other);
+
   /**
    * Run cross-validation with the bound and passed parameters.
    *
@@ -104,6 +112,11 @@ class CVFunction
            bool BoundArgsIndexInRange = (BoundArgIndex < BoundArgsAmount)>
   struct UseBoundArg;
 
+  //! Storage for a deep copy of the cross-validation object; only set when
+  //! this object was copy-constructed.  Declared before 'cv' so that the
+  //! reference below can bind to it during construction.
+  std::unique_ptr<CVType> ownedCV;
+
   //! A reference to the cross-validation object.
   CVType& cv;
 
@@ -58,6 +58,22 @@ CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::CVFunction(
     minDelta(minDelta)
 { /* Nothing left to do. */ }
 
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::CVFunction(
+    const CVFunction& other) :
+    ownedCV(new CVType(other.cv)),
+    cv(*ownedCV),
+    datasetInfo(other.datasetInfo),
+    boundArgs(other.boundArgs),
+    bestObjective(other.bestObjective),
+    bestModel(other.bestModel),
+    relativeDelta(other.relativeDelta),
+    minDelta(other.minDelta)
+{ /* Nothing left to do. */ }
+
 template<typename CVType,
          typename MLAlgorithm,
          size_t TotalArgs,
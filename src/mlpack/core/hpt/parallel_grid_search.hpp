@@ -0,0 +1,151 @@
+/**
+ * @file core/hpt/parallel_grid_search.hpp
+ * @author Kirill Mishchenko
+ *
+ * A drop-in replacement for ens::GridSearch that evaluates independent
+ * hyper-parameter combinations concurrently.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_PARALLEL_GRID_SEARCH_HPP
+#define MLPACK_CORE_HPT_PARALLEL_GRID_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * An optimizer for HyperParameterTuner that exhaustively evaluates a grid of
+ * hyper-parameter combinations like ens::GridSearch, but concurrently: each
+ * thread works through its share of the grid with its own copy of the
+ * objective function (and therefore its own copy of the cross-validation
+ * object and model instances), so no state is shared between evaluations.
+ *
+ * The result is deterministic regardless of scheduling: the reported optimum
+ * is the combination with the lowest objective, with ties broken in favor of
+ * the combination that comes first in grid order.
+ *
+ * Use it as the optimizer template argument of HyperParameterTuner:
+ *
+ * @code
+ * HyperParameterTuner<LinearRegression, MSE, SimpleCV, ParallelGridSearch>
+ *     hpt(validationSize, data, responses);
+ * @endcode
+ */
+class ParallelGridSearch
+{
+ public:
+  /**
+   * Find the best combination in the grid described by numCategories.  All
+   * dimensions must be categorical (that is, sets of values to choose from),
+   * as for ens::GridSearch.
+   *
+   * @param function The function to be minimized.  It must be copy-
+   *     constructible, and copies must be independently evaluable.
+   * @param bestParameters Matrix to store the best combination in.
+   * @param categoricalDimensions Whether each dimension is categorical.
+   * @param numCategories Number of categories in each dimension.
+   * @return The objective value of the best combination.
+   */
+  template<typename FunctionType>
+  double Optimize(FunctionType& function,
+                  arma::mat& bestParameters,
+                  const std::vector<bool>& categoricalDimensions,
+                  const arma::Row<size_t>& numCategories)
+  {
+    const size_t dims = categoricalDimensions.size();
+    for (size_t d = 0; d < dims; ++d)
+    {
+      if (!categoricalDimensions[d])
+      {
+        std::ostringstream oss;
+        oss << "ParallelGridSearch::Optimize(): dimension " << d << " is not "
+            << "categorical; specify a set of values to search through "
+            << "instead" << std::endl;
+        throw std::invalid_argument(oss.str());
+      }
+    }
+
+    size_t totalCombinations = 1;
+    for (size_t d = 0; d < dims; ++d)
+      totalCombinations *= numCategories[d];
+
+    double bestObjective = std::numeric_limits<double>::max();
+    size_t bestCombination = totalCombinations;
+
+    #pragma omp parallel
+    {
+      // Each thread evaluates with its own copy of the function, so that
+      // evaluations never share cross-validation state or models.
+      FunctionType localFunction(function);
+
+      double localBestObjective = std::numeric_limits<double>::max();
+      size_t localBestCombination = totalCombinations;
+
+      arma::mat parameters(dims, 1);
+
+      #pragma omp for schedule(dynamic) nowait
+      for (omp_size_t i = 0; i < (omp_size_t) totalCombinations; ++i)
+      {
+        // Decode the combination index into category indices.
+        size_t remainder = (size_t) i;
+        for (size_t d = 0; d < dims; ++d)
+        {
+          parameters(d, 0) = (double) (remainder % numCategories[d]);
+          remainder /= numCategories[d];
+        }
+
+        const double objective = localFunction.Evaluate(parameters);
+        if (objective < localBestObjective ||
+            (objective == localBestObjective &&
+             (size_t) i < localBestCombination))
+        {
+          localBestObjective = objective;
+          localBestCombination = (size_t) i;
+        }
+      }
+
+      // Keep the globally best combination; ties go to the earlier one in
+      // grid order so that the result does not depend on thread scheduling.
+      #pragma omp critical (ParallelGridSearchMerge)
+      {
+        if (localBestObjective < bestObjective ||
+            (localBestObjective == bestObjective &&
+             localBestCombination < bestCombination))
+        {
+          bestObjective = localBestObjective;
+          bestCombination = localBestCombination;
+        }
+      }
+    }
+
+    if (bestCombination == totalCombinations)
+      throw std::logic_error("ParallelGridSearch::Optimize(): no combination "
+          "was evaluated; is the grid empty?");
+
+    // Decode the winning combination.
+    bestParameters.set_size(dims, 1);
+    size_t remainder = bestCombination;
+    for (size_t d = 0; d < dims; ++d)
+    {
+      bestParameters(d, 0) = (double) (remainder % numCategories[d]);
+      remainder /= numCategories[d];
+    }
+
+    // Re-evaluate the winner on the caller's function, so that its state (in
+    // particular the best model tracked by CVFunction) reflects the winning
+    // combination.
+    function.Evaluate(bestParameters);
+
+    return bestObjective;
+  }
+};
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
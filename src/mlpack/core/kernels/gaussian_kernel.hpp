@@ -68,6 +68,28 @@ class GaussianKernel
     return exp(gamma * metric::SquaredEuclideanDistance::Evaluate(a, b));
   }
 
+  /**
+   * Batched evaluation of the Gaussian kernel for all pairs of columns of two
+   * datasets, so that kernels(i, j) = K(a.col(i), b.col(j)).  The squared
+   * distances are expanded as ||x||^2 + ||y||^2 - 2 x^T y, so the whole
+   * matrix is computed with one matrix product plus rank-one updates; this is
+   * far faster than pairwise evaluation when building Gram matrices.
+   *
+   * @param a First set of points (one per column).
+   * @param b Second set of points (one per column).
+   * @param kernels Matrix to store kernel values into (resized as needed).
+   */
+  template<typename MatType>
+  void Evaluate(const MatType& a, const MatType& b, MatType& kernels) const
+  {
+    kernels = -2.0 * (a.t() * b);
+    kernels.each_col() += arma::sum(arma::square(a), 0).t();
+    kernels.each_row() += arma::sum(arma::square(b), 0);
+    // Guard against small negative squared distances due to roundoff.
+    kernels = arma::clamp(kernels, 0.0, std::numeric_limits<double>::max());
+    kernels = arma::exp(gamma * kernels);
+  }
+
   /**
    * Evaluation of the Gaussian kernel given the distance between two points.
    *
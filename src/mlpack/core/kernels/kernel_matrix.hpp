@@ -0,0 +1,153 @@
+/**
+ * @file core/kernels/kernel_matrix.hpp
+ * @author Ryan Curtin
+ *
+ * Batched kernel evaluation.  KernelMatrix() fills a matrix of kernel values
+ * for all pairs of columns of two datasets; kernels that provide a batched
+ * Evaluate() overload (such as the distance- and dot-product-based kernels)
+ * compute the whole matrix with a handful of level-3 matrix operations, which
+ * is vastly faster than evaluating one pair at a time.  Kernels without a
+ * batched overload fall back to a parallel pairwise loop.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kernel {
+
+//! Utility struct to detect a batched Evaluate(a, b, k) member at compile
+//! time (SFINAE, in the spirit of data::HasSerialize).
+template<typename KernelType, typename MatType>
+struct HasBatchEvaluate
+{
+  template<typename T>
+  static char Check(
+      decltype(std::declval<T>().Evaluate(
+          std::declval<const MatType&>(),
+          std::declval<const MatType&>(),
+          std::declval<MatType&>()))*);
+
+  template<typename T>
+  static int Check(...);
+
+  static const bool value = (sizeof(Check<KernelType>(0)) == sizeof(char));
+};
+
+/**
+ * Compute the matrix of kernel values between all columns of a and all
+ * columns of b, so that k(i, j) = K(a.col(i), b.col(j)).  This overload is
+ * used when the kernel provides a batched Evaluate() overload.
+ *
+ * @param kernel Kernel to evaluate.
+ * @param a First set of points (one per column).
+ * @param b Second set of points (one per column).
+ * @param k Matrix to store kernel values into (resized as needed).
+ */
+template<typename KernelType, typename MatType>
+typename std::enable_if<HasBatchEvaluate<KernelType, MatType>::value>::type
+KernelMatrix(KernelType& kernel,
+             const MatType& a,
+             const MatType& b,
+             MatType& k)
+{
+  kernel.Evaluate(a, b, k);
+}
+
+/**
+ * Compute the matrix of kernel values between all columns of a and all
+ * columns of b.  This overload is the fallback for kernels without a batched
+ * Evaluate() overload; it evaluates the pairs in a parallel loop.
+ *
+ * @param kernel Kernel to evaluate.
+ * @param a First set of points (one per column).
+ * @param b Second set of points (one per column).
+ * @param k Matrix to store kernel values into (resized as needed).
+ */
+template<typename KernelType, typename MatType>
+typename std::enable_if<!HasBatchEvaluate<KernelType, MatType>::value>::type
+KernelMatrix(KernelType& kernel,
+             const MatType& a,
+             const MatType& b,
+             MatType& k)
+{
+  k.set_size(a.n_cols, b.n_cols);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t j = 0; j < (omp_size_t) b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      k(i, j) = kernel.Evaluate(a.unsafe_col(i), b.unsafe_col(j));
+}
+
+/**
+ * Compute the symmetric matrix of kernel values between all pairs of columns
+ * of a single dataset, so that k(i, j) = K(data.col(i), data.col(j)).  The
+ * matrix is assembled tile-by-tile: only the tiles of the upper triangle are
+ * computed (the lower triangle is filled by transposition), and the tiles are
+ * distributed over OpenMP threads.  Each tile is built with KernelMatrix(), so
+ * kernels with a batched Evaluate() overload turn each tile into a matrix
+ * product.  The kernel's scalar Evaluate() must be safe to call concurrently,
+ * which holds for all of the kernels shipped with mlpack.
+ *
+ * @param kernel Kernel to evaluate.
+ * @param data Set of points (one per column).
+ * @param k Matrix to store kernel values into (resized as needed).
+ * @param blockSize Number of columns per tile.
+ */
+template<typename KernelType, typename MatType>
+void SymmetricKernelMatrix(KernelType& kernel,
+                           const MatType& data,
+                           MatType& k,
+                           const size_t blockSize = 256)
+{
+  const size_t n = data.n_cols;
+  k.set_size(n, n);
+  const size_t numBlocks = (n + blockSize - 1) / blockSize;
+
+  // Flatten the upper-triangular tile indices into one list, so a single
+  // dynamically-scheduled loop covers them (edge tiles are cheaper than
+  // interior tiles, so static scheduling would leave threads idle).
+  std::vector<std::pair<size_t, size_t>> tiles;
+  tiles.reserve(numBlocks * (numBlocks + 1) / 2);
+  for (size_t bi = 0; bi < numBlocks; ++bi)
+    for (size_t bj = bi; bj < numBlocks; ++bj)
+      tiles.push_back(std::make_pair(bi, bj));
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t t = 0; t < (omp_size_t) tiles.size(); ++t)
+  {
+    const size_t iStart = tiles[t].first * blockSize;
+    const size_t jStart = tiles[t].second * blockSize;
+    const size_t iEnd = std::min(n, iStart + blockSize) - 1;
+    const size_t jEnd = std::min(n, jStart + blockSize) - 1;
+
+    // Materialize the column blocks, so the tile is computed on contiguous
+    // memory (the copy is negligible next to the tile evaluation itself).
+    const MatType blockI = data.cols(iStart, iEnd);
+    MatType tile;
+    if (iStart == jStart)
+    {
+      KernelMatrix(kernel, blockI, blockI, tile);
+    }
+    else
+    {
+      const MatType blockJ = data.cols(jStart, jEnd);
+      KernelMatrix(kernel, blockI, blockJ, tile);
+    }
+
+    k.submat(iStart, jStart, iEnd, jEnd) = tile;
+    if (iStart != jStart)
+      k.submat(jStart, iStart, jEnd, iEnd) = tile.t();
+  }
+}
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif
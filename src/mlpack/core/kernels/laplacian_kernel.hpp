@@ -64,6 +64,28 @@ class LaplacianKernel
     return exp(-metric::EuclideanDistance::Evaluate(a, b) / bandwidth);
   }
 
+  /**
+   * Batched evaluation of the Laplacian kernel for all pairs of columns of
+   * two datasets.  The pairwise Euclidean distances are obtained from one
+   * matrix product via the ||x||^2 + ||y||^2 - 2 x^T y expansion, avoiding
+   * per-pair evaluation when building Gram matrices.
+   *
+   * @param a First set of points (one per column).
+   * @param b Second set of points (one per column).
+   * @param kernels Matrix to store kernel values into (resized as needed).
+   */
+  template<typename MatType>
+  void Evaluate(const MatType& a, const MatType& b, MatType& kernels) const
+  {
+    kernels = -2.0 * (a.t() * b);
+    kernels.each_col() += arma::sum(arma::square(a), 0).t();
+    kernels.each_row() += arma::sum(arma::square(b), 0);
+    // Roundoff can leave tiny negative squared distances; clamp before the
+    // square root.
+    kernels = arma::clamp(kernels, 0.0, std::numeric_limits<double>::max());
+    kernels = arma::exp(-arma::sqrt(kernels) / bandwidth);
+  }
+
   /**
    * Evaluation of the Laplacian kernel given the distance between two points.
    *
@@ -55,6 +55,20 @@ class LinearKernel
     return arma::dot(a, b);
   }
 
+  /**
+   * Batched evaluation for all pairs of columns of two datasets; for the
+   * linear kernel the whole matrix is a single matrix product.
+   *
+   * @param a First set of points (one per column).
+   * @param b Second set of points (one per column).
+   * @param kernels Matrix to store kernel values into (resized as needed).
+   */
+  template<typename MatType>
+  static void Evaluate(const MatType& a, const MatType& b, MatType& kernels)
+  {
+    kernels = a.t() * b;
+  }
+
   //! Serialize the kernel (it has no members... do nothing).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
@@ -57,6 +57,21 @@ class PolynomialKernel
     return pow((arma::dot(a, b) + offset), degree);
   }
 
+  /**
+   * Batched evaluation for all pairs of columns of two datasets; the dot
+   * products are computed as one matrix product, and the offset/power are
+   * applied elementwise.
+   *
+   * @param a First set of points (one per column).
+   * @param b Second set of points (one per column).
+   * @param kernels Matrix to store kernel values into (resized as needed).
+   */
+  template<typename MatType>
+  void Evaluate(const MatType& a, const MatType& b, MatType& kernels) const
+  {
+    kernels = arma::pow((a.t() * b) + offset, degree);
+  }
+
   //! Get the degree of the polynomial.
   const double& Degree() const { return degree; }
   //! Modify the degree of the polynomial.
@@ -38,11 +38,77 @@ inline arma::Mat<eT> ColumnCovariance(const arma::Mat<eT>& x,
             false);
 
     const size_t n = xAlias.n_cols;
+    const size_t dim = xAlias.n_rows;
     const eT normVal = (normType == 0) ? ((n > 1) ? eT(n - 1) : eT(1)) : eT(n);
 
-    const arma::Mat<eT> tmp = xAlias.each_col() - arma::mean(xAlias, 1);
+    // Stream over the data in blocks of columns instead of forming a centered
+    // copy of the whole matrix: each block is centered around its own mean and
+    // its comoment is merged into the running result with Chan's pairwise
+    // update.  This keeps the extra memory at one block and the accuracy at
+    // the level of the centered computation.  The blocks are independent, so
+    // each thread accumulates its own partial moments and the partials are
+    // merged at the end.
+    const size_t blockSize = 256;
+
+    #ifdef HAS_OPENMP
+    const size_t numShards = (size_t) omp_get_max_threads();
+    #else
+    const size_t numShards = 1;
+    #endif
+    const size_t numBlocks = (n + blockSize - 1) / blockSize;
+
+    std::vector<size_t> counts(numShards, 0);
+    std::vector<arma::Col<eT>> means(numShards);
+    std::vector<arma::Mat<eT>> comoments(numShards);
+    for (size_t s = 0; s < numShards; ++s)
+    {
+      means[s].zeros(dim);
+      comoments[s].zeros(dim, dim);
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+    {
+      #ifdef HAS_OPENMP
+      const size_t s = (size_t) omp_get_thread_num();
+      #else
+      const size_t s = 0;
+      #endif
+
+      const size_t begin = b * blockSize;
+      const size_t end = std::min(begin + blockSize, n) - 1;
+      const size_t blockCount = end - begin + 1;
+
+      const arma::Col<eT> blockMean = arma::mean(xAlias.cols(begin, end), 1);
+      arma::Mat<eT> centered = xAlias.cols(begin, end);
+      centered.each_col() -= blockMean;
+
+      // Chan's merge of the block moments into this thread's partials.
+      const arma::Col<eT> delta = blockMean - means[s];
+      const size_t total = counts[s] + blockCount;
+      comoments[s] += centered * centered.t() +
+          (delta * delta.t()) * (eT(counts[s]) * eT(blockCount) / eT(total));
+      means[s] += delta * (eT(blockCount) / eT(total));
+      counts[s] = total;
+    }
+
+    // Merge the per-thread partial moments, again with Chan's update.
+    size_t count = counts[0];
+    arma::Col<eT> mean = std::move(means[0]);
+    out = std::move(comoments[0]);
+    for (size_t s = 1; s < numShards; ++s)
+    {
+      if (counts[s] == 0)
+        continue;
+
+      const arma::Col<eT> delta = means[s] - mean;
+      const size_t total = count + counts[s];
+      out += comoments[s] +
+          (delta * delta.t()) * (eT(count) * eT(counts[s]) / eT(total));
+      mean += delta * (eT(counts[s]) / eT(total));
+      count = total;
+    }
 
-    out = tmp * tmp.t();
     out /= normVal;
   }
 
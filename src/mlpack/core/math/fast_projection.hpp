@@ -0,0 +1,201 @@
+/**
+ * @file core/math/fast_projection.hpp
+ * @author Ryan Curtin
+ *
+ * Fast Johnson-Lindenstrauss style random projections: the subsampled
+ * randomized Hadamard transform and the count-sketch transform.  Both apply a
+ * random projection without ever materializing a dense projection matrix,
+ * which makes them far cheaper than a Gaussian projection when the projected
+ * dimension is large.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_FAST_PROJECTION_HPP
+#define MLPACK_CORE_MATH_FAST_PROJECTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * The subsampled randomized Hadamard transform (SRHT).  A vector x of
+ * dimension d is mapped to dimension k as
+ *
+ *   y = S H D x / sqrt(k)
+ *
+ * where D is a diagonal matrix of random signs, H is the (unnormalized)
+ * Walsh-Hadamard transform of the next power-of-two size, and S samples k of
+ * the transformed coordinates.  The scaling makes the squared norm of y an
+ * unbiased estimate of the squared norm of x.  Applying the transform costs
+ * O(d log d) per point independent of k, so it replaces a d x k Gaussian
+ * projection whenever k is much larger than log d.
+ */
+class SubsampledHadamardProjection
+{
+ public:
+  //! Create an empty, unusable projection (for serialization).
+  SubsampledHadamardProjection() : inputDim(0), outputDim(0), paddedDim(0) { }
+
+  /**
+   * Create a random projection from inputDim dimensions to outputDim
+   * dimensions.  outputDim may not exceed the padded (next power of two)
+   * input dimensionality.
+   *
+   * @param inputDim Dimensionality of the points to be projected.
+   * @param outputDim Dimensionality to project to.
+   */
+  SubsampledHadamardProjection(const size_t inputDim, const size_t outputDim);
+
+  /**
+   * Project each column of the input, storing the result in the output
+   * (which will have outputDim rows and input.n_cols columns).
+   *
+   * @param input Matrix of points to project, one per column.
+   * @param output Matrix to store projected points in.
+   */
+  template<typename InMatType, typename MatType>
+  void Project(const InMatType& input, MatType& output) const;
+
+  /**
+   * Project each row of the input, storing the result in the output (which
+   * will have input.n_rows rows and outputDim columns).  This is equivalent
+   * to multiplying the input on the right by the implicit projection matrix,
+   * as done when sketching the column space of a wide matrix.
+   *
+   * @param input Matrix of points to project, one per row.
+   * @param output Matrix to store projected points in.
+   */
+  template<typename InMatType, typename MatType>
+  void ProjectRows(const InMatType& input, MatType& output) const;
+
+  /**
+   * Apply the pseudoinverse of the padded transform to each column of the
+   * input and truncate to the original dimensionality, storing the result in
+   * the output (which will have inputDim rows).  This reconstructs the
+   * original points approximately; the reconstruction is the exact
+   * least-squares solution when the input dimensionality is a power of two.
+   *
+   * @param input Matrix of projected points, one per column.
+   * @param output Matrix to store reconstructed points in.
+   */
+  template<typename MatType>
+  void ProjectBack(const MatType& input, MatType& output) const;
+
+  //! Get the input dimensionality of the projection.
+  size_t InputDim() const { return inputDim; }
+  //! Get the output dimensionality of the projection.
+  size_t OutputDim() const { return outputDim; }
+
+  //! Serialize the projection.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(inputDim));
+    ar(CEREAL_NVP(outputDim));
+    ar(CEREAL_NVP(paddedDim));
+    ar(CEREAL_NVP(signs));
+    ar(CEREAL_NVP(sampled));
+  }
+
+ private:
+  /**
+   * Apply the in-place Walsh-Hadamard butterfly to the rows of the given
+   * matrix, transforming every column at once.  The number of rows must be a
+   * power of two.
+   */
+  template<typename MatType>
+  static void Hadamard(MatType& work);
+
+  //! Dimensionality of the points to be projected.
+  size_t inputDim;
+  //! Dimensionality to project to.
+  size_t outputDim;
+  //! Input dimensionality padded to the next power of two.
+  size_t paddedDim;
+  //! Random sign of each input dimension.
+  arma::vec signs;
+  //! The sampled coordinates of the transformed points.
+  arma::uvec sampled;
+};
+
+/**
+ * The count-sketch transform.  Each input dimension is hashed to one output
+ * dimension with a random sign, so projecting a point costs O(d) regardless
+ * of the output dimensionality and the implicit projection matrix is never
+ * built.  The transform preserves inner products in expectation and is
+ * especially cheap for sparse data, at the price of higher variance than the
+ * Hadamard transform for a given output dimensionality.
+ */
+class CountSketchProjection
+{
+ public:
+  //! Create an empty, unusable projection (for serialization).
+  CountSketchProjection() : inputDim(0), outputDim(0) { }
+
+  /**
+   * Create a random count-sketch projection from inputDim dimensions to
+   * outputDim dimensions.
+   *
+   * @param inputDim Dimensionality of the points to be projected.
+   * @param outputDim Dimensionality to project to.
+   */
+  CountSketchProjection(const size_t inputDim, const size_t outputDim);
+
+  /**
+   * Project each column of the input, storing the result in the output
+   * (which will have outputDim rows and input.n_cols columns).
+   *
+   * @param input Matrix of points to project, one per column.
+   * @param output Matrix to store projected points in.
+   */
+  template<typename InMatType, typename MatType>
+  void Project(const InMatType& input, MatType& output) const;
+
+  /**
+   * Project each row of the input, storing the result in the output (which
+   * will have input.n_rows rows and outputDim columns).
+   *
+   * @param input Matrix of points to project, one per row.
+   * @param output Matrix to store projected points in.
+   */
+  template<typename InMatType, typename MatType>
+  void ProjectRows(const InMatType& input, MatType& output) const;
+
+  //! Get the input dimensionality of the projection.
+  size_t InputDim() const { return inputDim; }
+  //! Get the output dimensionality of the projection.
+  size_t OutputDim() const { return outputDim; }
+
+  //! Serialize the projection.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(inputDim));
+    ar(CEREAL_NVP(outputDim));
+    ar(CEREAL_NVP(bins));
+    ar(CEREAL_NVP(signs));
+  }
+
+ private:
+  //! Dimensionality of the points to be projected.
+  size_t inputDim;
+  //! Dimensionality to project to.
+  size_t outputDim;
+  //! The output dimension each input dimension hashes to.
+  arma::uvec bins;
+  //! Random sign of each input dimension.
+  arma::vec signs;
+};
+
+} // namespace math
+} // namespace mlpack
+
+// Include implementation.
+#include "fast_projection_impl.hpp"
+
+#endif
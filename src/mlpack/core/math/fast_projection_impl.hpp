@@ -0,0 +1,166 @@
+/**
+ * @file core/math/fast_projection_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the fast Johnson-Lindenstrauss style random projections.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_FAST_PROJECTION_IMPL_HPP
+#define MLPACK_CORE_MATH_FAST_PROJECTION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "fast_projection.hpp"
+
+namespace mlpack {
+namespace math {
+
+inline SubsampledHadamardProjection::SubsampledHadamardProjection(
+    const size_t inputDim,
+    const size_t outputDim) :
+    inputDim(inputDim),
+    outputDim(outputDim)
+{
+  // Pad the input dimensionality to the next power of two, since the
+  // Walsh-Hadamard transform is only defined for power-of-two sizes.
+  paddedDim = 1;
+  while (paddedDim < inputDim)
+    paddedDim *= 2;
+
+  if (outputDim > paddedDim)
+  {
+    Log::Fatal << "SubsampledHadamardProjection(): output dimensionality ("
+        << outputDim << ") may not exceed the padded input dimensionality ("
+        << paddedDim << ")!" << std::endl;
+  }
+
+  // Draw the random signs.
+  signs.set_size(inputDim);
+  for (size_t i = 0; i < inputDim; ++i)
+    signs[i] = (Random() < 0.5) ? -1.0 : 1.0;
+
+  // Sample the coordinates to keep, without replacement.
+  arma::uvec ordering = arma::shuffle(
+      arma::regspace<arma::uvec>(0, paddedDim - 1));
+  sampled = arma::sort(ordering.head(outputDim));
+}
+
+template<typename MatType>
+inline void SubsampledHadamardProjection::Hadamard(MatType& work)
+{
+  // The standard iterative butterfly; each level combines row slabs of height
+  // h, so the work vectorizes across all columns at once.
+  for (size_t h = 1; h < work.n_rows; h *= 2)
+  {
+    for (size_t start = 0; start < work.n_rows; start += 2 * h)
+    {
+      const MatType top = work.rows(start, start + h - 1);
+      work.rows(start, start + h - 1) +=
+          work.rows(start + h, start + 2 * h - 1);
+      work.rows(start + h, start + 2 * h - 1) =
+          top - work.rows(start + h, start + 2 * h - 1);
+    }
+  }
+}
+
+template<typename InMatType, typename MatType>
+inline void SubsampledHadamardProjection::Project(const InMatType& input,
+                                                  MatType& output) const
+{
+  // Scatter into the padded buffer and apply the random signs.
+  MatType work(paddedDim, input.n_cols, arma::fill::zeros);
+  work.rows(0, inputDim - 1) = MatType(input);
+  work.rows(0, inputDim - 1).each_col() %= signs;
+
+  Hadamard(work);
+
+  // Keep the sampled coordinates, scaled so that squared norms are preserved
+  // in expectation.
+  output = work.rows(sampled) / std::sqrt((double) outputDim);
+}
+
+template<typename InMatType, typename MatType>
+inline void SubsampledHadamardProjection::ProjectRows(const InMatType& input,
+                                                      MatType& output) const
+{
+  // The same transform as Project(), applied along the rows; this is the
+  // column-slab version of the butterfly.
+  MatType work(input.n_rows, paddedDim, arma::fill::zeros);
+  work.cols(0, inputDim - 1) = MatType(input);
+  const arma::rowvec signsRow = signs.t();
+  work.cols(0, inputDim - 1).each_row() %= signsRow;
+
+  for (size_t h = 1; h < work.n_cols; h *= 2)
+  {
+    for (size_t start = 0; start < work.n_cols; start += 2 * h)
+    {
+      const MatType left = work.cols(start, start + h - 1);
+      work.cols(start, start + h - 1) +=
+          work.cols(start + h, start + 2 * h - 1);
+      work.cols(start + h, start + 2 * h - 1) =
+          left - work.cols(start + h, start + 2 * h - 1);
+    }
+  }
+
+  output = work.cols(sampled) / std::sqrt((double) outputDim);
+}
+
+template<typename MatType>
+inline void SubsampledHadamardProjection::ProjectBack(const MatType& input,
+                                                      MatType& output) const
+{
+  // The padded projection matrix A = S H D / sqrt(k) satisfies
+  // A A^T = (p / k) I, so its pseudoinverse is (k / p) A^T: scatter the
+  // sampled coordinates back, apply the (self-inverse up to scaling) Hadamard
+  // transform and the signs, and rescale.  Truncating the padded coordinates
+  // afterwards makes the reconstruction approximate unless the input
+  // dimensionality is a power of two.
+  MatType work(paddedDim, input.n_cols, arma::fill::zeros);
+  work.rows(sampled) = input;
+
+  Hadamard(work);
+
+  output = work.rows(0, inputDim - 1);
+  output.each_col() %= signs;
+  output *= std::sqrt((double) outputDim) / (double) paddedDim;
+}
+
+inline CountSketchProjection::CountSketchProjection(const size_t inputDim,
+                                                    const size_t outputDim) :
+    inputDim(inputDim),
+    outputDim(outputDim)
+{
+  bins.set_size(inputDim);
+  signs.set_size(inputDim);
+  for (size_t i = 0; i < inputDim; ++i)
+  {
+    bins[i] = (size_t) RandInt(0, outputDim);
+    signs[i] = (Random() < 0.5) ? -1.0 : 1.0;
+  }
+}
+
+template<typename InMatType, typename MatType>
+inline void CountSketchProjection::Project(const InMatType& input,
+                                           MatType& output) const
+{
+  output.zeros(outputDim, input.n_cols);
+  for (size_t r = 0; r < inputDim; ++r)
+    output.row(bins[r]) += signs[r] * MatType(input.row(r));
+}
+
+template<typename InMatType, typename MatType>
+inline void CountSketchProjection::ProjectRows(const InMatType& input,
+                                               MatType& output) const
+{
+  output.zeros(input.n_rows, outputDim);
+  for (size_t r = 0; r < inputDim; ++r)
+    output.col(bins[r]) += signs[r] * MatType(input.col(r));
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
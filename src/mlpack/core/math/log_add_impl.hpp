@@ -13,6 +13,7 @@
 #define MLPACK_CORE_MATH_LOG_ADD_IMPL_HPP
 
 #include "log_add.hpp"
+#include "simd_kernels.hpp"
 
 namespace mlpack {
 namespace math {
@@ -62,11 +63,9 @@ T LogAdd(T x, T y)
 template<typename T>
 typename T::elem_type AccuLog(const T& x)
 {
-  typename T::elem_type maxVal = max(x);
-  if (maxVal == -std::numeric_limits<typename T::elem_type>::infinity())
-    return maxVal;
-
-  return maxVal + log(sum(exp(x - maxVal)));;
+  // Contiguous floating-point vectors go through the runtime-dispatched SIMD
+  // kernel; anything else gets the equivalent max-shifted expression.
+  return simd::LogSumExp(x);
 }
 
 /**
@@ -56,24 +56,30 @@ CubeType MultiplyCube2Cube(const CubeType& cubeA,
 
   CubeType z(rows, cols, slices);
 
+  // Each slice product is independent of all the others, so the slice loops
+  // below run in parallel, one small GEMM per slice per thread.
   if (aTranspose && bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = arma::trans(cubeB.slice(i) * cubeA.slice(i));
   }
   else if (bTranspose && !aTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i) * cubeB.slice(i).t();
   }
   else if (aTranspose && !bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i).t() * cubeB.slice(i);
   }
   else
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i) * cubeB.slice(i);
   }
   return z;
@@ -114,24 +120,30 @@ CubeType MultiplyMat2Cube(const MatType& matA,
 
   CubeType z(rows, cols, slices);
 
+  // Each slice product is independent of all the others, so the slice loops
+  // below run in parallel, one small GEMM per slice per thread.
   if (aTranspose && bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = arma::trans(cubeB.slice(i) * matA);
   }
   else if (bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = matA * cubeB.slice(i).t();
   }
   else if (aTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = matA.t() * cubeB.slice(i);
   }
   else
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = matA * cubeB.slice(i);
   }
   return z;
@@ -170,24 +182,30 @@ CubeType MultiplyCube2Mat(const CubeType& cubeA,
 
   CubeType z(rows, cols, slices);
 
+  // Each slice product is independent of all the others, so the slice loops
+  // below run in parallel, one small GEMM per slice per thread.
   if (aTranspose && bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = arma::trans(matB * cubeA.slice(i));
   }
   else if (bTranspose && !aTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i) * matB.t();
   }
   else if (aTranspose && !bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i).t() * matB;
   }
   else
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i) * matB;
   }
   return z;
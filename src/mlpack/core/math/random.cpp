@@ -1,25 +1,49 @@
 /**
  * @file core/math/random.cpp
  *
- * Declarations of global random number generators.
+ * Definitions of the global random number generator accessors.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
  * 3-clause BSD license along with mlpack.  If not, see
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
+#include <cstdint>
 #include <random>
 #include <mlpack/mlpack_export.hpp>
 
 namespace mlpack {
 namespace math {
 
-// Global random object.
-MLPACK_EXPORT std::mt19937 randGen;
+// The per-thread generator state lives in function-local thread_local
+// objects, because exported thread_local variables are ill-formed on MSVC
+// (C2492); see random.hpp.
+
+// Global random object (one instance per thread; see random.hpp).
+MLPACK_EXPORT std::mt19937& RandGen()
+{
+  static thread_local std::mt19937 randGen;
+  return randGen;
+}
+
 // Global uniform distribution.
-MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist(0.0, 1.0);
+MLPACK_EXPORT std::uniform_real_distribution<>& RandUniformDist()
+{
+  static thread_local std::uniform_real_distribution<>
+      randUniformDist(0.0, 1.0);
+  return randUniformDist;
+}
+
 // Global normal distribution.
-MLPACK_EXPORT std::normal_distribution<> randNormalDist(0.0, 1.0);
+MLPACK_EXPORT std::normal_distribution<>& RandNormalDist()
+{
+  static thread_local std::normal_distribution<> randNormalDist(0.0, 1.0);
+  return randNormalDist;
+}
+
+// The base seed for deterministic random streams; the default matches the
+// default-constructed std::mt19937 seed.
+MLPACK_EXPORT uint64_t randSeedBase = 5489;
 
 } // namespace math
 } // namespace mlpack
@@ -19,28 +19,45 @@ namespace mlpack {
 namespace math /** Miscellaneous math routines. */ {
 
 /**
- * MLPACK_EXPORT is required for global variables; it exports the symbols
- * correctly on Windows.
+ * MLPACK_EXPORT is required for global variables and these accessors; it
+ * exports the symbols correctly on Windows.
+ *
+ * The per-thread generator state is reached through exported accessor
+ * functions (returning function-local thread_local objects) rather than
+ * exported thread_local variables, because MSVC cannot apply
+ * dllexport/dllimport to variables with thread storage duration (C2492).
+ */
+
+/**
+ * Access the calling thread's random generator.  One generator (and
+ * distribution state) exists per thread, so that parallel code — e.g. Monte
+ * Carlo sampling inside OpenMP regions — can draw random numbers without
+ * data races on the engine state.
  */
+MLPACK_EXPORT std::mt19937& RandGen();
+//! Access the calling thread's uniform distribution.
+MLPACK_EXPORT std::uniform_real_distribution<>& RandUniformDist();
+//! Access the calling thread's normal distribution.
+MLPACK_EXPORT std::normal_distribution<>& RandNormalDist();
 
-// Global random object.
-extern MLPACK_EXPORT std::mt19937 randGen;
-// Global uniform distribution.
-extern MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist;
-// Global normal distribution.
-extern MLPACK_EXPORT std::normal_distribution<> randNormalDist;
+// The base seed last given to RandomSeed(); deterministic random streams
+// (RandomStream) are derived from it.
+extern MLPACK_EXPORT uint64_t randSeedBase;
 
 /**
  * Set the random seed used by the random functions (Random() and RandInt()).
  * The seed is casted to a 32-bit integer before being given to the random
  * number generator, but a size_t is taken as a parameter for API consistency.
+ * Note that the generators are per-thread, so this seeds the calling thread's
+ * generator; other threads keep their own (default-seeded) streams.
  *
  * @param seed Seed for the random number generator.
  */
 inline void RandomSeed(const size_t seed)
 {
   #if (!defined(BINDING_TYPE) || BINDING_TYPE != BINDING_TYPE_TEST)
-    randGen.seed((uint32_t) seed);
+    randSeedBase = (uint64_t) seed;
+    RandGen().seed((uint32_t) seed);
     #if (BINDING_TYPE == BINDING_TYPE_R)
       // To suppress Found 'srand', possibly from 'srand' (C).
       (void) seed;
@@ -64,25 +81,104 @@ inline void RandomSeed(const size_t seed)
 inline void FixedRandomSeed()
 {
   const static size_t seed = rand();
-  randGen.seed((uint32_t) seed);
+  randSeedBase = (uint64_t) seed;
+  RandGen().seed((uint32_t) seed);
   srand((unsigned int) seed);
   arma::arma_rng::set_seed(seed);
 }
 
 inline void CustomRandomSeed(const size_t seed)
 {
-  randGen.seed((uint32_t) seed);
+  randSeedBase = (uint64_t) seed;
+  RandGen().seed((uint32_t) seed);
   srand((unsigned int) seed);
   arma::arma_rng::set_seed(seed);
 }
 #endif
 
+/**
+ * A counter-based random generator.  Instead of a large evolving state, the
+ * generator holds a key derived from a (seed, stream) pair and a counter, and
+ * every output is a strong mix (the SplitMix64 finalizer applied twice) of
+ * the key and the counter.  Distinct streams of the same seed are
+ * statistically independent, and each stream produces the same sequence no
+ * matter which thread runs it or in what order the streams are used.
+ *
+ * This is the facility to use for reproducible parallel randomness: give work
+ * item i the i-th stream (or call SeedThreadStream(i) to reseed the calling
+ * thread's global generator from it), and a seeded run becomes bit-for-bit
+ * identical at any thread count.
+ *
+ * The class satisfies the UniformRandomBitGenerator concept, so it can be
+ * used with the <random> distributions directly.
+ */
+class RandomStream
+{
+ public:
+  typedef uint64_t result_type;
+
+  /**
+   * Create the stream-th random stream of the current global seed (the seed
+   * last given to RandomSeed()).
+   *
+   * @param stream Index of the stream to create.
+   */
+  explicit RandomStream(const uint64_t stream) :
+      RandomStream(randSeedBase, stream) { }
+
+  /**
+   * Create the stream-th random stream of the given base seed.
+   *
+   * @param seed Base seed to derive the stream from.
+   * @param stream Index of the stream to create.
+   */
+  RandomStream(const uint64_t seed, const uint64_t stream) :
+      key(Mix(seed ^ Mix(stream + 0x9E3779B97F4A7C15ULL))),
+      counter(0) { }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return ~result_type(0); }
+
+  //! Return the next value of the stream.
+  result_type operator()() { return Mix(key ^ Mix(++counter)); }
+
+ private:
+  //! The SplitMix64 finalizer: a bijective mix of all 64 bits.
+  static uint64_t Mix(uint64_t z)
+  {
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  //! The key of this (seed, stream) pair.
+  uint64_t key;
+  //! The number of values drawn so far.
+  uint64_t counter;
+};
+
+/**
+ * Reseed the calling thread's global generator (RandGen()) to the stream-th
+ * deterministic stream of the current global seed.  Call this at the start of
+ * a parallel work item, with the work item index as the stream, to make all
+ * randomness drawn through Random() and RandInt() within the item
+ * reproducible regardless of which thread runs it.
+ *
+ * @param stream Index of the stream to seed with.
+ */
+inline void SeedThreadStream(const uint64_t stream)
+{
+  RandomStream s(stream);
+  RandGen().seed((uint32_t) s());
+}
+
 /**
  * Generates a uniform random number between 0 and 1.
  */
 inline double Random()
 {
-  return randUniformDist(randGen);
+  return RandUniformDist()(RandGen());
 }
 
 /**
@@ -90,7 +186,7 @@ inline double Random()
  */
 inline double Random(const double lo, const double hi)
 {
-  return lo + (hi - lo) * randUniformDist(randGen);
+  return lo + (hi - lo) * RandUniformDist()(RandGen());
 }
 
 /**
@@ -109,7 +205,7 @@ inline double RandBernoulli(const double input)
  */
 inline int RandInt(const int hiExclusive)
 {
-  return (int) std::floor((double) hiExclusive * randUniformDist(randGen));
+  return (int) std::floor((double) hiExclusive * RandUniformDist()(RandGen()));
 }
 
 /**
@@ -118,7 +214,7 @@ inline int RandInt(const int hiExclusive)
 inline int RandInt(const int lo, const int hiExclusive)
 {
   return lo + (int) std::floor((double) (hiExclusive - lo)
-                               * randUniformDist(randGen));
+                               * RandUniformDist()(RandGen()));
 }
 
 /**
@@ -126,7 +222,7 @@ inline int RandInt(const int lo, const int hiExclusive)
  */
 inline double RandNormal()
 {
-  return randNormalDist(randGen);
+  return RandNormalDist()(RandGen());
 }
 
 /**
@@ -138,7 +234,7 @@ inline double RandNormal()
  */
 inline double RandNormal(const double mean, const double variance)
 {
-  return variance * randNormalDist(randGen) + mean;
+  return variance * RandNormalDist()(RandGen()) + mean;
 }
 
 /**
@@ -17,6 +17,67 @@
 namespace mlpack {
 namespace math {
 
+/**
+ * Generate a uniformly random visitation ordering of numPoints points.  This
+ * is the permutation used internally by all of the ShuffleData() overloads.
+ *
+ * For very large datasets it is often preferable not to materialize a
+ * shuffled copy of the data at all: store this ordering instead and gather
+ * each mini-batch on demand with OrderedBatch().  Then an epoch of shuffled
+ * visitation costs one permutation of indices, not a copy of the dataset.
+ */
+inline arma::uvec ShuffleOrdering(const size_t numPoints)
+{
+  return arma::shuffle(arma::linspace<arma::uvec>(0, numPoints - 1,
+      numPoints));
+}
+
+/**
+ * Gather the batch of batchSize points starting at position begin of the
+ * given visitation ordering into output.  Only one batch of columns is ever
+ * copied, never the full dataset.  An empty ordering denotes the identity
+ * ordering, so the same call works before and after any shuffling has been
+ * done.
+ */
+template<typename MatType>
+void OrderedBatch(const MatType& input,
+                  const arma::uvec& ordering,
+                  const size_t begin,
+                  const size_t batchSize,
+                  MatType& output,
+                  const std::enable_if_t<!arma::is_SpMat<MatType>::value>* = 0)
+{
+  if (ordering.is_empty())
+    output = input.cols(begin, begin + batchSize - 1);
+  else
+    output = input.cols(ordering.subvec(begin, begin + batchSize - 1));
+}
+
+/**
+ * Gather the batch of batchSize points starting at position begin of the
+ * given visitation ordering into output.  Sparse matrices do not support
+ * non-contiguous column views, so the batch is assembled column by column.
+ */
+template<typename MatType>
+void OrderedBatch(const MatType& input,
+                  const arma::uvec& ordering,
+                  const size_t begin,
+                  const size_t batchSize,
+                  MatType& output,
+                  const std::enable_if_t<arma::is_SpMat<MatType>::value>* = 0)
+{
+  if (ordering.is_empty())
+  {
+    output = input.cols(begin, begin + batchSize - 1);
+  }
+  else
+  {
+    output.zeros(input.n_rows, batchSize);
+    for (size_t i = 0; i < batchSize; ++i)
+      output.col(i) = input.col(ordering[begin + i]);
+  }
+}
+
 /**
  * Shuffle a dataset and associated labels (or responses).  It is expected that
  * inputPoints and inputLabels have the same number of columns (so, be sure that
@@ -33,8 +94,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
 
   outputPoints = inputPoints.cols(ordering);
   outputLabels = inputLabels.cols(ordering);
@@ -56,8 +116,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
 
   // Extract coordinate list representation.
   arma::umat locations(2, inputPoints.n_nonzero);
@@ -109,8 +168,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<arma::is_Cube<LabelsType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
 
   // Properly handle the case where the input and output data are the same
   // object.
@@ -167,8 +225,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
 
   outputPoints = inputPoints.cols(ordering);
   outputLabels = inputLabels.cols(ordering);
@@ -195,8 +252,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
 
   // Extract coordinate list representation.
   arma::umat locations(2, inputPoints.n_nonzero);
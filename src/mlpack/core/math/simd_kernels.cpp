@@ -0,0 +1,266 @@
+/**
+ * @file core/math/simd_kernels.cpp
+ *
+ * Definitions of the runtime-dispatched SIMD kernels.  The kernels are
+ * deliberately written as plain scalar loops: with function multiversioning
+ * (MLPACK_TARGET_CLONES below), GCC and compatible compilers compile each
+ * kernel once per listed instruction set and install a resolver that picks
+ * the widest variant the CPU supports at load time.  Hand-written intrinsics
+ * would pin the code to one instruction set and are avoided on purpose.
+ *
+ * The `omp simd` pragmas assert that the reductions and elementwise loops may
+ * be reassociated and vectorized; without OpenMP they are ignored and the
+ * loops still compile as ordinary scalar code.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "simd_kernels.hpp"
+
+#include <cmath>
+#include <limits>
+
+// Function multiversioning needs GCC 6 or newer and ELF ifunc support; on
+// other platforms the kernels compile once for the baseline target and the
+// dispatch cost disappears entirely.
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 6) && \
+    defined(__x86_64__) && defined(__ELF__)
+  #define MLPACK_TARGET_CLONES \
+      __attribute__((target_clones("avx512f", "avx2", "default")))
+  #define MLPACK_TARGET_CLONES_DESC \
+      "runtime (target_clones: avx512f, avx2, default)"
+#else
+  #define MLPACK_TARGET_CLONES
+  #define MLPACK_TARGET_CLONES_DESC "compile-time (baseline target only)"
+#endif
+
+namespace mlpack {
+namespace math {
+namespace simd {
+
+const char* KernelDispatchDescription()
+{
+  return MLPACK_TARGET_CLONES_DESC;
+}
+
+MLPACK_TARGET_CLONES
+double SquaredDistance(const double* a, const double* b, const size_t n)
+{
+  double sum = 0.0;
+  #pragma omp simd reduction(+:sum)
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double d = a[i] - b[i];
+    sum += d * d;
+  }
+  return sum;
+}
+
+MLPACK_TARGET_CLONES
+float SquaredDistance(const float* a, const float* b, const size_t n)
+{
+  float sum = 0.0f;
+  #pragma omp simd reduction(+:sum)
+  for (size_t i = 0; i < n; ++i)
+  {
+    const float d = a[i] - b[i];
+    sum += d * d;
+  }
+  return sum;
+}
+
+// In the bound kernels below, a[2 * d] and a[2 * d + 1] are the lower and
+// upper bound of dimension d (the memory layout of an array of RangeType).
+// With v1 = b.lo - a.hi and v2 = a.lo - b.hi, the separation of the two
+// hyperrectangles in dimension d is max(0, v1, v2) and the furthest spread is
+// max(-v1, -v2); both are accumulated as squared sums (the L2 case).
+
+MLPACK_TARGET_CLONES
+double BoundMinDistanceSum(const double* a, const double* b, const size_t dim)
+{
+  double sum = 0.0;
+  #pragma omp simd reduction(+:sum)
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const double v1 = b[2 * d] - a[2 * d + 1];
+    const double v2 = a[2 * d] - b[2 * d + 1];
+    double v = (v1 > v2) ? v1 : v2;
+    v = (v > 0.0) ? v : 0.0;
+    sum += v * v;
+  }
+  return sum;
+}
+
+MLPACK_TARGET_CLONES
+float BoundMinDistanceSum(const float* a, const float* b, const size_t dim)
+{
+  float sum = 0.0f;
+  #pragma omp simd reduction(+:sum)
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const float v1 = b[2 * d] - a[2 * d + 1];
+    const float v2 = a[2 * d] - b[2 * d + 1];
+    float v = (v1 > v2) ? v1 : v2;
+    v = (v > 0.0f) ? v : 0.0f;
+    sum += v * v;
+  }
+  return sum;
+}
+
+MLPACK_TARGET_CLONES
+void RangeDistanceSums(const double* a, const double* b, const size_t dim,
+                       double& loSum, double& hiSum)
+{
+  double lo = 0.0, hi = 0.0;
+  #pragma omp simd reduction(+:lo,hi)
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const double v1 = b[2 * d] - a[2 * d + 1];
+    const double v2 = a[2 * d] - b[2 * d + 1];
+    double vLo = (v1 > v2) ? v1 : v2;
+    vLo = (vLo > 0.0) ? vLo : 0.0;
+    const double vHi = (v1 < v2) ? -v1 : -v2;
+    lo += vLo * vLo;
+    hi += vHi * vHi;
+  }
+  loSum = lo;
+  hiSum = hi;
+}
+
+MLPACK_TARGET_CLONES
+void RangeDistanceSums(const float* a, const float* b, const size_t dim,
+                       float& loSum, float& hiSum)
+{
+  float lo = 0.0f, hi = 0.0f;
+  #pragma omp simd reduction(+:lo,hi)
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const float v1 = b[2 * d] - a[2 * d + 1];
+    const float v2 = a[2 * d] - b[2 * d + 1];
+    float vLo = (v1 > v2) ? v1 : v2;
+    vLo = (vLo > 0.0f) ? vLo : 0.0f;
+    const float vHi = (v1 < v2) ? -v1 : -v2;
+    lo += vLo * vLo;
+    hi += vHi * vHi;
+  }
+  loSum = lo;
+  hiSum = hi;
+}
+
+MLPACK_TARGET_CLONES
+void PointRangeDistanceSums(const double* point, const double* b,
+                            const size_t dim, double& loSum, double& hiSum)
+{
+  double lo = 0.0, hi = 0.0;
+  #pragma omp simd reduction(+:lo,hi)
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const double v1 = b[2 * d] - point[d];
+    const double v2 = point[d] - b[2 * d + 1];
+    double vLo = (v1 > v2) ? v1 : v2;
+    vLo = (vLo > 0.0) ? vLo : 0.0;
+    const double vHi = (-v1 > -v2) ? -v1 : -v2;
+    lo += vLo * vLo;
+    hi += vHi * vHi;
+  }
+  loSum = lo;
+  hiSum = hi;
+}
+
+MLPACK_TARGET_CLONES
+void PointRangeDistanceSums(const float* point, const float* b,
+                            const size_t dim, float& loSum, float& hiSum)
+{
+  float lo = 0.0f, hi = 0.0f;
+  #pragma omp simd reduction(+:lo,hi)
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const float v1 = b[2 * d] - point[d];
+    const float v2 = point[d] - b[2 * d + 1];
+    float vLo = (v1 > v2) ? v1 : v2;
+    vLo = (vLo > 0.0f) ? vLo : 0.0f;
+    const float vHi = (-v1 > -v2) ? -v1 : -v2;
+    lo += vLo * vLo;
+    hi += vHi * vHi;
+  }
+  loSum = lo;
+  hiSum = hi;
+}
+
+MLPACK_TARGET_CLONES
+void Logistic(const double* x, double* y, const size_t n)
+{
+  #pragma omp simd
+  for (size_t i = 0; i < n; ++i)
+    y[i] = 1.0 / (1.0 + std::exp(-x[i]));
+}
+
+MLPACK_TARGET_CLONES
+void Logistic(const float* x, float* y, const size_t n)
+{
+  #pragma omp simd
+  for (size_t i = 0; i < n; ++i)
+    y[i] = 1.0f / (1.0f + std::exp(-x[i]));
+}
+
+MLPACK_TARGET_CLONES
+void Rectifier(const double* x, double* y, const size_t n)
+{
+  #pragma omp simd
+  for (size_t i = 0; i < n; ++i)
+    y[i] = (x[i] > 0.0) ? x[i] : 0.0;
+}
+
+MLPACK_TARGET_CLONES
+void Rectifier(const float* x, float* y, const size_t n)
+{
+  #pragma omp simd
+  for (size_t i = 0; i < n; ++i)
+    y[i] = (x[i] > 0.0f) ? x[i] : 0.0f;
+}
+
+MLPACK_TARGET_CLONES
+double LogSumExp(const double* x, const size_t n)
+{
+  double maxVal = -std::numeric_limits<double>::infinity();
+  #pragma omp simd reduction(max:maxVal)
+  for (size_t i = 0; i < n; ++i)
+    maxVal = (x[i] > maxVal) ? x[i] : maxVal;
+
+  // All elements are -inf (or the array is empty); exp(-inf - -inf) would
+  // produce NaNs, so return -inf directly.
+  if (maxVal == -std::numeric_limits<double>::infinity())
+    return maxVal;
+
+  double sum = 0.0;
+  #pragma omp simd reduction(+:sum)
+  for (size_t i = 0; i < n; ++i)
+    sum += std::exp(x[i] - maxVal);
+
+  return maxVal + std::log(sum);
+}
+
+MLPACK_TARGET_CLONES
+float LogSumExp(const float* x, const size_t n)
+{
+  float maxVal = -std::numeric_limits<float>::infinity();
+  #pragma omp simd reduction(max:maxVal)
+  for (size_t i = 0; i < n; ++i)
+    maxVal = (x[i] > maxVal) ? x[i] : maxVal;
+
+  if (maxVal == -std::numeric_limits<float>::infinity())
+    return maxVal;
+
+  float sum = 0.0f;
+  #pragma omp simd reduction(+:sum)
+  for (size_t i = 0; i < n; ++i)
+    sum += std::exp(x[i] - maxVal);
+
+  return maxVal + std::log(sum);
+}
+
+} // namespace simd
+} // namespace math
+} // namespace mlpack
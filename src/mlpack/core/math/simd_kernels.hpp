@@ -0,0 +1,200 @@
+/**
+ * @file core/math/simd_kernels.hpp
+ *
+ * Runtime-dispatched SIMD kernels for a handful of hot inner loops: squared
+ * Euclidean distances, logistic and rectifier activations, and log-sum-exp
+ * reductions.  The kernels are plain scalar loops compiled (where the compiler
+ * supports function multiversioning) into several variants targeting different
+ * x86-64 vector extensions; the best variant is selected at load time, so a
+ * single binary runs well on both old and new hardware without rebuilding.
+ *
+ * The kernels operate on raw contiguous arrays.  The templated wrappers below
+ * route contiguous dense Armadillo vectors through the kernels and fall back
+ * to the equivalent Armadillo expression for anything else (subviews with
+ * strides, expression templates, integral element types, ...), so callers can
+ * use them unconditionally.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_SIMD_KERNELS_HPP
+#define MLPACK_CORE_MATH_SIMD_KERNELS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <limits>
+
+namespace mlpack {
+namespace math {
+namespace simd /** Runtime-dispatched SIMD kernels. */ {
+
+/**
+ * Return a short human-readable description of how the kernels in this file
+ * are dispatched ("runtime" with the list of targeted instruction sets when
+ * function multiversioning is available, "compile-time" otherwise).  This is
+ * useful for verbose logging and for debugging performance problems.
+ */
+const char* KernelDispatchDescription();
+
+//! Compute the squared Euclidean distance between two arrays of length n.
+double SquaredDistance(const double* a, const double* b, const size_t n);
+//! Compute the squared Euclidean distance between two arrays of length n.
+float SquaredDistance(const float* a, const float* b, const size_t n);
+
+//! Compute the minimum squared distance between two hyperrectangles given as
+//! interleaved (lo, hi) arrays of dim pairs each.
+double BoundMinDistanceSum(const double* a, const double* b, const size_t dim);
+//! Compute the minimum squared distance between two hyperrectangles given as
+//! interleaved (lo, hi) arrays of dim pairs each.
+float BoundMinDistanceSum(const float* a, const float* b, const size_t dim);
+
+//! Compute the minimum and maximum squared distances between two
+//! hyperrectangles, given as interleaved (lo, hi) arrays of dim pairs each,
+//! in a single fused pass.
+void RangeDistanceSums(const double* a, const double* b, const size_t dim,
+                       double& loSum, double& hiSum);
+//! Compute the minimum and maximum squared distances between two
+//! hyperrectangles, given as interleaved (lo, hi) arrays of dim pairs each,
+//! in a single fused pass.
+void RangeDistanceSums(const float* a, const float* b, const size_t dim,
+                       float& loSum, float& hiSum);
+
+//! Compute the minimum and maximum squared distances between a point of dim
+//! elements and a hyperrectangle given as an interleaved (lo, hi) array of
+//! dim pairs, in a single fused pass.
+void PointRangeDistanceSums(const double* point, const double* b,
+                            const size_t dim, double& loSum, double& hiSum);
+//! Compute the minimum and maximum squared distances between a point of dim
+//! elements and a hyperrectangle given as an interleaved (lo, hi) array of
+//! dim pairs, in a single fused pass.
+void PointRangeDistanceSums(const float* point, const float* b,
+                            const size_t dim, float& loSum, float& hiSum);
+
+//! Apply the logistic function 1 / (1 + e^-x) elementwise; x and y may alias.
+void Logistic(const double* x, double* y, const size_t n);
+//! Apply the logistic function 1 / (1 + e^-x) elementwise; x and y may alias.
+void Logistic(const float* x, float* y, const size_t n);
+
+//! Apply the rectifier max(0, x) elementwise; x and y may alias.
+void Rectifier(const double* x, double* y, const size_t n);
+//! Apply the rectifier max(0, x) elementwise; x and y may alias.
+void Rectifier(const float* x, float* y, const size_t n);
+
+//! Compute log(sum(exp(x))) over an array of length n, shifting by the
+//! maximum for numerical stability.  Returns -inf for an empty array.
+double LogSumExp(const double* x, const size_t n);
+//! Compute log(sum(exp(x))) over an array of length n, shifting by the
+//! maximum for numerical stability.  Returns -inf for an empty array.
+float LogSumExp(const float* x, const size_t n);
+
+/**
+ * Trait that is true when VecType stores its elements in one contiguous block
+ * whose start can be recovered with MemPtr() below: dense vectors and column
+ * subviews qualify; row subviews and general expressions do not.
+ */
+template<typename VecType>
+struct IsContiguous
+{
+  static const bool value = arma::is_Col<VecType>::value ||
+      arma::is_Row<VecType>::value;
+};
+
+template<typename eT>
+struct IsContiguous<arma::subview_col<eT>>
+{
+  static const bool value = true;
+};
+
+//! Get a pointer to the contiguous memory of a dense vector.
+template<typename VecType>
+inline const typename VecType::elem_type* MemPtr(const VecType& v)
+{
+  return v.memptr();
+}
+
+//! Get a pointer to the contiguous memory of a column subview.
+template<typename eT>
+inline const eT* MemPtr(const arma::subview_col<eT>& v)
+{
+  return v.colmem;
+}
+
+/**
+ * Compute the squared Euclidean distance between two vectors via the
+ * runtime-dispatched kernel.  This overload is selected when both arguments
+ * are contiguous vectors of the same floating-point element type.
+ */
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type SquaredDistance(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename std::enable_if<
+        IsContiguous<VecTypeA>::value &&
+        IsContiguous<VecTypeB>::value &&
+        std::is_floating_point<typename VecTypeA::elem_type>::value &&
+        std::is_same<typename VecTypeA::elem_type,
+                     typename VecTypeB::elem_type>::value>::type* = 0)
+{
+  return SquaredDistance(MemPtr(a), MemPtr(b), a.n_elem);
+}
+
+/**
+ * Compute the squared Euclidean distance between two vectors via the
+ * equivalent Armadillo expression.  This overload is the fallback for
+ * non-contiguous arguments, expressions, and non-floating-point types.
+ */
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type SquaredDistance(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename std::enable_if<!(
+        IsContiguous<VecTypeA>::value &&
+        IsContiguous<VecTypeB>::value &&
+        std::is_floating_point<typename VecTypeA::elem_type>::value &&
+        std::is_same<typename VecTypeA::elem_type,
+                     typename VecTypeB::elem_type>::value)>::type* = 0)
+{
+  return arma::accu(arma::square(a - b));
+}
+
+/**
+ * Compute log(sum(exp(x))) over a vector via the runtime-dispatched kernel.
+ * This overload is selected when the argument is a contiguous vector of
+ * floating-point type.
+ */
+template<typename VecType>
+inline typename VecType::elem_type LogSumExp(
+    const VecType& x,
+    const typename std::enable_if<
+        IsContiguous<VecType>::value &&
+        std::is_floating_point<typename VecType::elem_type>::value>::type* = 0)
+{
+  return LogSumExp(MemPtr(x), x.n_elem);
+}
+
+/**
+ * Compute log(sum(exp(x))) over a vector via the equivalent max-shifted
+ * Armadillo expression.  This overload is the fallback for non-contiguous
+ * arguments, expressions, and non-floating-point types.
+ */
+template<typename VecType>
+inline typename VecType::elem_type LogSumExp(
+    const VecType& x,
+    const typename std::enable_if<!(
+        IsContiguous<VecType>::value &&
+        std::is_floating_point<typename VecType::elem_type>::value)>::type* = 0)
+{
+  const typename VecType::elem_type maxVal = arma::max(x);
+  if (maxVal ==
+      -std::numeric_limits<typename VecType::elem_type>::infinity())
+    return maxVal;
+
+  return maxVal + std::log(arma::accu(arma::exp(x - maxVal)));
+}
+
+} // namespace simd
+} // namespace math
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file core/math/z_order.hpp
+ *
+ * Morton (Z-order) space-filling-curve utilities.  Sorting points along the
+ * Z-order curve before building a space-partitioning tree makes the build and
+ * later leaf scans access memory in a cache-coherent order, since points that
+ * are close in space end up close in the matrix.  The trees themselves are
+ * unaffected structurally; only the layout of the dataset changes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_Z_ORDER_HPP
+#define MLPACK_CORE_MATH_Z_ORDER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Tag type to request Z-order presorting of the dataset in tree constructors
+ * that support it (see BinarySpaceTree and Octree).
+ */
+struct ZOrderPresort { };
+
+/**
+ * Compute the Morton (Z-order) code of a single point.  Each dimension is
+ * quantized into the grid defined by mins and widths, using as many bits per
+ * dimension as fit into 64 bits, and the quantized coordinates are
+ * bit-interleaved.  Points in more than 64 dimensions all map to code 0; the
+ * curve carries no useful locality there anyway.
+ *
+ * @param point Point to encode.
+ * @param mins Minimum value of each dimension.
+ * @param widths Width of each dimension (maximum minus minimum).
+ * @return The Morton code of the point.
+ */
+template<typename VecType>
+uint64_t ZOrderValue(const VecType& point,
+                     const arma::vec& mins,
+                     const arma::vec& widths)
+{
+  const size_t dims = point.n_elem;
+  if (dims == 0 || dims > 64)
+    return 0;
+
+  const size_t bitsPerDim = 64 / dims;
+  const uint64_t maxCell = (bitsPerDim == 64) ? ~uint64_t(0) :
+      ((uint64_t(1) << bitsPerDim) - 1);
+
+  uint64_t code = 0;
+  for (size_t d = 0; d < dims; ++d)
+  {
+    // Quantize the coordinate into [0, maxCell], clamping for safety against
+    // values outside [mins[d], mins[d] + widths[d]].
+    uint64_t cell = 0;
+    if (widths[d] > 0)
+    {
+      const double scaled = (point[d] - mins[d]) / widths[d];
+      if (scaled >= 1.0)
+        cell = maxCell;
+      else if (scaled > 0.0)
+        cell = (uint64_t) (scaled * (double) maxCell);
+    }
+
+    // Interleave: bit i of this dimension's cell becomes bit (i * dims + d)
+    // of the code.
+    for (size_t i = 0; i < bitsPerDim; ++i)
+      code |= ((cell >> i) & 1) << (i * dims + d);
+  }
+
+  return code;
+}
+
+/**
+ * Compute the ordering that sorts the columns of the given dataset along the
+ * Morton (Z-order) curve.  The encoding of each column is done in parallel
+ * when OpenMP is available; the sort is stable, so the ordering is
+ * deterministic.
+ *
+ * @param data Dataset to compute the ordering for.
+ * @param ordering Output vector; ordering[i] is the original column index of
+ *      the i'th point along the curve.
+ */
+template<typename MatType>
+void ZOrderIndices(const MatType& data, std::vector<size_t>& ordering)
+{
+  const size_t n = data.n_cols;
+  ordering.resize(n);
+  for (size_t i = 0; i < n; ++i)
+    ordering[i] = i;
+
+  if (n == 0 || data.n_rows == 0)
+    return;
+
+  // Bounding box of the data, for quantization.
+  const arma::vec mins = arma::conv_to<arma::vec>::from(arma::min(data, 1));
+  const arma::vec maxs = arma::conv_to<arma::vec>::from(arma::max(data, 1));
+  const arma::vec widths = maxs - mins;
+
+  std::vector<uint64_t> codes(n);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) n; ++i)
+    codes[i] = ZOrderValue(data.col(i), mins, widths);
+
+  std::stable_sort(ordering.begin(), ordering.end(),
+      [&codes](const size_t a, const size_t b) { return codes[a] < codes[b]; });
+}
+
+/**
+ * Reorder the columns of the given dataset along the Morton (Z-order) curve,
+ * storing the permutation in oldFromNew: after the call, column i of the data
+ * held the index oldFromNew[i] before the call.  The mapping has the same
+ * format as the oldFromNew mappings produced by tree constructors, so it can
+ * be used to initialize those mappings when presorting inside a constructor.
+ *
+ * @param data Dataset to reorder.
+ * @param oldFromNew Output vector of mappings to original column indices.
+ */
+template<typename MatType>
+void ZOrderPoints(MatType& data, std::vector<size_t>& oldFromNew)
+{
+  ZOrderIndices(data, oldFromNew);
+
+  const arma::uvec ordering =
+      arma::conv_to<arma::uvec>::from(oldFromNew);
+  data = data.cols(ordering);
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
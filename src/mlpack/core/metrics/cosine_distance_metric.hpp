@@ -0,0 +1,97 @@
+/**
+ * @file core/metrics/cosine_distance_metric.hpp
+ * @author Ryan Curtin
+ *
+ * The cosine distance as a metric-policy class with cached norms, usable
+ * anywhere a MetricType template parameter is accepted.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_COSINE_DISTANCE_METRIC_HPP
+#define MLPACK_CORE_METRICS_COSINE_DISTANCE_METRIC_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "self_value_cache.hpp"
+
+namespace mlpack {
+namespace metric {
+
+/**
+ * The cosine distance,
+ *
+ * @f[
+ * d(x, y) = 1 - \frac{x^T y}{|| x || \: || y ||},
+ * @f]
+ *
+ * which lies in the range [0, 2].  This is the distance complement of the
+ * CosineDistance kernel, packaged as a metric-policy class so that it can be
+ * used directly by NeighborSearch and other distance-based methods.  Note
+ * that the cosine distance does not satisfy the triangle inequality, so, like
+ * SquaredEuclideanDistance, it is not a true metric: use it with methods (or
+ * tree types) that do not rely on the triangle inequality for correctness.
+ *
+ * Each evaluation needs the norms of both points; PrecomputeNorms() caches
+ * the inverse norms of every column of a dataset, halving the FLOPs of every
+ * evaluation over that dataset (only the dot product remains).  By
+ * convention, the distance to a zero vector is 1 (as if the vectors were
+ * orthogonal).
+ */
+class CosineDistanceMetric
+{
+ public:
+  /**
+   * Default constructor does nothing, but is required to satisfy the Metric
+   * policy.
+   */
+  CosineDistanceMetric() { }
+
+  /**
+   * Computes the cosine distance between two points.
+   *
+   * @tparam VecTypeA Type of first vector.
+   * @tparam VecTypeB Type of second vector.
+   * @param a First vector.
+   * @param b Second vector.
+   * @return Cosine distance between vectors a and b, in [0, 2].
+   */
+  template<typename VecTypeA, typename VecTypeB>
+  typename VecTypeA::elem_type Evaluate(const VecTypeA& a,
+                                        const VecTypeB& b) const;
+
+  /**
+   * Precompute and cache the inverse norms of every column of the given
+   * dataset.  Afterwards, any Evaluate() call whose arguments are columns of
+   * that dataset only computes the dot product.  Both the reference and the
+   * query set may be cached; the cache must be cleared with ClearNorms() if
+   * the dataset is moved or modified.
+   *
+   * @param dataset Dataset whose columns will be cached.
+   */
+  template<typename MatType>
+  void PrecomputeNorms(const MatType& dataset);
+
+  //! Drop all cached norms.
+  void ClearNorms() { inverseNorms.Clear(); }
+
+  //! Serialize the metric (the norm cache is not serialized; recompute after
+  //! loading if desired).
+  template<typename Archive>
+  void serialize(Archive& /* ar */, const uint32_t /* version */) { }
+
+ private:
+  //! Cached inverse norms of dataset columns; zero-norm columns are cached
+  //! as 0, which the evaluation treats as "distance 1 to everything".
+  details::SelfValueCache<double> inverseNorms;
+};
+
+} // namespace metric
+} // namespace mlpack
+
+// Include implementation.
+#include "cosine_distance_metric_impl.hpp"
+
+#endif
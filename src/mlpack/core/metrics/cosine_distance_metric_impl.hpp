@@ -0,0 +1,65 @@
+/**
+ * @file core/metrics/cosine_distance_metric_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the cosine distance metric with cached norms.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_COSINE_DISTANCE_METRIC_IMPL_HPP
+#define MLPACK_CORE_METRICS_COSINE_DISTANCE_METRIC_IMPL_HPP
+
+// In case it hasn't been included.
+#include "cosine_distance_metric.hpp"
+
+namespace mlpack {
+namespace metric {
+
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type CosineDistanceMetric::Evaluate(
+    const VecTypeA& a,
+    const VecTypeB& b) const
+{
+  typedef typename VecTypeA::elem_type ElemType;
+
+  // The inverse norms come from the cache when the points are columns of a
+  // precomputed dataset (see PrecomputeNorms()); otherwise they are computed
+  // here.  A zero vector has no direction; by convention its distance to
+  // everything is 1.
+  double invNormA, invNormB;
+  if (!inverseNorms.Lookup(a, invNormA))
+  {
+    const double norm = arma::norm(a, 2);
+    invNormA = (norm == 0.0) ? 0.0 : 1.0 / norm;
+  }
+  if (!inverseNorms.Lookup(b, invNormB))
+  {
+    const double norm = arma::norm(b, 2);
+    invNormB = (norm == 0.0) ? 0.0 : 1.0 / norm;
+  }
+
+  if (invNormA == 0.0 || invNormB == 0.0)
+    return (ElemType) 1;
+
+  return (ElemType) (1.0 - arma::dot(a, b) * invNormA * invNormB);
+}
+
+template<typename MatType>
+void CosineDistanceMetric::PrecomputeNorms(const MatType& dataset)
+{
+  inverseNorms.Reserve(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    const double norm = arma::norm(dataset.col(i), 2);
+    inverseNorms.Insert((const void*) dataset.colptr(i),
+        (norm == 0.0) ? 0.0 : 1.0 / norm);
+  }
+}
+
+} // namespace metric
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,108 @@
+/**
+ * @file core/metrics/counting_metric.hpp
+ * @author Ryan Curtin
+ *
+ * A metric wrapper that counts how often the wrapped metric is evaluated.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_COUNTING_METRIC_HPP
+#define MLPACK_CORE_METRICS_COUNTING_METRIC_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <atomic>
+
+namespace mlpack {
+namespace metric {
+
+/**
+ * The CountingMetric class wraps another metric and counts every call to
+ * Evaluate().  With an expensive metric (for instance an IPMetric over a
+ * costly kernel), the number of metric evaluations is the cost measure that
+ * matters when comparing tree types or search strategies; timers conflate it
+ * with traversal overhead, and the base case / score counters of the
+ * individual methods miss the evaluations made inside bound computations.
+ *
+ * The counter is shared by all instances that wrap the same metric type, so
+ * the evaluations made by metric copies buried inside tree bounds are counted
+ * too; it is incremented atomically and can be read or reset from anywhere:
+ *
+ * @code
+ * typedef CountingMetric<EuclideanDistance> CountedEuclidean;
+ * CountedEuclidean::ResetCount();
+ *
+ * NeighborSearch<NearestNeighborSort, CountedEuclidean, arma::mat, VPTree>
+ *     knn(referenceSet);
+ * knn.Search(querySet, 3, neighbors, distances);
+ *
+ * Log::Info << CountedEuclidean::Evaluations() << " distance evaluations."
+ *     << std::endl;
+ * @endcode
+ *
+ * Note that Evaluate() is a non-static method even if the wrapped metric has
+ * a static Evaluate(), since metrics with internal state (such as IPMetric)
+ * must be evaluated through an instance.
+ *
+ * @tparam MetricType The metric to wrap and count.
+ */
+template<typename MetricType>
+class CountingMetric
+{
+ public:
+  //! Create the CountingMetric with a default-constructed wrapped metric.
+  CountingMetric() : metric() { }
+
+  //! Create the CountingMetric around an instantiated metric.
+  CountingMetric(MetricType metric) : metric(std::move(metric)) { }
+
+  /**
+   * Evaluate the wrapped metric and count the call.
+   *
+   * @param a First vector.
+   * @param b Second vector.
+   * @return Distance between the two points.
+   */
+  template<typename VecTypeA, typename VecTypeB>
+  typename VecTypeA::elem_type Evaluate(const VecTypeA& a, const VecTypeB& b)
+  {
+    ++evaluations;
+    return metric.Evaluate(a, b);
+  }
+
+  //! Get the wrapped metric.
+  const MetricType& Metric() const { return metric; }
+  //! Modify the wrapped metric.
+  MetricType& Metric() { return metric; }
+
+  //! Get the number of Evaluate() calls made through this metric type.
+  static uint64_t Evaluations() { return evaluations.load(); }
+  //! Reset the evaluation counter to zero.
+  static void ResetCount() { evaluations.store(0); }
+
+  //! Serialize the metric.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(metric));
+  }
+
+ private:
+  //! The metric whose evaluations are counted.
+  MetricType metric;
+
+  //! The number of evaluations, shared by every instance wrapping this
+  //! metric type.  The counter is atomic so parallel traversals can share it.
+  static std::atomic<uint64_t> evaluations;
+};
+
+template<typename MetricType>
+std::atomic<uint64_t> CountingMetric<MetricType>::evaluations(0);
+
+} // namespace metric
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,140 @@
+/**
+ * @file core/metrics/factored_mahalanobis_distance.hpp
+ * @author Ryan Curtin
+ *
+ * The Mahalanobis distance in factored form: stores L with Q = L^T L and
+ * evaluates as a Euclidean distance in the transformed space, with optional
+ * caching of transformed points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_FACTORED_MAHALANOBIS_DISTANCE_HPP
+#define MLPACK_CORE_METRICS_FACTORED_MAHALANOBIS_DISTANCE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "self_value_cache.hpp"
+
+namespace mlpack {
+namespace metric {
+
+/**
+ * The Mahalanobis distance in factored form.  Where MahalanobisDistance
+ * stores the covariance @f$ Q @f$ and multiplies by it on every evaluation,
+ * this class stores a factor @f$ L @f$ with @f$ Q = L^T L @f$ and evaluates
+ *
+ * @f[
+ * d(x, y) = || L x - L y ||_2
+ * @f]
+ *
+ * which is the same distance, but computed as a Euclidean distance in the
+ * transformed space.  That matters for metric learning (LMNN, NCA), where the
+ * optimizer updates @f$ L @f$ directly: the factor can be swapped in without
+ * ever forming @f$ Q @f$, and PrecomputeTransformed() caches @f$ L x @f$ for
+ * every column of a dataset, reducing each evaluation over that dataset from
+ * a matrix-vector product to a d-dimensional vector subtraction.  Setting a
+ * new factor with Factor() invalidates the cache.
+ *
+ * To build from a covariance matrix instead of a factor, use
+ * FromCovariance(), which takes the Cholesky factorization.  An empty factor
+ * (the default) is treated as the identity.
+ *
+ * Like MahalanobisDistance, the TakeRoot template parameter may be set to
+ * false to skip the square root, with the usual caveat that the result then
+ * does not satisfy the triangle inequality.
+ *
+ * @tparam TTakeRoot If true, takes the root of the output.
+ */
+template<bool TTakeRoot = true>
+class FactoredMahalanobisDistance
+{
+ public:
+  /**
+   * Initialize with an empty factor, which is treated as the identity (so the
+   * distance is Euclidean until a factor is set).
+   */
+  FactoredMahalanobisDistance() { }
+
+  /**
+   * Initialize with the given factor L, so that the effective covariance is
+   * Q = L^T L.  L need not be square: a low-rank (r x d) factor projects
+   * into an r-dimensional space.
+   *
+   * @param l Factor matrix L.
+   */
+  FactoredMahalanobisDistance(arma::mat l) : l(std::move(l)) { }
+
+  /**
+   * Create a FactoredMahalanobisDistance from a covariance matrix, taking its
+   * Cholesky factorization.  Throws std::runtime_error if the covariance is
+   * not positive definite.
+   *
+   * @param covariance Covariance matrix Q.
+   */
+  static FactoredMahalanobisDistance FromCovariance(
+      const arma::mat& covariance);
+
+  /**
+   * Evaluate the distance between the two given points.  When the points are
+   * columns of a dataset passed to PrecomputeTransformed(), their transformed
+   * versions come from the cache and no matrix-vector product is needed.
+   *
+   * @param a First vector.
+   * @param b Second vector.
+   */
+  template<typename VecTypeA, typename VecTypeB>
+  double Evaluate(const VecTypeA& a, const VecTypeB& b) const;
+
+  /**
+   * Precompute and cache L x for every column of the given dataset.  Both the
+   * reference and the query set may be cached.  The cache is invalidated when
+   * a new factor is set, and must be cleared with ClearTransformed() if the
+   * dataset itself is moved or modified.
+   *
+   * @param dataset Dataset whose columns will be cached.
+   */
+  template<typename MatType>
+  void PrecomputeTransformed(const MatType& dataset);
+
+  //! Drop all cached transformed points.
+  void ClearTransformed() { transformedPoints.Clear(); }
+
+  //! Access the factor matrix L.
+  const arma::mat& Factor() const { return l; }
+
+  /**
+   * Set a new factor matrix L (e.g. after an optimizer step), invalidating
+   * any cached transformed points.
+   *
+   * @param newFactor New factor matrix.
+   */
+  void Factor(arma::mat newFactor)
+  {
+    l = std::move(newFactor);
+    transformedPoints.Clear();
+  }
+
+  //! Serialize the distance (the cache is not serialized; recompute after
+  //! loading if desired).
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+  //! Whether or not the root is taken.
+  static const bool TakeRoot = TTakeRoot;
+
+ private:
+  //! The factor matrix L, with effective covariance Q = L^T L.
+  arma::mat l;
+  //! Cached transformed points L x, keyed by point memory address.
+  details::SelfValueCache<arma::vec> transformedPoints;
+};
+
+} // namespace metric
+} // namespace mlpack
+
+#include "factored_mahalanobis_distance_impl.hpp"
+
+#endif
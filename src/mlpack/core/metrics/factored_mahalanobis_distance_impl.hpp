@@ -0,0 +1,103 @@
+/**
+ * @file core/metrics/factored_mahalanobis_distance_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the factored Mahalanobis distance.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_FACTORED_MAHALANOBIS_DISTANCE_IMPL_HPP
+#define MLPACK_CORE_METRICS_FACTORED_MAHALANOBIS_DISTANCE_IMPL_HPP
+
+#include "factored_mahalanobis_distance.hpp"
+
+namespace mlpack {
+namespace metric {
+
+template<bool TakeRoot>
+FactoredMahalanobisDistance<TakeRoot>
+FactoredMahalanobisDistance<TakeRoot>::FromCovariance(
+    const arma::mat& covariance)
+{
+  // arma::chol() gives upper-triangular R with Q = R^T R, which is exactly
+  // the factor we store.
+  arma::mat r;
+  if (!arma::chol(r, covariance))
+  {
+    throw std::runtime_error("FactoredMahalanobisDistance::FromCovariance(): "
+        "covariance matrix is not positive definite!");
+  }
+
+  return FactoredMahalanobisDistance(std::move(r));
+}
+
+template<bool TakeRoot>
+template<typename VecTypeA, typename VecTypeB>
+double FactoredMahalanobisDistance<TakeRoot>::Evaluate(
+    const VecTypeA& a,
+    const VecTypeB& b) const
+{
+  // An empty factor is the identity: plain (squared) Euclidean distance.
+  double sum;
+  if (l.n_elem == 0)
+  {
+    sum = arma::accu(arma::square(a - b));
+  }
+  else
+  {
+    // The transformed points come from the cache when the points are columns
+    // of a precomputed dataset (see PrecomputeTransformed()).
+    arma::vec la, lb;
+    if (!transformedPoints.Lookup(a, la))
+      la = l * a;
+    if (!transformedPoints.Lookup(b, lb))
+      lb = l * b;
+
+    sum = arma::accu(arma::square(la - lb));
+  }
+
+  if (!TakeRoot) // The compiler should optimize this correctly at compile-time.
+    return sum;
+
+  return std::sqrt(sum);
+}
+
+template<bool TakeRoot>
+template<typename MatType>
+void FactoredMahalanobisDistance<TakeRoot>::PrecomputeTransformed(
+    const MatType& dataset)
+{
+  // Transform the whole dataset in one matrix-matrix product, then cache the
+  // columns.
+  const arma::mat transformed = (l.n_elem == 0) ?
+      arma::mat(dataset) : arma::mat(l * dataset);
+
+  transformedPoints.Reserve(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    transformedPoints.Insert((const void*) dataset.colptr(i),
+        arma::vec(transformed.col(i)));
+  }
+}
+
+// Serialize the factored Mahalanobis distance.
+template<bool TakeRoot>
+template<typename Archive>
+void FactoredMahalanobisDistance<TakeRoot>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(l));
+
+  // Cached transformed points refer to memory from before the load.
+  if (cereal::is_loading<Archive>())
+    transformedPoints.Clear();
+}
+
+} // namespace metric
+} // namespace mlpack
+
+#endif
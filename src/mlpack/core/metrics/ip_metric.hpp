@@ -13,6 +13,8 @@
 #ifndef MLPACK_METHODS_FASTMKS_IP_METRIC_HPP
 #define MLPACK_METHODS_FASTMKS_IP_METRIC_HPP
 
+#include "self_value_cache.hpp"
+
 namespace mlpack {
 namespace metric {
 
@@ -59,6 +61,23 @@ class IPMetric
   template<typename VecTypeA, typename VecTypeB>
   typename VecTypeA::elem_type Evaluate(const VecTypeA& a, const VecTypeB& b);
 
+  /**
+   * Precompute and cache the self-kernels K(x, x) of every column of the
+   * given dataset.  Afterwards, any Evaluate() call whose arguments are
+   * columns of that dataset recovers both self-kernels from the cache, so
+   * each evaluation costs a single kernel evaluation instead of three.  Call
+   * this once per dataset (both the reference and the query set may be
+   * cached); the cache must be cleared with ClearSelfKernels() if the dataset
+   * is moved or modified.
+   *
+   * @param dataset Dataset whose columns will be cached.
+   */
+  template<typename MatType>
+  void PrecomputeSelfKernels(const MatType& dataset);
+
+  //! Drop all cached self-kernels.
+  void ClearSelfKernels() { selfKernels.Clear(); }
+
   //! Get the kernel.
   const KernelType& Kernel() const { return *kernel; }
   //! Modify the kernel.
@@ -73,6 +92,9 @@ class IPMetric
   KernelType* kernel;
   //! If true, we are responsible for deleting the kernel.
   bool kernelOwner;
+  //! Cached self-kernels of dataset columns (see PrecomputeSelfKernels()).
+  //! Not serialized; recompute after loading if desired.
+  details::SelfValueCache<double> selfKernels;
 };
 
 } // namespace metric
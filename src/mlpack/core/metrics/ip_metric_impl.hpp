@@ -50,7 +50,8 @@ IPMetric<KernelType>::~IPMetric()
 template<typename KernelType>
 IPMetric<KernelType>::IPMetric(const IPMetric& other) :
   kernel(new KernelType(*other.kernel)),
-  kernelOwner(true)
+  kernelOwner(true),
+  selfKernels(other.selfKernels)
 {
   // Nothing to do.
 }
@@ -66,6 +67,7 @@ IPMetric<KernelType>& IPMetric<KernelType>::operator=(const IPMetric& other)
 
   kernel = new KernelType(*other.kernel);
   kernelOwner = true;
+  selfKernels = other.selfKernels;
   return *this;
 }
 
@@ -75,10 +77,29 @@ inline typename Vec1Type::elem_type IPMetric<KernelType>::Evaluate(
     const Vec1Type& a,
     const Vec2Type& b)
 {
-  // This is the metric induced by the kernel function.
-  // Maybe we can do better by caching some of this?
-  return sqrt(kernel->Evaluate(a, a) + kernel->Evaluate(b, b) -
-      2 * kernel->Evaluate(a, b));
+  // This is the metric induced by the kernel function.  The self-kernels come
+  // from the cache when the points are columns of a precomputed dataset (see
+  // PrecomputeSelfKernels()), reducing each evaluation to a single kernel
+  // evaluation.
+  double aa, bb;
+  if (!selfKernels.Lookup(a, aa))
+    aa = kernel->Evaluate(a, a);
+  if (!selfKernels.Lookup(b, bb))
+    bb = kernel->Evaluate(b, b);
+
+  return sqrt(aa + bb - 2 * kernel->Evaluate(a, b));
+}
+
+template<typename KernelType>
+template<typename MatType>
+void IPMetric<KernelType>::PrecomputeSelfKernels(const MatType& dataset)
+{
+  selfKernels.Reserve(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    selfKernels.Insert((const void*) dataset.colptr(i),
+        (double) kernel->Evaluate(dataset.col(i), dataset.col(i)));
+  }
 }
 
 // Serialize the kernel.
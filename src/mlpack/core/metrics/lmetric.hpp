@@ -83,6 +83,33 @@ class LMetric
   static typename VecTypeA::elem_type Evaluate(const VecTypeA& a,
                                                const VecTypeB& b);
 
+  /**
+   * Computes the distance between two points with early abandoning: the
+   * partial sums are accumulated a block of dimensions at a time, and as soon
+   * as a partial sum already guarantees that the distance exceeds the given
+   * bound, the remaining dimensions are skipped.
+   *
+   * If the distance is at most the bound, the exact distance is returned;
+   * otherwise the returned value is only a lower bound on the distance (but
+   * is itself guaranteed to exceed the given bound).  Callers that discard
+   * any result worse than the bound---such as nearest neighbor search, where
+   * the bound is the current k'th best distance---can therefore use this in
+   * place of Evaluate() without changing their results.
+   *
+   * @tparam VecTypeA Type of first vector (generally arma::vec or
+   *      arma::sp_vec).
+   * @tparam VecTypeB Type of second vector.
+   * @param a First vector.
+   * @param b Second vector.
+   * @param bound Distance above which the evaluation may be abandoned.
+   * @return Distance between vectors a and b, exact if within the bound.
+   */
+  template<typename VecTypeA, typename VecTypeB>
+  static typename VecTypeA::elem_type Evaluate(
+      const VecTypeA& a,
+      const VecTypeB& b,
+      const typename VecTypeA::elem_type bound);
+
   //! Serialize the metric (nothing to do).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
@@ -116,6 +143,75 @@ typedef LMetric<2, true> EuclideanDistance;
  */
 typedef LMetric<INT_MAX, false> ChebyshevDistance;
 
+/**
+ * The L_p metric for points of a dimensionality that is known at compile
+ * time.  This behaves identically to LMetric, but the dimension is a template
+ * parameter, so Evaluate() is a fixed-trip-count loop that the compiler fully
+ * unrolls into straight-line (and, for Power = 2, FMA-friendly) code.  At
+ * very low dimensionality---d = 2 or 3, as in geospatial data---this removes
+ * the loop and Armadillo expression overhead that dominates LMetric.
+ *
+ * Use it anywhere a MetricType template parameter is accepted, whenever the
+ * dimensionality of the data is fixed and known:
+ *
+ * @code
+ * NeighborSearch<NearestNeighborSort, Euclidean2DDistance> knn(dataset);
+ * @endcode
+ *
+ * In debug mode, Evaluate() asserts that the points actually have the
+ * compile-time dimensionality.
+ *
+ * @tparam Dimension Dimensionality of the points, known at compile time.
+ * @tparam TPower Power of metric; i.e. TPower = 1 gives the L1-norm
+ *    (Manhattan distance).
+ * @tparam TTakeRoot If true, the TPower'th root of the result is taken before
+ *    it is returned.  Setting this to false causes the metric to not satisfy
+ *    the Triangle Inequality (be careful!).
+ */
+template<size_t Dimension, int TPower, bool TTakeRoot = true>
+class FixedDimLMetric
+{
+ public:
+  /**
+   * Default constructor does nothing, but is required to satisfy the Metric
+   * policy.
+   */
+  FixedDimLMetric() { }
+
+  /**
+   * Computes the distance between two points of dimensionality Dimension.
+   *
+   * @tparam VecTypeA Type of first vector (generally arma::vec).
+   * @tparam VecTypeB Type of second vector.
+   * @param a First vector.
+   * @param b Second vector.
+   * @return Distance between vectors a and b.
+   */
+  template<typename VecTypeA, typename VecTypeB>
+  static typename VecTypeA::elem_type Evaluate(const VecTypeA& a,
+                                               const VecTypeB& b);
+
+  //! Serialize the metric (nothing to do).
+  template<typename Archive>
+  void serialize(Archive& /* ar */, const uint32_t /* version */) { }
+
+  //! The power of the metric.
+  static const int Power = TPower;
+  //! Whether or not the root is taken.
+  static const bool TakeRoot = TTakeRoot;
+};
+
+// Convenience typedefs for the common geospatial cases.
+
+/**
+ * The Euclidean (L2) distance for 2-dimensional points.
+ */
+typedef FixedDimLMetric<2, 2, true> Euclidean2DDistance;
+
+/**
+ * The Euclidean (L2) distance for 3-dimensional points.
+ */
+typedef FixedDimLMetric<3, 2, true> Euclidean3DDistance;
 
 } // namespace metric
 } // namespace mlpack
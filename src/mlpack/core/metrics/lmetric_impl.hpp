@@ -15,6 +15,8 @@
 // In case it hasn't been included.
 #include "lmetric.hpp"
 
+#include <mlpack/core/math/simd_kernels.hpp>
+
 namespace mlpack {
 namespace metric {
 
@@ -35,6 +37,75 @@ typename VecTypeA::elem_type LMetric<Power, TakeRoot>::Evaluate(
   return std::pow(sum, (1.0 / Power));
 }
 
+// Early-abandoning implementation.  This is shared by all powers; the
+// per-power branches below resolve at compile time.
+template<int Power, bool TakeRoot>
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type LMetric<Power, TakeRoot>::Evaluate(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename VecTypeA::elem_type bound)
+{
+  typedef typename VecTypeA::elem_type ElemType;
+
+  // The accumulation happens before the root is taken, so move the bound into
+  // that domain too.  The L-infinity metric accumulates with max() and never
+  // takes a root.
+  ElemType boundPower;
+  if (Power == INT_MAX || !TakeRoot)
+    boundPower = bound;
+  else if (Power == 2)
+    boundPower = bound * bound;
+  else
+    boundPower = std::pow(bound, (ElemType) Power);
+
+  // Checking the bound after every dimension would cost more than it saves;
+  // instead accumulate a block of dimensions at a time (small enough to
+  // abandon early, large enough that the inner loop still vectorizes).
+  const size_t blockSize = 32;
+
+  ElemType sum = 0;
+  size_t i = 0;
+  while (i < a.n_elem)
+  {
+    const size_t blockEnd = std::min((size_t) a.n_elem, i + blockSize);
+    for (; i < blockEnd; ++i)
+    {
+      // These branches resolve at compile time.
+      if (Power == 1)
+      {
+        sum += fabs(a[i] - b[i]);
+      }
+      else if (Power == 2)
+      {
+        const ElemType d = a[i] - b[i];
+        sum += d * d;
+      }
+      else if (Power == INT_MAX)
+      {
+        sum = std::max(sum, (ElemType) fabs(a[i] - b[i]));
+      }
+      else
+      {
+        sum += std::pow(fabs(a[i] - b[i]), Power);
+      }
+    }
+
+    // The partial sum can only grow, so once it exceeds the bound the full
+    // distance must too; stop and return the partial result, which is a lower
+    // bound on the true distance.
+    if (sum > boundPower)
+      break;
+  }
+
+  if (Power == INT_MAX || !TakeRoot)
+    return sum;
+  else if (Power == 2)
+    return std::sqrt(sum);
+
+  return std::pow(sum, (ElemType) (1.0 / Power));
+}
+
 // L1-metric specializations; the root doesn't matter.
 template<>
 template<typename VecTypeA, typename VecTypeB>
@@ -61,7 +132,9 @@ typename VecTypeA::elem_type LMetric<2, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::norm(a - b, 2);
+  // The kernel is used when both vectors are contiguous floating-point
+  // vectors; other argument types fall back to an Armadillo expression.
+  return std::sqrt(math::simd::SquaredDistance(a, b));
 }
 
 template<>
@@ -70,7 +143,9 @@ typename VecTypeA::elem_type LMetric<2, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return accu(arma::square(a - b));
+  // The kernel is used when both vectors are contiguous floating-point
+  // vectors; other argument types fall back to an Armadillo expression.
+  return math::simd::SquaredDistance(a, b);
 }
 
 // L3-metric specialization (not very likely to be used, but just in case).
@@ -106,6 +181,50 @@ typename VecTypeA::elem_type LMetric<INT_MAX, false>::Evaluate(
   return arma::as_scalar(arma::max(arma::abs(a - b)));
 }
 
+// Fixed-dimensionality implementation.  The trip count is a compile-time
+// constant, so the compiler fully unrolls the loop; for Power = 2 the body is
+// a chain of fused multiply-adds with no calls or branches.
+template<size_t Dimension, int Power, bool TakeRoot>
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type FixedDimLMetric<Dimension, Power, TakeRoot>::
+Evaluate(const VecTypeA& a, const VecTypeB& b)
+{
+  typedef typename VecTypeA::elem_type ElemType;
+
+  Log::Assert(a.n_elem == Dimension && b.n_elem == Dimension,
+      "FixedDimLMetric::Evaluate(): point dimensionality does not match the "
+      "compile-time dimension!");
+
+  ElemType sum = 0;
+  for (size_t i = 0; i < Dimension; ++i)
+  {
+    // These branches resolve at compile time.
+    if (Power == 1)
+    {
+      sum += std::abs(a[i] - b[i]);
+    }
+    else if (Power == 2)
+    {
+      const ElemType d = a[i] - b[i];
+      sum += d * d;
+    }
+    else
+    {
+      sum += std::pow(std::abs(a[i] - b[i]), Power);
+    }
+  }
+
+  if (!TakeRoot) // The compiler should optimize this correctly at compile-time.
+    return sum;
+
+  if (Power == 1)
+    return sum;
+  else if (Power == 2)
+    return std::sqrt(sum);
+
+  return std::pow(sum, 1.0 / Power);
+}
+
 } // namespace metric
 } // namespace mlpack
 
@@ -0,0 +1,112 @@
+/**
+ * @file core/metrics/self_value_cache.hpp
+ * @author Ryan Curtin
+ *
+ * A per-point cache of precomputed values (self-kernels, norms) for metrics,
+ * keyed by the memory address of the point.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_SELF_VALUE_CACHE_HPP
+#define MLPACK_CORE_METRICS_SELF_VALUE_CACHE_HPP
+
+#include <unordered_map>
+
+namespace mlpack {
+namespace metric {
+namespace details {
+
+//! Get the memory pointer of a vector with contiguous storage (arma::Col and
+//! friends).
+template<typename VecType>
+inline auto VecMemPtr(const VecType& v, int) -> decltype(v.memptr())
+{
+  return v.memptr();
+}
+
+//! Get the memory pointer of a column subview (what `dataset.col(i)` yields).
+template<typename VecType>
+inline auto VecMemPtr(const VecType& v, long) -> decltype(v.colptr(0))
+{
+  return v.colptr(0);
+}
+
+//! Fallback for expression types with no stable memory: no pointer, so no
+//! cache lookup is possible and the value is computed directly.
+template<typename VecType>
+inline const typename VecType::elem_type* VecMemPtr(const VecType& /* v */,
+                                                    ...)
+{
+  return NULL;
+}
+
+/**
+ * A cache of one precomputed value per point, keyed by the address of the
+ * point's memory.  Metrics whose Evaluate() receives columns of a dataset
+ * (which is how the trees and searches call them) can precompute a per-point
+ * quantity---the self-kernel K(x, x), or 1 / || x ||---once per dataset, and
+ * then recover it in Evaluate() from the column pointer alone, without any
+ * change to the Evaluate() signature.
+ *
+ * Points passed as expressions (no stable memory) simply miss the cache and
+ * are computed directly, so caching is always optional and never changes
+ * results.
+ *
+ * @tparam ValueType Type of the cached values.
+ */
+template<typename ValueType>
+class SelfValueCache
+{
+ public:
+  /**
+   * Look up the cached value of the given point.  Returns false (leaving
+   * `value` untouched) if the point has no stable memory or is not in the
+   * cache.
+   */
+  template<typename VecType>
+  bool Lookup(const VecType& point, ValueType& value) const
+  {
+    if (values.empty())
+      return false;
+
+    const void* ptr = (const void*) VecMemPtr(point, 0);
+    if (ptr == NULL)
+      return false;
+
+    const auto it = values.find(ptr);
+    if (it == values.end())
+      return false;
+
+    value = it->second;
+    return true;
+  }
+
+  /**
+   * Cache the value of the point at the given memory address.  Previously
+   * cached values are kept, so caches over both a reference and a query set
+   * can coexist; inserting for an already-cached address overwrites it.
+   */
+  void Insert(const void* ptr, const ValueType value) { values[ptr] = value; }
+
+  //! Reserve room for this many additional cached values.
+  void Reserve(const size_t count) { values.reserve(values.size() + count); }
+
+  //! Drop all cached values (e.g. because the underlying data moved).
+  void Clear() { values.clear(); }
+
+  //! Get the number of cached values.
+  size_t Size() const { return values.size(); }
+
+ private:
+  //! The cached values, keyed by point memory address.
+  std::unordered_map<const void*, ValueType> values;
+};
+
+} // namespace details
+} // namespace metric
+} // namespace mlpack
+
+#endif // MLPACK_CORE_METRICS_SELF_VALUE_CACHE_HPP
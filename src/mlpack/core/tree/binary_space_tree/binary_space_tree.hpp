@@ -12,13 +12,19 @@
 #define MLPACK_CORE_TREE_BINARY_SPACE_TREE_BINARY_SPACE_TREE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/z_order.hpp>
 
+#include "../node_pool.hpp"
 #include "../statistic.hpp"
 #include "midpoint_split.hpp"
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
 
+// Forward declaration, for the friend declaration below.
+template<typename TreeType>
+class FlatTreeIO;
+
 /**
  * A binary space partitioning tree, such as a KD-tree or a ball tree.  Once the
  * bound and type of dataset is defined, the tree will construct itself.  Call
@@ -148,6 +154,45 @@ class BinarySpaceTree
                   std::vector<size_t>& newFromOld,
                   const size_t maxLeafSize = 20);
 
+  /**
+   * Construct this as the root node of a binary space tree using the given
+   * dataset, presorting the points along the Morton (Z-order) curve before
+   * splitting.  The presort makes the build and later leaf scans access
+   * memory in a cache-coherent order; the structure of the tree itself does
+   * not depend on the initial point order, so search results are unaffected.
+   * The oldFromNew mapping accounts for the presort as well as the
+   * rearrangement done by splitting.  This will copy the input matrix; if you
+   * don't want this, consider using the constructor that takes an rvalue
+   * reference and use std::move().
+   *
+   * @param data Dataset to create tree from.  This will be copied!
+   * @param oldFromNew Vector which will be filled with the old positions for
+   *     each new point.
+   * @param presort Tag to select Z-order presorting (math::ZOrderPresort()).
+   * @param maxLeafSize Size of each leaf in the tree.
+   */
+  BinarySpaceTree(const MatType& data,
+                  std::vector<size_t>& oldFromNew,
+                  const math::ZOrderPresort presort,
+                  const size_t maxLeafSize = 20);
+
+  /**
+   * Construct this as the root node of a binary space tree using the given
+   * dataset, presorting the points along the Morton (Z-order) curve before
+   * splitting (see the copying overload for details).  This will take
+   * ownership of the data matrix.
+   *
+   * @param data Dataset to create tree from.
+   * @param oldFromNew Vector which will be filled with the old positions for
+   *     each new point.
+   * @param presort Tag to select Z-order presorting (math::ZOrderPresort()).
+   * @param maxLeafSize Size of each leaf in the tree.
+   */
+  BinarySpaceTree(MatType&& data,
+                  std::vector<size_t>& oldFromNew,
+                  const math::ZOrderPresort presort,
+                  const size_t maxLeafSize = 20);
+
   /**
    * Construct this as the root node of a binary space tree using the given
    * dataset.  This will take ownership of the data matrix; if you don't want
@@ -315,6 +360,24 @@ class BinarySpaceTree
    */
   ~BinarySpaceTree();
 
+  //! Nodes are allocated from a pooled allocator so that siblings built
+  //! together end up adjacent in memory; see node_pool.hpp.
+  void* operator new(const size_t size)
+  {
+    if (size == sizeof(BinarySpaceTree))
+      return NodePool<sizeof(BinarySpaceTree)>::Allocate();
+    return ::operator new(size);
+  }
+
+  //! Return a node's memory to the pool.
+  void operator delete(void* memory, const size_t size)
+  {
+    if (size == sizeof(BinarySpaceTree))
+      NodePool<sizeof(BinarySpaceTree)>::Deallocate(memory);
+    else
+      ::operator delete(memory);
+  }
+
   //! Return the bound object for this node.
   const BoundType<MetricType>& Bound() const { return bound; }
   //! Return the bound object for this node.
@@ -558,6 +621,11 @@ class BinarySpaceTree
   //! Friend access is given for the default constructor.
   friend class cereal::access;
 
+  //! Friend access is also given to the flat on-disk format (see
+  //! flat_tree_io.hpp), which rebuilds nodes the same way cereal does.
+  template<typename TreeType>
+  friend class FlatTreeIO;
+
  public:
   /**
    * Serialize the tree.
@@ -575,4 +643,15 @@ class BinarySpaceTree
 // Include everything else, if necessary.
 #include "../binary_space_tree.hpp"
 
+// The most common configurations are compiled once into libmlpack (see
+// core/tree/tree_instantiations.cpp), so client translation units can skip
+// instantiating them.  Define MLPACK_NO_EXTERN_TREE_TEMPLATES to disable this
+// (e.g. when using the headers without linking against libmlpack).
+#ifndef MLPACK_NO_EXTERN_TREE_TEMPLATES
+extern template class
+    mlpack::tree::BinarySpaceTree<mlpack::metric::EuclideanDistance>;
+extern template class
+    mlpack::tree::BinarySpaceTree<mlpack::metric::ManhattanDistance>;
+#endif
+
 #endif
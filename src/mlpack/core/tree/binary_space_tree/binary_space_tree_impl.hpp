@@ -41,8 +41,11 @@ BinarySpaceTree(
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
     dataset(new MatType(data)) // Copies the dataset.
 {
-  // Do the actual splitting of this node.
+  // Do the actual splitting of this node.  The OpenMP region allows large
+  // subtrees to be built as parallel tasks; see SplitNode().
   SplitType<BoundType<MetricType>, MatType> splitter;
+  #pragma omp parallel
+  #pragma omp single
   SplitNode(maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -74,8 +77,11 @@ BinarySpaceTree(
   for (size_t i = 0; i < data.n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
+  // Now do the actual splitting.  The OpenMP region allows large subtrees to
+  // be built as parallel tasks; see SplitNode().
   SplitType<BoundType<MetricType>, MatType> splitter;
+  #pragma omp parallel
+  #pragma omp single
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -108,8 +114,11 @@ BinarySpaceTree(
   for (size_t i = 0; i < data.n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
+  // Now do the actual splitting.  The OpenMP region allows large subtrees to
+  // be built as parallel tasks; see SplitNode().
   SplitType<BoundType<MetricType>, MatType> splitter;
+  #pragma omp parallel
+  #pragma omp single
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -121,6 +130,82 @@ BinarySpaceTree(
     newFromOld[oldFromNew[i]] = i;
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BinarySpaceTree(
+    const MatType& data,
+    std::vector<size_t>& oldFromNew,
+    const math::ZOrderPresort /* presort */,
+    const size_t maxLeafSize) :
+    left(NULL),
+    right(NULL),
+    parent(NULL),
+    begin(0),
+    count(data.n_cols),
+    bound(data.n_rows),
+    parentDistance(0), // Parent distance for the root is 0: it has no parent.
+    dataset(new MatType(data)) // Copies the dataset.
+{
+  // Reorder the copied dataset along the Z-order curve.  Initializing
+  // oldFromNew to the presort permutation (instead of the identity) composes
+  // it with the rearrangement done by the splits below, since SplitNode()
+  // swaps mapping entries whenever it swaps columns.
+  math::ZOrderPoints(*dataset, oldFromNew);
+
+  // Now do the actual splitting.  The OpenMP region allows large subtrees to
+  // be built as parallel tasks; see SplitNode().
+  SplitType<BoundType<MetricType>, MatType> splitter;
+  #pragma omp parallel
+  #pragma omp single
+  SplitNode(oldFromNew, maxLeafSize, splitter);
+
+  // Create the statistic depending on if we are a leaf or not.
+  stat = StatisticType(*this);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BinarySpaceTree(
+    MatType&& data,
+    std::vector<size_t>& oldFromNew,
+    const math::ZOrderPresort /* presort */,
+    const size_t maxLeafSize) :
+    left(NULL),
+    right(NULL),
+    parent(NULL),
+    begin(0),
+    count(data.n_cols),
+    bound(data.n_rows),
+    parentDistance(0), // Parent distance for the root is 0: it has no parent.
+    dataset(new MatType(std::move(data)))
+{
+  // Reorder the dataset along the Z-order curve.  Initializing oldFromNew to
+  // the presort permutation (instead of the identity) composes it with the
+  // rearrangement done by the splits below, since SplitNode() swaps mapping
+  // entries whenever it swaps columns.
+  math::ZOrderPoints(*dataset, oldFromNew);
+
+  // Now do the actual splitting.  The OpenMP region allows large subtrees to
+  // be built as parallel tasks; see SplitNode().
+  SplitType<BoundType<MetricType>, MatType> splitter;
+  #pragma omp parallel
+  #pragma omp single
+  SplitNode(oldFromNew, maxLeafSize, splitter);
+
+  // Create the statistic depending on if we are a leaf or not.
+  stat = StatisticType(*this);
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -138,8 +223,11 @@ BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
     dataset(new MatType(std::move(data)))
 {
-  // Do the actual splitting of this node.
+  // Do the actual splitting of this node.  The OpenMP region allows large
+  // subtrees to be built as parallel tasks; see SplitNode().
   SplitType<BoundType<MetricType>, MatType> splitter;
+  #pragma omp parallel
+  #pragma omp single
   SplitNode(maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -171,8 +259,11 @@ BinarySpaceTree(
   for (size_t i = 0; i < dataset->n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
+  // Now do the actual splitting.  The OpenMP region allows large subtrees to
+  // be built as parallel tasks; see SplitNode().
   SplitType<BoundType<MetricType>, MatType> splitter;
+  #pragma omp parallel
+  #pragma omp single
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -205,8 +296,11 @@ BinarySpaceTree(
   for (size_t i = 0; i < dataset->n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
+  // Now do the actual splitting.  The OpenMP region allows large subtrees to
+  // be built as parallel tasks; see SplitNode().
   SplitType<BoundType<MetricType>, MatType> splitter;
+  #pragma omp parallel
+  #pragma omp single
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -903,11 +997,17 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
   assert(splitCol < begin + count);
 
   // Now that we know the split column, we will recursively split the children
-  // by calling their constructors (which perform this splitting process).
+  // by calling their constructors (which perform this splitting process).  The
+  // two subtrees cover disjoint column ranges of the dataset, so if the node
+  // is large enough, each subtree is built as its own OpenMP task; small nodes
+  // are built serially to avoid task scheduling overhead.
+  #pragma omp task default(shared) if (count > 8192)
   left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
       maxLeafSize);
+  #pragma omp task default(shared) if (count > 8192)
   right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
       splitter, maxLeafSize);
+  #pragma omp taskwait
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -971,11 +1071,18 @@ SplitNode(std::vector<size_t>& oldFromNew,
   assert(splitCol < begin + count);
 
   // Now that we know the split column, we will recursively split the children
-  // by calling their constructors (which perform this splitting process).
+  // by calling their constructors (which perform this splitting process).  The
+  // two subtrees cover disjoint column ranges of the dataset (and disjoint
+  // entries of oldFromNew), so if the node is large enough, each subtree is
+  // built as its own OpenMP task; small nodes are built serially to avoid task
+  // scheduling overhead.
+  #pragma omp task default(shared) if (count > 8192)
   left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
       splitter, maxLeafSize);
+  #pragma omp task default(shared) if (count > 8192)
   right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
       oldFromNew, splitter, maxLeafSize);
+  #pragma omp taskwait
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -45,7 +45,9 @@ class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
 {
  public:
   /**
-   * Instantiate the dual-tree traverser with the given rule set.
+   * Instantiate the dual-tree traverser with the given rule set.  The
+   * frontier is unbounded by default; use FrontierCap() to bound the size of
+   * the priority queues that hold pending node combinations.
    */
   BreadthFirstDualTreeTraverser(RuleType& rule);
 
@@ -83,10 +85,34 @@ class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
   //! Modify the number of times a base case was calculated.
   size_t& NumBaseCases() { return numBaseCases; }
 
+  //! Get the maximum number of frames a frontier queue may hold (0 means
+  //! unbounded).
+  size_t FrontierCap() const { return frontierCap; }
+  //! Modify the maximum number of frames a frontier queue may hold.  When a
+  //! queue is full, further node combinations are finished depth-first
+  //! instead of being enqueued, which bounds the memory used by the
+  //! traversal without changing the results.
+  size_t& FrontierCap() { return frontierCap; }
+
  private:
+  /**
+   * Push the given frame onto the given queue, unless the queue has already
+   * reached the frontier cap; in that case, finish the node combination with
+   * a depth-first traversal instead.
+   *
+   * @param queue Frontier queue the frame belongs to.
+   * @param frame Node combination to be processed.
+   */
+  void PushOrTraverse(std::priority_queue<QueueFrameType>& queue,
+                      QueueFrameType& frame);
+
   //! Reference to the rules with which the trees will be traversed.
   RuleType& rule;
 
+  //! The maximum number of frames a frontier queue may hold (0 means
+  //! unbounded).
+  size_t frontierCap;
+
   //! The number of prunes.
   size_t numPrunes;
 
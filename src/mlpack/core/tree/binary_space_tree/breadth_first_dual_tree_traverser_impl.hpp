@@ -31,6 +31,7 @@ BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 BreadthFirstDualTreeTraverser<RuleType>::BreadthFirstDualTreeTraverser(
     RuleType& rule) :
     rule(rule),
+    frontierCap(0),
     numPrunes(0),
     numVisited(0),
     numScores(0),
@@ -134,14 +135,6 @@ BreadthFirstDualTreeTraverser<RuleType>::Traverse(
       const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
       for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
       {
-        // See if we need to investigate this point (this function should be
-        // implemented for the single-tree recursion too).  Restore the
-        // traversal information first.
-//        const double childScore = rule.Score(query, referenceNode);
-
-//        if (childScore == DBL_MAX)
-//          continue; // We can't improve this particular point.
-
         for (size_t ref = referenceNode.Begin(); ref < refEnd; ++ref)
           rule.BaseCase(query, ref);
 
@@ -153,11 +146,11 @@ BreadthFirstDualTreeTraverser<RuleType>::Traverse(
       // We have to recurse down the query node.
       QueueFrameType fl = { queryNode.Left(), &referenceNode, queryDepth + 1,
           score, rule.TraversalInfo() };
-      leftChildQueue.push(fl);
+      PushOrTraverse(leftChildQueue, fl);
 
       QueueFrameType fr = { queryNode.Right(), &referenceNode, queryDepth + 1,
           score, ti };
-      rightChildQueue.push(fr);
+      PushOrTraverse(rightChildQueue, fr);
     }
     else if (queryNode.IsLeaf() && (!referenceNode.IsLeaf()))
     {
@@ -166,11 +159,11 @@ BreadthFirstDualTreeTraverser<RuleType>::Traverse(
       // traversal information correctly.
       QueueFrameType fl = { &queryNode, referenceNode.Left(), queryDepth,
           score, rule.TraversalInfo() };
-      referenceQueue.push(fl);
+      PushOrTraverse(referenceQueue, fl);
 
       QueueFrameType fr = { &queryNode, referenceNode.Right(), queryDepth,
           score, ti };
-      referenceQueue.push(fr);
+      PushOrTraverse(referenceQueue, fr);
     }
     else
     {
@@ -178,21 +171,21 @@ BreadthFirstDualTreeTraverser<RuleType>::Traverse(
       // query descent order does not matter, we will go to the left query child
       // first.  Before recursing, we have to set the traversal information
       // correctly.
+      // Build all four frames before any of them is processed; a depth-first
+      // fallback in PushOrTraverse() modifies rule.TraversalInfo().
       QueueFrameType fll = { queryNode.Left(), referenceNode.Left(),
           queryDepth + 1, score, rule.TraversalInfo() };
-      leftChildQueue.push(fll);
-
       QueueFrameType flr = { queryNode.Left(), referenceNode.Right(),
           queryDepth + 1, score, rule.TraversalInfo() };
-      leftChildQueue.push(flr);
-
       QueueFrameType frl = { queryNode.Right(), referenceNode.Left(),
           queryDepth + 1, score, rule.TraversalInfo() };
-      rightChildQueue.push(frl);
-
       QueueFrameType frr = { queryNode.Right(), referenceNode.Right(),
           queryDepth + 1, score, rule.TraversalInfo() };
-      rightChildQueue.push(frr);
+
+      PushOrTraverse(leftChildQueue, fll);
+      PushOrTraverse(leftChildQueue, flr);
+      PushOrTraverse(rightChildQueue, frl);
+      PushOrTraverse(rightChildQueue, frr);
     }
   }
 
@@ -204,6 +197,46 @@ BreadthFirstDualTreeTraverser<RuleType>::Traverse(
     Traverse(*queryNode.Right(), rightChildQueue);
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BreadthFirstDualTreeTraverser<RuleType>::PushOrTraverse(
+    std::priority_queue<QueueFrameType>& queue,
+    QueueFrameType& frame)
+{
+  if ((frontierCap == 0) || (queue.size() < frontierCap))
+  {
+    queue.push(frame);
+    return;
+  }
+
+  // The frontier is full, so finish this node combination depth-first instead
+  // of letting the queue grow.  Restore the traversal information for the
+  // combination, then score it, exactly as if the frame had been popped.
+  rule.TraversalInfo() = frame.traversalInfo;
+  const double score = rule.Score(*frame.queryNode, *frame.referenceNode);
+  ++numScores;
+
+  if (score == DBL_MAX)
+  {
+    ++numPrunes;
+    return;
+  }
+
+  DualTreeTraverser<RuleType> traverser(rule);
+  traverser.Traverse(*frame.queryNode, *frame.referenceNode);
+
+  numPrunes += traverser.NumPrunes();
+  numVisited += traverser.NumVisited();
+  numScores += traverser.NumScores();
+  numBaseCases += traverser.NumBaseCases();
+}
+
 } // namespace tree
 } // namespace mlpack
 
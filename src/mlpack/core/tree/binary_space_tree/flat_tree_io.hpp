@@ -0,0 +1,118 @@
+/**
+ * @file core/tree/binary_space_tree/flat_tree_io.hpp
+ *
+ * Definition of FlatTreeIO, a flat, pointer-free on-disk format for
+ * BinarySpaceTree.  Unlike cereal serialization, which allocates and
+ * deserializes one node at a time, this format stores the dataset and the
+ * per-node state in a handful of contiguous arrays, so a saved tree can be
+ * loaded back with a few bulk reads.  On POSIX systems the dataset portion of
+ * the file can be memory-mapped instead of read, so the (typically dominant)
+ * dataset never has to be copied into the process at all and multiple
+ * processes loading the same file share one physical copy via the page cache.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_TREE_IO_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_TREE_IO_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/range.hpp>
+
+#include <iostream>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * FlatTreeIO provides Save() and Load() for BinarySpaceTree instantiations
+ * whose bound is an HRectBound (kd-trees, mean-split trees and similar).  The
+ * tree is written in preorder as structure-of-arrays: node offsets and counts,
+ * child links as indices, parent and furthest-descendant distances, and the
+ * per-dimension bound ranges.  The dataset is written first as one raw
+ * column-major block.
+ *
+ * Statistics are not stored; each node's statistic is reconstructed with
+ * StatisticType(node) after loading, exactly as a fresh tree build would.
+ *
+ * @tparam TreeType The BinarySpaceTree instantiation to save or load.
+ */
+template<typename TreeType>
+class FlatTreeIO
+{
+ public:
+  //! The matrix type and element type used by the tree.
+  typedef typename TreeType::Mat MatType;
+  typedef typename TreeType::ElemType ElemType;
+
+  /**
+   * Save the given tree (and its dataset) to the given file in the flat
+   * format.  Throws std::runtime_error if the file cannot be written.
+   *
+   * @param tree Tree to save; must be the root of the tree.
+   * @param filename File to write.
+   */
+  static void Save(const TreeType& tree, const std::string& filename);
+
+  /**
+   * Save the given tree (and its dataset) to the given stream, which must be
+   * opened in binary mode.
+   *
+   * @param tree Tree to save; must be the root of the tree.
+   * @param stream Stream to write to.
+   */
+  static void Save(const TreeType& tree, std::ostream& stream);
+
+  /**
+   * Load a tree from a file written by Save().  The caller owns the returned
+   * tree.  If mapDataset is true (the default) and the platform supports it,
+   * the dataset inside the tree will alias a read-only memory mapping of the
+   * file instead of being copied into memory: loading becomes nearly
+   * instantaneous, the pages are shared between all processes that map the
+   * same file, and the mapping stays valid for the lifetime of the process.
+   * The mapped dataset must not be modified.
+   *
+   * Throws std::runtime_error if the file cannot be read or is not a valid
+   * flat tree file for this TreeType.
+   *
+   * @param filename File to read.
+   * @param mapDataset If true, memory-map the dataset instead of copying it.
+   */
+  static TreeType* Load(const std::string& filename,
+                        const bool mapDataset = true);
+
+ private:
+  //! Number the nodes of the tree in preorder and fill the per-node arrays.
+  static void FillArrays(const TreeType& node,
+                         std::vector<arma::u64>& begins,
+                         std::vector<arma::u64>& counts,
+                         std::vector<arma::u64>& lefts,
+                         std::vector<arma::u64>& rights,
+                         std::vector<ElemType>& parentDistances,
+                         std::vector<ElemType>& furthestDistances,
+                         std::vector<ElemType>& boundLos,
+                         std::vector<ElemType>& boundHis);
+
+  //! Rebuild the node with the given index (and its subtree) from the arrays.
+  static TreeType* BuildNode(const size_t index,
+                             TreeType* parent,
+                             const MatType* dataset,
+                             const std::vector<arma::u64>& begins,
+                             const std::vector<arma::u64>& counts,
+                             const std::vector<arma::u64>& lefts,
+                             const std::vector<arma::u64>& rights,
+                             const std::vector<ElemType>& parentDistances,
+                             const std::vector<ElemType>& furthestDistances,
+                             const std::vector<ElemType>& boundLos,
+                             const std::vector<ElemType>& boundHis);
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_tree_io_impl.hpp"
+
+#endif
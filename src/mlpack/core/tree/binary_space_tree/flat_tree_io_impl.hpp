@@ -0,0 +1,300 @@
+/**
+ * @file core/tree/binary_space_tree/flat_tree_io_impl.hpp
+ *
+ * Implementation of FlatTreeIO, the flat, pointer-free on-disk format for
+ * BinarySpaceTree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_TREE_IO_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_TREE_IO_IMPL_HPP
+
+#include "flat_tree_io.hpp"
+
+#include <fstream>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace tree {
+
+namespace flat_tree {
+
+//! Magic bytes identifying a flat tree file.
+const char magic[8] = { 'm', 'l', 'p', 'k', 'f', 'l', 'a', 't' };
+//! Current version of the format.
+const arma::u64 version = 1;
+//! Index value used for a missing child.
+const arma::u64 noChild = (arma::u64) -1;
+
+//! Write a single 64-bit header field.
+inline void WriteU64(std::ostream& stream, const arma::u64 value)
+{
+  stream.write((const char*) &value, sizeof(arma::u64));
+}
+
+//! Read a single 64-bit header field.
+inline arma::u64 ReadU64(std::istream& stream)
+{
+  arma::u64 value = 0;
+  stream.read((char*) &value, sizeof(arma::u64));
+  return value;
+}
+
+} // namespace flat_tree
+
+template<typename TreeType>
+void FlatTreeIO<TreeType>::Save(const TreeType& tree,
+                                const std::string& filename)
+{
+  std::ofstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+    throw std::runtime_error("FlatTreeIO::Save(): cannot open file '" +
+        filename + "' for writing!");
+
+  Save(tree, stream);
+
+  if (!stream.good())
+    throw std::runtime_error("FlatTreeIO::Save(): write to '" + filename +
+        "' failed!");
+}
+
+template<typename TreeType>
+void FlatTreeIO<TreeType>::Save(const TreeType& tree, std::ostream& stream)
+{
+  const MatType& dataset = tree.Dataset();
+
+  // Collect the per-node state into contiguous arrays, numbering the nodes in
+  // preorder.
+  std::vector<arma::u64> begins, counts, lefts, rights;
+  std::vector<ElemType> parentDistances, furthestDistances, boundLos, boundHis;
+  FillArrays(tree, begins, counts, lefts, rights, parentDistances,
+      furthestDistances, boundLos, boundHis);
+
+  // Header: magic, version, element size, dimensionality, points, nodes.
+  stream.write(flat_tree::magic, sizeof(flat_tree::magic));
+  flat_tree::WriteU64(stream, flat_tree::version);
+  flat_tree::WriteU64(stream, (arma::u64) sizeof(ElemType));
+  flat_tree::WriteU64(stream, (arma::u64) dataset.n_rows);
+  flat_tree::WriteU64(stream, (arma::u64) dataset.n_cols);
+  flat_tree::WriteU64(stream, (arma::u64) begins.size());
+
+  // The dataset, as one raw column-major block, padded to an 8-byte boundary
+  // so that the node arrays (and a memory-mapped dataset) stay aligned.
+  const size_t datasetBytes = sizeof(ElemType) * dataset.n_elem;
+  stream.write((const char*) dataset.memptr(), datasetBytes);
+  const char pad[8] = { 0 };
+  if (datasetBytes % 8 != 0)
+    stream.write(pad, 8 - (datasetBytes % 8));
+
+  // The node arrays, each written as one block.
+  const size_t nodes = begins.size();
+  stream.write((const char*) begins.data(), nodes * sizeof(arma::u64));
+  stream.write((const char*) counts.data(), nodes * sizeof(arma::u64));
+  stream.write((const char*) lefts.data(), nodes * sizeof(arma::u64));
+  stream.write((const char*) rights.data(), nodes * sizeof(arma::u64));
+  stream.write((const char*) parentDistances.data(), nodes * sizeof(ElemType));
+  stream.write((const char*) furthestDistances.data(),
+      nodes * sizeof(ElemType));
+  stream.write((const char*) boundLos.data(),
+      nodes * dataset.n_rows * sizeof(ElemType));
+  stream.write((const char*) boundHis.data(),
+      nodes * dataset.n_rows * sizeof(ElemType));
+}
+
+template<typename TreeType>
+void FlatTreeIO<TreeType>::FillArrays(
+    const TreeType& node,
+    std::vector<arma::u64>& begins,
+    std::vector<arma::u64>& counts,
+    std::vector<arma::u64>& lefts,
+    std::vector<arma::u64>& rights,
+    std::vector<ElemType>& parentDistances,
+    std::vector<ElemType>& furthestDistances,
+    std::vector<ElemType>& boundLos,
+    std::vector<ElemType>& boundHis)
+{
+  // Reserve this node's slot before descending, so that the nodes end up in
+  // preorder.
+  const size_t index = begins.size();
+  begins.push_back((arma::u64) node.Begin());
+  counts.push_back((arma::u64) node.Count());
+  lefts.push_back(flat_tree::noChild);
+  rights.push_back(flat_tree::noChild);
+  parentDistances.push_back(node.ParentDistance());
+  furthestDistances.push_back(node.FurthestDescendantDistance());
+  for (size_t d = 0; d < node.Bound().Dim(); ++d)
+  {
+    boundLos.push_back(node.Bound()[d].Lo());
+    boundHis.push_back(node.Bound()[d].Hi());
+  }
+
+  if (node.Left())
+  {
+    lefts[index] = (arma::u64) begins.size();
+    FillArrays(*node.Left(), begins, counts, lefts, rights, parentDistances,
+        furthestDistances, boundLos, boundHis);
+  }
+  if (node.Right())
+  {
+    rights[index] = (arma::u64) begins.size();
+    FillArrays(*node.Right(), begins, counts, lefts, rights, parentDistances,
+        furthestDistances, boundLos, boundHis);
+  }
+}
+
+template<typename TreeType>
+TreeType* FlatTreeIO<TreeType>::Load(const std::string& filename,
+                                     const bool mapDataset)
+{
+  std::ifstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+    throw std::runtime_error("FlatTreeIO::Load(): cannot open file '" +
+        filename + "' for reading!");
+
+  // Validate the header.
+  char magic[8];
+  stream.read(magic, sizeof(magic));
+  if (std::memcmp(magic, flat_tree::magic, sizeof(magic)) != 0)
+    throw std::runtime_error("FlatTreeIO::Load(): '" + filename + "' is not "
+        "a flat tree file!");
+  if (flat_tree::ReadU64(stream) != flat_tree::version)
+    throw std::runtime_error("FlatTreeIO::Load(): unsupported flat tree "
+        "version in '" + filename + "'!");
+  if (flat_tree::ReadU64(stream) != sizeof(ElemType))
+    throw std::runtime_error("FlatTreeIO::Load(): element size mismatch in "
+        "'" + filename + "'!");
+
+  const size_t dims = (size_t) flat_tree::ReadU64(stream);
+  const size_t points = (size_t) flat_tree::ReadU64(stream);
+  const size_t nodes = (size_t) flat_tree::ReadU64(stream);
+
+  const size_t datasetBytes = sizeof(ElemType) * dims * points;
+  const size_t paddedBytes = (datasetBytes % 8 == 0) ? datasetBytes :
+      (datasetBytes + 8 - (datasetBytes % 8));
+  const size_t headerBytes = sizeof(flat_tree::magic) + 5 * sizeof(arma::u64);
+
+  // Load (or map) the dataset.
+  MatType* dataset = NULL;
+  #ifndef _WIN32
+  if (mapDataset)
+  {
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd != -1)
+    {
+      void* map = mmap(NULL, headerBytes + datasetBytes, PROT_READ, MAP_SHARED,
+          fd, 0);
+      close(fd);
+      if (map != MAP_FAILED)
+      {
+        // Alias the mapped region; the matrix does not own this memory.  The
+        // mapping is deliberately left in place for the lifetime of the
+        // process, so the dataset pages stay shared via the page cache.
+        ElemType* data = (ElemType*) ((char*) map + headerBytes);
+        dataset = new MatType(data, dims, points, false, true);
+      }
+    }
+  }
+  #else
+  (void) mapDataset;
+  #endif
+
+  if (dataset == NULL)
+  {
+    // Fall back to one bulk read of the dataset.
+    dataset = new MatType(dims, points);
+    stream.read((char*) dataset->memptr(), datasetBytes);
+  }
+
+  // The node arrays follow the (padded) dataset.
+  stream.seekg(headerBytes + paddedBytes);
+  std::vector<arma::u64> begins(nodes), counts(nodes), lefts(nodes),
+      rights(nodes);
+  std::vector<ElemType> parentDistances(nodes), furthestDistances(nodes),
+      boundLos(nodes * dims), boundHis(nodes * dims);
+  stream.read((char*) begins.data(), nodes * sizeof(arma::u64));
+  stream.read((char*) counts.data(), nodes * sizeof(arma::u64));
+  stream.read((char*) lefts.data(), nodes * sizeof(arma::u64));
+  stream.read((char*) rights.data(), nodes * sizeof(arma::u64));
+  stream.read((char*) parentDistances.data(), nodes * sizeof(ElemType));
+  stream.read((char*) furthestDistances.data(), nodes * sizeof(ElemType));
+  stream.read((char*) boundLos.data(), nodes * dims * sizeof(ElemType));
+  stream.read((char*) boundHis.data(), nodes * dims * sizeof(ElemType));
+
+  if (!stream.good())
+  {
+    delete dataset;
+    throw std::runtime_error("FlatTreeIO::Load(): '" + filename + "' is "
+        "truncated!");
+  }
+
+  return BuildNode(0, NULL, dataset, begins, counts, lefts, rights,
+      parentDistances, furthestDistances, boundLos, boundHis);
+}
+
+template<typename TreeType>
+TreeType* FlatTreeIO<TreeType>::BuildNode(
+    const size_t index,
+    TreeType* parent,
+    const MatType* dataset,
+    const std::vector<arma::u64>& begins,
+    const std::vector<arma::u64>& counts,
+    const std::vector<arma::u64>& lefts,
+    const std::vector<arma::u64>& rights,
+    const std::vector<ElemType>& parentDistances,
+    const std::vector<ElemType>& furthestDistances,
+    const std::vector<ElemType>& boundLos,
+    const std::vector<ElemType>& boundHis)
+{
+  const size_t dims = dataset->n_rows;
+
+  // FlatTreeIO is a friend of BinarySpaceTree, so we may use the protected
+  // empty constructor and fill the members directly, just as cereal loading
+  // does.
+  TreeType* node = new TreeType();
+  node->parent = parent;
+  node->begin = (size_t) begins[index];
+  node->count = (size_t) counts[index];
+  node->parentDistance = parentDistances[index];
+  node->furthestDescendantDistance = furthestDistances[index];
+  node->dataset = const_cast<MatType*>(dataset);
+
+  node->bound = decltype(node->bound)(dims);
+  for (size_t d = 0; d < dims; ++d)
+  {
+    node->bound[d] = math::RangeType<ElemType>(boundLos[index * dims + d],
+        boundHis[index * dims + d]);
+  }
+
+  if (lefts[index] != flat_tree::noChild)
+  {
+    node->left = BuildNode((size_t) lefts[index], node, dataset, begins,
+        counts, lefts, rights, parentDistances, furthestDistances, boundLos,
+        boundHis);
+  }
+  if (rights[index] != flat_tree::noChild)
+  {
+    node->right = BuildNode((size_t) rights[index], node, dataset, begins,
+        counts, lefts, rights, parentDistances, furthestDistances, boundLos,
+        boundHis);
+  }
+
+  // Rebuild the statistic from the reconstructed node, exactly as a fresh
+  // build would.
+  node->stat = decltype(node->stat)(*node);
+
+  return node;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
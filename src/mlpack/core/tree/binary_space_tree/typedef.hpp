@@ -79,6 +79,27 @@ using MeanSplitKDTree = BinarySpaceTree<MetricType,
                                         bound::HRectBound,
                                         MeanSplit>;
 
+/**
+ * A midpoint-split kd-tree with sparsely stored bounds.  This is the same as
+ * the KDTree, but each node's bound only stores ranges for the dimensions in
+ * which some of its points are nonzero (every other dimension implicitly has
+ * the range [0, 0]).  This makes the memory use of a node proportional to the
+ * dimensions its points touch rather than the full dimensionality, so it
+ * should be used with sparse matrix types (e.g. arma::sp_mat) on
+ * high-dimensional sparse data, where the dense per-dimension bounds of the
+ * KDTree would exceed the size of the data itself.
+ *
+ * This template typedef satisfies the TreeType policy API.
+ *
+ * @see @ref trees, BinarySpaceTree, KDTree
+ */
+template<typename MetricType, typename StatisticType, typename MatType>
+using SparseKDTree = BinarySpaceTree<MetricType,
+                                     StatisticType,
+                                     MatType,
+                                     bound::SparseHRectBound,
+                                     MidpointSplit>;
+
 /**
  * A midpoint-split ball tree.  This tree holds its points only in the leaves,
  * similar to the KDTree and MeanSplitKDTree.  However, the bounding shape of
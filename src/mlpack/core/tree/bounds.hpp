@@ -17,6 +17,7 @@
 
 #include "bound_traits.hpp"
 #include "hrectbound.hpp"
+#include "sparse_hrectbound.hpp"
 #include "ballbound.hpp"
 #include "hollow_ball_bound.hpp"
 #include "cellbound.hpp"
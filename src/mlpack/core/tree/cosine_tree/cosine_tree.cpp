@@ -29,8 +29,10 @@ CosineTree::CosineTree(const arma::mat& dataset) :
   indices.resize(numColumns);
   l2NormsSquared.zeros(numColumns);
 
-  // Set indices and calculate squared norms of the columns.
-  for (size_t i = 0; i < numColumns; ++i)
+  // Set indices and calculate squared norms of the columns.  The norms are
+  // independent of each other, so they are computed in parallel.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numColumns; ++i)
   {
     indices[i] = i;
     double l2Norm = arma::norm(dataset.col(i), 2);
@@ -43,6 +45,9 @@ CosineTree::CosineTree(const arma::mat& dataset) :
   // Calculate centroid of columns in the node.
   CalculateCentroid();
 
+  // Cache the cumulative Length-Squared distribution of the columns.
+  CalculateDistribution();
+
   splitPointIndex = ColumnSampleLS();
 }
 
@@ -72,6 +77,9 @@ CosineTree::CosineTree(CosineTree& parentNode,
   // Calculate centroid of columns in the node.
   CalculateCentroid();
 
+  // Cache the cumulative Length-Squared distribution of the columns.
+  CalculateDistribution();
+
   splitPointIndex = ColumnSampleLS();
 }
 
@@ -163,6 +171,7 @@ CosineTree::CosineTree(const CosineTree& other) :
     right(NULL),
     indices(other.indices),
     l2NormsSquared(other.l2NormsSquared),
+    cDistribution(other.cDistribution),
     centroid(other.centroid),
     basisVector(other.basisVector),
     splitPointIndex(other.SplitPointIndex()),
@@ -229,6 +238,7 @@ CosineTree& CosineTree::operator=(const CosineTree& other)
   right = other.Right();
   indices = other.indices;
   l2NormsSquared = other.l2NormsSquared;
+  cDistribution = other.cDistribution;
   centroid = other.centroid;
   basisVector = other.basisVector;
   splitPointIndex = other.SplitPointIndex();
@@ -283,6 +293,7 @@ CosineTree::CosineTree(CosineTree&& other) :
     right(other.right),
     indices(std::move(other.indices)),
     l2NormsSquared(std::move(other.l2NormsSquared)),
+    cDistribution(std::move(other.cDistribution)),
     centroid(std::move(other.centroid)),
     basisVector(std::move(other.basisVector)),
     splitPointIndex(other.splitPointIndex),
@@ -329,6 +340,7 @@ CosineTree& CosineTree::operator=(CosineTree&& other)
   right = other.Right();
   indices = std::move(other.indices);
   l2NormsSquared = std::move(other.l2NormsSquared);
+  cDistribution = std::move(other.cDistribution);
   centroid = std::move(other.centroid);
   basisVector = std::move(other.basisVector);
   splitPointIndex = other.SplitPointIndex();
@@ -430,7 +442,10 @@ double CosineTree::MonteCarloError(CosineTree* node,
     projectionSize = treeQueue.size();
 
   // For each sample, calculate the weighted projection onto the current basis.
-  for (size_t i = 0; i < numSamples; ++i)
+  // The samples only read the dataset and the basis vectors, so they are
+  // processed in parallel.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numSamples; ++i)
   {
     // Initialize projection as a vector of zeros.
     arma::vec projection;
@@ -545,16 +560,8 @@ void CosineTree::ColumnSamplesLS(std::vector<size_t>& sampledIndices,
                                  arma::vec& probabilities,
                                  size_t numSamples)
 {
-  // Initialize the cumulative distribution vector size.
-  arma::vec cDistribution;
-  cDistribution.zeros(numColumns + 1);
-
-  // Calculate cumulative length-squared distribution for the node.
-  for (size_t i = 0; i < numColumns; ++i)
-  {
-    cDistribution(i + 1) = cDistribution(i) +
-        (l2NormsSquared(i) / frobNormSquared);
-  }
+  // The cumulative length-squared distribution is cached at construction, so
+  // sampling costs only a binary search per sample.
 
   // Initialize sizes of the 'sampledIndices' and 'probabilities' vectors.
   sampledIndices.resize(numSamples);
@@ -581,17 +588,6 @@ size_t CosineTree::ColumnSampleLS()
     return 0;
   }
 
-  // Initialize the cumulative distribution vector size.
-  arma::vec cDistribution;
-  cDistribution.zeros(numColumns + 1);
-
-  // Calculate cumulative length-squared distribution for the node.
-  for (size_t i = 0; i < numColumns; ++i)
-  {
-    cDistribution(i + 1) = cDistribution(i) +
-        (l2NormsSquared(i) / frobNormSquared);
-  }
-
   // Generate a random value for sampling.
   double randValue = arma::randu();
   size_t start = 0, end = numColumns;
@@ -633,7 +629,10 @@ void CosineTree::CalculateCosines(arma::vec& cosines)
   // Initialize cosine vector as a vector of zeros.
   cosines.zeros(numColumns);
 
-  for (size_t i = 0; i < numColumns; ++i)
+  // Each cosine reads one column pair and writes one output element, so the
+  // columns are processed in parallel.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numColumns; ++i)
   {
     // If norm is zero, store cosine value as zero. Else, calculate cosine value
     // between two vectors.
@@ -663,5 +662,18 @@ void CosineTree::CalculateCentroid()
   centroid /= numColumns;
 }
 
+void CosineTree::CalculateDistribution()
+{
+  // Initialize the cumulative distribution vector size.
+  cDistribution.zeros(numColumns + 1);
+
+  // Calculate cumulative length-squared distribution for the node.
+  for (size_t i = 0; i < numColumns; ++i)
+  {
+    cDistribution(i + 1) = cDistribution(i) +
+        (l2NormsSquared(i) / frobNormSquared);
+  }
+}
+
 } // namespace tree
 } // namespace mlpack
@@ -194,6 +194,14 @@ class CosineTree
    */
   void CalculateCentroid();
 
+  /**
+   * Calculate the cumulative Length-Squared distribution of the columns in
+   * the node. The distribution depends only on the column norms, which are
+   * fixed for the lifetime of the node, so it is computed once at
+   * construction and reused by every sampling call.
+   */
+  void CalculateDistribution();
+
   //! Returns the basis of the constructed subspace.
   void GetFinalBasis(arma::mat& finalBasis) { finalBasis = basis; }
 
@@ -258,6 +266,8 @@ class CosineTree
   std::vector<size_t> indices;
   //! L2-norm squared of columns in the node.
   arma::vec l2NormsSquared;
+  //! Cumulative Length-Squared distribution of columns in the node.
+  arma::vec cDistribution;
   //! Centroid of columns of input matrix in the node.
   arma::vec centroid;
   //! Orthonormalized basis vector of the node.
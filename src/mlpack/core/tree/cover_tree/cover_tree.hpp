@@ -15,6 +15,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/range.hpp>
 
+#include "../node_pool.hpp"
 #include "../statistic.hpp"
 #include "first_point_is_root.hpp"
 
@@ -267,6 +268,24 @@ class CoverTree
    */
   ~CoverTree();
 
+  //! Draw node memory from the shared node pool (node_pool.hpp); cover tree
+  //! builds allocate many small nodes, which the pool keeps contiguous.
+  void* operator new(const size_t size)
+  {
+    if (size == sizeof(CoverTree))
+      return NodePool<sizeof(CoverTree)>::Allocate();
+    return ::operator new(size);
+  }
+
+  //! Recycle node memory through the pool.
+  void operator delete(void* memory, const size_t size)
+  {
+    if (size == sizeof(CoverTree))
+      NodePool<sizeof(CoverTree)>::Deallocate(memory);
+    else
+      ::operator delete(memory);
+  }
+
   //! A single-tree cover tree traverser; see single_tree_traverser.hpp for
   //! implementation.
   template<typename RuleType>
@@ -584,4 +603,12 @@ class CoverTree
 // Include the rest of the pieces, if necessary.
 #include "../cover_tree.hpp"
 
+// The default configuration is compiled once into libmlpack (see
+// core/tree/tree_instantiations.cpp), so client translation units can skip
+// instantiating it.  Define MLPACK_NO_EXTERN_TREE_TEMPLATES to disable this
+// (e.g. when using the headers without linking against libmlpack).
+#ifndef MLPACK_NO_EXTERN_TREE_TEMPLATES
+extern template class mlpack::tree::CoverTree<>;
+#endif
+
 #endif
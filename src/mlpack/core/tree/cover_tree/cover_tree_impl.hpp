@@ -25,12 +25,20 @@ namespace tree {
 template<typename TreeType, typename StatisticType>
 void BuildStatistics(TreeType* node)
 {
-  // Recurse first.
-  for (size_t i = 0; i < node->NumChildren(); ++i)
-    BuildStatistics<TreeType, StatisticType>(&node->Child(i));
+  // Cover trees can be very deep (the depth is bounded only by the number of
+  // points, not its logarithm), so this is done iteratively: collect the
+  // nodes in an order where parents precede their children, then build the
+  // statistics in reverse, so that every node's children are finished before
+  // the node itself.
+  std::vector<TreeType*> order(1, node);
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    for (size_t j = 0; j < order[i]->NumChildren(); ++j)
+      order.push_back(&order[i]->Child(j));
+  }
 
-  // Now build the statistic.
-  node->Stat() = StatisticType(*node);
+  for (size_t i = order.size(); i > 0; --i)
+    order[i - 1]->Stat() = StatisticType(*order[i - 1]);
 }
 
 // Create the cover tree.
@@ -742,9 +750,23 @@ template<
 >
 CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::~CoverTree()
 {
-  // Delete each child.
-  for (size_t i = 0; i < children.size(); ++i)
-    delete children[i];
+  // Delete the subtree iteratively: recursive destruction would use stack
+  // space proportional to the depth of the tree, and cover trees built on
+  // adversarial datasets can be deep enough to overflow the stack.  Each
+  // node's children are detached before it is deleted, so its destructor has
+  // nothing left to recurse into.
+  std::vector<CoverTree*> stack(children.begin(), children.end());
+  children.clear();
+  while (!stack.empty())
+  {
+    CoverTree* node = stack.back();
+    stack.pop_back();
+
+    stack.insert(stack.end(), node->children.begin(), node->children.end());
+    node->children.clear();
+
+    delete node;
+  }
 
   // Delete the local metric, if necessary.
   if (localMetric)
@@ -1392,9 +1414,13 @@ void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
                      const size_t pointSetSize)
 {
   // For each point, rebuild the distances.  The indices do not need to be
-  // modified.
+  // modified.  All of the distances of one expansion are computed here in a
+  // single batch, and this loop is where nearly all of the construction time
+  // goes, so large batches are evaluated in parallel; small batches are
+  // evaluated serially to avoid threading overhead.
   distanceComps += pointSetSize;
-  for (size_t i = 0; i < pointSetSize; ++i)
+  #pragma omp parallel for if (pointSetSize > 1024)
+  for (omp_size_t i = 0; i < (omp_size_t) pointSetSize; ++i)
   {
     distances[i] = metric->Evaluate(dataset->col(pointIndex),
         dataset->col(indices[i]));
@@ -4,7 +4,9 @@
  *
  * A simple greedy traverser which always chooses the child with the best score
  * and doesn't do backtracking.  The RuleType class must implement the method
- * 'GetBestChild()'.
+ * 'GetBestChild()'.  With a leaf budget greater than one, the traversal
+ * generalizes to a beam search over up to that many leaves, ordered by their
+ * bounds; the RuleType must then also implement 'Score()' and 'Rescore()'.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -40,12 +42,33 @@ class GreedySingleTreeTraverser
   //! Get the number of prunes.
   size_t NumPrunes() const { return numPrunes; }
 
+  //! Get the number of leaves a traversal may visit.  With the default of 1,
+  //! the traversal is the plain greedy descent to a single leaf; larger
+  //! values turn it into a beam search over the given number of leaves,
+  //! ordered by their bounds.
+  size_t LeafBudget() const { return leafBudget; }
+  //! Modify the number of leaves a traversal may visit.
+  size_t& LeafBudget() { return leafBudget; }
+
+  //! Get the number of nodes a beam-search traversal may visit (unlimited by
+  //! default).  This bounds the per-query work more tightly than the leaf
+  //! budget alone.  Only used when the leaf budget is greater than 1.
+  size_t NodeBudget() const { return nodeBudget; }
+  //! Modify the number of nodes a beam-search traversal may visit.
+  size_t& NodeBudget() { return nodeBudget; }
+
  private:
   //! Reference to the rules with which the tree will be traversed.
   RuleType& rule;
 
   //! The number of nodes which have been pruned during traversal.
   size_t numPrunes;
+
+  //! The maximum number of leaves to visit per traversal.
+  size_t leafBudget;
+
+  //! The maximum number of nodes to visit per beam-search traversal.
+  size_t nodeBudget;
 };
 
 } // namespace tree
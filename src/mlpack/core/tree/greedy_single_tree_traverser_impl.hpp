@@ -17,6 +17,8 @@
 // In case it hasn't been included yet.
 #include "greedy_single_tree_traverser.hpp"
 
+#include <queue>
+
 namespace mlpack {
 namespace tree {
 
@@ -24,7 +26,9 @@ template<typename TreeType, typename RuleType>
 GreedySingleTreeTraverser<TreeType, RuleType>::GreedySingleTreeTraverser(
     RuleType& rule) :
     rule(rule),
-    numPrunes(0)
+    numPrunes(0),
+    leafBudget(1),
+    nodeBudget(size_t() - 1)
 { /* Nothing to do. */ }
 
 template<typename TreeType, typename RuleType>
@@ -32,6 +36,65 @@ void GreedySingleTreeTraverser<TreeType, RuleType>::Traverse(
     const size_t queryIndex,
     TreeType& referenceNode)
 {
+  // With a leaf budget greater than one, run a beam search over the most
+  // promising subtrees instead of the plain greedy descent.
+  if (leafBudget > 1)
+  {
+    // The frontier of unvisited subtrees, most promising (lowest score)
+    // first.
+    typedef std::pair<double, TreeType*> Candidate;
+    std::priority_queue<Candidate, std::vector<Candidate>,
+        std::greater<Candidate>> frontier;
+    frontier.push(std::make_pair(0.0, &referenceNode));
+
+    size_t leavesVisited = 0;
+    size_t nodesVisited = 0;
+    size_t pointsVisited = 0;
+    // The budgets only apply once enough base cases have been run to fill the
+    // result list, so that a tight node budget cannot produce incomplete
+    // results.
+    while (!frontier.empty() &&
+        (pointsVisited < rule.MinimumBaseCases() ||
+         (leavesVisited < leafBudget && nodesVisited < nodeBudget)))
+    {
+      const Candidate candidate = frontier.top();
+      frontier.pop();
+      TreeType& node = *candidate.second;
+
+      // The bound may have tightened since the node was scored.
+      if (rule.Rescore(queryIndex, node, candidate.first) == DBL_MAX)
+      {
+        ++numPrunes;
+        continue;
+      }
+      ++nodesVisited;
+
+      for (size_t i = 0; i < node.NumPoints(); ++i)
+        rule.BaseCase(queryIndex, node.Point(i));
+      pointsVisited += node.NumPoints();
+
+      if (node.IsLeaf())
+      {
+        ++leavesVisited;
+      }
+      else
+      {
+        for (size_t i = 0; i < node.NumChildren(); ++i)
+        {
+          const double score = rule.Score(queryIndex, node.Child(i));
+          if (score == DBL_MAX)
+            ++numPrunes;
+          else
+            frontier.push(std::make_pair(score, &node.Child(i)));
+        }
+      }
+    }
+
+    // All subtrees left on the frontier are pruned by the budgets.
+    numPrunes += frontier.size();
+    return;
+  }
+
   // Run the base case as necessary for all the points in the reference node.
   for (size_t i = 0; i < referenceNode.NumPoints(); ++i)
     rule.BaseCase(queryIndex, referenceNode.Point(i));
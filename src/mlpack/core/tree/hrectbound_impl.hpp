@@ -14,12 +14,103 @@
 
 #include <math.h>
 
+#include <mlpack/core/math/simd_kernels.hpp>
+
 // In case it has not been included yet.
 #include "hrectbound.hpp"
 
 namespace mlpack {
 namespace bound {
 
+// The helpers below route the L2 distance computations through the
+// runtime-dispatched SIMD kernels when the element type is one the kernels
+// cover, and report through their return value whether they did; for other
+// element types (or non-contiguous points) the callers keep their scalar
+// loops.  An array of RangeType is exactly the interleaved (lo, hi) layout
+// the kernels expect.
+
+template<typename ElemType>
+inline typename std::enable_if<std::is_floating_point<ElemType>::value,
+    bool>::type
+SimdMinDistanceSum(const math::RangeType<ElemType>* a,
+                   const math::RangeType<ElemType>* b,
+                   const size_t dim,
+                   ElemType& sum)
+{
+  sum = math::simd::BoundMinDistanceSum(
+      reinterpret_cast<const ElemType*>(a),
+      reinterpret_cast<const ElemType*>(b), dim);
+  return true;
+}
+
+template<typename ElemType>
+inline typename std::enable_if<!std::is_floating_point<ElemType>::value,
+    bool>::type
+SimdMinDistanceSum(const math::RangeType<ElemType>* /* a */,
+                   const math::RangeType<ElemType>* /* b */,
+                   const size_t /* dim */,
+                   ElemType& /* sum */)
+{
+  return false;
+}
+
+template<typename ElemType>
+inline typename std::enable_if<std::is_floating_point<ElemType>::value,
+    bool>::type
+SimdRangeSums(const math::RangeType<ElemType>* a,
+              const math::RangeType<ElemType>* b,
+              const size_t dim,
+              ElemType& loSum,
+              ElemType& hiSum)
+{
+  math::simd::RangeDistanceSums(
+      reinterpret_cast<const ElemType*>(a),
+      reinterpret_cast<const ElemType*>(b), dim, loSum, hiSum);
+  return true;
+}
+
+template<typename ElemType>
+inline typename std::enable_if<!std::is_floating_point<ElemType>::value,
+    bool>::type
+SimdRangeSums(const math::RangeType<ElemType>* /* a */,
+              const math::RangeType<ElemType>* /* b */,
+              const size_t /* dim */,
+              ElemType& /* loSum */,
+              ElemType& /* hiSum */)
+{
+  return false;
+}
+
+template<typename ElemType, typename VecType>
+inline typename std::enable_if<
+    std::is_floating_point<ElemType>::value &&
+    math::simd::IsContiguous<VecType>::value &&
+    std::is_same<typename VecType::elem_type, ElemType>::value, bool>::type
+SimdPointRangeSums(const VecType& point,
+                   const math::RangeType<ElemType>* b,
+                   const size_t dim,
+                   ElemType& loSum,
+                   ElemType& hiSum)
+{
+  math::simd::PointRangeDistanceSums(math::simd::MemPtr(point),
+      reinterpret_cast<const ElemType*>(b), dim, loSum, hiSum);
+  return true;
+}
+
+template<typename ElemType, typename VecType>
+inline typename std::enable_if<!(
+    std::is_floating_point<ElemType>::value &&
+    math::simd::IsContiguous<VecType>::value &&
+    std::is_same<typename VecType::elem_type, ElemType>::value), bool>::type
+SimdPointRangeSums(const VecType& /* point */,
+                   const math::RangeType<ElemType>* /* b */,
+                   const size_t /* dim */,
+                   ElemType& /* loSum */,
+                   ElemType& /* hiSum */)
+{
+  return false;
+}
+
 /**
  * Empty constructor.
  */
@@ -249,6 +340,18 @@ ElemType HRectBound<MetricType, ElemType>::MinDistance(const HRectBound& other)
 {
   Log::Assert(dim == other.dim);
 
+  // For the L2 case over floating-point ranges, accumulate the squared sum in
+  // a single pass through the SIMD kernel.
+  if (MetricType::Power == 2)
+  {
+    ElemType kernelSum;
+    if (SimdMinDistanceSum(bounds, other.bounds, dim, kernelSum))
+    {
+      return MetricType::TakeRoot ? (ElemType) std::sqrt(kernelSum) :
+          kernelSum;
+    }
+  }
+
   ElemType sum = 0;
   const math::RangeType<ElemType>* mbound = bounds;
   const math::RangeType<ElemType>* obound = other.bounds;
@@ -396,6 +499,21 @@ HRectBound<MetricType, ElemType>::RangeDistance(
 
   Log::Assert(dim == other.dim);
 
+  // For the L2 case over floating-point ranges, both squared sums are
+  // accumulated in a single fused pass through the SIMD kernel.
+  if (MetricType::Power == 2)
+  {
+    if (SimdRangeSums(bounds, other.bounds, dim, loSum, hiSum))
+    {
+      if (MetricType::TakeRoot)
+      {
+        return math::RangeType<ElemType>((ElemType) std::sqrt(loSum),
+                                         (ElemType) std::sqrt(hiSum));
+      }
+      return math::RangeType<ElemType>(loSum, hiSum);
+    }
+  }
+
   ElemType v1, v2, vLo, vHi;
   for (size_t d = 0; d < dim; d++)
   {
@@ -464,6 +582,21 @@ HRectBound<MetricType, ElemType>::RangeDistance(
 
   Log::Assert(point.n_elem == dim);
 
+  // For the L2 case with a contiguous floating-point point, both squared
+  // sums are accumulated in a single fused pass through the SIMD kernel.
+  if (MetricType::Power == 2)
+  {
+    if (SimdPointRangeSums(point, bounds, dim, loSum, hiSum))
+    {
+      if (MetricType::TakeRoot)
+      {
+        return math::RangeType<ElemType>((ElemType) std::sqrt(loSum),
+                                         (ElemType) std::sqrt(hiSum));
+      }
+      return math::RangeType<ElemType>(loSum, hiSum);
+    }
+  }
+
   ElemType v1, v2, vLo, vHi;
   for (size_t d = 0; d < dim; d++)
   {
@@ -0,0 +1,164 @@
+/**
+ * @file core/tree/incremental_tree_builder.hpp
+ *
+ * Definition of IncrementalTreeBuilder.  Space trees in mlpack are static:
+ * inserting or removing a point means rebuilding the whole tree, and during
+ * that rebuild the tree cannot be queried.  IncrementalTreeBuilder owns a
+ * tree and buffers point insertions and deletions next to it; the buffered
+ * updates are folded into the tree either synchronously with Rebuild() or on
+ * a background thread with LaunchRebuild()/SwapIfReady(), so that the current
+ * tree remains usable for queries while its replacement is being built.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_INCREMENTAL_TREE_BUILDER_HPP
+#define MLPACK_CORE_TREE_INCREMENTAL_TREE_BUILDER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <atomic>
+#include <thread>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * IncrementalTreeBuilder owns a tree of the given type and provides an
+ * insert/delete API on top of it.  Updates do not modify the tree
+ * immediately; they are buffered, and queries against Tree() simply do not
+ * see them until the next rebuild.  This matches the common pattern of
+ * serving queries from a slightly stale index while updates accumulate.
+ *
+ * Deletion indices refer to columns of Dataset(), i.e. the dataset in the
+ * order the current tree stores it.  While a background rebuild is in flight,
+ * Delete() is not allowed (the index would be ambiguous: it could refer to
+ * either the current or the replacement dataset); Insert() remains valid at
+ * any time.
+ *
+ * The caller is responsible for making sure no queries are running when
+ * SwapIfReady() replaces the tree.
+ *
+ * @tparam TreeType Type of tree to hold (e.g. a BinarySpaceTree
+ *     instantiation).
+ */
+template<typename TreeType>
+class IncrementalTreeBuilder
+{
+ public:
+  //! Convenience typedefs.
+  typedef typename TreeType::Mat MatType;
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Construct the builder, building the initial tree on the given dataset.
+   *
+   * @param dataset Dataset to build the initial tree on.
+   * @param maxLeafSize Maximum leaf size to use for every (re)build.
+   */
+  IncrementalTreeBuilder(MatType dataset, const size_t maxLeafSize = 20);
+
+  //! Clean up the tree and any unfinished background rebuild.
+  ~IncrementalTreeBuilder();
+
+  //! No copies: the builder owns a tree and possibly a running thread.
+  IncrementalTreeBuilder(const IncrementalTreeBuilder&) = delete;
+  IncrementalTreeBuilder& operator=(const IncrementalTreeBuilder&) = delete;
+
+  //! Get the current tree.  The tree does not reflect buffered updates.
+  const TreeType& Tree() const { return *tree; }
+  //! Modify the current tree.
+  TreeType& Tree() { return *tree; }
+
+  //! Get the dataset of the current tree (deletion indices refer to this).
+  const MatType& Dataset() const { return tree->Dataset(); }
+
+  /**
+   * Buffer a point for insertion.  The point becomes visible to queries
+   * after the next rebuild.
+   *
+   * @param point Point to insert.
+   */
+  template<typename VecType>
+  void Insert(const VecType& point);
+
+  /**
+   * Buffer a point for deletion.  The point remains visible to queries until
+   * the next rebuild.  Throws std::logic_error if a background rebuild is in
+   * flight, and std::out_of_range for an invalid index.
+   *
+   * @param index Column index of the point in Dataset().
+   */
+  void Delete(const size_t index);
+
+  //! Get the number of buffered insertions and deletions.
+  size_t PendingUpdates() const { return pendingInserts + pendingDeletes; }
+
+  /**
+   * Fold all buffered updates into the tree, rebuilding it synchronously.
+   * If a background rebuild is in flight, it is adopted (or waited for)
+   * first.
+   */
+  void Rebuild();
+
+  /**
+   * Start rebuilding the tree on a background thread, folding in all updates
+   * buffered so far.  The current tree stays valid and queryable.  If a
+   * rebuild is already in flight, this does nothing.
+   */
+  void LaunchRebuild();
+
+  /**
+   * If a background rebuild has finished, replace the current tree with the
+   * rebuilt one and return true; otherwise return false.  No queries may be
+   * running on the old tree when this swaps it out.
+   */
+  bool SwapIfReady();
+
+ private:
+  //! Produce the dataset for the next tree: the current dataset without the
+  //! deleted columns, with the buffered insertions appended.
+  MatType MergedDataset() const;
+
+  //! Discard the buffers that the most recent (re)build consumed.
+  void ClearConsumedUpdates();
+
+  //! Wait for any in-flight background rebuild and adopt its result.
+  void FinishRebuild();
+
+  //! The current tree.
+  TreeType* tree;
+  //! Maximum leaf size used for every build.
+  size_t maxLeafSize;
+
+  //! Buffered insertions, stored flat in column-major order.
+  std::vector<ElemType> insertBuffer;
+  //! Number of buffered insertions.
+  size_t pendingInserts;
+  //! Deletion flags for the current dataset's columns.
+  std::vector<bool> deleted;
+  //! Number of buffered deletions.
+  size_t pendingDeletes;
+
+  //! The background rebuild thread, if any.
+  std::thread worker;
+  //! Whether a background rebuild is in flight (set until adoption).
+  bool rebuildInFlight;
+  //! Set by the worker once the replacement tree is complete.
+  std::atomic<bool> rebuildDone;
+  //! The replacement tree produced by the worker.
+  TreeType* replacement;
+  //! The number of insertions the in-flight rebuild consumed; later
+  //! insertions stay buffered for the next rebuild.
+  size_t consumedInserts;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "incremental_tree_builder_impl.hpp"
+
+#endif
@@ -0,0 +1,179 @@
+/**
+ * @file core/tree/incremental_tree_builder_impl.hpp
+ *
+ * Implementation of IncrementalTreeBuilder.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_INCREMENTAL_TREE_BUILDER_IMPL_HPP
+#define MLPACK_CORE_TREE_INCREMENTAL_TREE_BUILDER_IMPL_HPP
+
+#include "incremental_tree_builder.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType>
+IncrementalTreeBuilder<TreeType>::IncrementalTreeBuilder(
+    MatType dataset,
+    const size_t maxLeafSize) :
+    tree(new TreeType(std::move(dataset), maxLeafSize)),
+    maxLeafSize(maxLeafSize),
+    pendingInserts(0),
+    pendingDeletes(0),
+    rebuildInFlight(false),
+    rebuildDone(false),
+    replacement(NULL),
+    consumedInserts(0)
+{
+  deleted.resize(tree->Dataset().n_cols, false);
+}
+
+template<typename TreeType>
+IncrementalTreeBuilder<TreeType>::~IncrementalTreeBuilder()
+{
+  if (worker.joinable())
+    worker.join();
+  delete replacement;
+  delete tree;
+}
+
+template<typename TreeType>
+template<typename VecType>
+void IncrementalTreeBuilder<TreeType>::Insert(const VecType& point)
+{
+  if (point.n_elem != tree->Dataset().n_rows)
+    throw std::invalid_argument("IncrementalTreeBuilder::Insert(): point "
+        "dimensionality does not match the dataset!");
+
+  for (size_t d = 0; d < point.n_elem; ++d)
+    insertBuffer.push_back(point[d]);
+  ++pendingInserts;
+}
+
+template<typename TreeType>
+void IncrementalTreeBuilder<TreeType>::Delete(const size_t index)
+{
+  if (rebuildInFlight)
+    throw std::logic_error("IncrementalTreeBuilder::Delete(): cannot delete "
+        "while a background rebuild is in flight!");
+  if (index >= deleted.size())
+    throw std::out_of_range("IncrementalTreeBuilder::Delete(): invalid point "
+        "index!");
+
+  if (!deleted[index])
+  {
+    deleted[index] = true;
+    ++pendingDeletes;
+  }
+}
+
+template<typename TreeType>
+typename IncrementalTreeBuilder<TreeType>::MatType
+IncrementalTreeBuilder<TreeType>::MergedDataset() const
+{
+  const MatType& current = tree->Dataset();
+  const size_t dims = current.n_rows;
+  const size_t kept = current.n_cols - pendingDeletes;
+
+  MatType merged(dims, kept + pendingInserts);
+  size_t col = 0;
+  for (size_t i = 0; i < current.n_cols; ++i)
+    if (!deleted[i])
+      merged.col(col++) = current.col(i);
+
+  // Append the buffered insertions.
+  for (size_t i = 0; i < pendingInserts; ++i)
+  {
+    merged.col(col++) = arma::Col<ElemType>(
+        const_cast<ElemType*>(insertBuffer.data()) + i * dims, dims, false,
+        true);
+  }
+
+  return merged;
+}
+
+template<typename TreeType>
+void IncrementalTreeBuilder<TreeType>::ClearConsumedUpdates()
+{
+  // The rebuild consumed the first consumedInserts insertions and all of the
+  // deletions; anything inserted afterwards stays buffered.
+  insertBuffer.erase(insertBuffer.begin(),
+      insertBuffer.begin() + consumedInserts * tree->Dataset().n_rows);
+  pendingInserts -= consumedInserts;
+  consumedInserts = 0;
+
+  deleted.assign(tree->Dataset().n_cols, false);
+  pendingDeletes = 0;
+}
+
+template<typename TreeType>
+void IncrementalTreeBuilder<TreeType>::Rebuild()
+{
+  if (rebuildInFlight)
+  {
+    FinishRebuild();
+    if (PendingUpdates() == 0)
+      return;
+  }
+
+  if (PendingUpdates() == 0)
+    return;
+
+  consumedInserts = pendingInserts;
+  TreeType* rebuilt = new TreeType(MergedDataset(), maxLeafSize);
+  delete tree;
+  tree = rebuilt;
+  ClearConsumedUpdates();
+}
+
+template<typename TreeType>
+void IncrementalTreeBuilder<TreeType>::LaunchRebuild()
+{
+  if (rebuildInFlight || PendingUpdates() == 0)
+    return;
+
+  // Snapshot the merged dataset on this thread, so that the worker does not
+  // touch the (possibly still growing) insert buffer or the current tree.
+  MatType merged = MergedDataset();
+  consumedInserts = pendingInserts;
+  rebuildInFlight = true;
+  rebuildDone = false;
+
+  worker = std::thread([this](MatType data)
+  {
+    replacement = new TreeType(std::move(data), maxLeafSize);
+    rebuildDone = true;
+  }, std::move(merged));
+}
+
+template<typename TreeType>
+bool IncrementalTreeBuilder<TreeType>::SwapIfReady()
+{
+  if (!rebuildInFlight || !rebuildDone)
+    return false;
+
+  FinishRebuild();
+  return true;
+}
+
+template<typename TreeType>
+void IncrementalTreeBuilder<TreeType>::FinishRebuild()
+{
+  if (worker.joinable())
+    worker.join();
+
+  delete tree;
+  tree = replacement;
+  replacement = NULL;
+  rebuildInFlight = false;
+  ClearConsumedUpdates();
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,74 @@
+/**
+ * @file core/tree/leaf_size_tuner.hpp
+ *
+ * Defines the LeafSizeTuner class, which selects a leaf size for tree
+ * construction by measuring the build-and-query cost of a handful of
+ * candidate leaf sizes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_LEAF_SIZE_TUNER_HPP
+#define MLPACK_CORE_TREE_LEAF_SIZE_TUNER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The LeafSizeTuner class selects a leaf size empirically.  The best leaf
+ * size for a spatial tree depends on the dataset: small leaves mean deeper
+ * trees with better pruning but more traversal overhead, and large leaves
+ * mean cheaper trees with more base-case work, so no fixed default is right
+ * for every dataset.
+ *
+ * Tune() sweeps a ladder of candidate leaf sizes, invokes a caller-provided
+ * cost function with each candidate, measures the wall-clock time of each
+ * invocation with the timer infrastructure, and returns the cheapest
+ * candidate.  The cost function should perform the work whose cost the leaf
+ * size controls—typically building a tree on a sample of the dataset and
+ * running a small representative query workload against it.
+ *
+ * Because the measurements are wall-clock times of a sampled workload, the
+ * selection is a heuristic: it is meant to replace hand-tuning, not to
+ * certify the optimum.
+ */
+class LeafSizeTuner
+{
+ public:
+  /**
+   * Return the default ladder of candidate leaf sizes.  The ladder spans the
+   * range of values that are typically useful in practice.
+   */
+  static std::vector<size_t> DefaultCandidates()
+  {
+    return std::vector<size_t>({ 8, 20, 50, 100 });
+  }
+
+  /**
+   * Select the cheapest leaf size among the given candidates.  The cost
+   * function is invoked once with each candidate leaf size, its wall-clock
+   * time is measured, and the candidate with the smallest measured time is
+   * returned.
+   *
+   * @param costFunction Callable taking a leaf size (size_t); it should build
+   *      a tree with that leaf size and run a representative query workload.
+   * @param candidates Candidate leaf sizes to sweep; must not be empty.
+   * @return The candidate with the smallest measured cost.
+   */
+  template<typename CostFunctionType>
+  static size_t Tune(
+      CostFunctionType costFunction,
+      const std::vector<size_t>& candidates = DefaultCandidates());
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "leaf_size_tuner_impl.hpp"
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * @file core/tree/leaf_size_tuner_impl.hpp
+ *
+ * Implementation of the LeafSizeTuner class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_LEAF_SIZE_TUNER_IMPL_HPP
+#define MLPACK_CORE_TREE_LEAF_SIZE_TUNER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "leaf_size_tuner.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename CostFunctionType>
+size_t LeafSizeTuner::Tune(CostFunctionType costFunction,
+                           const std::vector<size_t>& candidates)
+{
+  if (candidates.empty())
+    throw std::invalid_argument("LeafSizeTuner::Tune(): at least one "
+        "candidate leaf size must be given");
+
+  // Use a private Timers instance so that the measurements work even when
+  // global timing is disabled, and so that they do not show up in the global
+  // timer output.
+  Timers timers;
+  timers.Enabled() = true;
+
+  size_t bestLeafSize = candidates[0];
+  std::chrono::microseconds bestCost = std::chrono::microseconds::max();
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    const std::string timerName = "leaf_size_" +
+        std::to_string(candidates[i]);
+
+    timers.StartTimer(timerName);
+    costFunction(candidates[i]);
+    timers.StopTimer(timerName);
+
+    const std::chrono::microseconds cost = timers.GetTimer(timerName);
+    Log::Info << "LeafSizeTuner::Tune(): leaf size " << candidates[i]
+        << " took " << cost.count() << " microseconds." << std::endl;
+
+    if (cost < bestCost)
+    {
+      bestCost = cost;
+      bestLeafSize = candidates[i];
+    }
+  }
+
+  return bestLeafSize;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,178 @@
+/**
+ * @file core/tree/node_pool.hpp
+ *
+ * Definition of NodePool, a pooled allocator for tree nodes.  Tree
+ * construction allocates one node at a time with operator new, which both
+ * costs a general-purpose allocator round trip per node and scatters sibling
+ * nodes across the heap.  NodePool hands out fixed-size blocks carved from
+ * large contiguous chunks, so nodes that are built together are laid out
+ * together and traversals touch fewer cache lines.  Freed nodes are recycled
+ * through per-thread free lists that overflow into a shared list, so blocks
+ * freed on one thread (trees are usually destroyed serially) flow back to
+ * the threads that allocate (parallel builds allocate on every worker).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_NODE_POOL_HPP
+#define MLPACK_CORE_TREE_NODE_POOL_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <cstddef> // std::max_align_t
+#include <mutex>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A pool of fixed-size memory blocks, intended to back the per-class
+ * operator new of tree node types.  One pool instantiation exists per block
+ * size, shared by all trees whose nodes have that size.
+ *
+ * Each thread owns its own free list, so the common allocation and
+ * deallocation paths are lock-free.  A thread whose list grows past a
+ * threshold spills a fixed-size segment of blocks to a shared list, and a
+ * thread whose list runs dry refills from the shared list before asking the
+ * system for a fresh chunk.  This matters with parallel tree builds: nodes
+ * are allocated on every worker thread but freed on whichever thread
+ * destroys the tree, and without the spill path the workers would never see
+ * their blocks again and every build/destroy cycle would grow the pool.
+ * Chunks are retained (and recycled) until the process exits, which is the
+ * usual pool tradeoff: repeated build/destroy cycles reuse the same warm
+ * memory instead of returning it to the system.
+ *
+ * @tparam BlockSize Size of the blocks to hand out, typically
+ *     sizeof(NodeType).
+ */
+template<size_t BlockSize>
+class NodePool
+{
+ public:
+  //! Get one block from the pool, refilling the calling thread's free list
+  //! from the shared list (or a fresh chunk) if it is empty.
+  static void* Allocate()
+  {
+    ThreadCache& cache = Cache();
+    if (!cache.freeList)
+      Refill(cache);
+
+    FreeBlock* block = cache.freeList;
+    cache.freeList = block->next;
+    --cache.size;
+    return block;
+  }
+
+  //! Return a block to the calling thread's free list, spilling a segment to
+  //! the shared list if the thread has accumulated more than it needs.
+  static void Deallocate(void* memory)
+  {
+    ThreadCache& cache = Cache();
+    FreeBlock* block = static_cast<FreeBlock*>(memory);
+    block->next = cache.freeList;
+    cache.freeList = block;
+    if (++cache.size >= 2 * chunkBlocks)
+      Spill(cache);
+  }
+
+ private:
+  //! Freed blocks are chained through their own storage.
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  //! A thread's free list, with its length so that spilling does not need to
+  //! walk the list to know when it is oversized.
+  struct ThreadCache
+  {
+    FreeBlock* freeList;
+    size_t size;
+  };
+
+  //! Number of blocks fetched from the system per refill; also the length of
+  //! the segments exchanged with the shared list.
+  static const size_t chunkBlocks = 256;
+
+  //! The block size rounded up so that every block in a chunk keeps maximal
+  //! fundamental alignment (and has room for the free-list link).
+  static const size_t alignedSize =
+      ((BlockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : BlockSize) +
+       alignof(std::max_align_t) - 1) / alignof(std::max_align_t) *
+      alignof(std::max_align_t);
+
+  //! Access the calling thread's free list.
+  static ThreadCache& Cache()
+  {
+    static thread_local ThreadCache cache = { NULL, 0 };
+    return cache;
+  }
+
+  //! The mutex guarding the shared segment list.  It is only taken when a
+  //! thread's list runs dry or overflows, so the common paths stay lock-free.
+  static std::mutex& SharedMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  //! Segments of chunkBlocks blocks spilled by overfull threads, each
+  //! represented by its head block.
+  static std::vector<FreeBlock*>& SharedSegments()
+  {
+    static std::vector<FreeBlock*> segments;
+    return segments;
+  }
+
+  //! Detach a segment of chunkBlocks blocks from the given thread's free
+  //! list and push it onto the shared list.
+  static void Spill(ThreadCache& cache)
+  {
+    FreeBlock* head = cache.freeList;
+    FreeBlock* tail = head;
+    for (size_t i = 1; i < chunkBlocks; ++i)
+      tail = tail->next;
+
+    cache.freeList = tail->next;
+    cache.size -= chunkBlocks;
+    tail->next = NULL;
+
+    std::lock_guard<std::mutex> lock(SharedMutex());
+    SharedSegments().push_back(head);
+  }
+
+  //! Refill the given thread's free list, preferring a segment spilled by
+  //! another thread over a fresh chunk from the system.
+  static void Refill(ThreadCache& cache)
+  {
+    {
+      std::lock_guard<std::mutex> lock(SharedMutex());
+      if (!SharedSegments().empty())
+      {
+        cache.freeList = SharedSegments().back();
+        SharedSegments().pop_back();
+        cache.size = chunkBlocks;
+        return;
+      }
+    }
+
+    // Carve a fresh contiguous chunk into blocks, preserving address order
+    // so that consecutively allocated nodes are adjacent in memory.
+    char* chunk = static_cast<char*>(::operator new(chunkBlocks * alignedSize));
+    for (size_t i = chunkBlocks; i > 0; --i)
+    {
+      FreeBlock* block = reinterpret_cast<FreeBlock*>(
+          chunk + (i - 1) * alignedSize);
+      block->next = cache.freeList;
+      cache.freeList = block;
+    }
+    cache.size += chunkBlocks;
+  }
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -13,7 +13,9 @@
 #define MLPACK_CORE_TREE_OCTREE_OCTREE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/z_order.hpp>
 #include "../hrectbound.hpp"
+#include "../node_pool.hpp"
 #include "../statistic.hpp"
 
 namespace mlpack {
@@ -41,6 +43,12 @@ class Octree
  private:
   //! The children held by this node.
   std::vector<Octree*> children;
+  //! The hyperoctant each child occupies, in the same order as `children`.
+  //! Bit d of the octant index is set if the child lies on the upper side of
+  //! the split center in dimension d.  Children are created in ascending
+  //! octant order, so this vector is sorted and iterating over `children`
+  //! walks the dataset in Morton (Z-curve) order.
+  std::vector<size_t> childOctants;
 
   //! The index of the first point in the dataset contained in this node (and
   //! its children).
@@ -111,6 +119,44 @@ class Octree
          std::vector<size_t>& newFromOld,
          const size_t maxLeafSize = 20);
 
+  /**
+   * Construct this as the root node of an octree on the given dataset,
+   * presorting the points along the Morton (Z-order) curve before splitting.
+   * The presort makes the build and later leaf scans access memory in a
+   * cache-coherent order; the structure of the tree does not depend on the
+   * initial point order, so search results are unaffected.  The oldFromNew
+   * mapping accounts for the presort as well as the rearrangement done by
+   * splitting.  This copies the dataset; if you don't want that, consider
+   * using the overload that takes an rvalue reference and use std::move().
+   *
+   * @param data Dataset to create tree from.  This will be copied!
+   * @param oldFromNew Vector which will be filled with the old positions for
+   *      each new point.
+   * @param presort Tag to select Z-order presorting (math::ZOrderPresort()).
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(const MatType& data,
+         std::vector<size_t>& oldFromNew,
+         const math::ZOrderPresort presort,
+         const size_t maxLeafSize = 20);
+
+  /**
+   * Construct this as the root node of an octree on the given dataset,
+   * presorting the points along the Morton (Z-order) curve before splitting
+   * (see the copying overload for details).  This will take ownership of the
+   * dataset.
+   *
+   * @param data Dataset to create tree from.
+   * @param oldFromNew Vector which will be filled with the old positions for
+   *      each new point.
+   * @param presort Tag to select Z-order presorting (math::ZOrderPresort()).
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(MatType&& data,
+         std::vector<size_t>& oldFromNew,
+         const math::ZOrderPresort presort,
+         const size_t maxLeafSize = 20);
+
   /**
    * Construct this as the root node of an octree on the given dataset.  This
    * will take ownership of the dataset; if you don't want this, consider using
@@ -249,6 +295,24 @@ class Octree
    */
   ~Octree();
 
+  //! Node storage comes from the pooled allocator in node_pool.hpp, keeping
+  //! sibling nodes adjacent in memory.
+  void* operator new(const size_t size)
+  {
+    if (size == sizeof(Octree))
+      return NodePool<sizeof(Octree)>::Allocate();
+    return ::operator new(size);
+  }
+
+  //! Give node storage back to the pool.
+  void operator delete(void* memory, const size_t size)
+  {
+    if (size == sizeof(Octree))
+      NodePool<sizeof(Octree)>::Deallocate(memory);
+    else
+      ::operator delete(memory);
+  }
+
   //! Return the dataset used by this node.
   const MatType& Dataset() const { return *dataset; }
 
@@ -351,6 +415,24 @@ class Octree
    */
   Octree*& ChildPtr(const size_t child) { return children[child]; }
 
+  /**
+   * Return the hyperoctant occupied by the given child.  Bit d of the octant
+   * index is set if the child lies on the upper side of the split center in
+   * dimension d.  Children are stored in ascending octant order, so iterating
+   * over the children of a node visits the dataset in Morton (Z-curve) order.
+   * If the index is out of bounds, unspecified behavior will occur.
+   */
+  size_t ChildOctant(const size_t child) const { return childOctants[child]; }
+
+  /**
+   * Return the index of the child occupying the given hyperoctant, or
+   * NumChildren() if that octant holds no points.  Combined with
+   * ChildOctant(), this gives sibling adjacency without any geometry: the
+   * neighbor of child i across dimension d, if it exists, is
+   * ChildWithOctant(ChildOctant(i) ^ (1 << d)).
+   */
+  size_t ChildWithOctant(const size_t octant) const;
+
   //! Return the number of points in this node (0 if not a leaf).
   size_t NumPoints() const;
 
@@ -145,6 +145,96 @@ Octree<MetricType, StatisticType, MatType>::Octree(
     newFromOld[oldFromNew[i]] = i;
 }
 
+//! Construct the tree, presorting along the Z-order curve.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>::Octree(
+    const MatType& dataset,
+    std::vector<size_t>& oldFromNew,
+    const math::ZOrderPresort /* presort */,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(dataset)),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  // Reorder the copied dataset along the Z-order curve.  Initializing
+  // oldFromNew to the presort permutation (instead of the identity) composes
+  // it with the rearrangement done by the splits below, since the splits swap
+  // mapping entries whenever they swap columns.
+  math::ZOrderPoints(*this->dataset, oldFromNew);
+
+  if (count > 0)
+  {
+    // Calculate empirical center of data.
+    bound |= *this->dataset;
+    arma::vec center;
+    bound.Center(center);
+
+    double maxWidth = 0.0;
+    for (size_t i = 0; i < bound.Dim(); ++i)
+      if (bound[i].Hi() - bound[i].Lo() > maxWidth)
+        maxWidth = bound[i].Hi() - bound[i].Lo();
+
+    SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+
+    furthestDescendantDistance = 0.5 * bound.Diameter();
+  }
+  else
+  {
+    furthestDescendantDistance = 0.0;
+  }
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
+//! Construct the tree, presorting along the Z-order curve.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>::Octree(
+    MatType&& dataset,
+    std::vector<size_t>& oldFromNew,
+    const math::ZOrderPresort /* presort */,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(std::move(dataset))),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  // Reorder the dataset along the Z-order curve.  Initializing oldFromNew to
+  // the presort permutation (instead of the identity) composes it with the
+  // rearrangement done by the splits below, since the splits swap mapping
+  // entries whenever they swap columns.
+  math::ZOrderPoints(*this->dataset, oldFromNew);
+
+  if (count > 0)
+  {
+    // Calculate empirical center of data.
+    bound |= *this->dataset;
+    arma::vec center;
+    bound.Center(center);
+
+    double maxWidth = 0.0;
+    for (size_t i = 0; i < bound.Dim(); ++i)
+      if (bound[i].Hi() - bound[i].Lo() > maxWidth)
+        maxWidth = bound[i].Hi() - bound[i].Lo();
+
+    SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+
+    furthestDescendantDistance = 0.5 * bound.Diameter();
+  }
+  else
+  {
+    furthestDescendantDistance = 0.0;
+  }
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
 //! Construct the tree.
 template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(MatType&& dataset,
@@ -343,6 +433,7 @@ Octree<MetricType, StatisticType, MatType>::Octree(
 //! Copy the given tree.
 template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(const Octree& other) :
+    childOctants(other.childOctants),
     begin(other.begin),
     count(other.count),
     bound(other.bound),
@@ -379,6 +470,7 @@ operator=(const Octree& other)
     delete children[i];
   children.clear();
 
+  childOctants = other.childOctants;
   begin = other.Begin();
   count = other.Count();
   bound = other.bound;
@@ -404,6 +496,7 @@ operator=(const Octree& other)
 template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(Octree&& other) :
     children(std::move(other.children)),
+    childOctants(std::move(other.childOctants)),
     begin(other.begin),
     count(other.count),
     bound(std::move(other.bound)),
@@ -443,6 +536,7 @@ operator=(Octree&& other)
   children.clear();
 
   children = std::move(other.children);
+  childOctants = std::move(other.childOctants);
   begin = other.Begin();
   count = other.Count();
   bound = std::move(other.bound);
@@ -511,14 +605,29 @@ size_t Octree<MetricType, StatisticType, MatType>::NumChildren() const
   return children.size();
 }
 
+template<typename MetricType, typename StatisticType, typename MatType>
+size_t Octree<MetricType, StatisticType, MatType>::ChildWithOctant(
+    const size_t octant) const
+{
+  // childOctants is sorted in ascending order, since children are created in
+  // octant order.
+  std::vector<size_t>::const_iterator it = std::lower_bound(
+      childOctants.begin(), childOctants.end(), octant);
+  if (it != childOctants.end() && *it == octant)
+    return (size_t) (it - childOctants.begin());
+  return NumChildren();
+}
+
 template<typename MetricType, typename StatisticType, typename MatType>
 template<typename VecType>
 size_t Octree<MetricType, StatisticType, MatType>::GetNearestChild(
     const VecType& point,
     typename std::enable_if_t<IsVector<VecType>::value>*) const
 {
-  // It's possible that this could be improved by caching which children we have
-  // and which we don't, but for now this is just a brute force search.
+  // The bounds are fitted to the points, not to the octant cells, so the
+  // child occupying the point's octant is not necessarily the nearest; we
+  // have to check every child.  But nothing can beat a zero distance, so we
+  // can stop as soon as we find a child whose bound contains the point.
   ElemType bestDistance = DBL_MAX;
   size_t bestIndex = NumChildren();
   for (size_t i = 0; i < NumChildren(); ++i)
@@ -528,6 +637,9 @@ size_t Octree<MetricType, StatisticType, MatType>::GetNearestChild(
     {
       bestDistance = dist;
       bestIndex = i;
+
+      if (bestDistance == 0.0)
+        break;
     }
   }
 
@@ -561,8 +673,9 @@ template<typename MetricType, typename StatisticType, typename MatType>
 size_t Octree<MetricType, StatisticType, MatType>::GetNearestChild(
     const Octree& queryNode) const
 {
-  // It's possible that this could be improved by caching which children we have
-  // and which we don't, but for now this is just a brute force search.
+  // The bounds are fitted to the points, not to the octant cells, so we have
+  // to check every child; but nothing can beat a zero distance, so we can
+  // stop as soon as we find a child whose bound overlaps the query node.
   ElemType bestDistance = DBL_MAX;
   size_t bestIndex = NumChildren();
   for (size_t i = 0; i < NumChildren(); ++i)
@@ -572,6 +685,9 @@ size_t Octree<MetricType, StatisticType, MatType>::GetNearestChild(
     {
       bestDistance = dist;
       bestIndex = i;
+
+      if (bestDistance == 0.0)
+        break;
     }
   }
 
@@ -742,6 +858,7 @@ void Octree<MetricType, StatisticType, MatType>::serialize(
   }
 
   ar(CEREAL_VECTOR_POINTER(children));
+  ar(CEREAL_NVP(childOctants));
 
   if (cereal::is_loading<Archive>())
   {
@@ -868,6 +985,7 @@ void Octree<MetricType, StatisticType, MatType>::SplitNode(
     children.push_back(new Octree(this, childBegins[i],
         childBegins[i + 1] - childBegins[i], childCenter, childWidth,
         maxLeafSize));
+    childOctants.push_back(i);
   }
 }
 
@@ -970,6 +1088,7 @@ void Octree<MetricType, StatisticType, MatType>::SplitNode(
     children.push_back(new Octree(this, childBegins[i],
         childBegins[i + 1] - childBegins[i], oldFromNew, childCenter,
         childWidth, maxLeafSize));
+    childOctants.push_back(i);
   }
 }
 
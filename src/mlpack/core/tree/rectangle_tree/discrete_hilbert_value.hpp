@@ -240,6 +240,30 @@ class DiscreteHilbertValue
   static int CompareValues(const arma::Col<HilbertElemType>& value1,
                            const arma::Col<HilbertElemType>& value2);
 
+  /**
+   * Return the index of the first point of the node whose Hilbert value is
+   * greater than the given value.  The points of a node are stored in Hilbert
+   * order, so this is a binary search; the result is the position at which a
+   * point with this value would be inserted, and the first index a scan for
+   * the value does not need to look at.
+   *
+   * @param value The Hilbert value to search for.
+   */
+  size_t UpperBound(const arma::Col<HilbertElemType>& value) const;
+
+  /**
+   * Return the index of the first point of the node whose Hilbert value is
+   * greater than the Hilbert value of the given point.  This method computes
+   * the Hilbert value of the point and then binary-searches the sorted local
+   * Hilbert values.
+   *
+   * @param pt The point to search for.
+   */
+  template<typename VecType>
+  size_t UpperBound(
+      const VecType& pt,
+      typename std::enable_if_t<IsVector<VecType>::value>* = 0) const;
+
   //! Return the number of values.
   size_t NumValues() const { return numValues; }
   //! Modify the number of values.
@@ -354,10 +354,9 @@ InsertPoint(TreeType *node,
     *valueToInsert = CalculateValue(pt);
   if (node->IsLeaf())
   {
-    // Find an appropriate place.
-    for (i = 0; i < numValues; ++i)
-      if (CompareValues(localHilbertValues->col(i), *valueToInsert) > 0)
-        break;
+    // The local Hilbert values are sorted, so the place can be found with a
+    // binary search.
+    i = UpperBound(*valueToInsert);
 
     for (size_t j = numValues; j > i; j--)
       localHilbertValues->col(j) = localHilbertValues->col(j-1);
@@ -378,6 +377,34 @@ InsertPoint(TreeType *node,
   return i;
 }
 
+template<typename TreeElemType>
+size_t DiscreteHilbertValue<TreeElemType>::UpperBound(
+    const arma::Col<HilbertElemType>& value) const
+{
+  size_t lo = 0;
+  size_t hi = numValues;
+
+  while (lo < hi)
+  {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (CompareValues(localHilbertValues->col(mid), value) > 0)
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+
+  return lo;
+}
+
+template<typename TreeElemType>
+template<typename VecType>
+size_t DiscreteHilbertValue<TreeElemType>::UpperBound(
+    const VecType& pt,
+    typename std::enable_if_t<IsVector<VecType>::value>*) const
+{
+  return UpperBound(CalculateValue(pt));
+}
+
 template<typename TreeElemType>
 template<typename TreeType>
 void DiscreteHilbertValue<TreeElemType>::InsertNode(TreeType* node)
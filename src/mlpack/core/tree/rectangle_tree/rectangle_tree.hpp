@@ -16,6 +16,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include "../hrectbound.hpp"
+#include "../node_pool.hpp"
 #include "../statistic.hpp"
 #include "r_tree_split.hpp"
 #include "r_tree_descent_heuristic.hpp"
@@ -24,6 +25,34 @@
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
 
+/**
+ * A tag type passed to the RectangleTree constructors to select bulk loading
+ * (sort-tile-recursive packing) instead of one-by-one insertion.  See the
+ * bulk-loading constructors of RectangleTree for details.
+ */
+struct StrBulkLoad { };
+
+/**
+ * Detect whether an auxiliary information type maintains a Hilbert value
+ * (i.e. whether the tree keeps its points ordered along a Hilbert curve).
+ * The bulk loader uses this to pick a point ordering that preserves the
+ * auxiliary information's invariants.
+ */
+template<typename AuxType>
+class HasHilbertValue
+{
+ private:
+  template<typename T>
+  static std::true_type Check(typename std::remove_reference<
+      decltype(std::declval<T&>().HilbertValue())>::type*);
+
+  template<typename T>
+  static std::false_type Check(...);
+
+ public:
+  static const bool value = decltype(Check<AuxType>(0))::value;
+};
+
 /**
  * A rectangle type tree tree, such as an R-tree or X-tree.  Once the
  * bound and type of dataset is defined, the tree will construct itself.  Call
@@ -156,6 +185,68 @@ class RectangleTree
                 const size_t minNumChildren = 2,
                 const size_t firstDataIndex = 0);
 
+  /**
+   * Construct this as the root node of a rectangle type tree by bulk loading:
+   * instead of inserting the points one by one (with repeated node splits),
+   * the points are ordered with the sort-tile-recursive (STR) algorithm and
+   * packed into full leaves, and the upper levels are packed on top of them
+   * level by level.  This produces a tree with near-100% node occupancy in a
+   * small fraction of the time that incremental insertion takes, and leaf
+   * construction is parallelized with OpenMP.
+   *
+   * For trees whose auxiliary information keeps the points in Hilbert order
+   * (HilbertRTree), the points are sorted along the Hilbert curve instead of
+   * tiled, which preserves the ordering invariants of that variant.  The R+
+   * and R++ variants maintain disjointness invariants that packing does not
+   * guarantee, so they should be built with the insertion constructors
+   * instead.
+   *
+   * The tree remains fully dynamic afterwards: points may still be inserted
+   * and deleted, with splits happening as usual.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param tag Tag object selecting this constructor (pass StrBulkLoad()).
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node
+   *      may have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node
+   *      may have.
+   * @param firstDataIndex The index of the first data point.  UNUSED UNLESS WE
+   *      ADD SUPPORT FOR HAVING A "CENTERAL" DATA MATRIX.
+   */
+  RectangleTree(const MatType& data,
+                const StrBulkLoad tag,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2,
+                const size_t firstDataIndex = 0);
+
+  /**
+   * Construct this as the root node of a rectangle type tree by bulk loading,
+   * taking ownership of the given dataset.  See the copying bulk-load
+   * constructor for a description of the algorithm.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param tag Tag object selecting this constructor (pass StrBulkLoad()).
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node
+   *      may have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node
+   *      may have.
+   * @param firstDataIndex The index of the first data point.  UNUSED UNLESS WE
+   *      ADD SUPPORT FOR HAVING A "CENTERAL" DATA MATRIX.
+   */
+  RectangleTree(MatType&& data,
+                const StrBulkLoad tag,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2,
+                const size_t firstDataIndex = 0);
+
   /**
    * Construct this as an empty node with the specified parent.  Copying the
    * parameters (maxLeafSize, minLeafSize, maxNumChildren, minNumChildren,
@@ -215,6 +306,25 @@ class RectangleTree
    */
   ~RectangleTree();
 
+  //! Rectangle tree nodes are repeatedly created and destroyed by splits and
+  //! re-insertions, so their storage is recycled through the node pool
+  //! (node_pool.hpp).
+  void* operator new(const size_t size)
+  {
+    if (size == sizeof(RectangleTree))
+      return NodePool<sizeof(RectangleTree)>::Allocate();
+    return ::operator new(size);
+  }
+
+  //! Return node storage to the pool.
+  void operator delete(void* memory, const size_t size)
+  {
+    if (size == sizeof(RectangleTree))
+      NodePool<sizeof(RectangleTree)>::Deallocate(memory);
+    else
+      ::operator delete(memory);
+  }
+
   /**
    * Delete this node of the tree, but leave the stuff contained in it intact.
    * This is used when splitting a node, where the data in this tree is moved to
@@ -564,6 +674,71 @@ class RectangleTree
    */
   void BuildStatistics(RectangleTree* node);
 
+  /**
+   * Bulk-load the points [firstDataIndex, dataset->n_cols) into this (root)
+   * node: order the points, pack them into leaves, and pack the upper levels
+   * bottom-up.  Called by the bulk-loading constructors.
+   *
+   * @param firstDataIndex The index of the first data point.
+   */
+  void BulkLoad(const size_t firstDataIndex);
+
+  /**
+   * Compute the order in which points are packed into leaves, using
+   * sort-tile-recursive tiling (see StrTile()).  On output, runs[k] holds the
+   * half-open range of `indices` that makes up the k-th leaf.
+   */
+  template<typename T = AuxiliaryInformation>
+  static typename std::enable_if<!HasHilbertValue<T>::value, void>::type
+  BulkLoadOrder(const MatType& data,
+                std::vector<size_t>& indices,
+                const size_t numLeaves,
+                std::vector<std::pair<size_t, size_t>>& runs);
+
+  /**
+   * Compute the order in which points are packed into leaves for trees that
+   * keep their points in Hilbert order: sort the points along the Hilbert
+   * curve and cut the sorted sequence into consecutive leaves, so that the
+   * ordering invariants of the auxiliary information hold in the packed tree.
+   */
+  template<typename T = AuxiliaryInformation>
+  static typename std::enable_if<HasHilbertValue<T>::value, void>::type
+  BulkLoadOrder(const MatType& data,
+                std::vector<size_t>& indices,
+                const size_t numLeaves,
+                std::vector<std::pair<size_t, size_t>>& runs);
+
+  /**
+   * Recursively tile indices[begin:end] into numLeaves leaf runs with the
+   * sort-tile-recursive algorithm: sort the range along dimension `dim`, cut
+   * it into slabs, and recurse into each slab along the next dimension.
+   * Large slabs are processed as parallel OpenMP tasks.
+   *
+   * @param data Dataset the indices point into.
+   * @param indices Point indices being ordered.
+   * @param begin First position of the range to tile.
+   * @param end One past the last position of the range to tile.
+   * @param numLeaves Number of leaf runs to cut this range into.
+   * @param dim Dimension to sort along at this level of the recursion.
+   * @param runs Output leaf runs (preallocated by the caller).
+   * @param runOffset Position in `runs` of this range's first leaf.
+   */
+  static void StrTile(const MatType& data,
+                      std::vector<size_t>& indices,
+                      const size_t begin,
+                      const size_t end,
+                      const size_t numLeaves,
+                      const size_t dim,
+                      std::vector<std::pair<size_t, size_t>>& runs,
+                      const size_t runOffset);
+
+  /**
+   * Attach an already-built node as a child of the given parent during bulk
+   * loading, updating the parent's bound, descendant count and auxiliary
+   * information.
+   */
+  static void BulkLoadAttach(RectangleTree* parentNode, RectangleTree* child);
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
@@ -121,6 +121,330 @@ RectangleTree(MatType&& data,
   BuildStatistics(this);
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(const MatType& data,
+              const StrBulkLoad /* tag */,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren,
+              const size_t firstDataIndex) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(data)),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this)
+{
+  BulkLoad(firstDataIndex);
+
+  // Initialize statistic recursively after tree construction is complete.
+  BuildStatistics(this);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(MatType&& data,
+              const StrBulkLoad /* tag */,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren,
+              const size_t firstDataIndex) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(std::move(data))),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this)
+{
+  BulkLoad(firstDataIndex);
+
+  // Initialize statistic recursively after tree construction is complete.
+  BuildStatistics(this);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+    BulkLoad(const size_t firstDataIndex)
+{
+  if (dataset->n_cols <= firstDataIndex)
+    return;
+
+  const size_t numPoints = dataset->n_cols - firstDataIndex;
+
+  // If everything fits into the root, it is a leaf; pack the points directly.
+  if (numPoints <= maxLeafSize)
+  {
+    for (size_t i = firstDataIndex; i < dataset->n_cols; ++i)
+    {
+      bound |= dataset->col(i);
+      numDescendants++;
+      if (!auxiliaryInfo.HandlePointInsertion(this, i))
+        points[count++] = i;
+    }
+    return;
+  }
+
+  // Order the points and cut them into leaf-sized runs.  Cutting at
+  // (numPoints * k) / numLeaves gives runs whose sizes differ by at most one,
+  // so every leaf is within one point of full.
+  std::vector<size_t> indices(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    indices[i] = firstDataIndex + i;
+
+  const size_t numLeaves = (numPoints + maxLeafSize - 1) / maxLeafSize;
+  std::vector<std::pair<size_t, size_t>> runs(numLeaves);
+  BulkLoadOrder<>(*dataset, indices, numLeaves, runs);
+
+  // Build the leaves.  Each leaf touches only its own run of points, so the
+  // leaves can be built in parallel; this is where the bound computations and
+  // the auxiliary information updates happen.
+  std::vector<RectangleTree*> level(numLeaves);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numLeaves; ++i)
+  {
+    RectangleTree* leaf = new RectangleTree(this);
+    for (size_t j = runs[i].first; j < runs[i].second; ++j)
+    {
+      const size_t index = indices[j];
+      leaf->bound |= dataset->col(index);
+      leaf->numDescendants++;
+      if (!leaf->auxiliaryInfo.HandlePointInsertion(leaf, index))
+        leaf->points[leaf->count++] = index;
+    }
+    level[i] = leaf;
+  }
+
+  // Pack the upper levels bottom-up.  Nodes that are adjacent in the ordering
+  // are close in space, so grouping consecutive runs of children keeps the
+  // parent bounds tight.  The nodes of each level are distributed evenly over
+  // the parents, so no parent ends up nearly empty.
+  while (level.size() > maxNumChildren)
+  {
+    const size_t numParents =
+        (level.size() + maxNumChildren - 1) / maxNumChildren;
+    std::vector<RectangleTree*> nextLevel(numParents);
+
+    size_t childIndex = 0;
+    for (size_t i = 0; i < numParents; ++i)
+    {
+      const size_t take = level.size() / numParents +
+          ((i < level.size() % numParents) ? 1 : 0);
+
+      RectangleTree* parentNode = new RectangleTree(this);
+      for (size_t j = 0; j < take; ++j)
+        BulkLoadAttach(parentNode, level[childIndex++]);
+
+      nextLevel[i] = parentNode;
+    }
+
+    level = std::move(nextLevel);
+  }
+
+  // The last level fits under the root.
+  for (size_t i = 0; i < level.size(); ++i)
+    BulkLoadAttach(this, level[i]);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename T>
+typename std::enable_if<!HasHilbertValue<T>::value, void>::type
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+    BulkLoadOrder(const MatType& data,
+                  std::vector<size_t>& indices,
+                  const size_t numLeaves,
+                  std::vector<std::pair<size_t, size_t>>& runs)
+{
+  // The OpenMP region allows large slabs to be tiled as parallel tasks; see
+  // StrTile().
+  #pragma omp parallel
+  #pragma omp single
+  StrTile(data, indices, 0, indices.size(), numLeaves, 0, runs, 0);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename T>
+typename std::enable_if<HasHilbertValue<T>::value, void>::type
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+    BulkLoadOrder(const MatType& data,
+                  std::vector<size_t>& indices,
+                  const size_t numLeaves,
+                  std::vector<std::pair<size_t, size_t>>& runs)
+{
+  // Sorting along the Hilbert curve (instead of tiling) means that both the
+  // points within each leaf and the leaves themselves end up in Hilbert
+  // order, which is exactly the invariant the auxiliary information
+  // maintains during incremental insertion.
+  typedef typename std::remove_reference<
+      decltype(std::declval<T&>().HilbertValue())>::type HilbertValueType;
+
+  std::sort(indices.begin(), indices.end(),
+      [&data](const size_t a, const size_t b)
+      {
+        return HilbertValueType::ComparePoints(data.col(a), data.col(b)) < 0;
+      });
+
+  const size_t numPoints = indices.size();
+  for (size_t k = 0; k < numLeaves; ++k)
+  {
+    runs[k] = std::make_pair((numPoints * k) / numLeaves,
+                             (numPoints * (k + 1)) / numLeaves);
+  }
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+    StrTile(const MatType& data,
+            std::vector<size_t>& indices,
+            const size_t begin,
+            const size_t end,
+            const size_t numLeaves,
+            const size_t dim,
+            std::vector<std::pair<size_t, size_t>>& runs,
+            const size_t runOffset)
+{
+  if (numLeaves == 1)
+  {
+    runs[runOffset] = std::make_pair(begin, end);
+    return;
+  }
+
+  // Sort this range of indices along the current dimension.
+  std::sort(indices.begin() + begin, indices.begin() + end,
+      [&data, dim](const size_t a, const size_t b)
+      {
+        return data(dim, a) < data(dim, b);
+      });
+
+  const size_t numPoints = end - begin;
+
+  // In the last dimension there is nothing left to tile: cut the sorted range
+  // into equal-sized leaf runs.
+  if (dim + 1 == data.n_rows)
+  {
+    for (size_t k = 0; k < numLeaves; ++k)
+    {
+      runs[runOffset + k] = std::make_pair(
+          begin + (numPoints * k) / numLeaves,
+          begin + (numPoints * (k + 1)) / numLeaves);
+    }
+    return;
+  }
+
+  // Cut the range into ceil(numLeaves^(1 / remainingDims)) slabs, so that the
+  // recursion produces roughly cubic tiles.  Slab boundaries are placed on
+  // leaf boundaries, so the slabs can never be cut into overfull leaves.
+  const size_t remainingDims = data.n_rows - dim;
+  size_t numSlabs = (size_t) std::ceil(
+      std::pow((double) numLeaves, 1.0 / remainingDims));
+  if (numSlabs > numLeaves)
+    numSlabs = numLeaves;
+
+  size_t cumLeaves = 0;
+  for (size_t s = 0; s < numSlabs; ++s)
+  {
+    size_t slabLeaves = numLeaves / numSlabs +
+        ((s < numLeaves % numSlabs) ? 1 : 0);
+    size_t slabBegin = begin + (numPoints * cumLeaves) / numLeaves;
+    size_t slabEnd =
+        begin + (numPoints * (cumLeaves + slabLeaves)) / numLeaves;
+    size_t slabRunOffset = runOffset + cumLeaves;
+
+    // Slabs are disjoint ranges of `indices` and `runs`, so large slabs can
+    // be tiled as parallel tasks; small slabs are tiled serially to avoid
+    // task scheduling overhead.
+    #pragma omp task default(shared) \
+        firstprivate(slabBegin, slabEnd, slabLeaves, slabRunOffset) \
+        if (slabEnd - slabBegin > 8192)
+    StrTile(data, indices, slabBegin, slabEnd, slabLeaves, dim + 1, runs,
+        slabRunOffset);
+
+    cumLeaves += slabLeaves;
+  }
+  #pragma omp taskwait
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+    BulkLoadAttach(RectangleTree* parentNode, RectangleTree* child)
+{
+  parentNode->bound |= child->bound;
+  parentNode->numDescendants += child->numDescendants;
+
+  // Children are attached in packing order, which is already the order the
+  // tree variant expects (for Hilbert trees the nodes arrive in ascending
+  // Hilbert order), so the child is appended directly.  The auxiliary
+  // information is still told about the insertion, so that per-node data such
+  // as the largest Hilbert value stays correct.
+  parentNode->children[parentNode->numChildren++] = child;
+  child->parent = parentNode;
+  parentNode->auxiliaryInfo.HandleNodeInsertion(parentNode, child, false);
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -0,0 +1,258 @@
+/**
+ * @file core/tree/sparse_hrectbound.hpp
+ *
+ * Bounds that are useful for binary space partitioning trees.
+ *
+ * This file describes the interface for the SparseHRectBound class, a
+ * hyperrectangle bound that only stores ranges for the dimensions in which
+ * some point is nonzero.  All other dimensions implicitly have the range
+ * [0, 0], which is exact for sparse data.  This keeps the memory use of a
+ * tree node proportional to the number of dimensions its points touch
+ * instead of the full dimensionality, which makes space trees feasible on
+ * high-dimensional sparse data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_SPARSE_HRECTBOUND_HPP
+#define MLPACK_CORE_TREE_SPARSE_HRECTBOUND_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/range.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include "bound_traits.hpp"
+#include "hrectbound.hpp"
+
+#include <cereal/types/map.hpp>
+
+#include <map>
+
+namespace mlpack {
+namespace bound {
+
+/**
+ * Hyper-rectangle bound for an L-metric that stores ranges sparsely.  Only
+ * the dimensions in which some enclosed point is nonzero get an explicit
+ * range; every other dimension implicitly has the range [0, 0].  The bounds
+ * are still tight per dimension: expanding with a sparse matrix accounts for
+ * the implicit zeros of the points, so a dimension whose column is not
+ * entirely nonzero gets a range containing zero.
+ *
+ * The distance computations walk the union of the stored dimensions (and,
+ * for point distances, the nonzero dimensions of the point), so their cost
+ * is proportional to the number of stored ranges rather than the full
+ * dimensionality.  This should be used with sparse matrix types; it works
+ * with dense data too but then has no advantage over HRectBound.
+ *
+ * @tparam MetricType Type of metric to use; must be of type LMetric.
+ * @tparam ElemType Element type (double/float/int/etc.).
+ */
+template<typename MetricType = metric::LMetric<2, true>,
+         typename ElemType = double>
+class SparseHRectBound
+{
+  // It is required that SparseHRectBound have an LMetric as the given
+  // MetricType.
+  static_assert(meta::IsLMetric<MetricType>::Value == true,
+      "SparseHRectBound can only be used with the LMetric<> metric type.");
+
+ public:
+  /**
+   * Empty constructor; creates a bound of dimensionality 0.
+   */
+  SparseHRectBound();
+
+  /**
+   * Initializes to specified dimensionality, containing no points.
+   *
+   * @param dimension Dimensionality of bound.
+   */
+  SparseHRectBound(const size_t dimension);
+
+  /**
+   * Resets the bound so that it contains no points.
+   */
+  void Clear();
+
+  //! Gets the dimensionality.
+  size_t Dim() const { return dim; }
+
+  //! Get the range for a particular dimension, creating an explicit [0, 0]
+  //! range for it if there is none.  No bounds checking.  Be careful: this
+  //! may make MinWidth() invalid.
+  math::RangeType<ElemType>& operator[](const size_t i);
+  //! Get the range for a particular dimension.  No bounds checking.
+  const math::RangeType<ElemType>& operator[](const size_t i) const;
+
+  //! Get the number of dimensions with an explicitly stored range.
+  size_t NumStoredDims() const { return ranges.size(); }
+
+  //! Get the minimum width of the bound.
+  ElemType MinWidth() const { return minWidth; }
+  //! Modify the minimum width of the bound.
+  ElemType& MinWidth() { return minWidth; }
+
+  //! Get the instantiated metric associated with the bound.
+  const MetricType& Metric() const { return metric; }
+  //! Modify the instantiated metric associated with the bound.
+  MetricType& Metric() { return metric; }
+
+  /**
+   * Calculates the center of the range, placing it into the given vector.
+   *
+   * @param center Vector which the center will be written to.
+   */
+  void Center(arma::Col<ElemType>& center) const;
+
+  /**
+   * Calculates minimum bound-to-point distance.
+   *
+   * @param point Point to which the minimum distance is requested.
+   */
+  template<typename VecType>
+  ElemType MinDistance(const VecType& point,
+                       typename std::enable_if_t<IsVector<VecType>::value>* = 0)
+      const;
+
+  /**
+   * Calculates minimum bound-to-bound distance.
+   *
+   * @param other Bound to which the minimum distance is requested.
+   */
+  ElemType MinDistance(const SparseHRectBound& other) const;
+
+  /**
+   * Calculates maximum bound-to-point squared distance.
+   *
+   * @param point Point to which the maximum distance is requested.
+   */
+  template<typename VecType>
+  ElemType MaxDistance(const VecType& point,
+                       typename std::enable_if_t<IsVector<VecType>::value>* = 0)
+      const;
+
+  /**
+   * Computes maximum distance.
+   *
+   * @param other Bound to which the maximum distance is requested.
+   */
+  ElemType MaxDistance(const SparseHRectBound& other) const;
+
+  /**
+   * Calculates minimum and maximum bound-to-bound distance.
+   *
+   * @param other Bound to which the minimum and maximum distances are
+   *     requested.
+   */
+  math::RangeType<ElemType> RangeDistance(const SparseHRectBound& other) const;
+
+  /**
+   * Calculates minimum and maximum bound-to-point distance.
+   *
+   * @param point Point to which the minimum and maximum distances are
+   *     requested.
+   */
+  template<typename VecType>
+  math::RangeType<ElemType> RangeDistance(
+      const VecType& point,
+      typename std::enable_if_t<IsVector<VecType>::value>* = 0) const;
+
+  /**
+   * Expands this region to include new points.
+   *
+   * @tparam MatType Type of matrix; could be SpMat, Mat, a subview, or just a
+   *   vector.
+   * @param data Data points to expand this region to include.
+   */
+  template<typename MatType>
+  SparseHRectBound& operator|=(const MatType& data);
+
+  /**
+   * Expands this region to encompass another bound.
+   */
+  SparseHRectBound& operator|=(const SparseHRectBound& other);
+
+  /**
+   * Determines if a point is within this bound.
+   *
+   * @param point Point to check the condition.
+   */
+  template<typename VecType>
+  bool Contains(const VecType& point) const;
+
+  /**
+   * Returns the diameter of the hyperrectangle (that is, the longest
+   * diagonal).
+   */
+  ElemType Diameter() const;
+
+  /**
+   * Serialize the bound object.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+ private:
+  /**
+   * Accumulate sum_d |point[d]|^Power over the nonzero dimensions of the
+   * point that have no stored range; those dimensions all have the implicit
+   * range [0, 0].  The sparse overload walks only the nonzero entries.
+   */
+  template<typename VecType>
+  typename std::enable_if<arma::is_arma_sparse_type<VecType>::value,
+      ElemType>::type
+  OutsideSum(const VecType& point) const;
+
+  template<typename VecType>
+  typename std::enable_if<!arma::is_arma_sparse_type<VecType>::value,
+      ElemType>::type
+  OutsideSum(const VecType& point) const;
+
+  /**
+   * Expand the stored ranges with the given data; the sparse overload walks
+   * only the nonzero entries and accounts for the implicit zeros of each
+   * column.
+   */
+  template<typename MatType>
+  typename std::enable_if<arma::is_arma_sparse_type<MatType>::value>::type
+  Expand(const MatType& data);
+
+  template<typename MatType>
+  typename std::enable_if<!arma::is_arma_sparse_type<MatType>::value>::type
+  Expand(const MatType& data);
+
+  //! Recompute the cached minimum width after the ranges have changed.
+  void UpdateMinWidth();
+
+  //! The dimensionality of the bound.
+  size_t dim;
+  //! The explicitly stored ranges, keyed by dimension; dimensions with no
+  //! entry have the implicit range [0, 0].
+  std::map<size_t, math::RangeType<ElemType>> ranges;
+  //! Whether any points have been added to the bound; until then the
+  //! implicit [0, 0] ranges do not apply.
+  bool hasPoints;
+  //! Cached minimum width of bound.
+  ElemType minWidth;
+  //! Instantiated metric (likely has size 0).
+  MetricType metric;
+  //! The implicit range of every dimension with no stored range.
+  static const math::RangeType<ElemType> defaultRange;
+};
+
+// A specialization of BoundTraits for this class.
+template<typename MetricType, typename ElemType>
+struct BoundTraits<SparseHRectBound<MetricType, ElemType>>
+{
+  //! These bounds are always tight for each dimension.
+  const static bool HasTightBounds = true;
+};
+
+} // namespace bound
+} // namespace mlpack
+
+#include "sparse_hrectbound_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_SPARSE_HRECTBOUND_HPP
@@ -0,0 +1,834 @@
+/**
+ * @file core/tree/sparse_hrectbound_impl.hpp
+ *
+ * Implementation of the sparse hyper-rectangle bound policy class.
+ * Template parameter Power is the metric to use; use 2 for Euclidean (L2).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_SPARSE_HRECTBOUND_IMPL_HPP
+#define MLPACK_CORE_TREE_SPARSE_HRECTBOUND_IMPL_HPP
+
+#include <math.h>
+
+// In case it has not been included yet.
+#include "sparse_hrectbound.hpp"
+
+namespace mlpack {
+namespace bound {
+
+//! The implicit range of every dimension with no stored range.
+template<typename MetricType, typename ElemType>
+const math::RangeType<ElemType>
+SparseHRectBound<MetricType, ElemType>::defaultRange(0, 0);
+
+/**
+ * Empty constructor.
+ */
+template<typename MetricType, typename ElemType>
+inline SparseHRectBound<MetricType, ElemType>::SparseHRectBound() :
+    dim(0),
+    hasPoints(false),
+    minWidth(0)
+{ /* Nothing to do. */ }
+
+/**
+ * Initializes to specified dimensionality, containing no points.
+ */
+template<typename MetricType, typename ElemType>
+inline SparseHRectBound<MetricType, ElemType>::SparseHRectBound(
+    const size_t dimension) :
+    dim(dimension),
+    hasPoints(false),
+    minWidth(0)
+{ /* Nothing to do. */ }
+
+/**
+ * Resets the bound so that it contains no points.
+ */
+template<typename MetricType, typename ElemType>
+inline void SparseHRectBound<MetricType, ElemType>::Clear()
+{
+  ranges.clear();
+  hasPoints = false;
+  minWidth = 0;
+}
+
+template<typename MetricType, typename ElemType>
+inline math::RangeType<ElemType>&
+SparseHRectBound<MetricType, ElemType>::operator[](const size_t i)
+{
+  // A mutable reference may be written to, so the implicit range has to be
+  // made explicit.
+  typename std::map<size_t, math::RangeType<ElemType>>::iterator it =
+      ranges.find(i);
+  if (it == ranges.end())
+    it = ranges.emplace(i, defaultRange).first;
+  return it->second;
+}
+
+template<typename MetricType, typename ElemType>
+inline const math::RangeType<ElemType>&
+SparseHRectBound<MetricType, ElemType>::operator[](const size_t i) const
+{
+  typename std::map<size_t, math::RangeType<ElemType>>::const_iterator it =
+      ranges.find(i);
+  return (it == ranges.end()) ? defaultRange : it->second;
+}
+
+/**
+ * Calculates the center of the range, placing it into the given vector.
+ */
+template<typename MetricType, typename ElemType>
+inline void SparseHRectBound<MetricType, ElemType>::Center(
+    arma::Col<ElemType>& center) const
+{
+  // Every dimension with no stored range has center zero.
+  center.zeros(dim);
+
+  for (const auto& range : ranges)
+    center(range.first) = range.second.Mid();
+}
+
+/**
+ * Calculates minimum bound-to-point squared distance.
+ */
+template<typename MetricType, typename ElemType>
+template<typename VecType>
+inline ElemType SparseHRectBound<MetricType, ElemType>::MinDistance(
+    const VecType& point,
+    typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+{
+  Log::Assert(point.n_elem == dim);
+
+  ElemType sum = 0;
+
+  ElemType lower, higher;
+  for (const auto& range : ranges)
+  {
+    const size_t d = range.first;
+    lower = range.second.Lo() - point[d];
+    higher = point[d] - range.second.Hi();
+
+    // Since only one of 'lower' or 'higher' is negative, if we add each's
+    // absolute value to itself and then sum those two, our result is the
+    // nonnegative half of the equation times two; then we raise to power
+    // Power.
+    if (MetricType::Power == 1)
+      sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+    else if (MetricType::Power == 2)
+    {
+      ElemType dist = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+      sum += dist * dist;
+    }
+    else
+    {
+      sum += pow((lower + fabs(lower)) + (higher + fabs(higher)),
+          (ElemType) MetricType::Power);
+    }
+  }
+
+  // Every dimension where the point is nonzero but no range is stored has the
+  // implicit range [0, 0]; the doubled one-sided distance there is
+  // 2 * |point[d]|, so the contribution is 2^Power times the plain sum.
+  sum += std::pow((ElemType) 2, (ElemType) MetricType::Power) *
+      OutsideSum(point);
+
+  // Now take the Power'th root (but make sure our result is squared if it needs
+  // to be); then cancel out the constant of 2 (which may have been squared now)
+  // that was introduced earlier.  The compiler should optimize out the if
+  // statement entirely.
+  if (MetricType::Power == 1)
+    return sum * 0.5;
+  else if (MetricType::Power == 2)
+  {
+    if (MetricType::TakeRoot)
+      return (ElemType) std::sqrt(sum) * 0.5;
+    else
+      return sum * 0.25;
+  }
+  else
+  {
+    if (MetricType::TakeRoot)
+      return (ElemType) pow((double) sum,
+          1.0 / (double) MetricType::Power) / 2.0;
+    else
+      return sum / pow(2.0, MetricType::Power);
+  }
+}
+
+/**
+ * Calculates minimum bound-to-bound squared distance.
+ */
+template<typename MetricType, typename ElemType>
+ElemType SparseHRectBound<MetricType, ElemType>::MinDistance(
+    const SparseHRectBound& other) const
+{
+  Log::Assert(dim == other.dim);
+
+  ElemType sum = 0;
+
+  // Walk the union of the stored dimensions of the two bounds; a dimension
+  // stored in neither contributes nothing, since both ranges are [0, 0].
+  typename std::map<size_t, math::RangeType<ElemType>>::const_iterator it1 =
+      ranges.cbegin();
+  typename std::map<size_t, math::RangeType<ElemType>>::const_iterator it2 =
+      other.ranges.cbegin();
+
+  ElemType lower, higher;
+  while (it1 != ranges.cend() || it2 != other.ranges.cend())
+  {
+    const math::RangeType<ElemType>* mbound;
+    const math::RangeType<ElemType>* obound;
+    if (it2 == other.ranges.cend() ||
+        (it1 != ranges.cend() && it1->first < it2->first))
+    {
+      mbound = &it1->second;
+      obound = &defaultRange;
+      ++it1;
+    }
+    else if (it1 == ranges.cend() || it2->first < it1->first)
+    {
+      mbound = &defaultRange;
+      obound = &it2->second;
+      ++it2;
+    }
+    else
+    {
+      mbound = &it1->second;
+      obound = &it2->second;
+      ++it1;
+      ++it2;
+    }
+
+    lower = obound->Lo() - mbound->Hi();
+    higher = mbound->Lo() - obound->Hi();
+    // We invoke the following:
+    //   x + fabs(x) = max(x * 2, 0)
+    //   (x * 2)^2 / 4 = x^2
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+      sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+    else if (MetricType::Power == 2)
+    {
+      ElemType dist = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
+      sum += dist * dist;
+    }
+    else
+    {
+      sum += pow((lower + fabs(lower)) + (higher + fabs(higher)),
+          (ElemType) MetricType::Power);
+    }
+  }
+
+  // The compiler should optimize out this if statement entirely.
+  if (MetricType::Power == 1)
+    return sum * 0.5;
+  else if (MetricType::Power == 2)
+  {
+    if (MetricType::TakeRoot)
+      return (ElemType) std::sqrt(sum) * 0.5;
+    else
+      return sum * 0.25;
+  }
+  else
+  {
+    if (MetricType::TakeRoot)
+      return (ElemType) pow((double) sum,
+          1.0 / (double) MetricType::Power) / 2.0;
+    else
+      return sum / pow(2.0, MetricType::Power);
+  }
+}
+
+/**
+ * Calculates maximum bound-to-point squared distance.
+ */
+template<typename MetricType, typename ElemType>
+template<typename VecType>
+inline ElemType SparseHRectBound<MetricType, ElemType>::MaxDistance(
+    const VecType& point,
+    typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+{
+  ElemType sum = 0;
+
+  Log::Assert(point.n_elem == dim);
+
+  for (const auto& range : ranges)
+  {
+    const size_t d = range.first;
+    ElemType v = std::max(fabs(point[d] - range.second.Lo()),
+        fabs(range.second.Hi() - point[d]));
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+      sum += v; // v is non-negative.
+    else if (MetricType::Power == 2)
+      sum += v * v;
+    else
+      sum += std::pow(v, (ElemType) MetricType::Power);
+  }
+
+  // Every dimension where the point is nonzero but no range is stored has the
+  // implicit range [0, 0]; the maximum distance there is |point[d]|.
+  sum += OutsideSum(point);
+
+  // The compiler should optimize out this if statement entirely.
+  if (MetricType::TakeRoot)
+  {
+    if (MetricType::Power == 1)
+      return sum;
+    else if (MetricType::Power == 2)
+      return (ElemType) std::sqrt(sum);
+    else
+      return (ElemType) pow((double) sum, 1.0 / (double) MetricType::Power);
+  }
+  else
+    return sum;
+}
+
+/**
+ * Computes maximum distance.
+ */
+template<typename MetricType, typename ElemType>
+inline ElemType SparseHRectBound<MetricType, ElemType>::MaxDistance(
+    const SparseHRectBound& other) const
+{
+  ElemType sum = 0;
+
+  Log::Assert(dim == other.dim);
+
+  typename std::map<size_t, math::RangeType<ElemType>>::const_iterator it1 =
+      ranges.cbegin();
+  typename std::map<size_t, math::RangeType<ElemType>>::const_iterator it2 =
+      other.ranges.cbegin();
+
+  ElemType v;
+  while (it1 != ranges.cend() || it2 != other.ranges.cend())
+  {
+    const math::RangeType<ElemType>* mbound;
+    const math::RangeType<ElemType>* obound;
+    if (it2 == other.ranges.cend() ||
+        (it1 != ranges.cend() && it1->first < it2->first))
+    {
+      mbound = &it1->second;
+      obound = &defaultRange;
+      ++it1;
+    }
+    else if (it1 == ranges.cend() || it2->first < it1->first)
+    {
+      mbound = &defaultRange;
+      obound = &it2->second;
+      ++it2;
+    }
+    else
+    {
+      mbound = &it1->second;
+      obound = &it2->second;
+      ++it1;
+      ++it2;
+    }
+
+    v = std::max(fabs(obound->Hi() - mbound->Lo()),
+        fabs(mbound->Hi() - obound->Lo()));
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+      sum += v; // v is non-negative.
+    else if (MetricType::Power == 2)
+      sum += v * v;
+    else
+      sum += std::pow(v, (ElemType) MetricType::Power);
+  }
+
+  // The compiler should optimize out this if statement entirely.
+  if (MetricType::TakeRoot)
+  {
+    if (MetricType::Power == 1)
+      return sum;
+    else if (MetricType::Power == 2)
+      return (ElemType) std::sqrt(sum);
+    else
+      return (ElemType) pow((double) sum, 1.0 / (double) MetricType::Power);
+  }
+  else
+    return sum;
+}
+
+/**
+ * Calculates minimum and maximum bound-to-bound squared distance.
+ */
+template<typename MetricType, typename ElemType>
+inline math::RangeType<ElemType>
+SparseHRectBound<MetricType, ElemType>::RangeDistance(
+    const SparseHRectBound& other) const
+{
+  ElemType loSum = 0;
+  ElemType hiSum = 0;
+
+  Log::Assert(dim == other.dim);
+
+  typename std::map<size_t, math::RangeType<ElemType>>::const_iterator it1 =
+      ranges.cbegin();
+  typename std::map<size_t, math::RangeType<ElemType>>::const_iterator it2 =
+      other.ranges.cbegin();
+
+  ElemType v1, v2, vLo, vHi;
+  while (it1 != ranges.cend() || it2 != other.ranges.cend())
+  {
+    const math::RangeType<ElemType>* mbound;
+    const math::RangeType<ElemType>* obound;
+    if (it2 == other.ranges.cend() ||
+        (it1 != ranges.cend() && it1->first < it2->first))
+    {
+      mbound = &it1->second;
+      obound = &defaultRange;
+      ++it1;
+    }
+    else if (it1 == ranges.cend() || it2->first < it1->first)
+    {
+      mbound = &defaultRange;
+      obound = &it2->second;
+      ++it2;
+    }
+    else
+    {
+      mbound = &it1->second;
+      obound = &it2->second;
+      ++it1;
+      ++it2;
+    }
+
+    v1 = obound->Lo() - mbound->Hi();
+    v2 = mbound->Lo() - obound->Hi();
+    // One of v1 or v2 is negative.
+    if (v1 >= v2)
+    {
+      vHi = -v2; // Make it nonnegative.
+      vLo = (v1 > 0) ? v1 : 0; // Force to be 0 if negative.
+    }
+    else
+    {
+      vHi = -v1; // Make it nonnegative.
+      vLo = (v2 > 0) ? v2 : 0; // Force to be 0 if negative.
+    }
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+    {
+      loSum += vLo; // vLo is non-negative.
+      hiSum += vHi; // vHi is non-negative.
+    }
+    else if (MetricType::Power == 2)
+    {
+      loSum += vLo * vLo;
+      hiSum += vHi * vHi;
+    }
+    else
+    {
+      loSum += std::pow(vLo, (ElemType) MetricType::Power);
+      hiSum += std::pow(vHi, (ElemType) MetricType::Power);
+    }
+  }
+
+  if (MetricType::TakeRoot)
+  {
+    if (MetricType::Power == 1)
+      return math::RangeType<ElemType>(loSum, hiSum);
+    else if (MetricType::Power == 2)
+      return math::RangeType<ElemType>((ElemType) std::sqrt(loSum),
+                                       (ElemType) std::sqrt(hiSum));
+    else
+    {
+      return math::RangeType<ElemType>(
+          (ElemType) pow((double) loSum, 1.0 / (double) MetricType::Power),
+          (ElemType) pow((double) hiSum, 1.0 / (double) MetricType::Power));
+    }
+  }
+  else
+    return math::RangeType<ElemType>(loSum, hiSum);
+}
+
+/**
+ * Calculates minimum and maximum bound-to-point squared distance.
+ */
+template<typename MetricType, typename ElemType>
+template<typename VecType>
+inline math::RangeType<ElemType>
+SparseHRectBound<MetricType, ElemType>::RangeDistance(
+    const VecType& point,
+    typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+{
+  ElemType loSum = 0;
+  ElemType hiSum = 0;
+
+  Log::Assert(point.n_elem == dim);
+
+  ElemType v1, v2, vLo, vHi;
+  for (const auto& range : ranges)
+  {
+    const size_t d = range.first;
+    v1 = range.second.Lo() - point[d]; // Negative if point[d] > lo.
+    v2 = point[d] - range.second.Hi(); // Negative if point[d] < hi.
+    // One of v1 or v2 (or both) is negative.
+    if (v1 >= 0) // point[d] <= bounds_[d].Lo().
+    {
+      vHi = -v2; // v2 will be larger but must be negated.
+      vLo = v1;
+    }
+    else // point[d] is between lo and hi, or greater than hi.
+    {
+      if (v2 >= 0)
+      {
+        vHi = -v1; // v1 will be larger, but must be negated.
+        vLo = v2;
+      }
+      else
+      {
+        vHi = -std::min(v1, v2); // Both are negative, but we need the larger.
+        vLo = 0;
+      }
+    }
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+    {
+      loSum += vLo; // vLo is non-negative.
+      hiSum += vHi; // vHi is non-negative.
+    }
+    else if (MetricType::Power == 2)
+    {
+      loSum += vLo * vLo;
+      hiSum += vHi * vHi;
+    }
+    else
+    {
+      loSum += std::pow(vLo, (ElemType) MetricType::Power);
+      hiSum += std::pow(vHi, (ElemType) MetricType::Power);
+    }
+  }
+
+  // Every dimension where the point is nonzero but no range is stored has the
+  // implicit range [0, 0]; both the minimum and maximum distance there are
+  // |point[d]|.
+  const ElemType outside = OutsideSum(point);
+  loSum += outside;
+  hiSum += outside;
+
+  if (MetricType::TakeRoot)
+  {
+    if (MetricType::Power == 1)
+      return math::RangeType<ElemType>(loSum, hiSum);
+    else if (MetricType::Power == 2)
+      return math::RangeType<ElemType>((ElemType) std::sqrt(loSum),
+                                       (ElemType) std::sqrt(hiSum));
+    else
+    {
+      return math::RangeType<ElemType>(
+          (ElemType) pow((double) loSum, 1.0 / (double) MetricType::Power),
+          (ElemType) pow((double) hiSum, 1.0 / (double) MetricType::Power));
+    }
+  }
+  else
+    return math::RangeType<ElemType>(loSum, hiSum);
+}
+
+/**
+ * Expands this region to include new points.
+ */
+template<typename MetricType, typename ElemType>
+template<typename MatType>
+inline SparseHRectBound<MetricType, ElemType>&
+SparseHRectBound<MetricType, ElemType>::operator|=(const MatType& data)
+{
+  Log::Assert(data.n_rows == dim);
+
+  if (data.n_cols == 0)
+    return *this;
+
+  Expand(data);
+  hasPoints = true;
+  UpdateMinWidth();
+
+  return *this;
+}
+
+/**
+ * Expands this region to encompass another bound.
+ */
+template<typename MetricType, typename ElemType>
+inline SparseHRectBound<MetricType, ElemType>&
+SparseHRectBound<MetricType, ElemType>::operator|=(
+    const SparseHRectBound& other)
+{
+  assert(other.dim == dim);
+
+  if (!other.hasPoints)
+    return *this;
+
+  if (!hasPoints)
+  {
+    ranges = other.ranges;
+    hasPoints = true;
+    minWidth = other.minWidth;
+    return *this;
+  }
+
+  // Our dimensions with no counterpart in the other bound must absorb the
+  // other bound's implicit [0, 0] range.
+  for (auto& range : ranges)
+  {
+    if (other.ranges.count(range.first) == 0)
+      range.second |= defaultRange;
+  }
+
+  // The other bound's dimensions absorb either our stored range or our
+  // implicit [0, 0] range.
+  for (const auto& range : other.ranges)
+  {
+    typename std::map<size_t, math::RangeType<ElemType>>::iterator it =
+        ranges.find(range.first);
+    if (it != ranges.end())
+    {
+      it->second |= range.second;
+    }
+    else
+    {
+      math::RangeType<ElemType> merged(range.second);
+      merged |= defaultRange;
+      ranges.emplace(range.first, merged);
+    }
+  }
+
+  UpdateMinWidth();
+
+  return *this;
+}
+
+/**
+ * Determines if a point is within this bound.
+ */
+template<typename MetricType, typename ElemType>
+template<typename VecType>
+inline bool SparseHRectBound<MetricType, ElemType>::Contains(
+    const VecType& point) const
+{
+  if (!hasPoints)
+    return false;
+
+  for (const auto& range : ranges)
+  {
+    if (!range.second.Contains(point[range.first]))
+      return false;
+  }
+
+  // Every dimension with no stored range has the implicit range [0, 0], so
+  // the point may not be nonzero in any of them.
+  return (OutsideSum(point) == 0);
+}
+
+/**
+ * Returns the diameter of the hyperrectangle (that is, the longest diagonal).
+ */
+template<typename MetricType, typename ElemType>
+inline ElemType SparseHRectBound<MetricType, ElemType>::Diameter() const
+{
+  // Dimensions with no stored range have width zero and contribute nothing.
+  ElemType d = 0;
+  for (const auto& range : ranges)
+    d += std::pow(range.second.Hi() - range.second.Lo(),
+        (ElemType) MetricType::Power);
+
+  if (MetricType::TakeRoot)
+    return (ElemType) std::pow((double) d, 1.0 / (double) MetricType::Power);
+  else
+    return d;
+}
+
+//! Serialize the bound object.
+template<typename MetricType, typename ElemType>
+template<typename Archive>
+void SparseHRectBound<MetricType, ElemType>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(dim));
+  ar(CEREAL_NVP(ranges));
+  ar(CEREAL_NVP(hasPoints));
+  ar(CEREAL_NVP(minWidth));
+  ar(CEREAL_NVP(metric));
+}
+
+template<typename MetricType, typename ElemType>
+template<typename VecType>
+inline typename std::enable_if<arma::is_arma_sparse_type<VecType>::value,
+    ElemType>::type
+SparseHRectBound<MetricType, ElemType>::OutsideSum(const VecType& point) const
+{
+  ElemType sum = 0;
+
+  for (typename VecType::const_iterator it = point.begin(); it != point.end();
+       ++it)
+  {
+    if (ranges.count(it.row()) != 0)
+      continue;
+
+    const ElemType v = (ElemType) *it;
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+      sum += std::fabs(v);
+    else if (MetricType::Power == 2)
+      sum += v * v;
+    else
+      sum += std::pow(std::fabs(v), (ElemType) MetricType::Power);
+  }
+
+  return sum;
+}
+
+template<typename MetricType, typename ElemType>
+template<typename VecType>
+inline typename std::enable_if<!arma::is_arma_sparse_type<VecType>::value,
+    ElemType>::type
+SparseHRectBound<MetricType, ElemType>::OutsideSum(const VecType& point) const
+{
+  ElemType sum = 0;
+
+  for (size_t d = 0; d < point.n_elem; ++d)
+  {
+    if (point[d] == 0 || ranges.count(d) != 0)
+      continue;
+
+    const ElemType v = (ElemType) point[d];
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+      sum += std::fabs(v);
+    else if (MetricType::Power == 2)
+      sum += v * v;
+    else
+      sum += std::pow(std::fabs(v), (ElemType) MetricType::Power);
+  }
+
+  return sum;
+}
+
+template<typename MetricType, typename ElemType>
+template<typename MatType>
+inline typename std::enable_if<arma::is_arma_sparse_type<MatType>::value>::type
+SparseHRectBound<MetricType, ElemType>::Expand(const MatType& data)
+{
+  // Gather the range and the number of nonzeros of each touched dimension in
+  // a single pass over the nonzero entries.
+  std::map<size_t, math::RangeType<ElemType>> batch;
+  std::map<size_t, size_t> counts;
+  for (typename MatType::const_iterator it = data.begin(); it != data.end();
+       ++it)
+  {
+    const size_t d = it.row();
+    const ElemType v = (ElemType) *it;
+
+    typename std::map<size_t, math::RangeType<ElemType>>::iterator batchIt =
+        batch.find(d);
+    if (batchIt == batch.end())
+    {
+      batch.emplace(d, math::RangeType<ElemType>(v, v));
+      counts.emplace(d, 1);
+    }
+    else
+    {
+      if (v < batchIt->second.Lo())
+        batchIt->second.Lo() = v;
+      if (v > batchIt->second.Hi())
+        batchIt->second.Hi() = v;
+      ++counts[d];
+    }
+  }
+
+  // Our stored dimensions the new points do not touch: every new point is
+  // zero there.
+  for (auto& range : ranges)
+  {
+    if (batch.count(range.first) == 0)
+      range.second |= defaultRange;
+  }
+
+  for (auto& range : batch)
+  {
+    // If not every new point is nonzero in this dimension, the range must
+    // include zero.
+    if (counts[range.first] < data.n_cols)
+      range.second |= defaultRange;
+
+    typename std::map<size_t, math::RangeType<ElemType>>::iterator it =
+        ranges.find(range.first);
+    if (it != ranges.end())
+      it->second |= range.second;
+    else
+    {
+      // If the bound already holds points, they are all zero in this
+      // dimension, so the implicit [0, 0] range applies to them.
+      if (hasPoints)
+        range.second |= defaultRange;
+      ranges.emplace(range.first, range.second);
+    }
+  }
+}
+
+template<typename MetricType, typename ElemType>
+template<typename MatType>
+inline typename std::enable_if<
+    !arma::is_arma_sparse_type<MatType>::value>::type
+SparseHRectBound<MetricType, ElemType>::Expand(const MatType& data)
+{
+  const arma::Col<ElemType> mins(arma::min(data, 1));
+  const arma::Col<ElemType> maxs(arma::max(data, 1));
+
+  for (size_t d = 0; d < dim; ++d)
+  {
+    math::RangeType<ElemType> range(mins[d], maxs[d]);
+
+    typename std::map<size_t, math::RangeType<ElemType>>::iterator it =
+        ranges.find(d);
+    if (it != ranges.end())
+      it->second |= range;
+    else
+    {
+      if (hasPoints)
+        range |= defaultRange;
+
+      // Ranges equal to the implicit [0, 0] need not be stored.
+      if (range.Lo() != 0 || range.Hi() != 0)
+        ranges.emplace(d, range);
+    }
+  }
+}
+
+template<typename MetricType, typename ElemType>
+inline void SparseHRectBound<MetricType, ElemType>::UpdateMinWidth()
+{
+  // Any dimension with no stored range has width zero.
+  if (ranges.size() < dim)
+  {
+    minWidth = 0;
+    return;
+  }
+
+  minWidth = std::numeric_limits<ElemType>::max();
+  for (const auto& range : ranges)
+  {
+    const ElemType width = range.second.Width();
+    if (width < minWidth)
+      minWidth = width;
+  }
+}
+
+} // namespace bound
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_SPARSE_HRECTBOUND_IMPL_HPP
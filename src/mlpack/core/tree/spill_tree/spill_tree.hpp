@@ -12,6 +12,7 @@
 #define MLPACK_CORE_TREE_SPILL_TREE_SPILL_TREE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "../node_pool.hpp"
 #include "../space_split/midpoint_space_split.hpp"
 #include "../statistic.hpp"
 
@@ -240,6 +241,23 @@ class SpillTree
    */
   ~SpillTree();
 
+  //! Allocate node storage from the pool in node_pool.hpp.
+  void* operator new(const size_t size)
+  {
+    if (size == sizeof(SpillTree))
+      return NodePool<sizeof(SpillTree)>::Allocate();
+    return ::operator new(size);
+  }
+
+  //! Return node storage to the pool.
+  void operator delete(void* memory, const size_t size)
+  {
+    if (size == sizeof(SpillTree))
+      NodePool<sizeof(SpillTree)>::Deallocate(memory);
+    else
+      ::operator delete(memory);
+  }
+
   //! Return the bound object for this node.
   const BoundType& Bound() const { return bound; }
   //! Return the bound object for this node.
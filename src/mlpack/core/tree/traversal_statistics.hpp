@@ -0,0 +1,114 @@
+/**
+ * @file core/tree/traversal_statistics.hpp
+ * @author Ryan Curtin
+ *
+ * A uniform set of counters for tree traversals.  Rule classes hold one of
+ * these and increment it from BaseCase(), Score(), and Rescore(); after a
+ * traversal the counters can be queried (or printed with Log::Info, which the
+ * command-line bindings enable under --verbose) to understand where time went.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TRAVERSAL_STATISTICS_HPP
+#define MLPACK_CORE_TREE_TRAVERSAL_STATISTICS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * Counters gathered during a tree traversal.  All of the counters are plain
+ * increments on the hot path, so the overhead is negligible next to the
+ * distance computations they count.
+ */
+class TraversalStatistics
+{
+ public:
+  //! Initialize all counters to zero.
+  TraversalStatistics() :
+      baseCases(0),
+      scores(0),
+      scorePrunes(0),
+      rescorePrunes(0),
+      boundUpdates(0)
+  { /* Nothing to do. */ }
+
+  //! Reset all counters to zero.
+  void Reset()
+  {
+    baseCases = 0;
+    scores = 0;
+    scorePrunes = 0;
+    rescorePrunes = 0;
+    boundUpdates = 0;
+  }
+
+  //! Merge counters from another traversal (e.g. a per-thread rule set).
+  TraversalStatistics& operator+=(const TraversalStatistics& other)
+  {
+    baseCases += other.baseCases;
+    scores += other.scores;
+    scorePrunes += other.scorePrunes;
+    rescorePrunes += other.rescorePrunes;
+    boundUpdates += other.boundUpdates;
+    return *this;
+  }
+
+  //! Get the number of base cases that have been performed.
+  size_t BaseCases() const { return baseCases; }
+  //! Modify the number of base cases that have been performed.
+  size_t& BaseCases() { return baseCases; }
+
+  //! Get the number of node combinations that have been scored.
+  size_t Scores() const { return scores; }
+  //! Modify the number of node combinations that have been scored.
+  size_t& Scores() { return scores; }
+
+  //! Get the number of node combinations pruned by Score().
+  size_t ScorePrunes() const { return scorePrunes; }
+  //! Modify the number of node combinations pruned by Score().
+  size_t& ScorePrunes() { return scorePrunes; }
+
+  //! Get the number of node combinations pruned by Rescore().
+  size_t RescorePrunes() const { return rescorePrunes; }
+  //! Modify the number of node combinations pruned by Rescore().
+  size_t& RescorePrunes() { return rescorePrunes; }
+
+  //! Get the number of bound (candidate/result) updates.
+  size_t BoundUpdates() const { return boundUpdates; }
+  //! Modify the number of bound (candidate/result) updates.
+  size_t& BoundUpdates() { return boundUpdates; }
+
+ private:
+  //! The number of base cases (point-to-point computations).
+  size_t baseCases;
+  //! The number of node combinations that were scored.
+  size_t scores;
+  //! The number of node combinations pruned directly by Score().
+  size_t scorePrunes;
+  //! The number of node combinations pruned by Rescore() after a bound
+  //! tightened.
+  size_t rescorePrunes;
+  //! The number of times a traversal bound or candidate result was updated.
+  size_t boundUpdates;
+};
+
+//! Print a one-line summary of the counters.
+inline std::ostream& operator<<(std::ostream& o,
+                                const TraversalStatistics& stats)
+{
+  o << stats.Scores() << " scores, " << stats.ScorePrunes()
+    << " score prunes, " << stats.RescorePrunes() << " rescore prunes, "
+    << stats.BaseCases() << " base cases, " << stats.BoundUpdates()
+    << " bound updates.";
+  return o;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
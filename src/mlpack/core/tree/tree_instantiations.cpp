@@ -0,0 +1,27 @@
+/**
+ * @file core/tree/tree_instantiations.cpp
+ *
+ * Explicit instantiation definitions for the most common tree configurations.
+ * These match the extern template declarations at the end of the tree class
+ * headers: the heavy template machinery of the common configurations is
+ * compiled once, here, into libmlpack, instead of once per client translation
+ * unit.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/tree/cover_tree.hpp>
+
+namespace mlpack {
+namespace tree {
+
+template class BinarySpaceTree<metric::EuclideanDistance>;
+template class BinarySpaceTree<metric::ManhattanDistance>;
+template class CoverTree<>;
+
+} // namespace tree
+} // namespace mlpack
@@ -0,0 +1,119 @@
+/**
+ * @file core/util/checkpointer.hpp
+ *
+ * A small utility for periodic iteration-level checkpointing of long-running
+ * computations (e.g. KMeans::Cluster() and AMF::Apply()), so that preempted
+ * jobs can resume from the last checkpoint instead of restarting from zero.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_CHECKPOINTER_HPP
+#define MLPACK_CORE_UTIL_CHECKPOINTER_HPP
+
+#include <cereal/archives/binary.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * A checkpointer writes the state of an iterative computation to a file every
+ * N iterations, and can read that state back so the computation resumes from
+ * the last checkpoint.  The state is serialized with a cereal binary archive,
+ * and the file is written atomically (to a temporary file that is then
+ * renamed), so a preemption in the middle of a write cannot corrupt the
+ * previous checkpoint.
+ *
+ * The same object can be passed to a later run: if the checkpoint file exists,
+ * Load() restores the saved state and the computation continues from it.
+ */
+class Checkpointer
+{
+ public:
+  /**
+   * Create a checkpointer that writes to the given file every 'interval'
+   * iterations.  An interval of 0 disables periodic writes (the file can
+   * still be loaded from).
+   */
+  Checkpointer(const std::string& filename, const size_t interval = 10) :
+      filename(filename), interval(interval) { }
+
+  //! Get the checkpoint filename.
+  const std::string& Filename() const { return filename; }
+
+  //! Get the checkpoint interval.
+  size_t Interval() const { return interval; }
+  //! Modify the checkpoint interval.
+  size_t& Interval() { return interval; }
+
+  //! Whether a checkpoint is due after the given (1-based) iteration.
+  bool Due(const size_t iteration) const
+  {
+    return (interval > 0) && (iteration % interval == 0);
+  }
+
+  /**
+   * Serialize the given state to the checkpoint file, replacing any previous
+   * checkpoint.  All arguments are written to one binary cereal archive, in
+   * order; Load() must be called with the same argument types in the same
+   * order.
+   */
+  template<typename... Args>
+  void Save(Args&&... state) const
+  {
+    // Write to a temporary file first, then atomically move it into place.
+    const std::string tmpFilename = filename + ".tmp";
+    {
+      std::ofstream ofs(tmpFilename, std::ios::binary);
+      if (!ofs.is_open())
+      {
+        throw std::runtime_error("Checkpointer::Save(): cannot open file '" +
+            tmpFilename + "' for writing!");
+      }
+
+      cereal::BinaryOutputArchive ar(ofs);
+      ar(std::forward<Args>(state)...);
+    }
+
+    if (std::rename(tmpFilename.c_str(), filename.c_str()) != 0)
+    {
+      throw std::runtime_error("Checkpointer::Save(): cannot move checkpoint "
+          "into place at '" + filename + "'!");
+    }
+  }
+
+  /**
+   * Restore state from the checkpoint file, if it exists.  Returns true if a
+   * checkpoint was loaded, and false if there is no checkpoint file (in which
+   * case the arguments are left untouched and the computation should start
+   * fresh).
+   */
+  template<typename... Args>
+  bool Load(Args&&... state) const
+  {
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs.is_open())
+      return false;
+
+    cereal::BinaryInputArchive ar(ifs);
+    ar(std::forward<Args>(state)...);
+    return true;
+  }
+
+ private:
+  //! The file checkpoints are written to.
+  std::string filename;
+  //! Number of iterations between checkpoints.
+  size_t interval;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif
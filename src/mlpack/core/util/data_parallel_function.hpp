@@ -0,0 +1,178 @@
+/**
+ * @file core/util/data_parallel_function.hpp
+ *
+ * A wrapper that evaluates a separable differentiable function as a set of
+ * data partitions whose gradients are reduced by summation.  This is the
+ * in-process core of data-parallel training: each partition corresponds to
+ * the shard one worker of a cluster would hold, and the reduction step is
+ * where a distributed implementation would perform an allreduce.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_DATA_PARALLEL_FUNCTION_HPP
+#define MLPACK_CORE_UTIL_DATA_PARALLEL_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * DataParallelFunction wraps a separable differentiable function (such as
+ * LogisticRegressionFunction or LinearSVMFunction) and exposes the full-batch
+ * differentiable function API expected by full-batch optimizers such as
+ * L-BFGS.  Each call splits the points into a fixed set of contiguous
+ * partitions, evaluates the objective and gradient of every partition
+ * independently (in parallel, if OpenMP is enabled), and reduces the partial
+ * results by summation.
+ *
+ * This mirrors the structure of distributed data-parallel training: each
+ * partition holds the work one process would perform on its local shard, and
+ * the summation is the allreduce.  A distributed front-end can therefore keep
+ * the wrapped function and the partition loop unchanged and only replace the
+ * reduction with a collective operation.  The reduction is performed in
+ * partition order, so results are deterministic for a fixed partition count
+ * regardless of the number of threads.
+ *
+ * The wrapped function must implement NumFunctions() and the batch forms
+ * Evaluate(parameters, begin, batchSize) and Gradient(parameters, begin,
+ * gradient, batchSize).  If the batch forms decompose additively (as
+ * LogisticRegressionFunction's do), the reduced objective and gradient are
+ * exactly the full-batch ones.  Functions whose batch forms are averaged over
+ * the batch (such as LinearSVMFunction's) yield the full-batch objective and
+ * gradient scaled by the number of partitions when the partitions have equal
+ * size, which leaves the optimum unchanged.
+ *
+ * @tparam FunctionType The type of the function to be wrapped.
+ */
+template<typename FunctionType>
+class DataParallelFunction
+{
+ public:
+  /**
+   * Construct the wrapper around the given function.  The function is held
+   * by reference and must outlive this object.
+   *
+   * @param function Function to wrap.
+   * @param numPartitions Number of partitions to split the points into; must
+   *      be at least 1 and at most function.NumFunctions().
+   */
+  DataParallelFunction(FunctionType& function, const size_t numPartitions) :
+      function(function),
+      numPartitions(numPartitions)
+  {
+    if (numPartitions == 0)
+      throw std::invalid_argument("at least one partition is required");
+    if (numPartitions > function.NumFunctions())
+    {
+      std::stringstream ss;
+      ss << "Requested number of partitions (" << numPartitions << ") is "
+          << "greater than the number of points (" << function.NumFunctions()
+          << ")";
+      throw std::invalid_argument(ss.str());
+    }
+  }
+
+  /**
+   * Evaluate the wrapped function with the given parameters, as the sum of
+   * the per-partition objectives.
+   *
+   * @param parameters Vector of parameters.
+   */
+  double Evaluate(const arma::mat& parameters) const
+  {
+    double objective = 0.0;
+    #pragma omp parallel for schedule(static) reduction(+:objective)
+    for (omp_size_t p = 0; p < omp_size_t(numPartitions); ++p)
+    {
+      size_t begin, batchSize;
+      Partition(p, begin, batchSize);
+      objective += function.Evaluate(parameters, begin, batchSize);
+    }
+
+    return objective;
+  }
+
+  /**
+   * Evaluate the gradient of the wrapped function with the given parameters,
+   * as the sum of the per-partition gradients.
+   *
+   * @param parameters Vector of parameters.
+   * @param gradient Matrix to store the gradient into.
+   */
+  template<typename GradType>
+  void Gradient(const arma::mat& parameters, GradType& gradient) const
+  {
+    std::vector<GradType> partialGradients(numPartitions);
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t p = 0; p < omp_size_t(numPartitions); ++p)
+    {
+      size_t begin, batchSize;
+      Partition(p, begin, batchSize);
+      function.Gradient(parameters, begin, partialGradients[p], batchSize);
+    }
+
+    // Reduce the partial gradients in partition order; this is the step a
+    // distributed implementation would replace with an allreduce.
+    gradient = std::move(partialGradients[0]);
+    for (size_t p = 1; p < numPartitions; ++p)
+      gradient += partialGradients[p];
+  }
+
+  /**
+   * Evaluate both the objective and the gradient of the wrapped function with
+   * the given parameters.
+   *
+   * @param parameters Vector of parameters.
+   * @param gradient Matrix to store the gradient into.
+   */
+  template<typename GradType>
+  double EvaluateWithGradient(const arma::mat& parameters,
+                              GradType& gradient) const
+  {
+    std::vector<GradType> partialGradients(numPartitions);
+    double objective = 0.0;
+    #pragma omp parallel for schedule(static) reduction(+:objective)
+    for (omp_size_t p = 0; p < omp_size_t(numPartitions); ++p)
+    {
+      size_t begin, batchSize;
+      Partition(p, begin, batchSize);
+      objective += function.EvaluateWithGradient(parameters, begin,
+          partialGradients[p], batchSize);
+    }
+
+    gradient = std::move(partialGradients[0]);
+    for (size_t p = 1; p < numPartitions; ++p)
+      gradient += partialGradients[p];
+
+    return objective;
+  }
+
+  //! Return the number of points in the wrapped function.
+  size_t NumFunctions() const { return function.NumFunctions(); }
+
+  //! Return the number of partitions.
+  size_t NumPartitions() const { return numPartitions; }
+
+ private:
+  //! Compute the extent of the given partition.  The partitions are
+  //! contiguous, cover all points, and differ in size by at most one point.
+  void Partition(const size_t p, size_t& begin, size_t& batchSize) const
+  {
+    begin = (p * function.NumFunctions()) / numPartitions;
+    batchSize = (((p + 1) * function.NumFunctions()) / numPartitions) - begin;
+  }
+
+  //! The wrapped function.
+  FunctionType& function;
+  //! The number of partitions to split the points into.
+  size_t numPartitions;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,134 @@
+/**
+ * @file core/util/instrumentation.cpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the hot-path event counters and scoped traces.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "instrumentation.hpp"
+
+using namespace mlpack;
+using namespace std;
+using namespace chrono;
+
+// These are function-local statics so that the registry is usable regardless
+// of static initialization order.
+mutex& Instrumentation::RegistryMutex()
+{
+  static mutex m;
+  return m;
+}
+
+list<Instrumentation::ThreadState>& Instrumentation::Registry()
+{
+  static list<ThreadState> registry;
+  return registry;
+}
+
+Instrumentation::ThreadState& Instrumentation::State()
+{
+  // Each thread registers itself exactly once; afterwards Count() and Trace()
+  // only touch this thread's own buffer.
+  thread_local ThreadState* state = []()
+  {
+    lock_guard<mutex> lock(RegistryMutex());
+    Registry().emplace_back();
+    return &Registry().back();
+  }();
+
+  return *state;
+}
+
+void Instrumentation::Count(const char* name, const uint64_t amount)
+{
+  ThreadState& state = State();
+  lock_guard<mutex> lock(state.mutex);
+  state.counters[name] += amount;
+}
+
+void Instrumentation::Trace(const char* name,
+                            const steady_clock::time_point start,
+                            const steady_clock::time_point end)
+{
+  ThreadState& state = State();
+  lock_guard<mutex> lock(state.mutex);
+  state.events.push_back(TraceEvent{ name, start, end });
+}
+
+map<string, uint64_t> Instrumentation::Counters()
+{
+  map<string, uint64_t> merged;
+
+  lock_guard<mutex> lock(RegistryMutex());
+  for (ThreadState& state : Registry())
+  {
+    lock_guard<mutex> stateLock(state.mutex);
+    for (const auto& counter : state.counters)
+      merged[counter.first] += counter.second;
+  }
+
+  return merged;
+}
+
+void Instrumentation::PrintCounters(ostream& stream)
+{
+  const map<string, uint64_t> merged = Counters();
+
+  stream << "{";
+  bool first = true;
+  for (const auto& counter : merged)
+  {
+    if (!first)
+      stream << ",";
+    first = false;
+    stream << "\n  \"" << counter.first << "\": " << counter.second;
+  }
+  stream << (merged.empty() ? "}" : "\n}") << endl;
+}
+
+void Instrumentation::PrintChromeTrace(ostream& stream)
+{
+  stream << "{ \"traceEvents\": [";
+
+  lock_guard<mutex> lock(RegistryMutex());
+  bool first = true;
+  size_t tid = 0;
+  for (ThreadState& state : Registry())
+  {
+    lock_guard<mutex> stateLock(state.mutex);
+    for (const TraceEvent& event : state.events)
+    {
+      if (!first)
+        stream << ",";
+      first = false;
+
+      // Complete events ("ph": "X") with microsecond timestamps, as the
+      // Chrome trace event format expects.
+      const auto ts = duration_cast<microseconds>(
+          event.start.time_since_epoch()).count();
+      const auto dur = duration_cast<microseconds>(
+          event.end - event.start).count();
+      stream << "\n  { \"name\": \"" << event.name << "\", "
+          << "\"cat\": \"mlpack\", \"ph\": \"X\", \"ts\": " << ts << ", "
+          << "\"dur\": " << dur << ", \"pid\": 0, \"tid\": " << tid << " }";
+    }
+    ++tid;
+  }
+
+  stream << (first ? "] }" : "\n] }") << endl;
+}
+
+void Instrumentation::Reset()
+{
+  lock_guard<mutex> lock(RegistryMutex());
+  for (ThreadState& state : Registry())
+  {
+    lock_guard<mutex> stateLock(state.mutex);
+    state.counters.clear();
+    state.events.clear();
+  }
+}
@@ -0,0 +1,206 @@
+/**
+ * @file core/util/instrumentation.hpp
+ * @author Ryan Curtin
+ *
+ * Zero-cost-when-disabled event counters and scoped traces for hot paths.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_INSTRUMENTATION_HPP
+#define MLPACK_CORE_UTIL_INSTRUMENTATION_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mlpack {
+
+/**
+ * Aggregated hot-path instrumentation: named event counters and scoped trace
+ * events.  This complements Timer and Profiler with answers to "how many"
+ * questions---base cases evaluated, allocations avoided, prunes made---and
+ * with a Chrome-trace-format timeline of annotated scopes.
+ *
+ * Like Log::Debug, the instrumentation is a compile-time switch: the
+ * MLPACK_COUNT(), MLPACK_COUNT_N(), and MLPACK_SCOPED_TRACE() macros below
+ * expand to nothing unless mlpack is compiled with MLPACK_INSTRUMENTATION
+ * defined, so annotating a hot kernel costs nothing in normal builds.  When
+ * enabled, each thread accumulates into its own buffer (in the style of
+ * Profiler), so the annotations do not serialize parallel code.
+ *
+ * Typical usage inside a method:
+ *
+ * @code
+ * double BaseCase(const size_t queryIndex, const size_t referenceIndex)
+ * {
+ *   MLPACK_COUNT(knn_base_cases);
+ *   ...
+ * }
+ *
+ * void SearchTree(...)
+ * {
+ *   MLPACK_SCOPED_TRACE(knn_tree_search);
+ *   ...
+ * }
+ * @endcode
+ *
+ * After the run, Instrumentation::PrintCounters() prints the aggregate counts
+ * as JSON, and Instrumentation::PrintChromeTrace() writes the recorded scopes
+ * in the Chrome trace event format (load the file at chrome://tracing or in
+ * Perfetto to see the timeline).
+ */
+class Instrumentation
+{
+ public:
+  /**
+   * Add the given amount to the named counter on the calling thread's buffer.
+   * Prefer the MLPACK_COUNT()/MLPACK_COUNT_N() macros, which compile to
+   * nothing when instrumentation is disabled.
+   *
+   * @param name Name of the counter.
+   * @param amount Amount to add to the counter.
+   */
+  static void Count(const char* name, const uint64_t amount = 1);
+
+  /**
+   * Record a completed trace scope on the calling thread's buffer.  Prefer
+   * the MLPACK_SCOPED_TRACE() macro, which compiles to nothing when
+   * instrumentation is disabled.
+   *
+   * @param name Name of the scope.
+   * @param start Time the scope was entered.
+   * @param end Time the scope was left.
+   */
+  static void Trace(const char* name,
+                    const std::chrono::steady_clock::time_point start,
+                    const std::chrono::steady_clock::time_point end);
+
+  /**
+   * Get the merged counters of all threads, as a map from counter name to
+   * aggregate count.
+   */
+  static std::map<std::string, uint64_t> Counters();
+
+  /**
+   * Print the merged counters of all threads as a JSON object to the given
+   * stream: one member per counter.
+   *
+   * @param stream Stream to print counters to.
+   */
+  static void PrintCounters(std::ostream& stream);
+
+  /**
+   * Print all recorded trace scopes in the Chrome trace event format (a JSON
+   * object with a "traceEvents" array of complete---"ph": "X"---events, with
+   * microsecond timestamps and one "tid" per mlpack thread).
+   *
+   * @param stream Stream to print the trace to.
+   */
+  static void PrintChromeTrace(std::ostream& stream);
+
+  /**
+   * Reset all counters and recorded trace scopes.  Do not call this while
+   * scopes are open on other threads!
+   */
+  static void Reset();
+
+ private:
+  //! A completed trace scope.
+  struct TraceEvent
+  {
+    //! Name of the scope.
+    const char* name;
+    //! Time the scope was entered.
+    std::chrono::steady_clock::time_point start;
+    //! Time the scope was left.
+    std::chrono::steady_clock::time_point end;
+  };
+
+  /**
+   * Per-thread instrumentation buffer.  Each thread writes only to its own
+   * buffer, so Count() and Trace() never contend; the registry is touched
+   * once per thread and during merges.
+   */
+  struct ThreadState
+  {
+    //! Counters accumulated by this thread.
+    std::map<std::string, uint64_t> counters;
+    //! Trace scopes recorded by this thread.
+    std::vector<TraceEvent> events;
+    //! Guards the buffer against a concurrent merge; uncontended on the hot
+    //! path since only the owning thread and a merging thread take it.
+    std::mutex mutex;
+  };
+
+  //! Get the calling thread's buffer, registering it on first use.
+  static ThreadState& State();
+
+  //! Get the mutex guarding the registry of per-thread buffers.
+  static std::mutex& RegistryMutex();
+  //! Get the registry of per-thread buffers; buffers are never removed, so
+  //! threads that have exited still contribute to merges.
+  static std::list<ThreadState>& Registry();
+};
+
+/**
+ * RAII helper for MLPACK_SCOPED_TRACE(): records the enclosing scope as a
+ * trace event when it is left, including via early return or exception.
+ */
+class ScopedTrace
+{
+ public:
+  //! Enter a scope with the given name (which must outlive the trace; string
+  //! literals, as the macro produces, are always safe).
+  explicit ScopedTrace(const char* name) :
+      name(name),
+      start(std::chrono::steady_clock::now())
+  {
+    // Nothing to do.
+  }
+
+  //! Leave the scope and record the event.
+  ~ScopedTrace()
+  {
+    Instrumentation::Trace(name, start, std::chrono::steady_clock::now());
+  }
+
+  //! No copies; the scope is recorded exactly once.
+  ScopedTrace(const ScopedTrace&) = delete;
+  ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+ private:
+  //! Name of the scope.
+  const char* name;
+  //! Time the scope was entered.
+  const std::chrono::steady_clock::time_point start;
+};
+
+} // namespace mlpack
+
+// The annotation macros.  These compile to nothing unless mlpack was built
+// with MLPACK_INSTRUMENTATION defined, so they may be placed in the hottest
+// loops without cost to normal builds.
+#ifdef MLPACK_INSTRUMENTATION
+  //! Increment the named event counter by one.
+  #define MLPACK_COUNT(name) ::mlpack::Instrumentation::Count(#name)
+  //! Add `amount` to the named event counter.
+  #define MLPACK_COUNT_N(name, amount) \
+      ::mlpack::Instrumentation::Count(#name, (amount))
+  //! Record the enclosing scope as a trace event.
+  #define MLPACK_SCOPED_TRACE(name) \
+      ::mlpack::ScopedTrace mlpackScopedTrace_##name(#name)
+#else
+  #define MLPACK_COUNT(name) ((void) 0)
+  #define MLPACK_COUNT_N(name, amount) ((void) 0)
+  #define MLPACK_SCOPED_TRACE(name) ((void) 0)
+#endif
+
+#endif // MLPACK_CORE_UTIL_INSTRUMENTATION_HPP
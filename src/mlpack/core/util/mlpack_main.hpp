@@ -90,12 +90,22 @@ using Option = mlpack::bindings::cli::CLIOption<T>;
 static const std::string testName = "";
 #include <mlpack/core/util/param.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
+#include <mlpack/bindings/cli/binding_server.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
 
 static void mlpackMain(); // This is typically defined after this include.
 
 int main(int argc, char** argv)
 {
+  // If server mode was requested, hand control to the binding server: it
+  // listens on a Unix domain socket and runs one framed request per
+  // invocation, reusing the process and any loaded models across requests.
+  for (int i = 1; i < argc - 1; ++i)
+  {
+    if (std::string(argv[i]) == "--server")
+      return mlpack::bindings::cli::RunServer(argc, argv, i, &mlpackMain);
+  }
+
   // Parse the command-line options; put them into CLI.
   mlpack::bindings::cli::ParseCommandLine(argc, argv);
   // Enable timing.
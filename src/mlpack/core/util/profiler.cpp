@@ -0,0 +1,181 @@
+/**
+ * @file core/util/profiler.cpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the hierarchical per-thread profiler.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "profiler.hpp"
+
+#include <list>
+#include <sstream>
+#include <stdexcept>
+
+using namespace mlpack;
+using namespace std;
+using namespace chrono;
+
+std::atomic<bool> Profiler::enabled(false);
+
+// These are function-local statics so that the registry is usable regardless
+// of static initialization order.
+mutex& Profiler::RegistryMutex()
+{
+  static mutex m;
+  return m;
+}
+
+list<Profiler::ThreadState>& Profiler::Registry()
+{
+  static list<ThreadState> registry;
+  return registry;
+}
+
+Profiler::ThreadState& Profiler::State()
+{
+  // Each thread registers itself exactly once; afterwards Start()/Stop() only
+  // touch this thread's own state.
+  thread_local ThreadState* state = []()
+  {
+    lock_guard<mutex> lock(RegistryMutex());
+    Registry().emplace_back();
+    return &Registry().back();
+  }();
+
+  return *state;
+}
+
+void Profiler::Start(const string& name)
+{
+  // Don't do anything if we aren't profiling.
+  if (!enabled)
+    return;
+
+  ThreadState& state = State();
+
+  // Nest under the innermost running section, if any.
+  string path = state.stack.empty() ? name :
+      state.stack.back().first + "/" + name;
+
+  state.stack.emplace_back(std::move(path), steady_clock::now());
+}
+
+void Profiler::Stop(const string& name)
+{
+  // Don't do anything if we aren't profiling.
+  if (!enabled)
+    return;
+
+  const steady_clock::time_point currTime = steady_clock::now();
+
+  ThreadState& state = State();
+
+  // The stopped section must be the innermost running one; anything else
+  // means the instrumentation is mismatched.
+  bool matches = false;
+  if (!state.stack.empty())
+  {
+    const string& path = state.stack.back().first;
+    const size_t base = path.rfind('/');
+    matches = (path.compare((base == string::npos) ? 0 : (base + 1),
+        string::npos, name) == 0);
+  }
+
+  if (!matches)
+  {
+    ostringstream error;
+    error << "Profiler::Stop(): no section with name '" << name
+        << "' is innermost on this thread";
+    throw runtime_error(error.str());
+  }
+
+  const string& path = state.stack.back().first;
+
+  const nanoseconds delta = duration_cast<nanoseconds>(currTime -
+      state.stack.back().second);
+
+  // The lock is on this thread's own state, so it is uncontended unless a
+  // merge is running concurrently.
+  lock_guard<mutex> lock(state.mutex);
+  ProfileEntry& entry = state.sections[path];
+  entry.total += delta;
+  ++entry.calls;
+
+  state.stack.pop_back();
+}
+
+map<string, ProfileEntry> Profiler::GetAll()
+{
+  map<string, ProfileEntry> merged;
+
+  lock_guard<mutex> lock(RegistryMutex());
+  for (ThreadState& state : Registry())
+  {
+    lock_guard<mutex> stateLock(state.mutex);
+    for (const auto& section : state.sections)
+    {
+      ProfileEntry& entry = merged[section.first];
+      entry.total += section.second.total;
+      entry.calls += section.second.calls;
+    }
+  }
+
+  return merged;
+}
+
+void Profiler::PrintJSON(ostream& stream)
+{
+  const map<string, ProfileEntry> merged = GetAll();
+
+  stream << "{";
+  bool first = true;
+  for (const auto& section : merged)
+  {
+    if (!first)
+      stream << ",";
+    first = false;
+
+    // Section paths contain only user-given names and '/', but escape quotes
+    // and backslashes anyway so that the output is always valid JSON.
+    stream << "\n  \"";
+    for (const char c : section.first)
+    {
+      if (c == '"' || c == '\\')
+        stream << '\\';
+      stream << c;
+    }
+    stream << "\": { \"nanoseconds\": " << section.second.total.count()
+        << ", \"calls\": " << section.second.calls << " }";
+  }
+  stream << (merged.empty() ? "}" : "\n}") << endl;
+}
+
+void Profiler::Reset()
+{
+  lock_guard<mutex> lock(RegistryMutex());
+  for (ThreadState& state : Registry())
+  {
+    lock_guard<mutex> stateLock(state.mutex);
+    state.sections.clear();
+    state.stack.clear();
+  }
+}
+
+void Profiler::Enable()
+{
+  enabled = true;
+}
+
+void Profiler::Disable()
+{
+  enabled = false;
+}
+
+bool Profiler::Enabled()
+{
+  return enabled;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file core/util/profiler.hpp
+ * @author Ryan Curtin
+ *
+ * A low-overhead hierarchical profiler with per-thread aggregation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PROFILER_HPP
+#define MLPACK_CORE_UTIL_PROFILER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mlpack {
+
+/**
+ * Aggregated results for one profiled section: total time spent in the
+ * section and the number of times it was entered, summed over all threads.
+ */
+struct ProfileEntry
+{
+  //! Total time spent inside the section.
+  std::chrono::nanoseconds total{ 0 };
+  //! Number of times the section was entered.
+  size_t calls{ 0 };
+};
+
+/**
+ * The Profiler class provides hierarchical, per-thread timing of mlpack
+ * internals.  It differs from Timer in two ways: sections nest, so a section
+ * started while another is running is recorded under a slash-separated path
+ * (e.g. "tree_building/split_selection"); and each thread accumulates into
+ * its own buffer with nanosecond resolution, so instrumenting a hot parallel
+ * loop does not serialize it on a global mutex.  The per-thread buffers are
+ * merged when the results are asked for, not on the hot path.
+ *
+ * Like Timer, the profiler is disabled by default and all calls are cheap
+ * no-ops until Enable() is called.  Sections are specific to the thread that
+ * started them: a section started on one thread cannot be stopped from
+ * another, and each thread has its own independent nesting stack.
+ *
+ * Prefer the RAII ProfileSection helper over manual Start()/Stop() pairs:
+ *
+ * @code
+ * void SplitNode(...)
+ * {
+ *   ProfileSection section("split_selection");
+ *   ...
+ * }
+ * @endcode
+ *
+ * Results can be retrieved as a map from slash-separated section paths to
+ * ProfileEntry objects with GetAll(), or dumped as JSON with PrintJSON() for
+ * machine consumption.
+ */
+class Profiler
+{
+ public:
+  /**
+   * Start a section with the given name on the calling thread.  If another
+   * section is already running on this thread, the new section is recorded as
+   * its child ("parent/name").  Sections are additive: entering the same path
+   * again adds to its total.
+   *
+   * @param name Name of the section to start; must not contain '/'.
+   */
+  static void Start(const std::string& name);
+
+  /**
+   * Stop the innermost running section on the calling thread.
+   *
+   * @note A std::runtime_error exception will be thrown if the given name
+   * does not match the innermost running section (or if no section is
+   * running), since that indicates mismatched instrumentation.
+   *
+   * @param name Name of the section to stop.
+   */
+  static void Stop(const std::string& name);
+
+  /**
+   * Get the merged results of all threads: a map from slash-separated section
+   * paths to their aggregate time and call count.
+   */
+  static std::map<std::string, ProfileEntry> GetAll();
+
+  /**
+   * Print the merged results of all threads as a JSON object to the given
+   * stream: one member per section path, each holding the total time in
+   * nanoseconds and the number of calls.
+   *
+   * @param stream Stream to print JSON results to.
+   */
+  static void PrintJSON(std::ostream& stream);
+
+  /**
+   * Reset all profiling results.  Do not call this while sections are running
+   * on other threads!  Whether or not profiling is enabled is not changed.
+   */
+  static void Reset();
+
+  //! Enable profiling.  Do not call this while sections are running!
+  static void Enable();
+  //! Disable profiling.  Do not call this while sections are running!
+  static void Disable();
+  //! Get whether or not profiling is enabled.
+  static bool Enabled();
+
+ private:
+  /**
+   * Per-thread profiling state.  Each thread writes only to its own
+   * ThreadState, so Start()/Stop() never contend; the global registry is
+   * touched once per thread (on first use) and during merges.
+   */
+  struct ThreadState
+  {
+    //! Stack of running sections: the full path of each and its start time.
+    std::vector<std::pair<std::string,
+        std::chrono::steady_clock::time_point>> stack;
+    //! Accumulated results for this thread, keyed by full section path.
+    std::map<std::string, ProfileEntry> sections;
+    //! Guards `sections` against a concurrent merge.  Only the owning thread
+    //! and a merging thread ever take it, so it is effectively uncontended on
+    //! the hot path.
+    std::mutex mutex;
+  };
+
+  //! Get the calling thread's state, registering it on first use.
+  static ThreadState& State();
+
+  //! Get the mutex guarding the registry of per-thread states.
+  static std::mutex& RegistryMutex();
+  //! Get the registry of per-thread states.  States are never removed, so
+  //! threads that have exited still contribute their results to merges; the
+  //! list gives each state a stable address for the thread-local pointers.
+  static std::list<ThreadState>& Registry();
+
+  //! Whether or not profiling is enabled.
+  static std::atomic<bool> enabled;
+};
+
+/**
+ * RAII helper that starts a profiler section on construction and stops it on
+ * destruction, so early returns and exceptions cannot leave a section
+ * running.
+ */
+class ProfileSection
+{
+ public:
+  //! Start a section with the given name.
+  explicit ProfileSection(const std::string& name) : name(name)
+  {
+    Profiler::Start(name);
+  }
+
+  //! Stop the section.
+  ~ProfileSection() { Profiler::Stop(name); }
+
+  //! No copies; the section is stopped exactly once.
+  ProfileSection(const ProfileSection&) = delete;
+  ProfileSection& operator=(const ProfileSection&) = delete;
+
+ private:
+  //! Name the section was started with.
+  const std::string name;
+};
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_PROFILER_HPP
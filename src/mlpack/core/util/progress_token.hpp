@@ -0,0 +1,129 @@
+/**
+ * @file core/util/progress_token.hpp
+ *
+ * A cooperative progress-reporting and cancellation token for long-running
+ * iterative computations (e.g. KMeans::Cluster(), AMF::Apply(), HMM::Train()).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PROGRESS_TOKEN_HPP
+#define MLPACK_CORE_UTIL_PROGRESS_TOKEN_HPP
+
+#include <atomic>
+#include <functional>
+#include <limits>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * A token that an iterative computation checks cooperatively between
+ * iterations, allowing the caller to observe progress and to abort a run
+ * cleanly without killing the process.
+ *
+ * The token can carry an optional callback, which is invoked with the current
+ * iteration number and objective value each time the computation reports
+ * progress; if the callback returns false, the computation stops after that
+ * iteration and returns its current (partial) result.  Independently of the
+ * callback, Cancel() may be called at any time---including from another
+ * thread---to request that the computation stop at the next report.
+ *
+ * For computations driven by an ensmallen optimizer (such as FFN::Train()),
+ * pass a ProgressTokenCallback wrapping the token as an optimizer callback
+ * instead.
+ */
+class ProgressToken
+{
+ public:
+  //! Create a token with no callback; useful for cancellation only.
+  ProgressToken() : cancelled(false) { }
+
+  /**
+   * Create a token with a progress callback.  The callback receives the
+   * iteration number and the current objective value (or NaN if the
+   * computation has no meaningful objective); returning false from the
+   * callback cancels the computation.
+   */
+  explicit ProgressToken(std::function<bool(size_t, double)> callback) :
+      callback(std::move(callback)), cancelled(false) { }
+
+  //! Request cancellation; this is safe to call from another thread.
+  void Cancel() { cancelled = true; }
+
+  //! Get whether cancellation has been requested.
+  bool Cancelled() const { return cancelled; }
+
+  /**
+   * Report progress from inside a computation.  Invokes the callback (if any)
+   * with the given iteration number and objective value.  Returns true if the
+   * computation should continue, and false if it should stop.
+   *
+   * @param iteration Number of the iteration that just finished.
+   * @param objective Current objective value (residual, log-likelihood, ...);
+   *     defaults to NaN for computations without one.
+   */
+  bool Report(const size_t iteration,
+              const double objective = std::numeric_limits<double>::quiet_NaN())
+  {
+    if (callback && !callback(iteration, objective))
+      cancelled = true;
+    return !cancelled;
+  }
+
+ private:
+  //! The callback to invoke on each report, if any.
+  std::function<bool(size_t, double)> callback;
+  //! Whether cancellation has been requested.
+  std::atomic<bool> cancelled;
+};
+
+/**
+ * An optimizer callback that connects a ProgressToken to ensmallen, so that
+ * the same token used for the iterative mlpack methods can also observe and
+ * cancel an ensmallen optimization (e.g. one started by FFN::Train()).
+ *
+ * The end of each epoch is reported to the token with the current objective;
+ * for optimizers without epochs, cancellation is still honored after every
+ * step.
+ */
+class ProgressTokenCallback
+{
+ public:
+  //! Wrap the given token; the token must outlive the optimization.
+  ProgressTokenCallback(ProgressToken& token) : token(token) { }
+
+  //! Report the end of an epoch to the token; returning true terminates the
+  //! optimization.
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool EndEpoch(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& /* coordinates */,
+                const size_t epoch,
+                const double objective)
+  {
+    return !token.Report(epoch, objective);
+  }
+
+  //! Honor cancellation after each step, for optimizers that do not have
+  //! epochs; the callback is deliberately not invoked here, since many steps
+  //! can make up one logical iteration.
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool StepTaken(OptimizerType& /* optimizer */,
+                 FunctionType& /* function */,
+                 const MatType& /* coordinates */)
+  {
+    return token.Cancelled();
+  }
+
+ private:
+  //! The wrapped token.
+  ProgressToken& token;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif
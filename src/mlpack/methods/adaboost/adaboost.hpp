@@ -29,6 +29,7 @@
 #define MLPACK_METHODS_ADABOOST_ADABOOST_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/compressed_blob.hpp>
 #include <mlpack/methods/perceptron/perceptron.hpp>
 #include <mlpack/methods/decision_tree/decision_tree.hpp>
 
@@ -90,10 +90,6 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
   // Use tempData to modify input data for incorporating weights.
   MatType tempData(data);
 
-  // This matrix is a helper matrix used to calculate the final hypothesis.
-  arma::mat sumFinalH = arma::zeros<arma::mat>(numClasses,
-      predictedLabels.n_cols);
-
   // Load the initial weights into a 2-D matrix.
   const double initWeight = 1.0 / double(data.n_cols * numClasses);
   arma::mat D(numClasses, data.n_cols);
@@ -113,9 +109,6 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     // rt = (sum) D(i) y(i) ht(xi)
     rt = 0.0;
 
-    // zt is used for weight normalization.
-    zt = 0.0;
-
     // Build the weight vectors.
     weights = arma::sum(D);
 
@@ -126,13 +119,25 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     // Now from predictedLabels, build ht, the weak hypothesis
     // buildClassificationMatrix(ht, predictedLabels);
 
-    // Now, calculate alpha(t) using ht.
-    for (size_t j = 0; j < D.n_cols; ++j) // instead of D, ht
+    // Now, calculate alpha(t) using ht.  The per-point weight masses are the
+    // column sums of D, which were just computed into `weights`, so there is
+    // no need to reduce over the rows of D again here.  The mass on the
+    // misclassified points is also accumulated, since the normalization
+    // constant below only depends on how the total mass splits between
+    // correctly and incorrectly classified points.
+    double wrongMass = 0.0;
+    #pragma omp parallel for reduction(+:rt,wrongMass) schedule(static)
+    for (omp_size_t j = 0; j < (omp_size_t) D.n_cols; ++j)
     {
       if (predictedLabels(j) == labels(j))
-        rt += arma::accu(D.col(j));
+      {
+        rt += weights(j);
+      }
       else
-        rt -= arma::accu(D.col(j));
+      {
+        rt -= weights(j);
+        wrongMass += weights(j);
+      }
     }
 
     if ((i > 0) && (std::abs(rt - crt) < tolerance))
@@ -156,46 +161,28 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     alpha.push_back(alphat);
     wl.push_back(w);
 
-    // Now start modifying the weights.
-    for (size_t j = 0; j < D.n_cols; ++j)
+    // Now start modifying the weights.  Every correctly classified point is
+    // scaled down by exp(alphat) and every misclassified point is scaled up
+    // by the same factor, so the normalization constant follows directly from
+    // the mass split computed above:
+    //   zt = correctMass / expo + wrongMass * expo, with
+    //   correctMass = rt + wrongMass.
+    const double expo = exp(alphat);
+    zt = (rt + wrongMass) / expo + wrongMass * expo;
+
+    // Fold the downscaling of the correctly classified points and the
+    // normalization into one scalar scale of D; after that, only the columns
+    // of the misclassified points need individual updates.
+    D /= (expo * zt);
+
+    const double wrongScale = expo * expo;
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t j = 0; j < (omp_size_t) D.n_cols; ++j)
     {
-      const double expo = exp(alphat);
-      if (predictedLabels(j) == labels(j))
-      {
-        for (size_t k = 0; k < D.n_rows; ++k)
-        {
-          // We calculate zt, the normalization constant.
-          D(k, j) /= expo;
-          zt += D(k, j); // * exp(-1 * alphat * yt(j,k) * ht(j,k));
-
-          // Add to the final hypothesis matrix.
-          // sumFinalH(k, j) += (alphat * ht(k, j));
-          if (k == labels(j))
-            sumFinalH(k, j) += (alphat); // * ht(k, j));
-          else
-            sumFinalH(k, j) -= (alphat);
-        }
-      }
-      else
-      {
-        for (size_t k = 0; k < D.n_rows; ++k)
-        {
-          // We calculate zt, the normalization constant.
-          D(k, j) *= expo;
-          zt += D(k, j);
-
-          // Add to the final hypothesis matrix.
-          if (k == labels(j))
-            sumFinalH(k, j) += alphat; // * ht(k, j));
-          else
-            sumFinalH(k, j) -= alphat;
-        }
-      }
+      if (predictedLabels(j) != labels(j))
+        D.col(j) *= wrongScale;
     }
 
-    // Normalize D.
-    D /= zt;
-
     // Accumulate the value of zt for the Hamming loss bound.
     ztProduct *= zt;
   }
@@ -225,17 +212,28 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
     arma::Row<size_t>& predictedLabels,
     arma::mat& probabilities)
 {
-  arma::Row<size_t> tempPredictedLabels(test.n_cols);
-
   probabilities.zeros(numClasses, test.n_cols);
   predictedLabels.set_size(test.n_cols);
 
-  for (size_t i = 0; i < wl.size(); ++i)
+  // The weak learners vote independently of each other, so they are evaluated
+  // across threads; each thread tallies its share of the ensemble locally and
+  // the tallies are merged at the end.
+  #pragma omp parallel
   {
-    wl[i].Classify(test, tempPredictedLabels);
+    arma::Row<size_t> tempPredictedLabels(test.n_cols);
+    arma::mat localProbabilities(numClasses, test.n_cols, arma::fill::zeros);
 
-    for (size_t j = 0; j < tempPredictedLabels.n_cols; ++j)
-      probabilities(tempPredictedLabels(j), j) += alpha[i];
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) wl.size(); ++i)
+    {
+      wl[i].Classify(test, tempPredictedLabels);
+
+      for (size_t j = 0; j < tempPredictedLabels.n_cols; ++j)
+        localProbabilities(tempPredictedLabels(j), j) += alpha[i];
+    }
+
+    #pragma omp critical (adaBoostClassify)
+    probabilities += localProbabilities;
   }
 
   arma::colvec pRow;
@@ -262,13 +260,45 @@ void AdaBoost<WeakLearnerType, MatType>::serialize(Archive& ar,
   ar(CEREAL_NVP(tolerance));
   ar(CEREAL_NVP(alpha));
 
-  // Now serialize each weak learner.
+  // Each weak learner is stored as its own compressed blob, so the ensemble
+  // packs and unpacks in parallel over its members (see RandomForest for the
+  // same scheme).
+  std::vector<data::CompressedBlob<WeakLearnerType>> compressedWl(
+      alpha.size());
+  if (!cereal::is_loading<Archive>())
+  {
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) wl.size(); ++i)
+      compressedWl[i].Pack(wl[i]);
+  }
+
+  ar(CEREAL_NVP(compressedWl));
+
   if (cereal::is_loading<Archive>())
   {
     wl.clear();
     wl.resize(alpha.size());
+
+    // An exception must not escape the parallel region, so remember failures
+    // and rethrow afterwards.
+    bool failed = false;
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) wl.size(); ++i)
+    {
+      try
+      {
+        compressedWl[i].Unpack(wl[i]);
+      }
+      catch (cereal::Exception&)
+      {
+        failed = true;
+      }
+    }
+
+    if (failed)
+      throw cereal::Exception("AdaBoost::serialize(): cannot unpack "
+          "compressed weak learners; corrupt model file?");
   }
-  ar(CEREAL_NVP(wl));
 }
 
 } // namespace adaboost
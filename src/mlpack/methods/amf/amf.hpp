@@ -19,6 +19,8 @@
 #define MLPACK_METHODS_AMF_AMF_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/checkpointer.hpp>
+#include <mlpack/core/util/progress_token.hpp>
 
 #include <mlpack/methods/amf/update_rules/nmf_mult_dist.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_als.hpp>
@@ -105,12 +107,41 @@ class AMF
    * @param W Basis matrix to be output.
    * @param H Encoding matrix to output.
    * @param r Rank r of the factorization.
+   * @param progress If non-NULL, a token that is reported to after each
+   *      iteration and that can cancel the factorization cooperatively.
    */
   template<typename MatType>
   double Apply(const MatType& V,
                const size_t r,
                arma::mat& W,
-               arma::mat& H);
+               arma::mat& H,
+               util::ProgressToken* progress = NULL);
+
+  /**
+   * Apply Alternating Matrix Factorization to the provided matrix with
+   * periodic checkpointing.  W, H and the termination policy state are
+   * written to the given checkpointer every checkpoint.Interval() iterations;
+   * if the checkpoint file already exists, the factorization resumes from the
+   * checkpointed state instead of a fresh initialization.  The termination
+   * policy must be serializable (as SimpleResidueTermination and
+   * MaxIterationTermination are).
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix to be output.
+   * @param H Encoding matrix to output.
+   * @param r Rank r of the factorization.
+   * @param checkpoint Checkpointer to periodically write the factorization
+   *      state to and to resume from.
+   * @param progress If non-NULL, a token that is reported to after each
+   *      iteration and that can cancel the factorization cooperatively.
+   */
+  template<typename MatType>
+  double Apply(const MatType& V,
+               const size_t r,
+               arma::mat& W,
+               arma::mat& H,
+               util::Checkpointer& checkpoint,
+               util::ProgressToken* progress = NULL);
 
   //! Access the termination policy.
   const TerminationPolicyType& TerminationPolicy() const
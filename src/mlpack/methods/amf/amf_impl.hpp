@@ -36,6 +36,7 @@ AMF<TerminationPolicyType, InitializationRuleType, UpdateRuleType>::AMF(
  * @param W Basis matrix to be output
  * @param H Encoding matrix to output
  * @param r Rank r of the factorization
+ * @param progress Optional progress/cancellation token
  */
 template<typename TerminationPolicyType,
          typename InitializationRuleType,
@@ -45,7 +46,8 @@ double AMF<TerminationPolicyType, InitializationRuleType, UpdateRuleType>::
 Apply(const MatType& V,
       const size_t r,
       arma::mat& W,
-      arma::mat& H)
+      arma::mat& H,
+      util::ProgressToken* progress)
 {
   // Initialize W and H.
   initializationRule.Initialize(V, r, W, H);
@@ -63,6 +65,93 @@ Apply(const MatType& V,
     // Update the values of W and H based on the update rules provided.
     update.WUpdate(V, W, H);
     update.HUpdate(V, W, H);
+
+    // Report progress and check for cooperative cancellation; on
+    // cancellation, the current (partial) factorization is returned.
+    if (progress && !progress->Report(terminationPolicy.Iteration(),
+        terminationPolicy.Index()))
+    {
+      Log::Info << "AMF::Apply(): cancelled after "
+          << terminationPolicy.Iteration() << " iterations." << std::endl;
+      break;
+    }
+  }
+
+  // get final residue and iteration count from termination policy
+  const double residue = terminationPolicy.Index();
+  const size_t iteration = terminationPolicy.Iteration();
+
+  Log::Info << "AMF converged to residue of " << residue << " in "
+      << iteration << " iterations." << std::endl;
+
+  return residue;
+}
+
+/**
+ * Apply Alternating Matrix Factorization to the provided matrix with periodic
+ * checkpointing, resuming from an existing checkpoint if one is present.
+ *
+ * @param V Input matrix to be factorized
+ * @param W Basis matrix to be output
+ * @param H Encoding matrix to output
+ * @param r Rank r of the factorization
+ * @param checkpoint Checkpointer holding the factorization state
+ * @param progress Optional progress/cancellation token
+ */
+template<typename TerminationPolicyType,
+         typename InitializationRuleType,
+         typename UpdateRuleType>
+template<typename MatType>
+double AMF<TerminationPolicyType, InitializationRuleType, UpdateRuleType>::
+Apply(const MatType& V,
+      const size_t r,
+      arma::mat& W,
+      arma::mat& H,
+      util::Checkpointer& checkpoint,
+      util::ProgressToken* progress)
+{
+  // If a checkpoint exists, resume from its W, H and termination policy
+  // state; otherwise initialize W and H and the termination policy.
+  const bool resumed = checkpoint.Load(W, H, terminationPolicy);
+  if (resumed)
+  {
+    Log::Info << "AMF::Apply(): resuming from checkpoint '"
+        << checkpoint.Filename() << "' at iteration "
+        << terminationPolicy.Iteration() << "." << std::endl;
+  }
+  else
+  {
+    initializationRule.Initialize(V, r, W, H);
+    Log::Info << "Initialized W and H." << std::endl;
+  }
+
+  // initialize the update rule
+  update.Initialize(V, r);
+  // initialize the termination policy, unless its checkpointed state is used
+  if (!resumed)
+    terminationPolicy.Initialize(V);
+
+  // check if termination conditions are met
+  while (!terminationPolicy.IsConverged(W, H))
+  {
+    // Update the values of W and H based on the update rules provided.
+    update.WUpdate(V, W, H);
+    update.HUpdate(V, W, H);
+
+    // Periodically write the factorization state to the checkpoint file, so
+    // that a preempted run can resume from it.
+    if (checkpoint.Due(terminationPolicy.Iteration()))
+      checkpoint.Save(W, H, terminationPolicy);
+
+    // Report progress and check for cooperative cancellation; on
+    // cancellation, the current (partial) factorization is returned.
+    if (progress && !progress->Report(terminationPolicy.Iteration(),
+        terminationPolicy.Index()))
+    {
+      Log::Info << "AMF::Apply(): cancelled after "
+          << terminationPolicy.Iteration() << " iterations." << std::endl;
+      break;
+    }
   }
 
   // get final residue and iteration count from termination policy
@@ -72,6 +72,15 @@ class MaxIterationTermination
   //! Modify the maximum number of iterations.
   size_t& MaxIterations() { return maxIterations; }
 
+  //! Serialize the termination policy, so that a factorization can be
+  //! checkpointed and resumed mid-run.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(maxIterations));
+    ar(CEREAL_NVP(iteration));
+  }
+
  private:
   //! The maximum number of allowed iterations.
   size_t maxIterations;
@@ -75,11 +75,12 @@ class SimpleResidueTermination
    */
   bool IsConverged(arma::mat& W, arma::mat& H)
   {
-    // Calculate the norm and compute the residue, but do it by hand, so as to
-    // avoid calculating (W*H), which may be very large.
-    double norm = 0.0;
-    for (size_t j = 0; j < H.n_cols; ++j)
-      norm += arma::norm(W * H.col(j), "fro");
+    // Calculate the norm from the factors' k x k Gram matrices:
+    // ||WH||_F^2 = trace((W^T W) (H H^T)).  This costs O((n + m) k^2) instead
+    // of the O(n m k) of forming the product, so for low ranks the
+    // convergence check no longer rivals the cost of the update step itself.
+    const double norm = std::sqrt(std::max(
+        arma::accu((W.t() * W) % (H * H.t())), 0.0));
     residue = fabs(normOld - norm) / normOld;
 
     // Store the norm.
@@ -108,6 +109,19 @@ class SimpleResidueTermination
   const double& MinResidue() const { return minResidue; }
   double& MinResidue() { return minResidue; }
 
+  //! Serialize the termination policy, so that a factorization can be
+  //! checkpointed and resumed mid-run.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(minResidue));
+    ar(CEREAL_NVP(maxIterations));
+    ar(CEREAL_NVP(residue));
+    ar(CEREAL_NVP(iteration));
+    ar(CEREAL_NVP(normOld));
+    ar(CEREAL_NVP(nm));
+  }
+
  public:
   //! residue threshold
   double minResidue;
@@ -75,32 +75,9 @@ class SimpleToleranceTermination
    */
   bool IsConverged(arma::mat& W, arma::mat& H)
   {
-    arma::mat WH;
-
-    WH = W * H;
-
     // compute residue
     residueOld = residue;
-    size_t n = V->n_rows;
-    size_t m = V->n_cols;
-    double sum = 0;
-    size_t count = 0;
-    for (size_t i = 0; i < n; ++i)
-    {
-        for (size_t j = 0; j < m; ++j)
-        {
-            double temp = 0;
-            if ((temp = (*V)(i, j)) != 0)
-            {
-                temp = (temp - WH(i, j));
-                temp = temp * temp;
-                sum += temp;
-                count++;
-            }
-        }
-    }
-    residue = sum / count;
-    residue = sqrt(residue);
+    residue = Residue(W, H);
 
     // increment iteration count
     iteration++;
@@ -167,6 +144,46 @@ class SimpleToleranceTermination
   double& Tolerance() { return tolerance; }
 
  private:
+  /**
+   * Compute the root mean squared residue over the nonzero entries of V.
+   * The columns are processed in blocks: each block computes its slice of
+   * W * H with one matrix product and is consumed immediately, so the
+   * memory footprint stays at n x blockSize instead of the full n x m
+   * product, and the blocks are independent and run in parallel.
+   */
+  double Residue(const arma::mat& W, const arma::mat& H) const
+  {
+    const size_t n = V->n_rows;
+    const size_t m = V->n_cols;
+    const size_t blockSize = std::min((size_t) 1024, m);
+    const size_t blocks = (m + blockSize - 1) / blockSize;
+
+    double sum = 0;
+    size_t count = 0;
+    #pragma omp parallel for reduction(+:sum, count) schedule(dynamic)
+    for (omp_size_t block = 0; block < (omp_size_t) blocks; ++block)
+    {
+      const size_t begin = block * blockSize;
+      const size_t end = std::min(m, begin + blockSize);
+      const arma::mat WH = W * H.cols(begin, end - 1);
+      for (size_t j = begin; j < end; ++j)
+      {
+        for (size_t i = 0; i < n; ++i)
+        {
+          double temp = (*V)(i, j);
+          if (temp != 0)
+          {
+            temp -= WH(i, j - begin);
+            sum += temp * temp;
+            count++;
+          }
+        }
+      }
+    }
+
+    return std::sqrt(sum / count);
+  }
+
   //! tolerance
   double tolerance;
   //! iteration threshold
@@ -198,6 +215,31 @@ class SimpleToleranceTermination
   double c_index;
 }; // class SimpleToleranceTermination
 
+/**
+ * Residue computation specialization for sparse matrices: iterate the
+ * stored nonzeros directly instead of probing every (i, j) pair.
+ */
+template<>
+inline double SimpleToleranceTermination<arma::sp_mat>::Residue(
+    const arma::mat& W, const arma::mat& H) const
+{
+  double sum = 0;
+  size_t count = 0;
+  #pragma omp parallel for reduction(+:sum, count) schedule(dynamic, 64)
+  for (omp_size_t j = 0; j < (omp_size_t) V->n_cols; ++j)
+  {
+    for (arma::sp_mat::const_col_iterator it = V->begin_col(j);
+        it != V->end_col(j); ++it)
+    {
+      const double temp = (*it) - arma::dot(W.row(it.row()), H.col(j));
+      sum += temp * temp;
+      count++;
+    }
+  }
+
+  return std::sqrt(sum / count);
+}
+
 } // namespace amf
 } // namespace mlpack
 
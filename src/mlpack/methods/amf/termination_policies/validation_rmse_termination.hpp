@@ -114,21 +114,20 @@ class ValidationRMSETermination
    */
   bool IsConverged(arma::mat& W, arma::mat& H)
   {
-    arma::mat WH;
-
-    WH = W * H;
-
-    // compute validation RMSE
+    // compute validation RMSE; only the sampled entries of (W * H) are
+    // needed, so evaluate those dot products directly instead of forming the
+    // full product -- O(num_test_points * k) rather than O(n * m * k)
     if (iteration != 0)
     {
       rmseOld = rmse;
       rmse = 0;
-      for (size_t i = 0; i < num_test_points; ++i)
+      #pragma omp parallel for reduction(+:rmse)
+      for (omp_size_t i = 0; i < (omp_size_t) num_test_points; ++i)
       {
         size_t t_row = test_points(i, 0);
         size_t t_col = test_points(i, 1);
         double t_val = test_points(i, 2);
-        double temp = (t_val - WH(t_row, t_col));
+        double temp = (t_val - arma::dot(W.row(t_row), H.col(t_col)));
         temp *= temp;
         rmse += temp;
       }
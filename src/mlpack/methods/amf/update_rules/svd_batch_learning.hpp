@@ -97,10 +97,12 @@ class SVDBatchLearning
     // initialize the momentum of this iteration.
     mW = momentum * mW;
 
-    // Compute the step.
+    // Compute the step.  Each row of deltaW depends only on row i of V and
+    // W, so the rows can be computed in parallel.
     arma::mat deltaW;
     deltaW.zeros(n, r);
-    for (size_t i = 0; i < n; ++i)
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) n; ++i)
     {
       for (size_t j = 0; j < m; ++j)
       {
@@ -142,10 +144,12 @@ class SVDBatchLearning
     // Initialize the momentum of this iteration.
     mH = momentum * mH;
 
-    // Compute the step.
+    // Compute the step.  The columns of deltaH are independent of each
+    // other, so they can be computed in parallel.
     arma::mat deltaH;
     deltaH.zeros(r, m);
-    for (size_t j = 0; j < m; ++j)
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (omp_size_t j = 0; j < (omp_size_t) m; ++j)
     {
       for (size_t i = 0; i < n; ++i)
       {
@@ -190,10 +194,31 @@ class SVDBatchLearning
   arma::mat mW;
   //! Momentum matrix for matrix H
   arma::mat mH;
+
+  //! Transpose of a sparse input matrix, cached by Initialize().  Column i of
+  //! this matrix holds the nonzeros of row i of V, giving WUpdate() the
+  //! row-sliced (CSR-like) access it needs; it is rebuilt by Initialize() and
+  //! therefore not serialized.
+  arma::sp_mat vt;
 }; // class SVDBatchLearning
 
-//! TODO : Merge this template specialized function for sparse matrix using
-//!        common row_col_iterator
+/**
+ * Initialize function specialization for sparse matrix: additionally cache
+ * the transpose of the input, so that WUpdate() can walk the nonzeros of one
+ * row of V as one contiguous column of the transpose.
+ */
+template<>
+inline void SVDBatchLearning::Initialize<arma::sp_mat>(
+    const arma::sp_mat& dataset, const size_t rank)
+{
+  const size_t n = dataset.n_rows;
+  const size_t m = dataset.n_cols;
+
+  mW.zeros(n, rank);
+  mH.zeros(rank, m);
+
+  vt = dataset.t();
+}
 
 /**
  * WUpdate function specialization for sparse matrix
@@ -211,12 +236,20 @@ inline void SVDBatchLearning::WUpdate<arma::sp_mat>(const arma::sp_mat& V,
   arma::mat deltaW;
   deltaW.zeros(n, r);
 
-  for (arma::sp_mat::const_iterator it = V.begin(); it != V.end(); ++it)
+  // Walk the cached transpose instead of the whole-matrix iterator: the
+  // nonzeros of row i of V form one contiguous column of vt, so each row of
+  // deltaW is accumulated from a single cache-resident slice, and distinct
+  // rows never touch the same output and can be processed in parallel.
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (omp_size_t row = 0; row < (omp_size_t) n; ++row)
   {
-    const size_t row = it.row();
-    const size_t col = it.col();
-    deltaW.row(it.row()) += (*it - arma::dot(W.row(row), H.col(col))) *
-                                             arma::trans(H.col(col));
+    for (arma::sp_mat::const_col_iterator it = vt.begin_col(row);
+        it != vt.end_col(row); ++it)
+    {
+      const size_t col = it.row();
+      deltaW.row(row) += (*it - arma::dot(W.row(row), H.col(col))) *
+          arma::trans(H.col(col));
+    }
   }
 
   if (kw != 0)
@@ -239,12 +272,18 @@ inline void SVDBatchLearning::HUpdate<arma::sp_mat>(const arma::sp_mat& V,
   arma::mat deltaH;
   deltaH.zeros(r, m);
 
-  for (arma::sp_mat::const_iterator it = V.begin(); it != V.end(); ++it)
+  // The nonzeros of one CSC column all touch the same column of deltaH and
+  // no other, so the columns can be processed in parallel.
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (omp_size_t col = 0; col < (omp_size_t) m; ++col)
   {
-    const size_t row = it.row();
-    const size_t col = it.col();
-    deltaH.col(col) += (*it - arma::dot(W.row(row), H.col(col))) *
-        W.row(row).t();
+    for (arma::sp_mat::const_col_iterator it = V.begin_col(col);
+        it != V.end_col(col); ++it)
+    {
+      const size_t row = it.row();
+      deltaH.col(col) += (*it - arma::dot(W.row(row), H.col(col))) *
+          W.row(row).t();
+    }
   }
 
   if (kh != 0)
@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_LOGISTIC_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/simd_kernels.hpp>
 
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
@@ -61,6 +62,32 @@ class LogisticFunction
     y = (1.0 / (1 + arma::exp(-x)));
   }
 
+  /**
+   * Computes the logistic function on a dense double-precision matrix.  This
+   * overload routes through the runtime-dispatched SIMD kernel.
+   *
+   * @param x Input data.
+   * @param y The resulting output activation.
+   */
+  static void Fn(const arma::mat& x, arma::mat& y)
+  {
+    y.set_size(arma::size(x));
+    math::simd::Logistic(x.memptr(), y.memptr(), x.n_elem);
+  }
+
+  /**
+   * Computes the logistic function on a dense single-precision matrix.  This
+   * overload routes through the runtime-dispatched SIMD kernel.
+   *
+   * @param x Input data.
+   * @param y The resulting output activation.
+   */
+  static void Fn(const arma::fmat& x, arma::fmat& y)
+  {
+    y.set_size(arma::size(x));
+    math::simd::Logistic(x.memptr(), y.memptr(), x.n_elem);
+  }
+
   /**
    * Computes the first derivative of the logistic function.
    *
@@ -24,7 +24,9 @@
 #define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_RECTIFIER_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/simd_kernels.hpp>
 #include <algorithm>
+#include <limits>
 
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
@@ -65,8 +67,34 @@ class RectifierFunction
   template<typename eT>
   static void Fn(const arma::Mat<eT>& x, arma::Mat<eT>& y)
   {
-    y.zeros(x.n_rows, x.n_cols);
-    y = arma::max(y, x);
+    // The elementwise expression is evaluated in place, so y may alias x.
+    y = arma::clamp(x, eT(0), std::numeric_limits<eT>::max());
+  }
+
+  /**
+   * Computes the rectifier function using a dense double-precision matrix as
+   * input.  This overload routes through the runtime-dispatched SIMD kernel.
+   *
+   * @param x Input data.
+   * @param y The resulting output activation.
+   */
+  static void Fn(const arma::mat& x, arma::mat& y)
+  {
+    y.set_size(arma::size(x));
+    math::simd::Rectifier(x.memptr(), y.memptr(), x.n_elem);
+  }
+
+  /**
+   * Computes the rectifier function using a dense single-precision matrix as
+   * input.  This overload routes through the runtime-dispatched SIMD kernel.
+   *
+   * @param x Input data.
+   * @param y The resulting output activation.
+   */
+  static void Fn(const arma::fmat& x, arma::fmat& y)
+  {
+    y.set_size(arma::size(x));
+    math::simd::Rectifier(x.memptr(), y.memptr(), x.n_elem);
   }
 
   /**
@@ -78,8 +106,8 @@ class RectifierFunction
   template<typename eT>
   static void Fn(const arma::Cube<eT>& x, arma::Cube<eT>& y)
   {
-    y.zeros(x.n_rows, x.n_cols, x.n_slices);
-    y = arma::max(y, x);
+    // The elementwise expression is evaluated in place, so y may alias x.
+    y = arma::clamp(x, eT(0), std::numeric_limits<eT>::max());
   }
 
   /**
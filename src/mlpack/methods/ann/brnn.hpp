@@ -164,6 +164,48 @@ class BRNN
   template<typename OptimizerType = ens::StandardSGD>
   double Train(arma::cube predictors, arma::cube responses);
 
+  /**
+   * Train the bidirectional recurrent neural network on the given input data
+   * using the given optimizer, where each sequence has its own length.  The
+   * predictors and responses must still be padded to rho time steps; the
+   * sequences are sorted by decreasing length so that every batch is stepped
+   * (in both time directions) only up to the longest sequence it contains.
+   *
+   * Note that the backward-in-time pass of a batch starts at the length of
+   * the longest sequence in the batch, so sequences shorter than that still
+   * see their padding in the backward direction.  Choose a batch size that
+   * keeps batches length-uniform (the sorting helps here) for exact results.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param sequenceLengths Length (number of time steps) of each sequence;
+   *        values are clamped to [1, rho].
+   * @param optimizer Instantiated optimizer used to train the model.
+   */
+  template<typename OptimizerType>
+  double Train(arma::cube predictors,
+               arma::cube responses,
+               arma::urowvec sequenceLengths,
+               OptimizerType& optimizer);
+
+  /**
+   * Train the bidirectional recurrent neural network on the given input data,
+   * where each sequence has its own length.  By default, the SGD optimization
+   * algorithm is used, but others can be specified (such as ens::RMSprop).
+   * See the overload above for the semantics of the sequence lengths.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param sequenceLengths Length (number of time steps) of each sequence;
+   *        values are clamped to [1, rho].
+   */
+  template<typename OptimizerType = ens::StandardSGD>
+  double Train(arma::cube predictors,
+               arma::cube responses,
+               arma::urowvec sequenceLengths);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -326,6 +368,24 @@ class BRNN
    */
   void ResetDeterministic();
 
+  /**
+   * Reorder the training sequences (and their lengths) according to the given
+   * column ordering.
+   *
+   * @param ordering Permutation of the sequence indices.
+   */
+  void ReorderSequences(const arma::uvec& ordering);
+
+  /**
+   * Return the number of time steps to evaluate for the given batch: the
+   * length of the longest sequence in the batch, or rho if no sequence
+   * lengths were given.
+   *
+   * @param begin Index of the first sequence of the batch.
+   * @param batchSize Number of sequences in the batch.
+   */
+  size_t BatchRho(const size_t begin, const size_t batchSize) const;
+
   //! Number of steps to backpropagate through time (BPTT).
   size_t rho;
 
@@ -363,6 +423,10 @@ class BRNN
   //! The matrix of responses to the input data points.
   arma::cube responses;
 
+  //! The length of each training sequence, sorted in decreasing order; empty
+  //! if every sequence has length rho.
+  arma::urowvec sequenceLengths;
+
   //! Matrix of (trained) parameters.
   arma::mat parameter;
 
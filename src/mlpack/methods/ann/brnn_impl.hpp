@@ -127,6 +127,7 @@ double BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
 
   this->predictors = std::move(predictors);
   this->responses = std::move(responses);
+  this->sequenceLengths.clear();
 
   this->deterministic = true;
   ResetDeterministic();
@@ -161,6 +162,7 @@ double BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
 
   this->predictors = std::move(predictors);
   this->responses = std::move(responses);
+  this->sequenceLengths.clear();
 
   this->deterministic = true;
   ResetDeterministic();
@@ -182,6 +184,117 @@ double BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
   return out;
 }
 
+template<typename OutputLayerType, typename MergeLayerType,
+         typename MergeOutputType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType>
+double BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
+    InitializationRuleType, CustomLayers...>::Train(
+    arma::cube predictors,
+    arma::cube responses,
+    arma::urowvec sequenceLengths,
+    OptimizerType& optimizer)
+{
+  if (sequenceLengths.n_elem != predictors.n_cols)
+  {
+    Log::Fatal << "BRNN<>::Train(): a sequence length must be given for every "
+        << "sequence (" << sequenceLengths.n_elem << " lengths given for "
+        << predictors.n_cols << " sequences)!" << std::endl;
+  }
+
+  numFunctions = responses.n_cols;
+
+  this->predictors = std::move(predictors);
+  this->responses = std::move(responses);
+  this->sequenceLengths = arma::clamp(sequenceLengths, 1, rho);
+
+  // Sort the sequences by decreasing length, so that a batch only has to be
+  // stepped up to the length of the longest sequence it contains.
+  ReorderSequences(arma::stable_sort_index(this->sequenceLengths.t(),
+      "descend"));
+
+  this->deterministic = true;
+  ResetDeterministic();
+
+  if (!reset)
+  {
+    ResetParameters();
+  }
+
+  WarnMessageMaxIterations<OptimizerType>(optimizer, this->predictors.n_cols);
+
+  // Train the model.
+  Timer::Start("BRNN_optimization");
+  const double out = optimizer.Optimize(*this, parameter);
+  Timer::Stop("BRNN_optimization");
+
+  Log::Info << "BRNN::BRNN(): final objective of trained model is " << out
+      << "." << std::endl;
+  return out;
+}
+
+template<typename OutputLayerType, typename MergeLayerType,
+         typename MergeOutputType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType>
+double BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
+    InitializationRuleType, CustomLayers...>::Train(
+    arma::cube predictors,
+    arma::cube responses,
+    arma::urowvec sequenceLengths)
+{
+  OptimizerType optimizer;
+  return Train(std::move(predictors), std::move(responses),
+      std::move(sequenceLengths), optimizer);
+}
+
+template<typename OutputLayerType, typename MergeLayerType,
+         typename MergeOutputType, typename InitializationRuleType,
+         typename... CustomLayers>
+void BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
+    InitializationRuleType, CustomLayers...>::ReorderSequences(
+    const arma::uvec& ordering)
+{
+  arma::cube newPredictors(predictors.n_rows, predictors.n_cols,
+      predictors.n_slices);
+  arma::cube newResponses(responses.n_rows, responses.n_cols,
+      responses.n_slices);
+  arma::urowvec newLengths(sequenceLengths.n_elem);
+
+  for (size_t i = 0; i < ordering.n_elem; ++i)
+    newLengths[i] = sequenceLengths[ordering[i]];
+
+  for (size_t s = 0; s < predictors.n_slices; ++s)
+  {
+    for (size_t i = 0; i < ordering.n_elem; ++i)
+      newPredictors.slice(s).col(i) = predictors.slice(s).col(ordering[i]);
+  }
+
+  for (size_t s = 0; s < responses.n_slices; ++s)
+  {
+    for (size_t i = 0; i < ordering.n_elem; ++i)
+      newResponses.slice(s).col(i) = responses.slice(s).col(ordering[i]);
+  }
+
+  predictors = std::move(newPredictors);
+  responses = std::move(newResponses);
+  sequenceLengths = std::move(newLengths);
+}
+
+template<typename OutputLayerType, typename MergeLayerType,
+         typename MergeOutputType, typename InitializationRuleType,
+         typename... CustomLayers>
+size_t BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
+    InitializationRuleType, CustomLayers...>::BatchRho(
+    const size_t begin, const size_t batchSize) const
+{
+  if (sequenceLengths.is_empty())
+    return rho;
+
+  return std::min(rho, size_t(arma::max(
+      sequenceLengths.subvec(begin, begin + batchSize - 1))));
+}
+
 template<typename OutputLayerType, typename MergeLayerType,
          typename MergeOutputType, typename InitializationRuleType,
          typename... CustomLayers>
@@ -297,14 +410,17 @@ double BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
   double performance = 0;
   size_t responseSeq = 0;
 
+  // Step both time directions only up to the longest sequence of the batch.
+  const size_t effectiveRho = BatchRho(begin, batchSize);
+
   std::vector<arma::mat> results1, results2;
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
   {
     forwardRNN.Forward(arma::mat(
         predictors.slice(seqNum).colptr(begin),
         predictors.n_rows, batchSize, false, true));
     backwardRNN.Forward(arma::mat(
-        predictors.slice(rho - seqNum - 1).colptr(begin),
+        predictors.slice(effectiveRho - seqNum - 1).colptr(begin),
         predictors.n_rows, batchSize, false, true));
 
     boost::apply_visitor(SaveOutputParameterVisitor(results1),
@@ -322,7 +438,7 @@ double BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
 
   // Performance calculation after forwarding through merge layer.
   arma::mat input;
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
   {
     if (!single)
     {
@@ -414,15 +530,18 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   backwardRNN.ResetCells();
   size_t networkSize = backwardRNN.network.size();
 
+  // Step both time directions only up to the longest sequence of the batch.
+  const size_t effectiveRho = BatchRho(begin, batchSize);
+
   // Forward propogation from both directions.
   std::vector<arma::mat> results1, results2;
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
   {
     forwardRNN.Forward(arma::mat(
         predictors.slice(seqNum).colptr(begin),
         predictors.n_rows, batchSize, false, true));
     backwardRNN.Forward(arma::mat(
-        predictors.slice(rho - seqNum - 1).colptr(begin),
+        predictors.slice(effectiveRho - seqNum - 1).colptr(begin),
         predictors.n_rows, batchSize, false, true));
 
     for (size_t l = 0; l < networkSize; ++l)
@@ -447,11 +566,11 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   arma::cube results;
   if (std::is_same<MergeLayerType, Concat<>>::value)
   {
-    results = arma::zeros<arma::cube>(outputSize * 2, batchSize, rho);
+    results = arma::zeros<arma::cube>(outputSize * 2, batchSize, effectiveRho);
   }
   else
   {
-    results = arma::zeros<arma::cube>(outputSize, batchSize, rho);
+    results = arma::zeros<arma::cube>(outputSize, batchSize, effectiveRho);
   }
 
   double performance = 0;
@@ -460,7 +579,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
 
   reverse(results1.begin(), results1.end());
   // Performance calculation here.
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
   {
     if (!single)
     {
@@ -485,7 +604,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   arma::mat delta;
   std::vector<arma::mat> allDelta;
 
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
   {
     if (single && seqNum > 0)
     {
@@ -518,7 +637,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   backwardGradient.zeros();
   backwardRNN.ResetGradients(backwardGradient);
 
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
   {
     forwardGradient.zeros();
     for (size_t l = 0; l < networkSize; ++l)
@@ -544,12 +663,12 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
           forwardRNN.network[networkSize - i]);
     }
     forwardRNN.Gradient(
-        arma::mat(predictors.slice(rho - seqNum - 1).colptr(begin),
+        arma::mat(predictors.slice(effectiveRho - seqNum - 1).colptr(begin),
         predictors.n_rows, batchSize, false, true));
     boost::apply_visitor(GradientVisitor(
         boost::apply_visitor(outputParameterVisitor,
         forwardRNN.network[networkSize - 2]),
-        allDelta[rho - seqNum - 1], 0), mergeLayer);
+        allDelta[effectiveRho - seqNum - 1], 0), mergeLayer);
     totalGradient += forwardGradient;
   }
 
@@ -557,7 +676,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   totalGradient = arma::mat(gradient.memptr() + parameter.n_elem/2,
       parameter.n_elem/2, 1, false, false);
 
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
   {
     backwardGradient.zeros();
     for (size_t l = 0; l < networkSize; ++l)
@@ -612,11 +731,26 @@ template<typename OutputLayerType, typename MergeLayerType,
 void BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
     InitializationRuleType, CustomLayers...>::Shuffle()
 {
-  arma::cube newPredictors, newResponses;
-  math::ShuffleData(predictors, responses, newPredictors, newResponses);
+  if (sequenceLengths.is_empty())
+  {
+    arma::cube newPredictors, newResponses;
+    math::ShuffleData(predictors, responses, newPredictors, newResponses);
 
-  predictors = std::move(newPredictors);
-  responses = std::move(newResponses);
+    predictors = std::move(newPredictors);
+    responses = std::move(newResponses);
+    return;
+  }
+
+  // Keep the sequences sorted by decreasing length: a random permutation is
+  // stably re-sorted by length, which shuffles the order only within groups
+  // of equal length.
+  arma::uvec ordering = arma::shuffle(
+      arma::regspace<arma::uvec>(0, predictors.n_cols - 1));
+  std::stable_sort(ordering.begin(), ordering.end(),
+      [this](const arma::uword a, const arma::uword b)
+      { return sequenceLengths[a] > sequenceLengths[b]; });
+
+  ReorderSequences(ordering);
 }
 
 template<typename OutputLayerType, typename MergeLayerType,
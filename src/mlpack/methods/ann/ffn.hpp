@@ -15,8 +15,10 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "visitor/backward_ignores_input_visitor.hpp"
 #include "visitor/delete_visitor.hpp"
 #include "visitor/delta_visitor.hpp"
+#include "visitor/elementwise_visitor.hpp"
 #include "visitor/output_height_visitor.hpp"
 #include "visitor/output_parameter_visitor.hpp"
 #include "visitor/output_width_visitor.hpp"
@@ -31,6 +33,7 @@
 #include <mlpack/methods/ann/layer/layer.hpp>
 #include <mlpack/methods/ann/init_rules/random_init.hpp>
 #include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/core/data/prefetching_chunk_iterator.hpp>
 #include <ensmallen.hpp>
 
 namespace mlpack {
@@ -39,6 +42,12 @@ namespace ann /** Artificial Neural Network. */ {
 /**
  * Implementation of a standard feed forward network.
  *
+ * Note that Predict(), PredictBatch(), and Evaluate() are not const: the
+ * layers store their activations internally and reuse that storage across
+ * calls, so a single FFN object must not serve concurrent inference calls
+ * from multiple threads.  For multi-threaded serving, give each thread its
+ * own copy of the trained network; copies share no state.
+ *
  * @tparam OutputLayerType The output layer type used to evaluate the network.
  * @tparam InitializationRuleType Rule used to initialize the weight matrix.
  * @tparam CustomLayers Any set of custom layers that could be a part of the
@@ -163,6 +172,32 @@ class FFN
                arma::mat responses,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the feedforward network on chunks of data produced by the given
+   * iterator, using the given optimizer.  Each chunk is trained on as soon as
+   * it is available, while the iterator's background thread materializes the
+   * next one; this overlaps disk reads with training when the iterator is
+   * backed by an OutOfCoreMatrix.  This makes one pass over the iterator;
+   * call iterator.Reset() and Train() again for further epochs.
+   *
+   * This will use the existing model parameters as a starting point for the
+   * optimization (and each chunk continues from the parameters left by the
+   * previous chunk).
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param iterator Iterator yielding chunks of predictors and responses.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The objective of the model on the last chunk (NaN or Inf on
+   *      error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double Train(data::PrefetchingChunkIterator<double>& iterator,
+               OptimizerType& optimizer,
+               CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -176,6 +211,26 @@ class FFN
    */
   void Predict(arma::mat predictors, arma::mat& results);
 
+  /**
+   * Predict the responses to a given set of predictors, processing batchSize
+   * points per forward pass instead of one.  This is the method to use for
+   * latency-sensitive inference: the input is aliased instead of copied, and
+   * the activation workspaces of the layers are sized for the batch on the
+   * first pass and then reused, so repeated calls with the same batch size
+   * perform no allocations beyond the results matrix.
+   *
+   * If the number of points is not a multiple of batchSize, the final smaller
+   * batch causes the workspaces to be resized; choose a batch size that
+   * divides the number of points to avoid this.
+   *
+   * @param predictors Input predictors.
+   * @param results Matrix to put output predictions of responses into.
+   * @param batchSize Number of points to process per forward pass.
+   */
+  void PredictBatch(const arma::mat& predictors,
+                    arma::mat& results,
+                    const size_t batchSize = 128);
+
   /**
    * Evaluate the feedforward network with the given predictors and responses.
    * This functions is usually used to monitor progress while training.
@@ -277,7 +332,9 @@ class FFN
 
   /**
    * Shuffle the order of function visitation. This may be called by the
-   * optimizer.
+   * optimizer.  Only a permutation of indices is generated; the training data
+   * itself is never copied or reordered, and mini-batches are gathered
+   * through the permutation on demand.
    */
   void Shuffle();
 
@@ -324,6 +381,14 @@ class FFN
   //! Modify the matrix of data points (predictors).
   arma::mat& Predictors() { return predictors; }
 
+  //! Get whether gradient evaluations during training are data-parallel.
+  bool Parallel() const { return parallel; }
+  //! Modify whether gradient evaluations during training are data-parallel.
+  //! If set, each batch is sharded over one network replica per OpenMP
+  //! thread and the shard gradients are summed; this changes the order of
+  //! the floating point accumulation, but not the expected result.
+  bool& Parallel() { return parallel; }
+
   /**
    * Reset the module infomration (weights/parameters).
    */
@@ -433,6 +498,39 @@ class FFN
    */
   void Swap(FFN& network);
 
+  /**
+   * Recompute which layers may run their Forward() pass in place on the
+   * output activation of the preceding layer.  Layer i may do so if it is
+   * elementwise and layer i - 1 does not read its own output activation
+   * during the backward pass (see LayerTraits).  The last layer is never run
+   * in place, since its output activation is read by the output layer.
+   */
+  void ResetInPlaceLayers();
+
+  /**
+   * Return the matrix holding the output activation of the layer with the
+   * given index.  For an in-place layer the activation lives in the output
+   * parameter of the preceding layer.
+   *
+   * @param index Index of the layer.
+   */
+  arma::mat& LayerOutputParameter(const size_t index);
+
+  /**
+   * Create one network replica per thread for data-parallel gradient
+   * evaluation.  The layers of each replica are pointed at the parameter
+   * matrix of this network, so the replicas see every optimizer update
+   * without explicit weight synchronization.
+   *
+   * @param numModels Number of replicas to create.
+   */
+  void CreateThreadModels(const size_t numModels);
+
+  /**
+   * Delete the per-thread network replicas; they are rebuilt on demand.
+   */
+  void ClearThreadModels();
+
   //! Instantiated outputlayer used to evaluate the network.
   OutputLayerType outputLayer;
 
@@ -452,12 +550,21 @@ class FFN
   //! Locally-stored model modules.
   std::vector<LayerTypes<CustomLayers...> > network;
 
+  //! For each layer, whether its Forward() pass runs in place on the output
+  //! activation of the preceding layer; rebuilt by ResetInPlaceLayers()
+  //! whenever the network structure changes.
+  std::vector<bool> inPlaceLayer;
+
   //! The matrix of data points (predictors).
   arma::mat predictors;
 
   //! The matrix of responses to the input data points.
   arma::mat responses;
 
+  //! The visitation ordering of the training points; empty until Shuffle() is
+  //! called, which denotes the identity ordering.
+  arma::uvec ordering;
+
   //! Matrix of (trained) parameters.
   arma::mat parameter;
 
@@ -494,6 +601,14 @@ class FFN
   //! The current evaluation mode (training or testing).
   bool deterministic;
 
+  //! If true, gradient evaluations during training are sharded over one
+  //! network replica per OpenMP thread.
+  bool parallel;
+
+  //! Per-thread network replicas used for data-parallel gradient evaluation;
+  //! their layers alias the parameter matrix of this network.
+  std::vector<FFN*> threadModels;
+
   //! Locally-stored delta object.
   arma::mat delta;
 
@@ -15,6 +15,8 @@
 // In case it hasn't been included yet.
 #include "ffn.hpp"
 
+#include <mlpack/core/math/shuffle_data.hpp>
+
 #include "visitor/forward_visitor.hpp"
 #include "visitor/backward_visitor.hpp"
 #include "visitor/deterministic_set_visitor.hpp"
@@ -39,7 +41,8 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     height(0),
     reset(false),
     numFunctions(0),
-    deterministic(false)
+    deterministic(false),
+    parallel(false)
 {
   /* Nothing to do here. */
 }
@@ -48,6 +51,8 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::~FFN()
 {
+  ClearThreadModels();
+
   std::for_each(network.begin(), network.end(),
       boost::apply_visitor(deleteVisitor));
 }
@@ -60,9 +65,15 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::ResetData(
   numFunctions = responses.n_cols;
   this->predictors = std::move(predictors);
   this->responses = std::move(responses);
+  // Any previous visitation ordering belongs to the old dataset.
+  this->ordering.clear();
   this->deterministic = false;
   ResetDeterministic();
 
+  // The architecture or parameter matrix may change below; any existing
+  // thread replicas are stale now and will be rebuilt on demand.
+  ClearThreadModels();
+
   if (!reset)
     ResetParameters();
 }
@@ -157,6 +168,30 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
   return out;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType, typename... CallbackTypes>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
+    data::PrefetchingChunkIterator<double>& iterator,
+    OptimizerType& optimizer,
+    CallbackTypes&&... callbacks)
+{
+  double out = 0.0;
+
+  // The iterator's background thread reads the next chunk while we train on
+  // the current one.  The chunks are moved into Train(), which takes its
+  // matrices by value, so no extra copy is made.  The callbacks are passed as
+  // lvalues since they are reused across chunks.
+  arma::mat chunkPredictors, chunkResponses;
+  while (iterator.Next(chunkPredictors, chunkResponses))
+  {
+    out = Train(std::move(chunkPredictors), std::move(chunkResponses),
+        optimizer, callbacks...);
+  }
+
+  return out;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename PredictorsType, typename ResponsesType>
@@ -258,6 +293,60 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+PredictBatch(const arma::mat& predictors,
+             arma::mat& results,
+             const size_t batchSize)
+{
+  CheckInputShape<std::vector<LayerTypes<CustomLayers...> > >(
+      network, predictors.n_rows, "FFN<>::PredictBatch()");
+
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("FFN::PredictBatch(): batch size must be "
+        "greater than zero!");
+  }
+
+  if (parameter.is_empty())
+    ResetParameters();
+
+  if (!deterministic)
+  {
+    deterministic = true;
+    ResetDeterministic();
+  }
+
+  // Run the first batch to find the output dimensionality, so that the
+  // results matrix can be sized without an extra copy of the network output.
+  const size_t firstBatch = std::min(batchSize, (size_t) predictors.n_cols);
+
+  // The const_cast is safe: the aliased matrix is only ever read by the
+  // forward pass.  Aliasing instead of copying keeps the hot path free of
+  // predictor copies.
+  Forward(arma::mat(const_cast<double*>(predictors.colptr(0)),
+      predictors.n_rows, firstBatch, false, true));
+
+  const arma::mat& output = boost::apply_visitor(outputParameterVisitor,
+      network.back());
+  results.set_size(output.n_rows, predictors.n_cols);
+  results.cols(0, firstBatch - 1) = output;
+
+  for (size_t begin = firstBatch; begin < predictors.n_cols;
+       begin += batchSize)
+  {
+    const size_t effectiveBatchSize = std::min(batchSize,
+        (size_t) predictors.n_cols - begin);
+
+    Forward(arma::mat(const_cast<double*>(predictors.colptr(begin)),
+        predictors.n_rows, effectiveBatchSize, false, true));
+
+    results.cols(begin, begin + effectiveBatchSize - 1) =
+        boost::apply_visitor(outputParameterVisitor, network.back());
+  }
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename PredictorsType, typename ResponsesType>
@@ -319,10 +408,16 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
     ResetDeterministic();
   }
 
-  Forward(predictors.cols(begin, begin + batchSize - 1));
+  // Gather the batch in the current visitation ordering; before Shuffle() is
+  // called this is just a contiguous slice.
+  arma::mat batchPredictors, batchResponses;
+  math::OrderedBatch(predictors, ordering, begin, batchSize, batchPredictors);
+  math::OrderedBatch(responses, ordering, begin, batchSize, batchResponses);
+
+  Forward(batchPredictors);
   double res = outputLayer.Forward(
       boost::apply_visitor(outputParameterVisitor, network.back()),
-      responses.cols(begin, begin + batchSize - 1));
+      batchResponses);
 
   for (size_t i = 0; i < network.size(); ++i)
   {
@@ -380,10 +475,96 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     ResetDeterministic();
   }
 
-  Forward(predictors.cols(begin, begin + batchSize - 1));
+  #ifdef HAS_OPENMP
+  const size_t numShards = (size_t) omp_get_max_threads();
+  #else
+  const size_t numShards = 1;
+  #endif
+
+  // Gather the batch in the current visitation ordering; before Shuffle() is
+  // called this is just a contiguous slice.
+  arma::mat batchPredictors, batchResponses;
+  math::OrderedBatch(predictors, ordering, begin, batchSize, batchPredictors);
+  math::OrderedBatch(responses, ordering, begin, batchSize, batchResponses);
+
+  // If data-parallel evaluation is enabled and the batch is large enough to
+  // be worth sharding, run the forward and backward passes of contiguous
+  // batch shards concurrently, one network replica per thread, and sum the
+  // shard gradients.  The output layer is evaluated once on the gathered
+  // full-batch output, so losses that normalize over the batch (e.g.
+  // MeanSquaredError) behave exactly as in the serial path.
+  if (parallel && numShards > 1 && batchSize >= 2 * numShards)
+  {
+    if (threadModels.empty())
+      CreateThreadModels(numShards);
+
+    const size_t shardSize = (batchSize + numShards - 1) / numShards;
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t s = 0; s < (omp_size_t) numShards; ++s)
+    {
+      const size_t shardBegin = s * shardSize;
+      const size_t shardEnd = std::min(batchSize, shardBegin + shardSize);
+
+      if (shardBegin < shardEnd)
+      {
+        threadModels[s]->Forward(batchPredictors.cols(shardBegin,
+            shardEnd - 1));
+      }
+    }
+
+    // Gather the shard outputs into one full-batch output matrix.
+    arma::mat networkOutput(boost::apply_visitor(outputParameterVisitor,
+        threadModels[0]->network.back()).n_rows, batchSize);
+    for (size_t s = 0; s < numShards; ++s)
+    {
+      const size_t shardBegin = s * shardSize;
+      const size_t shardEnd = std::min(batchSize, shardBegin + shardSize);
+
+      if (shardBegin < shardEnd)
+      {
+        networkOutput.cols(shardBegin, shardEnd - 1) = boost::apply_visitor(
+            outputParameterVisitor, threadModels[s]->network.back());
+      }
+    }
+
+    double res = outputLayer.Forward(networkOutput, batchResponses);
+
+    for (size_t s = 0; s < numShards; ++s)
+      for (size_t i = 0; i < threadModels[s]->network.size(); ++i)
+        res += boost::apply_visitor(lossVisitor, threadModels[s]->network[i]);
+
+    outputLayer.Backward(networkOutput, batchResponses, error);
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t s = 0; s < (omp_size_t) numShards; ++s)
+    {
+      const size_t shardBegin = s * shardSize;
+      const size_t shardEnd = std::min(batchSize, shardBegin + shardSize);
+
+      if (shardBegin < shardEnd)
+      {
+        FFN& model = *threadModels[s];
+        arma::mat shardGradient = arma::zeros<arma::mat>(parameter.n_rows,
+            parameter.n_cols);
+
+        model.error = error.cols(shardBegin, shardEnd - 1);
+        model.Backward();
+        model.ResetGradients(shardGradient);
+        model.Gradient(batchPredictors.cols(shardBegin, shardEnd - 1));
+
+        #pragma omp critical (ffnParallelGradient)
+        gradient += shardGradient;
+      }
+    }
+
+    return res;
+  }
+
+  Forward(batchPredictors);
   double res = outputLayer.Forward(
       boost::apply_visitor(outputParameterVisitor, network.back()),
-      responses.cols(begin, begin + batchSize - 1));
+      batchResponses);
 
   for (size_t i = 0; i < network.size(); ++i)
   {
@@ -392,12 +573,12 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
 
   outputLayer.Backward(
       boost::apply_visitor(outputParameterVisitor, network.back()),
-      responses.cols(begin, begin + batchSize - 1),
+      batchResponses,
       error);
 
   Backward();
   ResetGradients(gradient);
-  Gradient(predictors.cols(begin, begin + batchSize - 1));
+  Gradient(batchPredictors);
 
   return res;
 }
@@ -417,7 +598,11 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Shuffle()
 {
-  math::ShuffleData(predictors, responses, predictors, responses);
+  // Only a permutation of indices is generated; materializing a shuffled copy
+  // of the dataset would cost a full copy of the data every epoch.  The batch
+  // Evaluate() and EvaluateWithGradient() functions gather their batches
+  // through this ordering on demand.
+  ordering = math::ShuffleOrdering(predictors.n_cols);
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -456,12 +641,62 @@ void FFN<OutputLayerType, InitializationRuleType,
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::CreateThreadModels(const size_t numModels)
+{
+  // Move the training data out of the way while copying, so the replicas do
+  // not each hold a copy of the dataset; they read their shards directly
+  // from the predictors matrix of this network.
+  arma::mat tmpPredictors(std::move(predictors));
+  arma::mat tmpResponses(std::move(responses));
+
+  for (size_t i = 0; i < numModels; ++i)
+    threadModels.push_back(new FFN(*this));
+
+  predictors = std::move(tmpPredictors);
+  responses = std::move(tmpResponses);
+
+  for (size_t i = 0; i < numModels; ++i)
+  {
+    // Point the replica layers at the parameter matrix of this network.  The
+    // weights are only read during the parallel evaluation, so sharing them
+    // is safe, and the replicas see every optimizer update for free.
+    size_t offset = 0;
+    for (size_t l = 0; l < threadModels[i]->network.size(); ++l)
+    {
+      offset += boost::apply_visitor(WeightSetVisitor(parameter, offset),
+          threadModels[i]->network[l]);
+
+      boost::apply_visitor(resetVisitor, threadModels[i]->network[l]);
+    }
+
+    threadModels[i]->deterministic = deterministic;
+    threadModels[i]->ResetDeterministic();
+    threadModels[i]->parallel = false;
+  }
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ClearThreadModels()
+{
+  for (size_t i = 0; i < threadModels.size(); ++i)
+    delete threadModels[i];
+  threadModels.clear();
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename InputType>
 void FFN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::Forward(const InputType& input)
 {
+  if (inPlaceLayer.size() != network.size())
+    ResetInPlaceLayers();
+
   boost::apply_visitor(ForwardVisitor(input,
       boost::apply_visitor(outputParameterVisitor, network.front())),
       network.front());
@@ -490,9 +725,14 @@ void FFN<OutputLayerType, InitializationRuleType,
       boost::apply_visitor(SetInputHeightVisitor(height), network[i]);
     }
 
-    boost::apply_visitor(ForwardVisitor(boost::apply_visitor(
-        outputParameterVisitor, network[i - 1]),
-        boost::apply_visitor(outputParameterVisitor, network[i])), network[i]);
+    // An in-place layer overwrites the output activation of the preceding
+    // layer instead of filling a separate output matrix; this avoids the
+    // allocation and copy of an activation-sized buffer per elementwise
+    // layer.
+    arma::mat& layerInput = LayerOutputParameter(i - 1);
+    boost::apply_visitor(ForwardVisitor(layerInput, inPlaceLayer[i] ?
+        layerInput : boost::apply_visitor(outputParameterVisitor,
+        network[i])), network[i]);
 
     if (!reset)
     {
@@ -524,8 +764,10 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Backward()
 
   for (size_t i = 2; i < network.size(); ++i)
   {
-    boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
-        outputParameterVisitor, network[network.size() - i]),
+    // The output activation of an in-place layer lives in the output
+    // parameter of the preceding layer.
+    boost::apply_visitor(BackwardVisitor(
+        LayerOutputParameter(network.size() - i),
         boost::apply_visitor(deltaVisitor, network[network.size() - i + 1]),
         boost::apply_visitor(deltaVisitor, network[network.size() - i])),
         network[network.size() - i]);
@@ -543,16 +785,45 @@ void FFN<OutputLayerType, InitializationRuleType,
 
   for (size_t i = 1; i < network.size() - 1; ++i)
   {
-    boost::apply_visitor(GradientVisitor(boost::apply_visitor(
-        outputParameterVisitor, network[i - 1]),
+    boost::apply_visitor(GradientVisitor(LayerOutputParameter(i - 1),
         boost::apply_visitor(deltaVisitor, network[i + 1])), network[i]);
   }
 
-  boost::apply_visitor(GradientVisitor(boost::apply_visitor(
-      outputParameterVisitor, network[network.size() - 2]), error),
+  boost::apply_visitor(GradientVisitor(
+      LayerOutputParameter(network.size() - 2), error),
       network[network.size() - 1]);
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ResetInPlaceLayers()
+{
+  inPlaceLayer.assign(network.size(), false);
+
+  // The last layer is skipped since its output activation is read by the
+  // output layer and by Predict().  An elementwise layer itself does not set
+  // BackwardIgnoresInput, so two consecutive elementwise layers never run in
+  // place on the same buffer.
+  for (size_t i = 1; i + 1 < network.size(); ++i)
+  {
+    inPlaceLayer[i] =
+        boost::apply_visitor(ElementwiseVisitor(), network[i]) &&
+        boost::apply_visitor(BackwardIgnoresInputVisitor(), network[i - 1]);
+  }
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+arma::mat& FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::LayerOutputParameter(const size_t index)
+{
+  if (index > 0 && index < inPlaceLayer.size() && inPlaceLayer[index])
+    return boost::apply_visitor(outputParameterVisitor, network[index - 1]);
+
+  return boost::apply_visitor(outputParameterVisitor, network[index]);
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename Archive>
@@ -568,6 +839,8 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::serialize(
   // Be sure to clear other layers before loading.
   if (cereal::is_loading<Archive>())
   {
+    ClearThreadModels();
+
     std::for_each(network.begin(), network.end(),
         boost::apply_visitor(deleteVisitor));
     network.clear();
@@ -602,7 +875,14 @@ void FFN<OutputLayerType, InitializationRuleType,
   std::swap(width, network.width);
   std::swap(height, network.height);
   std::swap(reset, network.reset);
+  // The replica layers alias the parameter matrices being swapped, so it is
+  // easiest to drop the replicas on both sides and rebuild them on demand.
+  ClearThreadModels();
+  network.ClearThreadModels();
+
+  std::swap(parallel, network.parallel);
   std::swap(this->network, network.network);
+  std::swap(inPlaceLayer, network.inPlaceLayer);
   std::swap(predictors, network.predictors);
   std::swap(responses, network.responses);
   std::swap(parameter, network.parameter);
@@ -630,6 +910,7 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     numFunctions(network.numFunctions),
     error(network.error),
     deterministic(network.deterministic),
+    parallel(network.parallel),
     delta(network.delta),
     inputParameter(network.inputParameter),
     outputParameter(network.outputParameter),
@@ -659,6 +940,7 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     numFunctions(network.numFunctions),
     error(std::move(network.error)),
     deterministic(network.deterministic),
+    parallel(network.parallel),
     delta(std::move(network.delta)),
     inputParameter(std::move(network.inputParameter)),
     outputParameter(std::move(network.outputParameter)),
@@ -16,6 +16,8 @@
 // In case it hasn't yet been included.
 #include "dropout.hpp"
 
+#include <mlpack/core/math/random.hpp>
+
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
@@ -92,9 +94,11 @@ void Dropout<InputDataType, OutputDataType>::Forward(
   else
   {
     // Scale with input / (1 - ratio) and set values to zero with probability
-    // 'ratio'.
-    mask = arma::randu<arma::Mat<eT> >(input.n_rows, input.n_cols);
-    mask.transform([&](double val) { return (val > ratio); });
+    // 'ratio'.  The mask is drawn from the per-thread generator, so seeded
+    // runs---including parallel ones using deterministic streams (see
+    // math::SeedThreadStream())---reproduce the same masks.
+    mask.set_size(input.n_rows, input.n_cols);
+    mask.imbue([&]() { return (eT) (math::Random() > ratio); });
     output = input % mask * scale;
   }
 }
@@ -198,44 +198,48 @@ void FastLSTM<InputDataType, OutputDataType>::Forward(
       forwardStep, forwardStep + batchStep);
   gate.cols(forwardStep, forwardStep + batchStep).each_col() += input2GateBias;
 
-  arma::subview<double> sigmoidOut = gateActivation.cols(forwardStep,
-      forwardStep + batchStep);
-  FastSigmoid(
-      gate.submat(0, forwardStep, 3 * outSize - 1, forwardStep + batchStep),
-      sigmoidOut);
-
-  stateActivation.cols(forwardStep, forwardStep + batchStep) = arma::tanh(
-      gate.submat(3 * outSize, forwardStep, 4 * outSize - 1,
-      forwardStep + batchStep));
-
-  // Update the cell: cmul1 + cmul2
-  // where cmul1 is input gate * hidden state and
-  // cmul2 is forget gate * cell (prevCell).
-  if (forwardStep == 0)
+  // Apply the gate nonlinearities, update the cell and produce the output in
+  // one pass over each column, while the gate pre-activations of that column
+  // are still in cache.  This replaces a chain of Armadillo expressions that
+  // each traversed the full hidden state again; the stored intermediate
+  // activations are unchanged, since Backward() and Gradient() read them.
+  for (size_t j = 0; j <= batchStep; ++j)
   {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        gateActivation.submat(0, forwardStep, outSize - 1,
-        forwardStep + batchStep) %
-        stateActivation.cols(forwardStep, forwardStep + batchStep);
+    const ElemType* gateCol = gate.colptr(forwardStep + j);
+    ElemType* activationCol = gateActivation.colptr(forwardStep + j);
+    ElemType* stateCol = stateActivation.colptr(forwardStep + j);
+    ElemType* cellCol = cell.colptr(forwardStep + j);
+    const ElemType* prevCellCol = (forwardStep > 0) ?
+        cell.colptr(forwardStep - batchSize + j) : NULL;
+    ElemType* cellActivationCol = cellActivation.colptr(forwardStep + j);
+    ElemType* outputCol = outParameter.colptr(forwardStep + batchSize + j);
+
+    for (size_t i = 0; i < outSize; ++i)
+    {
+      // Gate order in the combined pre-activation block: input, output,
+      // forget, and finally the cell candidate.
+      const ElemType inputGate = FastSigmoid(gateCol[i]);
+      const ElemType outputGate = FastSigmoid(gateCol[outSize + i]);
+      const ElemType forgetGate = FastSigmoid(gateCol[2 * outSize + i]);
+      const ElemType state = std::tanh(gateCol[3 * outSize + i]);
+
+      activationCol[i] = inputGate;
+      activationCol[outSize + i] = outputGate;
+      activationCol[2 * outSize + i] = forgetGate;
+      stateCol[i] = state;
+
+      // Update the cell: input gate * hidden state, plus forget gate *
+      // previous cell if this is not the first step.
+      ElemType cellValue = inputGate * state;
+      if (prevCellCol != NULL)
+        cellValue += forgetGate * prevCellCol[i];
+      cellCol[i] = cellValue;
+
+      const ElemType cellActivationValue = std::tanh(cellValue);
+      cellActivationCol[i] = cellActivationValue;
+      outputCol[i] = cellActivationValue * outputGate;
+    }
   }
-  else
-  {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        gateActivation.submat(0, forwardStep, outSize - 1,
-        forwardStep + batchStep) %
-        stateActivation.cols(forwardStep, forwardStep + batchStep) +
-        gateActivation.submat(2 * outSize, forwardStep, 3 * outSize - 1,
-        forwardStep + batchStep) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
-  }
-
-  cellActivation.cols(forwardStep, forwardStep + batchStep) =
-      arma::tanh(cell.cols(forwardStep, forwardStep + batchStep));
-
-  outParameter.cols(forwardStep + batchSize,
-      forwardStep + batchSize + batchStep) = cellActivation.cols(
-      forwardStep, forwardStep + batchStep) % gateActivation.submat(
-      outSize, forwardStep, 2 * outSize - 1, forwardStep + batchStep);
 
   output = OutputType(outParameter.memptr() +
       (forwardStep + batchSize) * outSize, outSize, batchSize, false, false);
@@ -53,6 +53,21 @@ class LayerTraits
    * This is true if the layer is a connection layer.
    **/
   static const bool IsConnection = false;
+
+  /**
+   * This is true if the layer applies an elementwise function: its Forward()
+   * may write the result into the input matrix (in-place execution), and its
+   * Backward() needs only the layer's output activation, which mlpack passes
+   * as the input argument.
+   */
+  static const bool IsElementwise = false;
+
+  /**
+   * This is true if the layer's Backward() ignores the input argument (the
+   * layer's own output activation), so a following in-place elementwise layer
+   * may overwrite that activation safely.
+   */
+  static const bool BackwardIgnoresInput = false;
 };
 
 // This gives us a HasGradientCheck<T, U> type (where U is a function pointer)
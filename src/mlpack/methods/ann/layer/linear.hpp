@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_ANN_LAYER_LINEAR_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
 #include <mlpack/methods/ann/regularizer/no_regularizer.hpp>
 
 #include "layer_types.hpp"
@@ -196,6 +197,24 @@ class Linear
   RegularizerType regularizer;
 }; // class Linear
 
+//! Linear's Backward() only uses the weight matrix and the backpropagated
+//! error, so a following in-place elementwise layer may overwrite its output
+//! activation.
+template<typename InputDataType,
+         typename OutputDataType,
+         typename RegularizerType>
+class LayerTraits<Linear<InputDataType, OutputDataType, RegularizerType>>
+{
+ public:
+  static const bool IsBinary = false;
+  static const bool IsOutputLayer = false;
+  static const bool IsBiasLayer = false;
+  static const bool IsLSTMLayer = false;
+  static const bool IsConnection = false;
+  static const bool IsElementwise = false;
+  static const bool BackwardIgnoresInput = true;
+};
+
 } // namespace ann
 } // namespace mlpack
 
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_ANN_LAYER_LINEAR_NO_BIAS_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
 #include <mlpack/methods/ann/regularizer/no_regularizer.hpp>
 
 #include "layer_types.hpp"
@@ -170,6 +171,25 @@ class LinearNoBias
   RegularizerType regularizer;
 }; // class LinearNoBias
 
+//! LinearNoBias's Backward() only uses the weight matrix and the
+//! backpropagated error, so a following in-place elementwise layer may
+//! overwrite its output activation.
+template<typename InputDataType,
+         typename OutputDataType,
+         typename RegularizerType>
+class LayerTraits<LinearNoBias<InputDataType, OutputDataType,
+    RegularizerType>>
+{
+ public:
+  static const bool IsBinary = false;
+  static const bool IsOutputLayer = false;
+  static const bool IsBiasLayer = false;
+  static const bool IsLSTMLayer = false;
+  static const bool IsConnection = false;
+  static const bool IsElementwise = false;
+  static const bool BackwardIgnoresInput = true;
+};
+
 } // namespace ann
 } // namespace mlpack
 
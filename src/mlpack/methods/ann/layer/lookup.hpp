@@ -75,6 +75,10 @@ class Lookup
 
   /**
    * Calculate the gradient using the output delta and the input activation.
+   * Only the columns of the embedding table referenced by the input tokens
+   * are written; a same-size gradient buffer from a previous call (or a
+   * zero-filled one) is rezeroed only at the previously touched columns, so
+   * repeated calls do not sweep the full table.
    *
    * @param input The input parameter used for calculating the gradient.
    * @param error The calculated error.
@@ -85,6 +89,24 @@ class Lookup
                 const arma::Mat<eT>& error,
                 arma::Mat<eT>& gradient);
 
+  /**
+   * Calculate the gradient using the output delta and the input activation,
+   * emitting a sparse gradient that holds entries only for the embeddings
+   * referenced by the batch.  For large vocabularies this avoids
+   * materializing (and later applying) a dense gradient over the full table;
+   * a custom training loop can then update only the touched rows and apply
+   * regularization such as weight decay lazily, scaling each embedding by
+   * the accumulated decay the next time it is touched.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated sparse gradient.
+   */
+  template<typename eT>
+  void Gradient(const arma::Mat<eT>& input,
+                const arma::Mat<eT>& error,
+                arma::SpMat<eT>& gradient);
+
   //! Get the parameters.
   OutputDataType const& Parameters() const { return weights; }
   //! Modify the parameters.
@@ -133,6 +155,10 @@ class Lookup
   //! Locally-stored gradient object.
   OutputDataType gradient;
 
+  //! The embedding table columns written by the last dense Gradient() call;
+  //! the next call only needs to rezero these.
+  arma::uvec touchedTokens;
+
   //! Locally-stored output parameter object.
   OutputDataType outputParameter;
 }; // class Lookup
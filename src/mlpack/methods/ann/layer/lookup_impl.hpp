@@ -72,8 +72,23 @@ void Lookup<InputDataType, OutputDataType>::Gradient(
   arma::Cube<eT> errorTemp(const_cast<arma::Mat<eT>&>(error).memptr(),
       embeddingSize, seqLength, batchSize, false, false);
 
-  gradient.set_size(arma::size(weights));
-  gradient.zeros();
+  // A full-table zeroing pass is only needed the first time (or if the buffer
+  // was resized); afterwards it is enough to rezero the columns the previous
+  // call touched, which keeps the cost proportional to the batch instead of
+  // the vocabulary.
+  if (gradient.n_rows != weights.n_rows || gradient.n_cols != weights.n_cols ||
+      touchedTokens.is_empty())
+  {
+    gradient.set_size(arma::size(weights));
+    gradient.zeros();
+  }
+  else
+  {
+    gradient.cols(touchedTokens).zeros();
+  }
+
+  touchedTokens = arma::unique(
+      arma::conv_to<arma::uvec>::from(arma::vectorise(input)) - 1);
 
   for (size_t i = 0; i < batchSize; ++i)
   {
@@ -82,6 +97,52 @@ void Lookup<InputDataType, OutputDataType>::Gradient(
   }
 }
 
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void Lookup<InputDataType, OutputDataType>::Gradient(
+    const arma::Mat<eT>& input,
+    const arma::Mat<eT>& error,
+    arma::SpMat<eT>& gradient)
+{
+  const size_t seqLength = input.n_rows;
+  const size_t batchSize = input.n_cols;
+
+  arma::Cube<eT> errorTemp(const_cast<arma::Mat<eT>&>(error).memptr(),
+      embeddingSize, seqLength, batchSize, false, false);
+
+  const arma::uvec tokens = arma::conv_to<arma::uvec>::from(
+      arma::vectorise(input)) - 1;
+  const arma::uvec uniqueTokens = arma::unique(tokens);
+
+  // Accumulate the error of every occurrence of a token into a dense buffer
+  // holding only the touched columns.
+  arma::Mat<eT> values(embeddingSize, uniqueTokens.n_elem, arma::fill::zeros);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    for (size_t j = 0; j < seqLength; ++j)
+    {
+      const size_t slot = std::lower_bound(uniqueTokens.begin(),
+          uniqueTokens.end(), tokens[i * seqLength + j]) -
+          uniqueTokens.begin();
+      values.col(slot) += errorTemp.slice(i).col(j);
+    }
+  }
+
+  // Batch-insert the touched columns into the sparse gradient.
+  arma::umat locations(2, embeddingSize * uniqueTokens.n_elem);
+  for (size_t c = 0; c < uniqueTokens.n_elem; ++c)
+  {
+    for (size_t r = 0; r < embeddingSize; ++r)
+    {
+      locations(0, c * embeddingSize + r) = r;
+      locations(1, c * embeddingSize + r) = uniqueTokens[c];
+    }
+  }
+
+  gradient = arma::SpMat<eT>(locations, arma::vectorise(values),
+      weights.n_rows, weights.n_cols);
+}
+
 template<typename InputDataType, typename OutputDataType>
 template<typename Archive>
 void Lookup<InputDataType, OutputDataType>::serialize(
@@ -0,0 +1,132 @@
+/**
+ * @file methods/ann/loss_functions/softmax_cross_entropy_error.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the softmax cross-entropy with logits performance function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_ERROR_HPP
+#define MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_ERROR_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * The SoftmaxCrossEntropyError performance function measures the network's
+ * performance according to the cross-entropy between the softmax of the
+ * network output and the target class, given the raw logits instead of the
+ * (log-)softmax activations.  It fuses what is otherwise a LogSoftMax layer
+ * followed by NegativeLogLikelihood: the forward pass is a single
+ * log-sum-exp per column, and the backward pass is simply
+ * \f$softmax(x) - onehot(y)\f$, so no separate softmax backward pass is
+ * needed.  The target is expected to hold the class index of each column,
+ * as with NegativeLogLikelihood.
+ *
+ * For networks with a very large number of classes the loss can be
+ * approximated by sampled softmax: pass a nonzero number of samples, and
+ * each forward/backward pass restricts the partition sum to the target class
+ * plus that many uniformly sampled classes, making the output-layer cost
+ * independent of the number of classes.  Prediction is unaffected (the
+ * network emits raw logits, whose argmax equals the softmax argmax).
+ *
+ * For more information on sampled softmax, see the following paper.
+ *
+ * @code
+ * @inproceedings{Jean2015,
+ *   title     = {On Using Very Large Target Vocabulary for Neural Machine
+ *                Translation},
+ *   author    = {S{\'e}bastien Jean, Kyunghyun Cho, Roland Memisevic,
+ *                Yoshua Bengio},
+ *   booktitle = {Proceedings of ACL-IJCNLP},
+ *   year      = {2015}
+ * }
+ * @endcode
+ *
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+class SoftmaxCrossEntropyError
+{
+ public:
+  /**
+   * Create the SoftmaxCrossEntropyError object.
+   *
+   * @param numSamples Number of classes to sample for the sampled softmax
+   *        approximation; 0 (the default) computes the exact loss.
+   */
+  SoftmaxCrossEntropyError(const size_t numSamples = 0);
+
+  /**
+   * Computes the softmax cross-entropy error function.
+   *
+   * @param prediction Raw logits used for evaluating the specified loss
+   *     function.
+   * @param target The target vector of class indices.
+   */
+  template<typename PredictionType, typename TargetType>
+  typename PredictionType::elem_type Forward(const PredictionType& prediction,
+                                             const TargetType& target);
+
+  /**
+   * Ordinary feed backward pass of a neural network.  The returned loss is
+   * the softmax of the logits minus the one-hot encoded target (restricted
+   * to the sampled classes if sampling is enabled).
+   *
+   * @param prediction Raw logits used for evaluating the specified loss
+   *     function.
+   * @param target The target vector of class indices.
+   * @param loss The calculated error.
+   */
+  template<typename PredictionType, typename TargetType, typename LossType>
+  void Backward(const PredictionType& prediction,
+                const TargetType& target,
+                LossType& loss);
+
+  //! Get the output parameter.
+  OutputDataType& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  //! Get the number of sampled classes (0 means the exact loss).
+  size_t NumSamples() const { return numSamples; }
+  //! Modify the number of sampled classes (0 means the exact loss).
+  size_t& NumSamples() { return numSamples; }
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Number of classes to sample for the sampled softmax approximation.
+  size_t numSamples;
+
+  //! The classes sampled by the last forward pass; the backward pass reuses
+  //! them so the gradient matches the reported loss.
+  arma::uvec sampledClasses;
+
+  //! Locally-stored output parameter object.
+  mutable OutputDataType outputParameter;
+}; // class SoftmaxCrossEntropyError
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "softmax_cross_entropy_error_impl.hpp"
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * @file methods/ann/loss_functions/softmax_cross_entropy_error_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the softmax cross-entropy with logits performance
+ * function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_ERROR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_ERROR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "softmax_cross_entropy_error.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputDataType, typename OutputDataType>
+SoftmaxCrossEntropyError<InputDataType, OutputDataType>::
+SoftmaxCrossEntropyError(const size_t numSamples) : numSamples(numSamples)
+{
+  // Nothing to do here.
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename PredictionType, typename TargetType>
+typename PredictionType::elem_type
+SoftmaxCrossEntropyError<InputDataType, OutputDataType>::Forward(
+    const PredictionType& prediction,
+    const TargetType& target)
+{
+  typedef typename PredictionType::elem_type ElemType;
+  ElemType output = 0;
+
+  if (numSamples == 0 || numSamples >= prediction.n_rows)
+  {
+    // Exact loss: one log-sum-exp per column.
+    for (size_t i = 0; i < prediction.n_cols; ++i)
+    {
+      Log::Assert(target(i) >= 0 && target(i) < prediction.n_rows,
+          "Target class out of range.");
+
+      const ElemType maxLogit = prediction.col(i).max();
+      output += maxLogit + std::log(arma::accu(arma::exp(
+          prediction.col(i) - maxLogit))) - prediction(target(i), i);
+    }
+
+    return output;
+  }
+
+  // Sampled softmax: restrict the partition sum to the target class plus a
+  // shared set of uniformly sampled classes.  The sample is stored so that
+  // the backward pass computes the gradient of the same approximation.
+  sampledClasses.set_size(numSamples);
+  for (size_t s = 0; s < numSamples; ++s)
+    sampledClasses[s] = math::RandInt(0, prediction.n_rows);
+
+  for (size_t i = 0; i < prediction.n_cols; ++i)
+  {
+    Log::Assert(target(i) >= 0 && target(i) < prediction.n_rows,
+        "Target class out of range.");
+
+    const ElemType targetLogit = prediction(target(i), i);
+    ElemType maxLogit = targetLogit;
+    for (size_t s = 0; s < numSamples; ++s)
+    {
+      maxLogit = std::max(maxLogit,
+          ElemType(prediction(sampledClasses[s], i)));
+    }
+
+    ElemType sumExp = std::exp(targetLogit - maxLogit);
+    for (size_t s = 0; s < numSamples; ++s)
+    {
+      if (sampledClasses[s] != size_t(target(i)))
+        sumExp += std::exp(prediction(sampledClasses[s], i) - maxLogit);
+    }
+
+    output += maxLogit + std::log(sumExp) - targetLogit;
+  }
+
+  return output;
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename PredictionType, typename TargetType, typename LossType>
+void SoftmaxCrossEntropyError<InputDataType, OutputDataType>::Backward(
+    const PredictionType& prediction,
+    const TargetType& target,
+    LossType& loss)
+{
+  typedef typename PredictionType::elem_type ElemType;
+
+  if (numSamples == 0 || numSamples >= prediction.n_rows)
+  {
+    // Exact gradient: softmax(x) - onehot(y).
+    loss.set_size(prediction.n_rows, prediction.n_cols);
+    for (size_t i = 0; i < prediction.n_cols; ++i)
+    {
+      Log::Assert(target(i) >= 0 && target(i) < prediction.n_rows,
+          "Target class out of range.");
+
+      const ElemType maxLogit = prediction.col(i).max();
+      loss.col(i) = arma::exp(prediction.col(i) - maxLogit);
+      loss.col(i) /= arma::accu(loss.col(i));
+      loss(target(i), i) -= 1;
+    }
+
+    return;
+  }
+
+  // Sampled softmax: only the target class and the sampled classes receive
+  // gradient.  Reuse the sample of the last forward pass if there is one.
+  if (sampledClasses.n_elem != numSamples)
+  {
+    sampledClasses.set_size(numSamples);
+    for (size_t s = 0; s < numSamples; ++s)
+      sampledClasses[s] = math::RandInt(0, prediction.n_rows);
+  }
+
+  loss.zeros(prediction.n_rows, prediction.n_cols);
+  for (size_t i = 0; i < prediction.n_cols; ++i)
+  {
+    Log::Assert(target(i) >= 0 && target(i) < prediction.n_rows,
+        "Target class out of range.");
+
+    const ElemType targetLogit = prediction(target(i), i);
+    ElemType maxLogit = targetLogit;
+    for (size_t s = 0; s < numSamples; ++s)
+    {
+      maxLogit = std::max(maxLogit,
+          ElemType(prediction(sampledClasses[s], i)));
+    }
+
+    ElemType sumExp = std::exp(targetLogit - maxLogit);
+    for (size_t s = 0; s < numSamples; ++s)
+    {
+      if (sampledClasses[s] != size_t(target(i)))
+        sumExp += std::exp(prediction(sampledClasses[s], i) - maxLogit);
+    }
+
+    loss(target(i), i) = std::exp(targetLogit - maxLogit) / sumExp - 1;
+    for (size_t s = 0; s < numSamples; ++s)
+    {
+      if (sampledClasses[s] != size_t(target(i)))
+      {
+        loss(sampledClasses[s], i) +=
+            std::exp(prediction(sampledClasses[s], i) - maxLogit) / sumExp;
+      }
+    }
+  }
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename Archive>
+void SoftmaxCrossEntropyError<InputDataType, OutputDataType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numSamples));
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
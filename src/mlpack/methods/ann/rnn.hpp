@@ -179,6 +179,59 @@ class RNN
                arma::cube responses,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the recurrent neural network on the given input data using the given
+   * optimizer, where each sequence has its own length.  The predictors and
+   * responses must still be padded to rho time steps, but time steps past a
+   * sequence's length are never evaluated: the sequences are sorted by
+   * decreasing length so that every batch is truncated to the longest
+   * sequence it contains, and the loss of a sequence's padded time steps is
+   * masked out.  For data with skewed sequence lengths this skips most of the
+   * padded time step computation.
+   *
+   * Note that the sorting changes the order in which the sequences are
+   * visited; Shuffle() reshuffles only within groups of equal length.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param sequenceLengths Length (number of time steps) of each sequence;
+   *        values are clamped to [1, rho].
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double Train(arma::cube predictors,
+               arma::cube responses,
+               arma::urowvec sequenceLengths,
+               OptimizerType& optimizer,
+               CallbackTypes&&... callbacks);
+
+  /**
+   * Train the recurrent neural network on the given input data, where each
+   * sequence has its own length.  By default, the SGD optimization algorithm
+   * is used, but others can be specified (such as ens::RMSprop).  See the
+   * overload above for the semantics of the sequence lengths.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param sequenceLengths Length (number of time steps) of each sequence;
+   *        values are clamped to [1, rho].
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType = ens::StandardSGD, typename... CallbackTypes>
+  double Train(arma::cube predictors,
+               arma::cube responses,
+               arma::urowvec sequenceLengths,
+               CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -313,6 +366,10 @@ class RNN
   //! Modify the matrix of data points (predictors).
   arma::cube& Predictors() { return predictors; }
 
+  //! Get the lengths of the training sequences (empty if every sequence has
+  //! length rho).
+  const arma::urowvec& SequenceLengths() const { return sequenceLengths; }
+
   /**
    * Reset the state of the network.  This ensures that all internally-held
    * gradients are set to 0, all memory cells are reset, and the parameters
@@ -369,6 +426,37 @@ class RNN
    */
   void ResetGradients(arma::mat& gradient);
 
+  /**
+   * Reorder the training sequences (and their lengths) according to the given
+   * column ordering.
+   *
+   * @param ordering Permutation of the sequence indices.
+   */
+  void ReorderSequences(const arma::uvec& ordering);
+
+  /**
+   * Return the number of time steps to evaluate for the given batch: the
+   * length of the longest sequence in the batch, or rho if no sequence
+   * lengths were given.
+   *
+   * @param begin Index of the first sequence of the batch.
+   * @param batchSize Number of sequences in the batch.
+   */
+  size_t BatchRho(const size_t begin, const size_t batchSize) const;
+
+  /**
+   * Return the number of sequences of the given batch that are still running
+   * at the given time step.  The sequences are sorted by decreasing length,
+   * so these form a prefix of the batch.
+   *
+   * @param begin Index of the first sequence of the batch.
+   * @param batchSize Number of sequences in the batch.
+   * @param timeStep Time step of interest.
+   */
+  size_t ActiveSequences(const size_t begin,
+                         const size_t batchSize,
+                         const size_t timeStep) const;
+
   //! Number of steps to backpropagate through time (BPTT).
   size_t rho;
 
@@ -403,6 +491,10 @@ class RNN
   //! The matrix of responses to the input data points.
   arma::cube responses;
 
+  //! The length of each training sequence, sorted in decreasing order; empty
+  //! if every sequence has length rho.
+  arma::urowvec sequenceLengths;
+
   //! Matrix of (trained) parameters.
   arma::mat parameter;
 
@@ -157,6 +157,7 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
 
   this->predictors = std::move(predictors);
   this->responses = std::move(responses);
+  this->sequenceLengths.clear();
 
   this->deterministic = true;
   ResetDeterministic();
@@ -205,6 +206,7 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
 
   this->predictors = std::move(predictors);
   this->responses = std::move(responses);
+  this->sequenceLengths.clear();
 
   this->deterministic = true;
   ResetDeterministic();
@@ -228,6 +230,136 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
   return out;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType, typename... CallbackTypes>
+double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
+    arma::cube predictors,
+    arma::cube responses,
+    arma::urowvec sequenceLengths,
+    OptimizerType& optimizer,
+    CallbackTypes&&... callbacks)
+{
+  CheckInputShape<std::vector<LayerTypes<CustomLayers...> > >(network,
+                                                              predictors.n_rows,
+                                                              "RNN<>::Train()");
+
+  if (sequenceLengths.n_elem != predictors.n_cols)
+  {
+    Log::Fatal << "RNN<>::Train(): a sequence length must be given for every "
+        << "sequence (" << sequenceLengths.n_elem << " lengths given for "
+        << predictors.n_cols << " sequences)!" << std::endl;
+  }
+
+  numFunctions = responses.n_cols;
+
+  this->predictors = std::move(predictors);
+  this->responses = std::move(responses);
+  this->sequenceLengths = arma::clamp(sequenceLengths, 1, rho);
+
+  // Sort the sequences by decreasing length, so that a batch only has to be
+  // stepped up to the length of the longest sequence it contains, and the
+  // sequences of a batch that are still running at any time step form a
+  // prefix of the batch.
+  ReorderSequences(arma::stable_sort_index(this->sequenceLengths.t(),
+      "descend"));
+
+  this->deterministic = true;
+  ResetDeterministic();
+
+  if (!reset)
+  {
+    ResetParameters();
+  }
+
+  WarnMessageMaxIterations<OptimizerType>(optimizer, this->predictors.n_cols);
+
+  // Train the model.
+  Timer::Start("rnn_optimization");
+  const double out = optimizer.Optimize(*this, parameter, callbacks...);
+  Timer::Stop("rnn_optimization");
+
+  Log::Info << "RNN::RNN(): final objective of trained model is " << out
+      << "." << std::endl;
+  return out;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType, typename... CallbackTypes>
+double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
+    arma::cube predictors,
+    arma::cube responses,
+    arma::urowvec sequenceLengths,
+    CallbackTypes&&... callbacks)
+{
+  OptimizerType optimizer;
+  return Train(std::move(predictors), std::move(responses),
+      std::move(sequenceLengths), optimizer,
+      std::forward<CallbackTypes>(callbacks)...);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void RNN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ReorderSequences(const arma::uvec& ordering)
+{
+  arma::cube newPredictors(predictors.n_rows, predictors.n_cols,
+      predictors.n_slices);
+  arma::cube newResponses(responses.n_rows, responses.n_cols,
+      responses.n_slices);
+  arma::urowvec newLengths(sequenceLengths.n_elem);
+
+  for (size_t i = 0; i < ordering.n_elem; ++i)
+    newLengths[i] = sequenceLengths[ordering[i]];
+
+  for (size_t s = 0; s < predictors.n_slices; ++s)
+  {
+    for (size_t i = 0; i < ordering.n_elem; ++i)
+      newPredictors.slice(s).col(i) = predictors.slice(s).col(ordering[i]);
+  }
+
+  for (size_t s = 0; s < responses.n_slices; ++s)
+  {
+    for (size_t i = 0; i < ordering.n_elem; ++i)
+      newResponses.slice(s).col(i) = responses.slice(s).col(ordering[i]);
+  }
+
+  predictors = std::move(newPredictors);
+  responses = std::move(newResponses);
+  sequenceLengths = std::move(newLengths);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+size_t RNN<OutputLayerType, InitializationRuleType,
+           CustomLayers...>::BatchRho(const size_t begin,
+                                      const size_t batchSize) const
+{
+  if (sequenceLengths.is_empty())
+    return rho;
+
+  return std::min(rho, size_t(arma::max(
+      sequenceLengths.subvec(begin, begin + batchSize - 1))));
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+size_t RNN<OutputLayerType, InitializationRuleType,
+           CustomLayers...>::ActiveSequences(const size_t begin,
+                                             const size_t batchSize,
+                                             const size_t timeStep) const
+{
+  if (sequenceLengths.is_empty())
+    return batchSize;
+
+  size_t active = batchSize;
+  while (active > 0 && sequenceLengths[begin + active - 1] <= timeStep)
+    --active;
+
+  return active;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
@@ -313,8 +445,9 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
 
   double performance = 0;
   size_t responseSeq = 0;
+  const size_t effectiveRho = BatchRho(begin, batchSize);
 
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
   {
     // Wrap a matrix around our data to avoid a copy.
     arma::mat stepData(predictors.slice(seqNum).colptr(begin),
@@ -325,10 +458,34 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
       responseSeq = seqNum;
     }
 
-    performance += outputLayer.Forward(boost::apply_visitor(
-        outputParameterVisitor, network.back()),
-        arma::mat(responses.slice(responseSeq).colptr(begin),
-            responses.n_rows, batchSize, false, true));
+    const arma::mat& output = boost::apply_visitor(outputParameterVisitor,
+        network.back());
+    const size_t active = ActiveSequences(begin, batchSize, seqNum);
+    if (single && !sequenceLengths.is_empty())
+    {
+      // Each sequence contributes the loss of its own final time step; the
+      // sequences that finish at this time step form a contiguous range.
+      const size_t activeNext = ActiveSequences(begin, batchSize, seqNum + 1);
+      if (active > activeNext)
+      {
+        performance += outputLayer.Forward(output.cols(activeNext, active - 1),
+            arma::mat(responses.slice(0).colptr(begin + activeNext),
+                responses.n_rows, active - activeNext, false, true));
+      }
+    }
+    else if (active == batchSize)
+    {
+      performance += outputLayer.Forward(output,
+          arma::mat(responses.slice(responseSeq).colptr(begin),
+              responses.n_rows, batchSize, false, true));
+    }
+    else
+    {
+      // The loss of the finished sequences is masked out.
+      performance += outputLayer.Forward(output.cols(0, active - 1),
+          arma::mat(responses.slice(responseSeq).colptr(begin),
+              responses.n_rows, active, false, true));
+    }
   }
 
   if (outputSize == 0)
@@ -394,7 +551,8 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
 
   double performance = 0;
   size_t responseSeq = 0;
-  const size_t effectiveRho = std::min(rho, size_t(responses.size()));
+  const size_t effectiveRho = std::min(BatchRho(begin, batchSize),
+      size_t(responses.size()));
 
   for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
   {
@@ -413,10 +571,34 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
           network[l]);
     }
 
-    performance += outputLayer.Forward(boost::apply_visitor(
-        outputParameterVisitor, network.back()),
-        arma::mat(responses.slice(responseSeq).colptr(begin),
-            responses.n_rows, batchSize, false, true));
+    const arma::mat& output = boost::apply_visitor(outputParameterVisitor,
+        network.back());
+    const size_t active = ActiveSequences(begin, batchSize, seqNum);
+    if (single && !sequenceLengths.is_empty())
+    {
+      // Each sequence contributes the loss of its own final time step; the
+      // sequences that finish at this time step form a contiguous range.
+      const size_t activeNext = ActiveSequences(begin, batchSize, seqNum + 1);
+      if (active > activeNext)
+      {
+        performance += outputLayer.Forward(output.cols(activeNext, active - 1),
+            arma::mat(responses.slice(0).colptr(begin + activeNext),
+                responses.n_rows, active - activeNext, false, true));
+      }
+    }
+    else if (active == batchSize)
+    {
+      performance += outputLayer.Forward(output,
+          arma::mat(responses.slice(responseSeq).colptr(begin),
+              responses.n_rows, batchSize, false, true));
+    }
+    else
+    {
+      // The loss of the finished sequences is masked out.
+      performance += outputLayer.Forward(output.cols(0, active - 1),
+          arma::mat(responses.slice(responseSeq).colptr(begin),
+              responses.n_rows, active, false, true));
+    }
   }
 
   if (outputSize == 0)
@@ -443,7 +625,31 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
           network[network.size() - 1 - l]);
     }
 
-    if (single && seqNum > 0)
+    const size_t step = effectiveRho - seqNum - 1;
+    const size_t active = ActiveSequences(begin, batchSize, step);
+    if (single && !sequenceLengths.is_empty())
+    {
+      // Each sequence receives the error of its own final time step; the
+      // sequences that finish at this time step form a contiguous range, and
+      // all other sequences receive zero error.
+      const size_t activeNext = ActiveSequences(begin, batchSize, step + 1);
+      if (active > activeNext)
+      {
+        arma::mat finishedError;
+        outputLayer.Backward(boost::apply_visitor(
+            outputParameterVisitor, network.back()).cols(activeNext,
+            active - 1), arma::mat(responses.slice(0).colptr(begin +
+            activeNext), responses.n_rows, active - activeNext, false, true),
+            finishedError);
+        error.zeros(finishedError.n_rows, batchSize);
+        error.cols(activeNext, active - 1) = finishedError;
+      }
+      else
+      {
+        error.zeros();
+      }
+    }
+    else if (single && seqNum > 0)
     {
       error.zeros();
     }
@@ -454,11 +660,22 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
           arma::mat(responses.slice(0).colptr(begin),
           responses.n_rows, batchSize, false, true), error);
     }
+    else if (active < batchSize)
+    {
+      // The error of the finished sequences is masked out.
+      arma::mat activeError;
+      outputLayer.Backward(boost::apply_visitor(
+          outputParameterVisitor, network.back()).cols(0, active - 1),
+          arma::mat(responses.slice(step).colptr(begin),
+          responses.n_rows, active, false, true), activeError);
+      error.zeros(activeError.n_rows, batchSize);
+      error.cols(0, active - 1) = activeError;
+    }
     else
     {
       outputLayer.Backward(boost::apply_visitor(
           outputParameterVisitor, network.back()),
-          arma::mat(responses.slice(effectiveRho - seqNum - 1).colptr(begin),
+          arma::mat(responses.slice(step).colptr(begin),
           responses.n_rows, batchSize, false, true), error);
     }
 
@@ -487,11 +704,26 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Shuffle()
 {
-  arma::cube newPredictors, newResponses;
-  math::ShuffleData(predictors, responses, newPredictors, newResponses);
+  if (sequenceLengths.is_empty())
+  {
+    arma::cube newPredictors, newResponses;
+    math::ShuffleData(predictors, responses, newPredictors, newResponses);
 
-  predictors = std::move(newPredictors);
-  responses = std::move(newResponses);
+    predictors = std::move(newPredictors);
+    responses = std::move(newResponses);
+    return;
+  }
+
+  // Keep the sequences sorted by decreasing length: a random permutation is
+  // stably re-sorted by length, which shuffles the order only within groups
+  // of equal length.
+  arma::uvec ordering = arma::shuffle(
+      arma::regspace<arma::uvec>(0, predictors.n_cols - 1));
+  std::stable_sort(ordering.begin(), ordering.end(),
+      [this](const arma::uword a, const arma::uword b)
+      { return sequenceLengths[a] > sequenceLengths[b]; });
+
+  ReorderSequences(ordering);
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
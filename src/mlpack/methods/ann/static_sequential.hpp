@@ -0,0 +1,170 @@
+/**
+ * @file methods/ann/static_sequential.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the StaticSequential class, a compile-time-typed sequential
+ * network container for inference.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_STATIC_SEQUENTIAL_HPP
+#define MLPACK_METHODS_ANN_STATIC_SEQUENTIAL_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+
+#include <tuple>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of a compile-time-typed sequential network container.  The
+ * layer types are fixed as template arguments, so a forward pass is a chain
+ * of direct (inlinable) calls instead of one boost::apply_visitor dispatch
+ * per layer; for small networks, where each layer does little work, the
+ * dispatch overhead of the dynamic FFN container is measurable.
+ *
+ * The intended workflow is to train a model with the dynamic FFN container
+ * and then copy its weights into a StaticSequential with the same layer
+ * types for inference:
+ *
+ * @code
+ * FFN<NegativeLogLikelihood<>> model;
+ * model.Add<Linear<>>(10, 5);
+ * model.Add<ReLULayer<>>();
+ * model.Add<Linear<>>(5, 2);
+ * model.Train(trainData, trainLabels);
+ *
+ * StaticSequential<Linear<>, ReLULayer<>, Linear<>> network;
+ * network.CopyWeights(model);
+ * network.Predict(testData, predictions);
+ * @endcode
+ *
+ * Only plain layers are supported: container layers that hold a nested model
+ * (e.g. Sequential or Recurrent) still need the dynamic dispatch machinery
+ * and cannot be copied into a StaticSequential.
+ *
+ * @tparam Layers The layer types of the network, in order.
+ */
+template<typename... Layers>
+class StaticSequential
+{
+ public:
+  static_assert(sizeof...(Layers) > 0,
+      "StaticSequential must hold at least one layer.");
+
+  //! The number of layers in the network.
+  static const size_t NumLayers = sizeof...(Layers);
+
+  //! Create a StaticSequential object with default-constructed layers.
+  StaticSequential();
+
+  /**
+   * Create a StaticSequential object from already configured layers.
+   *
+   * @param layers The layers of the network, in order.
+   */
+  StaticSequential(Layers... layers);
+
+  /**
+   * Perform a forward pass of the data through the network, with every layer
+   * dispatched at compile time.
+   *
+   * @param input The input data.
+   * @param output The output activation of the last layer.
+   */
+  void Forward(const arma::mat& input, arma::mat& output);
+
+  /**
+   * Predict the responses to a given set of predictors.  Each column of the
+   * passed matrix is treated as one data point, matching the dynamic FFN
+   * container's Predict().
+   *
+   * @param predictors The input predictors.
+   * @param results The predicted responses.
+   */
+  void Predict(const arma::mat& predictors, arma::mat& results);
+
+  /**
+   * Copy the weights of a trained dynamic model whose layers have exactly
+   * the types of this network, in the same order.  The model's parameters
+   * must be initialized (i.e. it has been trained or ResetParameters() has
+   * been called).  Layers that support a deterministic mode are switched to
+   * it, since this container only runs forward passes.
+   *
+   * @param model The trained model (e.g. an FFN) to copy the weights from.
+   */
+  template<typename ModelType>
+  void CopyWeights(ModelType& model);
+
+  //! Get the Ith layer of the network.
+  template<size_t I>
+  const typename std::tuple_element<I, std::tuple<Layers...> >::type&
+  Layer() const { return std::get<I>(network); }
+  //! Modify the Ith layer of the network.
+  template<size_t I>
+  typename std::tuple_element<I, std::tuple<Layers...> >::type&
+  Layer() { return std::get<I>(network); }
+
+ private:
+  //! Forward pass through the layers starting at index I; the output of each
+  //! layer is stored in its own OutputParameter().
+  template<size_t I>
+  typename std::enable_if<I + 1 < sizeof...(Layers), void>::type
+  ForwardFrom(const arma::mat& input);
+
+  //! Forward pass base case: the last layer.
+  template<size_t I>
+  typename std::enable_if<I + 1 == sizeof...(Layers), void>::type
+  ForwardFrom(const arma::mat& input);
+
+  //! Copy the weights of the Ith and all following layers from the model.
+  template<size_t I, typename ModelType>
+  typename std::enable_if<I < sizeof...(Layers), void>::type
+  CopyWeightsFrom(ModelType& model);
+
+  //! Weight-copy base case: past the last layer.
+  template<size_t I, typename ModelType>
+  typename std::enable_if<I == sizeof...(Layers), void>::type
+  CopyWeightsFrom(ModelType& /* model */) { }
+
+  //! Rewire the weight aliases of a layer which implements Reset().
+  template<typename LayerType>
+  typename std::enable_if<
+      HasResetCheck<LayerType, void(LayerType::*)()>::value, void>::type
+  ResetLayer(LayerType& layer) { layer.Reset(); }
+
+  //! Nothing to rewire for a layer without Reset().
+  template<typename LayerType>
+  typename std::enable_if<
+      !HasResetCheck<LayerType, void(LayerType::*)()>::value, void>::type
+  ResetLayer(LayerType& /* layer */) { }
+
+  //! Switch a layer which implements Deterministic() to deterministic mode.
+  template<typename LayerType>
+  typename std::enable_if<HasDeterministicCheck<LayerType,
+      bool&(LayerType::*)(void)>::value, void>::type
+  SetDeterministic(LayerType& layer) { layer.Deterministic() = true; }
+
+  //! Nothing to do for a layer without a deterministic mode.
+  template<typename LayerType>
+  typename std::enable_if<!HasDeterministicCheck<LayerType,
+      bool&(LayerType::*)(void)>::value, void>::type
+  SetDeterministic(LayerType& /* layer */) { }
+
+  //! The layers of the network.
+  std::tuple<Layers...> network;
+}; // class StaticSequential
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "static_sequential_impl.hpp"
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * @file methods/ann/static_sequential_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the StaticSequential class, a compile-time-typed
+ * sequential network container for inference.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_STATIC_SEQUENTIAL_IMPL_HPP
+#define MLPACK_METHODS_ANN_STATIC_SEQUENTIAL_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "static_sequential.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename... Layers>
+StaticSequential<Layers...>::StaticSequential()
+{
+  // Nothing to do here.
+}
+
+template<typename... Layers>
+StaticSequential<Layers...>::StaticSequential(Layers... layers) :
+    network(std::move(layers)...)
+{
+  // Nothing to do here.
+}
+
+template<typename... Layers>
+void StaticSequential<Layers...>::Forward(const arma::mat& input,
+                                          arma::mat& output)
+{
+  ForwardFrom<0>(input);
+  output = std::get<NumLayers - 1>(network).OutputParameter();
+}
+
+template<typename... Layers>
+void StaticSequential<Layers...>::Predict(const arma::mat& predictors,
+                                          arma::mat& results)
+{
+  Forward(predictors, results);
+}
+
+template<typename... Layers>
+template<typename ModelType>
+void StaticSequential<Layers...>::CopyWeights(ModelType& model)
+{
+  if (model.Model().size() != NumLayers)
+  {
+    Log::Fatal << "StaticSequential::CopyWeights(): the given model has "
+        << model.Model().size() << " layers, but this network has "
+        << NumLayers << "!" << std::endl;
+  }
+
+  CopyWeightsFrom<0>(model);
+}
+
+template<typename... Layers>
+template<size_t I>
+typename std::enable_if<I + 1 < sizeof...(Layers), void>::type
+StaticSequential<Layers...>::ForwardFrom(const arma::mat& input)
+{
+  auto& layer = std::get<I>(network);
+  layer.Forward(input, layer.OutputParameter());
+  ForwardFrom<I + 1>(layer.OutputParameter());
+}
+
+template<typename... Layers>
+template<size_t I>
+typename std::enable_if<I + 1 == sizeof...(Layers), void>::type
+StaticSequential<Layers...>::ForwardFrom(const arma::mat& input)
+{
+  auto& layer = std::get<I>(network);
+  layer.Forward(input, layer.OutputParameter());
+}
+
+template<typename... Layers>
+template<size_t I, typename ModelType>
+typename std::enable_if<I < sizeof...(Layers), void>::type
+StaticSequential<Layers...>::CopyWeightsFrom(ModelType& model)
+{
+  typedef typename std::tuple_element<I, std::tuple<Layers...> >::type
+      LayerType;
+
+  LayerType** layer = boost::get<LayerType*>(&model.Model()[I]);
+  if (layer == NULL)
+  {
+    Log::Fatal << "StaticSequential::CopyWeights(): layer " << I
+        << " of the given model does not have the expected type!"
+        << std::endl;
+  }
+
+  // The assignment deep-copies the layer's weights, so the copy stays valid
+  // after the model goes away; Reset() then rewires the internal weight
+  // aliases to the copied storage.
+  std::get<I>(network) = **layer;
+  ResetLayer(std::get<I>(network));
+  SetDeterministic(std::get<I>(network));
+
+  CopyWeightsFrom<I + 1>(model);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
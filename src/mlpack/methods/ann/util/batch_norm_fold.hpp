@@ -0,0 +1,167 @@
+/**
+ * @file methods/ann/util/batch_norm_fold.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the batch normalization folding utility, which collapses
+ * BatchNorm layers into the weights of the preceding Linear or Convolution
+ * layer of a trained network.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_UTIL_BATCH_NORM_FOLD_HPP
+#define MLPACK_METHODS_ANN_UTIL_BATCH_NORM_FOLD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+#include <mlpack/methods/ann/layer/linear.hpp>
+#include <mlpack/methods/ann/layer/batch_norm.hpp>
+#include <mlpack/methods/ann/layer/convolution.hpp>
+#include <mlpack/methods/ann/visitor/weight_size_visitor.hpp>
+#include <mlpack/methods/ann/visitor/weight_set_visitor.hpp>
+#include <mlpack/methods/ann/visitor/parameters_visitor.hpp>
+#include <mlpack/methods/ann/visitor/reset_visitor.hpp>
+#include <mlpack/methods/ann/visitor/delete_visitor.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Fold every BatchNorm layer that directly follows a Linear or Convolution
+ * layer into the weights of that layer, and remove the folded BatchNorm
+ * layers from the network.  In deterministic mode a BatchNorm layer computes
+ * the per-channel affine transformation
+ *
+ * @f[
+ * y = \gamma \frac{x - \mu}{\sqrt{\sigma^2 + \epsilon}} + \beta
+ * @f]
+ *
+ * with the running mean @f$ \mu @f$ and variance @f$ \sigma^2 @f$ accrued
+ * during training, so it can be absorbed exactly into the preceding affine
+ * layer: each output row (or filter and bias of each output map) is scaled by
+ * @f$ \gamma / \sqrt{\sigma^2 + \epsilon} @f$ and the bias shifted
+ * accordingly.  The folded network produces the same inference output with
+ * fewer layers to dispatch and no normalization temporaries, which is where
+ * most of the per-prediction time goes for small models.
+ *
+ * The network must be initialized (e.g. trained or used for prediction at
+ * least once) before folding, and the folded network is only meant for
+ * inference---the removed BatchNorm layers no longer contribute to training.
+ * The network's parameter vector is rebuilt to match the reduced layer list.
+ *
+ * @param network Initialized network (e.g. FFN) to fold.
+ * @return The number of BatchNorm layers that were folded and removed.
+ */
+template<typename NetworkType>
+size_t FoldBatchNorm(NetworkType& network)
+{
+  if (network.Parameters().n_elem == 0)
+  {
+    throw std::invalid_argument("FoldBatchNorm(): cannot fold an "
+        "uninitialized network; train it or call Predict() first!");
+  }
+
+  auto& model = network.Model();
+  size_t folded = 0;
+  for (size_t i = 0; i + 1 < model.size(); ++i)
+  {
+    BatchNorm<>** normPtr = boost::get<BatchNorm<>*>(&model[i + 1]);
+    if (!normPtr)
+      continue;
+    BatchNorm<>* norm = *normPtr;
+
+    // The scale applied to each channel in deterministic mode; gamma is
+    // stored in the first half of the BatchNorm parameters, beta in the
+    // second half.
+    const size_t channels = norm->InputSize();
+    const arma::vec gamma = norm->Parameters().submat(0, 0, channels - 1, 0);
+    const arma::vec beta = norm->Parameters().submat(channels, 0,
+        2 * channels - 1, 0);
+    const arma::vec scale = gamma / arma::sqrt(norm->TrainingVariance() +
+        norm->Epsilon());
+    const arma::vec shift = beta - scale % norm->TrainingMean();
+
+    Linear<>** linearPtr = boost::get<Linear<>*>(&model[i]);
+    Convolution<>** convPtr = boost::get<Convolution<>*>(&model[i]);
+    if (linearPtr && (*linearPtr)->OutputSize() == channels)
+    {
+      // Scale each output unit's row and fold the normalization shift into
+      // the bias.
+      Linear<>* linear = *linearPtr;
+      linear->Weight().each_col() %= scale;
+      linear->Bias() = scale % linear->Bias() + shift;
+    }
+    else if (convPtr && (*convPtr)->OutputSize() == channels)
+    {
+      // Each output map owns the filter slices [map * inSize, (map + 1) *
+      // inSize); scale them all along with the map's bias.
+      Convolution<>* conv = *convPtr;
+      const size_t inMaps = conv->InputSize();
+      for (size_t map = 0; map < channels; ++map)
+      {
+        for (size_t inMap = 0; inMap < inMaps; ++inMap)
+          conv->Weight().slice(map * inMaps + inMap) *= scale(map);
+
+        conv->Bias()(map) = scale(map) * conv->Bias()(map) + shift(map);
+      }
+    }
+    else
+    {
+      continue;
+    }
+
+    boost::apply_visitor(DeleteVisitor(), model[i + 1]);
+    model.erase(model.begin() + i + 1);
+    folded++;
+  }
+
+  if (folded == 0)
+    return 0;
+
+  // The folded BatchNorm parameters are gone, so rebuild the network's
+  // parameter vector from the remaining layers and re-link the layer weights
+  // into it.
+  size_t total = 0;
+  for (size_t l = 0; l < model.size(); ++l)
+    total += boost::apply_visitor(WeightSizeVisitor(), model[l]);
+
+  arma::mat parameter(total, 1);
+  size_t offset = 0;
+  for (size_t l = 0; l < model.size(); ++l)
+  {
+    const size_t weights = boost::apply_visitor(WeightSizeVisitor(), model[l]);
+    if (weights > 0)
+    {
+      arma::mat layerParameters;
+      boost::apply_visitor(ParametersVisitor(layerParameters), model[l]);
+      parameter.submat(offset, 0, offset + weights - 1, 0) =
+          arma::vectorise(layerParameters);
+    }
+
+    offset += weights;
+  }
+
+  network.Parameters() = parameter;
+
+  offset = 0;
+  for (size_t l = 0; l < model.size(); ++l)
+  {
+    offset += boost::apply_visitor(WeightSetVisitor(network.Parameters(),
+        offset), model[l]);
+    boost::apply_visitor(ResetVisitor(), model[l]);
+  }
+
+  // Reset() may re-initialize the weights of some layer types (a BatchNorm
+  // layer that could not be folded resets gamma and beta, for instance), so
+  // restore the saved values through the freshly created aliases.
+  network.Parameters() = parameter;
+
+  return folded;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * @file methods/ann/util/quantization.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the post-training weight quantization utilities, which
+ * convert the parameters of a trained network to 8-bit integers with one
+ * symmetric scale per layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_UTIL_QUANTIZATION_HPP
+#define MLPACK_METHODS_ANN_UTIL_QUANTIZATION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/visitor/weight_size_visitor.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Quantize the parameters of a trained network to 8-bit integers
+ * (post-training quantization).  Each layer that carries weights (e.g.
+ * Linear or Convolution) gets its own symmetric scale, computed from the
+ * largest absolute weight of the layer, so that
+ *
+ * @f[
+ * w \approx \textrm{scale}_l \cdot q, \qquad q \in [-127, 127].
+ * @f]
+ *
+ * The quantized parameter vector together with the per-layer scales is a
+ * complete, four times smaller representation of the model weights; passing
+ * both to DequantizeWeights() restores the weights (up to quantization
+ * error) into a network of the same architecture.  Layers without weights
+ * contribute no scale.
+ *
+ * The network itself is not modified; to measure the accuracy impact of
+ * quantization, round-trip the weights through DequantizeWeights() and
+ * re-evaluate.
+ *
+ * @param network Trained network (e.g. FFN) whose weights are quantized.
+ * @param quantizedParameters Output vector of 8-bit weights, in the same
+ *      order as the network's parameter vector.
+ * @param scales Output vector of one scale per weight-carrying layer.
+ */
+template<typename NetworkType>
+void QuantizeWeights(NetworkType& network,
+                     arma::Col<arma::s8>& quantizedParameters,
+                     arma::vec& scales)
+{
+  const arma::mat& parameter = network.Parameters();
+  quantizedParameters.set_size(parameter.n_elem);
+  scales.set_size(network.Model().size());
+
+  size_t offset = 0;
+  size_t layerCount = 0;
+  for (size_t l = 0; l < network.Model().size(); ++l)
+  {
+    const size_t weights = boost::apply_visitor(WeightSizeVisitor(),
+        network.Model()[l]);
+    if (weights == 0)
+      continue;
+
+    const arma::vec layerWeights = parameter.submat(offset, 0,
+        offset + weights - 1, 0);
+
+    // Symmetric quantization: map the largest absolute weight to 127.  A
+    // layer of all zeros keeps scale 1 to avoid dividing by zero.
+    double scale = arma::abs(layerWeights).max() / 127.0;
+    if (scale == 0.0)
+      scale = 1.0;
+
+    for (size_t i = 0; i < weights; ++i)
+    {
+      quantizedParameters[offset + i] = (arma::s8) std::max(-127.0,
+          std::min(127.0, std::round(layerWeights[i] / scale)));
+    }
+
+    scales[layerCount++] = scale;
+    offset += weights;
+  }
+
+  scales.resize(layerCount);
+}
+
+/**
+ * Restore quantized weights into a network of the same architecture the
+ * weights were quantized from, producing the int8-accurate model.  This is
+ * the inverse of QuantizeWeights() up to quantization error.
+ *
+ * @param network Network (e.g. FFN) whose weights are overwritten.
+ * @param quantizedParameters Vector of 8-bit weights from QuantizeWeights().
+ * @param scales Vector of per-layer scales from QuantizeWeights().
+ */
+template<typename NetworkType>
+void DequantizeWeights(NetworkType& network,
+                       const arma::Col<arma::s8>& quantizedParameters,
+                       const arma::vec& scales)
+{
+  arma::mat& parameter = network.Parameters();
+  if (parameter.n_elem != quantizedParameters.n_elem)
+  {
+    throw std::invalid_argument("DequantizeWeights(): the number of "
+        "quantized weights does not match the network's parameter count!");
+  }
+
+  size_t offset = 0;
+  size_t layerCount = 0;
+  for (size_t l = 0; l < network.Model().size(); ++l)
+  {
+    const size_t weights = boost::apply_visitor(WeightSizeVisitor(),
+        network.Model()[l]);
+    if (weights == 0)
+      continue;
+
+    const double scale = scales[layerCount++];
+    for (size_t i = 0; i < weights; ++i)
+      parameter[offset + i] = scale * (double) quantizedParameters[offset + i];
+
+    offset += weights;
+  }
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ * @file methods/ann/util/raw_weights.hpp
+ * @author Marcus Edel
+ *
+ * Utilities to store network weights as a raw binary file and to run a
+ * network directly on top of an externally managed weight buffer, such as a
+ * memory-mapped file.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_UTIL_RAW_WEIGHTS_HPP
+#define MLPACK_METHODS_ANN_UTIL_RAW_WEIGHTS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/visitor/weight_size_visitor.hpp>
+#include <mlpack/methods/ann/visitor/weight_set_visitor.hpp>
+#include <mlpack/methods/ann/visitor/reset_visitor.hpp>
+#include <fstream>
+#include <cstring>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+//! Magic bytes identifying a raw mlpack weight file.
+static const char rawWeightsMagic[8] = { 'm', 'l', 'p', 'k', 'w', 'g', 't',
+    '\0' };
+
+/**
+ * Write the parameters of a network to a raw binary weight file: an 8-byte
+ * magic header, the weight count as a 64-bit integer, and the weights as
+ * consecutive doubles in the network's parameter order.
+ *
+ * Unlike a cereal archive, this layout can be mapped straight into memory
+ * (see AliasWeights()), so a serving process can start without copying or
+ * parsing the weights, and the page cache shares them between processes.
+ * The file uses the host byte order and is not portable across endianness.
+ *
+ * @param network Network (e.g. FFN) whose weights are written.
+ * @param filename Name of the file to write.
+ */
+template<typename NetworkType>
+void SaveRawWeights(const NetworkType& network, const std::string& filename)
+{
+  const arma::mat& parameter = network.Parameters();
+
+  std::ofstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("SaveRawWeights(): cannot open file '" +
+        filename + "' for writing!");
+  }
+
+  const uint64_t count = parameter.n_elem;
+  stream.write(rawWeightsMagic, sizeof(rawWeightsMagic));
+  stream.write((const char*) &count, sizeof(count));
+  stream.write((const char*) parameter.memptr(), count * sizeof(double));
+
+  if (!stream.good())
+  {
+    throw std::runtime_error("SaveRawWeights(): failed to write to file '" +
+        filename + "'!");
+  }
+}
+
+/**
+ * Load the parameters of a network from a raw binary weight file written by
+ * SaveRawWeights().  The network architecture must match the file: the
+ * weight count is validated before any weight is read.
+ *
+ * @param network Network (e.g. FFN) whose weights are overwritten.
+ * @param filename Name of the file to read.
+ */
+template<typename NetworkType>
+void LoadRawWeights(NetworkType& network, const std::string& filename)
+{
+  if (network.Parameters().is_empty())
+    network.ResetParameters();
+
+  std::ifstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("LoadRawWeights(): cannot open file '" +
+        filename + "' for reading!");
+  }
+
+  char magic[sizeof(rawWeightsMagic)];
+  uint64_t count = 0;
+  stream.read(magic, sizeof(magic));
+  stream.read((char*) &count, sizeof(count));
+  if (!stream.good() ||
+      std::memcmp(magic, rawWeightsMagic, sizeof(magic)) != 0)
+  {
+    throw std::runtime_error("LoadRawWeights(): file '" + filename +
+        "' is not a raw mlpack weight file!");
+  }
+
+  if (count != network.Parameters().n_elem)
+  {
+    throw std::invalid_argument("LoadRawWeights(): file '" + filename +
+        "' holds " + std::to_string(count) + " weights, but the network has "
+        + std::to_string(network.Parameters().n_elem) + " parameters!");
+  }
+
+  stream.read((char*) network.Parameters().memptr(),
+      count * sizeof(double));
+  if (!stream.good())
+  {
+    throw std::runtime_error("LoadRawWeights(): failed to read weights from "
+        "file '" + filename + "'!");
+  }
+}
+
+/**
+ * Point the parameter matrix of a network at an externally managed weight
+ * buffer, without copying.  The buffer must hold the weights in the
+ * network's parameter order (the layout SaveRawWeights() writes after its
+ * 16-byte header) and must outlive the network.
+ *
+ * The intended use is inference on a memory-mapped weight file: mapping the
+ * file with MAP_PRIVATE and aliasing the weight region starts the model
+ * without copying the weights, and unwritten pages stay shared with every
+ * other process mapping the same file.  Note that layers whose Reset()
+ * writes initial parameter values (currently BatchNorm) would overwrite the
+ * mapped weights; fold such layers out first (see FoldBatchNorm()).
+ * Training an aliased network writes updates through to the buffer.
+ *
+ * @param network Network (e.g. FFN) to run on the buffer.
+ * @param buffer The weight buffer; must stay valid while the network is
+ *      used.
+ * @param count Number of weights in the buffer.
+ */
+template<typename NetworkType>
+void AliasWeights(NetworkType& network, double* buffer, const size_t count)
+{
+  size_t total = 0;
+  for (size_t l = 0; l < network.Model().size(); ++l)
+    total += boost::apply_visitor(WeightSizeVisitor(), network.Model()[l]);
+
+  if (count != total)
+  {
+    throw std::invalid_argument("AliasWeights(): the buffer holds " +
+        std::to_string(count) + " weights, but the network has " +
+        std::to_string(total) + " parameters!");
+  }
+
+  // Alias the buffer and re-link every layer into it; the layers then read
+  // (and write) the external memory directly.
+  network.Parameters() = arma::mat(buffer, total, 1, false, false);
+
+  size_t offset = 0;
+  for (size_t l = 0; l < network.Model().size(); ++l)
+  {
+    offset += boost::apply_visitor(WeightSetVisitor(network.Parameters(),
+        offset), network.Model()[l]);
+    boost::apply_visitor(ResetVisitor(), network.Model()[l]);
+  }
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
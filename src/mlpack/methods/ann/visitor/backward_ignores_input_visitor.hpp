@@ -0,0 +1,46 @@
+/**
+ * @file methods/ann/visitor/backward_ignores_input_visitor.hpp
+ * @author Marcus Edel
+ *
+ * This file provides an abstraction to check whether a layer's Backward()
+ * ignores its input argument (see LayerTraits::BackwardIgnoresInput), and
+ * automatically directs any parameter to the right layer type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_BACKWARD_IGNORES_INPUT_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_BACKWARD_IGNORES_INPUT_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * BackwardIgnoresInputVisitor exposes the BackwardIgnoresInput trait of the
+ * given module: whether a following in-place elementwise layer may overwrite
+ * the module's output activation.
+ */
+class BackwardIgnoresInputVisitor : public boost::static_visitor<bool>
+{
+ public:
+  //! Return whether the layer's Backward() ignores its input argument.
+  template<typename LayerType>
+  bool operator()(LayerType* layer) const;
+
+  bool operator()(MoreTypes layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "backward_ignores_input_visitor_impl.hpp"
+
+#endif
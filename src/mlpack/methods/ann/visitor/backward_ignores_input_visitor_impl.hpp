@@ -0,0 +1,37 @@
+/**
+ * @file methods/ann/visitor/backward_ignores_input_visitor_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the BackwardIgnoresInput trait layer abstraction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_BACKWARD_IGNORES_INPUT_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_BACKWARD_IGNORES_INPUT_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "backward_ignores_input_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! BackwardIgnoresInputVisitor visitor class.
+template<typename LayerType>
+inline bool BackwardIgnoresInputVisitor::operator()(
+    LayerType* /* layer */) const
+{
+  return LayerTraits<LayerType>::BackwardIgnoresInput;
+}
+
+inline bool BackwardIgnoresInputVisitor::operator()(MoreTypes layer) const
+{
+  return layer.apply_visitor(*this);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
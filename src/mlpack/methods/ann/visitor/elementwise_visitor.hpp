@@ -0,0 +1,45 @@
+/**
+ * @file methods/ann/visitor/elementwise_visitor.hpp
+ * @author Marcus Edel
+ *
+ * This file provides an abstraction to check whether a layer applies an
+ * elementwise function (see LayerTraits::IsElementwise), and automatically
+ * directs any parameter to the right layer type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_ELEMENTWISE_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_ELEMENTWISE_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * ElementwiseVisitor exposes the IsElementwise trait of the given module:
+ * whether its Forward() may run in place on the input matrix.
+ */
+class ElementwiseVisitor : public boost::static_visitor<bool>
+{
+ public:
+  //! Return whether the layer applies an elementwise function.
+  template<typename LayerType>
+  bool operator()(LayerType* layer) const;
+
+  bool operator()(MoreTypes layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "elementwise_visitor_impl.hpp"
+
+#endif
@@ -90,7 +90,8 @@ class RandomizedBlockKrylovSVD
 
   /**
    * Apply Principal Component Analysis to the provided data set using the
-   * randomized block krylov SVD.
+   * randomized block krylov SVD.  Both dense and sparse input matrices are
+   * supported.
    *
    * @param data Data matrix.
    * @param u First unitary matrix.
@@ -98,11 +99,59 @@ class RandomizedBlockKrylovSVD
    * @param s Diagonal matrix of singular values.
    * @param rank Rank of the approximation.
    */
-  void Apply(const arma::mat& data,
+  template<typename MatType>
+  void Apply(const MatType& data,
              arma::mat& u,
              arma::vec& s,
              arma::mat& v,
-             const size_t rank);
+             const size_t rank)
+  {
+    arma::mat R, W, block;
+
+    if (blockSize == 0)
+    {
+      blockSize = rank + 10;
+    }
+
+    // Random block initialization.
+    arma::mat G = arma::randn(data.n_cols, blockSize);
+
+    // The Krylov basis is kept orthonormal as it is built: every new block is
+    // orthogonalized against the blocks already in place before it is
+    // appended, so there is no monolithic QR of the full basis at the end.
+    arma::mat K(data.n_rows, blockSize * (maxIterations + 1));
+
+    // Create a working matrix using data from writable auxiliary memory
+    // (K matrix). Doing so avoids an uncessary copy in upcoming step.
+    block = arma::mat(K.memptr(), data.n_rows, blockSize, false, false);
+    arma::qr_econ(block, R, arma::mat(data * G));
+
+    for (size_t i = 1; i <= maxIterations; ++i)
+    {
+      // Multiply the newest block by the Gram operator A * A^T.
+      GramMultiply(data, block, W);
+
+      // Two passes of block Gram-Schmidt against the basis built so far; the
+      // second pass removes the components that roundoff reintroduces.
+      arma::mat prev(K.memptr(), data.n_rows, blockSize * i, false, false);
+      W -= prev * (prev.t() * W);
+      W -= prev * (prev.t() * W);
+
+      // Orthonormalize the new block in place at its position in the basis.
+      block = arma::mat(K.memptr() + i * blockSize * data.n_rows, data.n_rows,
+          blockSize, false, false);
+      arma::qr_econ(block, R, W);
+    }
+
+    // K is orthonormal by construction, so the Rayleigh-Ritz step can use it
+    // directly.  Approximate eigenvalues and eigenvectors by doing an
+    // economical singular value decomposition of the projected matrix.
+    arma::svd_econ(u, s, v, arma::mat(K.t() * data));
+
+    // Compute only the approximations of the left singular vectors by
+    // applying the basis to the projected left singular vectors.
+    u = K * u;
+  }
 
   //! Get the number of iterations for the power method.
   size_t MaxIterations() const { return maxIterations; }
@@ -115,6 +164,36 @@ class RandomizedBlockKrylovSVD
   size_t& BlockSize() { return blockSize; }
 
  private:
+  /**
+   * Compute out = data * (data.t() * x) for dense input; the underlying BLAS
+   * handles the threading of the two products.
+   */
+  static void GramMultiply(const arma::mat& data,
+                           const arma::mat& x,
+                           arma::mat& out)
+  {
+    out = data * (data.t() * x);
+  }
+
+  /**
+   * Compute out = data * (data.t() * x) for sparse input.  The sparse-dense
+   * products are not threaded by the linear algebra backend, so the columns
+   * of the block are processed across threads instead; each column's product
+   * chain is independent.
+   */
+  static void GramMultiply(const arma::sp_mat& data,
+                           const arma::mat& x,
+                           arma::mat& out)
+  {
+    out.set_size(data.n_rows, x.n_cols);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t j = 0; j < (omp_size_t) x.n_cols; ++j)
+    {
+      out.col(j) = data * (data.t() * x.col(j));
+    }
+  }
+
   //! Locally stored number of iterations for the power method.
   size_t maxIterations;
 
@@ -216,6 +216,28 @@ class CFType
                           arma::Mat<size_t>& recommendations,
                           const arma::Col<size_t>& users);
 
+  /**
+   * Build a persistent neighbor cache: compute the neighborhood of every user
+   * once and store it in the model.  Subsequent calls to GetRecommendations()
+   * and recommendation serving after deserialization then skip the neighbor
+   * search entirely.  The cache is part of the serialized model and is
+   * invalidated by Train().
+   *
+   * Note that the cache is built with the NeighborSearchPolicy given here;
+   * while the cache is present, the policy passed to GetRecommendations() has
+   * no effect.
+   *
+   * @tparam NeighborSearchPolicy The policy used to search neighbors of
+   *     query set in referece set.
+   */
+  template<typename NeighborSearchPolicy = EuclideanSearch>
+  void BuildNeighborCache();
+
+  //! Get the cached neighborhood (empty if no cache has been built).
+  const arma::Mat<size_t>& NeighborCache() const { return neighborCache; }
+  //! Get the cached neighbor similarities (empty if no cache has been built).
+  const arma::mat& SimilarityCache() const { return similarityCache; }
+
   //! Converts the User, Item, Value Matrix to User-Item Table.
   static void CleanData(const arma::mat& data, arma::sp_mat& cleanedData);
 
@@ -273,6 +295,11 @@ class CFType
   arma::sp_mat cleanedData;
   //! Data normalization object.
   NormalizationType normalization;
+  //! Cached neighborhood of all users; empty if BuildNeighborCache() has not
+  //! been called since the last Train().
+  arma::Mat<size_t> neighborCache;
+  //! Cached similarities corresponding to neighborCache.
+  arma::mat similarityCache;
 
   //! Candidate represents a possible recommendation (value, item).
   typedef std::pair<double, size_t> Candidate;
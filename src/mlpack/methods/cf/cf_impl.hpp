@@ -85,6 +85,10 @@ Train(const arma::mat& data,
 {
   this->decomposition = decomposition;
 
+  // Any cached neighborhoods refer to the old factorization.
+  neighborCache.clear();
+  similarityCache.clear();
+
   // Make a copy of data before performing normalization.
   arma::mat normalizedData(data);
   normalization.Normalize(normalizedData);
@@ -126,6 +130,10 @@ Train(const arma::sp_mat& data,
 {
   this->decomposition = decomposition;
 
+  // Any cached neighborhoods refer to the old factorization.
+  neighborCache.clear();
+  similarityCache.clear();
+
   // data is not used in the following decomposition.Apply() method, so we only
   // need to Normalize cleanedData.
   cleanedData = data;
@@ -193,10 +201,23 @@ GetRecommendations(const size_t numRecs,
   // Calculate the neighborhood of the queried users.  Note that the query user
   // is part of the neighborhood---this is intentional.  We want to use the
   // weighted sum of both the query user and the local neighborhood of the
-  // query user.
-  // Calculate the neighborhood of the queried users.
-  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
-      users, numUsersForSimilarity, neighborhood, similarities);
+  // query user.  If a neighbor cache has been built, gather the cached
+  // neighborhoods instead of running a fresh search.
+  if (!neighborCache.is_empty())
+  {
+    neighborhood.set_size(numUsersForSimilarity, users.n_elem);
+    similarities.set_size(numUsersForSimilarity, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+    {
+      neighborhood.col(i) = neighborCache.col(users(i));
+      similarities.col(i) = similarityCache.col(users(i));
+    }
+  }
+  else
+  {
+    decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+        users, numUsersForSimilarity, neighborhood, similarities);
+  }
 
   // Generate recommendations for each query user by finding the maximum numRecs
   // elements in the ratings vector.
@@ -210,69 +231,121 @@ GetRecommendations(const size_t numRecs,
   // time and we don't want to repeat the initialization process in each loop.
   InterpolationPolicy interpolation(cleanedData);
 
-  for (size_t i = 0; i < users.n_elem; ++i)
+  // Score the queried users in blocks.  Within a block, a neighbor shared by
+  // several users is scored only once, and the weighted sums of neighbor
+  // ratings collapse into a single matrix product instead of one GEMV per
+  // (user, neighbor) pair.
+  const size_t blockSize = std::min((size_t) 64, (size_t) users.n_elem);
+  for (size_t blockBegin = 0; blockBegin < users.n_elem;
+      blockBegin += blockSize)
   {
-    // First, calculate the weighted sum of neighborhood values.
-    arma::vec ratings;
-    ratings.zeros(cleanedData.n_rows);
-
-    // Calculate interpolation weights.
-    arma::vec weights(numUsersForSimilarity);
-    interpolation.GetWeights(weights, decomposition, users(i),
-        neighborhood.col(i), similarities.col(i), cleanedData);
-
-    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+    const size_t blockEnd = std::min((size_t) users.n_elem,
+        blockBegin + blockSize);
+
+    // Calculate interpolation weights for the block, and collect the set of
+    // distinct neighbors it references.
+    arma::mat weights(numUsersForSimilarity, blockEnd - blockBegin);
+    std::map<size_t, size_t> neighborIndex;
+    for (size_t i = blockBegin; i < blockEnd; ++i)
     {
-      arma::vec neighborRatings;
-      decomposition.GetRatingOfUser(neighborhood(j, i), neighborRatings);
-      ratings += weights(j) * neighborRatings;
+      interpolation.GetWeights(weights.col(i - blockBegin), decomposition,
+          users(i), neighborhood.col(i), similarities.col(i), cleanedData);
+      for (size_t j = 0; j < neighborhood.n_rows; ++j)
+        neighborIndex.emplace(neighborhood(j, i), neighborIndex.size());
     }
 
-    // Let's build the list of candidate recomendations for the given user.
-    // Default candidate: the smallest possible value and invalid item number.
-    const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
-    std::vector<Candidate> vect(numRecs, def);
-    typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-        CandidateList;
-    CandidateList pqueue(CandidateCmp(), std::move(vect));
+    // Score each distinct neighbor of the block once.
+    arma::mat neighborRatings(cleanedData.n_rows, neighborIndex.size());
+    for (const std::pair<const size_t, size_t>& neighbor : neighborIndex)
+    {
+      arma::vec neighborRating;
+      decomposition.GetRatingOfUser(neighbor.first, neighborRating);
+      neighborRatings.col(neighbor.second) = neighborRating;
+    }
 
-    // Look through the ratings column corresponding to the current user.
-    for (size_t j = 0; j < ratings.n_rows; ++j)
+    // Accumulate the interpolation weights of each user onto its neighbors'
+    // columns; one GEMM then yields the interpolated ratings of the whole
+    // block.
+    arma::mat blockWeights(neighborIndex.size(), blockEnd - blockBegin,
+        arma::fill::zeros);
+    for (size_t i = blockBegin; i < blockEnd; ++i)
     {
-      // Ensure that the user hasn't already rated the item.
-      // The algorithm omits rating of zero. Thus, when normalizing original
-      // ratings in Normalize(), if normalized rating equals zero, it is set
-      // to the smallest positive double value.
-      if (cleanedData(j, users(i)) != 0.0)
-        continue; // The user already rated the item.
-
-      // Is the estimated value better than the worst candidate?
-      // Denormalize rating before comparison.
-      double realRating = normalization.Denormalize(users(i), j, ratings[j]);
-      if (realRating > pqueue.top().first)
+      for (size_t j = 0; j < neighborhood.n_rows; ++j)
       {
-        Candidate c = std::make_pair(realRating, j);
-        pqueue.pop();
-        pqueue.push(c);
+        blockWeights(neighborIndex[neighborhood(j, i)], i - blockBegin) +=
+            weights(j, i - blockBegin);
       }
     }
+    const arma::mat blockRatings = neighborRatings * blockWeights;
 
-    for (size_t p = 1; p <= numRecs; p++)
+    for (size_t i = blockBegin; i < blockEnd; ++i)
     {
-      recommendations(numRecs - p, i) = pqueue.top().second;
-      values(numRecs - p, i) = pqueue.top().first;
-      pqueue.pop();
-    }
+      // Let's build the list of candidate recomendations for the given user.
+      // Default candidate: the smallest possible value and invalid item
+      // number.
+      const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
+      std::vector<Candidate> vect(numRecs, def);
+      typedef std::priority_queue<Candidate, std::vector<Candidate>,
+          CandidateCmp> CandidateList;
+      CandidateList pqueue(CandidateCmp(), std::move(vect));
+
+      // Look through the ratings column corresponding to the current user.
+      for (size_t j = 0; j < cleanedData.n_rows; ++j)
+      {
+        // Ensure that the user hasn't already rated the item.
+        // The algorithm omits rating of zero. Thus, when normalizing original
+        // ratings in Normalize(), if normalized rating equals zero, it is set
+        // to the smallest positive double value.
+        if (cleanedData(j, users(i)) != 0.0)
+          continue; // The user already rated the item.
+
+        // Is the estimated value better than the worst candidate?
+        // Denormalize rating before comparison.
+        double realRating = normalization.Denormalize(users(i), j,
+            blockRatings(j, i - blockBegin));
+        if (realRating > pqueue.top().first)
+        {
+          Candidate c = std::make_pair(realRating, j);
+          pqueue.pop();
+          pqueue.push(c);
+        }
+      }
+
+      for (size_t p = 1; p <= numRecs; p++)
+      {
+        recommendations(numRecs - p, i) = pqueue.top().second;
+        values(numRecs - p, i) = pqueue.top().first;
+        pqueue.pop();
+      }
 
-    // If we were not able to come up with enough recommendations, issue a
-    // warning.
-    if (recommendations(numRecs - 1, i) == def.second)
-      Log::Warn << "Could not provide " << numRecs << " recommendations "
-          << "for user " << users(i) << " (not enough un-rated items)!"
-          << std::endl;
+      // If we were not able to come up with enough recommendations, issue a
+      // warning.
+      if (recommendations(numRecs - 1, i) == def.second)
+        Log::Warn << "Could not provide " << numRecs << " recommendations "
+            << "for user " << users(i) << " (not enough un-rated items)!"
+            << std::endl;
+    }
   }
 }
 
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename NeighborSearchPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+BuildNeighborCache()
+{
+  // Compute the neighborhood of every user once; GetRecommendations() will
+  // gather from this cache instead of searching.
+  arma::Col<size_t> allUsers = arma::linspace<arma::Col<size_t> >(0,
+      cleanedData.n_cols - 1, cleanedData.n_cols);
+
+  Timer::Start("cf_neighbor_cache");
+  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+      allUsers, numUsersForSimilarity, neighborCache, similarityCache);
+  Timer::Stop("cf_neighbor_cache");
+}
+
 // Predict the rating for a single user/item combination.
 template<typename DecompositionPolicy,
          typename NormalizationType>
@@ -436,6 +509,8 @@ serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(decomposition));
   ar(CEREAL_NVP(cleanedData));
   ar(CEREAL_NVP(normalization));
+  ar(CEREAL_NVP(neighborCache));
+  ar(CEREAL_NVP(similarityCache));
 }
 
 } // namespace cf
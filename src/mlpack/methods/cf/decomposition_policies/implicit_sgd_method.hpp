@@ -0,0 +1,268 @@
+/**
+ * @file methods/cf/decomposition_policies/implicit_sgd_method.hpp
+ * @author Haritha Nair
+ *
+ * Implementation of the stochastic gradient descent method with negative
+ * sampling for implicit feedback data, for use in Collaborative Filtering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_IMPLICIT_SGD_METHOD_HPP
+#define MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_IMPLICIT_SGD_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+namespace cf {
+
+/**
+ * Implementation of the implicit-feedback SGD policy to train a CFType model
+ * by stochastic gradient descent with negative sampling, rather than by a
+ * batch factorization of the full rating matrix.
+ *
+ * Every observed (user, item) interaction is treated as a positive example
+ * with target 1, and for each positive a small number of unobserved items is
+ * drawn uniformly as negative examples with target 0.  The factors are
+ * updated with plain SGD on the regularized squared error of each example.
+ * Since only the interaction list is ever touched, the cost per sweep is
+ * proportional to the number of interactions, not to users x items, which
+ * makes this policy the right choice for large implicit-feedback data where
+ * the batch policies are infeasible.
+ *
+ * The sweeps are parallelized Hogwild-style: the users are split across
+ * threads (each user's factor is owned by one thread per sweep) and the item
+ * factors are updated without locks.  Updates to an item factor from two
+ * threads may interleave, but with sparse interactions such collisions are
+ * rare and stochastic gradient descent is robust to them; see
+ *
+ * @code
+ * @inproceedings{recht2011hogwild,
+ *   title     = {Hogwild!: A Lock-Free Approach to Parallelizing Stochastic
+ *                Gradient Descent},
+ *   author    = {Recht, Benjamin and Re, Christopher and Wright, Stephen and
+ *                Niu, Feng},
+ *   booktitle = {Advances in Neural Information Processing Systems},
+ *   year      = {2011}
+ * }
+ * @endcode
+ *
+ * An example of how to use ImplicitSGDPolicy in CF is shown below:
+ *
+ * @code
+ * extern arma::mat data; // data is a (user, item, rating) table.
+ * // Users for whom recommendations are generated.
+ * extern arma::Col<size_t> users;
+ * arma::Mat<size_t> recommendations; // Resulting recommendations.
+ *
+ * CFType<ImplicitSGDPolicy> cf(data);
+ *
+ * // Generate 10 recommendations for all users.
+ * cf.GetRecommendations(10, recommendations);
+ * @endcode
+ */
+class ImplicitSGDPolicy
+{
+ public:
+  /**
+   * Use the implicit-feedback SGD method to perform collaborative filtering.
+   *
+   * @param stepSize Step size of the SGD updates.
+   * @param regularization Regularization applied to both factor matrices.
+   * @param negSamples Number of negative items drawn per positive
+   *     interaction.
+   */
+  ImplicitSGDPolicy(const double stepSize = 0.05,
+                    const double regularization = 0.01,
+                    const size_t negSamples = 4) :
+      stepSize(stepSize),
+      regularization(regularization),
+      negSamples(negSamples)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Collaborative Filtering to the provided data set using SGD with
+   * negative sampling over the interaction list.
+   *
+   * @param * (data) Data matrix: dense matrix (coordinate lists)
+   *    or sparse matrix(cleaned).
+   * @param cleanedData item user table in form of sparse matrix.
+   * @param rank Rank parameter for matrix factorization.
+   * @param maxIterations Number of sweeps over the interaction list.
+   * @param * (minResidue) Residue required to terminate.
+   * @param * (mit) Whether to terminate only when maxIterations is reached.
+   */
+  void Apply(const arma::mat& /* data */,
+             const arma::sp_mat& cleanedData,
+             const size_t rank,
+             const size_t maxIterations,
+             const double /* minResidue */,
+             const bool /* mit */)
+  {
+    const size_t numItems = cleanedData.n_rows;
+    const size_t numUsers = cleanedData.n_cols;
+
+    // Initialize the factors with small random values so the initial scores
+    // are of order 1.
+    w.randu(numItems, rank);
+    w /= std::sqrt((double) rank);
+    h.randu(rank, numUsers);
+    h /= std::sqrt((double) rank);
+
+    for (size_t sweep = 0; sweep < maxIterations; ++sweep)
+    {
+      // Hogwild-style sweep: each thread owns a block of users (and thus
+      // their columns of h); item rows of w are updated without locks.
+      #pragma omp parallel for schedule(dynamic, 64)
+      for (omp_size_t user = 0; user < (omp_size_t) numUsers; ++user)
+      {
+        for (arma::sp_mat::const_col_iterator it =
+            cleanedData.begin_col(user); it != cleanedData.end_col(user);
+            ++it)
+        {
+          // Positive example: target 1.
+          Update(it.row(), user, 1.0);
+
+          // Draw unobserved items as negative examples with target 0.  An
+          // accidentally drawn positive is simply skipped.
+          for (size_t s = 0; s < negSamples; ++s)
+          {
+            const size_t negItem = (size_t) math::RandInt(numItems);
+            if (cleanedData(negItem, user) == 0)
+              Update(negItem, user, 0.0);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Return predicted rating given user ID and item ID.
+   *
+   * @param user User ID.
+   * @param item Item ID.
+   */
+  double GetRating(const size_t user, const size_t item) const
+  {
+    double rating = arma::as_scalar(w.row(item) * h.col(user));
+    return rating;
+  }
+
+  /**
+   * Get predicted ratings for a user.
+   *
+   * @param user User ID.
+   * @param rating Resulting rating vector.
+   */
+  void GetRatingOfUser(const size_t user, arma::vec& rating) const
+  {
+    rating = w * h.col(user);
+  }
+
+  /**
+   * Get the neighborhood and corresponding similarities for a set of users.
+   *
+   * @tparam NeighborSearchPolicy The policy to perform neighbor search.
+   *
+   * @param users Users whose neighborhood is to be computed.
+   * @param numUsersForSimilarity The number of neighbors returned for
+   *     each user.
+   * @param neighborhood Neighbors represented by user IDs.
+   * @param similarities Similarity between each user and each of its
+   *     neighbors.
+   */
+  template<typename NeighborSearchPolicy>
+  void GetNeighborhood(const arma::Col<size_t>& users,
+                       const size_t numUsersForSimilarity,
+                       arma::Mat<size_t>& neighborhood,
+                       arma::mat& similarities) const
+  {
+    // We want to avoid calculating the full rating matrix, so we will do
+    // nearest neighbor search only on the H matrix, using the observation that
+    // if the rating matrix X = W*H, then d(X.col(i), X.col(j)) = d(W H.col(i),
+    // W H.col(j)).  This can be seen as nearest neighbor search on the H
+    // matrix with the Mahalanobis distance where M^{-1} = W^T W.  So, we'll
+    // decompose M^{-1} = L L^T (the Cholesky decomposition), and then multiply
+    // H by L^T. Then we can perform nearest neighbor search.
+    arma::mat l = arma::chol(w.t() * w);
+    arma::mat stretchedH = l * h; // Due to the Armadillo API, l is L^T.
+
+    // Temporarily store feature vector of queried users.
+    arma::mat query(stretchedH.n_rows, users.n_elem);
+    // Select feature vectors of queried users.
+    for (size_t i = 0; i < users.n_elem; ++i)
+      query.col(i) = stretchedH.col(users(i));
+
+    NeighborSearchPolicy neighborSearch(stretchedH);
+    neighborSearch.Search(
+        query, numUsersForSimilarity, neighborhood, similarities);
+  }
+
+  //! Get the Item Matrix.
+  const arma::mat& W() const { return w; }
+  //! Get the User Matrix.
+  const arma::mat& H() const { return h; }
+
+  //! Get the step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the step size.
+  double& StepSize() { return stepSize; }
+
+  //! Get the regularization parameter.
+  double Regularization() const { return regularization; }
+  //! Modify the regularization parameter.
+  double& Regularization() { return regularization; }
+
+  //! Get the number of negative samples per positive interaction.
+  size_t NegSamples() const { return negSamples; }
+  //! Modify the number of negative samples per positive interaction.
+  size_t& NegSamples() { return negSamples; }
+
+  /**
+   * Serialization.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(w));
+    ar(CEREAL_NVP(h));
+  }
+
+ private:
+  /**
+   * Perform one SGD step on the squared error of a single (item, user,
+   * target) example.
+   */
+  void Update(const size_t item, const size_t user, const double target)
+  {
+    const double error = target - arma::as_scalar(w.row(item) * h.col(user));
+
+    const arma::rowvec wRow = w.row(item);
+    w.row(item) += stepSize * (error * h.col(user).t() -
+        regularization * wRow);
+    h.col(user) += stepSize * (error * wRow.t() -
+        regularization * h.col(user));
+  }
+
+  //! Step size of the SGD updates.
+  double stepSize;
+  //! Regularization applied to both factor matrices.
+  double regularization;
+  //! Number of negative items drawn per positive interaction.
+  size_t negSamples;
+  //! Item matrix.
+  arma::mat w;
+  //! User matrix.
+  arma::mat h;
+};
+
+} // namespace cf
+} // namespace mlpack
+
+#endif
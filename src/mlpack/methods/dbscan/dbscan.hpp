@@ -130,31 +130,40 @@ class DBSCAN
   PointSelectionPolicy pointSelector;
 
   /**
-   * Performs DBSCAN clustering on the data, returning the number of clusters and
-   * also the list of cluster assignments.  This searches each point iteratively,
-   * and can save on RAM usage.  It may be slower than the batch search with a
-   * dual-tree algorithm.
+   * Performs DBSCAN clustering on the data in fixed-size chunks of points, so
+   * that the neighbor lists held in memory at any time are bounded regardless
+   * of the dataset size.  Two passes of range searches are made: one to
+   * identify core points, and one to merge components and resolve border
+   * points.  This is slower than BatchCluster() but saves RAM.
    *
    * @param data Dataset to cluster.
-   * @param assignments Assignments for each point.
-   * @param uf UnionFind structure that will be modified.
+   * @param uf Union-find structure to merge components into.
+   * @param corePoints Will be set to 1 for each core point.
+   * @param clustered Will be set to 1 for each point belonging to a cluster
+   *      (core points and resolved border points).
    */
   template<typename MatType>
   void PointwiseCluster(const MatType& data,
-                        emst::UnionFind& uf);
+                        emst::AtomicUnionFind& uf,
+                        std::vector<char>& corePoints,
+                        std::vector<char>& clustered);
 
   /**
-   * Performs DBSCAN clustering on the data, returning number of clusters
-   * and also the list of cluster assignments.  This can perform search in batch,
-   * so it is well suited for dual-tree or naive search.
+   * Performs DBSCAN clustering on the data with a single batch range search,
+   * holding all neighbor lists in memory at once.  This is well suited for
+   * dual-tree or naive search.
    *
    * @param data Dataset to cluster.
-   * @param assignments Assignments for each point.
-   * @param uf UnionFind structure that will be modified.
+   * @param uf Union-find structure to merge components into.
+   * @param corePoints Will be set to 1 for each core point.
+   * @param clustered Will be set to 1 for each point belonging to a cluster
+   *      (core points and resolved border points).
    */
   template<typename MatType>
   void BatchCluster(const MatType& data,
-                    emst::UnionFind& uf);
+                    emst::AtomicUnionFind& uf,
+                    std::vector<char>& corePoints,
+                    std::vector<char>& clustered);
 };
 
 } // namespace dbscan
@@ -100,40 +100,42 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
     const MatType& data,
     arma::Row<size_t>& assignments)
 {
-  // Initialize the UnionFind object.
-  emst::UnionFind uf(data.n_cols);
+  // Initialize the union-find structure.  The atomic variant allows the
+  // clustering passes below to merge components concurrently without locks.
+  emst::AtomicUnionFind uf(data.n_cols);
   rangeSearch.Train(data);
 
+  // These are std::vector<char> rather than a bitset because concurrent
+  // writes to different elements must not touch shared words.
+  std::vector<char> corePoints(data.n_cols, 0);
+  std::vector<char> clustered(data.n_cols, 0);
+
   if (batchMode)
-    BatchCluster(data, uf);
+    BatchCluster(data, uf, corePoints, clustered);
   else
-    PointwiseCluster(data, uf);
+    PointwiseCluster(data, uf, corePoints, clustered);
 
-  // Now set assignments.
+  // Now set assignments; points that are neither core points nor within range
+  // of one are noise.
   assignments.set_size(data.n_cols);
   for (size_t i = 0; i < data.n_cols; ++i)
-    assignments[i] = uf.Find(i);
-
-  // Get a count of all clusters.
-  const size_t numClusters = arma::max(assignments) + 1;
-  arma::Col<size_t> counts(numClusters, arma::fill::zeros);
-  for (size_t i = 0; i < assignments.n_elem; ++i)
-    counts[assignments[i]]++;
+    assignments[i] = (clustered[i]) ? uf.Find(i) : SIZE_MAX;
 
-  // Now assign clusters to new indices.
+  // Remap the component roots to consecutive cluster indices.  Every cluster
+  // contains at least one core point, so there is no need to filter
+  // components by size.
   size_t currentCluster = 0;
-  arma::Col<size_t> newAssignments(numClusters);
-  for (size_t i = 0; i < counts.n_elem; ++i)
+  arma::Col<size_t> newAssignments(data.n_cols);
+  newAssignments.fill(SIZE_MAX);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
   {
-    if (counts[i] >= minPoints)
-      newAssignments[i] = currentCluster++;
-    else
-      newAssignments[i] = SIZE_MAX;
-  }
+    if (assignments[i] == SIZE_MAX)
+      continue;
 
-  // Now reassign.
-  for (size_t i = 0; i < assignments.n_elem; ++i)
+    if (newAssignments[assignments[i]] == SIZE_MAX)
+      newAssignments[assignments[i]] = currentCluster++;
     assignments[i] = newAssignments[assignments[i]];
+  }
 
   Log::Info << currentCluster << " clusters found." << std::endl;
 
@@ -141,61 +143,156 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
 }
 
 /**
- * Performs DBSCAN clustering on the data, returning the number of clusters and
- * also the list of cluster assignments.  This searches each point iteratively,
- * and can save on RAM usage.  It may be slower than the batch search with a
- * dual-tree algorithm.
+ * Performs DBSCAN clustering on the data in fixed-size chunks of points, so
+ * that memory usage is bounded regardless of the dataset size.  It may be
+ * slower than the batch search.
  */
 template<typename RangeSearchType, typename PointSelectionPolicy>
 template<typename MatType>
 void DBSCAN<RangeSearchType, PointSelectionPolicy>::PointwiseCluster(
     const MatType& data,
-    emst::UnionFind& uf)
+    emst::AtomicUnionFind& uf,
+    std::vector<char>& corePoints,
+    std::vector<char>& clustered)
 {
+  // Searching chunks of points at a time, instead of one point per Search()
+  // call, lets the range search use its batch (dual-tree) traversal while the
+  // neighbor lists held in memory stay bounded by the chunk size.
+  const size_t chunkSize = 4096;
   std::vector<std::vector<size_t>> neighbors;
   std::vector<std::vector<double>> distances;
 
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // First pass: count epsilon-neighborhoods to identify core points.  Note
+  // that each point finds itself in this search (the query set is separate
+  // from the reference set), so no adjustment of minPoints is needed.
+  for (size_t start = 0; start < data.n_cols; start += chunkSize)
   {
-    if (i % 10000 == 0 && i > 0)
-      Log::Info << "DBSCAN clustering on point " << i << "..." << std::endl;
+    if (start % (chunkSize * 16) == 0 && start > 0)
+      Log::Info << "DBSCAN core point search on point " << start << "..."
+          << std::endl;
 
-    // Do the range search for only this point.
-    rangeSearch.Search(data.col(i), math::Range(0.0, epsilon), neighbors,
-        distances);
+    const size_t end = std::min(start + chunkSize, (size_t) data.n_cols) - 1;
+    const MatType chunk = data.cols(start, end);
+    rangeSearch.Search(chunk, math::Range(0.0, epsilon), neighbors, distances);
 
-    // Union to all neighbors.
-    for (size_t j = 0; j < neighbors[0].size(); ++j)
-      uf.Union(i, neighbors[0][j]);
+    for (size_t k = 0; k < neighbors.size(); ++k)
+      corePoints[start + k] = (neighbors[k].size() >= minPoints) ? 1 : 0;
+  }
+
+  // Second pass: merge core points with their core neighbors and resolve
+  // border points, now that all core points are known.  The merging within a
+  // chunk is parallel; the union-find structure is lock-free.
+  for (size_t start = 0; start < data.n_cols; start += chunkSize)
+  {
+    if (start % (chunkSize * 16) == 0 && start > 0)
+      Log::Info << "DBSCAN clustering on point " << start << "..."
+          << std::endl;
+
+    const size_t end = std::min(start + chunkSize, (size_t) data.n_cols) - 1;
+    const MatType chunk = data.cols(start, end);
+    rangeSearch.Search(chunk, math::Range(0.0, epsilon), neighbors, distances);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t k = 0; k < (omp_size_t) neighbors.size(); ++k)
+    {
+      const size_t i = start + k;
+      if (corePoints[i])
+      {
+        // Core points connect to all core points in range.
+        clustered[i] = 1;
+        for (size_t j = 0; j < neighbors[k].size(); ++j)
+        {
+          if (corePoints[neighbors[k][j]])
+            uf.Union(i, neighbors[k][j]);
+        }
+      }
+      else
+      {
+        // Border resolution: a non-core point joins the cluster of its
+        // lowest-indexed core neighbor (if it has one), which keeps the
+        // result independent of processing order.  A border point cannot
+        // merge two clusters, since it contributes only this one edge.
+        size_t anchor = SIZE_MAX;
+        for (size_t j = 0; j < neighbors[k].size(); ++j)
+        {
+          if (corePoints[neighbors[k][j]] && neighbors[k][j] < anchor)
+            anchor = neighbors[k][j];
+        }
+
+        if (anchor != SIZE_MAX)
+        {
+          uf.Union(i, anchor);
+          clustered[i] = 1;
+        }
+      }
+    }
   }
 }
 
 /**
- * Performs DBSCAN clustering on the data, returning number of clusters
- * and also the list of cluster assignments.  This can perform search in batch,
- * naive search).
+ * Performs DBSCAN clustering on the data with a single batch range search.
+ * This is well suited for dual-tree or naive search.
  */
 template<typename RangeSearchType, typename PointSelectionPolicy>
 template<typename MatType>
 void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
     const MatType& data,
-    emst::UnionFind& uf)
+    emst::AtomicUnionFind& uf,
+    std::vector<char>& corePoints,
+    std::vector<char>& clustered)
 {
   // For each point, find the points in epsilon-nighborhood and their distances.
   std::vector<std::vector<size_t>> neighbors;
   std::vector<std::vector<double>> distances;
   Log::Info << "Performing range search." << std::endl;
-  rangeSearch.Train(data);
   rangeSearch.Search(data, math::Range(0.0, epsilon), neighbors, distances);
   Log::Info << "Range search complete." << std::endl;
 
-  // Now loop over all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // Identify the core points.  This search is monochromatic, so each point is
+  // not included in its own neighbor list.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    corePoints[i] = (neighbors[i].size() + 1 >= minPoints) ? 1 : 0;
+
+  // Merge all pairs of core points within range of each other; the union-find
+  // structure is lock-free, so the visiting order does not matter and the
+  // loop can run in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    if (!corePoints[i])
+      continue;
+
+    clustered[i] = 1;
+    for (size_t j = 0; j < neighbors[i].size(); ++j)
+    {
+      if (corePoints[neighbors[i][j]])
+        uf.Union(i, neighbors[i][j]);
+    }
+  }
+
+  // Border resolution pass: each non-core point joins the cluster of its
+  // lowest-indexed core neighbor, if it has one.  Using the lowest index
+  // keeps the result independent of processing order, and a border point
+  // cannot merge two clusters since it contributes only this one edge.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
   {
-    // Get the next index.
-    const size_t index = pointSelector.Select(i, data);
-    for (size_t j = 0; j < neighbors[index].size(); ++j)
-      uf.Union(index, neighbors[index][j]);
+    if (corePoints[i])
+      continue;
+
+    size_t anchor = SIZE_MAX;
+    for (size_t j = 0; j < neighbors[i].size(); ++j)
+    {
+      if (corePoints[neighbors[i][j]] && neighbors[i][j] < anchor)
+        anchor = neighbors[i][j];
+    }
+
+    if (anchor != SIZE_MAX)
+    {
+      uf.Union(i, anchor);
+      clustered[i] = 1;
+    }
   }
 }
 
@@ -16,12 +16,15 @@ namespace mlpack {
 namespace tree {
 
 template<typename FitnessFunction>
-template<bool UseWeights, typename VecType, typename WeightVecType>
+template<bool UseWeights,
+         typename VecType,
+         typename LabelsType,
+         typename WeightVecType>
 double AllCategoricalSplit<FitnessFunction>::SplitIfBetter(
     const double bestGain,
     const VecType& data,
     const size_t numCategories,
-    const arma::Row<size_t>& labels,
+    const LabelsType& labels,
     const size_t numClasses,
     const WeightVecType& weights,
     const size_t minimumLeafSize,
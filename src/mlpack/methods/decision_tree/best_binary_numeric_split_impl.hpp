@@ -16,11 +16,14 @@ namespace mlpack {
 namespace tree {
 
 template<typename FitnessFunction>
-template<bool UseWeights, typename VecType, typename WeightVecType>
+template<bool UseWeights,
+         typename VecType,
+         typename LabelsType,
+         typename WeightVecType>
 double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
     const double bestGain,
     const VecType& data,
-    const arma::Row<size_t>& labels,
+    const LabelsType& labels,
     const size_t numClasses,
     const WeightVecType& weights,
     const size_t minimumLeafSize,
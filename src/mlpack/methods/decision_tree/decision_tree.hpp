@@ -35,6 +35,10 @@ namespace tree {
  * used to store split information.  In general, you would want to set this to
  * be the same as the type of the data that you will be using, but it's not
  * required to do that.
+ *
+ * All of the const Classify() overloads are reentrant: they modify no state of
+ * the tree and use no hidden scratch storage, so a single trained tree may
+ * safely serve concurrent Classify() calls from multiple threads.
  */
 template<typename FitnessFunction = GiniGain,
          template<typename> class NumericSplitType = BestBinaryNumericSplit,
@@ -507,6 +511,22 @@ class DecisionTree :
   typedef typename CategoricalSplit::AuxiliarySplitInfo
       CategoricalAuxiliarySplitInfo;
 
+  /**
+   * Flatten the tree into a breadth-first array of nodes and record, for each
+   * node, the index of its first child in that array.  The batch Classify()
+   * overloads descend this contiguous representation with a tight iterative
+   * loop instead of recursing through heap-scattered child pointers, which is
+   * considerably friendlier to the cache and branch predictor when many points
+   * are classified at once.
+   *
+   * @param nodes This will be filled with pointers to every node in the tree,
+   *      in breadth-first order (the root is element 0).
+   * @param childOffsets This will be filled with the index in `nodes` of each
+   *      node's first child; the value is meaningless for leaves.
+   */
+  void FlattenTree(std::vector<const DecisionTree*>& nodes,
+                   std::vector<size_t>& childOffsets) const;
+
   /**
    * Calculate the class probabilities of the given labels.
    */
@@ -532,12 +552,12 @@ class DecisionTree :
    * @param maximumDepth Maximum depth for the tree.
    * @return The final entropy of decision tree.
    */
-  template<bool UseWeights, typename MatType>
+  template<bool UseWeights, typename MatType, typename LabelsRowType>
   double Train(MatType& data,
                const size_t begin,
                const size_t count,
                const data::DatasetInfo& datasetInfo,
-               arma::Row<size_t>& labels,
+               LabelsRowType& labels,
                const size_t numClasses,
                arma::rowvec& weights,
                const size_t minimumLeafSize,
@@ -561,11 +581,11 @@ class DecisionTree :
    * @param maximumDepth Maximum depth for the tree.
    * @return The final entropy of decision tree.
    */
-  template<bool UseWeights, typename MatType>
+  template<bool UseWeights, typename MatType, typename LabelsRowType>
   double Train(MatType& data,
                const size_t begin,
                const size_t count,
-               arma::Row<size_t>& labels,
+               LabelsRowType& labels,
                const size_t numClasses,
                arma::rowvec& weights,
                const size_t minimumLeafSize,
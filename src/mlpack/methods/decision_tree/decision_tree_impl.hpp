@@ -50,6 +50,12 @@ DecisionTree<FitnessFunction,
 
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
+  // The OpenMP region lets the recursion train large subtrees as parallel
+  // tasks; see the recursive Train() overloads.
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+  #pragma omp parallel
+  #pragma omp single
+#endif
   Train<false>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels, numClasses,
       weights, minimumLeafSize, minimumGainSplit, maximumDepth,
       dimensionSelector);
@@ -87,6 +93,12 @@ DecisionTree<FitnessFunction,
 
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
+  // The OpenMP region lets the recursion train large subtrees as parallel
+  // tasks; see the recursive Train() overloads.
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+  #pragma omp parallel
+  #pragma omp single
+#endif
   Train<false>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses, weights,
       minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
 }
@@ -128,6 +140,12 @@ DecisionTree<FitnessFunction,
   dimensionSelector.Dimensions() = tmpData.n_rows;
 
   // Pass off work to the weighted Train() method.
+  // The OpenMP region lets the recursion train large subtrees as parallel
+  // tasks; see the recursive Train() overloads.
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+  #pragma omp parallel
+  #pragma omp single
+#endif
   Train<true>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels, numClasses,
       tmpWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
       dimensionSelector);
@@ -168,6 +186,12 @@ DecisionTree<FitnessFunction,
   TrueWeightsType tmpWeights(std::move(weights));
 
   // Pass off work to the weighted Train() method.
+  // The OpenMP region lets the recursion train large subtrees as parallel
+  // tasks; see the recursive Train() overloads.
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+  #pragma omp parallel
+  #pragma omp single
+#endif
   Train<true>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels, numClasses,
               tmpWeights, minimumLeafSize, minimumGainSplit);
 }
@@ -210,6 +234,12 @@ DecisionTree<FitnessFunction,
   dimensionSelector.Dimensions() = tmpData.n_rows;
 
   // Pass off work to the weighted Train() method.
+  // The OpenMP region lets the recursion train large subtrees as parallel
+  // tasks; see the recursive Train() overloads.
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+  #pragma omp parallel
+  #pragma omp single
+#endif
   Train<true>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses, tmpWeights,
       minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
 }
@@ -254,6 +284,12 @@ DecisionTree<FitnessFunction,
   dimensionSelector.Dimensions() = tmpData.n_rows;
 
   // Pass off work to the weighted Train() method.
+  // The OpenMP region lets the recursion train large subtrees as parallel
+  // tasks; see the recursive Train() overloads.
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+  #pragma omp parallel
+  #pragma omp single
+#endif
   Train<true>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses, tmpWeights,
       minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
 }
@@ -455,9 +491,17 @@ double DecisionTree<FitnessFunction,
 
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
-  return Train<false>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels,
+  // The OpenMP region lets the recursion train large subtrees as parallel
+  // tasks; see the recursive Train() overloads.
+  double gain;
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+  #pragma omp parallel
+  #pragma omp single
+#endif
+  gain = Train<false>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels,
       numClasses, weights, minimumLeafSize, minimumGainSplit, maximumDepth,
       dimensionSelector);
+  return gain;
 }
 
 //! Train on the given data, assuming all dimensions are numeric.
@@ -495,9 +539,17 @@ double DecisionTree<FitnessFunction,
 
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
-  return Train<false>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses,
+  // The OpenMP region lets the recursion train large subtrees as parallel
+  // tasks; see the recursive Train() overloads.
+  double gain;
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+  #pragma omp parallel
+  #pragma omp single
+#endif
+  gain = Train<false>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses,
       weights, minimumLeafSize, minimumGainSplit, maximumDepth,
       dimensionSelector);
+  return gain;
 }
 
 //! Train on the given weighted data.
@@ -542,9 +594,17 @@ double DecisionTree<FitnessFunction,
   dimensionSelector.Dimensions() = tmpData.n_rows;
 
   // Pass off work to the Train() method.
-  return Train<true>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels,
+  // The OpenMP region lets the recursion train large subtrees as parallel
+  // tasks; see the recursive Train() overloads.
+  double gain;
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+  #pragma omp parallel
+  #pragma omp single
+#endif
+  gain = Train<true>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels,
       numClasses, tmpWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
       dimensionSelector);
+  return gain;
 }
 
 //! Train on the given weighted data.
@@ -588,9 +648,17 @@ double DecisionTree<FitnessFunction,
   dimensionSelector.Dimensions() = tmpData.n_rows;
 
   // Pass off work to the Train() method.
-  return Train<true>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses,
+  // The OpenMP region lets the recursion train large subtrees as parallel
+  // tasks; see the recursive Train() overloads.
+  double gain;
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+  #pragma omp parallel
+  #pragma omp single
+#endif
+  gain = Train<true>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses,
       tmpWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
       dimensionSelector);
+  return gain;
 }
 
 //! Train on the given data, assuming all dimensions are numeric.
@@ -599,7 +667,7 @@ template<typename FitnessFunction,
          template<typename> class CategoricalSplitType,
          typename DimensionSelectionType,
          bool NoRecursion>
-template<bool UseWeights, typename MatType>
+template<bool UseWeights, typename MatType, typename LabelsRowType>
 double DecisionTree<FitnessFunction,
                     NumericSplitType,
                     CategoricalSplitType,
@@ -609,7 +677,7 @@ double DecisionTree<FitnessFunction,
     const size_t begin,
     const size_t count,
     const data::DatasetInfo& datasetInfo,
-    arma::Row<size_t>& labels,
+    LabelsRowType& labels,
     const size_t numClasses,
     arma::rowvec& weights,
     const size_t minimumLeafSize,
@@ -716,18 +784,15 @@ double DecisionTree<FitnessFunction,
     for (size_t i = begin; i < begin + count; ++i)
       childCounts[childAssignments[i - begin]]++;
 
-    // Initialize bestGain if recursive split is allowed.
-    if (!NoRecursion)
-    {
-      bestGain = 0.0;
-    }
-
-    // Split into children.
+    // Rearrange the data so that the points of each child are contiguous, and
+    // remember where each child's range begins.  This must happen before any
+    // child is trained, so that the children can then be built independently.
+    arma::Row<size_t> childBegins(numChildren);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = currentCol; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -739,26 +804,55 @@ double DecisionTree<FitnessFunction,
           ++currentCol;
         }
       }
+      children.push_back(new DecisionTree());
+    }
 
-      // Now build the child recursively.
-      DecisionTree* child = new DecisionTree();
-      if (NoRecursion)
-      {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, currentCol - currentChildBegin, minimumGainSplit,
-            maximumDepth - 1, dimensionSelector);
-      }
-      else
+    // Now build each child on its contiguous slice of columns.  The slices
+    // are disjoint, so each subtree can be trained as an independent task;
+    // near the root this lets the large subtrees build concurrently, which is
+    // where nearly all of the training time goes.  The tasks are executed by
+    // the team of the single parallel region opened at the public Train()
+    // entry point, so nodes at any depth of the recursion feed the same task
+    // pool.  Each task copies the dimension selector because selectors are
+    // stateful.  (Tasks require OpenMP 3.0, which MSVC's OpenMP support
+    // predates; without them the loop simply runs inline.)
+    arma::vec childGains(numChildren, arma::fill::zeros);
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+      // Don't bother deferring tiny subtrees; the task overhead would
+      // outweigh the work.
+      #pragma omp task default(shared) firstprivate(i) \
+          if (childCounts[i] > 500)
+#endif
       {
-        // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+        DimensionSelectionType childSelector = dimensionSelector;
+        if (NoRecursion)
+        {
+          children[i]->Train<UseWeights>(data, childBegins[i],
+              childCounts[i], datasetInfo, labels, numClasses, weights,
+              childCounts[i], minimumGainSplit, maximumDepth - 1,
+              childSelector);
+        }
+        else
+        {
+          // During recursion entropy of child node may change.
+          childGains[i] = children[i]->Train<UseWeights>(data,
+              childBegins[i], childCounts[i], datasetInfo, labels,
+              numClasses, weights, minimumLeafSize, minimumGainSplit,
+              maximumDepth - 1, childSelector);
+        }
       }
-      children.push_back(child);
+    }
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+    #pragma omp taskwait
+#endif
+
+    if (!NoRecursion)
+    {
+      bestGain = 0.0;
+      for (size_t i = 0; i < numChildren; ++i)
+        bestGain += double(childCounts[i]) / double(count) * (-childGains[i]);
     }
   }
   else
@@ -783,7 +877,7 @@ template<typename FitnessFunction,
          template<typename> class CategoricalSplitType,
          typename DimensionSelectionType,
          bool NoRecursion>
-template<bool UseWeights, typename MatType>
+template<bool UseWeights, typename MatType, typename LabelsRowType>
 double DecisionTree<FitnessFunction,
                     NumericSplitType,
                     CategoricalSplitType,
@@ -792,7 +886,7 @@ double DecisionTree<FitnessFunction,
     MatType& data,
     const size_t begin,
     const size_t count,
-    arma::Row<size_t>& labels,
+    LabelsRowType& labels,
     const size_t numClasses,
     arma::rowvec& weights,
     const size_t minimumLeafSize,
@@ -821,34 +915,68 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // Materialize the candidate dimensions, so each can be scored as its own
+    // task.
+    std::vector<size_t> candidateDims;
     for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
          i = dimensionSelector.Next())
+      candidateDims.push_back(i);
+
+    // Score the candidate dimensions as tasks executed by the team of the
+    // parallel region opened at the public Train() entry point; near the
+    // root, before any subtree tasks exist, the otherwise idle threads pick
+    // them up.  Every dimension is scored in task-local objects against the
+    // node's own entropy and the winners are merged under a critical
+    // section, so the auxiliary split members of this node are written
+    // exactly once and gain ties break towards the lower dimension no matter
+    // how the tasks are scheduled.
+    const double nodeGain = bestGain;
+    for (size_t d = 0; d < candidateDims.size(); ++d)
     {
-      const double dimGain = NumericSplitType<FitnessFunction>::template
-          SplitIfBetter<UseWeights>(bestGain,
-                                    data.cols(begin, begin + count - 1).row(i),
-                                    labels.cols(begin, begin + count - 1),
-                                    numClasses,
-                                    UseWeights ?
-                                        weights.cols(begin, begin + count - 1) :
-                                        weights,
-                                    minimumLeafSize,
-                                    minimumGainSplit,
-                                    classProbabilities,
-                                    *this);
-
-      // If the splitter did not report that it improved, then move to the next
-      // dimension.
-      if (dimGain == DBL_MAX)
-        continue;
-
-      bestDim = i;
-      bestGain = dimGain;
-
-      // If the gain is the best possible, no need to keep looking.
-      if (bestGain >= 0.0)
-        break;
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+      // Scoring a dimension of a tiny node is cheaper than deferring it.
+      #pragma omp task default(shared) firstprivate(d) if (count > 500)
+#endif
+      {
+        const size_t i = candidateDims[d];
+        arma::vec localProbabilities;
+        NumericAuxiliarySplitInfo localAux;
+        const double dimGain = NumericSplitType<FitnessFunction>::template
+            SplitIfBetter<UseWeights>(nodeGain,
+                                      data.cols(begin,
+                                          begin + count - 1).row(i),
+                                      labels.cols(begin, begin + count - 1),
+                                      numClasses,
+                                      UseWeights ?
+                                          weights.cols(begin,
+                                              begin + count - 1) :
+                                          weights,
+                                      minimumLeafSize,
+                                      minimumGainSplit,
+                                      localProbabilities,
+                                      localAux);
+
+        // The splitter returns DBL_MAX if it could not improve on the node's
+        // own gain.
+        if (dimGain != DBL_MAX)
+        {
+          #pragma omp critical (DecisionTreeSplitSearch)
+          {
+            if ((dimGain > bestGain) ||
+                (dimGain == bestGain && i < bestDim))
+            {
+              bestGain = dimGain;
+              bestDim = i;
+              classProbabilities = std::move(localProbabilities);
+              NumericAuxiliarySplitInfo::operator=(std::move(localAux));
+            }
+          }
+        }
+      }
     }
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+    #pragma omp taskwait
+#endif
   }
 
   // Did we split or not?  If so, then split the data and create the children.
@@ -874,17 +1002,15 @@ double DecisionTree<FitnessFunction,
     for (size_t j = begin; j < begin + count; ++j)
       childCounts[childAssignments[j - begin]]++;
 
-    // Initialize bestGain if recursive split is allowed.
-    if (!NoRecursion)
-    {
-      bestGain = 0.0;
-    }
-
+    // Rearrange the data so that the points of each child are contiguous, and
+    // remember where each child's range begins; only afterwards can the
+    // children be built independently of each other.
+    arma::Row<size_t> childBegins(numChildren);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = currentCol; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -896,26 +1022,48 @@ double DecisionTree<FitnessFunction,
           ++currentCol;
         }
       }
+      children.push_back(new DecisionTree());
+    }
 
-      // Now build the child recursively.
-      DecisionTree* child = new DecisionTree();
-      if (NoRecursion)
-      {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            currentCol - currentChildBegin, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-      }
-      else
+    // Train each child on its own slice of columns.  The slices are disjoint,
+    // so the subtrees are built as independent tasks on the same task pool as
+    // the rest of the recursion (see the comments in the mixed
+    // categorical/numeric overload above); each task needs a private copy of
+    // the stateful dimension selector.
+    arma::vec childGains(numChildren, arma::fill::zeros);
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+      #pragma omp task default(shared) firstprivate(i) \
+          if (childCounts[i] > 500)
+#endif
       {
-        // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+        DimensionSelectionType childSelector = dimensionSelector;
+        if (NoRecursion)
+        {
+          children[i]->Train<UseWeights>(data, childBegins[i],
+              childCounts[i], labels, numClasses, weights, childCounts[i],
+              minimumGainSplit, maximumDepth - 1, childSelector);
+        }
+        else
+        {
+          // During recursion entropy of child node may change.
+          childGains[i] = children[i]->Train<UseWeights>(data,
+              childBegins[i], childCounts[i], labels, numClasses, weights,
+              minimumLeafSize, minimumGainSplit, maximumDepth - 1,
+              childSelector);
+        }
       }
-      children.push_back(child);
+    }
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+    #pragma omp taskwait
+#endif
+
+    if (!NoRecursion)
+    {
+      bestGain = 0.0;
+      for (size_t i = 0; i < numChildren; ++i)
+        bestGain += double(childCounts[i]) / double(count) * (-childGains[i]);
     }
   }
   else
@@ -1002,9 +1150,20 @@ void DecisionTree<FitnessFunction,
     return;
   }
 
-  // Loop over each point.
+  // Flatten the tree once, then send each point down the contiguous node
+  // array.  This avoids a chain of recursive calls per point and keeps the
+  // descent loop tight.
+  std::vector<const DecisionTree*> nodes;
+  std::vector<size_t> childOffsets;
+  FlattenTree(nodes, childOffsets);
+
   for (size_t i = 0; i < data.n_cols; ++i)
-    predictions[i] = Classify(data.col(i));
+  {
+    size_t cur = 0;
+    while (nodes[cur]->children.size() != 0)
+      cur = childOffsets[cur] + nodes[cur]->CalculateDirection(data.col(i));
+    predictions[i] = nodes[cur]->dimensionTypeOrMajorityClass;
+  }
 }
 
 //! Return the class probabilities for a set of points.
@@ -1037,10 +1196,44 @@ void DecisionTree<FitnessFunction,
     node = &node->Child(0);
   probabilities.set_size(node->classProbabilities.n_elem, data.n_cols);
 
+  // As in the predictions-only overload, walk the flattened tree iteratively
+  // rather than recursing for every point.
+  std::vector<const DecisionTree*> nodes;
+  std::vector<size_t> childOffsets;
+  FlattenTree(nodes, childOffsets);
+
   for (size_t i = 0; i < data.n_cols; ++i)
   {
-    arma::vec v = probabilities.unsafe_col(i); // Alias of column.
-    Classify(data.col(i), predictions[i], v);
+    size_t cur = 0;
+    while (nodes[cur]->children.size() != 0)
+      cur = childOffsets[cur] + nodes[cur]->CalculateDirection(data.col(i));
+    predictions[i] = nodes[cur]->dimensionTypeOrMajorityClass;
+    probabilities.col(i) = nodes[cur]->classProbabilities;
+  }
+}
+
+//! Flatten the tree into a breadth-first node array for batch classification.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  NoRecursion>::FlattenTree(
+    std::vector<const DecisionTree*>& nodes,
+    std::vector<size_t>& childOffsets) const
+{
+  nodes.push_back(this);
+  // `nodes` grows as we iterate, so this loop visits every node exactly once
+  // and appends its children in breadth-first order.
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    childOffsets.push_back(nodes.size());
+    for (size_t c = 0; c < nodes[i]->children.size(); ++c)
+      nodes.push_back(nodes[i]->children[c]);
   }
 }
 
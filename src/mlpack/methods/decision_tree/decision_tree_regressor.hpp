@@ -0,0 +1,330 @@
+/**
+ * @file methods/decision_tree/decision_tree_regressor.hpp
+ * @author Ryan Curtin
+ *
+ * A decision tree learner for regression.  Its behavior can be controlled via
+ * template arguments.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_DECISION_TREE_REGRESSOR_HPP
+#define MLPACK_METHODS_DECISION_TREE_DECISION_TREE_REGRESSOR_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "mse_gain.hpp"
+#include "histogram_numeric_split.hpp"
+#include "all_dimension_select.hpp"
+#include <type_traits>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * This class implements a decision tree learner for regression.  It shares its
+ * structure with the DecisionTree classifier, but splits on the reduction in
+ * the response error (variance, for the default MSEGain) instead of label
+ * impurity, and each leaf predicts the (weighted) mean response of its points.
+ *
+ * The default numeric split is HistogramNumericSplit, which considers only
+ * binned candidate splits; this keeps each node's split search at one unsorted
+ * O(n) pass over its points, which matters when training on very large
+ * datasets.  BestBinaryNumericSplit-style exact enumeration over responses can
+ * be substituted through the NumericSplitType parameter.
+ *
+ * All dimensions are expected to be numeric; categorical dimensions should be
+ * encoded before training.
+ *
+ * All of the const Predict() overloads are reentrant: they modify no state of
+ * the tree and use no hidden scratch storage, so a single trained tree may
+ * safely serve concurrent Predict() calls from multiple threads.
+ */
+template<typename FitnessFunction = MSEGain,
+         template<typename> class NumericSplitType = HistogramNumericSplit,
+         typename DimensionSelectionType = AllDimensionSelect,
+         bool NoRecursion = false>
+class DecisionTreeRegressor :
+    public NumericSplitType<FitnessFunction>::AuxiliarySplitInfo
+{
+ public:
+  //! Allow access to the numeric split type.
+  typedef NumericSplitType<FitnessFunction> NumericSplit;
+  //! Allow access to the dimension selection type.
+  typedef DimensionSelectionType DimensionSelection;
+
+  /**
+   * Construct the decision tree on the given data and responses.  Setting
+   * minimumLeafSize and minimumGainSplit too small may cause the tree to
+   * overfit, but setting them too large may cause it to underfit.
+   *
+   * Use std::move if data or responses are no longer needed to avoid copies.
+   *
+   * @param data Dataset to train on.
+   * @param responses Responses for each training point.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   */
+  template<typename MatType, typename ResponsesType>
+  DecisionTreeRegressor(MatType data,
+                        ResponsesType responses,
+                        const size_t minimumLeafSize = 10,
+                        const double minimumGainSplit = 1e-7,
+                        const size_t maximumDepth = 0,
+                        DimensionSelectionType dimensionSelector =
+                            DimensionSelectionType());
+
+  /**
+   * Construct the decision tree on the given data and responses with weights.
+   * Setting minimumLeafSize and minimumGainSplit too small may cause the tree
+   * to overfit, but setting them too large may cause it to underfit.
+   *
+   * Use std::move if data, responses or weights are no longer needed to avoid
+   * copies.
+   *
+   * @param data Dataset to train on.
+   * @param responses Responses for each training point.
+   * @param weights The weight list of given responses.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   */
+  template<typename MatType, typename ResponsesType, typename WeightsType>
+  DecisionTreeRegressor(
+      MatType data,
+      ResponsesType responses,
+      WeightsType weights,
+      const size_t minimumLeafSize = 10,
+      const double minimumGainSplit = 1e-7,
+      const size_t maximumDepth = 0,
+      DimensionSelectionType dimensionSelector = DimensionSelectionType(),
+      const std::enable_if_t<arma::is_arma_type<
+          typename std::remove_reference<WeightsType>::type>::value>* = 0);
+
+  /**
+   * Construct a decision tree without training it.  It will be a leaf node
+   * that predicts 0.0.
+   */
+  DecisionTreeRegressor();
+
+  /**
+   * Copy another tree.  This may use a lot of memory---be sure that it's what
+   * you want to do.
+   *
+   * @param other Tree to copy.
+   */
+  DecisionTreeRegressor(const DecisionTreeRegressor& other);
+
+  /**
+   * Take ownership of another tree.
+   *
+   * @param other Tree to take ownership of.
+   */
+  DecisionTreeRegressor(DecisionTreeRegressor&& other);
+
+  /**
+   * Copy another tree.  This may use a lot of memory---be sure that it's what
+   * you want to do.
+   *
+   * @param other Tree to copy.
+   */
+  DecisionTreeRegressor& operator=(const DecisionTreeRegressor& other);
+
+  /**
+   * Take ownership of another tree.
+   *
+   * @param other Tree to take ownership of.
+   */
+  DecisionTreeRegressor& operator=(DecisionTreeRegressor&& other);
+
+  /**
+   * Clean up memory.
+   */
+  ~DecisionTreeRegressor();
+
+  /**
+   * Train the decision tree on the given data.  This will overwrite the
+   * existing model.  Setting minimumLeafSize and minimumGainSplit too small
+   * may cause the tree to overfit, but setting them too large may cause it to
+   * underfit.
+   *
+   * Use std::move if data or responses are no longer needed to avoid copies.
+   *
+   * @param data Dataset to train on.
+   * @param responses Responses for each training point.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The final error of the decision tree.
+   */
+  template<typename MatType, typename ResponsesType>
+  double Train(MatType data,
+               ResponsesType responses,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 0,
+               DimensionSelectionType dimensionSelector =
+                   DimensionSelectionType());
+
+  /**
+   * Train the decision tree on the given weighted data.  This will overwrite
+   * the existing model.  Setting minimumLeafSize and minimumGainSplit too
+   * small may cause the tree to overfit, but setting them too large may cause
+   * it to underfit.
+   *
+   * Use std::move if data, responses or weights are no longer needed to avoid
+   * copies.
+   *
+   * @param data Dataset to train on.
+   * @param responses Responses for each training point.
+   * @param weights Weights of all the responses.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The final error of the decision tree.
+   */
+  template<typename MatType, typename ResponsesType, typename WeightsType>
+  double Train(MatType data,
+               ResponsesType responses,
+               WeightsType weights,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 0,
+               DimensionSelectionType dimensionSelector =
+                   DimensionSelectionType(),
+               const std::enable_if_t<arma::is_arma_type<typename
+                   std::remove_reference<WeightsType>::type>::value>* = 0);
+
+  /**
+   * Predict the response of the given point, using the entire tree.
+   *
+   * @param point Point to predict.
+   */
+  template<typename VecType>
+  double Predict(const VecType& point) const;
+
+  /**
+   * Predict the responses of the given points, using the entire tree.  The
+   * predicted responses for each point are stored in the given vector.
+   *
+   * @param data Set of points to predict.
+   * @param predictions This will be filled with predictions for each point.
+   */
+  template<typename MatType>
+  void Predict(const MatType& data, arma::rowvec& predictions) const;
+
+  /**
+   * Serialize the tree.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+  //! Get the number of children.
+  size_t NumChildren() const { return children.size(); }
+
+  //! Get the child of the given index.
+  const DecisionTreeRegressor& Child(const size_t i) const
+  {
+    return *children[i];
+  }
+  //! Modify the child of the given index (be careful!).
+  DecisionTreeRegressor& Child(const size_t i) { return *children[i]; }
+
+  //! Get the split dimension (only meaningful if this is a non-leaf in a
+  //! trained tree).
+  size_t SplitDimension() const { return splitDimension; }
+
+  //! Get the prediction of this node (only meaningful if this is a leaf).
+  double Prediction() const { return prediction; }
+
+  /**
+   * Given a point and that this node is not a leaf, calculate the index of the
+   * child node this point would go towards.  This method is primarily used by
+   * the Predict() function, but it can be used in a standalone sense too.
+   *
+   * @param point Point to predict.
+   */
+  template<typename VecType>
+  size_t CalculateDirection(const VecType& point) const;
+
+ private:
+  //! The vector of children.
+  std::vector<DecisionTreeRegressor*> children;
+  //! The dimension this node splits on.
+  size_t splitDimension;
+  //! The prediction of this node; only meaningful if we are a leaf.
+  double prediction;
+  /**
+   * This vector may be used arbitrarily by the split type's
+   * CalculateDirection() function (if the node has children); for the default
+   * binary splits it holds the split point.  It is empty for leaves.
+   */
+  arma::vec splitInfo;
+
+  //! Note that this class will also hold the members of the NumericSplit
+  //! AuxiliarySplitInfo class, since it inherits from it.  We'll define a
+  //! convenience typedef here.
+  typedef typename NumericSplit::AuxiliarySplitInfo
+      NumericAuxiliarySplitInfo;
+
+  /**
+   * Flatten the tree into a breadth-first array of nodes and record, for each
+   * node, the index of its first child in that array; the batch Predict()
+   * overload descends this contiguous representation iteratively (see
+   * DecisionTree::FlattenTree()).
+   *
+   * @param nodes This will be filled with pointers to every node in the tree,
+   *      in breadth-first order (the root is element 0).
+   * @param childOffsets This will be filled with the index in `nodes` of each
+   *      node's first child; the value is meaningless for leaves.
+   */
+  void FlattenTree(std::vector<const DecisionTreeRegressor*>& nodes,
+                   std::vector<size_t>& childOffsets) const;
+
+  /**
+   * Calculate the prediction (the weighted mean) of the given responses.
+   */
+  template<bool UseWeights, typename ResponsesRowType, typename WeightsRowType>
+  void CalculatePrediction(const ResponsesRowType& responses,
+                           const WeightsRowType& weights);
+
+  /**
+   * Corresponding to the public Train() method, this method is designed for
+   * avoiding unnecessary copies during training.  This method is called for
+   * training children.
+   *
+   * @param data Dataset to train on.
+   * @param begin Index of the starting point in the dataset that belongs to
+   *      this node.
+   * @param count Number of points in this node.
+   * @param responses Responses for each training point.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @return The final error of the decision tree.
+   */
+  template<bool UseWeights, typename MatType, typename ResponsesRowType>
+  double Train(MatType& data,
+               const size_t begin,
+               const size_t count,
+               ResponsesRowType& responses,
+               arma::rowvec& weights,
+               const size_t minimumLeafSize,
+               const double minimumGainSplit,
+               const size_t maximumDepth,
+               DimensionSelectionType& dimensionSelector);
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "decision_tree_regressor_impl.hpp"
+
+#endif
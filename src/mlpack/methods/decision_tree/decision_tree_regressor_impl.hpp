@@ -0,0 +1,641 @@
+/**
+ * @file methods/decision_tree/decision_tree_regressor_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the decision tree regressor class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_DECISION_TREE_REGRESSOR_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_DECISION_TREE_REGRESSOR_IMPL_HPP
+
+#include "decision_tree_regressor.hpp"
+
+namespace mlpack {
+namespace tree {
+
+//! Construct and train without weight.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename MatType, typename ResponsesType>
+DecisionTreeRegressor<FitnessFunction,
+                      NumericSplitType,
+                      DimensionSelectionType,
+                      NoRecursion>::DecisionTreeRegressor(
+    MatType data,
+    ResponsesType responses,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector)
+{
+  using TrueMatType = typename std::decay<MatType>::type;
+  using TrueResponsesType = typename std::decay<ResponsesType>::type;
+
+  // Copy or move data.
+  TrueMatType tmpData(std::move(data));
+  TrueResponsesType tmpResponses(std::move(responses));
+
+  // Set the correct dimensionality for the dimension selector.
+  dimensionSelector.Dimensions() = tmpData.n_rows;
+
+  // Pass off work to the Train() method.
+  arma::rowvec weights; // Fake weights, not used.
+  Train<false>(tmpData, 0, tmpData.n_cols, tmpResponses, weights,
+      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+}
+
+//! Construct and train with weights.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename MatType, typename ResponsesType, typename WeightsType>
+DecisionTreeRegressor<FitnessFunction,
+                      NumericSplitType,
+                      DimensionSelectionType,
+                      NoRecursion>::DecisionTreeRegressor(
+    MatType data,
+    ResponsesType responses,
+    WeightsType weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector,
+    const std::enable_if_t<arma::is_arma_type<
+        typename std::remove_reference<WeightsType>::type>::value>*)
+{
+  using TrueMatType = typename std::decay<MatType>::type;
+  using TrueResponsesType = typename std::decay<ResponsesType>::type;
+  using TrueWeightsType = typename std::decay<WeightsType>::type;
+
+  // Copy or move data.
+  TrueMatType tmpData(std::move(data));
+  TrueResponsesType tmpResponses(std::move(responses));
+  TrueWeightsType tmpWeights(std::move(weights));
+
+  // Set the correct dimensionality for the dimension selector.
+  dimensionSelector.Dimensions() = tmpData.n_rows;
+
+  // Pass off work to the weighted Train() method.
+  Train<true>(tmpData, 0, tmpData.n_cols, tmpResponses, tmpWeights,
+      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+}
+
+//! Construct, don't train.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+DecisionTreeRegressor<FitnessFunction,
+                      NumericSplitType,
+                      DimensionSelectionType,
+                      NoRecursion>::DecisionTreeRegressor() :
+    splitDimension(0),
+    prediction(0.0)
+{
+  // Nothing else to do.
+}
+
+//! Copy another tree.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+DecisionTreeRegressor<FitnessFunction,
+                      NumericSplitType,
+                      DimensionSelectionType,
+                      NoRecursion>::DecisionTreeRegressor(
+    const DecisionTreeRegressor& other) :
+    NumericAuxiliarySplitInfo(other),
+    splitDimension(other.splitDimension),
+    prediction(other.prediction),
+    splitInfo(other.splitInfo)
+{
+  // Copy each child.
+  for (size_t i = 0; i < other.children.size(); ++i)
+    children.push_back(new DecisionTreeRegressor(*other.children[i]));
+}
+
+//! Take ownership of another tree.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+DecisionTreeRegressor<FitnessFunction,
+                      NumericSplitType,
+                      DimensionSelectionType,
+                      NoRecursion>::DecisionTreeRegressor(
+    DecisionTreeRegressor&& other) :
+    NumericAuxiliarySplitInfo(std::move(other)),
+    children(std::move(other.children)),
+    splitDimension(other.splitDimension),
+    prediction(other.prediction),
+    splitInfo(std::move(other.splitInfo))
+{
+  // Reset the other object.
+  other.prediction = 0.0;
+}
+
+//! Copy another tree.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+DecisionTreeRegressor<FitnessFunction,
+                      NumericSplitType,
+                      DimensionSelectionType,
+                      NoRecursion>&
+DecisionTreeRegressor<FitnessFunction,
+                      NumericSplitType,
+                      DimensionSelectionType,
+                      NoRecursion>::operator=(const DecisionTreeRegressor& other)
+{
+  if (this == &other)
+    return *this; // Nothing to copy.
+
+  // Clean memory if needed.
+  for (size_t i = 0; i < children.size(); ++i)
+    delete children[i];
+  children.clear();
+
+  // Copy everything from the other tree.
+  splitDimension = other.splitDimension;
+  prediction = other.prediction;
+  splitInfo = other.splitInfo;
+
+  // Copy the children.
+  for (size_t i = 0; i < other.children.size(); ++i)
+    children.push_back(new DecisionTreeRegressor(*other.children[i]));
+
+  // Copy the auxiliary info.
+  NumericAuxiliarySplitInfo::operator=(other);
+
+  return *this;
+}
+
+//! Take ownership of another tree.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+DecisionTreeRegressor<FitnessFunction,
+                      NumericSplitType,
+                      DimensionSelectionType,
+                      NoRecursion>&
+DecisionTreeRegressor<FitnessFunction,
+                      NumericSplitType,
+                      DimensionSelectionType,
+                      NoRecursion>::operator=(DecisionTreeRegressor&& other)
+{
+  if (this == &other)
+    return *this; // Nothing to move.
+
+  // Clean memory if needed.
+  for (size_t i = 0; i < children.size(); ++i)
+    delete children[i];
+  children.clear();
+
+  // Take ownership of the other tree's components.
+  children = std::move(other.children);
+  splitDimension = other.splitDimension;
+  prediction = other.prediction;
+  splitInfo = std::move(other.splitInfo);
+
+  // Reset the prediction of the other object.
+  other.prediction = 0.0;
+
+  // Take ownership of the auxiliary info.
+  NumericAuxiliarySplitInfo::operator=(std::move(other));
+
+  return *this;
+}
+
+//! Clean up memory.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+DecisionTreeRegressor<FitnessFunction,
+                      NumericSplitType,
+                      DimensionSelectionType,
+                      NoRecursion>::~DecisionTreeRegressor()
+{
+  for (size_t i = 0; i < children.size(); ++i)
+    delete children[i];
+}
+
+//! Train on the given data.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename MatType, typename ResponsesType>
+double DecisionTreeRegressor<FitnessFunction,
+                             NumericSplitType,
+                             DimensionSelectionType,
+                             NoRecursion>::Train(
+    MatType data,
+    ResponsesType responses,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector)
+{
+  // Sanity check on data.
+  util::CheckSameSizes(data, responses, "DecisionTreeRegressor::Train()");
+
+  using TrueMatType = typename std::decay<MatType>::type;
+  using TrueResponsesType = typename std::decay<ResponsesType>::type;
+
+  // Copy or move data.
+  TrueMatType tmpData(std::move(data));
+  TrueResponsesType tmpResponses(std::move(responses));
+
+  // Set the correct dimensionality for the dimension selector.
+  dimensionSelector.Dimensions() = tmpData.n_rows;
+
+  // Pass off work to the Train() method.
+  arma::rowvec weights; // Fake weights, not used.
+  return Train<false>(tmpData, 0, tmpData.n_cols, tmpResponses, weights,
+      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+}
+
+//! Train on the given weighted data.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename MatType, typename ResponsesType, typename WeightsType>
+double DecisionTreeRegressor<FitnessFunction,
+                             NumericSplitType,
+                             DimensionSelectionType,
+                             NoRecursion>::Train(
+    MatType data,
+    ResponsesType responses,
+    WeightsType weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector,
+    const std::enable_if_t<
+        arma::is_arma_type<
+        typename std::remove_reference<
+        WeightsType>::type>::value>*)
+{
+  // Sanity check on data.
+  util::CheckSameSizes(data, responses, "DecisionTreeRegressor::Train()");
+
+  using TrueMatType = typename std::decay<MatType>::type;
+  using TrueResponsesType = typename std::decay<ResponsesType>::type;
+  using TrueWeightsType = typename std::decay<WeightsType>::type;
+
+  // Copy or move data.
+  TrueMatType tmpData(std::move(data));
+  TrueResponsesType tmpResponses(std::move(responses));
+  TrueWeightsType tmpWeights(std::move(weights));
+
+  // Set the correct dimensionality for the dimension selector.
+  dimensionSelector.Dimensions() = tmpData.n_rows;
+
+  // Pass off work to the Train() method.
+  return Train<true>(tmpData, 0, tmpData.n_cols, tmpResponses, tmpWeights,
+      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+}
+
+//! Train on the given data.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<bool UseWeights, typename MatType, typename ResponsesRowType>
+double DecisionTreeRegressor<FitnessFunction,
+                             NumericSplitType,
+                             DimensionSelectionType,
+                             NoRecursion>::Train(
+    MatType& data,
+    const size_t begin,
+    const size_t count,
+    ResponsesRowType& responses,
+    arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType& dimensionSelector)
+{
+  // Clear children if needed.
+  for (size_t i = 0; i < children.size(); ++i)
+    delete children[i];
+  children.clear();
+
+  // Look through the list of dimensions and obtain the gain of the best split.
+  // We'll cache the best numeric split auxiliary information in numericAux
+  // (and clear it later if we make no split), and use splitInfo as auxiliary
+  // information.  Later we'll overwrite prediction to the mean response if we
+  // do not split.
+  double bestGain = FitnessFunction::template Evaluate<UseWeights>(
+      responses.subvec(begin, begin + count - 1),
+      UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
+  size_t bestDim = data.n_rows; // This means "no split".
+  const size_t end = dimensionSelector.End();
+
+  if (maximumDepth != 1)
+  {
+    for (size_t i = dimensionSelector.Begin(); i != end;
+         i = dimensionSelector.Next())
+    {
+      const double dimGain = NumericSplit::template SplitIfBetter<UseWeights>(
+          bestGain,
+          data.cols(begin, begin + count - 1).row(i),
+          responses.subvec(begin, begin + count - 1),
+          UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+          minimumLeafSize,
+          minimumGainSplit,
+          splitInfo,
+          *this);
+
+      // If the splitter reported that it did not split, move to the next
+      // dimension.
+      if (dimGain == DBL_MAX)
+        continue;
+
+      // Was there an improvement?  If so mark that it's the new best dimension.
+      bestDim = i;
+      bestGain = dimGain;
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
+    }
+  }
+
+  // Did we split or not?  If so, then split the data and create the children.
+  if (bestDim != data.n_rows)
+  {
+    splitDimension = bestDim;
+
+    // Get the number of children we will have.
+    const size_t numChildren = NumericSplit::NumChildren(splitInfo, *this);
+
+    // Calculate all child assignments.
+    arma::Row<size_t> childAssignments(count);
+    for (size_t j = begin; j < begin + count; ++j)
+    {
+      childAssignments[j - begin] = NumericSplit::CalculateDirection(
+          data(bestDim, j), splitInfo, *this);
+    }
+
+    // Figure out counts of children.
+    arma::Row<size_t> childCounts(numChildren, arma::fill::zeros);
+    for (size_t j = begin; j < begin + count; ++j)
+      childCounts[childAssignments[j - begin]]++;
+
+    // Rearrange the data so that the points of each child are contiguous, and
+    // remember where each child's range begins; only afterwards can the
+    // children be built independently of each other.
+    arma::Row<size_t> childBegins(numChildren);
+    size_t currentCol = begin;
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+      childBegins[i] = currentCol;
+      for (size_t j = currentCol; j < begin + count; ++j)
+      {
+        if (childAssignments[j - begin] == i)
+        {
+          childAssignments.swap_cols(currentCol - begin, j - begin);
+          data.swap_cols(currentCol, j);
+          responses.swap_cols(currentCol, j);
+          if (UseWeights)
+            weights.swap_cols(currentCol, j);
+          ++currentCol;
+        }
+      }
+      children.push_back(new DecisionTreeRegressor());
+    }
+
+    // Now build each child on its contiguous slice of columns.  The slices
+    // are disjoint, so the subtrees are built as independent tasks (see the
+    // comments in DecisionTree::Train()); each task needs a private copy of
+    // the stateful dimension selector.
+    arma::vec childGains(numChildren, arma::fill::zeros);
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+    #pragma omp parallel default(shared) if (!omp_in_parallel())
+    #pragma omp single
+#endif
+    {
+      for (size_t i = 0; i < numChildren; ++i)
+      {
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+        // Don't bother deferring tiny subtrees; the task overhead would
+        // outweigh the work.
+        #pragma omp task default(shared) firstprivate(i) \
+            if (childCounts[i] > 500)
+#endif
+        {
+          DimensionSelectionType childSelector = dimensionSelector;
+          if (NoRecursion)
+          {
+            children[i]->Train<UseWeights>(data, childBegins[i],
+                childCounts[i], responses, weights, childCounts[i],
+                minimumGainSplit, maximumDepth - 1, childSelector);
+          }
+          else
+          {
+            // During recursion the error of a child node may change.
+            childGains[i] = children[i]->Train<UseWeights>(data,
+                childBegins[i], childCounts[i], responses, weights,
+                minimumLeafSize, minimumGainSplit, maximumDepth - 1,
+                childSelector);
+          }
+        }
+      }
+    }
+
+    if (!NoRecursion)
+    {
+      bestGain = 0.0;
+      for (size_t i = 0; i < numChildren; ++i)
+        bestGain += double(childCounts[i]) / double(count) * (-childGains[i]);
+    }
+  }
+  else
+  {
+    // We won't be needing these members, so reset them.
+    NumericAuxiliarySplitInfo::operator=(NumericAuxiliarySplitInfo());
+    splitInfo.clear();
+
+    // Calculate the prediction because we are a leaf.
+    CalculatePrediction<UseWeights>(
+        responses.subvec(begin, begin + count - 1),
+        UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
+  }
+
+  return -bestGain;
+}
+
+//! Return the predicted response.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename VecType>
+double DecisionTreeRegressor<FitnessFunction,
+                             NumericSplitType,
+                             DimensionSelectionType,
+                             NoRecursion>::Predict(const VecType& point) const
+{
+  if (children.size() == 0)
+  {
+    // Return cached prediction.
+    return prediction;
+  }
+
+  return children[CalculateDirection(point)]->Predict(point);
+}
+
+//! Return the predicted responses for a set of points.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename MatType>
+void DecisionTreeRegressor<FitnessFunction,
+                           NumericSplitType,
+                           DimensionSelectionType,
+                           NoRecursion>::Predict(
+    const MatType& data,
+    arma::rowvec& predictions) const
+{
+  predictions.set_size(data.n_cols);
+  if (children.size() == 0)
+  {
+    predictions.fill(prediction);
+    return;
+  }
+
+  // Flatten the tree once, then send each point down the contiguous node
+  // array; this avoids a chain of recursive calls per point and keeps the
+  // descent loop tight.
+  std::vector<const DecisionTreeRegressor*> nodes;
+  std::vector<size_t> childOffsets;
+  FlattenTree(nodes, childOffsets);
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    size_t cur = 0;
+    while (nodes[cur]->children.size() != 0)
+      cur = childOffsets[cur] + nodes[cur]->CalculateDirection(data.col(i));
+    predictions[i] = nodes[cur]->prediction;
+  }
+}
+
+//! Flatten the tree into a breadth-first node array for batch prediction.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+void DecisionTreeRegressor<FitnessFunction,
+                           NumericSplitType,
+                           DimensionSelectionType,
+                           NoRecursion>::FlattenTree(
+    std::vector<const DecisionTreeRegressor*>& nodes,
+    std::vector<size_t>& childOffsets) const
+{
+  nodes.push_back(this);
+  // `nodes` grows as we iterate, so this loop visits every node exactly once
+  // and appends its children in breadth-first order.
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    childOffsets.push_back(nodes.size());
+    for (size_t c = 0; c < nodes[i]->children.size(); ++c)
+      nodes.push_back(nodes[i]->children[c]);
+  }
+}
+
+//! Serialize the tree.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename Archive>
+void DecisionTreeRegressor<FitnessFunction,
+                           NumericSplitType,
+                           DimensionSelectionType,
+                           NoRecursion>::serialize(Archive& ar,
+                                                   const uint32_t /* version */)
+{
+  // Clean memory if needed.
+  if (cereal::is_loading<Archive>())
+  {
+    for (size_t i = 0; i < children.size(); ++i)
+      delete children[i];
+    children.clear();
+  }
+  // Serialize the children first.
+  ar(CEREAL_VECTOR_POINTER(children));
+
+  // Now serialize the rest of the object.
+  ar(CEREAL_NVP(splitDimension));
+  ar(CEREAL_NVP(prediction));
+  ar(CEREAL_NVP(splitInfo));
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename VecType>
+size_t DecisionTreeRegressor<FitnessFunction,
+                             NumericSplitType,
+                             DimensionSelectionType,
+                             NoRecursion>::CalculateDirection(
+    const VecType& point) const
+{
+  return NumericSplit::CalculateDirection(point[splitDimension], splitInfo,
+      *this);
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<bool UseWeights, typename ResponsesRowType, typename WeightsRowType>
+void DecisionTreeRegressor<FitnessFunction,
+                           NumericSplitType,
+                           DimensionSelectionType,
+                           NoRecursion>::CalculatePrediction(
+    const ResponsesRowType& responses,
+    const WeightsRowType& weights)
+{
+  if (responses.n_elem == 0)
+  {
+    prediction = 0.0;
+    return;
+  }
+
+  if (UseWeights)
+  {
+    double sumWeights = 0.0;
+    double sum = 0.0;
+    for (size_t i = 0; i < responses.n_elem; ++i)
+    {
+      sum += weights[i] * responses[i];
+      sumWeights += weights[i];
+    }
+    prediction = (sumWeights > 0.0) ? sum / sumWeights : 0.0;
+  }
+  else
+  {
+    prediction = arma::mean(responses);
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,155 @@
+/**
+ * @file methods/decision_tree/histogram_numeric_split_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of strategy that searches binned candidate splits for
+ * regression.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction>
+template<bool UseWeights,
+         typename VecType,
+         typename ResponsesType,
+         typename WeightVecType>
+double HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Find the range of the dimension.  If all values are the same, we can't
+  // split.
+  const double dimMin = (double) data.min();
+  const double dimMax = (double) data.max();
+  if (dimMin == dimMax)
+    return DBL_MAX;
+
+  // There is no point in keeping more bins than points.
+  const size_t bins = std::min((size_t) NumBins, (size_t) data.n_elem);
+  const double binWidth = (dimMax - dimMin) / (double) bins;
+
+  // Accumulate the sufficient statistics of each bin in one unsorted pass
+  // over the points.  The point counts are tracked separately from the
+  // weights, because the minimum leaf size is a constraint on the number of
+  // points.
+  arma::Col<size_t> counts(bins, arma::fill::zeros);
+  arma::vec weightSums(bins, arma::fill::zeros);
+  arma::vec sums(bins, arma::fill::zeros);
+  arma::vec sumSquares(bins, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    // The maximum value lands exactly on the upper edge; clamp it into the
+    // last bin.
+    const size_t bin = std::min((size_t) ((data[i] - dimMin) / binWidth),
+        bins - 1);
+    const double weight = UseWeights ? (double) weights[i] : 1.0;
+
+    counts[bin]++;
+    weightSums[bin] += weight;
+    sums[bin] += weight * responses[i];
+    sumSquares[bin] += weight * responses[i] * responses[i];
+  }
+
+  const double totalWeight = arma::accu(weightSums);
+  const double totalSum = arma::accu(sums);
+  const double totalSumSquares = arma::accu(sumSquares);
+
+  // Loop through the bin boundaries, choosing the best one.  Also, force a
+  // minimum leaf size of 1 (empty children don't make sense).
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0) *
+      totalWeight;
+  bool improved = false;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  size_t leftCount = 0;
+  double leftWeight = 0.0;
+  double leftSum = 0.0;
+  double leftSumSquares = 0.0;
+  for (size_t b = 0; b < bins - 1; ++b)
+  {
+    // Move bin b to the left child; the candidate split is then the upper
+    // edge of bin b.
+    leftCount += counts[b];
+    leftWeight += weightSums[b];
+    leftSum += sums[b];
+    leftSumSquares += sumSquares[b];
+
+    // Ensure that both children would satisfy the minimum leaf size.
+    if ((leftCount < minimum) || (data.n_elem - leftCount < minimum))
+      continue;
+
+    // The right child's statistics follow from the totals, so each candidate
+    // is scored in constant time.
+    const double rightWeight = totalWeight - leftWeight;
+    const double leftGain = FitnessFunction::Evaluate(leftWeight, leftSum,
+        leftSumSquares);
+    const double rightGain = FitnessFunction::Evaluate(rightWeight,
+        totalSum - leftSum, totalSumSquares - leftSumSquares);
+
+    const double gain = leftWeight * leftGain + rightWeight * rightGain;
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      splitInfo.set_size(1);
+      splitInfo[0] = dimMin + (double) (b + 1) * binWidth;
+
+      return gain;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      splitInfo.set_size(1);
+      splitInfo[0] = dimMin + (double) (b + 1) * binWidth;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  return bestFoundGain / totalWeight;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t HistogramNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const arma::vec& splitInfo,
+    const AuxiliarySplitInfo& /* aux */)
+{
+  if (point <= splitInfo[0])
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
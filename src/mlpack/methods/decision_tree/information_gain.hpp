@@ -56,10 +56,10 @@ class InformationGain
    * @param numClasses Number of classes in the dataset.
    * @param weights Weights associated with labels.
    */
-  template<bool UseWeights>
-  static double Evaluate(const arma::Row<size_t>& labels,
+  template<bool UseWeights, typename RowType, typename WeightVecType>
+  static double Evaluate(const RowType& labels,
                          const size_t numClasses,
-                         const arma::Row<double>& weights)
+                         const WeightVecType& weights)
   {
      // Edge case: if there are no elements, the gain is zero.
      if (labels.n_elem == 0)
@@ -0,0 +1,106 @@
+/**
+ * @file methods/decision_tree/mse_gain.hpp
+ * @author Ryan Curtin
+ *
+ * The MSEGain class, a fitness function (FitnessFunction) for regression
+ * trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_MSE_GAIN_HPP
+#define MLPACK_METHODS_DECISION_TREE_MSE_GAIN_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The mean squared error gain, a measure of set purity for regression usable
+ * as a fitness function (FitnessFunction) for decision trees.  This is the
+ * variance of the responses around their (weighted) mean, but negated---since
+ * the decision tree will be trying to maximize gain (and the error would need
+ * to be minimized).  Minimizing this gain is therefore exactly
+ * variance-reduction splitting.
+ */
+class MSEGain
+{
+ public:
+  /**
+   * Evaluate the mean squared error given the sufficient statistics of a set
+   * of responses: the total weight (or count), the weighted sum of responses,
+   * and the weighted sum of squared responses.  This form allows split
+   * searches to score candidate splits in constant time from accumulated
+   * statistics.
+   *
+   * @param sumWeights Total weight (or number) of responses in the set.
+   * @param sum Weighted sum of the responses.
+   * @param sumSquares Weighted sum of the squared responses.
+   */
+  static double Evaluate(const double sumWeights,
+                         const double sum,
+                         const double sumSquares)
+  {
+    // Corner case: if the set is empty, the error is zero.
+    if (sumWeights <= 0.0)
+      return 0.0;
+
+    const double mean = sum / sumWeights;
+    // E[y^2] - (E[y])^2; guard against tiny negative results caused by
+    // floating-point cancellation.
+    return -std::max(sumSquares / sumWeights - mean * mean, 0.0);
+  }
+
+  /**
+   * Evaluate the mean squared error on the given set of responses.
+   *
+   * Note that it is possible that due to floating-point representation issues,
+   * it is possible that the gain returned can be very slightly greater than 0!
+   * Thus, if you are checking for a perfect fit, be sure to use 'gain >= 0.0'
+   * not 'gain == 0.0'.
+   *
+   * @param responses Set of responses to evaluate the error on.
+   * @param weights Weight of responses.
+   */
+  template<bool UseWeights, typename ResponsesType, typename WeightVecType>
+  static double Evaluate(const ResponsesType& responses,
+                         const WeightVecType& weights)
+  {
+    // Corner case: if there are no elements, the error is zero.
+    if (responses.n_elem == 0)
+      return 0.0;
+
+    double sumWeights = 0.0;
+    double sum = 0.0;
+    double sumSquares = 0.0;
+
+    if (UseWeights)
+    {
+      for (size_t i = 0; i < responses.n_elem; ++i)
+      {
+        sumWeights += weights[i];
+        sum += weights[i] * responses[i];
+        sumSquares += weights[i] * responses[i] * responses[i];
+      }
+    }
+    else
+    {
+      sumWeights = (double) responses.n_elem;
+      for (size_t i = 0; i < responses.n_elem; ++i)
+      {
+        sum += responses[i];
+        sumSquares += responses[i] * responses[i];
+      }
+    }
+
+    return Evaluate(sumWeights, sum, sumSquares);
+  }
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
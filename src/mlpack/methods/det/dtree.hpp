@@ -163,6 +163,28 @@ class DTree
               const size_t maxLeafSize = 10,
               const size_t minLeafSize = 5);
 
+  /**
+   * Refine an already-grown tree on a new (typically extended) dataset,
+   * instead of rebuilding it from scratch.  The existing split structure is
+   * kept wherever it remains valid: points are re-partitioned down the stored
+   * splits, node statistics are recomputed, leaves that have collected more
+   * than maxLeafSize points are expanded further, and subtrees whose split no
+   * longer leaves at least minLeafSize points on each side are discarded and
+   * regrown.  The points in the dataset will be reordered during refinement,
+   * just as during growth.
+   *
+   * @param data New dataset to refine the tree on.
+   * @param oldFromNew Mappings from old points to new points.
+   * @param useVolReg If true, volume regularization is used.
+   * @param maxLeafSize Maximum size of a leaf.
+   * @param minLeafSize Minimum size of a leaf.
+   */
+  double Refine(MatType& data,
+                arma::Col<size_t>& oldFromNew,
+                const bool useVolReg = false,
+                const size_t maxLeafSize = 10,
+                const size_t minLeafSize = 5);
+
   /**
    * Perform alpha pruning on a tree.  Returns the new value of alpha.
    *
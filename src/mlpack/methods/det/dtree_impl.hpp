@@ -633,14 +633,51 @@ double DTree<MatType, TagType>::Grow(MatType& data,
       splitValue = splitValueTmp;
       splitDim = dim;
 
-      // Recursively grow the children.
+      // Recursively grow the children.  The children cover disjoint column
+      // ranges of the data matrix (and of oldFromNew), so their subtrees can
+      // be grown concurrently.
       left = new DTree(maxValsL, minValsL, start, splitIndex, leftError);
       right = new DTree(maxValsR, minValsR, splitIndex, end, rightError);
 
+#ifdef _WIN32
+      // MSVC's OpenMP support predates tasking, so grow serially there.
       leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
                          minLeafSize);
       rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
                            minLeafSize);
+#else
+      if (root)
+      {
+        // The parallel region is opened once, here at the root, after the
+        // root's own split has been found (so the parallel dimension scan in
+        // FindSplit() is not nested inside it); deeper nodes only spawn tasks
+        // into this region.
+        #pragma omp parallel default(shared)
+        #pragma omp single
+        {
+          #pragma omp task shared(leftG)
+          leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
+                             minLeafSize);
+
+          rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
+                               minLeafSize);
+          #pragma omp taskwait
+        }
+      }
+      else
+      {
+        // Only defer the left subtree when it is large enough to be worth the
+        // scheduling overhead; small subtrees are grown inline.
+        #pragma omp task shared(leftG) \
+            if ((splitIndex - start) > 4 * maxLeafSize)
+        leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
+                           minLeafSize);
+
+        rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
+                             minLeafSize);
+        #pragma omp taskwait
+      }
+#endif
 
       // Store values of R(T~) and |T~|.
       subtreeLeaves = left->SubtreeLeaves() + right->SubtreeLeaves();
@@ -734,6 +771,158 @@ double DTree<MatType, TagType>::Grow(MatType& data,
   // -1.0 * subtreeLeavesError.
 }
 
+// Refine an already-grown tree on a new dataset, reusing the existing split
+// structure wherever it is still valid.
+template<typename MatType, typename TagType>
+double DTree<MatType, TagType>::Refine(MatType& data,
+                                       arma::Col<size_t>& oldFromNew,
+                                       const bool useVolReg,
+                                       const size_t maxLeafSize,
+                                       const size_t minLeafSize)
+{
+  Log::Assert(data.n_rows == maxVals.n_elem);
+  Log::Assert(data.n_rows == minVals.n_elem);
+
+  if (root)
+  {
+    // New points may fall outside the old bounding box; expand it and push
+    // the updated bounds down through the existing splits.
+    maxVals = arma::max(maxVals, StatType(arma::max(data, 1)));
+    minVals = arma::min(minVals, StatType(arma::min(data, 1)));
+    start = 0;
+    end = data.n_cols;
+    if (left != NULL && right != NULL)
+      FillMinMax(minVals, maxVals);
+  }
+
+  // Recompute this node's statistics for the new dataset.
+  logNegError = LogNegativeError(data.n_cols);
+  ratio = (double) (end - start) / (double) oldFromNew.n_elem;
+  logVolume = 0;
+  for (size_t i = 0; i < maxVals.n_elem; ++i)
+    if (maxVals[i] - minVals[i] > 0.0)
+      logVolume += std::log(maxVals[i] - minVals[i]);
+
+  if (left == NULL || right == NULL)
+  {
+    // A leaf: expand it if it has collected too many points; otherwise only
+    // its statistics needed updating.
+    if ((size_t) (end - start) > maxLeafSize)
+      return Grow(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize);
+
+    subtreeLeaves = 1;
+    subtreeLeavesLogNegError = logNegError;
+    return std::numeric_limits<double>::max();
+  }
+
+  // An internal node: re-partition the points with the stored split.
+  const size_t splitIndex = SplitData(data, splitDim, splitValue, oldFromNew);
+
+  if ((splitIndex - start) < minLeafSize || (end - splitIndex) < minLeafSize)
+  {
+    // The stored split no longer leaves enough points on both sides; discard
+    // this subtree and grow it afresh.
+    delete left;
+    delete right;
+    left = NULL;
+    right = NULL;
+    splitDim = size_t(-1);
+    splitValue = std::numeric_limits<ElemType>::max();
+    return Grow(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize);
+  }
+
+  left->start = start;
+  left->end = splitIndex;
+  right->start = splitIndex;
+  right->end = end;
+
+  // Refine the children; as in Grow(), they cover disjoint column ranges of
+  // the data matrix and can be processed concurrently.
+  double leftG, rightG;
+#ifdef _WIN32
+  leftG = left->Refine(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize);
+  rightG = right->Refine(data, oldFromNew, useVolReg, maxLeafSize,
+      minLeafSize);
+#else
+  if (root)
+  {
+    #pragma omp parallel default(shared)
+    #pragma omp single
+    {
+      #pragma omp task shared(leftG)
+      leftG = left->Refine(data, oldFromNew, useVolReg, maxLeafSize,
+                           minLeafSize);
+
+      rightG = right->Refine(data, oldFromNew, useVolReg, maxLeafSize,
+                             minLeafSize);
+      #pragma omp taskwait
+    }
+  }
+  else
+  {
+    #pragma omp task shared(leftG) \
+        if ((splitIndex - start) > 4 * maxLeafSize)
+    leftG = left->Refine(data, oldFromNew, useVolReg, maxLeafSize,
+                         minLeafSize);
+
+    rightG = right->Refine(data, oldFromNew, useVolReg, maxLeafSize,
+                           minLeafSize);
+    #pragma omp taskwait
+  }
+#endif
+
+  // The remainder is the same bookkeeping that Grow() performs once its
+  // children are in place.
+  subtreeLeaves = left->SubtreeLeaves() + right->SubtreeLeaves();
+  subtreeLeavesLogNegError = std::log(
+      std::exp(logVolume + left->SubtreeLeavesLogNegError()) +
+      std::exp(logVolume + right->SubtreeLeavesLogNegError()))
+      - logVolume;
+
+  const double range = maxVals[splitDim] - minVals[splitDim];
+  const double leftRatio = (splitValue - minVals[splitDim]) / range;
+  const double rightRatio = (maxVals[splitDim] - splitValue) / range;
+
+  const size_t leftPow = std::pow((double) (left->End() - left->Start()), 2);
+  const size_t rightPow = std::pow((double) (right->End() - right->Start()),
+      2);
+  const size_t thisPow = std::pow((double) (end - start), 2);
+
+  double tmpAlphaSum = leftPow / leftRatio + rightPow / rightRatio - thisPow;
+
+  if (left->SubtreeLeaves() > 1)
+  {
+    const double exponent = 2 * std::log((double) data.n_cols) + logVolume +
+        left->AlphaUpper();
+
+    tmpAlphaSum += std::exp(exponent);
+  }
+
+  if (right->SubtreeLeaves() > 1)
+  {
+    const double exponent = 2 * std::log((double) data.n_cols) + logVolume +
+        right->AlphaUpper();
+
+    tmpAlphaSum += std::exp(exponent);
+  }
+
+  alphaUpper = std::log(tmpAlphaSum) - 2 * std::log((double) data.n_cols)
+      - logVolume;
+
+  double gT;
+  if (useVolReg)
+  {
+    // This is wrong for now!
+    gT = alphaUpper; // / (subtreeLeavesVTInv - vTInv);
+  }
+  else
+  {
+    gT = alphaUpper - std::log((double) (subtreeLeaves - 1));
+  }
+
+  return std::min(gT, std::min(leftG, rightG));
+}
+
 
 template<typename MatType, typename TagType>
 double DTree<MatType, TagType>::PruneAndUpdate(const double oldAlpha,
@@ -175,7 +175,29 @@ class DualTreeBoruvka
    */
   void ComputeMST(arma::mat& results);
 
+  /**
+   * Statistics for a single Boruvka round, collected during ComputeMST();
+   * useful for seeing where the rounds stop paying off.
+   */
+  struct RoundStat
+  {
+    //! Number of edges in the forest after this round.
+    size_t edges;
+    //! Base cases computed during this round.
+    size_t baseCases;
+    //! Node combinations scored during this round.
+    size_t scores;
+    //! Wall-clock duration of this round, in seconds.
+    double seconds;
+  };
+
+  //! Get the per-round statistics of the last ComputeMST() run.
+  const std::vector<RoundStat>& RoundStats() const { return roundStats; }
+
  private:
+  //! Per-round statistics of the last ComputeMST() run.
+  std::vector<RoundStat> roundStats;
+
   /**
    * Adds a single edge to the edge list
    */
@@ -122,36 +122,126 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
   Timer::Start("emst/mst_computation");
 
   totalDist = 0; // Reset distance.
+  roundStats.clear();
 
   typedef DTBRules<MetricType, Tree> RuleType;
-  RuleType rules(data, connections, neighborsDistances, neighborsInComponent,
-                 neighborsOutComponent, metric);
+
+  size_t threads = 1;
+  #ifdef HAS_OPENMP
+    threads = (size_t) omp_get_max_threads();
+  #endif
+
   while (edges.size() < (data.n_cols - 1))
   {
+    arma::wall_clock roundClock;
+    roundClock.tic();
+    size_t roundBaseCases = 0;
+    size_t roundScores = 0;
+
+    // Make Find() read-only for the duration of the round, so that the
+    // parallel traversals below can query component membership without
+    // touching shared state.
+    connections.Flatten();
+
     if (naive)
     {
       // Full O(N^2) traversal.
+      RuleType rules(data, connections, neighborsDistances,
+          neighborsInComponent, neighborsOutComponent, metric);
       for (size_t i = 0; i < data.n_cols; ++i)
         for (size_t j = 0; j < data.n_cols; ++j)
           rules.BaseCase(i, j);
+      roundBaseCases = data.n_cols * data.n_cols;
     }
-    else
+    else if (threads == 1 || tree->NumChildren() == 0)
     {
+      RuleType rules(data, connections, neighborsDistances,
+          neighborsInComponent, neighborsOutComponent, metric);
       typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
       traverser.Traverse(*tree, *tree);
+      roundBaseCases = rules.BaseCases();
+      roundScores = rules.Scores();
+    }
+    else
+    {
+      // Parallel round: decompose the query side of the self-traversal into
+      // disjoint subtrees, one per thread at least.  Each thread searches
+      // with its own candidate arrays (the component-wise nearest neighbors
+      // found by different threads are merged afterwards), so the traversals
+      // share only read-only state.
+      std::vector<Tree*> queryRoots(1, tree);
+      while (queryRoots.size() < threads)
+      {
+        std::vector<Tree*> nextRoots;
+        bool anySplit = false;
+        for (size_t i = 0; i < queryRoots.size(); ++i)
+        {
+          if (queryRoots[i]->NumChildren() == 0)
+          {
+            nextRoots.push_back(queryRoots[i]);
+          }
+          else
+          {
+            for (size_t c = 0; c < queryRoots[i]->NumChildren(); ++c)
+              nextRoots.push_back(&queryRoots[i]->Child(c));
+            anySplit = true;
+          }
+        }
+        queryRoots.swap(nextRoots);
+        if (!anySplit)
+          break;
+      }
+
+      #pragma omp parallel
+      {
+        // Private candidate arrays; these start in the same reset state as
+        // the shared ones.
+        arma::vec localDistances = neighborsDistances;
+        arma::Col<size_t> localIn = neighborsInComponent;
+        arma::Col<size_t> localOut = neighborsOutComponent;
+
+        RuleType localRules(data, connections, localDistances, localIn,
+            localOut, metric);
+        typename Tree::template DualTreeTraverser<RuleType>
+            localTraverser(localRules);
+
+        #pragma omp for schedule(dynamic) nowait
+        for (omp_size_t i = 0; i < (omp_size_t) queryRoots.size(); ++i)
+          localTraverser.Traverse(*queryRoots[i], *tree);
+
+        // Merge: keep the best candidate edge found for each component.
+        #pragma omp critical
+        {
+          for (size_t c = 0; c < localDistances.n_elem; ++c)
+          {
+            if (localDistances[c] < neighborsDistances[c])
+            {
+              neighborsDistances[c] = localDistances[c];
+              neighborsInComponent[c] = localIn[c];
+              neighborsOutComponent[c] = localOut[c];
+            }
+          }
+          roundBaseCases += localRules.BaseCases();
+          roundScores += localRules.Scores();
+        }
+      }
     }
 
     AddAllEdges();
 
     Cleanup();
 
-    Log::Info << edges.size() << " edges found so far." << std::endl;
-    if (!naive)
-    {
-      Log::Info << rules.BaseCases() << " cumulative base cases." << std::endl;
-      Log::Info << rules.Scores() << " cumulative node combinations scored."
-          << std::endl;
-    }
+    RoundStat stat;
+    stat.edges = edges.size();
+    stat.baseCases = roundBaseCases;
+    stat.scores = roundScores;
+    stat.seconds = roundClock.toc();
+    roundStats.push_back(stat);
+
+    Log::Info << "Boruvka round " << roundStats.size() << ": " << edges.size()
+        << " edges found so far; " << roundBaseCases << " base cases and "
+        << roundScores << " node combinations scored in " << stat.seconds
+        << "s." << std::endl;
   }
 
   Timer::Stop("emst/mst_computation");
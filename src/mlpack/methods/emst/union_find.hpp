@@ -17,6 +17,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include <atomic>
+
 namespace mlpack {
 namespace emst {
 
@@ -61,12 +63,28 @@ class UnionFind
     }
     else
     {
-      // This ensures that the tree has a small depth.
-      parent[x] = Find(parent[x]);
-      return parent[x];
+      // This ensures that the tree has a small depth.  The write is skipped
+      // when the entry is already compressed, so that concurrent Find()s on a
+      // flattened structure (see Flatten()) perform no writes at all.
+      const size_t root = Find(parent[x]);
+      if (parent[x] != root)
+        parent[x] = root;
+      return root;
     }
   }
 
+  /**
+   * Fully compress the structure, so that every element points directly at
+   * the root of its component.  After a Flatten(), Find() is a read-only
+   * single lookup until the next Union(), which makes it safe to call
+   * concurrently from multiple threads.
+   */
+  void Flatten()
+  {
+    for (size_t i = 0; i < parent.n_elem; ++i)
+      Find(i);
+  }
+
   /**
    * Union the components containing x and y.
    *
@@ -98,6 +116,89 @@ class UnionFind
   }
 }; // class UnionFind
 
+/**
+ * A lock-free Union-Find structure, safe for concurrent Union() and Find()
+ * calls from multiple threads.  Parent pointers are stored as atomics; roots
+ * are linked with compare-and-swap, always attaching the higher-indexed root
+ * below the lower-indexed one.  That orientation cannot create cycles and
+ * makes the final component roots independent of thread interleaving, so
+ * parallel runs produce the same components as sequential ones.
+ *
+ * Unlike UnionFind, there is no union-by-rank (rank updates cannot easily be
+ * made atomic together with the link), so tree depths can be larger; the
+ * path-halving performed by Find() keeps them short in practice.
+ */
+class AtomicUnionFind
+{
+ private:
+  std::vector<std::atomic<size_t>> parent;
+
+ public:
+  //! Construct the object with the given size.
+  AtomicUnionFind(const size_t size) : parent(size)
+  {
+    for (size_t i = 0; i < size; ++i)
+      parent[i].store(i, std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns the component containing an element.  Safe to call concurrently
+   * with other Find() and Union() calls; note that a result may be stale if a
+   * concurrent Union() merges the component while this runs, so final
+   * component lookups should happen after all Union() calls have completed.
+   *
+   * @param x the component to be found
+   * @return The index of the component containing x
+   */
+  size_t Find(size_t x)
+  {
+    while (true)
+    {
+      const size_t p = parent[x].load(std::memory_order_relaxed);
+      if (p == x)
+        return x;
+
+      const size_t gp = parent[p].load(std::memory_order_relaxed);
+      if (gp == p)
+        return p;
+
+      // Path halving: point x at its grandparent.  A failed exchange only
+      // means another thread already shortened this path.
+      size_t expected = p;
+      parent[x].compare_exchange_weak(expected, gp,
+          std::memory_order_relaxed);
+      x = gp;
+    }
+  }
+
+  /**
+   * Union the components containing x and y.
+   *
+   * @param x one component
+   * @param y the other component
+   */
+  void Union(const size_t x, const size_t y)
+  {
+    size_t xRoot = Find(x);
+    size_t yRoot = Find(y);
+    while (xRoot != yRoot)
+    {
+      // Attach the higher-indexed root below the lower-indexed one.
+      if (xRoot > yRoot)
+        std::swap(xRoot, yRoot);
+
+      size_t expected = yRoot;
+      if (parent[yRoot].compare_exchange_strong(expected, xRoot,
+          std::memory_order_relaxed))
+        return;
+
+      // Another thread got to yRoot first; recompute the roots and retry.
+      xRoot = Find(xRoot);
+      yRoot = Find(yRoot);
+    }
+  }
+}; // class AtomicUnionFind
+
 } // namespace emst
 } // namespace mlpack
 
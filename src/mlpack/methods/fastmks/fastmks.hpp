@@ -302,6 +302,19 @@ class FastMKS
   //! Modify whether or not brute-force (naive) search is used.
   bool& Naive() { return naive; }
 
+  //! Get the number of Monte Carlo samples used for probabilistic pruning
+  //! during single-tree search (0 means the search is exact).
+  size_t MCSamples() const { return mcSamples; }
+  //! Modify the number of Monte Carlo samples used for probabilistic pruning
+  //! during single-tree search.  When set to a nonzero value m, a node that
+  //! cannot be pruned exactly is probed with m sampled descendants, and is
+  //! pruned anyway if no sample improves the current candidates; if a
+  //! fraction alpha of the node's points would improve the results, the
+  //! probability of wrongly pruning it is at most (1 - alpha)^m.  This trades
+  //! a small amount of accuracy for a large reduction in traversal time, and
+  //! only takes effect in single-tree mode.
+  size_t& MCSamples() { return mcSamples; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -321,6 +334,9 @@ class FastMKS
   bool singleMode;
   //! If true, naive (brute-force) search is used.
   bool naive;
+  //! Number of Monte Carlo samples for probabilistic pruning (0 for exact
+  //! search).
+  size_t mcSamples;
 
   //! The instantiated inner-product metric induced by the given kernel.
   metric::IPMetric<KernelType> metric;
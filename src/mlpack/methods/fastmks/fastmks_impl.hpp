@@ -35,7 +35,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(const bool singleMode,
     treeOwner(true),
     setOwner(true),
     singleMode(singleMode),
-    naive(naive)
+    naive(naive),
+    mcSamples(0)
 {
   Timer::Start("tree_building");
   if (!naive)
@@ -58,7 +59,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(
     treeOwner(true),
     setOwner(false),
     singleMode(singleMode),
-    naive(naive)
+    naive(naive),
+    mcSamples(0)
 {
   Timer::Start("tree_building");
   if (!naive)
@@ -82,6 +84,7 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(const MatType& referenceSet,
     setOwner(false),
     singleMode(singleMode),
     naive(naive),
+    mcSamples(0),
     metric(kernel)
 {
   Timer::Start("tree_building");
@@ -108,7 +111,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(
     treeOwner(true),
     setOwner(naive),
     singleMode(singleMode),
-    naive(naive)
+    naive(naive),
+    mcSamples(0)
 {
   Timer::Start("tree_building");
   if (!naive)
@@ -135,6 +139,7 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(MatType&& referenceSet,
     setOwner(naive),
     singleMode(singleMode),
     naive(naive),
+    mcSamples(0),
     metric(kernel)
 {
   Timer::Start("tree_building");
@@ -163,6 +168,7 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(Tree* referenceTree,
     setOwner(false),
     singleMode(singleMode),
     naive(false),
+    mcSamples(0),
     metric(referenceTree->Metric())
 {
   // Nothing to do.
@@ -180,6 +186,7 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(const FastMKS& other) :
     setOwner(other.referenceTree == NULL),
     singleMode(other.singleMode),
     naive(other.naive),
+    mcSamples(other.mcSamples),
     metric(other.metric)
 {
   // Set reference set correctly.
@@ -201,6 +208,7 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(FastMKS&& other) :
     setOwner(other.setOwner),
     singleMode(other.singleMode),
     naive(other.naive),
+    mcSamples(other.mcSamples),
     metric(std::move(other.metric))
 {
   // Clear information from the other.
@@ -210,6 +218,7 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(FastMKS&& other) :
   other.setOwner = false;
   other.singleMode = false;
   other.naive = false;
+  other.mcSamples = 0;
 }
 
 template<typename KernelType,
@@ -248,6 +257,7 @@ FastMKS<KernelType, MatType, TreeType>::operator=(const FastMKS& other)
 
   singleMode = other.singleMode;
   naive = other.naive;
+  mcSamples = other.mcSamples;
 }
 
 template<typename KernelType,
@@ -266,6 +276,7 @@ FastMKS<KernelType, MatType, TreeType>::operator=(FastMKS&& other)
     setOwner = other.setOwner;
     singleMode = other.singleMode;
     naive = other.naive;
+    mcSamples = other.mcSamples;
     metric = std::move(other.metric);
 
     // Clear information from the other.
@@ -275,6 +286,7 @@ FastMKS<KernelType, MatType, TreeType>::operator=(FastMKS&& other)
     other.setOwner = false;
     other.singleMode = false;
     other.naive = false;
+    other.mcSamples = 0;
   }
   return *this;
 }
@@ -455,8 +467,10 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < querySet.n_cols; ++q)
+    // Simple double loop.  Stupid, slow, but a good benchmark.  Each query
+    // point is independent, so the outer loop runs in parallel.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t q = 0; q < (omp_size_t) querySet.n_cols; ++q)
     {
       const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
       std::vector<Candidate> cList(k, def);
@@ -491,20 +505,55 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Single-tree implementation.
   if (singleMode)
   {
-    // Create rules object (this will store the results).  This constructor
-    // precalculates each self-kernel value.
     typedef FastMKSRules<KernelType, Tree> RuleType;
-    RuleType rules(*referenceSet, querySet, k, metric.Kernel());
 
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    // Fill the results with sentinels; each query's column is written by the
+    // thread that processes it.
+    indices.fill(size_t() - 1);
+    kernels.fill(-DBL_MAX);
+
+    size_t totalBaseCases = 0;
+    size_t totalScores = 0;
+
+    #pragma omp parallel
+    {
+      // The traversal caches query-dependent kernel values in the tree
+      // statistics, so concurrent queries cannot share one tree; each thread
+      // works on a private copy.  The rules object (which precalculates each
+      // self-kernel value) must be private for the same reason.
+      Tree threadTree(*referenceTree);
+      RuleType rules(*referenceSet, querySet, k, metric.Kernel(), mcSamples);
+
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+        traverser.Traverse((size_t) i, threadTree);
 
-    Log::Info << rules.BaseCases() << " base cases." << std::endl;
-    Log::Info << rules.Scores() << " scores." << std::endl;
+      arma::Mat<size_t> threadIndices;
+      arma::mat threadKernels;
+      rules.GetResults(threadIndices, threadKernels);
 
-    rules.GetResults(indices, kernels);
+      #pragma omp critical (fastmksResults)
+      {
+        // Copy over the results for the queries this thread processed; the
+        // others still hold their sentinel values.
+        for (size_t i = 0; i < querySet.n_cols; ++i)
+        {
+          if (threadKernels(0, i) != -DBL_MAX)
+          {
+            indices.col(i) = threadIndices.col(i);
+            kernels.col(i) = threadKernels.col(i);
+          }
+        }
+
+        totalBaseCases += rules.BaseCases();
+        totalScores += rules.Scores();
+      }
+    }
+
+    Log::Info << totalBaseCases << " base cases." << std::endl;
+    Log::Info << totalScores << " scores." << std::endl;
 
     Timer::Stop("computing_products");
     return;
@@ -592,8 +641,10 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < referenceSet->n_cols; ++q)
+    // Simple double loop.  Stupid, slow, but a good benchmark.  The queries
+    // are independent of each other, so the outer loop runs in parallel.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t q = 0; q < (omp_size_t) referenceSet->n_cols; ++q)
     {
       const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
       std::vector<Candidate> cList(k, def);
@@ -631,25 +682,53 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Single-tree implementation.
   if (singleMode)
   {
-    // Create rules object (this will store the results).  This constructor
-    // precalculates each self-kernel value.
     typedef FastMKSRules<KernelType, Tree> RuleType;
-    RuleType rules(*referenceSet, *referenceSet, k, metric.Kernel());
 
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    // Fill the results with sentinels; each query's column is written by the
+    // thread that processes it.
+    indices.fill(size_t() - 1);
+    kernels.fill(-DBL_MAX);
+
+    size_t totalBaseCases = 0;
+    size_t totalScores = 0;
 
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    #pragma omp parallel
+    {
+      // As in the query-set overload, the traversal caches query-dependent
+      // kernel values in the tree statistics, so each thread traverses a
+      // private copy of the tree with a private rules object.
+      Tree threadTree(*referenceTree);
+      RuleType rules(*referenceSet, *referenceSet, k, metric.Kernel(),
+          mcSamples);
+
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
-    // Save the number of pruned nodes.
-    const size_t numPrunes = traverser.NumPrunes();
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) referenceSet->n_cols; ++i)
+        traverser.Traverse((size_t) i, threadTree);
 
-    Log::Info << "Pruned " << numPrunes << " nodes." << std::endl;
+      arma::Mat<size_t> threadIndices;
+      arma::mat threadKernels;
+      rules.GetResults(threadIndices, threadKernels);
 
-    Log::Info << rules.BaseCases() << " base cases." << std::endl;
-    Log::Info << rules.Scores() << " scores." << std::endl;
+      #pragma omp critical (fastmksResults)
+      {
+        for (size_t i = 0; i < referenceSet->n_cols; ++i)
+        {
+          if (threadKernels(0, i) != -DBL_MAX)
+          {
+            indices.col(i) = threadIndices.col(i);
+            kernels.col(i) = threadKernels.col(i);
+          }
+        }
+
+        totalBaseCases += rules.BaseCases();
+        totalScores += rules.Scores();
+      }
+    }
 
-    rules.GetResults(indices, kernels);
+    Log::Info << totalBaseCases << " base cases." << std::endl;
+    Log::Info << totalScores << " scores." << std::endl;
 
     Timer::Stop("computing_products");
     return;
@@ -674,6 +753,7 @@ void FastMKS<KernelType, MatType, TreeType>::serialize(
   // Serialize preferences for search.
   ar(CEREAL_NVP(naive));
   ar(CEREAL_NVP(singleMode));
+  ar(CEREAL_NVP(mcSamples));
 
   // If we are doing naive search, serialize the dataset.  Otherwise we
   // serialize the tree.
@@ -14,6 +14,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/kernels/kernel_traits.hpp>
+#include <mlpack/core/math/random.hpp>
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
 #include <mlpack/core/tree/traversal_info.hpp>
 #include <boost/heap/priority_queue.hpp>
@@ -38,15 +39,26 @@ class FastMKSRules
    * Construct the FastMKSRules object.  This is usually done from within the
    * FastMKS class at search time.
    *
+   * If mcSamples is nonzero, single-tree scoring becomes probabilistic: a
+   * reference node that the deterministic bound cannot prune is probed with
+   * mcSamples randomly sampled descendants, and pruned anyway if none of the
+   * sampled kernel values improves the query's current candidates.  If a
+   * fraction alpha of the node's descendants would improve the results, the
+   * probability that such a node is wrongly pruned is at most
+   * (1 - alpha)^mcSamples, so the search is no longer exact.
+   *
    * @param referenceSet Set of reference data.
    * @param querySet Set of query data.
    * @param k Number of candidates to search for.
    * @param kernel Kernel to run FastMKS with.
+   * @param mcSamples Number of Monte Carlo samples for probabilistic pruning
+   *      (0 for exact search).
    */
   FastMKSRules(const typename TreeType::Mat& referenceSet,
                const typename TreeType::Mat& querySet,
                const size_t k,
-               KernelType& kernel);
+               KernelType& kernel,
+               const size_t mcSamples = 0);
 
   /**
    * Store the list of candidates for each query point in the given matrices.
@@ -158,6 +170,10 @@ class FastMKSRules
   //! Number of points to search for.
   const size_t k;
 
+  //! Number of Monte Carlo samples used for probabilistic pruning (0 for
+  //! exact search).
+  const size_t mcSamples;
+
   //! Cached query set self-kernels (|| q || for each q).
   arma::vec queryKernels;
   //! Cached reference set self-kernels (|| r || for each r).
@@ -23,10 +23,12 @@ FastMKSRules<KernelType, TreeType>::FastMKSRules(
     const typename TreeType::Mat& referenceSet,
     const typename TreeType::Mat& querySet,
     const size_t k,
-    KernelType& kernel) :
+    KernelType& kernel,
+    const size_t mcSamples) :
     referenceSet(referenceSet),
     querySet(querySet),
     k(k),
+    mcSamples(mcSamples),
     kernel(kernel),
     lastQueryIndex(-1),
     lastReferenceIndex(-1),
@@ -213,9 +215,49 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
     maxKernel = kernelEval + furthestDist * queryKernels[queryIndex];
   }
 
+  if (maxKernel < bestKernel)
+    return DBL_MAX;
+
+  // The deterministic bound could not prune the node.  In Monte Carlo mode,
+  // probe the node with a handful of sampled descendants before committing to
+  // a full recursion: if no sampled kernel value improves the current
+  // candidates, the node is unlikely to contain anything useful and is pruned
+  // anyway.  If a fraction alpha of the node's descendants would improve the
+  // results, the probability that every sample misses them is at most
+  // (1 - alpha)^mcSamples.  Small nodes are cheaper to recurse into than to
+  // sample, so they are always searched exactly.
+  if ((mcSamples > 0) && (referenceNode.NumDescendants() >= 2 * mcSamples))
+  {
+    bool improves = false;
+    for (size_t s = 0; s < mcSamples; ++s)
+    {
+      const size_t ref = referenceNode.Descendant(
+          math::RandInt(referenceNode.NumDescendants()));
+
+      // Don't let a point match itself in the monochromatic case.
+      if ((&querySet == &referenceSet) && (ref == queryIndex))
+        continue;
+
+      const double eval = kernel.Evaluate(querySet.col(queryIndex),
+                                          referenceSet.col(ref));
+      ++baseCases;
+
+      if (eval > bestKernel)
+      {
+        improves = true;
+        break;
+      }
+    }
+
+    // The sampled evaluations are not inserted as candidates, so that the
+    // exact recursion below cannot produce duplicate results.
+    if (!improves)
+      return DBL_MAX;
+  }
+
   // We return the inverse of the maximum kernel so that larger kernels are
   // recursed into first.
-  return (maxKernel >= bestKernel) ? (1.0 / maxKernel) : DBL_MAX;
+  return 1.0 / maxKernel;
 }
 
 template<typename KernelType, typename TreeType>
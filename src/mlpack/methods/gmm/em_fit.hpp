@@ -22,6 +22,8 @@
 #include <mlpack/methods/kmeans/kmeans.hpp>
 // Default covariance matrix constraint.
 #include "positive_definite_constraint.hpp"
+// Needed so that Estimate() can detect when covariances must be pooled.
+#include "tied_constraint.hpp"
 
 namespace mlpack {
 namespace gmm {
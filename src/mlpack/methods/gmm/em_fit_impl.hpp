@@ -87,8 +87,11 @@ Estimate(const arma::mat& observations,
         << "log-likelihood " << l << "." << std::endl;
 
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
+    // Gaussian given the observations and the present theta value.  Each
+    // component's batched LogProbability() call writes to its own column, so
+    // the components can be computed concurrently.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Store conditional log probabilities into condLogProb vector for each
       // Gaussian.  First we make an alias of the condLogProb vector.
@@ -98,7 +101,8 @@ Estimate(const arma::mat& observations,
     }
 
     // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) condLogProb.n_rows; ++i)
     {
       // Avoid dividing by zero; if the probability for everything is 0, we
       // don't want to make it NaN.
@@ -109,14 +113,18 @@ Estimate(const arma::mat& observations,
 
     // Store the sum of the probability of each state over all the observations.
     arma::vec probRowSums(dists.size());
-    for (size_t i = 0; i < dists.size(); ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       probRowSums(i) = mlpack::math::AccuLog(condLogProb.col(i));
     }
 
     // Calculate the new value of the means using the updated conditional
-    // probabilities.
-    for (size_t i = 0; i < dists.size(); ++i)
+    // probabilities.  The M-step updates each component from its own weighted
+    // sums over the dataset (already batched as matrix products), and no
+    // component reads another's state, so this loop is also parallel.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Don't update if there's no probability of the Gaussian having points.
       if (probRowSums[i] != -std::numeric_limits<double>::infinity())
@@ -158,6 +166,23 @@ Estimate(const arma::mat& observations,
     // probabilities.
     weights = arma::exp(probRowSums - std::log(observations.n_cols));
 
+    // If the covariances are tied, pool the per-component covariances
+    // (weighted by the new component weights) and assign the pooled result to
+    // every component.  This cannot happen inside ApplyConstraint(), which
+    // only sees one component at a time.
+    if (std::is_same<CovarianceConstraintPolicy, TiedConstraint>::value)
+    {
+      typename std::conditional<std::is_same<Distribution,
+          distribution::DiagonalGaussianDistribution>::value,
+          arma::vec, arma::mat>::type pooledCovariance;
+      pooledCovariance.zeros(arma::size(dists[0].Covariance()));
+      for (size_t i = 0; i < dists.size(); ++i)
+        pooledCovariance += weights[i] * dists[i].Covariance();
+
+      for (size_t i = 0; i < dists.size(); ++i)
+        dists[i].Covariance(pooledCovariance);
+    }
+
     // Update values of l; calculate new log-likelihood.
     lOld = l;
     l = LogLikelihood(observations, dists, weights);
@@ -192,8 +217,11 @@ Estimate(const arma::mat& observations,
   while (std::abs(l - lOld) > tolerance && iteration != maxIterations)
   {
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
+    // Gaussian given the observations and the present theta value.  Each
+    // component's batched LogProbability() call writes to its own column, so
+    // the components can be computed concurrently.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Store conditional log probabilities into condLogProb vector for each
       // Gaussian.  First we make an alias of the condLogProb vector.
@@ -203,7 +231,8 @@ Estimate(const arma::mat& observations,
     }
 
     // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) condLogProb.n_rows; ++i)
     {
       // Avoid dividing by zero; if the probability for everything is 0, we
       // don't want to make it NaN.
@@ -217,9 +246,12 @@ Estimate(const arma::mat& observations,
     arma::vec probRowSums(dists.size());
 
     // Calculate the new value of the means using the updated conditional
-    // probabilities.
+    // probabilities.  As in the unweighted overload, each component's update
+    // depends only on its own column of responsibilities, so the components
+    // can be refit concurrently.
     arma::vec logProbabilities = arma::log(probabilities);
-    for (size_t i = 0; i < dists.size(); ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Calculate the sum of probabilities of points, which is the
       // conditional probability of each point being from Gaussian i
@@ -271,6 +303,21 @@ Estimate(const arma::mat& observations,
     // probabilities.
     weights = arma::exp(probRowSums - mlpack::math::AccuLog(logProbabilities));
 
+    // For tied covariances, pool across components just as in the unweighted
+    // overload; the per-component constraint hook cannot do this.
+    if (std::is_same<CovarianceConstraintPolicy, TiedConstraint>::value)
+    {
+      typename std::conditional<std::is_same<Distribution,
+          distribution::DiagonalGaussianDistribution>::value,
+          arma::vec, arma::mat>::type pooledCovariance;
+      pooledCovariance.zeros(arma::size(dists[0].Covariance()));
+      for (size_t i = 0; i < dists.size(); ++i)
+        pooledCovariance += weights[i] * dists[i].Covariance();
+
+      for (size_t i = 0; i < dists.size(); ++i)
+        dists[i].Covariance(pooledCovariance);
+    }
+
     // Update values of l; calculate new log-likelihood.
     lOld = l;
     l = LogLikelihood(observations, dists, weights);
@@ -383,25 +430,31 @@ LogLikelihood(const arma::mat& observations,
 {
   double logLikelihood = 0;
 
-  arma::vec logPhis;
   arma::mat logLikelihoods(dists.size(), observations.n_cols);
 
-  // It has to be LogProbability() otherwise Probability() would overflow easily
-  for (size_t i = 0; i < dists.size(); ++i)
+  // It has to be LogProbability() otherwise Probability() would overflow
+  // easily.  Each component fills its own row, so this is safe to do in
+  // parallel (logPhis must stay local to the iteration).
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
   {
+    arma::vec logPhis;
     dists[i].LogProbability(observations, logPhis);
     logLikelihoods.row(i) = log(weights(i)) + trans(logPhis);
   }
-  // Now sum over every point.
+  // Now sum over every point, with one fused log-sum-exp over all components
+  // instead of a per-point AccuLog() call.
+  arma::vec pointLogLikelihoods;
+  mlpack::math::LogSumExpT(logLikelihoods, pointLogLikelihoods);
+
   for (size_t j = 0; j < observations.n_cols; ++j)
   {
-    if (mlpack::math::AccuLog(logLikelihoods.col(j)) ==
-        -std::numeric_limits<double>::infinity())
+    if (pointLogLikelihoods(j) == -std::numeric_limits<double>::infinity())
     {
       Log::Info << "Likelihood of point " << j << " is 0!  It is probably an "
           << "outlier." << std::endl;
     }
-    logLikelihood += mlpack::math::AccuLog(logLikelihoods.col(j));
+    logLikelihood += pointLogLikelihoods(j);
   }
 
   return logLikelihood;
@@ -237,9 +237,11 @@ double GMM::LogLikelihood(
     logLikelihoods.row(i) = log(weightsL(i)) + trans(logPhis);
   }
 
-  // Now sum over every point.
-  for (size_t j = 0; j < data.n_cols; ++j)
-    loglikelihood += mlpack::math::AccuLog(logLikelihoods.col(j));
+  // Now sum over every point, using one fused log-sum-exp across components
+  // rather than a per-point AccuLog() call.
+  arma::vec pointLogLikelihoods;
+  mlpack::math::LogSumExpT(logLikelihoods, pointLogLikelihoods);
+  loglikelihood = arma::accu(pointLogLikelihoods);
   return loglikelihood;
 }
 
@@ -0,0 +1,63 @@
+/**
+ * @file methods/gmm/spherical_constraint.hpp
+ * @author Ryan Curtin
+ *
+ * Constrain a covariance matrix to be spherical (isotropic).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_SPHERICAL_CONSTRAINT_HPP
+#define MLPACK_METHODS_GMM_SPHERICAL_CONSTRAINT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace gmm {
+
+/**
+ * Force a covariance matrix to be spherical; that is, a scalar multiple of the
+ * identity matrix.  The scalar is the mean of the diagonal of the given
+ * covariance, which is the maximum-likelihood spherical covariance for the
+ * component.  A spherical component needs only one variance parameter, so this
+ * is useful for high-component-count models where full covariance estimation
+ * would overfit (or be too slow).
+ */
+class SphericalConstraint
+{
+ public:
+  //! Force a covariance matrix to be spherical.
+  static void ApplyConstraint(arma::mat& covariance)
+  {
+    // The maximum-likelihood isotropic variance is the average of the diagonal
+    // of the unconstrained covariance; clamp it away from zero so the
+    // component cannot collapse onto a single point.
+    const double variance = std::max(
+        arma::as_scalar(arma::mean(covariance.diag())), 1e-10);
+    covariance = variance *
+        arma::eye<arma::mat>(covariance.n_rows, covariance.n_cols);
+  }
+
+  /**
+   * Apply the spherical constraint to the given diagonal covariance matrix
+   * (which is represented as a vector): every element of the diagonal is set
+   * to their mean, with a minimum value of 1e-10.
+   */
+  static void ApplyConstraint(arma::vec& diagCovariance)
+  {
+    const double variance = std::max(
+        arma::as_scalar(arma::mean(diagCovariance)), 1e-10);
+    diagCovariance.fill(variance);
+  }
+
+  //! Serialize the constraint (which holds nothing, so, nothing to do).
+  template<typename Archive>
+  static void serialize(Archive& /* ar */, const uint32_t /* version */) { }
+};
+
+} // namespace gmm
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,64 @@
+/**
+ * @file methods/gmm/tied_constraint.hpp
+ * @author Ryan Curtin
+ *
+ * Constrain all components of a GMM to share one covariance matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_TIED_CONSTRAINT_HPP
+#define MLPACK_METHODS_GMM_TIED_CONSTRAINT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "positive_definite_constraint.hpp"
+
+namespace mlpack {
+namespace gmm {
+
+/**
+ * Tie the covariance matrices of all components of a GMM together, so that
+ * every component shares a single pooled covariance.  Tying reduces the number
+ * of covariance parameters from one matrix per component to one matrix total,
+ * and means only one Cholesky factorization is needed per EM iteration instead
+ * of one per component.
+ *
+ * Tying is inherently a cross-component operation, so it cannot be expressed
+ * through the per-component ApplyConstraint() hook alone.  When EMFit is
+ * instantiated with this policy, it pools the per-component covariances
+ * (weighted by the component weights) after each M-step and assigns the pooled
+ * matrix to every component; the per-component hook here only guards positive
+ * definiteness so that the intermediate matrices remain factorizable.
+ */
+class TiedConstraint
+{
+ public:
+  //! Ensure the per-component covariance remains positive definite; the
+  //! actual tying across components is handled inside EMFit.
+  static void ApplyConstraint(arma::mat& covariance)
+  {
+    PositiveDefiniteConstraint::ApplyConstraint(covariance);
+  }
+
+  /**
+   * Apply the constraint to the given diagonal covariance matrix (which is
+   * represented as a vector).  As with the matrix version, this only enforces
+   * positive definiteness; the pooling is done by EMFit.
+   */
+  static void ApplyConstraint(arma::vec& diagCovariance)
+  {
+    PositiveDefiniteConstraint::ApplyConstraint(diagCovariance);
+  }
+
+  //! Serialize the constraint (which holds nothing, so, nothing to do).
+  template<typename Archive>
+  static void serialize(Archive& /* ar */, const uint32_t /* version */) { }
+};
+
+} // namespace gmm
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file methods/gradient_boosting/gradient_boosting.hpp
+ * @author Ryan Curtin
+ *
+ * Definition of the GradientBoosting class, a gradient boosted ensemble of
+ * regression trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_HPP
+
+#include <mlpack/core/data/compressed_blob.hpp>
+#include <mlpack/methods/decision_tree/decision_tree_regressor.hpp>
+#include "squared_error_loss.hpp"
+#include "logistic_loss.hpp"
+
+namespace mlpack {
+namespace gradient_boosting {
+
+/**
+ * The GradientBoosting class implements gradient boosted decision trees: an
+ * additive ensemble of shallow DecisionTreeRegressor trees, where each tree
+ * is fit to the per-point Newton step of the loss at the current predictions
+ * and added with a shrinkage factor (the learning rate).
+ *
+ * The trees are trained on the Newton targets -gradient / hessian with the
+ * hessians as instance weights, so a leaf's fitted value is
+ * -sum(gradients) / sum(hessians)---the second-order (Newton) leaf weight.
+ * For the default SquaredErrorLoss the hessians are constant and this reduces
+ * to classical residual fitting; with LogisticLoss the ensemble performs
+ * binary classification on 0/1 responses.
+ *
+ * The base learners use HistogramNumericSplit, so each tree trains in time
+ * linear in the number of points; this is what makes boosting hundreds of
+ * trees on very large datasets affordable.
+ *
+ * All of the const Predict() and Classify() overloads are reentrant, so a
+ * single trained ensemble may safely serve concurrent calls from multiple
+ * threads.
+ *
+ * @tparam LossFunction The loss to minimize; see SquaredErrorLoss for the
+ *      required interface.
+ */
+template<typename LossFunction = SquaredErrorLoss>
+class GradientBoosting
+{
+ public:
+  //! Allow access to the base learner type.
+  typedef tree::DecisionTreeRegressor<> TreeType;
+
+  /**
+   * Construct the ensemble without any training.  Predict() will throw an
+   * exception until Train() is called.
+   */
+  GradientBoosting() : initialScore(0.0), learningRate(0.1) { }
+
+  /**
+   * Create a gradient boosted ensemble, training on the given data and
+   * responses.
+   *
+   * @param dataset Dataset to train on.
+   * @param responses Responses for each training point (0 or 1 for
+   *      classification losses).
+   * @param numTrees Number of trees to boost.
+   * @param learningRate Shrinkage applied to each tree's contribution.
+   * @param minimumLeafSize Minimum number of points in each tree's leaf nodes.
+   * @param minimumGainSplit Minimum gain for splitting a tree node.
+   * @param maximumDepth Maximum depth for each tree (0 means no limit).
+   */
+  template<typename MatType, typename ResponsesType>
+  GradientBoosting(const MatType& dataset,
+                   const ResponsesType& responses,
+                   const size_t numTrees = 100,
+                   const double learningRate = 0.1,
+                   const size_t minimumLeafSize = 10,
+                   const double minimumGainSplit = 1e-7,
+                   const size_t maximumDepth = 6);
+
+  /**
+   * Train the ensemble on the given data and responses.  This will overwrite
+   * the existing model.
+   *
+   * @param data Dataset to train on.
+   * @param responses Responses for each training point (0 or 1 for
+   *      classification losses).
+   * @param numTrees Number of trees to boost.
+   * @param learningRate Shrinkage applied to each tree's contribution.
+   * @param minimumLeafSize Minimum number of points in each tree's leaf nodes.
+   * @param minimumGainSplit Minimum gain for splitting a tree node.
+   * @param maximumDepth Maximum depth for each tree (0 means no limit).
+   * @return The average training loss of the final ensemble.
+   */
+  template<typename MatType, typename ResponsesType>
+  double Train(const MatType& data,
+               const ResponsesType& responses,
+               const size_t numTrees = 100,
+               const double learningRate = 0.1,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 6);
+
+  /**
+   * Predict the response of the given point: the transformed sum of every
+   * tree's contribution (for LogisticLoss, the probability of class 1).  If
+   * the ensemble has not been trained, this will throw an exception.
+   *
+   * @param point Point to be predicted.
+   */
+  template<typename VecType>
+  double Predict(const VecType& point) const;
+
+  /**
+   * Predict the responses of each point in the given dataset.  If the
+   * ensemble has not been trained, this will throw an exception.
+   *
+   * @param data Dataset to be predicted.
+   * @param predictions Output predictions for each point in the dataset.
+   */
+  template<typename MatType>
+  void Predict(const MatType& data, arma::rowvec& predictions) const;
+
+  /**
+   * Classify each point in the given dataset by thresholding the transformed
+   * score at 0.5.  This is only meaningful for classification losses such as
+   * LogisticLoss.  If the ensemble has not been trained, this will throw an
+   * exception.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output class predictions for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  //! Access a tree in the ensemble.
+  const TreeType& Tree(const size_t i) const { return trees[i]; }
+  //! Modify a tree in the ensemble (be careful!).
+  TreeType& Tree(const size_t i) { return trees[i]; }
+
+  //! Get the number of trees in the ensemble.
+  size_t NumTrees() const { return trees.size(); }
+
+  //! Get the starting raw score of the ensemble.
+  double InitialScore() const { return initialScore; }
+
+  //! Get the learning rate used during training.
+  double LearningRate() const { return learningRate; }
+
+  /**
+   * Serialize the ensemble.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The boosted trees, in boosting order.
+  std::vector<TreeType> trees;
+
+  //! The constant raw score the boosting starts from.
+  double initialScore;
+  //! The shrinkage applied to each tree's contribution.
+  double learningRate;
+};
+
+} // namespace gradient_boosting
+} // namespace mlpack
+
+// Include implementation.
+#include "gradient_boosting_impl.hpp"
+
+#endif
@@ -0,0 +1,218 @@
+/**
+ * @file methods/gradient_boosting/gradient_boosting_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of gradient boosted decision trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_IMPL_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "gradient_boosting.hpp"
+
+namespace mlpack {
+namespace gradient_boosting {
+
+template<typename LossFunction>
+template<typename MatType, typename ResponsesType>
+GradientBoosting<LossFunction>::GradientBoosting(
+    const MatType& dataset,
+    const ResponsesType& responses,
+    const size_t numTrees,
+    const double learningRate,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth)
+{
+  // Pass off work to the Train() method.
+  Train(dataset, responses, numTrees, learningRate, minimumLeafSize,
+      minimumGainSplit, maximumDepth);
+}
+
+template<typename LossFunction>
+template<typename MatType, typename ResponsesType>
+double GradientBoosting<LossFunction>::Train(
+    const MatType& data,
+    const ResponsesType& responses,
+    const size_t numTrees,
+    const double learningRate,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth)
+{
+  util::CheckSameSizes(data, responses, "GradientBoosting::Train()");
+
+  trees.clear();
+  trees.reserve(numTrees);
+  this->learningRate = learningRate;
+
+  // The boosting starts from the constant score that minimizes the loss, and
+  // each round fits a tree to the Newton step of the loss at the current
+  // scores: the targets are -gradient / hessian and the hessians act as
+  // instance weights, so the tree's leaf values come out as
+  // -sum(gradients) / sum(hessians)---the exact second-order leaf weights.
+  initialScore = LossFunction::InitialScore(responses);
+
+  arma::rowvec scores(data.n_cols);
+  scores.fill(initialScore);
+
+  arma::rowvec gradients, hessians, targets, treePredictions;
+  for (size_t i = 0; i < numTrees; ++i)
+  {
+    LossFunction::GradientsAndHessians(responses, scores, gradients, hessians);
+    targets = -gradients / hessians;
+
+    Timer::Start("train_tree");
+    trees.emplace_back(data, targets, hessians, minimumLeafSize,
+        minimumGainSplit, maximumDepth);
+    Timer::Stop("train_tree");
+
+    // Update the running scores with the shrunken contribution of the new
+    // tree; the predictions are reused for the next round's gradients, so no
+    // extra pass over the ensemble is ever needed during training.
+    trees.back().Predict(data, treePredictions);
+    scores += learningRate * treePredictions;
+  }
+
+  return LossFunction::Evaluate(responses, scores);
+}
+
+template<typename LossFunction>
+template<typename VecType>
+double GradientBoosting<LossFunction>::Predict(const VecType& point) const
+{
+  // Check edge case.
+  if (trees.size() == 0)
+  {
+    throw std::invalid_argument("GradientBoosting::Predict(): no ensemble "
+        "trained!");
+  }
+
+  double score = initialScore;
+  for (size_t i = 0; i < trees.size(); ++i)
+    score += learningRate * trees[i].Predict(point);
+
+  return LossFunction::Transform(score);
+}
+
+template<typename LossFunction>
+template<typename MatType>
+void GradientBoosting<LossFunction>::Predict(const MatType& data,
+                                             arma::rowvec& predictions) const
+{
+  // Check edge case.
+  if (trees.size() == 0)
+  {
+    predictions.clear();
+
+    throw std::invalid_argument("GradientBoosting::Predict(): no ensemble "
+        "trained!");
+  }
+
+  predictions.set_size(data.n_cols);
+  predictions.fill(initialScore);
+
+  // Process the points in blocks, as in RandomForestRegressor::Predict():
+  // each block is pushed through every tree with the batch
+  // DecisionTreeRegressor::Predict(), which keeps a tree's nodes hot in cache
+  // for a whole block of points rather than re-walking the entire ensemble
+  // for every point.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t firstId = block * blockSize;
+    const size_t lastId = std::min(firstId + blockSize, (size_t) data.n_cols)
+        - 1;
+
+    arma::rowvec treePredictions;
+    for (size_t t = 0; t < trees.size(); ++t)
+    {
+      trees[t].Predict(data.cols(firstId, lastId), treePredictions);
+      predictions.subvec(firstId, lastId) += learningRate * treePredictions;
+    }
+
+    for (size_t j = firstId; j <= lastId; ++j)
+      predictions[j] = LossFunction::Transform(predictions[j]);
+  }
+}
+
+template<typename LossFunction>
+template<typename MatType>
+void GradientBoosting<LossFunction>::Classify(
+    const MatType& data,
+    arma::Row<size_t>& predictions) const
+{
+  arma::rowvec transformedScores;
+  Predict(data, transformedScores);
+
+  predictions.set_size(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    predictions[i] = (transformedScores[i] > 0.5) ? 1 : 0;
+}
+
+template<typename LossFunction>
+template<typename Archive>
+void GradientBoosting<LossFunction>::serialize(Archive& ar,
+                                               const uint32_t /* version */)
+{
+  size_t numTrees;
+  if (cereal::is_loading<Archive>())
+    trees.clear();
+  else
+    numTrees = trees.size();
+
+  ar(CEREAL_NVP(numTrees));
+
+  // As in RandomForestRegressor::serialize(), the trees dominate the size of
+  // the model, so each one is stored as its own compressed blob; the
+  // independent blobs let packing and unpacking parallelize over the trees.
+  std::vector<data::CompressedBlob<TreeType>> compressedTrees(numTrees);
+  if (!cereal::is_loading<Archive>())
+  {
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) numTrees; ++i)
+      compressedTrees[i].Pack(trees[i]);
+  }
+
+  ar(CEREAL_NVP(compressedTrees));
+
+  if (cereal::is_loading<Archive>())
+  {
+    trees.resize(numTrees);
+    // An exception must not escape the parallel region, so remember failures
+    // and rethrow afterwards.
+    bool failed = false;
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) numTrees; ++i)
+    {
+      try
+      {
+        compressedTrees[i].Unpack(trees[i]);
+      }
+      catch (cereal::Exception&)
+      {
+        failed = true;
+      }
+    }
+
+    if (failed)
+      throw cereal::Exception("GradientBoosting::serialize(): cannot unpack "
+          "compressed trees; corrupt model file?");
+  }
+
+  ar(CEREAL_NVP(initialScore));
+  ar(CEREAL_NVP(learningRate));
+}
+
+} // namespace gradient_boosting
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,234 @@
+/**
+ * @file methods/gradient_boosting/gradient_boosting_main.cpp
+ * @author Ryan Curtin
+ *
+ * A program to build and evaluate gradient boosted tree ensembles for
+ * regression.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/io.hpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+
+#include "gradient_boosting.hpp"
+
+using namespace mlpack;
+using namespace mlpack::gradient_boosting;
+using namespace mlpack::util;
+using namespace arma;
+using namespace std;
+
+// Program Name.
+BINDING_NAME("Gradient Boosted Trees");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "An implementation of gradient boosted decision trees for regression.  "
+    "Given a dataset and responses, an ensemble of shallow regression trees "
+    "can be trained and saved for later use, or a pre-trained ensemble can be "
+    "used to output regression predictions for a test set.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "This program trains a gradient boosted ensemble of regression trees on "
+    "the given training points and responses, and can save the trained "
+    "ensemble to a model file or predict the responses of a given test set.  "
+    "Each tree is fit to the second-order (Newton) step of the squared error "
+    "loss at the ensemble's current predictions and added with the shrinkage "
+    "factor given by " + PRINT_PARAM_STRING("learning_rate") + ".  The trees "
+    "use histogram-based splits, so training time is linear in the number of "
+    "points."
+    "\n\n"
+    "The training set and associated responses are specified with the " +
+    PRINT_PARAM_STRING("training") + " and " +
+    PRINT_PARAM_STRING("training_responses") + " parameters, respectively.  "
+    "The " + PRINT_PARAM_STRING("num_trees") + " parameter controls the "
+    "number of boosting rounds, and " + PRINT_PARAM_STRING("learning_rate") +
+    " the contribution of each tree; smaller learning rates generally need "
+    "more trees but generalize better.  The " +
+    PRINT_PARAM_STRING("minimum_leaf_size") + ", " +
+    PRINT_PARAM_STRING("minimum_gain_split") + " and " +
+    PRINT_PARAM_STRING("maximum_depth") + " parameters control the size of "
+    "the individual trees, exactly as for the decision_tree program."
+    "\n\n"
+    "A trained ensemble may be saved with the " +
+    PRINT_PARAM_STRING("output_model") + " output parameter, and loaded for "
+    "later prediction with the " + PRINT_PARAM_STRING("input_model") +
+    " parameter.  Predictions for the points in the matrix given by the " +
+    PRINT_PARAM_STRING("test") + " parameter may be saved with the " +
+    PRINT_PARAM_STRING("predictions") + " output parameter.");
+
+// Example.
+BINDING_EXAMPLE(
+    "For example, to train a gradient boosted ensemble of 200 trees with a "
+    "learning rate of 0.05 on the dataset " + PRINT_DATASET("X") + " with "
+    "responses " + PRINT_DATASET("y") + ", saving the trained ensemble to " +
+    PRINT_MODEL("gb_model") + ", the following command could be used:"
+    "\n\n" +
+    PRINT_CALL("gradient_boosting", "training", "X", "training_responses", "y",
+        "num_trees", 200, "learning_rate", 0.05, "output_model", "gb_model") +
+    "\n\n"
+    "Then, to use " + PRINT_MODEL("gb_model") + " to predict responses for a "
+    "test set " + PRINT_DATASET("X_test") + ", saving the predictions to " +
+    PRINT_DATASET("y_test") + ", the following command could be used:"
+    "\n\n" +
+    PRINT_CALL("gradient_boosting", "input_model", "gb_model", "test", "X_test",
+        "predictions", "y_test"));
+
+// See also...
+BINDING_SEE_ALSO("@decision_tree", "#decision_tree");
+BINDING_SEE_ALSO("@random_forest", "#random_forest");
+BINDING_SEE_ALSO("Gradient boosting on Wikipedia",
+        "https://en.wikipedia.org/wiki/Gradient_boosting");
+BINDING_SEE_ALSO("mlpack::gradient_boosting::GradientBoosting C++ class "
+        "documentation",
+        "@doxygen/classmlpack_1_1gradient__boosting_1_1GradientBoosting.html");
+
+PARAM_MATRIX_IN("training", "Training dataset.", "t");
+PARAM_ROW_IN("training_responses", "Responses for the training dataset.  If "
+    "not given, the responses are assumed to be the last row of the training "
+    "matrix.", "r");
+
+PARAM_MATRIX_IN("test", "Test dataset to produce predictions for.", "T");
+PARAM_ROW_OUT("predictions", "Predicted responses for each point in the test "
+    "set.", "p");
+
+PARAM_INT_IN("num_trees", "Number of trees in the ensemble (boosting "
+    "rounds).", "N", 100);
+PARAM_DOUBLE_IN("learning_rate", "Shrinkage applied to each tree's "
+    "contribution.", "e", 0.1);
+PARAM_INT_IN("minimum_leaf_size", "Minimum number of points in each leaf "
+    "node.", "n", 10);
+PARAM_DOUBLE_IN("minimum_gain_split", "Minimum gain needed to make a split "
+    "when building a tree.", "g", 1e-7);
+PARAM_INT_IN("maximum_depth", "Maximum depth of each tree (0 means no "
+    "limit).", "D", 6);
+
+/**
+ * This is the class that we will serialize.  It is a pretty simple wrapper
+ * around GradientBoosting<>.
+ */
+class GradientBoostingModel
+{
+ public:
+  // The ensemble itself, left public for direct access by this program.
+  GradientBoosting<> gb;
+
+  // Create the model.
+  GradientBoostingModel() { /* Nothing to do. */ }
+
+  // Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(gb));
+  }
+};
+
+PARAM_MODEL_IN(GradientBoostingModel, "input_model", "Pre-trained gradient "
+    "boosting model to use for prediction.", "m");
+PARAM_MODEL_OUT(GradientBoostingModel, "output_model", "Model to save trained "
+    "gradient boosting ensemble to.", "M");
+
+static void mlpackMain()
+{
+  // Check for incompatible input parameters.
+  RequireOnlyOnePassed({ "training", "input_model" }, true);
+
+  RequireAtLeastOnePassed({ "output_model", "predictions" }, false,
+      "no output will be saved");
+
+  ReportIgnoredParam({{ "test", false }}, "predictions");
+  if (!IO::HasParam("training"))
+  {
+    ReportIgnoredParam({{ "training", false }}, "num_trees");
+    ReportIgnoredParam({{ "training", false }}, "learning_rate");
+    ReportIgnoredParam({{ "training", false }}, "minimum_leaf_size");
+    ReportIgnoredParam({{ "training", false }}, "minimum_gain_split");
+    ReportIgnoredParam({{ "training", false }}, "maximum_depth");
+  }
+
+  RequireParamValue<int>("num_trees", [](int x) { return x > 0; }, true,
+      "number of trees must be positive");
+  RequireParamValue<double>("learning_rate", [](double x) { return x > 0.0; },
+      true, "learning rate must be positive");
+  RequireParamValue<int>("minimum_leaf_size", [](int x) { return x > 0; },
+      true, "minimum leaf size must be positive");
+  RequireParamValue<double>("minimum_gain_split",
+      [](double x) { return x >= 0.0; }, true,
+      "minimum gain for splitting must be nonnegative");
+  RequireParamValue<int>("maximum_depth", [](int x) { return x >= 0; }, true,
+      "maximum depth must not be negative");
+
+  GradientBoostingModel* model;
+  if (IO::HasParam("training"))
+  {
+    model = new GradientBoostingModel();
+
+    mat dataset = std::move(IO::GetParam<mat>("training"));
+
+    rowvec responses;
+    if (IO::HasParam("training_responses"))
+    {
+      responses = IO::GetParam<rowvec>("training_responses");
+
+      if (responses.n_cols != dataset.n_cols)
+      {
+        delete model;
+        Log::Fatal << "The responses must have the same number of columns as "
+            "the training set." << endl;
+      }
+    }
+    else
+    {
+      // The responses are the last row of the training matrix.
+      if (dataset.n_rows < 2)
+      {
+        delete model;
+        Log::Fatal << "Can't get responses from training data since it has "
+            "less than 2 rows." << endl;
+      }
+      responses = dataset.row(dataset.n_rows - 1);
+      dataset.shed_row(dataset.n_rows - 1);
+    }
+
+    const size_t numTrees = (size_t) IO::GetParam<int>("num_trees");
+    const double learningRate = IO::GetParam<double>("learning_rate");
+    const size_t minimumLeafSize =
+        (size_t) IO::GetParam<int>("minimum_leaf_size");
+    const double minimumGainSplit = IO::GetParam<double>("minimum_gain_split");
+    const size_t maximumDepth = (size_t) IO::GetParam<int>("maximum_depth");
+
+    Timer::Start("gb_training");
+    const double loss = model->gb.Train(dataset, responses, numTrees,
+        learningRate, minimumLeafSize, minimumGainSplit, maximumDepth);
+    Timer::Stop("gb_training");
+
+    Log::Info << "Average training loss: " << loss << "." << endl;
+  }
+  else
+  {
+    // A model file was passed in, so load it.
+    model = IO::GetParam<GradientBoostingModel*>("input_model");
+  }
+
+  // Did we want to predict, too?
+  if (IO::HasParam("test"))
+  {
+    mat testPoints = std::move(IO::GetParam<mat>("test"));
+
+    rowvec predictions;
+    Timer::Start("gb_prediction");
+    model->gb.Predict(testPoints, predictions);
+    Timer::Stop("gb_prediction");
+
+    IO::GetParam<rowvec>("predictions") = std::move(predictions);
+  }
+
+  // Save the model if needed.
+  IO::GetParam<GradientBoostingModel*>("output_model") = model;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file methods/gradient_boosting/logistic_loss.hpp
+ * @author Ryan Curtin
+ *
+ * The LogisticLoss class, a loss function (LossFunction) for gradient
+ * boosting on binary classification problems.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_LOGISTIC_LOSS_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_LOGISTIC_LOSS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace gradient_boosting {
+
+/**
+ * The logistic (binomial deviance) loss, usable as a loss function
+ * (LossFunction) for gradient boosting on binary classification problems.
+ * Responses are expected to be 0 or 1; raw scores are log-odds, and
+ * Transform() maps them to probabilities of class 1.
+ */
+class LogisticLoss
+{
+ public:
+  /**
+   * Return the constant score that minimizes the loss over the given
+   * responses; this is the log-odds of the base rate, and is used as the
+   * starting prediction of the ensemble.
+   *
+   * @param responses Responses of the training points (0 or 1).
+   */
+  template<typename ResponsesType>
+  static double InitialScore(const ResponsesType& responses)
+  {
+    // Clamp the base rate away from 0 and 1, so that the log-odds stay
+    // finite when only one class is present.
+    const double rate = std::min(std::max(arma::mean(responses), 1e-10),
+        1.0 - 1e-10);
+    return std::log(rate / (1.0 - rate));
+  }
+
+  /**
+   * Compute the first and second derivatives of the loss with respect to the
+   * raw scores, for each point.
+   *
+   * @param responses Responses of the training points (0 or 1).
+   * @param scores Current raw scores (log-odds) of the ensemble.
+   * @param gradients This will be filled with the per-point gradients.
+   * @param hessians This will be filled with the per-point second derivatives.
+   */
+  template<typename ResponsesType>
+  static void GradientsAndHessians(const ResponsesType& responses,
+                                   const arma::rowvec& scores,
+                                   arma::rowvec& gradients,
+                                   arma::rowvec& hessians)
+  {
+    gradients.set_size(responses.n_elem);
+    hessians.set_size(responses.n_elem);
+    for (size_t i = 0; i < responses.n_elem; ++i)
+    {
+      const double p = Transform(scores[i]);
+      gradients[i] = p - responses[i];
+      // Keep the Hessian away from zero, so that the Newton targets the trees
+      // are fit to stay finite for points the model is already sure about.
+      hessians[i] = std::max(p * (1.0 - p), 1e-16);
+    }
+  }
+
+  /**
+   * Transform a raw score (log-odds) into a probability of class 1.
+   *
+   * @param score Raw score to transform.
+   */
+  static double Transform(const double score)
+  {
+    return 1.0 / (1.0 + std::exp(-score));
+  }
+
+  /**
+   * Evaluate the average loss (negative log-likelihood) of the given raw
+   * scores against the given responses.
+   *
+   * @param responses Responses of the points (0 or 1).
+   * @param scores Raw scores of the ensemble.
+   */
+  template<typename ResponsesType>
+  static double Evaluate(const ResponsesType& responses,
+                         const arma::rowvec& scores)
+  {
+    if (responses.n_elem == 0)
+      return 0.0;
+
+    double loss = 0.0;
+    for (size_t i = 0; i < responses.n_elem; ++i)
+    {
+      const double p = std::min(std::max(Transform(scores[i]), 1e-10),
+          1.0 - 1e-10);
+      loss -= responses[i] * std::log(p) +
+          (1.0 - responses[i]) * std::log(1.0 - p);
+    }
+
+    return loss / responses.n_elem;
+  }
+};
+
+} // namespace gradient_boosting
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @file methods/gradient_boosting/squared_error_loss.hpp
+ * @author Ryan Curtin
+ *
+ * The SquaredErrorLoss class, a loss function (LossFunction) for gradient
+ * boosting on regression problems.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_SQUARED_ERROR_LOSS_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_SQUARED_ERROR_LOSS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace gradient_boosting {
+
+/**
+ * The squared error loss, usable as a loss function (LossFunction) for
+ * gradient boosting on regression problems.  Its gradient with respect to a
+ * raw score is the residual and its second derivative is constant, so Newton
+ * boosting under this loss reduces to fitting each tree to the plain
+ * residuals.
+ */
+class SquaredErrorLoss
+{
+ public:
+  /**
+   * Return the constant score that minimizes the loss over the given
+   * responses; this is used as the starting prediction of the ensemble.
+   *
+   * @param responses Responses of the training points.
+   */
+  template<typename ResponsesType>
+  static double InitialScore(const ResponsesType& responses)
+  {
+    return arma::mean(responses);
+  }
+
+  /**
+   * Compute the first and second derivatives of the loss with respect to the
+   * raw scores, for each point.
+   *
+   * @param responses Responses of the training points.
+   * @param scores Current raw scores of the ensemble.
+   * @param gradients This will be filled with the per-point gradients.
+   * @param hessians This will be filled with the per-point second derivatives.
+   */
+  template<typename ResponsesType>
+  static void GradientsAndHessians(const ResponsesType& responses,
+                                   const arma::rowvec& scores,
+                                   arma::rowvec& gradients,
+                                   arma::rowvec& hessians)
+  {
+    gradients = scores - responses;
+    hessians.ones(responses.n_elem);
+  }
+
+  /**
+   * Transform a raw score into a prediction.  For the squared error loss the
+   * raw score already is the prediction.
+   *
+   * @param score Raw score to transform.
+   */
+  static double Transform(const double score) { return score; }
+
+  /**
+   * Evaluate the average loss of the given raw scores against the given
+   * responses.
+   *
+   * @param responses Responses of the points.
+   * @param scores Raw scores of the ensemble.
+   */
+  template<typename ResponsesType>
+  static double Evaluate(const ResponsesType& responses,
+                         const arma::rowvec& scores)
+  {
+    if (responses.n_elem == 0)
+      return 0.0;
+
+    double loss = 0.0;
+    for (size_t i = 0; i < responses.n_elem; ++i)
+      loss += std::pow(scores[i] - responses[i], 2.0);
+
+    return loss / responses.n_elem;
+  }
+};
+
+} // namespace gradient_boosting
+} // namespace mlpack
+
+#endif
@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/dists/discrete_distribution.hpp>
+#include <mlpack/core/util/progress_token.hpp>
 
 namespace mlpack {
 namespace hmm /** Hidden Markov Models. */ {
@@ -164,9 +165,12 @@ class HMM
    * for training.
    *
    * @param dataSeq Vector of observation sequences.
+   * @param progress If non-NULL, a token that is reported to after each
+   *      Baum-Welch iteration and that can cancel the training cooperatively.
    * @return Log-likelihood of state sequence.
    */
-  double Train(const std::vector<arma::mat>& dataSeq);
+  double Train(const std::vector<arma::mat>& dataSeq,
+               util::ProgressToken* progress = NULL);
 
   /**
    * Train the model using the given labeled observations; the transition and
@@ -493,6 +497,41 @@ class HMM
                 arma::mat& backwardLogProb,
                 arma::mat& logProbs) const;
 
+  /**
+   * Refit the given emission distribution to the weighted observations.  This
+   * overload is selected when the distribution's Train() accepts a trial
+   * count and a flag to reuse the existing model (as GMM's does); when
+   * warmStart is true the refit then starts from the distribution's current
+   * parameters.  During Baum-Welch the conditional probabilities change
+   * little between iterations, so warm-started refits skip the initial
+   * clustering and converge in far fewer EM steps than fitting from scratch.
+   *
+   * @param dist Emission distribution to refit.
+   * @param observations All observations, one column per time step.
+   * @param probabilities Probability of each observation belonging to dist.
+   * @param warmStart If true, refit starting from the current parameters.
+   */
+  template<typename Dist>
+  static auto TrainEmission(const int /* dispatchToWarmStart */,
+                            Dist& dist,
+                            const arma::mat& observations,
+                            const arma::vec& probabilities,
+                            const bool warmStart)
+      -> decltype(void(dist.Train(observations, probabilities, size_t(1),
+          true)));
+
+  /**
+   * Refit the given emission distribution to the weighted observations.  This
+   * overload is the fallback for distributions whose Train() cannot reuse the
+   * existing model; it always fits from scratch.
+   */
+  template<typename Dist>
+  static void TrainEmission(const long /* dispatchToWarmStart */,
+                            Dist& dist,
+                            const arma::mat& observations,
+                            const arma::vec& probabilities,
+                            const bool warmStart);
+
   //! Set of emission probability distributions; one for each state.
   std::vector<Distribution> emission;
 
@@ -505,6 +544,10 @@ class HMM
   //! Transition probability matrix. No need to be mutable in mlpack 4.0.
   mutable arma::mat logTransition;
 
+  //! Transpose of logTransition, kept in sync by ConvertToLogSpace() so that
+  //! the forward recursion can reduce over contiguous columns.
+  mutable arma::mat logTransitionT;
+
  private:
   /**
    * Make sure the variables in log space are in sync
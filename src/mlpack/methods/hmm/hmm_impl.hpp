@@ -43,6 +43,7 @@ HMM<Distribution>::HMM(const size_t states,
     transitionProxy.col(i) /= arma::accu(transitionProxy.col(i));
 
   logTransition = log(transitionProxy);
+  logTransitionT = logTransition.t();
   logInitial = log(initialProxy);
 }
 
@@ -58,6 +59,7 @@ HMM<Distribution>::HMM(const arma::vec& initial,
     emission(emission),
     transitionProxy(transition),
     logTransition(log(transition)),
+    logTransitionT(logTransition.t()),
     initialProxy(initial),
     logInitial(log(initial)),
     tolerance(tolerance),
@@ -92,7 +94,8 @@ HMM<Distribution>::HMM(const arma::vec& initial,
  * @param dataSeq Set of data sequences to train on.
  */
 template<typename Distribution>
-double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
+double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq,
+                                util::ProgressToken* progress)
 {
   // We should allow a guess at the transition and emission matrices.
   double loglik = 0;
@@ -119,6 +122,16 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
       arma::vec(totalLength));
   arma::mat emissionList(dimensionality, totalLength);
 
+  // Compute where each sequence's observations start in the emission list, so
+  // that sequences processed concurrently write to disjoint column ranges.
+  std::vector<size_t> seqOffsets(dataSeq.size());
+  size_t offset = 0;
+  for (size_t seq = 0; seq < dataSeq.size(); seq++)
+  {
+    seqOffsets[seq] = offset;
+    offset += dataSeq[seq].n_cols;
+  }
+
   // This should be the Baum-Welch algorithm (EM for HMM estimation). This
   // follows the procedure outlined in Elliot, Aggoun, and Moore's book "Hidden
   // Markov Models: Estimation and Control", pp. 36-40.
@@ -133,70 +146,99 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
     // Reset log likelihood.
     loglik = 0;
 
-    // Sum over time.
-    size_t sumTime = 0;
-
-    // Loop over each sequence.
-    for (size_t seq = 0; seq < dataSeq.size(); seq++)
+    // Loop over each sequence.  Given the current parameters, the
+    // forward-backward pass of each sequence is independent of all the others,
+    // so the sequences are dispatched across threads.  Each thread accumulates
+    // into its own copy of the initial/transition statistics, which are merged
+    // at the end; the emission list columns for each sequence are disjoint and
+    // need no synchronization.
+    #pragma omp parallel reduction(+:loglik)
     {
+      arma::vec threadLogInitial(logTransition.n_rows);
+      threadLogInitial.fill(-std::numeric_limits<double>::infinity());
+      arma::mat threadLogTransition(logTransition.n_rows,
+                                    logTransition.n_cols);
+      threadLogTransition.fill(-std::numeric_limits<double>::infinity());
+
+      // Workspace reused across the sequences a thread processes; when the
+      // sequences have the same length this avoids repeated matrix
+      // allocations inside Forward() and Backward().
       arma::mat stateLogProb;
       arma::mat forwardLog;
       arma::mat backwardLog;
       arma::vec logScales;
+      arma::mat logProbs;
 
-      // Add the log-likelihood of this sequence.  This is the E-step.
-      loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
-          backwardLog, logScales);
-
-      // Add to estimate of initial probability for state j.
-      math::LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
-          newLogInitial);
-
-      // Define a variable to store the value of log-probability for data.
-      arma::mat logProbs(dataSeq[seq].n_cols, logTransition.n_rows);
-      // Save the values of log-probability to logProbs.
-      for (size_t i = 0; i < logTransition.n_rows; i++)
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t seq = 0; seq < (omp_size_t) dataSeq.size(); seq++)
       {
-        // Define alias of desired column.
-        arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-        // Use advanced constructor for using logProbs directly.
-        emission[i].LogProbability(dataSeq[seq], alias);
-      }
+        // Add the log-likelihood of this sequence.  This is the E-step.
+        loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
+            backwardLog, logScales);
 
-      // Now re-estimate the parameters.  This is the M-step.
-      //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
-      //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t]) b(i,
-      //           t + 1)))
-      //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t) b(i, t)
-      // We store the new estimates in a different matrix.
-      for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
-      {
-        // Assemble temporary vector that's used in log-sum computation.
-        if (t < dataSeq[seq].n_cols - 1)
+        // Add to estimate of initial probability for state j.
+        math::LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
+            threadLogInitial);
+
+        // Save the values of log-probability to logProbs.
+        logProbs.set_size(dataSeq[seq].n_cols, logTransition.n_rows);
+        for (size_t i = 0; i < logTransition.n_rows; i++)
         {
-          // This term is the same across all states, so compute it once and
-          // cache it.
-          const arma::vec tmp = backwardLog.col(t + 1) +
-              logProbs.row(t + 1).t() - logScales[t + 1];
-          arma::vec output;
-          math::LogSumExp(tmp, output);
+          // Define alias of desired column.
+          arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+          // Use advanced constructor for using logProbs directly.
+          emission[i].LogProbability(dataSeq[seq], alias);
+        }
 
-          for (size_t j = 0; j < logTransition.n_cols; ++j)
+        // Now re-estimate the parameters.  This is the M-step.
+        //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
+        //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t])
+        //           b(i, t + 1)))
+        //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t)
+        //           b(i, t)
+        // We store the new estimates in a different matrix.
+        size_t sumTime = seqOffsets[seq];
+        for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+        {
+          // Assemble temporary vector that's used in log-sum computation.
+          if (t < dataSeq[seq].n_cols - 1)
           {
-            // Compute the estimate of T_ij (probability of transition from
-            // state j to state i).  We postpone multiplication of the old T_ij
-            // until later.
-            arma::vec tmp2 = output + forwardLog(j, t);
-            arma::vec alias = newLogTransition.unsafe_col(j);
-            math::LogSumExp<arma::vec, true>(tmp2, alias);
+            // This term is the same across all states, so compute it once and
+            // cache it.
+            const arma::vec tmp = backwardLog.col(t + 1) +
+                logProbs.row(t + 1).t() - logScales[t + 1];
+            arma::vec output;
+            math::LogSumExp(tmp, output);
+
+            for (size_t j = 0; j < logTransition.n_cols; ++j)
+            {
+              // Compute the estimate of T_ij (probability of transition from
+              // state j to state i).  We postpone multiplication of the old
+              // T_ij until later.
+              arma::vec tmp2 = output + forwardLog(j, t);
+              arma::vec alias = threadLogTransition.unsafe_col(j);
+              math::LogSumExp<arma::vec, true>(tmp2, alias);
+            }
           }
+
+          // Add to list of emission observations, for Distribution::Train().
+          for (size_t j = 0; j < logTransition.n_cols; ++j)
+            emissionProb[j][sumTime] = exp(stateLogProb(j, t));
+          emissionList.col(sumTime) = dataSeq[seq].col(t);
+          sumTime++;
         }
+      }
 
-        // Add to list of emission observations, for Distribution::Train().
-        for (size_t j = 0; j < logTransition.n_cols; ++j)
-          emissionProb[j][sumTime] = exp(stateLogProb(j, t));
-        emissionList.col(sumTime) = dataSeq[seq].col(t);
-        sumTime++;
+      // Merge this thread's accumulators into the shared estimates with
+      // element-wise log-addition.
+      #pragma omp critical
+      {
+        for (size_t i = 0; i < newLogInitial.n_elem; ++i)
+          newLogInitial[i] = math::LogAdd(newLogInitial[i],
+              threadLogInitial[i]);
+        for (size_t i = 0; i < newLogTransition.n_elem; ++i)
+          newLogTransition[i] = math::LogAdd(newLogTransition[i],
+              threadLogTransition[i]);
       }
     }
 
@@ -206,6 +248,15 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
       break;
     }
 
+    // Report progress and check for cooperative cancellation; on
+    // cancellation, the parameters of the last completed iteration are kept.
+    if (progress && !progress->Report(iter, loglik))
+    {
+      Log::Info << "HMM::Train(): cancelled after " << iter << " iterations."
+          << std::endl;
+      break;
+    }
+
     oldLoglik = loglik;
 
     // Normalize the new initial probabilities.
@@ -232,9 +283,15 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
 
     initialProxy = exp(logInitial);
     transitionProxy = exp(logTransition);
-    // Now estimate emission probabilities.
+    logTransitionT = logTransition.t();
+    // Now estimate emission probabilities.  After the first iteration the
+    // refits are warm-started from the previous parameters, for distributions
+    // whose Train() supports that (see TrainEmission()); the first iteration
+    // fits from scratch so that states whose distributions started out
+    // identical are differentiated by their initial clusterings.
     for (size_t state = 0; state < logTransition.n_cols; state++)
-      emission[state].Train(emissionList, emissionProb[state]);
+      TrainEmission(0, emission[state], emissionList, emissionProb[state],
+          iter > 0);
 
     Log::Debug << "Iteration " << iter << ": log-likelihood " << loglik
         << "." << std::endl;
@@ -316,6 +373,7 @@ void HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq,
   initialProxy = initial;
   transitionProxy = transition;
   logTransition = log(transition);
+  logTransitionT = logTransition.t();
   logInitial = log(initial);
 
   // Estimate emission matrix.
@@ -747,12 +805,17 @@ arma::vec HMM<Distribution>::ForwardAtTn(const arma::vec& emissionLogProb,
 
   // The forward probability of state j at time t is the sum over all states of
   // the probability of the previous state transitioning to the current state
-  // and emitting the given observation.  To do this computation in log-space,
-  // we can use LogSumExp().
-  arma::vec forwardLogProb;
-  arma::mat tmp = logTransition + repmat(prevForwardLogProb.t(),
-      logTransition.n_rows, 1);
-  math::LogSumExp(tmp, forwardLogProb);
+  // and emitting the given observation.  Each state's sum is an AccuLog()
+  // reduction over a contiguous column of the transposed transition matrix;
+  // this avoids materializing the N x N repmat() temporary that a
+  // LogSumExp() formulation would create at every time step.
+  arma::vec forwardLogProb(logTransition.n_rows);
+  arma::vec work(logTransition.n_rows);
+  for (size_t j = 0; j < logTransition.n_rows; ++j)
+  {
+    work = logTransitionT.unsafe_col(j) + prevForwardLogProb;
+    forwardLogProb[j] = math::AccuLog(work);
+  }
   forwardLogProb += emissionLogProb;
 
   // Normalize probability.
@@ -810,18 +873,24 @@ void HMM<Distribution>::Backward(const arma::mat& dataSeq,
   backwardLogProb.col(dataSeq.n_cols - 1).fill(0);
 
   // Now step backwards through all other observations.
+  arma::vec weights(logTransition.n_rows);
+  arma::vec work(logTransition.n_rows);
   for (size_t t = dataSeq.n_cols - 2; t + 1 > 0; t--)
   {
     // The backward probability of state j at time t is the sum over all
     // states of the probability of the next state having been a transition
     // from the current state multiplied by the probability of each of those
-    // states emitting the given observation.  To compute this in log-space, we
-    // can use LogSumExpT().
-    const arma::mat tmp = logTransition +
-        repmat(backwardLogProb.col(t + 1), 1, logTransition.n_cols) +
-        repmat(logProbs.row(t + 1).t(), 1, logTransition.n_cols);
-    arma::vec alias = backwardLogProb.unsafe_col(t);
-    math::LogSumExpT<arma::mat, true>(tmp, alias);
+    // states emitting the given observation.  The per-next-state terms are
+    // combined once per time step, and each state's sum is then an AccuLog()
+    // reduction over a contiguous column of the transition matrix; this
+    // avoids the two N x N repmat() temporaries that a LogSumExpT()
+    // formulation would create at every time step.
+    weights = backwardLogProb.col(t + 1) + logProbs.row(t + 1).t();
+    for (size_t j = 0; j < logTransition.n_cols; ++j)
+    {
+      work = logTransition.unsafe_col(j) + weights;
+      backwardLogProb(j, t) = math::AccuLog(work);
+    }
 
     // Normalize by the weights from the forward algorithm.
     if (std::isfinite(logScales[t + 1]))
@@ -829,6 +898,42 @@ void HMM<Distribution>::Backward(const arma::mat& dataSeq,
   }
 }
 
+/**
+ * Refit an emission distribution, warm-starting from its current parameters
+ * when requested.  This overload is selected when Train() accepts a trial
+ * count and a flag to reuse the existing model.
+ */
+template<typename Distribution>
+template<typename Dist>
+auto HMM<Distribution>::TrainEmission(const int /* dispatchToWarmStart */,
+                                      Dist& dist,
+                                      const arma::mat& observations,
+                                      const arma::vec& probabilities,
+                                      const bool warmStart)
+    -> decltype(void(dist.Train(observations, probabilities, size_t(1),
+        true)))
+{
+  if (warmStart)
+    dist.Train(observations, probabilities, 1, true);
+  else
+    dist.Train(observations, probabilities);
+}
+
+/**
+ * Refit an emission distribution that cannot reuse its existing model; always
+ * fits from scratch.
+ */
+template<typename Distribution>
+template<typename Dist>
+void HMM<Distribution>::TrainEmission(const long /* dispatchToWarmStart */,
+                                      Dist& dist,
+                                      const arma::mat& observations,
+                                      const arma::vec& probabilities,
+                                      const bool /* warmStart */)
+{
+  dist.Train(observations, probabilities);
+}
+
 /**
  * Make sure the variables in log space are in sync with the linear
  * counterparts.
@@ -845,6 +950,9 @@ void HMM<Distribution>::ConvertToLogSpace() const
   if (recalculateTransition)
   {
     logTransition = log(transitionProxy);
+    // The forward recursion reduces over rows of logTransition; keep the
+    // transpose so those reductions run over contiguous columns.
+    logTransitionT = logTransition.t();
     recalculateTransition = false;
   }
 }
@@ -868,6 +976,7 @@ void HMM<Distribution>::load(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(emission));
 
   logTransition = log(transition);
+  logTransitionT = logTransition.t();
   logInitial = log(initial);
   initialProxy = std::move(initial);
   transitionProxy = std::move(transition);
@@ -0,0 +1,155 @@
+/**
+ * @file methods/hmm/streaming_hmm.hpp
+ * @author Ryan Curtin
+ *
+ * Online (streaming) inference for hidden Markov models: incremental
+ * filtering, fixed-lag smoothing, and bounded-lag Viterbi decoding.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HMM_STREAMING_HMM_HPP
+#define MLPACK_METHODS_HMM_STREAMING_HMM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "hmm.hpp"
+
+namespace mlpack {
+namespace hmm {
+
+/**
+ * Online inference over an unbounded observation stream for a trained HMM.
+ * Unlike HMM::Predict(), HMM::Filter(), and HMM::Smooth(), which require the
+ * whole sequence up front and allocate O(T * states) working memory, this
+ * class ingests one observation at a time with constant per-observation cost
+ * and memory bounded by the configured lag, independent of stream length.
+ *
+ * Each call to Push() advances the filter recursion; afterwards,
+ *
+ *  - FilteredOutput() gives the expected emission at the current time given
+ *    all observations so far (zero-lag filtering);
+ *  - SmoothedOutput() gives the expected emission `lag` steps in the past,
+ *    conditioned on everything seen so far (fixed-lag smoothing); and
+ *  - PredictAtLag() gives the Viterbi-decoded state `lag` steps in the past,
+ *    using a ring buffer of backpointers of depth `lag` (bounded-lag Viterbi).
+ *
+ * The smoothed and decoded outputs are only defined once at least (lag + 1)
+ * observations have been pushed.  With lag equal to the sequence length minus
+ * one, the fixed-lag results at the start of the stream coincide with the
+ * full-sequence Smooth() and Predict() results.
+ *
+ * The referenced HMM is not owned and must outlive this object; this class
+ * holds only transient decoding state and is not serializable.
+ */
+template<typename Distribution = distribution::DiscreteDistribution>
+class StreamingHMM
+{
+ public:
+  /**
+   * Create a streaming decoder for the given (trained) HMM.
+   *
+   * @param hmm HMM to decode with; must outlive this object.
+   * @param lag Number of observations of delay for SmoothedOutput() and
+   *      PredictAtLag().  Larger lags give estimates closer to full-sequence
+   *      smoothing/decoding at the cost of O(lag * states) memory and
+   *      O(lag * states^2) work per SmoothedOutput() call.
+   */
+  StreamingHMM(const HMM<Distribution>& hmm, const size_t lag = 0);
+
+  /**
+   * Ingest the next observation of the stream, updating the filter state, the
+   * Viterbi scores, and the bounded-lag buffers.
+   *
+   * @param observation Observation at the current time step.
+   * @return Log scale factor of this observation; the sum of these over the
+   *      stream is the log-likelihood of the observations so far (also
+   *      available via LogLikelihood()).
+   */
+  double Push(const arma::vec& observation);
+
+  /**
+   * Compute the expected emission at the current time step, conditioned on
+   * all observations pushed so far: E[Y_t | y_0, ..., y_t].  Only valid after
+   * at least one observation has been pushed.  This will not work for
+   * distributions without a Mean() function.
+   *
+   * @param output Vector to store the expected emission in.
+   */
+  void FilteredOutput(arma::vec& output) const;
+
+  /**
+   * Compute the expected emission `lag` steps in the past, conditioned on all
+   * observations pushed so far: E[Y_{t - lag} | y_0, ..., y_t].  Only valid
+   * once at least (lag + 1) observations have been pushed.  This will not
+   * work for distributions without a Mean() function.
+   *
+   * @param output Vector to store the expected emission in.
+   */
+  void SmoothedOutput(arma::vec& output) const;
+
+  /**
+   * Return the most probable hidden state `lag` steps in the past, decoded by
+   * backtracking through the ring buffer of Viterbi backpointers.  Only valid
+   * once at least (lag + 1) observations have been pushed.  Note that with a
+   * finite lag this is an approximation to full-sequence Viterbi decoding:
+   * the decision for time (t - lag) is made from the best path ending at the
+   * current time t.
+   */
+  size_t PredictAtLag() const;
+
+  //! Return the log-likelihood of all observations pushed so far.
+  double LogLikelihood() const { return logLikelihood; }
+
+  //! Return the number of observations pushed so far.
+  size_t StreamLength() const { return t; }
+
+  //! Return the configured lag.
+  size_t Lag() const { return lag; }
+
+  //! Reset the decoder to the beginning of a new stream.
+  void Reset();
+
+ private:
+  //! The model used for decoding (not owned).
+  const HMM<Distribution>* hmm;
+  //! Delay, in observations, of the smoothed and decoded outputs.
+  size_t lag;
+
+  //! Log of the transition matrix, cached at construction.
+  arma::mat logTransition;
+  //! Log of the initial state probabilities, cached at construction.
+  arma::vec logInitial;
+
+  //! Number of observations pushed so far.
+  size_t t;
+  //! Accumulated log-likelihood of the stream.
+  double logLikelihood;
+
+  //! Scaled forward log-probabilities at the current time (the filter state);
+  //! empty until the first observation arrives.
+  arma::vec forwardLogProb;
+  //! Viterbi path scores at the current time, normalized each step so the
+  //! values do not drift to -inf over an unbounded stream.
+  arma::vec viterbiLogProb;
+
+  //! Ring buffer of the last (lag + 1) forward probability vectors; column
+  //! (k mod (lag + 1)) holds the filter state at time k.
+  arma::mat forwardLogProbWindow;
+  //! Ring buffer of the last (lag + 1) emission log-probability vectors,
+  //! needed for the backward pass of fixed-lag smoothing.
+  arma::mat emissionLogProbWindow;
+  //! Ring buffer of Viterbi backpointers; column (k mod lag) holds the
+  //! backpointers chosen at time k.  Empty when lag is zero.
+  arma::Mat<size_t> backPointers;
+};
+
+} // namespace hmm
+} // namespace mlpack
+
+// Include implementation.
+#include "streaming_hmm_impl.hpp"
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ * @file methods/hmm/streaming_hmm_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the StreamingHMM class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HMM_STREAMING_HMM_IMPL_HPP
+#define MLPACK_METHODS_HMM_STREAMING_HMM_IMPL_HPP
+
+// Just in case...
+#include "streaming_hmm.hpp"
+#include <mlpack/core/math/log_add.hpp>
+
+namespace mlpack {
+namespace hmm {
+
+template<typename Distribution>
+StreamingHMM<Distribution>::StreamingHMM(const HMM<Distribution>& hmm,
+                                         const size_t lag) :
+    hmm(&hmm),
+    lag(lag),
+    logTransition(arma::log(hmm.Transition())),
+    logInitial(arma::log(hmm.Initial())),
+    t(0),
+    logLikelihood(0.0)
+{
+  // The windows hold one column per time step in [t - lag, t]; the
+  // backpointer ring only needs the last `lag` decisions.
+  forwardLogProbWindow.set_size(logTransition.n_rows, lag + 1);
+  emissionLogProbWindow.set_size(logTransition.n_rows, lag + 1);
+  if (lag > 0)
+    backPointers.set_size(logTransition.n_rows, lag);
+}
+
+template<typename Distribution>
+double StreamingHMM<Distribution>::Push(const arma::vec& observation)
+{
+  const size_t states = logTransition.n_rows;
+  const size_t curT = t; // 0-based time index of this observation.
+
+  // Emission log-probability of the observation under each state; this is
+  // needed both for the filter update and for the smoothing window.
+  arma::vec emissionLogProb(states);
+  for (size_t state = 0; state < states; ++state)
+    emissionLogProb(state) = hmm->Emission()[state].LogProbability(observation);
+
+  // Advance the (scaled) forward recursion.  An empty forwardLogProb tells
+  // the HMM that this is the start of the sequence.
+  const double curLogScale = hmm->EmissionLogScaleFactor(emissionLogProb,
+      forwardLogProb);
+  logLikelihood = (curT == 0) ? curLogScale : logLikelihood + curLogScale;
+
+  // Store the filter state and emission probabilities in the ring buffers.
+  forwardLogProbWindow.col(curT % (lag + 1)) = forwardLogProb;
+  emissionLogProbWindow.col(curT % (lag + 1)) = emissionLogProb;
+
+  // Advance the Viterbi recursion.
+  if (curT == 0)
+  {
+    viterbiLogProb = logInitial + emissionLogProb;
+  }
+  else
+  {
+    arma::vec newViterbiLogProb(states);
+    arma::uword index;
+    for (size_t j = 0; j < states; ++j)
+    {
+      // As in HMM::Predict(): the best path into state j goes through the
+      // predecessor with the highest score.
+      arma::vec prob = viterbiLogProb + logTransition.row(j).t();
+      newViterbiLogProb(j) = prob.max(index) + emissionLogProb(j);
+      if (lag > 0)
+        backPointers(j, curT % lag) = index;
+    }
+
+    // Normalize so the scores do not drift to -inf over an unbounded stream;
+    // subtracting a constant does not change any argmax.
+    viterbiLogProb = newViterbiLogProb - newViterbiLogProb.max();
+  }
+
+  ++t;
+  return curLogScale;
+}
+
+template<typename Distribution>
+void StreamingHMM<Distribution>::FilteredOutput(arma::vec& output) const
+{
+  if (t == 0)
+  {
+    Log::Fatal << "StreamingHMM::FilteredOutput(): no observations have been "
+        << "pushed yet!" << std::endl;
+  }
+
+  // Compute the expected emission under the filtered state distribution.
+  // This will not work for distributions without a Mean() function.
+  output.zeros(hmm->Dimensionality());
+  for (size_t i = 0; i < logTransition.n_rows; ++i)
+    output += hmm->Emission()[i].Mean() * std::exp(forwardLogProb(i));
+}
+
+template<typename Distribution>
+void StreamingHMM<Distribution>::SmoothedOutput(arma::vec& output) const
+{
+  if (t < lag + 1)
+  {
+    Log::Fatal << "StreamingHMM::SmoothedOutput(): need at least " << lag + 1
+        << " observations for lag " << lag << ", but only " << t << " have "
+        << "been pushed!" << std::endl;
+  }
+
+  const size_t states = logTransition.n_rows;
+  const size_t curT = t - 1;
+  const size_t smoothT = curT - lag;
+
+  // Run the backward recursion from the current time down to the smoothed
+  // time, over the buffered emission probabilities.  The backward variables
+  // are unscaled; combining them with the scaled forward variables and
+  // renormalizing below yields the correct smoothed posterior.
+  arma::vec backwardLogProb(states, arma::fill::zeros);
+  for (size_t k = curT; k > smoothT; --k)
+  {
+    const arma::vec tmp = emissionLogProbWindow.col(k % (lag + 1)) +
+        backwardLogProb;
+    arma::vec newBackwardLogProb(states);
+    for (size_t i = 0; i < states; ++i)
+    {
+      const arma::vec combined = logTransition.col(i) + tmp;
+      newBackwardLogProb(i) = math::AccuLog(combined);
+    }
+    backwardLogProb = newBackwardLogProb;
+  }
+
+  arma::vec stateLogProb = forwardLogProbWindow.col(smoothT % (lag + 1)) +
+      backwardLogProb;
+  stateLogProb -= math::AccuLog(stateLogProb);
+
+  // Compute the expected emission under the smoothed state distribution.
+  // This will not work for distributions without a Mean() function.
+  output.zeros(hmm->Dimensionality());
+  for (size_t i = 0; i < states; ++i)
+    output += hmm->Emission()[i].Mean() * std::exp(stateLogProb(i));
+}
+
+template<typename Distribution>
+size_t StreamingHMM<Distribution>::PredictAtLag() const
+{
+  if (t < lag + 1)
+  {
+    Log::Fatal << "StreamingHMM::PredictAtLag(): need at least " << lag + 1
+        << " observations for lag " << lag << ", but only " << t << " have "
+        << "been pushed!" << std::endl;
+  }
+
+  // Start from the best state at the current time, then follow the
+  // backpointer ring `lag` steps into the past.
+  const size_t curT = t - 1;
+  arma::uword cur;
+  viterbiLogProb.max(cur);
+  for (size_t k = curT; k > curT - lag; --k)
+    cur = backPointers(cur, k % lag);
+
+  return (size_t) cur;
+}
+
+template<typename Distribution>
+void StreamingHMM<Distribution>::Reset()
+{
+  t = 0;
+  logLikelihood = 0.0;
+  // An empty forward vector marks the start of a new sequence.
+  forwardLogProb.reset();
+  viterbiLogProb.reset();
+}
+
+} // namespace hmm
+} // namespace mlpack
+
+#endif
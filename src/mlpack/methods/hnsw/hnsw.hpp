@@ -0,0 +1,191 @@
+/**
+ * @file methods/hnsw/hnsw.hpp
+ *
+ * An implementation of Hierarchical Navigable Small World (HNSW) graphs for
+ * approximate nearest neighbor search, as described in:
+ *
+ * @code
+ * @article{malkov2018efficient,
+ *   title={Efficient and robust approximate nearest neighbor search using
+ *          hierarchical navigable small world graphs},
+ *   author={Malkov, Y.A. and Yashunin, D.A.},
+ *   journal={IEEE Transactions on Pattern Analysis and Machine Intelligence},
+ *   volume={42},
+ *   number={4},
+ *   pages={824--836},
+ *   year={2018}
+ * }
+ * @endcode
+ *
+ * HNSW builds a layered proximity graph over the reference set: every point
+ * appears in layer 0, and each higher layer contains an exponentially smaller
+ * sample of the points.  A query greedily descends through the sparse upper
+ * layers to a good starting point, then runs a beam search in layer 0.  This
+ * gives sublinear approximate search with a tunable recall/speed tradeoff,
+ * complementing the exact tree-based indexes (see NeighborSearch).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HNSW_HNSW_HPP
+#define MLPACK_METHODS_HNSW_HNSW_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The HNSW class implements an approximate k-nearest-neighbor index over a
+ * fixed reference set.  The graph is built once (at construction or with
+ * Train()) and is then searched with Search(), which follows the same output
+ * conventions as NeighborSearch and LSHSearch: one column of the neighbors
+ * and distances matrices per query point.
+ *
+ * The main tuning parameters are:
+ *  - maxNeighbors (M in the paper): the number of links kept per point and
+ *    per layer; larger values give better recall and a bigger index.
+ *  - efConstruction: the beam width used while building; larger values give
+ *    a better graph at the cost of build time.
+ *  - efSearch: the beam width used while querying; this is the runtime
+ *    recall/speed knob and may be changed between searches.
+ *
+ * @tparam MetricType The metric to use for the distance computations.
+ * @tparam MatType The type of the dataset matrix.
+ */
+template<typename MetricType = metric::EuclideanDistance,
+         typename MatType = arma::mat>
+class HNSW
+{
+ public:
+  /**
+   * Construct the HNSW index on the given reference set.
+   *
+   * @param referenceSet Set of points to index (this is copied).
+   * @param maxNeighbors Number of links per point and layer (M).
+   * @param efConstruction Beam width used during construction.
+   * @param efSearch Default beam width used during search.
+   * @param metric Instantiated metric to use.
+   */
+  HNSW(MatType referenceSet,
+       const size_t maxNeighbors = 16,
+       const size_t efConstruction = 200,
+       const size_t efSearch = 64,
+       const MetricType metric = MetricType());
+
+  /**
+   * Construct an empty HNSW index; call Train() before Search().
+   *
+   * @param maxNeighbors Number of links per point and layer (M).
+   * @param efConstruction Beam width used during construction.
+   * @param efSearch Default beam width used during search.
+   * @param metric Instantiated metric to use.
+   */
+  HNSW(const size_t maxNeighbors = 16,
+       const size_t efConstruction = 200,
+       const size_t efSearch = 64,
+       const MetricType metric = MetricType());
+
+  /**
+   * Build (or rebuild) the index on the given reference set.
+   *
+   * @param referenceSet Set of points to index (this is copied).
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * Search for the approximate k nearest neighbors of every point in the
+   * given query set.  Queries are processed in parallel when OpenMP is
+   * enabled.  The beam width used is max(k, EfSearch()).
+   *
+   * @param querySet Points to search for.
+   * @param k Number of neighbors to find.
+   * @param neighbors Matrix to store neighbor indices into (k x queries).
+   * @param distances Matrix to store neighbor distances into (k x queries).
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  //! Serialize the index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+  //! Get the reference set.
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+  //! Get the number of links kept per point and layer.
+  size_t MaxNeighbors() const { return maxNeighbors; }
+  //! Get the construction beam width.
+  size_t EfConstruction() const { return efConstruction; }
+  //! Get the search beam width.
+  size_t EfSearch() const { return efSearch; }
+  //! Modify the search beam width (this does not require a rebuild).
+  size_t& EfSearch() { return efSearch; }
+
+  //! Get the number of layers in the graph.
+  size_t NumLayers() const { return layers.size(); }
+
+ private:
+  //! One adjacency list per point; layers[l][i] holds the links of point i in
+  //! layer l.  Points that do not appear in layer l have an empty list there.
+  typedef std::vector<std::vector<size_t>> LayerGraph;
+
+  //! Insert the given point (already present in referenceSet) into the graph.
+  void InsertPoint(const size_t index);
+
+  /**
+   * Beam search in a single layer: starting from the given entry points, find
+   * the (up to) ef closest points to the query in that layer.  The results
+   * are returned sorted by increasing distance.
+   *
+   * @param query Query point.
+   * @param layer Layer to search in.
+   * @param entries Entry points (indices into the reference set).
+   * @param ef Beam width.
+   * @param visited Workspace flags; must be all-false of size n on entry and
+   *     is restored to all-false before returning.
+   */
+  template<typename VecType>
+  std::vector<std::pair<double, size_t>> SearchLayer(
+      const VecType& query,
+      const size_t layer,
+      const std::vector<size_t>& entries,
+      const size_t ef,
+      std::vector<bool>& visited) const;
+
+  //! Trim the neighbor list of the given point in the given layer to the
+  //! layer's link cap, keeping the closest links.
+  void ShrinkNeighbors(const size_t index, const size_t layer);
+
+  //! The indexed points.
+  MatType referenceSet;
+  //! The layered graph, from layer 0 (densest) upwards.
+  std::vector<LayerGraph> layers;
+  //! The entry point into the top layer.
+  size_t entryPoint;
+
+  //! Number of links per point and layer (M); layer 0 allows 2 * M.
+  size_t maxNeighbors;
+  //! Beam width used during construction.
+  size_t efConstruction;
+  //! Beam width used during search.
+  size_t efSearch;
+  //! Scale of the geometric layer distribution (1 / ln(M)).
+  double levelScale;
+
+  //! The metric used for distance computation.
+  MetricType metric;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "hnsw_impl.hpp"
+
+#endif
@@ -0,0 +1,303 @@
+/**
+ * @file methods/hnsw/hnsw_impl.hpp
+ *
+ * Implementation of the HNSW approximate nearest neighbor index.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HNSW_HNSW_IMPL_HPP
+#define MLPACK_METHODS_HNSW_HNSW_IMPL_HPP
+
+#include "hnsw.hpp"
+
+#include <mlpack/core/math/random.hpp>
+
+#include <queue>
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename MetricType, typename MatType>
+HNSW<MetricType, MatType>::HNSW(MatType referenceSet,
+                                const size_t maxNeighbors,
+                                const size_t efConstruction,
+                                const size_t efSearch,
+                                const MetricType metric) :
+    entryPoint(0),
+    maxNeighbors(maxNeighbors),
+    efConstruction(efConstruction),
+    efSearch(efSearch),
+    levelScale(1.0 / std::log((double) maxNeighbors)),
+    metric(metric)
+{
+  Train(std::move(referenceSet));
+}
+
+template<typename MetricType, typename MatType>
+HNSW<MetricType, MatType>::HNSW(const size_t maxNeighbors,
+                                const size_t efConstruction,
+                                const size_t efSearch,
+                                const MetricType metric) :
+    entryPoint(0),
+    maxNeighbors(maxNeighbors),
+    efConstruction(efConstruction),
+    efSearch(efSearch),
+    levelScale(1.0 / std::log((double) maxNeighbors)),
+    metric(metric)
+{
+  // Nothing to do; the index is empty until Train() is called.
+}
+
+template<typename MetricType, typename MatType>
+void HNSW<MetricType, MatType>::Train(MatType referenceSetIn)
+{
+  referenceSet = std::move(referenceSetIn);
+  layers.clear();
+
+  Timer::Start("hnsw_construction");
+  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+    InsertPoint(i);
+  Timer::Stop("hnsw_construction");
+}
+
+template<typename MetricType, typename MatType>
+void HNSW<MetricType, MatType>::InsertPoint(const size_t index)
+{
+  // Draw the top layer of this point from a geometric distribution.
+  const size_t level =
+      (size_t) std::floor(-std::log(1.0 - math::Random()) * levelScale);
+
+  // Make sure all layers up to `level` exist.  Any new layer gets an empty
+  // adjacency list for every point; only this point will live in it until
+  // another point draws an equally high level.
+  const size_t oldTop = layers.size();
+  const bool newTop = (level >= oldTop);
+  while (layers.size() <= level)
+    layers.push_back(LayerGraph(referenceSet.n_cols));
+
+  // The first point only establishes the entry point.
+  if (index == 0)
+  {
+    entryPoint = 0;
+    return;
+  }
+
+  std::vector<bool> visited(referenceSet.n_cols, false);
+  std::vector<size_t> entries(1, entryPoint);
+
+  // Greedily descend through the pre-existing layers above this point's top
+  // level.
+  for (size_t l = oldTop - 1; l > level; --l)
+  {
+    std::vector<std::pair<double, size_t>> best = SearchLayer(
+        referenceSet.col(index), l, entries, 1, visited);
+    if (!best.empty())
+      entries[0] = best[0].second;
+  }
+
+  // Insert into every pre-existing layer from min(level, old top) down to 0.
+  const size_t startLayer = std::min(level, oldTop - 1);
+  for (size_t l = startLayer + 1; l-- > 0; )
+  {
+    std::vector<std::pair<double, size_t>> candidates = SearchLayer(
+        referenceSet.col(index), l, entries, efConstruction, visited);
+
+    // Link to the closest maxNeighbors candidates, bidirectionally.
+    const size_t links = std::min(maxNeighbors, candidates.size());
+    for (size_t j = 0; j < links; ++j)
+    {
+      const size_t other = candidates[j].second;
+      layers[l][index].push_back(other);
+      layers[l][other].push_back(index);
+      ShrinkNeighbors(other, l);
+    }
+
+    // Continue the descent from the best candidate found in this layer.
+    if (!candidates.empty())
+      entries[0] = candidates[0].second;
+  }
+
+  // If this point exceeded the previous top layer, it is the new entry point.
+  if (newTop)
+    entryPoint = index;
+}
+
+template<typename MetricType, typename MatType>
+void HNSW<MetricType, MatType>::ShrinkNeighbors(const size_t index,
+                                                const size_t layer)
+{
+  // Layer 0 allows twice as many links as the upper layers.
+  const size_t cap = (layer == 0) ? 2 * maxNeighbors : maxNeighbors;
+  std::vector<size_t>& list = layers[layer][index];
+  if (list.size() <= cap)
+    return;
+
+  // Keep the `cap` closest links.
+  std::vector<std::pair<double, size_t>> scored;
+  scored.reserve(list.size());
+  for (size_t j = 0; j < list.size(); ++j)
+  {
+    scored.push_back(std::make_pair(metric.Evaluate(referenceSet.col(index),
+        referenceSet.col(list[j])), list[j]));
+  }
+  std::partial_sort(scored.begin(), scored.begin() + cap, scored.end());
+
+  list.resize(cap);
+  for (size_t j = 0; j < cap; ++j)
+    list[j] = scored[j].second;
+}
+
+template<typename MetricType, typename MatType>
+template<typename VecType>
+std::vector<std::pair<double, size_t>>
+HNSW<MetricType, MatType>::SearchLayer(const VecType& query,
+                                       const size_t layer,
+                                       const std::vector<size_t>& entries,
+                                       const size_t ef,
+                                       std::vector<bool>& visited) const
+{
+  // Min-heap of candidates still to expand, max-heap of current results.
+  typedef std::pair<double, size_t> Scored;
+  std::priority_queue<Scored, std::vector<Scored>, std::greater<Scored>>
+      candidates;
+  std::priority_queue<Scored> results;
+  std::vector<size_t> touched;
+
+  for (size_t j = 0; j < entries.size(); ++j)
+  {
+    const size_t e = entries[j];
+    if (visited[e])
+      continue;
+    visited[e] = true;
+    touched.push_back(e);
+    const double d = metric.Evaluate(query, referenceSet.col(e));
+    candidates.push(std::make_pair(d, e));
+    results.push(std::make_pair(d, e));
+  }
+
+  while (!candidates.empty())
+  {
+    const Scored current = candidates.top();
+    candidates.pop();
+
+    // The beam is full and every remaining candidate is further away than
+    // the worst result we hold, so the search has converged.
+    if (results.size() >= ef && current.first > results.top().first)
+      break;
+
+    const std::vector<size_t>& links = layers[layer][current.second];
+    for (size_t j = 0; j < links.size(); ++j)
+    {
+      const size_t nb = links[j];
+      if (visited[nb])
+        continue;
+      visited[nb] = true;
+      touched.push_back(nb);
+
+      const double d = metric.Evaluate(query, referenceSet.col(nb));
+      if (results.size() < ef || d < results.top().first)
+      {
+        candidates.push(std::make_pair(d, nb));
+        results.push(std::make_pair(d, nb));
+        if (results.size() > ef)
+          results.pop();
+      }
+    }
+  }
+
+  // Restore the visited workspace for the next call.
+  for (size_t j = 0; j < touched.size(); ++j)
+    visited[touched[j]] = false;
+
+  // Extract the results in increasing order of distance.
+  std::vector<Scored> sorted(results.size());
+  for (size_t j = results.size(); j-- > 0; )
+  {
+    sorted[j] = results.top();
+    results.pop();
+  }
+  return sorted;
+}
+
+template<typename MetricType, typename MatType>
+void HNSW<MetricType, MatType>::Search(const MatType& querySet,
+                                       const size_t k,
+                                       arma::Mat<size_t>& neighbors,
+                                       arma::mat& distances) const
+{
+  if (layers.empty())
+    throw std::runtime_error("HNSW::Search(): the index is empty; call "
+        "Train() first!");
+  if (k > referenceSet.n_cols)
+    throw std::invalid_argument("HNSW::Search(): requested more neighbors "
+        "than there are reference points!");
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  const size_t ef = std::max(k, efSearch);
+
+  Timer::Start("computing_neighbors");
+  #pragma omp parallel
+  {
+    // One visited-flag workspace per thread, reused across queries.
+    std::vector<bool> visited(referenceSet.n_cols, false);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+    {
+      std::vector<size_t> entries(1, entryPoint);
+
+      // Greedy descent through the upper layers.
+      for (size_t l = layers.size() - 1; l > 0; --l)
+      {
+        std::vector<std::pair<double, size_t>> best = SearchLayer(
+            querySet.col(i), l, entries, 1, visited);
+        if (!best.empty())
+          entries[0] = best[0].second;
+      }
+
+      // Beam search in the bottom layer.
+      std::vector<std::pair<double, size_t>> found = SearchLayer(
+          querySet.col(i), 0, entries, ef, visited);
+
+      for (size_t j = 0; j < k; ++j)
+      {
+        if (j < found.size())
+        {
+          neighbors(j, i) = found[j].second;
+          distances(j, i) = found[j].first;
+        }
+        else
+        {
+          // Not enough points were reachable; pad with invalid results.
+          neighbors(j, i) = (size_t) -1;
+          distances(j, i) = std::numeric_limits<double>::infinity();
+        }
+      }
+    }
+  }
+  Timer::Stop("computing_neighbors");
+}
+
+template<typename MetricType, typename MatType>
+template<typename Archive>
+void HNSW<MetricType, MatType>::serialize(Archive& ar,
+                                          const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(referenceSet));
+  ar(CEREAL_NVP(layers));
+  ar(CEREAL_NVP(entryPoint));
+  ar(CEREAL_NVP(maxNeighbors));
+  ar(CEREAL_NVP(efConstruction));
+  ar(CEREAL_NVP(efSearch));
+  ar(CEREAL_NVP(levelScale));
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -284,6 +284,19 @@ class HoeffdingTree
   //! Get the size of the Hoeffding Tree.
   size_t NumDescendants() const;
 
+  /**
+   * Take a prediction-only snapshot of this tree.  The snapshot has the same
+   * split structure, majority classes and probabilities---everything that
+   * Classify() reads---but none of the per-dimension split statistics that
+   * Train() updates, so taking one is far cheaper than a full copy.  A
+   * serving thread can classify with the snapshot while ingestion keeps
+   * training the original tree.  Do not call Train() on a snapshot: it
+   * carries no split statistics to update.
+   *
+   * @param snapshot Tree to overwrite with the snapshot.
+   */
+  void SnapshotPredictor(HoeffdingTree& snapshot) const;
+
   /**
    * Classify the given point and also return an estimate of the probability
    * that the prediction is correct.  (This estimate is simply the probability
@@ -335,6 +348,16 @@ class HoeffdingTree
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  /**
+   * Recursively build a prediction-only copy of this subtree for
+   * SnapshotPredictor(), sharing the snapshot root's dataset info and
+   * dimension mappings.
+   */
+  HoeffdingTree* SnapshotNode(
+      const data::DatasetInfo* sharedInfo,
+      std::unordered_map<size_t, std::pair<size_t, size_t>>* sharedMappings)
+      const;
+
   // We need to keep some information for before we have split.
 
   //! Information for splitting of numeric features (used before split).
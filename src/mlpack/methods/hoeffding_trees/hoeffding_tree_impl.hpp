@@ -440,12 +440,37 @@ void HoeffdingTree<
       }
     }
   }
-  else
+  else if (children.size() == 0)
   {
     // We aren't training in batch mode; loop through the points.
     for (size_t i = 0; i < data.n_cols; ++i)
       Train(data.col(i), labels[i]);
   }
+  else
+  {
+    // Streaming mode, but the tree has already split.  Route the whole block
+    // of samples to the leaves in one pass, then let every leaf ingest its
+    // samples together.  A leaf's ancestors cannot change while the block is
+    // processed, so this builds exactly the same tree as feeding the points
+    // through the root one at a time---but each internal node is walked once
+    // per block, and a leaf's split statistics stay hot in cache while it
+    // updates.  (A leaf may split mid-block; its remaining samples are then
+    // routed onwards by its own Train().)
+    std::unordered_map<HoeffdingTree*, std::vector<size_t>> leafSamples;
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      HoeffdingTree* node = this;
+      while (node->children.size() > 0)
+        node = node->children[node->CalculateDirection(data.col(i))];
+      leafSamples[node].push_back(i);
+    }
+
+    for (auto it = leafSamples.begin(); it != leafSamples.end(); ++it)
+    {
+      for (size_t j = 0; j < it->second.size(); ++j)
+        it->first->Train(data.col(it->second[j]), labels[it->second[j]]);
+    }
+  }
 }
 
 //! Train on a set of points.
@@ -561,6 +586,104 @@ void HoeffdingTree<
   }
 }
 
+// Build a prediction-only snapshot of the tree.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::SnapshotPredictor(HoeffdingTree& snapshot) const
+{
+  // Clear out whatever the target tree held.
+  for (size_t i = 0; i < snapshot.children.size(); ++i)
+    delete snapshot.children[i];
+  snapshot.children.clear();
+  snapshot.numericSplits.clear();
+  snapshot.categoricalSplits.clear();
+
+  // Copy everything Classify() reads, but deliberately leave the
+  // numericSplits and categoricalSplits vectors empty: the per-dimension
+  // split statistics are by far the largest part of a growing node, and they
+  // are only needed for further training.
+  snapshot.numSamples = numSamples;
+  snapshot.numClasses = numClasses;
+  snapshot.maxSamples = maxSamples;
+  snapshot.checkInterval = checkInterval;
+  snapshot.minSamples = minSamples;
+  snapshot.successProbability = successProbability;
+  snapshot.splitDimension = splitDimension;
+  snapshot.majorityClass = majorityClass;
+  snapshot.majorityProbability = majorityProbability;
+  snapshot.categoricalSplit = categoricalSplit;
+  snapshot.numericSplit = numericSplit;
+
+  // The snapshot root owns fresh copies of the dataset info and dimension
+  // mappings; every node below shares them, just as the other constructors
+  // arrange.
+  if (snapshot.ownsInfo)
+    delete snapshot.datasetInfo;
+  snapshot.datasetInfo = new data::DatasetInfo(*datasetInfo);
+  snapshot.ownsInfo = true;
+
+  if (snapshot.ownsMappings)
+    delete snapshot.dimensionMappings;
+  snapshot.dimensionMappings = new std::unordered_map<size_t,
+      std::pair<size_t, size_t>>(*dimensionMappings);
+  snapshot.ownsMappings = true;
+
+  for (size_t i = 0; i < children.size(); ++i)
+  {
+    snapshot.children.push_back(children[i]->SnapshotNode(
+        snapshot.datasetInfo, snapshot.dimensionMappings));
+  }
+}
+
+// Recursively build one node of a prediction-only snapshot.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>*
+HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::SnapshotNode(
+    const data::DatasetInfo* sharedInfo,
+    std::unordered_map<size_t, std::pair<size_t, size_t>>* sharedMappings)
+    const
+{
+  HoeffdingTree* node = new HoeffdingTree();
+
+  // The default constructor allocated an empty info and mapping; use the
+  // shared ones instead.
+  delete node->datasetInfo;
+  node->datasetInfo = sharedInfo;
+  node->ownsInfo = false;
+  delete node->dimensionMappings;
+  node->dimensionMappings = sharedMappings;
+  node->ownsMappings = false;
+
+  node->numSamples = numSamples;
+  node->numClasses = numClasses;
+  node->maxSamples = maxSamples;
+  node->checkInterval = checkInterval;
+  node->minSamples = minSamples;
+  node->successProbability = successProbability;
+  node->splitDimension = splitDimension;
+  node->majorityClass = majorityClass;
+  node->majorityProbability = majorityProbability;
+  node->categoricalSplit = categoricalSplit;
+  node->numericSplit = numericSplit;
+
+  for (size_t i = 0; i < children.size(); ++i)
+    node->children.push_back(children[i]->SnapshotNode(sharedInfo,
+        sharedMappings));
+
+  return node;
+}
+
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
          template<typename> class CategoricalSplitType>
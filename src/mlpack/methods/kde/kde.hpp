@@ -55,6 +55,9 @@ struct KDEDefaultParams
 
   //! Monte Carlo break coefficient.
   static constexpr double mcBreakCoef = 0.4;
+
+  //! Size of the leaves of the reference and query trees.
+  static constexpr size_t leafSize = 20;
 };
 
 /**
@@ -225,6 +228,43 @@ class KDE
    */
   void Evaluate(arma::vec& estimations);
 
+  /**
+   * Estimate density of each reference point for several bandwidth candidates
+   * at once, sharing a single traversal between all of them.  The estimation
+   * of a point with itself is not computed (leave-one-out), so the results
+   * are directly usable for likelihood cross-validation.  Estimations are not
+   * normalized.
+   *
+   * Each traversal decision is bounded separately for every bandwidth, so
+   * each row of the result satisfies the model error tolerances just like a
+   * separate Evaluate() call with that bandwidth would; the cost is roughly
+   * that of the single most expensive bandwidth instead of the sum of all of
+   * them.  Monte Carlo estimations are not used by this method.
+   *
+   * @pre The model has to be previously trained.
+   * @param bandwidths Bandwidth candidates to evaluate.
+   * @param estimations Matrix which will hold the density estimates; row i
+   *                    holds the estimates for bandwidths[i] and each column
+   *                    corresponds to a reference point.
+   */
+  void EvaluateBandwidths(const std::vector<double>& bandwidths,
+                          arma::mat& estimations);
+
+  /**
+   * Select the bandwidth that maximizes the leave-one-out log-likelihood of
+   * the reference set among the given candidates, using a single shared
+   * traversal (see EvaluateBandwidths()).  The model kernel is not modified.
+   *
+   * @pre The model has to be previously trained and the reference set must
+   *      contain at least two points.
+   * @param bandwidths Bandwidth candidates to evaluate.
+   * @param logLikelihoods Vector which will hold the leave-one-out
+   *                       log-likelihood of each candidate.
+   * @return The candidate bandwidth with the highest log-likelihood.
+   */
+  double SelectBandwidth(const std::vector<double>& bandwidths,
+                         arma::vec& logLikelihoods);
+
   //! Get the kernel.
   const KernelType& Kernel() const { return kernel; }
 
@@ -295,6 +335,14 @@ class KDE
   //! Modify Monte Carlo break coefficient. (0 < newCoef <= 1).
   void MCBreakCoef(const double newCoef);
 
+  //! Get the leaf size used when building trees.
+  size_t LeafSize() const { return leafSize; }
+
+  //! Modify the leaf size used when building trees (takes effect the next
+  //! time a tree is built; ignored by tree types that are not built with a
+  //! leaf size).
+  size_t& LeafSize() { return leafSize; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
@@ -346,6 +394,10 @@ class KDE
   //! is the limit before Monte Carlo estimation recurses.
   double mcBreakCoef;
 
+  //! Size of the leaves of the reference and query trees (ignored by tree
+  //! types that are not built with a leaf size).
+  size_t leafSize;
+
   //! Check whether absolute and relative error values are compatible.
   static void CheckErrorValues(const double relError, const double absError);
 
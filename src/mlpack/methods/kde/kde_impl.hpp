@@ -21,17 +21,22 @@ template<typename TreeType, typename MatType>
 TreeType* BuildTree(
     MatType&& dataset,
     std::vector<size_t>& oldFromNew,
+    const size_t leafSize,
     const typename std::enable_if<
         tree::TreeTraits<TreeType>::RearrangesDataset>::type* = 0)
 {
-  return new TreeType(std::forward<MatType>(dataset), oldFromNew);
+  return new TreeType(std::forward<MatType>(dataset), oldFromNew, leafSize);
 }
 
-//! Construct tree that doesn't rearrange the dataset.
+//! Construct tree that doesn't rearrange the dataset.  The tree types used
+//! here that don't rearrange the dataset (cover trees and rectangle trees)
+//! have no common leaf size constructor parameter, so the leaf size is
+//! ignored.
 template<typename TreeType, typename MatType>
 TreeType* BuildTree(
     MatType&& dataset,
     const std::vector<size_t>& /* oldFromNew */,
+    const size_t /* leafSize */,
     const typename std::enable_if<
         !tree::TreeTraits<TreeType>::RearrangesDataset>::type* = 0)
 {
@@ -72,7 +77,8 @@ KDE(const double relError,
     trained(false),
     mode(mode),
     monteCarlo(monteCarlo),
-    initialSampleSize(initialSampleSize)
+    initialSampleSize(initialSampleSize),
+    leafSize(KDEDefaultParams::leafSize)
 {
   CheckErrorValues(relError, absError);
   MCProb(mcProb);
@@ -106,7 +112,8 @@ KDE(const KDE& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    leafSize(other.leafSize)
 {
   if (trained)
   {
@@ -152,7 +159,8 @@ KDE(KDE&& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    leafSize(other.leafSize)
 {
   other.kernel = std::move(KernelType());
   other.metric = std::move(MetricType());
@@ -168,6 +176,7 @@ KDE(KDE&& other) :
   other.initialSampleSize = KDEDefaultParams::initialSampleSize;
   other.mcEntryCoef = KDEDefaultParams::mcEntryCoef;
   other.mcBreakCoef = KDEDefaultParams::mcBreakCoef;
+  other.leafSize = KDEDefaultParams::leafSize;
 }
 
 template<typename KernelType,
@@ -212,6 +221,7 @@ operator=(const KDE& other)
     initialSampleSize = other.initialSampleSize;
     mcEntryCoef = other.mcEntryCoef;
     mcBreakCoef = other.mcBreakCoef;
+    leafSize = other.leafSize;
     if (trained)
     {
       if (ownsReferenceTree)
@@ -278,6 +288,7 @@ operator=(KDE&& other)
     this->initialSampleSize = other.initialSampleSize;
     this->mcEntryCoef = other.mcEntryCoef;
     this->mcBreakCoef = other.mcBreakCoef;
+    this->leafSize = other.leafSize;
   }
   return *this;
 }
@@ -338,7 +349,8 @@ Train(MatType referenceSet)
   Timer::Start("building_reference_tree");
   this->oldFromNewReferences = new std::vector<size_t>;
   this->referenceTree = BuildTree<Tree>(std::move(referenceSet),
-                                        *oldFromNewReferences);
+                                        *oldFromNewReferences,
+                                        leafSize);
   Timer::Stop("building_reference_tree");
   this->trained = true;
 }
@@ -398,7 +410,8 @@ Evaluate(MatType querySet, arma::vec& estimations)
   {
     Timer::Start("building_query_tree");
     std::vector<size_t> oldFromNewQueries;
-    Tree* queryTree = BuildTree<Tree>(std::move(querySet), oldFromNewQueries);
+    Tree* queryTree = BuildTree<Tree>(std::move(querySet), oldFromNewQueries,
+        leafSize);
     Timer::Stop("building_query_tree");
     try
     {
@@ -443,36 +456,55 @@ Evaluate(MatType querySet, arma::vec& estimations)
 
     Timer::Start("computing_kde");
 
-    // Evaluate.
+    // Evaluate.  The query points are independent, so each OpenMP thread
+    // traverses batches of them with its own rule set (and hence its own
+    // Monte Carlo sampling state; the random generator streams are
+    // per-thread).  Every rule set writes only the estimation entries of the
+    // queries it was given, so the shared estimations vector needs no
+    // locking.
     typedef KDERules<MetricType, KernelType, Tree> RuleType;
-    RuleType rules = RuleType(referenceTree->Dataset(),
-                              querySet,
-                              estimations,
-                              relError,
-                              absError,
-                              mcProb,
-                              initialSampleSize,
-                              mcEntryCoef,
-                              mcBreakCoef,
-                              metric,
-                              kernel,
-                              monteCarlo,
-                              false);
+    size_t scores = 0;
+    size_t baseCases = 0;
+    tree::TraversalStatistics traversalStats;
 
-    // Create traverser.
-    SingleTreeTraversalType<RuleType> traverser(rules);
+    #pragma omp parallel
+    {
+      RuleType rules = RuleType(referenceTree->Dataset(),
+                                querySet,
+                                estimations,
+                                relError,
+                                absError,
+                                mcProb,
+                                initialSampleSize,
+                                mcEntryCoef,
+                                mcBreakCoef,
+                                metric,
+                                kernel,
+                                monteCarlo,
+                                false);
 
-    // Traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+      // Create traverser.
+      SingleTreeTraversalType<RuleType> traverser(rules);
+
+      // Traverse for each point.
+      #pragma omp for schedule(dynamic, 64)
+      for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      #pragma omp critical
+      {
+        scores += rules.Scores();
+        baseCases += rules.BaseCases();
+        traversalStats += rules.TraversalStats();
+      }
+    }
 
     estimations /= referenceTree->Dataset().n_cols;
     Timer::Stop("computing_kde");
 
-    Log::Info << rules.Scores() << " node combinations were scored."
-              << std::endl;
-    Log::Info << rules.BaseCases() << " base cases were calculated."
-              << std::endl;
+    Log::Info << scores << " node combinations were scored." << std::endl;
+    Log::Info << baseCases << " base cases were calculated." << std::endl;
+    Log::Info << "Traversal statistics: " << traversalStats << std::endl;
   }
 }
 
@@ -568,6 +600,7 @@ Evaluate(Tree* queryTree,
 
   Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
   Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
+  Log::Info << "Traversal statistics: " << rules.TraversalStats() << std::endl;
 }
 
 template<typename KernelType,
@@ -646,6 +679,138 @@ Evaluate(arma::vec& estimations)
 
   Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
   Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
+  Log::Info << "Traversal statistics: " << rules.TraversalStats() << std::endl;
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+EvaluateBandwidths(const std::vector<double>& bandwidths,
+                   arma::mat& estimations)
+{
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot evaluate KDE model: model needs to be "
+                             "trained before evaluation");
+  }
+
+  // Check there is at least one bandwidth candidate.
+  if (bandwidths.empty())
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: no bandwidth "
+                                "candidates were given");
+  }
+
+  // Get estimations matrix ready.
+  estimations.zeros(bandwidths.size(), referenceTree->Dataset().n_cols);
+
+  // Instantiate one kernel for each bandwidth candidate.
+  std::vector<KernelType> kernels;
+  kernels.reserve(bandwidths.size());
+  for (size_t k = 0; k < bandwidths.size(); ++k)
+    kernels.push_back(KernelType(bandwidths[k]));
+
+  Timer::Start("computing_kde");
+
+  // Evaluate all bandwidths in one traversal.
+  typedef KDEMultiRules<MetricType, KernelType, Tree> RuleType;
+  RuleType rules = RuleType(referenceTree->Dataset(),
+                            referenceTree->Dataset(),
+                            estimations,
+                            relError,
+                            absError,
+                            metric,
+                            kernels,
+                            true);
+
+  if (mode == DUAL_TREE_MODE)
+  {
+    // Create traverser.
+    DualTreeTraversalType<RuleType> traverser(rules);
+    traverser.Traverse(*referenceTree, *referenceTree);
+  }
+  else if (mode == SINGLE_TREE_MODE)
+  {
+    SingleTreeTraversalType<RuleType> traverser(rules);
+    for (size_t i = 0; i < referenceTree->Dataset().n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+  }
+
+  estimations /= referenceTree->Dataset().n_cols;
+
+  // Rearrange if necessary.
+  if (tree::TreeTraits<Tree>::RearrangesDataset)
+  {
+    const size_t nQueries = oldFromNewReferences->size();
+    arma::mat rearrangedEstimations(estimations.n_rows, nQueries);
+
+    // Remap columns.
+    for (size_t i = 0; i < nQueries; ++i)
+      rearrangedEstimations.col(oldFromNewReferences->at(i)) =
+          estimations.col(i);
+
+    estimations = std::move(rearrangedEstimations);
+  }
+  Timer::Stop("computing_kde");
+
+  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
+  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
+  Log::Info << "Traversal statistics: " << rules.TraversalStats() << std::endl;
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+double KDE<KernelType,
+           MetricType,
+           MatType,
+           TreeType,
+           DualTreeTraversalType,
+           SingleTreeTraversalType>::
+SelectBandwidth(const std::vector<double>& bandwidths,
+                arma::vec& logLikelihoods)
+{
+  // Leave-one-out estimations need at least two reference points.
+  if (trained && referenceTree->Dataset().n_cols < 2)
+  {
+    throw std::invalid_argument("cannot select KDE bandwidth: reference set "
+                                "must contain at least two points");
+  }
+
+  arma::mat estimations;
+  EvaluateBandwidths(bandwidths, estimations);
+
+  const size_t n = referenceTree->Dataset().n_cols;
+  const size_t dims = referenceTree->Dataset().n_rows;
+  logLikelihoods.set_size(bandwidths.size());
+  for (size_t k = 0; k < bandwidths.size(); ++k)
+  {
+    // Estimations are divided by the full reference set size and are not
+    // normalized; rescale them into proper leave-one-out densities so that
+    // likelihoods of different bandwidths are comparable.
+    const double scale = ((double) n / (n - 1)) /
+        KernelType(bandwidths[k]).Normalizer(dims);
+    logLikelihoods(k) = arma::accu(arma::log(scale * estimations.row(k)));
+  }
+
+  return bandwidths[logLikelihoods.index_max()];
 }
 
 template<typename KernelType,
@@ -788,6 +953,7 @@ serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(initialSampleSize));
   ar(CEREAL_NVP(mcEntryCoef));
   ar(CEREAL_NVP(mcBreakCoef));
+  ar(CEREAL_NVP(leafSize));
 
   // If we are loading, clean up memory if necessary.
   if (cereal::is_loading<Archive>())
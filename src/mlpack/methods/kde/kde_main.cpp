@@ -185,6 +185,20 @@ PARAM_DOUBLE_IN("mc_break_coef",
                 "the limit for the sample size before it recurses.",
                 "c",
                 KDEDefaultParams::mcBreakCoef);
+PARAM_DOUBLE_IN("subspace_variance",
+                "Fraction of the total variance the principal subspace "
+                "projection has to retain.  Values smaller than 1 project the "
+                "data onto its leading principal components before building "
+                "the tree (approximate, intended for high-dimensional data).",
+                "u",
+                1.0);
+PARAM_INT_IN("leaf_size",
+             "Leaf size of the tree, for tree types that are built with one "
+             "(kd-trees, ball trees and octrees).  If 0, a leaf size is "
+             "selected automatically by measuring the cost of a few "
+             "candidate leaf sizes on a sample of the reference set.",
+             "l",
+             (int) KDEDefaultParams::leafSize);
 
 // Output predictions options.
 PARAM_COL_OUT("predictions", "Vector to store density predictions.",
@@ -206,6 +220,8 @@ static void mlpackMain()
   const int initialSampleSize = IO::GetParam<int>("initial_sample_size");
   const double mcEntryCoef = IO::GetParam<double>("mc_entry_coef");
   const double mcBreakCoef = IO::GetParam<double>("mc_break_coef");
+  const double subspaceVariance = IO::GetParam<double>("subspace_variance");
+  const int leafSize = IO::GetParam<int>("leaf_size");
 
   // Initialize results vector.
   arma::vec estimations;
@@ -214,6 +230,8 @@ static void mlpackMain()
   RequireOnlyOnePassed({ "reference", "input_model" }, true);
   ReportIgnoredParam({{ "input_model", true }}, "tree");
   ReportIgnoredParam({{ "input_model", true }}, "kernel");
+  ReportIgnoredParam({{ "input_model", true }}, "subspace_variance");
+  ReportIgnoredParam({{ "input_model", true }}, "leaf_size");
 
   // Monte Carlo parameters only make sense if it is activated.
   ReportIgnoredParam({{ "monte_carlo", false }}, "mc_probability");
@@ -249,6 +267,13 @@ static void mlpackMain()
       [](double x){return x > 0 && x <= 1;}, true,
       "Monte Carlo break coefficient must be greater than 0 and less than "
       "or equal to 1");
+  RequireParamValue<double>("subspace_variance",
+      [](double x){return x > 0 && x <= 1;}, true,
+      "subspace retained variance fraction must be greater than 0 and less "
+      "than or equal to 1");
+  RequireParamValue<int>("leaf_size", [](int x){return x >= 0;},
+      true, "leaf size must be greater than or equal to 0 (0 means select "
+      "automatically)");
 
   KDEModel* kde;
 
@@ -282,6 +307,12 @@ static void mlpackMain()
     else if (treeStr == "r-tree")
       kde->TreeType() = KDEModel::R_TREE;
 
+    // Set the retained variance fraction for the subspace projection.
+    kde->SubspaceVariance() = subspaceVariance;
+
+    // Set the leaf size (0 requests automatic selection).
+    kde->LeafSize() = (size_t) leafSize;
+
     // Build model.
     kde->BuildModel(std::move(reference));
 
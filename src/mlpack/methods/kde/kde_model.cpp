@@ -24,7 +24,9 @@ KDEModel::KDEModel(const double bandwidth,
                    const double mcProb,
                    const size_t initialSampleSize,
                    const double mcEntryCoef,
-                   const double mcBreakCoef) :
+                   const double mcBreakCoef,
+                   const double subspaceVarRetained,
+                   const size_t leafSize) :
     bandwidth(bandwidth),
     relError(relError),
     absError(absError),
@@ -35,6 +37,8 @@ KDEModel::KDEModel(const double bandwidth,
     initialSampleSize(initialSampleSize),
     mcEntryCoef(mcEntryCoef),
     mcBreakCoef(mcBreakCoef),
+    subspaceVarRetained(subspaceVarRetained),
+    leafSize(leafSize),
     kdeModel(NULL)
 {
   // Nothing to do.
@@ -52,6 +56,8 @@ KDEModel::KDEModel(const KDEModel& other) :
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
     mcBreakCoef(other.mcBreakCoef),
+    subspaceVarRetained(other.subspaceVarRetained),
+    leafSize(other.leafSize),
     kdeModel(other.kdeModel->Clone())
 {
   // Nothing to do.
@@ -69,6 +75,8 @@ KDEModel::KDEModel(KDEModel&& other) :
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
     mcBreakCoef(other.mcBreakCoef),
+    subspaceVarRetained(other.subspaceVarRetained),
+    leafSize(other.leafSize),
     kdeModel(std::move(other.kdeModel))
 {
   // Reset other model.
@@ -82,6 +90,8 @@ KDEModel::KDEModel(KDEModel&& other) :
   other.initialSampleSize = KDEDefaultParams::initialSampleSize;
   other.mcEntryCoef = KDEDefaultParams::mcEntryCoef;
   other.mcBreakCoef = KDEDefaultParams::mcBreakCoef;
+  other.subspaceVarRetained = 1.0;
+  other.leafSize = KDEDefaultParams::leafSize;
 }
 
 KDEModel& KDEModel::operator=(const KDEModel& other)
@@ -100,6 +110,8 @@ KDEModel& KDEModel::operator=(const KDEModel& other)
     initialSampleSize = other.initialSampleSize;
     mcEntryCoef = other.mcEntryCoef;
     mcBreakCoef = other.mcBreakCoef;
+    subspaceVarRetained = other.subspaceVarRetained;
+    leafSize = other.leafSize;
     kdeModel = other.kdeModel->Clone();
   }
 
@@ -122,6 +134,8 @@ KDEModel& KDEModel::operator=(KDEModel&& other)
     initialSampleSize = other.initialSampleSize;
     mcEntryCoef = other.mcEntryCoef;
     mcBreakCoef = other.mcBreakCoef;
+    subspaceVarRetained = other.subspaceVarRetained;
+    leafSize = other.leafSize;
     kdeModel = std::move(other.kdeModel);
 
     // Reset other model.
@@ -135,6 +149,8 @@ KDEModel& KDEModel::operator=(KDEModel&& other)
     other.initialSampleSize = KDEDefaultParams::initialSampleSize;
     other.mcEntryCoef = KDEDefaultParams::mcEntryCoef;
     other.mcBreakCoef = KDEDefaultParams::mcBreakCoef;
+    other.subspaceVarRetained = 1.0;
+    other.leafSize = KDEDefaultParams::leafSize;
   }
 
   return *this;
@@ -146,35 +162,55 @@ KDEModel::~KDEModel()
   delete kdeModel;
 }
 
+template<typename KernelType,
+         template<typename TreeMetricType,
+                  typename TreeMatType,
+                  typename TreeStatType> class TreeType>
+KDEWrapperBase* MakeKDEWrapper(const double relError,
+                               const double absError,
+                               const double bandwidth,
+                               const double subspaceVarRetained)
+{
+  if (subspaceVarRetained < 1.0)
+  {
+    return new SubspaceKDEWrapper<KernelType, TreeType>(
+        relError, absError, KernelType(bandwidth), subspaceVarRetained);
+  }
+
+  return new KDEWrapper<KernelType, TreeType>(
+      relError, absError, KernelType(bandwidth));
+}
+
 template<template<typename TreeMetricType,
                   typename TreeMatType,
                   typename TreeStatType> class TreeType>
 KDEWrapperBase* InitializeModelHelper(const KDEModel::KernelTypes kernelType,
                                       const double relError,
                                       const double absError,
-                                      const double bandwidth)
+                                      const double bandwidth,
+                                      const double subspaceVarRetained)
 {
   switch (kernelType)
   {
     case KDEModel::GAUSSIAN_KERNEL:
-      return new KDEWrapper<kernel::GaussianKernel, TreeType>(
-          relError, absError, kernel::GaussianKernel(bandwidth));
+      return MakeKDEWrapper<kernel::GaussianKernel, TreeType>(
+          relError, absError, bandwidth, subspaceVarRetained);
 
     case KDEModel::EPANECHNIKOV_KERNEL:
-      return new KDEWrapper<kernel::EpanechnikovKernel, TreeType>(
-          relError, absError, kernel::EpanechnikovKernel(bandwidth));
+      return MakeKDEWrapper<kernel::EpanechnikovKernel, TreeType>(
+          relError, absError, bandwidth, subspaceVarRetained);
 
     case KDEModel::LAPLACIAN_KERNEL:
-      return new KDEWrapper<kernel::LaplacianKernel, TreeType>(
-          relError, absError, kernel::LaplacianKernel(bandwidth));
+      return MakeKDEWrapper<kernel::LaplacianKernel, TreeType>(
+          relError, absError, bandwidth, subspaceVarRetained);
 
     case KDEModel::SPHERICAL_KERNEL:
-      return new KDEWrapper<kernel::SphericalKernel, TreeType>(
-          relError, absError, kernel::SphericalKernel(bandwidth));
+      return MakeKDEWrapper<kernel::SphericalKernel, TreeType>(
+          relError, absError, bandwidth, subspaceVarRetained);
 
     case KDEModel::TRIANGULAR_KERNEL:
-      return new KDEWrapper<kernel::TriangularKernel, TreeType>(
-          relError, absError, kernel::TriangularKernel(bandwidth));
+      return MakeKDEWrapper<kernel::TriangularKernel, TreeType>(
+          relError, absError, bandwidth, subspaceVarRetained);
   }
 
   // This should never happen.
@@ -191,27 +227,27 @@ void KDEModel::InitializeModel()
   {
     case KD_TREE:
       kdeModel = InitializeModelHelper<tree::KDTree>(kernelType, relError,
-          absError, bandwidth);
+          absError, bandwidth, subspaceVarRetained);
       break;
 
     case BALL_TREE:
       kdeModel = InitializeModelHelper<tree::BallTree>(kernelType, relError,
-          absError, bandwidth);
+          absError, bandwidth, subspaceVarRetained);
       break;
 
     case COVER_TREE:
       kdeModel = InitializeModelHelper<tree::StandardCoverTree>(kernelType,
-          relError, absError, bandwidth);
+          relError, absError, bandwidth, subspaceVarRetained);
       break;
 
     case OCTREE:
       kdeModel = InitializeModelHelper<tree::Octree>(kernelType, relError,
-          absError, bandwidth);
+          absError, bandwidth, subspaceVarRetained);
       break;
 
     case R_TREE:
       kdeModel = InitializeModelHelper<tree::RTree>(kernelType, relError,
-          absError, bandwidth);
+          absError, bandwidth, subspaceVarRetained);
       break;
   }
 }
@@ -235,8 +271,53 @@ void KDEModel::BuildModel(arma::mat&& referenceSet)
   // Set Monte Carlo break coefficient.
   kdeModel->MCBreakCoef(mcBreakCoef);
 
+  // A leaf size of zero requests automatic selection.
+  if (leafSize == 0)
+    TuneLeafSize(referenceSet);
+
   // Train the model.
-  kdeModel->Train(std::move(referenceSet));
+  kdeModel->Train(std::move(referenceSet), leafSize);
+}
+
+// Select a leaf size for the given reference set empirically.
+void KDEModel::TuneLeafSize(const arma::mat& referenceSet)
+{
+  // Cover trees and rectangle trees are not built with a leaf size, so there
+  // is nothing to tune for them.  Small reference sets are too noisy to
+  // calibrate on.
+  if (treeType == COVER_TREE || treeType == R_TREE ||
+      referenceSet.n_cols < 100)
+  {
+    leafSize = KDEDefaultParams::leafSize;
+    return;
+  }
+
+  Timer::Start("leaf_size_tuning");
+
+  // Sample the reference set so that calibration stays cheap even on large
+  // datasets.
+  arma::uvec samples;
+  math::ObtainDistinctSamples(0, referenceSet.n_cols, 2000, samples);
+  const arma::mat sampleSet = referenceSet.cols(samples);
+
+  // Use a monochromatic evaluation on the sample as the representative
+  // workload.
+  leafSize = tree::LeafSizeTuner::Tune(
+      [&](const size_t candidate)
+      {
+        KDEModel trial(bandwidth, relError, absError, kernelType, treeType,
+            monteCarlo, mcProb, initialSampleSize, mcEntryCoef, mcBreakCoef,
+            subspaceVarRetained, candidate);
+
+        arma::mat trialSet(sampleSet);
+        trial.BuildModel(std::move(trialSet));
+
+        arma::vec estimates;
+        trial.Evaluate(estimates);
+      });
+
+  Timer::Stop("leaf_size_tuning");
+  Log::Info << "Selected leaf size " << leafSize << "." << std::endl;
 }
 
 // Perform bichromatic evaluation.
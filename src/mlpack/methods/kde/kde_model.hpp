@@ -17,6 +17,7 @@
 #include <mlpack/core/tree/octree.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/tree/rectangle_tree.hpp>
+#include <mlpack/core/tree/leaf_size_tuner.hpp>
 
 // Include core.
 #include <mlpack/core.hpp>
@@ -115,8 +116,8 @@ class KDEWrapperBase
   //! Modify the search mode.
   virtual KDEMode& Mode() = 0;
 
-  //! Train the model (build the tree).
-  virtual void Train(arma::mat&& referenceSet) = 0;
+  //! Train the model (build the tree with the given leaf size).
+  virtual void Train(arma::mat&& referenceSet, const size_t leafSize) = 0;
 
   //! Perform bichromatic KDE (i.e. KDE with a separate query set).
   virtual void Evaluate(arma::mat&& querySet,
@@ -193,8 +194,8 @@ class KDEWrapper : public KDEWrapperBase
   //! Modify the search mode.
   virtual KDEMode& Mode() { return kde.Mode(); }
 
-  //! Train the model (build the tree).
-  virtual void Train(arma::mat&& referenceSet);
+  //! Train the model (build the tree with the given leaf size).
+  virtual void Train(arma::mat&& referenceSet, const size_t leafSize);
 
   //! Perform bichromatic KDE (i.e. KDE with a separate query set).
   virtual void Evaluate(arma::mat&& querySet,
@@ -220,6 +221,95 @@ class KDEWrapper : public KDEWrapperBase
   KDEType kde;
 };
 
+/**
+ * SubspaceKDEWrapper is a KDEWrapper that builds its tree on the projection of
+ * the reference data onto its leading principal components.  In high
+ * dimensions the bounds of spatial trees become vacuous and KDE degenerates
+ * into brute force; if the data lives close to a lower-dimensional subspace,
+ * projecting first restores tight bounds and fast traversals.
+ *
+ * The density estimates are approximate: kernel evaluations use subspace
+ * distances, and the contribution of the discarded components is accounted
+ * for with a correction term that evaluates the kernel at the expected
+ * residual distance (twice the discarded variance).  The approximation error
+ * vanishes as the retained variance fraction approaches 1.
+ */
+template<typename KernelType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+class SubspaceKDEWrapper : public KDEWrapper<KernelType, TreeType>
+{
+ public:
+  //! Create the SubspaceKDEWrapper object.
+  SubspaceKDEWrapper(const double relError,
+                     const double absError,
+                     const KernelType& kernel,
+                     const double varRetained) :
+      KDEWrapper<KernelType, TreeType>(relError, absError, kernel),
+      varRetained(varRetained),
+      fullDimension(0),
+      residualDistance(0.0)
+  {
+    // Nothing left to do.
+  }
+
+  //! Create a new SubspaceKDEWrapper that is the same as this one.  This
+  //! function will properly handle polymorphism.
+  virtual SubspaceKDEWrapper* Clone() const
+  {
+    return new SubspaceKDEWrapper(*this);
+  }
+
+  //! Destruct the SubspaceKDEWrapper (nothing to do).
+  virtual ~SubspaceKDEWrapper() { }
+
+  //! Compute the principal subspace and build the tree on projected data.
+  virtual void Train(arma::mat&& referenceSet, const size_t leafSize);
+
+  //! Perform bichromatic KDE (i.e. KDE with a separate query set).
+  virtual void Evaluate(arma::mat&& querySet, arma::vec& estimates);
+
+  //! Perform monochromatic KDE (i.e. with the reference set as the query set).
+  virtual void Evaluate(arma::vec& estimates);
+
+  //! Get the fraction of the total variance the projection has to retain.
+  double VarianceRetained() const { return varRetained; }
+
+  //! Get the dimension of the principal subspace (0 if no projection was
+  //! needed).
+  size_t SubspaceDimension() const { return basis.n_cols; }
+
+  //! Serialize the KDE model along with the projection.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(cereal::make_nvp("kde", this->kde));
+    ar(CEREAL_NVP(varRetained));
+    ar(CEREAL_NVP(fullDimension));
+    ar(CEREAL_NVP(basis));
+    ar(CEREAL_NVP(dataMean));
+    ar(CEREAL_NVP(residualDistance));
+  }
+
+ protected:
+  //! Fraction of the total variance the projection has to retain.
+  double varRetained;
+
+  //! Dimension of the data the model was trained on.
+  size_t fullDimension;
+
+  //! Leading principal components (one per column); empty if the projection
+  //! would not reduce the dimension.
+  arma::mat basis;
+
+  //! Mean of the reference set.
+  arma::vec dataMean;
+
+  //! Expected distance between two points in the discarded components.
+  double residualDistance;
+};
+
 /**
  * The KDEModel provides an abstraction for the KDE class, abstracting away the
  * KernelType and TreeType parameters and allowing those to be specified at
@@ -279,6 +369,14 @@ class KDEModel
   //! Break coefficient for Monte Carlo estimations.
   double mcBreakCoef;
 
+  //! Fraction of the total variance the principal subspace projection has to
+  //! retain; 1 disables the projection.
+  double subspaceVarRetained;
+
+  //! Size of the leaves of the trees; 0 means select automatically when the
+  //! model is built.
+  size_t leafSize;
+
   /**
    * kdeModel holds whatever KDE type we are using.  It is initialized using the
    * `BuildModel()` method.
@@ -309,6 +407,17 @@ class KDEModel
    * @param mcBreakCoef Coefficient to control what fraction of the node's
    *                    descendants evaluated is the limit before Monte Carlo
    *                    estimation recurses.
+   * @param subspaceVarRetained Fraction of the total variance the principal
+   *                            subspace projection has to retain.  Values
+   *                            smaller than 1 project the reference data onto
+   *                            its leading principal components before
+   *                            building the tree (approximate, intended for
+   *                            high-dimensional data).
+   * @param leafSize Size of the leaves of the trees, for tree types that are
+   *                 built with one.  If 0, a leaf size is selected
+   *                 automatically when the model is built, by measuring the
+   *                 cost of a few candidate leaf sizes on a sample of the
+   *                 reference set.
    */
   KDEModel(const double bandwidth = 1.0,
            const double relError = KDEDefaultParams::relError,
@@ -319,7 +428,9 @@ class KDEModel
            const double mcProb = KDEDefaultParams::mcProb,
            const size_t initialSampleSize = KDEDefaultParams::initialSampleSize,
            const double mcEntryCoef = KDEDefaultParams::mcEntryCoef,
-           const double mcBreakCoef = KDEDefaultParams::mcBreakCoef);
+           const double mcBreakCoef = KDEDefaultParams::mcBreakCoef,
+           const double subspaceVarRetained = 1.0,
+           const size_t leafSize = KDEDefaultParams::leafSize);
 
   //! Copy constructor of the given model.
   KDEModel(const KDEModel& other);
@@ -408,6 +519,20 @@ class KDEModel
   //! Modify Monte Carlo break coefficient.
   void MCBreakCoefficient(const double newBreakCoef);
 
+  //! Get the retained variance fraction for the subspace projection.
+  double SubspaceVariance() const { return subspaceVarRetained; }
+
+  //! Modify the retained variance fraction for the subspace projection
+  //! (0 < newVar <= 1; takes effect the next time the model is built).
+  double& SubspaceVariance() { return subspaceVarRetained; }
+
+  //! Get the leaf size of the trees.
+  size_t LeafSize() const { return leafSize; }
+
+  //! Modify the leaf size of the trees (takes effect the next time the model
+  //! is built; 0 means select automatically).
+  size_t& LeafSize() { return leafSize; }
+
   //! Get the mode of the model.
   KDEMode Mode() const { return kdeModel->Mode(); }
 
@@ -425,6 +550,10 @@ class KDEModel
    * Takes possession of the reference set to avoid a copy, so the reference set
    * will not be usable after this.
    *
+   * If LeafSize() is zero, a leaf size is first selected automatically by
+   * measuring the build-and-evaluate cost of a few candidate leaf sizes on a
+   * sample of the reference set (see tree::LeafSizeTuner).
+   *
    * @param referenceSet Set of reference points.
    */
   void BuildModel(arma::mat&& referenceSet);
@@ -456,6 +585,18 @@ class KDEModel
  private:
   //! Clean memory.
   void CleanMemory();
+
+  /**
+   * Select a leaf size for the given reference set by measuring the
+   * build-and-evaluate cost of a ladder of candidate leaf sizes on a sample
+   * of the reference set (see tree::LeafSizeTuner), and store it in
+   * LeafSize().  If the current tree type is not built with a leaf size, or
+   * the reference set is too small for calibration to be meaningful, the
+   * default leaf size is stored instead.
+   *
+   * @param referenceSet Reference set the model will be built on.
+   */
+  void TuneLeafSize(const arma::mat& referenceSet);
 };
 
 } // namespace kde
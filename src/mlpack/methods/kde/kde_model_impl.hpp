@@ -23,8 +23,10 @@ template<typename KernelType,
          template<typename TreeMetricType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType>
-void KDEWrapper<KernelType, TreeType>::Train(arma::mat&& referenceSet)
+void KDEWrapper<KernelType, TreeType>::Train(arma::mat&& referenceSet,
+                                             const size_t leafSize)
 {
+  kde.LeafSize() = leafSize;
   kde.Train(std::move(referenceSet));
 }
 
@@ -57,56 +59,199 @@ void KDEWrapper<KernelType, TreeType>::Evaluate(arma::vec& estimates)
                                                 estimates);
 }
 
+//! Compute the principal subspace and build the tree on projected data.
+template<typename KernelType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void SubspaceKDEWrapper<KernelType, TreeType>::Train(arma::mat&& referenceSet,
+                                                     const size_t leafSize)
+{
+  this->kde.LeafSize() = leafSize;
+  fullDimension = referenceSet.n_rows;
+  dataMean = arma::mean(referenceSet, 1);
+  basis.reset();
+  residualDistance = 0.0;
+
+  Timer::Start("computing_principal_subspace");
+  // Center the reference set; KDE is translation invariant, so training on
+  // centered data gives the same estimates.
+  referenceSet.each_col() -= dataMean;
+
+  // Eigendecomposition of the covariance matrix of the reference set.  The
+  // eigenvalues are returned in ascending order.
+  arma::vec eigval;
+  arma::mat eigvec;
+  bool success = false;
+  if (referenceSet.n_cols > 1)
+  {
+    const arma::mat cov = referenceSet * referenceSet.t() /
+        (referenceSet.n_cols - 1);
+    success = arma::eig_sym(eigval, eigvec, cov);
+  }
+
+  if (success)
+  {
+    // Clamp small negative eigenvalues caused by round-off error.
+    eigval = arma::clamp(eigval, 0.0, arma::datum::inf);
+    const double totalVariance = arma::accu(eigval);
+
+    // Keep the smallest set of leading components that retains the requested
+    // fraction of the total variance.
+    double retained = 0.0;
+    size_t m = 0;
+    while (m < eigval.n_elem && retained < varRetained * totalVariance)
+    {
+      retained += eigval(eigval.n_elem - 1 - m);
+      ++m;
+    }
+
+    if (m < fullDimension)
+    {
+      // The leading components are the last columns.
+      basis = eigvec.cols(eigval.n_elem - m, eigval.n_elem - 1);
+
+      // Expected squared distance of two independent points in the discarded
+      // components is twice the discarded variance.
+      const double discarded = std::max(totalVariance - retained, 0.0);
+      residualDistance = std::sqrt(2 * discarded);
+
+      Log::Info << "SubspaceKDEWrapper::Train(): projected " << fullDimension
+          << "-dimensional data onto its " << m << " leading principal "
+          << "components (" << retained / totalVariance * 100 << "% of the "
+          << "variance retained)." << std::endl;
+    }
+  }
+  Timer::Stop("computing_principal_subspace");
+
+  if (basis.n_elem > 0)
+  {
+    arma::mat projected = basis.t() * referenceSet;
+    this->kde.Train(std::move(projected));
+  }
+  else
+  {
+    // The projection would not reduce the dimension; train on the full data.
+    this->kde.Train(std::move(referenceSet));
+  }
+}
+
+//! Perform bichromatic KDE (i.e. KDE with a separate query set).
+template<typename KernelType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void SubspaceKDEWrapper<KernelType, TreeType>::Evaluate(arma::mat&& querySet,
+                                                        arma::vec& estimates)
+{
+  querySet.each_col() -= dataMean;
+  if (basis.n_elem > 0)
+  {
+    arma::mat projected = basis.t() * querySet;
+    this->kde.Evaluate(std::move(projected), estimates);
+  }
+  else
+  {
+    this->kde.Evaluate(std::move(querySet), estimates);
+  }
+
+  // Account for the discarded components by evaluating the kernel at the
+  // expected residual distance.
+  if (residualDistance > 0.0)
+  {
+    estimates *= this->kde.Kernel().Evaluate(residualDistance) /
+        this->kde.Kernel().Evaluate(0.0);
+  }
+
+  // Normalize with the full dimension so that estimates approximate densities
+  // in the original space.
+  KernelNormalizer::ApplyNormalizer<KernelType>(this->kde.Kernel(),
+                                                fullDimension,
+                                                estimates);
+}
+
+//! Perform monochromatic KDE (i.e. with the reference set as the query set).
+template<typename KernelType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void SubspaceKDEWrapper<KernelType, TreeType>::Evaluate(arma::vec& estimates)
+{
+  this->kde.Evaluate(estimates);
+
+  // Account for the discarded components by evaluating the kernel at the
+  // expected residual distance.
+  if (residualDistance > 0.0)
+  {
+    estimates *= this->kde.Kernel().Evaluate(residualDistance) /
+        this->kde.Kernel().Evaluate(0.0);
+  }
+
+  // Normalize with the full dimension so that estimates approximate densities
+  // in the original space.
+  KernelNormalizer::ApplyNormalizer<KernelType>(this->kde.Kernel(),
+                                                fullDimension,
+                                                estimates);
+}
+
+template<typename KernelType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         typename Archive>
+void WrapperSerializer(Archive& ar,
+                       KDEWrapperBase* kdeModel,
+                       const bool subspace)
+{
+  if (subspace)
+  {
+    SubspaceKDEWrapper<KernelType, TreeType>& typedModel =
+        dynamic_cast<SubspaceKDEWrapper<KernelType, TreeType>&>(*kdeModel);
+    ar(CEREAL_NVP(typedModel));
+  }
+  else
+  {
+    KDEWrapper<KernelType, TreeType>& typedModel =
+        dynamic_cast<KDEWrapper<KernelType, TreeType>&>(*kdeModel);
+    ar(CEREAL_NVP(typedModel));
+  }
+}
+
 template<template<typename TreeMetricType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          typename Archive>
 void SerializationHelper(Archive& ar,
                          KDEWrapperBase* kdeModel,
-                         const KDEModel::KernelTypes kernelType)
+                         const KDEModel::KernelTypes kernelType,
+                         const bool subspace)
 {
   switch (kernelType)
   {
     case KDEModel::GAUSSIAN_KERNEL:
-      {
-        KDEWrapper<kernel::GaussianKernel, TreeType>& typedModel =
-            dynamic_cast<KDEWrapper<kernel::GaussianKernel,
-                                    TreeType>&>(*kdeModel);
-        ar(CEREAL_NVP(typedModel));
-        break;
-      }
+      WrapperSerializer<kernel::GaussianKernel, TreeType>(ar, kdeModel,
+          subspace);
+      break;
+
     case KDEModel::EPANECHNIKOV_KERNEL:
-      {
-        KDEWrapper<kernel::EpanechnikovKernel, TreeType>& typedModel =
-            dynamic_cast<KDEWrapper<kernel::EpanechnikovKernel,
-                                    TreeType>&>(*kdeModel);
-        ar(CEREAL_NVP(typedModel));
-        break;
-      }
+      WrapperSerializer<kernel::EpanechnikovKernel, TreeType>(ar, kdeModel,
+          subspace);
+      break;
+
     case KDEModel::LAPLACIAN_KERNEL:
-      {
-        KDEWrapper<kernel::LaplacianKernel, TreeType>& typedModel =
-            dynamic_cast<KDEWrapper<kernel::LaplacianKernel,
-                                    TreeType>&>(*kdeModel);
-        ar(CEREAL_NVP(typedModel));
-        break;
-      }
+      WrapperSerializer<kernel::LaplacianKernel, TreeType>(ar, kdeModel,
+          subspace);
+      break;
+
     case KDEModel::SPHERICAL_KERNEL:
-      {
-        KDEWrapper<kernel::SphericalKernel, TreeType>& typedModel =
-            dynamic_cast<KDEWrapper<kernel::SphericalKernel,
-                                    TreeType>&>(*kdeModel);
-        ar(CEREAL_NVP(typedModel));
-        break;
-      }
+      WrapperSerializer<kernel::SphericalKernel, TreeType>(ar, kdeModel,
+          subspace);
+      break;
+
     case KDEModel::TRIANGULAR_KERNEL:
-      {
-        KDEWrapper<kernel::TriangularKernel, TreeType>& typedModel =
-            dynamic_cast<KDEWrapper<kernel::TriangularKernel,
-                                    TreeType>&>(*kdeModel);
-        ar(CEREAL_NVP(typedModel));
-        break;
-      }
+      WrapperSerializer<kernel::TriangularKernel, TreeType>(ar, kdeModel,
+          subspace);
+      break;
   }
 }
 
@@ -124,6 +269,8 @@ void KDEModel::serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(initialSampleSize));
   ar(CEREAL_NVP(mcEntryCoef));
   ar(CEREAL_NVP(mcBreakCoef));
+  ar(CEREAL_NVP(subspaceVarRetained));
+  ar(CEREAL_NVP(leafSize));
 
   if (cereal::is_loading<Archive>())
   {
@@ -138,26 +285,28 @@ void KDEModel::serialize(Archive& ar, const uint32_t /* version */)
     InitializeModel(); // Values will be overwritten.
 
   // Avoid polymorphism in serialization by serializing directly by the type.
+  const bool subspace = (subspaceVarRetained < 1.0);
   switch (treeType)
   {
     case KD_TREE:
-      SerializationHelper<tree::KDTree>(ar, kdeModel, kernelType);
+      SerializationHelper<tree::KDTree>(ar, kdeModel, kernelType, subspace);
       break;
 
     case BALL_TREE:
-      SerializationHelper<tree::BallTree>(ar, kdeModel, kernelType);
+      SerializationHelper<tree::BallTree>(ar, kdeModel, kernelType, subspace);
       break;
 
     case COVER_TREE:
-      SerializationHelper<tree::StandardCoverTree>(ar, kdeModel, kernelType);
+      SerializationHelper<tree::StandardCoverTree>(ar, kdeModel, kernelType,
+          subspace);
       break;
 
     case OCTREE:
-      SerializationHelper<tree::Octree>(ar, kdeModel, kernelType);
+      SerializationHelper<tree::Octree>(ar, kdeModel, kernelType, subspace);
       break;
 
     case R_TREE:
-      SerializationHelper<tree::RTree>(ar, kdeModel, kernelType);
+      SerializationHelper<tree::RTree>(ar, kdeModel, kernelType, subspace);
       break;
   }
 }
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_KDE_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
 
 namespace mlpack {
 namespace kde {
@@ -88,10 +89,16 @@ class KDERules
   TraversalInfoType& TraversalInfo() { return traversalInfo; }
 
   //! Get the number of base cases.
-  size_t BaseCases() const { return baseCases; }
+  size_t BaseCases() const { return stats.BaseCases(); }
 
   //! Get the number of scores.
-  size_t Scores() const { return scores; }
+  size_t Scores() const { return stats.Scores(); }
+
+  //! Get the full set of traversal statistics.
+  const tree::TraversalStatistics& TraversalStats() const { return stats; }
+
+  //! Modify the full set of traversal statistics.
+  tree::TraversalStatistics& TraversalStats() { return stats; }
 
   //! Get the minimum number of base cases we need to perform to have acceptable
   //! results.
@@ -174,11 +181,138 @@ class KDERules
   //! Traversal information.
   TraversalInfoType traversalInfo;
 
-  //! The number of base cases.
-  size_t baseCases;
+  //! Traversal counters (base cases, scores, prunes).
+  tree::TraversalStatistics stats;
+};
+
+/**
+ * A traversal Rules class that estimates densities for several bandwidths of
+ * the same kernel family in a single traversal.  All bandwidths share the
+ * tree work and the distance computations; each query/reference combination
+ * is bounded separately for every bandwidth and pruned only when every
+ * bandwidth's bound is within its error tolerance, so each returned estimate
+ * obeys the same error guarantees as a separate deterministic KDERules
+ * traversal with that bandwidth.  Monte Carlo estimation is not supported.
+ *
+ * This exists for bandwidth selection: sweeping N bandwidths costs roughly
+ * one traversal instead of N (see KDE::EvaluateBandwidths()).
+ */
+template<typename MetricType, typename KernelType, typename TreeType>
+class KDEMultiRules
+{
+ public:
+  /**
+   * Construct KDEMultiRules.
+   *
+   * @param referenceSet Reference set data.
+   * @param querySet Query set data.
+   * @param densities Matrix where estimations will be written; each row
+   *                  corresponds to a kernel and each column to a query
+   *                  point.
+   * @param relError Relative error tolerance.
+   * @param absError Absolute error tolerance.
+   * @param metric Instantiated metric.
+   * @param kernels Instantiated kernels, one per bandwidth candidate.
+   * @param sameSet True if query and reference sets are the same
+   *                (monochromatic evaluation).
+   */
+  KDEMultiRules(const arma::mat& referenceSet,
+                const arma::mat& querySet,
+                arma::mat& densities,
+                const double relError,
+                const double absError,
+                MetricType& metric,
+                std::vector<KernelType>& kernels,
+                const bool sameSet);
+
+  //! Base Case.
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex);
+
+  //! SingleTree Score.
+  double Score(const size_t queryIndex, TreeType& referenceNode);
+
+  //! SingleTree Rescore.
+  double Rescore(const size_t queryIndex,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  //! Dual-Tree Score.
+  double Score(TreeType& queryNode, TreeType& referenceNode);
+
+  //! Dual-Tree Rescore.
+  double Rescore(TreeType& queryNode,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  typedef typename tree::TraversalInfo<TreeType> TraversalInfoType;
+
+  //! Get traversal information.
+  const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
+
+  //! Modify traversal information.
+  TraversalInfoType& TraversalInfo() { return traversalInfo; }
+
+  //! Get the number of base cases.
+  size_t BaseCases() const { return stats.BaseCases(); }
+
+  //! Get the number of scores.
+  size_t Scores() const { return stats.Scores(); }
+
+  //! Get the full set of traversal statistics.
+  const tree::TraversalStatistics& TraversalStats() const { return stats; }
+
+  //! Modify the full set of traversal statistics.
+  tree::TraversalStatistics& TraversalStats() { return stats; }
+
+  //! Get the minimum number of base cases we need to perform to have acceptable
+  //! results.
+  size_t MinimumBaseCases() const { return 0; }
+
+ private:
+  /**
+   * Bound the kernel values of a node combination for every bandwidth and
+   * decide whether all of them can be pruned.  On success, midKernels holds
+   * the midpoint kernel estimate of each bandwidth.
+   */
+  bool CanPruneAll(const double minDistance,
+                   const double maxDistance,
+                   arma::vec& midKernels) const;
+
+  //! The reference set.
+  const arma::mat& referenceSet;
+
+  //! The query set.
+  const arma::mat& querySet;
+
+  //! Density values (one row per kernel, one column per query point).
+  arma::mat& densities;
+
+  //! Relative error tolerance.
+  const double relError;
+
+  //! Absolute error tolerance available for each reference point.
+  const double absErrorTol;
+
+  //! Instantiated metric.
+  MetricType& metric;
+
+  //! Instantiated kernels, one per bandwidth candidate.
+  std::vector<KernelType>& kernels;
+
+  //! Whether reference and query sets are the same.
+  const bool sameSet;
+
+  //! The last query index.
+  size_t lastQueryIndex;
+
+  //! The last reference index.
+  size_t lastReferenceIndex;
+
+  //! Traversal information.
+  TraversalInfoType traversalInfo;
 
-  //! The number of scores.
-  size_t scores;
+  //! Traversal counters (base cases, scores, prunes).
+  tree::TraversalStatistics stats;
 };
 
 /**
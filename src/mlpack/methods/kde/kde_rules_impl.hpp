@@ -52,9 +52,7 @@ KDERules<MetricType, KernelType, TreeType>::KDERules(
     sameSet(sameSet),
     absErrorTol(absError / referenceSet.n_cols),
     lastQueryIndex(querySet.n_cols),
-    lastReferenceIndex(referenceSet.n_cols),
-    baseCases(0),
-    scores(0)
+    lastReferenceIndex(referenceSet.n_cols)
 {
   // Initialize accumError.
   accumError = arma::vec(querySet.n_cols, arma::fill::zeros);
@@ -89,7 +87,7 @@ double KDERules<MetricType, KernelType, TreeType>::BaseCase(
   // Update accumulated relative error tolerance for single-tree pruning.
   accumError(queryIndex) += 2 * relError * kernelValue;
 
-  ++baseCases;
+  ++stats.BaseCases();
   lastQueryIndex = queryIndex;
   lastReferenceIndex = referenceIndex;
   traversalInfo.LastBaseCase() = distance;
@@ -287,7 +285,9 @@ Score(const size_t queryIndex, TreeType& referenceNode)
       accumMCAlpha(queryIndex) += depthAlpha;
   }
 
-  ++scores;
+  ++stats.Scores();
+  if (score == DBL_MAX)
+    ++stats.ScorePrunes();
   traversalInfo.LastReferenceNode() = &referenceNode;
   traversalInfo.LastScore() = score;
   return score;
@@ -510,7 +510,9 @@ Score(TreeType& queryNode, TreeType& referenceNode)
       queryStat.AccumAlpha() += depthAlpha;
   }
 
-  ++scores;
+  ++stats.Scores();
+  if (score == DBL_MAX)
+    ++stats.ScorePrunes();
   traversalInfo.LastQueryNode() = &queryNode;
   traversalInfo.LastReferenceNode() = &referenceNode;
   traversalInfo.LastScore() = score;
@@ -573,6 +575,237 @@ CalculateAlpha(TreeType* node)
   return stat.MCAlpha();
 }
 
+template<typename MetricType, typename KernelType, typename TreeType>
+KDEMultiRules<MetricType, KernelType, TreeType>::KDEMultiRules(
+    const arma::mat& referenceSet,
+    const arma::mat& querySet,
+    arma::mat& densities,
+    const double relError,
+    const double absError,
+    MetricType& metric,
+    std::vector<KernelType>& kernels,
+    const bool sameSet) :
+    referenceSet(referenceSet),
+    querySet(querySet),
+    densities(densities),
+    relError(relError),
+    absErrorTol(absError / referenceSet.n_cols),
+    metric(metric),
+    kernels(kernels),
+    sameSet(sameSet),
+    lastQueryIndex(querySet.n_cols),
+    lastReferenceIndex(referenceSet.n_cols)
+{
+  // Nothing to do.
+}
+
+//! Multi-bandwidth base case.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline
+double KDEMultiRules<MetricType, KernelType, TreeType>::BaseCase(
+    const size_t queryIndex,
+    const size_t referenceIndex)
+{
+  // If reference and query sets are the same we don't want to compute the
+  // estimation of a point with itself.
+  if (sameSet && (queryIndex == referenceIndex))
+    return 0.0;
+
+  // Avoid duplicated calculations.
+  if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
+    return 0.0;
+
+  // The distance is computed once and shared by every bandwidth.
+  const double distance = metric.Evaluate(querySet.col(queryIndex),
+                                          referenceSet.col(referenceIndex));
+  for (size_t k = 0; k < kernels.size(); ++k)
+    densities(k, queryIndex) += kernels[k].Evaluate(distance);
+
+  ++stats.BaseCases();
+  lastQueryIndex = queryIndex;
+  lastReferenceIndex = referenceIndex;
+  traversalInfo.LastBaseCase() = distance;
+  return distance;
+}
+
+//! Decide whether every bandwidth can be pruned for a node combination.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline
+bool KDEMultiRules<MetricType, KernelType, TreeType>::CanPruneAll(
+    const double minDistance,
+    const double maxDistance,
+    arma::vec& midKernels) const
+{
+  // Each bandwidth keeps its own bound; the combination is prunable only if
+  // every bandwidth satisfies its own error tolerance, so the guarantees of a
+  // single-bandwidth deterministic traversal hold for every row.
+  for (size_t k = 0; k < kernels.size(); ++k)
+  {
+    const double maxKernel = kernels[k].Evaluate(minDistance);
+    const double minKernel = kernels[k].Evaluate(maxDistance);
+    const double bound = maxKernel - minKernel;
+    const double errorTolerance = absErrorTol + relError * minKernel;
+
+    if (bound > 2 * errorTolerance)
+      return false;
+
+    midKernels(k) = (maxKernel + minKernel) / 2.0;
+  }
+  return true;
+}
+
+//! Multi-bandwidth single-tree scoring function.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEMultiRules<MetricType, KernelType, TreeType>::
+Score(const size_t queryIndex, TreeType& referenceNode)
+{
+  // Auxiliary variables.
+  const arma::vec& queryPoint = querySet.unsafe_col(queryIndex);
+  const size_t refNumDesc = referenceNode.NumDescendants();
+  double score, minDistance, maxDistance;
+  // Calculations are not duplicated.
+  bool alreadyDidRefPoint0 = false;
+
+  if (tree::TreeTraits<TreeType>::FirstPointIsCentroid &&
+      lastQueryIndex == queryIndex &&
+      traversalInfo.LastReferenceNode() != NULL &&
+      lastReferenceIndex == referenceNode.Point(0))
+  {
+    // Don't duplicate calculations.
+    alreadyDidRefPoint0 = true;
+    const double furthestDescDist = referenceNode.FurthestDescendantDistance();
+    minDistance = std::max(traversalInfo.LastBaseCase() - furthestDescDist,
+        0.0);
+    maxDistance = traversalInfo.LastBaseCase() + furthestDescDist;
+  }
+  else
+  {
+    // All calculations are new.
+    const math::Range r = referenceNode.RangeDistance(queryPoint);
+    minDistance = r.Lo();
+    maxDistance = r.Hi();
+
+    // Check if we are a self-child.
+    if (tree::TreeTraits<TreeType>::HasSelfChildren &&
+        referenceNode.Parent() != NULL &&
+        referenceNode.Parent()->Point(0) == referenceNode.Point(0))
+    {
+      alreadyDidRefPoint0 = true;
+    }
+  }
+
+  arma::vec midKernels(kernels.size());
+  if (CanPruneAll(minDistance, maxDistance, midKernels))
+  {
+    // Sum up estimations for every bandwidth.
+    const size_t numPoints = alreadyDidRefPoint0 ? refNumDesc - 1 : refNumDesc;
+    densities.col(queryIndex) += numPoints * midKernels;
+
+    // Don't explore this tree branch.
+    score = DBL_MAX;
+  }
+  else
+  {
+    // Recurse.
+    score = minDistance;
+  }
+
+  ++stats.Scores();
+  if (score == DBL_MAX)
+    ++stats.ScorePrunes();
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  traversalInfo.LastScore() = score;
+  return score;
+}
+
+//! Multi-bandwidth single-tree rescore.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline double KDEMultiRules<MetricType, KernelType, TreeType>::
+Rescore(const size_t /* queryIndex */,
+        TreeType& /* referenceNode */,
+        const double oldScore) const
+{
+  // If it's pruned it continues to be pruned.
+  return oldScore;
+}
+
+//! Multi-bandwidth dual-tree scoring function.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEMultiRules<MetricType, KernelType, TreeType>::
+Score(TreeType& queryNode, TreeType& referenceNode)
+{
+  const size_t refNumDesc = referenceNode.NumDescendants();
+  double score, minDistance, maxDistance;
+  // Calculations are not duplicated.
+  bool alreadyDidRefPoint0 = false;
+
+  if (tree::TreeTraits<TreeType>::FirstPointIsCentroid &&
+      (traversalInfo.LastQueryNode() != NULL) &&
+      (traversalInfo.LastReferenceNode() != NULL) &&
+      (traversalInfo.LastQueryNode()->Point(0) == queryNode.Point(0)) &&
+      (traversalInfo.LastReferenceNode()->Point(0) == referenceNode.Point(0)))
+  {
+    // Don't duplicate calculations.
+    alreadyDidRefPoint0 = true;
+    lastQueryIndex = queryNode.Point(0);
+    lastReferenceIndex = referenceNode.Point(0);
+
+    // Calculate min and max distance.
+    const double refFurtDescDist = referenceNode.FurthestDescendantDistance();
+    const double queryFurtDescDist = queryNode.FurthestDescendantDistance();
+    const double sumFurtDescDist = refFurtDescDist + queryFurtDescDist;
+    minDistance = std::max(traversalInfo.LastBaseCase() - sumFurtDescDist, 0.0);
+    maxDistance = traversalInfo.LastBaseCase() + sumFurtDescDist;
+  }
+  else
+  {
+    // All calculations are new.
+    const math::Range r = queryNode.RangeDistance(referenceNode);
+    minDistance = r.Lo();
+    maxDistance = r.Hi();
+  }
+
+  arma::vec midKernels(kernels.size());
+  if (CanPruneAll(minDistance, maxDistance, midKernels))
+  {
+    // Sum up estimations for every bandwidth.
+    for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+    {
+      if (alreadyDidRefPoint0 && i == 0)
+        densities.col(queryNode.Descendant(i)) += (refNumDesc - 1) * midKernels;
+      else
+        densities.col(queryNode.Descendant(i)) += refNumDesc * midKernels;
+    }
+
+    // Prune.
+    score = DBL_MAX;
+  }
+  else
+  {
+    // Recurse.
+    score = minDistance;
+  }
+
+  ++stats.Scores();
+  if (score == DBL_MAX)
+    ++stats.ScorePrunes();
+  traversalInfo.LastQueryNode() = &queryNode;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  traversalInfo.LastScore() = score;
+  return score;
+}
+
+//! Multi-bandwidth dual-tree rescore.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline double KDEMultiRules<MetricType, KernelType, TreeType>::
+Rescore(TreeType& /* queryNode */,
+        TreeType& /* referenceNode */,
+        const double oldScore) const
+{
+  // If a branch is pruned then it continues to be pruned.
+  return oldScore;
+}
+
 //! Clean rules base case.
 template<typename TreeType>
 inline force_inline
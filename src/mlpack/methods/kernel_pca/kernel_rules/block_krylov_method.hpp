@@ -0,0 +1,81 @@
+/**
+ * @file methods/kernel_pca/kernel_rules/block_krylov_method.hpp
+ * @author Marcus Edel
+ *
+ * Use randomized block Krylov SVD to compute a partial eigendecomposition of
+ * the kernel matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_KERNEL_PCA_BLOCK_KRYLOV_METHOD_HPP
+#define MLPACK_METHODS_KERNEL_PCA_BLOCK_KRYLOV_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
+#include <mlpack/methods/block_krylov_svd/randomized_block_krylov_svd.hpp>
+
+namespace mlpack {
+namespace kpca {
+
+/**
+ * The exact kernel matrix is constructed, but only the leading eigenpairs are
+ * extracted, using the randomized block Krylov method.  The Krylov subspace
+ * iterations converge faster than plain randomized SVD when the kernel
+ * matrix's spectrum decays slowly, at the cost of a somewhat larger working
+ * set; as with RandomizedKernelRule, the decomposition cost scales with the
+ * requested rank rather than with the dataset size cubed.
+ */
+template<typename KernelType>
+class BlockKrylovKernelRule
+{
+ public:
+  /**
+   * Construct the exact kernel matrix and compute its leading eigenpairs.
+   *
+   * @param data Input data points.
+   * @param transformedData Matrix to output results into.
+   * @param eigval The leading KPCA eigenvalues will be written to this vector.
+   * @param eigvec The leading KPCA eigenvectors will be written to this
+   *     matrix.
+   * @param rank Number of eigenpairs to compute.
+   * @param kernel Kernel to be used for computation.
+   */
+  static void ApplyKernelMatrix(const arma::mat& data,
+                                arma::mat& transformedData,
+                                arma::vec& eigval,
+                                arma::mat& eigvec,
+                                const size_t rank,
+                                KernelType kernel = KernelType())
+  {
+    // Assemble the kernel matrix with the tiled parallel builder.
+    arma::mat kernelMatrix;
+    kernel::SymmetricKernelMatrix(kernel, data, kernelMatrix);
+
+    // Pseudo-centering on the kernel matrix, exactly as in NaiveKernelRule.
+    arma::rowvec rowMean = arma::sum(kernelMatrix, 0) / kernelMatrix.n_cols;
+    kernelMatrix.each_col() -= arma::sum(kernelMatrix, 1) /
+        kernelMatrix.n_cols;
+    kernelMatrix.each_row() -= rowMean;
+    kernelMatrix += arma::sum(rowMean) / kernelMatrix.n_cols;
+
+    // Compute the leading eigenpairs through the Krylov subspace.  The
+    // centered kernel matrix is symmetric positive semidefinite, so the
+    // singular triplets are eigenpairs, already ordered largest-first.
+    const size_t effectiveRank = std::min(rank, (size_t) data.n_cols);
+    arma::mat v;
+    svd::RandomizedBlockKrylovSVD bksvd;
+    bksvd.Apply(kernelMatrix, eigvec, eigval, v, effectiveRank);
+
+    transformedData = eigvec.t() * kernelMatrix;
+    transformedData.each_col() /= arma::sqrt(eigval);
+  }
+};
+
+} // namespace kpca
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,81 @@
+/**
+ * @file methods/kernel_pca/kernel_rules/randomized_method.hpp
+ * @author Marcus Edel
+ *
+ * Use randomized SVD to compute a partial eigendecomposition of the kernel
+ * matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_KERNEL_PCA_RANDOMIZED_METHOD_HPP
+#define MLPACK_METHODS_KERNEL_PCA_RANDOMIZED_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
+#include <mlpack/methods/randomized_svd/randomized_svd.hpp>
+
+namespace mlpack {
+namespace kpca {
+
+/**
+ * The exact kernel matrix is constructed, but only the leading eigenpairs are
+ * extracted, using randomized SVD.  When only a few components of a large
+ * dataset are needed this avoids the full O(n^3) eigendecomposition that the
+ * naive rule performs; the amount of work scales with the requested rank
+ * instead.  The centered kernel matrix is symmetric positive semidefinite, so
+ * its singular value decomposition coincides with its eigendecomposition.
+ */
+template<typename KernelType>
+class RandomizedKernelRule
+{
+ public:
+  /**
+   * Construct the exact kernel matrix and compute its leading eigenpairs.
+   *
+   * @param data Input data points.
+   * @param transformedData Matrix to output results into.
+   * @param eigval The leading KPCA eigenvalues will be written to this vector.
+   * @param eigvec The leading KPCA eigenvectors will be written to this
+   *     matrix.
+   * @param rank Number of eigenpairs to compute.
+   * @param kernel Kernel to be used for computation.
+   */
+  static void ApplyKernelMatrix(const arma::mat& data,
+                                arma::mat& transformedData,
+                                arma::vec& eigval,
+                                arma::mat& eigvec,
+                                const size_t rank,
+                                KernelType kernel = KernelType())
+  {
+    // Construct the kernel matrix, tile-by-tile and in parallel.
+    arma::mat kernelMatrix;
+    kernel::SymmetricKernelMatrix(kernel, data, kernelMatrix);
+
+    // Pseudo-center the kernel matrix; see NaiveKernelRule for why this is
+    // done on the kernel matrix instead of the (inaccessible) feature space.
+    arma::rowvec rowMean = arma::sum(kernelMatrix, 0) / kernelMatrix.n_cols;
+    kernelMatrix.each_col() -= arma::sum(kernelMatrix, 1) /
+        kernelMatrix.n_cols;
+    kernelMatrix.each_row() -= rowMean;
+    kernelMatrix += arma::sum(rowMean) / kernelMatrix.n_cols;
+
+    // Extract only the leading eigenpairs.  Randomized SVD returns the
+    // singular values in descending order, which is the order KPCA expects.
+    const size_t effectiveRank = std::min(rank, (size_t) data.n_cols);
+    arma::mat v;
+    svd::RandomizedSVD rsvd;
+    rsvd.Apply(kernelMatrix, eigvec, eigval, v, effectiveRank);
+
+    transformedData = eigvec.t() * kernelMatrix;
+    transformedData.each_col() /= arma::sqrt(eigval);
+  }
+};
+
+} // namespace kpca
+} // namespace mlpack
+
+#endif
@@ -59,6 +59,26 @@ class AllowEmptyClusters
     newCentroids.col(emptyCluster) = oldCentroids.col(emptyCluster);
   }
 
+  /**
+   * This overload accepts the assignments and distances cached by the Lloyd
+   * step; this policy has no use for them, so they are ignored.
+   */
+  template<typename MetricType, typename MatType>
+  static inline force_inline void EmptyCluster(
+      const MatType& /* data */,
+      const size_t emptyCluster,
+      const arma::mat& oldCentroids,
+      arma::mat& newCentroids,
+      arma::Col<size_t>& /* clusterCounts */,
+      const arma::Row<size_t>& /* lloydAssignments */,
+      const arma::vec& /* lloydDistances */,
+      MetricType& /* metric */,
+      const size_t /* iteration */)
+  {
+    // Take the last iteration's centroid.
+    newCentroids.col(emptyCluster) = oldCentroids.col(emptyCluster);
+  }
+
   //! Serialize the empty cluster policy (nothing to do).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
@@ -30,6 +30,18 @@ namespace kmeans {
  * dataset.  The conditions under which this will perform best are probably
  * limited to the case where k is close to the number of points in the dataset,
  * and the number of iterations of the k-means algorithm will be few.
+ *
+ * When mlpack is built with MLPACK_INSTRUMENTATION, each iteration reports
+ * prune counts broken down by bound type (dtkm_static_prunes,
+ * dtkm_owner_prunes, dtkm_traversal_info_prunes, dtkm_min_distance_prunes,
+ * dtkm_all_clusters_prunes, dtkm_rescore_prunes), the point and node prunes
+ * made while adjusting bounds between iterations (dtkm_update_point_prunes,
+ * dtkm_update_points_retained, dtkm_update_node_prunes), and scoped traces of
+ * the per-iteration phases (dtkm_update_tree, dtkm_coalesce_tree,
+ * dtkm_traversal, dtkm_decoalesce_tree); see
+ * Instrumentation::PrintCounters().  Comparing these against the prune rate
+ * of HamerlyKMeans on the same data is the intended way to choose between the
+ * two engines.
  */
 template<
     typename MetricType,
@@ -99,6 +99,8 @@ double DualTreeKMeans<MetricType, MatType, TreeType>::Iterate(
     arma::mat& newCentroids,
     arma::Col<size_t>& counts)
 {
+  MLPACK_SCOPED_TRACE(dtkm_iterate);
+
   // Build a tree on the centroids.  This will make a copy if necessary, which
   // is unfortunate, but I don't see a reasonable way around it.
   std::vector<size_t> oldFromNewCentroids;
@@ -136,7 +138,10 @@ double DualTreeKMeans<MetricType, MatType, TreeType>::Iterate(
 
     Timer::Stop("knn");
 
-    UpdateTree(*tree, centroids);
+    {
+      MLPACK_SCOPED_TRACE(dtkm_update_tree);
+      UpdateTree(*tree, centroids);
+    }
 
     for (size_t i = 0; i < dataset.n_cols; ++i)
       visited[i] = false;
@@ -159,16 +164,25 @@ double DualTreeKMeans<MetricType, MatType, TreeType>::Iterate(
       traverser(rules);
 
   Timer::Start("tree_mod");
-  CoalesceTree(*tree);
+  {
+    MLPACK_SCOPED_TRACE(dtkm_coalesce_tree);
+    CoalesceTree(*tree);
+  }
   Timer::Stop("tree_mod");
 
   // Set the number of pruned centroids in the root to 0.
   tree->Stat().Pruned() = 0;
-  traverser.Traverse(*tree, nns.ReferenceTree());
+  {
+    MLPACK_SCOPED_TRACE(dtkm_traversal);
+    traverser.Traverse(*tree, nns.ReferenceTree());
+  }
   distanceCalculations += rules.BaseCases() + rules.Scores();
 
   Timer::Start("tree_mod");
-  DecoalesceTree(*tree);
+  {
+    MLPACK_SCOPED_TRACE(dtkm_decoalesce_tree);
+    DecoalesceTree(*tree);
+  }
   Timer::Stop("tree_mod");
 
   // Now we need to extract the clusters.
@@ -394,6 +408,7 @@ visited[node.Descendant(i)] << ".\n";
         prunedPoints[index] = true;
         upperBounds[index] += clusterDistances[owner];
         lowerBounds[index] = pruningLowerBound;
+        MLPACK_COUNT(dtkm_update_point_prunes);
       }
       else
       {
@@ -405,6 +420,7 @@ visited[node.Descendant(i)] << ".\n";
         {
           prunedPoints[index] = true;
           lowerBounds[index] = pruningLowerBound;
+          MLPACK_COUNT(dtkm_update_point_prunes);
         }
         else
         {
@@ -418,6 +434,7 @@ visited[node.Descendant(i)] << ".\n";
             upperBounds[index] = DBL_MAX;
             lowerBounds[index] = DBL_MAX;
           }
+          MLPACK_COUNT(dtkm_update_points_retained);
           allPointsPruned = false;
         }
       }
@@ -453,6 +470,7 @@ visited[node.Descendant(i)] << ".\n";
   }
   else // The node is now pruned.
   {
+    MLPACK_COUNT(dtkm_update_node_prunes);
     if (prunedLastIteration)
     {
       // Track total movement while pruned.
@@ -489,6 +507,7 @@ void DualTreeKMeans<MetricType, MatType, TreeType>::ExtractCentroids(
     const size_t owner = node.Stat().Owner();
     newCentroids.col(owner) += node.Stat().Centroid() * node.NumDescendants();
     newCounts[owner] += node.NumDescendants();
+    MLPACK_COUNT_N(dtkm_points_extracted_by_node, node.NumDescendants());
 
     // Perform the sanity check here.
 /*
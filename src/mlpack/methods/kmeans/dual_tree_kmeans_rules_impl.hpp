@@ -67,6 +67,7 @@ inline force_inline double DualTreeKMeansRules<MetricType, TreeType>::BaseCase(
 
   // Calculate the distance.
   ++baseCases;
+  MLPACK_COUNT(dtkm_base_cases);
   const double distance = metric.Evaluate(dataset.col(queryIndex),
                                           centroids.col(referenceIndex));
 
@@ -110,7 +111,10 @@ inline double DualTreeKMeansRules<MetricType, TreeType>::Score(
     TreeType& referenceNode)
 {
   if (queryNode.Stat().StaticPruned() == true)
+  {
+    MLPACK_COUNT(dtkm_static_prunes);
     return DBL_MAX;
+  }
 
   // Pruned() for the root node must never be set to size_t(-1).
   if (queryNode.Stat().Pruned() == size_t(-1))
@@ -121,7 +125,10 @@ inline double DualTreeKMeansRules<MetricType, TreeType>::Score(
   }
 
   if (queryNode.Stat().Pruned() == centroids.n_cols)
+  {
+    MLPACK_COUNT(dtkm_owner_prunes);
     return DBL_MAX;
+  }
 
   // This looks a lot like the hackery used in NeighborSearchRules to avoid
   // distance computations.  We'll use the traversal info to see if a
@@ -226,6 +233,7 @@ inline double DualTreeKMeansRules<MetricType, TreeType>::Score(
       }
 
       queryNode.Stat().Pruned() += referenceNode.NumDescendants();
+      MLPACK_COUNT(dtkm_traversal_info_prunes);
       score = DBL_MAX;
     }
   }
@@ -247,6 +255,7 @@ inline double DualTreeKMeansRules<MetricType, TreeType>::Score(
       // This assumes that reference clusters don't appear elsewhere in the
       // tree.
       queryNode.Stat().Pruned() += referenceNode.NumDescendants();
+      MLPACK_COUNT(dtkm_min_distance_prunes);
       score = DBL_MAX;
     }
     else if (distances.Hi() < queryNode.Stat().UpperBound())
@@ -278,6 +287,7 @@ inline double DualTreeKMeansRules<MetricType, TreeType>::Score(
   if (queryNode.Stat().Pruned() == centroids.n_cols - 1)
   {
     queryNode.Stat().Pruned() = centroids.n_cols; // Owner() is already set.
+    MLPACK_COUNT(dtkm_all_clusters_prunes);
     return DBL_MAX;
   }
 
@@ -320,6 +330,7 @@ inline double DualTreeKMeansRules<MetricType, TreeType>::Rescore(
 
     // This assumes that reference clusters don't appear elsewhere in the tree.
     queryNode.Stat().Pruned() += referenceNode.NumDescendants();
+    MLPACK_COUNT(dtkm_rescore_prunes);
     return DBL_MAX;
   }
 
@@ -39,6 +39,14 @@ class HamerlyKMeans
 
   size_t DistanceCalculations() const { return distanceCalculations; }
 
+  /**
+   * Invalidate the per-point bounds, so that the next call to Iterate()
+   * reinitializes them.  The bound arrays keep their allocations.  This is
+   * necessary if the centroids are changed by something other than Iterate()
+   * between two calls (e.g. by another Lloyd step implementation).
+   */
+  void Reset();
+
  private:
   //! The dataset.
   const MatType& dataset;
@@ -54,6 +62,9 @@ class HamerlyKMeans
   arma::vec lowerBounds;
   //! Assignments for each point.
   arma::Col<size_t> assignments;
+  //! Movement of each centroid in the last iteration (pooled across
+  //! iterations to avoid reallocation).
+  arma::vec centroidMovements;
 
   //! Track distance calculations.
   size_t distanceCalculations;
@@ -43,6 +43,7 @@ double HamerlyKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
     lowerBounds.zeros(dataset.n_cols);
     assignments.zeros(dataset.n_cols);
     minClusterDistances.set_size(centroids.n_cols);
+    centroidMovements.set_size(centroids.n_cols);
   }
 
   // Reset new centroids.
@@ -131,7 +132,6 @@ double HamerlyKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   double furthestMovement = 0.0;
   double secondFurthestMovement = 0.0;
   size_t furthestMovingCluster = 0;
-  arma::vec centroidMovements(centroids.n_cols);
   double centroidMovement = 0.0;
   for (size_t c = 0; c < centroids.n_cols; ++c)
   {
@@ -172,6 +172,14 @@ double HamerlyKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   return std::sqrt(centroidMovement);
 }
 
+template<typename MetricType, typename MatType>
+void HamerlyKMeans<MetricType, MatType>::Reset()
+{
+  // Emptying minClusterDistances makes the next call to Iterate() refill all
+  // the bound arrays; their allocations are kept and reused.
+  minClusterDistances.reset();
+}
+
 } // namespace kmeans
 } // namespace mlpack
 
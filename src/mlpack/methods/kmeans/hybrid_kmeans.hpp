@@ -0,0 +1,118 @@
+/**
+ * @file methods/kmeans/hybrid_kmeans.hpp
+ *
+ * A hybrid Lloyd step implementation that switches between Hamerly's
+ * bound-based algorithm and the Pelleg-Moore blacklist algorithm depending on
+ * which one is pruning better.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_HYBRID_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_HYBRID_KMEANS_HPP
+
+#include "hamerly_kmeans.hpp"
+#include "pelleg_moore_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * A Lloyd step implementation that combines Hamerly's algorithm with the
+ * Pelleg-Moore blacklist algorithm.  The two prune in complementary regimes:
+ * Hamerly's per-point bounds are cheap to maintain but collapse while the
+ * centroids are still moving a lot, and the Pelleg-Moore tree traversal
+ * prunes well for moving centroids but carries per-node blacklist overhead
+ * once the clustering has nearly converged.  Neither dominates for large k.
+ *
+ * After every iteration this class measures the prune rate of the strategy it
+ * used (the fraction of the k * n distance calculations a naive iteration
+ * would make that were avoided).  When the active strategy's prune rate drops
+ * below a threshold and the other strategy's last measured rate is better,
+ * the next iteration switches strategies.  Both strategies keep their bound
+ * arrays pooled across iterations: Hamerly's per-point bounds are only
+ * invalidated (not reallocated) on a switch, and the Pelleg-Moore tree is
+ * built once, the first time it is needed.
+ *
+ * Both underlying algorithms are exact, so every iterate produces the same
+ * centroids a naive Lloyd step would.
+ */
+template<typename MetricType, typename MatType>
+class HybridKMeans
+{
+ public:
+  /**
+   * Construct the HybridKMeans object.  The Pelleg-Moore tree is not built
+   * until it is first needed.
+   */
+  HybridKMeans(const MatType& dataset, MetricType& metric);
+
+  /**
+   * Delete the Pelleg-Moore step, if it was ever created.
+   */
+  ~HybridKMeans();
+
+  /**
+   * Run a single iteration of Lloyd's algorithm with whichever strategy is
+   * currently active, updating the given centroids into the newCentroids
+   * matrix.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Current counts, to be overwritten with new counts.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  //! Return the number of distance calculations.
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+  //! Return whether Hamerly's algorithm is the active strategy.
+  bool UsingHamerly() const { return usingHamerly; }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! Hamerly's algorithm; its bound arrays persist across iterations.
+  HamerlyKMeans<MetricType, MatType> hamerly;
+  //! The Pelleg-Moore algorithm; created lazily because it builds a tree.
+  PellegMooreKMeans<MetricType, MatType>* pellegMoore;
+
+  //! Whether Hamerly's algorithm is the active strategy.
+  bool usingHamerly;
+  //! Whether the active strategy was switched before this iteration; its
+  //! first iteration is not representative (Hamerly has to refill its
+  //! bounds), so no switching decision is made from it.
+  bool justSwitched;
+
+  //! Last measured prune rate of Hamerly's algorithm.
+  double hamerlyPruneRate;
+  //! Last measured prune rate of the Pelleg-Moore algorithm.
+  double pellegMoorePruneRate;
+
+  //! Distance calculations of Hamerly's algorithm after the last iteration.
+  size_t lastHamerlyCalcs;
+  //! Distance calculations of the Pelleg-Moore algorithm after the last
+  //! iteration.
+  size_t lastPellegMooreCalcs;
+
+  //! Track distance calculations.
+  size_t distanceCalculations;
+
+  //! Prune rate below which a switch to the other strategy is considered.
+  static constexpr double minPruneRate = 0.5;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "hybrid_kmeans_impl.hpp"
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * @file methods/kmeans/hybrid_kmeans_impl.hpp
+ *
+ * Implementation of the hybrid Hamerly / Pelleg-Moore Lloyd step.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_HYBRID_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_HYBRID_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hybrid_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+HybridKMeans<MetricType, MatType>::HybridKMeans(const MatType& dataset,
+                                                MetricType& metric) :
+    dataset(dataset),
+    metric(metric),
+    hamerly(dataset, metric),
+    pellegMoore(NULL),
+    usingHamerly(true),
+    justSwitched(true),
+    // Unmeasured strategies are assumed to prune perfectly, so that the first
+    // time the active strategy degrades the other one gets tried.
+    hamerlyPruneRate(1.0),
+    pellegMoorePruneRate(1.0),
+    lastHamerlyCalcs(0),
+    lastPellegMooreCalcs(0),
+    distanceCalculations(0)
+{
+  // Nothing to do.
+}
+
+template<typename MetricType, typename MatType>
+HybridKMeans<MetricType, MatType>::~HybridKMeans()
+{
+  if (pellegMoore)
+    delete pellegMoore;
+}
+
+template<typename MetricType, typename MatType>
+double HybridKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
+                                                  arma::mat& newCentroids,
+                                                  arma::Col<size_t>& counts)
+{
+  // Number of distance calculations a naive iteration would make; the prune
+  // rate of a strategy is measured against it.
+  const double naiveCalcs = (double) dataset.n_cols * centroids.n_cols;
+
+  double residual;
+  if (usingHamerly)
+  {
+    residual = hamerly.Iterate(centroids, newCentroids, counts);
+
+    const size_t calcs = hamerly.DistanceCalculations() - lastHamerlyCalcs;
+    lastHamerlyCalcs = hamerly.DistanceCalculations();
+    distanceCalculations += calcs;
+
+    if (justSwitched)
+    {
+      // The bounds were just (re)initialized, so this iteration's prune rate
+      // is not representative of the strategy.
+      justSwitched = false;
+    }
+    else
+    {
+      hamerlyPruneRate = 1.0 - std::min(1.0, calcs / naiveCalcs);
+      if (hamerlyPruneRate < minPruneRate &&
+          hamerlyPruneRate < pellegMoorePruneRate)
+      {
+        Log::Info << "HybridKMeans: Hamerly prune rate " << hamerlyPruneRate
+            << "; switching to the Pelleg-Moore strategy." << std::endl;
+        usingHamerly = false;
+        justSwitched = true;
+      }
+    }
+  }
+  else
+  {
+    // Build the tree the first time the Pelleg-Moore strategy is used.
+    if (!pellegMoore)
+    {
+      pellegMoore = new PellegMooreKMeans<MetricType, MatType>(dataset,
+          metric);
+    }
+
+    residual = pellegMoore->Iterate(centroids, newCentroids, counts);
+
+    const size_t calcs = pellegMoore->DistanceCalculations() -
+        lastPellegMooreCalcs;
+    lastPellegMooreCalcs = pellegMoore->DistanceCalculations();
+    distanceCalculations += calcs;
+
+    if (justSwitched)
+    {
+      justSwitched = false;
+    }
+    else
+    {
+      pellegMoorePruneRate = 1.0 - std::min(1.0, calcs / naiveCalcs);
+      if (pellegMoorePruneRate < minPruneRate &&
+          pellegMoorePruneRate < hamerlyPruneRate)
+      {
+        Log::Info << "HybridKMeans: Pelleg-Moore prune rate "
+            << pellegMoorePruneRate << "; switching to the Hamerly strategy."
+            << std::endl;
+        usingHamerly = true;
+        justSwitched = true;
+
+        // Hamerly's bounds are stale (the centroids moved without it);
+        // invalidate them so the next iteration rebuilds them.
+        hamerly.Reset();
+      }
+    }
+  }
+
+  return residual;
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -63,6 +63,30 @@ class KillEmptyClusters
   }
 }
 
+  /**
+   * This overload accepts the assignments and distances cached by the Lloyd
+   * step; this policy has no use for them, so they are ignored.
+   */
+  template<typename MetricType, typename MatType>
+  static inline force_inline void EmptyCluster(
+      const MatType& /* data */,
+      const size_t emptyCluster,
+      const arma::mat& /* oldCentroids */,
+      arma::mat& newCentroids,
+      arma::Col<size_t>& clusterCounts,
+      const arma::Row<size_t>& /* lloydAssignments */,
+      const arma::vec& /* lloydDistances */,
+      MetricType& /* metric */,
+      const size_t /* iteration */)
+{
+  // Remove the empty cluster.
+  if (emptyCluster < newCentroids.n_cols)
+  {
+    newCentroids.shed_col(emptyCluster);
+    clusterCounts.shed_row(emptyCluster);
+  }
+}
+
   //! Serialize the empty cluster policy (nothing to do).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
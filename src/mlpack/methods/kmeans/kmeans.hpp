@@ -15,6 +15,8 @@
 #include <mlpack/prereqs.hpp>
 
 #include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/util/checkpointer.hpp>
+#include <mlpack/core/util/progress_token.hpp>
 #include "sample_initialization.hpp"
 #include "max_variance_new_cluster.hpp"
 #include "naive_kmeans.hpp"
@@ -59,7 +61,13 @@ namespace kmeans /** K-Means clustering. */ {
  *     implement a default constructor and 'void EmptyCluster(const arma::mat&
  *     data, const size_t emptyCluster, const arma::mat& oldCentroids,
  *     arma::mat& newCentroids, arma::Col<size_t>& counts, MetricType& metric,
- *     const size_t iteration)'.
+ *     const size_t iteration)'.  If the LloydStepType caches the cluster
+ *     assignments and point-to-centroid distances it computed (that is, it has
+ *     'const arma::Row<size_t>& Assignments() const' and 'const arma::vec&
+ *     Distances() const' members, like NaiveKMeans), the policy must instead
+ *     implement an overload that additionally accepts those two arrays after
+ *     the counts, so that it can reuse them instead of recomputing distances
+ *     over the whole dataset.
  * @tparam LloydStepType Implementation of single Lloyd step to use.
  *
  * @see RandomPartition, SampleInitialization, RefinedStart, AllowEmptyClusters,
@@ -104,11 +112,14 @@ class KMeans
    * @param assignments Vector to store cluster assignments in.
    * @param initialGuess If true, then it is assumed that assignments has a list
    *      of initial cluster assignments.
+   * @param progress If non-NULL, a token that is reported to after each
+   *      iteration and that can cancel the clustering cooperatively.
    */
   void Cluster(const MatType& data,
                const size_t clusters,
                arma::Row<size_t>& assignments,
-               const bool initialGuess = false);
+               const bool initialGuess = false,
+               util::ProgressToken* progress = NULL);
 
   /**
    * Perform k-means clustering on the data, returning the centroids of each
@@ -122,11 +133,71 @@ class KMeans
    * @param centroids Matrix in which centroids are stored.
    * @param initialGuess If true, then it is assumed that centroids contains the
    *      initial cluster centroids.
+   * @param progress If non-NULL, a token that is reported to after each
+   *      iteration and that can cancel the clustering cooperatively.
+   * @param checkpoint If non-NULL, a checkpointer that the current centroids
+   *      are periodically written to.
    */
   void Cluster(const MatType& data,
                size_t clusters,
                arma::mat& centroids,
-               const bool initialGuess = false);
+               const bool initialGuess = false,
+               util::ProgressToken* progress = NULL,
+               util::Checkpointer* checkpoint = NULL);
+
+  /**
+   * Perform k-means clustering on the data with periodic checkpointing,
+   * returning the centroids of each cluster in the centroids matrix.  The
+   * centroids are written to the given checkpointer every
+   * checkpoint.Interval() iterations; if the checkpoint file already exists,
+   * clustering resumes from the checkpointed centroids instead of a fresh
+   * initialization.  Note that the iteration counter restarts on resume, so
+   * MaxIterations() bounds the iterations of each run, not of the whole
+   * clustering.
+   *
+   * @tparam MatType Type of matrix (arma::mat or arma::sp_mat).
+   * @param data Dataset to cluster.
+   * @param clusters Number of clusters to compute.
+   * @param centroids Matrix in which centroids are stored.
+   * @param checkpoint Checkpointer to periodically write centroids to and to
+   *      resume from.
+   * @param progress If non-NULL, a token that is reported to after each
+   *      iteration and that can cancel the clustering cooperatively.
+   */
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids,
+               util::Checkpointer& checkpoint,
+               util::ProgressToken* progress = NULL);
+
+  /**
+   * Perform k-means clustering on the data with per-point instance weights,
+   * returning the centroids of each cluster in the centroids matrix.  Each
+   * point contributes its weight to the centroid updates, so a point with
+   * weight w behaves exactly like w copies of that point; in particular, the
+   * multiplicity counts produced by data::CollapseDuplicates() can be passed
+   * here to cluster a duplicate-heavy dataset at the cost of its unique
+   * points.  This overload requires a LloydStepType that supports instance
+   * weights (NaiveKMeans does).
+   *
+   * @tparam MatType Type of matrix (arma::mat or arma::sp_mat).
+   * @tparam VecType Type of the weight vector (any Armadillo vector type).
+   * @param data Dataset to cluster.
+   * @param clusters Number of clusters to compute.
+   * @param centroids Matrix in which centroids are stored.
+   * @param weights Instance weight of each point; weights must be positive.
+   * @param initialGuess If true, then it is assumed that centroids contains
+   *      the initial cluster centroids.
+   * @param progress If non-NULL, a token that is reported to after each
+   *      iteration and that can cancel the clustering cooperatively.
+   */
+  template<typename VecType>
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids,
+               const VecType& weights,
+               const bool initialGuess = false,
+               util::ProgressToken* progress = NULL);
 
   /**
    * Perform k-means clustering on the data, returning a list of cluster
@@ -147,13 +218,16 @@ class KMeans
    *      has a list of initial cluster assignments.
    * @param initialCentroidGuess If true, then it is assumed that centroids
    *      contains the initial centroids of each cluster.
+   * @param progress If non-NULL, a token that is reported to after each
+   *      iteration and that can cancel the clustering cooperatively.
    */
   void Cluster(const MatType& data,
                const size_t clusters,
                arma::Row<size_t>& assignments,
                arma::mat& centroids,
                const bool initialAssignmentGuess = false,
-               const bool initialCentroidGuess = false);
+               const bool initialCentroidGuess = false,
+               util::ProgressToken* progress = NULL);
 
   //! Get the maximum number of iterations.
   size_t MaxIterations() const { return maxIterations; }
@@ -181,6 +255,20 @@ class KMeans
   void serialize(Archive& ar, const uint32_t version);
 
  private:
+  /**
+   * Run the Lloyd iterations with an already-constructed Lloyd step,
+   * performing initialization, empty cluster handling, checkpointing and
+   * progress reporting.  This is shared by the unweighted and weighted
+   * Cluster() overloads.
+   */
+  void ClusterLoop(const MatType& data,
+                   const size_t clusters,
+                   arma::mat& centroids,
+                   const bool initialGuess,
+                   util::ProgressToken* progress,
+                   util::Checkpointer* checkpoint,
+                   LloydStepType<MetricType, MatType>& lloydStep);
+
   //! Maximum number of iterations before giving up.
   size_t maxIterations;
   //! Instantiated distance metric.
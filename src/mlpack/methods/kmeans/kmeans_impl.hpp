@@ -78,6 +78,77 @@ bool GetInitialAssignmentsOrCentroids(
   return false;
 }
 
+/**
+ * These give us objects we can use to tell whether or not a LloydStepType
+ * caches the cluster assignments and point-to-centroid distances it computed
+ * during an iteration.
+ */
+HAS_MEM_FUNC(Assignments, CachesAssignmentsCheck);
+HAS_MEM_FUNC(Distances, CachesDistancesCheck);
+
+/**
+ * 'value' is true if the LloydStepType class has members
+ * 'const arma::Row<size_t>& Assignments() const' and
+ * 'const arma::vec& Distances() const'.
+ */
+template<typename LloydStepType>
+struct CachesPointInformation
+{
+  static const bool value =
+      CachesAssignmentsCheck<LloydStepType,
+          const arma::Row<size_t>&(LloydStepType::*)() const>::value &&
+      CachesDistancesCheck<LloydStepType,
+          const arma::vec&(LloydStepType::*)() const>::value;
+};
+
+//! Call the empty cluster policy with the assignments and distances the Lloyd
+//! step cached, so that the policy does not have to recompute all n * k
+//! point-to-centroid distances.
+template<typename EmptyClusterPolicy,
+         typename LloydStepType,
+         typename MatType,
+         typename MetricType>
+void HandleEmptyCluster(
+    EmptyClusterPolicy& emptyClusterAction,
+    const LloydStepType& lloydStep,
+    const MatType& data,
+    const size_t emptyCluster,
+    const arma::mat& oldCentroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts,
+    MetricType& metric,
+    const size_t iteration,
+    const typename std::enable_if_t<
+        CachesPointInformation<LloydStepType>::value>* = 0)
+{
+  emptyClusterAction.EmptyCluster(data, emptyCluster, oldCentroids,
+      newCentroids, counts, lloydStep.Assignments(), lloydStep.Distances(),
+      metric, iteration);
+}
+
+//! Call the empty cluster policy without any cached point information, if the
+//! Lloyd step does not provide it.
+template<typename EmptyClusterPolicy,
+         typename LloydStepType,
+         typename MatType,
+         typename MetricType>
+void HandleEmptyCluster(
+    EmptyClusterPolicy& emptyClusterAction,
+    const LloydStepType& /* lloydStep */,
+    const MatType& data,
+    const size_t emptyCluster,
+    const arma::mat& oldCentroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts,
+    MetricType& metric,
+    const size_t iteration,
+    const typename std::enable_if_t<
+        !CachesPointInformation<LloydStepType>::value>* = 0)
+{
+  emptyClusterAction.EmptyCluster(data, emptyCluster, oldCentroids,
+      newCentroids, counts, metric, iteration);
+}
+
 /**
  * Construct the K-Means object.
  */
@@ -124,10 +195,12 @@ inline void KMeans<
 Cluster(const MatType& data,
         const size_t clusters,
         arma::Row<size_t>& assignments,
-        const bool initialGuess)
+        const bool initialGuess,
+        util::ProgressToken* progress)
 {
   arma::mat centroids(data.n_rows, clusters);
-  Cluster(data, clusters, assignments, centroids, initialGuess);
+  Cluster(data, clusters, assignments, centroids, initialGuess, false,
+      progress);
 }
 
 /**
@@ -148,7 +221,71 @@ void KMeans<
 Cluster(const MatType& data,
         const size_t clusters,
         arma::mat& centroids,
-        const bool initialGuess)
+        const bool initialGuess,
+        util::ProgressToken* progress,
+        util::Checkpointer* checkpoint)
+{
+  LloydStepType<MetricType, MatType> lloydStep(data, metric);
+  ClusterLoop(data, clusters, centroids, initialGuess, progress, checkpoint,
+      lloydStep);
+}
+
+/**
+ * Perform k-means clustering on the data with per-point instance weights.
+ */
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+template<typename VecType>
+void KMeans<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::
+Cluster(const MatType& data,
+        const size_t clusters,
+        arma::mat& centroids,
+        const VecType& weights,
+        const bool initialGuess,
+        util::ProgressToken* progress)
+{
+  if (weights.n_elem != data.n_cols)
+  {
+    Log::Fatal << "KMeans::Cluster(): number of instance weights ("
+        << weights.n_elem << ") not the same as the number of points ("
+        << data.n_cols << ")!" << std::endl;
+  }
+
+  LloydStepType<MetricType, MatType> lloydStep(data, metric);
+  lloydStep.Weights() = arma::conv_to<arma::vec>::from(weights);
+  ClusterLoop(data, clusters, centroids, initialGuess, progress, NULL,
+      lloydStep);
+}
+
+/**
+ * Run the Lloyd iterations with an already-constructed Lloyd step.
+ */
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+void KMeans<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::
+ClusterLoop(const MatType& data,
+            const size_t clusters,
+            arma::mat& centroids,
+            const bool initialGuess,
+            util::ProgressToken* progress,
+            util::Checkpointer* checkpoint,
+            LloydStepType<MetricType, MatType>& lloydStep)
 {
   // Make sure we have more points than clusters.
   if (clusters > data.n_cols)
@@ -207,7 +344,6 @@ Cluster(const MatType& data,
 
   size_t iteration = 0;
 
-  LloydStepType<MetricType, MatType> lloydStep(data, metric);
   arma::mat centroidsOther;
   double cNorm;
 
@@ -228,11 +364,11 @@ Cluster(const MatType& data,
       {
         Log::Info << "Cluster " << i << " is empty.\n";
         if (iteration % 2 == 0)
-          emptyClusterAction.EmptyCluster(data, i, centroids, centroidsOther,
-              counts, metric, iteration);
+          HandleEmptyCluster(emptyClusterAction, lloydStep, data, i, centroids,
+              centroidsOther, counts, metric, iteration);
         else
-          emptyClusterAction.EmptyCluster(data, i, centroidsOther, centroids,
-              counts, metric, iteration);
+          HandleEmptyCluster(emptyClusterAction, lloydStep, data, i,
+              centroidsOther, centroids, counts, metric, iteration);
       }
     }
 
@@ -241,6 +377,26 @@ Cluster(const MatType& data,
         << cNorm << ".\n";
     if (std::isnan(cNorm) || std::isinf(cNorm))
       cNorm = 1e-4; // Keep iterating.
+
+    // Periodically write the current centroids to the checkpoint file, so
+    // that a preempted run can resume from them.
+    if (checkpoint && checkpoint->Due(iteration))
+    {
+      if ((iteration - 1) % 2 == 0)
+        checkpoint->Save(centroidsOther);
+      else
+        checkpoint->Save(centroids);
+    }
+
+    // Report progress and check for cooperative cancellation; on
+    // cancellation, the centroids of the last completed iteration are
+    // returned.
+    if (progress && !progress->Report(iteration, cNorm))
+    {
+      Log::Info << "KMeans::Cluster(): cancelled after " << iteration
+          << " iterations." << std::endl;
+      break;
+    }
   } while (cNorm > 1e-5 && iteration != maxIterations);
 
   // If we ended on an even iteration, then the centroids are in the
@@ -263,6 +419,39 @@ Cluster(const MatType& data,
       << std::endl;
 }
 
+/**
+ * Perform k-means clustering on the data with periodic checkpointing,
+ * resuming from an existing checkpoint if one is present.
+ */
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+void KMeans<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::
+Cluster(const MatType& data,
+        const size_t clusters,
+        arma::mat& centroids,
+        util::Checkpointer& checkpoint,
+        util::ProgressToken* progress)
+{
+  // If a checkpoint exists, resume from the centroids it holds instead of
+  // performing a fresh initialization.
+  const bool resumed = checkpoint.Load(centroids);
+  if (resumed)
+  {
+    Log::Info << "KMeans::Cluster(): resuming from checkpoint '"
+        << checkpoint.Filename() << "'." << std::endl;
+  }
+
+  Cluster(data, clusters, centroids, resumed, progress, &checkpoint);
+}
+
 /**
  * Perform k-means clustering on the data, returning a list of cluster
  * assignments and the centroids of each cluster.
@@ -283,7 +472,8 @@ Cluster(const MatType& data,
         arma::Row<size_t>& assignments,
         arma::mat& centroids,
         const bool initialAssignmentGuess,
-        const bool initialCentroidGuess)
+        const bool initialCentroidGuess,
+        util::ProgressToken* progress)
 {
   // Now, the initial assignments.  First determine if they are necessary.
   if (initialAssignmentGuess)
@@ -309,7 +499,7 @@ Cluster(const MatType& data,
   }
 
   Cluster(data, clusters, centroids,
-      initialAssignmentGuess || initialCentroidGuess);
+      initialAssignmentGuess || initialCentroidGuess, progress);
 
   // Calculate final assignments in parallel over the entire dataset.
   assignments.set_size(data.n_cols);
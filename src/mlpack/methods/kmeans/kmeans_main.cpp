@@ -21,6 +21,7 @@
 #include "elkan_kmeans.hpp"
 #include "hamerly_kmeans.hpp"
 #include "pelleg_moore_kmeans.hpp"
+#include "hybrid_kmeans.hpp"
 #include "dual_tree_kmeans.hpp"
 
 using namespace mlpack;
@@ -62,9 +63,11 @@ BINDING_LONG_DESC(
     " option.  The standard O(kN) approach can be used ('naive').  Other "
     "options include the Pelleg-Moore tree-based algorithm ('pelleg-moore'), "
     "Elkan's triangle-inequality based algorithm ('elkan'), Hamerly's "
-    "modification to Elkan's algorithm ('hamerly'), the dual-tree k-means "
-    "algorithm ('dualtree'), and the dual-tree k-means algorithm using the "
-    "cover tree ('dualtree-covertree')."
+    "modification to Elkan's algorithm ('hamerly'), a hybrid of Hamerly's and "
+    "the Pelleg-Moore algorithm that switches between the two based on their "
+    "measured prune rates ('hybrid'), the dual-tree k-means algorithm "
+    "('dualtree'), and the dual-tree k-means algorithm using the cover tree "
+    "('dualtree-covertree')."
     "\n\n"
     "The behavior for when an empty cluster is encountered can be modified with"
     " the " + PRINT_PARAM_STRING("allow_empty_clusters") + " option.  When "
@@ -156,7 +159,7 @@ PARAM_FLAG("kmeans_plus_plus", "Use the k-means++ initialization strategy to "
     "choose initial points.", "K");
 
 PARAM_STRING_IN("algorithm", "Algorithm to use for the Lloyd iteration "
-    "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'dualtree', or "
+    "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'hybrid', 'dualtree', or "
     "'dualtree-covertree').", "a", "naive");
 
 // Given the type of initial partition policy, figure out the empty cluster
@@ -236,8 +239,8 @@ template<typename InitialPartitionPolicy, typename EmptyClusterPolicy>
 void FindLloydStepType(const InitialPartitionPolicy& ipp)
 {
   RequireParamInSet<string>("algorithm", { "elkan", "hamerly", "pelleg-moore",
-      "dualtree", "dualtree-covertree", "naive" }, true, "unknown k-means "
-      "algorithm");
+      "hybrid", "dualtree", "dualtree-covertree", "naive" }, true, "unknown "
+      "k-means algorithm");
 
   const string algorithm = IO::GetParam<string>("algorithm");
   if (algorithm == "elkan")
@@ -247,6 +250,8 @@ void FindLloydStepType(const InitialPartitionPolicy& ipp)
   else if (algorithm == "pelleg-moore")
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy,
         PellegMooreKMeans>(ipp);
+  else if (algorithm == "hybrid")
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, HybridKMeans>(ipp);
   else if (algorithm == "dualtree")
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy,
         DefaultDualTreeKMeans>(ipp);
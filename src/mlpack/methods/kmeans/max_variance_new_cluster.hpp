@@ -54,6 +54,39 @@ class MaxVarianceNewCluster
                     MetricType& metric,
                     const size_t iteration);
 
+  /**
+   * Take the point furthest from the centroid of the cluster with maximum
+   * variance to be a new cluster, reusing the assignments and point-to-centroid
+   * distances the Lloyd step already computed during this iteration.  If either
+   * array is empty (because the Lloyd step does not cache them), this falls
+   * back to recomputing them over the whole dataset.
+   *
+   * @tparam MatType Type of data (arma::mat or arma::spmat).
+   * @param data Dataset on which clustering is being performed.
+   * @param emptyCluster Index of cluster which is empty.
+   * @param oldCentroids Centroids of each cluster (one per column) at the start
+   *      of the iteration.
+   * @param newCentroids Centroids of each cluster (one per column) at the end
+   *      of the iteration.
+   * @param clusterCounts Number of points in each cluster.
+   * @param lloydAssignments Closest cluster of each point, as computed by the
+   *      Lloyd step (may be empty).
+   * @param lloydDistances Distance of each point to its closest cluster, as
+   *      computed by the Lloyd step (may be empty).
+   * @param metric The Metric to use.
+   * @param iteration Number of iteration.
+   */
+  template<typename MetricType, typename MatType>
+  void EmptyCluster(const MatType& data,
+                    const size_t emptyCluster,
+                    const arma::mat& oldCentroids,
+                    arma::mat& newCentroids,
+                    arma::Col<size_t>& clusterCounts,
+                    const arma::Row<size_t>& lloydAssignments,
+                    const arma::vec& lloydDistances,
+                    MetricType& metric,
+                    const size_t iteration);
+
   //! Serialize the object.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
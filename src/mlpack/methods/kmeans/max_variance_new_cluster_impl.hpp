@@ -29,10 +29,57 @@ void MaxVarianceNewCluster::EmptyCluster(const MatType& data,
                                          arma::Col<size_t>& clusterCounts,
                                          MetricType& metric,
                                          const size_t iteration)
+{
+  // No cached information from the Lloyd step is available, so the variances
+  // and assignments will be recomputed from scratch when needed.
+  EmptyCluster(data, emptyCluster, oldCentroids, newCentroids, clusterCounts,
+      arma::Row<size_t>(), arma::vec(), metric, iteration);
+}
+
+/**
+ * Take action about an empty cluster, reusing the assignments and distances
+ * the Lloyd step computed (if it provided any).
+ */
+template<typename MetricType, typename MatType>
+void MaxVarianceNewCluster::EmptyCluster(
+    const MatType& data,
+    const size_t emptyCluster,
+    const arma::mat& oldCentroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& clusterCounts,
+    const arma::Row<size_t>& lloydAssignments,
+    const arma::vec& lloydDistances,
+    MetricType& metric,
+    const size_t iteration)
 {
   // If necessary, calculate the variances and assignments.
   if (iteration != this->iteration || assignments.n_elem != data.n_cols)
-    Precalculate(data, oldCentroids, clusterCounts, metric);
+  {
+    if (lloydAssignments.n_elem == data.n_cols &&
+        lloydDistances.n_elem == data.n_cols)
+    {
+      // The Lloyd step already found the closest cluster to each point and the
+      // distance to it, so the variances can be accumulated directly instead
+      // of recomputing all n * k distances.
+      assignments = lloydAssignments;
+      variances.zeros(oldCentroids.n_cols);
+      for (size_t i = 0; i < data.n_cols; ++i)
+        variances[assignments[i]] += std::pow(lloydDistances[i], 2.0);
+
+      // Divide by the number of points in the cluster to produce the variance,
+      // unless the cluster is empty or contains only one point, in which case
+      // we set the variance to 0.
+      for (size_t i = 0; i < clusterCounts.n_elem; ++i)
+        if (clusterCounts[i] <= 1)
+          variances[i] = 0;
+        else
+          variances[i] /= clusterCounts[i];
+    }
+    else
+    {
+      Precalculate(data, oldCentroids, clusterCounts, metric);
+    }
+  }
   this->iteration = iteration;
 
   // Now find the cluster with maximum variance.
@@ -0,0 +1,95 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans.hpp
+ * @author Ryan Curtin
+ *
+ * An implementation of mini-batch k-means, where each iteration refines the
+ * centroids using a random sample of the dataset instead of every point.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * This is an implementation of a single iteration of the mini-batch k-means
+ * algorithm of Sculley ("Web-scale k-means clustering", 2010).  Each call to
+ * Iterate() samples a small batch of points, assigns them to their nearest
+ * centroid, and moves each centroid towards its assigned batch points with a
+ * per-centroid learning rate that decays as the centroid accumulates points.
+ * The resulting centroids are approximate, but an iteration touches only the
+ * batch instead of the entire dataset, which makes this a good choice for
+ * datasets too large for full Lloyd iterations.
+ *
+ * This class is meant to be used as the LloydStepType policy of the KMeans
+ * class, just like NaiveKMeans.
+ *
+ * @tparam MetricType Type of metric used with this implementation.
+ * @tparam MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename MetricType, typename MatType>
+class MiniBatchKMeans
+{
+ public:
+  /**
+   * Construct the MiniBatchKMeans object with the given dataset and metric.
+   *
+   * @param dataset Dataset.
+   * @param metric Instantiated metric.
+   */
+  MiniBatchKMeans(const MatType& dataset, MetricType& metric);
+
+  /**
+   * Run a single iteration of mini-batch k-means, updating the given centroids
+   * into the newCentroids matrix.  The returned residual is the movement of
+   * the centroids during this iteration; because of the decaying learning
+   * rates it shrinks as iterations accumulate, so the usual convergence check
+   * of the KMeans class applies.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Cumulative number of sampled points assigned to each
+   *     cluster across all iterations so far.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+  //! Get the number of points sampled per iteration.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points sampled per iteration.
+  size_t& BatchSize() { return batchSize; }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! Number of points sampled per iteration.
+  size_t batchSize;
+  //! Cumulative per-cluster sample counts; these drive the per-centroid
+  //! learning rates.
+  arma::Col<size_t> clusterCounts;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "mini_batch_kmeans_impl.hpp"
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans_impl.hpp
+ * @author Ryan Curtin
+ *
+ * An implementation of mini-batch k-means, where each iteration refines the
+ * centroids using a random sample of the dataset instead of every point.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mini_batch_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+MiniBatchKMeans<MetricType, MatType>::MiniBatchKMeans(const MatType& dataset,
+                                                      MetricType& metric) :
+    dataset(dataset),
+    metric(metric),
+    batchSize(std::min((size_t) dataset.n_cols, (size_t) 1000)),
+    distanceCalculations(0)
+{ /* Nothing to do. */ }
+
+// Run a single iteration.
+template<typename MetricType, typename MatType>
+double MiniBatchKMeans<MetricType, MatType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  // The cumulative sample counts persist across iterations; they determine the
+  // learning rate of each centroid.
+  if (clusterCounts.n_elem != centroids.n_cols)
+    clusterCounts.zeros(centroids.n_cols);
+
+  // Sample the batch (with replacement, as in the original algorithm).
+  arma::uvec batch(batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+    batch[i] = (arma::uword) math::RandInt((int) dataset.n_cols);
+
+  // Assign each batch point to its closest centroid; the assignments are
+  // independent, so this loop is parallelized.
+  arma::Col<size_t> assignments(batchSize);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) batchSize; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      const double distance = metric.Evaluate(dataset.col(batch[i]),
+          centroids.unsafe_col(j));
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+    assignments[i] = closestCluster;
+  }
+
+  // Apply the centroid updates sequentially: each batch point pulls its
+  // centroid towards it with a step size of 1 / (points seen so far), so
+  // centroids stabilize as they accumulate samples.
+  newCentroids = centroids;
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    const size_t cluster = assignments[i];
+    const double stepSize = 1.0 / (++clusterCounts[cluster]);
+    newCentroids.col(cluster) *= (1.0 - stepSize);
+    newCentroids.col(cluster) += stepSize * dataset.col(batch[i]);
+  }
+
+  // Report the cumulative counts; a cluster is only considered empty if it has
+  // never received a batch point.
+  counts = clusterCounts;
+
+  distanceCalculations += centroids.n_cols * batchSize;
+
+  // Calculate cluster distortion for this iteration.
+  double cNorm = 0.0;
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    cNorm += std::pow(metric.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -56,12 +56,36 @@ class NaiveKMeans
 
   size_t DistanceCalculations() const { return distanceCalculations; }
 
+  //! Get the cluster assignments from the last call to Iterate().  These are
+  //! used by EmptyClusterPolicy classes to avoid recomputing every
+  //! point-to-centroid distance when a cluster empties.
+  const arma::Row<size_t>& Assignments() const { return assignments; }
+  //! Get the distance of each point to its closest cluster from the last call
+  //! to Iterate().
+  const arma::vec& Distances() const { return distances; }
+
+  //! Get the instance weights used by Iterate() (empty means unweighted).
+  const arma::vec& Weights() const { return weights; }
+  //! Modify the instance weights used by Iterate().  When this is nonempty,
+  //! each point contributes its weight to the centroid update, so a point
+  //! with weight w behaves exactly like w copies of that point.
+  arma::vec& Weights() { return weights; }
+
  private:
   //! The dataset.
   const MatType& dataset;
   //! The instantiated metric.
   MetricType& metric;
 
+  //! Instance weights (empty means unweighted).
+  arma::vec weights;
+
+  //! Closest cluster of each point, from the last call to Iterate().
+  arma::Row<size_t> assignments;
+  //! Distance of each point to its closest cluster, from the last call to
+  //! Iterate().
+  arma::vec distances;
+
   //! Number of distance calculations.
   size_t distanceCalculations;
 };
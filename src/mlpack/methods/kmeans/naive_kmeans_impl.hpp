@@ -38,6 +38,13 @@ double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
 {
   newCentroids.zeros(centroids.n_rows, centroids.n_cols);
   counts.zeros(centroids.n_cols);
+  assignments.set_size(dataset.n_cols);
+  distances.set_size(dataset.n_cols);
+
+  const bool weighted = !weights.is_empty();
+  arma::vec weightSums;
+  if (weighted)
+    weightSums.zeros(centroids.n_cols);
 
   // Find the closest centroid to each point and update the new centroids.
   // Computed in parallel over the complete dataset
@@ -47,6 +54,9 @@ double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
     arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
         arma::fill::zeros);
     arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+    arma::vec localWeightSums;
+    if (weighted)
+      localWeightSums.zeros(centroids.n_cols);
 
     #pragma omp for
     for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
@@ -68,8 +78,23 @@ double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
 
       Log::Assert(closestCluster != centroids.n_cols);
 
-      // We now have the minimum distance centroid index.  Update that centroid.
-      localCentroids.unsafe_col(closestCluster) += dataset.col(i);
+      // Cache the result, so that an EmptyClusterPolicy does not have to
+      // recompute it.
+      assignments[i] = closestCluster;
+      distances[i] = minDistance;
+
+      // We now have the minimum distance centroid index.  Update that
+      // centroid; with instance weights, each point contributes its weight.
+      if (weighted)
+      {
+        localCentroids.unsafe_col(closestCluster) +=
+            weights[i] * dataset.col(i);
+        localWeightSums(closestCluster) += weights[i];
+      }
+      else
+      {
+        localCentroids.unsafe_col(closestCluster) += dataset.col(i);
+      }
       localCounts(closestCluster)++;
     }
     // Combine calculated state from each thread
@@ -77,13 +102,24 @@ double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
     {
       newCentroids += localCentroids;
       counts += localCounts;
+      if (weighted)
+        weightSums += localWeightSums;
     }
   }
 
   // Now normalize the centroid.
   for (size_t i = 0; i < centroids.n_cols; ++i)
-    if (counts(i) != 0)
+  {
+    if (weighted)
+    {
+      if (weightSums(i) > 0.0)
+        newCentroids.col(i) /= weightSums(i);
+    }
+    else if (counts(i) != 0)
+    {
       newCentroids.col(i) /= counts(i);
+    }
+  }
 
   distanceCalculations += centroids.n_cols * dataset.n_cols;
 
@@ -61,6 +61,7 @@ double PellegMooreKMeans<MetricType, MatType>::Iterate(
   traverser.Traverse(0, *tree);
 
   distanceCalculations += rules.DistanceCalculations();
+  Log::Info << "Traversal statistics: " << rules.TraversalStats() << std::endl;
 
   // Now, calculate how far the clusters moved, after normalizing them.
   double residual = 0.0;
@@ -14,6 +14,8 @@
 #ifndef MLPACK_METHODS_KMEANS_PELLEG_MOORE_KMEANS_RULES_HPP
 #define MLPACK_METHODS_KMEANS_PELLEG_MOORE_KMEANS_RULES_HPP
 
+#include <mlpack/core/tree/traversal_statistics.hpp>
+
 namespace mlpack {
 namespace kmeans {
 
@@ -85,6 +87,11 @@ class PellegMooreKMeansRules
   //! Modify the number of distance calculations that have been performed.
   size_t& DistanceCalculations() { return distanceCalculations; }
 
+  //! Get the full set of traversal statistics.
+  const tree::TraversalStatistics& TraversalStats() const { return stats; }
+  //! Modify the full set of traversal statistics.
+  tree::TraversalStatistics& TraversalStats() { return stats; }
+
  private:
   //! The dataset.
   const typename TreeType::Mat& dataset;
@@ -99,6 +106,8 @@ class PellegMooreKMeansRules
 
   //! The number of O(d) distance calculations that have been performed.
   size_t distanceCalculations;
+  //! Traversal counters (scores, prunes, blacklist additions).
+  tree::TraversalStatistics stats;
 };
 
 } // namespace kmeans
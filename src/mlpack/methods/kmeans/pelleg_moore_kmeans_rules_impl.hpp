@@ -61,6 +61,8 @@ double PellegMooreKMeansRules<MetricType, TreeType>::Score(
     referenceNode.Stat().Blacklist() =
         referenceNode.Parent()->Stat().Blacklist();
 
+  ++stats.Scores();
+
   // The query index is a fake index that we won't use, and the reference node
   // holds all of the points in the dataset.  Our goal is to determine whether
   // or not this node is dominated by a single cluster.
@@ -123,6 +125,10 @@ double PellegMooreKMeansRules<MetricType, TreeType>::Score(
     }
   }
 
+  // Each blacklist addition tightens the set of clusters this node (and its
+  // descendants) must consider.
+  stats.BoundUpdates() += newBlacklisted;
+
   if (whitelisted - newBlacklisted == 1)
   {
     // This node is dominated by the closest cluster.
@@ -130,10 +136,12 @@ double PellegMooreKMeansRules<MetricType, TreeType>::Score(
     newCentroids.col(closestCluster) += referenceNode.NumDescendants() *
         referenceNode.Stat().Centroid();
 
+    ++stats.ScorePrunes();
     return DBL_MAX;
   }
 
   // Perform the base case here.
+  stats.BaseCases() += referenceNode.NumPoints();
   for (size_t i = 0; i < referenceNode.NumPoints(); ++i)
   {
     size_t bestCluster = centroids.n_cols;
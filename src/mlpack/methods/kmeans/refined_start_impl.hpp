@@ -26,16 +26,22 @@ void RefinedStart::Cluster(const MatType& data,
                            const size_t clusters,
                            arma::mat& centroids) const
 {
-  // This will hold the sampled datasets.
+  // The number of points in each sampled dataset.
   const size_t numPoints = size_t(percentage * data.n_cols);
-  MatType sampledData(data.n_rows, numPoints);
   // vector<bool> is packed so each bool is 1 bit.
   std::vector<bool> pointsUsed(data.n_cols, false);
   arma::mat sampledCentroids(data.n_rows, samplings * clusters);
 
+  // The subsample clusterings are independent of each other, so they can be
+  // run in parallel.  Draw all of the needed random numbers up front (the
+  // indices of each subsample and the initial centroids of each clustering),
+  // so that the global random number generator is not used from multiple
+  // threads.
+  arma::Mat<size_t> sampleIndices(numPoints, samplings);
+  arma::mat initialCentroids(data.n_rows, samplings * clusters);
   for (size_t i = 0; i < samplings; ++i)
   {
-    // First, assemble the sampled dataset.
+    // First, select the points for the sampled dataset.
     size_t curSample = 0;
     while (curSample < numPoints)
     {
@@ -46,24 +52,45 @@ void RefinedStart::Cluster(const MatType& data,
       {
         // This point isn't used yet.  So we'll put it in our sample.
         pointsUsed[sample] = true;
-        sampledData.col(curSample) = data.col(sample);
+        sampleIndices(curSample, i) = sample;
         ++curSample;
       }
     }
 
-    // Now, using the sampled dataset, run k-means.  In the case of an empty
-    // cluster, we re-initialize that cluster as the point furthest away from
-    // the cluster with maximum variance.  This is not *exactly* what the paper
-    // implements, but it is quite similar, and we'll call it "good enough".
-    KMeans<> kmeans;
-    kmeans.Cluster(sampledData, clusters, centroids);
-
-    // Store the sampled centroids.
-    sampledCentroids.cols(i * clusters, (i + 1) * clusters - 1) = centroids;
+    // Sample the initial centroids from the subsample, just as
+    // SampleInitialization would.
+    for (size_t j = 0; j < clusters; ++j)
+    {
+      initialCentroids.col(i * clusters + j) =
+          data.col(sampleIndices(math::RandInt(numPoints), i));
+    }
 
     pointsUsed.assign(data.n_cols, false);
   }
 
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) samplings; ++i)
+  {
+    // Assemble the sampled dataset.
+    MatType sampledData(data.n_rows, numPoints);
+    for (size_t j = 0; j < numPoints; ++j)
+      sampledData.col(j) = data.col(sampleIndices(j, i));
+
+    // Now, using the sampled dataset, run k-means from the initial centroids
+    // drawn above.  In the case of an empty cluster, we re-initialize that
+    // cluster as the point furthest away from the cluster with maximum
+    // variance.  This is not *exactly* what the paper implements, but it is
+    // quite similar, and we'll call it "good enough".
+    arma::mat sampleCentroids = initialCentroids.cols(i * clusters,
+        (i + 1) * clusters - 1);
+    KMeans<> kmeans;
+    kmeans.Cluster(sampledData, clusters, sampleCentroids, true);
+
+    // Store the sampled centroids; each sampling writes to its own columns.
+    sampledCentroids.cols(i * clusters, (i + 1) * clusters - 1) =
+        sampleCentroids;
+  }
+
   // Now, we run k-means on the sampled centroids to get our final clusters.
   KMeans<> kmeans;
   kmeans.Cluster(sampledCentroids, clusters, centroids);
@@ -0,0 +1,129 @@
+/**
+ * @file methods/kmeans/streaming_kmeans_plus_plus.hpp
+ *
+ * An initial partitioning policy that runs the k-means++ seeding on a
+ * reservoir sample of the dataset, over-seeding and then reducing to the
+ * requested number of clusters.  Because the dataset is read in a single
+ * sequential pass, this is suitable for datasets that are streamed or do not
+ * fit in memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_STREAMING_KMEANS_PLUS_PLUS_HPP
+#define MLPACK_METHODS_KMEANS_STREAMING_KMEANS_PLUS_PLUS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+#include "kmeans.hpp"
+#include "kmeans_plus_plus_initialization.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * An initial partitioning policy meant for datasets that are too large for the
+ * exact k-means++ seeding, which makes k full passes over the data.  This
+ * policy instead makes a single sequential pass, maintaining a uniform
+ * reservoir sample of the dataset; then it over-seeds by running the k-means++
+ * seeding on the reservoir to select more centers than requested, and finally
+ * clusters those centers down to the requested number of clusters (in the
+ * spirit of the k-means|| reduction step).
+ *
+ * The reservoir size bounds both the memory use and the cost of the seeding,
+ * independently of the dataset size.
+ */
+class StreamingKMeansPlusPlus
+{
+ public:
+  /**
+   * Create the StreamingKMeansPlusPlus object, optionally specifying the size
+   * of the reservoir sample and the over-seeding factor (how many candidate
+   * centers are selected for each requested cluster).
+   */
+  StreamingKMeansPlusPlus(const size_t reservoirSize = 1000,
+                          const double overseeding = 3.0) :
+      reservoirSize(reservoirSize), overseeding(overseeding) { }
+
+  /**
+   * Initialize the centroids matrix by running the k-means++ seeding on a
+   * reservoir sample of the data, over-seeding and then reducing to the
+   * requested number of clusters.
+   *
+   * @tparam MatType Type of data (arma::mat or arma::sp_mat).
+   * @param data Dataset.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to put initial centroids into.
+   */
+  template<typename MatType>
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids) const
+  {
+    // Fill the reservoir with a uniform sample of the dataset in one
+    // sequential pass (Vitter's algorithm R): the first points fill the
+    // reservoir, and each later point i replaces a random reservoir element
+    // with probability m / (i + 1).
+    const size_t m = std::min(reservoirSize, (size_t) data.n_cols);
+    arma::mat reservoir(data.n_rows, m);
+    for (size_t i = 0; i < m; ++i)
+      reservoir.col(i) = data.col(i);
+    for (size_t i = m; i < data.n_cols; ++i)
+    {
+      const size_t j = (size_t) math::RandInt(i + 1);
+      if (j < m)
+        reservoir.col(j) = data.col(i);
+    }
+
+    // Now over-seed with the k-means++ strategy on the reservoir.  We cannot
+    // select more seeds than there are points in the reservoir.
+    const size_t seeds = std::min(m,
+        std::max(clusters, (size_t) (overseeding * clusters)));
+    arma::mat seedCentroids;
+    KMeansPlusPlusInitialization::Cluster(reservoir, seeds, seedCentroids);
+
+    if (seeds <= clusters)
+    {
+      centroids = std::move(seedCentroids);
+      return;
+    }
+
+    // Reduce the over-seeded centers to the requested number of clusters by
+    // clustering them, the same way RefinedStart reduces its sampled
+    // centroids.
+    KMeans<> kmeans;
+    kmeans.Cluster(seedCentroids, clusters, centroids);
+  }
+
+  //! Get the size of the reservoir sample.
+  size_t ReservoirSize() const { return reservoirSize; }
+  //! Modify the size of the reservoir sample.
+  size_t& ReservoirSize() { return reservoirSize; }
+
+  //! Get the over-seeding factor.
+  double Overseeding() const { return overseeding; }
+  //! Modify the over-seeding factor.
+  double& Overseeding() { return overseeding; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(reservoirSize));
+    ar(CEREAL_NVP(overseeding));
+  }
+
+ private:
+  //! The number of points held in the reservoir sample.
+  size_t reservoirSize;
+  //! The number of candidate centers selected for each requested cluster.
+  double overseeding;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
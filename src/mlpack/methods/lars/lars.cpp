@@ -484,6 +484,46 @@ void LARS::Predict(const arma::mat& points,
     predictions = betaPath.back().t() * points;
 }
 
+void LARS::PathSolutions(const arma::vec& lambdas, arma::mat& betaGrid) const
+{
+  if (betaPath.empty())
+  {
+    throw std::runtime_error("LARS::PathSolutions(): the model is not "
+        "trained; call Train() first!");
+  }
+
+  betaGrid.set_size(betaPath.front().n_elem, lambdas.n_elem);
+
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+  {
+    const double lambda = lambdas(i);
+
+    // lambdaPath is decreasing; clamp grid values outside the traced range.
+    if (lambda >= lambdaPath.front())
+    {
+      betaGrid.col(i) = betaPath.front();
+      continue;
+    }
+    else if (lambda <= lambdaPath.back())
+    {
+      betaGrid.col(i) = betaPath.back();
+      continue;
+    }
+
+    // Find the path segment bracketing this lambda, then interpolate linearly
+    // between its endpoints (the path is piecewise linear in lambda).
+    size_t j = 0;
+    while (lambdaPath[j + 1] > lambda)
+      ++j;
+
+    const double high = lambdaPath[j];
+    const double low = lambdaPath[j + 1];
+    const double interp = (high - lambda) / (high - low);
+
+    betaGrid.col(i) = (1 - interp) * betaPath[j] + interp * betaPath[j + 1];
+  }
+}
+
 // Private functions.
 void LARS::Deactivate(const size_t activeVarInd)
 {
@@ -249,6 +249,23 @@ class LARS
                arma::rowvec& predictions,
                const bool rowMajor = false) const;
 
+  /**
+   * Compute the solution coefficients for a whole grid of lambda1 values from
+   * a single trained model.  Because the LARS solution path is piecewise
+   * linear in lambda1, any solution between two vertices of the traced path
+   * can be recovered exactly by linear interpolation; there is no need to
+   * retrain (and refactorize the Gram matrix) once per lambda.  To sweep over
+   * the entire path, train with lambda1 = 0; the path is only traced down to
+   * the lambda1 the model was trained with, and grid values below it will
+   * return the solution at that endpoint.  Grid values above the largest
+   * absolute correlation return the all-zero solution.
+   *
+   * @param lambdas Values of lambda1 to compute solutions for.
+   * @param betaGrid Matrix to store the solutions in; column i will hold the
+   *     coefficients for lambdas(i).
+   */
+  void PathSolutions(const arma::vec& lambdas, arma::mat& betaGrid) const;
+
   //! Get the L1 regularization coefficient.
   double Lambda1() const { return lambda1; }
   //! Modify the L1 regularization coefficient.
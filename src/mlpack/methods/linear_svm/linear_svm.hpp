@@ -223,7 +223,11 @@ class LinearSVM
                          const arma::Row<size_t>& testLabels) const;
 
   /**
-   * Train the Linear SVM with the given training data.
+   * Train the Linear SVM with the given training data.  If the model has
+   * already been trained on data with the same dimensionality and number of
+   * classes, optimization continues from the current parameters (a warm
+   * start); this makes repeated retraining on slightly changed data much
+   * cheaper than training from scratch.
    *
    * @tparam OptimizerType Desired optimizer.
    * @tparam CallbackTypes Types of Callback Functions.
@@ -243,7 +247,11 @@ class LinearSVM
                CallbackTypes&&... callbacks);
 
   /**
-   * Train the Linear SVM with the given training data.
+   * Train the Linear SVM with the given training data.  If the model has
+   * already been trained on data with the same dimensionality and number of
+   * classes, optimization continues from the current parameters (a warm
+   * start); this makes repeated retraining on slightly changed data much
+   * cheaper than training from scratch.
    *
    * @tparam OptimizerType Desired optimizer.
    * @param data Input training features. Each column associate with one sample.
@@ -258,6 +266,50 @@ class LinearSVM
                const size_t numClasses = 2,
                OptimizerType optimizer = OptimizerType());
 
+  /**
+   * Train the Linear SVM with the given training data and per-instance
+   * weights.  A point with weight w contributes to the hinge loss and
+   * gradient exactly like w copies of that point, so importance can be
+   * expressed without physically replicating columns of the dataset.
+   *
+   * @tparam OptimizerType Desired optimizer.
+   * @param data Input training features. Each column associate with one sample.
+   * @param labels Labels associated with the feature data.
+   * @param numClasses Number of classes for classification.
+   * @param instanceWeights Instance weight of each point.
+   * @param optimizer Desired optimizer.
+   * @return Objective value of the final point.
+   */
+  template <typename OptimizerType = ens::L_BFGS>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const arma::rowvec& instanceWeights,
+               OptimizerType optimizer = OptimizerType());
+
+  /**
+   * Train the Linear SVM with the given training data and per-instance
+   * weights, passing the given callbacks to the optimizer.
+   *
+   * @tparam OptimizerType Desired optimizer.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param data Input training features. Each column associate with one sample.
+   * @param labels Labels associated with the feature data.
+   * @param numClasses Number of classes for classification.
+   * @param instanceWeights Instance weight of each point.
+   * @param optimizer Desired optimizer.
+   * @param callbacks Callback Functions.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return Objective value of the final point.
+   */
+  template <typename OptimizerType = ens::L_BFGS, typename... CallbackTypes>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const arma::rowvec& instanceWeights,
+               OptimizerType optimizer,
+               CallbackTypes&&... callbacks);
+
 
   //! Sets the number of classes.
   size_t& NumClasses() { return numClasses; }
@@ -45,6 +45,28 @@ class LinearSVMFunction
                     const double delta = 1.0,
                     const bool fitIntercept = false);
 
+  /**
+   * Construct the Linear SVM objective function with per-instance weights.  A
+   * point with weight w contributes to the hinge loss and gradient exactly
+   * like w copies of that point; the regularization term is not affected by
+   * the weights.
+   *
+   * @param dataset Input training data, each column associate with one sample
+   * @param labels Labels associated with the feature data.
+   * @param numClasses Number of classes for classification.
+   * @param instanceWeights Instance weight of each point.
+   * @param lambda L2-regularization constant.
+   * @param delta Margin of difference between correct class and other classes.
+   * @param fitIntercept Intercept term flag.
+   */
+  LinearSVMFunction(const MatType& dataset,
+                    const arma::Row<size_t>& labels,
+                    const size_t numClasses,
+                    const arma::rowvec& instanceWeights,
+                    const double lambda = 0.0001,
+                    const double delta = 1.0,
+                    const bool fitIntercept = false);
+
   /**
    * Shuffle the dataset.
    */
@@ -175,6 +197,9 @@ class LinearSVMFunction
   //! Gets the intercept flag.
   bool FitIntercept() const { return fitIntercept; }
 
+  //! Return the vector of instance weights.
+  const arma::rowvec& InstanceWeights() const { return instanceWeights; }
+
   //! Return the number of functions.
   size_t NumFunctions() const;
 
@@ -188,6 +213,12 @@ class LinearSVMFunction
   //! The datapoints for training.
   MatType dataset;
 
+  //! The instance weight of each point (all ones when unweighted).
+  arma::rowvec instanceWeights;
+
+  //! The sum of all instance weights (the effective number of points).
+  double totalWeight;
+
   //! Number of Classes.
   size_t numClasses;
 
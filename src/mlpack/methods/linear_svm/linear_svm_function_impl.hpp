@@ -37,6 +37,42 @@ LinearSVMFunction<MatType>::LinearSVMFunction(
     delta(delta),
     fitIntercept(fitIntercept)
 {
+  // Without instance weights, every point counts once.
+  instanceWeights.ones(dataset.n_cols);
+  totalWeight = (double) dataset.n_cols;
+
+  InitializeWeights(initialPoint, dataset.n_rows, numClasses, fitIntercept);
+  initialPoint *= 0.005;
+
+  // Calculate the label matrix.
+  GetGroundTruthMatrix(labels, groundTruth);
+}
+
+template <typename MatType>
+LinearSVMFunction<MatType>::LinearSVMFunction(
+    const MatType& dataset,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& instanceWeights,
+    const double lambda,
+    const double delta,
+    const bool fitIntercept) :
+    dataset(math::MakeAlias(const_cast<MatType&>(dataset), false)),
+    instanceWeights(instanceWeights),
+    numClasses(numClasses),
+    lambda(lambda),
+    delta(delta),
+    fitIntercept(fitIntercept)
+{
+  if (instanceWeights.n_elem != dataset.n_cols)
+  {
+    Log::Fatal << "LinearSVMFunction(): number of instance weights ("
+        << instanceWeights.n_elem << ") does not match number of points ("
+        << dataset.n_cols << ")!" << std::endl;
+  }
+
+  totalWeight = arma::accu(instanceWeights);
+
   InitializeWeights(initialPoint, dataset.n_rows, numClasses, fitIntercept);
   initialPoint *= 0.005;
 
@@ -119,6 +155,10 @@ void LinearSVMFunction<MatType>::Shuffle()
   math::ClearAlias(dataset);
   dataset = std::move(newData);
 
+  // The instance weights must follow their points.
+  arma::rowvec newWeights = instanceWeights.cols(ordering);
+  instanceWeights = std::move(newWeights);
+
   // Assemble data for batch constructor.  We need reverse orderings though...
   arma::uvec reverseOrdering(ordering.n_elem);
   for (size_t i = 0; i < ordering.n_elem; ++i)
@@ -152,39 +192,64 @@ double LinearSVMFunction<MatType>::Evaluate(
   // Calculate the loss and regularization terms.
   // L_i = Σ_i Σ_m max(0, Δ + (w_m x_i + b_m) - (w_{y_i} x_i + b_{y_i}))
   // where (m != y_i)
-  double loss, regularization;
-
-  // Scores for each class are evaluated.
-  arma::mat scores;
-
-  // Check intercept condition.
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset;
-  }
-  else
+  double loss = 0.0, regularization;
+
+  // Partition the dataset into one column block per thread, so that the score
+  // and margin matrices are only ever materialized blockwise.
+  #ifdef HAS_OPENMP
+  const size_t numBlocks = (size_t) omp_get_max_threads();
+  #else
+  const size_t numBlocks = 1;
+  #endif
+  const size_t blockSize = (dataset.n_cols + numBlocks - 1) / numBlocks;
+
+  #pragma omp parallel for schedule(static) reduction(+:loss)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
   {
-    // When using `fitIntercept` we need to add the `b_i` term explicitly.
-    // The first `parameters.n_rows - 1` rows of parameters holds the value
-    // of Weights `w_i`, and the last row holds `b_i`.
-    // On calculating the score, we add `b_i` term to each element of
-    // `i_th` row of `scores`.
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
+    const size_t firstId = block * blockSize;
+    if (firstId >= dataset.n_cols)
+      continue;
+    const size_t lastId = std::min(firstId + blockSize,
+        (size_t) dataset.n_cols) - 1;
+
+    // Scores for each class are evaluated.
+    arma::mat scores;
+
+    // Check intercept condition.
+    if (!fitIntercept)
+    {
+      scores = parameters.t() * dataset.cols(firstId, lastId);
+    }
+    else
+    {
+      // When using `fitIntercept` we need to add the `b_i` term explicitly.
+      // The first `parameters.n_rows - 1` rows of parameters holds the value
+      // of Weights `w_i`, and the last row holds `b_i`.
+      // On calculating the score, we add `b_i` term to each element of
+      // `i_th` row of `scores`.
+      scores = parameters.rows(0, dataset.n_rows - 1).t()
+          * dataset.cols(firstId, lastId)
+          + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
+          lastId - firstId + 1);
+    }
+
+    // Evaluate the margin by the following steps:
+    //  - Subtracting the score of correct class from all the class scores.
+    //  - Adding the margin parameter `delta`.
+    //  - Removing the `delta` parameter from correct class label in each
+    //    column.
+    arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
+        * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
+        + delta - (delta * groundTruth.cols(firstId, lastId));
+
+    // The Hinge Loss Function, with each point's loss scaled by its instance
+    // weight.
+    arma::mat hinge = arma::clamp(margin, 0.0, DBL_MAX);
+    hinge.each_row() %= instanceWeights.subvec(firstId, lastId);
+    loss += arma::accu(hinge);
   }
 
-  // Evaluate the margin by the following steps:
-  //  - Subtracting the score of correct class from all the class scores.
-  //  - Adding the margin parameter `delta`.
-  //  - Removing the `delta` parameter from correct class label in each
-  //    column.
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth), numClasses, 1)) + delta
-      - (delta * groundTruth);
-
-  // The Hinge Loss Function
-  loss = arma::accu(arma::clamp(margin, 0.0, DBL_MAX)) / dataset.n_cols;
+  loss /= totalWeight;
 
   // Adding the regularization term.
   regularization = 0.5 * lambda * arma::dot(parameters, parameters);
@@ -223,9 +288,12 @@ double LinearSVMFunction<MatType>::Evaluate(
       * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
       + delta - (delta * groundTruth.cols(firstId, lastId));
 
-  // The Hinge Loss Function
-  loss = arma::accu(arma::clamp(margin, 0.0, DBL_MAX));
-  loss /= batchSize;
+  // The Hinge Loss Function, averaged over the total instance weight of the
+  // batch.
+  arma::mat hinge = arma::clamp(margin, 0.0, DBL_MAX);
+  hinge.each_row() %= instanceWeights.subvec(firstId, lastId);
+  loss = arma::accu(hinge);
+  loss /= arma::accu(instanceWeights.subvec(firstId, lastId));
 
   // Adding the regularization term.
   regularization = 0.5 * lambda * arma::dot(parameters, parameters);
@@ -245,54 +313,90 @@ void LinearSVMFunction<MatType>::Gradient(
   // So, we focus of these positive elements and reduce them.
   // Also, we need to increase the score of the correct class.
 
-  // Scores for each class are evaluated.
-  arma::mat scores;
+  // The gradient is a sum over points, so each thread can process its own
+  // column block with a thread-local accumulator and the results can be
+  // merged at the end.
+  #ifdef HAS_OPENMP
+  const size_t numBlocks = (size_t) omp_get_max_threads();
+  #else
+  const size_t numBlocks = 1;
+  #endif
+  const size_t blockSize = (dataset.n_cols + numBlocks - 1) / numBlocks;
 
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset;
-  }
-  else
-  {
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
-  }
+  gradient.zeros(arma::size(parameters));
 
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth), numClasses, 1)) + delta
-      - (delta * groundTruth);
-
-  // An element of `mask` matrix holds `1` corresponding to
-  // each positive element of `margin` matrix.
-  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
-      { val = (val > 0) ? 1: 0; });
-
-  arma::mat difference = groundTruth
-      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
-
-  // The gradient is evaluated as follows:
-  //  - Add `x_i` to `w_j` if `margin_i_m`is positive.
-  //  - Subtract `x_i` from `w_y_i` for each positive
-  //    `margin_i_j`.
-  //  - Take the average over the size of dataset.
-  //  - Add the regularization parameter.
-
-  // Check intercept condition
-  if (!fitIntercept)
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
   {
-    gradient = dataset * difference.t();
-  }
-  else
-  {
-    gradient.set_size(arma::size(parameters));
-    gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-        dataset * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-        arma::ones<arma::rowvec>(dataset.n_cols) * difference.t();
+    const size_t firstId = block * blockSize;
+    if (firstId >= dataset.n_cols)
+      continue;
+    const size_t lastId = std::min(firstId + blockSize,
+        (size_t) dataset.n_cols) - 1;
+
+    // Scores for each class are evaluated.
+    arma::mat scores;
+
+    if (!fitIntercept)
+    {
+      scores = parameters.t() * dataset.cols(firstId, lastId);
+    }
+    else
+    {
+      scores = parameters.rows(0, dataset.n_rows - 1).t()
+          * dataset.cols(firstId, lastId)
+          + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
+          lastId - firstId + 1);
+    }
+
+    arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
+        * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
+        + delta - (delta * groundTruth.cols(firstId, lastId));
+
+    // An element of `mask` matrix holds `1` corresponding to
+    // each positive element of `margin` matrix.
+    arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
+        { val = (val > 0) ? 1: 0; });
+
+    arma::mat difference = groundTruth.cols(firstId, lastId)
+        % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
+
+    // Scale each point's contribution by its instance weight.
+    difference.each_row() %= instanceWeights.subvec(firstId, lastId);
+
+    // The gradient is evaluated as follows:
+    //  - Add `x_i` to `w_j` if `margin_i_m`is positive.
+    //  - Subtract `x_i` from `w_y_i` for each positive
+    //    `margin_i_j`.
+    //  - Take the average over the size of dataset.
+    //  - Add the regularization parameter.
+
+    // Check intercept condition
+    if (!fitIntercept)
+    {
+      const arma::mat localGradient =
+          dataset.cols(firstId, lastId) * difference.t();
+
+      #pragma omp critical
+      gradient += localGradient;
+    }
+    else
+    {
+      const arma::mat localGradient =
+          dataset.cols(firstId, lastId) * difference.t();
+      const arma::rowvec localBias =
+          arma::ones<arma::rowvec>(lastId - firstId + 1) * difference.t();
+
+      #pragma omp critical
+      {
+        gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) +=
+            localGradient;
+        gradient.row(parameters.n_rows - 1) += localBias;
+      }
+    }
   }
 
-  gradient /= dataset.n_cols;
+  gradient /= totalWeight;
 
   // Adding the regularization contribution to the gradient.
   gradient += lambda * parameters;
@@ -335,6 +439,9 @@ void LinearSVMFunction<MatType>::Gradient(
   arma::mat difference = groundTruth.cols(firstId, lastId)
       % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
 
+  // Scale each point's contribution by its instance weight.
+  difference.each_row() %= instanceWeights.subvec(firstId, lastId);
+
   // Check intercept condition
   if (!fitIntercept)
   {
@@ -349,7 +456,7 @@ void LinearSVMFunction<MatType>::Gradient(
         arma::ones<arma::rowvec>(batchSize) * difference.t();
   }
 
-  gradient /= batchSize;
+  gradient /= arma::accu(instanceWeights.subvec(firstId, lastId));
 
   // Adding the regularization contribution to the gradient.
   gradient += lambda * parameters;
@@ -361,56 +468,96 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
     const arma::mat& parameters,
     GradType& gradient) const
 {
-  double loss, regularization, cost;
-
-  // Scores for each class are evaluated.
-  arma::mat scores;
-
-  if (!fitIntercept)
+  double loss = 0.0, regularization, cost;
+
+  // This is the fused entry point: the score matrix is computed once per
+  // column block and reused for both the loss and the gradient, with the
+  // blocks processed by different threads.
+  #ifdef HAS_OPENMP
+  const size_t numBlocks = (size_t) omp_get_max_threads();
+  #else
+  const size_t numBlocks = 1;
+  #endif
+  const size_t blockSize = (dataset.n_cols + numBlocks - 1) / numBlocks;
+
+  gradient.zeros(arma::size(parameters));
+
+  #pragma omp parallel for schedule(static) reduction(+:loss)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
   {
-    scores = parameters.t() * dataset;
+    const size_t firstId = block * blockSize;
+    if (firstId >= dataset.n_cols)
+      continue;
+    const size_t lastId = std::min(firstId + blockSize,
+        (size_t) dataset.n_cols) - 1;
+
+    // Scores for each class are evaluated.
+    arma::mat scores;
+
+    if (!fitIntercept)
+    {
+      scores = parameters.t() * dataset.cols(firstId, lastId);
+    }
+    else
+    {
+      scores = parameters.rows(0, dataset.n_rows - 1).t()
+          * dataset.cols(firstId, lastId)
+          + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
+          lastId - firstId + 1);
+    }
+
+    arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
+        * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
+        + delta - (delta * groundTruth.cols(firstId, lastId));
+
+    // For each sample, find the total number of classes where
+    // ( margin > 0 ).
+    arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
+        { val = (val > 0) ? 1: 0; });
+
+    arma::mat difference = groundTruth.cols(firstId, lastId)
+        % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
+
+    // Scale each point's contribution by its instance weight.
+    difference.each_row() %= instanceWeights.subvec(firstId, lastId);
+
+    // Check intercept condition
+    if (!fitIntercept)
+    {
+      const arma::mat localGradient =
+          dataset.cols(firstId, lastId) * difference.t();
+
+      #pragma omp critical
+      gradient += localGradient;
+    }
+    else
+    {
+      const arma::mat localGradient =
+          dataset.cols(firstId, lastId) * difference.t();
+      const arma::rowvec localBias =
+          arma::ones<arma::rowvec>(lastId - firstId + 1) * difference.t();
+
+      #pragma omp critical
+      {
+        gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) +=
+            localGradient;
+        gradient.row(parameters.n_rows - 1) += localBias;
+      }
+    }
+
+    // The Hinge Loss Function, with each point's loss scaled by its instance
+    // weight.
+    arma::mat hinge = arma::clamp(margin, 0.0, DBL_MAX);
+    hinge.each_row() %= instanceWeights.subvec(firstId, lastId);
+    loss += arma::accu(hinge);
   }
-  else
-  {
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
-  }
-
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth), numClasses, 1)) + delta
-      - (delta * groundTruth);
-
-  // For each sample, find the total number of classes where
-  // ( margin > 0 ).
-  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
-      { val = (val > 0) ? 1: 0; });
-
-  arma::mat difference = groundTruth
-      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
 
-  // Check intercept condition
-  if (!fitIntercept)
-  {
-    gradient = dataset * difference.t();
-  }
-  else
-  {
-    gradient.set_size(arma::size(parameters));
-    gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-            dataset * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-            arma::ones<arma::rowvec>(dataset.n_cols) * difference.t();
-  }
-
-  gradient /= dataset.n_cols;
+  gradient /= totalWeight;
 
   // Adding the regularization contribution to the gradient.
   gradient += lambda * parameters;
 
-  // The Hinge Loss Function
-  loss = arma::accu(arma::clamp(margin, 0.0, DBL_MAX));
-  loss /= dataset.n_cols;
+  loss /= totalWeight;
 
   // Adding the regularization term.
   regularization = 0.5 * lambda * arma::dot(parameters, parameters);
@@ -459,6 +606,9 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
   arma::mat difference = groundTruth.cols(firstId, lastId)
       % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
 
+  // Scale each point's contribution by its instance weight.
+  difference.each_row() %= instanceWeights.subvec(firstId, lastId);
+
   // Check intercept condition
   if (!fitIntercept)
   {
@@ -473,15 +623,18 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
         arma::ones<arma::rowvec>(batchSize) * difference.t();
   }
 
-  gradient /= batchSize;
+  gradient /= arma::accu(instanceWeights.subvec(firstId, lastId));
 
 
   // Adding the regularization contribution to the gradient.
   gradient += lambda * parameters;
 
-  // The Hinge Loss Function
-  loss = arma::accu(arma::clamp(margin.cols(firstId, lastId), 0.0, DBL_MAX));
-  loss /= batchSize;
+  // The Hinge Loss Function, averaged over the total instance weight of the
+  // batch.
+  arma::mat hinge = arma::clamp(margin.cols(firstId, lastId), 0.0, DBL_MAX);
+  hinge.each_row() %= instanceWeights.subvec(firstId, lastId);
+  loss = arma::accu(hinge);
+  loss /= arma::accu(instanceWeights.subvec(firstId, lastId));
 
   // Adding the regularization term.
   regularization = 0.5 * lambda * arma::dot(parameters, parameters);
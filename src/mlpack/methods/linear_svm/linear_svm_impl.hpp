@@ -99,9 +99,14 @@ double LinearSVM<MatType>::Train(
     throw std::invalid_argument("LinearSVM dataset has 0 number of classes!");
   }
 
+  this->numClasses = numClasses;
   LinearSVMFunction<MatType> svm(data, labels, numClasses, lambda, delta,
       fitIntercept);
-  if (parameters.is_empty())
+
+  // If the model has already been trained on data of the same shape, continue
+  // optimization from the current parameters (a warm start); otherwise start
+  // from a fresh initial point.
+  if (arma::size(parameters) != arma::size(svm.InitialPoint()))
     parameters = svm.InitialPoint();
 
   // Train the model.
@@ -128,9 +133,49 @@ double LinearSVM<MatType>::Train(
     throw std::invalid_argument("LinearSVM dataset has 0 number of classes!");
   }
 
+  this->numClasses = numClasses;
   LinearSVMFunction<MatType> svm(data, labels, numClasses, lambda, delta,
       fitIntercept);
-  if (parameters.is_empty())
+
+  // If the model has already been trained on data of the same shape, continue
+  // optimization from the current parameters (a warm start); otherwise start
+  // from a fresh initial point.
+  if (arma::size(parameters) != arma::size(svm.InitialPoint()))
+    parameters = svm.InitialPoint();
+
+  // Train the model.
+  Timer::Start("linear_svm_optimization");
+  const double out = optimizer.Optimize(svm, parameters);
+  Timer::Stop("linear_svm_optimization");
+
+  Log::Info << "LinearSVM::LinearSVM(): final objective of "
+            << "trained model is " << out << "." << std::endl;
+
+  return out;
+}
+
+template <typename MatType>
+template <typename OptimizerType>
+double LinearSVM<MatType>::Train(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& instanceWeights,
+    OptimizerType optimizer)
+{
+  if (numClasses <= 1)
+  {
+    throw std::invalid_argument("LinearSVM dataset has 0 number of classes!");
+  }
+
+  this->numClasses = numClasses;
+  LinearSVMFunction<MatType> svm(data, labels, numClasses, instanceWeights,
+      lambda, delta, fitIntercept);
+
+  // If the model has already been trained on data of the same shape, continue
+  // optimization from the current parameters (a warm start); otherwise start
+  // from a fresh initial point.
+  if (arma::size(parameters) != arma::size(svm.InitialPoint()))
     parameters = svm.InitialPoint();
 
   // Train the model.
@@ -144,6 +189,42 @@ double LinearSVM<MatType>::Train(
   return out;
 }
 
+template <typename MatType>
+template <typename OptimizerType, typename... CallbackTypes>
+double LinearSVM<MatType>::Train(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& instanceWeights,
+    OptimizerType optimizer,
+    CallbackTypes&&... callbacks)
+{
+  if (numClasses <= 1)
+  {
+    throw std::invalid_argument("LinearSVM dataset has 0 number of classes!");
+  }
+
+  this->numClasses = numClasses;
+  LinearSVMFunction<MatType> svm(data, labels, numClasses, instanceWeights,
+      lambda, delta, fitIntercept);
+
+  // If the model has already been trained on data of the same shape, continue
+  // optimization from the current parameters (a warm start); otherwise start
+  // from a fresh initial point.
+  if (arma::size(parameters) != arma::size(svm.InitialPoint()))
+    parameters = svm.InitialPoint();
+
+  // Train the model.
+  Timer::Start("linear_svm_optimization");
+  const double out = optimizer.Optimize(svm, parameters, callbacks...);
+  Timer::Stop("linear_svm_optimization");
+
+  Log::Info << "LinearSVM::LinearSVM(): final objective of "
+            << "trained model is " << out << "." << std::endl;
+
+  return out;
+}
+
 template <typename MatType>
 void LinearSVM<MatType>::Classify(
     const MatType& data,
@@ -95,6 +95,10 @@ class Constraints
   /**
    * Calculates k differently labeled nearest neighbors & distances to
    * impostors for each datapoint and writes them back to passed matrices.
+   * The result of the last full search is cached: if the same dataset is
+   * passed again (as happens when the LMNN objective and its gradient are
+   * evaluated at the same coordinates), the cached impostors are returned
+   * without searching.
    *
    * @param outputNeighbors Coordinates matrix to store impostors.
    * @param outputDistance matrix to store distance.
@@ -195,6 +199,15 @@ class Constraints
   //! Number of target neighbors & impostors to calulate.
   size_t k;
 
+  //! Query set of the most recent cached full impostor search.
+  arma::mat lastSearchDataset;
+
+  //! Cached impostor indices for lastSearchDataset.
+  arma::Mat<size_t> cachedNeighbors;
+
+  //! Cached impostor distances for lastSearchDataset.
+  arma::mat cachedDistances;
+
   //! Store unique labels.
   arma::Row<size_t> uniqueLabels;
 
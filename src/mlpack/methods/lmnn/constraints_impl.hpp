@@ -171,14 +171,27 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputMatrix,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
-
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
+  // Serve the result from the cache if the last full search ran on an
+  // identical dataset.
+  if (cachedNeighbors.n_rows == k &&
+      cachedNeighbors.n_cols == dataset.n_cols &&
+      lastSearchDataset.n_rows == dataset.n_rows &&
+      arma::approx_equal(lastSearchDataset, dataset, "absdiff", 0.0))
+  {
+    outputMatrix = cachedNeighbors;
+    return;
+  }
 
-  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
+  // Every class is searched independently and writes a disjoint set of output
+  // columns, so the classes are processed in parallel, each with its own KNN
+  // instance.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; ++i)
   {
+    KNN knn;
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Perform KNN search with differently labeled points as reference
     // set and  same class points as query set.
     knn.Train(dataset.cols(indexDiff[i]));
@@ -209,14 +222,28 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
-
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
+  // The optimizer often evaluates the objective and the gradient at the same
+  // coordinates; in that case the transformed dataset is unchanged and the
+  // previous search result is still valid.
+  if (cachedNeighbors.n_rows == k &&
+      cachedNeighbors.n_cols == dataset.n_cols &&
+      lastSearchDataset.n_rows == dataset.n_rows &&
+      arma::approx_equal(lastSearchDataset, dataset, "absdiff", 0.0))
+  {
+    outputNeighbors = cachedNeighbors;
+    outputDistance = cachedDistances;
+    return;
+  }
 
-  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
+  // The per-class searches are independent and write disjoint output columns,
+  // so they run in parallel, each with its own KNN instance.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; ++i)
   {
+    KNN knn;
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Perform KNN search with differently labeled points as reference
     // set and  same class points as query set.
     knn.Train(dataset.cols(indexDiff[i]));
@@ -234,6 +261,12 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
     outputNeighbors.cols(indexSame[i]) = neighbors;
     outputDistance.cols(indexSame[i]) = distances;
   }
+
+  // Remember this search so a repeated call with the same dataset can be
+  // answered from the cache.
+  lastSearchDataset = dataset;
+  cachedNeighbors = outputNeighbors;
+  cachedDistances = outputDistance;
 }
 
 // Calculates k differently labeled nearest neighbors on a
@@ -348,19 +381,17 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
-
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
-
-  // Vectors to store indices.
-  arma::uvec subIndexSame;
-
-  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
+  // Each point belongs to exactly one class, so the per-class searches write
+  // disjoint output columns and can run concurrently.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; ++i)
   {
+    KNN knn;
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Calculate impostors.
-    subIndexSame = arma::find(labels.cols(points.head(numPoints)) ==
+    arma::uvec subIndexSame = arma::find(labels.cols(points.head(numPoints)) ==
         uniqueLabels[i]);
 
     // Perform KNN search with differently labeled points as reference
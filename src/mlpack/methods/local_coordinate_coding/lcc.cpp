@@ -35,17 +35,15 @@ void LocalCoordinateCoding::Encode(const arma::mat& data, arma::mat& codes)
       * data);
 
   arma::mat dictGram = trans(dictionary) * dictionary;
-  arma::mat dictGramTD(dictGram.n_rows, dictGram.n_cols);
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    // Report progress.
-    if ((i % 100) == 0)
-    {
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
-    }
 
+  // The points are coded independently, just as in sparse coding: each
+  // iteration works on its own reweighted dictionary, Gram matrix, and LARS
+  // instance, and writes only its own column of the codes.
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
     arma::vec invW = invSqDists.unsafe_col(i);
     arma::mat dictPrime = dictionary * diagmat(invW);
 
@@ -183,19 +181,17 @@ void LocalCoordinateCoding::OptimizeDictionary(const arma::mat& data,
     arma::mat A = codesPrime * diagmat(wSquared) * trans(codesPrime);
     arma::mat B = codesPrime * diagmat(wSquared) * trans(dataPrime);
 
-    dictionary = trans(solve(A, B));
-    /*
-    dictionary = trans(solve(codesPrime * diagmat(wSquared) * trans(codesPrime),
-        codesPrime * diagmat(wSquared) * trans(dataPrime)));
-    */
+    SolveDictionarySystem(A, B, dictionary);
   }
   else
   {
     // Inactive atoms must be reinitialized randomly, so we cannot solve
     // directly for the entire dictionary estimate.
-    arma::mat dictionaryActive =
-      trans(solve(codesPrime * diagmat(wSquared) * trans(codesPrime),
-                  codesPrime * diagmat(wSquared) * trans(dataPrime)));
+    arma::mat A = codesPrime * diagmat(wSquared) * trans(codesPrime);
+    arma::mat B = codesPrime * diagmat(wSquared) * trans(dataPrime);
+
+    arma::mat dictionaryActive;
+    SolveDictionarySystem(A, B, dictionaryActive);
 
     // Update all atoms.
     size_t currentInactiveIndex = 0;
@@ -223,6 +219,29 @@ void LocalCoordinateCoding::OptimizeDictionary(const arma::mat& data,
   }
 }
 
+void LocalCoordinateCoding::SolveDictionarySystem(const arma::mat& A,
+                                                  const arma::mat& B,
+                                                  arma::mat& solution)
+{
+  // The system matrix is symmetric positive definite, so one Cholesky
+  // factorization plus two triangular solves does the job at roughly half
+  // the cost of a general LU-based solve.  Note that the factorization
+  // cannot usefully be carried across outer iterations: the codes are fully
+  // re-estimated each time, so successive system matrices have no low-rank
+  // relationship to exploit.
+  arma::mat R;
+  if (arma::chol(R, A))
+  {
+    solution = trans(solve(trimatu(R), solve(trimatl(trans(R)), B)));
+  }
+  else
+  {
+    // Fall back to a general solve if A is (numerically) not positive
+    // definite.
+    solution = trans(solve(A, B));
+  }
+}
+
 double LocalCoordinateCoding::Objective(const arma::mat& data,
                                         const arma::mat& codes,
                                         const arma::uvec& adjacencies) const
@@ -208,6 +208,19 @@ class LocalCoordinateCoding
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  /**
+   * Solve the (symmetric positive definite) dictionary system A D^T = B for
+   * the dictionary D via a Cholesky factorization, falling back to a general
+   * solve if the factorization fails.
+   *
+   * @param A System matrix (Z W Z^T; symmetric positive definite).
+   * @param B Right-hand side (Z W X^T).
+   * @param solution Will contain the solved dictionary (transposed solution).
+   */
+  static void SolveDictionarySystem(const arma::mat& A,
+                                    const arma::mat& B,
+                                    arma::mat& solution);
+
   //! Number of atoms in dictionary.
   size_t atoms;
 
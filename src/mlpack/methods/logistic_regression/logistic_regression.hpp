@@ -33,6 +33,10 @@ namespace regression {
  * class is restricted to support only two classes.  For multiclass logistic
  * regression, see mlpack::regression::SoftmaxRegression.
  *
+ * All of the const Classify() overloads are reentrant: they modify no state of
+ * the model and use no hidden scratch storage, so a single trained model may
+ * safely serve concurrent Classify() calls from multiple threads.
+ *
  * @tparam MatType Type of data matrix.
  */
 template<typename MatType = arma::mat>
@@ -114,7 +118,10 @@ class LogisticRegression
                      const double lambda);
 
   /**
-   * Train the LogisticRegression model on the given input data.  By default,
+   * Train the LogisticRegression model on the given input data.  If the model
+   * has already been trained on data with the same dimensionality, the
+   * current parameters are used as the initial point of the optimization (a
+   * warm start), so retraining on slightly changed data is cheap.  By default,
    * the L-BFGS optimization algorithm is used, but others can be specified
    * (such as ens::SGD).
    *
@@ -159,6 +166,54 @@ class LogisticRegression
                OptimizerType& optimizer,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the LogisticRegression model on the given input data with
+   * per-instance weights.  A point with weight w contributes to the objective
+   * and gradient exactly like w copies of that point, so importance can be
+   * expressed without physically replicating rows of the dataset.  By
+   * default, the L-BFGS optimization algorithm is used, but others can be
+   * specified (such as ens::SGD).
+   *
+   * This will use the existing model parameters as a starting point for the
+   * optimization.  If this is not what you want, then you should access the
+   * parameters vector directly with Parameters() and modify it as desired.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param weights Instance weight of each point.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error)
+   */
+  template<typename OptimizerType = ens::L_BFGS, typename... CallbackTypes>
+  double Train(const MatType& predictors,
+               const arma::Row<size_t>& responses,
+               const arma::rowvec& weights,
+               CallbackTypes&&... callbacks);
+
+  /**
+   * Train the LogisticRegression model on the given input data with
+   * per-instance weights, using the given instantiated optimizer.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param weights Instance weight of each point.
+   * @param optimizer Instantiated optimizer with instantiated error function.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error)
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double Train(const MatType& predictors,
+               const arma::Row<size_t>& responses,
+               const arma::rowvec& weights,
+               OptimizerType& optimizer,
+               CallbackTypes&&... callbacks);
+
   //! Return the parameters (the b vector).
   const arma::rowvec& Parameters() const { return parameters; }
   //! Modify the parameters (the b vector).
@@ -41,6 +41,22 @@ class LogisticRegressionFunction
                              const arma::Row<size_t>& responses,
                              const double lambda = 0);
 
+  /**
+   * Creates the LogisticRegressionFunction with per-instance weights.  A point
+   * with weight w contributes to the objective and gradient exactly like w
+   * copies of that point; the regularization term is not affected by the
+   * weights.
+   *
+   * @param predictors The matrix of data points.
+   * @param responses The measured data for each point in predictors.
+   * @param weights Instance weight of each point.
+   * @param lambda Regularization constant for ridge regression.
+   */
+  LogisticRegressionFunction(const MatType& predictors,
+                             const arma::Row<size_t>& responses,
+                             const arma::rowvec& weights,
+                             const double lambda = 0);
+
   //! Return the regularization parameter (lambda).
   const double& Lambda() const { return lambda; }
   //! Modify the regularization parameter (lambda).
@@ -50,9 +66,14 @@ class LogisticRegressionFunction
   const MatType& Predictors() const { return predictors; }
   //! Return the vector of responses.
   const arma::Row<size_t>& Responses() const { return responses; }
+  //! Return the vector of instance weights.
+  const arma::rowvec& Weights() const { return weights; }
 
   /**
-  * Shuffle the order of function visitation.  This may be called by the optimizer.
+  * Shuffle the order of function visitation.  This may be called by the
+  * optimizer.  Only a permutation of indices is generated; the dataset itself
+  * is never copied or reordered, and mini-batches are gathered through the
+  * permutation on demand.
   */
   void Shuffle();
 
@@ -159,12 +180,17 @@ class LogisticRegressionFunction
   size_t NumFeatures() const { return predictors.n_rows + 1; }
 
  private:
-  //! The matrix of data points (predictors).  This is an alias until shuffling
-  //! is done.
+  //! The matrix of data points (predictors).  This is an alias and is never
+  //! modified.
   MatType predictors;
-  //! The vector of responses to the input data points.  This is an alias until
-  //! shuffling is done.
+  //! The vector of responses to the input data points.  This is an alias and
+  //! is never modified.
   arma::Row<size_t> responses;
+  //! The instance weight of each point (all ones when unweighted).
+  arma::rowvec weights;
+  //! The visitation ordering of the points; empty until Shuffle() is called,
+  //! which denotes the identity ordering.
+  arma::uvec ordering;
   //! The regularization parameter for L2-regularization.
   double lambda;
 };
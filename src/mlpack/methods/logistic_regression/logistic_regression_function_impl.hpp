@@ -29,6 +29,7 @@ LogisticRegressionFunction<MatType>::LogisticRegressionFunction(
     predictors(math::MakeAlias(const_cast<MatType&>(predictors), false)),
     responses(math::MakeAlias(const_cast<arma::Row<size_t>&>(responses),
         false)),
+    weights(predictors.n_cols, arma::fill::ones),
     lambda(lambda)
 {
   // Sanity check.
@@ -41,24 +42,47 @@ LogisticRegressionFunction<MatType>::LogisticRegressionFunction(
   }
 }
 
+template<typename MatType>
+LogisticRegressionFunction<MatType>::LogisticRegressionFunction(
+    const MatType& predictors,
+    const arma::Row<size_t>& responses,
+    const arma::rowvec& weights,
+    const double lambda) :
+    // We promise to be well-behaved... the elements won't be modified.
+    predictors(math::MakeAlias(const_cast<MatType&>(predictors), false)),
+    responses(math::MakeAlias(const_cast<arma::Row<size_t>&>(responses),
+        false)),
+    weights(weights),
+    lambda(lambda)
+{
+  // Sanity check.
+  if (responses.n_elem != predictors.n_cols)
+  {
+    Log::Fatal << "LogisticRegressionFunction::LogisticRegressionFunction(): "
+        << "predictors matrix has " << predictors.n_cols << " points, but "
+        << "responses vector has " << responses.n_elem << " elements (should be"
+        << " " << predictors.n_cols << ")!" << std::endl;
+  }
+  if (weights.n_elem != predictors.n_cols)
+  {
+    Log::Fatal << "LogisticRegressionFunction::LogisticRegressionFunction(): "
+        << "predictors matrix has " << predictors.n_cols << " points, but "
+        << "weights vector has " << weights.n_elem << " elements (should be "
+        << predictors.n_cols << ")!" << std::endl;
+  }
+}
+
 /**
- * Shuffle the datapoints.
+ * Shuffle the order of visitation of the datapoints.
  */
 template<typename MatType>
 void LogisticRegressionFunction<MatType>::Shuffle()
 {
-  MatType newPredictors;
-  arma::Row<size_t> newResponses;
-
-  math::ShuffleData(predictors, responses, newPredictors, newResponses);
-
-  // If we are an alias, make sure we don't write to the original data.
-  math::ClearAlias(predictors);
-  math::ClearAlias(responses);
-
-  // Take ownership of the new data.
-  predictors = std::move(newPredictors);
-  responses = std::move(newResponses);
+  // Only a permutation of indices is generated; materializing a shuffled copy
+  // of the dataset would cost a full copy of the data every epoch.  The batch
+  // Evaluate() and Gradient() functions gather their batches through this
+  // ordering on demand.
+  ordering = math::ShuffleOrdering(predictors.n_cols);
 }
 
 /**
@@ -93,7 +117,7 @@ double LogisticRegressionFunction<MatType>::Evaluate(
   // terms for computational efficiency.  Note that the conversion causes some
   // copy and slowdown, but this is so negligible compared to the rest of the
   // calculation it is not worth optimizing for.
-  const double result = arma::accu(arma::log(1.0 -
+  const double result = arma::accu(weights % arma::log(1.0 -
       arma::conv_to<arma::rowvec>::from(responses) + sigmoid %
       (2 * arma::conv_to<arma::rowvec>::from(responses) - 1.0)));
 
@@ -117,16 +141,22 @@ double LogisticRegressionFunction<MatType>::Evaluate(
       arma::dot(parameters.tail_cols(parameters.n_elem - 1),
                 parameters.tail_cols(parameters.n_elem - 1));
 
+  // Gather the batch in the current visitation ordering.
+  MatType batchPredictors;
+  arma::Row<size_t> batchResponses;
+  arma::rowvec batchWeights;
+  math::OrderedBatch(predictors, ordering, begin, batchSize, batchPredictors);
+  math::OrderedBatch(responses, ordering, begin, batchSize, batchResponses);
+  math::OrderedBatch(weights, ordering, begin, batchSize, batchWeights);
+
   // Calculate the sigmoid function values.
   const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1))));
+      parameters.tail_cols(parameters.n_elem - 1) * batchPredictors)));
 
   // Compute the objective for the given batch size from a given point.
-  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
-      begin + batchSize - 1));
-  const double result = arma::accu(arma::log(1.0 - respD + sigmoid %
-      (2 * respD - 1.0)));
+  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(batchResponses);
+  const double result = arma::accu(batchWeights % arma::log(1.0 - respD +
+      sigmoid % (2 * respD - 1.0)));
 
   // Invert the result, because it's a minimization.
   return regularization - result;
@@ -142,13 +172,46 @@ void LogisticRegressionFunction<MatType>::Gradient(
   arma::mat regularization;
   regularization = lambda * parameters.tail_cols(parameters.n_elem - 1);
 
-  const arma::rowvec sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
-      - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+  gradient.zeros(arma::size(parameters));
 
-  gradient.set_size(arma::size(parameters));
-  gradient[0] = -arma::accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  // Shard the pass over the data: each thread computes the partial gradient
+  // of a contiguous block of points, and the partial results are summed.  The
+  // gradient is a sum over points, so the shards are independent.
+  #ifdef HAS_OPENMP
+  const size_t numShards = (size_t) omp_get_max_threads();
+  #else
+  const size_t numShards = 1;
+  #endif
+  const size_t shardSize = (predictors.n_cols + numShards - 1) / numShards;
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t s = 0; s < (omp_size_t) numShards; ++s)
+  {
+    const size_t begin = s * shardSize;
+    if (begin >= predictors.n_cols)
+      continue;
+    const size_t end = std::min(begin + shardSize,
+        (size_t) predictors.n_cols) - 1;
+
+    const arma::rowvec sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
+        - parameters.tail_cols(parameters.n_elem - 1) *
+        predictors.cols(begin, end))));
+
+    const arma::rowvec weightedDiffs =
+        (sigmoids - responses.subvec(begin, end)) %
+        weights.subvec(begin, end);
+    const double localIntercept = arma::accu(weightedDiffs);
+    const arma::rowvec localGradient = weightedDiffs *
+        predictors.cols(begin, end).t();
+
+    #pragma omp critical
+    {
+      gradient[0] += localIntercept;
+      gradient.tail_cols(parameters.n_elem - 1) += localGradient;
+    }
+  }
+
+  gradient.tail_cols(parameters.n_elem - 1) += regularization;
 }
 
 //! Evaluate the gradient of the logistic regression objective function for a
@@ -166,18 +229,26 @@ void LogisticRegressionFunction<MatType>::Gradient(
   regularization = lambda * parameters.tail_cols(parameters.n_elem - 1)
       / predictors.n_cols * batchSize;
 
+  // Gather the batch in the current visitation ordering.
+  MatType batchPredictors;
+  arma::Row<size_t> batchResponses;
+  arma::rowvec batchWeights;
+  math::OrderedBatch(predictors, ordering, begin, batchSize, batchPredictors);
+  math::OrderedBatch(responses, ordering, begin, batchSize, batchResponses);
+  math::OrderedBatch(weights, ordering, begin, batchSize, batchWeights);
+
   const arma::rowvec exponents = parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1);
+      parameters.tail_cols(parameters.n_elem - 1) * batchPredictors;
   // Calculating the sigmoid function values.
   const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-exponents));
 
+  const arma::rowvec weightedDiffs = (sigmoids - batchResponses) %
+      batchWeights;
+
   gradient.set_size(parameters.n_rows, parameters.n_cols);
-  gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
-      sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  gradient[0] = arma::accu(weightedDiffs);
+  gradient.tail_cols(parameters.n_elem - 1) = weightedDiffs *
+      batchPredictors.t() + regularization;
 }
 
 /**
@@ -190,8 +261,9 @@ void LogisticRegressionFunction<MatType>::PartialGradient(
     const size_t j,
     arma::sp_mat& gradient) const
 {
-  const arma::rowvec diffs = responses - (1 / (1 + arma::exp(-parameters(0, 0)
-      - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+  const arma::rowvec diffs = weights % (responses - (1 / (1 +
+      arma::exp(-parameters(0, 0) -
+      parameters.tail_cols(parameters.n_elem - 1) * predictors))));
 
   gradient.set_size(arma::size(parameters));
 
@@ -220,19 +292,54 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
       arma::dot(parameters.tail_cols(parameters.n_elem - 1),
                 parameters.tail_cols(parameters.n_elem - 1));
 
-  // Calculate the sigmoid function values.
-  const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) * predictors)));
-
-  gradient.set_size(arma::size(parameters));
-  gradient[0] = -arma::accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  gradient.zeros(arma::size(parameters));
+
+  // Both the objective and the gradient are sums over points, so we can split
+  // the dataset into one contiguous shard per thread and reduce the partial
+  // results afterwards.
+  #ifdef HAS_OPENMP
+  const size_t numShards = (size_t) omp_get_max_threads();
+  #else
+  const size_t numShards = 1;
+  #endif
+  const size_t shardSize = (predictors.n_cols + numShards - 1) / numShards;
+
+  double result = 0.0;
+  #pragma omp parallel for schedule(static) reduction(+:result)
+  for (omp_size_t s = 0; s < (omp_size_t) numShards; ++s)
+  {
+    const size_t begin = s * shardSize;
+    if (begin >= predictors.n_cols)
+      continue;
+    const size_t end = std::min(begin + shardSize,
+        (size_t) predictors.n_cols) - 1;
+
+    // Calculate the sigmoid function values for this shard.
+    const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+        parameters.tail_cols(parameters.n_elem - 1) *
+        predictors.cols(begin, end))));
+
+    const arma::rowvec weightedDiffs =
+        (sigmoids - responses.subvec(begin, end)) %
+        weights.subvec(begin, end);
+    const double localIntercept = arma::accu(weightedDiffs);
+    const arma::rowvec localGradient = weightedDiffs *
+        predictors.cols(begin, end).t();
+
+    #pragma omp critical
+    {
+      gradient[0] += localIntercept;
+      gradient.tail_cols(parameters.n_elem - 1) += localGradient;
+    }
+
+    // Now compute the objective function using the sigmoids.
+    const arma::rowvec respD = arma::conv_to<arma::rowvec>::from(
+        responses.subvec(begin, end));
+    result += arma::accu(weights.subvec(begin, end) %
+        arma::log(1.0 - respD + sigmoids % (2 * respD - 1.0)));
+  }
 
-  // Now compute the objective function using the sigmoids.
-  double result = arma::accu(arma::log(1.0 -
-      arma::conv_to<arma::rowvec>::from(responses) + sigmoids %
-      (2 * arma::conv_to<arma::rowvec>::from(responses) - 1.0)));
+  gradient.tail_cols(parameters.n_elem - 1) += regularization;
 
   // Invert the result, because it's a minimization.
   return objectiveRegularization - result;
@@ -256,23 +363,30 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
       arma::dot(parameters.tail_cols(parameters.n_elem - 1),
                 parameters.tail_cols(parameters.n_elem - 1));
 
+  // Gather the batch in the current visitation ordering.
+  MatType batchPredictors;
+  arma::Row<size_t> batchResponses;
+  arma::rowvec batchWeights;
+  math::OrderedBatch(predictors, ordering, begin, batchSize, batchPredictors);
+  math::OrderedBatch(responses, ordering, begin, batchSize, batchResponses);
+  math::OrderedBatch(weights, ordering, begin, batchSize, batchWeights);
+
   // Calculate the sigmoid function values.
   const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1))));
+      parameters.tail_cols(parameters.n_elem - 1) * batchPredictors)));
+
+  const arma::rowvec weightedDiffs = (sigmoids - batchResponses) %
+      batchWeights;
 
   gradient.set_size(parameters.n_rows, parameters.n_cols);
-  gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
-      sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  gradient[0] = arma::accu(weightedDiffs);
+  gradient.tail_cols(parameters.n_elem - 1) = weightedDiffs *
+      batchPredictors.t() + regularization;
 
   // Now compute the objective function using the sigmoids.
-  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
-      begin + batchSize - 1));
-  const double result = arma::accu(arma::log(1.0 - respD + sigmoids %
-      (2 * respD - 1.0)));
+  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(batchResponses);
+  const double result = arma::accu(batchWeights % arma::log(1.0 - respD +
+      sigmoids % (2 * respD - 1.0)));
 
   // Invert the result, because it's a minimization.
   return objectiveRegularization - result;
@@ -101,6 +101,45 @@ double LogisticRegression<MatType>::Train(
   return out;
 }
 
+template<typename MatType>
+template<typename OptimizerType, typename... CallbackTypes>
+double LogisticRegression<MatType>::Train(
+        const MatType& predictors,
+        const arma::Row<size_t>& responses,
+        const arma::rowvec& weights,
+        CallbackTypes&&... callbacks)
+{
+  OptimizerType optimizer;
+  return Train(predictors, responses, weights, optimizer, callbacks...);
+}
+
+template<typename MatType>
+template<typename OptimizerType, typename... CallbackTypes>
+double LogisticRegression<MatType>::Train(
+    const MatType& predictors,
+    const arma::Row<size_t>& responses,
+    const arma::rowvec& weights,
+    OptimizerType& optimizer,
+    CallbackTypes&&... callbacks)
+{
+  LogisticRegressionFunction<MatType> errorFunction(predictors, responses,
+      weights, lambda);
+
+  // Set size of parameters vector according to the input data received.
+  if (parameters.n_elem != predictors.n_rows + 1)
+    parameters = arma::rowvec(predictors.n_rows + 1, arma::fill::zeros);
+
+  Timer::Start("logistic_regression_optimization");
+  const double out = optimizer.Optimize(errorFunction, parameters,
+      callbacks...);
+  Timer::Stop("logistic_regression_optimization");
+
+  Log::Info << "LogisticRegression::LogisticRegression(): final objective of "
+      << "trained model is " << out << "." << std::endl;
+
+  return out;
+}
+
 template<typename MatType>
 template<typename VecType>
 size_t LogisticRegression<MatType>::Classify(const VecType& point,
@@ -61,7 +61,8 @@ BINDING_LONG_DESC(
     PRINT_PARAM_STRING("lambda") + " option, and the "
     "optimizer used to train the model can be specified with the " +
     PRINT_PARAM_STRING("optimizer") + " parameter.  Available options are "
-    "'sgd' (stochastic gradient descent) and 'lbfgs' (the L-BFGS optimizer).  "
+    "'sgd' (stochastic gradient descent), 'psgd' (parallel stochastic gradient "
+    "descent) and 'lbfgs' (the L-BFGS optimizer).  "
     "There are also various parameters for the optimizer; the " +
     PRINT_PARAM_STRING("max_iterations") + " parameter specifies the maximum "
     "number of allowed iterations, and the " +
@@ -135,8 +136,8 @@ PARAM_UROW_IN("labels", "A matrix containing labels (0 or 1) for the points "
 // Optimizer parameters.
 PARAM_DOUBLE_IN("lambda", "L2-regularization parameter for training.", "L",
     0.0);
-PARAM_STRING_IN("optimizer", "Optimizer to use for training ('lbfgs' or "
-    "'sgd').", "O", "lbfgs");
+PARAM_STRING_IN("optimizer", "Optimizer to use for training ('lbfgs', 'sgd' "
+    "or 'psgd').", "O", "lbfgs");
 PARAM_DOUBLE_IN("tolerance", "Convergence tolerance for optimizer.", "e",
     1e-10);
 PARAM_INT_IN("max_iterations", "Maximum iterations for optimizer (0 indicates "
@@ -217,8 +218,8 @@ static void mlpackMain()
   RequireParamValue<double>("tolerance", [](double x) { return x >= 0.0; },
       true, "tolerance must be positive or zero");
 
-  // Optimizer has to be L-BFGS or SGD.
-  RequireParamInSet<string>("optimizer", { "lbfgs", "sgd" },
+  // Optimizer has to be L-BFGS, SGD, or parallel SGD.
+  RequireParamInSet<string>("optimizer", { "lbfgs", "sgd", "psgd" },
       true, "unknown optimizer");
 
   // Lambda must be positive.
@@ -233,13 +234,16 @@ static void mlpackMain()
   RequireParamValue<double>("step_size", [](double x) { return x >= 0.0; },
       true, "step size must be positive");
 
-  if (optimizerType != "sgd")
+  if (optimizerType == "lbfgs")
   {
     if (IO::HasParam("step_size"))
     {
       Log::Warn << PRINT_PARAM_STRING("step_size") << " ignored because "
-          << "optimizer type is not 'sgd'." << std::endl;
+          << "optimizer type is not 'sgd' or 'psgd'." << std::endl;
     }
+  }
+  if (optimizerType != "sgd")
+  {
     if (IO::HasParam("batch_size"))
     {
       Log::Warn << PRINT_PARAM_STRING("batch_size") << " ignored because "
@@ -333,6 +337,24 @@ static void mlpackMain()
       // This will train the model.
       model->Train(regressors, responses, sgdOpt);
     }
+    else if (optimizerType == "psgd")
+    {
+      #ifdef HAS_OPENMP
+      const size_t threads = omp_get_max_threads();
+      #else
+      const size_t threads = 1;
+      Log::Warn << "Using parallel SGD, but OpenMP support is "
+          << "not available!" << endl;
+      #endif
+
+      ens::ConstantStep decayPolicy(stepSize);
+      ens::ParallelSGD<ens::ConstantStep> psgdOpt(maxIterations, std::ceil(
+          (float) regressors.n_cols / threads), tolerance, true, decayPolicy);
+      Log::Info << "Training model with ParallelSGD optimizer." << endl;
+
+      // This will train the model.
+      model->Train(regressors, responses, psgdOpt);
+    }
     else if (optimizerType == "lbfgs")
     {
       ens::L_BFGS lbfgsOpt;
@@ -290,10 +290,16 @@ class LSHSearch
   //! Get the bucket size of the second hash.
   size_t BucketSize() const { return bucketSize; }
 
-  //! Get the second hash table.
-  const std::vector<arma::Col<size_t>>& SecondHashTable() const
+  //! Get the second hash table: all bucket contents, stored back-to-back in
+  //! one flat array.  Use BucketOffsets() and BucketContentSize() to find the
+  //! slice that belongs to each row.
+  const arma::Col<size_t>& SecondHashTable() const
       { return secondHashTable; }
 
+  //! Get the starting offset of each second hash table row in
+  //! SecondHashTable().
+  const arma::Col<size_t>& BucketOffsets() const { return bucketOffsets; }
+
   //! Get the projection tables.
   const arma::cube& Projections() { return projections; }
 
@@ -450,9 +456,14 @@ class LSHSearch
   //! The bucket size of the second hash.
   size_t bucketSize;
 
-  //! The final hash table; should be (< secondHashSize) vectors each with
-  //! (<= bucketSize) elements.
-  std::vector<arma::Col<size_t>> secondHashTable;
+  //! The final hash table, stored compactly: the contents of all (up to
+  //! secondHashSize) rows, each holding at most bucketSize elements, laid out
+  //! back-to-back in a single array.  This avoids one allocation (and one
+  //! pointer indirection) per bucket.
+  arma::Col<size_t> secondHashTable;
+
+  //! The starting offset of each row of the hash table in secondHashTable.
+  arma::Col<size_t> bucketOffsets;
 
   //! The number of elements present in each hash bucket; should be
   //! secondHashSize.
@@ -84,6 +84,7 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(const LSHSearch& other) :
     secondHashWeights(other.secondHashWeights),
     bucketSize(other.bucketSize),
     secondHashTable(other.secondHashTable),
+    bucketOffsets(other.bucketOffsets),
     bucketContentSize(other.bucketContentSize),
     bucketRowInHashTable(other.bucketRowInHashTable),
     distanceEvaluations(other.distanceEvaluations)
@@ -104,6 +105,7 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(LSHSearch&& other) :
     secondHashWeights(std::move(other.secondHashWeights)),
     bucketSize(other.bucketSize),
     secondHashTable(std::move(other.secondHashTable)),
+    bucketOffsets(std::move(other.bucketOffsets)),
     bucketContentSize(std::move(other.bucketContentSize)),
     bucketRowInHashTable(std::move(other.bucketRowInHashTable)),
     distanceEvaluations(other.distanceEvaluations)
@@ -132,6 +134,7 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashWeights = other.secondHashWeights;
   bucketSize = other.bucketSize;
   secondHashTable = other.secondHashTable;
+  bucketOffsets = other.bucketOffsets;
   bucketContentSize = other.bucketContentSize;
   bucketRowInHashTable = other.bucketRowInHashTable;
   distanceEvaluations = other.distanceEvaluations;
@@ -154,6 +157,7 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashWeights = std::move(other.secondHashWeights);
   bucketSize = other.bucketSize;
   secondHashTable = std::move(other.secondHashTable);
+  bucketOffsets = std::move(other.bucketOffsets);
   bucketContentSize = std::move(other.bucketContentSize);
   bucketRowInHashTable = std::move(other.bucketRowInHashTable);
   distanceEvaluations = other.distanceEvaluations;
@@ -311,35 +315,48 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
 
   const size_t numRowsInTable = arma::accu(secondHashBinCounts > 0);
   bucketContentSize.zeros(numRowsInTable);
-  secondHashTable.resize(numRowsInTable);
+  bucketOffsets.set_size(numRowsInTable);
 
-  // Next we must assign each point in each table to the right second hash
-  // table.
+  // The bucket contents are stored compactly: one flat array holding every
+  // bucket back-to-back, with bucketOffsets giving the start of each row.
+  // First pass: assign rows to buckets in order of first appearance and
+  // compute the row offsets from the (capped) bucket counts.
   size_t currentRow = 0;
+  size_t totalSize = 0;
   for (size_t i = 0; i < numTables; ++i)
   {
-    // Insert the point in the corresponding row to its bucket in the
-    // 'secondHashTable'.
     for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
     {
-      // This is the bucket number.
-      size_t hashInd = (size_t) secondHashVectors(i, j);
-      // The point ID is 'j'.
-
-      // If this is currently an empty bucket, start a new row keep track of
-      // which row corresponds to the bucket.
-      const size_t maxSize = secondHashBinCounts[hashInd];
+      const size_t hashInd = (size_t) secondHashVectors(i, j);
       if (bucketRowInHashTable[hashInd] == secondHashSize)
       {
         bucketRowInHashTable[hashInd] = currentRow;
-        secondHashTable[currentRow].set_size(maxSize);
+        bucketOffsets[currentRow] = totalSize;
+        totalSize += secondHashBinCounts[hashInd];
         currentRow++;
       }
+    }
+  }
 
-      // If this vector in the hash table is not full, add the point.
+  secondHashTable.set_size(totalSize);
+
+  // Second pass: insert each point in each table into its bucket's slice of
+  // the flat array.
+  for (size_t i = 0; i < numTables; ++i)
+  {
+    for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
+    {
+      // This is the bucket number; the point ID is 'j'.
+      const size_t hashInd = (size_t) secondHashVectors(i, j);
+      const size_t maxSize = secondHashBinCounts[hashInd];
+
+      // If this bucket is not full, add the point.
       const size_t index = bucketRowInHashTable[hashInd];
       if (bucketContentSize[index] < maxSize)
-        secondHashTable[index](bucketContentSize[index]++) = j;
+      {
+        secondHashTable[bucketOffsets[index] + bucketContentSize[index]] = j;
+        bucketContentSize[index]++;
+      }
     } // Loop over all points in the reference set.
   } // Loop over tables.
 
@@ -812,7 +829,7 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
         {
           // Pick the indices in the bucket corresponding to hashInd.
           for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsidered[ secondHashTable[tableRow](j) ]++;
+            refPointsConsidered[ secondHashTable[bucketOffsets[tableRow] + j] ]++;
         }
       }
     }
@@ -843,7 +860,8 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
         {
           // Store all secondHashTable points in the candidates set.
           for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsideredSmall(start++) = secondHashTable[tableRow](j);
+            refPointsConsideredSmall(start++) =
+                secondHashTable[bucketOffsets[tableRow] + j];
        }
       }
     }
@@ -1051,6 +1069,7 @@ void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
   ar(CEREAL_NVP(secondHashWeights));
   ar(CEREAL_NVP(bucketSize));
   ar(CEREAL_NVP(secondHashTable));
+  ar(CEREAL_NVP(bucketOffsets));
   ar(CEREAL_NVP(bucketContentSize));
   ar(CEREAL_NVP(bucketRowInHashTable));
   ar(CEREAL_NVP(distanceEvaluations));
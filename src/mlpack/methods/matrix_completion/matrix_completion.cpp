@@ -98,6 +98,72 @@ void MatrixCompletion::Recover(arma::mat& recovered)
   recovered = recovered(arma::span(0, m - 1), arma::span(m, m + n - 1));
 }
 
+void MatrixCompletion::Recover(arma::mat& recovered,
+                               const size_t blockSize,
+                               const size_t maxBlocks,
+                               const double tolerance)
+{
+  const size_t p = indices.n_cols;
+
+  // Nothing to sample; use the full-batch solver.
+  if (blockSize == 0 || blockSize >= p)
+  {
+    Recover(recovered);
+    return;
+  }
+
+  // Warm-start every block solve from the factor of the previous round.
+  arma::mat coordinates = sdp.Function().GetInitialPoint();
+
+  // With only a fraction of the constraints present, the penalty mass of the
+  // subproblem shrinks by the same fraction; scaling the trace objective
+  // keeps the ratio between the nuclear-norm term and the constraints the
+  // same as in the full problem.
+  const double objectiveScale = (double) blockSize / (double) p;
+
+  for (size_t block = 0; block < maxBlocks; ++block)
+  {
+    // Sample a constraint subset without replacement.
+    const arma::uvec sample = arma::randperm(p, blockSize);
+
+    ens::LRSDP<ens::SDP<arma::sp_mat>> blockSdp(blockSize, 0, coordinates);
+    blockSdp.SDP().C().eye(m + n, m + n);
+    blockSdp.SDP().C() *= objectiveScale;
+    for (size_t i = 0; i < blockSize; ++i)
+    {
+      const size_t c = sample(i);
+      blockSdp.SDP().SparseB()[i] = 2. * values(c);
+      blockSdp.SDP().SparseA()[i].zeros(m + n, m + n);
+      blockSdp.SDP().SparseA()[i](indices(0, c), m + indices(1, c)) = 1.;
+      blockSdp.SDP().SparseA()[i](m + indices(1, c), indices(0, c)) = 1.;
+    }
+
+    blockSdp.Optimize(coordinates);
+
+    // Evaluate the residuals over every observed entry, not just the sampled
+    // ones; each residual is an independent dot product of factor rows, so
+    // the scan is threaded.
+    double squaredError = 0.0;
+    #pragma omp parallel for reduction(+:squaredError) schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) p; ++i)
+    {
+      const double predicted = arma::dot(coordinates.row(indices(0, i)),
+          coordinates.row(m + indices(1, i)));
+      const double residual = predicted - values(i);
+      squaredError += residual * residual;
+    }
+
+    const double rmse = std::sqrt(squaredError / p);
+    Log::Info << "MatrixCompletion::Recover(): block round " << block
+        << ", observed-entry RMSE " << rmse << "." << std::endl;
+    if (rmse < tolerance)
+      break;
+  }
+
+  recovered = coordinates * trans(coordinates);
+  recovered = recovered(arma::span(0, m - 1), arma::span(m, m + n - 1));
+}
+
 size_t MatrixCompletion::DefaultRank(const size_t m,
                                      const size_t n,
                                      const size_t p)
@@ -111,6 +111,30 @@ class MatrixCompletion
    */
   void Recover(arma::mat& recovered);
 
+  /**
+   * Solve the completion problem blockwise: each round samples a random
+   * subset of the observed-entry constraints, solves the resulting smaller
+   * SDP warm-started from the previous factor, and checks the residuals over
+   * all observed entries.  The per-round cost scales with the block size
+   * instead of with the full number of observed entries, which makes very
+   * large constraint sets tractable; the price is that each subproblem is a
+   * relaxation, so several rounds are typically needed.  The trace objective
+   * is reweighted by the sampling fraction so the balance between the
+   * nuclear-norm term and the constraint penalties matches the full problem.
+   *
+   * @param recovered Will contain the completed matrix.
+   * @param blockSize Number of constraints to sample per round; 0 (or a value
+   *    not less than the number of observed entries) falls back to the
+   *    full-batch solver.
+   * @param maxBlocks Maximum number of rounds.
+   * @param tolerance RMSE over the observed entries below which the iteration
+   *    stops.
+   */
+  void Recover(arma::mat& recovered,
+               const size_t blockSize,
+               const size_t maxBlocks = 20,
+               const double tolerance = 1e-5);
+
   //! Return the underlying SDP.
   const ens::LRSDP<ens::SDP<arma::sp_mat>>& Sdp() const
   {
@@ -207,57 +207,101 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
 
   assignments.set_size(data.n_cols);
 
-  range::RangeSearch<> rangeSearcher(data);
   math::Range validRadius(0, radius);
-  std::vector<std::vector<size_t> > neighbors;
-  std::vector<std::vector<double> > distances;
 
-  // For each seed, perform mean shift algorithm.
-  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+  // The seeds are independent until their modes are merged, so they are
+  // shifted in parallel.  The list of converged modes (`centroids`) is shared
+  // between threads and guarded by a named critical section; it doubles as a
+  // basin-of-attraction cache, so that a seed whose centroid drifts within
+  // the radius of an already-converged mode stops iterating immediately
+  // instead of retracing the rest of the path.
+  #pragma omp parallel
   {
-    // Initial centroid is the seed itself.
-    allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations
-        || forceConvergence; completedIterations++)
+    // Each thread needs its own searcher (and therefore its own rule state),
+    // because concurrent Search() calls on a shared RangeSearch object mutate
+    // its members.  The per-thread tree build is amortized over all the seeds
+    // and iterations the thread processes.
+    range::RangeSearch<> rangeSearcher(data);
+    std::vector<std::vector<size_t> > neighbors;
+    std::vector<std::vector<double> > distances;
+
+    // For each seed, perform mean shift algorithm.
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) pSeeds->n_cols; ++i)
     {
-      // Store new centroid in this.
-      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+      // Initial centroid is the seed itself.
+      allCentroids.col(i) = pSeeds->unsafe_col(i);
+      for (size_t completedIterations = 0; completedIterations < maxIterations
+          || forceConvergence; completedIterations++)
+      {
+        // If the centroid has entered the basin of an already-converged mode,
+        // it will converge there too; adopt that mode without iterating
+        // further.  (The mode list also serves as the duplicate filter below,
+        // so anything within `radius` of an existing mode is a duplicate.)
+        bool adopted = false;
+        #pragma omp critical (meanShiftModes)
+        {
+          for (size_t k = 0; k < centroids.n_cols; ++k)
+          {
+            const double distance = metric::EuclideanDistance::Evaluate(
+                allCentroids.unsafe_col(i), centroids.unsafe_col(k));
+            if (distance < radius)
+            {
+              adopted = true;
+              break;
+            }
+          }
+        }
+        if (adopted)
+          break;
 
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() == 0) // There are no points in the cluster.
-        break;
+        // Store new centroid in this.
+        arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
 
-      // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
-        newCentroid = allCentroids.unsafe_col(i);
+        rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
+            neighbors, distances);
+        if (neighbors[0].size() == 0) // There are no points in the cluster.
+          break;
 
-      // If the mean shift vector is small enough, it has converged.
-      if (metric::EuclideanDistance::Evaluate(newCentroid,
-          allCentroids.unsafe_col(i)) < 1e-3 * radius)
-      {
-        // Determine if the new centroid is duplicate with old ones.
-        bool isDuplicated = false;
-        for (size_t k = 0; k < centroids.n_cols; ++k)
+        // Calculate new centroid.
+        if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
+          newCentroid = allCentroids.unsafe_col(i);
+
+        // If the mean shift vector is small enough, it has converged.
+        if (metric::EuclideanDistance::Evaluate(newCentroid,
+            allCentroids.unsafe_col(i)) < 1e-3 * radius)
         {
-          const double distance = metric::EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
-          if (distance < radius)
+          // Determine if the new centroid is duplicate with old ones.  This
+          // must happen under the same critical section as the basin check so
+          // two threads cannot insert the same mode concurrently.
+          #pragma omp critical (meanShiftModes)
           {
-            isDuplicated = true;
-            break;
+            bool isDuplicated = false;
+            for (size_t k = 0; k < centroids.n_cols; ++k)
+            {
+              const double distance = metric::EuclideanDistance::Evaluate(
+                  allCentroids.unsafe_col(i), centroids.unsafe_col(k));
+              if (distance < radius)
+              {
+                isDuplicated = true;
+                break;
+              }
+            }
+
+            if (!isDuplicated)
+            {
+              centroids.insert_cols(centroids.n_cols,
+                  allCentroids.unsafe_col(i));
+            }
           }
-        }
 
-        if (!isDuplicated)
-          centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
+          // Get out of the loop.
+          break;
+        }
 
-        // Get out of the loop.
-        break;
+        // Update the centroid.
+        allCentroids.col(i) = newCentroid;
       }
-
-      // Update the centroid.
-      allCentroids.col(i) = newCentroid;
     }
   }
 
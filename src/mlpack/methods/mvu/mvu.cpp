@@ -13,13 +13,13 @@
  */
 #include "mvu.hpp"
 
-#include <mlpack/core/optimizers/sdp/lrsdp.hpp>
-
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
+#include <ensmallen.hpp>
+
 using namespace mlpack;
 using namespace mlpack::mvu;
-using namespace mlpack::optimization;
+using namespace mlpack::neighbor;
 
 MVU::MVU(const arma::mat& data) : data(data)
 {
@@ -36,68 +36,72 @@ void MVU::Unfold(const size_t newDim,
   // Following Nick's idea.
   outputData.randu(data.n_cols, newDim);
 
-  // The number of constraints is the number of nearest neighbors plus one.
-  LRSDP<arma::sp_mat> mvuSolver(numNeighbors * data.n_cols + 1, outputData);
-
-  // Set up the objective.  Because we are maximizing the trace of (R R^T),
-  // we'll instead state it as min(-I_n * (R R^T)), meaning C() is -I_n.
-  mvuSolver.C().eye(data.n_cols, data.n_cols);
-  mvuSolver.C() *= -1;
-
-  // Now set up each of the constraints.
-  // The first constraint is trace(ones * R * R^T) = 0.
-  mvuSolver.B()[0] = 0;
-  mvuSolver.A()[0].ones(data.n_cols, data.n_cols);
+  const size_t n = data.n_cols;
 
-  // All of our other constraints will be sparse except the first.  So set that
-  // vector of modes accordingly.
-  mvuSolver.AModes().ones();
-  mvuSolver.AModes()[0] = 0;
-
-  // Now all of the other constraints.  We first have to run KNN to get the
-  // list of nearest neighbors.
+  // We have to run KNN first to get the list of nearest neighbors.
   arma::Mat<size_t> neighbors;
   arma::mat distances;
 
   KNN knn(data);
   knn.Search(numNeighbors, neighbors, distances);
 
-  // Add each of the other constraints.  They are sparse constraints:
-  //   Tr(A_ij K) = d_ij;
+  // The LRSDP formulation never materializes the n x n Gram matrix: it
+  // optimizes the low-rank factor R (with K = R R^T) directly, so the inner
+  // solver is matrix-free and every constraint is evaluated against R in time
+  // proportional to the number of nonzeros of its constraint matrix.  The
+  // distance constraints have four nonzeros each and are stored as sparse
+  // matrices; only the centering constraint is dense.
+  ens::LRSDP<ens::SDP<arma::sp_mat>> mvuSolver(numNeighbors * n, 1,
+      outputData);
+
+  // Set up the objective.  Because we are maximizing the trace of (R R^T),
+  // we'll instead state it as min(-I_n * (R R^T)), meaning C() is -I_n.
+  mvuSolver.SDP().C() = -arma::speye<arma::sp_mat>(n, n);
+
+  // The centering constraint is trace(ones * R * R^T) = 0; the all-ones
+  // matrix is the only constraint that is not sparse.
+  mvuSolver.SDP().DenseA()[0].ones(n, n);
+  mvuSolver.SDP().DenseB()[0] = 0;
+
+  // Add each of the distance constraints:
+  //   Tr(A_ij K) = d_ij^2;
   //   A_ij = zeros except for 1 at (i, i), (j, j); -1 at (i, j), (j, i).
+  // Each matrix is assembled with batch insertion from its four nonzeros.
+  arma::umat locations(2, 4);
+  arma::vec values(4);
   for (size_t i = 0; i < neighbors.n_cols; ++i)
   {
     for (size_t j = 0; j < numNeighbors; ++j)
     {
       // This is the index of the constraint.
-      const size_t index = (i * numNeighbors) + j + 1;
-
-      arma::mat& aRef = mvuSolver.A()[index];
-
-      aRef.set_size(3, 4);
+      const size_t index = (i * numNeighbors) + j;
+      const size_t neighbor = neighbors(j, i);
 
       // A_ij(i, i) = 1.
-      aRef(0, 0) = i;
-      aRef(1, 0) = i;
-      aRef(2, 0) = 1;
+      locations(0, 0) = i;
+      locations(1, 0) = i;
+      values(0) = 1;
 
       // A_ij(i, j) = -1.
-      aRef(0, 1) = i;
-      aRef(1, 1) = neighbors(j, i);
-      aRef(2, 1) = -1;
+      locations(0, 1) = i;
+      locations(1, 1) = neighbor;
+      values(1) = -1;
 
       // A_ij(j, i) = -1.
-      aRef(0, 2) = neighbors(j, i);
-      aRef(1, 2) = i;
-      aRef(2, 2) = -1;
+      locations(0, 2) = neighbor;
+      locations(1, 2) = i;
+      values(2) = -1;
 
       // A_ij(j, j) = 1.
-      aRef(0, 3) = neighbors(j, i);
-      aRef(1, 3) = neighbors(j, i);
-      aRef(2, 3) = 1;
+      locations(0, 3) = neighbor;
+      locations(1, 3) = neighbor;
+      values(3) = 1;
+
+      mvuSolver.SDP().SparseA()[index] = arma::sp_mat(locations, values, n, n);
 
-      // The constraint b_ij is the distance between these two points.
-      mvuSolver.B()[index] = distances(j, i);
+      // The constraint b_ij is the squared distance between these two points,
+      // since Tr(A_ij K) expands to || x_i - x_j ||^2.
+      mvuSolver.SDP().SparseB()[index] = std::pow(distances(j, i), 2);
     }
   }
 
@@ -120,6 +120,26 @@ class NaiveBayesClassifier
              const size_t numClasses,
              const bool incremental = true);
 
+  /**
+   * Train the Naive Bayes classifier on the given dataset with per-instance
+   * weights.  A point with weight w contributes to the class priors, means,
+   * and variances exactly like w copies of that point, so importance can be
+   * expressed without physically replicating columns of the dataset.  The
+   * weighted statistics cannot be merged into an existing model, so this
+   * overload always trains from scratch on the given data; the incremental
+   * algorithm is not available.
+   *
+   * @param data The dataset to train on.
+   * @param labels The labels for the dataset.
+   * @param numClasses The number of classes in the dataset.
+   * @param weights Instance weight of each point.
+   */
+  template<typename MatType>
+  void Train(const MatType& data,
+             const arma::Row<size_t>& labels,
+             const size_t numClasses,
+             const arma::rowvec& weights);
+
   /**
    * Train the Naive Bayes classifier on the given point.  This will use the
    * incremental algorithm for updating the model parameters.  The data must be
@@ -109,18 +109,52 @@ void NaiveBayesClassifier<ModelMatType>::Train(
   // for each of the features with respect to each of the labels.
   if (incremental)
   {
-    // Use incremental algorithm.
-    // Fist, de-normalize probabilities.
+    // Use the incremental algorithm, processing the dataset one chunk of
+    // points at a time.  Each chunk's per-class counts, means, and summed
+    // squared deviations are computed with vectorized block operations and
+    // then merged into the model's sufficient statistics using the pairwise
+    // update of Chan et al.  Only one chunk of intermediate results is ever
+    // held in memory, so arbitrarily large streams of data can be passed
+    // through repeated calls to Train().
+    const size_t chunkSize = 1024;
+
+    // First, de-normalize the model to recover the per-class counts and the
+    // unnormalized sums of squared deviations.
     probabilities *= trainingPoints;
-
-    for (size_t j = 0; j < data.n_cols; ++j)
+    for (size_t i = 0; i < probabilities.n_elem; ++i)
     {
-      const size_t label = labels[j];
-      ++probabilities[label];
+      if (probabilities[i] > 2)
+        variances.col(i) *= (probabilities[i] - 1);
+    }
 
-      arma::vec delta = data.col(j) - means.col(label);
-      means.col(label) += delta / probabilities[label];
-      variances.col(label) += delta % (data.col(j) - means.col(label));
+    for (size_t begin = 0; begin < data.n_cols; begin += chunkSize)
+    {
+      const size_t end = std::min(begin + chunkSize,
+          (size_t) data.n_cols) - 1;
+
+      for (size_t c = 0; c < numClasses; ++c)
+      {
+        // Gather the points of this class in the chunk.
+        const arma::uvec indices = begin +
+            arma::find(labels.subvec(begin, end) == c);
+        if (indices.n_elem == 0)
+          continue;
+
+        const arma::Mat<ElemType> block = data.cols(indices);
+        const ElemType blockCount = (ElemType) indices.n_elem;
+        const arma::Col<ElemType> blockMean = arma::mean(block, 1);
+        const arma::Col<ElemType> blockM2 = arma::sum(arma::square(
+            block.each_col() - blockMean), 1);
+
+        // Merge the block statistics into the model statistics.
+        const ElemType oldCount = probabilities[c];
+        const ElemType newCount = oldCount + blockCount;
+        const arma::Col<ElemType> delta = blockMean - means.col(c);
+        means.col(c) += delta * (blockCount / newCount);
+        variances.col(c) += blockM2 +
+            arma::square(delta) * (oldCount * blockCount / newCount);
+        probabilities[c] = newCount;
+      }
     }
 
     for (size_t i = 0; i < probabilities.n_elem; ++i)
@@ -175,6 +209,62 @@ void NaiveBayesClassifier<ModelMatType>::Train(
   trainingPoints += data.n_cols;
 }
 
+template<typename ModelMatType>
+template<typename MatType>
+void NaiveBayesClassifier<ModelMatType>::Train(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights)
+{
+  static_assert(std::is_same<ElemType, typename MatType::elem_type>::value,
+      "NaiveBayesClassifier: element type of given data must match the element "
+      "type of the model!");
+
+  if (weights.n_elem != data.n_cols)
+  {
+    Log::Fatal << "NaiveBayesClassifier::Train(): number of weights ("
+        << weights.n_elem << ") does not match number of points ("
+        << data.n_cols << ")!" << std::endl;
+  }
+
+  // The weighted statistics cannot be merged into an existing model, so the
+  // model is always trained from scratch on the given data.
+  probabilities.zeros(numClasses);
+  means.zeros(data.n_rows, numClasses);
+  variances.zeros(data.n_rows, numClasses);
+
+  // Compute the weighted sufficient statistics of each class with vectorized
+  // block operations.  A point with weight w contributes exactly like w
+  // copies of that point.
+  for (size_t c = 0; c < numClasses; ++c)
+  {
+    const arma::uvec indices = arma::find(labels == c);
+    if (indices.n_elem == 0)
+      continue;
+
+    const arma::Mat<ElemType> block = data.cols(indices);
+    const arma::Col<ElemType> classWeights =
+        arma::conv_to<arma::Col<ElemType>>::from(weights.elem(indices));
+    const ElemType classWeight = arma::accu(classWeights);
+    if (classWeight == 0.0)
+      continue;
+
+    means.col(c) = (block * classWeights) / classWeight;
+    variances.col(c) = arma::square(block.each_col() - means.col(c)) *
+        classWeights;
+    if (classWeight > 1)
+      variances.col(c) /= (classWeight - 1);
+    probabilities[c] = classWeight;
+  }
+
+  // Add epsilon to prevent log of zero.
+  variances += epsilon;
+
+  probabilities /= arma::accu(probabilities);
+  trainingPoints += data.n_cols;
+}
+
 template<typename ModelMatType>
 template<typename VecType>
 void NaiveBayesClassifier<ModelMatType>::Train(const VecType& point,
@@ -188,7 +278,7 @@ void NaiveBayesClassifier<ModelMatType>::Train(const VecType& point,
   probabilities *= trainingPoints;
   probabilities[label]++;
 
-  arma::vec delta = point - means.col(label);
+  arma::Col<ElemType> delta = point - means.col(label);
   means.col(label) += delta / probabilities[label];
   if (probabilities[label] > 2)
     variances.col(label) *= (probabilities[label] - 2);
@@ -40,6 +40,14 @@ namespace nca {
  * optimizers use, overloads of Evaluate() and Gradient() are given which only
  * operate on one point in the dataset.  This is useful for optimizers like
  * stochastic gradient descent (see mlpack::optimization::SGD).
+ *
+ * For large datasets the exact softmax is too expensive, since every
+ * evaluation is quadratic in the number of points.  Setting NumNeighbors() to
+ * a nonzero value k restricts each point's softmax to its k nearest neighbors
+ * under the current stretched metric, found with a tree search; terms outside
+ * the neighborhood are vanishingly small anyway because of the exponential
+ * weighting.  The approximation applies to the non-separable Evaluate() and
+ * Gradient(); the separable (stochastic) overloads are always exact.
  */
 template<typename MetricType = metric::SquaredEuclideanDistance>
 class SoftmaxErrorFunction
@@ -131,6 +139,12 @@ class SoftmaxErrorFunction
    */
   size_t NumFunctions() const { return dataset.n_cols; }
 
+  //! Get the number of neighbors the softmax is restricted to (0 means the
+  //! exact softmax over all points).
+  size_t NumNeighbors() const { return numNeighbors; }
+  //! Modify the number of neighbors the softmax is restricted to.
+  size_t& NumNeighbors() { return numNeighbors; }
+
  private:
   //! The dataset.  This is an alias until Shuffle() is called.
   arma::mat dataset;
@@ -151,6 +165,15 @@ class SoftmaxErrorFunction
   //! Evaluate() and Gradient().
   arma::vec denominators;
 
+  //! Number of neighbors the softmax is restricted to; 0 means exact.
+  size_t numNeighbors;
+  //! The value of numNeighbors the last precalculation was run with.
+  size_t lastNumNeighbors;
+  //! Neighbor indices from the last precalculation (approximate mode only).
+  arma::Mat<size_t> neighbors;
+  //! Neighbor distances from the last precalculation (approximate mode only).
+  arma::mat neighborDistances;
+
   //! False if nothing has ever been precalculated (only at construction time).
   bool precalculated;
 
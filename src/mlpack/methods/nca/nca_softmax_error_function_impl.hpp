@@ -16,6 +16,7 @@
 #include "nca_softmax_error_function.hpp"
 
 #include <mlpack/core.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
 namespace mlpack {
 namespace nca {
@@ -29,6 +30,8 @@ SoftmaxErrorFunction<MetricType>::SoftmaxErrorFunction(
     dataset(math::MakeAlias(const_cast<arma::mat&>(dataset), false)),
     labels(math::MakeAlias(const_cast<arma::Row<size_t>&>(labels), false)),
     metric(metric),
+    numNeighbors(0),
+    lastNumNeighbors(0),
     precalculated(false)
 { /* nothing to do */ }
 
@@ -129,25 +132,76 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
   //     (p_i p_ik + p_k p_ki) x_ik x_ik^T
   arma::mat sum;
   sum.zeros(stretchedDataset.n_rows, stretchedDataset.n_rows);
-  for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
+
+  if (numNeighbors > 0)
   {
-    for (size_t k = (i + 1); k < stretchedDataset.n_cols; ++k)
+    // Approximate mode: the neighbor lists are not symmetric, so instead of
+    // the pairwise form we use the per-point form
+    //   sum_i sum_{j in N(i)} p_ij (p_i - [labels match]) x_ij x_ij^T,
+    // restricted to each point's neighborhood.  Each thread accumulates into
+    // its own matrix, and the partial sums are combined at the end.
+    #pragma omp parallel
     {
-      // Calculate p_ik and p_ki first.
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(k)));
-      double p_ik = 0, p_ki = 0;
-      p_ik = eval / denominators(i);
-      p_ki = eval / denominators(k);
+      arma::mat localSum(stretchedDataset.n_rows, stretchedDataset.n_rows,
+          arma::fill::zeros);
 
-      // Subtract x_i from x_k.  We are not using stretched points here.
-      arma::vec x_ik = dataset.col(i) - dataset.col(k);
-      arma::mat secondTerm = (x_ik * trans(x_ik));
+      #pragma omp for schedule(dynamic, 64) nowait
+      for (omp_size_t i = 0; i < (omp_size_t) stretchedDataset.n_cols; ++i)
+      {
+        for (size_t j = 0; j < neighbors.n_rows; ++j)
+        {
+          const size_t k = neighbors(j, i);
+          const double p_ik = std::exp(-neighborDistances(j, i)) /
+              denominators(i);
+
+          // Subtract x_i from x_k.  We are not using stretched points here.
+          arma::vec x_ik = dataset.col(i) - dataset.col(k);
+          const double weight = (labels[i] == labels[k]) ?
+              (p[i] - 1) * p_ik : p[i] * p_ik;
+
+          localSum += weight * (x_ik * trans(x_ik));
+        }
+      }
 
-      if (labels[i] == labels[k])
-        sum += ((p[i] - 1) * p_ik + (p[k] - 1) * p_ki) * secondTerm;
-      else
-        sum += (p[i] * p_ik + p[k] * p_ki) * secondTerm;
+      #pragma omp critical (ncaSoftmaxGradient)
+      sum += localSum;
+    }
+  }
+  else
+  {
+    // Exact mode.  The pairs are independent given the precalculated
+    // denominators, so the triangle of pairs is split across threads, each
+    // accumulating into a thread-local matrix.
+    #pragma omp parallel
+    {
+      arma::mat localSum(stretchedDataset.n_rows, stretchedDataset.n_rows,
+          arma::fill::zeros);
+
+      #pragma omp for schedule(dynamic, 8) nowait
+      for (omp_size_t i = 0; i < (omp_size_t) stretchedDataset.n_cols; ++i)
+      {
+        for (size_t k = (i + 1); k < stretchedDataset.n_cols; ++k)
+        {
+          // Calculate p_ik and p_ki first.
+          double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                             stretchedDataset.unsafe_col(k)));
+          double p_ik = 0, p_ki = 0;
+          p_ik = eval / denominators(i);
+          p_ki = eval / denominators(k);
+
+          // Subtract x_i from x_k.  We are not using stretched points here.
+          arma::vec x_ik = dataset.col(i) - dataset.col(k);
+          arma::mat secondTerm = (x_ik * trans(x_ik));
+
+          if (labels[i] == labels[k])
+            localSum += ((p[i] - 1) * p_ik + (p[k] - 1) * p_ki) * secondTerm;
+          else
+            localSum += (p[i] * p_ik + p[k] * p_ki) * secondTerm;
+        }
+      }
+
+      #pragma omp critical (ncaSoftmaxGradient)
+      sum += localSum;
     }
   }
 
@@ -248,40 +302,67 @@ void SoftmaxErrorFunction<MetricType>::Precalculate(
     lastCoordinates.set_size(coordinates.n_rows, coordinates.n_cols);
   }
   else if ((accu(coordinates == lastCoordinates) == coordinates.n_elem) &&
-      precalculated)
+      precalculated && (numNeighbors == lastNumNeighbors))
   {
     return; // No need to calculate; we already have this stuff saved.
   }
 
   // Coordinates are different; save the new ones, and stretch the dataset.
   lastCoordinates = coordinates;
+  lastNumNeighbors = numNeighbors;
   stretchedDataset = coordinates * dataset;
 
   // For each point i, we must evaluate the softmax function:
   //   p_ij = exp( -K(x_i, x_j) ) / ( sum_{k != i} ( exp( -K(x_i, x_k) )))
   //   p_i = sum_{j in class of i} p_ij
   // We will do this by keeping track of the denominators for each i as well as
-  // the numerators (the sum for all j in class of i).  This will be on the
-  // order of O((n * (n + 1)) / 2), which really isn't all that great.
+  // the numerators (the sum for all j in class of i).
   p.zeros(stretchedDataset.n_cols);
   denominators.zeros(stretchedDataset.n_cols);
-  for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
+
+  if (numNeighbors > 0)
   {
-    for (size_t j = (i + 1); j < stretchedDataset.n_cols; ++j)
+    // Approximate mode: restrict each point's softmax to its numNeighbors
+    // nearest neighbors under the current stretched metric.  The tree search
+    // replaces the quadratic scan over all pairs.
+    neighbor::NeighborSearch<neighbor::NearestNeighborSort, MetricType> knn(
+        stretchedDataset, neighbor::DUAL_TREE_MODE, 0.0, metric);
+    knn.Search(numNeighbors, neighbors, neighborDistances);
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (omp_size_t i = 0; i < (omp_size_t) stretchedDataset.n_cols; ++i)
     {
-      // Evaluate exp(-d(x_i, x_j)).
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(j)));
+      for (size_t j = 0; j < neighbors.n_rows; ++j)
+      {
+        const double eval = std::exp(-neighborDistances(j, i));
+        denominators[i] += eval;
+        if (labels[i] == labels[neighbors(j, i)])
+          p[i] += eval;
+      }
+    }
+  }
+  else
+  {
+    // Exact mode, O(n^2).  Accumulating every point's sums independently
+    // gives up the factor-of-two saving from the symmetry K(i, j) = K(j, i),
+    // but makes the rows race-free so the outer loop parallelizes.
+    #pragma omp parallel for schedule(dynamic, 8)
+    for (omp_size_t i = 0; i < (omp_size_t) stretchedDataset.n_cols; ++i)
+    {
+      for (size_t j = 0; j < stretchedDataset.n_cols; ++j)
+      {
+        if (j == (size_t) i)
+          continue;
 
-      // Add this to the denominators of both p_i and p_j: K(i, j) = K(j, i).
-      denominators[i] += eval;
-      denominators[j] += eval;
+        // Evaluate exp(-d(x_i, x_j)).
+        double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                           stretchedDataset.unsafe_col(j)));
 
-      // If i and j are the same class, add to numerator of both.
-      if (labels[i] == labels[j])
-      {
-        p[i] += eval;
-        p[j] += eval;
+        denominators[i] += eval;
+
+        // If i and j are the same class, add to the numerator.
+        if (labels[i] == labels[j])
+          p[i] += eval;
       }
     }
   }
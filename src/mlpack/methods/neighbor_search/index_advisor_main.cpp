@@ -0,0 +1,259 @@
+/**
+ * @file methods/neighbor_search/index_advisor_main.cpp
+ *
+ * Implementation of the index advisor executable.  Benchmarks candidate tree
+ * types and leaf sizes for a nearest neighbor workload and emits the
+ * recommended model.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/io.hpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+#include <mlpack/core/tree/leaf_size_tuner.hpp>
+
+#include <string>
+
+#include "neighbor_search.hpp"
+#include "ns_model.hpp"
+
+using namespace std;
+using namespace mlpack;
+using namespace mlpack::neighbor;
+using namespace mlpack::tree;
+using namespace mlpack::util;
+
+// Convenience typedef.
+typedef NSModel<NearestNeighborSort> KNNModel;
+
+// Program Name.
+BINDING_NAME("Nearest Neighbor Index Advisor");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "A benchmark harness that selects a tree type and leaf size for a "
+    "k-nearest-neighbor workload.  Given a reference dataset and a workload "
+    "description (k, query batch size, optional latency target), candidate "
+    "configurations are timed on a sample of the data and the recommended "
+    "model is built and saved, ready for use with mlpack_knn.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "Which spatial tree answers a nearest neighbor workload fastest depends "
+    "on the dataset (dimensionality, clustering) and on the workload (how "
+    "many neighbors, how many queries per batch), so no fixed choice is "
+    "right everywhere.  This program measures instead of guessing: it draws "
+    "a sample of the reference set, and for each candidate tree type "
+    "('kd', 'ball', 'cover', 'vp', 'oct') builds an index and times the "
+    "construction plus a representative query batch.  For tree types that "
+    "are built with a leaf size, a ladder of candidate leaf sizes is swept "
+    "as well."
+    "\n\n"
+    "The cheapest configuration is reported, and the recommended model is "
+    "built on the full reference set and saved to " +
+    PRINT_PARAM_STRING("output_model") + "; it can be passed directly to "
+    "mlpack_knn as --input_model_file.  If " +
+    PRINT_PARAM_STRING("latency_target") + " is given, the measured batch "
+    "latency of the recommendation is checked against it and a warning is "
+    "printed if the target was not met on the sample (the full set will "
+    "generally be slower still)."
+    "\n\n"
+    "Because the selection is based on wall-clock measurements of a sampled "
+    "workload, it is a heuristic: it replaces hand-tuning, it does not "
+    "certify the optimum.");
+
+// Example.
+BINDING_EXAMPLE(
+    "For example, to select an index for 5-nearest-neighbor queries arriving "
+    "in batches of 256 over " + PRINT_DATASET("input") + ", and save the "
+    "recommended model to " + PRINT_MODEL("index") + ": "
+    "\n\n" +
+    PRINT_CALL("index_advisor", "reference", "input", "k", 5, "batch_size",
+        256, "output_model", "index"));
+
+// See also...
+BINDING_SEE_ALSO("@knn", "#knn");
+BINDING_SEE_ALSO("@kfn", "#kfn");
+BINDING_SEE_ALSO("NeighborSearch tutorial (k-nearest-neighbors)",
+        "@doxygen/nstutorial.html");
+BINDING_SEE_ALSO("mlpack::neighbor::NSModel C++ class documentation",
+        "@doxygen/classmlpack_1_1neighbor_1_1NSModel.html");
+
+// Dataset and output model.
+PARAM_MATRIX_IN_REQ("reference", "Matrix containing the reference dataset.",
+    "r");
+PARAM_MODEL_OUT(KNNModel, "output_model", "The recommended model, built on "
+    "the full reference set; ready to pass to mlpack_knn.", "M");
+
+// Workload description.
+PARAM_INT_IN("k", "Number of nearest neighbors the workload searches for.",
+    "k", 3);
+PARAM_INT_IN("batch_size", "Number of query points per batch in the "
+    "workload.", "b", 256);
+PARAM_DOUBLE_IN("latency_target", "Per-batch latency target in milliseconds "
+    "(0 means no target).", "L", 0);
+
+// Benchmark settings.
+PARAM_INT_IN("sample_size", "Number of reference points to benchmark on (0 "
+    "uses the whole reference set).", "S", 2000);
+PARAM_INT_IN("seed", "Random seed (if 0, std::time(NULL) is used).", "s", 0);
+
+static void mlpackMain()
+{
+  if (IO::GetParam<int>("seed") != 0)
+    math::RandomSeed((size_t) IO::GetParam<int>("seed"));
+  else
+    math::RandomSeed((size_t) std::time(NULL));
+
+  RequireAtLeastOnePassed({ "output_model" }, false,
+      "the recommended model will not be saved");
+
+  RequireParamValue<int>("k", [](int x) { return x > 0; }, true,
+      "k must be greater than 0");
+  RequireParamValue<int>("batch_size", [](int x) { return x > 0; }, true,
+      "batch size must be greater than 0");
+  RequireParamValue<int>("sample_size", [](int x) { return x >= 0; }, true,
+      "sample size must be greater than or equal to 0 (0 uses the whole "
+      "reference set)");
+  RequireParamValue<double>("latency_target",
+      [](double x) { return x >= 0.0; }, true,
+      "latency target must be positive");
+
+  const size_t k = (size_t) IO::GetParam<int>("k");
+  const size_t batchSize = (size_t) IO::GetParam<int>("batch_size");
+  const double latencyTarget = IO::GetParam<double>("latency_target");
+
+  arma::mat referenceSet = std::move(IO::GetParam<arma::mat>("reference"));
+
+  if (k >= referenceSet.n_cols)
+  {
+    Log::Fatal << "Invalid k: " << k << "; must be less than the number of "
+        << "reference points (" << referenceSet.n_cols << ")." << endl;
+  }
+
+  // Benchmark on a sample of the reference set so that the advice stays
+  // cheap even on large datasets.
+  size_t sampleSize = (size_t) IO::GetParam<int>("sample_size");
+  if (sampleSize == 0)
+    sampleSize = referenceSet.n_cols;
+  if (sampleSize <= k)
+  {
+    Log::Fatal << "Invalid sample size: " << sampleSize << "; must be "
+        << "greater than k (" << k << ")." << endl;
+  }
+
+  arma::uvec samples;
+  math::ObtainDistinctSamples(0, referenceSet.n_cols, sampleSize, samples);
+  const arma::mat sampleSet = referenceSet.cols(samples);
+
+  // Draw a query batch of the workload's size from the reference set; this
+  // stands in for the batches the index will serve.
+  arma::uvec querySamples;
+  math::ObtainDistinctSamples(0, referenceSet.n_cols, batchSize,
+      querySamples);
+  const arma::mat queryBatch = referenceSet.cols(querySamples);
+
+  Log::Info << "Benchmarking on " << sampleSet.n_cols << " sampled reference "
+      << "points with query batches of " << queryBatch.n_cols << " points "
+      << "(k = " << k << ")." << endl;
+
+  // The candidate tree types.  Cover and vantage point trees are not built
+  // with a leaf size, so they get a single pass with the default.
+  const vector<pair<KNNModel::TreeTypes, string>> candidates = {
+      { KNNModel::KD_TREE, "kd" },
+      { KNNModel::BALL_TREE, "ball" },
+      { KNNModel::COVER_TREE, "cover" },
+      { KNNModel::VP_TREE, "vp" },
+      { KNNModel::OCTREE, "oct" } };
+
+  // Use a private Timers instance, as LeafSizeTuner does, so the
+  // measurements work even when global timing is disabled and do not show up
+  // in the global timer output.
+  Timers timers;
+  timers.Enabled() = true;
+
+  KNNModel::TreeTypes bestTree = KNNModel::KD_TREE;
+  string bestTreeName = "kd";
+  size_t bestLeafSize = 20;
+  chrono::microseconds bestCost = chrono::microseconds::max();
+  chrono::microseconds bestSearchCost = chrono::microseconds::max();
+
+  Timer::Start("index_advising");
+
+  for (size_t t = 0; t < candidates.size(); ++t)
+  {
+    const bool usesLeafSize =
+        (candidates[t].first == KNNModel::KD_TREE ||
+         candidates[t].first == KNNModel::BALL_TREE ||
+         candidates[t].first == KNNModel::OCTREE);
+    const vector<size_t> leafSizes = usesLeafSize ?
+        tree::LeafSizeTuner::DefaultCandidates() : vector<size_t>({ 20 });
+
+    for (size_t l = 0; l < leafSizes.size(); ++l)
+    {
+      const string name = candidates[t].second +
+          (usesLeafSize ? ("_" + to_string(leafSizes[l])) : string());
+
+      KNNModel trial(candidates[t].first, false);
+      trial.LeafSize() = leafSizes[l];
+
+      timers.StartTimer(name + "_build");
+      arma::mat trialSet(sampleSet);
+      trial.BuildModel(std::move(trialSet), DUAL_TREE_MODE);
+      timers.StopTimer(name + "_build");
+
+      arma::Mat<size_t> neighbors;
+      arma::mat distances;
+      timers.StartTimer(name + "_search");
+      arma::mat trialBatch(queryBatch);
+      trial.Search(std::move(trialBatch), k, neighbors, distances);
+      timers.StopTimer(name + "_search");
+
+      const chrono::microseconds searchCost =
+          timers.GetTimer(name + "_search");
+      const chrono::microseconds cost =
+          timers.GetTimer(name + "_build") + searchCost;
+
+      Log::Info << "Tree type '" << candidates[t].second << "'";
+      if (usesLeafSize)
+        Log::Info << ", leaf size " << leafSizes[l];
+      Log::Info << ": build + batch took " << cost.count()
+          << " microseconds (batch search: " << searchCost.count()
+          << " microseconds)." << endl;
+
+      if (cost < bestCost)
+      {
+        bestCost = cost;
+        bestSearchCost = searchCost;
+        bestTree = candidates[t].first;
+        bestTreeName = candidates[t].second;
+        bestLeafSize = leafSizes[l];
+      }
+    }
+  }
+
+  Timer::Stop("index_advising");
+
+  Log::Info << "Recommended configuration: tree type '" << bestTreeName
+      << "', leaf size " << bestLeafSize << "." << endl;
+
+  const double batchMs = bestSearchCost.count() / 1000.0;
+  if (latencyTarget > 0.0 && batchMs > latencyTarget)
+  {
+    Log::Warn << "The recommended configuration took " << batchMs << " ms "
+        << "per query batch on the sampled reference set, which misses the "
+        << "latency target of " << latencyTarget << " ms; the full "
+        << "reference set will generally be slower still." << endl;
+  }
+
+  // Build the recommended model on the full reference set, ready to
+  // serialize.
+  KNNModel* advised = new KNNModel(bestTree, false);
+  advised->LeafSize() = bestLeafSize;
+  advised->BuildModel(std::move(referenceSet), DUAL_TREE_MODE);
+
+  IO::GetParam<KNNModel*>("output_model") = advised;
+}
@@ -106,7 +106,9 @@ PARAM_STRING_IN("tree_type", "Type of tree to use: 'kd', 'vp', 'rp', 'max-rp', "
     "'r-plus-plus', 'spill', 'oct'.", "t", "kd");
 PARAM_INT_IN("leaf_size", "Leaf size for tree building (used for kd-trees, vp "
     "trees, random projection trees, UB trees, R trees, R* trees, X trees, "
-    "Hilbert R trees, R+ trees, R++ trees, spill trees, and octrees).", "l",
+    "Hilbert R trees, R+ trees, R++ trees, spill trees, and octrees).  If 0, "
+    "a leaf size is selected automatically by measuring the cost of a few "
+    "candidate leaf sizes on a sample of the reference set.", "l",
     20);
 PARAM_DOUBLE_IN("tau", "Overlapping size (only valid for spill trees).", "u",
     0);
@@ -162,9 +164,10 @@ static void mlpackMain()
   ReportIgnoredParam({{ "k", false }}, "true_distances");
   ReportIgnoredParam({{ "k", false }}, "query");
 
-  // Sanity check on leaf size.
-  RequireParamValue<int>("leaf_size", [](int x) { return x > 0; },
-      true, "leaf size must be positive");
+  // Sanity check on leaf size (0 requests automatic selection).
+  RequireParamValue<int>("leaf_size", [](int x) { return x >= 0; },
+      true, "leaf size must be greater than or equal to 0 (0 means select "
+      "automatically)");
   const int lsInt = IO::GetParam<int>("leaf_size");
 
   // Sanity check on tau.
@@ -277,6 +277,98 @@ class NeighborSearch
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
+  /**
+   * A reusable context for repeated searches of the same shape (same number
+   * of query points, dimensionality, and k).  The context owns the rule state
+   * (including the per-query candidate lists, which dominate the allocation
+   * cost of a search) and the temporary matrices used for index mapping, and
+   * reuses them across calls to the context-taking Search() overload; when
+   * the shape of the search changes, the state is simply rebuilt.  A context
+   * may be used with different NeighborSearch objects, but reuse only happens
+   * while the same object is searched repeatedly.
+   */
+  class SearchContext
+  {
+   public:
+    //! Construct an empty context; state is allocated at the first search.
+    SearchContext() : rules(NULL), referenceSet(NULL), k(0), epsilon(0) { }
+
+    //! Release any state held by the context.
+    ~SearchContext();
+
+    //! No copies; the rule state holds references into the context.
+    SearchContext(const SearchContext&) = delete;
+    SearchContext& operator=(const SearchContext&) = delete;
+
+   private:
+    //! Give NeighborSearch access to the context internals.
+    template<typename SP,
+             typename MT,
+             typename MatT,
+             template<typename, typename, typename> class TT,
+             template<typename> class DTT,
+             template<typename> class STT>
+    friend class NeighborSearch;
+
+    //! Convenience typedef of the rule type the context stores.
+    typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
+
+    //! Owned copy of the query set; assigning a same-shaped matrix to it
+    //! reuses its memory, so the rules below can keep referring to it.
+    MatType querySet;
+
+    //! Reused rule state (NULL until the first search).
+    RuleType* rules;
+
+    //! Temporary result matrix, used when reference indices need mapping.
+    arma::Mat<size_t> unmappedNeighbors;
+
+    //! The (unmapped) neighbors found by the previous search through this
+    //! context.  These are replayed as hints into the next same-shaped
+    //! search: seeding the candidate lists with the previous batch's
+    //! neighbors tightens the pruning bounds up front, which pays off when
+    //! the query distribution is stable across batches.  Stale hints only
+    //! cost their distance evaluations; the traversal falls back to its
+    //! usual bound computations.
+    arma::Mat<size_t> previousNeighbors;
+
+    //! The reference set the rules were built against; reuse is only valid
+    //! while this does not change.
+    const MatType* referenceSet;
+
+    //! The number of neighbors the rules were built for.
+    size_t k;
+
+    //! The approximation parameter the rules were built with.
+    double epsilon;
+  };
+
+  /**
+   * For each point in the query set, compute the nearest neighbors as the
+   * matrix-taking Search() overload does, but reuse the state held by the
+   * given context.  When the same context is passed to repeated searches of
+   * the same shape, the candidate lists, the query set buffer, and the
+   * mapping temporaries are all reused instead of reallocated, which
+   * stabilizes the latency of small searches issued at a high rate.
+   *
+   * The context path runs the traversal serially, since it is meant for
+   * latency-sensitive repeated small searches; in DUAL_TREE_MODE, where a
+   * query tree must be built per call anyway and there is little to reuse,
+   * this simply falls back to the regular Search().
+   *
+   * @param querySet Set of query points (can be just one point).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   * @param context Context whose state is reused across calls.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances,
+              SearchContext& context);
+
   /**
    * Calculate the average relative error (effective error) between the
    * distances calculated and the true distances provided.  The input matrices
@@ -316,6 +408,11 @@ class NeighborSearch
   //! Return the number of node combination scores during the last search.
   size_t Scores() const { return scores; }
 
+  //! Return the full traversal statistics (prunes, bound updates, and so
+  //! forth) gathered during the last search.
+  const tree::TraversalStatistics& TraversalStats() const
+  { return traversalStats; }
+
   //! Access the search mode.
   NeighborSearchMode SearchMode() const { return searchMode; }
   //! Modify the search mode.
@@ -326,6 +423,21 @@ class NeighborSearch
   //! Modify the relative error to be considered in approximate search.
   double& Epsilon() { return epsilon; }
 
+  //! Access the number of leaves a greedy single-tree search may visit per
+  //! query.  With the default of 1, GREEDY_SINGLE_TREE_MODE descends to a
+  //! single leaf; larger values run a beam search over that many leaves,
+  //! ordered by their bounds, trading latency for recall.
+  size_t LeafBudget() const { return leafBudget; }
+  //! Modify the number of leaves a greedy single-tree search may visit.
+  size_t& LeafBudget() { return leafBudget; }
+
+  //! Access the number of nodes a greedy beam search may visit per query
+  //! (unlimited by default).  Only used when the leaf budget is greater
+  //! than 1.
+  size_t NodeBudget() const { return nodeBudget; }
+  //! Modify the number of nodes a greedy beam search may visit per query.
+  size_t& NodeBudget() { return nodeBudget; }
+
   //! Access the reference dataset.
   const MatType& ReferenceSet() const { return *referenceSet; }
 
@@ -350,6 +462,10 @@ class NeighborSearch
   NeighborSearchMode searchMode;
   //! Indicates the relative error to be considered in approximate search.
   double epsilon;
+  //! The maximum number of leaves a greedy single-tree search may visit.
+  size_t leafBudget;
+  //! The maximum number of nodes a greedy beam search may visit.
+  size_t nodeBudget;
 
   //! Instantiation of metric.
   MetricType metric;
@@ -358,6 +474,8 @@ class NeighborSearch
   size_t baseCases;
   //! The total number of scores (applicable for non-naive search).
   size_t scores;
+  //! Aggregated traversal statistics from the last search.
+  tree::TraversalStatistics traversalStats;
 
   //! If this is true, the reference tree bounds need to be reset on a call to
   //! Search() without a query set.
@@ -65,6 +65,8 @@ SingleTreeTraversalType>::NeighborSearch(MatType referenceSetIn,
         &referenceTree->Dataset()),
     searchMode(mode),
     epsilon(epsilon),
+    leafBudget(1),
+    nodeBudget(size_t() - 1),
     metric(metric),
     baseCases(0),
     scores(0),
@@ -92,6 +94,8 @@ SingleTreeTraversalType>::NeighborSearch(Tree referenceTree,
     referenceSet(&this->referenceTree->Dataset()),
     searchMode(mode),
     epsilon(epsilon),
+    leafBudget(1),
+    nodeBudget(size_t() - 1),
     metric(metric),
     baseCases(0),
     scores(0),
@@ -118,6 +122,8 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
     referenceSet(mode == NAIVE_MODE ? new MatType() : NULL), // Empty matrix.
     searchMode(mode),
     epsilon(epsilon),
+    leafBudget(1),
+    nodeBudget(size_t() - 1),
     metric(metric),
     baseCases(0),
     scores(0),
@@ -152,6 +158,8 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearch& other) :
         new MatType(*other.referenceSet)),
     searchMode(other.searchMode),
     epsilon(other.epsilon),
+    leafBudget(other.leafBudget),
+    nodeBudget(other.nodeBudget),
     metric(other.metric),
     baseCases(other.baseCases),
     scores(other.scores),
@@ -176,6 +184,8 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
     referenceSet(other.referenceSet),
     searchMode(other.searchMode),
     epsilon(other.epsilon),
+    leafBudget(other.leafBudget),
+    nodeBudget(other.nodeBudget),
     metric(std::move(other.metric)),
     baseCases(other.baseCases),
     scores(other.scores),
@@ -187,6 +197,8 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
+  other.leafBudget = 1;
+  other.nodeBudget = size_t() - 1;
   other.baseCases = 0;
   other.scores = 0;
   other.treeNeedsReset = false;
@@ -229,6 +241,8 @@ NeighborSearch<SortPolicy,
       new MatType(*other.referenceSet);
   searchMode = other.searchMode;
   epsilon = other.epsilon;
+  leafBudget = other.leafBudget;
+  nodeBudget = other.nodeBudget;
   metric = other.metric;
   baseCases = other.baseCases;
   scores = other.scores;
@@ -271,6 +285,8 @@ NeighborSearch<SortPolicy,
   referenceSet = other.referenceSet;
   searchMode = other.searchMode;
   epsilon = other.epsilon;
+  leafBudget = other.leafBudget;
+  nodeBudget = other.nodeBudget;
   metric = other.metric;
   baseCases = other.baseCases;
   scores = other.scores;
@@ -285,6 +301,8 @@ NeighborSearch<SortPolicy,
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
+  other.leafBudget = 1;
+  other.nodeBudget = size_t() - 1;
   other.baseCases = 0;
   other.scores = 0;
   other.treeNeedsReset = false;
@@ -401,9 +419,11 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   }
 
   Timer::Start("computing_neighbors");
+  MLPACK_SCOPED_TRACE(computing_neighbors);
 
   baseCases = 0;
   scores = 0;
+  traversalStats.Reset();
 
   // This will hold mappings for query points, if necessary.
   std::vector<size_t> oldFromNewQueries;
@@ -452,25 +472,49 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
     case SINGLE_TREE_MODE:
     {
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric, epsilon);
+      // Each thread traverses batches of query points with its own rule set
+      // and traverser, so the only shared state is the read-only reference
+      // tree.  Batches of consecutive queries keep the candidate heaps and
+      // the leaf scans cache-friendly.  Without OpenMP this reduces to the
+      // usual serial traversal.
+      #pragma omp parallel
+      {
+        RuleType localRules(*referenceSet, querySet, k, metric, epsilon);
+        SingleTreeTraversalType<RuleType> localTraverser(localRules);
+        std::vector<size_t> localQueries;
 
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
+        #pragma omp for schedule(dynamic, 64) nowait
+        for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+        {
+          localTraverser.Traverse(i, *referenceTree);
+          localQueries.push_back(i);
+        }
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+        // Merge this thread's results; the query points handled by each
+        // thread are disjoint, so the copied columns never overlap.
+        arma::Mat<size_t> localNeighbors;
+        arma::mat localDistances;
+        localRules.GetResults(localNeighbors, localDistances);
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+        for (size_t i = 0; i < localQueries.size(); ++i)
+        {
+          neighborPtr->col(localQueries[i]) =
+              localNeighbors.col(localQueries[i]);
+          distancePtr->col(localQueries[i]) =
+              localDistances.col(localQueries[i]);
+        }
 
-      Log::Info << rules.Scores() << " node combinations were scored."
-          << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
-          << std::endl;
+        #pragma omp critical
+        {
+          scores += localRules.Scores();
+          baseCases += localRules.BaseCases();
+          traversalStats += localRules.TraversalStats();
+        }
+      }
 
-      rules.GetResults(*neighborPtr, *distancePtr);
+      Log::Info << scores << " node combinations were scored." << std::endl;
+      Log::Info << baseCases << " base cases were calculated." << std::endl;
+      Log::Info << "Traversal statistics: " << traversalStats << std::endl;
       break;
     }
     case DUAL_TREE_MODE:
@@ -482,48 +526,148 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       Timer::Stop("tree_building");
       Timer::Start("computing_neighbors");
 
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, epsilon);
+      size_t threads = 1;
+      #ifdef HAS_OPENMP
+        threads = (size_t) omp_get_max_threads();
+      #endif
 
-      // Create the traverser.
-      DualTreeTraversalType<RuleType> traverser(rules);
+      if (threads == 1 || queryTree->NumChildren() == 0)
+      {
+        // Create the helper object for the tree traversal.
+        RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, epsilon);
 
-      traverser.Traverse(*queryTree, *referenceTree);
+        // Create the traverser.
+        DualTreeTraversalType<RuleType> traverser(rules);
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+        traverser.Traverse(*queryTree, *referenceTree);
 
-      Log::Info << rules.Scores() << " node combinations were scored."
-          << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
-          << std::endl;
+        scores += rules.Scores();
+        baseCases += rules.BaseCases();
+        traversalStats += rules.TraversalStats();
 
-      rules.GetResults(*neighborPtr, *distancePtr);
+        rules.GetResults(*neighborPtr, *distancePtr);
+      }
+      else
+      {
+        // Decompose the query tree into a frontier of disjoint subtrees, one
+        // level at a time, until there is at least one subtree per thread.
+        // Each subtree can then be traversed against the shared (read-only)
+        // reference tree independently.
+        std::vector<Tree*> queryRoots(1, queryTree);
+        while (queryRoots.size() < threads)
+        {
+          std::vector<Tree*> nextRoots;
+          bool anySplit = false;
+          for (size_t i = 0; i < queryRoots.size(); ++i)
+          {
+            if (queryRoots[i]->NumChildren() == 0)
+            {
+              nextRoots.push_back(queryRoots[i]);
+            }
+            else
+            {
+              for (size_t c = 0; c < queryRoots[i]->NumChildren(); ++c)
+                nextRoots.push_back(&queryRoots[i]->Child(c));
+              anySplit = true;
+            }
+          }
+          queryRoots.swap(nextRoots);
+          if (!anySplit)
+            break; // All of the subtrees are leaves; we cannot go deeper.
+        }
+
+        #pragma omp parallel
+        {
+          // Each thread gets its own rule set and traverser; the subtrees
+          // handled by a thread cover disjoint sets of query points, so the
+          // per-thread results can be merged without synchronization.
+          RuleType localRules(*referenceSet, queryTree->Dataset(), k, metric,
+              epsilon);
+          DualTreeTraversalType<RuleType> localTraverser(localRules);
+          std::vector<Tree*> localRoots;
+
+          #pragma omp for schedule(dynamic) nowait
+          for (omp_size_t i = 0; i < (omp_size_t) queryRoots.size(); ++i)
+          {
+            localTraverser.Traverse(*queryRoots[i], *referenceTree);
+            localRoots.push_back(queryRoots[i]);
+          }
+
+          // Merge this thread's results into the output matrices.  Every
+          // query point belongs to exactly one subtree, so the columns
+          // written here are disjoint across threads.
+          arma::Mat<size_t> localNeighbors;
+          arma::mat localDistances;
+          localRules.GetResults(localNeighbors, localDistances);
+
+          for (size_t i = 0; i < localRoots.size(); ++i)
+          {
+            for (size_t j = 0; j < localRoots[i]->NumDescendants(); ++j)
+            {
+              const size_t query = localRoots[i]->Descendant(j);
+              neighborPtr->col(query) = localNeighbors.col(query);
+              distancePtr->col(query) = localDistances.col(query);
+            }
+          }
+
+          #pragma omp critical
+          {
+            scores += localRules.Scores();
+            baseCases += localRules.BaseCases();
+            traversalStats += localRules.TraversalStats();
+          }
+        }
+      }
+
+      Log::Info << scores << " node combinations were scored." << std::endl;
+      Log::Info << baseCases << " base cases were calculated." << std::endl;
+      Log::Info << "Traversal statistics: " << traversalStats << std::endl;
 
       delete queryTree;
       break;
     }
     case GREEDY_SINGLE_TREE_MODE:
     {
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric);
-
-      // Create the traverser.
-      tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
+      // Parallelized the same way as SINGLE_TREE_MODE above.
+      #pragma omp parallel
+      {
+        RuleType localRules(*referenceSet, querySet, k, metric);
+        tree::GreedySingleTreeTraverser<Tree, RuleType>
+            localTraverser(localRules);
+        localTraverser.LeafBudget() = leafBudget;
+        localTraverser.NodeBudget() = nodeBudget;
+        std::vector<size_t> localQueries;
+
+        #pragma omp for schedule(dynamic, 64) nowait
+        for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+        {
+          localTraverser.Traverse(i, *referenceTree);
+          localQueries.push_back(i);
+        }
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+        arma::Mat<size_t> localNeighbors;
+        arma::mat localDistances;
+        localRules.GetResults(localNeighbors, localDistances);
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+        for (size_t i = 0; i < localQueries.size(); ++i)
+        {
+          neighborPtr->col(localQueries[i]) =
+              localNeighbors.col(localQueries[i]);
+          distancePtr->col(localQueries[i]) =
+              localDistances.col(localQueries[i]);
+        }
 
-      Log::Info << rules.Scores() << " node combinations were scored."
-          << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
-          << std::endl;
+        #pragma omp critical
+        {
+          scores += localRules.Scores();
+          baseCases += localRules.BaseCases();
+          traversalStats += localRules.TraversalStats();
+        }
+      }
 
-      rules.GetResults(*neighborPtr, *distancePtr);
+      Log::Info << scores << " node combinations were scored." << std::endl;
+      Log::Info << baseCases << " base cases were calculated." << std::endl;
+      Log::Info << "Traversal statistics: " << traversalStats << std::endl;
       break;
     }
   }
@@ -590,6 +734,176 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   }
 } // Search()
 
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::SearchContext::~SearchContext()
+{
+  delete rules;
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances,
+    SearchContext& context)
+{
+  // A dual-tree search must build a tree over the query points on every call
+  // anyway, so there is almost nothing for the context to reuse; use the
+  // regular search path.
+  if (searchMode == DUAL_TREE_MODE)
+  {
+    Search(querySet, k, neighbors, distances);
+    return;
+  }
+
+  if (k > referenceSet->n_cols)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << referenceSet->n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  Timer::Start("computing_neighbors");
+  MLPACK_SCOPED_TRACE(computing_neighbors);
+
+  baseCases = 0;
+  scores = 0;
+  traversalStats.Reset();
+
+  typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
+
+  // The stored rule state can be reused only if the shape of the search has
+  // not changed since it was built.
+  const bool reusable = (context.rules != NULL) &&
+      (context.k == k) &&
+      (context.epsilon == epsilon) &&
+      (context.referenceSet == referenceSet) &&
+      (context.querySet.n_rows == querySet.n_rows) &&
+      (context.querySet.n_cols == querySet.n_cols);
+
+  // Copy the query set into the context's buffer; when the shape matches, the
+  // buffer's memory is reused and the references held by the rules stay
+  // valid.
+  context.querySet = querySet;
+
+  if (reusable)
+  {
+    context.rules->Reset();
+
+    // Replay the neighbor hints recorded by the previous search through this
+    // context; see SearchContext::previousNeighbors.  A brute-force search
+    // evaluates every pair anyway and gains nothing from tighter bounds.
+    if (searchMode != NAIVE_MODE &&
+        context.previousNeighbors.n_rows == k &&
+        context.previousNeighbors.n_cols == querySet.n_cols)
+    {
+      for (size_t i = 0; i < querySet.n_cols; ++i)
+      {
+        for (size_t j = 0; j < k; ++j)
+        {
+          const size_t hint = context.previousNeighbors(j, i);
+          if (hint < referenceSet->n_cols)
+            context.rules->WarmStart(i, hint);
+        }
+      }
+    }
+  }
+  else
+  {
+    delete context.rules;
+    context.rules = new RuleType(*referenceSet, context.querySet, k, metric,
+        epsilon);
+    context.referenceSet = referenceSet;
+    context.k = k;
+    context.epsilon = epsilon;
+  }
+
+  switch (searchMode)
+  {
+    case NAIVE_MODE:
+    {
+      // The naive brute-force search.
+      for (size_t i = 0; i < querySet.n_cols; ++i)
+        for (size_t j = 0; j < referenceSet->n_cols; ++j)
+          context.rules->BaseCase(i, j);
+
+      break;
+    }
+    case SINGLE_TREE_MODE:
+    {
+      // The context path is meant for latency-sensitive repeated small
+      // searches, so traverse serially through the reused rule state.
+      SingleTreeTraversalType<RuleType> traverser(*context.rules);
+      for (size_t i = 0; i < querySet.n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      break;
+    }
+    case GREEDY_SINGLE_TREE_MODE:
+    {
+      tree::GreedySingleTreeTraverser<Tree, RuleType>
+          traverser(*context.rules);
+      traverser.LeafBudget() = leafBudget;
+      traverser.NodeBudget() = nodeBudget;
+      for (size_t i = 0; i < querySet.n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      break;
+    }
+    case DUAL_TREE_MODE:
+      break; // Handled above.
+  }
+
+  scores += context.rules->Scores();
+  baseCases += context.rules->BaseCases();
+  traversalStats += context.rules->TraversalStats();
+
+  Log::Info << scores << " node combinations were scored." << std::endl;
+  Log::Info << baseCases << " base cases were calculated." << std::endl;
+
+  // Retrieve the results, using the context's temporary matrix when the
+  // reference indices need to be mapped back to their original ordering.
+  arma::Mat<size_t>* neighborPtr = &neighbors;
+  if (tree::TreeTraits<Tree>::RearrangesDataset &&
+      !oldFromNewReferences.empty())
+    neighborPtr = &context.unmappedNeighbors;
+
+  context.rules->GetResults(*neighborPtr, distances);
+
+  // Record the (unmapped) neighbors as hints for the next search through
+  // this context.
+  context.previousNeighbors = *neighborPtr;
+
+  Timer::Stop("computing_neighbors");
+
+  // Map the reference indices, if necessary.
+  if (neighborPtr != &neighbors)
+  {
+    neighbors.set_size(k, querySet.n_cols);
+    for (size_t i = 0; i < neighbors.n_cols; ++i)
+      for (size_t j = 0; j < neighbors.n_rows; ++j)
+        neighbors(j, i) = oldFromNewReferences[(*neighborPtr)(j, i)];
+  }
+} // Search()
+
 template<typename SortPolicy,
          typename MetricType,
          typename MatType,
@@ -620,9 +934,11 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
         "query tree when naive or singleMode are set to true");
 
   Timer::Start("computing_neighbors");
+  MLPACK_SCOPED_TRACE(computing_neighbors);
 
   baseCases = 0;
   scores = 0;
+  traversalStats.Reset();
 
   // Get a reference to the query set.
   const MatType& querySet = queryTree.Dataset();
@@ -647,9 +963,11 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   scores += rules.Scores();
   baseCases += rules.BaseCases();
+  traversalStats += rules.TraversalStats();
 
   Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
   Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
+  Log::Info << "Traversal statistics: " << traversalStats << std::endl;
 
   rules.GetResults(*neighborPtr, distances);
 
@@ -706,9 +1024,11 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   }
 
   Timer::Start("computing_neighbors");
+  MLPACK_SCOPED_TRACE(computing_neighbors);
 
   baseCases = 0;
   scores = 0;
+  traversalStats.Reset();
 
   arma::Mat<size_t>* neighborPtr = &neighbors;
   arma::mat* distancePtr = &distances;
@@ -725,10 +1045,18 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   neighborPtr->set_size(k, referenceSet->n_cols);
   distancePtr->set_size(k, referenceSet->n_cols);
 
-  // Create the helper object for the traversal.
+  // Create the helper object for the traversal.  For monochromatic dual-tree
+  // search we can perform a self-join: each unordered pair of points and nodes
+  // is considered only once, with results reflected into both candidate lists.
+  // This is not valid for trees whose scoring depends on base case results
+  // (trees where the first point is the centroid) or for spill trees (which
+  // hold duplicated points and use a separate query tree).
+  const bool selfJoin = (searchMode == DUAL_TREE_MODE) &&
+      !tree::TreeTraits<Tree>::FirstPointIsCentroid &&
+      !tree::IsSpillTree<Tree>::value;
   typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
   RuleType rules(*referenceSet, *referenceSet, k, metric, epsilon,
-      true /* don't return the same point as nearest neighbor */);
+      true /* don't return the same point as nearest neighbor */, selfJoin);
 
   switch (searchMode)
   {
@@ -753,11 +1081,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
+      traversalStats += rules.TraversalStats();
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
       Log::Info << rules.BaseCases() << " base cases were calculated."
           << std::endl;
+      Log::Info << "Traversal statistics: " << traversalStats << std::endl;
       break;
     }
     case DUAL_TREE_MODE:
@@ -801,11 +1131,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
+      traversalStats += rules.TraversalStats();
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
       Log::Info << rules.BaseCases() << " base cases were calculated."
           << std::endl;
+      Log::Info << "Traversal statistics: " << traversalStats << std::endl;
 
       // Next time we perform this search, we'll need to reset the tree.
       treeNeedsReset = true;
@@ -815,6 +1147,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     {
       // Create the traverser.
       tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
+      traverser.LeafBudget() = leafBudget;
+      traverser.NodeBudget() = nodeBudget;
 
       // Now have it traverse for each point.
       for (size_t i = 0; i < referenceSet->n_cols; ++i)
@@ -822,11 +1156,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
+      traversalStats += rules.TraversalStats();
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
       Log::Info << rules.BaseCases() << " base cases were calculated."
           << std::endl;
+      Log::Info << "Traversal statistics: " << traversalStats << std::endl;
       break;
     }
   }
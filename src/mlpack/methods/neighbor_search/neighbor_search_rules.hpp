@@ -14,8 +14,10 @@
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
+#include <mlpack/core/tree/tree_traits.hpp>
 
-#include <queue>
+#include <algorithm>
 
 namespace mlpack {
 namespace neighbor {
@@ -46,13 +48,23 @@ class NeighborSearchRules
    * @param epsilon Relative approximate error.
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
+   * @param selfJoin If true (this requires sameSet to be true), the rules
+   *      perform a self-join: each computed base case is reflected into both
+   *      points' candidate lists, mirrored base cases are skipped, and node
+   *      combinations whose mirrored orientation must be visited anyway are
+   *      pruned.  This is only valid for dual-tree traversals where the query
+   *      and reference trees are the same tree, and should not be used with
+   *      trees whose scoring depends on base case results (i.e. trees where
+   *      FirstPointIsCentroid is true) or trees that hold duplicated points
+   *      (i.e. spill trees).
    */
   NeighborSearchRules(const typename TreeType::Mat& referenceSet,
                       const typename TreeType::Mat& querySet,
                       const size_t k,
                       MetricType& metric,
                       const double epsilon = 0,
-                      const bool sameSet = false);
+                      const bool sameSet = false,
+                      const bool selfJoin = false);
 
   /**
    * Store the list of candidates for each query point in the given matrices.
@@ -63,6 +75,30 @@ class NeighborSearchRules
    */
   void GetResults(arma::Mat<size_t>& neighbors, arma::mat& distances);
 
+  /**
+   * Reset the rules so they can be reused for another search over the same
+   * query and reference sets (whose contents may have changed, but not their
+   * shapes).  The candidate lists are refilled in place, reusing their
+   * existing storage, so repeated searches through the same rule object do
+   * not reallocate; the traversal statistics are reset as well.
+   */
+  void Reset();
+
+  /**
+   * Seed the candidate list of the given query point with the given reference
+   * point, computing the distance immediately.  This is used to replay
+   * neighbor hints recorded from an earlier search over a similar batch of
+   * queries: the seeded candidates tighten the pruning bounds before the
+   * traversal starts, and the traversal falls back to its usual bound
+   * computations wherever the hints are stale.  Warm-started rules
+   * deduplicate candidate insertions, so a traversal that visits a seeded
+   * pair again does not produce duplicate results.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceIndex Index of reference point to seed with.
+   */
+  void WarmStart(const size_t queryIndex, const size_t referenceIndex);
+
   /**
    * Get the distance from the query point to the reference point.
    * This will update the list of candidates with the new point if appropriate
@@ -140,14 +176,19 @@ class NeighborSearchRules
                  const double oldScore) const;
 
   //! Get the number of base cases that have been performed.
-  size_t BaseCases() const { return baseCases; }
+  size_t BaseCases() const { return stats.BaseCases(); }
   //! Modify the number of base cases that have been performed.
-  size_t& BaseCases() { return baseCases; }
+  size_t& BaseCases() { return stats.BaseCases(); }
 
   //! Get the number of scores that have been performed.
-  size_t Scores() const { return scores; }
+  size_t Scores() const { return stats.Scores(); }
   //! Modify the number of scores that have been performed.
-  size_t& Scores() { return scores; }
+  size_t& Scores() { return stats.Scores(); }
+
+  //! Get the full set of traversal statistics.
+  const tree::TraversalStatistics& TraversalStats() const { return stats; }
+  //! Modify the full set of traversal statistics.
+  tree::TraversalStatistics& TraversalStats() { return stats; }
 
   //! Convenience typedef.
   typedef typename tree::TraversalInfo<TreeType> TraversalInfoType;
@@ -171,7 +212,9 @@ class NeighborSearchRules
   //! Candidate represents a possible candidate neighbor (distance, index).
   typedef std::pair<double, size_t> Candidate;
 
-  //! Compare two candidates based on the distance.
+  //! Compare two candidates based on the distance.  This orders candidates
+  //! from best to worst, so a heap built with it keeps the worst candidate at
+  //! the front.
   struct CandidateCmp {
     bool operator()(const Candidate& c1, const Candidate& c2)
     {
@@ -179,12 +222,19 @@ class NeighborSearchRules
     };
   };
 
-  //! Use a priority queue to represent the list of candidate neighbors.
-  typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-      CandidateList;
+  //! All candidate neighbors, in one contiguous pool: the slice
+  //! [queryIndex * k, (queryIndex + 1) * k) holds the candidates of the given
+  //! query point, maintained as a binary heap with the worst candidate at the
+  //! front.  Pooling the per-query heaps into a single allocation avoids one
+  //! allocation per query point, which dominates setup time for large k.
+  std::vector<Candidate> candidates;
 
-  //! Set of candidate neighbors for each point.
-  std::vector<CandidateList> candidates;
+  //! Return the distance of the worst candidate neighbor of a query point
+  //! (the front of its heap); this is the pruning bound for that point.
+  double WorstCandidateDistance(const size_t queryIndex) const
+  {
+    return candidates[queryIndex * k].first;
+  }
 
   //! Number of neighbors to search for.
   const size_t k;
@@ -195,6 +245,13 @@ class NeighborSearchRules
   //! Denotes whether or not the reference and query sets are the same.
   bool sameSet;
 
+  //! Denotes whether we are performing a self-join over a single tree.
+  bool selfJoin;
+
+  //! Denotes whether any candidate lists were seeded with WarmStart(); if so,
+  //! insertions must check for duplicates.
+  bool warmStarted;
+
   //! Relative error to be considered in approximate search.
   const double epsilon;
 
@@ -205,10 +262,9 @@ class NeighborSearchRules
   //! The last base case result.
   double lastBaseCase;
 
-  //! The number of base cases that have been performed.
-  size_t baseCases;
-  //! The number of scores that have been performed.
-  size_t scores;
+  //! Traversal counters (base cases, scores, prunes, bound updates).  This is
+  //! mutable because prunes are also counted in the const Rescore() methods.
+  mutable tree::TraversalStatistics stats;
 
   //! Traversal info for the parent combination; this is updated by the
   //! traversal before each call to Score().
@@ -219,6 +275,62 @@ class NeighborSearchRules
    */
   double CalculateBound(TreeType& queryNode) const;
 
+  /**
+   * Return true if, during a self-join, the given node combination is the
+   * mirror of a combination that the traversal is guaranteed to visit anyway,
+   * so that it can be pruned outright.  This is only possible for trees that
+   * rearrange the dataset, where each node owns a contiguous range of point
+   * indices: a combination whose reference range lies entirely before its
+   * query range is the mirror of the (kept) opposite orientation.  For other
+   * tree types no such order exists and we never prune this way; the self-join
+   * then still saves the mirrored base cases but not the mirrored node visits.
+   */
+  template<typename T = TreeType>
+  static typename std::enable_if<tree::TreeTraits<T>::RearrangesDataset,
+      bool>::type
+  MirroredNodeCombination(const T& queryNode, const T& referenceNode)
+  {
+    return (referenceNode.Begin() + referenceNode.Count() <= queryNode.Begin());
+  }
+
+  template<typename T = TreeType>
+  static typename std::enable_if<!tree::TreeTraits<T>::RearrangesDataset,
+      bool>::type
+  MirroredNodeCombination(const T& /* queryNode */,
+                          const T& /* referenceNode */)
+  {
+    return false;
+  }
+
+  /**
+   * Evaluate the distance between two points, forwarding the current pruning
+   * bound to metrics that support bounded (early-abandoning) evaluation; for
+   * other metrics this falls back to a full evaluation.  Pass 0 as the last
+   * argument, so that the bounded overload is preferred when it exists.  If
+   * the evaluation is abandoned, the result is only a lower bound on the true
+   * distance, so this may only be used where any result worse than the bound
+   * is discarded outright.
+   */
+  template<typename VecTypeA, typename VecTypeB>
+  auto EvaluateDistance(const VecTypeA& a,
+                        const VecTypeB& b,
+                        const double bound,
+                        const int /* preferBounded */)
+      -> decltype(std::declval<MetricType&>().Evaluate(a, b,
+          (typename VecTypeA::elem_type) bound))
+  {
+    return metric.Evaluate(a, b, (typename VecTypeA::elem_type) bound);
+  }
+
+  template<typename VecTypeA, typename VecTypeB>
+  double EvaluateDistance(const VecTypeA& a,
+                          const VecTypeB& b,
+                          const double /* bound */,
+                          const long /* preferBounded */)
+  {
+    return metric.Evaluate(a, b);
+  }
+
   /**
    * Helper function to insert a point into the list of candidate points.
    *
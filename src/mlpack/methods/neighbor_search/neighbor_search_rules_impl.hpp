@@ -26,17 +26,18 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
     const size_t k,
     MetricType& metric,
     const double epsilon,
-    const bool sameSet) :
+    const bool sameSet,
+    const bool selfJoin) :
     referenceSet(referenceSet),
     querySet(querySet),
     k(k),
     metric(metric),
     sameSet(sameSet),
+    selfJoin(selfJoin),
+    warmStarted(false),
     epsilon(epsilon),
     lastQueryIndex(querySet.n_cols),
-    lastReferenceIndex(referenceSet.n_cols),
-    baseCases(0),
-    scores(0)
+    lastReferenceIndex(referenceSet.n_cols)
 {
   // We must set the traversal info last query and reference node pointers to
   // something that is both invalid (i.e. not a tree node) and not NULL.  We'll
@@ -44,19 +45,15 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
   traversalInfo.LastQueryNode() = (TreeType*) this;
   traversalInfo.LastReferenceNode() = (TreeType*) this;
 
-  // Let's build the list of candidate neighbors for each query point.
-  // It will be initialized with k candidates: (WorstDistance, size_t() - 1)
-  // The list of candidates will be updated when visiting new points with the
+  // Let's build the pool of candidate neighbors for each query point.
+  // Each query point's slice of the pool is initialized with k candidates:
+  // (WorstDistance, size_t() - 1); identical elements trivially form a heap.
+  // The candidates will be updated when visiting new points with the
   // BaseCase() method.
   const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
       size_t() - 1);
 
-  std::vector<Candidate> vect(k, def);
-  CandidateList pqueue(CandidateCmp(), std::move(vect));
-
-  candidates.reserve(querySet.n_cols);
-  for (size_t i = 0; i < querySet.n_cols; ++i)
-    candidates.push_back(pqueue);
+  candidates.assign(k * querySet.n_cols, def);
 }
 
 template<typename SortPolicy, typename MetricType, typename TreeType>
@@ -69,16 +66,70 @@ void NeighborSearchRules<SortPolicy, MetricType, TreeType>::GetResults(
 
   for (size_t i = 0; i < querySet.n_cols; ++i)
   {
-    CandidateList& pqueue = candidates[i];
-    for (size_t j = 1; j <= k; ++j)
+    const typename std::vector<Candidate>::iterator begin =
+        candidates.begin() + i * k;
+
+    // Sorting the heap pops the worst candidates to the back, so the slice
+    // ends up ordered best-first.
+    std::sort_heap(begin, begin + k, CandidateCmp());
+    for (size_t j = 0; j < k; ++j)
     {
-      neighbors(k - j, i) = pqueue.top().second;
-      distances(k - j, i) = pqueue.top().first;
-      pqueue.pop();
+      neighbors(j, i) = (begin + j)->second;
+      distances(j, i) = (begin + j)->first;
     }
   }
 };
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+void NeighborSearchRules<SortPolicy, MetricType, TreeType>::Reset()
+{
+  // Refill the candidate pool with default candidates, in place; identical
+  // elements trivially form a heap, and no allocation happens here.
+  const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
+      size_t() - 1);
+
+  std::fill(candidates.begin(), candidates.end(), def);
+  warmStarted = false;
+
+  // Invalidate the cached last base case and the traversal info, exactly as
+  // the constructor does.
+  lastQueryIndex = querySet.n_cols;
+  lastReferenceIndex = referenceSet.n_cols;
+  traversalInfo = TraversalInfoType();
+  traversalInfo.LastQueryNode() = (TreeType*) this;
+  traversalInfo.LastReferenceNode() = (TreeType*) this;
+
+  stats.Reset();
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+void NeighborSearchRules<SortPolicy, MetricType, TreeType>::WarmStart(
+    const size_t queryIndex,
+    const size_t referenceIndex)
+{
+  warmStarted = true;
+
+  // The hint is a real candidate for this query point, so compute its
+  // distance and insert it exactly as a base case would (with early
+  // abandoning where the metric and sort policy allow it; see BaseCase()).
+  double distance;
+  if (!tree::TreeTraits<TreeType>::FirstPointIsCentroid &&
+      SortPolicy::IsBetter(0.0, 1.0))
+  {
+    distance = EvaluateDistance(querySet.col(queryIndex),
+        referenceSet.col(referenceIndex),
+        WorstCandidateDistance(queryIndex), 0);
+  }
+  else
+  {
+    distance = metric.Evaluate(querySet.col(queryIndex),
+                               referenceSet.col(referenceIndex));
+  }
+  ++stats.BaseCases();
+
+  InsertNeighbor(queryIndex, referenceIndex, distance);
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline force_inline // Absolutely MUST be inline so optimizations can happen.
 double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
@@ -89,16 +140,55 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   if (sameSet && (queryIndex == referenceIndex))
     return 0.0;
 
+  // In a self-join, each unordered point pair is evaluated only once; the
+  // mirrored pair is handled by the reflection below.
+  if (selfJoin && (queryIndex > referenceIndex))
+    return 0.0;
+
   // If we have already performed this base case, then do not perform it again.
   if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
     return lastBaseCase;
 
-  double distance = metric.Evaluate(querySet.col(queryIndex),
-                                    referenceSet.col(referenceIndex));
-  ++baseCases;
+  // When a result worse than the current k'th best distance would be
+  // discarded anyway---that is, when smaller distances are better---the
+  // metric may abandon the evaluation as soon as a partial sum already
+  // exceeds that bound (if it supports bounded evaluation; see
+  // EvaluateDistance()).  An abandoned result is only a lower bound on the
+  // true distance, so this cannot be used with trees that reuse base case
+  // results to assemble node bounds (those with FirstPointIsCentroid).
+  double distance;
+  if (!tree::TreeTraits<TreeType>::FirstPointIsCentroid &&
+      SortPolicy::IsBetter(0.0, 1.0))
+  {
+    double bound = WorstCandidateDistance(queryIndex);
+    if (selfJoin)
+    {
+      // The result is also reflected into the reference point's candidate
+      // list, so the evaluation may only be abandoned past the looser of the
+      // two bounds.
+      const double refBound = WorstCandidateDistance(referenceIndex);
+      if (SortPolicy::IsBetter(bound, refBound))
+        bound = refBound;
+    }
+
+    distance = EvaluateDistance(querySet.col(queryIndex),
+                                referenceSet.col(referenceIndex), bound, 0);
+  }
+  else
+  {
+    distance = metric.Evaluate(querySet.col(queryIndex),
+                               referenceSet.col(referenceIndex));
+  }
+  ++stats.BaseCases();
+  MLPACK_COUNT(neighbor_search_base_cases);
 
   InsertNeighbor(queryIndex, referenceIndex, distance);
 
+  // Reflect the result in a self-join: the reference point will never see this
+  // pair in the mirrored orientation, so update its candidate list too.
+  if (selfJoin)
+    InsertNeighbor(referenceIndex, queryIndex, distance);
+
   // Cache this information for the next time BaseCase() is called.
   lastQueryIndex = queryIndex;
   lastReferenceIndex = referenceIndex;
@@ -112,7 +202,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     const size_t queryIndex,
     TreeType& referenceNode)
 {
-  ++scores; // Count number of Score() calls.
+  ++stats.Scores(); // Count number of Score() calls.
   double distance;
   if (tree::TreeTraits<TreeType>::FirstPointIsCentroid)
   {
@@ -143,18 +233,32 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
   }
 
   // Compare against the best k'th distance for this query point so far.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = WorstCandidateDistance(queryIndex);
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
-  return (SortPolicy::IsBetter(distance, bestDistance)) ?
-      SortPolicy::ConvertToScore(distance) : DBL_MAX;
+  // In a self-join, the base cases guarded by this score are also reflected
+  // into the reference node's candidate lists, so we may only prune when the
+  // reference node's neighbor bound cannot be improved either.
+  if (selfJoin)
+  {
+    const double refBound = CalculateBound(referenceNode);
+    if (SortPolicy::IsBetter(bestDistance, refBound))
+      bestDistance = refBound;
+  }
+
+  if (SortPolicy::IsBetter(distance, bestDistance))
+    return SortPolicy::ConvertToScore(distance);
+
+  ++stats.ScorePrunes();
+  MLPACK_COUNT(neighbor_search_score_prunes);
+  return DBL_MAX;
 }
 
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline size_t NeighborSearchRules<SortPolicy, MetricType, TreeType>::
 GetBestChild(const size_t queryIndex, TreeType& referenceNode)
 {
-  ++scores;
+  ++stats.Scores();
   return SortPolicy::GetBestChild(querySet.col(queryIndex), referenceNode);
 }
 
@@ -162,14 +266,14 @@ template<typename SortPolicy, typename MetricType, typename TreeType>
 inline size_t NeighborSearchRules<SortPolicy, MetricType, TreeType>::
 GetBestChild(const TreeType& queryNode, TreeType& referenceNode)
 {
-  ++scores;
+  ++stats.Scores();
   return SortPolicy::GetBestChild(queryNode, referenceNode);
 }
 
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
     const size_t queryIndex,
-    TreeType& /* referenceNode */,
+    TreeType& referenceNode,
     const double oldScore) const
 {
   // If we are already pruning, still prune.
@@ -179,10 +283,23 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
   const double distance = SortPolicy::ConvertToDistance(oldScore);
 
   // Just check the score again against the distances.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = WorstCandidateDistance(queryIndex);
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
-  return (SortPolicy::IsBetter(distance, bestDistance)) ? oldScore : DBL_MAX;
+  // As in Score(), a self-join may only prune when the reference node's
+  // neighbor bound cannot be improved either.
+  if (selfJoin)
+  {
+    const double refBound = CalculateBound(referenceNode);
+    if (SortPolicy::IsBetter(bestDistance, refBound))
+      bestDistance = refBound;
+  }
+
+  if (SortPolicy::IsBetter(distance, bestDistance))
+    return oldScore;
+
+  ++stats.RescorePrunes();
+  return DBL_MAX;
 }
 
 template<typename SortPolicy, typename MetricType, typename TreeType>
@@ -190,10 +307,28 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     TreeType& queryNode,
     TreeType& referenceNode)
 {
-  ++scores; // Count number of Score() calls.
+  ++stats.Scores(); // Count number of Score() calls.
+
+  // In a self-join, a combination whose mirror is guaranteed to be visited can
+  // be pruned immediately.
+  if (selfJoin && MirroredNodeCombination(queryNode, referenceNode))
+  {
+    ++stats.ScorePrunes();
+    return DBL_MAX;
+  }
 
   // Update our bound.
-  const double bestDistance = CalculateBound(queryNode);
+  double bestDistance = CalculateBound(queryNode);
+
+  // In a self-join, this combination also serves the reference node's points
+  // (by reflection), so we may only prune when neither node's neighbor bound
+  // could possibly be improved; take the looser of the two bounds.
+  if (selfJoin)
+  {
+    const double refBound = CalculateBound(referenceNode);
+    if (SortPolicy::IsBetter(bestDistance, refBound))
+      bestDistance = refBound;
+  }
 
   // Use the traversal info to see if a parent-child or parent-parent prune is
   // possible.  This is a looser bound than we could make, but it might be
@@ -290,6 +425,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
       // There isn't any need to set the traversal information because no
       // descendant combinations will be visited, and those are the only
       // combinations that would depend on the traversal information.
+      ++stats.ScorePrunes();
       return DBL_MAX;
     }
   }
@@ -342,6 +478,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     // There isn't any need to set the traversal information because no
     // descendant combinations will be visited, and those are the only
     // combinations that would depend on the traversal information.
+    ++stats.ScorePrunes();
     return DBL_MAX;
   }
 }
@@ -349,7 +486,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
     TreeType& queryNode,
-    TreeType& /* referenceNode */,
+    TreeType& referenceNode,
     const double oldScore) const
 {
   if (oldScore == DBL_MAX || oldScore == 0.0)
@@ -358,9 +495,22 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
   const double distance = SortPolicy::ConvertToDistance(oldScore);
 
   // Update our bound.
-  const double bestDistance = CalculateBound(queryNode);
+  double bestDistance = CalculateBound(queryNode);
 
-  return (SortPolicy::IsBetter(distance, bestDistance)) ? oldScore : DBL_MAX;
+  // As in Score(), a self-join may only prune when neither node's neighbor
+  // bound could possibly be improved.
+  if (selfJoin)
+  {
+    const double refBound = CalculateBound(referenceNode);
+    if (SortPolicy::IsBetter(bestDistance, refBound))
+      bestDistance = refBound;
+  }
+
+  if (SortPolicy::IsBetter(distance, bestDistance))
+    return oldScore;
+
+  ++stats.RescorePrunes();
+  return DBL_MAX;
 }
 
 // Calculate the bound for a given query node in its current state and update
@@ -404,7 +554,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
   // Loop over points held in the node.
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double distance = candidates[queryNode.Point(i)].top().first;
+    const double distance = WorstCandidateDistance(queryNode.Point(i));
     if (SortPolicy::IsBetter(worstDistance, distance))
       worstDistance = distance;
     if (SortPolicy::IsBetter(distance, bestPointDistance))
@@ -499,13 +649,27 @@ InsertNeighbor(
     const size_t neighbor,
     const double distance)
 {
-  CandidateList& pqueue = candidates[queryIndex];
-  Candidate c = std::make_pair(distance, neighbor);
+  const typename std::vector<Candidate>::iterator begin =
+      candidates.begin() + queryIndex * k;
+  const Candidate c = std::make_pair(distance, neighbor);
 
-  if (CandidateCmp()(c, pqueue.top()))
+  // If the point is better than the worst candidate (the front of the heap),
+  // replace that candidate and restore the heap.
+  if (CandidateCmp()(c, *begin))
   {
-    pqueue.pop();
-    pqueue.push(c);
+    // A traversal over warm-started rules may visit a seeded pair again; do
+    // not insert the same neighbor twice.
+    if (warmStarted)
+    {
+      for (size_t j = 0; j < k; ++j)
+        if ((begin + j)->second == neighbor)
+          return;
+    }
+
+    std::pop_heap(begin, begin + k, CandidateCmp());
+    *(begin + k - 1) = c;
+    std::push_heap(begin, begin + k, CandidateCmp());
+    ++stats.BoundUpdates();
   }
 }
 
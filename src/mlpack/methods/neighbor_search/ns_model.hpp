@@ -21,6 +21,7 @@
 #include <mlpack/core/tree/rectangle_tree.hpp>
 #include <mlpack/core/tree/spill_tree.hpp>
 #include <mlpack/core/tree/octree.hpp>
+#include <mlpack/core/tree/leaf_size_tuner.hpp>
 #include "neighbor_search.hpp"
 
 namespace mlpack {
@@ -453,11 +454,30 @@ class NSModel
   void InitializeModel(const NeighborSearchMode searchMode,
                        const double epsilon);
 
-  //! Build the reference tree.
+  /**
+   * Build the reference tree.  If LeafSize() is zero, a leaf size is first
+   * selected automatically (see TuneLeafSize()).
+   */
   void BuildModel(arma::mat&& referenceSet,
                   const NeighborSearchMode searchMode,
                   const double epsilon = 0);
 
+  /**
+   * Select a leaf size for the given reference set by measuring the
+   * build-and-search cost of a ladder of candidate leaf sizes on a sample of
+   * the reference set (see tree::LeafSizeTuner), and store it in LeafSize().
+   * If the current tree type is not built with a leaf size, the search mode
+   * is brute-force, or the reference set is too small for calibration to be
+   * meaningful, the default leaf size of 20 is stored instead.
+   *
+   * @param referenceSet Reference set the model will be built on.
+   * @param searchMode Search mode the model will be used in.
+   * @param epsilon Error bound the model will be used with.
+   */
+  void TuneLeafSize(const arma::mat& referenceSet,
+                    const NeighborSearchMode searchMode,
+                    const double epsilon);
+
   //! Perform neighbor search.  The query set will be reordered.
   void Search(arma::mat&& querySet,
               const size_t k,
@@ -469,6 +489,29 @@ class NSModel
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
+  /**
+   * Perform neighbor search, automatically selecting the fastest search mode
+   * for the given query batch.  A small strided sample of the query set is
+   * timed with dual-tree, single-tree and brute-force search (reusing the
+   * already-built tree), SearchMode() is set to the fastest, and the whole
+   * query set is then searched with it.  Greedy search is not considered,
+   * because its results are approximate.  If the query set is too small for
+   * the calibration to pay off, or the model was built for brute-force
+   * search (and thus holds no tree), the current search mode is used
+   * directly.
+   *
+   * @param querySet Query set (this will be reordered).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Output matrix to store neighbor indices into.
+   * @param distances Output matrix to store neighbor distances into.
+   * @param sampleSize Number of query points to time each strategy with.
+   */
+  void AutoSearch(arma::mat&& querySet,
+                  const size_t k,
+                  arma::Mat<size_t>& neighbors,
+                  arma::mat& distances,
+                  const size_t sampleSize = 100);
+
   //! Return a string representation of the current tree type.
   std::string TreeName() const;
 };
@@ -561,6 +561,12 @@ void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
   if (randomBasis)
     referenceSet = q * referenceSet;
 
+  // A leaf size of zero requests automatic selection.  Tune on the (possibly
+  // projected) reference set, so that the calibration sees the same data the
+  // tree will be built on.
+  if (leafSize == 0)
+    TuneLeafSize(referenceSet, searchMode, epsilon);
+
   if (searchMode != NAIVE_MODE)
   {
     Timer::Start("tree_building");
@@ -577,6 +583,54 @@ void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
   }
 }
 
+//! Select a leaf size for the given reference set empirically.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::TuneLeafSize(const arma::mat& referenceSet,
+                                       const NeighborSearchMode searchMode,
+                                       const double epsilon)
+{
+  // Only some of the tree types are built with a leaf size; for the others
+  // (and for brute-force search, which builds no tree) there is nothing to
+  // tune.  Small reference sets are too noisy to calibrate on.
+  const bool usesLeafSize = (treeType == TreeTypes::KD_TREE ||
+      treeType == TreeTypes::BALL_TREE || treeType == TreeTypes::OCTREE ||
+      treeType == TreeTypes::SPILL_TREE);
+  if (!usesLeafSize || searchMode == NAIVE_MODE || referenceSet.n_cols < 100)
+  {
+    leafSize = 20; // Fall back to the usual default.
+    return;
+  }
+
+  Timer::Start("leaf_size_tuning");
+
+  // Sample the reference set so that calibration stays cheap even on large
+  // datasets.
+  arma::uvec samples;
+  math::ObtainDistinctSamples(0, referenceSet.n_cols, 2000, samples);
+  const arma::mat sampleSet = referenceSet.cols(samples);
+
+  // Use a small monochromatic search as the representative query workload.
+  const size_t k = 3;
+  leafSize = tree::LeafSizeTuner::Tune(
+      [&](const size_t candidate)
+      {
+        NSModel<SortPolicy> trial(treeType, false);
+        trial.LeafSize() = candidate;
+        trial.Tau() = tau;
+        trial.Rho() = rho;
+
+        arma::mat trialSet(sampleSet);
+        trial.BuildModel(std::move(trialSet), searchMode, epsilon);
+
+        arma::Mat<size_t> neighbors;
+        arma::mat distances;
+        trial.Search(k, neighbors, distances);
+      });
+
+  Timer::Stop("leaf_size_tuning");
+  Log::Info << "Selected leaf size " << leafSize << "." << std::endl;
+}
+
 //! Perform neighbor search.  The query set will be reordered.
 template<typename SortPolicy>
 void NSModel<SortPolicy>::Search(arma::mat&& querySet,
@@ -642,6 +696,95 @@ void NSModel<SortPolicy>::Search(const size_t k,
   nSearch->Search(k, neighbors, distances);
 }
 
+//! Perform neighbor search with automatic search mode selection.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::AutoSearch(arma::mat&& querySet,
+                                     const size_t k,
+                                     arma::Mat<size_t>& neighbors,
+                                     arma::mat& distances,
+                                     const size_t sampleSize)
+{
+  // Small batches are not worth calibrating; search with the current mode.
+  if (sampleSize == 0 || querySet.n_cols <= 2 * sampleSize)
+  {
+    Search(std::move(querySet), k, neighbors, distances);
+    return;
+  }
+
+  // We may need to map the query set randomly.  This is done once here, and
+  // the search below goes through the wrapper directly so that the mapping is
+  // not applied twice.
+  if (randomBasis)
+    querySet = q * querySet;
+
+  // A model built for brute-force search holds no tree, so there are no
+  // other strategies to try.
+  if (SearchMode() == NAIVE_MODE)
+  {
+    Log::Info << "Searching for " << k << " neighbors with brute-force "
+        << "(naive) search..." << std::endl;
+    nSearch->Search(std::move(querySet), k, neighbors, distances, leafSize,
+        rho);
+    return;
+  }
+
+  // Gather a strided sample of the query set, so that the sample reflects
+  // the composition of the whole batch.
+  const size_t stride = querySet.n_cols / sampleSize;
+  arma::mat sample(querySet.n_rows, sampleSize);
+  for (size_t i = 0; i < sampleSize; ++i)
+    sample.col(i) = querySet.col(i * stride);
+
+  // Time each exact strategy on the sample, reusing the built tree.  Greedy
+  // search is excluded because its results are approximate.
+  const NeighborSearchMode candidates[3] =
+      { DUAL_TREE_MODE, SINGLE_TREE_MODE, NAIVE_MODE };
+  const char* candidateNames[3] =
+      { "dual-tree", "single-tree", "brute-force (naive)" };
+
+  NeighborSearchMode bestMode = DUAL_TREE_MODE;
+  double bestTime = DBL_MAX;
+  arma::wall_clock clock;
+  for (size_t m = 0; m < 3; ++m)
+  {
+    SearchMode() = candidates[m];
+
+    arma::Mat<size_t> sampleNeighbors;
+    arma::mat sampleDistances;
+    clock.tic();
+    nSearch->Search(arma::mat(sample), k, sampleNeighbors, sampleDistances,
+        leafSize, rho);
+    const double time = clock.toc();
+
+    Log::Info << "AutoSearch(): " << candidateNames[m] << " search took "
+        << time << "s on a sample of " << sampleSize << " queries."
+        << std::endl;
+
+    if (time < bestTime)
+    {
+      bestTime = time;
+      bestMode = candidates[m];
+    }
+  }
+
+  SearchMode() = bestMode;
+  Log::Info << "Searching for " << k << " neighbors with ";
+  switch (bestMode)
+  {
+    case NAIVE_MODE:
+      Log::Info << "brute-force (naive) search..." << std::endl;
+      break;
+    case SINGLE_TREE_MODE:
+      Log::Info << "single-tree " << TreeName() << " search..." << std::endl;
+      break;
+    default:
+      Log::Info << "dual-tree " << TreeName() << " search..." << std::endl;
+      break;
+  }
+
+  nSearch->Search(std::move(querySet), k, neighbors, distances, leafSize, rho);
+}
+
 //! Get the name of the tree type.
 template<typename SortPolicy>
 std::string NSModel<SortPolicy>::TreeName() const
@@ -0,0 +1,137 @@
+/**
+ * @file methods/neighbor_search/sharded_neighbor_search.hpp
+ *
+ * Neighbor search over a reference set that is split into shards, each with
+ * its own tree, with bound-based shard pruning before queries are fanned out
+ * to the shards.  This is the single-process core of a distributed search:
+ * each shard holds exactly the state one node of a cluster would hold.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_HPP
+
+#include "neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The ShardedNeighborSearch class performs neighbor search over a reference
+ * set that has been split into several shards, each holding its own tree and
+ * its own NeighborSearch object.  The root bounds of the shard trees act as a
+ * routing table: searching proceeds in rounds, where every query point visits
+ * its most promising unvisited shard, and a shard is only searched for the
+ * queries whose current k-th best result it could still improve.  After the
+ * first round, most queries are already resolved and the remaining rounds
+ * fan out to very few shards.
+ *
+ * Each shard is self-contained (its own dataset, tree, and search state), so
+ * this class is also the in-process skeleton of a distributed search: a
+ * transport layer can place one shard per node, broadcast the per-round query
+ * batches, and merge the returned candidate lists exactly as Search() does
+ * here.
+ *
+ * The shards are contiguous column blocks of the given reference set; shard
+ * pruning is most effective when nearby points land in the same shard, so it
+ * can pay off to order the reference points spatially before constructing
+ * this object.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MetricType The metric to use for computation.
+ * @tparam MatType The type of data matrix.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MetricType = mlpack::metric::EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = tree::KDTree>
+class ShardedNeighborSearch
+{
+ public:
+  //! Convenience typedef for the search object of a single shard.
+  typedef NeighborSearch<SortPolicy, MetricType, MatType, TreeType>
+      ShardSearchType;
+
+  /**
+   * Initialize the ShardedNeighborSearch object, splitting the given
+   * reference set into the given number of shards (contiguous column blocks)
+   * and building a tree for each shard.
+   *
+   * NAIVE_MODE is not supported, because the shard trees double as the
+   * routing table for shard pruning.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numShards Number of shards to split the reference set into; must
+   *      be at least 1 and at most the number of reference points.
+   * @param mode Neighbor search mode used within each shard.
+   * @param epsilon Relative approximate error (non-negative).
+   * @param metric An optional instance of the MetricType class.
+   */
+  ShardedNeighborSearch(MatType referenceSet,
+                        const size_t numShards,
+                        const NeighborSearchMode mode = DUAL_TREE_MODE,
+                        const double epsilon = 0,
+                        const MetricType metric = MetricType());
+
+  /**
+   * For each point in the query set, compute the nearest neighbors over all
+   * shards and store the output in the given matrices, which are resized to
+   * the appropriate size.  The shards are visited in rounds, best shard
+   * first, and a shard is pruned for a query once the query's current k-th
+   * best distance is better than the best possible distance to the shard.
+   *
+   * @param querySet Set of query points (can be just one point).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point,
+   *      as indices into the original reference set.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  //! Return the number of shards.
+  size_t NumShards() const { return shards.size(); }
+
+  //! Return the search object of the given shard.
+  const ShardSearchType& Shard(const size_t i) const { return shards[i]; }
+
+  //! Return the total number of base case evaluations performed by all
+  //! shards during the last search.
+  size_t BaseCases() const;
+
+ private:
+  /**
+   * Merge the sorted candidate list a shard returned for one query into the
+   * query's global sorted result list, translating the shard-local reference
+   * indices by the shard's column offset.
+   */
+  void MergeShardResults(const size_t queryIndex,
+                         const size_t shardOffset,
+                         const size_t shardQueryIndex,
+                         const arma::Mat<size_t>& shardNeighbors,
+                         const arma::mat& shardDistances,
+                         arma::Mat<size_t>& neighbors,
+                         arma::mat& distances) const;
+
+  //! The per-shard search objects, each owning its shard's dataset and tree.
+  std::vector<ShardSearchType> shards;
+  //! Column offset of each shard in the original reference set.
+  std::vector<size_t> shardOffsets;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "sharded_neighbor_search_impl.hpp"
+
+#endif
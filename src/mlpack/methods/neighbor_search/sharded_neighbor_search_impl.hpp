@@ -0,0 +1,239 @@
+/**
+ * @file methods/neighbor_search/sharded_neighbor_search_impl.hpp
+ *
+ * Implementation of the ShardedNeighborSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sharded_neighbor_search.hpp"
+
+#include <algorithm>
+
+namespace mlpack {
+namespace neighbor {
+
+// Construct the object, splitting the reference set into shards.
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+ShardedNeighborSearch(MatType referenceSet,
+                      const size_t numShards,
+                      const NeighborSearchMode mode,
+                      const double epsilon,
+                      const MetricType metric)
+{
+  if (numShards == 0)
+    throw std::invalid_argument("at least one shard is required");
+  if (numShards > referenceSet.n_cols)
+  {
+    std::stringstream ss;
+    ss << "Requested number of shards (" << numShards << ") is greater than "
+        << "the number of points in the reference set ("
+        << referenceSet.n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+  if (mode == NAIVE_MODE)
+    throw std::invalid_argument("naive search is not supported by "
+        "ShardedNeighborSearch; the shard trees are needed for shard "
+        "pruning");
+
+  // Split the reference set into contiguous column blocks of (nearly) equal
+  // size, and build a search object (and thus a tree) for each block.
+  shards.reserve(numShards);
+  shardOffsets.reserve(numShards);
+  for (size_t s = 0; s < numShards; ++s)
+  {
+    const size_t begin = (s * referenceSet.n_cols) / numShards;
+    const size_t end = (((s + 1) * referenceSet.n_cols) / numShards) - 1;
+    shardOffsets.push_back(begin);
+    shards.emplace_back(MatType(referenceSet.cols(begin, end)), mode, epsilon,
+        metric);
+  }
+}
+
+// Search for the k nearest neighbors over all shards.
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+Search(const MatType& querySet,
+       const size_t k,
+       arma::Mat<size_t>& neighbors,
+       arma::mat& distances)
+{
+  // The number of reference points is the sum of the shard sizes, which is
+  // the number of columns of the original reference set.
+  size_t referencePoints = 0;
+  for (size_t s = 0; s < shards.size(); ++s)
+    referencePoints += shards[s].ReferenceSet().n_cols;
+  if (k > referencePoints)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << referencePoints << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  neighbors.fill(size_t() - 1);
+  distances.set_size(k, querySet.n_cols);
+  distances.fill(SortPolicy::WorstDistance());
+
+  // Build the routing table: the best possible distance from each query point
+  // to each shard's tree root bound.  This is the information a distributed
+  // implementation would replicate on every node.
+  arma::mat shardBestDist(shards.size(), querySet.n_cols);
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+    for (size_t s = 0; s < shards.size(); ++s)
+      shardBestDist(s, q) = SortPolicy::BestPointToNodeDistance(
+          querySet.col(q), &shards[s].ReferenceTree());
+
+  // For each query point, order the shards from most to least promising.
+  arma::Mat<size_t> shardOrder(shards.size(), querySet.n_cols);
+  std::vector<size_t> order(shards.size());
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    for (size_t s = 0; s < shards.size(); ++s)
+      order[s] = s;
+    std::sort(order.begin(), order.end(),
+        [&](const size_t a, const size_t b)
+        {
+          return SortPolicy::IsBetter(shardBestDist(a, q),
+              shardBestDist(b, q));
+        });
+    for (size_t s = 0; s < shards.size(); ++s)
+      shardOrder(s, q) = order[s];
+  }
+
+  // Fan the queries out to the shards in rounds.  In round r, each query
+  // visits its r-th most promising shard, but only if that shard's bound
+  // could still improve the query's current k-th best result.  Each round is
+  // one batched search per shard, which in a distributed implementation would
+  // be one request per node.
+  std::vector<std::vector<size_t>> shardQueries(shards.size());
+  for (size_t round = 0; round < shards.size(); ++round)
+  {
+    for (size_t s = 0; s < shards.size(); ++s)
+      shardQueries[s].clear();
+
+    size_t activeQueries = 0;
+    for (size_t q = 0; q < querySet.n_cols; ++q)
+    {
+      const size_t s = shardOrder(round, q);
+      if (SortPolicy::IsBetter(shardBestDist(s, q), distances(k - 1, q)))
+      {
+        shardQueries[s].push_back(q);
+        ++activeQueries;
+      }
+    }
+
+    // All queries have been resolved; later rounds would be no-ops too, since
+    // each query's shard order is sorted from most to least promising.
+    if (activeQueries == 0)
+      break;
+
+    for (size_t s = 0; s < shards.size(); ++s)
+    {
+      if (shardQueries[s].empty())
+        continue;
+
+      // Gather the active query points into one batch for this shard.
+      MatType shardQuerySet(querySet.n_rows, shardQueries[s].size());
+      for (size_t i = 0; i < shardQueries[s].size(); ++i)
+        shardQuerySet.col(i) = querySet.col(shardQueries[s][i]);
+
+      // A shard may hold fewer than k points; it then contributes as many
+      // candidates as it has.
+      const size_t shardK = std::min(k,
+          (size_t) shards[s].ReferenceSet().n_cols);
+
+      arma::Mat<size_t> shardNeighbors;
+      arma::mat shardDistances;
+      shards[s].Search(shardQuerySet, shardK, shardNeighbors, shardDistances);
+
+      for (size_t i = 0; i < shardQueries[s].size(); ++i)
+        MergeShardResults(shardQueries[s][i], shardOffsets[s], i,
+            shardNeighbors, shardDistances, neighbors, distances);
+    }
+  }
+}
+
+// Merge one shard's sorted candidate list into the global result list.
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+MergeShardResults(const size_t queryIndex,
+                  const size_t shardOffset,
+                  const size_t shardQueryIndex,
+                  const arma::Mat<size_t>& shardNeighbors,
+                  const arma::mat& shardDistances,
+                  arma::Mat<size_t>& neighbors,
+                  arma::mat& distances) const
+{
+  const size_t k = neighbors.n_rows;
+  arma::Col<size_t> mergedNeighbors(k);
+  arma::vec mergedDistances(k);
+
+  // Both lists are sorted from best to worst, so one pass over the two lists
+  // suffices to keep the k best candidates overall.
+  size_t i = 0, j = 0;
+  for (size_t m = 0; m < k; ++m)
+  {
+    if (j < shardNeighbors.n_rows &&
+        SortPolicy::IsBetter(shardDistances(j, shardQueryIndex),
+            distances(i, queryIndex)))
+    {
+      mergedNeighbors[m] = shardNeighbors(j, shardQueryIndex) + shardOffset;
+      mergedDistances[m] = shardDistances(j, shardQueryIndex);
+      ++j;
+    }
+    else
+    {
+      mergedNeighbors[m] = neighbors(i, queryIndex);
+      mergedDistances[m] = distances(i, queryIndex);
+      ++i;
+    }
+  }
+
+  neighbors.col(queryIndex) = mergedNeighbors;
+  distances.col(queryIndex) = mergedDistances;
+}
+
+// Sum the base case counts over all shards.
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+BaseCases() const
+{
+  size_t baseCases = 0;
+  for (size_t s = 0; s < shards.size(); ++s)
+    baseCases += shards[s].BaseCases();
+  return baseCases;
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * @file methods/neighbor_search/spill_search_tuner.hpp
+ *
+ * Defines the SpillSearchTuner class, which calibrates the overlap parameter
+ * tau of defeatist spill tree search (see DefeatistKNN and SpillKNN) against a
+ * target recall, and provides cheap sampled recall estimation for approximate
+ * search results.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_SEARCH_TUNER_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_SEARCH_TUNER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/spill_tree.hpp>
+#include "neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The SpillSearchTuner class provides the pieces needed to deploy defeatist
+ * spill tree search (see DefeatistKNN and SpillKNN) under an accuracy
+ * requirement.  Defeatist search trades recall for speed, and the achieved
+ * recall depends heavily on the overlap parameter tau of the spill tree;
+ * without calibration there is no way to know what recall a given tau will
+ * deliver on a given dataset.
+ *
+ * TuneTau() selects tau empirically: it runs exact search on a sampled subset
+ * of the reference set to obtain ground truth, then sweeps a ladder of tau
+ * values (scaled by the observed kth-neighbor distances) and returns the
+ * smallest tau whose defeatist recall on the sample meets the target.
+ * EstimateRecall() estimates the recall of a finished approximate search by
+ * exactly solving a small random sample of the queries, avoiding a full exact
+ * run.
+ *
+ * Both estimates are sampled, so they carry sampling error; they are meant to
+ * guide deployment, not to certify exact recall.  Calibration uses
+ * single-tree defeatist search (the canonical defeatist strategy).
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MatType The type of data matrix.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MatType = arma::mat>
+class SpillSearchTuner
+{
+ public:
+  //! Convenience typedef for the spill tree type that is calibrated.
+  typedef tree::SPTree<metric::EuclideanDistance,
+      NeighborSearchStat<SortPolicy>, MatType> Tree;
+
+  //! Convenience typedef for defeatist neighbor search on that tree.
+  typedef NeighborSearch<SortPolicy,
+      metric::EuclideanDistance,
+      MatType,
+      tree::SPTree,
+      Tree::template DefeatistDualTreeTraverser,
+      Tree::template DefeatistSingleTreeTraverser> SpillSearchType;
+
+  /**
+   * Compute the recall of the found neighbors against the exact neighbors.
+   * The recall is the fraction of exact neighbors that appear in the found
+   * neighbors of the same query point; 1.0 indicates perfect recall and 0.0
+   * indicates that no exact neighbor was found.  Both matrices must have the
+   * same size, with one column per query point.
+   *
+   * @param foundNeighbors Matrix of neighbors found by approximate search.
+   * @param exactNeighbors Matrix of exact neighbors.
+   */
+  static double Recall(const arma::Mat<size_t>& foundNeighbors,
+                       const arma::Mat<size_t>& exactNeighbors);
+
+  /**
+   * Estimate the recall of the given approximate search results by exactly
+   * solving a random sample of the queries with brute-force search.  The cost
+   * is O(sampleSize * n * d), independent of how many queries were answered,
+   * so this is cheap enough to run online after each batch of searches.
+   *
+   * @param referenceSet Reference set the search was performed on.
+   * @param querySet Query set the search was performed with.
+   * @param foundNeighbors Neighbors returned by the approximate search (one
+   *      column per query point).
+   * @param sampleSize Maximum number of queries to solve exactly.
+   * @return Estimated recall, between 0.0 and 1.0.
+   */
+  static double EstimateRecall(const MatType& referenceSet,
+                               const MatType& querySet,
+                               const arma::Mat<size_t>& foundNeighbors,
+                               const size_t sampleSize = 100);
+
+  /**
+   * Calibrate the overlap parameter tau against a target recall.  A subset of
+   * the reference set is sampled, exact neighbors of sampled query points are
+   * computed within it, and increasing values of tau (scaled by the median
+   * kth-neighbor distance of the sample) are tried until single-tree
+   * defeatist search reaches the target recall on the sample.  The smallest
+   * such tau is returned; if no candidate reaches the target, the candidate
+   * with the highest recall is returned and a warning is printed.
+   *
+   * The returned tau can be passed directly to the SpillTree constructor (or
+   * to SpillNSWrapper::Train()) for the full reference set.
+   *
+   * @param referenceSet Full reference set.
+   * @param k Number of neighbors that will be searched for.
+   * @param targetRecall Desired recall, between 0.0 and 1.0.
+   * @param achievedRecall Output: recall achieved by the returned tau on the
+   *      sample.
+   * @param sampleSize Maximum number of reference points to sample for
+   *      calibration.
+   * @param querySampleSize Maximum number of query points to sample for
+   *      calibration.
+   * @param leafSize Leaf size that will be used to build the deployed tree.
+   * @param rho Balance threshold that will be used to build the deployed
+   *      tree.
+   * @return The calibrated value of tau.
+   */
+  static double TuneTau(const MatType& referenceSet,
+                        const size_t k,
+                        const double targetRecall,
+                        double& achievedRecall,
+                        const size_t sampleSize = 1000,
+                        const size_t querySampleSize = 100,
+                        const size_t leafSize = 20,
+                        const double rho = 0.7);
+
+  /**
+   * Calibrate the overlap parameter tau against a target recall, without
+   * reporting the recall that the returned tau achieved on the sample.
+   *
+   * @param referenceSet Full reference set.
+   * @param k Number of neighbors that will be searched for.
+   * @param targetRecall Desired recall, between 0.0 and 1.0.
+   * @return The calibrated value of tau.
+   */
+  static double TuneTau(const MatType& referenceSet,
+                        const size_t k,
+                        const double targetRecall);
+
+ private:
+  /**
+   * Compute the exact neighbors of the given query set within the given
+   * reference set by brute force, ordered according to SortPolicy.
+   *
+   * @param referenceSet Reference set to search in.
+   * @param querySet Query points to search for.
+   * @param k Number of neighbors to find.
+   * @param neighbors Output matrix of neighbor indices (k rows, one column
+   *      per query point).
+   * @param distances Output matrix of neighbor distances.
+   */
+  static void ExactNeighbors(const MatType& referenceSet,
+                             const MatType& querySet,
+                             const size_t k,
+                             arma::Mat<size_t>& neighbors,
+                             arma::mat& distances);
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "spill_search_tuner_impl.hpp"
+
+#endif
@@ -0,0 +1,207 @@
+/**
+ * @file methods/neighbor_search/spill_search_tuner_impl.hpp
+ *
+ * Implementation of the SpillSearchTuner class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_SEARCH_TUNER_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_SEARCH_TUNER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "spill_search_tuner.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy, typename MatType>
+double SpillSearchTuner<SortPolicy, MatType>::Recall(
+    const arma::Mat<size_t>& foundNeighbors,
+    const arma::Mat<size_t>& exactNeighbors)
+{
+  if (foundNeighbors.n_rows != exactNeighbors.n_rows ||
+      foundNeighbors.n_cols != exactNeighbors.n_cols)
+    throw std::invalid_argument("SpillSearchTuner::Recall(): matrices provided"
+        " must have equal size");
+
+  const size_t queries = foundNeighbors.n_cols;
+  const size_t neighbors = foundNeighbors.n_rows; // Should be equal to k.
+
+  // The recall is the set intersection of found and exact neighbors.
+  size_t found = 0;
+  for (size_t col = 0; col < queries; ++col)
+    for (size_t row = 0; row < neighbors; ++row)
+      for (size_t nei = 0; nei < exactNeighbors.n_rows; ++nei)
+        if (exactNeighbors(row, col) == foundNeighbors(nei, col))
+        {
+          found++;
+          break;
+        }
+
+  return ((double) found) / exactNeighbors.n_elem;
+}
+
+template<typename SortPolicy, typename MatType>
+double SpillSearchTuner<SortPolicy, MatType>::EstimateRecall(
+    const MatType& referenceSet,
+    const MatType& querySet,
+    const arma::Mat<size_t>& foundNeighbors,
+    const size_t sampleSize)
+{
+  if (foundNeighbors.n_cols != querySet.n_cols)
+    throw std::invalid_argument("SpillSearchTuner::EstimateRecall(): "
+        "foundNeighbors must have one column per query point");
+
+  // Sample the queries that will be solved exactly.
+  arma::uvec querySamples;
+  math::ObtainDistinctSamples(0, querySet.n_cols, sampleSize, querySamples);
+
+  const MatType sampledQueries = querySet.cols(querySamples);
+  const arma::Mat<size_t> sampledFound = foundNeighbors.cols(querySamples);
+
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  ExactNeighbors(referenceSet, sampledQueries, foundNeighbors.n_rows,
+      exactNeighbors, exactDistances);
+
+  return Recall(sampledFound, exactNeighbors);
+}
+
+template<typename SortPolicy, typename MatType>
+double SpillSearchTuner<SortPolicy, MatType>::TuneTau(
+    const MatType& referenceSet,
+    const size_t k,
+    const double targetRecall,
+    double& achievedRecall,
+    const size_t sampleSize,
+    const size_t querySampleSize,
+    const size_t leafSize,
+    const double rho)
+{
+  // Sample the reference subset that calibration will run against.  The
+  // sample must be large enough that k exact neighbors exist in it.
+  arma::uvec referenceSamples;
+  math::ObtainDistinctSamples(0, referenceSet.n_cols,
+      std::max(sampleSize, k + 1), referenceSamples);
+
+  if (referenceSamples.n_elem <= k)
+    throw std::invalid_argument("SpillSearchTuner::TuneTau(): reference set "
+        "must contain more than k points");
+
+  const MatType sampleSet = referenceSet.cols(referenceSamples);
+
+  // Sample query points from the full reference set, so that the calibration
+  // workload resembles the deployed (monochromatic) workload.
+  arma::uvec querySamples;
+  math::ObtainDistinctSamples(0, referenceSet.n_cols, querySampleSize,
+      querySamples);
+  const MatType querySet = referenceSet.cols(querySamples);
+
+  // Exact ground truth on the sample.
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  ExactNeighbors(sampleSet, querySet, k, exactNeighbors, exactDistances);
+
+  // The overlap tau is an absolute distance margin around the splitting
+  // hyperplane, so useful candidate values scale with the kth-neighbor
+  // distances of the data.  Sweep a ladder of multiples of the median
+  // kth-neighbor distance, starting at zero (no overlap).
+  const double scale = arma::median(
+      exactDistances.row(exactDistances.n_rows - 1).t());
+  const double multipliers[] = { 0.0, 0.125, 0.25, 0.5, 1.0, 2.0 };
+  const size_t numCandidates = sizeof(multipliers) / sizeof(multipliers[0]);
+
+  double bestTau = 0.0;
+  double bestRecall = -1.0;
+  for (size_t i = 0; i < numCandidates; ++i)
+  {
+    const double tau = multipliers[i] * scale;
+
+    // Build the spill tree on the sample and run single-tree defeatist
+    // search with the candidate overlap.
+    Tree tree(sampleSet, tau, leafSize, rho);
+    SpillSearchType search(std::move(tree), SINGLE_TREE_MODE);
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    search.Search(querySet, k, neighbors, distances);
+
+    const double recall = Recall(neighbors, exactNeighbors);
+    Log::Info << "SpillSearchTuner::TuneTau(): tau " << tau << " gives recall "
+        << recall << " on the sample." << std::endl;
+
+    if (recall > bestRecall)
+    {
+      bestRecall = recall;
+      bestTau = tau;
+    }
+
+    // Candidates are tried in increasing order, so the first one that meets
+    // the target is the smallest (cheapest) one.
+    if (recall >= targetRecall)
+      break;
+  }
+
+  if (bestRecall < targetRecall)
+  {
+    Log::Warn << "SpillSearchTuner::TuneTau(): no candidate tau reached the "
+        << "target recall " << targetRecall << "; returning tau " << bestTau
+        << " with sample recall " << bestRecall << "." << std::endl;
+  }
+
+  achievedRecall = bestRecall;
+  return bestTau;
+}
+
+template<typename SortPolicy, typename MatType>
+double SpillSearchTuner<SortPolicy, MatType>::TuneTau(
+    const MatType& referenceSet,
+    const size_t k,
+    const double targetRecall)
+{
+  double achievedRecall;
+  return TuneTau(referenceSet, k, targetRecall, achievedRecall);
+}
+
+template<typename SortPolicy, typename MatType>
+void SpillSearchTuner<SortPolicy, MatType>::ExactNeighbors(
+    const MatType& referenceSet,
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  Log::Assert(k <= referenceSet.n_cols);
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  // Whether SortPolicy prefers smaller distances (nearest neighbors) or
+  // larger ones (furthest neighbors).
+  const bool ascending = SortPolicy::IsBetter(0.0, 1.0);
+
+  metric::EuclideanDistance metric;
+  #pragma omp parallel for firstprivate(metric)
+  for (omp_size_t q = 0; q < (omp_size_t) querySet.n_cols; ++q)
+  {
+    arma::vec dists(referenceSet.n_cols);
+    for (size_t r = 0; r < referenceSet.n_cols; ++r)
+      dists[r] = metric.Evaluate(querySet.col(q), referenceSet.col(r));
+
+    const arma::uvec order =
+        arma::sort_index(dists, ascending ? "ascend" : "descend");
+    for (size_t j = 0; j < k; ++j)
+    {
+      neighbors(j, q) = order[j];
+      distances(j, q) = dists[order[j]];
+    }
+  }
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
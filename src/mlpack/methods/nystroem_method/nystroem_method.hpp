@@ -16,6 +16,7 @@
 #define MLPACK_METHODS_NYSTROEM_METHOD_NYSTROEM_METHOD_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
 #include "kmeans_selection.hpp"
 
 namespace mlpack {
@@ -46,6 +47,19 @@ class NystroemMethod
    */
   void Apply(arma::mat& output);
 
+  /**
+   * Apply the ensemble Nystroem method: build the given number of independent
+   * approximations, each from its own set of selected landmarks, and average
+   * them.  The average is returned in factored form, so the output matrix G
+   * has (ensembles * rank) columns and K' = G * G^T.  This is only useful
+   * with a randomized PointSelectionPolicy; with a deterministic policy every
+   * member of the ensemble is identical.
+   *
+   * @param output Matrix to store kernel approximation into.
+   * @param ensembles Number of independent landmark sets to average over.
+   */
+  void Apply(arma::mat& output, const size_t ensembles);
+
   /**
    * Construct the kernel matrix with matrix that contains the selected points.
    *
@@ -35,18 +35,14 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& miniKernel,
     arma::mat& semiKernel)
 {
-  // Assemble mini-kernel matrix.
-  for (size_t i = 0; i < rank; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      miniKernel(i, j) = kernel.Evaluate(selectedData->col(i),
-                                         selectedData->col(j));
+  // Assemble mini-kernel matrix.  KernelMatrix() uses the kernel's batched
+  // Evaluate() overload when there is one, so both matrices are built with
+  // level-3 operations instead of per-pair evaluations.
+  KernelMatrix(kernel, *selectedData, *selectedData, miniKernel);
 
   // Construct semi-kernel matrix with interactions between selected data and
   // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      semiKernel(i, j) = kernel.Evaluate(data.col(i),
-                                         selectedData->col(j));
+  KernelMatrix(kernel, data, *selectedData, semiKernel);
   // Clean the memory.
   delete selectedData;
 }
@@ -57,22 +53,16 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& miniKernel,
     arma::mat& semiKernel)
 {
-  // Assemble mini-kernel matrix.
-  for (size_t i = 0; i < rank; ++i)
-  {
-    for (size_t j = 0; j < rank; ++j)
-    {
-      miniKernel(i, j) = kernel.Evaluate(data.col(selectedPoints(i)),
-                                         data.col(selectedPoints(j)));
-    }
-  }
+  // Gather the selected points once, then assemble both matrices in batched
+  // form (a matrix product per matrix for kernels with a batched Evaluate()).
+  const arma::mat selectedData =
+      data.cols(arma::conv_to<arma::uvec>::from(selectedPoints));
+
+  KernelMatrix(kernel, selectedData, selectedData, miniKernel);
 
   // Construct semi-kernel matrix with interactions between selected points and
   // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      semiKernel(i, j) = kernel.Evaluate(data.col(i),
-                                         data.col(selectedPoints(j)));
+  KernelMatrix(kernel, data, selectedData, semiKernel);
 }
 
 template<typename KernelType, typename PointSelectionPolicy>
@@ -84,19 +74,47 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::Apply(arma::mat& output)
   GetKernelMatrix(PointSelectionPolicy::Select(data, rank), miniKernel,
                   semiKernel);
 
-  // Singular value decomposition mini-kernel matrix.
-  arma::mat U, V;
+  // The mini-kernel matrix is symmetric positive semidefinite, so instead of
+  // a full nonsymmetric SVD we can use the symmetric eigendecomposition,
+  // which is cheaper and whose size is already matched to the target rank
+  // (the block is rank x rank).
+  arma::mat U;
   arma::vec s;
-  arma::svd(U, s, V, miniKernel);
+  arma::eig_sym(s, U, miniKernel, "dc");
 
   // Construct the output matrix.  We need to have special handling when
-  // miniKernel ended up being low-rank.
-  arma::mat normalization = arma::diagmat(1.0 / sqrt(s));
+  // miniKernel ended up being low-rank: eigenvalues that are numerically zero
+  // (or slightly negative, from roundoff) are dropped.
+  arma::mat normalization = arma::zeros<arma::mat>(s.n_elem, s.n_elem);
   for (size_t i = 0; i < s.n_elem; ++i)
-    if (std::abs(s[i]) <= 1e-20)
-      normalization(i, i) = 0.0;
+    if (s[i] > 1e-20)
+      normalization(i, i) = 1.0 / std::sqrt(s[i]);
+
+  output = semiKernel * U * normalization;
+}
+
+template<typename KernelType, typename PointSelectionPolicy>
+void NystroemMethod<KernelType, PointSelectionPolicy>::Apply(
+    arma::mat& output, const size_t ensembles)
+{
+  if (ensembles <= 1)
+  {
+    Apply(output);
+    return;
+  }
 
-  output = semiKernel * U * normalization * V;
+  // Build independent approximations, each from its own landmark set, and
+  // average them.  The average is kept in factored form: since
+  // (1 / p) * sum_i G_i G_i^T = G G^T with G = [G_1 ... G_p] / sqrt(p),
+  // concatenating the scaled member factors is enough.
+  output.set_size(data.n_cols, ensembles * rank);
+  const double scale = 1.0 / std::sqrt((double) ensembles);
+  for (size_t e = 0; e < ensembles; ++e)
+  {
+    arma::mat member;
+    Apply(member);
+    output.cols(e * rank, (e + 1) * rank - 1) = scale * member;
+  }
 }
 
 } // namespace kernel
@@ -0,0 +1,181 @@
+/**
+ * @file methods/pca/decomposition_policies/streaming_svd_method.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the streaming block power method for use in the
+ * Principal Components Analysis method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_STREAMING_SVD_METHOD_HPP
+#define MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_STREAMING_SVD_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace pca {
+
+/**
+ * Implementation of the streaming block power policy.  The principal
+ * components are estimated by subspace (block power) iteration on the
+ * covariance, consuming the centered data one column block at a time: each
+ * pass accumulates C * B block by block, where B is the current basis
+ * estimate, and never forms the covariance matrix or a full SVD workspace.
+ *
+ * Besides the data itself, the working set is one d x l basis and one column
+ * block, so the policy is suitable for matrices that are memory-mapped or
+ * otherwise too large for the dense decomposition policies; the data is only
+ * ever read sequentially, one block at a time.
+ */
+class StreamingSVDPolicy
+{
+ public:
+  /**
+   * Use the streaming block power method to perform the principal components
+   * analysis (PCA).
+   *
+   * @param blockSize Number of columns consumed at a time (Default: 1024).
+   * @param maxPasses Upper limit on the number of passes over the data
+   *        (Default: 10).
+   * @param tolerance Stop once the largest principal angle between successive
+   *        basis estimates drops below this value (Default: 1e-8).
+   */
+  StreamingSVDPolicy(const size_t blockSize = 1024,
+                     const size_t maxPasses = 10,
+                     const double tolerance = 1e-8) :
+      blockSize(blockSize),
+      maxPasses(maxPasses),
+      tolerance(tolerance)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Principal Component Analysis to the provided data set using the
+   * streaming block power method.
+   *
+   * @param * (data) Data matrix.
+   * @param centeredData Centered data matrix.
+   * @param transformedData Matrix to put results of PCA into.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   * @param rank Rank of the decomposition.
+   */
+  void Apply(const arma::mat& /* data */,
+             const arma::mat& centeredData,
+             arma::mat& transformedData,
+             arma::vec& eigVal,
+             arma::mat& eigvec,
+             const size_t rank)
+  {
+    const size_t d = centeredData.n_rows;
+    const size_t n = centeredData.n_cols;
+
+    // Oversample the requested rank, as the other approximate policies do;
+    // when l reaches the dimensionality, one Rayleigh-Ritz step is exact.
+    const size_t l = std::min(rank + 2, std::min(d, n));
+
+    arma::mat B = arma::randn<arma::mat>(d, l);
+    arma::mat R;
+    arma::qr_econ(B, R, B);
+
+    arma::mat S(d, l);
+    for (size_t pass = 0; pass < maxPasses; ++pass)
+    {
+      // Accumulate S = C * B one column block at a time; the covariance C is
+      // never formed.
+      ApplyCovariance(centeredData, B, S);
+
+      arma::mat BNew;
+      arma::qr_econ(BNew, R, S);
+
+      // The singular values of B^T BNew are the cosines of the principal
+      // angles between successive basis estimates; stop once the basis has
+      // stopped rotating.
+      const arma::vec overlap = arma::svd(B.t() * BNew);
+      B = std::move(BNew);
+      if ((1.0 - overlap.min()) < tolerance)
+        break;
+    }
+
+    // Rayleigh-Ritz step: eigendecompose the covariance restricted to the
+    // converged basis to obtain the principal components and eigenvalues.
+    ApplyCovariance(centeredData, B, S);
+    arma::mat T = B.t() * S;
+    T = 0.5 * (T + T.t());
+
+    arma::vec ritzVal;
+    arma::mat ritzVec;
+    arma::eig_sym(ritzVal, ritzVec, T);
+
+    // eig_sym() returns ascending eigenvalues; PCA wants them descending.
+    eigVal = arma::reverse(ritzVal);
+    eigvec = B * arma::fliplr(ritzVec);
+
+    // Project the samples to the principals, block by block.
+    transformedData.set_size(l, n);
+    for (size_t begin = 0; begin < n; begin += blockSize)
+    {
+      const size_t end = std::min(n, begin + blockSize) - 1;
+      transformedData.cols(begin, end) =
+          arma::trans(eigvec) * centeredData.cols(begin, end);
+    }
+  }
+
+  //! Get the number of columns consumed at a time.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of columns consumed at a time.
+  size_t& BlockSize() { return blockSize; }
+
+  //! Get the upper limit on the number of passes over the data.
+  size_t MaxPasses() const { return maxPasses; }
+  //! Modify the upper limit on the number of passes over the data.
+  size_t& MaxPasses() { return maxPasses; }
+
+  //! Get the early-stopping tolerance on the basis rotation.
+  double Tolerance() const { return tolerance; }
+  //! Modify the early-stopping tolerance on the basis rotation.
+  double& Tolerance() { return tolerance; }
+
+ private:
+  /**
+   * Compute S = C * B block by block, where C is the covariance of the
+   * centered data.
+   *
+   * @param centeredData Centered data matrix.
+   * @param B Current basis estimate.
+   * @param S Matrix to store the result into.
+   */
+  void ApplyCovariance(const arma::mat& centeredData,
+                       const arma::mat& B,
+                       arma::mat& S) const
+  {
+    S.zeros();
+    for (size_t begin = 0; begin < centeredData.n_cols; begin += blockSize)
+    {
+      const size_t end = std::min((size_t) centeredData.n_cols,
+          begin + blockSize) - 1;
+      S += centeredData.cols(begin, end) *
+          (centeredData.cols(begin, end).t() * B);
+    }
+    S /= (centeredData.n_cols - 1);
+  }
+
+  //! Locally stored number of columns consumed at a time.
+  size_t blockSize;
+
+  //! Locally stored upper limit on the number of passes over the data.
+  size_t maxPasses;
+
+  //! Locally stored early-stopping tolerance on the basis rotation.
+  double tolerance;
+};
+
+} // namespace pca
+} // namespace mlpack
+
+#endif
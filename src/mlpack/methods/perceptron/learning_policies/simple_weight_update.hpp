@@ -60,6 +60,45 @@ class SimpleWeightUpdate
     weights.col(correctClass) += instanceWeight * trainingPoint;
     biases(correctClass) += instanceWeight;
   }
+
+  /**
+   * Update the weights for a whole batch of misclassified points at once.
+   * Each point applies the same rule as the single-point overload above, but
+   * the updates are grouped: the per-point coefficients (+1 towards the
+   * correct class, -1 away from the predicted class, scaled by the instance
+   * weight) are collected into one coefficient matrix and applied with a
+   * single matrix product instead of a rank-1 update per point.
+   *
+   * @param trainingPoints Matrix of misclassified points, one per column.
+   * @param weights Matrix of weights.
+   * @param biases Vector of biases.
+   * @param incorrectClasses Index of the predicted (wrong) class of each
+   *      point.
+   * @param correctClasses Index of the true class of each point.
+   * @param instanceWeights Weight of each point during training (useful for
+   *      boosting); if empty, all points have weight 1.
+   */
+  template<typename MatType>
+  void UpdateWeights(const MatType& trainingPoints,
+                     arma::mat& weights,
+                     arma::vec& biases,
+                     const arma::Row<size_t>& incorrectClasses,
+                     const arma::Row<size_t>& correctClasses,
+                     const arma::rowvec& instanceWeights = arma::rowvec())
+  {
+    arma::mat coefficients(trainingPoints.n_cols, weights.n_cols,
+        arma::fill::zeros);
+    for (size_t j = 0; j < trainingPoints.n_cols; ++j)
+    {
+      const double instanceWeight =
+          (instanceWeights.n_elem > 0) ? instanceWeights[j] : 1.0;
+      coefficients(j, incorrectClasses[j]) -= instanceWeight;
+      coefficients(j, correctClasses[j]) += instanceWeight;
+    }
+
+    weights += trainingPoints * coefficients;
+    biases += arma::sum(coefficients, 0).t();
+  }
 };
 
 } // namespace perceptron
@@ -106,14 +106,14 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Classify(
     const MatType& test,
     arma::Row<size_t>& predictedLabels)
 {
-  arma::vec tempLabelMat;
-  arma::uword maxIndex = 0;
+  // Score all points with one matrix product.
+  arma::mat scores = weights.t() * test;
+  scores.each_col() += biases;
 
-  // Could probably be faster if done in batch.
+  arma::uword maxIndex = 0;
   for (size_t i = 0; i < test.n_cols; ++i)
   {
-    tempLabelMat = weights.t() * test.col(i) + biases;
-    tempLabelMat.max(maxIndex);
+    scores.unsafe_col(i).max(maxIndex);
     predictedLabels(0, i) = maxIndex;
   }
 }
@@ -145,16 +145,30 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
     wip.Initialize(weights, biases, data.n_rows, numClasses);
   }
 
-  size_t j, i = 0;
+  size_t i = 0;
   bool converged = false;
-  size_t tempLabel;
-  arma::uword maxIndexRow = 0, maxIndexCol = 0;
-  arma::mat tempLabelMat;
 
   LearnPolicy LP;
 
   const bool hasWeights = (instanceWeights.n_elem > 0);
 
+  // Process the dataset in blocks: each block is scored against the current
+  // weights with a single matrix product, the misclassified points are
+  // gathered, and their updates are applied together through the learning
+  // policy.  This replaces a matrix-vector product and a rank-1 update per
+  // point with one GEMM and one grouped update per block.  The block size
+  // trades GEMM efficiency against update staleness---within a block every
+  // point is scored with the weights from the start of the block---and does
+  // not change the fixed point: convergence is still a full pass with no
+  // mistakes.
+  const size_t blockSize = 256;
+
+  // These are reused across blocks to avoid per-block allocations.
+  arma::mat scores;
+  arma::uvec mistakes(blockSize);
+  arma::Row<size_t> incorrectClasses(blockSize), correctClasses(blockSize);
+  arma::rowvec mistakeWeights(blockSize);
+
   while ((i < maxIterations) && (!converged))
   {
     // This outer loop is for each iteration, and we use the 'converged'
@@ -163,31 +177,46 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
     converged = true;
 
     // Now this inner loop is for going through the dataset in each iteration.
-    for (j = 0; j < data.n_cols; ++j)
+    for (size_t start = 0; start < data.n_cols; start += blockSize)
     {
-      // Multiply for each variable and check whether the current weight vector
-      // correctly classifies this.
-      tempLabelMat = weights.t() * data.col(j) + biases;
+      const size_t end = std::min(start + blockSize, (size_t) data.n_cols) - 1;
 
-      tempLabelMat.max(maxIndexRow, maxIndexCol);
+      // Score the whole block at once.
+      scores = weights.t() * data.cols(start, end);
+      scores.each_col() += biases;
 
-      // Check whether prediction is correct.
-      if (maxIndexRow != labels(0, j))
+      // Gather the misclassified points of this block.
+      size_t numMistakes = 0;
+      arma::uword maxIndex = 0;
+      for (size_t j = start; j <= end; ++j)
       {
-        // Due to incorrect prediction, convergence set to false.
-        converged = false;
-        tempLabel = labels(0, j);
-
-        // Send maxIndexRow for knowing which weight to update, send j to know
-        // the value of the vector to update it with.  Send tempLabel to know
-        // the correct class.
-        if (hasWeights)
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow, tempLabel,
-              instanceWeights(j));
-        else
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow,
-              tempLabel);
+        scores.unsafe_col(j - start).max(maxIndex);
+        if (maxIndex != labels(0, j))
+        {
+          mistakes[numMistakes] = j;
+          incorrectClasses[numMistakes] = maxIndex;
+          correctClasses[numMistakes] = labels(0, j);
+          if (hasWeights)
+            mistakeWeights[numMistakes] = instanceWeights(j);
+          ++numMistakes;
+        }
       }
+
+      if (numMistakes == 0)
+        continue;
+
+      // Due to incorrect predictions, convergence set to false.
+      converged = false;
+
+      // Apply the updates of all the mistakes in this block together.
+      LP.UpdateWeights(
+          MatType(data.cols(mistakes.head(numMistakes))),
+          weights,
+          biases,
+          incorrectClasses.head(numMistakes),
+          correctClasses.head(numMistakes),
+          hasWeights ? arma::rowvec(mistakeWeights.head(numMistakes)) :
+              arma::rowvec());
     }
   }
 }
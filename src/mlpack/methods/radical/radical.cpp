@@ -70,22 +70,31 @@ double Radical::DoRadical2D(const mat& matX)
 {
   CopyAndPerturb(perturbed, matX);
 
-  mat::fixed<2, 2> matJacobi;
+  return SearchAngles(perturbed);
+}
+
 
+double Radical::SearchAngles(const mat& perturbedSubspace) const
+{
   vec values(angles);
 
-  for (size_t i = 0; i < angles; ++i)
+  // Every candidate angle is scored independently of the others, so the
+  // brute-force search is threaded; each thread rotates the subspace into its
+  // own workspace.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) angles; ++i)
   {
     const double theta = (i / (double) angles) * M_PI / 2.0;
     const double cosTheta = cos(theta);
     const double sinTheta = sin(theta);
 
+    mat::fixed<2, 2> matJacobi;
     matJacobi(0, 0) = cosTheta;
     matJacobi(1, 0) = -sinTheta;
     matJacobi(0, 1) = sinTheta;
     matJacobi(1, 1) = cosTheta;
 
-    candidate = perturbed * matJacobi;
+    mat candidate = perturbedSubspace * matJacobi;
     vec candidateY1 = candidate.unsafe_col(0);
     vec candidateY2 = candidate.unsafe_col(1);
 
@@ -132,7 +141,7 @@ void Radical::DoRadical(const mat& matXT, mat& matY, mat& matW)
   Timer::Start("radical_do_radical");
   matW = matWhitening;
 
-  mat matYSubspace(nPoints, 2);
+  mat perturbedSubspace(nPoints * replicates, 2);
 
   mat matJ = eye(nDims, nDims);
 
@@ -140,6 +149,12 @@ void Radical::DoRadical(const mat& matXT, mat& matY, mat& matW)
   {
     Log::Info << "RADICAL: sweep " << sweepNum << "." << std::endl;
 
+    // Replicate and perturb the whitened data once per sweep.  The rotations
+    // applied below are orthogonal, so rotating the perturbed copy alongside
+    // matY leaves the distribution of its Gaussian noise unchanged; there is
+    // no need to re-replicate for every dimension pair.
+    CopyAndPerturb(perturbed, matY);
+
     for (size_t i = 0; i < nDims - 1; ++i)
     {
       for (size_t j = i + 1; j < nDims; ++j)
@@ -147,10 +162,10 @@ void Radical::DoRadical(const mat& matXT, mat& matY, mat& matW)
         Log::Debug << "RADICAL 2D on dimensions " << i << " and " << j << "."
             << std::endl;
 
-        matYSubspace.col(0) = matY.col(i);
-        matYSubspace.col(1) = matY.col(j);
+        perturbedSubspace.col(0) = perturbed.col(i);
+        perturbedSubspace.col(1) = perturbed.col(j);
 
-        const double thetaOpt = DoRadical2D(matYSubspace);
+        const double thetaOpt = SearchAngles(perturbedSubspace);
 
         const double cosThetaOpt = cos(thetaOpt);
         const double sinThetaOpt = sin(thetaOpt);
@@ -168,6 +183,14 @@ void Radical::DoRadical(const mat& matXT, mat& matY, mat& matW)
         matJ(j, i) = 0;
         matJ(i, j) = 0;
         matJ(j, j) = 1;
+
+        // Apply the same rotation to the perturbed copy; only columns i and j
+        // are affected.
+        const vec oldColI = perturbed.col(i);
+        perturbed.col(i) = cosThetaOpt * oldColI -
+            sinThetaOpt * perturbed.col(j);
+        perturbed.col(j) = sinThetaOpt * oldColI +
+            cosThetaOpt * perturbed.col(j);
       }
     }
   }
@@ -131,8 +131,17 @@ class Radical
 
   //! Internal matrix, held as member variable to prevent memory reallocations.
   arma::mat perturbed;
-  //! Internal matrix, held as member variable to prevent memory reallocations.
-  arma::mat candidate;
+
+  /**
+   * Brute-force search over candidate rotation angles of an already-perturbed
+   * two-column matrix, returning the angle minimizing the summed marginal
+   * entropy estimate.  The angle evaluations are independent and are scored
+   * in parallel.
+   *
+   * @param perturbedSubspace Perturbed replicates of a two-dimensional
+   *    coordinate projection of the data.
+   */
+  double SearchAngles(const arma::mat& perturbedSubspace) const;
 };
 
 void WhitenFeatureMajorMatrix(const arma::mat& matX,
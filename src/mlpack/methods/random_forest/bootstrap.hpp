@@ -17,7 +17,11 @@ namespace mlpack {
 namespace tree {
 
 /**
- * Given a dataset, create another dataset via bootstrap sampling, with labels.
+ * Given a dataset and a set of already-sampled point indices, create another
+ * dataset containing those points, with labels.  This overload exists so that
+ * the sampling itself can be done separately from the gathering; RandomForest
+ * draws the indices for all of its trees up front, which keeps seeded training
+ * runs reproducible regardless of how many threads build the trees.
  */
 template<bool UseWeights,
          typename MatType,
@@ -26,22 +30,36 @@ template<bool UseWeights,
 void Bootstrap(const MatType& dataset,
                const LabelsType& labels,
                const WeightsType& weights,
+               const arma::uvec& indices,
                MatType& bootstrapDataset,
                LabelsType& bootstrapLabels,
                WeightsType& bootstrapWeights)
 {
-  bootstrapDataset.set_size(dataset.n_rows, dataset.n_cols);
-  bootstrapLabels.set_size(labels.n_elem);
+  bootstrapDataset = dataset.cols(indices);
+  bootstrapLabels = labels.cols(indices);
   if (UseWeights)
-    bootstrapWeights.set_size(weights.n_elem);
+    bootstrapWeights = weights.cols(indices);
+}
 
+/**
+ * Given a dataset, create another dataset via bootstrap sampling, with labels.
+ */
+template<bool UseWeights,
+         typename MatType,
+         typename LabelsType,
+         typename WeightsType>
+void Bootstrap(const MatType& dataset,
+               const LabelsType& labels,
+               const WeightsType& weights,
+               MatType& bootstrapDataset,
+               LabelsType& bootstrapLabels,
+               WeightsType& bootstrapWeights)
+{
   // Random sampling with replacement.
   arma::uvec indices = arma::randi<arma::uvec>(dataset.n_cols,
       arma::distr_param(0, dataset.n_cols - 1));
-  bootstrapDataset = dataset.cols(indices);
-  bootstrapLabels = labels.cols(indices);
-  if (UseWeights)
-    bootstrapWeights = weights.cols(indices);
+  Bootstrap<UseWeights>(dataset, labels, weights, indices, bootstrapDataset,
+      bootstrapLabels, bootstrapWeights);
 }
 
 } // namespace tree
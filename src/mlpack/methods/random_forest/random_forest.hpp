@@ -12,6 +12,8 @@
 #ifndef MLPACK_METHODS_RANDOM_FOREST_RANDOM_FOREST_HPP
 #define MLPACK_METHODS_RANDOM_FOREST_RANDOM_FOREST_HPP
 
+#include <mlpack/core/math/random.hpp>
+#include <mlpack/core/data/compressed_blob.hpp>
 #include <mlpack/methods/decision_tree/decision_tree.hpp>
 #include <mlpack/methods/decision_tree/multiple_random_dimension_select.hpp>
 #include "bootstrap.hpp"
@@ -35,6 +37,10 @@ namespace tree {
  *   publisher={Springer}
  * }
  * @endcode
+ *
+ * All of the const Classify() overloads are reentrant: they modify no state of
+ * the forest and use no hidden scratch storage, so a single trained forest may
+ * safely serve concurrent Classify() calls from multiple threads.
  */
 template<typename FitnessFunction = GiniGain,
          typename DimensionSelectionType = MultipleRandomDimensionSelect,
@@ -51,7 +57,7 @@ class RandomForest
    * Construct the random forest without any training or specifying the number
    * of trees.  Predict() will throw an exception until Train() is called.
    */
-  RandomForest() { }
+  RandomForest() : oobError(0.0) { }
 
   /**
    * Create a random forest, training on the given labeled training data with
@@ -69,9 +75,9 @@ class RandomForest
    * @param maximumDepth Maximum depth for the tree.
    * @param dimensionSelector Instantiated dimension selection policy.
    */
-  template<typename MatType>
+  template<typename MatType, typename LabelsType>
   RandomForest(const MatType& dataset,
-               const arma::Row<size_t>& labels,
+               const LabelsType& labels,
                const size_t numClasses,
                const size_t numTrees = 20,
                const size_t minimumLeafSize = 1,
@@ -98,10 +104,10 @@ class RandomForest
    * @param maximumDepth Maximum depth for the tree.
    * @param dimensionSelector Instantiated dimension selection policy.
    */
-  template<typename MatType>
+  template<typename MatType, typename LabelsType>
   RandomForest(const MatType& dataset,
                const data::DatasetInfo& datasetInfo,
-               const arma::Row<size_t>& labels,
+               const LabelsType& labels,
                const size_t numClasses,
                const size_t numTrees = 20,
                const size_t minimumLeafSize = 1,
@@ -125,9 +131,9 @@ class RandomForest
    * @param maximumDepth Maximum depth for the tree.
    * @param dimensionSelector Instantiated dimension selection policy.
    */
-  template<typename MatType>
+  template<typename MatType, typename LabelsType>
   RandomForest(const MatType& dataset,
-               const arma::Row<size_t>& labels,
+               const LabelsType& labels,
                const size_t numClasses,
                const arma::rowvec& weights,
                const size_t numTrees = 20,
@@ -156,10 +162,10 @@ class RandomForest
    * @param maximumDepth Maximum depth for the tree.
    * @param dimensionSelector Instantiated dimension selection policy.
    */
-  template<typename MatType>
+  template<typename MatType, typename LabelsType>
   RandomForest(const MatType& dataset,
                const data::DatasetInfo& datasetInfo,
-               const arma::Row<size_t>& labels,
+               const LabelsType& labels,
                const size_t numClasses,
                const arma::rowvec& weights,
                const size_t numTrees = 20,
@@ -184,18 +190,22 @@ class RandomForest
    * @param minimumGainSplit Minimum gain for splitting a decision tree node.
    * @param maximumDepth Maximum depth for the tree.
    * @param dimensionSelector Instantiated dimension selection policy.
+   * @param computeImportances If true, permutation importances for each
+   *      dimension will be computed on the out-of-bag points of each tree and
+   *      can be read with FeatureImportances().
    * @return The average entropy of all the decision trees trained under forest.
    */
-  template<typename MatType>
+  template<typename MatType, typename LabelsType>
   double Train(const MatType& data,
-               const arma::Row<size_t>& labels,
+               const LabelsType& labels,
                const size_t numClasses,
                const size_t numTrees = 20,
                const size_t minimumLeafSize = 1,
                const double minimumGainSplit = 1e-7,
                const size_t maximumDepth = 0,
                DimensionSelectionType dimensionSelector =
-                   DimensionSelectionType());
+                   DimensionSelectionType(),
+               const bool computeImportances = false);
 
   /**
    * Train the random forest on the given labeled training data with the given
@@ -215,19 +225,23 @@ class RandomForest
    * @param minimumGainSplit Minimum gain for splitting a decision tree node.
    * @param maximumDepth Maximum depth for the tree.
    * @param dimensionSelector Instantiated dimension selection policy.
+   * @param computeImportances If true, permutation importances for each
+   *      dimension will be computed on the out-of-bag points of each tree and
+   *      can be read with FeatureImportances().
    * @return The average entropy of all the decision trees trained under forest.
    */
-  template<typename MatType>
+  template<typename MatType, typename LabelsType>
   double Train(const MatType& data,
                const data::DatasetInfo& datasetInfo,
-               const arma::Row<size_t>& labels,
+               const LabelsType& labels,
                const size_t numClasses,
                const size_t numTrees = 20,
                const size_t minimumLeafSize = 1,
                const double minimumGainSplit = 1e-7,
                const size_t maximumDepth = 0,
                DimensionSelectionType dimensionSelector =
-                   DimensionSelectionType());
+                   DimensionSelectionType(),
+               const bool computeImportances = false);
 
   /**
    * Train the random forest on the given weighted labeled training data with
@@ -245,11 +259,14 @@ class RandomForest
    * @param minimumGainSplit Minimum gain for splitting a decision tree node.
    * @param maximumDepth Maximum depth for the tree.
    * @param dimensionSelector Instantiated dimension selection policy.
+   * @param computeImportances If true, permutation importances for each
+   *      dimension will be computed on the out-of-bag points of each tree and
+   *      can be read with FeatureImportances().
    * @return The average entropy of all the decision trees trained under forest.
    */
-  template<typename MatType>
+  template<typename MatType, typename LabelsType>
   double Train(const MatType& data,
-               const arma::Row<size_t>& labels,
+               const LabelsType& labels,
                const size_t numClasses,
                const arma::rowvec& weights,
                const size_t numTrees = 20,
@@ -257,7 +274,8 @@ class RandomForest
                const double minimumGainSplit = 1e-7,
                const size_t maximumDepth = 0,
                DimensionSelectionType dimensionSelector =
-                   DimensionSelectionType());
+                   DimensionSelectionType(),
+               const bool computeImportances = false);
 
   /**
    * Train the random forest on the given weighted labeled training data with
@@ -277,12 +295,15 @@ class RandomForest
    * @param minimumGainSplit Minimum gain for splitting a decision tree node.
    * @param maximumDepth Maximum depth for the tree.
    * @param dimensionSelector Instantiated dimension selection policy.
+   * @param computeImportances If true, permutation importances for each
+   *      dimension will be computed on the out-of-bag points of each tree and
+   *      can be read with FeatureImportances().
    * @return The average entropy of all the decision trees trained under forest.
    */
-  template<typename MatType>
+  template<typename MatType, typename LabelsType>
   double Train(const MatType& data,
                const data::DatasetInfo& datasetInfo,
-               const arma::Row<size_t>& labels,
+               const LabelsType& labels,
                const size_t numClasses,
                const arma::rowvec& weights,
                const size_t numTrees = 20,
@@ -290,7 +311,8 @@ class RandomForest
                const double minimumGainSplit = 1e-7,
                const size_t maximumDepth = 0,
                DimensionSelectionType dimensionSelector =
-                   DimensionSelectionType());
+                   DimensionSelectionType(),
+               const bool computeImportances = false);
 
   /**
    * Predict the class of the given point.  If the random forest has not been
@@ -348,6 +370,25 @@ class RandomForest
   //! Get the number of trees in the forest.
   size_t NumTrees() const { return trees.size(); }
 
+  /**
+   * Get the out-of-bag classification error from the last call to Train().
+   * Each point is classified by majority vote of only those trees that did not
+   * see it during bootstrap sampling, so this is an unbiased estimate of the
+   * generalization error that costs no separate evaluation pass.  This is 0 if
+   * the forest has not been trained.
+   */
+  double OOBError() const { return oobError; }
+
+  /**
+   * Get the permutation importance of each dimension, computed on the
+   * out-of-bag points during the last call to Train().  The importance of a
+   * dimension is the average decrease in a tree's out-of-bag accuracy when
+   * that dimension's values are shuffled among the tree's out-of-bag points.
+   * This is empty unless Train() was called with computeImportances set to
+   * true.
+   */
+  const arma::vec& FeatureImportances() const { return featureImportances; }
+
   /**
    * Serialize the random forest.
    */
@@ -370,25 +411,36 @@ class RandomForest
    * @param minimumGainSplit Minimum gain for splitting a decision tree node.
    * @param maximumDepth Maximum depth for the tree.
    * @param dimensionSelector Instantiated dimension selection policy.
+   * @param computeImportances Whether to compute permutation importances on
+   *      the out-of-bag points of each tree.
    * @tparam UseWeights Whether or not to use the weights parameter.
    * @tparam UseDatasetInfo Whether or not to use the datasetInfo parameter.
    * @tparam MatType The type of data matrix (i.e. arma::mat).
    * @return The average entropy of all the decision trees trained under forest.
    */
-  template<bool UseWeights, bool UseDatasetInfo, typename MatType>
+  template<bool UseWeights,
+           bool UseDatasetInfo,
+           typename MatType,
+           typename LabelsType>
   double Train(const MatType& data,
                const data::DatasetInfo& datasetInfo,
-               const arma::Row<size_t>& labels,
+               const LabelsType& labels,
                const size_t numClasses,
                const arma::rowvec& weights,
                const size_t numTrees,
                const size_t minimumLeafSize,
                const double minimumGainSplit,
                const size_t maximumDepth,
-               DimensionSelectionType& dimensionSelector);
+               DimensionSelectionType& dimensionSelector,
+               const bool computeImportances = false);
 
   //! The trees in the forest.
   std::vector<DecisionTreeType> trees;
+
+  //! The out-of-bag error from the last call to Train().
+  double oobError;
+  //! Permutation importances of each dimension (empty unless computed).
+  arma::vec featureImportances;
 };
 
 } // namespace tree
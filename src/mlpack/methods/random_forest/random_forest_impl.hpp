@@ -24,14 +24,14 @@ template<
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType
 >
-template<typename MatType>
+template<typename MatType, typename LabelsType>
 RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType
 >::RandomForest(const MatType& dataset,
-                const arma::Row<size_t>& labels,
+                const LabelsType& labels,
                 const size_t numClasses,
                 const size_t numTrees,
                 const size_t minimumLeafSize,
@@ -52,7 +52,7 @@ template<
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType
 >
-template<typename MatType>
+template<typename MatType, typename LabelsType>
 RandomForest<
     FitnessFunction,
     DimensionSelectionType,
@@ -60,7 +60,7 @@ RandomForest<
     CategoricalSplitType
 >::RandomForest(const MatType& dataset,
                 const data::DatasetInfo& datasetInfo,
-                const arma::Row<size_t>& labels,
+                const LabelsType& labels,
                 const size_t numClasses,
                 const size_t numTrees,
                 const size_t minimumLeafSize,
@@ -81,14 +81,14 @@ template<
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType
 >
-template<typename MatType>
+template<typename MatType, typename LabelsType>
 RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType
 >::RandomForest(const MatType& dataset,
-                const arma::Row<size_t>& labels,
+                const LabelsType& labels,
                 const size_t numClasses,
                 const arma::rowvec& weights,
                 const size_t numTrees,
@@ -109,7 +109,7 @@ template<
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType
 >
-template<typename MatType>
+template<typename MatType, typename LabelsType>
 RandomForest<
     FitnessFunction,
     DimensionSelectionType,
@@ -117,7 +117,7 @@ RandomForest<
     CategoricalSplitType
 >::RandomForest(const MatType& dataset,
                 const data::DatasetInfo& datasetInfo,
-                const arma::Row<size_t>& labels,
+                const LabelsType& labels,
                 const size_t numClasses,
                 const arma::rowvec& weights,
                 const size_t numTrees,
@@ -137,27 +137,28 @@ template<
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType
 >
-template<typename MatType>
+template<typename MatType, typename LabelsType>
 double RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType
 >::Train(const MatType& dataset,
-         const arma::Row<size_t>& labels,
+         const LabelsType& labels,
          const size_t numClasses,
          const size_t numTrees,
          const size_t minimumLeafSize,
          const double minimumGainSplit,
          const size_t maximumDepth,
-         DimensionSelectionType dimensionSelector)
+         DimensionSelectionType dimensionSelector,
+         const bool computeImportances)
 {
   // Pass off to Train().
   data::DatasetInfo info; // Ignored by Train().
   arma::rowvec weights; // Ignored by Train().
   return Train<false, false>(dataset, info, labels, numClasses, weights,
       numTrees, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector);
+      dimensionSelector, computeImportances);
 }
 
 template<
@@ -166,7 +167,7 @@ template<
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType
 >
-template<typename MatType>
+template<typename MatType, typename LabelsType>
 double RandomForest<
     FitnessFunction,
     DimensionSelectionType,
@@ -174,19 +175,20 @@ double RandomForest<
     CategoricalSplitType
 >::Train(const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
-         const arma::Row<size_t>& labels,
+         const LabelsType& labels,
          const size_t numClasses,
          const size_t numTrees,
          const size_t minimumLeafSize,
          const double minimumGainSplit,
          const size_t maximumDepth,
-         DimensionSelectionType dimensionSelector)
+         DimensionSelectionType dimensionSelector,
+         const bool computeImportances)
 {
   // Pass off to Train().
   arma::rowvec weights; // Ignored by Train().
   return Train<false, true>(dataset, datasetInfo, labels, numClasses, weights,
       numTrees, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector);
+      dimensionSelector, computeImportances);
 }
 
 template<
@@ -195,27 +197,28 @@ template<
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType
 >
-template<typename MatType>
+template<typename MatType, typename LabelsType>
 double RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
     CategoricalSplitType
 >::Train(const MatType& dataset,
-         const arma::Row<size_t>& labels,
+         const LabelsType& labels,
          const size_t numClasses,
          const arma::rowvec& weights,
          const size_t numTrees,
          const size_t minimumLeafSize,
          const double minimumGainSplit,
          const size_t maximumDepth,
-         DimensionSelectionType dimensionSelector)
+         DimensionSelectionType dimensionSelector,
+         const bool computeImportances)
 {
   // Pass off to Train().
   data::DatasetInfo info; // Ignored by Train().
   return Train<false, false>(dataset, info, labels, numClasses, weights,
       numTrees, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector);
+      dimensionSelector, computeImportances);
 }
 
 template<
@@ -224,7 +227,7 @@ template<
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType
 >
-template<typename MatType>
+template<typename MatType, typename LabelsType>
 double RandomForest<
     FitnessFunction,
     DimensionSelectionType,
@@ -232,19 +235,20 @@ double RandomForest<
     CategoricalSplitType
 >::Train(const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
-         const arma::Row<size_t>& labels,
+         const LabelsType& labels,
          const size_t numClasses,
          const arma::rowvec& weights,
          const size_t numTrees,
          const size_t minimumLeafSize,
          const double minimumGainSplit,
          const size_t maximumDepth,
-         DimensionSelectionType dimensionSelector)
+         DimensionSelectionType dimensionSelector,
+         const bool computeImportances)
 {
   // Pass off to Train().
   return Train<true, true>(dataset, datasetInfo, labels, numClasses, weights,
       numTrees, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector);
+      dimensionSelector, computeImportances);
 }
 
 template<
@@ -340,10 +344,38 @@ void RandomForest<
 
   predictions.set_size(data.n_cols);
 
-  #pragma omp parallel for
-  for (omp_size_t i = 0; i < data.n_cols; ++i)
+  // Process the points in blocks.  Each block is pushed through every tree
+  // with the batch DecisionTree::Classify() and the votes are fused into one
+  // accumulator before taking the argmax; this keeps a tree's nodes hot in
+  // cache for a whole block of points rather than re-walking the entire
+  // forest for every point.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
   {
-    predictions[i] = Classify(data.col(i));
+    const size_t firstId = block * blockSize;
+    const size_t lastId = std::min(firstId + blockSize, (size_t) data.n_cols)
+        - 1;
+
+    arma::mat votes(trees[0].NumClasses(), lastId - firstId + 1,
+        arma::fill::zeros);
+    arma::Row<size_t> treePredictions; // Ignored.
+    arma::mat treeProbs;
+    for (size_t t = 0; t < trees.size(); ++t)
+    {
+      trees[t].Classify(data.cols(firstId, lastId), treePredictions,
+          treeProbs);
+      votes += treeProbs;
+    }
+
+    for (size_t i = firstId; i <= lastId; ++i)
+    {
+      arma::uword maxIndex = 0;
+      votes.col(i - firstId).max(maxIndex);
+      predictions[i] = (size_t) maxIndex;
+    }
   }
 }
 
@@ -373,13 +405,38 @@ void RandomForest<
         "trained!");
   }
 
-  probabilities.set_size(trees[0].NumClasses(), data.n_cols);
+  probabilities.zeros(trees[0].NumClasses(), data.n_cols);
   predictions.set_size(data.n_cols);
-  #pragma omp parallel for
-  for (omp_size_t i = 0; i < data.n_cols; ++i)
+
+  // Batched voting, as in the predictions-only overload above: each block of
+  // points goes through all trees before moving on, and the accumulated votes
+  // are normalized at the end.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
   {
-    arma::vec probs = probabilities.unsafe_col(i);
-    Classify(data.col(i), predictions[i], probs);
+    const size_t firstId = block * blockSize;
+    const size_t lastId = std::min(firstId + blockSize, (size_t) data.n_cols)
+        - 1;
+
+    arma::Row<size_t> treePredictions; // Ignored.
+    arma::mat treeProbs;
+    for (size_t t = 0; t < trees.size(); ++t)
+    {
+      trees[t].Classify(data.cols(firstId, lastId), treePredictions,
+          treeProbs);
+      probabilities.cols(firstId, lastId) += treeProbs;
+    }
+    probabilities.cols(firstId, lastId) /= trees.size();
+
+    for (size_t i = firstId; i <= lastId; ++i)
+    {
+      arma::uword maxIndex = 0;
+      probabilities.unsafe_col(i).max(maxIndex);
+      predictions[i] = (size_t) maxIndex;
+    }
   }
 }
 
@@ -405,11 +462,46 @@ void RandomForest<
 
   ar(CEREAL_NVP(numTrees));
 
-  // Allocate space if needed.
+  // The trees dominate the size of the model, so each one is stored as its
+  // own compressed blob instead of an expanded object.  Because the blobs are
+  // independent, packing and unpacking parallelizes over the trees.
+  std::vector<data::CompressedBlob<DecisionTreeType>> compressedTrees(
+      numTrees);
+  if (!cereal::is_loading<Archive>())
+  {
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) numTrees; ++i)
+      compressedTrees[i].Pack(trees[i]);
+  }
+
+  ar(CEREAL_NVP(compressedTrees));
+
   if (cereal::is_loading<Archive>())
+  {
     trees.resize(numTrees);
+    // An exception must not escape the parallel region, so remember failures
+    // and rethrow afterwards.
+    bool failed = false;
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) numTrees; ++i)
+    {
+      try
+      {
+        compressedTrees[i].Unpack(trees[i]);
+      }
+      catch (cereal::Exception&)
+      {
+        failed = true;
+      }
+    }
+
+    if (failed)
+      throw cereal::Exception("RandomForest::serialize(): cannot unpack "
+          "compressed trees; corrupt model file?");
+  }
 
-  ar(CEREAL_NVP(trees));
+  ar(CEREAL_NVP(oobError));
+  ar(CEREAL_NVP(featureImportances));
 }
 
 template<
@@ -418,7 +510,10 @@ template<
     template<typename> class NumericSplitType,
     template<typename> class CategoricalSplitType
 >
-template<bool UseWeights, bool UseDatasetInfo, typename MatType>
+template<bool UseWeights,
+         bool UseDatasetInfo,
+         typename MatType,
+         typename LabelsType>
 double RandomForest<
     FitnessFunction,
     DimensionSelectionType,
@@ -426,29 +521,57 @@ double RandomForest<
     CategoricalSplitType
 >::Train(const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
-         const arma::Row<size_t>& labels,
+         const LabelsType& labels,
          const size_t numClasses,
          const arma::rowvec& weights,
          const size_t numTrees,
          const size_t minimumLeafSize,
          const double minimumGainSplit,
          const size_t maximumDepth,
-         DimensionSelectionType& dimensionSelector)
+         DimensionSelectionType& dimensionSelector,
+         const bool computeImportances)
 {
   // Train each tree individually.
   trees.resize(numTrees); // This will fill the vector with untrained trees.
   double avgGain = 0.0;
+  if (computeImportances)
+    featureImportances.zeros(dataset.n_rows);
+  else
+    featureImportances.clear();
+
+  // Draw every tree's bootstrap sample up front, on one thread.  This way the
+  // sampling consumes the random generator in a fixed order, so a seeded run
+  // builds the same samples no matter how many threads train the trees below.
+  // (The random dimension selection inside each tree draws from a per-tree
+  // deterministic stream, so the full forest is reproducible under OpenMP.)
+  Timer::Start("bootstrap");
+  std::vector<arma::uvec> bootstrapIndices(numTrees);
+  for (size_t i = 0; i < numTrees; ++i)
+  {
+    bootstrapIndices[i] = arma::randi<arma::uvec>(dataset.n_cols,
+        arma::distr_param(0, dataset.n_cols - 1));
+  }
+  Timer::Stop("bootstrap");
+
+  // Votes of each tree on the points it did not see during bootstrap
+  // sampling; these are tallied while the trees train, so the out-of-bag
+  // error estimate costs no separate pass over the dataset.
+  arma::mat oobVotes(numClasses, dataset.n_cols, arma::fill::zeros);
 
   #pragma omp parallel for reduction( + : avgGain)
   for (omp_size_t i = 0; i < numTrees; ++i)
   {
-    Timer::Start("bootstrap");
+    // Give this tree its own deterministic random stream: the random
+    // dimension selection during training draws from the per-thread
+    // generator, so with per-tree streams a seeded run builds identical trees
+    // at any thread count.
+    math::SeedThreadStream(i);
+
     MatType bootstrapDataset;
-    arma::Row<size_t> bootstrapLabels;
+    typename std::decay<LabelsType>::type bootstrapLabels;
     arma::rowvec bootstrapWeights;
-    Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
-        bootstrapLabels, bootstrapWeights);
-    Timer::Stop("bootstrap");
+    Bootstrap<UseWeights>(dataset, labels, weights, bootstrapIndices[i],
+        bootstrapDataset, bootstrapLabels, bootstrapWeights);
 
     // Now build the decision tree.
     Timer::Start("train_tree");
@@ -482,7 +605,82 @@ double RandomForest<
       }
     }
     Timer::Stop("train_tree");
+
+    // Classify the points this tree never saw and fold its votes into the
+    // shared out-of-bag tally.
+    arma::Row<size_t> inBag(dataset.n_cols, arma::fill::zeros);
+    for (size_t j = 0; j < bootstrapIndices[i].n_elem; ++j)
+      inBag[bootstrapIndices[i][j]] = 1;
+    const arma::uvec oobPoints = arma::find(inBag == 0);
+    if (oobPoints.n_elem == 0)
+      continue;
+
+    const MatType oobData = dataset.cols(oobPoints);
+    // oobPredictions is a Row<size_t>, so bring the out-of-bag labels to that
+    // type for the elementwise comparisons below.
+    const arma::Row<size_t> oobLabels =
+        arma::conv_to<arma::Row<size_t>>::from(labels.cols(oobPoints));
+
+    arma::Row<size_t> oobPredictions;
+    arma::mat oobProbs;
+    trees[i].Classify(oobData, oobPredictions, oobProbs);
+
+    #pragma omp critical
+    {
+      for (size_t j = 0; j < oobPoints.n_elem; ++j)
+        oobVotes.col(oobPoints[j]) += oobProbs.col(j);
+    }
+
+    if (computeImportances)
+    {
+      // Permutation importance of a dimension: how much this tree's accuracy
+      // on its out-of-bag points drops when that dimension's values are
+      // shuffled among them.
+      const size_t baseCorrect = arma::accu(oobPredictions == oobLabels);
+      arma::vec treeImportances(dataset.n_rows, arma::fill::zeros);
+      MatType permutedData = oobData;
+      for (size_t dim = 0; dim < dataset.n_rows; ++dim)
+      {
+        permutedData.row(dim) = arma::shuffle(oobData.row(dim));
+
+        arma::Row<size_t> permutedPredictions;
+        trees[i].Classify(permutedData, permutedPredictions);
+        const size_t permutedCorrect =
+            arma::accu(permutedPredictions == oobLabels);
+        treeImportances[dim] = (double(baseCorrect) -
+            double(permutedCorrect)) / double(oobPoints.n_elem);
+
+        // Restore the dimension before permuting the next one.
+        permutedData.row(dim) = oobData.row(dim);
+      }
+
+      #pragma omp critical
+      {
+        featureImportances += treeImportances;
+      }
+    }
   }
+
+  // A point contributes to the out-of-bag error if at least one tree voted on
+  // it; the prediction is the majority vote of those trees.
+  size_t oobCount = 0;
+  size_t oobWrong = 0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    if (arma::accu(oobVotes.col(i)) == 0.0)
+      continue;
+
+    ++oobCount;
+    arma::uword maxIndex = 0;
+    oobVotes.col(i).max(maxIndex);
+    if ((size_t) maxIndex != labels[i])
+      ++oobWrong;
+  }
+  oobError = (oobCount > 0) ? double(oobWrong) / double(oobCount) : 0.0;
+
+  if (computeImportances)
+    featureImportances /= numTrees;
+
   return avgGain / numTrees;
 }
 
@@ -0,0 +1,237 @@
+/**
+ * @file methods/random_forest/random_forest_regressor.hpp
+ * @author Ryan Curtin
+ *
+ * Definition of the RandomForestRegressor class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_RANDOM_FOREST_REGRESSOR_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_RANDOM_FOREST_REGRESSOR_HPP
+
+#include <mlpack/core/math/random.hpp>
+#include <mlpack/core/data/compressed_blob.hpp>
+#include <mlpack/methods/decision_tree/decision_tree_regressor.hpp>
+#include <mlpack/methods/decision_tree/multiple_random_dimension_select.hpp>
+#include "bootstrap.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The RandomForestRegressor class provides an implementation of random
+ * forests for regression: an ensemble of DecisionTreeRegressor trees, each
+ * trained on a bootstrap sample of the dataset with randomized dimension
+ * selection, whose predictions are averaged.
+ *
+ * All of the const Predict() overloads are reentrant: they modify no state of
+ * the forest and use no hidden scratch storage, so a single trained forest may
+ * safely serve concurrent Predict() calls from multiple threads.
+ */
+template<typename FitnessFunction = MSEGain,
+         typename DimensionSelectionType = MultipleRandomDimensionSelect,
+         template<typename> class NumericSplitType = HistogramNumericSplit>
+class RandomForestRegressor
+{
+ public:
+  //! Allow access to the underlying decision tree type.
+  typedef DecisionTreeRegressor<FitnessFunction, NumericSplitType,
+      DimensionSelectionType> DecisionTreeType;
+
+  /**
+   * Construct the random forest without any training or specifying the number
+   * of trees.  Predict() will throw an exception until Train() is called.
+   */
+  RandomForestRegressor() : oobError(0.0) { }
+
+  /**
+   * Create a random forest, training on the given data and responses with the
+   * given number of trees.  The minimumLeafSize and minimumGainSplit
+   * parameters are given to each individual decision tree during tree
+   * building.  Optionally, you may specify a DimensionSelectionType to set
+   * parameters for the strategy used to choose dimensions.
+   *
+   * @param dataset Dataset to train on.
+   * @param responses Responses for each training point.
+   * @param numTrees Number of trees in the forest.
+   * @param minimumLeafSize Minimum number of points in each tree's leaf nodes.
+   * @param minimumGainSplit Minimum gain for splitting a decision tree node.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   */
+  template<typename MatType, typename ResponsesType>
+  RandomForestRegressor(const MatType& dataset,
+                        const ResponsesType& responses,
+                        const size_t numTrees = 20,
+                        const size_t minimumLeafSize = 1,
+                        const double minimumGainSplit = 1e-7,
+                        const size_t maximumDepth = 0,
+                        DimensionSelectionType dimensionSelector =
+                            DimensionSelectionType());
+
+  /**
+   * Create a random forest, training on the given weighted data and responses
+   * with the given number of trees.  The minimumLeafSize and minimumGainSplit
+   * parameters are given to each individual decision tree during tree
+   * building.
+   *
+   * @param dataset Dataset to train on.
+   * @param responses Responses for each training point.
+   * @param weights Weights (importances) of each point in the dataset.
+   * @param numTrees Number of trees in the forest.
+   * @param minimumLeafSize Minimum number of points in each tree's leaf nodes.
+   * @param minimumGainSplit Minimum gain for splitting a decision tree node.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   */
+  template<typename MatType, typename ResponsesType>
+  RandomForestRegressor(const MatType& dataset,
+                        const ResponsesType& responses,
+                        const arma::rowvec& weights,
+                        const size_t numTrees = 20,
+                        const size_t minimumLeafSize = 1,
+                        const double minimumGainSplit = 1e-7,
+                        const size_t maximumDepth = 0,
+                        DimensionSelectionType dimensionSelector =
+                            DimensionSelectionType());
+
+  /**
+   * Train the random forest on the given data and responses with the given
+   * number of trees.  The minimumLeafSize and minimumGainSplit parameters are
+   * given to each individual decision tree during tree building.  Optionally,
+   * you may specify a DimensionSelectionType to set parameters for the
+   * strategy used to choose dimensions.
+   *
+   * @param data Dataset to train on.
+   * @param responses Responses for each training point.
+   * @param numTrees Number of trees in the forest.
+   * @param minimumLeafSize Minimum number of points in each tree's leaf nodes.
+   * @param minimumGainSplit Minimum gain for splitting a decision tree node.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The average error of all the decision trees trained under forest.
+   */
+  template<typename MatType, typename ResponsesType>
+  double Train(const MatType& data,
+               const ResponsesType& responses,
+               const size_t numTrees = 20,
+               const size_t minimumLeafSize = 1,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 0,
+               DimensionSelectionType dimensionSelector =
+                   DimensionSelectionType());
+
+  /**
+   * Train the random forest on the given weighted data and responses with the
+   * given number of trees.  The minimumLeafSize and minimumGainSplit
+   * parameters are given to each individual decision tree during tree
+   * building.
+   *
+   * @param data Dataset to train on.
+   * @param responses Responses for each training point.
+   * @param weights Weights (importances) of each point in the dataset.
+   * @param numTrees Number of trees in the forest.
+   * @param minimumLeafSize Minimum number of points in each tree's leaf nodes.
+   * @param minimumGainSplit Minimum gain for splitting a decision tree node.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The average error of all the decision trees trained under forest.
+   */
+  template<typename MatType, typename ResponsesType>
+  double Train(const MatType& data,
+               const ResponsesType& responses,
+               const arma::rowvec& weights,
+               const size_t numTrees = 20,
+               const size_t minimumLeafSize = 1,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 0,
+               DimensionSelectionType dimensionSelector =
+                   DimensionSelectionType());
+
+  /**
+   * Predict the response of the given point, as the average of every tree's
+   * prediction.  If the random forest has not been trained, this will throw an
+   * exception.
+   *
+   * @param point Point to be predicted.
+   */
+  template<typename VecType>
+  double Predict(const VecType& point) const;
+
+  /**
+   * Predict the responses of each point in the given dataset.  If the random
+   * forest has not been trained, this will throw an exception.
+   *
+   * @param data Dataset to be predicted.
+   * @param predictions Output predictions for each point in the dataset.
+   */
+  template<typename MatType>
+  void Predict(const MatType& data, arma::rowvec& predictions) const;
+
+  //! Access a tree in the forest.
+  const DecisionTreeType& Tree(const size_t i) const { return trees[i]; }
+  //! Modify a tree in the forest (be careful!).
+  DecisionTreeType& Tree(const size_t i) { return trees[i]; }
+
+  //! Get the number of trees in the forest.
+  size_t NumTrees() const { return trees.size(); }
+
+  /**
+   * Get the out-of-bag mean squared error from the last call to Train().
+   * Each point is predicted by averaging only those trees that did not see it
+   * during bootstrap sampling, so this is an unbiased estimate of the
+   * generalization error that costs no separate evaluation pass.  This is 0
+   * if the forest has not been trained.
+   */
+  double OOBError() const { return oobError; }
+
+  /**
+   * Serialize the random forest.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Perform the training of the forest.  The template bool parameter controls
+   * whether or not the weights argument should be ignored.
+   *
+   * @param dataset Dataset to train on.
+   * @param responses Responses for the dataset.
+   * @param weights Weights for each point in the dataset (may be ignored).
+   * @param numTrees Number of trees in the forest.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for splitting a decision tree node.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @tparam UseWeights Whether or not to use the weights parameter.
+   * @tparam MatType The type of data matrix (i.e. arma::mat).
+   * @return The average error of all the decision trees trained under forest.
+   */
+  template<bool UseWeights, typename MatType, typename ResponsesType>
+  double Train(const MatType& dataset,
+               const ResponsesType& responses,
+               const arma::rowvec& weights,
+               const size_t numTrees,
+               const size_t minimumLeafSize,
+               const double minimumGainSplit,
+               const size_t maximumDepth,
+               DimensionSelectionType& dimensionSelector);
+
+  //! The trees in the forest.
+  std::vector<DecisionTreeType> trees;
+
+  //! The out-of-bag error from the last call to Train().
+  double oobError;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "random_forest_regressor_impl.hpp"
+
+#endif
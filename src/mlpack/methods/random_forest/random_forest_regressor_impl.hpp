@@ -0,0 +1,364 @@
+/**
+ * @file methods/random_forest/random_forest_regressor_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of random forest regression.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_RANDOM_FOREST_REGRESSOR_IMPL_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_RANDOM_FOREST_REGRESSOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "random_forest_regressor.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType
+>
+template<typename MatType, typename ResponsesType>
+RandomForestRegressor<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType
+>::RandomForestRegressor(const MatType& dataset,
+                         const ResponsesType& responses,
+                         const size_t numTrees,
+                         const size_t minimumLeafSize,
+                         const double minimumGainSplit,
+                         const size_t maximumDepth,
+                         DimensionSelectionType dimensionSelector)
+{
+  // Pass off work to the Train() method.
+  arma::rowvec weights; // Fake weights, not used.
+  Train<false>(dataset, responses, weights, numTrees, minimumLeafSize,
+      minimumGainSplit, maximumDepth, dimensionSelector);
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType
+>
+template<typename MatType, typename ResponsesType>
+RandomForestRegressor<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType
+>::RandomForestRegressor(const MatType& dataset,
+                         const ResponsesType& responses,
+                         const arma::rowvec& weights,
+                         const size_t numTrees,
+                         const size_t minimumLeafSize,
+                         const double minimumGainSplit,
+                         const size_t maximumDepth,
+                         DimensionSelectionType dimensionSelector)
+{
+  // Pass off work to the Train() method.
+  Train<true>(dataset, responses, weights, numTrees, minimumLeafSize,
+      minimumGainSplit, maximumDepth, dimensionSelector);
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType
+>
+template<typename MatType, typename ResponsesType>
+double RandomForestRegressor<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType
+>::Train(const MatType& data,
+         const ResponsesType& responses,
+         const size_t numTrees,
+         const size_t minimumLeafSize,
+         const double minimumGainSplit,
+         const size_t maximumDepth,
+         DimensionSelectionType dimensionSelector)
+{
+  // Pass off to Train().
+  arma::rowvec weights; // Ignored by Train().
+  return Train<false>(data, responses, weights, numTrees, minimumLeafSize,
+      minimumGainSplit, maximumDepth, dimensionSelector);
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType
+>
+template<typename MatType, typename ResponsesType>
+double RandomForestRegressor<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType
+>::Train(const MatType& data,
+         const ResponsesType& responses,
+         const arma::rowvec& weights,
+         const size_t numTrees,
+         const size_t minimumLeafSize,
+         const double minimumGainSplit,
+         const size_t maximumDepth,
+         DimensionSelectionType dimensionSelector)
+{
+  // Pass off to Train().
+  return Train<true>(data, responses, weights, numTrees, minimumLeafSize,
+      minimumGainSplit, maximumDepth, dimensionSelector);
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType
+>
+template<typename VecType>
+double RandomForestRegressor<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType
+>::Predict(const VecType& point) const
+{
+  // Check edge case.
+  if (trees.size() == 0)
+  {
+    throw std::invalid_argument("RandomForestRegressor::Predict(): no random "
+        "forest trained!");
+  }
+
+  double sum = 0.0;
+  for (size_t i = 0; i < trees.size(); ++i)
+    sum += trees[i].Predict(point);
+
+  return sum / trees.size();
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType
+>
+template<typename MatType>
+void RandomForestRegressor<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType
+>::Predict(const MatType& data, arma::rowvec& predictions) const
+{
+  // Check edge case.
+  if (trees.size() == 0)
+  {
+    predictions.clear();
+
+    throw std::invalid_argument("RandomForestRegressor::Predict(): no random "
+        "forest trained!");
+  }
+
+  predictions.zeros(data.n_cols);
+
+  // Process the points in blocks, as in RandomForest::Classify(): each block
+  // is pushed through every tree with the batch
+  // DecisionTreeRegressor::Predict() and the results are accumulated before
+  // averaging, which keeps a tree's nodes hot in cache for a whole block of
+  // points rather than re-walking the entire forest for every point.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t firstId = block * blockSize;
+    const size_t lastId = std::min(firstId + blockSize, (size_t) data.n_cols)
+        - 1;
+
+    arma::rowvec treePredictions;
+    for (size_t t = 0; t < trees.size(); ++t)
+    {
+      trees[t].Predict(data.cols(firstId, lastId), treePredictions);
+      predictions.subvec(firstId, lastId) += treePredictions;
+    }
+    predictions.subvec(firstId, lastId) /= trees.size();
+  }
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType
+>
+template<typename Archive>
+void RandomForestRegressor<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType
+>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  size_t numTrees;
+  if (cereal::is_loading<Archive>())
+    trees.clear();
+  else
+    numTrees = trees.size();
+
+  ar(CEREAL_NVP(numTrees));
+
+  // The trees dominate the size of the model, so each one is stored as its
+  // own compressed blob, as in RandomForest::serialize(); the independent
+  // blobs let packing and unpacking parallelize over the trees.
+  std::vector<data::CompressedBlob<DecisionTreeType>> compressedTrees(
+      numTrees);
+  if (!cereal::is_loading<Archive>())
+  {
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) numTrees; ++i)
+      compressedTrees[i].Pack(trees[i]);
+  }
+
+  ar(CEREAL_NVP(compressedTrees));
+
+  if (cereal::is_loading<Archive>())
+  {
+    trees.resize(numTrees);
+    // An exception must not escape the parallel region, so remember failures
+    // and rethrow afterwards.
+    bool failed = false;
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) numTrees; ++i)
+    {
+      try
+      {
+        compressedTrees[i].Unpack(trees[i]);
+      }
+      catch (cereal::Exception&)
+      {
+        failed = true;
+      }
+    }
+
+    if (failed)
+      throw cereal::Exception("RandomForestRegressor::serialize(): cannot "
+          "unpack compressed trees; corrupt model file?");
+  }
+
+  ar(CEREAL_NVP(oobError));
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType
+>
+template<bool UseWeights, typename MatType, typename ResponsesType>
+double RandomForestRegressor<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType
+>::Train(const MatType& dataset,
+         const ResponsesType& responses,
+         const arma::rowvec& weights,
+         const size_t numTrees,
+         const size_t minimumLeafSize,
+         const double minimumGainSplit,
+         const size_t maximumDepth,
+         DimensionSelectionType& dimensionSelector)
+{
+  // Train each tree individually.
+  trees.resize(numTrees); // This will fill the vector with untrained trees.
+  double avgGain = 0.0;
+
+  // Draw every tree's bootstrap sample up front, on one thread, so a seeded
+  // run builds the same samples no matter how many threads train the trees
+  // below (see RandomForest::Train()).
+  Timer::Start("bootstrap");
+  std::vector<arma::uvec> bootstrapIndices(numTrees);
+  for (size_t i = 0; i < numTrees; ++i)
+  {
+    bootstrapIndices[i] = arma::randi<arma::uvec>(dataset.n_cols,
+        arma::distr_param(0, dataset.n_cols - 1));
+  }
+  Timer::Stop("bootstrap");
+
+  // Predictions of each tree on the points it did not see during bootstrap
+  // sampling; these are tallied while the trees train, so the out-of-bag
+  // error estimate costs no separate pass over the dataset.
+  arma::rowvec oobSums(dataset.n_cols, arma::fill::zeros);
+  arma::Row<size_t> oobCounts(dataset.n_cols, arma::fill::zeros);
+
+  #pragma omp parallel for reduction( + : avgGain)
+  for (omp_size_t i = 0; i < numTrees; ++i)
+  {
+    // Give this tree its own deterministic random stream, so that the random
+    // dimension selection during training is reproducible at any thread count.
+    math::SeedThreadStream(i);
+
+    MatType bootstrapDataset;
+    typename std::decay<ResponsesType>::type bootstrapResponses;
+    arma::rowvec bootstrapWeights;
+    Bootstrap<UseWeights>(dataset, responses, weights, bootstrapIndices[i],
+        bootstrapDataset, bootstrapResponses, bootstrapWeights);
+
+    // Now build the decision tree.
+    Timer::Start("train_tree");
+    if (UseWeights)
+    {
+      avgGain += trees[i].Train(bootstrapDataset, bootstrapResponses,
+          bootstrapWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
+          dimensionSelector);
+    }
+    else
+    {
+      avgGain += trees[i].Train(bootstrapDataset, bootstrapResponses,
+          minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+    }
+    Timer::Stop("train_tree");
+
+    // Predict the points this tree never saw and fold the results into the
+    // shared out-of-bag tally.
+    arma::Row<size_t> inBag(dataset.n_cols, arma::fill::zeros);
+    for (size_t j = 0; j < bootstrapIndices[i].n_elem; ++j)
+      inBag[bootstrapIndices[i][j]] = 1;
+    const arma::uvec oobPoints = arma::find(inBag == 0);
+    if (oobPoints.n_elem == 0)
+      continue;
+
+    arma::rowvec oobPredictions;
+    trees[i].Predict(dataset.cols(oobPoints), oobPredictions);
+
+    #pragma omp critical
+    {
+      for (size_t j = 0; j < oobPoints.n_elem; ++j)
+      {
+        oobSums[oobPoints[j]] += oobPredictions[j];
+        oobCounts[oobPoints[j]]++;
+      }
+    }
+  }
+
+  // A point contributes to the out-of-bag error if at least one tree
+  // predicted it; the prediction is the average over those trees.
+  size_t oobCount = 0;
+  double oobSquaredError = 0.0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    if (oobCounts[i] == 0)
+      continue;
+
+    ++oobCount;
+    const double error = oobSums[i] / oobCounts[i] - responses[i];
+    oobSquaredError += error * error;
+  }
+  oobError = (oobCount > 0) ? oobSquaredError / double(oobCount) : 0.0;
+
+  return avgGain / numTrees;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -22,10 +22,12 @@ RandomizedSVD::RandomizedSVD(const arma::mat& data,
                              const size_t iteratedPower,
                              const size_t maxIterations,
                              const size_t rank,
-                             const double eps) :
+                             const double eps,
+                             const double tolerance) :
     iteratedPower(iteratedPower),
     maxIterations(maxIterations),
-    eps(eps)
+    eps(eps),
+    tolerance(tolerance)
 {
   if (rank == 0)
   {
@@ -39,10 +41,12 @@ RandomizedSVD::RandomizedSVD(const arma::mat& data,
 
 RandomizedSVD::RandomizedSVD(const size_t iteratedPower,
                              const size_t maxIterations,
-                             const double eps) :
+                             const double eps,
+                             const double tolerance) :
     iteratedPower(iteratedPower),
     maxIterations(maxIterations),
-    eps(eps)
+    eps(eps),
+    tolerance(tolerance)
 {
   /* Nothing to do here */
 }
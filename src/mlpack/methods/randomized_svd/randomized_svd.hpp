@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_RANDOMIZED_SVD_RANDOMIZED_SVD_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/fast_projection.hpp>
 
 namespace mlpack {
 namespace svd {
@@ -80,6 +81,10 @@ class RandomizedSVD
    * @param rank Rank of the approximation (Default: number of rows.)
    * @param eps The eps coefficient to avoid division by zero (numerical
    *        stability).
+   * @param tolerance If greater than zero, stop the power iterations early
+   *        once the largest principal angle between successive subspace
+   *        estimates drops below this value; maxIterations then acts as an
+   *        upper limit (Default: 0, always run maxIterations iterations).
    */
   RandomizedSVD(const arma::mat& data,
                 arma::mat& u,
@@ -88,7 +93,8 @@ class RandomizedSVD
                 const size_t iteratedPower = 0,
                 const size_t maxIterations = 2,
                 const size_t rank = 0,
-                const double eps = 1e-7);
+                const double eps = 1e-7,
+                const double tolerance = 0);
 
   /**
    * Create object for the randomized SVD method.
@@ -99,10 +105,15 @@ class RandomizedSVD
    *        (Default: 2).
    * @param eps The eps coefficient to avoid division by zero (numerical
    *        stability).
+   * @param tolerance If greater than zero, stop the power iterations early
+   *        once the largest principal angle between successive subspace
+   *        estimates drops below this value; maxIterations then acts as an
+   *        upper limit (Default: 0, always run maxIterations iterations).
    */
   RandomizedSVD(const size_t iteratedPower = 0,
                 const size_t maxIterations = 2,
-                const double eps = 1e-7);
+                const double eps = 1e-7,
+                const double tolerance = 0);
 
 /**
    * Center the data to apply Principal Component Analysis on given sparse
@@ -140,6 +151,12 @@ class RandomizedSVD
    * Apply Principal Component Analysis to the provided matrix data set
    * using the randomized SVD.
    *
+   * This overload is the backend-generic entry point: the linear algebra
+   * functions are called unqualified so they resolve via argument-dependent
+   * lookup, which means it can be instantiated with the matrix types of any
+   * backend that mirrors the Armadillo API (see the dense backend aliases in
+   * prereqs.hpp).
+   *
    * @param data Data matrix.
    * @param u First unitary matrix.
    * @param v Second unitary matrix.
@@ -147,70 +164,120 @@ class RandomizedSVD
    * @param rank Rank of the approximation.
    * @param rowMean Centered mean value matrix.
    */
-  template<typename MatType>
+  template<typename MatType, typename OutMatType, typename VecType>
   void Apply(const MatType& data,
-             arma::mat& u,
-             arma::vec& s,
-             arma::mat& v,
+             OutMatType& u,
+             VecType& s,
+             OutMatType& v,
              const size_t rank,
              MatType rowMean)
   {
     if (iteratedPower == 0)
       iteratedPower = rank + 2;
 
-    arma::mat R, Q, Qdata;
+    OutMatType R, Q, Qdata;
 
-    // Apply the centered data matrix to a random matrix, obtaining Q.
+    // Apply the centered data matrix to a random matrix, obtaining Q.  With
+    // the fast projection enabled, the dense Gaussian matrix is replaced by
+    // the implicit subsampled randomized Hadamard transform: the sketch costs
+    // O(log d) per matrix entry instead of O(iteratedPower), and the
+    // centering corrections are just the projections of the row mean and of
+    // the all-ones vector.
     if (data.n_cols >= data.n_rows)
     {
-      R = arma::randn<arma::mat>(data.n_rows, iteratedPower);
-      Q = (data.t() * R) - arma::repmat(arma::trans(R.t() * rowMean),
-          data.n_cols, 1);
+      if (useFastProjection)
+      {
+        math::SubsampledHadamardProjection proj(data.n_rows, iteratedPower);
+        OutMatType sketch, meanSketch;
+        proj.Project(data, sketch);
+        proj.Project(OutMatType(rowMean), meanSketch);
+        Q = trans(sketch);
+        Q.each_row() -= trans(meanSketch);
+      }
+      else
+      {
+        R.set_size(data.n_rows, iteratedPower);
+        R.randn();
+        Q = (data.t() * R) - repmat(trans(R.t() * rowMean), data.n_cols, 1);
+      }
     }
     else
     {
-      R = arma::randn<arma::mat>(data.n_cols, iteratedPower);
-      Q = (data * R) - (rowMean * (arma::ones(1, data.n_cols) * R));
+      if (useFastProjection)
+      {
+        math::SubsampledHadamardProjection proj(data.n_cols, iteratedPower);
+        proj.ProjectRows(data, Q);
+        // The column sums of the implicit random matrix are the projection of
+        // the all-ones vector.
+        OutMatType onesSketch;
+        proj.Project(OutMatType(data.n_cols, 1, arma::fill::ones), onesSketch);
+        Q -= rowMean * trans(onesSketch);
+      }
+      else
+      {
+        R.set_size(data.n_cols, iteratedPower);
+        R.randn();
+        // ones(1, n) * R is the vector of column sums of R.
+        Q = (data * R) - (rowMean * sum(R, 0));
+      }
     }
 
     // Form a matrix Q whose columns constitute a
     // well-conditioned basis for the columns of the earlier Q.
     if (maxIterations == 0)
     {
-      arma::qr_econ(Q, v, Q);
+      qr_econ(Q, v, Q);
     }
     else
     {
-      arma::lu(Q, v, Q);
+      lu(Q, v, Q);
     }
 
     // Perform normalized power iterations.
+    OutMatType QPrev;
     for (size_t i = 0; i < maxIterations; ++i)
     {
       if (data.n_cols >= data.n_rows)
       {
-        Q = (data * Q) - rowMean * (arma::ones(1, data.n_cols) * Q);
-        arma::lu(Q, v, Q);
-        Q = (data.t() * Q) - arma::repmat(rowMean.t() * Q, data.n_cols, 1);
+        Q = (data * Q) - rowMean * sum(Q, 0);
+        lu(Q, v, Q);
+        Q = (data.t() * Q) - repmat(rowMean.t() * Q, data.n_cols, 1);
       }
       else
       {
-        Q = (data.t() * Q) - arma::repmat(rowMean.t() * Q, data.n_cols, 1);
-        arma::lu(Q, v, Q);
-        Q = (data * Q) - (rowMean * (arma::ones(1, data.n_cols) * Q));
+        Q = (data.t() * Q) - repmat(rowMean.t() * Q, data.n_cols, 1);
+        lu(Q, v, Q);
+        Q = (data * Q) - (rowMean * sum(Q, 0));
       }
 
       // Computing the LU decomposition is more efficient than computing the QR
       // decomposition, so we only use it in the last iteration, a pivoted QR
       // decomposition which renormalizes Q, ensuring that the columns of Q are
-      // orthonormal.
-      if (i < (maxIterations - 1))
+      // orthonormal.  When adaptive stopping is enabled, any iteration may be
+      // the last, so the basis is kept orthonormal throughout; this also makes
+      // the subspace comparison below meaningful.
+      if (tolerance > 0 || i == (maxIterations - 1))
       {
-        arma::lu(Q, v, Q);
+        qr_econ(Q, v, Q);
       }
       else
       {
-        arma::qr_econ(Q, v, Q);
+        lu(Q, v, Q);
+      }
+
+      if (tolerance > 0)
+      {
+        if (i > 0)
+        {
+          // The singular values of QPrev^T Q are the cosines of the principal
+          // angles between successive subspace estimates.  Once the subspace
+          // stops rotating, further passes over the data cannot improve the
+          // estimate, so we can stop early.
+          const VecType overlap = svd(OutMatType(QPrev.t() * Q));
+          if ((1.0 - overlap.min()) < tolerance)
+            break;
+        }
+        QPrev = Q;
       }
     }
 
@@ -219,14 +286,14 @@ class RandomizedSVD
     // applied to Q.
     if (data.n_cols >= data.n_rows)
     {
-      Qdata = (data * Q) - rowMean * (arma::ones(1, data.n_cols) * Q);
-      arma::svd_econ(u, s, v, Qdata);
+      Qdata = (data * Q) - rowMean * sum(Q, 0);
+      svd_econ(u, s, v, Qdata);
       v = Q * v;
     }
     else
     {
-      Qdata = (Q.t() * data) - arma::repmat(Q.t() * rowMean, 1,  data.n_cols);
-      arma::svd_econ(u, s, v, Qdata);
+      Qdata = (Q.t() * data) - repmat(Q.t() * rowMean, 1,  data.n_cols);
+      svd_econ(u, s, v, Qdata);
       u = Q * u;
     }
   }
@@ -246,6 +313,16 @@ class RandomizedSVD
   //! Modify the value used for decomposition stability.
   double& Epsilon() { return eps; }
 
+  //! Get the early-stopping tolerance of the power method.
+  double Tolerance() const { return tolerance; }
+  //! Modify the early-stopping tolerance of the power method.
+  double& Tolerance() { return tolerance; }
+
+  //! Get whether the initial sketch uses the fast Hadamard transform.
+  bool UseFastProjection() const { return useFastProjection; }
+  //! Modify whether the initial sketch uses the fast Hadamard transform.
+  bool& UseFastProjection() { return useFastProjection; }
+
  private:
   //! Locally stored size of the normalized power iterations.
   size_t iteratedPower;
@@ -255,6 +332,14 @@ class RandomizedSVD
 
   //! The value used for numerical stability.
   double eps;
+
+  //! Early-stopping tolerance on the rotation of the estimated subspace; 0
+  //! disables adaptive stopping.
+  double tolerance;
+
+  //! Whether to sketch with the subsampled randomized Hadamard transform
+  //! instead of a dense Gaussian matrix.
+  bool useFastProjection = false;
 };
 
 } // namespace svd
@@ -16,6 +16,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
 #include "range_search_stat.hpp"
 
 namespace mlpack {
@@ -36,12 +37,24 @@ class LeafSizeRSWrapper;
  * @tparam MetricType Metric to use for range search calculations.
  * @tparam MatType Type of data to use.
  * @tparam TreeType Type of tree to use; must satisfy the TreeType policy API.
+ * @tparam DualTreeTraversalType The type of dual tree traversal to use
+ *     (defaults to the tree's default traverser).
+ * @tparam SingleTreeTraversalType The type of single tree traversal to use
+ *     (defaults to the tree's default traverser).
  */
 template<typename MetricType = metric::EuclideanDistance,
          typename MatType = arma::mat,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType = tree::KDTree>
+                  typename TreeMatType> class TreeType = tree::KDTree,
+         template<typename RuleType> class DualTreeTraversalType =
+             TreeType<MetricType,
+                      RangeSearchStat,
+                      MatType>::template DualTreeTraverser,
+         template<typename RuleType> class SingleTreeTraversalType =
+             TreeType<MetricType,
+                      RangeSearchStat,
+                      MatType>::template SingleTreeTraverser>
 class RangeSearch
 {
  public:
@@ -268,6 +281,60 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, streaming each result to the given callback as soon as it is
+   * found instead of accumulating results in memory.  The callback must be
+   * callable as callback(queryIndex, neighborIndex, distance); the indices
+   * passed to it refer to the original (unpermuted) query and reference sets,
+   * and results for a query point arrive in no particular order.
+   *
+   * Use this overload for large radius joins: memory use stays bounded no
+   * matter how dense the range is, and output can be consumed while the
+   * traversal is still running.
+   *
+   * Optionally, a per-query result cap may be given; once a query point has
+   * received maxNeighborsPerQuery results, no further results are emitted for
+   * it (and the search for it is pruned where possible).  Note that with a cap
+   * the emitted results are an arbitrary subset of the true result set.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param callback Callback invoked once per result.
+   * @param maxNeighborsPerQuery Maximum number of results to emit for any
+   *      single query point (0 means no cap).
+   */
+  template<typename CallbackType>
+  void Search(const MatType& querySet,
+              const math::Range& range,
+              CallbackType callback,
+              const size_t maxNeighborsPerQuery = 0);
+
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set (so the query set and the reference set are the same), streaming each
+   * result to the given callback as soon as it is found instead of
+   * accumulating results in memory.  The callback must be callable as
+   * callback(queryIndex, neighborIndex, distance); the indices passed to it
+   * refer to the original (unpermuted) reference set, a query point is never
+   * reported as its own neighbor, and results for a query point arrive in no
+   * particular order.
+   *
+   * Optionally, a per-query result cap may be given; once a query point has
+   * received maxNeighborsPerQuery results, no further results are emitted for
+   * it (and the search for it is pruned where possible).  Note that with a cap
+   * the emitted results are an arbitrary subset of the true result set.
+   *
+   * @param range Range of distances in which to search.
+   * @param callback Callback invoked once per result.
+   * @param maxNeighborsPerQuery Maximum number of results to emit for any
+   *      single query point (0 means no cap).
+   */
+  template<typename CallbackType>
+  void Search(const math::Range& range,
+              CallbackType callback,
+              const size_t maxNeighborsPerQuery = 0);
+
   //! Get whether single-tree search is being used.
   bool SingleMode() const { return singleMode; }
   //! Modify whether single-tree search is being used.
@@ -283,6 +350,11 @@ class RangeSearch
   //! Get the number of scores during the last search.
   size_t Scores() const { return scores; }
 
+  //! Get the full traversal statistics (prunes, result insertions, and so
+  //! forth) gathered during the last search.
+  const tree::TraversalStatistics& TraversalStats() const
+  { return traversalStats; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
@@ -317,6 +389,8 @@ class RangeSearch
   size_t baseCases;
   //! The total number of scores during the last search.
   size_t scores;
+  //! Aggregated traversal statistics from the last search.
+  tree::TraversalStatistics traversalStats;
 
   //! For access to mappings when building models.
   friend class LeafSizeRSWrapper<TreeType>;
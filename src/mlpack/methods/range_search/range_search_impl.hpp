@@ -46,8 +46,11 @@ template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::RangeSearch(
     MatType referenceSet,
     const bool naive,
     const bool singleMode,
@@ -70,8 +73,11 @@ template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::RangeSearch(
     Tree* referenceTree,
     const bool singleMode,
     const MetricType metric) :
@@ -91,8 +97,11 @@ template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::RangeSearch(
     const bool naive,
     const bool singleMode,
     const MetricType metric) :
@@ -119,8 +128,11 @@ template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::RangeSearch(
     const RangeSearch& other) :
     oldFromNewReferences(other.oldFromNewReferences),
     referenceTree(other.referenceTree ? new Tree(*other.referenceTree) : NULL),
@@ -140,8 +152,11 @@ template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<MetricType, MatType, TreeType>::RangeSearch(RangeSearch&& other) :
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::RangeSearch(RangeSearch&& other) :
     oldFromNewReferences(std::move(other.oldFromNewReferences)),
     referenceTree(other.referenceTree),
     referenceSet(other.referenceSet),
@@ -167,9 +182,13 @@ template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<MetricType, MatType, TreeType>&
-RangeSearch<MetricType, MatType, TreeType>::operator=(const RangeSearch& other)
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>&
+RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::operator=(const RangeSearch& other)
 {
   if (this != &other)
   {
@@ -191,9 +210,13 @@ template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<MetricType, MatType, TreeType>&
-RangeSearch<MetricType, MatType, TreeType>::operator=(RangeSearch&& other)
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>&
+RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::operator=(RangeSearch&& other)
 {
   if (this != &other)
   {
@@ -231,8 +254,11 @@ template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<MetricType, MatType, TreeType>::~RangeSearch()
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::~RangeSearch()
 {
   if (treeOwner && referenceTree)
     delete referenceTree;
@@ -244,8 +270,11 @@ template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RangeSearch<MetricType, MatType, TreeType>::Train(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::Train(
     MatType referenceSet)
 {
   // Clean up the old tree, if we built one.
@@ -282,8 +311,11 @@ template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RangeSearch<MetricType, MatType, TreeType>::Train(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::Train(
   Tree* referenceTree)
 {
   if (naive)
@@ -305,8 +337,11 @@ template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RangeSearch<MetricType, MatType, TreeType>::Search(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::Search(
     const MatType& querySet,
     const math::Range& range,
     std::vector<std::vector<size_t>>& neighbors,
@@ -360,6 +395,7 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   // Reset counts.
   baseCases = 0;
   scores = 0;
+  traversalStats.Reset();
 
   if (naive)
   {
@@ -372,13 +408,14 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
         rules.BaseCase(i, j);
 
     baseCases += (querySet.n_cols * referenceSet->n_cols);
+    traversalStats += rules.TraversalStats();
   }
   else if (singleMode)
   {
     // Create the traverser.
     RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
         metric);
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    SingleTreeTraversalType<RuleType> traverser(rules);
 
     // Now have it traverse for each point.
     for (size_t i = 0; i < querySet.n_cols; ++i)
@@ -386,6 +423,7 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
     baseCases += rules.BaseCases();
     scores += rules.Scores();
+    traversalStats += rules.TraversalStats();
   }
   else // Dual-tree recursion.
   {
@@ -399,12 +437,13 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
     // Create the traverser.
     RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
         *distancePtr, metric);
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    DualTreeTraversalType<RuleType> traverser(rules);
 
     traverser.Traverse(*queryTree, *referenceTree);
 
     baseCases += rules.BaseCases();
     scores += rules.Scores();
+    traversalStats += rules.TraversalStats();
 
     // Clean up tree memory.
     delete queryTree;
@@ -483,8 +522,11 @@ template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RangeSearch<MetricType, MatType, TreeType>::Search(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::Search(
     Tree* queryTree,
     const math::Range& range,
     std::vector<std::vector<size_t>>& neighbors,
@@ -522,7 +564,7 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
       distances, metric);
 
   // Create the traverser.
-  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+  DualTreeTraversalType<RuleType> traverser(rules);
 
   traverser.Traverse(*queryTree, *referenceTree);
 
@@ -530,6 +572,7 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
   baseCases = rules.BaseCases();
   scores = rules.Scores();
+  traversalStats = rules.TraversalStats();
 
   // Do we need to map indices?
   if (treeOwner && tree::TreeTraits<Tree>::RearrangesDataset)
@@ -554,8 +597,11 @@ template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RangeSearch<MetricType, MatType, TreeType>::Search(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::Search(
     const math::Range& range,
     std::vector<std::vector<size_t>>& neighbors,
     std::vector<std::vector<double>>& distances)
@@ -597,11 +643,12 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
     baseCases = (referenceSet->n_cols * referenceSet->n_cols);
     scores = 0;
+    traversalStats = rules.TraversalStats();
   }
   else if (singleMode)
   {
     // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    SingleTreeTraversalType<RuleType> traverser(rules);
 
     // Now have it traverse for each point.
     for (size_t i = 0; i < referenceSet->n_cols; ++i)
@@ -609,16 +656,18 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
     baseCases = rules.BaseCases();
     scores = rules.Scores();
+    traversalStats = rules.TraversalStats();
   }
   else // Dual-tree recursion.
   {
     // Create the traverser.
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    DualTreeTraversalType<RuleType> traverser(rules);
 
     traverser.Traverse(*referenceTree, *referenceTree);
 
     baseCases = rules.BaseCases();
     scores = rules.Scores();
+    traversalStats = rules.TraversalStats();
   }
 
   Timer::Stop("range_search/computing_neighbors");
@@ -655,9 +704,201 @@ template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename CallbackType>
+void RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::Search(
+    const MatType& querySet,
+    const math::Range& range,
+    CallbackType callback,
+    const size_t maxNeighborsPerQuery)
+{
+  util::CheckSameDimensionality(querySet, *referenceSet,
+      "RangeSearch::Search()", "query set");
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  Timer::Start("range_search/computing_neighbors");
+
+  // This will hold mappings for query points, if necessary.
+  std::vector<size_t> oldFromNewQueries;
+
+  // The callback must see original indices.  If the trees rearranged the
+  // datasets, map each index back before handing the result to the user's
+  // callback; there is no result storage, so the mapping happens per result
+  // instead of in a pass at the end.
+  const bool mapQueries = (tree::TreeTraits<Tree>::RearrangesDataset &&
+      !singleMode && !naive);
+  const bool mapRefs = (tree::TreeTraits<Tree>::RearrangesDataset &&
+      treeOwner);
+  auto mappedCallback = [&](const size_t queryIndex,
+                            const size_t neighborIndex,
+                            const double distance)
+  {
+    callback(mapQueries ? oldFromNewQueries[queryIndex] : queryIndex,
+        mapRefs ? oldFromNewReferences[neighborIndex] : neighborIndex,
+        distance);
+  };
+
+  // Create the helper objects for the traversal.
+  typedef RangeSearchCallbackCollector<decltype(mappedCallback)> CollectorType;
+  typedef RangeSearchRules<MetricType, Tree, CollectorType> RuleType;
+  CollectorType collector(mappedCallback, querySet.n_cols,
+      maxNeighborsPerQuery);
+
+  // Reset counts.
+  baseCases = 0;
+  scores = 0;
+  traversalStats.Reset();
+
+  if (naive)
+  {
+    RuleType rules(*referenceSet, querySet, range, collector, metric);
+
+    // The naive brute-force solution.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+        rules.BaseCase(i, j);
+
+    baseCases += (querySet.n_cols * referenceSet->n_cols);
+    traversalStats += rules.TraversalStats();
+  }
+  else if (singleMode)
+  {
+    // Create the traverser.
+    RuleType rules(*referenceSet, querySet, range, collector, metric);
+    SingleTreeTraversalType<RuleType> traverser(rules);
+
+    // Now have it traverse for each point.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    baseCases += rules.BaseCases();
+    scores += rules.Scores();
+    traversalStats += rules.TraversalStats();
+  }
+  else // Dual-tree recursion.
+  {
+    // Build the query tree.
+    Timer::Stop("range_search/computing_neighbors");
+    Timer::Start("range_search/tree_building");
+    Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+    Timer::Stop("range_search/tree_building");
+    Timer::Start("range_search/computing_neighbors");
+
+    // Create the traverser.
+    RuleType rules(*referenceSet, queryTree->Dataset(), range, collector,
+        metric);
+    DualTreeTraversalType<RuleType> traverser(rules);
+
+    traverser.Traverse(*queryTree, *referenceTree);
+
+    baseCases += rules.BaseCases();
+    scores += rules.Scores();
+    traversalStats += rules.TraversalStats();
+
+    // Clean up tree memory.
+    delete queryTree;
+  }
+
+  Timer::Stop("range_search/computing_neighbors");
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename CallbackType>
+void RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::Search(
+    const math::Range& range,
+    CallbackType callback,
+    const size_t maxNeighborsPerQuery)
+{
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  Timer::Start("range_search/computing_neighbors");
+
+  // The callback must see original indices.  If we built a tree that
+  // rearranged the dataset, map each index back before handing the result to
+  // the user's callback.
+  const bool mapRefs = (tree::TreeTraits<Tree>::RearrangesDataset &&
+      treeOwner);
+  auto mappedCallback = [&](const size_t queryIndex,
+                            const size_t neighborIndex,
+                            const double distance)
+  {
+    callback(mapRefs ? oldFromNewReferences[queryIndex] : queryIndex,
+        mapRefs ? oldFromNewReferences[neighborIndex] : neighborIndex,
+        distance);
+  };
+
+  // Create the helper objects for the traversal.
+  typedef RangeSearchCallbackCollector<decltype(mappedCallback)> CollectorType;
+  typedef RangeSearchRules<MetricType, Tree, CollectorType> RuleType;
+  CollectorType collector(mappedCallback, referenceSet->n_cols,
+      maxNeighborsPerQuery);
+  RuleType rules(*referenceSet, *referenceSet, range, collector, metric,
+      true /* don't return the query in the results */);
+
+  if (naive)
+  {
+    // The naive brute-force solution.
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+        rules.BaseCase(i, j);
+
+    baseCases = (referenceSet->n_cols * referenceSet->n_cols);
+    scores = 0;
+    traversalStats = rules.TraversalStats();
+  }
+  else if (singleMode)
+  {
+    // Create the traverser.
+    SingleTreeTraversalType<RuleType> traverser(rules);
+
+    // Now have it traverse for each point.
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+    traversalStats = rules.TraversalStats();
+  }
+  else // Dual-tree recursion.
+  {
+    // Create the traverser.
+    DualTreeTraversalType<RuleType> traverser(rules);
+
+    traverser.Traverse(*referenceTree, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+    traversalStats = rules.TraversalStats();
+  }
+
+  Timer::Stop("range_search/computing_neighbors");
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
 template<typename Archive>
-void RangeSearch<MetricType, MatType, TreeType>::serialize(
+void RangeSearch<MetricType, MatType, TreeType, DualTreeTraversalType,
+    SingleTreeTraversalType>::serialize(
     Archive& ar, const uint32_t /* version */)
 {
   // Serialize preferences for search.
@@ -13,18 +13,139 @@
 #define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
 
 namespace mlpack {
 namespace range {
 
+/**
+ * A result collector for range search that accumulates every result into the
+ * standard vector-of-vectors output.  This is the default collector used by
+ * RangeSearchRules; see RangeSearchCallbackCollector for a collector that
+ * streams results instead of storing them.
+ */
+class RangeSearchVectorCollector
+{
+ public:
+  /**
+   * Construct the collector with the output objects to store results in.
+   *
+   * @param neighbors Vector to store resulting neighbors in.
+   * @param distances Vector to store resulting distances in.
+   */
+  RangeSearchVectorCollector(std::vector<std::vector<size_t> >& neighbors,
+                             std::vector<std::vector<double> >& distances) :
+      neighbors(neighbors),
+      distances(distances)
+  {
+    // Nothing to do.
+  }
+
+  //! Reserve space for numResults additional results for the given query.
+  void Reserve(const size_t queryIndex, const size_t numResults)
+  {
+    neighbors[queryIndex].reserve(neighbors[queryIndex].size() + numResults);
+    distances[queryIndex].reserve(distances[queryIndex].size() + numResults);
+  }
+
+  //! Store a single result for the given query point.
+  void Emit(const size_t queryIndex,
+            const size_t referenceIndex,
+            const double distance)
+  {
+    neighbors[queryIndex].push_back(referenceIndex);
+    distances[queryIndex].push_back(distance);
+  }
+
+  //! This collector never refuses results.
+  bool Full(const size_t /* queryIndex */) const { return false; }
+
+ private:
+  //! The vector the resultant neighbor indices should be stored in.
+  std::vector<std::vector<size_t> >& neighbors;
+  //! The vector the resultant neighbor distances should be stored in.
+  std::vector<std::vector<double> >& distances;
+};
+
+/**
+ * A result collector for range search that hands each result to a callback as
+ * soon as it is found, instead of accumulating results in memory.  For dense
+ * ranges this keeps the memory use of a search bounded, and downstream
+ * consumers (e.g. a radius join writing pairs to disk) can start processing
+ * results while the traversal is still running.
+ *
+ * Optionally, a per-query result cap may be given; once a query point has
+ * received that many results, further results for it are dropped (and, in
+ * single-tree traversals, the remaining reference tree is pruned for it).
+ * Note that with a cap the reported results are an arbitrary subset of the
+ * true result set, since results are emitted in traversal order.
+ *
+ * @tparam CallbackType Type of the callback; must be callable as
+ *      callback(queryIndex, referenceIndex, distance).
+ */
+template<typename CallbackType>
+class RangeSearchCallbackCollector
+{
+ public:
+  /**
+   * Construct the collector with the given callback.
+   *
+   * @param callback Callback to invoke for each result.
+   * @param numQueries Number of query points.
+   * @param maxPerQuery Maximum number of results to emit for any single query
+   *      point (0 means no cap).
+   */
+  RangeSearchCallbackCollector(CallbackType& callback,
+                               const size_t numQueries,
+                               const size_t maxPerQuery = 0) :
+      callback(callback),
+      maxPerQuery(maxPerQuery),
+      counts(maxPerQuery > 0 ? numQueries : 0, 0)
+  {
+    // Nothing to do.
+  }
+
+  //! Nothing to reserve; results are not stored.
+  void Reserve(const size_t /* queryIndex */, const size_t /* numResults */) { }
+
+  //! Pass a single result to the callback.
+  void Emit(const size_t queryIndex,
+            const size_t referenceIndex,
+            const double distance)
+  {
+    callback(queryIndex, referenceIndex, distance);
+    if (maxPerQuery > 0)
+      ++counts[queryIndex];
+  }
+
+  //! Return true if the given query point has reached the result cap.
+  bool Full(const size_t queryIndex) const
+  {
+    return (maxPerQuery > 0) && (counts[queryIndex] >= maxPerQuery);
+  }
+
+ private:
+  //! The callback each result is passed to.
+  CallbackType& callback;
+  //! The per-query result cap (0 means no cap).
+  size_t maxPerQuery;
+  //! The number of results emitted for each query (empty if there is no cap).
+  std::vector<size_t> counts;
+};
+
 /**
  * The RangeSearchRules class is a template helper class used by RangeSearch
  * class when performing range searches.
  *
  * @tparam MetricType The metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam CollectorType The result collector to use; either
+ *      RangeSearchVectorCollector (the default, which stores all results) or
+ *      RangeSearchCallbackCollector (which streams them).
  */
-template<typename MetricType, typename TreeType>
+template<typename MetricType,
+         typename TreeType,
+         typename CollectorType = RangeSearchVectorCollector>
 class RangeSearchRules
 {
  public:
@@ -49,6 +170,25 @@ class RangeSearchRules
                    MetricType& metric,
                    const bool sameSet = false);
 
+  /**
+   * Construct the RangeSearchRules object with an arbitrary result collector.
+   * This is used by the streaming overloads of RangeSearch::Search().
+   *
+   * @param referenceSet Set of reference data.
+   * @param querySet Set of query data.
+   * @param range Range to search for.
+   * @param collector Collector each result is handed to.
+   * @param metric Instantiated metric.
+   * @param sameSet If true, the query and reference set are taken to be the
+   *      same, and a query point will not return itself in the results.
+   */
+  RangeSearchRules(const arma::mat& referenceSet,
+                   const arma::mat& querySet,
+                   const math::Range& range,
+                   CollectorType collector,
+                   MetricType& metric,
+                   const bool sameSet = false);
+
   /**
    * Compute the base case between the given query point and reference point.
    *
@@ -113,9 +253,14 @@ class RangeSearchRules
   TraversalInfoType& TraversalInfo() { return traversalInfo; }
 
   //! Get the number of base cases.
-  size_t BaseCases() const { return baseCases; }
+  size_t BaseCases() const { return stats.BaseCases(); }
   //! Get the number of scores (that is, calls to RangeDistance()).
-  size_t Scores() const { return scores; }
+  size_t Scores() const { return stats.Scores(); }
+
+  //! Get the full set of traversal statistics.
+  const tree::TraversalStatistics& TraversalStats() const { return stats; }
+  //! Modify the full set of traversal statistics.
+  tree::TraversalStatistics& TraversalStats() { return stats; }
 
   //! Get the minimum number of base cases we need to perform to have acceptable
   //! results.
@@ -131,11 +276,8 @@ class RangeSearchRules
   //! The range of distances for which we are searching.
   const math::Range& range;
 
-  //! The vector the resultant neighbor indices should be stored in.
-  std::vector<std::vector<size_t> >& neighbors;
-
-  //! The vector the resultant neighbor distances should be stored in.
-  std::vector<std::vector<double> >& distances;
+  //! The collector that results are handed to.
+  CollectorType collector;
 
   //! The instantiated metric.
   MetricType& metric;
@@ -156,10 +298,8 @@ class RangeSearchRules
 
   TraversalInfoType traversalInfo;
 
-  //! The number of base cases.
-  size_t baseCases;
-  //! THe number of scores.
-  size_t scores;
+  //! Traversal counters (base cases, scores, prunes, result insertions).
+  tree::TraversalStatistics stats;
 };
 
 } // namespace range
@@ -293,7 +293,11 @@ Search(const MatType& querySet,
 
   if (naive)
   {
-    RuleType rules(*referenceSet, querySet, k, metric, tau, alpha, naive,
+    // Pass false for the naive parameter so that the rules do not resample
+    // the reference set for every query point in their constructor; the
+    // single set of samples drawn below is shared by all queries instead,
+    // which still gives each query numSamples uniform distinct samples.
+    RuleType rules(*referenceSet, querySet, k, metric, tau, alpha, false,
         sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
 
     // Find how many samples from the reference set we need and sample uniformly
@@ -305,10 +309,13 @@ Search(const MatType& querySet,
         distinctSamples);
 
     // Run the base case on each combination of query point and sampled
-    // reference point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
+    // reference point.  Each query point only touches its own candidate list
+    // and sample counter, so the queries can be processed in parallel against
+    // the shared sample buffer.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
       for (size_t j = 0; j < distinctSamples.n_elem; ++j)
-        rules.BaseCase(i, (size_t) distinctSamples[j]);
+        rules.BaseCase((size_t) i, (size_t) distinctSamples[j]);
 
     rules.GetResults(*neighborPtr, *distancePtr);
   }
@@ -323,12 +330,19 @@ Search(const MatType& querySet,
     {
       Log::Info << "Performing single-tree traversal..." << std::endl;
 
-      // Create the traverser.
-      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+      // The traversal for a query only writes to that query's candidate list
+      // and sample counter, and the reference tree itself is not modified, so
+      // each thread can traverse the shared tree for its own set of queries.
+      #pragma omp parallel
+      {
+        // Create the traverser.
+        typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+        // Now have it traverse for each point.
+        #pragma omp for schedule(dynamic)
+        for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+          traverser.Traverse((size_t) i, *referenceTree);
+      }
 
       Log::Info << "Single-tree traversal complete." << std::endl;
       Log::Info << "Average number of distance calculations per query point: "
@@ -519,7 +533,10 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::Search(
 
   // Create the helper object for the tree traversal.
   typedef RASearchRules<SortPolicy, MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, k, metric, tau, alpha, naive,
+  // Pass false for the naive parameter so that the rules do not resample the
+  // reference set for every query point in their constructor; in naive mode
+  // the set of samples drawn below is shared by all queries instead.
+  RuleType rules(*referenceSet, *referenceSet, k, metric, tau, alpha, false,
       sampleAtLeaves, firstLeafExact, singleSampleLimit, true /* same sets */);
 
   if (naive)
@@ -532,19 +549,28 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::Search(
     math::ObtainDistinctSamples(0, referenceSet->n_cols, numSamples,
         distinctSamples);
 
-    // The naive brute-force solution.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
+    // Run the base case on each combination of query point and sampled
+    // reference point; the candidate lists of different queries are disjoint,
+    // so the outer loop parallelizes cleanly.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) referenceSet->n_cols; ++i)
+      for (size_t j = 0; j < distinctSamples.n_elem; ++j)
+        rules.BaseCase((size_t) i, (size_t) distinctSamples[j]);
   }
   else if (singleMode)
   {
-    // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    // The traversal does not modify the reference tree and only writes to
+    // per-query state in the rules, so threads can share the tree.
+    #pragma omp parallel
+    {
+      // Create the traverser.
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+      // Now have it traverse for each point.
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) referenceSet->n_cols; ++i)
+        traverser.Traverse((size_t) i, *referenceTree);
+    }
   }
   else
   {
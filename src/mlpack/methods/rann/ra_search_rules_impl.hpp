@@ -135,6 +135,10 @@ double RASearchRules<SortPolicy, MetricType, TreeType>::BaseCase(
 
   numSamplesMade[queryIndex]++;
 
+  // Unlike the candidate lists and sample counts, which are per-query, this
+  // counter is shared between all queries, so it must be updated atomically
+  // when the query loop runs in parallel.
+  #pragma omp atomic
   numDistComputations++;
 
   return distance;
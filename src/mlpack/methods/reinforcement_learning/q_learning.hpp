@@ -110,6 +110,28 @@ class QLearning
    */
   double Episode();
 
+  /**
+   * Execute several episodes with environment stepping split from learning.
+   * All but one of the available threads act: each actor steps a private
+   * copy of the environment against a read-only snapshot of the policy
+   * network and pushes the observed transitions into a shared queue.  The
+   * remaining thread is the learner; it drains the queue into the replay
+   * method, performs the network updates, and swaps a fresh parameter
+   * snapshot in for the actors every PolicySnapshotInterval() updates.
+   *
+   * Unlike the async_learning module there are no per-worker optimizers,
+   * gradient buffers or target networks: all learning state lives on the
+   * single learner thread, and the actors only hold forward-pass copies of
+   * the snapshot parameters.
+   *
+   * If only one thread is available, the episodes are executed serially via
+   * Episode().
+   *
+   * @param numEpisodes Number of episodes to execute.
+   * @return Return of each episode, in order of completion.
+   */
+  arma::vec ParallelEpisodes(const size_t numEpisodes);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
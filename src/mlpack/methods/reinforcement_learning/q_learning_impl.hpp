@@ -14,6 +14,9 @@
 
 #include "q_learning.hpp"
 
+#include <queue>
+#include <tuple>
+
 namespace mlpack {
 namespace rl {
 
@@ -385,6 +388,199 @@ double QLearning<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+arma::vec QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::ParallelEpisodes(const size_t numEpisodes)
+{
+  arma::vec returns(numEpisodes, arma::fill::zeros);
+
+  /**
+   * Compute the number of threads for the for-loop, the same way the
+   * async_learning module does.
+   */
+  size_t numThreads = 0;
+  #pragma omp parallel reduction(+:numThreads)
+  numThreads++;
+
+  // The actor / learner split needs at least one thread for each side.
+  if (numThreads < 2)
+  {
+    Log::Warn << "QLearning::ParallelEpisodes(): only one thread is "
+        << "available, executing the episodes serially." << std::endl;
+    for (size_t i = 0; i < numEpisodes; ++i)
+      returns(i) = Episode();
+    return returns;
+  }
+
+  // One transition as observed by an actor.
+  typedef std::tuple<StateType, ActionType, double, StateType, bool>
+      TransitionType;
+
+  /**
+   * OpenMP doesn't support shared class member variables.
+   * So we need to copy them to local variables.
+   */
+  std::queue<TransitionType> transitionQueue;
+  arma::mat snapshotParameters = learningNetwork.Parameters();
+  size_t snapshotVersion = 0;
+  size_t episodesStarted = 0;
+  size_t episodesFinished = 0;
+  bool stop = false;
+
+  #pragma omp parallel for shared(transitionQueue, snapshotParameters, \
+      snapshotVersion, episodesStarted, episodesFinished, stop, returns)
+  for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+  {
+    if (t == 0)
+    {
+      // The learner: drain the transition queue into the replay method,
+      // update the network, and publish a fresh policy snapshot every
+      // PolicySnapshotInterval() updates.
+      size_t updates = 0;
+      bool done = false;
+      while (!stop)
+      {
+        std::queue<TransitionType> drained;
+        #pragma omp critical (qLearningTransitionQueue)
+        {
+          std::swap(drained, transitionQueue);
+        }
+
+        while (!drained.empty())
+        {
+          TransitionType& transition = drained.front();
+          replayMethod.Store(std::get<0>(transition),
+              std::get<1>(transition), std::get<2>(transition),
+              std::get<3>(transition), std::get<4>(transition),
+              config.Discount());
+          totalSteps++;
+          drained.pop();
+
+          if (deterministic || totalSteps < config.ExplorationSteps())
+            continue;
+
+          if (config.IsCategorical())
+            TrainCategoricalAgent();
+          else
+            TrainAgent();
+
+          if (++updates % config.PolicySnapshotInterval() == 0)
+          {
+            #pragma omp critical (qLearningSnapshot)
+            {
+              snapshotParameters = learningNetwork.Parameters();
+              ++snapshotVersion;
+            }
+          }
+        }
+
+        // Once all episodes have finished, every transition has already been
+        // pushed; one more drain pass above picks up the stragglers before
+        // the loop stops.
+        if (done)
+        {
+          stop = true;
+          continue;
+        }
+
+        #pragma omp critical (qLearningEpisodes)
+        {
+          if (episodesFinished >= numEpisodes)
+            done = true;
+        }
+      }
+    }
+    else
+    {
+      // An actor: step a private environment against the policy snapshot.
+      // The copied network is only ever used for forward passes; its
+      // parameters are refreshed whenever the learner publishes a new
+      // snapshot.
+      NetworkType actorNetwork = learningNetwork;
+      size_t actorVersion;
+      #pragma omp critical (qLearningSnapshot)
+      {
+        actorNetwork.Parameters() = snapshotParameters;
+        actorVersion = snapshotVersion;
+      }
+
+      EnvironmentType actorEnvironment = environment;
+      StateType actorState;
+      double actorReturn = 0.0;
+      size_t episodeIndex = std::numeric_limits<size_t>::max();
+
+      while (!stop)
+      {
+        // Claim the next unstarted episode, if there is one left.
+        if (episodeIndex == std::numeric_limits<size_t>::max())
+        {
+          #pragma omp critical (qLearningEpisodes)
+          {
+            if (episodesStarted < numEpisodes)
+              episodeIndex = episodesStarted++;
+          }
+          if (episodeIndex == std::numeric_limits<size_t>::max())
+            break;
+
+          actorState = actorEnvironment.InitialSample();
+          actorReturn = 0.0;
+        }
+
+        // Pick up the latest policy snapshot, if it changed.
+        #pragma omp critical (qLearningSnapshot)
+        {
+          if (actorVersion != snapshotVersion)
+          {
+            actorNetwork.Parameters() = snapshotParameters;
+            actorVersion = snapshotVersion;
+          }
+        }
+
+        arma::colvec actionValue;
+        actorNetwork.Predict(actorState.Encode(), actionValue);
+        ActionType actorAction = policy.Sample(actionValue, deterministic,
+            config.NoisyQLearning());
+
+        StateType nextState;
+        const double reward = actorEnvironment.Sample(actorState,
+            actorAction, nextState);
+        actorReturn += reward;
+        const bool terminal = actorEnvironment.IsTerminal(nextState);
+
+        #pragma omp critical (qLearningTransitionQueue)
+        {
+          transitionQueue.push(TransitionType(actorState, actorAction,
+              reward, nextState, terminal));
+        }
+
+        actorState = nextState;
+        if (terminal)
+        {
+          #pragma omp critical (qLearningEpisodes)
+          {
+            returns(episodeIndex) = actorReturn;
+            ++episodesFinished;
+          }
+          episodeIndex = std::numeric_limits<size_t>::max();
+        }
+      }
+    }
+  }
+
+  return returns;
+}
+
 } // namespace rl
 } // namespace mlpack
 
@@ -197,14 +197,15 @@ class PrioritizedReplay
    */
   arma::ucolvec SampleProportional()
   {
-    arma::ucolvec idxes(batchSize);
+    arma::ucolvec idxes;
     double totalSum = idxSum.Sum(0, (full ? capacity : position));
     double sumPerRange = totalSum / batchSize;
-    for (size_t bt = 0; bt < batchSize; bt++)
-    {
-      const double mass = arma::randu() * sumPerRange + bt * sumPerRange;
-      idxes(bt) = idxSum.FindPrefixSum(mass);
-    }
+
+    // Draw all masses up front and descend the tree once for the whole
+    // batch instead of once per sample.
+    arma::colvec masses = (arma::randu<arma::colvec>(batchSize) +
+        arma::regspace<arma::colvec>(0, batchSize - 1)) * sumPerRange;
+    idxSum.FindPrefixSumBatch(masses, idxes);
     return idxes;
   }
 
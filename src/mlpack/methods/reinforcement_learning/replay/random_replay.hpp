@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_RL_REPLAY_RANDOM_REPLAY_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
 #include <cassert>
 
 namespace mlpack {
@@ -39,8 +40,11 @@ namespace rl {
  * @endcode
  *
  * @tparam EnvironmentType Desired task.
+ * @tparam StateStorageType Matrix type used to store the encoded states.
+ *         Passing arma::fmat halves the replay memory by keeping the states
+ *         in single precision; they are converted back on sampling.
  */
-template <typename EnvironmentType>
+template <typename EnvironmentType, typename StateStorageType = arma::mat>
 class RandomReplay
 {
  public:
@@ -127,10 +131,12 @@ class RandomReplay
     state = nStepBuffer.front().state;
     action = nStepBuffer.front().action;
 
-    states.col(position) = state.Encode();
+    states.col(position) = arma::conv_to<arma::Col<
+        typename StateStorageType::elem_type>>::from(state.Encode());
     actions[position] = action;
     rewards(position) = reward;
-    nextStates.col(position) = nextState.Encode();
+    nextStates.col(position) = arma::conv_to<arma::Col<
+        typename StateStorageType::elem_type>>::from(nextState.Encode());
     isTerminal(position) = isEnd;
     position++;
     if (position == capacity)
@@ -187,15 +193,40 @@ class RandomReplay
               arma::irowvec& isTerminal)
   {
     size_t upperBound = full ? capacity : position;
-    arma::uvec sampledIndices = arma::randi<arma::uvec>(
-        batchSize, arma::distr_param(0, upperBound - 1));
-
-    sampledStates = states.cols(sampledIndices);
-    for (size_t t = 0; t < sampledIndices.n_rows; t ++)
-      sampledActions.push_back(actions[sampledIndices[t]]);
-    sampledRewards = rewards.elem(sampledIndices).t();
-    sampledNextStates = nextStates.cols(sampledIndices);
-    isTerminal = this->isTerminal.elem(sampledIndices).t();
+
+    // Reuse the index buffer between draws, and gather the sampled columns
+    // straight into the output matrices -- Mat::cols() and elem() would
+    // materialize an intermediate matrix per draw, which costs more than the
+    // gather itself for typical batch sizes.
+    if (sampledIndices.n_elem != batchSize)
+      sampledIndices.set_size(batchSize);
+    for (size_t t = 0; t < batchSize; ++t)
+      sampledIndices[t] = math::RandInt(upperBound);
+
+    sampledStates.set_size(states.n_rows, batchSize);
+    sampledNextStates.set_size(nextStates.n_rows, batchSize);
+    sampledRewards.set_size(batchSize);
+    isTerminal.set_size(batchSize);
+    sampledActions.reserve(sampledActions.size() + batchSize);
+    for (size_t t = 0; t < batchSize; ++t)
+    {
+      const size_t index = sampledIndices[t];
+
+      const typename StateStorageType::elem_type* state = states.colptr(index);
+      const typename StateStorageType::elem_type* nextState =
+          nextStates.colptr(index);
+      double* sampledState = sampledStates.colptr(t);
+      double* sampledNextState = sampledNextStates.colptr(t);
+      for (size_t j = 0; j < states.n_rows; ++j)
+      {
+        sampledState[j] = (double) state[j];
+        sampledNextState[j] = (double) nextState[j];
+      }
+
+      sampledActions.push_back(actions[index]);
+      sampledRewards[t] = rewards[index];
+      isTerminal[t] = this->isTerminal[index];
+    }
   }
 
   /**
@@ -247,7 +278,7 @@ class RandomReplay
   std::deque<Transition> nStepBuffer;
 
   //! Locally-stored encoded previous states.
-  arma::mat states;
+  StateStorageType states;
 
   //! Locally-stored previous actions.
   std::vector<ActionType> actions;
@@ -256,7 +287,10 @@ class RandomReplay
   arma::rowvec rewards;
 
   //! Locally-stored encoded previous next states.
-  arma::mat nextStates;
+  StateStorageType nextStates;
+
+  //! Reused buffer of sampled indices.
+  arma::uvec sampledIndices;
 
   //! Locally-stored termination information of previous experience.
   arma::irowvec isTerminal;
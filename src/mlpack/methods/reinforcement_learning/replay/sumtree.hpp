@@ -74,14 +74,34 @@ class SumTree
    */
   void BatchUpdate(const arma::ucolvec& indices, const arma::Col<T>& data)
   {
+    if (indices.n_rows == 0)
+      return;
+
     for (size_t i = 0; i < indices.n_rows; ++i)
     {
       element[indices[i] + capacity] = data[i];
     }
-    // update the total tree with bottom-up technique.
-    for (size_t i = capacity - 1; i > 0; i--)
+
+    // Propagate only the modified paths upwards, one level at a time.  All
+    // leaves sit on the same level, so every round holds nodes of a single
+    // level; deduplicating them recomputes shared ancestors only once, which
+    // costs O(batch log capacity) instead of rebuilding the whole tree.
+    std::vector<size_t> nodes(indices.n_rows);
+    for (size_t i = 0; i < indices.n_rows; ++i)
+      nodes[i] = (indices[i] + capacity) / 2;
+
+    while (true)
     {
-      element[i] = element[2 * i] + element[2 * i + 1];
+      std::sort(nodes.begin(), nodes.end());
+      nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+      for (size_t i = 0; i < nodes.size(); ++i)
+        element[nodes[i]] = element[2 * nodes[i]] + element[2 * nodes[i] + 1];
+
+      if (nodes.front() == 1)
+        break;
+      for (size_t i = 0; i < nodes.size(); ++i)
+        nodes[i] /= 2;
     }
   }
 
@@ -178,6 +198,40 @@ class SumTree
     return idx - capacity;
   }
 
+  /**
+   * Batched version of FindPrefixSum(): find for every given mass the
+   * highest index `idx` such that
+   * sum(arr[0] + arr[1] + ... + arr[idx]) <= mass.
+   *
+   * The whole batch descends the tree one level at a time, so the upper
+   * levels stay cache-resident across the batch, and the child selection is
+   * a branch-free index update.
+   *
+   * @param masses The upper bounds of segment array sums.
+   * @param indices The found index for each mass.
+   */
+  void FindPrefixSumBatch(const arma::Col<T>& masses, arma::ucolvec& indices)
+  {
+    arma::Col<T> remaining(masses);
+    indices.set_size(masses.n_elem);
+    indices.fill(1);
+
+    size_t node = 1;
+    while (node < capacity)
+    {
+      for (size_t i = 0; i < remaining.n_elem; ++i)
+      {
+        const size_t left = 2 * indices[i];
+        const size_t goRight = (element[left] <= remaining[i]);
+        remaining[i] -= goRight * element[left];
+        indices[i] = left + goRight;
+      }
+      node *= 2;
+    }
+
+    indices -= capacity;
+  }
+
  private:
   //! The capacity of the data array.
   size_t capacity;
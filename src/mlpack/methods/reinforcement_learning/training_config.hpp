@@ -34,7 +34,8 @@ class TrainingConfig
       atomSize(51),
       vMin(0),
       vMax(200),
-      rho(0.005)
+      rho(0.005),
+      policySnapshotInterval(10)
   { /* Nothing to do here. */ }
 
   TrainingConfig(
@@ -67,7 +68,8 @@ class TrainingConfig
       atomSize(atomSize),
       vMin(vMin),
       vMax(vMax),
-      rho(rho)
+      rho(rho),
+      policySnapshotInterval(10)
   { /* Nothing to do here. */ }
 
   //! Get the amount of workers.
@@ -149,6 +151,11 @@ class TrainingConfig
   //! Modify the rho value for sac.
   double& Rho() { return rho; }
 
+  //! Get the number of learner updates between policy snapshot swaps.
+  size_t PolicySnapshotInterval() const { return policySnapshotInterval; }
+  //! Modify the number of learner updates between policy snapshot swaps.
+  size_t& PolicySnapshotInterval() { return policySnapshotInterval; }
+
  private:
   /**
    * Locally-stored number of workers.
@@ -242,6 +249,13 @@ class TrainingConfig
    * This is valid only for Soft Actor-Critic.
    */
   double rho;
+
+  /**
+   * Locally-stored number of learner updates between two swaps of the policy
+   * snapshot that the actor threads act against.
+   * This is valid only for the parallel q-learning agent.
+   */
+  size_t policySnapshotInterval;
 };
 
 } // namespace rl
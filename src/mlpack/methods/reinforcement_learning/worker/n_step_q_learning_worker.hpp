@@ -60,7 +60,8 @@ class NStepQLearningWorker
       environment(environment),
       config(config),
       deterministic(deterministic),
-      pending(config.UpdateInterval())
+      pending(config.UpdateInterval()),
+      targetVersion(0)
   { Reset(); }
 
   /**
@@ -81,7 +82,9 @@ class NStepQLearningWorker
       pending(other.pending),
       pendingIndex(other.pendingIndex),
       network(other.network),
-      state(other.state)
+      state(other.state),
+      targetSnapshot(other.targetSnapshot),
+      targetVersion(other.targetVersion)
   {
     #if ENS_VERSION_MAJOR >= 2
     updatePolicy = new typename UpdaterType::template
@@ -111,7 +114,9 @@ class NStepQLearningWorker
       pending(std::move(other.pending)),
       pendingIndex(std::move(other.pendingIndex)),
       network(std::move(other.network)),
-      state(std::move(other.state))
+      state(std::move(other.state)),
+      targetSnapshot(std::move(other.targetSnapshot)),
+      targetVersion(std::move(other.targetVersion))
   {
     #if ENS_VERSION_MAJOR >= 2
     other.updatePolicy = NULL;
@@ -147,6 +152,8 @@ class NStepQLearningWorker
     pendingIndex = other.pendingIndex;
     network = other.network;
     state = other.state;
+    targetSnapshot = other.targetSnapshot;
+    targetVersion = other.targetVersion;
 
     #if ENS_VERSION_MAJOR >= 2
     updatePolicy = new typename UpdaterType::template
@@ -184,6 +191,8 @@ class NStepQLearningWorker
     pendingIndex = std::move(other.pendingIndex);
     network = std::move(other.network);
     state = std::move(other.state);
+    targetSnapshot = std::move(other.targetSnapshot);
+    targetVersion = std::move(other.targetVersion);
 
     #if ENS_VERSION_MAJOR >= 2
     updatePolicy = new typename UpdaterType::template
@@ -227,6 +236,7 @@ class NStepQLearningWorker
 
     // Build local network.
     network = learningNetwork;
+    targetVersion = 0;
   }
 
   /**
@@ -289,8 +299,20 @@ class NStepQLearningWorker
       double target = 0;
       if (!terminal)
       {
-        #pragma omp critical
-        { targetNetwork.Predict(nextState.Encode(), actionValue); };
+        // Refresh the local target network snapshot if the shared target
+        // network may have changed, then bootstrap from the snapshot
+        // without holding any lock.  The snapshot is at most one sync
+        // interval stale, which asynchronous methods tolerate by design.
+        const size_t targetEpoch =
+            totalSteps / config.TargetNetworkSyncInterval() + 1;
+        if (targetVersion != targetEpoch)
+        {
+          #pragma omp critical
+          { targetSnapshot = targetNetwork; }
+          targetVersion = targetEpoch;
+        }
+
+        targetSnapshot.Predict(nextState.Encode(), actionValue);
         target = actionValue.max();
       }
 
@@ -397,6 +419,13 @@ class NStepQLearningWorker
 
   //! Current state of the agent.
   StateType state;
+
+  //! Local snapshot of the shared target network, used for lock-free
+  //! target value computation.
+  NetworkType targetSnapshot;
+
+  //! Version of the shared target network the snapshot was taken at.
+  size_t targetVersion;
 };
 
 } // namespace rl
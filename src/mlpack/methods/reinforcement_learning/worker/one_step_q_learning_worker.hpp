@@ -60,7 +60,8 @@ class OneStepQLearningWorker
       environment(environment),
       config(config),
       deterministic(deterministic),
-      pending(config.UpdateInterval())
+      pending(config.UpdateInterval()),
+      targetVersion(0)
   { Reset(); }
 
   /**
@@ -81,7 +82,9 @@ class OneStepQLearningWorker
       pending(other.pending),
       pendingIndex(other.pendingIndex),
       network(other.network),
-      state(other.state)
+      state(other.state),
+      targetSnapshot(other.targetSnapshot),
+      targetVersion(other.targetVersion)
   {
     #if ENS_VERSION_MAJOR >= 2
     updatePolicy = new typename UpdaterType::template
@@ -111,7 +114,9 @@ class OneStepQLearningWorker
       pending(std::move(other.pending)),
       pendingIndex(std::move(other.pendingIndex)),
       network(std::move(other.network)),
-      state(std::move(other.state))
+      state(std::move(other.state)),
+      targetSnapshot(std::move(other.targetSnapshot)),
+      targetVersion(std::move(other.targetVersion))
   {
     #if ENS_VERSION_MAJOR >= 2
     other.updatePolicy = NULL;
@@ -147,6 +152,8 @@ class OneStepQLearningWorker
     pendingIndex = other.pendingIndex;
     network = other.network;
     state = other.state;
+    targetSnapshot = other.targetSnapshot;
+    targetVersion = other.targetVersion;
 
     #if ENS_VERSION_MAJOR >= 2
     updatePolicy = new typename UpdaterType::template
@@ -184,6 +191,8 @@ class OneStepQLearningWorker
     pendingIndex = std::move(other.pendingIndex);
     network = std::move(other.network);
     state = std::move(other.state);
+    targetSnapshot = std::move(other.targetSnapshot);
+    targetVersion = std::move(other.targetVersion);
 
     #if ENS_VERSION_MAJOR >= 2
     other.updatePolicy = NULL;
@@ -227,6 +236,7 @@ class OneStepQLearningWorker
 
     // Build local network.
     network = learningNetwork;
+    targetVersion = 0;
   }
 
   /**
@@ -280,6 +290,20 @@ class OneStepQLearningWorker
 
     if (terminal || pendingIndex >= config.UpdateInterval())
     {
+      // Refresh the local target network snapshot if the shared target
+      // network may have changed since the last refresh.  The snapshot lets
+      // the per-transition loop below run without any synchronization;
+      // workers see a target that is at most one sync interval stale, which
+      // asynchronous methods tolerate by design.
+      const size_t targetEpoch =
+          totalSteps / config.TargetNetworkSyncInterval() + 1;
+      if (targetVersion != targetEpoch)
+      {
+        #pragma omp critical
+        { targetSnapshot = targetNetwork; }
+        targetVersion = targetEpoch;
+      }
+
       // Initialize the gradient storage.
       arma::mat totalGradients(learningNetwork.Parameters().n_rows,
           learningNetwork.Parameters().n_cols, arma::fill::zeros);
@@ -289,11 +313,7 @@ class OneStepQLearningWorker
 
         // Compute the target state-action value.
         arma::colvec actionValue;
-        #pragma omp critical
-        {
-          targetNetwork.Predict(
-              std::get<3>(transition).Encode(), actionValue);
-        };
+        targetSnapshot.Predict(std::get<3>(transition).Encode(), actionValue);
         double targetActionValue = actionValue.max();
         if (terminal && i == pending.size() - 1)
           targetActionValue = 0;
@@ -397,6 +417,13 @@ class OneStepQLearningWorker
 
   //! Current state of the agent.
   StateType state;
+
+  //! Local snapshot of the shared target network, used for lock-free
+  //! target value computation.
+  NetworkType targetSnapshot;
+
+  //! Version of the shared target network the snapshot was taken at.
+  size_t targetVersion;
 };
 
 } // namespace rl
@@ -61,7 +61,8 @@ class OneStepSarsaWorker
       environment(environment),
       config(config),
       deterministic(deterministic),
-      pending(config.UpdateInterval())
+      pending(config.UpdateInterval()),
+      targetVersion(0)
   { Reset(); }
 
   /**
@@ -83,7 +84,9 @@ class OneStepSarsaWorker
       pendingIndex(other.pendingIndex),
       network(other.network),
       state(other.state),
-      action(other.action)
+      action(other.action),
+      targetSnapshot(other.targetSnapshot),
+      targetVersion(other.targetVersion)
   {
     Reset();
 
@@ -114,7 +117,9 @@ class OneStepSarsaWorker
       pendingIndex(std::move(other.pendingIndex)),
       network(std::move(other.network)),
       state(std::move(other.state)),
-      action(std::move(other.action))
+      action(std::move(other.action)),
+      targetSnapshot(std::move(other.targetSnapshot)),
+      targetVersion(std::move(other.targetVersion))
   {
     #if ENS_VERSION_MAJOR >= 2
     other.updatePolicy = NULL;
@@ -151,6 +156,8 @@ class OneStepSarsaWorker
     network = other.network;
     state = other.state;
     action = other.action;
+    targetSnapshot = other.targetSnapshot;
+    targetVersion = other.targetVersion;
 
     #if ENS_VERSION_MAJOR >= 2
     updatePolicy = new typename UpdaterType::template
@@ -189,6 +196,8 @@ class OneStepSarsaWorker
     network = std::move(other.network);
     state = std::move(other.state);
     action = std::move(other.action);
+    targetSnapshot = std::move(other.targetSnapshot);
+    targetVersion = std::move(other.targetVersion);
 
     #if ENS_VERSION_MAJOR >= 2
     other.updatePolicy = NULL;
@@ -232,6 +241,7 @@ class OneStepSarsaWorker
 
     // Build local network.
     network = learningNetwork;
+    targetVersion = 0;
   }
 
   /**
@@ -293,6 +303,19 @@ class OneStepSarsaWorker
 
     if (terminal || pendingIndex >= config.UpdateInterval())
     {
+      // Take a fresh snapshot of the shared target network if it may have
+      // changed, so the loop below can evaluate targets without locking.
+      // The snapshot is at most one sync interval stale, which asynchronous
+      // methods tolerate by design.
+      const size_t targetEpoch =
+          totalSteps / config.TargetNetworkSyncInterval() + 1;
+      if (targetVersion != targetEpoch)
+      {
+        #pragma omp critical
+        { targetSnapshot = targetNetwork; }
+        targetVersion = targetEpoch;
+      }
+
       // Initialize the gradient storage.
       arma::mat totalGradients(learningNetwork.Parameters().n_rows,
           learningNetwork.Parameters().n_cols, arma::fill::zeros);
@@ -302,11 +325,7 @@ class OneStepSarsaWorker
 
         // Compute the target state-action value.
         arma::colvec actionValue;
-        #pragma omp critical
-        {
-          targetNetwork.Predict(
-              std::get<3>(transition).Encode(), actionValue);
-        };
+        targetSnapshot.Predict(std::get<3>(transition).Encode(), actionValue);
         double targetActionValue = 0;
         if (!(terminal && i == pending.size() - 1))
           targetActionValue = actionValue[std::get<4>(transition).action];
@@ -416,6 +435,13 @@ class OneStepSarsaWorker
 
   //! Current action of the agent.
   ActionType action;
+
+  //! Local snapshot of the shared target network, used for lock-free
+  //! target value computation.
+  NetworkType targetSnapshot;
+
+  //! Version of the shared target network the snapshot was taken at.
+  size_t targetVersion;
 };
 
 } // namespace rl
@@ -78,6 +78,7 @@ class SoftmaxRegression
    * function. By default, the model takes a small value.
    *
    * @tparam OptimizerType Desired optimizer type.
+   * @tparam MatType Type of the data matrix (arma::mat or arma::sp_mat).
    * @param data Input training features. Each column associate with one sample
    * @param labels Labels associated with the feature data.
    * @param numClasses Number of classes for classification.
@@ -85,8 +86,8 @@ class SoftmaxRegression
    * @param lambda L2-regularization constant.
    * @param fitIntercept add intercept term or not.
    */
-  template<typename OptimizerType = ens::L_BFGS>
-  SoftmaxRegression(const arma::mat& data,
+  template<typename OptimizerType = ens::L_BFGS, typename MatType = arma::mat>
+  SoftmaxRegression(const MatType& data,
                     const arma::Row<size_t>& labels,
                     const size_t numClasses,
                     const double lambda = 0.0001,
@@ -99,6 +100,7 @@ class SoftmaxRegression
    * function. By default, the model takes a small value.
    *
    * @tparam OptimizerType Desired optimizer type.
+   * @tparam MatType Type of the data matrix (arma::mat or arma::sp_mat).
    * @tparam CallbackTypes Types of Callback Functions.
    * @param data Input training features. Each column associate with one sample
    * @param labels Labels associated with the feature data.
@@ -109,8 +111,8 @@ class SoftmaxRegression
    * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
    *        See https://www.ensmallen.org/docs.html#callback-documentation.
    */
-  template<typename OptimizerType, typename... CallbackTypes>
-  SoftmaxRegression(const arma::mat& data,
+  template<typename OptimizerType, typename MatType, typename... CallbackTypes>
+  SoftmaxRegression(const MatType& data,
                     const arma::Row<size_t>& labels,
                     const size_t numClasses,
                     const double lambda,
@@ -171,24 +173,32 @@ class SoftmaxRegression
   double ComputeAccuracy(const arma::mat& testData,
                          const arma::Row<size_t>& labels) const;
   /**
-   * Train the softmax regression with the given training data.
+   * Train the softmax regression with the given training data.  If the model
+   * has already been trained on data with the same dimensionality and number
+   * of classes, optimization continues from the current parameters (a warm
+   * start), so periodic retraining on new batches of data is cheap.
    *
    * @tparam OptimizerType Desired optimizer type.
+   * @tparam MatType Type of the data matrix (arma::mat or arma::sp_mat).
    * @param data Input data with each column as one example.
    * @param labels Labels associated with the feature data.
    * @param numClasses Number of classes for classification.
    * @param optimizer Desired optimizer.
    * @return Objective value of the final point.
    */
-  template<typename OptimizerType = ens::L_BFGS>
-  double Train(const arma::mat& data,
+  template<typename OptimizerType = ens::L_BFGS, typename MatType = arma::mat>
+  double Train(const MatType& data,
                const arma::Row<size_t>& labels,
                const size_t numClasses,
                OptimizerType optimizer = OptimizerType());
   /**
-   * Train the softmax regression with the given training data.
+   * Train the softmax regression with the given training data.  If the model
+   * has already been trained on data with the same dimensionality and number
+   * of classes, optimization continues from the current parameters (a warm
+   * start), so periodic retraining on new batches of data is cheap.
    *
    * @tparam OptimizerType Desired optimizer type.
+   * @tparam MatType Type of the data matrix (arma::mat or arma::sp_mat).
    * @tparam CallbackTypes Types of Callback Functions.
    * @param data Input data with each column as one example.
    * @param labels Labels associated with the feature data.
@@ -198,13 +208,63 @@ class SoftmaxRegression
    *      See https://www.ensmallen.org/docs.html#callback-documentation.
    * @return Objective value of the final point.
    */
-  template<typename OptimizerType = ens::L_BFGS, typename... CallbackTypes>
-  double Train(const arma::mat& data,
+  template<typename OptimizerType = ens::L_BFGS,
+           typename MatType,
+           typename... CallbackTypes>
+  double Train(const MatType& data,
                const arma::Row<size_t>& labels,
                const size_t numClasses,
                OptimizerType optimizer,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the softmax regression with the given training data and per-instance
+   * weights.  A point with weight w contributes to the objective and gradient
+   * exactly like w copies of that point, so importance can be expressed
+   * without physically replicating columns of the dataset.
+   *
+   * @tparam OptimizerType Desired optimizer type.
+   * @tparam MatType Type of the data matrix (arma::mat or arma::sp_mat).
+   * @param data Input data with each column as one example.
+   * @param labels Labels associated with the feature data.
+   * @param numClasses Number of classes for classification.
+   * @param weights Instance weight of each point.
+   * @param optimizer Desired optimizer.
+   * @return Objective value of the final point.
+   */
+  template<typename OptimizerType = ens::L_BFGS, typename MatType = arma::mat>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const arma::rowvec& weights,
+               OptimizerType optimizer = OptimizerType());
+
+  /**
+   * Train the softmax regression with the given training data and per-instance
+   * weights, passing the given callbacks to the optimizer.
+   *
+   * @tparam OptimizerType Desired optimizer type.
+   * @tparam MatType Type of the data matrix (arma::mat or arma::sp_mat).
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param data Input data with each column as one example.
+   * @param labels Labels associated with the feature data.
+   * @param numClasses Number of classes for classification.
+   * @param weights Instance weight of each point.
+   * @param optimizer Desired optimizer.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return Objective value of the final point.
+   */
+  template<typename OptimizerType = ens::L_BFGS,
+           typename MatType,
+           typename... CallbackTypes>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const arma::rowvec& weights,
+               OptimizerType optimizer,
+               CallbackTypes&&... callbacks);
+
   //! Sets the number of classes.
   size_t& NumClasses() { return numClasses; }
   //! Gets the number of classes.
@@ -18,6 +18,14 @@
 namespace mlpack {
 namespace regression {
 
+/**
+ * The objective function for softmax regression.  This is templated on the
+ * type of the data matrix, so that sparse datasets can be trained on directly
+ * (with MatType = arma::sp_mat) without densification.
+ *
+ * @tparam MatType Type of the data matrix (arma::mat or arma::sp_mat).
+ */
+template<typename MatType = arma::mat>
 class SoftmaxRegressionFunction
 {
  public:
@@ -31,9 +39,29 @@ class SoftmaxRegressionFunction
    * @param lambda L2-regularization constant.
    * @param fitIntercept Intercept term flag.
    */
-  SoftmaxRegressionFunction(const arma::mat& data,
+  SoftmaxRegressionFunction(const MatType& data,
+                            const arma::Row<size_t>& labels,
+                            const size_t numClasses,
+                            const double lambda = 0.0001,
+                            const bool fitIntercept = false);
+
+  /**
+   * Construct the Softmax Regression objective function with per-instance
+   * weights.  A point with weight w contributes to the objective and gradient
+   * exactly like w copies of that point; the regularization term is not
+   * affected by the weights.
+   *
+   * @param data Input training data, each column associate with one sample
+   * @param labels Labels associated with the feature data.
+   * @param numClasses Number of classes for classification.
+   * @param weights Instance weight of each point.
+   * @param lambda L2-regularization constant.
+   * @param fitIntercept Intercept term flag.
+   */
+  SoftmaxRegressionFunction(const MatType& data,
                             const arma::Row<size_t>& labels,
                             const size_t numClasses,
+                            const arma::rowvec& weights,
                             const double lambda = 0.0001,
                             const bool fitIntercept = false);
 
@@ -187,11 +215,18 @@ class SoftmaxRegressionFunction
   //! Gets the intercept flag.
   bool FitIntercept() const { return fitIntercept; }
 
+  //! Return the vector of instance weights.
+  const arma::rowvec& Weights() const { return weights; }
+
  private:
   //! Training data matrix.  This is an alias until the data is shuffled.
-  arma::mat data;
+  MatType data;
   //! Label matrix for the provided data.
   arma::sp_mat groundTruth;
+  //! The instance weight of each point (all ones when unweighted).
+  arma::rowvec weights;
+  //! The sum of all instance weights (the effective number of points).
+  double totalWeight;
   //! Initial parameter point.
   arma::mat initialPoint;
   //! Number of classes.
@@ -205,4 +240,7 @@ class SoftmaxRegressionFunction
 } // namespace regression
 } // namespace mlpack
 
+// Include implementation.
+#include "softmax_regression_function_impl.hpp"
+
 #endif
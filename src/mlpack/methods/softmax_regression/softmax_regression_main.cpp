@@ -55,10 +55,12 @@ BINDING_LONG_DESC(
     "The trained model can be saved with the " +
     PRINT_PARAM_STRING("output_model") + " output parameter. If training is not"
     " desired, but only testing is, a model can be loaded with the " +
-    PRINT_PARAM_STRING("input_model") + " parameter.  At the current time, a "
-    "loaded model cannot be trained further, so specifying both " +
+    PRINT_PARAM_STRING("input_model") + " parameter.  If both " +
     PRINT_PARAM_STRING("input_model") + " and " +
-    PRINT_PARAM_STRING("training") + " is not allowed."
+    PRINT_PARAM_STRING("training") + " are given, optimization continues from "
+    "the parameters of the loaded model (a warm start), which makes periodic "
+    "retraining on new batches of data much cheaper than training from "
+    "scratch."
     "\n\n"
     "The program is also able to evaluate a model on test data.  A test dataset"
     " can be specified with the " + PRINT_PARAM_STRING("test") + " parameter. "
@@ -142,8 +144,9 @@ static void mlpackMain()
 {
   const int maxIterations = IO::GetParam<int>("max_iterations");
 
-  // One of inputFile and modelFile must be specified.
-  RequireOnlyOnePassed({ "input_model", "training" }, true);
+  // One of inputFile and modelFile must be specified.  If both are given, the
+  // loaded model is used as a warm start for further training.
+  RequireAtLeastOnePassed({ "input_model", "training" }, true);
   if (IO::HasParam("training"))
   {
     RequireAtLeastOnePassed({ "labels" }, true, "if training data is specified,"
@@ -259,10 +262,11 @@ Model* TrainSoftmax(const size_t maxIterations)
 
   Model* sm;
   if (IO::HasParam("input_model"))
-  {
     sm = IO::GetParam<Model*>("input_model");
-  }
   else
+    sm = new Model(0, 0);
+
+  if (IO::HasParam("training"))
   {
     arma::mat trainData = std::move(IO::GetParam<arma::mat>("training"));
     arma::Row<size_t> trainLabels =
@@ -277,10 +281,19 @@ Model* TrainSoftmax(const size_t maxIterations)
 
     const bool intercept = IO::HasParam("no_intercept") ? false : true;
 
+    if (!IO::HasParam("input_model"))
+    {
+      // Build an untrained model with the right settings; Train() will
+      // initialize the parameters.
+      delete sm;
+      sm = new Model(trainData.n_rows, numClasses, intercept);
+    }
+    sm->Lambda() = IO::GetParam<double>("lambda");
+
+    // If a model was loaded, training continues from its parameters.
     const size_t numBasis = 5;
     ens::L_BFGS optimizer(numBasis, maxIterations);
-    sm = new Model(trainData, trainLabels, numClasses,
-        IO::GetParam<double>("lambda"), intercept, std::move(optimizer));
+    sm->Train(trainData, trainLabels, numClasses, std::move(optimizer));
   }
   return sm;
 }
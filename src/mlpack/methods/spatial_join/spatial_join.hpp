@@ -0,0 +1,139 @@
+/**
+ * @file methods/spatial_join/spatial_join.hpp
+ *
+ * Defines the SpatialJoin class, which computes all pairs of points from two
+ * datasets that lie within a given distance of each other, using a
+ * synchronized dual-tree descent over two rectangle trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_SPATIAL_JOIN_SPATIAL_JOIN_HPP
+#define MLPACK_METHODS_SPATIAL_JOIN_SPATIAL_JOIN_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/tree/rectangle_tree.hpp>
+#include <mlpack/core/tree/statistic.hpp>
+
+namespace mlpack {
+namespace spatial /** Spatial join routines. */ {
+
+/**
+ * The SpatialJoin class computes the distance join of two point sets: every
+ * pair of points (one from each set) whose distance is at most a given
+ * threshold.  This is the point-set analogue of the spatial join of two
+ * collections of geometries, and a threshold of zero reports exactly the
+ * coincident pairs.
+ *
+ * The join is computed with a synchronized descent over two rectangle trees,
+ * one per set: a pair of nodes is pruned as soon as the minimum distance
+ * between their bounds exceeds the threshold, and the surviving leaf pairs
+ * are then scanned pairwise (in parallel, if OpenMP is enabled).  This
+ * avoids the quadratic pair enumeration that a nested-loop join would
+ * perform, while a block-nested fallback (see Naive()) remains available for
+ * inputs so small that building the trees would not pay off.
+ *
+ * Each matching pair is reported exactly once, since the leaves of a
+ * rectangle tree partition the points of the set it is built on.
+ *
+ * @tparam MetricType The metric to join with; must be an LMetric, since the
+ *     rectangle tree bounds require one.
+ * @tparam MatType The type of data matrix.
+ * @tparam TreeType The rectangle tree variant to build (e.g. tree::RTree or
+ *     tree::RStarTree).
+ */
+template<typename MetricType = metric::EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = tree::RStarTree>
+class SpatialJoin
+{
+ public:
+  //! Convenience typedef for the tree type that the join is computed with.
+  typedef TreeType<MetricType, tree::EmptyStatistic, MatType> Tree;
+
+  /**
+   * Construct the SpatialJoin object with the two given sets, building a
+   * tree on each of them (unless naive mode is used, in which case no trees
+   * are built).  The sets are moved to internal copies; use std::move to
+   * avoid copying.
+   *
+   * @param firstSet First set of points to join.
+   * @param secondSet Second set of points to join.
+   * @param naive Whether to use the block-nested fallback instead of trees.
+   * @param metric Instantiated distance metric.
+   */
+  SpatialJoin(MatType firstSet,
+              MatType secondSet,
+              const bool naive = false,
+              const MetricType metric = MetricType());
+
+  //! Delete the SpatialJoin object and the trees it holds.
+  ~SpatialJoin();
+
+  /**
+   * Compute the join: every pair of points within the given distance
+   * threshold of each other.  The indices in each reported pair refer to
+   * columns of the first and second set, respectively, and the distance of
+   * the pair is stored at the same position of the distances vector.  The
+   * pairs are reported in no particular order.
+   *
+   * @param threshold Maximum distance for a pair to be reported (>= 0).
+   * @param pairs Output vector of matching (first, second) index pairs.
+   * @param distances Output vector of distances of the matching pairs.
+   */
+  void Search(const double threshold,
+              std::vector<std::pair<size_t, size_t>>& pairs,
+              std::vector<double>& distances);
+
+  //! Get the first set of points.
+  const MatType& FirstSet() const { return *firstSet; }
+
+  //! Get the second set of points.
+  const MatType& SecondSet() const { return *secondSet; }
+
+  //! Get whether the block-nested fallback is used instead of trees.
+  bool Naive() const { return naive; }
+
+ private:
+  /**
+   * Compute the join with a cache-blocked nested loop over the two sets.
+   * This is the fallback for inputs so small that building trees would
+   * dominate the cost of the join.
+   */
+  void BlockNestedJoin(const double threshold,
+                       std::vector<std::pair<size_t, size_t>>& pairs,
+                       std::vector<double>& distances) const;
+
+  //! Tree built on the first set (NULL in naive mode).
+  Tree* firstTree;
+
+  //! Tree built on the second set (NULL in naive mode).
+  Tree* secondTree;
+
+  //! Pointer to the first set (the tree's dataset, or an owned copy in naive
+  //! mode).
+  const MatType* firstSet;
+
+  //! Pointer to the second set.
+  const MatType* secondSet;
+
+  //! Whether the sets are owned directly (naive mode) instead of by the
+  //! trees.
+  bool naive;
+
+  //! Instantiated distance metric.
+  MetricType metric;
+};
+
+} // namespace spatial
+} // namespace mlpack
+
+// Include implementation.
+#include "spatial_join_impl.hpp"
+
+#endif
@@ -0,0 +1,227 @@
+/**
+ * @file methods/spatial_join/spatial_join_impl.hpp
+ *
+ * Implementation of the SpatialJoin class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_SPATIAL_JOIN_SPATIAL_JOIN_IMPL_HPP
+#define MLPACK_METHODS_SPATIAL_JOIN_SPATIAL_JOIN_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "spatial_join.hpp"
+
+namespace mlpack {
+namespace spatial {
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+SpatialJoin<MetricType, MatType, TreeType>::SpatialJoin(
+    MatType firstSet,
+    MatType secondSet,
+    const bool naive,
+    const MetricType metric) :
+    firstTree(NULL),
+    secondTree(NULL),
+    naive(naive),
+    metric(metric)
+{
+  if (naive)
+  {
+    // No trees are needed; hold the sets directly.
+    this->firstSet = new MatType(std::move(firstSet));
+    this->secondSet = new MatType(std::move(secondSet));
+  }
+  else
+  {
+    Timer::Start("spatial_join_tree_building");
+    firstTree = new Tree(std::move(firstSet));
+    secondTree = new Tree(std::move(secondSet));
+    Timer::Stop("spatial_join_tree_building");
+
+    // Rectangle trees do not rearrange the dataset, so the point indices of
+    // the trees refer directly to columns of these matrices.
+    this->firstSet = &firstTree->Dataset();
+    this->secondSet = &secondTree->Dataset();
+  }
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+SpatialJoin<MetricType, MatType, TreeType>::~SpatialJoin()
+{
+  if (naive)
+  {
+    delete firstSet;
+    delete secondSet;
+  }
+  else
+  {
+    delete firstTree;
+    delete secondTree;
+  }
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void SpatialJoin<MetricType, MatType, TreeType>::Search(
+    const double threshold,
+    std::vector<std::pair<size_t, size_t>>& pairs,
+    std::vector<double>& distances)
+{
+  if (threshold < 0)
+    throw std::invalid_argument("SpatialJoin::Search(): threshold must be "
+        "greater than or equal to 0");
+
+  pairs.clear();
+  distances.clear();
+
+  if (naive)
+  {
+    Timer::Start("spatial_join");
+    BlockNestedJoin(threshold, pairs, distances);
+    Timer::Stop("spatial_join");
+    return;
+  }
+
+  Timer::Start("spatial_join");
+
+  // Synchronized descent over both trees.  A node pair survives only if the
+  // minimum distance between the two bounds is within the threshold; for a
+  // threshold of zero this is exactly the overlap test of the classical
+  // R-tree spatial join.  Descending both nodes of a surviving pair at once
+  // keeps the descent synchronized, so only node pairs whose subtrees can
+  // actually contain matches are ever visited.
+  std::vector<std::pair<const Tree*, const Tree*>> frontier;
+  std::vector<std::pair<const Tree*, const Tree*>> leafPairs;
+  frontier.emplace_back(firstTree, secondTree);
+  while (!frontier.empty())
+  {
+    const Tree* first = frontier.back().first;
+    const Tree* second = frontier.back().second;
+    frontier.pop_back();
+
+    // Overlap pruning: bounds further apart than the threshold cannot
+    // contain a matching pair.
+    if (first->Bound().MinDistance(second->Bound()) > threshold)
+      continue;
+
+    if (first->IsLeaf() && second->IsLeaf())
+    {
+      leafPairs.emplace_back(first, second);
+    }
+    else if (first->IsLeaf())
+    {
+      for (size_t j = 0; j < second->NumChildren(); ++j)
+        frontier.emplace_back(first, &second->Child(j));
+    }
+    else if (second->IsLeaf())
+    {
+      for (size_t i = 0; i < first->NumChildren(); ++i)
+        frontier.emplace_back(&first->Child(i), second);
+    }
+    else
+    {
+      for (size_t i = 0; i < first->NumChildren(); ++i)
+        for (size_t j = 0; j < second->NumChildren(); ++j)
+          frontier.emplace_back(&first->Child(i), &second->Child(j));
+    }
+  }
+
+  // Scan the surviving leaf pairs.  The leaf pairs are independent of each
+  // other, so the scan parallelizes over them; each thread collects its
+  // matches locally and appends them to the output in one step.
+  #pragma omp parallel
+  {
+    std::vector<std::pair<size_t, size_t>> localPairs;
+    std::vector<double> localDistances;
+
+    #pragma omp for schedule(dynamic) nowait
+    for (omp_size_t l = 0; l < (omp_size_t) leafPairs.size(); ++l)
+    {
+      const Tree* first = leafPairs[l].first;
+      const Tree* second = leafPairs[l].second;
+      for (size_t i = 0; i < first->Count(); ++i)
+      {
+        const size_t p = first->Point(i);
+        for (size_t j = 0; j < second->Count(); ++j)
+        {
+          const size_t q = second->Point(j);
+          const double distance = metric.Evaluate(firstSet->col(p),
+                                                  secondSet->col(q));
+          if (distance <= threshold)
+          {
+            localPairs.emplace_back(p, q);
+            localDistances.push_back(distance);
+          }
+        }
+      }
+    }
+
+    #pragma omp critical
+    {
+      pairs.insert(pairs.end(), localPairs.begin(), localPairs.end());
+      distances.insert(distances.end(), localDistances.begin(),
+          localDistances.end());
+    }
+  }
+
+  Timer::Stop("spatial_join");
+
+  Log::Info << "SpatialJoin::Search(): " << leafPairs.size() << " leaf pairs "
+      << "scanned; " << pairs.size() << " matching pairs found." << std::endl;
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void SpatialJoin<MetricType, MatType, TreeType>::BlockNestedJoin(
+    const double threshold,
+    std::vector<std::pair<size_t, size_t>>& pairs,
+    std::vector<double>& distances) const
+{
+  // Process the sets in blocks of columns, so that the inner block stays in
+  // cache while it is compared against every point of the outer block.
+  const size_t blockSize = 256;
+  for (size_t ib = 0; ib < firstSet->n_cols; ib += blockSize)
+  {
+    const size_t iEnd = std::min(ib + blockSize, (size_t) firstSet->n_cols);
+    for (size_t jb = 0; jb < secondSet->n_cols; jb += blockSize)
+    {
+      const size_t jEnd = std::min(jb + blockSize,
+          (size_t) secondSet->n_cols);
+      for (size_t i = ib; i < iEnd; ++i)
+      {
+        for (size_t j = jb; j < jEnd; ++j)
+        {
+          const double distance = metric.Evaluate(firstSet->col(i),
+                                                  secondSet->col(j));
+          if (distance <= threshold)
+          {
+            pairs.emplace_back(i, j);
+            distances.push_back(distance);
+          }
+        }
+      }
+    }
+  }
+}
+
+} // namespace spatial
+} // namespace mlpack
+
+#endif
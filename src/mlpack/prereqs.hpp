@@ -128,6 +128,8 @@ or upgrade Boost to 1.59 or newer.
 // All code should have access to logging.
 #include <mlpack/core/util/log.hpp>
 #include <mlpack/core/util/timers.hpp>
+#include <mlpack/core/util/profiler.hpp>
+#include <mlpack/core/util/instrumentation.hpp>
 
 // This can be removed with Visual Studio supports an OpenMP version with
 // unsigned loop variables.
@@ -143,4 +145,34 @@ or upgrade Boost to 1.59 or newer.
 // Include ready to use utility function to check sizes of datasets.
 #include <mlpack/core/util/size_checks.hpp>
 
+// Compile-time execution policy for dense linear algebra.  Methods that are
+// dominated by dense matrix products (for example the randomized SVD
+// variants) either template their Apply() methods on the matrix type or route
+// their working matrices through the aliases below.  Defining these macros
+// before including mlpack reroutes such methods to an accelerated backend
+// whose matrix types mirror the Armadillo API, without per-method rewrites;
+// by default everything stays on Armadillo.  Methods written against this
+// policy must call linear algebra functions unqualified so that
+// argument-dependent lookup resolves them in the backend's namespace.
+#ifndef MLPACK_DENSE_MAT_TYPE
+  #define MLPACK_DENSE_MAT_TYPE arma::mat
+#endif
+#ifndef MLPACK_DENSE_COL_TYPE
+  #define MLPACK_DENSE_COL_TYPE arma::vec
+#endif
+#ifndef MLPACK_DENSE_ROW_TYPE
+  #define MLPACK_DENSE_ROW_TYPE arma::rowvec
+#endif
+
+namespace mlpack {
+
+//! The dense matrix type of the configured dense linear algebra backend.
+typedef MLPACK_DENSE_MAT_TYPE DenseMatType;
+//! The dense column vector type of the configured dense backend.
+typedef MLPACK_DENSE_COL_TYPE DenseColType;
+//! The dense row vector type of the configured dense backend.
+typedef MLPACK_DENSE_ROW_TYPE DenseRowType;
+
+} // namespace mlpack
+
 #endif
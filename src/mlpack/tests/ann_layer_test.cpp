@@ -1925,6 +1925,56 @@ TEST_CASE("SimpleLookupLayerTest", "[ANNLayerTest]")
   REQUIRE(std::fabs(arma::accu(error) - arma::accu(gradient)) <= 1e-07);
 }
 
+/**
+ * Test the sparse gradient of the lookup module, and that repeated dense
+ * gradient calls (which only rezero the previously touched columns) match a
+ * fresh computation.
+ */
+TEST_CASE("LookupLayerSparseGradientTest", "[ANNLayerTest]")
+{
+  const size_t vocabSize = 50;
+  const size_t embeddingSize = 4;
+  const size_t seqLength = 3;
+  const size_t batchSize = 5;
+
+  Lookup<> module(vocabSize, embeddingSize);
+  module.Parameters().randu();
+
+  arma::mat input(seqLength, batchSize);
+  for (size_t i = 0; i < input.n_elem; ++i)
+    input(i) = math::RandInt(1, vocabSize);
+
+  arma::mat error = 0.01 * arma::randu(embeddingSize * seqLength, batchSize);
+
+  // The sparse gradient must match the dense gradient, while only holding
+  // entries for the embeddings referenced by the batch.
+  arma::mat denseGradient;
+  arma::sp_mat sparseGradient;
+  module.Gradient(input, error, denseGradient);
+  module.Gradient(input, error, sparseGradient);
+
+  CheckMatrices(denseGradient, arma::mat(sparseGradient));
+
+  const arma::uvec uniqueTokens = arma::unique(
+      arma::conv_to<arma::uvec>::from(arma::vectorise(input)) - 1);
+  REQUIRE(sparseGradient.n_nonzero <= embeddingSize * uniqueTokens.n_elem);
+
+  // A second dense call with different tokens must give the same result as a
+  // fresh module, even though only the touched columns are rezeroed.
+  arma::mat shiftedInput = input;
+  for (size_t i = 0; i < shiftedInput.n_elem; ++i)
+    shiftedInput(i) = math::RandInt(1, vocabSize);
+
+  arma::mat reusedGradient = denseGradient;
+  module.Gradient(shiftedInput, error, reusedGradient);
+
+  Lookup<> freshModule(vocabSize, embeddingSize);
+  arma::mat freshGradient;
+  freshModule.Gradient(shiftedInput, error, freshGradient);
+
+  CheckMatrices(reusedGradient, freshGradient);
+}
+
 /**
  * Lookup layer numerical gradient test.
  */
@@ -0,0 +1,149 @@
+/**
+ * @file tests/benchmarks/benchmark_harness.cpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the microbenchmark registry, runner, and main().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark_harness.hpp"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+using namespace mlpack;
+using namespace mlpack::bench;
+using namespace std;
+using namespace chrono;
+
+vector<BenchmarkInfo>& mlpack::bench::Registry()
+{
+  static vector<BenchmarkInfo> registry;
+  return registry;
+}
+
+bool mlpack::bench::RegisterBenchmark(const string& name,
+                                      BenchmarkFunction function)
+{
+  Registry().push_back(BenchmarkInfo{ name, function });
+  return true;
+}
+
+int mlpack::bench::RunAllBenchmarks(int argc, char** argv)
+{
+  string filter = "";
+  bool json = false;
+  double minTime = 0.25;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const string arg(argv[i]);
+    if (arg.compare(0, 9, "--filter=") == 0)
+    {
+      filter = arg.substr(9);
+    }
+    else if (arg == "--json")
+    {
+      json = true;
+    }
+    else if (arg.compare(0, 11, "--min-time=") == 0)
+    {
+      minTime = atof(arg.substr(11).c_str());
+    }
+    else
+    {
+      cerr << "unknown argument '" << arg << "'!" << endl;
+      cerr << "usage: " << argv[0]
+          << " [--filter=<substring>] [--json] [--min-time=<seconds>]"
+          << endl;
+      return 1;
+    }
+  }
+
+  const nanoseconds minDuration =
+      duration_cast<nanoseconds>(duration<double>(minTime));
+
+  if (!json)
+  {
+    cout << left << setw(40) << "benchmark" << right << setw(14)
+        << "iterations" << setw(16) << "ns/iteration" << endl;
+    cout << string(70, '-') << endl;
+  }
+  else
+  {
+    cout << "{ \"benchmarks\": [";
+  }
+
+  bool first = true;
+  size_t ran = 0;
+  for (const BenchmarkInfo& info : Registry())
+  {
+    if (!filter.empty() && info.name.find(filter) == string::npos)
+      continue;
+    ++ran;
+
+    // Re-run with a growing iteration count until the timed loop is long
+    // enough to measure reliably.
+    size_t iterations = 1;
+    nanoseconds elapsed(0);
+    while (true)
+    {
+      State state(iterations);
+      info.function(state);
+      elapsed = state.Elapsed();
+
+      if (elapsed >= minDuration || iterations >= (size_t) 1000000000)
+        break;
+
+      // Grow toward the target duration, but at most 10x at a time to avoid
+      // overshooting on fast kernels with noisy first measurements.
+      size_t next = iterations * 10;
+      if (elapsed.count() > 0)
+      {
+        const double scale = (double) minDuration.count() /
+            (double) elapsed.count();
+        next = std::min<size_t>(next,
+            std::max<size_t>(iterations + 1, (size_t)(iterations * scale)));
+      }
+      iterations = next;
+    }
+
+    const double nsPerIteration = (double) elapsed.count() /
+        (double) iterations;
+
+    if (!json)
+    {
+      cout << left << setw(40) << info.name << right << setw(14) << iterations
+          << setw(16) << fixed << setprecision(1) << nsPerIteration << endl;
+    }
+    else
+    {
+      if (!first)
+        cout << ",";
+      first = false;
+      cout << "\n  { \"name\": \"" << info.name << "\", \"iterations\": "
+          << iterations << ", \"ns_per_iteration\": " << fixed
+          << setprecision(1) << nsPerIteration << " }";
+    }
+  }
+
+  if (json)
+    cout << (first ? "] }" : "\n] }") << endl;
+
+  if (ran == 0 && !filter.empty())
+  {
+    cerr << "no benchmarks match filter '" << filter << "'!" << endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+int main(int argc, char** argv)
+{
+  return RunAllBenchmarks(argc, argv);
+}
@@ -0,0 +1,148 @@
+/**
+ * @file tests/benchmarks/benchmark_harness.hpp
+ * @author Ryan Curtin
+ *
+ * A minimal Google-Benchmark-style microbenchmark harness for mlpack's hot
+ * kernels.  This is intentionally self-contained so that the benchmark target
+ * does not add an external dependency to the build.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_TESTS_BENCHMARKS_BENCHMARK_HARNESS_HPP
+#define MLPACK_TESTS_BENCHMARKS_BENCHMARK_HARNESS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mlpack {
+namespace bench {
+
+/**
+ * Per-run benchmark state, in the style of benchmark::State.  A benchmark
+ * function loops on KeepRunning(); the harness decides how many iterations
+ * the loop makes and times the whole loop:
+ *
+ * @code
+ * void BM_LMetricEvaluate(bench::State& state)
+ * {
+ *   // Setup outside the loop is not timed.
+ *   arma::vec a(100, arma::fill::randu), b(100, arma::fill::randu);
+ *   while (state.KeepRunning())
+ *     bench::DoNotOptimize(metric::EuclideanDistance::Evaluate(a, b));
+ * }
+ * BENCHMARK(BM_LMetricEvaluate);
+ * @endcode
+ */
+class State
+{
+ public:
+  //! Create a state that will run the given number of iterations.
+  explicit State(const size_t targetIterations) :
+      targetIterations(targetIterations),
+      iteration(0)
+  {
+    // Nothing to do; the clock starts on the first KeepRunning() call.
+  }
+
+  //! Returns true until the target number of iterations has been run.  The
+  //! first call starts the timer and the last one stops it, so setup before
+  //! the loop is not timed.
+  bool KeepRunning()
+  {
+    if (iteration == 0)
+      start = std::chrono::steady_clock::now();
+
+    if (iteration++ < targetIterations)
+      return true;
+
+    end = std::chrono::steady_clock::now();
+    return false;
+  }
+
+  //! Get the number of iterations the loop ran.
+  size_t Iterations() const { return targetIterations; }
+
+  //! Get the total time the loop took (valid after the loop finishes).
+  std::chrono::nanoseconds Elapsed() const
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+  }
+
+ private:
+  //! Number of iterations the loop will run.
+  size_t targetIterations;
+  //! Current iteration.
+  size_t iteration;
+  //! Time the first iteration started.
+  std::chrono::steady_clock::time_point start;
+  //! Time the last iteration finished.
+  std::chrono::steady_clock::time_point end;
+};
+
+//! The type of a benchmark function.
+typedef void (*BenchmarkFunction)(State&);
+
+//! A registered benchmark: its name and its function.
+struct BenchmarkInfo
+{
+  std::string name;
+  BenchmarkFunction function;
+};
+
+//! Get the global list of registered benchmarks.
+std::vector<BenchmarkInfo>& Registry();
+
+/**
+ * Register a benchmark function; used by the BENCHMARK() macro.  Returns true
+ * so that it can initialize a namespace-scope dummy variable.
+ */
+bool RegisterBenchmark(const std::string& name, BenchmarkFunction function);
+
+/**
+ * Run all registered benchmarks (each one is re-run with a growing iteration
+ * count until it runs long enough to time reliably) and print the results.
+ * Understands the following arguments:
+ *
+ *   --filter=<substring>  only run benchmarks whose name contains the string
+ *   --json                print results as JSON (for compare-benchmarks.py)
+ *   --min-time=<seconds>  minimum timed duration per benchmark (default 0.25)
+ *
+ * Returns an exit code suitable for returning from main().
+ */
+int RunAllBenchmarks(int argc, char** argv);
+
+/**
+ * Keep the compiler from optimizing away a computed value whose result is
+ * otherwise unused.  The analogue of benchmark::DoNotOptimize().
+ */
+#if defined(_MSC_VER)
+#pragma optimize("", off)
+template<typename T>
+inline void DoNotOptimize(T&& value) { (void) value; }
+#pragma optimize("", on)
+#else
+template<typename T>
+inline void DoNotOptimize(T&& value)
+{
+  asm volatile("" : : "g" (value) : "memory");
+}
+#endif
+
+} // namespace bench
+} // namespace mlpack
+
+/**
+ * Register a benchmark function of type void(bench::State&), in the style of
+ * Google Benchmark's BENCHMARK() macro.
+ */
+#define BENCHMARK(function) \
+    static const bool function##Registered = \
+        ::mlpack::bench::RegisterBenchmark(#function, function)
+
+#endif // MLPACK_TESTS_BENCHMARKS_BENCHMARK_HARNESS_HPP
@@ -0,0 +1,145 @@
+/**
+ * @file tests/benchmarks/kernel_benchmarks.cpp
+ * @author Ryan Curtin
+ *
+ * Microbenchmarks for mlpack's hot kernels: metric evaluation, tree building,
+ * neighbor search base cases, k-means iterations, CSV loading, and the FFN
+ * forward pass.  Run via the mlpack_bench target; compare two runs with
+ * scripts/compare-benchmarks.py.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/kmeans/naive_kmeans.hpp>
+#include <mlpack/methods/ann/layer/layer.hpp>
+#include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
+#include <mlpack/methods/ann/ffn.hpp>
+
+#include "benchmark_harness.hpp"
+
+#include <cstdio>
+
+using namespace mlpack;
+using namespace mlpack::ann;
+using namespace mlpack::bench;
+using namespace mlpack::kmeans;
+using namespace mlpack::metric;
+using namespace mlpack::neighbor;
+using namespace mlpack::tree;
+
+/**
+ * A single Euclidean distance evaluation between two 100-dimensional points.
+ */
+void BM_LMetricEvaluate(State& state)
+{
+  arma::vec a(100, arma::fill::randu);
+  arma::vec b(100, arma::fill::randu);
+
+  while (state.KeepRunning())
+    DoNotOptimize(EuclideanDistance::Evaluate(a, b));
+}
+BENCHMARK(BM_LMetricEvaluate);
+
+/**
+ * Building a kd-tree on 10k 10-dimensional points.
+ */
+void BM_KDTreeBuild(State& state)
+{
+  arma::mat dataset(10, 10000, arma::fill::randu);
+
+  while (state.KeepRunning())
+  {
+    KDTree<EuclideanDistance, EmptyStatistic, arma::mat> tree(dataset);
+    DoNotOptimize(tree.NumDescendants());
+  }
+}
+BENCHMARK(BM_KDTreeBuild);
+
+/**
+ * The k-nearest-neighbor base case: one point-to-point evaluation plus the
+ * candidate list update.
+ */
+void BM_NeighborSearchBaseCase(State& state)
+{
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+
+  arma::mat referenceSet(10, 1000, arma::fill::randu);
+  arma::mat querySet(10, 1000, arma::fill::randu);
+  EuclideanDistance metric;
+  NeighborSearchRules<NearestNeighborSort, EuclideanDistance, TreeType>
+      rules(referenceSet, querySet, 5 /* k */, metric, 0.0, false);
+
+  size_t q = 0, r = 0;
+  while (state.KeepRunning())
+  {
+    DoNotOptimize(rules.BaseCase(q, r));
+    // Walk both sets so consecutive base cases are not cached pairs.
+    q = (q + 1) % querySet.n_cols;
+    r = (r + 7) % referenceSet.n_cols;
+  }
+}
+BENCHMARK(BM_NeighborSearchBaseCase);
+
+/**
+ * One full naive Lloyd iteration: 10k points against 8 centroids.
+ */
+void BM_NaiveKMeansIterate(State& state)
+{
+  arma::mat dataset(10, 10000, arma::fill::randu);
+  arma::mat centroids(10, 8, arma::fill::randu);
+  EuclideanDistance metric;
+  NaiveKMeans<EuclideanDistance, arma::mat> naive(dataset, metric);
+
+  arma::mat newCentroids;
+  arma::Col<size_t> counts;
+  while (state.KeepRunning())
+    DoNotOptimize(naive.Iterate(centroids, newCentroids, counts));
+}
+BENCHMARK(BM_NaiveKMeansIterate);
+
+/**
+ * Loading a 10x1000 numeric CSV file from disk.
+ */
+void BM_LoadCSV(State& state)
+{
+  arma::mat dataset(10, 1000, arma::fill::randu);
+  data::Save("mlpack_bench_tmp.csv", dataset);
+
+  arma::mat loaded;
+  while (state.KeepRunning())
+  {
+    data::Load("mlpack_bench_tmp.csv", loaded);
+    DoNotOptimize(loaded.n_elem);
+  }
+
+  remove("mlpack_bench_tmp.csv");
+}
+BENCHMARK(BM_LoadCSV);
+
+/**
+ * The forward pass of a small feedforward network on a 128-point batch.
+ */
+void BM_FFNForward(State& state)
+{
+  FFN<MeanSquaredError<> > model;
+  model.Add<Linear<> >(100, 64);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(64, 10);
+  model.ResetParameters();
+
+  arma::mat batch(100, 128, arma::fill::randu);
+  arma::mat results;
+  while (state.KeepRunning())
+  {
+    model.Forward(batch, results);
+    DoNotOptimize(results.n_elem);
+  }
+}
+BENCHMARK(BM_FFNForward);
@@ -0,0 +1,180 @@
+/**
+ * @file tests/binding_server_test.cpp
+ *
+ * Test the wire protocol of the persistent CLI binding server.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/bindings/cli/server_protocol.hpp>
+
+#include "catch.hpp"
+
+#ifndef _WIN32
+
+#include <cstdio>
+#include <fstream>
+
+using namespace std;
+using namespace mlpack;
+using namespace mlpack::bindings::cli;
+
+//! Write one framed request (argc, then { length, bytes } per argument) to
+//! the given socket, as a client would.
+static void SendRequest(const int fd, const vector<string>& args)
+{
+  const uint32_t count = (uint32_t) args.size();
+  REQUIRE(WriteExact(fd, &count, sizeof(count)));
+  for (const string& arg : args)
+  {
+    const uint32_t len = (uint32_t) arg.size();
+    REQUIRE(WriteExact(fd, &len, sizeof(len)));
+    if (len > 0)
+      REQUIRE(WriteExact(fd, arg.data(), len));
+  }
+}
+
+/**
+ * A framed request written on one end of a socket pair must come out of
+ * ReadRequest() on the other end unchanged, including empty arguments and
+ * arguments with embedded NUL bytes.
+ */
+TEST_CASE("BindingServerRequestRoundTripTest", "[BindingServerTest]")
+{
+  int fds[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+  vector<string> sent;
+  sent.push_back("--input_model_file");
+  sent.push_back("model.bin");
+  sent.push_back(""); // An empty argument must survive framing.
+  sent.push_back(string("nul\0byte", 8)); // So must an embedded NUL.
+  SendRequest(fds[1], sent);
+
+  vector<string> received;
+  bool shutdown = false;
+  REQUIRE(ReadRequest(fds[0], received, shutdown));
+  REQUIRE(shutdown == false);
+  REQUIRE(received == sent);
+
+  // A second request on the same connection must also be read correctly.
+  SendRequest(fds[1], vector<string>(1, "--verbose"));
+  REQUIRE(ReadRequest(fds[0], received, shutdown));
+  REQUIRE(shutdown == false);
+  REQUIRE(received.size() == 1);
+  REQUIRE(received[0] == "--verbose");
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
+/**
+ * A request with argc equal to 0 is the shutdown request; ReadRequest() must
+ * succeed and set the shutdown flag.
+ */
+TEST_CASE("BindingServerShutdownRequestTest", "[BindingServerTest]")
+{
+  int fds[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+  SendRequest(fds[1], vector<string>());
+
+  vector<string> received;
+  bool shutdown = false;
+  REQUIRE(ReadRequest(fds[0], received, shutdown));
+  REQUIRE(shutdown == true);
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
+/**
+ * Garbage on the socket must not cause a huge allocation: an argument length
+ * over the 1 MB limit makes ReadRequest() fail, and so does EOF in the middle
+ * of a request.
+ */
+TEST_CASE("BindingServerMalformedRequestTest", "[BindingServerTest]")
+{
+  int fds[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+  // One argument whose claimed length is just over the limit.
+  uint32_t count = 1;
+  uint32_t len = (1 << 20) + 1;
+  REQUIRE(WriteExact(fds[1], &count, sizeof(count)));
+  REQUIRE(WriteExact(fds[1], &len, sizeof(len)));
+
+  vector<string> received;
+  bool shutdown = false;
+  REQUIRE(ReadRequest(fds[0], received, shutdown) == false);
+  REQUIRE(shutdown == false);
+
+  // A request truncated by the client hanging up must also fail, not hang:
+  // promise two arguments but send only one, then close.
+  count = 2;
+  len = 4;
+  REQUIRE(WriteExact(fds[1], &count, sizeof(count)));
+  REQUIRE(WriteExact(fds[1], &len, sizeof(len)));
+  REQUIRE(WriteExact(fds[1], "abcd", 4));
+  close(fds[1]);
+
+  REQUIRE(ReadRequest(fds[0], received, shutdown) == false);
+
+  close(fds[0]);
+}
+
+/**
+ * A response written with WriteResponse() must frame the status and message
+ * as documented: status, then length, then the message bytes.
+ */
+TEST_CASE("BindingServerResponseFramingTest", "[BindingServerTest]")
+{
+  int fds[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+  const string message = "something went wrong";
+  WriteResponse(fds[1], 1, message);
+
+  uint32_t status, len;
+  REQUIRE(ReadExact(fds[0], &status, sizeof(status)));
+  REQUIRE(status == 1);
+  REQUIRE(ReadExact(fds[0], &len, sizeof(len)));
+  REQUIRE(len == message.size());
+  string received(len, '\0');
+  REQUIRE(ReadExact(fds[0], &received[0], len));
+  REQUIRE(received == message);
+
+  // A success response carries an empty message.
+  WriteResponse(fds[1], 0, "");
+  REQUIRE(ReadExact(fds[0], &status, sizeof(status)));
+  REQUIRE(status == 0);
+  REQUIRE(ReadExact(fds[0], &len, sizeof(len)));
+  REQUIRE(len == 0);
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
+/**
+ * FileModificationTime(), which the server uses to detect model files
+ * overwritten on disk, must return 0 for a missing file and a nonzero stamp
+ * for an existing one.
+ */
+TEST_CASE("BindingServerFileModificationTimeTest", "[BindingServerTest]")
+{
+  REQUIRE(FileModificationTime("nonexistent_file_for_mtime_test.bin") == 0);
+
+  const string filename = "binding_server_mtime_test.txt";
+  ofstream f(filename);
+  f << "stamp" << endl;
+  f.close();
+
+  REQUIRE(FileModificationTime(filename) != 0);
+
+  remove(filename.c_str());
+}
+
+#endif // _WIN32
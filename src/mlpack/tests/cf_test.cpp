@@ -15,6 +15,7 @@
 #include <mlpack/methods/cf/cf.hpp>
 #include <mlpack/methods/cf/decomposition_policies/batch_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/bias_svd_method.hpp>
+#include <mlpack/methods/cf/decomposition_policies/implicit_sgd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/randomized_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/regularized_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svd_complete_method.hpp>
@@ -578,6 +579,53 @@ TEST_CASE("CFGetRecommendationsAllUsersSVDPPTest", "[CFTest]")
   GetRecommendationsAllUsers<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure that correct number of recommendations are generated when query
+ * set for implicit-feedback SGD method.
+ */
+TEST_CASE("CFGetRecommendationsAllUsersImplicitSGDTest", "[CFTest]")
+{
+  GetRecommendationsAllUsers<ImplicitSGDPolicy>();
+}
+
+/**
+ * Make sure that recommendations served from a prebuilt neighbor cache match
+ * the ones computed with a fresh neighbor search.
+ */
+TEST_CASE("CFNeighborCacheTest", "[CFTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  const size_t numRecs = 3;
+  CFType<RegSVDPolicy> c(dataset, RegSVDPolicy(), 5, 5, 30);
+
+  // Compute recommendations with a fresh search, then from the cache; the
+  // same factorization must give the same answer either way.
+  arma::Mat<size_t> recommendations;
+  c.GetRecommendations(numRecs, recommendations);
+
+  REQUIRE(c.NeighborCache().is_empty());
+  c.BuildNeighborCache();
+  REQUIRE(c.NeighborCache().n_rows == 5);
+  REQUIRE(c.NeighborCache().n_cols == c.CleanedData().n_cols);
+  REQUIRE(c.SimilarityCache().n_rows == 5);
+  REQUIRE(c.SimilarityCache().n_cols == c.CleanedData().n_cols);
+
+  arma::Mat<size_t> cachedRecommendations;
+  c.GetRecommendations(numRecs, cachedRecommendations);
+
+  REQUIRE(cachedRecommendations.n_rows == recommendations.n_rows);
+  REQUIRE(cachedRecommendations.n_cols == recommendations.n_cols);
+  for (size_t i = 0; i < recommendations.n_elem; ++i)
+    REQUIRE(cachedRecommendations[i] == recommendations[i]);
+
+  // Retraining must invalidate the cache.
+  c.Train(dataset, RegSVDPolicy(), 30);
+  REQUIRE(c.NeighborCache().is_empty());
+}
+
 /**
  * Make sure that the recommendations are generated for queried users only
  * for randomized SVD.
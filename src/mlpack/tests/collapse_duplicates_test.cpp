@@ -0,0 +1,132 @@
+/**
+ * @file tests/collapse_duplicates_test.cpp
+ *
+ * Test the CollapseDuplicates() and ExpandNeighbors() functions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/data/collapse_duplicates.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+#include "test_catch_tools.hpp"
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::data;
+using namespace mlpack::neighbor;
+
+/**
+ * Test that duplicate points are collapsed to the unique points in order of
+ * first occurrence, with correct multiplicities and mappings.
+ */
+TEST_CASE("CollapseDuplicatesTest", "[CollapseDuplicatesTest]")
+{
+  arma::mat input = { { 1.0, 2.0, 1.0, 3.0, 2.0, 1.0 },
+                      { 4.0, 5.0, 4.0, 6.0, 5.0, 4.0 } };
+
+  arma::mat output;
+  arma::Col<size_t> counts, mappings;
+  const size_t uniquePoints = CollapseDuplicates(input, output, counts,
+      mappings);
+
+  REQUIRE(uniquePoints == 3);
+  REQUIRE(output.n_rows == 2);
+  REQUIRE(output.n_cols == 3);
+
+  // Unique points appear in order of first occurrence.
+  REQUIRE(output(0, 0) == Approx(1.0).epsilon(1e-10));
+  REQUIRE(output(0, 1) == Approx(2.0).epsilon(1e-10));
+  REQUIRE(output(0, 2) == Approx(3.0).epsilon(1e-10));
+
+  REQUIRE(counts.n_elem == 3);
+  REQUIRE(counts[0] == 3);
+  REQUIRE(counts[1] == 2);
+  REQUIRE(counts[2] == 1);
+
+  REQUIRE(mappings.n_elem == 6);
+  REQUIRE(mappings[0] == 0);
+  REQUIRE(mappings[1] == 1);
+  REQUIRE(mappings[2] == 0);
+  REQUIRE(mappings[3] == 2);
+  REQUIRE(mappings[4] == 1);
+  REQUIRE(mappings[5] == 0);
+
+  // A dataset without duplicates must pass through unchanged.
+  arma::mat distinct = arma::randu<arma::mat>(5, 50);
+  CollapseDuplicates(distinct, output, counts, mappings);
+
+  REQUIRE(output.n_cols == distinct.n_cols);
+  REQUIRE(arma::accu(counts != 1) == 0);
+  for (size_t i = 0; i < distinct.n_cols; ++i)
+    REQUIRE(mappings[i] == i);
+}
+
+/**
+ * Test that a monochromatic k-nearest-neighbor search on the collapsed set,
+ * expanded with ExpandNeighbors(), gives the same distances as a search on the
+ * original duplicate-heavy set.
+ */
+TEST_CASE("CollapseDuplicatesExpandNeighborsTest", "[CollapseDuplicatesTest]")
+{
+  // Build a dataset where every point appears one to three times.
+  arma::mat uniqueData = arma::randu<arma::mat>(5, 200);
+  std::vector<size_t> columns;
+  for (size_t i = 0; i < uniqueData.n_cols; ++i)
+    for (size_t c = 0; c < (i % 3) + 1; ++c)
+      columns.push_back(i);
+
+  arma::mat dataset(uniqueData.n_rows, columns.size());
+  for (size_t i = 0; i < columns.size(); ++i)
+    dataset.col(i) = uniqueData.col(columns[i]);
+
+  const size_t k = 4;
+
+  // Get the reference results on the original dataset.
+  KNN exact(dataset);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  exact.Search(k, exactNeighbors, exactDistances);
+
+  // Collapse, search on the unique points only, and expand.
+  arma::mat collapsed;
+  arma::Col<size_t> counts, mappings;
+  CollapseDuplicates(dataset, collapsed, counts, mappings);
+  REQUIRE(collapsed.n_cols == uniqueData.n_cols);
+
+  KNN knn(collapsed);
+  arma::Mat<size_t> collapsedNeighbors;
+  arma::mat collapsedDistances;
+  knn.Search(k, collapsedNeighbors, collapsedDistances);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  ExpandNeighbors(collapsedNeighbors, collapsedDistances, counts, mappings, k,
+      neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == k);
+  REQUIRE(neighbors.n_cols == dataset.n_cols);
+
+  // The distances must agree exactly; the neighbor indices may differ between
+  // copies of the same point, so check that each expanded neighbor lies at the
+  // reported distance instead.
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(distances(j, i) ==
+          Approx(exactDistances(j, i)).epsilon(1e-10));
+      REQUIRE(neighbors(j, i) != i);
+      const double trueDistance = metric::EuclideanDistance::Evaluate(
+          dataset.col(i), dataset.col(neighbors(j, i)));
+      REQUIRE(trueDistance == Approx(distances(j, i)).margin(1e-10));
+    }
+  }
+
+  // Asking for more neighbors than the collapsed search computed must throw.
+  REQUIRE_THROWS_AS(ExpandNeighbors(collapsedNeighbors, collapsedDistances,
+      counts, mappings, k + 1, neighbors, distances), std::invalid_argument);
+}
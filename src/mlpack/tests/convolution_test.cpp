@@ -16,6 +16,8 @@
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_gemm_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/winograd_convolution.hpp>
 
 #include "serialization.hpp"
 #include "catch.hpp"
@@ -148,6 +150,14 @@ TEST_CASE("ValidConvolution2DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<ValidConvolution> >(input, filter,
       output);
+
+  // Perform the convolution using the im2col patch matrix and GEMM.
+  Convolution2DMethodTest<Im2ColGEMMConvolution<ValidConvolution> >(input,
+      filter, output);
+
+  // Perform the convolution using the Winograd F(2x2, 3x3) transform.
+  Convolution2DMethodTest<WinogradConvolution<ValidConvolution> >(input,
+      filter, output);
 }
 
 /**
@@ -185,6 +195,14 @@ TEST_CASE("FullConvolution2DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<FullConvolution> >(input, filter,
       output);
+
+  // Perform the convolution using the im2col patch matrix and GEMM.
+  Convolution2DMethodTest<Im2ColGEMMConvolution<FullConvolution> >(input,
+      filter, output);
+
+  // Perform the convolution using the Winograd F(2x2, 3x3) transform.
+  Convolution2DMethodTest<WinogradConvolution<FullConvolution> >(input,
+      filter, output);
 }
 
 /**
@@ -230,6 +248,14 @@ TEST_CASE("ValidConvolution3DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution using the im2col patch matrix and GEMM.
+  Convolution3DMethodTest<Im2ColGEMMConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
+
+  // Perform the convolution using the Winograd F(2x2, 3x3) transform.
+  Convolution3DMethodTest<WinogradConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -279,6 +305,14 @@ TEST_CASE("FullConvolution3DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution using the im2col patch matrix and GEMM.
+  Convolution3DMethodTest<Im2ColGEMMConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
+
+  // Perform the convolution using the Winograd F(2x2, 3x3) transform.
+  Convolution3DMethodTest<WinogradConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -321,6 +355,14 @@ TEST_CASE("ValidConvolutionBatchTest", "[ConvolutionTest]")
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution using the im2col patch matrix and GEMM.
+  ConvolutionMethodBatchTest<Im2ColGEMMConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
+
+  // Perform the convolution using the Winograd F(2x2, 3x3) transform.
+  ConvolutionMethodBatchTest<WinogradConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
 }
 
 /**
@@ -367,4 +409,49 @@ TEST_CASE("FullConvolutionBatchTest", "[ConvolutionTest]")
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<FullConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution using the im2col patch matrix and GEMM.
+  ConvolutionMethodBatchTest<Im2ColGEMMConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+
+  // Perform the convolution using the Winograd F(2x2, 3x3) transform.
+  ConvolutionMethodBatchTest<WinogradConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+}
+
+/**
+ * Test that the im2col+GEMM and Winograd rules agree with the naive rule on
+ * random inputs whose output size is not a multiple of the 2x2 Winograd tile,
+ * and (for im2col) on strided application.
+ */
+TEST_CASE("AcceleratedConvolutionAgreementTest", "[ConvolutionTest]")
+{
+  for (size_t size = 5; size < 9; ++size)
+  {
+    arma::mat input(size, size, arma::fill::randu);
+    arma::mat filter(3, 3, arma::fill::randu);
+
+    arma::mat naiveOutput, im2colOutput, winogradOutput;
+    NaiveConvolution<ValidConvolution>::Convolution(input, filter,
+        naiveOutput);
+    Im2ColGEMMConvolution<ValidConvolution>::Convolution(input, filter,
+        im2colOutput);
+    WinogradConvolution<ValidConvolution>::Convolution(input, filter,
+        winogradOutput);
+
+    CheckMatrices(naiveOutput, im2colOutput);
+    CheckMatrices(naiveOutput, winogradOutput);
+
+    // A strided convolution makes the Winograd rule fall back to im2col; both
+    // must still match the naive result.
+    NaiveConvolution<ValidConvolution>::Convolution(input, filter,
+        naiveOutput, 2, 2);
+    Im2ColGEMMConvolution<ValidConvolution>::Convolution(input, filter,
+        im2colOutput, 2, 2);
+    WinogradConvolution<ValidConvolution>::Convolution(input, filter,
+        winogradOutput, 2, 2);
+
+    CheckMatrices(naiveOutput, im2colOutput);
+    CheckMatrices(naiveOutput, winogradOutput);
+  }
 }
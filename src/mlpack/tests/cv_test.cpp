@@ -12,6 +12,7 @@
 #include <type_traits>
 
 #include <mlpack/core/cv/meta_info_extractor.hpp>
+#include <mlpack/core/data/incremental_confusion_matrix.hpp>
 #include <mlpack/core/cv/metrics/accuracy.hpp>
 #include <mlpack/core/cv/metrics/f1.hpp>
 #include <mlpack/core/cv/metrics/mse.hpp>
@@ -19,6 +20,7 @@
 #include <mlpack/core/cv/metrics/recall.hpp>
 #include <mlpack/core/cv/metrics/r2_score.hpp>
 #include <mlpack/core/cv/metrics/silhouette_score.hpp>
+#include <mlpack/core/cv/metrics/davies_bouldin_index.hpp>
 #include <mlpack/core/cv/simple_cv.hpp>
 #include <mlpack/core/cv/k_fold_cv.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
@@ -95,6 +97,62 @@ TEST_CASE("ConfusionMatrixTest", "[CVTest]")
   REQUIRE(output(1, 1) == 3);
 }
 
+/**
+ * Test for the incremental confusion matrix: batch updates, single updates
+ * and merged accumulators must all give the same counts as ConfusionMatrix(),
+ * and the derived metrics must match the values from
+ * BinaryClassificationMetricsTest.
+ */
+TEST_CASE("IncrementalConfusionMatrixTest", "[CVTest]")
+{
+  // Labels that will be considered as "ground truth".
+  arma::Row<size_t> labels("0 0 1 0 0  1 0 1 0 1");
+
+  // Predicted labels.
+  arma::Row<size_t> predictedLabels("0 0 0 0 0  1 1 1 1 1");
+
+  // Accumulate all predictions in one batch.
+  data::IncrementalConfusionMatrix cm(2);
+  cm.Update(predictedLabels, labels);
+  REQUIRE(cm.Count() == 10);
+  REQUIRE(cm.Matrix()(0, 0) == 4);
+  REQUIRE(cm.Matrix()(0, 1) == 1);
+  REQUIRE(cm.Matrix()(1, 0) == 2);
+  REQUIRE(cm.Matrix()(1, 1) == 3);
+
+  // Accumulating one prediction at a time must give the same counts.
+  data::IncrementalConfusionMatrix single(2);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    single.Update(predictedLabels[i], labels[i]);
+  REQUIRE(arma::all(arma::vectorise(single.Matrix() == cm.Matrix())));
+
+  // Accumulating two halves independently and merging them must give the
+  // same counts; this is the cross-thread use case.
+  data::IncrementalConfusionMatrix left(2), right(2);
+  left.Update(predictedLabels.subvec(0, 4), labels.subvec(0, 4));
+  right.Update(predictedLabels.subvec(5, 9), labels.subvec(5, 9));
+  left.Merge(right);
+  REQUIRE(left.Count() == 10);
+  REQUIRE(arma::all(arma::vectorise(left.Matrix() == cm.Matrix())));
+
+  // The derived metrics must match the cross-validation metric classes (see
+  // BinaryClassificationMetricsTest).
+  REQUIRE(cm.Accuracy() == Approx(0.7).epsilon(1e-7));
+  REQUIRE(cm.Precision(1) == Approx(0.6).epsilon(1e-7));
+  REQUIRE(cm.Recall(1) == Approx(0.75).epsilon(1e-7));
+  double f1 = 2 * 0.6 * 0.75 / (0.6 + 0.75);
+  REQUIRE(cm.F1(1) == Approx(f1).epsilon(1e-7));
+  REQUIRE(cm.MacroPrecision() ==
+      Approx((4.0 / 5 + 0.6) / 2).epsilon(1e-7));
+  REQUIRE(cm.MacroRecall() == Approx((4.0 / 6 + 0.75) / 2).epsilon(1e-7));
+
+  // Mismatched sizes and incompatible merges must be rejected.
+  REQUIRE_THROWS_AS(cm.Update(predictedLabels, labels.subvec(0, 4)),
+      std::invalid_argument);
+  data::IncrementalConfusionMatrix threeClasses(3);
+  REQUIRE_THROWS_AS(cm.Merge(threeClasses), std::invalid_argument);
+}
+
 /**
  * Test metrics for multiclass classification.
  */
@@ -401,6 +459,55 @@ TEST_CASE("SimpleCVMSETest", "[CVTest]")
   REQUIRE(std::abs(weightedCV2.Evaluate() - expectedMSE) > 1e-5);
 }
 
+/**
+ * Test that repeated evaluation with the same arguments retrains the model in
+ * place, while evaluation with other hyperparameters rebuilds it.
+ */
+TEST_CASE("SimpleCVModelReuseTest", "[CVTest]")
+{
+  arma::mat data("0 1 2 3 4");
+  arma::rowvec responses("-1 0 1 3 5");
+
+  SimpleCV<LinearRegression, MSE> cv(0.6, data, responses);
+
+  const double firstResult = cv.Evaluate();
+  const LinearRegression* firstModel = &cv.Model();
+
+  // An identical evaluation should reuse the model object and produce the
+  // same result.
+  REQUIRE(cv.Evaluate() == Approx(firstResult).epsilon(1e-7));
+  REQUIRE(&cv.Model() == firstModel);
+
+  // Passing a hyperparameter should rebuild the model, and a subsequent call
+  // without hyperparameters should rebuild it once more instead of retraining
+  // the regularized model in place.
+  cv.Evaluate(1.0);
+  REQUIRE(cv.Evaluate() == Approx(firstResult).epsilon(1e-7));
+}
+
+/**
+ * Test in-place retraining with a classifier that warm-starts from its current
+ * parameters, and that a copy made after evaluation works independently.
+ */
+TEST_CASE("SimpleCVClassifierModelReuseTest", "[CVTest]")
+{
+  arma::mat data =
+    arma::mat("1 0; 2 0; 1 1; 2 1; 1 0; 2 0; 1 1; 2 1").t();
+  arma::Row<size_t> labels("0 0 1 1 0 1 1 1");
+
+  SimpleCV<LogisticRegression<>, Accuracy> cv(0.5, data, labels);
+
+  REQUIRE(cv.Evaluate() == Approx(0.75).epsilon(1e-7));
+  const LogisticRegression<>* model = &cv.Model();
+
+  REQUIRE(cv.Evaluate() == Approx(0.75).epsilon(1e-7));
+  REQUIRE(&cv.Model() == model);
+
+  SimpleCV<LogisticRegression<>, Accuracy> cvCopy(cv);
+  REQUIRE(&cvCopy.Model() != model);
+  REQUIRE(cvCopy.Evaluate() == Approx(0.75).epsilon(1e-7));
+}
+
 /**
  * Test that scores of -nan are filtered out.
  */
@@ -505,6 +612,36 @@ TEST_CASE("KFoldCVMSETest", "[CVTest]")
   REQUIRE_NOTHROW(cv.Model());
 }
 
+/**
+ * Test that parallel k-fold cross-validation gives the same result as the
+ * sequential run.
+ */
+TEST_CASE("KFoldCVParallelTest", "[CVTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(5, 500);
+  arma::rowvec responses = data.row(0) + 2.0 * data.row(3) +
+      0.05 * arma::randu<arma::rowvec>(500);
+
+  // 10-fold cross-validation, no shuffling, so both runs see identical folds.
+  KFoldCV<LinearRegression, MSE> sequentialCV(10, data, responses, false);
+  KFoldCV<LinearRegression, MSE> parallelCV(10, data, responses, false);
+  parallelCV.Parallel() = true;
+
+  const double sequentialScore = sequentialCV.Evaluate();
+  const double parallelScore = parallelCV.Evaluate();
+
+  REQUIRE(parallelScore == Approx(sequentialScore).epsilon(1e-10));
+  REQUIRE_NOTHROW(parallelCV.Model());
+
+  // Restricting the number of fold-level threads must not change the result
+  // either.
+  KFoldCV<LinearRegression, MSE> twoThreadCV(10, data, responses, false);
+  twoThreadCV.Parallel() = true;
+  twoThreadCV.NumThreads() = 2;
+
+  REQUIRE(twoThreadCV.Evaluate() == Approx(sequentialScore).epsilon(1e-10));
+}
+
 /**
  * Test k-fold cross-validation with the Accuracy metric.
  */
@@ -779,3 +916,95 @@ TEST_CASE("SilhouetteScoreTest", "[CVTest]")
   double silhouetteScore = SilhouetteScore::Overall(X, labels, metric);
   REQUIRE(silhouetteScore == Approx(0.1121684822489150).epsilon(1e-7));
 }
+
+/**
+ * Test the sampling estimator for the Silhouette Score.
+ */
+TEST_CASE("SilhouetteScoreEstimateTest", "[CVTest]")
+{
+  // Two well-separated Gaussian clusters.
+  arma::mat X(2, 1000, arma::fill::randn);
+  X.cols(500, 999) += 10.0;
+  arma::Row<size_t> labels(1000);
+  labels.cols(0, 499).fill(0);
+  labels.cols(500, 999).fill(1);
+
+  metric::EuclideanDistance metric;
+  const double exact = SilhouetteScore::Overall(X, labels, metric);
+
+  double confidenceWidth;
+  const double estimate = SilhouetteScore::EstimateOverall(X, labels, metric,
+      200, confidenceWidth);
+
+  // The clusters are well separated, so the per-sample scores have little
+  // variance and the estimate should land close to the exact score.
+  REQUIRE(confidenceWidth > 0.0);
+  REQUIRE(std::abs(estimate - exact) <= confidenceWidth + 0.05);
+
+  // When the sample size covers the dataset, the exact score is returned.
+  double zeroWidth;
+  const double full = SilhouetteScore::EstimateOverall(X, labels, metric,
+      2000, zeroWidth);
+  REQUIRE(full == Approx(exact).epsilon(1e-10));
+  REQUIRE(zeroWidth == 0.0);
+
+  // A sample size of zero is invalid.
+  REQUIRE_THROWS_AS(SilhouetteScore::EstimateOverall(X, labels, metric, 0,
+      confidenceWidth), std::invalid_argument);
+}
+
+/**
+ * Test the centroid-based simplified Silhouette Score.
+ */
+TEST_CASE("SimplifiedSilhouetteScoreTest", "[CVTest]")
+{
+  // Two well-separated Gaussian clusters; with this much separation the
+  // simplified score should closely track the exact one.
+  arma::mat X(2, 1000, arma::fill::randn);
+  X.cols(500, 999) += 10.0;
+  arma::Row<size_t> labels(1000);
+  labels.cols(0, 499).fill(0);
+  labels.cols(500, 999).fill(1);
+
+  metric::EuclideanDistance metric;
+  const double exact = SilhouetteScore::Overall(X, labels, metric);
+  const double simplified = SilhouetteScore::SimplifiedOverall(X, labels,
+      metric);
+
+  REQUIRE(std::abs(simplified - exact) < 0.1);
+
+  // A single cluster is invalid.
+  labels.fill(0);
+  REQUIRE_THROWS_AS(SilhouetteScore::SimplifiedOverall(X, labels, metric),
+      std::invalid_argument);
+}
+
+/**
+ * Test the Davies-Bouldin index.
+ */
+TEST_CASE("DaviesBouldinIndexTest", "[CVTest]")
+{
+  // Hand-computable example: two one-dimensional clusters with centroids 0.5
+  // and 10.5, each with average scatter 0.5, at distance 10.
+  arma::mat X = { { 0.0, 1.0, 10.0, 11.0 } };
+  arma::Row<size_t> labels = { 0, 0, 1, 1 };
+  metric::EuclideanDistance metric;
+
+  const double index = DaviesBouldinIndex::Overall(X, labels, metric);
+  REQUIRE(index == Approx(0.1).epsilon(1e-7));
+
+  // A good clustering should get a lower (better) index than a clustering
+  // with mixed-up labels.
+  arma::mat Y(2, 1000, arma::fill::randn);
+  Y.cols(500, 999) += 10.0;
+  arma::Row<size_t> goodLabels(1000);
+  goodLabels.cols(0, 499).fill(0);
+  goodLabels.cols(500, 999).fill(1);
+  arma::Row<size_t> badLabels(1000);
+  for (size_t i = 0; i < 1000; ++i)
+    badLabels[i] = i % 2;
+
+  const double good = DaviesBouldinIndex::Overall(Y, goodLabels, metric);
+  const double bad = DaviesBouldinIndex::Overall(Y, badLabels, metric);
+  REQUIRE(good < bad);
+}
@@ -306,3 +306,35 @@ TEST_CASE("RandomPointSelectionTest", "[DBSCANTest]")
   // The number of assignments returned should be the same as points.
   REQUIRE(assignments.n_elem == points.n_cols);
 }
+
+/**
+ * A non-core point that falls in range of two clusters must not merge them;
+ * it should join the cluster of its lowest-indexed core neighbor.
+ */
+TEST_CASE("BorderPointResolutionTest", "[DBSCANTest]")
+{
+  // Two dense groups of four points each, connected only through a single
+  // sparse bridge point that is not a core point (minPoints = 4).
+  arma::mat points(1, 9);
+  points = { 0.0, 0.2, 0.4, 0.6, 1.2, 1.8, 2.0, 2.2, 2.4 };
+
+  for (size_t mode = 0; mode < 2; ++mode)
+  {
+    DBSCAN<> d(0.65, 4, (mode == 0));
+
+    arma::Row<size_t> assignments;
+    const size_t clusters = d.Cluster(points, assignments);
+
+    // The bridge point (index 4) must not chain the two groups together.
+    REQUIRE(clusters == 2);
+    for (size_t i = 1; i < 4; ++i)
+      REQUIRE(assignments[i] == assignments[0]);
+    for (size_t i = 6; i < 9; ++i)
+      REQUIRE(assignments[i] == assignments[5]);
+    REQUIRE(assignments[0] != assignments[5]);
+
+    // The bridge point is a border point of both groups; it joins the cluster
+    // of its lowest-indexed core neighbor, which lies in the first group.
+    REQUIRE(assignments[4] == assignments[0]);
+  }
+}
@@ -1301,3 +1301,301 @@ TEST_CASE("DifferentMaximumDepthTest", "[DecisionTreeTest]")
   REQUIRE(d2.Child(0).NumChildren() == 2);
   REQUIRE(d2.Child(1).NumChildren() == 2);
 }
+
+/**
+ * Make sure the batch Classify() overloads, which descend a flattened copy of
+ * the tree, give exactly the same results as classifying each point
+ * individually, on both numeric and mixed categorical data.
+ */
+TEST_CASE("BatchClassifyMatchesSinglePointTest", "[DecisionTreeTest]")
+{
+  // Numeric tree.
+  {
+    arma::mat dataset;
+    arma::Row<size_t> labels;
+    if (!data::Load("vc2.csv", dataset))
+      FAIL("Cannot load test dataset vc2.csv!");
+    if (!data::Load("vc2_labels.txt", labels))
+      FAIL("Cannot load labels for vc2_labels.txt!");
+
+    DecisionTree<> tree(dataset, labels, 3, 10);
+
+    arma::Row<size_t> predictions;
+    arma::mat probabilities;
+    tree.Classify(dataset, predictions, probabilities);
+
+    REQUIRE(predictions.n_elem == dataset.n_cols);
+    REQUIRE(probabilities.n_cols == dataset.n_cols);
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+    {
+      size_t prediction;
+      arma::vec pointProbabilities;
+      tree.Classify(dataset.col(i), prediction, pointProbabilities);
+
+      REQUIRE(predictions[i] == prediction);
+      for (size_t j = 0; j < pointProbabilities.n_elem; ++j)
+        REQUIRE(probabilities(j, i) == Approx(pointProbabilities[j]));
+    }
+  }
+
+  // Tree with categorical splits.
+  {
+    arma::mat d;
+    arma::Row<size_t> l;
+    data::DatasetInfo di;
+    MockCategoricalData(d, l, di);
+
+    DecisionTree<> tree(d, di, l, 5, 10);
+
+    arma::Row<size_t> predictions;
+    tree.Classify(d, predictions);
+
+    REQUIRE(predictions.n_elem == d.n_cols);
+    for (size_t i = 0; i < d.n_cols; ++i)
+      REQUIRE(predictions[i] == tree.Classify(d.col(i)));
+  }
+}
+
+/**
+ * Build a tree on a dataset large enough that subtree training runs as
+ * deferred tasks (when OpenMP is available), and make sure the result is
+ * still a good classifier with a sane structure.
+ */
+TEST_CASE("ParallelSubtreeTrainingTest", "[DecisionTreeTest]")
+{
+  // Two well-separated Gaussians in 10 dimensions.
+  arma::mat dataset(10, 10000, arma::fill::randn);
+  arma::Row<size_t> labels(10000);
+  for (size_t i = 5000; i < 10000; ++i)
+    dataset.col(i) += 4.0;
+  labels.subvec(0, 4999).zeros();
+  labels.subvec(5000, 9999).ones();
+
+  DecisionTree<> tree(dataset, labels, 2, 10);
+
+  // The root must have split, and both subtrees must have been built.
+  REQUIRE(tree.NumChildren() > 0);
+
+  arma::Row<size_t> predictions;
+  tree.Classify(dataset, predictions);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    if (predictions[i] == labels[i])
+      ++correct;
+
+  // The classes are easily separable, so accuracy should be very high.
+  REQUIRE(double(correct) / double(dataset.n_cols) > 0.95);
+}
+
+/**
+ * Make sure a tree trained on labels of a different integer type gives the
+ * same results as one trained on size_t labels, with no conversion required
+ * from the caller.
+ */
+TEST_CASE("DecisionTreeIntegerLabelTypeTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load test dataset vc2.csv!");
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt!");
+
+  // The same labels, held as 32-bit signed integers.
+  const arma::Row<int> intLabels =
+      arma::conv_to<arma::Row<int>>::from(labels);
+
+  DecisionTree<> tree(dataset, labels, 3, 10);
+  DecisionTree<> intTree(dataset, intLabels, 3, 10);
+
+  // Training is deterministic, so the trees must agree everywhere.
+  arma::Row<size_t> predictions, intPredictions;
+  tree.Classify(dataset, predictions);
+  intTree.Classify(dataset, intPredictions);
+
+  REQUIRE(arma::all(predictions == intPredictions));
+}
+
+/**
+ * Make sure the MSE gain is zero when the responses are constant.
+ */
+TEST_CASE("MSEGainPerfectTest", "[DecisionTreeTest]")
+{
+  arma::rowvec weights(10, arma::fill::ones);
+  arma::rowvec responses(10);
+  responses.fill(3.0);
+
+  REQUIRE(MSEGain::Evaluate<false>(responses, weights) ==
+      Approx(0.0).margin(1e-5));
+  REQUIRE(MSEGain::Evaluate<true>(responses, weights) ==
+      Approx(0.0).margin(1e-5));
+}
+
+/**
+ * Make sure the MSE gain is the negated variance of the responses, and that
+ * the sufficient-statistics form agrees with the direct form.
+ */
+TEST_CASE("MSEGainVarianceTest", "[DecisionTreeTest]")
+{
+  arma::rowvec weights(4, arma::fill::ones);
+  arma::rowvec responses("0.0 2.0 0.0 2.0"); // Variance 1.
+
+  REQUIRE(MSEGain::Evaluate<false>(responses, weights) ==
+      Approx(-1.0).epsilon(1e-7));
+
+  // The sufficient-statistics form must give the same result.
+  const double sum = arma::accu(responses);
+  const double sumSquares = arma::accu(responses % responses);
+  REQUIRE(MSEGain::Evaluate((double) responses.n_elem, sum, sumSquares) ==
+      Approx(-1.0).epsilon(1e-7));
+}
+
+/**
+ * Check that the histogram split will split on an obviously splittable
+ * dimension.
+ */
+TEST_CASE("HistogramNumericSplitSimpleSplitTest", "[DecisionTreeTest]")
+{
+  arma::rowvec values("0.0 0.1 0.2 0.3 10.0 10.1 10.2 10.3");
+  arma::rowvec responses("0.0 0.0 0.0 0.0 5.0 5.0 5.0 5.0");
+  arma::rowvec weights(responses.n_elem);
+  weights.ones();
+
+  arma::vec splitInfo;
+  HistogramNumericSplit<MSEGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = MSEGain::Evaluate<false>(responses, weights);
+  const double gain = HistogramNumericSplit<MSEGain>::SplitIfBetter<false>(
+      bestGain, values, responses, weights, 3, 1e-7, splitInfo, aux);
+
+  // Make sure that a split was made, and that it cleanly separated the two
+  // clusters (both children are then pure, so the gain is perfect).
+  REQUIRE(gain > bestGain);
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+  REQUIRE(splitInfo.n_elem == 1);
+  REQUIRE(splitInfo[0] > 0.3);
+  REQUIRE(splitInfo[0] < 10.0);
+
+  // Make sure the directions are calculated correctly.
+  for (size_t i = 0; i < values.n_elem; ++i)
+  {
+    const size_t direction = HistogramNumericSplit<MSEGain>::CalculateDirection(
+        values[i], splitInfo, aux);
+    REQUIRE(direction == ((values[i] < 5.0) ? 0 : 1));
+  }
+}
+
+/**
+ * Check that the histogram split doesn't split if both children would be too
+ * small.
+ */
+TEST_CASE("HistogramNumericSplitMinSamplesTest", "[DecisionTreeTest]")
+{
+  arma::rowvec values("0.0 0.1 10.0 10.1");
+  arma::rowvec responses("0.0 0.0 5.0 5.0");
+  arma::rowvec weights(responses.n_elem);
+  weights.ones();
+
+  arma::vec splitInfo;
+  HistogramNumericSplit<MSEGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = MSEGain::Evaluate<false>(responses, weights);
+  const double gain = HistogramNumericSplit<MSEGain>::SplitIfBetter<false>(
+      bestGain, values, responses, weights, 8, 1e-7, splitInfo, aux);
+
+  // Make sure that no split was made.
+  REQUIRE(gain == DBL_MAX);
+}
+
+/**
+ * Build a regression tree on a dataset with a simple structure and make sure
+ * it can recover the responses.
+ */
+TEST_CASE("DecisionTreeRegressorSimpleTest", "[DecisionTreeTest]")
+{
+  // The response is a step function of the first dimension.
+  arma::mat dataset(3, 1000, arma::fill::randu);
+  arma::rowvec responses(1000);
+  for (size_t i = 0; i < 1000; ++i)
+    responses[i] = (dataset(0, i) > 0.5) ? 10.0 : 0.0;
+
+  DecisionTreeRegressor<> tree(dataset, responses, 1);
+
+  // The tree must have split at least once to model the step.
+  REQUIRE(tree.NumChildren() > 0);
+
+  // The predictions should recover the step function closely.
+  arma::rowvec predictions;
+  tree.Predict(dataset, predictions);
+  REQUIRE(predictions.n_elem == responses.n_elem);
+
+  double mse = 0.0;
+  for (size_t i = 0; i < responses.n_elem; ++i)
+    mse += std::pow(predictions[i] - responses[i], 2.0);
+  mse /= responses.n_elem;
+  REQUIRE(mse < 0.5);
+
+  // The batch overload must agree with single-point prediction.
+  for (size_t i = 0; i < 100; ++i)
+    REQUIRE(tree.Predict(dataset.col(i)) == Approx(predictions[i]));
+}
+
+/**
+ * Make sure that weighted regression training ignores zero-weight noise
+ * points.
+ */
+TEST_CASE("DecisionTreeRegressorWeightedTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset(3, 1200, arma::fill::randu);
+  arma::rowvec responses(1200);
+  arma::rowvec weights(1200);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    responses[i] = (dataset(0, i) > 0.5) ? 10.0 : 0.0;
+    weights[i] = 1.0;
+  }
+
+  // Add garbage points with zero weight.
+  for (size_t i = 1000; i < 1200; ++i)
+  {
+    responses[i] = 100.0 * math::Random();
+    weights[i] = 0.0;
+  }
+
+  DecisionTreeRegressor<> tree(dataset, responses, weights, 1);
+
+  // The zero-weight noise should not affect the fit on the clean points.
+  double mse = 0.0;
+  for (size_t i = 0; i < 1000; ++i)
+    mse += std::pow(tree.Predict(dataset.col(i)) - responses[i], 2.0);
+  mse /= 1000;
+  REQUIRE(mse < 0.5);
+}
+
+/**
+ * Test that the decision tree regressor serializes correctly.
+ */
+TEST_CASE("DecisionTreeRegressorSerializationTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset(3, 500, arma::fill::randu);
+  arma::rowvec responses = 5.0 * dataset.row(0) + dataset.row(1);
+
+  DecisionTreeRegressor<> tree(dataset, responses, 5);
+
+  arma::rowvec beforePredictions;
+  tree.Predict(dataset, beforePredictions);
+
+  DecisionTreeRegressor<> xmlTree, jsonTree, binaryTree;
+  SerializeObjectAll(tree, xmlTree, jsonTree, binaryTree);
+
+  arma::rowvec xmlPredictions, jsonPredictions, binaryPredictions;
+  xmlTree.Predict(dataset, xmlPredictions);
+  jsonTree.Predict(dataset, jsonPredictions);
+  binaryTree.Predict(dataset, binaryPredictions);
+
+  CheckMatrices(beforePredictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+}
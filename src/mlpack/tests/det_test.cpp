@@ -285,6 +285,61 @@ TEST_CASE("TestGrow", "[DETTest]")
   REQUIRE(alpha == Approx(min(rootAlpha, rAlpha)).epsilon(1e-12));
 }
 
+TEST_CASE("TestRefine", "[DETTest]")
+{
+  arma::mat testData(3, 5);
+
+  testData = { { 4, 5, 7, 3, 5 },
+               { 5, 0, 1, 7, 1 },
+               { 5, 6, 7, 1, 8 } };
+
+  arma::Col<size_t> oTest(5);
+  oTest = { 0, 1, 2, 3, 4 };
+
+  DTree<arma::mat> testDTree(testData);
+  const double alpha = testDTree.Grow(testData, oTest, false, 2, 1);
+
+  // Refining on the same data must leave the tree unchanged: all splits stay
+  // valid, no leaf exceeds the maximum size, and the recomputed statistics
+  // match the grown ones.
+  arma::Col<size_t> oRefine(5);
+  oRefine = { 0, 1, 2, 3, 4 };
+  const double refinedAlpha = testDTree.Refine(testData, oRefine, false, 2, 1);
+
+  REQUIRE(testDTree.SubtreeLeaves() == 3);
+  REQUIRE(testDTree.SplitDim() == 2);
+  REQUIRE(testDTree.SplitValue() == Approx(5.5).epsilon(1e-7));
+  REQUIRE(testDTree.Right()->SplitDim() == 1);
+  REQUIRE(testDTree.Right()->SplitValue() == Approx(0.5).epsilon(1e-7));
+  REQUIRE(refinedAlpha == Approx(alpha).epsilon(1e-12));
+
+  // Now extend the dataset with three points that land in the left leaf of
+  // the root (z <= 5.5); the root and right subtree splits stay valid, and
+  // the left leaf must be expanded, since it now holds five points.
+  arma::mat extendedData(3, 8);
+  extendedData.cols(0, 4) = testData;
+  extendedData.col(5) = arma::vec("4.0 5.0 5.2");
+  extendedData.col(6) = arma::vec("3.5 6.0 5.1");
+  extendedData.col(7) = arma::vec("4.2 5.5 5.0");
+
+  arma::Col<size_t> oExtended = arma::regspace<arma::Col<size_t>>(0, 7);
+  testDTree.Refine(extendedData, oExtended, false, 2, 1);
+
+  REQUIRE(testDTree.Start() == 0);
+  REQUIRE(testDTree.End() == 8);
+  REQUIRE(testDTree.SplitDim() == 2);
+  REQUIRE(testDTree.SplitValue() == Approx(5.5).epsilon(1e-7));
+  REQUIRE(testDTree.Right()->SplitDim() == 1);
+  REQUIRE(testDTree.Right()->SplitValue() == Approx(0.5).epsilon(1e-7));
+
+  // The left leaf had to split, so the tree has grown.
+  REQUIRE(testDTree.Left()->SubtreeLeaves() >= 2);
+  REQUIRE(testDTree.SubtreeLeaves() >= 4);
+
+  // The refined tree must assign positive density to the new points.
+  REQUIRE(testDTree.ComputeValue(arma::vec("4.0 5.0 5.1")) > 0.0);
+}
+
 TEST_CASE("TestPruneAndUpdate", "[DETTest]")
 {
   arma::mat testData(3, 5);
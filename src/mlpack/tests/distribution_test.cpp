@@ -88,6 +88,35 @@ TEST_CASE("DiscreteDistributionRandomTest", "[DistributionTest]")
   REQUIRE(actualProb(2) == Approx(0.1).epsilon(0.08));
 }
 
+/**
+ * Make sure the batched Random() overload follows the distribution too.
+ */
+TEST_CASE("DiscreteDistributionBatchRandomTest", "[DistributionTest]")
+{
+  DiscreteDistribution d(arma::Col<size_t>("3"));
+
+  d.Probabilities() = "0.3 0.6 0.1";
+
+  const arma::mat samples = d.Random(50000);
+
+  REQUIRE(samples.n_rows == 1);
+  REQUIRE(samples.n_cols == 50000);
+
+  arma::vec actualProb(3);
+  actualProb.zeros();
+
+  for (size_t i = 0; i < samples.n_cols; ++i)
+    actualProb((size_t) (samples(0, i) + 0.5))++;
+
+  // Normalize.
+  actualProb /= accu(actualProb);
+
+  // 8% tolerance, because this can be a noisy process.
+  REQUIRE(actualProb(0) == Approx(0.3).epsilon(0.08));
+  REQUIRE(actualProb(1) == Approx(0.6).epsilon(0.08));
+  REQUIRE(actualProb(2) == Approx(0.1).epsilon(0.08));
+}
+
 /**
  * Make sure we can estimate from observations correctly.
  */
@@ -453,6 +482,45 @@ TEST_CASE("GaussianMultipointMultivariateProbabilityTest", "[DistributionTest]")
   REQUIRE(phis(5) == Approx(-14.900192463287908).epsilon(1e-7));
 }
 
+/**
+ * The blocked batch LogProbability() must agree with the single-point path on
+ * batches larger than one block, and the cached factor must survive
+ * serialization.
+ */
+TEST_CASE("GaussianBlockedLogProbabilityTest", "[DistributionTest]")
+{
+  // Use more points than the batch path's block size so that several blocks
+  // are processed.
+  arma::mat points(10, 1200, arma::fill::randn);
+
+  GaussianDistribution g;
+  g.Train(points);
+
+  arma::vec logProbs;
+  g.LogProbability(points, logProbs);
+
+  REQUIRE(logProbs.n_elem == 1200);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    REQUIRE(logProbs(i) ==
+        Approx(g.LogProbability(points.col(i))).epsilon(1e-10));
+  }
+
+  // A deserialized distribution must give the same probabilities (the inverse
+  // factor is rebuilt at load time, not stored in the archive).
+  GaussianDistribution xmlG, jsonG, binaryG;
+  SerializeObjectAll(g, xmlG, jsonG, binaryG);
+
+  arma::vec xmlLogProbs, jsonLogProbs, binaryLogProbs;
+  xmlG.LogProbability(points, xmlLogProbs);
+  jsonG.LogProbability(points, jsonLogProbs);
+  binaryG.LogProbability(points, binaryLogProbs);
+
+  CheckMatrices(logProbs, xmlLogProbs, jsonLogProbs, binaryLogProbs);
+  REQUIRE(binaryG.LogProbability(points.col(0)) ==
+      Approx(g.LogProbability(points.col(0))).epsilon(1e-10));
+}
+
 /**
  * Make sure random observations follow the probability distribution correctly.
  */
@@ -669,7 +737,7 @@ TEST_CASE("GammaDistributionTrainTest", "[DistributionTest]")
   // Random generation of gamma-like points.
   for (size_t j = 0; j < d; ++j)
     for (size_t i = 0; i < N; ++i)
-      rdata(j, i) = dist(math::randGen);
+      rdata(j, i) = dist(math::RandGen());
 
   // Create Gamma object and call Train() on reference set.
   GammaDistribution gDist;
@@ -687,7 +755,7 @@ TEST_CASE("GammaDistributionTrainTest", "[DistributionTest]")
   // Random generation of gamma-like points.
   for (size_t j = 0; j < d2; ++j)
     for (size_t i = 0; i < N2; ++i)
-      rdata2(j, i) = dist(math::randGen);
+      rdata2(j, i) = dist(math::RandGen());
 
   // Fit results using old object.
   gDist.Train(rdata2);
@@ -715,7 +783,7 @@ TEST_CASE("GammaDistributionTrainWithProbabilitiesTest", "[DistributionTest]")
 
   for (size_t j = 0; j < d; ++j)
     for (size_t i = 0; i < N; ++i)
-      rdata(j, i) = dist(math::randGen);
+      rdata(j, i) = dist(math::RandGen());
 
   // Fill the probabilities randomly.
   arma::vec probabilities(N, arma::fill::randu);
@@ -759,7 +827,7 @@ TEST_CASE("GammaDistributionTrainAllProbabilities1Test", "[DistributionTest]")
 
   for (size_t j = 0; j < d; ++j)
     for (size_t i = 0; i < N; ++i)
-      rdata(j, i) = dist(math::randGen);
+      rdata(j, i) = dist(math::RandGen());
 
   // Fit results with only data.
   GammaDistribution gDist;
@@ -808,9 +876,9 @@ TEST_CASE("GammaDistributionTrainTwoDistProbabilities1Test",
     for (size_t i = 0; i < N; ++i)
     {
       if (i % 2 == 0)
-        rdata(j, i) = dist(math::randGen);
+        rdata(j, i) = dist(math::RandGen());
       else
-        rdata(j, i) = dist2(math::randGen);
+        rdata(j, i) = dist2(math::RandGen());
     }
   }
 
@@ -859,7 +927,7 @@ TEST_CASE("GammaDistributionFittingTest", "[DistributionTest]")
   arma::mat rdata(d, N);
   for (size_t j = 0; j < d; ++j)
     for (size_t i = 0; i < N; ++i)
-      rdata(j, i) = dist(math::randGen);
+      rdata(j, i) = dist(math::RandGen());
 
   // Create Gamma object and call Train() on reference set.
   GammaDistribution gDist;
@@ -880,7 +948,7 @@ TEST_CASE("GammaDistributionFittingTest", "[DistributionTest]")
   arma::mat rdata2(d, N);
   for (size_t j = 0; j < d; ++j)
     for (size_t i = 0; i < N; ++i)
-      rdata2(j, i) = dist2(math::randGen);
+      rdata2(j, i) = dist2(math::RandGen());
 
   // Create Gamma object and call Train() on reference set.
   GammaDistribution gDist2;
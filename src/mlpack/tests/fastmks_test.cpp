@@ -58,6 +58,55 @@ TEST_CASE("FastMKSSingleTreeVsNaive", "[FastMKSTest]")
   }
 }
 
+/**
+ * Check that Monte Carlo single-tree search returns nearly the same results
+ * as naive search.  The probabilistic prune can miss candidates, so we only
+ * require a high recall of the true max-kernel points.
+ */
+TEST_CASE("FastMKSMonteCarloSingleTreeTest", "[FastMKSTest]")
+{
+  // First create a random dataset.
+  arma::mat data;
+  data.randn(5, 1000);
+  LinearKernel lk;
+
+  // Now run FastMKS naively.
+  FastMKS<LinearKernel> naive(data, lk, false, true);
+
+  arma::Mat<size_t> naiveIndices;
+  arma::mat naiveProducts;
+  naive.Search(10, naiveIndices, naiveProducts);
+
+  // Now run approximate single-tree search with 50 samples per prune test.
+  FastMKS<LinearKernel> single(data, lk, true);
+  single.MCSamples() = 50;
+
+  arma::Mat<size_t> singleIndices;
+  arma::mat singleProducts;
+  single.Search(10, singleIndices, singleProducts);
+
+  // Count how many of the true max-kernel candidates were recovered.
+  size_t found = 0;
+  for (size_t q = 0; q < singleIndices.n_cols; ++q)
+  {
+    for (size_t r = 0; r < singleIndices.n_rows; ++r)
+    {
+      for (size_t j = 0; j < naiveIndices.n_rows; ++j)
+      {
+        if (singleIndices(r, q) == naiveIndices(j, q))
+        {
+          ++found;
+          break;
+        }
+      }
+    }
+  }
+
+  // Require at least 95% recall; the bound is loose so that the test is not
+  // random-seed-sensitive.
+  REQUIRE(found >= (size_t) (0.95 * singleIndices.n_elem));
+}
+
 /**
  * Compare dual-tree and naive.
  */
@@ -14,7 +14,11 @@
 
 #include <mlpack/methods/ann/layer/layer.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
+#include <mlpack/methods/ann/util/batch_norm_fold.hpp>
+#include <mlpack/methods/ann/util/quantization.hpp>
+#include <mlpack/methods/ann/util/raw_weights.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/static_sequential.hpp>
 
 #include <ensmallen.hpp>
 
@@ -730,8 +734,355 @@ TEST_CASE("FFNMiscTest", "[FeedForwardNetworkTest]")
 }
 
 /**
- * Test that serialization works ok.
+ * Test post-training int8 weight quantization: the quantized representation
+ * must round-trip with bounded error, and the dequantized model's
+ * predictions must stay close to the original ones.
  */
+TEST_CASE("FFNQuantizeWeightsTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 100, arma::fill::randu);
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<Linear<> >(10, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+
+  arma::mat predictions;
+  model.Predict(data, predictions);
+
+  const arma::mat originalParameters = model.Parameters();
+
+  arma::Col<arma::s8> quantized;
+  arma::vec scales;
+  QuantizeWeights(model, quantized, scales);
+
+  // Two weight-carrying layers, and one 8-bit value per weight.
+  REQUIRE(scales.n_elem == 2);
+  REQUIRE(quantized.n_elem == originalParameters.n_elem);
+  REQUIRE(arma::all(scales > 0.0));
+
+  // Restoring the quantized weights must reproduce every original weight up
+  // to half the coarsest quantization step.
+  DequantizeWeights(model, quantized, scales);
+  const double maxError = arma::abs(model.Parameters() -
+      originalParameters).max();
+  REQUIRE(maxError <= 0.5 * scales.max() + 1e-12);
+
+  // The quantized model should predict nearly the same values.
+  arma::mat quantizedPredictions;
+  model.Predict(data, quantizedPredictions);
+  CheckMatrices(predictions, quantizedPredictions, 1e-1);
+
+  // A mismatched architecture must be rejected.
+  FFN<MeanSquaredError<> > otherModel;
+  otherModel.Add<Linear<> >(10, 2);
+  arma::mat otherPredictions;
+  otherModel.Predict(data, otherPredictions);
+  REQUIRE_THROWS_AS(DequantizeWeights(otherModel, quantized, scales),
+      std::invalid_argument);
+}
+
+/**
+ * Test the raw binary weight file round-trip and running a network on an
+ * external weight buffer without copying.
+ */
+TEST_CASE("FFNRawWeightsTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 30, arma::fill::randu);
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<Linear<> >(10, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+
+  arma::mat predictions;
+  model.Predict(data, predictions);
+
+  SaveRawWeights(model, "raw_weights_test.bin");
+
+  // A fresh model of the same architecture must predict identically after
+  // loading the raw weights.
+  FFN<MeanSquaredError<> > loadedModel;
+  loadedModel.Add<Linear<> >(10, 8);
+  loadedModel.Add<SigmoidLayer<> >();
+  loadedModel.Add<Linear<> >(8, 3);
+  LoadRawWeights(loadedModel, "raw_weights_test.bin");
+
+  arma::mat loadedPredictions;
+  loadedModel.Predict(data, loadedPredictions);
+  CheckMatrices(predictions, loadedPredictions);
+
+  // Running on an external buffer must not copy: changes to the buffer have
+  // to show up in the network's predictions.
+  std::vector<double> buffer(model.Parameters().begin(),
+      model.Parameters().end());
+  FFN<MeanSquaredError<> > aliasedModel;
+  aliasedModel.Add<Linear<> >(10, 8);
+  aliasedModel.Add<SigmoidLayer<> >();
+  aliasedModel.Add<Linear<> >(8, 3);
+  aliasedModel.ResetParameters();
+  AliasWeights(aliasedModel, buffer.data(), buffer.size());
+  REQUIRE(aliasedModel.Parameters().memptr() == buffer.data());
+
+  arma::mat aliasedPredictions;
+  aliasedModel.Predict(data, aliasedPredictions);
+  CheckMatrices(predictions, aliasedPredictions);
+
+  std::fill(buffer.begin(), buffer.end(), 0.0);
+  aliasedModel.Predict(data, aliasedPredictions);
+  REQUIRE(arma::abs(aliasedPredictions).max() == Approx(0.0).margin(1e-12));
+
+  // Size mismatches must be rejected before anything is read or aliased.
+  FFN<MeanSquaredError<> > otherModel;
+  otherModel.Add<Linear<> >(10, 2);
+  REQUIRE_THROWS_AS(LoadRawWeights(otherModel, "raw_weights_test.bin"),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(AliasWeights(otherModel, buffer.data(), buffer.size()),
+      std::invalid_argument);
+
+  remove("raw_weights_test.bin");
+}
+
+/**
+ * Test batch normalization folding: collapsing the BatchNorm layers into the
+ * preceding Linear or Convolution layers must not change the inference
+ * output, while shrinking the layer list and the parameter vector.
+ */
+TEST_CASE("FFNFoldBatchNormTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 50, arma::fill::randu);
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<Linear<> >(10, 16);
+  model.Add<BatchNorm<> >(16);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(16, 3);
+  model.Add<BatchNorm<> >(3);
+
+  // Folding an uninitialized network must be rejected.
+  REQUIRE_THROWS_AS(FoldBatchNorm(model), std::invalid_argument);
+
+  arma::mat predictions;
+  model.Predict(data, predictions);
+
+  // Give the normalization layers non-trivial statistics and parameters so
+  // the fold has something to absorb.
+  model.Parameters().randu();
+  BatchNorm<>* norm = boost::get<BatchNorm<>*>(model.Model()[1]);
+  norm->TrainingMean() = arma::randn(16, 1);
+  norm->TrainingVariance() = arma::randu(16, 1) + 0.1;
+  norm = boost::get<BatchNorm<>*>(model.Model()[4]);
+  norm->TrainingMean() = arma::randn(3, 1);
+  norm->TrainingVariance() = arma::randu(3, 1) + 0.1;
+
+  model.Predict(data, predictions);
+  const size_t oldParameters = model.Parameters().n_elem;
+
+  REQUIRE(FoldBatchNorm(model) == 2);
+  REQUIRE(model.Model().size() == 3);
+  REQUIRE(model.Parameters().n_elem == oldParameters - 2 * (16 + 3));
+
+  arma::mat foldedPredictions;
+  model.Predict(data, foldedPredictions);
+  CheckMatrices(predictions, foldedPredictions, 1e-5);
+
+  // The convolution path: the fold scales every filter of an output map.
+  FFN<MeanSquaredError<> > convModel;
+  convModel.Add<Convolution<> >(1, 2, 3, 3, 1, 1, 0, 0, 8, 8);
+  convModel.Add<BatchNorm<> >(2);
+  convModel.Add<Linear<> >(72, 3);
+
+  arma::mat images(64, 20, arma::fill::randu);
+  arma::mat convPredictions;
+  convModel.Predict(images, convPredictions);
+
+  convModel.Parameters().randu();
+  norm = boost::get<BatchNorm<>*>(convModel.Model()[1]);
+  norm->TrainingMean() = arma::randn(2, 1);
+  norm->TrainingVariance() = arma::randu(2, 1) + 0.1;
+
+  convModel.Predict(images, convPredictions);
+  REQUIRE(FoldBatchNorm(convModel) == 1);
+  REQUIRE(convModel.Model().size() == 2);
+
+  arma::mat foldedConvPredictions;
+  convModel.Predict(images, foldedConvPredictions);
+  CheckMatrices(convPredictions, foldedConvPredictions, 1e-5);
+}
+
+/**
+ * Test that data-parallel gradient evaluation gives the same objective and
+ * gradient as the serial path.  MeanSquaredError is used on purpose: it
+ * normalizes over the batch, so this also checks that sharding does not
+ * change the loss scaling.
+ */
+TEST_CASE("FFNParallelGradientTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 256, arma::fill::randu);
+  arma::mat responses(3, 256, arma::fill::randu);
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<Linear<> >(10, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+
+  model.Predictors() = data;
+  model.Responses() = responses;
+
+  arma::mat serialGradient, parallelGradient;
+  const double serialObjective = model.EvaluateWithGradient(
+      model.Parameters(), 0, serialGradient, 256);
+
+  model.Parallel() = true;
+  const double parallelObjective = model.EvaluateWithGradient(
+      model.Parameters(), 0, parallelGradient, 256);
+
+  REQUIRE(serialObjective == Approx(parallelObjective).epsilon(1e-7));
+  CheckMatrices(serialGradient, parallelGradient);
+
+  // A batch whose size is not a multiple of the shard count must also match.
+  model.Parallel() = false;
+  const double serialPartial = model.EvaluateWithGradient(
+      model.Parameters(), 19, serialGradient, 111);
+
+  model.Parallel() = true;
+  const double parallelPartial = model.EvaluateWithGradient(
+      model.Parameters(), 19, parallelGradient, 111);
+
+  REQUIRE(serialPartial == Approx(parallelPartial).epsilon(1e-7));
+  CheckMatrices(serialGradient, parallelGradient);
+}
+
+/**
+ * Test that PredictBatch() gives the same predictions as Predict(), both with
+ * a batch size that divides the number of points and one that does not.
+ */
+TEST_CASE("FFNPredictBatchTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 250, arma::fill::randu);
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(10, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+
+  arma::mat predictions, batchPredictions;
+  model.Predict(data, predictions);
+
+  // 50 divides 250 evenly; 64 leaves a smaller final batch.
+  model.PredictBatch(data, batchPredictions, 50);
+  CheckMatrices(predictions, batchPredictions);
+
+  model.PredictBatch(data, batchPredictions, 64);
+  CheckMatrices(predictions, batchPredictions);
+
+  // A zero batch size should be rejected.
+  REQUIRE_THROWS_AS(model.PredictBatch(data, batchPredictions, 0),
+      std::invalid_argument);
+}
+
+/**
+ * Test that a network with elementwise layers running in place on the
+ * preceding layer's output activation still computes the correct forward
+ * pass and gradients.
+ */
+TEST_CASE("FFNInPlaceActivationTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 16, arma::fill::randu);
+  arma::mat responses(3, 16, arma::fill::randu);
+
+  // The ReLU and sigmoid layers both follow a Linear layer, so both run in
+  // place.
+  FFN<MeanSquaredError<> > model;
+  model.Add<Linear<> >(10, 8);
+  model.Add<ReLULayer<> >();
+  model.Add<Linear<> >(8, 5);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(5, 3);
+
+  model.ResetParameters();
+
+  // Compute the expected output by hand from the parameter matrix.
+  const arma::mat& p = model.Parameters();
+  const arma::mat w1 = arma::reshape(p.rows(0, 79), 8, 10);
+  const arma::vec b1 = p.rows(80, 87);
+  const arma::mat w2 = arma::reshape(p.rows(88, 127), 5, 8);
+  const arma::vec b2 = p.rows(128, 132);
+  const arma::mat w3 = arma::reshape(p.rows(133, 147), 3, 5);
+  const arma::vec b3 = p.rows(148, 150);
+
+  arma::mat h1 = w1 * data;
+  h1.each_col() += b1;
+  h1 = arma::clamp(h1, 0.0, arma::datum::inf);
+  arma::mat h2 = w2 * h1;
+  h2.each_col() += b2;
+  h2 = 1.0 / (1.0 + arma::exp(-h2));
+  arma::mat expected = w3 * h2;
+  expected.each_col() += b3;
+
+  arma::mat predictions;
+  model.Predict(data, predictions);
+  CheckMatrices(predictions, expected);
+
+  // The analytic gradient must match a central-difference approximation.
+  model.Predictors() = data;
+  model.Responses() = responses;
+
+  arma::mat gradient;
+  model.EvaluateWithGradient(model.Parameters(), 0, gradient, 16);
+
+  const double eps = 1e-6;
+  for (size_t i = 0; i < model.Parameters().n_elem; ++i)
+  {
+    const double orig = model.Parameters()(i);
+    model.Parameters()(i) = orig + eps;
+    const double fPlus = model.Evaluate(model.Parameters(), 0, 16);
+    model.Parameters()(i) = orig - eps;
+    const double fMinus = model.Evaluate(model.Parameters(), 0, 16);
+    model.Parameters()(i) = orig;
+
+    REQUIRE(gradient(i) ==
+        Approx((fPlus - fMinus) / (2 * eps)).margin(1e-4));
+  }
+}
+
+/**
+ * Test that a StaticSequential network with the weights of a dynamic FFN
+ * produces exactly the FFN's predictions.
+ */
+TEST_CASE("StaticSequentialTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 32, arma::fill::randu);
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(10, 8);
+  model.Add<ReLULayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+
+  model.ResetParameters();
+
+  arma::mat expected;
+  model.Predict(data, expected);
+
+  StaticSequential<Linear<>, ReLULayer<>, Linear<>, LogSoftMax<> > network;
+  network.CopyWeights(model);
+
+  arma::mat predictions;
+  network.Predict(data, predictions);
+
+  CheckMatrices(predictions, expected);
+
+  // The static network must keep working after the dynamic model goes away:
+  // the copied weights are owned by the static layers.
+  FFN<NegativeLogLikelihood<> > emptied(std::move(model));
+  network.Predict(data, predictions);
+  CheckMatrices(predictions, expected);
+
+  // The layer accessor must hand back the concrete layer type.
+  REQUIRE(network.Layer<0>().OutputSize() == 8);
+}
 TEST_CASE("FFSerializationTest", "[FeedForwardNetworkTest]")
 {
   // Load the dataset.
@@ -1008,3 +1359,37 @@ TEST_CASE("FFNCheckInputShapeTest", "[FeedForwardNetworkTest]")
 
   REQUIRE_THROWS_AS(model.Train(trainData, trainLabels, opt), std::logic_error);
 }
+
+/**
+ * Training an FFN through a PrefetchingChunkIterator must make progress on a
+ * simple regression problem and match the data chunk by chunk.
+ */
+TEST_CASE("FFNPrefetchingChunkTrainTest", "[FeedForwardNetworkTest]")
+{
+  // A linear target: responses = A * predictors.
+  arma::mat predictors(4, 512, arma::fill::randu);
+  arma::mat weights(2, 4, arma::fill::randu);
+  arma::mat responses = weights * predictors;
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<Linear<> >(4, 2);
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, 1000, -1);
+
+  // Several epochs over the iterator, resetting between passes.
+  data::PrefetchingChunkIterator<> it(predictors, responses, 128, 2);
+  double objective = 0.0;
+  for (size_t epoch = 0; epoch < 20; ++epoch)
+  {
+    objective = model.Train(it, opt);
+    it.Reset();
+  }
+
+  REQUIRE(std::isfinite(objective));
+
+  arma::mat predictions;
+  model.Predict(predictors, predictions);
+  const double error = arma::norm(predictions - responses, "fro") /
+      arma::norm(responses, "fro");
+  REQUIRE(error < 0.1);
+}
@@ -19,6 +19,8 @@
 #include <mlpack/methods/gmm/positive_definite_constraint.hpp>
 #include <mlpack/methods/gmm/diagonal_constraint.hpp>
 #include <mlpack/methods/gmm/eigenvalue_ratio_constraint.hpp>
+#include <mlpack/methods/gmm/spherical_constraint.hpp>
+#include <mlpack/methods/gmm/tied_constraint.hpp>
 
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
@@ -645,6 +647,55 @@ TEST_CASE("DiagonalConstraintTest", "[GMMTest]")
   }
 }
 
+TEST_CASE("SphericalConstraintTest", "[GMMTest]")
+{
+  // Make sure matrices are projected to a scalar multiple of the identity with
+  // the right scalar.
+  for (size_t i = 0; i < 30; ++i)
+  {
+    const size_t elem = 5 + math::RandInt(50);
+    arma::mat cov(elem, elem);
+    cov.randu();
+    const double meanDiag = arma::as_scalar(arma::mean(cov.diag()));
+
+    SphericalConstraint::ApplyConstraint(cov);
+
+    for (size_t j = 0; j < elem; ++j)
+      for (size_t k = 0; k < elem; ++k)
+      {
+        if (j == k)
+          REQUIRE(cov(j, k) == Approx(meanDiag).epsilon(1e-7));
+        else
+          REQUIRE(cov(j, k) == Approx(0.0).margin(1e-50));
+      }
+  }
+}
+
+TEST_CASE("TiedCovarianceTrainingTest", "[GMMTest]")
+{
+  // Two well-separated Gaussians sharing the same covariance; training with
+  // the tied constraint should give every component an identical covariance
+  // matrix.
+  arma::mat observations(2, 2000);
+  observations.cols(0, 999) = arma::randn(2, 1000);
+  observations.cols(1000, 1999) = arma::randn(2, 1000) +
+      arma::repmat(arma::vec("8.0 8.0"), 1, 1000);
+
+  GMM gmm(2, 2);
+  EMFit<kmeans::KMeans<>, TiedConstraint> fitter(250, 1e-10);
+  gmm.Train(observations, 2, false, fitter);
+
+  for (size_t j = 0; j < 4; ++j)
+  {
+    REQUIRE(gmm.Component(0).Covariance()[j] ==
+        Approx(gmm.Component(1).Covariance()[j]).epsilon(1e-10));
+  }
+
+  // The pooled covariance should be close to the true (identity) covariance.
+  REQUIRE(gmm.Component(0).Covariance()(0, 0) == Approx(1.0).epsilon(0.3));
+  REQUIRE(gmm.Component(0).Covariance()(1, 1) == Approx(1.0).epsilon(0.3));
+}
+
 TEST_CASE("EigenvalueRatioConstraintTest", "[GMMTest]")
 {
   // Generate a list of eigenvalue ratios.
@@ -0,0 +1,177 @@
+/**
+ * @file tests/gradient_boosting_test.cpp
+ * @author Ryan Curtin
+ *
+ * Tests for the GradientBoosting class and its loss functions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/gradient_boosting/gradient_boosting.hpp>
+
+#include "serialization.hpp"
+#include "test_catch_tools.hpp"
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::gradient_boosting;
+
+/**
+ * The squared error loss should produce the residuals as Newton targets and
+ * the mean as the initial score.
+ */
+TEST_CASE("SquaredErrorLossTest", "[GradientBoostingTest]")
+{
+  arma::rowvec responses("1.0 3.0 5.0");
+  arma::rowvec scores("2.0 2.0 2.0");
+
+  REQUIRE(SquaredErrorLoss::InitialScore(responses) == Approx(3.0));
+
+  arma::rowvec gradients, hessians;
+  SquaredErrorLoss::GradientsAndHessians(responses, scores, gradients,
+      hessians);
+
+  // The gradient is the (negated) residual and the Hessian is constant.
+  REQUIRE(gradients[0] == Approx(1.0));
+  REQUIRE(gradients[1] == Approx(-1.0));
+  REQUIRE(gradients[2] == Approx(-3.0));
+  for (size_t i = 0; i < 3; ++i)
+    REQUIRE(hessians[i] == Approx(1.0));
+
+  // The loss is the mean squared error: (1 + 1 + 9) / 3.
+  REQUIRE(SquaredErrorLoss::Evaluate(responses, scores) ==
+      Approx(11.0 / 3.0));
+}
+
+/**
+ * The logistic loss should map raw scores to probabilities and produce
+ * gradients p - y.
+ */
+TEST_CASE("LogisticLossTest", "[GradientBoostingTest]")
+{
+  // At a raw score of zero the probability is one half.
+  REQUIRE(LogisticLoss::Transform(0.0) == Approx(0.5));
+
+  // A balanced dataset starts from log-odds zero.
+  arma::rowvec responses("0.0 1.0 0.0 1.0");
+  REQUIRE(LogisticLoss::InitialScore(responses) == Approx(0.0).margin(1e-10));
+
+  arma::rowvec scores(4, arma::fill::zeros);
+  arma::rowvec gradients, hessians;
+  LogisticLoss::GradientsAndHessians(responses, scores, gradients, hessians);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    REQUIRE(gradients[i] == Approx(0.5 - responses[i]));
+    REQUIRE(hessians[i] == Approx(0.25));
+  }
+
+  // At probability one half the negative log-likelihood is log(2).
+  REQUIRE(LogisticLoss::Evaluate(responses, scores) ==
+      Approx(std::log(2.0)));
+}
+
+/**
+ * The ensemble should fit a noiseless linear response closely, and more
+ * boosting rounds should not increase the training loss.
+ */
+TEST_CASE("GradientBoostingRegressionTest", "[GradientBoostingTest]")
+{
+  arma::mat dataset(3, 1000, arma::fill::randu);
+  arma::rowvec responses = 2.0 * dataset.row(0) - dataset.row(1) +
+      3.0 * dataset.row(2);
+
+  GradientBoosting<> gb;
+  const double lossFew = gb.Train(dataset, responses, 10, 0.1, 5);
+  const double lossMany = gb.Train(dataset, responses, 100, 0.1, 5);
+
+  REQUIRE(lossMany <= lossFew);
+  REQUIRE(gb.NumTrees() == 100);
+
+  arma::rowvec predictions;
+  gb.Predict(dataset, predictions);
+
+  const double mse = arma::mean(arma::square(predictions - responses));
+  REQUIRE(mse < 0.1);
+
+  // The batch predictions must agree with the single-point overload.
+  for (size_t i = 0; i < 50; ++i)
+    REQUIRE(predictions[i] == Approx(gb.Predict(dataset.col(i))));
+}
+
+/**
+ * With the logistic loss the ensemble should separate two well-separated
+ * clusters and output probabilities on the correct side of one half.
+ */
+TEST_CASE("GradientBoostingClassificationTest", "[GradientBoostingTest]")
+{
+  arma::mat dataset(2, 500, arma::fill::randu);
+  arma::rowvec responses(500);
+  for (size_t i = 250; i < 500; ++i)
+    dataset.col(i) += 5.0;
+  responses.subvec(0, 249).zeros();
+  responses.subvec(250, 499).ones();
+
+  GradientBoosting<LogisticLoss> gb(dataset, responses, 25, 0.3, 5);
+
+  arma::Row<size_t> predictions;
+  gb.Classify(dataset, predictions);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < 500; ++i)
+    if (predictions[i] == (size_t) responses[i])
+      ++correct;
+
+  REQUIRE(correct > 490);
+
+  // Predict() must return probabilities for the logistic loss.
+  arma::rowvec probabilities;
+  gb.Predict(dataset, probabilities);
+  for (size_t i = 0; i < 500; ++i)
+  {
+    REQUIRE(probabilities[i] >= 0.0);
+    REQUIRE(probabilities[i] <= 1.0);
+  }
+}
+
+/**
+ * Predict() should throw if the ensemble has not been trained.
+ */
+TEST_CASE("GradientBoostingEmptyPredictTest", "[GradientBoostingTest]")
+{
+  GradientBoosting<> gb;
+  arma::mat dataset(3, 10, arma::fill::randu);
+  arma::rowvec predictions;
+
+  REQUIRE_THROWS_AS(gb.Predict(dataset.col(0)), std::invalid_argument);
+  REQUIRE_THROWS_AS(gb.Predict(dataset, predictions), std::invalid_argument);
+}
+
+/**
+ * A serialized and deserialized ensemble should produce identical predictions.
+ */
+TEST_CASE("GradientBoostingSerializationTest", "[GradientBoostingTest]")
+{
+  arma::mat dataset(3, 500, arma::fill::randu);
+  arma::rowvec responses = dataset.row(0) + 2.0 * dataset.row(2);
+
+  GradientBoosting<> gb(dataset, responses, 20, 0.1, 5);
+
+  GradientBoosting<> xmlGb, jsonGb, binaryGb;
+  SerializeObjectAll(gb, xmlGb, jsonGb, binaryGb);
+
+  REQUIRE(xmlGb.NumTrees() == gb.NumTrees());
+  REQUIRE(jsonGb.NumTrees() == gb.NumTrees());
+  REQUIRE(binaryGb.NumTrees() == gb.NumTrees());
+
+  arma::rowvec predictions, xmlPredictions, jsonPredictions, binaryPredictions;
+  gb.Predict(dataset, predictions);
+  xmlGb.Predict(dataset, xmlPredictions);
+  jsonGb.Predict(dataset, jsonPredictions);
+  binaryGb.Predict(dataset, binaryPredictions);
+
+  CheckMatrices(predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+}
@@ -10,6 +10,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/hmm/hmm.hpp>
+#include <mlpack/methods/hmm/streaming_hmm.hpp>
 #include <mlpack/methods/gmm/gmm.hpp>
 #include <mlpack/methods/gmm/diagonal_gmm.hpp>
 
@@ -2109,3 +2110,78 @@ TEST_CASE("DiagonalGMMHMMLoadSaveTest", "[HMMTest]")
     }
   }
 }
+
+/**
+ * The streaming decoder should reproduce batch Filter(), Smooth(), and
+ * Predict() results when it is given enough lag.
+ */
+TEST_CASE("StreamingHMMTest", "[HMMTest]")
+{
+  // Two states with well-separated Gaussian emissions, so that fixed-lag
+  // estimates are effectively identical to full-sequence estimates.
+  HMM<GaussianDistribution> hmm(2, GaussianDistribution(1));
+  hmm.Initial() = arma::vec("0.6 0.4");
+  hmm.Transition() = arma::mat("0.9 0.2; 0.1 0.8");
+  hmm.Emission()[0] = GaussianDistribution("0.0", "0.5");
+  hmm.Emission()[1] = GaussianDistribution("10.0", "0.5");
+
+  arma::mat obs;
+  arma::Row<size_t> hiddenStates;
+  hmm.Generate(100, obs, hiddenStates);
+  const size_t seqLength = obs.n_cols;
+
+  // Batch results to compare against.
+  arma::mat batchFilter;
+  arma::mat batchSmooth;
+  arma::Row<size_t> batchStates;
+  hmm.Filter(obs, batchFilter);
+  hmm.Smooth(obs, batchSmooth);
+  hmm.Predict(obs, batchStates);
+  const double batchLogLik = hmm.LogLikelihood(obs);
+
+  // Zero-lag streaming filtering must match the batch filter.
+  StreamingHMM<GaussianDistribution> filterStream(hmm, 0);
+  arma::vec streamOutput;
+  for (size_t t = 0; t < seqLength; ++t)
+  {
+    filterStream.Push(obs.unsafe_col(t));
+    filterStream.FilteredOutput(streamOutput);
+    REQUIRE(streamOutput[0] ==
+        Approx(batchFilter(0, t)).epsilon(1e-7).margin(1e-7));
+  }
+  REQUIRE(filterStream.LogLikelihood() == Approx(batchLogLik).epsilon(1e-7));
+
+  // With lag covering the whole sequence, the smoothed output and decoded
+  // state at time 0 coincide exactly with the batch results.
+  StreamingHMM<GaussianDistribution> fullLagStream(hmm, seqLength - 1);
+  for (size_t t = 0; t < seqLength; ++t)
+    fullLagStream.Push(obs.unsafe_col(t));
+  fullLagStream.SmoothedOutput(streamOutput);
+  REQUIRE(streamOutput[0] ==
+      Approx(batchSmooth(0, 0)).epsilon(1e-7).margin(1e-7));
+  REQUIRE(fullLagStream.PredictAtLag() == batchStates[0]);
+
+  // With a moderate lag, the bounded-lag outputs should agree with the batch
+  // results everywhere, since the emissions pin down the states.
+  const size_t lag = 10;
+  StreamingHMM<GaussianDistribution> lagStream(hmm, lag);
+  for (size_t t = 0; t < seqLength; ++t)
+  {
+    lagStream.Push(obs.unsafe_col(t));
+    if (t >= lag)
+    {
+      REQUIRE(lagStream.PredictAtLag() == batchStates[t - lag]);
+      lagStream.SmoothedOutput(streamOutput);
+      REQUIRE(streamOutput[0] ==
+          Approx(batchSmooth(0, t - lag)).epsilon(1e-5).margin(1e-5));
+    }
+  }
+
+  // After a reset, the decoder should treat new data as a fresh stream.
+  filterStream.Reset();
+  REQUIRE(filterStream.StreamLength() == 0);
+  filterStream.Push(obs.unsafe_col(0));
+  filterStream.FilteredOutput(streamOutput);
+  REQUIRE(streamOutput[0] ==
+      Approx(batchFilter(0, 0)).epsilon(1e-7).margin(1e-7));
+}
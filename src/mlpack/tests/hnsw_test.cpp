@@ -0,0 +1,107 @@
+/**
+ * @file tests/hnsw_test.cpp
+ *
+ * Tests for the HNSW approximate nearest neighbor index.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/hnsw/hnsw.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+#include "serialization.hpp"
+
+using namespace mlpack;
+using namespace mlpack::neighbor;
+
+/**
+ * The index should return results in the right format, with sane distances.
+ */
+TEST_CASE("HNSWBasicTest", "[HNSWTest]")
+{
+  arma::mat referenceSet(8, 300, arma::fill::randu);
+  arma::mat querySet(8, 50, arma::fill::randu);
+
+  HNSW<> hnsw(referenceSet);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(querySet, 3, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 3);
+  REQUIRE(neighbors.n_cols == 50);
+  REQUIRE(distances.n_rows == 3);
+  REQUIRE(distances.n_cols == 50);
+
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      REQUIRE(neighbors(j, i) < referenceSet.n_cols);
+      // Results must be sorted by increasing distance.
+      if (j > 0)
+        REQUIRE(distances(j, i) >= distances(j - 1, i));
+    }
+  }
+}
+
+/**
+ * With a generous beam width, recall against the exact answer should be high.
+ */
+TEST_CASE("HNSWRecallTest", "[HNSWTest]")
+{
+  arma::mat referenceSet(8, 1000, arma::fill::randu);
+  arma::mat querySet(8, 100, arma::fill::randu);
+  const size_t k = 5;
+
+  HNSW<> hnsw(referenceSet, 16, 200, 128);
+
+  arma::Mat<size_t> approxNeighbors, exactNeighbors;
+  arma::mat approxDistances, exactDistances;
+  hnsw.Search(querySet, k, approxNeighbors, approxDistances);
+
+  KNN exact(referenceSet);
+  exact.Search(querySet, k, exactNeighbors, exactDistances);
+
+  size_t hits = 0;
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+      for (size_t l = 0; l < k; ++l)
+        if (approxNeighbors(j, i) == exactNeighbors(l, i))
+        {
+          ++hits;
+          break;
+        }
+  }
+
+  const double recall = (double) hits / (double) (k * querySet.n_cols);
+  REQUIRE(recall >= 0.7);
+}
+
+/**
+ * A serialized and reloaded index must give identical results.
+ */
+TEST_CASE("HNSWSerializationTest", "[HNSWTest]")
+{
+  arma::mat referenceSet(5, 200, arma::fill::randu);
+  arma::mat querySet(5, 20, arma::fill::randu);
+
+  HNSW<> hnsw(referenceSet);
+
+  HNSW<> binaryCopy, xmlCopy, jsonCopy;
+  SerializeObjectAll(hnsw, xmlCopy, jsonCopy, binaryCopy);
+
+  arma::Mat<size_t> neighbors, binaryNeighbors;
+  arma::mat distances, binaryDistances;
+  hnsw.Search(querySet, 3, neighbors, distances);
+  binaryCopy.Search(querySet, 3, binaryNeighbors, binaryDistances);
+
+  CheckMatrices(neighbors, binaryNeighbors);
+  CheckMatrices(distances, binaryDistances);
+}
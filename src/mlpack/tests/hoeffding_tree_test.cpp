@@ -1475,3 +1475,86 @@ TEST_CASE("HoeffdingTreeModelSerializationTest", "[HoeffdingTreeTest]")
     }
   }
 }
+
+/**
+ * Streaming a block of samples through Train() routes them to the leaves in
+ * one pass; make sure this builds exactly the same tree as feeding the same
+ * samples through the root one at a time.
+ */
+TEST_CASE("StreamingBlockIngestionEquivalenceTest", "[HoeffdingTreeTest]")
+{
+  // Two separable Gaussian classes in three dimensions.
+  arma::mat dataset(3, 6000, arma::fill::randn);
+  arma::Row<size_t> labels(6000);
+  for (size_t i = 0; i < 6000; ++i)
+  {
+    labels[i] = i % 2;
+    if (labels[i] == 1)
+      dataset.col(i) += 3.0;
+  }
+
+  data::DatasetInfo info(3);
+
+  // Build two identical trees on the first half of the data.
+  HoeffdingTree<> pointTree(dataset.cols(0, 2999), info,
+      labels.subvec(0, 2999), 2, true);
+  HoeffdingTree<> blockTree(dataset.cols(0, 2999), info,
+      labels.subvec(0, 2999), 2, true);
+
+  // Now stream the second half: one point at a time into the first tree, and
+  // as a single block into the second.
+  for (size_t i = 3000; i < 6000; ++i)
+    pointTree.Train(dataset.col(i), labels[i]);
+
+  arma::mat secondBlock = dataset.cols(3000, 5999);
+  arma::Row<size_t> secondLabels = labels.subvec(3000, 5999);
+  blockTree.Train(secondBlock, secondLabels, false);
+
+  // The two trees must agree on everything.
+  REQUIRE(pointTree.NumDescendants() == blockTree.NumDescendants());
+  for (size_t i = 0; i < 6000; ++i)
+    REQUIRE(pointTree.Classify(dataset.col(i)) ==
+        blockTree.Classify(dataset.col(i)));
+}
+
+/**
+ * A prediction-only snapshot must classify exactly like the tree it was taken
+ * from, even after the original keeps training.
+ */
+TEST_CASE("SnapshotPredictorTest", "[HoeffdingTreeTest]")
+{
+  arma::mat dataset(3, 4000, arma::fill::randn);
+  arma::Row<size_t> labels(4000);
+  for (size_t i = 0; i < 4000; ++i)
+  {
+    labels[i] = i % 2;
+    if (labels[i] == 1)
+      dataset.col(i) += 3.0;
+  }
+
+  data::DatasetInfo info(3);
+  HoeffdingTree<> tree(dataset.cols(0, 1999), info, labels.subvec(0, 1999), 2,
+      true);
+
+  HoeffdingTree<> snapshot;
+  tree.SnapshotPredictor(snapshot);
+
+  REQUIRE(snapshot.NumDescendants() == tree.NumDescendants());
+  for (size_t i = 0; i < 4000; ++i)
+  {
+    size_t treePrediction, snapshotPrediction;
+    double treeProbability, snapshotProbability;
+    tree.Classify(dataset.col(i), treePrediction, treeProbability);
+    snapshot.Classify(dataset.col(i), snapshotPrediction,
+        snapshotProbability);
+
+    REQUIRE(treePrediction == snapshotPrediction);
+    REQUIRE(treeProbability == Approx(snapshotProbability));
+  }
+
+  // Continue training the original; the snapshot must be unaffected.
+  const size_t snapshotSize = snapshot.NumDescendants();
+  for (size_t i = 2000; i < 4000; ++i)
+    tree.Train(dataset.col(i), labels[i]);
+  REQUIRE(snapshot.NumDescendants() == snapshotSize);
+}
@@ -156,4 +156,41 @@ TEST_CASE("ImageInfoSerialization", "[ImageLoadTest]")
   REQUIRE(info.Quality() == binaryInfo.Quality());
 }
 
+/**
+ * Test that presetting a resolution in ImageInfo resamples the loaded image,
+ * both for a single file and for a batch.
+ */
+TEST_CASE("LoadImageResampleTest", "[ImageLoadTest]")
+{
+  arma::Mat<unsigned char> matrix;
+  data::ImageInfo info(25, 25, 3);
+
+  REQUIRE(data::Load("test_image.png", matrix, info, false) == true);
+  // width * height * channels.
+  REQUIRE(matrix.n_rows == 25 * 25 * 3);
+  REQUIRE(matrix.n_cols == 1);
+  REQUIRE(info.Width() == 25);
+  REQUIRE(info.Height() == 25);
+  REQUIRE(info.Channels() == 3);
+
+  // Every file of the batch is downscaled to the preset resolution.
+  arma::Mat<unsigned char> batch;
+  data::ImageInfo batchInfo(25, 25, 3);
+  std::vector<std::string> files = {"test_image.png", "test_image.png",
+      "test_image.png"};
+
+  REQUIRE(data::Load(files, batch, batchInfo, false) == true);
+  REQUIRE(batch.n_rows == 25 * 25 * 3);
+  REQUIRE(batch.n_cols == 3);
+
+  // The columns come from the same source image, so they must be identical,
+  // and they must match the single-file load.
+  for (size_t i = 0; i < batch.n_rows; ++i)
+  {
+    REQUIRE(batch(i, 0) == matrix(i, 0));
+    REQUIRE(batch(i, 1) == matrix(i, 0));
+    REQUIRE(batch(i, 2) == matrix(i, 0));
+  }
+}
+
 #endif // HAS_STB.
@@ -313,3 +313,46 @@ TEST_CASE("DatasetMapperPointerMapping", "[ImputationTest]")
   REQUIRE(dm.UnmapString(1, 0) == &b);
   REQUIRE(dm.UnmapString(2, 0) == &c);
 }
+
+/**
+ * Make sure the fused multi-dimension imputation overloads give the same
+ * results as imputing each dimension on its own.
+ */
+TEST_CASE("MultipleDimensionImputationTest", "[ImputationTest]")
+{
+  arma::mat input("3.0 0.0 2.0 0.0;"
+                  "5.0 6.0 0.0 6.0;"
+                  "9.0 8.0 4.0 8.0;");
+  arma::mat rowWiseInput(input.t());
+  const double mappedValue = 0.0;
+
+  std::vector<double> mappedValues(2, mappedValue);
+  std::vector<size_t> dimensions;
+  dimensions.push_back(0);
+  dimensions.push_back(1);
+
+  // Get the reference result by imputing each dimension separately.
+  arma::mat expected(input);
+  MeanImputation<double> imputer;
+  imputer.Impute(expected, mappedValue, 0, true);
+  imputer.Impute(expected, mappedValue, 1, true);
+
+  // Column-wise fused imputation.
+  imputer.Impute(input, mappedValues, dimensions, true);
+  CheckMatrices(input, expected);
+
+  // Row-wise fused imputation of the transposed data must agree too.
+  imputer.Impute(rowWiseInput, mappedValues, dimensions, false);
+  CheckMatrices(rowWiseInput, arma::mat(expected.t()));
+
+  // The median strategy shares the multi-dimension interface.
+  arma::mat medianInput("3.0 0.0 2.0 0.0;"
+                        "5.0 6.0 0.0 6.0;"
+                        "9.0 8.0 4.0 8.0;");
+  arma::mat medianExpected(medianInput);
+  MedianImputation<double> medianImputer;
+  medianImputer.Impute(medianExpected, mappedValue, 0, true);
+  medianImputer.Impute(medianExpected, mappedValue, 1, true);
+  medianImputer.Impute(medianInput, mappedValues, dimensions, true);
+  CheckMatrices(medianInput, medianExpected);
+}
@@ -1297,3 +1297,67 @@ TEST_CASE("GaussianBreadthDualKDTreeMonteCarloKDE", "[KDETest]")
 
   REQUIRE(correctResults > 70);
 }
+
+/**
+ * Test that evaluating several bandwidths with a shared traversal matches
+ * separate monochromatic evaluations of each bandwidth.
+ */
+TEST_CASE("KDEMultiBandwidthTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 300);
+  const std::vector<double> bandwidths = {0.2, 0.5, 1.0, 2.5};
+  const double relError = 0.01;
+
+  for (const KDEMode mode : {KDEMode::DUAL_TREE_MODE, KDEMode::SINGLE_TREE_MODE})
+  {
+    KDE<GaussianKernel, metric::EuclideanDistance, arma::mat, tree::KDTree>
+        kde(relError, 0.0, GaussianKernel(), mode);
+    kde.Train(reference);
+
+    // Shared-traversal estimation of all bandwidths.
+    arma::mat multiEstimations;
+    kde.EvaluateBandwidths(bandwidths, multiEstimations);
+    REQUIRE(multiEstimations.n_rows == bandwidths.size());
+    REQUIRE(multiEstimations.n_cols == reference.n_cols);
+
+    // Compare against a separate evaluation of each bandwidth.
+    for (size_t k = 0; k < bandwidths.size(); ++k)
+    {
+      KDE<GaussianKernel, metric::EuclideanDistance, arma::mat, tree::KDTree>
+          singleKDE(relError, 0.0, GaussianKernel(bandwidths[k]), mode);
+      singleKDE.Train(reference);
+      arma::vec singleEstimations;
+      singleKDE.Evaluate(singleEstimations);
+
+      for (size_t i = 0; i < reference.n_cols; ++i)
+      {
+        REQUIRE(multiEstimations(k, i) ==
+            Approx(singleEstimations(i)).epsilon(2 * relError));
+      }
+    }
+  }
+}
+
+/**
+ * Test that bandwidth selection by leave-one-out likelihood picks a sensible
+ * candidate and rejects extreme bandwidths.
+ */
+TEST_CASE("KDESelectBandwidthTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 400);
+  // The tiny bandwidth heavily undersmooths and the huge one oversmooths, so
+  // the reasonable bandwidth should win the leave-one-out likelihood.
+  const std::vector<double> bandwidths = {1e-4, 0.3, 100.0};
+
+  KDE<GaussianKernel, metric::EuclideanDistance, arma::mat, tree::KDTree>
+      kde(0.01, 0.0, GaussianKernel());
+  kde.Train(reference);
+
+  arma::vec logLikelihoods;
+  const double best = kde.SelectBandwidth(bandwidths, logLikelihoods);
+
+  REQUIRE(logLikelihoods.n_elem == bandwidths.size());
+  REQUIRE(best == bandwidths[1]);
+  REQUIRE(logLikelihoods(1) > logLikelihoods(0));
+  REQUIRE(logLikelihoods(1) > logLikelihoods(2));
+}
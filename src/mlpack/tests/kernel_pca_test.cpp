@@ -12,6 +12,8 @@
 #include <mlpack/core.hpp>
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
 #include <mlpack/methods/kernel_pca/kernel_rules/nystroem_method.hpp>
+#include <mlpack/methods/kernel_pca/kernel_rules/randomized_method.hpp>
+#include <mlpack/methods/kernel_pca/kernel_rules/block_krylov_method.hpp>
 #include <mlpack/methods/kernel_pca/kernel_pca.hpp>
 
 #include "catch.hpp"
@@ -147,3 +149,56 @@ TEST_CASE("CircleTransformationTestNystroem", "[KernelPCATest]")
   REQUIRE(ranges[0].Contains(ranges[2]) == false);
   REQUIRE(ranges[1].Contains(ranges[2]) == false);
 }
+
+/**
+ * The randomized and block Krylov kernel rules compute only the leading
+ * eigenpairs; these should agree with the leading eigenpairs from the naive
+ * rule's full eigendecomposition.
+ */
+TEST_CASE("PartialEigendecompositionKernelRuleTest", "[KernelPCATest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 300);
+
+  const size_t rank = 4;
+  GaussianKernel kernel(1.0);
+
+  arma::mat naiveTransformed, naiveEigvec;
+  arma::vec naiveEigval;
+  NaiveKernelRule<GaussianKernel>::ApplyKernelMatrix(dataset,
+      naiveTransformed, naiveEigval, naiveEigvec, rank, kernel);
+
+  arma::mat randTransformed, randEigvec;
+  arma::vec randEigval;
+  RandomizedKernelRule<GaussianKernel>::ApplyKernelMatrix(dataset,
+      randTransformed, randEigval, randEigvec, rank, kernel);
+
+  arma::mat krylovTransformed, krylovEigvec;
+  arma::vec krylovEigval;
+  BlockKrylovKernelRule<GaussianKernel>::ApplyKernelMatrix(dataset,
+      krylovTransformed, krylovEigval, krylovEigvec, rank, kernel);
+
+  // Only the requested number of eigenpairs should have been computed.
+  REQUIRE(randEigval.n_elem == rank);
+  REQUIRE(randTransformed.n_rows == rank);
+  REQUIRE(krylovEigval.n_elem == rank);
+  REQUIRE(krylovTransformed.n_rows == rank);
+
+  // The leading eigenvalues should match the naive rule's (randomized
+  // methods are approximate, so use a loose tolerance).
+  for (size_t i = 0; i < rank; ++i)
+  {
+    REQUIRE(randEigval[i] == Approx(naiveEigval[i]).epsilon(1e-3));
+    REQUIRE(krylovEigval[i] == Approx(naiveEigval[i]).epsilon(1e-3));
+  }
+
+  // Projections should match up to sign (eigenvector signs are arbitrary).
+  for (size_t i = 0; i < rank; ++i)
+  {
+    const double dot = arma::dot(randTransformed.row(i),
+        naiveTransformed.row(i));
+    const double sign = (dot < 0.0) ? -1.0 : 1.0;
+    REQUIRE(arma::norm(sign * randTransformed.row(i) -
+        naiveTransformed.row(i)) == Approx(0.0).margin(1e-3 *
+        arma::norm(naiveTransformed.row(i))));
+  }
+}
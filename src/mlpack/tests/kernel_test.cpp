@@ -20,6 +20,10 @@
 #include <mlpack/core/kernels/spherical_kernel.hpp>
 #include <mlpack/core/kernels/pspectrum_string_kernel.hpp>
 #include <mlpack/core/kernels/cauchy_kernel.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
+#include <mlpack/core/metrics/cosine_distance_metric.hpp>
+#include <mlpack/core/metrics/factored_mahalanobis_distance.hpp>
+#include <mlpack/core/metrics/ip_metric.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/metrics/mahalanobis_distance.hpp>
 
@@ -117,6 +121,37 @@ TEST_CASE("LMetricZerosTest", "[KernelTest]")
   REQUIRE(LMetric<5, true>::Evaluate(a, a) == 0);
 }
 
+/**
+ * The fixed-dimensionality metric must agree with the general LMetric for a
+ * few powers, with and without the root, on 2- and 3-dimensional points.
+ */
+TEST_CASE("FixedDimLMetricTest", "[KernelTest]")
+{
+  for (size_t trial = 0; trial < 10; ++trial)
+  {
+    arma::vec a2(2, arma::fill::randn);
+    arma::vec b2(2, arma::fill::randn);
+    arma::vec a3(3, arma::fill::randn);
+    arma::vec b3(3, arma::fill::randn);
+
+    REQUIRE(Euclidean2DDistance::Evaluate(a2, b2) ==
+        Approx(EuclideanDistance::Evaluate(a2, b2)).epsilon(1e-7));
+    REQUIRE(Euclidean3DDistance::Evaluate(a3, b3) ==
+        Approx(EuclideanDistance::Evaluate(a3, b3)).epsilon(1e-7));
+
+    REQUIRE((FixedDimLMetric<2, 2, false>::Evaluate(a2, b2)) ==
+        Approx(SquaredEuclideanDistance::Evaluate(a2, b2)).epsilon(1e-7));
+    REQUIRE((FixedDimLMetric<3, 1, false>::Evaluate(a3, b3)) ==
+        Approx(ManhattanDistance::Evaluate(a3, b3)).epsilon(1e-7));
+    REQUIRE((FixedDimLMetric<3, 3, true>::Evaluate(a3, b3)) ==
+        Approx((LMetric<3, true>::Evaluate(a3, b3))).epsilon(1e-7));
+  }
+
+  // Zero distance for identical points.
+  arma::vec z(2, arma::fill::randu);
+  REQUIRE(Euclidean2DDistance::Evaluate(z, z) == Approx(0.0).margin(1e-15));
+}
+
 /**
  * Simple test of Mahalanobis distance with unset covariance matrix in
  * constructor.
@@ -632,3 +667,276 @@ TEST_CASE("CauchyKernelTest", "[KernelTest]")
   REQUIRE(ck.Evaluate(a, b) == Approx(0.92592588).epsilon(1e-7));
   REQUIRE(ck.Evaluate(b, a) == Approx(0.92592588).epsilon(1e-7));
 }
+
+/**
+ * Test that batched kernel evaluation through KernelMatrix() matches pairwise
+ * evaluation, both for kernels with a batched Evaluate() overload and for
+ * kernels using the pairwise fallback.
+ */
+TEST_CASE("KernelMatrixTest", "[KernelTest]")
+{
+  arma::mat a = arma::randu<arma::mat>(4, 60);
+  arma::mat b = arma::randu<arma::mat>(4, 35);
+
+  // Kernels with batched overloads.
+  {
+    GaussianKernel gk(1.3);
+    arma::mat k;
+    KernelMatrix(gk, a, b, k);
+    REQUIRE(k.n_rows == a.n_cols);
+    REQUIRE(k.n_cols == b.n_cols);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      for (size_t i = 0; i < a.n_cols; ++i)
+        REQUIRE(k(i, j) ==
+            Approx(gk.Evaluate(a.col(i), b.col(j))).epsilon(1e-10));
+  }
+
+  {
+    LaplacianKernel lk(0.8);
+    arma::mat k;
+    KernelMatrix(lk, a, b, k);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      for (size_t i = 0; i < a.n_cols; ++i)
+        REQUIRE(k(i, j) ==
+            Approx(lk.Evaluate(a.col(i), b.col(j))).epsilon(1e-10));
+  }
+
+  {
+    LinearKernel lk;
+    arma::mat k;
+    KernelMatrix(lk, a, b, k);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      for (size_t i = 0; i < a.n_cols; ++i)
+        REQUIRE(k(i, j) ==
+            Approx(lk.Evaluate(a.col(i), b.col(j))).epsilon(1e-10));
+  }
+
+  {
+    PolynomialKernel pk(3.0, 0.5);
+    arma::mat k;
+    KernelMatrix(pk, a, b, k);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      for (size_t i = 0; i < a.n_cols; ++i)
+        REQUIRE(k(i, j) ==
+            Approx(pk.Evaluate(a.col(i), b.col(j))).epsilon(1e-10));
+  }
+
+  // A kernel without a batched overload exercises the pairwise fallback.
+  {
+    CauchyKernel ck(2.0);
+    arma::mat k;
+    KernelMatrix(ck, a, b, k);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      for (size_t i = 0; i < a.n_cols; ++i)
+        REQUIRE(k(i, j) ==
+            Approx(ck.Evaluate(a.col(i), b.col(j))).epsilon(1e-10));
+  }
+}
+
+/**
+ * Test that the tiled symmetric Gram builder agrees with pairwise evaluation
+ * and produces an exactly symmetric matrix, using a block size small enough
+ * to exercise diagonal, off-diagonal, and ragged edge tiles.
+ */
+TEST_CASE("SymmetricKernelMatrixTest", "[KernelTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(6, 53);
+
+  {
+    GaussianKernel gk(0.9);
+    arma::mat k;
+    SymmetricKernelMatrix(gk, data, k, 16);
+    REQUIRE(k.n_rows == data.n_cols);
+    REQUIRE(k.n_cols == data.n_cols);
+    for (size_t j = 0; j < data.n_cols; ++j)
+    {
+      for (size_t i = 0; i <= j; ++i)
+      {
+        REQUIRE(k(i, j) ==
+            Approx(gk.Evaluate(data.col(i), data.col(j))).epsilon(1e-10));
+        REQUIRE(k(i, j) == k(j, i));
+      }
+    }
+  }
+
+  // A kernel without a batched overload goes through the pairwise fallback
+  // inside each tile.
+  {
+    CauchyKernel ck(1.5);
+    arma::mat k;
+    SymmetricKernelMatrix(ck, data, k, 16);
+    for (size_t j = 0; j < data.n_cols; ++j)
+    {
+      for (size_t i = 0; i <= j; ++i)
+      {
+        REQUIRE(k(i, j) ==
+            Approx(ck.Evaluate(data.col(i), data.col(j))).epsilon(1e-10));
+        REQUIRE(k(i, j) == k(j, i));
+      }
+    }
+  }
+}
+
+/**
+ * IPMetric evaluations with cached self-kernels must exactly match the
+ * uncached evaluations, both for cached columns and for unrelated points.
+ */
+TEST_CASE("IPMetricCachedSelfKernelTest", "[KernelTest]")
+{
+  arma::mat dataset(5, 50, arma::fill::randu);
+
+  GaussianKernel gk(1.3);
+  IPMetric<GaussianKernel> cached(gk);
+  IPMetric<GaussianKernel> uncached(gk);
+
+  cached.PrecomputeSelfKernels(dataset);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 10; ++j)
+    {
+      REQUIRE(cached.Evaluate(dataset.col(i), dataset.col(j)) ==
+          Approx(uncached.Evaluate(dataset.col(i), dataset.col(j)))
+          .epsilon(1e-10));
+    }
+  }
+
+  // Points that are not columns of the cached dataset miss the cache and are
+  // computed directly.
+  arma::vec a(5, arma::fill::randu);
+  REQUIRE(cached.Evaluate(a, dataset.col(3)) ==
+      Approx(uncached.Evaluate(a, dataset.col(3))).epsilon(1e-10));
+
+  // Clearing the cache must not change any results either.
+  cached.ClearSelfKernels();
+  REQUIRE(cached.Evaluate(dataset.col(0), dataset.col(1)) ==
+      Approx(uncached.Evaluate(dataset.col(0), dataset.col(1)))
+      .epsilon(1e-10));
+}
+
+/**
+ * Basic correctness of the cosine distance metric: parallel, orthogonal, and
+ * opposite vectors, plus the zero-vector convention.
+ */
+TEST_CASE("CosineDistanceMetricTest", "[KernelTest]")
+{
+  CosineDistanceMetric d;
+
+  arma::vec a = "1.0 0.0";
+  arma::vec b = "2.0 0.0";
+  arma::vec c = "0.0 3.0";
+  arma::vec e = "-1.0 0.0";
+  arma::vec z = "0.0 0.0";
+
+  REQUIRE(d.Evaluate(a, b) == Approx(0.0).margin(1e-10));
+  REQUIRE(d.Evaluate(a, c) == Approx(1.0).epsilon(1e-7));
+  REQUIRE(d.Evaluate(a, e) == Approx(2.0).epsilon(1e-7));
+  REQUIRE(d.Evaluate(a, z) == Approx(1.0).epsilon(1e-7));
+  REQUIRE(d.Evaluate(z, z) == Approx(1.0).epsilon(1e-7));
+}
+
+/**
+ * Cosine distance evaluations with cached norms must match the uncached
+ * evaluations, and agree with the CosineDistance kernel.
+ */
+TEST_CASE("CosineDistanceMetricCachedNormsTest", "[KernelTest]")
+{
+  arma::mat dataset(6, 40, arma::fill::randn);
+
+  CosineDistanceMetric cached;
+  CosineDistanceMetric uncached;
+  cached.PrecomputeNorms(dataset);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 10; ++j)
+    {
+      const double expected = 1.0 -
+          CosineDistance::Evaluate(dataset.col(i), dataset.col(j));
+      REQUIRE(cached.Evaluate(dataset.col(i), dataset.col(j)) ==
+          Approx(expected).margin(1e-10));
+      REQUIRE(uncached.Evaluate(dataset.col(i), dataset.col(j)) ==
+          Approx(expected).margin(1e-10));
+    }
+  }
+}
+
+/**
+ * The factored Mahalanobis distance must match MahalanobisDistance when the
+ * factor L satisfies Q = L^T L, with and without the root, cached or not.
+ */
+TEST_CASE("FactoredMahalanobisDistanceTest", "[KernelTest]")
+{
+  arma::mat lFactor(4, 4, arma::fill::randn);
+  arma::mat q = lFactor.t() * lFactor;
+
+  FactoredMahalanobisDistance<true> fmd(lFactor);
+  FactoredMahalanobisDistance<false> fmdNoRoot(lFactor);
+  MahalanobisDistance<true> md(q);
+  MahalanobisDistance<false> mdNoRoot(q);
+
+  arma::mat dataset(4, 30, arma::fill::randn);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    for (size_t j = 0; j < 10; ++j)
+    {
+      REQUIRE(fmd.Evaluate(dataset.col(i), dataset.col(j)) ==
+          Approx(md.Evaluate(dataset.col(i), dataset.col(j))).margin(1e-10));
+      REQUIRE(fmdNoRoot.Evaluate(dataset.col(i), dataset.col(j)) ==
+          Approx(mdNoRoot.Evaluate(dataset.col(i), dataset.col(j)))
+          .margin(1e-10));
+    }
+  }
+
+  // Cached transformed points must not change any results.
+  fmd.PrecomputeTransformed(dataset);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    REQUIRE(fmd.Evaluate(dataset.col(i), dataset.col(i + 10)) ==
+        Approx(md.Evaluate(dataset.col(i), dataset.col(i + 10)))
+        .margin(1e-10));
+  }
+
+  // An empty factor behaves as the identity (Euclidean distance).
+  FactoredMahalanobisDistance<true> identity;
+  REQUIRE(identity.Evaluate(dataset.col(0), dataset.col(1)) ==
+      Approx(EuclideanDistance::Evaluate(dataset.col(0), dataset.col(1)))
+      .margin(1e-10));
+}
+
+/**
+ * FromCovariance() must recover a valid factor, and setting a new factor must
+ * invalidate the cached transformed points.
+ */
+TEST_CASE("FactoredMahalanobisDistanceUpdateTest", "[KernelTest]")
+{
+  // A well-conditioned covariance.
+  arma::mat lFactor(3, 3, arma::fill::randn);
+  arma::mat q = lFactor.t() * lFactor + 3.0 * arma::eye<arma::mat>(3, 3);
+
+  FactoredMahalanobisDistance<false> fmd =
+      FactoredMahalanobisDistance<false>::FromCovariance(q);
+  MahalanobisDistance<false> md(q);
+
+  arma::mat dataset(3, 20, arma::fill::randn);
+  fmd.PrecomputeTransformed(dataset);
+
+  REQUIRE(fmd.Evaluate(dataset.col(0), dataset.col(1)) ==
+      Approx(md.Evaluate(dataset.col(0), dataset.col(1))).margin(1e-10));
+
+  // After a factor update (as in an LMNN/NCA optimizer step), the stale cache
+  // must not be used: results must reflect the new factor.
+  arma::mat newFactor = 2.0 * arma::eye<arma::mat>(3, 3);
+  fmd.Factor(newFactor);
+
+  const double expected = 4.0 * SquaredEuclideanDistance::Evaluate(
+      dataset.col(0), dataset.col(1));
+  REQUIRE(fmd.Evaluate(dataset.col(0), dataset.col(1)) ==
+      Approx(expected).margin(1e-10));
+
+  // A non-positive-definite covariance must be refused.
+  arma::mat bad = -1.0 * arma::eye<arma::mat>(3, 3);
+  REQUIRE_THROWS_AS(
+      FactoredMahalanobisDistance<false>::FromCovariance(bad),
+      std::runtime_error);
+}
@@ -13,13 +13,17 @@
 #include <mlpack/methods/kmeans/allow_empty_clusters.hpp>
 #include <mlpack/methods/kmeans/refined_start.hpp>
 #include <mlpack/methods/kmeans/kmeans_plus_plus_initialization.hpp>
+#include <mlpack/methods/kmeans/streaming_kmeans_plus_plus.hpp>
 #include <mlpack/methods/kmeans/elkan_kmeans.hpp>
+#include <mlpack/methods/kmeans/mini_batch_kmeans.hpp>
 #include <mlpack/methods/kmeans/hamerly_kmeans.hpp>
 #include <mlpack/methods/kmeans/pelleg_moore_kmeans.hpp>
+#include <mlpack/methods/kmeans/hybrid_kmeans.hpp>
 #include <mlpack/methods/kmeans/dual_tree_kmeans.hpp>
 #include <mlpack/methods/kmeans/sample_initialization.hpp>
 #include <mlpack/methods/kmeans/random_partition.hpp>
 
+#include <mlpack/core/data/collapse_duplicates.hpp>
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
@@ -230,6 +234,72 @@ TEST_CASE("MaxVarianceNewClusterTest", "[KMeansTest]")
   REQUIRE(counts[2] == 1);
 }
 
+/**
+ * Make sure the max variance method gives the same result when it reuses the
+ * assignments and distances the Lloyd step computed, instead of recomputing
+ * them itself.
+ */
+TEST_CASE("MaxVarianceNewClusterCachedTest", "[KMeansTest]")
+{
+  arma::mat data;
+  data.randu(5, 200);
+
+  arma::mat centroids;
+  centroids.randu(5, 10);
+  // Cluster 7 is empty; mark it invalid so that no point can be closest to it.
+  centroids.col(7).fill(DBL_MAX);
+
+  metric::LMetric<2, true> metric;
+
+  // Compute the assignments and distances the way a Lloyd step would.
+  arma::Row<size_t> lloydAssignments(data.n_cols);
+  arma::vec lloydDistances(data.n_cols);
+  arma::Col<size_t> counts(centroids.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols;
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      if (j == 7)
+        continue; // Leave cluster 7 empty.
+
+      const double distance = metric.Evaluate(data.col(i), centroids.col(j));
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    lloydAssignments[i] = closestCluster;
+    lloydDistances[i] = minDistance;
+    ++counts[closestCluster];
+  }
+
+  // Run the policy once with cached information and once without, on copies of
+  // the same state.
+  arma::mat cachedCentroids(centroids);
+  arma::Col<size_t> cachedCounts(counts);
+  MaxVarianceNewCluster cachedMvnc;
+  cachedMvnc.EmptyCluster(data, 7, centroids, cachedCentroids, cachedCounts,
+      lloydAssignments, lloydDistances, metric, 0);
+
+  arma::mat uncachedCentroids(centroids);
+  arma::Col<size_t> uncachedCounts(counts);
+  MaxVarianceNewCluster uncachedMvnc;
+  uncachedMvnc.EmptyCluster(data, 7, centroids, uncachedCentroids,
+      uncachedCounts, metric, 0);
+
+  // The uncached run finds each point's closest centroid itself, but that must
+  // be exactly what we passed in, so the results have to be identical.
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    REQUIRE(cachedCounts[i] == uncachedCounts[i]);
+
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+    REQUIRE(cachedCentroids[i] == Approx(uncachedCentroids[i]).epsilon(1e-10));
+}
+
 /**
  * Make sure the random partitioner seems to return valid results.
  */
@@ -421,6 +491,84 @@ TEST_CASE("InitialAssignmentOverrideTest", "[KMeansTest]")
   REQUIRE(centroids(1, 1) > 40.0);
 }
 
+/**
+ * Make sure a progress token can observe the per-iteration residual and
+ * cancel a clustering before convergence.
+ */
+TEST_CASE("KMeansProgressTokenTest", "[KMeansTest]")
+{
+  arma::mat dataset(10, 1000);
+  dataset.randu();
+
+  // Cancel the clustering after three iterations.
+  size_t reports = 0;
+  util::ProgressToken token([&reports](const size_t /* iteration */,
+                                       const double objective)
+      {
+        REQUIRE(objective >= 0.0);
+        return (++reports < 3);
+      });
+
+  arma::mat centroids;
+  KMeans<> kmeans;
+  kmeans.Cluster(dataset, 20, centroids, false, &token);
+
+  // The callback must have been invoked exactly three times, with the last
+  // invocation cancelling the run; the centroids of the last completed
+  // iteration must still be returned.
+  REQUIRE(reports == 3);
+  REQUIRE(token.Cancelled());
+  REQUIRE(centroids.n_rows == 10);
+  REQUIRE(centroids.n_cols == 20);
+  REQUIRE(centroids.is_finite());
+}
+
+/**
+ * Make sure a clustering can be checkpointed mid-run and then resumed from
+ * the checkpoint.
+ */
+TEST_CASE("KMeansCheckpointTest", "[KMeansTest]")
+{
+  arma::mat dataset(10, 1000);
+  dataset.randu();
+
+  const std::string file = "kmeans_checkpoint_test.bin";
+  remove(file.c_str());
+
+  util::Checkpointer checkpoint(file, 1);
+
+  // First run: checkpoint every iteration and simulate preemption by
+  // cancelling after three iterations.
+  {
+    size_t reports = 0;
+    util::ProgressToken token([&reports](const size_t /* iteration */,
+                                         const double /* objective */)
+        { return (++reports < 3); });
+
+    arma::mat centroids;
+    KMeans<> kmeans;
+    kmeans.Cluster(dataset, 20, centroids, checkpoint, &token);
+  }
+
+  // The checkpoint must hold valid centroids.
+  arma::mat checkCentroids;
+  REQUIRE(checkpoint.Load(checkCentroids));
+  REQUIRE(checkCentroids.n_rows == 10);
+  REQUIRE(checkCentroids.n_cols == 20);
+  REQUIRE(checkCentroids.is_finite());
+
+  // Second run: resume from the checkpoint and run to convergence.
+  arma::mat centroids;
+  KMeans<> kmeans;
+  kmeans.Cluster(dataset, 20, centroids, checkpoint);
+
+  REQUIRE(centroids.n_rows == 10);
+  REQUIRE(centroids.n_cols == 20);
+  REQUIRE(centroids.is_finite());
+
+  remove(file.c_str());
+}
+
 /**
  * Test that the refined starting policy returns decent initial cluster
  * estimates.
@@ -553,6 +701,66 @@ TEST_CASE("KMeansPlusPlusTest", "[KMeansTest]")
   REQUIRE(distortion < 14500.0);
 }
 
+/**
+ * Test that the streaming k-means++ over-seeding strategy returns decent
+ * initial cluster estimates while only seeding from a reservoir sample.
+ */
+TEST_CASE("StreamingKMeansPlusPlusTest", "[KMeansTest]")
+{
+  // The same five-Gaussian dataset as the k-means++ test above.
+  arma::mat data(3, 3000);
+  data.randn();
+
+  arma::mat centroids(" 0  5 -2 -6  1;"
+                      " 0  0 -2  8  6;"
+                      " 0 -2 -2  8  1");
+
+  for (size_t i = 1000; i < 1200; ++i)
+    data.col(i) += centroids.col(1);
+  for (size_t i = 1200; i < 1700; ++i)
+    data.col(i) += centroids.col(2);
+  for (size_t i = 1700; i < 1800; ++i)
+    data.col(i) += centroids.col(3);
+  for (size_t i = 1800; i < 3000; ++i)
+    data.col(i) += centroids.col(4);
+
+  // Seed from a reservoir of 500 points with 3x over-seeding.
+  StreamingKMeansPlusPlus s(500, 3.0);
+  arma::mat resultingCentroids;
+  s.Cluster(data, 5, resultingCentroids);
+
+  REQUIRE(resultingCentroids.n_rows == 3);
+  REQUIRE(resultingCentroids.n_cols == 5);
+
+  // Calculate resulting assignments.
+  arma::Row<size_t> assignments(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    double bestDist = DBL_MAX;
+    for (size_t j = 0; j < 5; ++j)
+    {
+      const double dist = metric::EuclideanDistance::Evaluate(data.col(i),
+          resultingCentroids.col(j));
+      if (dist < bestDist)
+      {
+        bestDist = dist;
+        assignments[i] = j;
+      }
+    }
+  }
+
+  // Calculate sum of distances from centroid means.
+  double distortion = 0;
+  for (size_t i = 0; i < 3000; ++i)
+    distortion += metric::EuclideanDistance::Evaluate(data.col(i),
+        resultingCentroids.col(assignments[i]));
+
+  // The seeding only ever sees the reservoir, so it is noisier than exact
+  // k-means++; random initial starts give distortion around 22000, so require
+  // that we do clearly better than that.
+  REQUIRE(distortion < 17000.0);
+}
+
 #ifdef ARMA_HAS_SPMAT
 /**
  * Make sure sparse k-means works okay.
@@ -703,6 +911,76 @@ TEST_CASE("PellegMooreTest", "[KMeansTest]")
   }
 }
 
+TEST_CASE("HybridKMeansTest", "[KMeansTest]")
+{
+  const size_t trials = 5;
+
+  for (size_t t = 0; t < trials; ++t)
+  {
+    arma::mat dataset(10, 1000);
+    dataset.randu();
+
+    const size_t k = 5 * (t + 1);
+    arma::mat centroids(10, k);
+    centroids.randu();
+
+    // Make sure the hybrid algorithm and the naive method return the same
+    // clusters; both underlying strategies are exact, so switching between
+    // them must not change the result.
+    arma::mat naiveCentroids(centroids);
+    KMeans<> km;
+    arma::Row<size_t> assignments;
+    km.Cluster(dataset, k, assignments, naiveCentroids, false, true);
+
+    KMeans<metric::EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+        HybridKMeans> hybrid;
+    arma::Row<size_t> hybridAssignments;
+    arma::mat hybridCentroids(centroids);
+    hybrid.Cluster(dataset, k, hybridAssignments, hybridCentroids, false,
+        true);
+
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+      REQUIRE(assignments[i] == hybridAssignments[i]);
+
+    for (size_t i = 0; i < centroids.n_elem; ++i)
+      REQUIRE(naiveCentroids[i] == Approx(hybridCentroids[i]).epsilon(1e-7));
+  }
+}
+
+TEST_CASE("HybridKMeansSwitchTest", "[KMeansTest]")
+{
+  // Iterating manually with both strategies interleaved must give the same
+  // residuals as either strategy alone, even across switches (which force
+  // Hamerly's bounds to be rebuilt).
+  arma::mat dataset(5, 500);
+  dataset.randu();
+  const size_t k = 10;
+  arma::mat centroids(5, k);
+  centroids.randu();
+
+  metric::EuclideanDistance metric;
+  HybridKMeans<metric::EuclideanDistance, arma::mat> hybrid(dataset, metric);
+  NaiveKMeans<metric::EuclideanDistance, arma::mat> naive(dataset, metric);
+
+  arma::mat hybridCentroids(centroids), naiveCentroids(centroids);
+  arma::mat newHybridCentroids, newNaiveCentroids;
+  arma::Col<size_t> hybridCounts, naiveCounts;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    hybrid.Iterate(hybridCentroids, newHybridCentroids, hybridCounts);
+    naive.Iterate(naiveCentroids, newNaiveCentroids, naiveCounts);
+
+    for (size_t j = 0; j < centroids.n_elem; ++j)
+    {
+      REQUIRE(newHybridCentroids[j] ==
+          Approx(newNaiveCentroids[j]).epsilon(1e-10));
+    }
+
+    hybridCentroids = newHybridCentroids;
+    naiveCentroids = newNaiveCentroids;
+  }
+}
+
 TEST_CASE("DTNNTest", "[KMeansTest]")
 {
   const size_t trials = 5;
@@ -800,3 +1078,101 @@ TEST_CASE("SampleInitializationTest", "[KMeansTest]")
     REQUIRE(j < dataset.n_cols);
   }
 }
+
+TEST_CASE("MiniBatchKMeansTest", "[KMeansTest]")
+{
+  // Mini-batch k-means is approximate, so use three widely separated Gaussian
+  // clusters and check that each true center is recovered closely by exactly
+  // one centroid.
+  arma::mat dataset(2, 1500);
+  dataset.cols(0, 499) = arma::randn(2, 500) * 0.5;
+  dataset.cols(500, 999) = arma::randn(2, 500) * 0.5 +
+      arma::repmat(arma::vec("10.0 10.0"), 1, 500);
+  dataset.cols(1000, 1499) = arma::randn(2, 500) * 0.5 +
+      arma::repmat(arma::vec("-10.0 10.0"), 1, 500);
+
+  arma::mat trueCenters(2, 3);
+  trueCenters.col(0) = arma::vec("0.0 0.0");
+  trueCenters.col(1) = arma::vec("10.0 10.0");
+  trueCenters.col(2) = arma::vec("-10.0 10.0");
+
+  // Start each centroid near a different true center, so this checks the
+  // refinement and not the (random) initialization.
+  arma::mat centroids = trueCenters + 2.0 * arma::randn(2, 3);
+
+  KMeans<metric::EuclideanDistance, SampleInitialization,
+      MaxVarianceNewCluster, MiniBatchKMeans> miniBatch;
+  arma::Row<size_t> assignments;
+  miniBatch.Cluster(dataset, 3, assignments, centroids, false, true);
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    const double distance = metric::EuclideanDistance::Evaluate(
+        centroids.col(i), trueCenters.col(i));
+    REQUIRE(distance < 1.0);
+  }
+
+  // All points of a separated cluster should share an assignment.
+  for (size_t c = 0; c < 3; ++c)
+    for (size_t i = 0; i < 500; ++i)
+      REQUIRE(assignments[500 * c + i] == assignments[500 * c]);
+}
+
+/**
+ * Make sure that weighted clustering gives the same centroids as clustering
+ * the physically replicated dataset: a point with weight w must behave
+ * exactly like w copies of that point.
+ */
+TEST_CASE("WeightedKMeansTest", "[KMeansTest]")
+{
+  // Build a small dataset and a replicated version of it.
+  arma::mat uniqueData = arma::randu<arma::mat>(3, 100);
+  arma::vec weights(100);
+  std::vector<size_t> columns;
+  for (size_t i = 0; i < uniqueData.n_cols; ++i)
+  {
+    weights[i] = (double) ((i % 4) + 1);
+    for (size_t c = 0; c < (i % 4) + 1; ++c)
+      columns.push_back(i);
+  }
+
+  arma::mat replicated(uniqueData.n_rows, columns.size());
+  for (size_t i = 0; i < columns.size(); ++i)
+    replicated.col(i) = uniqueData.col(columns[i]);
+
+  // Use the same initial centroids for both runs, so the Lloyd iterations
+  // must follow the same trajectory.
+  arma::mat initialCentroids = uniqueData.cols(0, 4);
+
+  KMeans<> kmeans;
+  arma::mat weightedCentroids(initialCentroids);
+  kmeans.Cluster(uniqueData, 5, weightedCentroids, weights, true);
+
+  arma::mat replicatedCentroids(initialCentroids);
+  kmeans.Cluster(replicated, 5, replicatedCentroids, true);
+
+  for (size_t i = 0; i < weightedCentroids.n_elem; ++i)
+  {
+    REQUIRE(weightedCentroids[i] ==
+        Approx(replicatedCentroids[i]).epsilon(1e-7));
+  }
+
+  // The multiplicity counts from CollapseDuplicates() must work as weights
+  // directly and give the same result.
+  arma::mat collapsed;
+  arma::Col<size_t> counts, mappings;
+  data::CollapseDuplicates(replicated, collapsed, counts, mappings);
+
+  arma::mat countCentroids(initialCentroids);
+  kmeans.Cluster(collapsed, 5, countCentroids, counts, true);
+
+  for (size_t i = 0; i < weightedCentroids.n_elem; ++i)
+    REQUIRE(countCentroids[i] == Approx(weightedCentroids[i]).epsilon(1e-7));
+
+  // A weight vector of the wrong length must be rejected.
+  Log::Fatal.ignoreInput = true;
+  arma::vec badWeights(replicated.n_cols + 1, arma::fill::ones);
+  REQUIRE_THROWS_AS(kmeans.Cluster(replicated, 5, countCentroids, badWeights,
+      true), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
@@ -12,8 +12,11 @@
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/methods/neighbor_search/unmap.hpp>
 #include <mlpack/methods/neighbor_search/ns_model.hpp>
+#include <mlpack/methods/neighbor_search/spill_search_tuner.hpp>
+#include <mlpack/methods/neighbor_search/sharded_neighbor_search.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/tree/example_tree.hpp>
+#include <mlpack/core/metrics/counting_metric.hpp>
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
 
@@ -889,6 +892,50 @@ TEST_CASE("KNNDualBallTreeTest", "[KNNTest]")
   }
 }
 
+/**
+ * Test the vantage point tree search with a CountingMetric wrapped around the
+ * metric.  The results must match the naive method, and the counter must show
+ * that the VP tree needed far fewer metric evaluations than naive search.
+ */
+TEST_CASE("KNNVPTreeCountingMetricTest", "[KNNTest]")
+{
+  arma::mat data;
+  data.randu(10, 300); // 10 dimensional, 300 points.
+
+  typedef CountingMetric<EuclideanDistance> CountedEuclidean;
+
+  typedef VPTree<CountedEuclidean, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  TreeType tree(data);
+
+  KNN naive(tree.Dataset(), NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(3, naiveNeighbors, naiveDistances);
+
+  // VPTree modifies data; use the permuted dataset (as done above for the
+  // ball tree) so the point correspondence between both methods holds.
+  NeighborSearch<NearestNeighborSort, CountedEuclidean, arma::mat, VPTree>
+      vpTreeSearch(std::move(tree));
+
+  CountedEuclidean::ResetCount();
+
+  arma::Mat<size_t> vpTreeNeighbors;
+  arma::mat vpTreeDistances;
+  vpTreeSearch.Search(3, vpTreeNeighbors, vpTreeDistances);
+
+  for (size_t i = 0; i < vpTreeNeighbors.n_elem; ++i)
+  {
+    REQUIRE(vpTreeNeighbors[i] == naiveNeighbors[i]);
+    REQUIRE(vpTreeDistances[i] == Approx(naiveDistances[i]).epsilon(1e-7));
+  }
+
+  // The search must have pruned at least some of the 300 * 299 pairwise
+  // evaluations the naive method performs.
+  REQUIRE(CountedEuclidean::Evaluations() > 0);
+  REQUIRE(CountedEuclidean::Evaluations() < 300 * 299);
+}
+
 /**
  * Test the spill tree hybrid sp-tree search (defeatist search on overlapping
  * nodes, and backtracking in non-overlapping nodes) against the naive method.
@@ -1022,6 +1069,58 @@ TEST_CASE("SparseKNNKDTreeTest", "[KNNTest]")
   }
 }
 
+/**
+ * Make sure sparse nearest neighbors works with the sparse-bound kd-tree,
+ * whose nodes only store bounding ranges for the dimensions their points
+ * touch.  Unlike the dense-bound kd-tree, this stays feasible when the
+ * dimensionality is high.
+ */
+TEST_CASE("SparseKNNSparseKDTreeTest", "[KNNTest]")
+{
+  arma::sp_mat queryDataset;
+  queryDataset.sprandu(500, 200, 0.03);
+  arma::sp_mat referenceDataset;
+  referenceDataset.sprandu(500, 500, 0.02);
+  arma::mat denseQuery(queryDataset);
+  arma::mat denseReference(referenceDataset);
+
+  typedef NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::sp_mat,
+      SparseKDTree> SparseKNN;
+
+  SparseKNN a(referenceDataset);
+  KNN naive(denseReference, NAIVE_MODE);
+
+  arma::mat sparseDistances;
+  arma::Mat<size_t> sparseNeighbors;
+  a.Search(queryDataset, 10, sparseNeighbors, sparseDistances);
+
+  arma::mat naiveDistances;
+  arma::Mat<size_t> naiveNeighbors;
+  naive.Search(denseQuery, 10, naiveNeighbors, naiveDistances);
+
+  for (size_t i = 0; i < naiveNeighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < naiveNeighbors.n_rows; ++j)
+    {
+      // Distances, not indices, are compared: with this much sparsity, many
+      // points are duplicates (or all zero) and tie orderings may differ.
+      REQUIRE(naiveDistances(j, i) ==
+              Approx(sparseDistances(j, i)).margin(1e-7));
+    }
+  }
+
+  // Single-tree mode must give the same results, too.
+  SparseKNN single(referenceDataset, SINGLE_TREE_MODE);
+  arma::mat singleDistances;
+  arma::Mat<size_t> singleNeighbors;
+  single.Search(queryDataset, 10, singleNeighbors, singleDistances);
+
+  for (size_t i = 0; i < naiveNeighbors.n_cols; ++i)
+    for (size_t j = 0; j < naiveNeighbors.n_rows; ++j)
+      REQUIRE(naiveDistances(j, i) ==
+              Approx(singleDistances(j, i)).margin(1e-7));
+}
+
 /*
 TEST_CASE("SparseKNNCoverTreeTest", "[KNNTest]")
 {
@@ -1249,6 +1348,36 @@ TEST_CASE("KNNDoubleReferenceSearchTest", "[KNNTest]")
   REQUIRE(knn.Scores() ==scores);
 }
 
+/**
+ * The aggregated traversal statistics should agree with the BaseCases() and
+ * Scores() counters, and should be reset between searches.
+ */
+TEST_CASE("KNNTraversalStatisticsTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 500);
+  KNN knn(std::move(dataset));
+
+  arma::mat distances;
+  arma::Mat<size_t> neighbors;
+  knn.Search(3, neighbors, distances);
+
+  const tree::TraversalStatistics& stats = knn.TraversalStats();
+  REQUIRE(stats.BaseCases() == knn.BaseCases());
+  REQUIRE(stats.Scores() == knn.Scores());
+  // A search on random data must perform some work and prune something.
+  REQUIRE(stats.BaseCases() > 0);
+  REQUIRE(stats.Scores() > 0);
+  REQUIRE(stats.ScorePrunes() + stats.RescorePrunes() > 0);
+  REQUIRE(stats.BoundUpdates() > 0);
+
+  // A second search should produce the same counts, not accumulate.
+  const size_t baseCases = stats.BaseCases();
+  const size_t scores = stats.Scores();
+  knn.Search(3, neighbors, distances);
+  REQUIRE(knn.TraversalStats().BaseCases() == baseCases);
+  REQUIRE(knn.TraversalStats().Scores() == scores);
+}
+
 /**
  * Make sure that the neighborPtr matrix isn't accidentally deleted.
  * See issue #478.
@@ -1816,3 +1945,511 @@ TEST_CASE("KNNSpillTreeSearchEnoughResults", "[KNNTest]")
   REQUIRE(arma::accu(distancesGreedy < 0.0 || distancesGreedy > std::sqrt(3.0))
       == 0);
 }
+
+/**
+ * Test that SpillSearchTuner::Recall() computes the right value on known
+ * inputs.
+ */
+TEST_CASE("SpillSearchTunerRecallTest", "[KNNTest]")
+{
+  arma::Mat<size_t> exact(2, 2);
+  exact(0, 0) = 0; exact(1, 0) = 1;
+  exact(0, 1) = 2; exact(1, 1) = 3;
+
+  // Perfect recall when the found neighbors match exactly (order within a
+  // column does not matter).
+  arma::Mat<size_t> found = exact;
+  found.swap_rows(0, 1);
+  REQUIRE(SpillSearchTuner<>::Recall(found, exact) == Approx(1.0));
+
+  // Half of the exact neighbors are missing.
+  found(0, 0) = 7;
+  found(0, 1) = 8;
+  REQUIRE(SpillSearchTuner<>::Recall(found, exact) == Approx(0.5));
+
+  // Mismatched sizes must be rejected.
+  arma::Mat<size_t> tooSmall(1, 2);
+  REQUIRE_THROWS_AS(SpillSearchTuner<>::Recall(tooSmall, exact),
+      std::invalid_argument);
+}
+
+/**
+ * Test that SpillSearchTuner::EstimateRecall() reports perfect recall when
+ * the approximate results are in fact exact.
+ */
+TEST_CASE("SpillSearchTunerEstimateRecallTest", "[KNNTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 300);
+
+  const size_t k = 5;
+
+  KNN naive(dataset, NAIVE_MODE);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  naive.Search(dataset, k, neighbors, distances);
+
+  // Exact results must estimate to perfect recall, whatever the sample.
+  REQUIRE(SpillSearchTuner<>::EstimateRecall(dataset, dataset, neighbors, 50)
+      == Approx(1.0));
+}
+
+/**
+ * Test tau calibration: a zero recall target must be satisfied by the
+ * smallest candidate (no overlap), and a real target must produce a tau whose
+ * deployed defeatist search reaches reasonable estimated recall.
+ */
+TEST_CASE("SpillSearchTunerTuneTauTest", "[KNNTest]")
+{
+  arma::mat dataset;
+  dataset.randu(10, 500);
+
+  const size_t k = 3;
+
+  // Any recall satisfies a zero target, so the first candidate (tau = 0) must
+  // be selected.
+  double achievedRecall;
+  REQUIRE(SpillSearchTuner<>::TuneTau(dataset, k, 0.0, achievedRecall) == 0.0);
+  REQUIRE(achievedRecall >= 0.0);
+  REQUIRE(achievedRecall <= 1.0);
+
+  // Calibrate against a real target and deploy the returned tau.
+  const double tau = SpillSearchTuner<>::TuneTau(dataset, k, 0.9,
+      achievedRecall);
+  REQUIRE(tau >= 0.0);
+  REQUIRE(achievedRecall >= 0.0);
+  REQUIRE(achievedRecall <= 1.0);
+
+  SpillKNN::Tree referenceTree(dataset, tau);
+  SpillKNN search(std::move(referenceTree), SINGLE_TREE_MODE);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  search.Search(dataset, k, neighbors, distances);
+
+  // The estimate is sampled and the calibration subset differs from the full
+  // set, so only require a loose bound here.
+  const double estimate =
+      SpillSearchTuner<>::EstimateRecall(dataset, dataset, neighbors, 100);
+  REQUIRE(estimate >= 0.5);
+  REQUIRE(estimate <= 1.0);
+}
+
+/**
+ * Test that ShardedNeighborSearch returns exactly the same results as a
+ * single search over the whole reference set, for several shard counts.
+ */
+TEST_CASE("ShardedSearchEquivalenceTest", "[KNNTest]")
+{
+  arma::mat referenceSet;
+  referenceSet.randu(10, 1000);
+  arma::mat querySet;
+  querySet.randu(10, 200);
+
+  const size_t k = 5;
+
+  KNN knn(referenceSet);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(querySet, k, neighbors, distances);
+
+  for (size_t numShards : { 1, 3, 7 })
+  {
+    ShardedNeighborSearch<> sharded(referenceSet, numShards);
+    REQUIRE(sharded.NumShards() == numShards);
+
+    arma::Mat<size_t> shardedNeighbors;
+    arma::mat shardedDistances;
+    sharded.Search(querySet, k, shardedNeighbors, shardedDistances);
+
+    REQUIRE(shardedNeighbors.n_rows == k);
+    REQUIRE(shardedNeighbors.n_cols == querySet.n_cols);
+    for (size_t q = 0; q < querySet.n_cols; ++q)
+    {
+      for (size_t j = 0; j < k; ++j)
+      {
+        REQUIRE(shardedNeighbors(j, q) == neighbors(j, q));
+        REQUIRE(shardedDistances(j, q) ==
+            Approx(distances(j, q)).epsilon(1e-10));
+      }
+    }
+  }
+}
+
+/**
+ * Test that ShardedNeighborSearch works when k exceeds the size of some
+ * shards, and rejects invalid configurations.
+ */
+TEST_CASE("ShardedSearchSmallShardTest", "[KNNTest]")
+{
+  arma::mat referenceSet;
+  referenceSet.randu(5, 23);
+  arma::mat querySet;
+  querySet.randu(5, 10);
+
+  // With 4 shards of ~6 points each, k = 10 is larger than every shard.
+  const size_t k = 10;
+
+  KNN knn(referenceSet);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(querySet, k, neighbors, distances);
+
+  ShardedNeighborSearch<> sharded(referenceSet, 4);
+  arma::Mat<size_t> shardedNeighbors;
+  arma::mat shardedDistances;
+  sharded.Search(querySet, k, shardedNeighbors, shardedDistances);
+
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(shardedNeighbors(j, q) == neighbors(j, q));
+      REQUIRE(shardedDistances(j, q) ==
+          Approx(distances(j, q)).epsilon(1e-10));
+    }
+  }
+
+  // More candidates than reference points must be rejected, as in
+  // NeighborSearch.
+  REQUIRE_THROWS_AS(sharded.Search(querySet, 24, shardedNeighbors,
+      shardedDistances), std::invalid_argument);
+
+  // Invalid shard counts and naive mode must be rejected at construction.
+  REQUIRE_THROWS_AS(ShardedNeighborSearch<>(referenceSet, 0),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(ShardedNeighborSearch<>(referenceSet, 24),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(ShardedNeighborSearch<>(referenceSet, 2, NAIVE_MODE),
+      std::invalid_argument);
+}
+
+/**
+ * Test that the beam-search generalization of greedy single-tree search
+ * improves recall as the leaf budget grows, returns complete results even
+ * under a tight node budget, and recovers the exact results when the budget
+ * covers the whole tree.
+ */
+TEST_CASE("KNNGreedyBeamSearchTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(8, 1000);
+  arma::mat querySet = arma::randu<arma::mat>(8, 100);
+
+  const size_t k = 5;
+
+  // Compute the exact results.
+  KNN exact(referenceSet);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  exact.Search(querySet, k, exactNeighbors, exactDistances);
+
+  // Recall of greedy search against the exact results, for increasing leaf
+  // budgets.
+  KNN greedy(referenceSet, GREEDY_SINGLE_TREE_MODE);
+  double lastRecall = 0.0;
+  for (size_t leafBudget : { 1, 8, 64 })
+  {
+    greedy.LeafBudget() = leafBudget;
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    greedy.Search(querySet, k, neighbors, distances);
+
+    // All result lists must be complete.
+    REQUIRE(arma::accu(neighbors >= referenceSet.n_cols) == 0);
+
+    size_t found = 0;
+    for (size_t q = 0; q < querySet.n_cols; ++q)
+      for (size_t j = 0; j < k; ++j)
+        found += arma::accu(neighbors.col(q) == exactNeighbors(j, q));
+    const double recall = double(found) / exactNeighbors.n_elem;
+
+    // A larger beam may only improve the results.
+    REQUIRE(recall >= lastRecall);
+    lastRecall = recall;
+  }
+
+  // A budget covering every leaf must give the exact results.
+  greedy.LeafBudget() = referenceSet.n_cols;
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  greedy.Search(querySet, k, neighbors, distances);
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(neighbors(j, q) == exactNeighbors(j, q));
+      REQUIRE(distances(j, q) == Approx(exactDistances(j, q)).epsilon(1e-10));
+    }
+  }
+
+  // Even a very tight node budget must return complete result lists.
+  greedy.LeafBudget() = 64;
+  greedy.NodeBudget() = 2;
+  greedy.Search(querySet, k, neighbors, distances);
+  REQUIRE(arma::accu(neighbors >= referenceSet.n_cols) == 0);
+  REQUIRE(arma::accu(distances == DBL_MAX) == 0);
+}
+
+/**
+ * Test that NSModel::AutoSearch() returns the exact results regardless of
+ * which search mode its calibration selects, and that the small-batch and
+ * brute-force fallbacks work.
+ */
+TEST_CASE("KNNModelAutoSearchTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort> KNNModel;
+
+  arma::mat referenceData = arma::randu<arma::mat>(8, 800);
+  arma::mat queryData = arma::randu<arma::mat>(8, 500);
+
+  // Get a baseline.
+  KNN knn(referenceData);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(queryData, 3, baselineNeighbors, baselineDistances);
+
+  KNNModel model(KNNModel::TreeTypes::KD_TREE, false);
+  arma::mat referenceCopy(referenceData);
+  model.BuildModel(std::move(referenceCopy), DUAL_TREE_MODE);
+
+  // All candidate strategies are exact, so whichever the calibration picks,
+  // the results must match the baseline.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  arma::mat queryCopy(queryData);
+  model.AutoSearch(std::move(queryCopy), 3, neighbors, distances, 50);
+
+  REQUIRE(neighbors.n_rows == baselineNeighbors.n_rows);
+  REQUIRE(neighbors.n_cols == baselineNeighbors.n_cols);
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == baselineNeighbors[i]);
+    REQUIRE(distances[i] == Approx(baselineDistances[i]).epsilon(1e-10));
+  }
+
+  // A batch smaller than the calibration sample falls back to the current
+  // search mode and must still give the exact results.
+  arma::mat smallQuery(queryData.cols(0, 59));
+  model.AutoSearch(std::move(smallQuery), 3, neighbors, distances, 100);
+  for (size_t q = 0; q < 60; ++q)
+    for (size_t j = 0; j < 3; ++j)
+      REQUIRE(neighbors(j, q) == baselineNeighbors(j, q));
+
+  // A model built for brute-force search holds no tree; AutoSearch() must
+  // keep using brute-force search.
+  KNNModel naiveModel(KNNModel::TreeTypes::KD_TREE, false);
+  arma::mat referenceCopy2(referenceData);
+  naiveModel.BuildModel(std::move(referenceCopy2), NAIVE_MODE);
+
+  arma::mat queryCopy2(queryData);
+  naiveModel.AutoSearch(std::move(queryCopy2), 3, neighbors, distances, 50);
+  REQUIRE(naiveModel.SearchMode() == NAIVE_MODE);
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+    REQUIRE(neighbors[i] == baselineNeighbors[i]);
+}
+
+/**
+ * Test that the self-join specialization used by monochromatic dual-tree
+ * search returns the exact results while evaluating each unordered point pair
+ * at most once, and that tree types that fall back to the full traversal are
+ * still exact.
+ */
+TEST_CASE("KNNSelfJoinTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(8, 1000);
+  const size_t k = 5;
+
+  // Get the exact results with brute-force monochromatic search.
+  KNN naive(dataset, NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(k, naiveNeighbors, naiveDistances);
+
+  // Monochromatic dual-tree search with a kd-tree uses the full self-join
+  // (mirrored node pruning and base case reflection).
+  KNN knn(dataset);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(k, neighbors, distances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == naiveNeighbors[i]);
+    REQUIRE(distances[i] == Approx(naiveDistances[i]).epsilon(1e-10));
+  }
+
+  // Each unordered pair is evaluated at most once, so the number of base cases
+  // cannot exceed n * (n - 1) / 2.
+  REQUIRE(knn.BaseCases() <=
+      dataset.n_cols * (dataset.n_cols - 1) / 2);
+
+  // Ball trees also rearrange the dataset and use the full self-join.
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, BallTree>
+      ballTreeSearch(dataset);
+  ballTreeSearch.Search(k, neighbors, distances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == naiveNeighbors[i]);
+    REQUIRE(distances[i] == Approx(naiveDistances[i]).epsilon(1e-10));
+  }
+
+  // Cover trees score with base case results, so they fall back to the full
+  // traversal; the results must still be exact.
+  NeighborSearch<NearestNeighborSort, LMetric<2>, arma::mat, StandardCoverTree>
+      coverTreeSearch(dataset);
+  coverTreeSearch.Search(k, neighbors, distances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == naiveNeighbors[i]);
+    REQUIRE(distances[i] == Approx(naiveDistances[i]).epsilon(1e-10));
+  }
+
+  // R trees do not rearrange the dataset, so only the base case reflection
+  // applies; the results must still be exact.
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, RTree>
+      rTreeSearch(dataset);
+  rTreeSearch.Search(k, neighbors, distances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == naiveNeighbors[i]);
+    REQUIRE(distances[i] == Approx(naiveDistances[i]).epsilon(1e-10));
+  }
+}
+
+/**
+ * Ensure that a leaf size of zero makes NSModel select a leaf size
+ * automatically, and that the results with the selected leaf size are still
+ * exact.
+ */
+TEST_CASE("KNNModelLeafSizeAutotuneTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort> KNNModel;
+
+  arma::mat referenceData = arma::randu<arma::mat>(8, 500);
+  arma::mat queryData = arma::randu<arma::mat>(8, 100);
+
+  // Get a baseline.
+  KNN knn(referenceData);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(queryData, 3, baselineNeighbors, baselineDistances);
+
+  KNNModel model(KNNModel::TreeTypes::KD_TREE, false);
+  model.LeafSize() = 0; // Request automatic selection.
+
+  arma::mat referenceCopy(referenceData);
+  model.BuildModel(std::move(referenceCopy), DUAL_TREE_MODE);
+
+  // A leaf size must have been selected.
+  REQUIRE(model.LeafSize() > 0);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  arma::mat queryCopy(queryData);
+  model.Search(std::move(queryCopy), 3, neighbors, distances);
+
+  for (size_t i = 0; i < distances.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == baselineNeighbors[i]);
+    REQUIRE(distances[i] == Approx(baselineDistances[i]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Test that the context-taking Search() overload gives identical results to
+ * the regular overload, including across repeated searches that reuse the
+ * context and across shape changes that force it to rebuild its state.
+ */
+TEST_CASE("KNNSearchContextTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(8, 300);
+
+  KNN single(referenceData, SINGLE_TREE_MODE);
+  KNN::SearchContext context;
+
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    // Same shape every trial, so the context state is reused.
+    arma::mat queryData = arma::randu<arma::mat>(8, 50);
+
+    arma::Mat<size_t> neighbors, expectedNeighbors;
+    arma::mat distances, expectedDistances;
+
+    single.Search(queryData, 3, neighbors, distances, context);
+    single.Search(queryData, 3, expectedNeighbors, expectedDistances);
+
+    REQUIRE(neighbors.n_rows == expectedNeighbors.n_rows);
+    REQUIRE(neighbors.n_cols == expectedNeighbors.n_cols);
+    for (size_t i = 0; i < neighbors.n_elem; ++i)
+    {
+      REQUIRE(neighbors[i] == expectedNeighbors[i]);
+      REQUIRE(distances[i] == Approx(expectedDistances[i]).epsilon(1e-10));
+    }
+  }
+
+  // A different query set size (and k) forces the context to rebuild.
+  arma::mat queryData = arma::randu<arma::mat>(8, 20);
+  arma::Mat<size_t> neighbors, expectedNeighbors;
+  arma::mat distances, expectedDistances;
+
+  single.Search(queryData, 5, neighbors, distances, context);
+  single.Search(queryData, 5, expectedNeighbors, expectedDistances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == expectedNeighbors[i]);
+    REQUIRE(distances[i] == Approx(expectedDistances[i]).epsilon(1e-10));
+  }
+
+  // The naive mode goes through the context path too.
+  KNN naive(referenceData, NAIVE_MODE);
+  KNN::SearchContext naiveContext;
+  naive.Search(queryData, 5, neighbors, distances, naiveContext);
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == expectedNeighbors[i]);
+    REQUIRE(distances[i] == Approx(expectedDistances[i]).epsilon(1e-10));
+  }
+}
+
+/**
+ * Test that replaying neighbor hints from a previous search through a
+ * SearchContext does not change the results, whether the hints are exact
+ * (identical query batch) or stale (perturbed query batch).
+ */
+TEST_CASE("KNNSearchContextWarmStartTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(10, 400);
+  arma::mat queryData = arma::randu<arma::mat>(10, 60);
+
+  KNN single(referenceData, SINGLE_TREE_MODE);
+  KNN::SearchContext context;
+
+  arma::Mat<size_t> neighbors, expectedNeighbors;
+  arma::mat distances, expectedDistances;
+
+  single.Search(queryData, 4, expectedNeighbors, expectedDistances);
+
+  // The first context search records hints; the second replays exact hints;
+  // the third replays stale hints from a perturbed batch.
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    if (trial == 2)
+    {
+      queryData += 0.01 * arma::randn<arma::mat>(10, 60);
+      single.Search(queryData, 4, expectedNeighbors, expectedDistances);
+    }
+
+    single.Search(queryData, 4, neighbors, distances, context);
+
+    for (size_t i = 0; i < neighbors.n_elem; ++i)
+    {
+      REQUIRE(neighbors[i] == expectedNeighbors[i]);
+      REQUIRE(distances[i] == Approx(expectedDistances[i]).epsilon(1e-10));
+    }
+  }
+}
@@ -469,3 +469,52 @@ TEST_CASE("LARSCopyConstructorTest", "[LARSTest]")
   // The output of both models should be the same.
   CheckMatrices(predictions, predictionsFromCopiedModel);
 }
+
+/**
+ * Ensure that PathSolutions() recovers the same solutions that retraining at
+ * each lambda would give, without retraining.
+ */
+TEST_CASE("LARSPathSolutionsTest", "[LARSTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+  GenerateProblem(X, y, 100, 10);
+
+  // Trace the full path by training down to lambda1 = 0.
+  LARS lars(true, 0.0, 0.0);
+  arma::vec beta;
+  lars.Train(X, y, beta);
+
+  // Pick a grid spanning the traced path, including values beyond both ends.
+  const double maxLambda = lars.LambdaPath().front();
+  arma::vec lambdas = { 2 * maxLambda, 0.5 * maxLambda, 0.1 * maxLambda, 0.0 };
+
+  arma::mat betaGrid;
+  lars.PathSolutions(lambdas, betaGrid);
+  REQUIRE(betaGrid.n_rows == X.n_rows);
+  REQUIRE(betaGrid.n_cols == lambdas.n_elem);
+
+  // Above the largest correlation, the solution is identically zero.
+  REQUIRE(arma::norm(betaGrid.col(0), 2) == Approx(0.0).margin(1e-15));
+
+  // Interior grid values must match a model trained at that lambda1 exactly,
+  // since both are points on the same piecewise linear path.
+  for (size_t i = 1; i < 3; ++i)
+  {
+    LARS larsSingle(true, lambdas(i), 0.0);
+    arma::vec betaSingle;
+    larsSingle.Train(X, y, betaSingle);
+
+    for (size_t j = 0; j < betaSingle.n_elem; ++j)
+      REQUIRE(betaGrid(j, i) == Approx(betaSingle(j)).margin(1e-8));
+  }
+
+  // At lambda1 = 0 the grid solution is the endpoint of the path.
+  for (size_t j = 0; j < beta.n_elem; ++j)
+    REQUIRE(betaGrid(j, 3) == Approx(beta(j)).margin(1e-8));
+
+  // An untrained model has no path to interpolate.
+  LARS untrained(true, 0.0, 0.0);
+  REQUIRE_THROWS_AS(untrained.PathSolutions(lambdas, betaGrid),
+      std::runtime_error);
+}
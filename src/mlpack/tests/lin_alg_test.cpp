@@ -266,3 +266,28 @@ TEST_CASE("TestSymKronId", "[LinAlgTest]")
       REQUIRE(lhs(j) == Approx(rhs(j)).epsilon(1e-7));
   }
 }
+
+/**
+ * The blocked streaming ColumnCovariance() must match cov(trans(X)) exactly,
+ * including when the data spans many blocks and for both normalization types.
+ */
+TEST_CASE("TestColumnCovarianceStreaming", "[LinAlgTest]")
+{
+  // More columns than one block, so several block merges happen.
+  mat x = randn<mat>(6, 1000);
+
+  mat c0 = mlpack::math::ColumnCovariance(x, 0);
+  mat c1 = mlpack::math::ColumnCovariance(x, 1);
+  mat ref0 = cov(trans(x), 0);
+  mat ref1 = cov(trans(x), 1);
+
+  REQUIRE(approx_equal(c0, ref0, "absdiff", 1e-10));
+  REQUIRE(approx_equal(c1, ref1, "absdiff", 1e-10));
+
+  // A single column is treated as one-dimensional data.
+  vec y = randn<vec>(500);
+  mat cy = mlpack::math::ColumnCovariance(mat(y));
+  REQUIRE(cy.n_rows == 1);
+  REQUIRE(cy.n_cols == 1);
+  REQUIRE(cy(0, 0) == Approx(var(y)).epsilon(1e-10));
+}
@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/linear_svm/linear_svm.hpp>
+#include <mlpack/core/util/data_parallel_function.hpp>
 #include <ensmallen.hpp>
 
 #include "catch.hpp"
@@ -1181,3 +1182,128 @@ TEST_CASE("LinearSVMCallbackTest", "[LinearSVMTest]")
 
   REQUIRE(cb.calledEndOptimization == true);
 }
+
+/**
+ * Test that a LinearSVMFunction trained through DataParallelFunction with
+ * L-BFGS separates an easily separable two-Gaussian dataset.
+ */
+TEST_CASE("LinearSVMDataParallelTrainingTest", "[LinearSVMTest]")
+{
+  const size_t points = 1000;
+  const size_t inputSize = 3;
+  const size_t numClasses = 2;
+  const double lambda = 0.5;
+
+  // Generate two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 9.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("4.0 3.0 4.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(inputSize, points);
+  arma::Row<size_t> labels(points);
+
+  // Run multiple trials to sidestep occasional L-BFGS line search failures
+  // (see the comment in LinearSVMLBFGSTwoClasses).
+  bool success = false;
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    for (size_t i = 0; i < points / 2; ++i)
+    {
+      data.col(i) = g1.Random();
+      labels(i) = 0;
+    }
+    for (size_t i = points / 2; i < points; ++i)
+    {
+      data.col(i) = g2.Random();
+      labels(i) = 1;
+    }
+
+    LinearSVMFunction<arma::mat> svmf(data, labels, numClasses, lambda);
+    util::DataParallelFunction<LinearSVMFunction<arma::mat>> dpf(svmf, 4);
+
+    arma::mat parameters = svmf.InitialPoint();
+    ens::L_BFGS opt;
+    opt.Optimize(dpf, parameters);
+
+    // Compute the training accuracy of the learned parameters.
+    const arma::mat scores = parameters.t() * data;
+    size_t correct = 0;
+    for (size_t i = 0; i < points; ++i)
+    {
+      arma::uword prediction;
+      scores.col(i).max(prediction);
+      if ((size_t) prediction == labels(i))
+        ++correct;
+    }
+
+    if ((double) correct / points >= 0.99)
+    {
+      success = true;
+      break;
+    }
+  }
+
+  REQUIRE(success == true);
+}
+
+/**
+ * Test that per-instance weights behave exactly like replicated points: the
+ * weighted hinge loss must agree with the unweighted hinge loss on a dataset
+ * where each point is physically copied as many times as its (integer)
+ * weight.
+ */
+TEST_CASE("LinearSVMFunctionWeightedEvaluate", "[LinearSVMTest]")
+{
+  const size_t points = 100;
+  const size_t inputSize = 5;
+  const size_t numClasses = 3;
+
+  arma::mat data(inputSize, points, arma::fill::randu);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(points,
+      arma::distr_param(0, numClasses - 1));
+
+  // Integer weights, so that the replicated dataset is exactly equivalent.
+  arma::rowvec weights(points);
+  for (size_t i = 0; i < points; ++i)
+    weights[i] = (double) ((i % 4) + 1);
+
+  // Build the physically replicated dataset.
+  const size_t repPoints = (size_t) arma::accu(weights);
+  arma::mat repData(inputSize, repPoints);
+  arma::Row<size_t> repLabels(repPoints);
+  size_t col = 0;
+  for (size_t i = 0; i < points; ++i)
+  {
+    for (size_t w = 0; w < (size_t) weights[i]; ++w)
+    {
+      repData.col(col) = data.col(i);
+      repLabels[col] = labels[i];
+      ++col;
+    }
+  }
+
+  LinearSVMFunction<> weighted(data, labels, numClasses, weights, 0.01);
+  LinearSVMFunction<> replicated(repData, repLabels, numClasses, 0.01);
+
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    arma::mat parameters(inputSize, numClasses, arma::fill::randn);
+    parameters *= 0.1;
+
+    REQUIRE(weighted.Evaluate(parameters) ==
+        Approx(replicated.Evaluate(parameters)).epsilon(1e-7));
+
+    arma::mat weightedGradient, replicatedGradient;
+    weighted.Gradient(parameters, weightedGradient);
+    replicated.Gradient(parameters, replicatedGradient);
+    REQUIRE(arma::approx_equal(weightedGradient, replicatedGradient, "absdiff",
+        1e-7));
+
+    arma::mat ewgGradient;
+    const double ewgObjective = weighted.EvaluateWithGradient(parameters,
+        ewgGradient);
+    REQUIRE(ewgObjective ==
+        Approx(replicated.Evaluate(parameters)).epsilon(1e-7));
+    REQUIRE(arma::approx_equal(ewgGradient, replicatedGradient, "absdiff",
+        1e-7));
+  }
+}
@@ -97,6 +97,62 @@ TEST_CASE("LMNNImpostorsTest", "[LMNNTest]")
   REQUIRE(impostors(0, 5) == 2);
 }
 
+/**
+ * A repeated impostor search on the same dataset should be answered from the
+ * cache, and a search on different data should not be.
+ */
+TEST_CASE("LMNNImpostorsCacheTest", "[LMNNTest]")
+{
+  // Useful but simple dataset with six points and two classes.
+  arma::mat dataset        = "-0.1 -0.1 -0.1  0.1  0.1  0.1;"
+                             " 1.0  0.0 -1.0  1.0  0.0 -1.0 ";
+  arma::Row<size_t> labels = " 0    0    0    1    1    1   ";
+
+  Constraints<> constraint(dataset, labels, 1);
+
+  // Calculate norm of datapoints.
+  arma::vec norm(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    norm(i) = arma::norm(dataset.col(i));
+  }
+
+  arma::Mat<size_t> impostors(1, dataset.n_cols);
+  arma::mat distances(1, dataset.n_cols);
+  constraint.Impostors(impostors, distances, dataset, labels, norm);
+
+  // The second search runs on identical data, so the cached result must come
+  // back unchanged.
+  arma::Mat<size_t> impostorsCached(1, dataset.n_cols);
+  arma::mat distancesCached(1, dataset.n_cols);
+  constraint.Impostors(impostorsCached, distancesCached, dataset, labels,
+      norm);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    REQUIRE(impostorsCached(0, i) == impostors(0, i));
+    REQUIRE(distancesCached(0, i) == Approx(distances(0, i)));
+  }
+
+  // Moving points 4 and 5 far away makes point 3 the closest impostor of
+  // every point in the first class; the cache must not serve stale results
+  // for the modified dataset.
+  arma::mat shifted = dataset;
+  shifted.row(0).cols(4, 5) += 100.0;
+
+  arma::vec shiftedNorm(shifted.n_cols);
+  for (size_t i = 0; i < shifted.n_cols; ++i)
+  {
+    shiftedNorm(i) = arma::norm(shifted.col(i));
+  }
+
+  constraint.Impostors(impostors, distances, shifted, labels, shiftedNorm);
+
+  REQUIRE(impostors(0, 0) == 3);
+  REQUIRE(impostors(0, 1) == 3);
+  REQUIRE(impostors(0, 2) == 3);
+}
+
 //
 // Tests for the LMNNFunction
 //
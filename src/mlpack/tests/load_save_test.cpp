@@ -14,6 +14,9 @@
 #include <mlpack/core.hpp>
 #include <mlpack/core/data/load_arff.hpp>
 #include <mlpack/core/data/map_policies/missing_policy.hpp>
+#include <mlpack/core/data/out_of_core_matrix.hpp>
+#include <mlpack/core/data/prefetching_chunk_iterator.hpp>
+#include <mlpack/core/data/compressed_blob.hpp>
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
 
@@ -124,6 +127,128 @@ TEST_CASE("LoadCSVTest", "[LoadSaveTest]")
   remove("test_file.csv");
 }
 
+/**
+ * Make sure the chunked numeric CSV loader parses a file correctly, including
+ * a trailing newline and empty fields.
+ */
+TEST_CASE("LoadNumericCSVTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+
+  // 50 lines, so that every thread's chunk contains some rows.
+  for (size_t i = 0; i < 50; ++i)
+    f << (4 * i) << ", " << (4 * i + 1) << ", " << (4 * i + 2) << ", "
+      << (4 * i + 3) << endl;
+
+  f.close();
+
+  arma::mat test;
+  REQUIRE(data::LoadNumericCSV("test_file.csv", test) == true);
+
+  REQUIRE(test.n_rows == 50);
+  REQUIRE(test.n_cols == 4);
+
+  for (size_t i = 0; i < 50; ++i)
+    for (size_t j = 0; j < 4; ++j)
+      REQUIRE(test(i, j) == Approx((double) (4 * i + j)).epsilon(1e-7));
+
+  // An empty field should load as zero, like Armadillo's CSV loader.
+  f.open("test_file.csv", fstream::out);
+  f << "1,,3" << endl;
+  f.close();
+
+  REQUIRE(data::LoadNumericCSV("test_file.csv", test) == true);
+  REQUIRE(test.n_rows == 1);
+  REQUIRE(test.n_cols == 3);
+  REQUIRE(test(0, 1) == Approx(0.0).margin(1e-7));
+
+  // Non-numeric data must be rejected, so that data::Load() falls back to the
+  // general loader.
+  f.open("test_file.csv", fstream::out);
+  f << "1, hello, 3" << endl;
+  f.close();
+
+  REQUIRE(data::LoadNumericCSV("test_file.csv", test) == false);
+
+  // Remove the file.
+  remove("test_file.csv");
+}
+
+/**
+ * Make sure a matrix round-trips exactly through the binary columnar format,
+ * and that type mismatches are rejected.
+ */
+TEST_CASE("ColumnarFormatTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(10, 250, arma::fill::randu);
+
+  REQUIRE(data::Save("test_file.mcol", dataset) == true);
+
+  arma::mat reloaded;
+  REQUIRE(data::Load("test_file.mcol", reloaded) == true);
+
+  // The format stores the matrix in its in-memory orientation, so the
+  // round-trip must be exact and orientation-preserving.
+  REQUIRE(reloaded.n_rows == dataset.n_rows);
+  REQUIRE(reloaded.n_cols == dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_elem; ++i)
+    REQUIRE(reloaded[i] == dataset[i]);
+
+  // The loaded matrix may alias a copy-on-write mapping of the file; writing
+  // to it must not change the file contents.
+  reloaded.zeros();
+  arma::mat reloadedAgain;
+  REQUIRE(data::Load("test_file.mcol", reloadedAgain) == true);
+  for (size_t i = 0; i < dataset.n_elem; ++i)
+    REQUIRE(reloadedAgain[i] == dataset[i]);
+
+  // Loading into a matrix with a different element type must fail.
+  arma::fmat wrongType;
+  REQUIRE(data::Load("test_file.mcol", wrongType) == false);
+
+  remove("test_file.mcol");
+}
+
+/**
+ * Make sure an OutOfCoreMatrix exposes the same data as the file it maps, and
+ * that window prefetch/release hints do not affect the visible data.
+ */
+TEST_CASE("OutOfCoreMatrixTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(25, 400, arma::fill::randu);
+  REQUIRE(data::Save("test_file.mcol", dataset) == true);
+
+  {
+    data::OutOfCoreMatrix<> mapped("test_file.mcol");
+
+    REQUIRE(mapped.Rows() == dataset.n_rows);
+    REQUIRE(mapped.Cols() == dataset.n_cols);
+
+    // Slide a window across the dataset, as a batch algorithm would.
+    const size_t window = 100;
+    for (size_t start = 0; start < mapped.Cols(); start += window)
+    {
+      mapped.Prefetch(start, window);
+      for (size_t c = start; c < std::min(start + window, mapped.Cols()); ++c)
+        for (size_t r = 0; r < mapped.Rows(); ++r)
+          REQUIRE(mapped.Matrix()(r, c) == dataset(r, c));
+      mapped.Release(start, window);
+    }
+
+    // Released columns must still read back correctly (they are refetched
+    // from the file on demand).
+    for (size_t r = 0; r < mapped.Rows(); ++r)
+      REQUIRE(mapped.Matrix()(r, 0) == dataset(r, 0));
+  }
+
+  // Element type mismatches must be rejected.
+  REQUIRE_THROWS_AS(data::OutOfCoreMatrix<float>("test_file.mcol"),
+      std::runtime_error);
+
+  remove("test_file.mcol");
+}
+
 /**
  * Make sure a TSV is loaded correctly to a sparse matrix.
  */
@@ -1243,6 +1368,39 @@ TEST_CASE("NormalizeLabelTest", "[LoadSaveTest]")
     REQUIRE(randLabels[i] == revertedLabels[i]);
 }
 
+/**
+ * Test normalizing labels directly from a file; the result should match
+ * loading and normalizing in two separate steps.
+ */
+TEST_CASE("NormalizeLabelFromFileTest", "[LoadSaveTest]")
+{
+  arma::rowvec labels("-3 7 7 -3 2 2 -3 7");
+  REQUIRE(data::Save("labels_file.csv", labels) == true);
+
+  arma::Row<size_t> newLabels;
+  arma::vec mappings;
+  REQUIRE(data::NormalizeLabels("labels_file.csv", newLabels, mappings) ==
+      true);
+
+  arma::Row<size_t> expectedLabels;
+  arma::vec expectedMappings;
+  data::NormalizeLabels(labels, expectedLabels, expectedMappings);
+
+  REQUIRE(newLabels.n_elem == expectedLabels.n_elem);
+  for (size_t i = 0; i < newLabels.n_elem; ++i)
+    REQUIRE(newLabels[i] == expectedLabels[i]);
+
+  REQUIRE(mappings.n_elem == expectedMappings.n_elem);
+  for (size_t i = 0; i < mappings.n_elem; ++i)
+    REQUIRE(mappings[i] == expectedMappings[i]);
+
+  // A missing file should report failure, not throw.
+  REQUIRE(data::NormalizeLabels("nonexistent_labels_file.csv", newLabels,
+      mappings) == false);
+
+  remove("labels_file.csv");
+}
+
 // Test structures.
 class TestInner
 {
@@ -2485,3 +2643,318 @@ TEST_CASE("DatasetMapperNonUniqueTest", "[LoadSaveTest]")
   REQUIRE(dm.UnmapString(nan, 0, 1) == "goodbye");
   REQUIRE(dm.UnmapString(nan, 0, 2) == "cheese");
 }
+
+/**
+ * Test that the interned DatasetInfo variant behaves exactly like the default
+ * one.
+ */
+TEST_CASE("InternedDatasetInfoTest", "[LoadSaveTest]")
+{
+  InternedDatasetInfo di(10);
+
+  // Do all types default to numeric?
+  for (size_t i = 0; i < 10; ++i)
+  {
+    REQUIRE(di.Type(i) == Datatype::numeric);
+    REQUIRE(di.NumMappings(i) == 0);
+  }
+
+  // Add enough mappings for dimension 3 that the open-addressing table has
+  // to grow several times.
+  for (size_t i = 0; i < 100; ++i)
+  {
+    std::ostringstream oss;
+    oss << "test_mapping_" << i;
+    REQUIRE(di.MapString<size_t>(oss.str(), 3) == i);
+  }
+
+  // Mapping an already-mapped string must return the existing mapping.
+  REQUIRE(di.MapString<size_t>("test_mapping_42", 3) == 42);
+
+  REQUIRE(di.Type(3) == Datatype::categorical);
+  REQUIRE(di.NumMappings(3) == 100);
+
+  // Get the mappings back, in both directions.
+  for (size_t i = 0; i < 100; ++i)
+  {
+    std::ostringstream oss;
+    oss << "test_mapping_" << i;
+    REQUIRE(di.UnmapString(i, 3) == oss.str());
+    REQUIRE(di.UnmapValue(oss.str(), 3) == i);
+  }
+
+  // Unknown values and inputs must throw, as with the default storage.
+  REQUIRE_THROWS_AS(di.UnmapString(100, 3), std::invalid_argument);
+  REQUIRE_THROWS_AS(di.UnmapValue("unknown_mapping", 3),
+      std::invalid_argument);
+}
+
+/**
+ * Test that the interned DatasetInfo variant survives a serialization round
+ * trip; the hash table is rebuilt on load from the compact form.
+ */
+TEST_CASE("InternedDatasetInfoSerializationTest", "[LoadSaveTest]")
+{
+  InternedDatasetInfo di(3);
+  for (size_t i = 0; i < 50; ++i)
+  {
+    std::ostringstream oss;
+    oss << "category_" << i;
+    di.MapString<size_t>(oss.str(), 1);
+  }
+
+  std::ostringstream output;
+  {
+    cereal::BinaryOutputArchive ar(output);
+    ar(cereal::make_nvp("di", di));
+  }
+
+  InternedDatasetInfo di2;
+  std::istringstream input(output.str());
+  {
+    cereal::BinaryInputArchive ar(input);
+    ar(cereal::make_nvp("di", di2));
+  }
+
+  REQUIRE(di2.Dimensionality() == 3);
+  REQUIRE(di2.Type(1) == Datatype::categorical);
+  REQUIRE(di2.NumMappings(1) == 50);
+  for (size_t i = 0; i < 50; ++i)
+  {
+    std::ostringstream oss;
+    oss << "category_" << i;
+    REQUIRE(di2.UnmapString(i, 1) == oss.str());
+    REQUIRE(di2.UnmapValue(oss.str(), 1) == i);
+  }
+}
+
+/**
+ * Test an ARFF file that qualifies for the chunked parallel parser: all
+ * categorical dimensions pre-declared, no quoting.  Also covers comment
+ * lines inside the @data section and a missing trailing newline.
+ */
+TEST_CASE("ARFFFastPathTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << endl;
+  f << "@attribute one NUMERIC" << endl;
+  f << "@attribute two {red, green, blue}" << endl;
+  f << "@attribute three REAL" << endl;
+  f << endl;
+  f << "@data" << endl;
+  f << "% a comment inside the data section" << endl;
+  for (size_t i = 0; i < 100; ++i)
+  {
+    const char* categories[3] = { "red", "green", "blue" };
+    f << i << ", " << categories[i % 3] << ", " << (0.5 * i);
+    if (i != 99)
+      f << endl; // The last line has no trailing newline.
+  }
+  f.close();
+
+  arma::mat dataset;
+  DatasetInfo info;
+  if (!data::Load("test.arff", dataset, info))
+    FAIL("Cannot load dataset");
+
+  REQUIRE(info.Dimensionality() == 3);
+  REQUIRE(info.Type(0) == Datatype::numeric);
+  REQUIRE(info.Type(1) == Datatype::categorical);
+  REQUIRE(info.NumMappings(1) == 3);
+  REQUIRE(info.Type(2) == Datatype::numeric);
+
+  REQUIRE(dataset.n_rows == 3);
+  REQUIRE(dataset.n_cols == 100);
+
+  for (size_t i = 0; i < 100; ++i)
+  {
+    REQUIRE(dataset(0, i) == Approx(double(i)).epsilon(1e-7));
+    REQUIRE(dataset(1, i) == Approx(double(i % 3)).epsilon(1e-7));
+    REQUIRE(dataset(2, i) == Approx(0.5 * i).epsilon(1e-7));
+  }
+
+  remove("test.arff");
+}
+
+/**
+ * An unknown category in a dimension with pre-declared categories must still
+ * throw, with the fast path declining in favor of the stream parser.
+ */
+TEST_CASE("ARFFFastPathUnknownCategoryTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << "@attribute one {red, green, blue}" << endl;
+  f << "@data" << endl;
+  f << "red" << endl;
+  f << "yellow" << endl;
+  f.close();
+
+  arma::mat dataset;
+  DatasetInfo info;
+  REQUIRE_THROWS_AS(data::LoadARFF("test.arff", dataset, info),
+      std::runtime_error);
+
+  remove("test.arff");
+}
+
+/**
+ * PrefetchingChunkIterator must yield exactly the columns of the source
+ * matrices, in order, and Reset() must allow a second identical pass.
+ */
+TEST_CASE("PrefetchingChunkIteratorTest", "[LoadSaveTest]")
+{
+  arma::mat predictors(5, 103, arma::fill::randu);
+  arma::mat responses(2, 103, arma::fill::randu);
+
+  // A chunk size that does not divide the number of columns, so the last
+  // chunk is smaller.
+  data::PrefetchingChunkIterator<> it(predictors, responses, 10, 2);
+  REQUIRE(it.NumChunks() == 11);
+
+  for (size_t pass = 0; pass < 2; ++pass)
+  {
+    arma::mat chunk, chunkResponses;
+    size_t col = 0;
+    size_t chunks = 0;
+    while (it.Next(chunk, chunkResponses))
+    {
+      REQUIRE(chunk.n_rows == predictors.n_rows);
+      REQUIRE(chunkResponses.n_rows == responses.n_rows);
+      REQUIRE(chunk.n_cols == chunkResponses.n_cols);
+
+      arma::mat expected = predictors.cols(col, col + chunk.n_cols - 1);
+      arma::mat expectedResponses =
+          responses.cols(col, col + chunk.n_cols - 1);
+      CheckMatrices(chunk, expected);
+      CheckMatrices(chunkResponses, expectedResponses);
+
+      col += chunk.n_cols;
+      ++chunks;
+    }
+
+    REQUIRE(col == predictors.n_cols);
+    REQUIRE(chunks == it.NumChunks());
+
+    // A second Next() after exhaustion must still return false.
+    REQUIRE(!it.Next(chunk, chunkResponses));
+
+    it.Reset();
+  }
+}
+
+/**
+ * The predictors-only constructor and Next() overload must work too, and
+ * mismatched responses must be refused.
+ */
+TEST_CASE("PrefetchingChunkIteratorPredictorsOnlyTest", "[LoadSaveTest]")
+{
+  arma::mat predictors(3, 50, arma::fill::randu);
+
+  data::PrefetchingChunkIterator<> it(predictors, 16);
+
+  arma::mat chunk;
+  size_t col = 0;
+  while (it.Next(chunk))
+  {
+    arma::mat expected = predictors.cols(col, col + chunk.n_cols - 1);
+    CheckMatrices(chunk, expected);
+    col += chunk.n_cols;
+  }
+  REQUIRE(col == predictors.n_cols);
+
+  arma::mat responses(1, 49, arma::fill::randu);
+  REQUIRE_THROWS_AS(
+      data::PrefetchingChunkIterator<>(predictors, responses, 16),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure the LZ codec round-trips buffers of different character: empty,
+ * tiny, highly repetitive, and incompressible random bytes.
+ */
+TEST_CASE("LZCodecRoundTripTest", "[LoadSaveTest]")
+{
+  // Empty input compresses to an empty output.
+  REQUIRE(data::LZCompress(NULL, 0).empty());
+
+  std::vector<std::vector<unsigned char>> inputs;
+
+  // Input shorter than the minimum match length.
+  inputs.push_back(std::vector<unsigned char>{ 'a', 'b', 'c' });
+
+  // Highly repetitive input, including overlapping matches.
+  inputs.push_back(std::vector<unsigned char>(10000, 'x'));
+  std::vector<unsigned char> pattern;
+  for (size_t i = 0; i < 5000; ++i)
+    pattern.push_back((unsigned char) ("abcdefg"[i % 7]));
+  inputs.push_back(pattern);
+
+  // Incompressible random bytes.
+  std::vector<unsigned char> random(20000);
+  for (size_t i = 0; i < random.size(); ++i)
+    random[i] = (unsigned char) math::RandInt(0, 256);
+  inputs.push_back(random);
+
+  for (size_t c = 0; c < inputs.size(); ++c)
+  {
+    const std::vector<unsigned char>& input = inputs[c];
+    const std::vector<unsigned char> compressed =
+        data::LZCompress(input.data(), input.size());
+
+    std::vector<unsigned char> output(input.size());
+    REQUIRE(data::LZDecompress(compressed.data(), compressed.size(),
+        output.data(), output.size()));
+    REQUIRE(output == input);
+  }
+
+  // The repetitive input should actually compress.
+  const std::vector<unsigned char> compressed =
+      data::LZCompress(inputs[1].data(), inputs[1].size());
+  REQUIRE(compressed.size() < inputs[1].size() / 10);
+
+  // Truncated input must be detected, not crash or succeed.
+  std::vector<unsigned char> output(inputs[1].size());
+  REQUIRE(!data::LZDecompress(compressed.data(), compressed.size() / 2,
+      output.data(), output.size()));
+}
+
+/**
+ * Make sure CompressedBlob round-trips an object, reports sensible sizes, and
+ * survives serialization of the blob itself.
+ */
+TEST_CASE("CompressedBlobTest", "[LoadSaveTest]")
+{
+  // A matrix with much repetition, so that compression does something.
+  arma::mat x(20, 500);
+  x.fill(3.0);
+  x.row(4) = arma::randu<arma::rowvec>(500);
+
+  data::CompressedBlob<arma::mat> blob(x);
+  REQUIRE(blob.OriginalSize() > 0);
+  REQUIRE(blob.CompressedSize() < blob.OriginalSize());
+
+  arma::mat y;
+  blob.Unpack(y);
+  REQUIRE(arma::approx_equal(x, y, "absdiff", 0.0));
+
+  // Serialize the blob through a binary archive and unpack the copy.
+  std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+  {
+    cereal::BinaryOutputArchive ar(ss);
+    ar(cereal::make_nvp("blob", blob));
+  }
+
+  data::CompressedBlob<arma::mat> blob2;
+  {
+    cereal::BinaryInputArchive ar(ss);
+    ar(cereal::make_nvp("blob", blob2));
+  }
+
+  arma::mat z;
+  blob2.Unpack(z);
+  REQUIRE(arma::approx_equal(x, z, "absdiff", 0.0));
+}
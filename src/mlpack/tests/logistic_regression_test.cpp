@@ -12,6 +12,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/logistic_regression/logistic_regression.hpp>
+#include <mlpack/core/util/data_parallel_function.hpp>
 #include <ensmallen.hpp>
 
 #include "catch.hpp"
@@ -693,6 +694,64 @@ TEST_CASE("LogisticRegressionSGDGaussianTest", "[LogisticRegressionTest]")
   REQUIRE(testAcc == Approx(100.0).epsilon(0.006)); // 0.6% error tolerance.
 }
 
+#ifdef HAS_OPENMP
+
+// Test training of logistic regression on two Gaussians and ensure it's
+// properly separable using parallel SGD (Hogwild!).
+TEST_CASE("LogisticRegressionParallelSGDGaussianTest",
+          "[LogisticRegressionTest]")
+{
+  // Generate a two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("9.0 9.0 9.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, 1000);
+  arma::Row<size_t> responses(1000);
+  for (size_t i = 0; i < 500; ++i)
+  {
+    data.col(i) = g1.Random();
+    responses[i] = 0;
+  }
+  for (size_t i = 500; i < 1000; ++i)
+  {
+    data.col(i) = g2.Random();
+    responses[i] = 1;
+  }
+
+  // Now train a logistic regression object on it.  The thread share size is
+  // chosen so that every point gets visited each iteration.
+  ens::ConstantStep decayPolicy(0.01);
+  ens::ParallelSGD<ens::ConstantStep> psgd(0,
+      std::ceil((float) data.n_cols / omp_get_max_threads()),
+      1e-5, true, decayPolicy);
+  LogisticRegression<> lr(data.n_rows, 0.5);
+  lr.Train(data, responses, psgd);
+
+  // Ensure that the error is close to zero.
+  const double acc = lr.ComputeAccuracy(data, responses);
+
+  REQUIRE(acc == Approx(100.0).epsilon(0.003)); // 0.3% error tolerance.
+
+  // Create a test set.
+  for (size_t i = 0; i < 500; ++i)
+  {
+    data.col(i) = g1.Random();
+    responses[i] = 0;
+  }
+  for (size_t i = 500; i < 1000; ++i)
+  {
+    data.col(i) = g2.Random();
+    responses[i] = 1;
+  }
+
+  // Ensure that the error is close to zero.
+  const double testAcc = lr.ComputeAccuracy(data, responses);
+
+  REQUIRE(testAcc == Approx(100.0).epsilon(0.006)); // 0.6% error tolerance.
+}
+
+#endif
+
 /**
  * Test constructor that takes an already-instantiated optimizer.
  */
@@ -1081,3 +1140,206 @@ TEST_CASE("IncrementalTraining", "[LogisticRegressionTest]")
 
   REQUIRE(acc == Approx(100.0).epsilon(0.03)); // 3% error tolerance.
 }
+
+/**
+ * Concurrent Classify() calls on a single trained model must give the same
+ * results as a serial call: Classify() is const and reentrant.
+ */
+TEST_CASE("LogisticRegressionConcurrentClassifyTest",
+          "[LogisticRegressionTest]")
+{
+  // Generate a two-Gaussian dataset.
+  arma::mat data = arma::join_rows(arma::randn(3, 500) + 2.0,
+      arma::randn(3, 500) - 2.0);
+  arma::Row<size_t> responses = arma::join_rows(
+      arma::zeros<arma::Row<size_t>>(500), arma::ones<arma::Row<size_t>>(500));
+
+  LogisticRegression<> lr(data, responses);
+
+  arma::Row<size_t> serialLabels;
+  lr.Classify(data, serialLabels);
+
+  // Classify the same dataset from several threads at once, each into its own
+  // output; every thread must reproduce the serial results exactly.
+  const size_t runs = 4;
+  std::vector<arma::Row<size_t>> labels(runs);
+  #pragma omp parallel for
+  for (omp_size_t t = 0; t < (omp_size_t) runs; ++t)
+    lr.Classify(data, labels[t]);
+
+  for (size_t t = 0; t < runs; ++t)
+    REQUIRE(arma::all(labels[t] == serialLabels));
+}
+
+/**
+ * Test that shuffling the LogisticRegressionFunction only permutes the order
+ * of visitation: the batch objective and gradient must still sum to the full
+ * objective and gradient.
+ */
+TEST_CASE("LogisticRegressionFunctionShuffledSeparableEvaluate",
+          "[LogisticRegressionTest]")
+{
+  const size_t points = 50;
+  arma::mat data(4, points, arma::fill::randn);
+  arma::Row<size_t> responses(points);
+  for (size_t i = 0; i < points; ++i)
+    responses[i] = math::RandInt(0, 2);
+
+  LogisticRegressionFunction<> lrf(data, responses,
+      0.0 /* no regularization */);
+  const arma::rowvec parameters(5, arma::fill::randn);
+
+  const double fullObjective = lrf.Evaluate(parameters);
+  arma::mat fullGradient;
+  lrf.Gradient(parameters, fullGradient);
+
+  // The visitation ordering must not change the sum over all points, neither
+  // before nor after shuffling.
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    double batchObjective = 0.0;
+    arma::mat batchGradient(arma::size(fullGradient), arma::fill::zeros);
+    for (size_t i = 0; i < points; i += 10)
+    {
+      batchObjective += lrf.Evaluate(parameters, i, 10);
+
+      arma::mat gradient;
+      lrf.Gradient(parameters, i, gradient, 10);
+      batchGradient += gradient;
+    }
+
+    REQUIRE(batchObjective == Approx(fullObjective).epsilon(1e-7));
+    REQUIRE(arma::approx_equal(batchGradient, fullGradient, "absdiff", 1e-7));
+
+    lrf.Shuffle();
+  }
+}
+
+/**
+ * Test that DataParallelFunction reproduces the full-batch objective and
+ * gradient of LogisticRegressionFunction exactly, for several partition
+ * counts, and rejects invalid partition counts.
+ */
+TEST_CASE("LogisticRegressionDataParallelFunctionTest",
+          "[LogisticRegressionTest]")
+{
+  const size_t points = 500;
+  const size_t dimension = 10;
+
+  arma::mat data(dimension, points, arma::fill::randu);
+  arma::Row<size_t> responses(points);
+  for (size_t i = 0; i < points; ++i)
+    responses(i) = math::RandInt(0, 2);
+
+  LogisticRegressionFunction<> lrf(data, responses, 0.5 /* regularization */);
+
+  arma::rowvec parameters(dimension + 1, arma::fill::randu);
+
+  const double fullObjective = lrf.Evaluate(parameters);
+  arma::mat fullGradient;
+  lrf.Gradient(parameters, fullGradient);
+
+  for (size_t numPartitions : { 1, 3, 7 })
+  {
+    util::DataParallelFunction<LogisticRegressionFunction<>> dpf(lrf,
+        numPartitions);
+    REQUIRE(dpf.NumPartitions() == numPartitions);
+    REQUIRE(dpf.NumFunctions() == points);
+
+    REQUIRE(dpf.Evaluate(parameters) == Approx(fullObjective).epsilon(1e-7));
+
+    arma::mat gradient;
+    dpf.Gradient(parameters, gradient);
+    REQUIRE(arma::approx_equal(gradient, fullGradient, "absdiff", 1e-7));
+
+    arma::mat ewgGradient;
+    const double ewgObjective = dpf.EvaluateWithGradient(parameters,
+        ewgGradient);
+    REQUIRE(ewgObjective == Approx(fullObjective).epsilon(1e-7));
+    REQUIRE(arma::approx_equal(ewgGradient, fullGradient, "absdiff", 1e-7));
+  }
+
+  REQUIRE_THROWS_AS(
+      util::DataParallelFunction<LogisticRegressionFunction<>>(lrf, 0),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(
+      util::DataParallelFunction<LogisticRegressionFunction<>>(lrf,
+          points + 1),
+      std::invalid_argument);
+}
+
+/**
+ * Test that per-instance weights behave exactly like replicated points: the
+ * weighted objective function must agree with the unweighted objective
+ * function on a dataset where each point is physically copied as many times
+ * as its (integer) weight.
+ */
+TEST_CASE("LogisticRegressionFunctionWeightedEvaluate",
+          "[LogisticRegressionTest]")
+{
+  const size_t points = 50;
+  const size_t dimension = 4;
+
+  arma::mat data(dimension, points, arma::fill::randu);
+  arma::Row<size_t> responses = arma::randi<arma::Row<size_t>>(points,
+      arma::distr_param(0, 1));
+
+  // Integer weights, so that the replicated dataset is exactly equivalent.
+  arma::rowvec weights(points);
+  for (size_t i = 0; i < points; ++i)
+    weights[i] = (double) ((i % 3) + 1);
+
+  // Build the physically replicated dataset.
+  const size_t repPoints = (size_t) arma::accu(weights);
+  arma::mat repData(dimension, repPoints);
+  arma::Row<size_t> repResponses(repPoints);
+  size_t col = 0;
+  for (size_t i = 0; i < points; ++i)
+  {
+    for (size_t w = 0; w < (size_t) weights[i]; ++w)
+    {
+      repData.col(col) = data.col(i);
+      repResponses[col] = responses[i];
+      ++col;
+    }
+  }
+
+  LogisticRegressionFunction<> weighted(data, responses, weights, 0.5);
+  LogisticRegressionFunction<> replicated(repData, repResponses, 0.5);
+
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    arma::rowvec parameters(dimension + 1, arma::fill::randn);
+    parameters *= 0.1;
+
+    REQUIRE(weighted.Evaluate(parameters) ==
+        Approx(replicated.Evaluate(parameters)).epsilon(1e-7));
+
+    arma::mat weightedGradient, replicatedGradient;
+    weighted.Gradient(parameters, weightedGradient);
+    replicated.Gradient(parameters, replicatedGradient);
+    REQUIRE(arma::approx_equal(weightedGradient, replicatedGradient, "absdiff",
+        1e-7));
+
+    arma::mat ewgGradient;
+    const double ewgObjective = weighted.EvaluateWithGradient(parameters,
+        ewgGradient);
+    REQUIRE(ewgObjective ==
+        Approx(replicated.Evaluate(parameters)).epsilon(1e-7));
+    REQUIRE(arma::approx_equal(ewgGradient, replicatedGradient, "absdiff",
+        1e-7));
+  }
+
+  // Training on the weighted objective should give (nearly) the same model as
+  // training on the replicated dataset.
+  LogisticRegression<> weightedModel(dimension);
+  weightedModel.Train(data, responses, weights);
+  LogisticRegression<> replicatedModel(dimension);
+  replicatedModel.Train(repData, repResponses);
+
+  for (size_t i = 0; i < dimension + 1; ++i)
+  {
+    REQUIRE(weightedModel.Parameters()[i] ==
+        Approx(replicatedModel.Parameters()[i]).margin(1e-3));
+  }
+}
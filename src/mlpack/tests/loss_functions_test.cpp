@@ -32,6 +32,8 @@
 #include <mlpack/methods/ann/loss_functions/cosine_embedding_loss.hpp>
 #include <mlpack/methods/ann/loss_functions/l1_loss.hpp>
 #include <mlpack/methods/ann/loss_functions/soft_margin_loss.hpp>
+#include <mlpack/methods/ann/loss_functions/softmax_cross_entropy_error.hpp>
+#include <mlpack/methods/ann/loss_functions/negative_log_likelihood.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_absolute_percentage_error.hpp>
 #include <mlpack/methods/ann/loss_functions/triplet_margin_loss.hpp>
 #include <mlpack/methods/ann/loss_functions/hinge_loss.hpp>
@@ -883,6 +885,79 @@ TEST_CASE("SoftMarginLossTest", "[LossFunctionsTest]")
   REQUIRE(output.n_cols == input.n_cols);
   CheckMatrices(output, expectedOutput, 0.1);
 }
+
+/**
+ * Simple test for the Softmax Cross-Entropy Error function.
+ */
+TEST_CASE("SoftmaxCrossEntropyErrorTest", "[LossFunctionsTest]")
+{
+  arma::mat input, target, output, reference;
+  SoftmaxCrossEntropyError<> module;
+
+  input = arma::mat("0.5 1.7 -0.3 0.2; -1.2 0.4 2.1 0.0; 0.3 -0.6 0.9 -1.4");
+  target = arma::mat("2 0 1 0");
+
+  // The fused loss must match LogSoftMax followed by NegativeLogLikelihood.
+  LogSoftMax<> softmax;
+  NegativeLogLikelihood<> nll;
+  arma::mat logSoftmaxOutput;
+  softmax.Forward(input, logSoftmaxOutput);
+  const double referenceLoss = nll.Forward(logSoftmaxOutput, target);
+
+  const double loss = module.Forward(input, target);
+  REQUIRE(loss == Approx(referenceLoss).epsilon(1e-5));
+
+  // Test the Backward function; the gradient is softmax(input) minus the
+  // one-hot encoded target, so every column must sum to zero.
+  module.Backward(input, target, output);
+  REQUIRE(output.n_rows == input.n_rows);
+  REQUIRE(output.n_cols == input.n_cols);
+
+  reference = arma::exp(input.each_row() - arma::max(input, 0));
+  reference.each_row() /= arma::sum(reference, 0);
+  for (size_t i = 0; i < target.n_elem; ++i)
+    reference(target(i), i) -= 1;
+  CheckMatrices(output, reference);
+
+  for (size_t i = 0; i < output.n_cols; ++i)
+    REQUIRE(arma::accu(output.col(i)) == Approx(0.0).margin(1e-10));
+}
+
+/**
+ * Test the sampled softmax approximation of the Softmax Cross-Entropy Error
+ * function.
+ */
+TEST_CASE("SampledSoftmaxCrossEntropyErrorTest", "[LossFunctionsTest]")
+{
+  arma::mat input = arma::randn<arma::mat>(50, 4);
+  arma::mat target = arma::mat("4 17 3 42");
+
+  // Sampling at least as many classes as exist must reduce to the exact loss.
+  SoftmaxCrossEntropyError<> exact;
+  SoftmaxCrossEntropyError<> saturated(50);
+  REQUIRE(saturated.Forward(input, target) ==
+      Approx(exact.Forward(input, target)).epsilon(1e-5));
+
+  // With a small sample the loss is still nonnegative and cannot exceed the
+  // exact loss, since the partition sum only shrinks.
+  SoftmaxCrossEntropyError<> sampled(5);
+  const double sampledLoss = sampled.Forward(input, target);
+  REQUIRE(sampledLoss >= 0.0);
+  REQUIRE(sampledLoss <= exact.Forward(input, target) + 1e-10);
+
+  // The gradient touches at most numSamples + 1 rows per column, and each
+  // column still sums to zero.
+  arma::mat gradient;
+  sampled.Backward(input, target, gradient);
+  REQUIRE(gradient.n_rows == input.n_rows);
+  REQUIRE(gradient.n_cols == input.n_cols);
+  for (size_t i = 0; i < gradient.n_cols; ++i)
+  {
+    REQUIRE(arma::accu(gradient.col(i)) == Approx(0.0).margin(1e-10));
+    REQUIRE(arma::accu(gradient.col(i) != 0) <= 6);
+  }
+}
+
 /**
  * Simple test for the Mean Absolute Percentage Error function.
  */
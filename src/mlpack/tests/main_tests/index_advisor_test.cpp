@@ -0,0 +1,113 @@
+/**
+ * @file tests/main_tests/index_advisor_test.cpp
+ *
+ * Test mlpackMain() of index_advisor_main.cpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <string>
+
+#define BINDING_TYPE BINDING_TYPE_TEST
+static const std::string testName = "NearestNeighborIndexAdvisor";
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+#include "test_helper.hpp"
+#include <mlpack/methods/neighbor_search/index_advisor_main.cpp>
+
+#include "../test_catch_tools.hpp"
+#include "../catch.hpp"
+
+using namespace mlpack;
+
+struct IndexAdvisorTestFixture
+{
+ public:
+  IndexAdvisorTestFixture()
+  {
+    // Cache in the options for this program.
+    IO::RestoreSettings(testName);
+  }
+
+  ~IndexAdvisorTestFixture()
+  {
+    // Clear the settings.
+    bindings::tests::CleanMemory();
+    IO::ClearSettings();
+  }
+};
+
+/*
+ * Check that an invalid k is rejected.
+ */
+TEST_CASE_METHOD(IndexAdvisorTestFixture, "IndexAdvisorInvalidKTest",
+                 "[IndexAdvisorMainTest][BindingTests]")
+{
+  arma::mat referenceData;
+  referenceData.randu(3, 100); // 100 points in 3 dimensions.
+
+  SetInputParam("reference", std::move(referenceData));
+  SetInputParam("k", (int) 101); // Invalid: more than the reference points.
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/*
+ * Check that a sample size not greater than k is rejected.
+ */
+TEST_CASE_METHOD(IndexAdvisorTestFixture, "IndexAdvisorInvalidSampleSizeTest",
+                 "[IndexAdvisorMainTest][BindingTests]")
+{
+  arma::mat referenceData;
+  referenceData.randu(3, 100); // 100 points in 3 dimensions.
+
+  SetInputParam("reference", std::move(referenceData));
+  SetInputParam("k", (int) 10);
+  SetInputParam("sample_size", (int) 10);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/*
+ * Check that the advisor emits a usable model built on the full reference
+ * set.
+ */
+TEST_CASE_METHOD(IndexAdvisorTestFixture, "IndexAdvisorModelOutputTest",
+                 "[IndexAdvisorMainTest][BindingTests]")
+{
+  arma::mat referenceData;
+  referenceData.randu(4, 400); // 400 points in 4 dimensions.
+
+  SetInputParam("reference", referenceData);
+  SetInputParam("k", (int) 3);
+  SetInputParam("batch_size", (int) 32);
+  SetInputParam("sample_size", (int) 200);
+  SetInputParam("seed", (int) 1);
+
+  mlpackMain();
+
+  KNNModel* model = IO::GetParam<KNNModel*>("output_model");
+  REQUIRE(model != NULL);
+
+  // The recommended model must be built on the full reference set, with a
+  // usable leaf size, and must answer queries.
+  REQUIRE(model->Dataset().n_rows == 4);
+  REQUIRE(model->Dataset().n_cols == 400);
+  REQUIRE(model->LeafSize() > 0);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  model->Search(3, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 3);
+  REQUIRE(neighbors.n_cols == 400);
+  REQUIRE(distances.n_rows == 3);
+  REQUIRE(distances.n_cols == 400);
+}
@@ -574,3 +574,135 @@ TEST_CASE_METHOD(KDETestFixture, "KDEMainMonteCarloFlag",
   const double sumDifferences = arma::accu(differences);
   REQUIRE(sumDifferences > 0);
 }
+
+/**
+  * Ensure that when the data lies close to a low-dimensional subspace, the
+  * subspace projection gives estimations close to the full-dimensional ones.
+ **/
+TEST_CASE_METHOD(KDETestFixture, "KDESubspaceVarianceMain",
+                "[KDEMainTest][BindingTests]")
+{
+  // Datasets: 3 informative dimensions plus 37 dimensions of tiny noise.
+  arma::mat reference = arma::join_cols(arma::randu(3, 400),
+      0.001 * arma::randn(37, 400));
+  arma::mat query = arma::join_cols(arma::randu(3, 100),
+      0.001 * arma::randn(37, 100));
+  arma::vec kdeEstimations, mainEstimations;
+  double kernelBandwidth = 0.8;
+  double relError = 0.01;
+
+  // Full-dimensional estimations.
+  kernel::GaussianKernel kernel(kernelBandwidth);
+  metric::EuclideanDistance metric;
+  KDE<kernel::GaussianKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::KDTree>
+      kde(relError, 0.0, kernel, KDEMode::DUAL_TREE_MODE, metric);
+  kde.Train(arma::mat(reference));
+  kde.Evaluate(arma::mat(query), kdeEstimations);
+  // Normalize estimations.
+  kdeEstimations /= kernel.Normalizer(reference.n_rows);
+
+  // Main estimations with subspace projection.
+  SetInputParam("reference", reference);
+  SetInputParam("query", query);
+  SetInputParam("kernel", std::string("gaussian"));
+  SetInputParam("tree", std::string("kd-tree"));
+  SetInputParam("rel_error", relError);
+  SetInputParam("bandwidth", kernelBandwidth);
+  SetInputParam("subspace_variance", 0.99);
+
+  mlpackMain();
+  mainEstimations = std::move(IO::GetParam<arma::vec>("predictions"));
+
+  // The projection discards almost no variance, so estimations should be
+  // close to the full-dimensional ones.
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(mainEstimations[i] == Approx(kdeEstimations[i]).epsilon(0.05));
+}
+
+/**
+  * Ensuring that an invalid retained variance fraction results in a runtime
+  * error.
+ **/
+TEST_CASE_METHOD(KDETestFixture, "KDEMainInvalidSubspaceVariance",
+                "[KDEMainTest][BindingTests]")
+{
+  arma::mat reference = arma::randu<arma::mat>(2, 10);
+  arma::mat query = arma::randu<arma::mat>(2, 5);
+
+  // Main params.
+  SetInputParam("reference", reference);
+  SetInputParam("query", query);
+  SetInputParam("kernel", std::string("gaussian"));
+
+  Log::Fatal.ignoreInput = true;
+  // Invalid when 0 or below.
+  SetInputParam("subspace_variance", 0.0);
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+
+  // Valid between 0 and 1.
+  SetInputParam("subspace_variance", 0.9);
+  REQUIRE_NOTHROW(mlpackMain());
+
+  // Invalid greater than 1.
+  SetInputParam("subspace_variance", 1.1);
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/**
+  * Ensure that a leaf size of zero makes the KDE binding select a leaf size
+  * automatically, and that the estimations match the ones obtained with the
+  * default leaf size.
+ **/
+TEST_CASE_METHOD(KDETestFixture, "KDELeafSizeAutotune",
+                "[KDEMainTest][BindingTests]")
+{
+  // Datasets.
+  arma::mat reference = arma::randu(3, 400);
+  arma::mat query = arma::randu(3, 100);
+  arma::vec defaultEstimations, tunedEstimations;
+  double kernelBandwidth = 1.5;
+  double relError = 0.05;
+
+  // Estimations with the default leaf size.
+  SetInputParam("reference", reference);
+  SetInputParam("query", query);
+  SetInputParam("kernel", std::string("gaussian"));
+  SetInputParam("tree", std::string("kd-tree"));
+  SetInputParam("rel_error", relError);
+  SetInputParam("bandwidth", kernelBandwidth);
+
+  mlpackMain();
+
+  defaultEstimations = std::move(IO::GetParam<arma::vec>("predictions"));
+
+  delete IO::GetParam<KDEModel*>("output_model");
+  IO::GetParam<KDEModel*>("output_model") = NULL;
+  ResetKDESettings();
+
+  // Estimations with an automatically selected leaf size.
+  SetInputParam("reference", reference);
+  SetInputParam("query", query);
+  SetInputParam("kernel", std::string("gaussian"));
+  SetInputParam("tree", std::string("kd-tree"));
+  SetInputParam("rel_error", relError);
+  SetInputParam("bandwidth", kernelBandwidth);
+  SetInputParam("leaf_size", (int) 0);
+
+  mlpackMain();
+
+  tunedEstimations = std::move(IO::GetParam<arma::vec>("predictions"));
+
+  // A leaf size must have been selected.
+  REQUIRE(IO::GetParam<KDEModel*>("output_model")->LeafSize() > 0);
+
+  // The estimations must agree within the error tolerance of both runs.
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    REQUIRE(defaultEstimations[i] ==
+        Approx(tunedEstimations[i]).epsilon(2 * relError));
+  }
+}
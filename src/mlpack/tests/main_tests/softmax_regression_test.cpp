@@ -259,7 +259,8 @@ TEST_CASE_METHOD(
 }
 
 /**
- * Make sure only one of training data or pre-trained model is passed.
+ * Make sure that passing both training data and a pre-trained model continues
+ * training from the model parameters (a warm start).
  */
 TEST_CASE_METHOD(
     SoftmaxRegressionTestFixture,
@@ -279,18 +280,23 @@ TEST_CASE_METHOD(
   inputData.shed_row(inputData.n_rows - 1);
 
   // Input training data.
-  SetInputParam("training", std::move(inputData));
-  SetInputParam("labels", std::move(labels));
+  SetInputParam("training", inputData);
+  SetInputParam("labels", labels);
 
   mlpackMain();
 
-  // Input pre-trained model.
+  // Pass the trained model back in along with the training data; this should
+  // warm-start training rather than fail.
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("labels", std::move(labels));
   SetInputParam("input_model",
                 IO::GetParam<SoftmaxRegression*>("output_model"));
 
-  Log::Fatal.ignoreInput = true;
-  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
-  Log::Fatal.ignoreInput = false;
+  mlpackMain();
+
+  // The retrained model should have the same shape as before.
+  REQUIRE(IO::GetParam<SoftmaxRegression*>("output_model")->
+      Parameters().n_elem > 0);
 }
 
 /**
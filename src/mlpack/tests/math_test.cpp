@@ -10,8 +10,13 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core/math/clamp.hpp>
+#include <mlpack/core/math/fast_projection.hpp>
 #include <mlpack/core/math/random.hpp>
 #include <mlpack/core/math/range.hpp>
+#include <mlpack/core/math/log_add.hpp>
+#include <mlpack/core/math/multiply_slices.hpp>
+#include <mlpack/core/math/simd_kernels.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
 
@@ -1006,3 +1011,351 @@ TEST_CASE("InplaceSparseShuffleWeightsTest", "[MathTest]")
     REQUIRE(weightCounts[i] == 1);
   }
 }
+
+/**
+ * Test that Z-order encoding matches the quadrant structure on a known
+ * 2-dimensional example.
+ */
+TEST_CASE("ZOrderValueTest", "[MathTest]")
+{
+  // Corners of the unit square: the high halves of the code interleave the
+  // quadrant bits, so codes must order as quadrants 00 < 10 < 01 < 11 (x is
+  // the low interleaved bit).
+  arma::mat corners("0 1 0 1; 0 0 1 1");
+  const arma::vec mins("0 0");
+  const arma::vec widths("1 1");
+
+  const uint64_t c00 = math::ZOrderValue(corners.col(0), mins, widths);
+  const uint64_t c10 = math::ZOrderValue(corners.col(1), mins, widths);
+  const uint64_t c01 = math::ZOrderValue(corners.col(2), mins, widths);
+  const uint64_t c11 = math::ZOrderValue(corners.col(3), mins, widths);
+
+  REQUIRE(c00 < c10);
+  REQUIRE(c10 < c01);
+  REQUIRE(c01 < c11);
+
+  // In one dimension the curve reduces to numeric order.
+  arma::mat line("0.9 0.1 0.5 0.3");
+  std::vector<size_t> ordering;
+  math::ZOrderIndices(line, ordering);
+  REQUIRE(ordering.size() == 4);
+  REQUIRE(ordering[0] == 1);
+  REQUIRE(ordering[1] == 3);
+  REQUIRE(ordering[2] == 2);
+  REQUIRE(ordering[3] == 0);
+}
+
+/**
+ * Test that ZOrderPoints() permutes the dataset and fills a consistent
+ * oldFromNew mapping.
+ */
+TEST_CASE("ZOrderPointsTest", "[MathTest]")
+{
+  arma::mat data(3, 200, arma::fill::randu);
+  const arma::mat original(data);
+
+  std::vector<size_t> oldFromNew;
+  math::ZOrderPoints(data, oldFromNew);
+
+  REQUIRE(oldFromNew.size() == original.n_cols);
+
+  // The mapping must be a permutation, and each permuted column must match
+  // the original column it claims to come from.
+  std::vector<bool> seen(original.n_cols, false);
+  for (size_t i = 0; i < original.n_cols; ++i)
+  {
+    REQUIRE(oldFromNew[i] < original.n_cols);
+    REQUIRE(!seen[oldFromNew[i]]);
+    seen[oldFromNew[i]] = true;
+
+    for (size_t d = 0; d < original.n_rows; ++d)
+      REQUIRE(data(d, i) == Approx(original(d, oldFromNew[i])).epsilon(1e-10));
+  }
+}
+
+/**
+ * Test that the runtime-dispatched SIMD kernels agree with the equivalent
+ * Armadillo expressions.
+ */
+TEST_CASE("SimdKernelEquivalenceTest", "[MathTest]")
+{
+  arma::vec a(257, arma::fill::randn);
+  arma::vec b(257, arma::fill::randn);
+
+  // Squared distances, through the raw kernel and the dispatching wrapper.
+  const double ref = arma::accu(arma::square(a - b));
+  REQUIRE(simd::SquaredDistance(a.memptr(), b.memptr(), a.n_elem) ==
+      Approx(ref).epsilon(1e-10));
+  REQUIRE(simd::SquaredDistance(a, b) == Approx(ref).epsilon(1e-10));
+
+  // Column subviews are contiguous and must also take the kernel path.
+  arma::mat m(257, 2, arma::fill::randn);
+  REQUIRE(simd::SquaredDistance(m.col(0), m.col(1)) ==
+      Approx(arma::accu(arma::square(m.col(0) - m.col(1)))).epsilon(1e-10));
+
+  // Single-precision kernel.
+  arma::fvec fa(100, arma::fill::randn);
+  arma::fvec fb(100, arma::fill::randn);
+  REQUIRE(simd::SquaredDistance(fa, fb) ==
+      Approx(arma::accu(arma::square(fa - fb))).epsilon(1e-4));
+
+  // The L2 metric must agree with its old definition.
+  metric::SquaredEuclideanDistance sed;
+  metric::EuclideanDistance ed;
+  REQUIRE(sed.Evaluate(a, b) == Approx(ref).epsilon(1e-10));
+  REQUIRE(ed.Evaluate(a, b) == Approx(std::sqrt(ref)).epsilon(1e-10));
+
+  // Activation kernels.
+  arma::vec logistic(a.n_elem);
+  simd::Logistic(a.memptr(), logistic.memptr(), a.n_elem);
+  REQUIRE(arma::approx_equal(logistic,
+      arma::vec(1.0 / (1.0 + arma::exp(-a))), "absdiff", 1e-12));
+
+  arma::vec rectified(a.n_elem);
+  simd::Rectifier(a.memptr(), rectified.memptr(), a.n_elem);
+  REQUIRE(arma::approx_equal(rectified,
+      arma::vec(arma::clamp(a, 0.0, arma::datum::inf)), "absdiff", 1e-12));
+}
+
+/**
+ * Test the log-sum-exp kernel against the shifted reference computation,
+ * including the stability and empty-input edge cases.
+ */
+TEST_CASE("SimdLogSumExpTest", "[MathTest]")
+{
+  arma::vec x(301, arma::fill::randn);
+  const double maxVal = arma::max(x);
+  const double ref = maxVal + std::log(arma::accu(arma::exp(x - maxVal)));
+
+  REQUIRE(simd::LogSumExp(x.memptr(), x.n_elem) ==
+      Approx(ref).epsilon(1e-10));
+  REQUIRE(AccuLog(x) == Approx(ref).epsilon(1e-10));
+
+  // Large values must not overflow thanks to the max shift.
+  arma::vec big(10);
+  big.fill(1000.0);
+  REQUIRE(simd::LogSumExp(big.memptr(), big.n_elem) ==
+      Approx(1000.0 + std::log(10.0)).epsilon(1e-10));
+
+  // All -inf (and empty) inputs return -inf instead of NaN.
+  arma::vec inf(5);
+  inf.fill(-arma::datum::inf);
+  REQUIRE(simd::LogSumExp(inf.memptr(), inf.n_elem) == -arma::datum::inf);
+  REQUIRE(simd::LogSumExp((const double*) NULL, 0) == -arma::datum::inf);
+}
+
+/**
+ * Test that OrderedBatch() gathers exactly the columns named by the
+ * visitation ordering, and that an empty ordering denotes the identity.
+ */
+TEST_CASE("OrderedBatchTest", "[MathTest]")
+{
+  arma::mat data(5, 60, arma::fill::randu);
+
+  // The empty ordering gathers a contiguous slice.
+  arma::mat batch;
+  OrderedBatch(data, arma::uvec(), 10, 20, batch);
+  REQUIRE(arma::approx_equal(batch, data.cols(10, 29), "absdiff", 1e-15));
+
+  // A shuffled ordering gathers the permuted columns.
+  const arma::uvec ordering = ShuffleOrdering(data.n_cols);
+  OrderedBatch(data, ordering, 10, 20, batch);
+  REQUIRE(batch.n_rows == data.n_rows);
+  REQUIRE(batch.n_cols == 20);
+  for (size_t i = 0; i < 20; ++i)
+  {
+    REQUIRE(arma::approx_equal(batch.col(i), data.col(ordering[10 + i]),
+        "absdiff", 1e-15));
+  }
+
+  // The sparse overload must assemble the same batch column by column.
+  arma::sp_mat sparseData(data);
+  arma::sp_mat sparseBatch;
+  OrderedBatch(sparseData, ordering, 10, 20, sparseBatch);
+  REQUIRE(arma::approx_equal(arma::mat(sparseBatch), batch, "absdiff",
+      1e-15));
+}
+
+/**
+ * Test that the parallel slice multiplication produces the same result as
+ * multiplying each slice by hand, for all transposition combinations.
+ */
+TEST_CASE("MultiplySlicesParallelTest", "[MathTest]")
+{
+  arma::cube a(7, 5, 40, arma::fill::randn);
+  arma::cube b(5, 9, 40, arma::fill::randn);
+
+  const arma::cube ab = MultiplyCube2Cube(a, b);
+  const arma::cube atbt = MultiplyCube2Cube(b, a, true, true);
+  for (size_t i = 0; i < a.n_slices; ++i)
+  {
+    REQUIRE(arma::approx_equal(ab.slice(i), a.slice(i) * b.slice(i),
+        "absdiff", 1e-12));
+    REQUIRE(arma::approx_equal(atbt.slice(i), b.slice(i).t() * a.slice(i).t(),
+        "absdiff", 1e-12));
+  }
+
+  arma::mat m(9, 7, arma::fill::randn);
+  arma::mat m2(9, 5, arma::fill::randn);
+  const arma::cube ma = MultiplyMat2Cube(m, a);
+  const arma::cube am = MultiplyCube2Mat(a, m2, false, true);
+  for (size_t i = 0; i < a.n_slices; ++i)
+  {
+    REQUIRE(arma::approx_equal(ma.slice(i), m * a.slice(i), "absdiff",
+        1e-12));
+    REQUIRE(arma::approx_equal(am.slice(i), a.slice(i) * m2.t(), "absdiff",
+        1e-12));
+  }
+}
+
+/**
+ * Test the deterministic random streams: equal (seed, stream) pairs reproduce
+ * the same sequence, different streams differ, and SeedThreadStream() makes
+ * the global generator reproducible.
+ */
+TEST_CASE("RandomStreamTest", "[MathTest]")
+{
+  // The same (seed, stream) pair must always yield the same sequence.
+  RandomStream a(17, 3);
+  RandomStream b(17, 3);
+  for (size_t i = 0; i < 50; ++i)
+    REQUIRE(a() == b());
+
+  // Different streams (and different seeds) must yield different sequences.
+  RandomStream c(17, 4);
+  RandomStream d(18, 3);
+  RandomStream e(17, 3);
+  size_t cDiffers = 0, dDiffers = 0;
+  for (size_t i = 0; i < 50; ++i)
+  {
+    const uint64_t ref = e();
+    cDiffers += (c() != ref);
+    dDiffers += (d() != ref);
+  }
+  REQUIRE(cDiffers > 0);
+  REQUIRE(dDiffers > 0);
+
+  // The streams can drive <random> distributions.
+  RandomStream f(3);
+  std::uniform_real_distribution<> dist(0.0, 1.0);
+  for (size_t i = 0; i < 50; ++i)
+  {
+    const double value = dist(f);
+    REQUIRE(value >= 0.0);
+    REQUIRE(value <= 1.0);
+  }
+
+  // Reseeding the calling thread to the same stream must reproduce the same
+  // draws from the global generator.
+  SeedThreadStream(5);
+  const double r1 = Random();
+  const double r2 = Random();
+  SeedThreadStream(5);
+  REQUIRE(Random() == r1);
+  REQUIRE(Random() == r2);
+}
+
+/**
+ * The subsampled randomized Hadamard transform must act like its explicit
+ * projection matrix: projecting a matrix column-by-column, projecting rows,
+ * projecting sparse input, and applying the pseudoinverse must all agree with
+ * the dense linear algebra.
+ */
+TEST_CASE("SubsampledHadamardProjectionTest", "[MathTest]")
+{
+  const size_t inputDim = 11; // Will be padded to 16.
+  const size_t outputDim = 7;
+  SubsampledHadamardProjection proj(inputDim, outputDim);
+
+  REQUIRE(proj.InputDim() == inputDim);
+  REQUIRE(proj.OutputDim() == outputDim);
+
+  // Recover the explicit projection matrix by projecting the identity.
+  arma::mat explicitMatrix;
+  proj.Project(arma::mat(arma::eye(inputDim, inputDim)), explicitMatrix);
+  REQUIRE(explicitMatrix.n_rows == outputDim);
+  REQUIRE(explicitMatrix.n_cols == inputDim);
+
+  arma::mat x(inputDim, 25, arma::fill::randn);
+
+  // The implicit transform must match multiplication by the explicit matrix.
+  arma::mat projected;
+  proj.Project(x, projected);
+  REQUIRE(arma::approx_equal(projected, explicitMatrix * x, "absdiff",
+      1e-10));
+
+  // Projecting the rows of x^T is the transpose of projecting the columns of
+  // x.
+  arma::mat rowProjected;
+  proj.ProjectRows(arma::mat(x.t()), rowProjected);
+  REQUIRE(arma::approx_equal(rowProjected, projected.t(), "absdiff", 1e-10));
+
+  // Sparse input must give the same result as dense input.
+  arma::mat sparseProjected;
+  proj.Project(arma::sp_mat(x), sparseProjected);
+  REQUIRE(arma::approx_equal(sparseProjected, projected, "absdiff", 1e-10));
+
+  // ProjectBack() applies the scaled adjoint (k / p) A^T, the pseudoinverse
+  // of the padded transform; here p = 16 is the padded dimensionality.
+  arma::mat reconstructed;
+  proj.ProjectBack(projected, reconstructed);
+  REQUIRE(arma::approx_equal(reconstructed, (7.0 / 16.0) *
+      explicitMatrix.t() * projected, "absdiff", 1e-10));
+}
+
+/**
+ * When the input dimensionality is a power of two and no coordinates are
+ * dropped, the transform is orthogonal, so the pseudoinverse must invert it
+ * exactly.
+ */
+TEST_CASE("SubsampledHadamardProjectionRoundTripTest", "[MathTest]")
+{
+  const size_t dim = 16;
+  SubsampledHadamardProjection proj(dim, dim);
+
+  arma::mat x(dim, 10, arma::fill::randn);
+  arma::mat projected, reconstructed;
+  proj.Project(x, projected);
+  proj.ProjectBack(projected, reconstructed);
+
+  REQUIRE(arma::approx_equal(reconstructed, x, "absdiff", 1e-10));
+
+  // An orthogonal transform preserves squared norms exactly.
+  REQUIRE(arma::norm(projected, "fro") ==
+      Approx(arma::norm(x, "fro")).epsilon(1e-10));
+}
+
+/**
+ * The count-sketch transform must also match its explicit projection matrix,
+ * and that matrix must have exactly one nonzero of unit magnitude per column.
+ */
+TEST_CASE("CountSketchProjectionTest", "[MathTest]")
+{
+  const size_t inputDim = 20;
+  const size_t outputDim = 6;
+  CountSketchProjection proj(inputDim, outputDim);
+
+  REQUIRE(proj.InputDim() == inputDim);
+  REQUIRE(proj.OutputDim() == outputDim);
+
+  // Recover the explicit projection matrix by projecting the identity.
+  arma::mat explicitMatrix;
+  proj.Project(arma::mat(arma::eye(inputDim, inputDim)), explicitMatrix);
+  for (size_t i = 0; i < inputDim; ++i)
+  {
+    REQUIRE(arma::accu(explicitMatrix.col(i) != 0) == 1);
+    REQUIRE(arma::accu(arma::abs(explicitMatrix.col(i))) ==
+        Approx(1.0).epsilon(1e-10));
+  }
+
+  arma::mat x(inputDim, 25, arma::fill::randn);
+
+  arma::mat projected;
+  proj.Project(x, projected);
+  REQUIRE(arma::approx_equal(projected, explicitMatrix * x, "absdiff",
+      1e-10));
+
+  arma::mat rowProjected;
+  proj.ProjectRows(arma::mat(x.t()), rowProjected);
+  REQUIRE(arma::approx_equal(rowProjected, projected.t(), "absdiff", 1e-10));
+}
@@ -60,3 +60,35 @@ TEST_CASE("UniformMatrixCompletionSDP", "[MatrixCompletionTest]")
        Approx(Xorig(indices(0, i), indices(1, i))).epsilon(1e-7));
   }
 }
+
+/**
+ * The blockwise solver should recover a good approximation of the same matrix
+ * while only ever solving subproblems over sampled constraint subsets.
+ */
+TEST_CASE("BlockwiseMatrixCompletionSDP", "[MatrixCompletionTest]")
+{
+  arma::mat Xorig, values;
+  arma::umat indices;
+
+  if (!data::Load("completion_X.csv", Xorig, false, false))
+    FAIL("Cannot load dataset completion_X.csv");
+  if (!data::Load("completion_indices.csv", indices, false, false))
+    FAIL("Cannot load dataset completion_indices.csv");
+
+  values.set_size(indices.n_cols);
+  for (size_t i = 0; i < indices.n_cols; ++i)
+  {
+    values(i) = Xorig(indices(0, i), indices(1, i));
+  }
+
+  arma::mat recovered;
+  MatrixCompletion mc(Xorig.n_rows, Xorig.n_cols, indices, values);
+  mc.Recover(recovered, indices.n_cols / 2, 25, 1e-5);
+
+  // Each round only enforces a sampled half of the constraints, so the
+  // recovery is approximate; require a reasonably small relative error.
+  const double err =
+    arma::norm(Xorig - recovered, "fro") /
+    arma::norm(Xorig, "fro");
+  REQUIRE(err == Approx(0.0).margin(0.05));
+}
@@ -12,6 +12,7 @@
 #include <mlpack/core/metrics/lmetric.hpp>
 #include "catch.hpp"
 #include <mlpack/core/metrics/iou_metric.hpp>
+#include <mlpack/core/metrics/counting_metric.hpp>
 #include <mlpack/core/metrics/non_maximal_supression.hpp>
 #include <mlpack/core/metrics/bleu.hpp>
 #include "test_catch_tools.hpp"
@@ -97,6 +98,76 @@ TEST_CASE("LINFMetricTest", "[MetricTest]")
       Approx(lMetric.Evaluate(a2, b2)).epsilon(1e-7));
 }
 
+/**
+ * Test for the early-abandoning (bounded) L-metric evaluation: within the
+ * bound the result must be exact, and past the bound the result must still
+ * exceed the bound.
+ */
+TEST_CASE("LMetricBoundedEvaluateTest", "[MetricTest]")
+{
+  // Use enough dimensions that several blocks are accumulated.
+  arma::vec a(300, arma::fill::randn);
+  arma::vec b(300, arma::fill::randn);
+
+  const double l1 = ManhattanDistance::Evaluate(a, b);
+  const double l2 = EuclideanDistance::Evaluate(a, b);
+  const double l2Sq = SquaredEuclideanDistance::Evaluate(a, b);
+  const double lInf = ChebyshevDistance::Evaluate(a, b);
+
+  // A bound at least as large as the distance must give the exact result.
+  REQUIRE(ManhattanDistance::Evaluate(a, b, l1) ==
+      Approx(l1).epsilon(1e-10));
+  REQUIRE(EuclideanDistance::Evaluate(a, b, 2.0 * l2) ==
+      Approx(l2).epsilon(1e-10));
+  REQUIRE(SquaredEuclideanDistance::Evaluate(a, b, l2Sq) ==
+      Approx(l2Sq).epsilon(1e-10));
+  REQUIRE(ChebyshevDistance::Evaluate(a, b, 2.0 * lInf) ==
+      Approx(lInf).epsilon(1e-10));
+
+  // A tighter bound may abandon the evaluation, but the result must then
+  // still exceed the bound (and can never exceed the true distance).
+  const double abandoned = EuclideanDistance::Evaluate(a, b, 0.5 * l2);
+  REQUIRE(abandoned > 0.5 * l2);
+  REQUIRE(abandoned <= l2 * (1.0 + 1e-10));
+
+  const double abandonedL1 = ManhattanDistance::Evaluate(a, b, 0.25 * l1);
+  REQUIRE(abandonedL1 > 0.25 * l1);
+  REQUIRE(abandonedL1 <= l1 * (1.0 + 1e-10));
+}
+
+/**
+ * The CountingMetric must return the wrapped metric's distances unchanged and
+ * count every Evaluate() call, with the counter shared between instances.
+ */
+TEST_CASE("CountingMetricTest", "[MetricTest]")
+{
+  arma::vec a(25, arma::fill::randn);
+  arma::vec b(25, arma::fill::randn);
+
+  CountingMetric<EuclideanDistance>::ResetCount();
+  REQUIRE(CountingMetric<EuclideanDistance>::Evaluations() == 0);
+
+  CountingMetric<EuclideanDistance> counted;
+  REQUIRE(counted.Evaluate(a, b) ==
+      Approx(EuclideanDistance::Evaluate(a, b)).epsilon(1e-10));
+  REQUIRE(CountingMetric<EuclideanDistance>::Evaluations() == 1);
+
+  // A copy shares the same counter.
+  CountingMetric<EuclideanDistance> copy(counted);
+  copy.Evaluate(b, a);
+  REQUIRE(CountingMetric<EuclideanDistance>::Evaluations() == 2);
+
+  // Counts for different wrapped metric types are independent.
+  CountingMetric<ManhattanDistance> countedL1;
+  countedL1.Evaluate(a, b);
+  REQUIRE(CountingMetric<ManhattanDistance>::Evaluations() == 1);
+  REQUIRE(CountingMetric<EuclideanDistance>::Evaluations() == 2);
+
+  CountingMetric<EuclideanDistance>::ResetCount();
+  CountingMetric<ManhattanDistance>::ResetCount();
+  REQUIRE(CountingMetric<EuclideanDistance>::Evaluations() == 0);
+}
+
 /**
  * Simple test for IoU metric.
  */
@@ -398,3 +398,121 @@ TEST_CASE("NaiveBayesClassifierHighDimensionsTest", "[NBCTest]")
   for (size_t i = 0; i < calcVec.n_cols; ++i)
     REQUIRE(calcVec(i) == testLabels(i));
 }
+
+/**
+ * Test that the chunked incremental trainer gives the same model as the
+ * two-pass batch trainer on a dataset large enough to span several chunks.
+ */
+TEST_CASE("ChunkedIncrementalTrainTest", "[NBCTest]")
+{
+  const size_t classes = 3;
+  arma::mat data = arma::randn<arma::mat>(5, 3000);
+  arma::Row<size_t> labels(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    labels[i] = math::RandInt(0, (int) classes);
+
+  NaiveBayesClassifier<> nbcBatch(data, labels, classes, false);
+  NaiveBayesClassifier<> nbcInc(data, labels, classes, true);
+
+  for (size_t i = 0; i < nbcBatch.Means().n_elem; ++i)
+  {
+    REQUIRE(nbcInc.Means()[i] ==
+        Approx(nbcBatch.Means()[i]).epsilon(1e-7));
+    REQUIRE(nbcInc.Variances()[i] ==
+        Approx(nbcBatch.Variances()[i]).epsilon(1e-7));
+  }
+  for (size_t i = 0; i < classes; ++i)
+  {
+    REQUIRE(nbcInc.Probabilities()[i] ==
+        Approx(nbcBatch.Probabilities()[i]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Test that a float model (ModelMatType = arma::fmat) can be trained both
+ * incrementally and in batch mode, and closely matches the double model.
+ */
+TEST_CASE("FloatModelTrainTest", "[NBCTest]")
+{
+  const size_t classes = 2;
+  arma::mat data = arma::randn<arma::mat>(4, 500);
+  arma::Row<size_t> labels(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    labels[i] = math::RandInt(0, (int) classes);
+  arma::fmat floatData = arma::conv_to<arma::fmat>::from(data);
+
+  NaiveBayesClassifier<> nbc(data, labels, classes, true);
+  NaiveBayesClassifier<arma::fmat> nbcFloat(floatData, labels, classes, true);
+
+  for (size_t i = 0; i < nbc.Means().n_elem; ++i)
+  {
+    REQUIRE(nbcFloat.Means()[i] ==
+        Approx((float) nbc.Means()[i]).epsilon(1e-3));
+    REQUIRE(nbcFloat.Variances()[i] ==
+        Approx((float) nbc.Variances()[i]).epsilon(1e-3));
+  }
+
+  // Predictions from both models should agree on nearly all points.
+  arma::Row<size_t> predictions, floatPredictions;
+  nbc.Classify(data, predictions);
+  nbcFloat.Classify(floatData, floatPredictions);
+  size_t agreements = 0;
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    if (predictions[i] == floatPredictions[i])
+      ++agreements;
+  REQUIRE(agreements >= (size_t) (0.99 * predictions.n_elem));
+}
+
+/**
+ * Test that training with per-instance weights gives the same model as
+ * training on a dataset where each point is physically copied as many times
+ * as its (integer) weight.
+ */
+TEST_CASE("NaiveBayesWeightedTrainTest", "[NBCTest]")
+{
+  const size_t points = 200;
+  const size_t dimension = 4;
+  const size_t classes = 3;
+
+  arma::mat data(dimension, points, arma::fill::randu);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(points,
+      arma::distr_param(0, classes - 1));
+
+  // Integer weights, so that the replicated dataset is exactly equivalent.
+  arma::rowvec weights(points);
+  for (size_t i = 0; i < points; ++i)
+    weights[i] = (double) ((i % 3) + 1);
+
+  // Build the physically replicated dataset.
+  const size_t repPoints = (size_t) arma::accu(weights);
+  arma::mat repData(dimension, repPoints);
+  arma::Row<size_t> repLabels(repPoints);
+  size_t col = 0;
+  for (size_t i = 0; i < points; ++i)
+  {
+    for (size_t w = 0; w < (size_t) weights[i]; ++w)
+    {
+      repData.col(col) = data.col(i);
+      repLabels[col] = labels[i];
+      ++col;
+    }
+  }
+
+  NaiveBayesClassifier<> weighted(dimension, classes);
+  weighted.Train(data, labels, classes, weights);
+
+  NaiveBayesClassifier<> replicated(repData, repLabels, classes, false);
+
+  for (size_t c = 0; c < classes; ++c)
+  {
+    REQUIRE(weighted.Probabilities()[c] ==
+        Approx(replicated.Probabilities()[c]).epsilon(1e-7));
+    for (size_t d = 0; d < dimension; ++d)
+    {
+      REQUIRE(weighted.Means()(d, c) ==
+          Approx(replicated.Means()(d, c)).epsilon(1e-7));
+      REQUIRE(weighted.Variances()(d, c) ==
+          Approx(replicated.Variances()(d, c)).epsilon(1e-5));
+    }
+  }
+}
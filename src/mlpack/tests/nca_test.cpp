@@ -318,3 +318,59 @@ TEST_CASE("NCALBFGSSimpleDataset", "[NCATesT]")
   // norm is close to 0.
   REQUIRE(arma::norm(finalGradient, 2) < 1e-6);
 }
+
+/**
+ * When the neighborhood covers every other point, the k-nearest-subset
+ * approximation must agree with the exact softmax objective and gradient.
+ */
+TEST_CASE("SoftmaxNeighborSubsetEquivalenceTest", "[NCATesT]")
+{
+  arma::mat data;
+  data.randu(4, 50);
+  arma::Row<size_t> labels(50);
+  for (size_t i = 0; i < 50; ++i)
+    labels[i] = i % 3;
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> exact(data, labels);
+  SoftmaxErrorFunction<SquaredEuclideanDistance> approx(data, labels);
+  approx.NumNeighbors() = 49; // Every other point is a neighbor.
+
+  arma::mat coordinates = arma::eye<arma::mat>(4, 4);
+  coordinates(0, 1) = 0.3;
+  coordinates(2, 3) = -0.2;
+
+  REQUIRE(exact.Evaluate(coordinates) ==
+      Approx(approx.Evaluate(coordinates)).epsilon(1e-10));
+
+  arma::mat exactGradient, approxGradient;
+  exact.Gradient(coordinates, exactGradient);
+  approx.Gradient(coordinates, approxGradient);
+
+  for (size_t i = 0; i < exactGradient.n_elem; ++i)
+    REQUIRE(exactGradient[i] == Approx(approxGradient[i]).margin(1e-10));
+}
+
+/**
+ * With a small neighborhood, the approximate objective should still be close
+ * to the exact one, since the excluded softmax terms decay exponentially.
+ */
+TEST_CASE("SoftmaxNeighborSubsetApproximationTest", "[NCATesT]")
+{
+  arma::mat data;
+  data.randu(4, 200);
+  data *= 3.0; // Spread the points out so far-away terms are negligible.
+  arma::Row<size_t> labels(200);
+  for (size_t i = 0; i < 200; ++i)
+    labels[i] = i % 2;
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> exact(data, labels);
+  SoftmaxErrorFunction<SquaredEuclideanDistance> approx(data, labels);
+  approx.NumNeighbors() = 30;
+
+  arma::mat coordinates = arma::eye<arma::mat>(4, 4);
+
+  const double exactObj = exact.Evaluate(coordinates);
+  const double approxObj = approx.Evaluate(coordinates);
+
+  REQUIRE(approxObj == Approx(exactObj).epsilon(0.05));
+}
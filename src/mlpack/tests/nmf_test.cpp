@@ -24,6 +24,89 @@ using namespace arma;
 using namespace mlpack;
 using namespace mlpack::amf;
 
+/**
+ * Make sure a progress token can observe and cancel a factorization.
+ */
+TEST_CASE("NMFProgressTokenTest", "[NMFTest]")
+{
+  mat w = randu<mat>(20, 12);
+  mat h = randu<mat>(12, 20);
+  mat v = w * h;
+  size_t r = 12;
+
+  // Cancel the factorization after five iterations.
+  size_t reports = 0;
+  util::ProgressToken token([&reports](const size_t /* iteration */,
+                                       const double /* objective */)
+      { return (++reports < 5); });
+
+  AMF<> nmf;
+  nmf.Apply(v, r, w, h, &token);
+
+  // The callback must have been invoked exactly five times, with the last
+  // invocation cancelling the run; the partial factorization must still have
+  // the right shape.
+  REQUIRE(reports == 5);
+  REQUIRE(token.Cancelled());
+  REQUIRE(w.n_rows == 20);
+  REQUIRE(w.n_cols == r);
+  REQUIRE(h.n_rows == r);
+  REQUIRE(h.n_cols == 20);
+}
+
+/**
+ * Make sure a factorization can be checkpointed mid-run and then resumed from
+ * the checkpoint.
+ */
+TEST_CASE("NMFCheckpointTest", "[NMFTest]")
+{
+  mat w = randu<mat>(20, 12);
+  mat h = randu<mat>(12, 20);
+  mat v = w * h;
+  size_t r = 12;
+
+  const std::string file = "nmf_checkpoint_test.bin";
+  remove(file.c_str());
+
+  util::Checkpointer checkpoint(file, 1);
+
+  // First run: checkpoint every iteration and simulate preemption by
+  // cancelling after ten iterations.
+  {
+    size_t reports = 0;
+    util::ProgressToken token([&reports](const size_t /* iteration */,
+                                         const double /* objective */)
+        { return (++reports < 10); });
+
+    AMF<> nmf;
+    nmf.Apply(v, r, w, h, checkpoint, &token);
+  }
+
+  // The checkpoint must hold the state of the interrupted run.
+  mat checkW, checkH;
+  SimpleResidueTermination checkPolicy;
+  REQUIRE(checkpoint.Load(checkW, checkH, checkPolicy));
+  REQUIRE(checkPolicy.Iteration() == 10);
+  REQUIRE(checkW.n_rows == 20);
+  REQUIRE(checkW.n_cols == r);
+  REQUIRE(checkH.n_rows == r);
+  REQUIRE(checkH.n_cols == 20);
+
+  // Second run: resume from the checkpoint and run to convergence.  The
+  // iteration count continues from the checkpointed state.
+  AMF<> nmf;
+  nmf.Apply(v, r, w, h, checkpoint);
+  REQUIRE(nmf.TerminationPolicy().Iteration() > 10);
+
+  mat wh = w * h;
+
+  // Make sure reconstruction error is not too high.  5.0% tolerance.
+  REQUIRE(arma::norm(v - wh, "fro") / arma::norm(v, "fro") ==
+      Approx(0.0).margin(0.05));
+
+  remove(file.c_str());
+}
+
 /**
  * Check the if the product of the calculated factorization is close to the
  * input matrix. Default case.
@@ -301,3 +384,30 @@ TEST_CASE("NonNegNMFALSTest", "[NMFTest]")
   REQUIRE((arma::all(arma::vectorise(w) >= 0)
       && arma::all(arma::vectorise(h) >= 0)));
 }
+
+/**
+ * The residue computed from the factors' Gram matrices must agree with the
+ * residue computed from the explicit product W * H.
+ */
+TEST_CASE("SimpleResidueTerminationGramNormTest", "[NMFTest]")
+{
+  mat v = randu<mat>(50, 40);
+  SimpleResidueTermination srt(1e-10, 100);
+  srt.Initialize(v);
+
+  mat w = randu<mat>(50, 5);
+  mat h = randu<mat>(5, 40);
+
+  // The first call establishes the stored norm.
+  srt.IsConverged(w, h);
+  REQUIRE(srt.normOld == Approx(norm(w * h, "fro")));
+
+  // A second call with perturbed factors must produce the same residue as the
+  // explicit product.
+  const double oldNorm = srt.normOld;
+  mat w2 = 0.9 * w;
+  srt.IsConverged(w2, h);
+
+  const double expected = std::abs(oldNorm - norm(w2 * h, "fro")) / oldNorm;
+  REQUIRE(srt.Index() == Approx(expected));
+}
@@ -199,3 +199,43 @@ TEST_CASE("GermanTest", "[NystroemMethodTest]")
     REQUIRE(avgError == Approx(0.0).margin(results[trial]));
   }
 }
+
+/**
+ * Make sure the ensemble mode gives a factor with the right shape, and that a
+ * full-rank ensemble reproduces the kernel matrix just like a single full-rank
+ * approximation does.
+ */
+TEST_CASE("EnsembleNystroemTest", "[NystroemMethodTest]")
+{
+  arma::mat data;
+  data.randu(5, 100);
+
+  GaussianKernel gk;
+  NystroemMethod<GaussianKernel, OrderedSelection> nm(data, gk, 100);
+
+  arma::mat g;
+  nm.Apply(g, 3);
+
+  // One block of columns per ensemble member.
+  REQUIRE(g.n_rows == data.n_cols);
+  REQUIRE(g.n_cols == 300);
+
+  // Construct exact kernel matrix.
+  arma::mat kernel(100, 100);
+  for (size_t i = 0; i < 100; ++i)
+    for (size_t j = 0; j < 100; ++j)
+      kernel(i, j) = gk.Evaluate(data.col(i), data.col(j));
+
+  // Each member is full-rank, so their average is too.
+  arma::mat approximation = g * g.t();
+  for (size_t i = 0; i < 100; ++i)
+  {
+    for (size_t j = 0; j < 100; ++j)
+    {
+      if (kernel(i, j) < 1e-5)
+        REQUIRE(approximation(i, j) == Approx(0.0).margin(1e-4));
+      else
+        REQUIRE(kernel(i, j) == Approx(approximation(i, j)).epsilon(1e-7));
+    }
+  }
+}
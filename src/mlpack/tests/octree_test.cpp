@@ -346,3 +346,92 @@ TEST_CASE("OctreeSerializationTest", "[OctreeTest]")
   delete binaryTree;
   delete jsonTree;
 }
+
+//! Recursively check the child octant bookkeeping of every node.
+void CheckChildOctants(const Octree<>& node)
+{
+  const size_t maxOctants = ((size_t) 1) << node.Dataset().n_rows;
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+  {
+    // Octants must be valid and strictly ascending (Morton order).
+    REQUIRE(node.ChildOctant(i) < maxOctants);
+    if (i > 0)
+      REQUIRE(node.ChildOctant(i) > node.ChildOctant(i - 1));
+
+    // The octant lookup must invert the octant accessor.
+    REQUIRE(node.ChildWithOctant(node.ChildOctant(i)) == i);
+
+    CheckChildOctants(node.Child(i));
+  }
+
+  // Octants that no child occupies must return an invalid index.
+  size_t child = 0;
+  for (size_t o = 0; o < maxOctants; ++o)
+  {
+    if (child < node.NumChildren() && node.ChildOctant(child) == o)
+      ++child;
+    else
+      REQUIRE(node.ChildWithOctant(o) == node.NumChildren());
+  }
+}
+
+/**
+ * Test that the cached child octants agree with the geometry of the split and
+ * that children are stored in Morton order.
+ */
+TEST_CASE("OctreeChildOctantTest", "[OctreeTest]")
+{
+  // Four corners of the unit square; the split center is (0.5, 0.5), so each
+  // point determines the octant of its child exactly.
+  arma::mat corners("0 0 1 1; 0 1 0 1");
+  Octree<> t(corners, 1);
+
+  REQUIRE(t.NumChildren() == 4);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    const size_t point = t.Child(i).Point(0);
+    size_t expectedOctant = 0;
+    for (size_t d = 0; d < corners.n_rows; ++d)
+      if (t.Child(i).Dataset()(d, point) > 0.5)
+        expectedOctant |= (((size_t) 1) << d);
+
+    REQUIRE(t.ChildOctant(i) == expectedOctant);
+    REQUIRE(t.ChildWithOctant(expectedOctant) == i);
+  }
+
+  // Check the invariants on a larger random tree too.
+  arma::mat dataset(3, 700, arma::fill::randu);
+  Octree<> t2(std::move(dataset), 10);
+  CheckChildOctants(t2);
+}
+
+/**
+ * Test that the Z-order presorting constructor produces a valid octree with a
+ * correct oldFromNew mapping (composed of the presort and the splits).
+ */
+TEST_CASE("OctreeZOrderPresortTest", "[OctreeTest]")
+{
+  arma::mat dataset(3, 700, arma::fill::randu);
+
+  std::vector<size_t> oldFromNew;
+  Octree<> t(dataset, oldFromNew, math::ZOrderPresort());
+
+  REQUIRE(t.NumDescendants() == dataset.n_cols);
+  REQUIRE(oldFromNew.size() == dataset.n_cols);
+
+  // The mapping must be a permutation that maps tree columns back to the
+  // original dataset.
+  std::vector<bool> seen(dataset.n_cols, false);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    REQUIRE(oldFromNew[i] < dataset.n_cols);
+    REQUIRE(!seen[oldFromNew[i]]);
+    seen[oldFromNew[i]] = true;
+
+    for (size_t d = 0; d < dataset.n_rows; ++d)
+      REQUIRE(t.Dataset()(d, i) == dataset(d, oldFromNew[i]));
+  }
+
+  // The octant bookkeeping must hold on the presorted tree too.
+  CheckChildOctants(t);
+}
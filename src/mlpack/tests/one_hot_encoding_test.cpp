@@ -230,3 +230,71 @@ TEST_CASE("OneHotEncodingDatasetinfoTest", "[OneHotEncodingTest]")
 
   remove("test.csv");
 }
+
+/**
+ * Test that the sparse overload gives the same encoding as the dense
+ * overload.
+ */
+TEST_CASE("OneHotEncodingSparseOutputTest", "[OneHotEncodingTest]")
+{
+  arma::mat matrix;
+  matrix = "1 1 -1 -1 -1 -1 1 1;"
+           "0 2  3  4  5  6 7 8;"
+           "1 2  1  2  1  2 1 2;";
+
+  arma::Col<size_t> indices("0 2");
+
+  arma::mat denseOutput;
+  data::OneHotEncoding(matrix, indices, denseOutput);
+
+  arma::sp_mat sparseOutput;
+  data::OneHotEncoding(matrix, indices, sparseOutput);
+
+  REQUIRE(sparseOutput.n_rows == denseOutput.n_rows);
+  REQUIRE(sparseOutput.n_cols == denseOutput.n_cols);
+  CheckMatrices(denseOutput, arma::mat(sparseOutput));
+
+  // With no indices to encode, the output must be the input.
+  data::OneHotEncoding(matrix, arma::Col<size_t>(), sparseOutput);
+  CheckMatrices(matrix, arma::mat(sparseOutput));
+}
+
+/**
+ * Test the sparse DatasetMapper overload against the dense DatasetInfo
+ * overload on a dataset with a mapped categorical dimension.
+ */
+TEST_CASE("OneHotEncodingSparseDatasetMapperTest", "[OneHotEncodingTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  f << "1, 2, hello" << endl;
+  f << "3, 4, goodbye" << endl;
+  f << "5, 6, coffee" << endl;
+  f << "7, 8, confusion" << endl;
+  f << "9, 10, hello" << endl;
+  f << "11, 12, confusion" << endl;
+  f << "13, 14, confusion" << endl;
+  f.close();
+
+  // Load the test CSV.
+  arma::mat matrix;
+  DatasetInfo info;
+  if (!data::Load("test.csv", matrix, info))
+    FAIL("Cannot load dataset test.csv");
+
+  arma::mat denseOutput;
+  data::OneHotEncoding(matrix, denseOutput, info);
+
+  arma::sp_mat sparseOutput;
+  data::OneHotEncoding(matrix, sparseOutput, info);
+
+  REQUIRE(sparseOutput.n_rows == denseOutput.n_rows);
+  REQUIRE(sparseOutput.n_cols == denseOutput.n_cols);
+  CheckMatrices(denseOutput, arma::mat(sparseOutput));
+
+  // Exactly one nonzero element per point in the encoded dimension, plus the
+  // nonzero numeric values.
+  REQUIRE(sparseOutput.n_nonzero == 3 * matrix.n_cols);
+
+  remove("test.csv");
+}
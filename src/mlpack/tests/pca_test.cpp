@@ -16,6 +16,7 @@
 #include <mlpack/methods/pca/decomposition_policies/quic_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/randomized_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/randomized_block_krylov_method.hpp>
+#include <mlpack/methods/pca/decomposition_policies/streaming_svd_method.hpp>
 
 #include "catch.hpp"
 
@@ -204,6 +205,16 @@ TEST_CASE("ArmaComparisonRandomizedPCATest", "[PCATest]")
   ArmaComparisonPCA<RandomizedSVDPolicy>();
 }
 
+/**
+ * Compare the output of our streaming block power PCA implementation with
+ * Armadillo's.  A small block size forces several blocks per pass.
+ */
+TEST_CASE("ArmaComparisonStreamingPCATest", "[PCATest]")
+{
+  StreamingSVDPolicy decomposition(128);
+  ArmaComparisonPCA<StreamingSVDPolicy>(false, decomposition);
+}
+
 /**
  * Test that dimensionality reduction with exact-svd PCA works the same way
  * MATLAB does (which should be correct!).
@@ -233,6 +244,15 @@ TEST_CASE("RandomizedPCADimensionalityReductionTest", "[PCATest]")
   PCADimensionalityReduction<RandomizedSVDPolicy>();
 }
 
+/**
+ * Test that dimensionality reduction with streaming block power PCA works the
+ * same way MATLAB does (which should be correct!).
+ */
+TEST_CASE("StreamingPCADimensionalityReductionTest", "[PCATest]")
+{
+  PCADimensionalityReduction<StreamingSVDPolicy>();
+}
+
 /**
  * Test that dimensionality reduction with QUIC-SVD PCA works the same way
  * as the Exact-SVD PCA method.
@@ -104,6 +104,40 @@ TEST_CASE("SimpleWeightUpdateInstanceWeight", "[PerceptronTest]")
   CHECK(biases(2) == 10);
 }
 
+/**
+ * This test tests whether the batched SimpleWeightUpdate overload gives the
+ * same result as applying the single-point rule to each misclassified point.
+ */
+TEST_CASE("SimpleWeightUpdateBatch", "[PerceptronTest]")
+{
+  SimpleWeightUpdate wip;
+
+  mat trainingPoints(5, 4, fill::randu);
+  Row<size_t> incorrectClasses("0 1 2 0");
+  Row<size_t> correctClasses("2 0 1 1");
+  rowvec instanceWeights("1.0 3.0 0.5 2.0");
+
+  mat weights(5, 3, fill::randu);
+  vec biases(3, fill::randu);
+
+  // Apply the single-point rule to each point in turn.
+  mat expectedWeights = weights;
+  vec expectedBiases = biases;
+  for (size_t j = 0; j < trainingPoints.n_cols; ++j)
+  {
+    wip.UpdateWeights(vec(trainingPoints.col(j)), expectedWeights,
+        expectedBiases, incorrectClasses[j], correctClasses[j],
+        instanceWeights[j]);
+  }
+
+  // The grouped update must produce the same weights and biases.
+  wip.UpdateWeights(trainingPoints, weights, biases, incorrectClasses,
+      correctClasses, instanceWeights);
+
+  CHECK(arma::approx_equal(weights, expectedWeights, "absdiff", 1e-10));
+  CHECK(arma::approx_equal(biases, expectedBiases, "absdiff", 1e-10));
+}
+
 /**
  * This test tests whether the perceptron converges for the AND gate classifier.
  */
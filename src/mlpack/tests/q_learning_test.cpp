@@ -123,6 +123,38 @@ TEST_CASE("CartPoleWithDQN", "[QLearningTest]")
   REQUIRE(converged);
 }
 
+//! Test the episode-parallel actor / learner split in Cart Pole task.
+TEST_CASE("CartPoleParallelEpisodesTest", "[QLearningTest]")
+{
+  // Set up the network.
+  SimpleDQN<> network(4, 64, 64, 2);
+
+  // Set up the policy and replay method.
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+  RandomReplay<CartPole> replayMethod(10, 10000);
+
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 100;
+  config.PolicySnapshotInterval() = 10;
+  config.StepLimit() = 200;
+
+  // Set up DQN agent.
+  QLearning<CartPole, decltype(network), AdamUpdate, decltype(policy)>
+      agent(config, network, policy, replayMethod);
+
+  arma::vec returns = agent.ParallelEpisodes(30);
+
+  // Every episode must have finished, and in CartPole each episode collects
+  // at least one unit of reward before termination.
+  REQUIRE(returns.n_elem == 30);
+  for (size_t i = 0; i < returns.n_elem; ++i)
+    REQUIRE(returns(i) >= 1.0);
+  REQUIRE(agent.TotalSteps() == size_t(arma::accu(returns)));
+}
+
 //! Test DQN in Cart Pole task with Prioritized Replay.
 TEST_CASE("CartPoleWithDQNPrioritizedReplay", "[QLearningTest]")
 {
@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/random_forest/random_forest.hpp>
+#include <mlpack/methods/random_forest/random_forest_regressor.hpp>
 #include <mlpack/methods/decision_tree/random_dimension_select.hpp>
 
 #include "serialization.hpp"
@@ -498,3 +499,270 @@ TEST_CASE("DifferentTreesTest", "[RandomForestTest]")
 
   REQUIRE(success == true);
 }
+
+/**
+ * Make sure the batched Classify() overloads give exactly the same results as
+ * classifying every point individually.
+ */
+TEST_CASE("RandomForestBatchClassifyTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load test dataset vc2.csv!");
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt!");
+
+  RandomForest<> rf(dataset, labels, 3, 10 /* 10 trees */, 1);
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  rf.Classify(dataset, predictions, probabilities);
+
+  REQUIRE(predictions.n_elem == dataset.n_cols);
+  REQUIRE(probabilities.n_cols == dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    size_t prediction;
+    arma::vec pointProbabilities;
+    rf.Classify(dataset.col(i), prediction, pointProbabilities);
+
+    REQUIRE(predictions[i] == prediction);
+    for (size_t j = 0; j < pointProbabilities.n_elem; ++j)
+      REQUIRE(probabilities(j, i) == Approx(pointProbabilities[j]));
+  }
+
+  // The predictions-only overload must agree too.
+  arma::Row<size_t> predictionsOnly;
+  rf.Classify(dataset, predictionsOnly);
+  REQUIRE(arma::all(predictionsOnly == predictions));
+}
+
+/**
+ * Check that the out-of-bag error computed during training is a sensible
+ * estimate of generalization error.
+ */
+TEST_CASE("RandomForestOOBErrorTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load test dataset vc2.csv!");
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt!");
+
+  RandomForest<> rf;
+  rf.Train(dataset, labels, 3, 20 /* 20 trees */, 1);
+
+  // The forest gets over 70% held-out accuracy on this dataset, so the
+  // out-of-bag error should land in the same ballpark.
+  REQUIRE(rf.OOBError() >= 0.0);
+  REQUIRE(rf.OOBError() <= 0.45);
+
+  // Importances were not requested.
+  REQUIRE(rf.FeatureImportances().n_elem == 0);
+}
+
+/**
+ * Check that permutation importance singles out the only informative
+ * dimension in a synthetic dataset.
+ */
+TEST_CASE("RandomForestPermutationImportanceTest", "[RandomForestTest]")
+{
+  // Four noise dimensions, with the class signal carried by dimension 1 only.
+  arma::mat dataset(4, 2000, arma::fill::randn);
+  arma::Row<size_t> labels(2000);
+  for (size_t i = 0; i < 2000; ++i)
+  {
+    labels[i] = i % 2;
+    dataset(1, i) += 3.0 * labels[i];
+  }
+
+  RandomForest<> rf;
+  rf.Train(dataset, labels, 2, 20 /* 20 trees */, 5, 1e-7, 0,
+      MultipleRandomDimensionSelect(), true /* compute importances */);
+
+  const arma::vec& importances = rf.FeatureImportances();
+  REQUIRE(importances.n_elem == 4);
+
+  // The informative dimension must dominate the noise dimensions.
+  REQUIRE(importances[1] > importances[0]);
+  REQUIRE(importances[1] > importances[2]);
+  REQUIRE(importances[1] > importances[3]);
+  REQUIRE(importances[1] > 0.05);
+}
+
+/**
+ * Concurrent Classify() calls on a single trained forest must give the same
+ * results as a serial call: Classify() is const and reentrant.
+ */
+TEST_CASE("RandomForestConcurrentClassifyTest", "[RandomForestTest]")
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+
+  RandomForest<> rf(dataset, labels, 3, 10 /* 10 trees */);
+
+  arma::Row<size_t> serialPredictions;
+  arma::mat serialProbabilities;
+  rf.Classify(dataset, serialPredictions, serialProbabilities);
+
+  // Classify the same dataset from several threads at once, each into its own
+  // output; every thread must reproduce the serial results exactly.
+  const size_t runs = 4;
+  std::vector<arma::Row<size_t>> predictions(runs);
+  std::vector<arma::mat> probabilities(runs);
+  #pragma omp parallel for
+  for (omp_size_t t = 0; t < (omp_size_t) runs; ++t)
+    rf.Classify(dataset, predictions[t], probabilities[t]);
+
+  for (size_t t = 0; t < runs; ++t)
+  {
+    REQUIRE(arma::all(predictions[t] == serialPredictions));
+    REQUIRE(arma::approx_equal(probabilities[t], serialProbabilities,
+        "absdiff", 1e-15));
+  }
+}
+
+/**
+ * Make sure that two random forests trained with the same seed are identical,
+ * even when the trees are trained in parallel: the bootstrap samples are
+ * drawn up front and each tree uses its own deterministic random stream.
+ */
+TEST_CASE("RandomForestDeterministicTrainTest", "[RandomForestTest]")
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load test dataset vc2.csv!");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt!");
+
+  math::RandomSeed(100);
+  RandomForest<> rf1(dataset, labels, 3, 15 /* 15 trees */, 1);
+
+  math::RandomSeed(100);
+  RandomForest<> rf2(dataset, labels, 3, 15 /* 15 trees */, 1);
+
+  // Identical forests must produce identical predictions and probabilities.
+  arma::Row<size_t> predictions1, predictions2;
+  arma::mat probabilities1, probabilities2;
+  rf1.Classify(dataset, predictions1, probabilities1);
+  rf2.Classify(dataset, predictions2, probabilities2);
+
+  REQUIRE(arma::all(predictions1 == predictions2));
+  REQUIRE(arma::approx_equal(probabilities1, probabilities2, "absdiff", 0.0));
+}
+
+/**
+ * Make sure a forest can be trained directly on labels of a different integer
+ * type, and that the result matches a forest trained on size_t labels with
+ * the same seed.
+ */
+TEST_CASE("RandomForestIntegerLabelTypeTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load test dataset vc2.csv!");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt!");
+
+  // The same labels, held as 32-bit signed integers.
+  const arma::Row<int> intLabels =
+      arma::conv_to<arma::Row<int>>::from(labels);
+
+  math::RandomSeed(100);
+  RandomForest<> rf(dataset, labels, 3, 15 /* 15 trees */, 1);
+
+  math::RandomSeed(100);
+  RandomForest<> intRf(dataset, intLabels, 3, 15 /* 15 trees */, 1);
+
+  arma::Row<size_t> predictions, intPredictions;
+  rf.Classify(dataset, predictions);
+  intRf.Classify(dataset, intPredictions);
+
+  REQUIRE(arma::all(predictions == intPredictions));
+  REQUIRE(rf.OOBError() == intRf.OOBError());
+}
+
+/**
+ * Make sure a random forest regressor can learn a simple function and that
+ * its out-of-bag error is a sensible estimate of the generalization error.
+ */
+TEST_CASE("RandomForestRegressorLearningTest", "[RandomForestTest]")
+{
+  arma::mat dataset(5, 2000, arma::fill::randu);
+  arma::rowvec responses = 10.0 * dataset.row(0) + 5.0 * dataset.row(1);
+
+  RandomForestRegressor<> rf(dataset, responses, 20 /* 20 trees */, 5);
+
+  arma::rowvec predictions;
+  rf.Predict(dataset, predictions);
+  REQUIRE(predictions.n_elem == responses.n_elem);
+
+  // The fit should explain nearly all of the response variance (which is
+  // roughly 125 / 12 ~= 10.4 here).
+  double mse = 0.0;
+  for (size_t i = 0; i < responses.n_elem; ++i)
+    mse += std::pow(predictions[i] - responses[i], 2.0);
+  mse /= responses.n_elem;
+  REQUIRE(mse < 1.0);
+
+  // The out-of-bag error estimates the error on unseen points, so it should
+  // be larger than the training error but still far below the response
+  // variance.
+  REQUIRE(rf.OOBError() >= mse);
+  REQUIRE(rf.OOBError() < 5.0);
+
+  // The batch overload must agree with single-point prediction.
+  for (size_t i = 0; i < 100; ++i)
+    REQUIRE(rf.Predict(dataset.col(i)) == Approx(predictions[i]));
+}
+
+/**
+ * Make sure an untrained random forest regressor throws on Predict().
+ */
+TEST_CASE("RandomForestRegressorEmptyPredictTest", "[RandomForestTest]")
+{
+  RandomForestRegressor<> rf; // No training.
+
+  arma::mat points(10, 100, arma::fill::randu);
+  arma::rowvec predictions;
+
+  REQUIRE_THROWS_AS(rf.Predict(points.col(0)), std::invalid_argument);
+  REQUIRE_THROWS_AS(rf.Predict(points, predictions), std::invalid_argument);
+}
+
+/**
+ * Test that the random forest regressor serializes correctly.
+ */
+TEST_CASE("RandomForestRegressorSerializationTest", "[RandomForestTest]")
+{
+  arma::mat dataset(4, 1000, arma::fill::randu);
+  arma::rowvec responses = 3.0 * dataset.row(0) - dataset.row(2);
+
+  RandomForestRegressor<> rf(dataset, responses, 10 /* 10 trees */, 5);
+
+  arma::rowvec beforePredictions;
+  rf.Predict(dataset, beforePredictions);
+
+  RandomForestRegressor<> xmlForest, jsonForest, binaryForest;
+  binaryForest.Train(dataset, responses, 3, 5);
+  SerializeObjectAll(rf, xmlForest, jsonForest, binaryForest);
+
+  // Now check that we get the same results from the deserialized forests.
+  arma::rowvec xmlPredictions, jsonPredictions, binaryPredictions;
+  xmlForest.Predict(dataset, xmlPredictions);
+  jsonForest.Predict(dataset, jsonPredictions);
+  binaryForest.Predict(dataset, binaryPredictions);
+
+  CheckMatrices(beforePredictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+}
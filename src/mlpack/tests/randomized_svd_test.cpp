@@ -60,3 +60,101 @@ TEST_CASE("RandomizedSVDReconstructionError", "[RandomizedSVDTest]")
       arma::norm(centeredData, "frob");
   REQUIRE(error == Approx(0.0).margin(1e-5));
 }
+
+/**
+ * With adaptive early stopping enabled, the power iterations may stop before
+ * the iteration limit, but the result must still be accurate.
+ */
+TEST_CASE("RandomizedSVDAdaptiveIterationTest", "[RandomizedSVDTest]")
+{
+  arma::mat U = arma::randn<arma::mat>(3, 20);
+  arma::mat V = arma::randn<arma::mat>(10, 3);
+
+  arma::mat R;
+  arma::qr_econ(U, R, U);
+  arma::qr_econ(V, R, V);
+
+  arma::mat s = arma::diagmat(arma::vec("1 0.1 0.01"));
+
+  arma::mat data = arma::trans(U * arma::diagmat(s) * V.t());
+
+  // Center the data into a temporary matrix.
+  arma::mat centeredData;
+  math::Center(data, centeredData);
+
+  arma::mat U1, U2, V1, V2;
+  arma::vec s1, s2, s3;
+
+  arma::svd_econ(U1, s1, V1, centeredData);
+
+  // Generous iteration limit; the subspace-rotation criterion should cut the
+  // iterations short well before it is reached.
+  svd::RandomizedSVD rSVD(0, 100, 1e-7, 1e-5);
+  rSVD.Apply(data, U2, s2, V2, 3);
+
+  // Use the same amount of data for the comparison (matrix rank).
+  s3 = s1.subvec(0, s2.n_elem - 1);
+
+  // The singular value error should be small.
+  double error = arma::norm(s2 - s3, "frob") / arma::norm(s2, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+
+  arma::mat reconstruct = U2 * arma::diagmat(s2) * V2.t();
+
+  // The relative reconstruction error should be small.
+  error = arma::norm(centeredData - reconstruct, "frob") /
+      arma::norm(centeredData, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+}
+
+/**
+ * With the fast Hadamard sketch enabled, the decomposition must be as
+ * accurate as with the dense Gaussian sketch, for both orientations of the
+ * data matrix.
+ */
+TEST_CASE("RandomizedSVDFastProjectionTest", "[RandomizedSVDTest]")
+{
+  arma::mat U = arma::randn<arma::mat>(30, 3);
+  arma::mat V = arma::randn<arma::mat>(60, 3);
+
+  arma::mat R;
+  arma::qr_econ(U, R, U);
+  arma::qr_econ(V, R, V);
+
+  arma::mat s = arma::diagmat(arma::vec("1 0.1 0.01"));
+
+  // 30 x 60; the transposed copy exercises the tall orientation.
+  arma::mat data = U * s * V.t();
+
+  svd::RandomizedSVD rSVD(0, 10);
+  rSVD.UseFastProjection() = true;
+
+  for (const bool transposed : { false, true })
+  {
+    const arma::mat input = transposed ? arma::mat(data.t()) : data;
+
+    arma::mat centeredData;
+    math::Center(input, centeredData);
+
+    arma::mat U1, U2, V1, V2;
+    arma::vec s1, s2, s3;
+
+    arma::svd_econ(U1, s1, V1, centeredData);
+
+    rSVD.Apply(input, U2, s2, V2, 3);
+
+    // Use the same amount of data for the comparison (matrix rank).
+    s3 = s1.subvec(0, s2.n_elem - 1);
+
+    // The singular value error should be small.
+    double error = arma::norm(s2 - s3, "frob") / arma::norm(s2, "frob");
+    REQUIRE(error == Approx(0.0).margin(1e-5));
+
+    arma::mat reconstruct = U2 * arma::diagmat(s2) * V2.t();
+
+    // The relative reconstruction error should be small.
+    error = arma::norm(centeredData - reconstruct, "frob") /
+        arma::norm(centeredData, "frob");
+    REQUIRE(error == Approx(0.0).margin(1e-5));
+  }
+}
@@ -1714,3 +1714,259 @@ TEST_CASE("MoveOperatorNaiveTest", "[RangeSearchTest]")
     }
   }
 }
+
+/**
+ * Make sure that the breadth-first dual-tree traverser, used as the traversal
+ * policy of RangeSearch, gives the same results as the default depth-first
+ * traversal.
+ */
+TEST_CASE("BreadthFirstRangeSearchTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 500);
+  arma::mat queryData = arma::randu<arma::mat>(3, 200);
+
+  RangeSearch<> rs(referenceData);
+
+  RangeSearch<EuclideanDistance,
+              arma::mat,
+              KDTree,
+              KDTree<EuclideanDistance,
+                     RangeSearchStat,
+                     arma::mat>::template BreadthFirstDualTreeTraverser>
+      bfRs(referenceData);
+
+  const Range range(0.25, 1.05);
+
+  vector<vector<size_t>> neighbors, bfNeighbors;
+  vector<vector<double>> distances, bfDistances;
+  rs.Search(queryData, range, neighbors, distances);
+  bfRs.Search(queryData, range, bfNeighbors, bfDistances);
+
+  vector<vector<pair<double, size_t>>> sorted, bfSorted;
+  SortResults(neighbors, distances, sorted);
+  SortResults(bfNeighbors, bfDistances, bfSorted);
+
+  REQUIRE(bfSorted.size() == sorted.size());
+  for (size_t i = 0; i < sorted.size(); ++i)
+  {
+    REQUIRE(bfSorted[i].size() == sorted[i].size());
+    for (size_t j = 0; j < sorted[i].size(); ++j)
+    {
+      REQUIRE(bfSorted[i][j].second == sorted[i][j].second);
+      REQUIRE(bfSorted[i][j].first ==
+          Approx(sorted[i][j].first).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Make sure that bounding the frontier of the breadth-first dual-tree
+ * traverser does not change the results; overflowing node combinations are
+ * finished depth-first instead.
+ */
+TEST_CASE("BreadthFirstFrontierCapTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 500);
+  arma::mat queryData = arma::randu<arma::mat>(3, 200);
+
+  const Range range(0.25, 1.05);
+
+  // Get exact results with naive search.
+  RangeSearch<> naive(referenceData, true);
+  vector<vector<size_t>> naiveNeighbors;
+  vector<vector<double>> naiveDistances;
+  naive.Search(queryData, range, naiveNeighbors, naiveDistances);
+
+  // Run the breadth-first traversal directly with a very small frontier cap,
+  // so that the depth-first fallback is exercised heavily.
+  typedef KDTree<EuclideanDistance, RangeSearchStat, arma::mat> TreeType;
+  std::vector<size_t> oldFromNewRefs, oldFromNewQueries;
+  TreeType referenceTree(referenceData, oldFromNewRefs);
+  TreeType queryTree(queryData, oldFromNewQueries);
+
+  vector<vector<size_t>> neighbors(queryData.n_cols);
+  vector<vector<double>> distances(queryData.n_cols);
+
+  typedef RangeSearchRules<EuclideanDistance, TreeType> RuleType;
+  EuclideanDistance metric;
+  RuleType rules(referenceTree.Dataset(), queryTree.Dataset(), range,
+      neighbors, distances, metric);
+
+  TreeType::BreadthFirstDualTreeTraverser<RuleType> traverser(rules);
+  traverser.FrontierCap() = 4;
+  traverser.Traverse(queryTree, referenceTree);
+
+  // Map the results back to the original point indices, then compare against
+  // the naive results.
+  vector<vector<size_t>> mappedNeighbors(queryData.n_cols);
+  vector<vector<double>> mappedDistances(queryData.n_cols);
+  for (size_t i = 0; i < neighbors.size(); ++i)
+  {
+    const size_t queryIndex = oldFromNewQueries[i];
+    mappedNeighbors[queryIndex].resize(neighbors[i].size());
+    mappedDistances[queryIndex].resize(distances[i].size());
+    for (size_t j = 0; j < neighbors[i].size(); ++j)
+    {
+      mappedNeighbors[queryIndex][j] = oldFromNewRefs[neighbors[i][j]];
+      mappedDistances[queryIndex][j] = distances[i][j];
+    }
+  }
+
+  vector<vector<pair<double, size_t>>> sorted, naiveSorted;
+  SortResults(mappedNeighbors, mappedDistances, sorted);
+  SortResults(naiveNeighbors, naiveDistances, naiveSorted);
+
+  REQUIRE(sorted.size() == naiveSorted.size());
+  for (size_t i = 0; i < sorted.size(); ++i)
+  {
+    REQUIRE(sorted[i].size() == naiveSorted[i].size());
+    for (size_t j = 0; j < sorted[i].size(); ++j)
+    {
+      REQUIRE(sorted[i][j].second == naiveSorted[i][j].second);
+      REQUIRE(sorted[i][j].first ==
+          Approx(naiveSorted[i][j].first).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Make sure the streaming (callback) overload of Search() emits exactly the
+ * same result set as the vector-accumulating overload, in all three search
+ * modes, with original (unpermuted) indices.
+ */
+TEST_CASE("StreamingSearchEquivalenceTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData;
+  referenceData.randu(8, 400); // 400 points in 8 dimensions.
+  arma::mat queryData;
+  queryData.randu(8, 150); // 150 points in 8 dimensions.
+
+  const Range range(0.3, 1.1);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    const bool naive = (mode == 0);
+    const bool singleMode = (mode == 1);
+
+    RangeSearch<> rs(referenceData, naive, singleMode);
+
+    // Get the reference results with the accumulating overload.
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    rs.Search(queryData, range, neighbors, distances);
+
+    // Now collect the streamed results into the same shape.
+    vector<vector<size_t>> streamedNeighbors(queryData.n_cols);
+    vector<vector<double>> streamedDistances(queryData.n_cols);
+    rs.Search(queryData, range,
+        [&](const size_t queryIndex, const size_t neighborIndex,
+            const double distance)
+        {
+          streamedNeighbors[queryIndex].push_back(neighborIndex);
+          streamedDistances[queryIndex].push_back(distance);
+        });
+
+    vector<vector<pair<double, size_t>>> sorted, streamedSorted;
+    SortResults(neighbors, distances, sorted);
+    SortResults(streamedNeighbors, streamedDistances, streamedSorted);
+
+    REQUIRE(streamedSorted.size() == sorted.size());
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+      REQUIRE(streamedSorted[i].size() == sorted[i].size());
+      for (size_t j = 0; j < sorted[i].size(); ++j)
+      {
+        REQUIRE(streamedSorted[i][j].second == sorted[i][j].second);
+        REQUIRE(streamedSorted[i][j].first ==
+            Approx(sorted[i][j].first).epsilon(1e-10));
+      }
+    }
+  }
+}
+
+/**
+ * Make sure the monochromatic streaming overload matches the monochromatic
+ * accumulating overload, and never reports a point as its own neighbor.
+ */
+TEST_CASE("StreamingMonochromaticSearchTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData;
+  referenceData.randu(8, 400); // 400 points in 8 dimensions.
+
+  const Range range(0.3, 1.1);
+
+  RangeSearch<> rs(referenceData);
+
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  rs.Search(range, neighbors, distances);
+
+  vector<vector<size_t>> streamedNeighbors(referenceData.n_cols);
+  vector<vector<double>> streamedDistances(referenceData.n_cols);
+  rs.Search(range,
+      [&](const size_t queryIndex, const size_t neighborIndex,
+          const double distance)
+      {
+        REQUIRE(queryIndex != neighborIndex);
+        streamedNeighbors[queryIndex].push_back(neighborIndex);
+        streamedDistances[queryIndex].push_back(distance);
+      });
+
+  vector<vector<pair<double, size_t>>> sorted, streamedSorted;
+  SortResults(neighbors, distances, sorted);
+  SortResults(streamedNeighbors, streamedDistances, streamedSorted);
+
+  REQUIRE(streamedSorted.size() == sorted.size());
+  for (size_t i = 0; i < sorted.size(); ++i)
+  {
+    REQUIRE(streamedSorted[i].size() == sorted[i].size());
+    for (size_t j = 0; j < sorted[i].size(); ++j)
+      REQUIRE(streamedSorted[i][j].second == sorted[i][j].second);
+  }
+}
+
+/**
+ * Make sure the per-query result cap of the streaming overload is respected:
+ * each query point receives min(cap, total) results, and every emitted result
+ * is correct (in range, with the right distance).
+ */
+TEST_CASE("StreamingSearchResultCapTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData;
+  referenceData.randu(8, 400); // 400 points in 8 dimensions.
+  arma::mat queryData;
+  queryData.randu(8, 150); // 150 points in 8 dimensions.
+
+  const Range range(0.3, 1.1);
+  const size_t cap = 5;
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    const bool naive = (mode == 0);
+    const bool singleMode = (mode == 1);
+
+    RangeSearch<> rs(referenceData, naive, singleMode);
+
+    // Get the full result set, for its per-query counts.
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    rs.Search(queryData, range, neighbors, distances);
+
+    vector<size_t> streamedCounts(queryData.n_cols, 0);
+    rs.Search(queryData, range,
+        [&](const size_t queryIndex, const size_t neighborIndex,
+            const double distance)
+        {
+          // Each emitted result must be a genuine result.
+          REQUIRE(range.Contains(distance));
+          REQUIRE(distance ==
+              Approx(metric::EuclideanDistance::Evaluate(
+                  queryData.col(queryIndex),
+                  referenceData.col(neighborIndex))).epsilon(1e-10));
+          ++streamedCounts[queryIndex];
+        }, cap);
+
+    for (size_t i = 0; i < queryData.n_cols; ++i)
+      REQUIRE(streamedCounts[i] == std::min(cap, neighbors[i].size()));
+  }
+}
@@ -737,6 +737,58 @@ TEST_CASE("DiscreteHilbertValueSyncTest", "[RectangleTreeTraitsTest]")
   CheckDiscreteHilbertValueSync(hilbertRTree);
 }
 
+template<typename TreeType>
+void CheckHilbertUpperBound(const TreeType& tree, const arma::mat& queries)
+{
+  typedef DiscreteHilbertValue<typename TreeType::ElemType> HilbertValue;
+  typedef typename HilbertValue::HilbertElemType HilbertElemType;
+
+  if (tree.IsLeaf())
+  {
+    const HilbertValue& value = tree.AuxiliaryInfo().HilbertValue();
+
+    for (size_t q = 0; q < queries.n_cols; ++q)
+    {
+      const arma::Col<HilbertElemType> queryValue =
+          HilbertValue::CalculateValue(queries.col(q));
+
+      // The binary search must agree with a linear scan of the sorted local
+      // Hilbert values.
+      size_t expected = 0;
+      for (; expected < value.NumValues(); ++expected)
+      {
+        if (HilbertValue::CompareValues(
+            value.LocalHilbertValues()->col(expected), queryValue) > 0)
+          break;
+      }
+
+      REQUIRE(value.UpperBound(queryValue) == expected);
+      REQUIRE(value.UpperBound(queries.col(q)) == expected);
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < tree.NumChildren(); ++i)
+      CheckHilbertUpperBound(tree.Child(i), queries);
+  }
+}
+
+TEST_CASE("DiscreteHilbertValueUpperBoundTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(4, 500); // 500 points in 4 dimensions.
+
+  typedef HilbertRTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat> TreeType;
+  TreeType hilbertRTree(dataset, 20, 6, 5, 2, 0);
+
+  // Use a mixture of points present in the tree and fresh random points.
+  arma::mat queries(4, 20, arma::fill::randu);
+  queries.cols(0, 9) = dataset.cols(0, 9);
+
+  CheckHilbertUpperBound(hilbertRTree, queries);
+}
+
 TEST_CASE("DiscreteHilbertValueTest", "[RectangleTreeTraitsTest]")
 {
   arma::vec point01(1);
@@ -1359,3 +1411,170 @@ TEST_CASE("RectangleTreeMoveDatasetTest", "[RectangleTreeTraitsTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+/**
+ * A function to run every structural check we have on a bulk-loaded tree: the
+ * right number of points, correct (and tight) containment, correct parent
+ * pointers, and legal fills.
+ */
+template<typename TreeType>
+void CheckBulkLoadedTree(const TreeType& tree, const size_t numPoints)
+{
+  REQUIRE(tree.NumDescendants() == numPoints);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckHierarchy(tree);
+  CheckNumDescendants(tree);
+  CheckFills(tree);
+}
+
+// Test that a bulk-loaded R tree is structurally valid and gives exactly the
+// same search results as a naive search.
+TEST_CASE("StrBulkLoadTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  typedef RTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  TreeType tree(dataset, StrBulkLoad(), 20, 6, 5, 2, 0);
+
+  CheckBulkLoadedTree(tree, 1000);
+
+  // Every leaf should be packed (nearly) full: the bulk loader balances the
+  // leaf sizes, so no leaf can be less than half full.
+  std::vector<const TreeType*> stack(1, &tree);
+  while (!stack.empty())
+  {
+    const TreeType* node = stack.back();
+    stack.pop_back();
+    if (node->IsLeaf())
+      REQUIRE(node->Count() >= node->MaxLeafSize() / 2);
+    else
+      for (size_t i = 0; i < node->NumChildren(); ++i)
+        stack.push_back(&node->Child(i));
+  }
+
+  // Nearest neighbor search with the bulk-loaded R tree.
+  NeighborSearch<NearestNeighborSort, metric::LMetric<2, true>, arma::mat,
+      RTree> knn1(std::move(tree), SINGLE_TREE_MODE);
+
+  arma::Mat<size_t> neighbors1;
+  arma::mat distances1;
+  knn1.Search(5, neighbors1, distances1);
+
+  // Nearest neighbor search the naive way.
+  KNN knn2(dataset, NAIVE_MODE);
+
+  arma::Mat<size_t> neighbors2;
+  arma::mat distances2;
+  knn2.Search(5, neighbors2, distances2);
+
+  for (size_t i = 0; i < neighbors1.size(); ++i)
+  {
+    REQUIRE(neighbors1[i] == neighbors2[i]);
+    REQUIRE(distances1[i] == distances2[i]);
+  }
+}
+
+// Test that bulk loading also produces valid R* and X trees.
+TEST_CASE("StrBulkLoadVariantsTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  typedef RStarTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat> RStarTreeType;
+  RStarTreeType rStarTree(dataset, StrBulkLoad(), 20, 6, 5, 2, 0);
+  CheckBulkLoadedTree(rStarTree, 1000);
+
+  typedef XTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> XTreeType;
+  XTreeType xTree(dataset, StrBulkLoad(), 20, 6, 5, 2, 0);
+  CheckBulkLoadedTree(xTree, 1000);
+}
+
+// Test that a bulk-loaded Hilbert R tree keeps its points and nodes in Hilbert
+// order, with the largest Hilbert values in sync, and that it gives correct
+// search results.
+TEST_CASE("StrBulkLoadHilbertTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  typedef HilbertRTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat> TreeType;
+  TreeType hilbertRTree(dataset, StrBulkLoad(), 20, 6, 5, 2, 0);
+
+  CheckBulkLoadedTree(hilbertRTree, 1000);
+  CheckHilbertOrdering(hilbertRTree);
+  CheckDiscreteHilbertValueSync(hilbertRTree);
+
+  // Nearest neighbor search with the bulk-loaded Hilbert R tree.
+  NeighborSearch<NearestNeighborSort, metric::LMetric<2, true>, arma::mat,
+      HilbertRTree> knn1(std::move(hilbertRTree), SINGLE_TREE_MODE);
+
+  arma::Mat<size_t> neighbors1;
+  arma::mat distances1;
+  knn1.Search(5, neighbors1, distances1);
+
+  // Nearest neighbor search the naive way.
+  KNN knn2(dataset, NAIVE_MODE);
+
+  arma::Mat<size_t> neighbors2;
+  arma::mat distances2;
+  knn2.Search(5, neighbors2, distances2);
+
+  for (size_t i = 0; i < neighbors1.size(); ++i)
+  {
+    REQUIRE(neighbors1[i] == neighbors2[i]);
+    REQUIRE(distances1[i] == distances2[i]);
+  }
+}
+
+// Test the bulk-load edge cases: a dataset that fits into the root leaf, and
+// the dataset-owning (move) constructor.
+TEST_CASE("StrBulkLoadSmallAndMoveTest", "[RectangleTreeTraitsTest]")
+{
+  typedef RTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  // Everything fits into the root, which stays a leaf.
+  arma::mat smallDataset = arma::randu<arma::mat>(3, 15);
+  TreeType smallTree(smallDataset, StrBulkLoad(), 20, 6, 5, 2, 0);
+
+  REQUIRE(smallTree.IsLeaf());
+  REQUIRE(smallTree.Count() == 15);
+  CheckBulkLoadedTree(smallTree, 15);
+
+  // The move constructor should take ownership of the dataset.
+  arma::mat dataset = arma::randu<arma::mat>(3, 1000);
+  TreeType tree(std::move(dataset), StrBulkLoad());
+
+  REQUIRE(dataset.n_elem == 0);
+  REQUIRE(tree.Dataset().n_rows == 3);
+  REQUIRE(tree.Dataset().n_cols == 1000);
+  CheckBulkLoadedTree(tree, 1000);
+}
+
+// Test that a bulk-loaded tree remains fully dynamic: points can still be
+// deleted from it, with the usual tree condensation.
+TEST_CASE("StrBulkLoadDynamicDeleteTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  const int numIter = 50;
+
+  typedef RTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  TreeType tree(dataset, StrBulkLoad(), 20, 6, 5, 2, 0);
+
+  for (int i = 0; i < numIter; ++i)
+    tree.DeletePoint(999 - i);
+
+  REQUIRE(tree.NumDescendants() == 1000 - numIter);
+
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckNumDescendants(tree);
+}
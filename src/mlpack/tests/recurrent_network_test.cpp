@@ -711,6 +711,105 @@ TEST_CASE("MultiTimestepTest", "[RecurrentNetworkTest]")
   REQUIRE(err <= 0.025);
 }
 
+/**
+ * Test that training with per-sequence lengths gives the same objective and
+ * gradients as evaluating each length group on its own.
+ */
+TEST_CASE("RNNSequenceLengthsTest", "[RecurrentNetworkTest]")
+{
+  const size_t rho = 6;
+  const size_t shortRho = 3;
+
+  arma::cube input(2, 8, rho, arma::fill::randu);
+  arma::cube target(1, 8, rho, arma::fill::randu);
+
+  // A zero step size, one iteration and no shuffling: Train() only installs
+  // the data and the sequence lengths, and leaves the parameters untouched.
+  ens::StandardSGD opt(0.0, 8, 1, 1e-5, false);
+
+  RNN<MeanSquaredError<> > model(rho);
+  model.Add<Linear<> >(2, 4);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(4, 1);
+
+  // When every sequence has length rho, the masked evaluation must match the
+  // unmasked one.
+  model.Train(input, target, opt);
+  const double unmasked = model.Evaluate(model.Parameters(), 0, 8);
+
+  arma::urowvec fullLengths(8);
+  fullLengths.fill(rho);
+  model.Train(input, target, fullLengths, opt);
+  REQUIRE(model.Evaluate(model.Parameters(), 0, 8) ==
+      Approx(unmasked).epsilon(1e-10));
+
+  // Now give the last four sequences a shorter length.  The lengths are
+  // already in decreasing order, so the sorting does not move any sequence,
+  // and with a batch size of four each batch holds one length group.
+  arma::urowvec mixedLengths(8);
+  mixedLengths.subvec(0, 3).fill(rho);
+  mixedLengths.subvec(4, 7).fill(shortRho);
+  model.Train(input, target, mixedLengths, opt);
+
+  const double longBatch = model.Evaluate(model.Parameters(), 0, 4);
+  const double shortBatch = model.Evaluate(model.Parameters(), 4, 4);
+  arma::mat longBatchGradient, shortBatchGradient;
+  model.EvaluateWithGradient(model.Parameters(), 0, longBatchGradient, 4);
+  model.EvaluateWithGradient(model.Parameters(), 4, shortBatchGradient, 4);
+
+  // The long group evaluated on its own.
+  RNN<MeanSquaredError<> > longModel(rho);
+  longModel.Add<Linear<> >(2, 4);
+  longModel.Add<SigmoidLayer<> >();
+  longModel.Add<Linear<> >(4, 1);
+  ens::StandardSGD groupOpt(0.0, 4, 1, 1e-5, false);
+  longModel.Train(input.subcube(0, 0, 0, 1, 3, rho - 1),
+      target.subcube(0, 0, 0, 0, 3, rho - 1), groupOpt);
+  longModel.Parameters() = model.Parameters();
+  REQUIRE(longModel.Evaluate(longModel.Parameters(), 0, 4) ==
+      Approx(longBatch).epsilon(1e-10));
+  arma::mat longGradient;
+  longModel.EvaluateWithGradient(longModel.Parameters(), 0, longGradient, 4);
+  CheckMatrices(longBatchGradient, longGradient);
+
+  // The short group evaluated on its own, with the padding removed.
+  RNN<MeanSquaredError<> > shortModel(shortRho);
+  shortModel.Add<Linear<> >(2, 4);
+  shortModel.Add<SigmoidLayer<> >();
+  shortModel.Add<Linear<> >(4, 1);
+  shortModel.Train(input.subcube(0, 4, 0, 1, 7, shortRho - 1),
+      target.subcube(0, 4, 0, 0, 7, shortRho - 1), groupOpt);
+  shortModel.Parameters() = model.Parameters();
+  REQUIRE(shortModel.Evaluate(shortModel.Parameters(), 0, 4) ==
+      Approx(shortBatch).epsilon(1e-10));
+  arma::mat shortGradient;
+  shortModel.EvaluateWithGradient(shortModel.Parameters(), 0, shortGradient,
+      4);
+  CheckMatrices(shortBatchGradient, shortGradient);
+
+  // The padded region of a mixed batch must have no influence on the
+  // objective or the gradient.
+  arma::cube garbageInput = input;
+  arma::cube garbageTarget = target;
+  garbageInput.subcube(0, 4, shortRho, 1, 7, rho - 1).fill(-3.0);
+  garbageTarget.subcube(0, 4, shortRho, 0, 7, rho - 1).fill(42.0);
+
+  RNN<MeanSquaredError<> > garbageModel(rho);
+  garbageModel.Add<Linear<> >(2, 4);
+  garbageModel.Add<SigmoidLayer<> >();
+  garbageModel.Add<Linear<> >(4, 1);
+  garbageModel.Train(garbageInput, garbageTarget, mixedLengths, opt);
+  garbageModel.Parameters() = model.Parameters();
+
+  REQUIRE(garbageModel.Evaluate(garbageModel.Parameters(), 0, 8) ==
+      Approx(model.Evaluate(model.Parameters(), 0, 8)).epsilon(1e-10));
+  arma::mat garbageGradient, mixedGradient;
+  garbageModel.EvaluateWithGradient(garbageModel.Parameters(), 0,
+      garbageGradient, 8);
+  model.EvaluateWithGradient(model.Parameters(), 0, mixedGradient, 8);
+  CheckMatrices(garbageGradient, mixedGradient);
+}
+
 /**
  * Test that RNN::Train() returns finite objective value.
  */
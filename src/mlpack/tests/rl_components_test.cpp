@@ -271,6 +271,38 @@ TEST_CASE("RandomReplayTest", "[RLComponentsTest]")
   }
 }
 
+/**
+ * The replay memory can optionally store encoded states in single precision;
+ * sampling must still return the stored transition (up to float precision).
+ */
+TEST_CASE("RandomReplayFloatStorageTest", "[RLComponentsTest]")
+{
+  RandomReplay<MountainCar, arma::fmat> replay(1, 3);
+  MountainCar env;
+  MountainCar::State state = env.InitialSample();
+  MountainCar::Action action;
+  action.action = MountainCar::Action::actions::backward;
+  MountainCar::State nextState;
+  double reward = env.Sample(state, action, nextState);
+  replay.Store(state, action, reward, nextState, env.IsTerminal(nextState),
+      0.9);
+  REQUIRE(1 == replay.Size());
+
+  arma::mat sampledState;
+  std::vector<MountainCar::Action> sampledAction;
+  arma::rowvec sampledReward;
+  arma::mat sampledNextState;
+  arma::irowvec sampledTerminal;
+  replay.Sample(sampledState, sampledAction, sampledReward, sampledNextState,
+      sampledTerminal);
+
+  CheckMatrices(state.Encode(), sampledState, 1e-4);
+  CheckMatrices(nextState.Encode(), sampledNextState, 1e-4);
+  REQUIRE(sampledAction.size() == 1);
+  REQUIRE(action.action == sampledAction[0].action);
+  REQUIRE(reward == Approx(arma::as_scalar(sampledReward)).epsilon(1e-7));
+}
+
 /**
  * Construct a greedy policy instance and check if it works as
  * it should be.
@@ -10,11 +10,13 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/core/data/scaler_methods/pca_whitening.hpp>
+#include <mlpack/core/data/scaler_methods/random_projection.hpp>
 #include <mlpack/core/data/scaler_methods/zca_whitening.hpp>
 #include <mlpack/core/data/scaler_methods/min_max_scaler.hpp>
 #include <mlpack/core/data/scaler_methods/max_abs_scaler.hpp>
 #include <mlpack/core/data/scaler_methods/standard_scaler.hpp>
 #include <mlpack/core/data/scaler_methods/mean_normalization.hpp>
+#include <mlpack/core/data/scaler_methods/scaler_pipeline.hpp>
 
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
@@ -172,3 +174,74 @@ TEST_CASE("ZCAWhiteningTest", "[ScalingTest]")
   scale.InverseTransform(output, temp);
   CheckMatrices(dataset, temp);
 }
+
+/**
+ * Test that a ScalerPipeline matches applying its stages by hand, and that
+ * the blockwise transforms round-trip.
+ */
+TEST_CASE("ScalerPipelineTest", "[ScalingTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(5, 100);
+
+  // Reference: fit and apply the two stages manually.
+  arma::mat expected;
+  data::MinMaxScaler minMaxScale(2, 5);
+  minMaxScale.Fit(input);
+  minMaxScale.Transform(input, expected);
+  data::StandardScaler standardScale;
+  standardScale.Fit(expected);
+  standardScale.Transform(expected, expected);
+
+  // A small block size forces the blockwise path through several blocks.
+  data::ScalerPipeline<data::MinMaxScaler, data::StandardScaler> pipeline(
+      data::MinMaxScaler(2, 5), data::StandardScaler());
+  pipeline.BlockSize() = 7;
+  pipeline.Fit(input);
+
+  arma::mat output;
+  pipeline.Transform(input, output);
+  CheckMatrices(output, expected);
+
+  // The in-place overload must agree with the copying one.
+  arma::mat inPlace(input);
+  pipeline.Transform(inPlace);
+  CheckMatrices(inPlace, expected);
+
+  // Inverting the chain must recover the original data.
+  pipeline.InverseTransform(inPlace);
+  CheckMatrices(inPlace, input);
+}
+
+/**
+ * Test for the RandomProjection scaler class.
+ */
+TEST_CASE("RandomProjectionScalerTest", "[ScalingTest]")
+{
+  // A power-of-two dimensionality keeps the inverse transform exact.
+  arma::mat input = arma::randu<arma::mat>(32, 100);
+
+  data::RandomProjection scale(10);
+  scale.Fit(input);
+
+  arma::mat output;
+  scale.Transform(input, output);
+  REQUIRE(output.n_rows == 10);
+  REQUIRE(output.n_cols == input.n_cols);
+
+  // The squared norms should be preserved on average; with 32 dimensions and
+  // 100 points the relative error of the total is small.
+  REQUIRE(arma::accu(arma::square(output)) ==
+      Approx(arma::accu(arma::square(input))).epsilon(0.5));
+
+  // The inverse transform gives the least-squares reconstruction: projecting
+  // it again must reproduce the projected data.
+  arma::mat reconstructed, reprojected;
+  scale.InverseTransform(output, reconstructed);
+  REQUIRE(reconstructed.n_rows == input.n_rows);
+  scale.Transform(reconstructed, reprojected);
+  CheckMatrices(output, reprojected);
+
+  // Transform() before Fit() must throw.
+  data::RandomProjection unfitted(10);
+  REQUIRE_THROWS_AS(unfitted.Transform(input, output), std::runtime_error);
+}
@@ -35,7 +35,7 @@ TEST_CASE("SoftmaxRegressionFunctionEvaluate", "[SoftmaxRegressionTest]")
     labels(i) = math::RandInt(0, numClasses);
 
   // Create a SoftmaxRegressionFunction. Regularization term ignored.
-  SoftmaxRegressionFunction srf(data, labels, numClasses, 0);
+  SoftmaxRegressionFunction<> srf(data, labels, numClasses, 0);
 
   // Run a number of trials.
   for (size_t i = 0; i < trials; ++i)
@@ -82,9 +82,9 @@ TEST_CASE("SoftmaxRegressionFunctionRegularizationEvaluate",
     labels(i) = math::RandInt(0, numClasses);
 
   // 3 objects for comparing regularization costs.
-  SoftmaxRegressionFunction srfNoReg(data, labels, numClasses, 0);
-  SoftmaxRegressionFunction srfSmallReg(data, labels, numClasses, 1);
-  SoftmaxRegressionFunction srfBigReg(data, labels, numClasses, 20);
+  SoftmaxRegressionFunction<> srfNoReg(data, labels, numClasses, 0);
+  SoftmaxRegressionFunction<> srfSmallReg(data, labels, numClasses, 1);
+  SoftmaxRegressionFunction<> srfBigReg(data, labels, numClasses, 20);
 
   // Run a number of trials.
   for (size_t i = 0; i < trials; ++i)
@@ -125,8 +125,8 @@ TEST_CASE("SoftmaxRegressionFunctionGradient",
 
   // 2 objects for 2 terms in the cost function. Each term contributes towards
   // the gradient and thus need to be checked independently.
-  SoftmaxRegressionFunction srf1(data, labels, numClasses, 0);
-  SoftmaxRegressionFunction srf2(data, labels, numClasses, 20);
+  SoftmaxRegressionFunction<> srf1(data, labels, numClasses, 0);
+  SoftmaxRegressionFunction<> srf2(data, labels, numClasses, 20);
 
   // Create a random set of parameters.
   arma::mat parameters;
@@ -674,3 +674,125 @@ TEST_CASE("SoftmaxRegressionComputeProbabilitiesAndLabelsTest",
     REQUIRE(testLabels(i) == labels(i));
   }
 }
+
+/**
+ * Test sparse and dense softmax regression and make sure they both work the
+ * same using the L-BFGS optimizer.
+ */
+TEST_CASE("SoftmaxRegressionSparseLBFGSTest", "[SoftmaxRegressionTest]")
+{
+  // Create a random dataset.
+  arma::sp_mat dataset;
+  dataset.sprandu(10, 800, 0.3);
+  arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels(800);
+  for (size_t i = 0; i < 800; ++i)
+    labels[i] = math::RandInt(0, 3);
+
+  SoftmaxRegression sr(denseDataset, labels, 3, 0.3);
+
+  SoftmaxRegression srSparse(10, 3);
+  srSparse.Lambda() = 0.3;
+  srSparse.Train(dataset, labels, 3);
+
+  REQUIRE(sr.Parameters().n_elem == srSparse.Parameters().n_elem);
+  for (size_t i = 0; i < sr.Parameters().n_elem; ++i)
+    REQUIRE(sr.Parameters()[i] ==
+        Approx(srSparse.Parameters()[i]).epsilon(1e-5));
+}
+
+/**
+ * Test that a trained model can be trained further on a new batch of data (a
+ * warm start), and that it still classifies well afterwards.
+ */
+TEST_CASE("SoftmaxRegressionIncrementalTrainingTest", "[SoftmaxRegressionTest]")
+{
+  const size_t points = 1000;
+  const size_t inputSize = 3;
+  const size_t numClasses = 2;
+
+  // Generate a two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("9.0 9.0 9.0"), arma::eye<arma::mat>(3, 3));
+
+  // Interleave the classes so that both batches contain both classes.
+  arma::mat data(inputSize, points);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; i += 2)
+  {
+    data.col(i) = g1.Random();
+    labels(i) = 0;
+    data.col(i + 1) = g2.Random();
+    labels(i + 1) = 1;
+  }
+
+  // Train on the first batch of data.
+  SoftmaxRegression sr(data.cols(0, points / 2 - 1),
+      labels.cols(0, points / 2 - 1), numClasses);
+
+  // Now train further on the second batch; this should continue from the
+  // already-trained parameters instead of restarting.
+  sr.Train(data.cols(points / 2, points - 1),
+      labels.cols(points / 2, points - 1), numClasses);
+
+  // The model should classify the full dataset well.
+  const double acc = sr.ComputeAccuracy(data, labels);
+  REQUIRE(acc == Approx(100.0).epsilon(0.02));
+}
+
+/**
+ * Test that per-instance weights behave exactly like replicated points: the
+ * weighted objective function must agree with the unweighted objective
+ * function on a dataset where each point is physically copied as many times
+ * as its (integer) weight.
+ */
+TEST_CASE("SoftmaxRegressionFunctionWeightedEvaluate",
+          "[SoftmaxRegressionTest]")
+{
+  const size_t points = 100;
+  const size_t inputSize = 5;
+  const size_t numClasses = 3;
+
+  arma::mat data(inputSize, points, arma::fill::randu);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(points,
+      arma::distr_param(0, numClasses - 1));
+
+  // Integer weights, so that the replicated dataset is exactly equivalent.
+  arma::rowvec weights(points);
+  for (size_t i = 0; i < points; ++i)
+    weights[i] = (double) ((i % 4) + 1);
+
+  // Build the physically replicated dataset.
+  const size_t repPoints = (size_t) arma::accu(weights);
+  arma::mat repData(inputSize, repPoints);
+  arma::Row<size_t> repLabels(repPoints);
+  size_t col = 0;
+  for (size_t i = 0; i < points; ++i)
+  {
+    for (size_t w = 0; w < (size_t) weights[i]; ++w)
+    {
+      repData.col(col) = data.col(i);
+      repLabels[col] = labels[i];
+      ++col;
+    }
+  }
+
+  SoftmaxRegressionFunction<> weighted(data, labels, numClasses, weights,
+      0.01);
+  SoftmaxRegressionFunction<> replicated(repData, repLabels, numClasses, 0.01);
+
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    arma::mat parameters(numClasses, inputSize, arma::fill::randn);
+    parameters *= 0.1;
+
+    REQUIRE(weighted.Evaluate(parameters) ==
+        Approx(replicated.Evaluate(parameters)).epsilon(1e-7));
+
+    arma::mat weightedGradient, replicatedGradient;
+    weighted.Gradient(parameters, weightedGradient);
+    replicated.Gradient(parameters, replicatedGradient);
+    REQUIRE(arma::approx_equal(weightedGradient, replicatedGradient, "absdiff",
+        1e-7));
+  }
+}
@@ -0,0 +1,157 @@
+/**
+ * @file tests/spatial_join_test.cpp
+ *
+ * Tests for the SpatialJoin class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/spatial_join/spatial_join.hpp>
+
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::spatial;
+using namespace mlpack::metric;
+
+//! Compute the join by brute force, as ground truth.
+void BruteForceJoin(const arma::mat& firstSet,
+                    const arma::mat& secondSet,
+                    const double threshold,
+                    std::vector<std::pair<size_t, size_t>>& pairs,
+                    std::vector<double>& distances)
+{
+  pairs.clear();
+  distances.clear();
+  for (size_t i = 0; i < firstSet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < secondSet.n_cols; ++j)
+    {
+      const double distance = EuclideanDistance::Evaluate(firstSet.col(i),
+          secondSet.col(j));
+      if (distance <= threshold)
+      {
+        pairs.emplace_back(i, j);
+        distances.push_back(distance);
+      }
+    }
+  }
+}
+
+//! Sort a join result into a canonical order so that results can be compared.
+void SortJoinResult(std::vector<std::pair<size_t, size_t>>& pairs,
+                    std::vector<double>& distances)
+{
+  std::vector<size_t> order(pairs.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::sort(order.begin(), order.end(),
+      [&](const size_t a, const size_t b) { return pairs[a] < pairs[b]; });
+
+  std::vector<std::pair<size_t, size_t>> sortedPairs(pairs.size());
+  std::vector<double> sortedDistances(distances.size());
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    sortedPairs[i] = pairs[order[i]];
+    sortedDistances[i] = distances[order[i]];
+  }
+  pairs = std::move(sortedPairs);
+  distances = std::move(sortedDistances);
+}
+
+/**
+ * The tree-based join must report exactly the pairs that brute force does,
+ * each exactly once, for a range of thresholds.
+ */
+TEST_CASE("SpatialJoinTreeVsBruteForceTest", "[SpatialJoinTest]")
+{
+  arma::mat firstSet = arma::randu<arma::mat>(3, 200);
+  arma::mat secondSet = arma::randu<arma::mat>(3, 300);
+
+  SpatialJoin<> join(firstSet, secondSet);
+
+  const double thresholds[] = { 0.0, 0.05, 0.25, 0.75 };
+  for (const double threshold : thresholds)
+  {
+    std::vector<std::pair<size_t, size_t>> pairs, expectedPairs;
+    std::vector<double> distances, expectedDistances;
+
+    join.Search(threshold, pairs, distances);
+    BruteForceJoin(firstSet, secondSet, threshold, expectedPairs,
+        expectedDistances);
+
+    REQUIRE(pairs.size() == expectedPairs.size());
+    REQUIRE(distances.size() == pairs.size());
+
+    SortJoinResult(pairs, distances);
+    SortJoinResult(expectedPairs, expectedDistances);
+    for (size_t i = 0; i < pairs.size(); ++i)
+    {
+      REQUIRE(pairs[i] == expectedPairs[i]);
+      REQUIRE(distances[i] ==
+          Approx(expectedDistances[i]).epsilon(1e-10).margin(1e-12));
+    }
+  }
+}
+
+/**
+ * The block-nested fallback must give the same result as the tree-based
+ * join.
+ */
+TEST_CASE("SpatialJoinNaiveEquivalenceTest", "[SpatialJoinTest]")
+{
+  arma::mat firstSet = arma::randu<arma::mat>(5, 150);
+  arma::mat secondSet = arma::randu<arma::mat>(5, 150);
+
+  SpatialJoin<> treeJoin(firstSet, secondSet);
+  SpatialJoin<> naiveJoin(firstSet, secondSet, true);
+  REQUIRE(naiveJoin.Naive());
+
+  std::vector<std::pair<size_t, size_t>> treePairs, naivePairs;
+  std::vector<double> treeDistances, naiveDistances;
+  treeJoin.Search(0.5, treePairs, treeDistances);
+  naiveJoin.Search(0.5, naivePairs, naiveDistances);
+
+  REQUIRE(treePairs.size() == naivePairs.size());
+
+  SortJoinResult(treePairs, treeDistances);
+  SortJoinResult(naivePairs, naiveDistances);
+  for (size_t i = 0; i < treePairs.size(); ++i)
+  {
+    REQUIRE(treePairs[i] == naivePairs[i]);
+    REQUIRE(treeDistances[i] ==
+        Approx(naiveDistances[i]).epsilon(1e-10).margin(1e-12));
+  }
+}
+
+/**
+ * The join must also work with the plain R tree, and must prune everything
+ * when the two sets are far apart.
+ */
+TEST_CASE("SpatialJoinRTreeSeparatedClustersTest", "[SpatialJoinTest]")
+{
+  arma::mat firstSet = arma::randu<arma::mat>(3, 100);
+  arma::mat secondSet = arma::randu<arma::mat>(3, 100) + 10.0;
+
+  SpatialJoin<EuclideanDistance, arma::mat, tree::RTree> join(firstSet,
+      secondSet);
+
+  std::vector<std::pair<size_t, size_t>> pairs;
+  std::vector<double> distances;
+
+  // The clusters are well over distance 1 apart, so nothing matches.
+  join.Search(1.0, pairs, distances);
+  REQUIRE(pairs.size() == 0);
+
+  // A threshold larger than the diameter of the union matches everything.
+  join.Search(100.0, pairs, distances);
+  REQUIRE(pairs.size() == firstSet.n_cols * secondSet.n_cols);
+
+  // Negative thresholds are invalid.
+  REQUIRE_THROWS_AS(join.Search(-1.0, pairs, distances),
+      std::invalid_argument);
+}
@@ -421,3 +421,121 @@ TEST_CASE("SplitLabeledDataResultField", "[SplitDataTest]")
   CheckFields(input, inputConcat);
   CheckFields(label, labelConcat);
 }
+
+/**
+ * Test SplitIndices(): the index vectors must partition the dataset, and
+ * views formed from them must match the original columns.
+ */
+TEST_CASE("SplitIndicesResultTest", "[SplitDataTest]")
+{
+  const mat input(2, 10, fill::randu);
+
+  uvec trainIdx, testIdx;
+  SplitIndices(input.n_cols, trainIdx, testIdx, 0.2);
+  REQUIRE(trainIdx.n_elem == 8);
+  REQUIRE(testIdx.n_elem == 2);
+
+  // Every index must be used exactly once.
+  uvec counts(input.n_cols, fill::zeros);
+  for (uword i : trainIdx)
+    counts[i]++;
+  for (uword i : testIdx)
+    counts[i]++;
+  for (uword i = 0; i < counts.n_elem; ++i)
+    REQUIRE(counts[i] == 1);
+
+  // The views must refer to the original columns.
+  const mat trainData = input.cols(trainIdx);
+  for (size_t i = 0; i < trainIdx.n_elem; ++i)
+    CheckMatrices(mat(input.col(trainIdx[i])), mat(trainData.col(i)));
+
+  // Without shuffling, the split must be the linear-order split.
+  SplitIndices(input.n_cols, trainIdx, testIdx, 0.2, false);
+  for (uword i = 0; i < trainIdx.n_elem; ++i)
+    REQUIRE(trainIdx[i] == i);
+  for (uword i = 0; i < testIdx.n_elem; ++i)
+    REQUIRE(testIdx[i] == trainIdx.n_elem + i);
+}
+
+/**
+ * Test StratifiedSplitIndices(): the label ratios of the index-based split
+ * must match those of StratifiedSplit().
+ */
+TEST_CASE("StratifiedSplitIndicesResultTest", "[SplitDataTest]")
+{
+  // 2 0s, 10 1s, 12 2s and 16 3s; at a test ratio of 0.25 the test set must
+  // receive 0 0s, 2 1s, 3 2s and 4 3s.
+  Row<size_t> labels(40);
+  labels.cols(0, 1).fill(0);
+  labels.cols(2, 11).fill(1);
+  labels.cols(12, 23).fill(2);
+  labels.cols(24, 39).fill(3);
+
+  uvec trainIdx, testIdx;
+  StratifiedSplitIndices(labels, trainIdx, testIdx, 0.25);
+
+  REQUIRE(trainIdx.n_elem == 31);
+  REQUIRE(testIdx.n_elem == 9);
+
+  const Row<size_t> testLabels = labels.cols(testIdx);
+  REQUIRE(static_cast<uvec>(find(testLabels == 0)).n_elem == 0);
+  REQUIRE(static_cast<uvec>(find(testLabels == 1)).n_elem == 2);
+  REQUIRE(static_cast<uvec>(find(testLabels == 2)).n_elem == 3);
+  REQUIRE(static_cast<uvec>(find(testLabels == 3)).n_elem == 4);
+
+  // Every index must be used exactly once.
+  uvec counts(labels.n_elem, fill::zeros);
+  for (uword i : trainIdx)
+    counts[i]++;
+  for (uword i : testIdx)
+    counts[i]++;
+  for (uword i = 0; i < counts.n_elem; ++i)
+    REQUIRE(counts[i] == 1);
+}
+
+/**
+ * Test that StreamingSplit() is deterministic and independent of chunk
+ * boundaries: splitting a dataset in one piece and in several chunks must
+ * give the same result.
+ */
+TEST_CASE("StreamingSplitChunkInvarianceTest", "[SplitDataTest]")
+{
+  const mat input(3, 500, fill::randu);
+
+  mat trainData, testData;
+  StreamingSplit(input, trainData, testData, 0.3);
+  REQUIRE(trainData.n_cols + testData.n_cols == input.n_cols);
+
+  // The expected test fraction is 0.3; with 500 samples the realized count
+  // should be in a loose band around 150.
+  REQUIRE(testData.n_cols > 100);
+  REQUIRE(testData.n_cols < 200);
+
+  // Replay the dataset in uneven chunks; the concatenated results must be
+  // identical to the single-pass split.
+  mat trainChunks, testChunks;
+  const size_t chunkSizes[] = { 123, 77, 300 };
+  size_t offset = 0;
+  for (size_t chunkSize : chunkSizes)
+  {
+    mat trainChunk, testChunk;
+    StreamingSplit(input.cols(offset, offset + chunkSize - 1), trainChunk,
+        testChunk, 0.3, offset);
+    trainChunks = arma::join_rows(trainChunks, trainChunk);
+    testChunks = arma::join_rows(testChunks, testChunk);
+    offset += chunkSize;
+  }
+
+  CheckMatrices(trainData, trainChunks);
+  CheckMatrices(testData, testChunks);
+
+  // A different seed must give a different assignment for at least one
+  // sample, while each seed remains self-consistent.
+  bool anyDifferent = false;
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    REQUIRE(SplitIsTest(i, 0.3) == SplitIsTest(i, 0.3));
+    anyDifferent |= (SplitIsTest(i, 0.3) != SplitIsTest(i, 0.3, 1));
+  }
+  REQUIRE(anyDifferent);
+}
@@ -1434,3 +1434,45 @@ TEST_CASE("SplitByAnyOfTfIdfEncodingSerialization", "[StringEncodingTest]")
 
   CheckMatrices(output, xmlOutput, jsonOutput, binaryOutput);
 }
+
+/**
+ * Test the frozen dictionary lookup table.
+ */
+TEST_CASE("FrozenStringEncodingDictionaryTest", "[StringEncodingTest]")
+{
+  arma::mat output;
+  DictionaryEncoding<SplitByAnyOf::TokenType> encoder;
+  SplitByAnyOf tokenizer(" .,\"");
+
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+
+  StringEncodingDictionary<boost::string_view>& dictionary =
+      encoder.Dictionary();
+
+  REQUIRE(!dictionary.Frozen());
+  dictionary.Freeze();
+  REQUIRE(dictionary.Frozen());
+
+  // Frozen lookups must agree with the mapping for every token.
+  for (const auto& keyValue : dictionary.Mapping())
+  {
+    REQUIRE(dictionary.HasToken(keyValue.first));
+    REQUIRE(dictionary.Value(keyValue.first) == keyValue.second);
+  }
+
+  REQUIRE(!dictionary.HasToken("qwertyuiop"));
+  REQUIRE_THROWS_AS(dictionary.Value("qwertyuiop"), std::out_of_range);
+
+  // Encoding the same corpus again adds no tokens, so the dictionary stays
+  // frozen and the output must not change.
+  arma::mat frozenOutput;
+  encoder.Encode(stringEncodingInput, frozenOutput, tokenizer);
+
+  CheckMatrices(output, frozenOutput);
+  REQUIRE(dictionary.Frozen());
+
+  // A previously unseen token unfreezes the dictionary.
+  dictionary.AddToken("qwertyuiop");
+  REQUIRE(!dictionary.Frozen());
+  REQUIRE(dictionary.HasToken("qwertyuiop"));
+}
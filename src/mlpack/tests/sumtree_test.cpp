@@ -88,3 +88,42 @@ TEST_CASE("BatchUpdate", "[SumTreeTest]")
   CHECK(sumtree.FindPrefixSum(2.8) <= 3);
   CHECK(sumtree.FindPrefixSum(3.0) <= 3);
 }
+
+/**
+ * Test that a batch update touching only some leaves still leaves the whole
+ * tree consistent.
+ */
+TEST_CASE("SparseBatchUpdate", "[SumTreeTest]")
+{
+  SumTree<double> sumtree(8);
+  for (size_t i = 0; i < 8; ++i)
+    sumtree.Set(i, 1.0);
+
+  arma::ucolvec indices = {1, 6};
+  arma::colvec data = {0.5, 2.5};
+  sumtree.BatchUpdate(indices, data);
+
+  CHECK(sumtree.Get(1) == Approx(0.5).epsilon(1e-10));
+  CHECK(sumtree.Get(6) == Approx(2.5).epsilon(1e-10));
+  CHECK(sumtree.Sum() == Approx(9.0).epsilon(1e-10));
+  CHECK(sumtree.Sum(0, 4) == Approx(3.5).epsilon(1e-10));
+  CHECK(sumtree.Sum(4, 8) == Approx(5.5).epsilon(1e-10));
+}
+
+/**
+ * Test that the batched tree descent agrees with the scalar one.
+ */
+TEST_CASE("FindPrefixSumBatch", "[SumTreeTest]")
+{
+  SumTree<double> sumtree(8);
+  for (size_t i = 0; i < 8; ++i)
+    sumtree.Set(i, 0.1 + 0.2 * i);
+
+  arma::colvec masses = {0.0, 0.05, 0.3, 1.0, 2.0, 3.5, 6.3};
+  arma::ucolvec indices;
+  sumtree.FindPrefixSumBatch(masses, indices);
+
+  REQUIRE(indices.n_elem == masses.n_elem);
+  for (size_t i = 0; i < masses.n_elem; ++i)
+    CHECK(indices[i] == sumtree.FindPrefixSum(masses[i]));
+}
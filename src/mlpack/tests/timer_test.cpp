@@ -143,3 +143,202 @@ TEST_CASE("DisabledTimingTest", "[TimerTest]")
 
   REQUIRE(Timer::Get("test_timer") == std::chrono::microseconds(0));
 }
+
+/**
+ * Nested profiler sections must be recorded under slash-separated paths, with
+ * call counts, and disappear on Reset().
+ */
+TEST_CASE("ProfilerHierarchyTest", "[TimerTest]")
+{
+  Profiler::Reset();
+  Profiler::Enable();
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    ProfileSection outer("tree_building");
+    {
+      ProfileSection inner("split_selection");
+      #ifdef _WIN32
+      Sleep(5);
+      #else
+      usleep(5000);
+      #endif
+    }
+  }
+
+  Profiler::Disable();
+
+  std::map<std::string, ProfileEntry> results = Profiler::GetAll();
+  REQUIRE(results.count("tree_building") == 1);
+  REQUIRE(results.count("tree_building/split_selection") == 1);
+  REQUIRE(results.count("split_selection") == 0);
+
+  REQUIRE(results["tree_building"].calls == 3);
+  REQUIRE(results["tree_building/split_selection"].calls == 3);
+
+  // The parent includes its child's time, and the child slept 3x5ms.
+  REQUIRE(results["tree_building/split_selection"].total.count() >= 15000000);
+  REQUIRE(results["tree_building"].total >=
+      results["tree_building/split_selection"].total);
+
+  Profiler::Reset();
+  REQUIRE(Profiler::GetAll().empty());
+}
+
+/**
+ * Each thread aggregates into its own buffer; the merged results must sum
+ * over all threads.
+ */
+TEST_CASE("ProfilerMultithreadTest", "[TimerTest]")
+{
+  Profiler::Reset();
+  Profiler::Enable();
+
+  std::thread threads[3];
+  for (size_t i = 0; i < 3; ++i)
+  {
+    threads[i] = std::thread([]()
+        {
+          ProfileSection section("thread_work");
+          #ifdef _WIN32
+          Sleep(20);
+          #else
+          int restarts = 0;
+          // Catch occasional EINTR failures.
+          while (usleep(20000) != 0 && restarts < 3)
+            ++restarts;
+          #endif
+        });
+  }
+
+  for (size_t i = 0; i < 3; ++i)
+    threads[i].join();
+
+  Profiler::Disable();
+
+  std::map<std::string, ProfileEntry> results = Profiler::GetAll();
+  REQUIRE(results["thread_work"].calls == 3);
+  REQUIRE(results["thread_work"].total >= std::chrono::milliseconds(50));
+
+  Profiler::Reset();
+}
+
+/**
+ * Mismatched Stop() calls must throw, and everything must be a no-op while
+ * profiling is disabled.
+ */
+TEST_CASE("ProfilerMismatchAndDisabledTest", "[TimerTest]")
+{
+  Profiler::Reset();
+  Profiler::Enable();
+
+  REQUIRE_THROWS_AS(Profiler::Stop("never_started"), std::runtime_error);
+
+  Profiler::Start("outer");
+  Profiler::Start("inner");
+  // "outer" is not the innermost section.
+  REQUIRE_THROWS_AS(Profiler::Stop("outer"), std::runtime_error);
+  Profiler::Stop("inner");
+  Profiler::Stop("outer");
+
+  Profiler::Disable();
+
+  // Disabled: no recording, no exceptions.
+  Profiler::Start("disabled_section");
+  Profiler::Stop("disabled_section");
+
+  std::map<std::string, ProfileEntry> results = Profiler::GetAll();
+  REQUIRE(results.count("disabled_section") == 0);
+  REQUIRE(results["outer/inner"].calls == 1);
+
+  Profiler::Reset();
+}
+
+/**
+ * The JSON dump must contain one member per section path with nanosecond
+ * totals and call counts.
+ */
+TEST_CASE("ProfilerJSONTest", "[TimerTest]")
+{
+  Profiler::Reset();
+  Profiler::Enable();
+
+  {
+    ProfileSection outer("a");
+    ProfileSection inner("b");
+  }
+
+  Profiler::Disable();
+
+  std::ostringstream oss;
+  Profiler::PrintJSON(oss);
+  const std::string json = oss.str();
+
+  REQUIRE(json.find("\"a\"") != std::string::npos);
+  REQUIRE(json.find("\"a/b\"") != std::string::npos);
+  REQUIRE(json.find("\"nanoseconds\"") != std::string::npos);
+  REQUIRE(json.find("\"calls\": 1") != std::string::npos);
+  REQUIRE(json.front() == '{');
+
+  Profiler::Reset();
+}
+
+/**
+ * Event counters must aggregate across threads, and the dumps must be valid
+ * JSON-ish output with the expected members.  (The MLPACK_COUNT() and
+ * MLPACK_SCOPED_TRACE() macros are no-ops in this build unless
+ * MLPACK_INSTRUMENTATION is defined, so this exercises the underlying API
+ * directly; the macro calls just have to compile away.)
+ */
+TEST_CASE("InstrumentationCounterTest", "[TimerTest]")
+{
+  Instrumentation::Reset();
+
+  // These must compile (to nothing, unless instrumentation is enabled).
+  MLPACK_COUNT(noop_counter);
+  MLPACK_COUNT_N(noop_counter, 5);
+  MLPACK_SCOPED_TRACE(noop_trace);
+
+  Instrumentation::Count("base_cases", 3);
+  Instrumentation::Count("base_cases");
+  Instrumentation::Count("prunes", 10);
+
+  std::thread t([]() { Instrumentation::Count("base_cases", 2); });
+  t.join();
+
+  std::map<std::string, uint64_t> counters = Instrumentation::Counters();
+  REQUIRE(counters["base_cases"] == 6);
+  REQUIRE(counters["prunes"] == 10);
+
+  std::ostringstream oss;
+  Instrumentation::PrintCounters(oss);
+  REQUIRE(oss.str().find("\"base_cases\": 6") != std::string::npos);
+  REQUIRE(oss.str().find("\"prunes\": 10") != std::string::npos);
+
+  Instrumentation::Reset();
+  REQUIRE(Instrumentation::Counters().empty());
+}
+
+/**
+ * Scoped traces must come out in the Chrome trace event format: complete
+ * events with names, timestamps, and durations.
+ */
+TEST_CASE("InstrumentationChromeTraceTest", "[TimerTest]")
+{
+  Instrumentation::Reset();
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto end = start + std::chrono::microseconds(250);
+  Instrumentation::Trace("tree_search", start, end);
+
+  std::ostringstream oss;
+  Instrumentation::PrintChromeTrace(oss);
+  const std::string trace = oss.str();
+
+  REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+  REQUIRE(trace.find("\"name\": \"tree_search\"") != std::string::npos);
+  REQUIRE(trace.find("\"ph\": \"X\"") != std::string::npos);
+  REQUIRE(trace.find("\"dur\": 250") != std::string::npos);
+
+  Instrumentation::Reset();
+}
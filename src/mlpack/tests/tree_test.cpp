@@ -14,9 +14,13 @@
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/metrics/mahalanobis_distance.hpp>
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
+#include <mlpack/core/tree/incremental_tree_builder.hpp>
+#include <mlpack/core/tree/leaf_size_tuner.hpp>
+#include <mlpack/core/tree/node_pool.hpp>
 #include <mlpack/core/tree/rectangle_tree.hpp>
 
 #include <queue>
+#include <set>
 #include <stack>
 
 #include "catch.hpp"
@@ -489,6 +493,49 @@ TEST_CASE("HRectBoundRangeDistancePoint", "[TreeTest]")
   }
 }
 
+/**
+ * Run the same RangeDistance() consistency checks at higher dimensionality
+ * (past the width of any vector register) and with a float element type, so
+ * the vectorized L2 path is compared against the scalar MinDistance() and
+ * MaxDistance() loops.
+ */
+TEST_CASE("HRectBoundRangeDistanceHighDimensions", "[TreeTest]")
+{
+  for (int i = 0; i < 10; ++i)
+  {
+    const size_t dim = 64 + math::RandInt(20);
+
+    HRectBound<EuclideanDistance> a(dim);
+    HRectBound<EuclideanDistance> b(dim);
+    HRectBound<EuclideanDistance, float> af(dim);
+    HRectBound<EuclideanDistance, float> bf(dim);
+
+    arma::vec loA(dim, arma::fill::randu), widthA(dim, arma::fill::randu);
+    arma::vec loB(dim, arma::fill::randu), widthB(dim, arma::fill::randu);
+
+    for (size_t j = 0; j < dim; ++j)
+    {
+      a[j] = Range(loA[j], loA[j] + widthA[j]);
+      b[j] = Range(loB[j], loB[j] + widthB[j]);
+      af[j] = RangeType<float>((float) loA[j], (float) (loA[j] + widthA[j]));
+      bf[j] = RangeType<float>((float) loB[j], (float) (loB[j] + widthB[j]));
+    }
+
+    const Range r = a.RangeDistance(b);
+    REQUIRE(r.Lo() == Approx(a.MinDistance(b)).epsilon(1e-7));
+    REQUIRE(r.Hi() == Approx(a.MaxDistance(b)).epsilon(1e-7));
+
+    const RangeType<float> rf = af.RangeDistance(bf);
+    REQUIRE(rf.Lo() == Approx(af.MinDistance(bf)).epsilon(1e-4));
+    REQUIRE(rf.Hi() == Approx(af.MaxDistance(bf)).epsilon(1e-4));
+
+    arma::vec point(dim, arma::fill::randu);
+    const Range s = a.RangeDistance(point);
+    REQUIRE(s.Lo() == Approx(a.MinDistance(point)).epsilon(1e-7));
+    REQUIRE(s.Hi() == Approx(a.MaxDistance(point)).epsilon(1e-7));
+  }
+}
+
 /**
  * Test that we can expand the bound to include a new point.
  */
@@ -1040,6 +1087,141 @@ TEST_CASE("HRectBoundDiameter", "[TreeTest]")
   REQUIRE(d.Diameter() == Approx(0.0).margin(1e-5));
 }
 
+/**
+ * Ensure that SparseHRectBound gives exactly the same results as HRectBound
+ * built on the densified data, while only storing ranges for the touched
+ * dimensions.
+ */
+TEST_CASE("SparseHRectBoundEquivalenceTest", "[TreeTest]")
+{
+  arma::sp_mat data;
+  data.sprandu(1000, 60, 0.01);
+  const arma::mat denseData(data);
+
+  SparseHRectBound<> sparseBound(1000);
+  HRectBound<> denseBound(1000);
+  sparseBound |= data.cols(0, 29);
+  sparseBound |= data.cols(30, 59);
+  denseBound |= denseData;
+
+  // Only the touched dimensions may be stored.
+  REQUIRE(sparseBound.NumStoredDims() < 1000);
+
+  // Each dimension's range must be identical to the dense bound's.
+  for (size_t d = 0; d < 1000; ++d)
+  {
+    REQUIRE(sparseBound[d].Lo() == Approx(denseBound[d].Lo()).margin(1e-10));
+    REQUIRE(sparseBound[d].Hi() == Approx(denseBound[d].Hi()).margin(1e-10));
+  }
+
+  REQUIRE(sparseBound.Diameter() == Approx(denseBound.Diameter()).
+      epsilon(1e-10));
+  REQUIRE(sparseBound.MinWidth() == Approx(denseBound.MinWidth()).
+      margin(1e-10));
+
+  arma::Col<double> sparseCenter, denseCenter;
+  sparseBound.Center(sparseCenter);
+  denseBound.Center(denseCenter);
+  REQUIRE(arma::approx_equal(sparseCenter, denseCenter, "absdiff", 1e-10));
+
+  // Point distances must agree, whether the point is given sparsely or
+  // densely.
+  arma::sp_vec sparsePoint;
+  sparsePoint.sprandu(1000, 1, 0.02);
+  const arma::vec densePoint(sparsePoint);
+
+  REQUIRE(sparseBound.MinDistance(sparsePoint) ==
+      Approx(denseBound.MinDistance(densePoint)).margin(1e-10));
+  REQUIRE(sparseBound.MinDistance(densePoint) ==
+      Approx(denseBound.MinDistance(densePoint)).margin(1e-10));
+  REQUIRE(sparseBound.MaxDistance(sparsePoint) ==
+      Approx(denseBound.MaxDistance(densePoint)).margin(1e-10));
+  REQUIRE(sparseBound.RangeDistance(sparsePoint).Lo() ==
+      Approx(denseBound.RangeDistance(densePoint).Lo()).margin(1e-10));
+  REQUIRE(sparseBound.RangeDistance(sparsePoint).Hi() ==
+      Approx(denseBound.RangeDistance(densePoint).Hi()).margin(1e-10));
+
+  // Bound-to-bound distances must also agree.
+  arma::sp_mat otherData;
+  otherData.sprandu(1000, 40, 0.01);
+
+  SparseHRectBound<> otherSparse(1000);
+  HRectBound<> otherDense(1000);
+  otherSparse |= otherData;
+  otherDense |= arma::mat(otherData);
+
+  REQUIRE(sparseBound.MinDistance(otherSparse) ==
+      Approx(denseBound.MinDistance(otherDense)).margin(1e-10));
+  REQUIRE(sparseBound.MaxDistance(otherSparse) ==
+      Approx(denseBound.MaxDistance(otherDense)).margin(1e-10));
+  REQUIRE(sparseBound.RangeDistance(otherSparse).Lo() ==
+      Approx(denseBound.RangeDistance(otherDense).Lo()).margin(1e-10));
+  REQUIRE(sparseBound.RangeDistance(otherSparse).Hi() ==
+      Approx(denseBound.RangeDistance(otherDense).Hi()).margin(1e-10));
+
+  // Merging bounds must behave like the dense union, too.
+  sparseBound |= otherSparse;
+  denseBound |= otherDense;
+  for (size_t d = 0; d < 1000; ++d)
+  {
+    REQUIRE(sparseBound[d].Lo() == Approx(denseBound[d].Lo()).margin(1e-10));
+    REQUIRE(sparseBound[d].Hi() == Approx(denseBound[d].Hi()).margin(1e-10));
+  }
+
+  // Containment must account for the implicit [0, 0] ranges: every enclosed
+  // point is contained, and a point that is nonzero in an untouched dimension
+  // is not.
+  for (size_t i = 0; i < data.n_cols; ++i)
+    REQUIRE(sparseBound.Contains(arma::sp_vec(data.col(i))));
+
+  size_t untouched = 0;
+  while (untouched < 1000 && (sparseBound[untouched].Lo() != 0 ||
+      sparseBound[untouched].Hi() != 0))
+    ++untouched;
+  REQUIRE(untouched < 1000);
+  arma::sp_vec outsidePoint(1000);
+  outsidePoint[untouched] = 1.0;
+  REQUIRE(!sparseBound.Contains(outsidePoint));
+}
+
+/**
+ * Ensure that the SparseKDTree only stores bound ranges for the dimensions
+ * its points touch.
+ */
+TEST_CASE("SparseKDTreeBoundStorageTest", "[TreeTest]")
+{
+  arma::sp_mat data;
+  data.sprandu(2000, 200, 0.005);
+
+  SparseKDTree<EuclideanDistance, EmptyStatistic, arma::sp_mat> tree(data, 20);
+
+  // The root stores at most one range per touched dimension, and leaves store
+  // far fewer.
+  REQUIRE(tree.Bound().NumStoredDims() < (size_t) 2000);
+  std::vector<const SparseKDTree<EuclideanDistance, EmptyStatistic,
+      arma::sp_mat>*> stack;
+  stack.push_back(&tree);
+  while (!stack.empty())
+  {
+    const auto* node = stack.back();
+    stack.pop_back();
+    if (node->IsLeaf())
+    {
+      // A leaf's bound cannot store more dimensions than its points have
+      // nonzero entries.
+      size_t nonzeros = 0;
+      for (size_t i = 0; i < node->NumPoints(); ++i)
+        nonzeros += arma::sp_vec(tree.Dataset().col(node->Point(i))).n_nonzero;
+      REQUIRE(node->Bound().NumStoredDims() <= nonzeros);
+    }
+    else
+    {
+      stack.push_back(node->Left());
+      stack.push_back(node->Right());
+    }
+  }
+}
+
 /**
  * It seems as though Bill has stumbled across a bug where
  * BinarySpaceTree<>::count() returns something different than
@@ -2287,3 +2469,250 @@ TEST_CASE("CoverTreeDescendantTest", "[TreeTest]")
   // using the recursive function above.
   CheckDescendants(&tree);
 }
+
+/**
+ * Build a cover tree on an adversarial dataset: collinear points with
+ * exponentially shrinking gaps, which forces the tree to be as deep as the
+ * number of points instead of logarithmic in it.  The tree should still
+ * satisfy all the cover tree invariants, and its (iterative) destruction
+ * should handle the extreme depth.
+ */
+TEST_CASE("CoverTreeAdversarialDepthTest", "[TreeTest]")
+{
+  // Each point is at 2^(-i), so every expansion level of the tree separates
+  // only one point from the rest.
+  const size_t numPoints = 200;
+  arma::mat dataset(1, numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    dataset[i] = std::pow(2.0, -((double) i));
+
+  typedef StandardCoverTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      TreeType;
+  TreeType tree(dataset);
+
+  REQUIRE(tree.NumDescendants() == numPoints);
+
+  // Each point should have exactly one leaf node representing it.
+  arma::vec counts;
+  counts.zeros(numPoints);
+  RecurseTreeCountLeaves(tree, counts);
+  for (size_t i = 0; i < numPoints; ++i)
+    REQUIRE(counts[i] == 1);
+
+  // Each non-leaf should have a self-child, and each node must satisfy the
+  // covering principle.
+  CheckSelfChild<TreeType>(tree);
+  CheckCovering<TreeType, LMetric<2, true>>(tree);
+}
+
+/**
+ * Check that a kd-tree saved in the flat on-disk format and loaded back is
+ * identical to the original, node for node.
+ */
+template<typename TreeType>
+void CheckFlatTreesEqual(const TreeType* a, const TreeType* b)
+{
+  REQUIRE(a->Begin() == b->Begin());
+  REQUIRE(a->Count() == b->Count());
+  REQUIRE(a->ParentDistance() == Approx(b->ParentDistance()).margin(1e-10));
+  REQUIRE(a->FurthestDescendantDistance() ==
+      Approx(b->FurthestDescendantDistance()).margin(1e-10));
+  for (size_t d = 0; d < a->Bound().Dim(); ++d)
+  {
+    REQUIRE(a->Bound()[d].Lo() == Approx(b->Bound()[d].Lo()).margin(1e-10));
+    REQUIRE(a->Bound()[d].Hi() == Approx(b->Bound()[d].Hi()).margin(1e-10));
+  }
+
+  REQUIRE((a->Left() == NULL) == (b->Left() == NULL));
+  REQUIRE((a->Right() == NULL) == (b->Right() == NULL));
+  if (a->Left())
+    CheckFlatTreesEqual(a->Left(), b->Left());
+  if (a->Right())
+    CheckFlatTreesEqual(a->Right(), b->Right());
+}
+
+/**
+ * Save a kd-tree with FlatTreeIO and load it back, both with and without
+ * dataset mapping.
+ */
+TEST_CASE("FlatTreeIOTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset;
+  dataset.randu(5, 500);
+
+  TreeType tree(dataset);
+  FlatTreeIO<TreeType>::Save(tree, "flat_tree_io_test.bin");
+
+  // First load with a plain copied dataset.
+  TreeType* copied = FlatTreeIO<TreeType>::Load("flat_tree_io_test.bin",
+      false);
+  CheckFlatTreesEqual(&tree, copied);
+  REQUIRE(arma::approx_equal(tree.Dataset(), copied->Dataset(), "absdiff",
+      1e-10));
+  delete copied;
+
+  // Then load with the dataset memory-mapped (where supported; on other
+  // platforms this silently falls back to copying).
+  TreeType* mapped = FlatTreeIO<TreeType>::Load("flat_tree_io_test.bin");
+  CheckFlatTreesEqual(&tree, mapped);
+  REQUIRE(arma::approx_equal(tree.Dataset(), mapped->Dataset(), "absdiff",
+      1e-10));
+  delete mapped;
+
+  remove("flat_tree_io_test.bin");
+}
+
+/**
+ * Check that IncrementalTreeBuilder folds buffered insertions and deletions
+ * into the tree on rebuild, both synchronously and in the background.
+ */
+TEST_CASE("IncrementalTreeBuilderTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset;
+  dataset.randu(3, 200);
+
+  IncrementalTreeBuilder<TreeType> builder(dataset);
+  REQUIRE(builder.Dataset().n_cols == 200);
+
+  // Updates are buffered, not applied.
+  builder.Insert(arma::vec("0.5 0.5 0.5"));
+  builder.Delete(0);
+  builder.Delete(0); // Duplicate deletion must not count twice.
+  REQUIRE(builder.PendingUpdates() == 2);
+  REQUIRE(builder.Dataset().n_cols == 200);
+
+  builder.Rebuild();
+  REQUIRE(builder.PendingUpdates() == 0);
+  REQUIRE(builder.Dataset().n_cols == 200); // -1 point, +1 point.
+
+  // Now rebuild in the background; insertions are allowed while the rebuild
+  // runs, deletions are not.
+  builder.Insert(arma::vec("0.1 0.2 0.3"));
+  builder.LaunchRebuild();
+  builder.Insert(arma::vec("0.9 0.9 0.9"));
+  REQUIRE_THROWS_AS(builder.Delete(1), std::logic_error);
+
+  while (!builder.SwapIfReady()) { }
+  REQUIRE(builder.Dataset().n_cols == 201);
+  REQUIRE(builder.PendingUpdates() == 1); // The second insertion remains.
+
+  builder.Rebuild();
+  REQUIRE(builder.Dataset().n_cols == 202);
+}
+
+/**
+ * Test that the Z-order presorting constructor produces a valid kd-tree with
+ * a correct oldFromNew mapping (composed of the presort and the splits).
+ */
+TEST_CASE("KdTreeZOrderPresortTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(5, 1500, arma::fill::randu);
+
+  std::vector<size_t> oldFromNew;
+  TreeType root(dataset, oldFromNew, math::ZOrderPresort());
+  const arma::mat& treeset = root.Dataset();
+
+  REQUIRE(root.Count() == dataset.n_cols);
+  REQUIRE(oldFromNew.size() == dataset.n_cols);
+
+  // The mapping must be a permutation that maps tree columns back to the
+  // original dataset.
+  std::vector<bool> seen(dataset.n_cols, false);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    REQUIRE(oldFromNew[i] < dataset.n_cols);
+    REQUIRE(!seen[oldFromNew[i]]);
+    seen[oldFromNew[i]] = true;
+
+    for (size_t j = 0; j < dataset.n_rows; ++j)
+      REQUIRE(treeset(j, i) == dataset(j, oldFromNew[i]));
+  }
+
+  // The tree must still satisfy the bound invariants.
+  CheckPointBounds(root);
+}
+
+/**
+ * Ensure that LeafSizeTuner tries every candidate and returns the one with
+ * the smallest measured cost.
+ */
+TEST_CASE("LeafSizeTunerTest", "[TreeTest]")
+{
+  // Use a cost function whose running time is proportional to the candidate,
+  // so that the smallest candidate is the cheapest.
+  std::vector<size_t> visited;
+  const std::vector<size_t> candidates = { 6, 1, 3 };
+  const size_t chosen = LeafSizeTuner::Tune(
+      [&](const size_t candidate)
+      {
+        visited.push_back(candidate);
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(10 * candidate));
+      }, candidates);
+
+  REQUIRE(visited == candidates);
+  REQUIRE(chosen == 1);
+
+  // An empty candidate ladder is invalid.
+  REQUIRE_THROWS_AS(LeafSizeTuner::Tune([](const size_t) { },
+      std::vector<size_t>()), std::invalid_argument);
+}
+
+/**
+ * NodePool must hand out distinct, maximally aligned blocks, reuse freed
+ * blocks, and let blocks freed on one thread flow back to allocating threads
+ * through the shared list (without that, every parallel build/destroy cycle
+ * would grow the pool).
+ */
+TEST_CASE("NodePoolReuseTest", "[TreeTest]")
+{
+  // Use a block size no tree node has, so this test owns the instantiation.
+  typedef NodePool<1000> Pool;
+
+  // Allocate three spill segments' worth of blocks.
+  const size_t count = 768;
+  std::vector<void*> blocks(count);
+  std::set<void*> unique;
+  for (size_t i = 0; i < count; ++i)
+  {
+    blocks[i] = Pool::Allocate();
+    REQUIRE(blocks[i] != NULL);
+    REQUIRE(((uintptr_t) blocks[i]) % alignof(std::max_align_t) == 0);
+    unique.insert(blocks[i]);
+  }
+  REQUIRE(unique.size() == count);
+
+  // A block freed on the same thread is handed out again first.
+  Pool::Deallocate(blocks[count - 1]);
+  REQUIRE(Pool::Allocate() == blocks[count - 1]);
+
+  // Free everything on this thread; part of it spills to the shared list.
+  for (size_t i = 0; i < count; ++i)
+    Pool::Deallocate(blocks[i]);
+
+  // Now allocate from every thread of a parallel region.  Every block must
+  // come out of what was just freed---if the freed blocks did not flow back,
+  // worker threads would pull fresh chunks instead.
+  std::vector<void*> reused;
+  #pragma omp parallel num_threads(2)
+  {
+    std::vector<void*> local(count / 4);
+    for (size_t i = 0; i < local.size(); ++i)
+      local[i] = Pool::Allocate();
+
+    #pragma omp critical (nodePoolTest)
+    reused.insert(reused.end(), local.begin(), local.end());
+
+    for (size_t i = 0; i < local.size(); ++i)
+      Pool::Deallocate(local[i]);
+  }
+
+  for (size_t i = 0; i < reused.size(); ++i)
+    REQUIRE(unique.count(reused[i]) == 1);
+}